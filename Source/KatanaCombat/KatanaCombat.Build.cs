@@ -22,27 +22,21 @@ public class KatanaCombat : ModuleRules
 			"UMG",
 			"Slate",
 			"SlateCore",
-			"MotionWarping"
+			"MotionWarping",
+			"Niagara"
 		});
 
-		PrivateDependencyModuleNames.AddRange(new string[] { "MotionWarping" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "MotionWarping", "Gauntlet", "Sockets", "Networking", "HTTP", "NavigationSystem", "AnimationBudgetAllocator" });
 
 		PublicIncludePaths.AddRange(new string[] {
 			"KatanaCombat",
 			"KatanaCombat/Public",
-			"KatanaCombat/Variant_Platforming",
-			"KatanaCombat/Variant_Platforming/Animation",
 			"KatanaCombat/Variant_Combat",
 			"KatanaCombat/Variant_Combat/AI",
 			"KatanaCombat/Variant_Combat/Animation",
 			"KatanaCombat/Variant_Combat/Gameplay",
 			"KatanaCombat/Variant_Combat/Interfaces",
-			"KatanaCombat/Variant_Combat/UI",
-			"KatanaCombat/Variant_SideScrolling",
-			"KatanaCombat/Variant_SideScrolling/AI",
-			"KatanaCombat/Variant_SideScrolling/Gameplay",
-			"KatanaCombat/Variant_SideScrolling/Interfaces",
-			"KatanaCombat/Variant_SideScrolling/UI"
+			"KatanaCombat/Variant_Combat/UI"
 		});
 		PrivateIncludePaths.AddRange(new string[] {
 			
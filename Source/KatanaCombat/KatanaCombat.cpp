@@ -2,7 +2,120 @@
 
 #include "KatanaCombat.h"
 #include "Modules/ModuleManager.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/CoreRedirects.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, KatanaCombat, "KatanaCombat" );
+namespace KatanaVariantModules
+{
+	struct FVariantModule
+	{
+		/** Maps under this folder use the module's classes */
+		const TCHAR* ContentPath;
+		const TCHAR* ModuleName;
+	};
+
+	static const FVariantModule VariantModules[] =
+	{
+		{ TEXT("/Game/Variant_Platforming/"), TEXT("KatanaPlatforming") },
+		{ TEXT("/Game/Variant_SideScrolling/"), TEXT("KatanaSideScrolling") }
+	};
+
+	static void LoadVariantModule(const TCHAR* ModuleName)
+	{
+		// Not built into this target (Shipping) - nothing to load
+		FModuleManager& ModuleManager = FModuleManager::Get();
+		if (!ModuleManager.IsModuleLoaded(ModuleName) && ModuleManager.ModuleExists(ModuleName))
+		{
+			ModuleManager.LoadModule(ModuleName);
+		}
+	}
+
+	/** Types that were compiled into KatanaCombat before the variants became modules (assets saved back then still name the old package) */
+	static void AddMovedTypeRedirects()
+	{
+		struct FMovedType
+		{
+			ECoreRedirectFlags Type;
+			const TCHAR* ModuleName;
+			const TCHAR* TypeName;
+		};
+
+		static const FMovedType MovedTypes[] =
+		{
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaPlatforming"), TEXT("AnimNotify_EndDash") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaPlatforming"), TEXT("PlatformingCharacter") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaPlatforming"), TEXT("PlatformingGameMode") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaPlatforming"), TEXT("PlatformingPlayerController") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingAIController") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingCameraManager") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingCharacter") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingGameMode") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingInteractable") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingJumpPad") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingMovingPlatform") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingNPC") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingPickup") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingPlayerController") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingSoftPlatform") },
+			{ ECoreRedirectFlags::Type_Class, TEXT("KatanaSideScrolling"), TEXT("SideScrollingUI") },
+			{ ECoreRedirectFlags::Type_Struct, TEXT("KatanaSideScrolling"), TEXT("StateTreeGetPlayerInstanceData") },
+			{ ECoreRedirectFlags::Type_Struct, TEXT("KatanaSideScrolling"), TEXT("StateTreeGetPlayerTask") }
+		};
+
+		TArray<FCoreRedirect> Redirects;
+		for (const FMovedType& MovedType : MovedTypes)
+		{
+			Redirects.Emplace(MovedType.Type, FString::Printf(TEXT("/Script/KatanaCombat.%s"), MovedType.TypeName), FString::Printf(TEXT("/Script/%s.%s"), MovedType.ModuleName, MovedType.TypeName));
+		}
+		FCoreRedirects::AddRedirectList(Redirects, TEXT("KatanaVariantModules"));
+	}
+
+	void LoadForMap(const FString& MapName)
+	{
+		for (const FVariantModule& VariantModule : VariantModules)
+		{
+			if (MapName.StartsWith(VariantModule.ContentPath))
+			{
+				LoadVariantModule(VariantModule.ModuleName);
+			}
+		}
+	}
+
+	void LoadAll()
+	{
+		for (const FVariantModule& VariantModule : VariantModules)
+		{
+			LoadVariantModule(VariantModule.ModuleName);
+		}
+	}
+}
+
+class FKatanaCombatModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		KatanaVariantModules::AddMovedTypeRedirects();
+
+		// The editor and the cooker work with every variant's assets
+		if (GIsEditor || IsRunningCommandlet())
+		{
+			KatanaVariantModules::LoadAll();
+			return;
+		}
+
+		PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddStatic(&KatanaVariantModules::LoadForMap);
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	}
+
+private:
+	FDelegateHandle PreLoadMapHandle;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FKatanaCombatModule, KatanaCombat, "KatanaCombat" );
 
 DEFINE_LOG_CATEGORY(LogKatanaCombat)
\ No newline at end of file
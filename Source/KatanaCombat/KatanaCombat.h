@@ -5,4 +5,18 @@
 #include "CoreMinimal.h"
 
 /** Main log category used across the project */
-DECLARE_LOG_CATEGORY_EXTERN(LogKatanaCombat, Log, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(LogKatanaCombat, Log, All);
+
+/**
+ * Optional gameplay variants (platforming, side scrolling) are separate modules that aren't loaded at
+ * startup: the editor and commandlets load all of them, games load a variant with the first map from
+ * its content folder (Shipping builds don't compile them at all)
+ */
+namespace KatanaVariantModules
+{
+	/** Load the variant modules a map needs (called before every map load) */
+	KATANACOMBAT_API void LoadForMap(const FString& MapName);
+
+	/** Load every variant module (maps outside the variant folders that use variant classes call this first) */
+	KATANACOMBAT_API void LoadAll();
+}
\ No newline at end of file
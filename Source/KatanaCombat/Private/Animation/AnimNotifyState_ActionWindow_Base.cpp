@@ -1,12 +1,13 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Animation/AnimNotifyState_ActionWindow_Base.h"
+#include "Animation/CombatNotifySink.h"
 #include "Core/CombatComponent.h"
 #include "Core/CombatComponentV2.h"
-#include "Characters/SamuraiCharacter.h"
-#include "Data/CombatSettings.h"
 #include "Animation/AnimInstance.h"
-#include "GameFramework/Character.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatAttackProfiler.h"
 
 UAnimNotifyState_ActionWindow_Base::UAnimNotifyState_ActionWindow_Base()
 {
@@ -14,67 +15,61 @@ UAnimNotifyState_ActionWindow_Base::UAnimNotifyState_ActionWindow_Base()
 
 void UAnimNotifyState_ActionWindow_Base::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Combat_AnimNotify);
+	COMBAT_CSV_SCOPE_IN(Anim, AnimNotify);
+	FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Notify);
 	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
 
-	if (!MeshComp || !MeshComp->GetOwner())
+	// Receivers resolved once per mesh (no owner cast / component search per fire)
+	FCombatNotifySink FallbackSink;
+	const FCombatNotifySink* Sink = FCombatNotifySink::Get(MeshComp, FallbackSink);
+	AttackProfileScope.SetAttack(Sink ? Sink->GetCurrentAttack() : nullptr);
+	if (!Sink)
 	{
 		return;
 	}
 
-	// Check if using V2 system via CombatSettings (owned by character)
-	ASamuraiCharacter* Character = Cast<ASamuraiCharacter>(MeshComp->GetOwner());
-	if (Character && Character->CombatSettings && Character->CombatSettings->bUseV2System)
+	// V2: Register checkpoint for timer-based execution (unless the attack's windows are scheduled already)
+	if (Sink->UsesV2())
 	{
-		// V2: Register checkpoint for timer-based execution
-		if (UCombatComponentV2* CombatV2 = Character->FindComponentByClass<UCombatComponentV2>())
+		if (Sink->CombatComponentV2->IsAttackTimingScheduled())
 		{
-			// Get current montage time for checkpoint registration
-			if (UAnimInstance* AnimInstance = MeshComp->GetAnimInstance())
+			return;
+		}
+
+		// Get current montage time for checkpoint registration
+		if (UAnimInstance* AnimInstance = MeshComp->GetAnimInstance())
+		{
+			if (UAnimMontage* CurrentMontage = AnimInstance->GetCurrentActiveMontage())
 			{
-				if (UAnimMontage* CurrentMontage = AnimInstance->GetCurrentActiveMontage())
-				{
-					float CurrentMontageTime = AnimInstance->Montage_GetPosition(CurrentMontage);
-					CombatV2->RegisterCheckpoint(GetWindowType(), CurrentMontageTime, TotalDuration);
-				}
+				float CurrentMontageTime = AnimInstance->Montage_GetPosition(CurrentMontage);
+				Sink->CombatComponentV2->RegisterCheckpoint(GetWindowType(), CurrentMontageTime, TotalDuration);
 			}
-			return; // Early exit for V2
 		}
+		return; // Early exit for V2
 	}
 
 	// V1: Call legacy window open method
-	if (Character)
+	if (Sink->CombatComponent)
 	{
-		if (UCombatComponent* CombatComp = Character->FindComponentByClass<UCombatComponent>())
-		{
-			OnOpenWindow_V1(CombatComp, TotalDuration);
-		}
+		OnOpenWindow_V1(Sink->CombatComponent, TotalDuration);
 	}
 }
 
 void UAnimNotifyState_ActionWindow_Base::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Combat_AnimNotify);
+	COMBAT_CSV_SCOPE_IN(Anim, AnimNotify);
+	FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Notify);
 	Super::NotifyEnd(MeshComp, Animation, EventReference);
 
-	if (!MeshComp || !MeshComp->GetOwner())
-	{
-		return;
-	}
-
 	// V2: Checkpoints expire automatically via ClearExpiredCheckpoints()
 	// Only need to close for V1 system
-	
-	if (ASamuraiCharacter* Character = Cast<ASamuraiCharacter>(MeshComp->GetOwner()))
+	FCombatNotifySink FallbackSink;
+	const FCombatNotifySink* Sink = FCombatNotifySink::Get(MeshComp, FallbackSink);
+	AttackProfileScope.SetAttack(Sink ? Sink->GetCurrentAttack() : nullptr);
+	if (Sink && !Sink->UsesV2() && Sink->CombatComponent)
 	{
-		// Check if V2 is enabled via CombatSettings (owned by character)
-		bool bUseV2 = Character->CombatSettings && Character->CombatSettings->bUseV2System;
-
-		// V1: Call legacy window close method
-		if (!bUseV2)
-		{
-			if (UCombatComponent* CombatComp = Character->FindComponentByClass<UCombatComponent>())
-			{
-				OnCloseWindow_V1(CombatComp);
-			}
-		}
+		OnCloseWindow_V1(Sink->CombatComponent);
 	}
 }
\ No newline at end of file
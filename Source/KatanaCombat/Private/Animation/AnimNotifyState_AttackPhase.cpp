@@ -2,6 +2,9 @@
 
 #include "Animation/AnimNotifyState_AttackPhase.h"
 #include "Interfaces/CombatInterface.h"
+#include "Animation/CombatNotifySink.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatAttackProfiler.h"
 
 UAnimNotifyState_AttackPhase::UAnimNotifyState_AttackPhase()
 {
@@ -10,6 +13,9 @@ UAnimNotifyState_AttackPhase::UAnimNotifyState_AttackPhase()
 
 void UAnimNotifyState_AttackPhase::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
 {
+    SCOPE_CYCLE_COUNTER(STAT_Combat_AnimNotify);
+    COMBAT_CSV_SCOPE_IN(Anim, AnimNotify);
+    FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Notify);
     Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
 
     // DEPRECATION WARNING: Log once per session
@@ -20,31 +26,30 @@ void UAnimNotifyState_AttackPhase::NotifyBegin(USkeletalMeshComponent* MeshComp,
         bDeprecationWarningLogged = true;
     }
 
-    if (!MeshComp || !MeshComp->GetOwner())
+    // Route to combat interface (resolved once per mesh via notify sink)
+    FCombatNotifySink FallbackSink;
+    const FCombatNotifySink* Sink = FCombatNotifySink::Get(MeshComp, FallbackSink);
+    AttackProfileScope.SetAttack(Sink ? Sink->GetCurrentAttack() : nullptr);
+    if (Sink && Sink->CombatInterfaceOwner)
     {
-        return;
-    }
-
-    // Route to combat interface
-    if (ICombatInterface* CombatInterface = Cast<ICombatInterface>(MeshComp->GetOwner()))
-    {
-        CombatInterface->Execute_OnAttackPhaseBegin(MeshComp->GetOwner(), Phase);
+        ICombatInterface::Execute_OnAttackPhaseBegin(Sink->CombatInterfaceOwner, Phase);
     }
 }
 
 void UAnimNotifyState_AttackPhase::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
 {
+    SCOPE_CYCLE_COUNTER(STAT_Combat_AnimNotify);
+    COMBAT_CSV_SCOPE_IN(Anim, AnimNotify);
+    FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Notify);
     Super::NotifyEnd(MeshComp, Animation, EventReference);
     
-    if (!MeshComp || !MeshComp->GetOwner())
-    {
-        return;
-    }
-    
-    // Route to combat interface
-    if (ICombatInterface* CombatInterface = Cast<ICombatInterface>(MeshComp->GetOwner()))
+    // Route to combat interface (resolved once per mesh via notify sink)
+    FCombatNotifySink FallbackSink;
+    const FCombatNotifySink* Sink = FCombatNotifySink::Get(MeshComp, FallbackSink);
+    AttackProfileScope.SetAttack(Sink ? Sink->GetCurrentAttack() : nullptr);
+    if (Sink && Sink->CombatInterfaceOwner)
     {
-        CombatInterface->Execute_OnAttackPhaseEnd(MeshComp->GetOwner(), Phase);
+        ICombatInterface::Execute_OnAttackPhaseEnd(Sink->CombatInterfaceOwner, Phase);
     }
 }
 
@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Animation/AnimNotifyState_CancelWindow.h"
+#include "Core/CombatComponent.h"
+
+UAnimNotifyState_CancelWindow::UAnimNotifyState_CancelWindow()
+{
+}
+
+void UAnimNotifyState_CancelWindow::OnOpenWindow_V1(UCombatComponent* CombatComp, float Duration)
+{
+	// V1 cancels recovery from the combo window; authored cancel windows are V2 only
+}
+
+void UAnimNotifyState_CancelWindow::OnCloseWindow_V1(UCombatComponent* CombatComp)
+{
+}
+
+FString UAnimNotifyState_CancelWindow::GetNotifyName_Implementation() const
+{
+	return TEXT("Cancel Window");
+}
\ No newline at end of file
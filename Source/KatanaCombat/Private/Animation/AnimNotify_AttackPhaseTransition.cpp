@@ -2,7 +2,11 @@
 
 #include "Animation/AnimNotify_AttackPhaseTransition.h"
 #include "Interfaces/CombatInterface.h"
+#include "Animation/CombatNotifySink.h"
+#include "Core/CombatComponentV2.h"
 #include "GameFramework/Actor.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatAttackProfiler.h"
 
 UAnimNotify_AttackPhaseTransition::UAnimNotify_AttackPhaseTransition()
 {
@@ -15,23 +19,25 @@ UAnimNotify_AttackPhaseTransition::UAnimNotify_AttackPhaseTransition()
 
 void UAnimNotify_AttackPhaseTransition::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Combat_AnimNotify);
+	COMBAT_CSV_SCOPE_IN(Anim, AnimNotify);
+	FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Notify);
 	Super::Notify(MeshComp, Animation, EventReference);
 
-	if (!MeshComp)
-	{
-		return;
-	}
+	// Route to ICombatInterface on owner (resolved once per mesh via notify sink)
+	FCombatNotifySink FallbackSink;
+	const FCombatNotifySink* Sink = FCombatNotifySink::Get(MeshComp, FallbackSink);
+	AttackProfileScope.SetAttack(Sink ? Sink->GetCurrentAttack() : nullptr);
 
-	AActor* Owner = MeshComp->GetOwner();
-	if (!Owner)
+	// Scheduled from the cooked timing instead (UCombatComponentV2::bScheduleAttackTiming)
+	if (Sink && Sink->UsesV2() && Sink->CombatComponentV2->IsAttackTimingScheduled())
 	{
 		return;
 	}
 
-	// Route to ICombatInterface on owner
-	if (Owner->Implements<UCombatInterface>())
+	if (Sink && Sink->CombatInterfaceOwner)
 	{
-		ICombatInterface::Execute_OnAttackPhaseTransition(Owner, TransitionToPhase);
+		ICombatInterface::Execute_OnAttackPhaseTransition(Sink->CombatInterfaceOwner, TransitionToPhase);
 	}
 }
 
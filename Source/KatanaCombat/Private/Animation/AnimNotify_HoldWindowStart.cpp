@@ -2,7 +2,15 @@
 
 #include "Animation/AnimNotify_HoldWindowStart.h"
 #include "Interfaces/CombatInterface.h"
+#include "Animation/CombatNotifySink.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Core/CombatComponentV2.h"
+#include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatAttackProfiler.h"
 
 UAnimNotify_HoldWindowStart::UAnimNotify_HoldWindowStart()
 {
@@ -15,24 +23,53 @@ UAnimNotify_HoldWindowStart::UAnimNotify_HoldWindowStart()
 
 void UAnimNotify_HoldWindowStart::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Combat_AnimNotify);
+	COMBAT_CSV_SCOPE_IN(Anim, AnimNotify);
+	FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Notify);
 	Super::Notify(MeshComp, Animation, EventReference);
 
-	if (!MeshComp)
+	// Route to ICombatInterface on owner (resolved once per mesh via notify sink)
+	FCombatNotifySink FallbackSink;
+	const FCombatNotifySink* Sink = FCombatNotifySink::Get(MeshComp, FallbackSink);
+	AttackProfileScope.SetAttack(Sink ? Sink->GetCurrentAttack() : nullptr);
+	if (Sink && Sink->CombatInterfaceOwner)
 	{
-		return;
+		// V2 judges buttons against when the notify was crossed within this frame, not the frame time
+		if (Sink->CombatComponentV2)
+		{
+			Sink->CombatComponentV2->SetHoldWindowStartTime(GetCrossingWorldTime(MeshComp, Animation, EventReference));
+		}
+
+		ICombatInterface::Execute_OnHoldWindowStart(Sink->CombatInterfaceOwner, InputType);
 	}
+}
 
-	AActor* Owner = MeshComp->GetOwner();
-	if (!Owner)
+float UAnimNotify_HoldWindowStart::GetCrossingWorldTime(const USkeletalMeshComponent* MeshComp, const UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+{
+	const UWorld* World = MeshComp ? MeshComp->GetWorld() : nullptr;
+	if (!World)
 	{
-		return;
+		return 0.0f;
 	}
 
-	// Route to ICombatInterface on owner
-	if (Owner->Implements<UCombatInterface>())
+	const float WorldTime = World->GetTimeSeconds();
+	const UAnimInstance* AnimInstance = MeshComp->GetAnimInstance();
+	const UAnimMontage* Montage = Cast<UAnimMontage>(Animation);
+	const FAnimNotifyEvent* NotifyEvent = EventReference.GetNotify();
+	if (!AnimInstance || !Montage || !NotifyEvent)
 	{
-		ICombatInterface::Execute_OnHoldWindowStart(Owner, InputType);
+		return WorldTime;
 	}
+
+	// Montage time advanced past the notify this frame: walk that distance back at the play rate
+	const float PlayRate = FMath::Abs(AnimInstance->Montage_GetPlayRate(Montage) * Montage->RateScale);
+	if (PlayRate <= UE_KINDA_SMALL_NUMBER)
+	{
+		return WorldTime;
+	}
+
+	const float Overshoot = FMath::Abs(AnimInstance->Montage_GetPosition(Montage) - NotifyEvent->GetTriggerTime()) / PlayRate;
+	return WorldTime - FMath::Min(Overshoot, World->GetDeltaSeconds());
 }
 
 FString UAnimNotify_HoldWindowStart::GetNotifyName_Implementation() const
@@ -2,6 +2,11 @@
 
 #include "Animation/AnimNotify_ToggleHitDetection.h"
 #include "Interfaces/CombatInterface.h"
+#include "Animation/CombatNotifySink.h"
+#include "Core/CombatComponent.h"
+#include "Core/WeaponComponent.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatAttackProfiler.h"
 
 UAnimNotify_ToggleHitDetection::UAnimNotify_ToggleHitDetection()
 {
@@ -10,6 +15,9 @@ UAnimNotify_ToggleHitDetection::UAnimNotify_ToggleHitDetection()
 
 void UAnimNotify_ToggleHitDetection::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Combat_AnimNotify);
+	COMBAT_CSV_SCOPE_IN(Anim, AnimNotify);
+	FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Notify);
 	Super::Notify(MeshComp, Animation, EventReference);
 
 	// DEPRECATION WARNING: Log once per session
@@ -20,21 +28,30 @@ void UAnimNotify_ToggleHitDetection::Notify(USkeletalMeshComponent* MeshComp, UA
 		bDeprecationWarningLogged = true;
 	}
 
-	if (!MeshComp || !MeshComp->GetOwner())
+	// Straight to the weapon (resolved once per mesh via notify sink); the interface covers owners without one
+	FCombatNotifySink FallbackSink;
+	const FCombatNotifySink* Sink = FCombatNotifySink::Get(MeshComp, FallbackSink);
+	AttackProfileScope.SetAttack(Sink ? Sink->GetCurrentAttack() : nullptr);
+	if (Sink && Sink->WeaponComponent)
 	{
-		return;
+		if (bEnable)
+		{
+			Sink->WeaponComponent->EnableHitDetectionForAttack(Sink->CombatComponent ? Sink->CombatComponent->GetCurrentAttack() : nullptr);
+		}
+		else
+		{
+			Sink->WeaponComponent->DisableHitDetection();
+		}
 	}
-
-	// Route to combat interface
-	if (ICombatInterface* CombatInterface = Cast<ICombatInterface>(MeshComp->GetOwner()))
+	else if (Sink && Sink->CombatInterfaceOwner)
 	{
 		if (bEnable)
 		{
-			CombatInterface->Execute_OnEnableHitDetection(MeshComp->GetOwner());
+			ICombatInterface::Execute_OnEnableHitDetection(Sink->CombatInterfaceOwner);
 		}
 		else
 		{
-			CombatInterface->Execute_OnDisableHitDetection(MeshComp->GetOwner());
+			ICombatInterface::Execute_OnDisableHitDetection(Sink->CombatInterfaceOwner);
 		}
 	}
 }
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Animation/CombatNotifySink.h"
+#include "Animation/SamuraiAnimInstance.h"
+#include "Characters/SamuraiCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Core/CombatComponent.h"
+#include "Core/CombatComponentV2.h"
+#include "Core/WeaponComponent.h"
+#include "Interfaces/CombatInterface.h"
+
+void FCombatNotifySink::Resolve(AActor* Owner)
+{
+	Reset();
+	bResolved = true;
+
+	if (!Owner)
+	{
+		return;
+	}
+
+	if (Owner->Implements<UCombatInterface>())
+	{
+		CombatInterfaceOwner = Owner;
+	}
+
+	// Samurai characters create only the stack their CombatSettings select (SelectCombatBackend),
+	// so the V2 receiver is simply whether that component exists
+	if (const ASamuraiCharacter* Character = Cast<ASamuraiCharacter>(Owner))
+	{
+		CombatComponent = Character->CombatComponent;
+		CombatComponentV2 = Character->CombatComponentV2;
+		WeaponComponent = Character->WeaponComponent;
+		return;
+	}
+
+	// Other owners: V1 receivers only
+	CombatComponent = Owner->FindComponentByClass<UCombatComponent>();
+	WeaponComponent = Owner->FindComponentByClass<UWeaponComponent>();
+}
+
+void FCombatNotifySink::Reset()
+{
+	CombatComponent = nullptr;
+	CombatComponentV2 = nullptr;
+	CombatInterfaceOwner = nullptr;
+	WeaponComponent = nullptr;
+	bResolved = false;
+}
+
+const UAttackData* FCombatNotifySink::GetCurrentAttack() const
+{
+	if (CombatComponentV2)
+	{
+		return CombatComponentV2->GetCurrentAttack();
+	}
+
+	return CombatComponent ? CombatComponent->GetCurrentAttack() : nullptr;
+}
+
+const FCombatNotifySink* FCombatNotifySink::Get(const USkeletalMeshComponent* MeshComp, FCombatNotifySink& Fallback)
+{
+	if (!MeshComp)
+	{
+		return nullptr;
+	}
+
+	if (USamuraiAnimInstance* SamuraiAnim = Cast<USamuraiAnimInstance>(MeshComp->GetAnimInstance()))
+	{
+		return &SamuraiAnim->GetCombatNotifySink();
+	}
+
+	Fallback.Resolve(MeshComp->GetOwner());
+	return &Fallback;
+}
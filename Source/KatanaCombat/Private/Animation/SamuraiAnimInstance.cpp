@@ -4,6 +4,7 @@
 #include "Core/CombatComponent.h"
 #include "Core/HitReactionComponent.h"
 #include "Interfaces/CombatInterface.h"
+#include "Debug/CombatTrace.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 
@@ -20,14 +21,32 @@ void USamuraiAnimInstance::NativeInitializeAnimation()
         CombatComponent = OwnerCharacter->FindComponentByClass<UCombatComponent>();
         HitReactionComponent = OwnerCharacter->FindComponentByClass<UHitReactionComponent>();
     }
+
+    // Re-resolve notify receivers lazily on next notify
+    CombatNotifySink.Reset();
+
+    // Force a full variable update on the next thread-safe update
+    AppliedVersions.Reset();
 }
 
 void USamuraiAnimInstance::NativeUpdateAnimation(float DeltaTime)
 {
     Super::NativeUpdateAnimation(DeltaTime);
+    COMBAT_CSV_SCOPE_IN(Anim, AnimGatherSnapshot);
+    COMBAT_BUDGET_SCOPE(Anim);
+
+    // Game thread: snapshot component state only - all derived variables update on the worker thread
+    GatherSnapshot();
+}
+
+void USamuraiAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaTime)
+{
+    Super::NativeThreadSafeUpdateAnimation(DeltaTime);
+    COMBAT_CSV_SCOPE_IN(Anim, AnimThreadSafeUpdate);
+    COMBAT_BUDGET_SCOPE(Anim);
 
     // Early exit if references not set
-    if (!OwnerCharacter || !MovementComponent)
+    if (!Snapshot.bValid)
     {
         return;
     }
@@ -37,13 +56,64 @@ void USamuraiAnimInstance::NativeUpdateAnimation(float DeltaTime)
 }
 
 // ============================================================================
-// UPDATE ANIMATION VARIABLES
+// SNAPSHOT (Game thread)
+// ============================================================================
+
+void USamuraiAnimInstance::GatherSnapshot()
+{
+    Snapshot.bValid = OwnerCharacter && MovementComponent;
+    if (!Snapshot.bValid)
+    {
+        return;
+    }
+
+    const FVector Velocity = MovementComponent->Velocity;
+    const FVector Forward = OwnerCharacter->GetActorForwardVector();
+    const FVector Right = OwnerCharacter->GetActorRightVector();
+    const bool bIsFalling = MovementComponent->IsFalling();
+    if (Velocity != Snapshot.Velocity || Forward != Snapshot.Forward || Right != Snapshot.Right || bIsFalling != Snapshot.bIsFalling)
+    {
+        Snapshot.Velocity = Velocity;
+        Snapshot.Forward = Forward;
+        Snapshot.Right = Right;
+        Snapshot.bIsFalling = bIsFalling;
+        ++Snapshot.MovementVersion;
+    }
+
+    Snapshot.bHasCombat = CombatComponent != nullptr;
+    if (CombatComponent)
+    {
+        Snapshot.Combat = CombatComponent->PublishAnimState();
+    }
+
+    Snapshot.bHasHitReaction = HitReactionComponent != nullptr;
+    if (HitReactionComponent)
+    {
+        const bool bIsStunned = HitReactionComponent->IsStunned();
+        const float RemainingStunTime = HitReactionComponent->GetRemainingStunTime();
+        const float FlinchAlpha = HitReactionComponent->GetFlinchAlpha();
+        const EAttackDirection FlinchDirection = HitReactionComponent->GetFlinchDirection();
+        if (bIsStunned != Snapshot.bIsStunned || RemainingStunTime != Snapshot.RemainingStunTime
+            || FlinchAlpha != Snapshot.FlinchAlpha || FlinchDirection != Snapshot.FlinchDirection)
+        {
+            Snapshot.bIsStunned = bIsStunned;
+            Snapshot.RemainingStunTime = RemainingStunTime;
+            Snapshot.FlinchAlpha = FlinchAlpha;
+            Snapshot.FlinchDirection = FlinchDirection;
+            ++Snapshot.HitReactionVersion;
+        }
+    }
+}
+
+// ============================================================================
+// UPDATE ANIMATION VARIABLES (Worker thread - reads Snapshot only)
 // ============================================================================
 
 void USamuraiAnimInstance::UpdateAnimationVariables()
 {
-    UpdateMovement();
+    // Combat state first: movement reads this frame's hold/combat flags
     UpdateCombatState();
+    UpdateMovement();
     UpdateCombo();
     UpdatePosture();
     UpdateCharge();
@@ -52,10 +122,14 @@ void USamuraiAnimInstance::UpdateAnimationVariables()
 
 void USamuraiAnimInstance::UpdateMovement()
 {
-    if (!MovementComponent)
+    // Skip when neither movement nor combat flags changed (static characters)
+    const uint32 StateVersion = Snapshot.bHasCombat ? Snapshot.Combat.StateVersion : MAX_uint32 - 1;
+    if (Snapshot.MovementVersion == AppliedVersions.Movement && StateVersion == AppliedVersions.MovementState)
     {
         return;
     }
+    AppliedVersions.Movement = Snapshot.MovementVersion;
+    AppliedVersions.MovementState = StateVersion;
 
     // CRITICAL: Don't update locomotion during hold state
     // Prevents animation state machine from reacting to velocity changes
@@ -69,26 +143,14 @@ void USamuraiAnimInstance::UpdateMovement()
     }
 
     // Get velocity and speed
-    const FVector Velocity = MovementComponent->Velocity;
+    const FVector& Velocity = Snapshot.Velocity;
     Speed = Velocity.Size2D();
 
     // Calculate direction relative to character facing
     if (Speed > 0.0f)
     {
-        // Get movement direction in world space
-        const FVector VelocityNormal = Velocity.GetSafeNormal2D();
-        
-        // Get character forward and right vectors
-        const FVector Forward = OwnerCharacter->GetActorForwardVector();
-        const FVector Right = OwnerCharacter->GetActorRightVector();
-        
-        // Calculate dot products to determine direction
-        const float ForwardDot = FVector::DotProduct(VelocityNormal, Forward);
-        const float RightDot = FVector::DotProduct(VelocityNormal, Right);
-        
-        // Convert to angle (-180 to 180 degrees)
-        // Atan2 gives us the angle, then convert to degrees
-        Direction = FMath::RadiansToDegrees(FMath::Atan2(RightDot, ForwardDot));
+        // Angle of movement relative to character facing (-180 to 180 degrees)
+        Direction = CombatHelpers::RelativeYawDegrees(Velocity.GetSafeNormal2D(), Snapshot.Forward, Snapshot.Right);
     }
     else
     {
@@ -96,15 +158,12 @@ void USamuraiAnimInstance::UpdateMovement()
     }
 
     // Check if in air
-    bIsInAir = MovementComponent->IsFalling();
-
-    // Determine if in combat stance (attacking or recently attacked)
-    bIsInCombat = bIsAttacking || bIsBlocking || bIsGuardBroken;
+    bIsInAir = Snapshot.bIsFalling;
 }
 
 void USamuraiAnimInstance::UpdateCombatState()
 {
-    if (!CombatComponent)
+    if (!Snapshot.bHasCombat)
     {
         CombatState = ECombatState::Idle;
         CurrentPhase = EAttackPhase::None;
@@ -112,50 +171,95 @@ void USamuraiAnimInstance::UpdateCombatState()
         bIsBlocking = false;
         bIsGuardBroken = false;
         bIsHoldingAttack = false;
+        bIsInCombat = false;
+        AppliedVersions.State = MAX_uint32;
         return;
     }
 
-    // Sync state from combat component
-    CombatState = CombatComponent->GetCombatState();
-    CurrentPhase = CombatComponent->GetCurrentPhase();
-    bIsAttacking = CombatComponent->IsAttacking();
-    bIsBlocking = CombatComponent->IsBlocking();
-    bIsGuardBroken = CombatComponent->IsGuardBroken();
-    bIsHoldingAttack = CombatComponent->IsHolding();
+    // Skip when the published state block is unchanged
+    const FCombatAnimState& Combat = Snapshot.Combat;
+    if (Combat.StateVersion == AppliedVersions.State)
+    {
+        return;
+    }
+    AppliedVersions.State = Combat.StateVersion;
+
+    // Sync state from combat component snapshot
+    CombatState = Combat.CombatState;
+    CurrentPhase = Combat.CurrentPhase;
+    bIsAttacking = Combat.bIsAttacking;
+    bIsBlocking = Combat.bIsBlocking;
+    bIsGuardBroken = Combat.bIsGuardBroken;
+    bIsHoldingAttack = Combat.bIsHolding;
+
+    // Determine if in combat stance (attacking or recently attacked)
+    bIsInCombat = bIsAttacking || bIsBlocking || bIsGuardBroken;
 }
 
 void USamuraiAnimInstance::UpdateCombo()
 {
-    if (!CombatComponent)
+    if (!Snapshot.bHasCombat)
     {
         ComboCount = 0;
         bCanCombo = false;
+        AppliedVersions.Combo = MAX_uint32;
+        return;
+    }
+
+    if (Snapshot.Combat.ComboVersion == AppliedVersions.Combo)
+    {
         return;
     }
+    AppliedVersions.Combo = Snapshot.Combat.ComboVersion;
 
-    ComboCount = CombatComponent->GetComboCount();
-    bCanCombo = CombatComponent->CanCombo();
+    ComboCount = Snapshot.Combat.ComboCount;
+    bCanCombo = Snapshot.Combat.bCanCombo;
 }
 
 void USamuraiAnimInstance::UpdatePosture()
 {
-    if (!CombatComponent)
+    if (!Snapshot.bHasCombat)
     {
         PosturePercent = 1.0f;
         bIsPostureLow = false;
+        AppliedVersions.Posture = MAX_uint32;
+        return;
+    }
+
+    if (Snapshot.Combat.PostureVersion == AppliedVersions.Posture)
+    {
         return;
     }
+    AppliedVersions.Posture = Snapshot.Combat.PostureVersion;
 
-    PosturePercent = CombatComponent->GetPosturePercent();
+    PosturePercent = Snapshot.Combat.PosturePercent;
     bIsPostureLow = (PosturePercent < 0.4f);
 }
 
 void USamuraiAnimInstance::UpdateCharge()
 {
-    if (!CombatComponent)
+    if (!Snapshot.bHasCombat)
     {
         ChargePercent = 0.0f;
         bIsCharging = false;
+        ChargeStage = INDEX_NONE;
+        AppliedVersions.Charge = MAX_uint32;
+        return;
+    }
+
+    if (Snapshot.Combat.ChargeVersion == AppliedVersions.Charge && Snapshot.Combat.StateVersion == AppliedVersions.ChargeState)
+    {
+        return;
+    }
+    AppliedVersions.Charge = Snapshot.Combat.ChargeVersion;
+    AppliedVersions.ChargeState = Snapshot.Combat.StateVersion;
+
+    // Staged hold: progress is published per stage boundary
+    ChargeStage = Snapshot.Combat.ChargeStage;
+    if (Snapshot.Combat.NumChargeStages > 0)
+    {
+        bIsCharging = true;
+        ChargePercent = static_cast<float>(ChargeStage + 1) / Snapshot.Combat.NumChargeStages;
         return;
     }
 
@@ -178,21 +282,31 @@ void USamuraiAnimInstance::UpdateCharge()
 
 void USamuraiAnimInstance::UpdateHitReaction()
 {
-    if (!HitReactionComponent)
+    if (!Snapshot.bHasHitReaction)
     {
         bIsStunned = false;
         HitIntensity = 0.0f;
+        FlinchAlpha = 0.0f;
+        FlinchDirection = EAttackDirection::None;
+        AppliedVersions.HitReaction = MAX_uint32;
+        return;
+    }
+
+    if (Snapshot.HitReactionVersion == AppliedVersions.HitReaction)
+    {
         return;
     }
+    AppliedVersions.HitReaction = Snapshot.HitReactionVersion;
 
-    bIsStunned = HitReactionComponent->IsStunned();
+    bIsStunned = Snapshot.bIsStunned;
+    FlinchAlpha = Snapshot.FlinchAlpha;
+    FlinchDirection = Snapshot.FlinchDirection;
 
     // Calculate hit intensity from remaining stun time
     if (bIsStunned)
     {
-        const float RemainingStun = HitReactionComponent->GetRemainingStunTime();
         // Intensity decreases as stun time runs out (for blend out)
-        HitIntensity = FMath::Clamp(RemainingStun / 0.5f, 0.0f, 1.0f);
+        HitIntensity = FMath::Clamp(Snapshot.RemainingStunTime / 0.5f, 0.0f, 1.0f);
     }
     else
     {
@@ -204,30 +318,39 @@ void USamuraiAnimInstance::UpdateHitReaction()
 // ANIMNOTIFY ROUTING
 // ============================================================================
 
+const FCombatNotifySink& USamuraiAnimInstance::GetCombatNotifySink()
+{
+    if (!CombatNotifySink.bResolved)
+    {
+        CombatNotifySink.Resolve(GetOwningActor());
+    }
+    return CombatNotifySink;
+}
+
 void USamuraiAnimInstance::OnAttackPhaseBegin(EAttackPhase Phase)
 {
-    // Route to ICombatInterface on owner
-    if (OwnerCharacter && OwnerCharacter->Implements<UCombatInterface>())
+    // Route to ICombatInterface on owner (resolved once via notify sink)
+    if (AActor* CombatOwner = GetCombatNotifySink().CombatInterfaceOwner)
     {
-        ICombatInterface::Execute_OnAttackPhaseBegin(OwnerCharacter, Phase);
+        ICombatInterface::Execute_OnAttackPhaseBegin(CombatOwner, Phase);
     }
 }
 
 void USamuraiAnimInstance::OnAttackPhaseEnd(EAttackPhase Phase)
 {
-    // Route to ICombatInterface on owner
-    if (OwnerCharacter && OwnerCharacter->Implements<UCombatInterface>())
+    // Route to ICombatInterface on owner (resolved once via notify sink)
+    if (AActor* CombatOwner = GetCombatNotifySink().CombatInterfaceOwner)
     {
-        ICombatInterface::Execute_OnAttackPhaseEnd(OwnerCharacter, Phase);
+        ICombatInterface::Execute_OnAttackPhaseEnd(CombatOwner, Phase);
     }
 }
 
 void USamuraiAnimInstance::OnAttackPhaseTransition(EAttackPhase NewPhase)
 {
-    // Route to ICombatInterface on owner
-    if (OwnerCharacter && OwnerCharacter->Implements<UCombatInterface>())
+    // Route to ICombatInterface on owner (resolved once via notify sink)
+    if (AActor* CombatOwner = GetCombatNotifySink().CombatInterfaceOwner)
     {
-        ICombatInterface::Execute_OnAttackPhaseTransition(OwnerCharacter, NewPhase);
+        ICombatInterface::Execute_OnAttackPhaseTransition(CombatOwner, NewPhase);
     }
 }
 
@@ -249,18 +372,18 @@ void USamuraiAnimInstance::OnComboWindowClosed()
 
 void USamuraiAnimInstance::OnEnableHitDetection()
 {
-    // Route to ICombatInterface on owner
-    if (OwnerCharacter && OwnerCharacter->Implements<UCombatInterface>())
+    // Route to ICombatInterface on owner (resolved once via notify sink)
+    if (AActor* CombatOwner = GetCombatNotifySink().CombatInterfaceOwner)
     {
-        ICombatInterface::Execute_OnEnableHitDetection(OwnerCharacter);
+        ICombatInterface::Execute_OnEnableHitDetection(CombatOwner);
     }
 }
 
 void USamuraiAnimInstance::OnDisableHitDetection()
 {
-    // Route to ICombatInterface on owner
-    if (OwnerCharacter && OwnerCharacter->Implements<UCombatInterface>())
+    // Route to ICombatInterface on owner (resolved once via notify sink)
+    if (AActor* CombatOwner = GetCombatNotifySink().CombatInterfaceOwner)
     {
-        ICombatInterface::Execute_OnDisableHitDetection(OwnerCharacter);
+        ICombatInterface::Execute_OnDisableHitDetection(CombatOwner);
     }
 }
\ No newline at end of file
@@ -7,28 +7,40 @@
 #include "Core/TargetingComponent.h"
 #include "Core/WeaponComponent.h"
 #include "Core/HitReactionComponent.h"
+#include "Core/HurtboxComponent.h"
+#include "Core/CombatEventChannelComponent.h"
+#include "Core/HitStopSubsystem.h"
+#include "Core/CombatImpactSubsystem.h"
+#include "Core/CombatInputTimingSubsystem.h"
+#include "Core/CombatAnimBudgetSubsystem.h"
 #include "Debug/CombatDebugWidget.h"
+#include "Animation/SamuraiAnimInstance.h"
+#include "Debug/CombatTrace.h"
 #include "Data/AttackData.h"
 #include "Data/CombatSettings.h"
+#include "Data/CombatArchetype.h"
 #include "ActionQueueTypes.h"
 #include "MotionWarpingComponent.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
 
-ASamuraiCharacter::ASamuraiCharacter()
+ASamuraiCharacter::ASamuraiCharacter(const FObjectInitializer& ObjectInitializer)
+    // Budgeted mesh: UCombatAnimBudgetSubsystem decides when its animation may be throttled
+    : Super(ObjectInitializer.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
     PrimaryActorTick.bCanEverTick = true;
 
     // Create combat components
+    COMBAT_LLM_SCOPE(Components);
     CombatComponent = CreateDefaultSubobject<UCombatComponent>(TEXT("CombatComponent"));
-    CombatComponentV2 = CreateDefaultSubobject<UCombatComponentV2>(TEXT("CombatComponentV2"));
-    CombatDebugWidget = CreateDefaultSubobject<UCombatDebugWidget>(TEXT("CombatDebugWidget"));
     TargetingComponent = CreateDefaultSubobject<UTargetingComponent>(TEXT("TargetingComponent"));
     WeaponComponent = CreateDefaultSubobject<UWeaponComponent>(TEXT("WeaponComponent"));
     HitReactionComponent = CreateDefaultSubobject<UHitReactionComponent>(TEXT("HitReactionComponent"));
     MotionWarpingComponent = CreateDefaultSubobject<UMotionWarpingComponent>(TEXT("MotionWarpingComponent"));
+    CombatEventChannel = CreateDefaultSubobject<UCombatEventChannelComponent>(TEXT("CombatEventChannel"));
 
     // Configure character movement (default for third-person combat)
     GetCharacterMovement()->bOrientRotationToMovement = true;
@@ -41,6 +53,84 @@ ASamuraiCharacter::ASamuraiCharacter()
     bUseControllerRotationRoll = false;
 }
 
+void ASamuraiCharacter::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+
+    // Components read shared config from the archetype - must run before their BeginPlay
+    if (CombatArchetype)
+    {
+        if (CombatArchetype->CombatSettings)
+        {
+            CombatSettings = CombatArchetype->CombatSettings;
+        }
+        if (HitReactionComponent)
+        {
+            HitReactionComponent->SetArchetype(CombatArchetype);
+        }
+        if (TargetingComponent)
+        {
+            TargetingComponent->SetArchetype(CombatArchetype);
+        }
+    }
+
+    // Settings are final now (archetype applied) - build only the combat stack they select
+    SelectCombatBackend();
+}
+
+void ASamuraiCharacter::SelectCombatBackend()
+{
+    const bool bWantsV2 = CombatSettings && CombatSettings->bUseV2System;
+    if (bWantsV2 == (CombatComponentV2 != nullptr))
+    {
+        return;
+    }
+
+    if (bWantsV2)
+    {
+        COMBAT_LLM_SCOPE(Components);
+        {
+            // V2 is mostly its inline action queue
+            COMBAT_LLM_SCOPE(ActionQueue);
+            CombatComponentV2 = NewObject<UCombatComponentV2>(this, TEXT("CombatComponentV2"));
+        }
+        CombatDebugWidget = NewObject<UCombatDebugWidget>(this, TEXT("CombatDebugWidget"));
+
+        // Created by name on every machine from the same settings, so the input RPCs resolve without replicating the component
+        CombatComponentV2->SetNetAddressable();
+
+        // V2 first: the widget looks it up in BeginPlay
+        CombatComponentV2->RegisterComponent();
+        CombatDebugWidget->RegisterComponent();
+    }
+    else
+    {
+        // Free the names for a later switch back
+        for (UActorComponent* Component : TArray<UActorComponent*>{ CombatDebugWidget, CombatComponentV2 })
+        {
+            if (Component)
+            {
+                Component->DestroyComponent();
+                Component->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_NonTransactional);
+            }
+        }
+        CombatComponentV2 = nullptr;
+        CombatDebugWidget = nullptr;
+    }
+
+    // Notifies dispatch to a sink resolved against the previous stack
+    if (USamuraiAnimInstance* SamuraiAnim = GetMesh() ? Cast<USamuraiAnimInstance>(GetMesh()->GetAnimInstance()) : nullptr)
+    {
+        SamuraiAnim->InvalidateCombatNotifySink();
+    }
+
+    // A V2 stack registered after BeginPlay came with tick functions of its own
+    if (HasActorBegunPlay())
+    {
+        AggregateCombatTicks();
+    }
+}
+
 void ASamuraiCharacter::BeginPlay()
 {
     Super::BeginPlay();
@@ -60,8 +150,17 @@ void ASamuraiCharacter::BeginPlay()
     // Bind to weapon hit event for damage processing
     if (WeaponComponent)
     {
-        WeaponComponent->OnWeaponHit.AddDynamic(this, &ASamuraiCharacter::OnWeaponHitTarget);
+        WeaponComponent->OnWeaponHitNative.AddUObject(this, &ASamuraiCharacter::OnWeaponHitTarget);
+    }
+
+    // Mesh registered itself with the allocator in its own BeginPlay
+    if (UCombatAnimBudgetSubsystem* AnimBudget = GetWorld()->GetSubsystem<UCombatAnimBudgetSubsystem>())
+    {
+        AnimBudget->RegisterMesh(GetMesh());
     }
+
+    // Components registered their tick functions in their own BeginPlay
+    AggregateCombatTicks();
 }
 
 void ASamuraiCharacter::Tick(float DeltaTime)
@@ -69,6 +168,75 @@ void ASamuraiCharacter::Tick(float DeltaTime)
     Super::Tick(DeltaTime);
 }
 
+void ASamuraiCharacter::RegisterActorTickFunctions(bool bRegister)
+{
+    Super::RegisterActorTickFunctions(bRegister);
+
+    if (bRegister)
+    {
+        if (bLatchCombatInput && !InputLatchTickFunction.IsTickFunctionRegistered())
+        {
+            InputLatchTickFunction.Target = this;
+            InputLatchTickFunction.bCanEverTick = true;
+            InputLatchTickFunction.TickGroup = TG_PrePhysics;
+            InputLatchTickFunction.RegisterTickFunction(GetLevel());
+
+            // Animation evaluates after the latched inputs have started their montages
+            if (USkeletalMeshComponent* CharacterMesh = GetMesh())
+            {
+                CharacterMesh->PrimaryComponentTick.AddPrerequisite(this, InputLatchTickFunction);
+            }
+
+            UpdateInputLatch();
+        }
+
+        if (bAggregateCombatTick && !CombatAggregateTickFunction.IsTickFunctionRegistered())
+        {
+            CombatAggregateTickFunction.Target = this;
+            CombatAggregateTickFunction.bCanEverTick = true;
+            CombatAggregateTickFunction.TickGroup = TG_DuringPhysics;
+            CombatAggregateTickFunction.RegisterTickFunction(GetLevel());
+
+            // Components tick after their owner
+            if (PrimaryActorTick.bCanEverTick)
+            {
+                CombatAggregateTickFunction.AddPrerequisite(this, PrimaryActorTick);
+            }
+        }
+        return;
+    }
+
+    if (CombatAggregateTickFunction.IsTickFunctionRegistered())
+    {
+        CombatAggregateTickFunction.RemovePrerequisite(this, PrimaryActorTick);
+        CombatAggregateTickFunction.UnRegisterTickFunction();
+    }
+
+    if (InputLatchTickFunction.IsTickFunctionRegistered())
+    {
+        if (USkeletalMeshComponent* CharacterMesh = GetMesh())
+        {
+            CharacterMesh->PrimaryComponentTick.RemovePrerequisite(this, InputLatchTickFunction);
+        }
+
+        if (AController* LatchController = InputLatchController.Get())
+        {
+            InputLatchTickFunction.RemovePrerequisite(LatchController, LatchController->PrimaryActorTick);
+        }
+        InputLatchController.Reset();
+
+        InputLatchTickFunction.UnRegisterTickFunction();
+        LatchedInputs.Reset();
+    }
+}
+
+void ASamuraiCharacter::NotifyControllerChanged()
+{
+    Super::NotifyControllerChanged();
+
+    UpdateInputLatch();
+}
+
 void ASamuraiCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
     Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -130,14 +298,8 @@ void ASamuraiCharacter::Move(const FInputActionValue& Value)
 {
     const FVector2D MovementVector = Value.Get<FVector2D>();
 
-    // Cache for directional input (used by attack handlers)
-    LastMovementInput = MovementVector;
-
-    // Forward movement input to combat component for directional attacks
-    if (CombatComponent)
-    {
-        CombatComponent->SetMovementInput(MovementVector);
-    }
+    // Feed the per-frame directional input sample (attack handlers and combat components read it)
+    RecordMovementInput(MovementVector);
 
     if (Controller && !MovementVector.IsZero())
     {
@@ -168,97 +330,154 @@ void ASamuraiCharacter::Look(const FInputActionValue& Value)
     }
 }
 
-void ASamuraiCharacter::OnLightAttackStarted(const FInputActionValue& Value)
+void ASamuraiCharacter::SubmitCombatInput(EInputType InputType, EInputEventType EventType, EInputDirection Direction, double InputPlatformTime)
 {
-    // Check CombatSettings for V2 system enabled
-    if (CombatSettings && CombatSettings->bUseV2System && CombatComponentV2)
+    // V2 only exists when CombatSettings selected it (SelectCombatBackend)
+    if (CombatComponentV2)
     {
-        // Convert current movement input to directional input
-        EInputDirection Direction = GetDirectionalInputFromMovement(LastMovementInput);
-        CombatComponentV2->OnInputEvent(EInputType::LightAttack, EInputEventType::Press, Direction);
+        CombatComponentV2->OnInputEvent(InputType, EventType, Direction, InputPlatformTime);
+        return;
     }
-    else if (CombatComponent)
+
+    if (!CombatComponent)
     {
-        CombatComponent->OnLightAttackPressed();
+        return;
     }
-}
 
-void ASamuraiCharacter::OnLightAttackCompleted(const FInputActionValue& Value)
-{
-    if (CombatSettings && CombatSettings->bUseV2System && CombatComponentV2)
+    const bool bPressed = EventType == EInputEventType::Press;
+    switch (InputType)
     {
-        // Convert current movement input to directional input
-        EInputDirection Direction = GetDirectionalInputFromMovement(LastMovementInput);
-        CombatComponentV2->OnInputEvent(EInputType::LightAttack, EInputEventType::Release, Direction);
+        case EInputType::LightAttack:
+            bPressed ? CombatComponent->OnLightAttackPressed() : CombatComponent->OnLightAttackReleased();
+            break;
+        case EInputType::HeavyAttack:
+            bPressed ? CombatComponent->OnHeavyAttackPressed() : CombatComponent->OnHeavyAttackReleased();
+            break;
+        case EInputType::Block:
+            if (bPressed)
+            {
+                // Parry is judged against when the press happened, not when this frame processed it
+                const UCombatInputTimingSubsystem* InputTiming = GetWorld() ? GetWorld()->GetSubsystem<UCombatInputTimingSubsystem>() : nullptr;
+                CombatComponent->OnBlockPressed(InputTiming && InputPlatformTime > 0.0 ? InputTiming->PlatformTimeToWorldTime(InputPlatformTime) : -1.0f);
+            }
+            else
+            {
+                CombatComponent->OnBlockReleased();
+            }
+            break;
+        case EInputType::Evade:
+            if (bPressed)
+            {
+                CombatComponent->OnEvadePressed();
+            }
+            break;
+        default:
+            break;
     }
-    else if (CombatComponent)
+}
+
+void ASamuraiCharacter::LatchCombatInput(EInputType InputType, EInputEventType EventType, EInputDirection Direction, double InputPlatformTime)
+{
+    // Inputs arriving after the stage ran this frame (or with it off) would only wait longer by being held
+    if (!bLatchCombatInput || !CombatComponentV2 || !IsInputLatchActive() || LastInputLatchFrame == GFrameCounter)
     {
-        CombatComponent->OnLightAttackReleased();
+        SubmitCombatInput(InputType, EventType, Direction, InputPlatformTime);
+        return;
     }
+
+    FCombatInputCommand& Command = LatchedInputs.AddDefaulted_GetRef();
+    Command.Component = CombatComponentV2;
+    Command.InputType = InputType;
+    Command.EventType = EventType;
+    Command.Direction = Direction;
+    Command.PlatformTime = InputPlatformTime;
 }
 
-void ASamuraiCharacter::OnHeavyAttackStarted(const FInputActionValue& Value)
+void ASamuraiCharacter::ProcessLatchedInputs()
 {
-    if (CombatSettings && CombatSettings->bUseV2System && CombatComponentV2)
+    LastInputLatchFrame = GFrameCounter;
+    if (LatchedInputs.Num() == 0)
     {
-        // Convert current movement input to directional input
-        EInputDirection Direction = GetDirectionalInputFromMovement(LastMovementInput);
-        CombatComponentV2->OnInputEvent(EInputType::HeavyAttack, EInputEventType::Press, Direction);
+        return;
     }
-    else if (CombatComponent)
+
+    // Swap out in case an input's handlers feed more input
+    TArray<FCombatInputCommand, TInlineAllocator<4>> Inputs = MoveTemp(LatchedInputs);
+    LatchedInputs.Reset();
+
+    for (const FCombatInputCommand& Command : Inputs)
     {
-        CombatComponent->OnHeavyAttackPressed();
+        SubmitCombatInput(Command.InputType, Command.EventType, Command.Direction, Command.PlatformTime);
     }
 }
 
-void ASamuraiCharacter::OnHeavyAttackCompleted(const FInputActionValue& Value)
+void ASamuraiCharacter::UpdateInputLatch()
 {
-    if (CombatSettings && CombatSettings->bUseV2System && CombatComponentV2)
+    if (!InputLatchTickFunction.IsTickFunctionRegistered())
     {
-        // Convert current movement input to directional input
-        EInputDirection Direction = GetDirectionalInputFromMovement(LastMovementInput);
-        CombatComponentV2->OnInputEvent(EInputType::HeavyAttack, EInputEventType::Release, Direction);
+        return;
     }
-    else if (CombatComponent)
+
+    // Only local players' inputs come through the controller's input processing
+    AController* LatchController = IsPlayerControlled() && IsLocallyControlled() ? GetController() : nullptr;
+    if (InputLatchController.Get() != LatchController)
     {
-        CombatComponent->OnHeavyAttackReleased();
+        if (AController* PreviousLatchController = InputLatchController.Get())
+        {
+            InputLatchTickFunction.RemovePrerequisite(PreviousLatchController, PreviousLatchController->PrimaryActorTick);
+        }
+
+        if (LatchController)
+        {
+            InputLatchTickFunction.AddPrerequisite(LatchController, LatchController->PrimaryActorTick);
+        }
+
+        InputLatchController = LatchController;
+    }
+
+    InputLatchTickFunction.SetTickFunctionEnable(LatchController != nullptr);
+
+    // Nothing will drain what the last controller left behind
+    if (!LatchController)
+    {
+        ProcessLatchedInputs();
     }
 }
 
+void ASamuraiCharacter::OnLightAttackStarted(const FInputActionValue& Value)
+{
+    // Convert current movement input to directional input
+    LatchCombatInput(EInputType::LightAttack, EInputEventType::Press, GetDirectionalInput().Direction8, GetInputPlatformTime(LightAttackAction, true));
+}
+
+void ASamuraiCharacter::OnLightAttackCompleted(const FInputActionValue& Value)
+{
+    LatchCombatInput(EInputType::LightAttack, EInputEventType::Release, GetDirectionalInput().Direction8, GetInputPlatformTime(LightAttackAction, false));
+}
+
+void ASamuraiCharacter::OnHeavyAttackStarted(const FInputActionValue& Value)
+{
+    LatchCombatInput(EInputType::HeavyAttack, EInputEventType::Press, GetDirectionalInput().Direction8, GetInputPlatformTime(HeavyAttackAction, true));
+}
+
+void ASamuraiCharacter::OnHeavyAttackCompleted(const FInputActionValue& Value)
+{
+    LatchCombatInput(EInputType::HeavyAttack, EInputEventType::Release, GetDirectionalInput().Direction8, GetInputPlatformTime(HeavyAttackAction, false));
+}
+
 void ASamuraiCharacter::OnBlockStarted(const FInputActionValue& Value)
 {
-    if (CombatSettings && CombatSettings->bUseV2System && CombatComponentV2)
-    {
-        CombatComponentV2->OnInputEvent(EInputType::Block, EInputEventType::Press);
-    }
-    else if (CombatComponent)
-    {
-        CombatComponent->OnBlockPressed();
-    }
+    LatchCombatInput(EInputType::Block, EInputEventType::Press, EInputDirection::None, GetInputPlatformTime(BlockAction, true));
 }
 
 void ASamuraiCharacter::OnBlockCompleted(const FInputActionValue& Value)
 {
-    if (CombatSettings && CombatSettings->bUseV2System && CombatComponentV2)
-    {
-        CombatComponentV2->OnInputEvent(EInputType::Block, EInputEventType::Release);
-    }
-    else if (CombatComponent)
-    {
-        CombatComponent->OnBlockReleased();
-    }
+    LatchCombatInput(EInputType::Block, EInputEventType::Release, EInputDirection::None, GetInputPlatformTime(BlockAction, false));
 }
 
 void ASamuraiCharacter::OnEvadeStarted(const FInputActionValue& Value)
 {
-    if (CombatSettings && CombatSettings->bUseV2System && CombatComponentV2)
-    {
-        CombatComponentV2->OnInputEvent(EInputType::Evade, EInputEventType::Press);
-    }
-    else if (CombatComponent)
-    {
-        CombatComponent->OnEvadePressed();
-    }
+    LatchCombatInput(EInputType::Evade, EInputEventType::Press, EInputDirection::None, GetInputPlatformTime(EvadeAction, true));
 }
 
 void ASamuraiCharacter::OnToggleDebug(const FInputActionValue& Value)
@@ -338,8 +557,8 @@ void ASamuraiCharacter::OnAttackPhaseTransition_Implementation(EAttackPhase NewP
         CombatComponent->OnAttackPhaseTransition(NewPhase);
     }
 
-    // Also forward to V2 if enabled
-    if (CombatSettings && CombatSettings->bUseV2System && CombatComponentV2)
+    // Also forward to V2 if it is the active stack
+    if (CombatComponentV2)
     {
         CombatComponentV2->OnPhaseTransition(NewPhase);
     }
@@ -350,10 +569,15 @@ bool ASamuraiCharacter::IsInParryWindow_Implementation() const
     return CombatComponent ? CombatComponent->IsInParryWindow() : false;
 }
 
+const FCombatQuerySnapshot* ASamuraiCharacter::GetCombatQuerySnapshot() const
+{
+    return CombatComponent ? &CombatComponent->GetQuerySnapshot() : nullptr;
+}
+
 void ASamuraiCharacter::OnHoldWindowStart_Implementation(EInputType InputType)
 {
-    // V2-only feature - forward to V2 system if enabled
-    if (CombatSettings && CombatSettings->bUseV2System && CombatComponentV2)
+    // V2-only feature - forward to V2 system if it is the active stack
+    if (CombatComponentV2)
     {
         CombatComponentV2->OnHoldWindowStart(InputType);
     }
@@ -382,7 +606,8 @@ float ASamuraiCharacter::ApplyDamage_Implementation(const FHitReactionInfo& HitI
             return HitReactionComponent->ApplyDamage(HitInfo);
         }
         
-        // Successfully blocked
+        // Successfully blocked - still part of this frame's hit aggregate
+        HitReactionComponent->RecordBlockedHit(HitInfo, PostureDamage);
         return 0.0f;
     }
 
@@ -479,114 +704,268 @@ bool ASamuraiCharacter::IsInCounterWindow_Implementation() const
 }
 
 // ============================================================================
-// WEAPON HIT PROCESSING
+// LATCHED INPUT STAGE
 // ============================================================================
 
+void FCombatInputLatchTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Target && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Target->ProcessLatchedInputs();
+    }
+}
 
-void ASamuraiCharacter::OnWeaponHitTarget(AActor* HitActor, const FHitResult& HitResult, UAttackData* AttackData)
-{ 
-    if (!HitActor || !AttackData)
+FString FCombatInputLatchTickFunction::DiagnosticMessage()
+{
+    return Target ? FString::Printf(TEXT("%s[LatchCombatInput]"), *Target->GetFullName()) : TEXT("ASamuraiCharacter::ProcessLatchedInputs");
+}
+
+// ============================================================================
+// AGGREGATED COMBAT TICK
+// ============================================================================
+
+void ASamuraiCharacter::AggregateCombatTicks()
+{
+    if (!CombatAggregateTickFunction.IsTickFunctionRegistered())
     {
         return;
     }
 
-    // Check if target implements IDamageableInterface
-    if (HitActor->Implements<UDamageableInterface>())
+    // Rebuilt in update order; components already held keep their slot (and pending time), destroyed ones drop out
+    const TArray<FAggregatedCombatTick, TInlineAllocator<4>> PreviousTicks = MoveTemp(AggregatedCombatTicks);
+    AggregatedCombatTicks.Reset();
+
+    for (UActorComponent* Component : TArray<UActorComponent*, TInlineAllocator<4>>{ CombatComponent, CombatComponentV2, TargetingComponent, CombatDebugWidget })
     {
+        if (!IsValid(Component))
+        {
+            continue;
+        }
 
-        
-        // Build hit reaction info
-        FHitReactionInfo HitInfo;
-        HitInfo.Attacker = this;
-        HitInfo.HitDirection = (HitActor->GetActorLocation() - GetActorLocation()).GetSafeNormal();
-        HitInfo.AttackData = AttackData;
-        HitInfo.Damage = AttackData->BaseDamage;
-        HitInfo.StunDuration = AttackData->HitStunDuration;
-        HitInfo.bWasCounter = CombatComponent ? CombatComponent->IsInCounterWindow() : false;
-        HitInfo.ImpactPoint = HitResult.ImpactPoint;
-
-        // Apply counter damage multiplier if applicable
-        if (HitInfo.bWasCounter && IDamageableInterface::Execute_IsInCounterWindow(HitActor))
+        const FAggregatedCombatTick* PreviousTick = PreviousTicks.FindByPredicate([Component](const FAggregatedCombatTick& Tick) { return Tick.Component == Component; });
+        FActorComponentTickFunction& ComponentTick = Component->PrimaryComponentTick;
+
+        // Only take over ticks the engine registered, that would have run in our group anyway
+        if (!PreviousTick && (!ComponentTick.IsTickFunctionRegistered() || ComponentTick.TickGroup != CombatAggregateTickFunction.TickGroup || ComponentTick.bTickEvenWhenPaused))
         {
-            HitInfo.Damage *= AttackData->CounterDamageMultiplier;
+            continue;
+        }
+
+        // Unregistered, the enabled flag is kept and SetComponentTickEnabled only updates it
+        if (ComponentTick.IsTickFunctionRegistered())
+        {
+            ComponentTick.UnRegisterTickFunction();
         }
 
-        // Apply damage via interface
-        const float DamageDealt = IDamageableInterface::Execute_ApplyDamage(HitActor, HitInfo);
+        AggregatedCombatTicks.Add(PreviousTick ? *PreviousTick : FAggregatedCombatTick{ Component });
+    }
+}
 
-        // Broadcast hit event
-        if (CombatComponent)
+void ASamuraiCharacter::TickCombatComponents(float DeltaTime, ELevelTick TickType)
+{
+    COMBAT_TRACE_SCOPE(ASamuraiCharacter::TickCombatComponents);
+
+    for (FAggregatedCombatTick& AggregatedTick : AggregatedCombatTicks)
+    {
+        UActorComponent* Component = AggregatedTick.Component;
+        if (!IsValid(Component) || !Component->IsRegistered())
+        {
+            continue;
+        }
+
+        // Re-registering the actor's ticks (level streaming) re-registers the component's as well: take it back
+        FActorComponentTickFunction& ComponentTick = Component->PrimaryComponentTick;
+        if (ComponentTick.IsTickFunctionRegistered())
         {
-            CombatComponent->OnAttackHit.Broadcast(HitActor, DamageDealt);
+            ComponentTick.UnRegisterTickFunction();
         }
+
+        // Nothing to do this frame
+        if (!ComponentTick.IsTickFunctionEnabled())
+        {
+            AggregatedTick.PendingDeltaTime = 0.0f;
+            continue;
+        }
+
+        // Targeting's warp tracking runs at an interval
+        AggregatedTick.PendingDeltaTime += DeltaTime;
+        if (AggregatedTick.PendingDeltaTime < ComponentTick.TickInterval)
+        {
+            continue;
+        }
+
+        const float ComponentDeltaTime = AggregatedTick.PendingDeltaTime;
+        AggregatedTick.PendingDeltaTime = 0.0f;
+        Component->TickComponent(ComponentDeltaTime, TickType, &ComponentTick);
     }
 }
 
+void FCombatAggregateTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Target && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Target->TickCombatComponents(DeltaTime, TickType);
+    }
+}
+
+FString FCombatAggregateTickFunction::DiagnosticMessage()
+{
+    return Target ? FString::Printf(TEXT("%s[AggregateCombatTick]"), *Target->GetFullName()) : TEXT("ASamuraiCharacter::TickCombatComponents");
+}
+
 // ============================================================================
-// DIRECTIONAL INPUT HELPERS
+// WEAPON HIT PROCESSING
 // ============================================================================
 
-EInputDirection ASamuraiCharacter::GetDirectionalInputFromMovement(const FVector2D& MovementVector) const
-{
-    // Minimum magnitude threshold to register directional input (deadzone)
-    constexpr float MinMagnitude = 0.25f;
 
-    // Check if input is below deadzone threshold
-    if (MovementVector.SizeSquared() < MinMagnitude * MinMagnitude)
+void ASamuraiCharacter::OnWeaponHitTarget(AActor* HitActor, const FHitResult& HitResult, UAttackData* AttackData)
+{ 
+    if (!HitActor || !AttackData)
     {
-        return EInputDirection::None;
+        return;
     }
 
-    // Calculate angle in degrees (0° = right, 90° = forward, 180° = left, 270° = backward)
-    // Note: FVector2D(X, Y) where X = right, Y = forward
-    float Angle = FMath::Atan2(MovementVector.Y, MovementVector.X) * (180.0f / PI);
+    // Damage route: duel opponent (cached pair), else the route resolved when the target entered the
+    // weapon's swing registry (resolved here if the hit was reported some other way)
+    FWeaponHitTarget Target;
+    if (ASamuraiCharacter* DuelOpponent = CombatComponent && CombatComponent->IsDuelOpponent(HitActor) ? CombatComponent->GetDuelOpponent() : nullptr)
+    {
+        Target.NativeDamageable = DuelOpponent;
+    }
+    else if (const FWeaponHitTarget* CachedTarget = WeaponComponent ? WeaponComponent->GetHitTarget(HitActor) : nullptr)
+    {
+        Target = *CachedTarget;
+    }
+    else
+    {
+        Target = FWeaponHitTarget::Resolve(HitActor);
+    }
 
-    // Normalize to [0, 360) range
-    if (Angle < 0)
+    if (!Target.IsDamageable())
     {
-        Angle += 360.0f;
+        return;
+    }
+
+    // Build hit reaction info
+    FHitReactionInfo HitInfo;
+    HitInfo.Attacker = this;
+    HitInfo.HitDirection = (HitActor->GetActorLocation() - GetActorLocation()).GetSafeNormal();
+    HitInfo.AttackData = AttackData;
+    HitInfo.Damage = AttackData->BaseDamage;
+    HitInfo.StunDuration = AttackData->HitStunDuration;
+    HitInfo.bWasCounter = CombatComponent ? CombatComponent->IsInCounterWindow() : false;
+    HitInfo.ImpactPoint = HitResult.ImpactPoint;
+
+    // Damage zone from the hurtbox the sweep landed on
+    if (const UHurtboxComponent* Hurtbox = UHurtboxComponent::FromHit(HitResult))
+    {
+        HitInfo.HitZone = Hurtbox->Zone;
+        HitInfo.Damage *= Hurtbox->DamageMultiplier;
+    }
+
+    // Apply counter damage multiplier if applicable (native targets called directly, Blueprint ones via Execute_)
+    if (HitInfo.bWasCounter)
+    {
+        const bool bTargetInCounterWindow = Target.NativeDamageable ? Target.NativeDamageable->IsInCounterWindow_Implementation()
+            : Target.bBlueprintDamageable && IDamageableInterface::Execute_IsInCounterWindow(HitActor);
+        if (bTargetInCounterWindow)
+        {
+            HitInfo.Damage *= AttackData->CounterDamageMultiplier;
+        }
     }
 
-    // Convert angle to 8-way directional input
-    // Each direction covers a 45° slice (22.5° on each side of cardinal/diagonal)
-    // Right: 337.5° - 22.5° (0°)
-    if (Angle >= 337.5f || Angle < 22.5f)
+    // Apply damage
+    float DamageDealt = 0.0f;
+    if (Target.NativeDamageable)
     {
-        return EInputDirection::Right;
+        DamageDealt = Target.NativeDamageable->ApplyDamage_Implementation(HitInfo);
     }
-    // ForwardRight: 22.5° - 67.5° (45°)
-    else if (Angle >= 22.5f && Angle < 67.5f)
+    else if (Target.bBlueprintDamageable)
     {
-        return EInputDirection::ForwardRight;
+        DamageDealt = IDamageableInterface::Execute_ApplyDamage(HitActor, HitInfo);
     }
-    // Forward: 67.5° - 112.5° (90°)
-    else if (Angle >= 67.5f && Angle < 112.5f)
+    else
     {
-        return EInputDirection::Forward;
+        DamageDealt = Target.HitReaction->ApplyDamage(HitInfo);
     }
-    // ForwardLeft: 112.5° - 157.5° (135°)
-    else if (Angle >= 112.5f && Angle < 157.5f)
+
+    // Broadcast hit event
+    if (CombatComponent)
     {
-        return EInputDirection::ForwardLeft;
+        CombatComponent->OnAttackHitNative.Broadcast(HitActor, DamageDealt);
+        CombatComponent->OnAttackHit.Broadcast(HitActor, DamageDealt);
     }
-    // Left: 157.5° - 202.5° (180°)
-    else if (Angle >= 157.5f && Angle < 202.5f)
+
+    // Hit-stop on both sides (merged and applied once per frame by the subsystem)
+    const float HitStopDuration = AttackData->HitStopDuration >= 0.0f ? AttackData->HitStopDuration : (CombatSettings ? CombatSettings->HitStopDuration : 0.0f);
+    UHitStopSubsystem* HitStop = GetWorld()->GetSubsystem<UHitStopSubsystem>();
+    if (HitStop && HitStopDuration > 0.0f)
     {
-        return EInputDirection::Left;
+        const float Dilation = CombatSettings ? CombatSettings->HitStopTimeDilation : 0.05f;
+        HitStop->RequestHitStop(this, HitStopDuration, Dilation);
+        HitStop->RequestHitStop(HitActor, HitStopDuration, Dilation);
     }
-    // BackwardLeft: 202.5° - 247.5° (225°)
-    else if (Angle >= 202.5f && Angle < 247.5f)
+
+    // Impact VFX/audio (merged with the frame's other hits by the subsystem)
+    if (UCombatImpactSubsystem* Impacts = GetWorld()->GetSubsystem<UCombatImpactSubsystem>())
     {
-        return EInputDirection::BackwardLeft;
+        Impacts->QueueImpact(HitResult, AttackData, CombatSettings);
     }
-    // Backward: 247.5° - 292.5° (270°)
-    else if (Angle >= 247.5f && Angle < 292.5f)
+
+    // Replicate to remote machines (no-op outside a networked server)
+    if (CombatEventChannel)
     {
-        return EInputDirection::Backward;
+        CombatEventChannel->QueueHitEvent(HitActor, HitInfo.ImpactPoint, HitInfo.HitDirection, AttackData, DamageDealt);
     }
-    // BackwardRight: 292.5° - 337.5° (315°)
-    else // Angle >= 292.5f && Angle < 337.5f
+}
+
+// ============================================================================
+// DIRECTIONAL INPUT HELPERS
+// ============================================================================
+
+const FCombatDirectionalInput& ASamuraiCharacter::GetDirectionalInput() const
+{
+    if (DirectionalInputSample.FrameNumber != GFrameCounter)
     {
-        return EInputDirection::BackwardRight;
+        // Input not refreshed since last frame means the stick was released
+        const FVector2D RawInput = GFrameCounter - LastMovementInputFrame <= 1 ? LastMovementInput : FVector2D::ZeroVector;
+        const FRotator ControlRotation = Controller ? Controller->GetControlRotation() : GetActorRotation();
+
+        DirectionalInputSample = FCombatDirectionalInput::Build(RawInput, ControlRotation, GetActorForwardVector(), GetActorRightVector());
+        DirectionalInputSample.FrameNumber = GFrameCounter;
     }
+    return DirectionalInputSample;
+}
+
+void ASamuraiCharacter::RecordMovementInput(const FVector2D& MovementVector)
+{
+    LastMovementInput = MovementVector;
+    LastMovementInputFrame = GFrameCounter;
+
+    // Resample on the next read (input can arrive after an earlier read this frame)
+    DirectionalInputSample.FrameNumber = 0;
+}
+
+double ASamuraiCharacter::GetInputPlatformTime(const UInputAction* Action, bool bPressed) const
+{
+    const APlayerController* PlayerController = Cast<APlayerController>(GetController());
+    const UCombatInputTimingSubsystem* InputTiming = GetWorld() ? GetWorld()->GetSubsystem<UCombatInputTimingSubsystem>() : nullptr;
+    if (!Action || !PlayerController || !InputTiming)
+    {
+        return 0.0;
+    }
+
+    const UEnhancedInputLocalPlayerSubsystem* InputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer());
+    if (!InputSubsystem)
+    {
+        return 0.0;
+    }
+
+    // Whichever mapped key changed most recently is the one that fired the action
+    return InputTiming->GetLatestKeyEventTime(InputSubsystem->QueryKeysMappedToAction(Action), bPressed);
+}
+
+EInputDirection ASamuraiCharacter::GetDirectionalInputFromMovement(const FVector2D& MovementVector) const
+{
+    return CombatHelpers::VectorToInputDirection(MovementVector, FCombatDirectionalInput::DeadZone);
 }
\ No newline at end of file
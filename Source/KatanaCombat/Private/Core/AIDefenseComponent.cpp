@@ -0,0 +1,214 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/AIDefenseComponent.h"
+#include "Core/AIDefenseSubsystem.h"
+#include "Characters/SamuraiCharacter.h"
+#include "ActionQueueTypes.h"
+#include "Engine/World.h"
+
+UAIDefenseComponent::UAIDefenseComponent()
+{
+    // Entirely timer-driven
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UAIDefenseComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (UAIDefenseSubsystem* DefenseSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UAIDefenseSubsystem>() : nullptr)
+    {
+        DefenseSubsystem->RegisterDefender(this);
+    }
+}
+
+void UAIDefenseComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    CancelPendingDefense();
+
+    if (UAIDefenseSubsystem* DefenseSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UAIDefenseSubsystem>() : nullptr)
+    {
+        DefenseSubsystem->UnregisterDefender(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+// ============================================================================
+// SCHEDULING
+// ============================================================================
+
+void UAIDefenseComponent::OnAttackStarted(AActor* Attacker, TConstArrayView<FTimerCheckpoint> Checkpoints, float MontagePosition, float PlayRate)
+{
+    UCombatTimerWheelSubsystem* TimerWheel = GetWorld() ? GetWorld()->GetSubsystem<UCombatTimerWheelSubsystem>() : nullptr;
+    if (!bDefenseEnabled || !Attacker || !TimerWheel)
+    {
+        return;
+    }
+
+    const FAIDefensePlan Plan = PlanDefense(RollDefenseAction(), Checkpoints, MontagePosition, PlayRate);
+
+    // Combo follow-up while already guarding: keep the block up through the next strike
+    if (bBlockHeld && Plan.Action == EAIDefenseAction::Block)
+    {
+        PendingAttacker = Attacker;
+        TimerWheel->SetTimer<&UAIDefenseComponent::ReleaseDefenseInput>(ReleaseTimer, this, Plan.PressDelay + Plan.HoldTime);
+        return;
+    }
+
+    CancelPendingDefense();
+    if (!Plan.IsValid())
+    {
+        return;
+    }
+
+    PendingPlan = Plan;
+    PendingAttacker = Attacker;
+    TimerWheel->SetTimer<&UAIDefenseComponent::PressDefenseInput>(PressTimer, this, Plan.PressDelay);
+}
+
+FAIDefensePlan UAIDefenseComponent::PlanDefense(EAIDefenseAction Action, TConstArrayView<FTimerCheckpoint> Checkpoints, float MontagePosition, float PlayRate) const
+{
+    FAIDefensePlan Plan;
+    if (Action == EAIDefenseAction::None || PlayRate <= UE_KINDA_SMALL_NUMBER)
+    {
+        return Plan;
+    }
+
+    // Next parry window that hasn't closed yet, in world seconds from now
+    const FTimerCheckpoint* Window = Checkpoints.FindByPredicate([MontagePosition](const FTimerCheckpoint& Checkpoint)
+    {
+        return Checkpoint.WindowType == EActionWindowType::Parry && Checkpoint.MontageTime + Checkpoint.Duration > MontagePosition;
+    });
+
+    if (!Window)
+    {
+        // No telegraph to time against: guard as soon as possible
+        if (Action == EAIDefenseAction::Block || Action == EAIDefenseAction::Parry)
+        {
+            Plan.Action = EAIDefenseAction::Block;
+            Plan.PressDelay = ReactionTime;
+            Plan.HoldTime = BlockHoldTime;
+        }
+        return Plan;
+    }
+
+    const float WindowOpen = (Window->MontageTime - MontagePosition) / PlayRate;
+    const float WindowClose = (Window->MontageTime + Window->Duration - MontagePosition) / PlayRate;
+
+    switch (Action)
+    {
+        case EAIDefenseAction::Parry:
+        {
+            // Aim inside the window; a slow reaction still lands late in it, or falls back to blocking
+            const float PressDelay = FMath::Max(ReactionTime, FMath::Lerp(WindowOpen, WindowClose, ParryWindowFraction));
+            if (PressDelay < WindowClose)
+            {
+                Plan.Action = EAIDefenseAction::Parry;
+                Plan.PressDelay = PressDelay;
+                Plan.HoldTime = BlockHoldTime;
+                return Plan;
+            }
+            return PlanDefense(EAIDefenseAction::Block, Checkpoints, MontagePosition, PlayRate);
+        }
+
+        case EAIDefenseAction::Block:
+        {
+            // Guard up before the window opens (a press inside it would parry) and hold through the strike
+            const float Latest = FMath::Max(WindowClose, ReactionTime);
+            Plan.Action = EAIDefenseAction::Block;
+            Plan.PressDelay = FMath::Clamp(WindowOpen - BlockLeadTime, ReactionTime, Latest);
+            Plan.HoldTime = FMath::Max(WindowClose - Plan.PressDelay, 0.0f) + BlockHoldTime;
+            return Plan;
+        }
+
+        case EAIDefenseAction::Evade:
+        {
+            // Dodge as the window closes - the strike follows it
+            if (WindowClose >= ReactionTime)
+            {
+                Plan.Action = EAIDefenseAction::Evade;
+                Plan.PressDelay = WindowClose;
+            }
+            return Plan;
+        }
+
+        default:
+            return Plan;
+    }
+}
+
+void UAIDefenseComponent::CancelPendingDefense()
+{
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetWorld() ? GetWorld()->GetSubsystem<UCombatTimerWheelSubsystem>() : nullptr)
+    {
+        TimerWheel->ClearTimer(PressTimer);
+        TimerWheel->ClearTimer(ReleaseTimer);
+    }
+
+    if (bBlockHeld)
+    {
+        ReleaseDefenseInput();
+    }
+
+    PendingPlan = FAIDefensePlan();
+    PendingAttacker.Reset();
+}
+
+EAIDefenseAction UAIDefenseComponent::RollDefenseAction() const
+{
+    const float Roll = FMath::FRand();
+    if (Roll < ParryChance)
+    {
+        return EAIDefenseAction::Parry;
+    }
+    if (Roll < ParryChance + BlockChance)
+    {
+        return EAIDefenseAction::Block;
+    }
+    if (Roll < ParryChance + BlockChance + EvadeChance)
+    {
+        return EAIDefenseAction::Evade;
+    }
+    return EAIDefenseAction::None;
+}
+
+void UAIDefenseComponent::PressDefenseInput()
+{
+    ASamuraiCharacter* Character = Cast<ASamuraiCharacter>(GetOwner());
+    if (!Character || !PendingAttacker.IsValid())
+    {
+        PendingPlan = FAIDefensePlan();
+        return;
+    }
+
+    if (PendingPlan.Action == EAIDefenseAction::Evade)
+    {
+        Character->SubmitCombatInput(EInputType::Evade, EInputEventType::Press);
+        PendingPlan = FAIDefensePlan();
+        return;
+    }
+
+    // Block and parry are both a block press - whether it parries depends on the attacker's window
+    Character->SubmitCombatInput(EInputType::Block, EInputEventType::Press);
+    bBlockHeld = true;
+
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetWorld()->GetSubsystem<UCombatTimerWheelSubsystem>())
+    {
+        TimerWheel->SetTimer<&UAIDefenseComponent::ReleaseDefenseInput>(ReleaseTimer, this, PendingPlan.HoldTime);
+    }
+}
+
+void UAIDefenseComponent::ReleaseDefenseInput()
+{
+    if (bBlockHeld)
+    {
+        if (ASamuraiCharacter* Character = Cast<ASamuraiCharacter>(GetOwner()))
+        {
+            Character->SubmitCombatInput(EInputType::Block, EInputEventType::Release);
+        }
+        bBlockHeld = false;
+    }
+
+    PendingPlan = FAIDefensePlan();
+}
@@ -0,0 +1,83 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/AIDefenseSubsystem.h"
+#include "Core/AIDefenseComponent.h"
+#include "Core/MontageCheckpointCache.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+void UAIDefenseSubsystem::Deinitialize()
+{
+    Defenders.Empty();
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+void UAIDefenseSubsystem::RegisterDefender(UAIDefenseComponent* Defender)
+{
+    if (Defender)
+    {
+        Defenders.AddUnique(Defender);
+    }
+}
+
+void UAIDefenseSubsystem::UnregisterDefender(UAIDefenseComponent* Defender)
+{
+    Defenders.RemoveSwap(Defender);
+}
+
+// ============================================================================
+// EVENTS
+// ============================================================================
+
+void UAIDefenseSubsystem::NotifyAttackStarted(AActor* Attacker, const UAnimInstance* AnimInstance, UAnimMontage* Montage, FName SectionName)
+{
+    if (Defenders.Num() == 0 || !Attacker || !AnimInstance || !Montage)
+    {
+        return;
+    }
+
+    UMontageCheckpointCache* CheckpointCache = GetWorld() ? GetWorld()->GetSubsystem<UMontageCheckpointCache>() : nullptr;
+    if (!CheckpointCache)
+    {
+        return;
+    }
+
+    const TConstArrayView<FTimerCheckpoint> Checkpoints = CheckpointCache->GetCheckpoints(Montage, SectionName);
+    const float MontagePosition = AnimInstance->Montage_GetPosition(Montage);
+    const float PlayRate = AnimInstance->Montage_GetPlayRate(Montage) * Montage->RateScale * Attacker->CustomTimeDilation;
+
+    const APawn* AttackerPawn = Cast<APawn>(Attacker);
+    const bool bPlayerAttacker = AttackerPawn && AttackerPawn->IsPlayerControlled();
+    const FVector AttackerLocation = Attacker->GetActorLocation();
+
+    for (int32 i = Defenders.Num() - 1; i >= 0; --i)
+    {
+        UAIDefenseComponent* Defender = Defenders[i].Get();
+        if (!Defender)
+        {
+            Defenders.RemoveAtSwap(i);
+            continue;
+        }
+
+        // Player-possessed characters defend themselves
+        const AActor* DefenderOwner = Defender->GetOwner();
+        const APawn* DefenderPawn = Cast<APawn>(DefenderOwner);
+        if (!DefenderOwner || DefenderOwner == Attacker || (DefenderPawn && DefenderPawn->IsPlayerControlled())
+            || (Defender->bOnlyDefendAgainstPlayers && !bPlayerAttacker))
+        {
+            continue;
+        }
+
+        if (FVector::DistSquared(AttackerLocation, DefenderOwner->GetActorLocation()) <= FMath::Square(Defender->MaxReactDistance))
+        {
+            Defender->OnAttackStarted(Attacker, Checkpoints, MontagePosition, PlayRate);
+        }
+    }
+}
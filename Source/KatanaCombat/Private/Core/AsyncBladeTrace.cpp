@@ -0,0 +1,165 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/AsyncBladeTrace.h"
+#include "Misc/ScopeLock.h"
+
+void FAsyncBladeTrace::Begin(const FAttackSwingVolume* SwingVolume, float InRadius, float InSpatialTolerance, int32 InMaxSubsteps)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    bActive = true;
+    bHasSnapshot = false;
+    bHasPrevPose = false;
+    bHasBake = SwingVolume && SwingVolume->GetNumSamples() > 0;
+    if (bHasBake)
+    {
+        Bake = *SwingVolume;
+    }
+    else
+    {
+        Bake.Reset();
+    }
+
+    Radius = InRadius;
+    SpatialTolerance = FMath::Max(InSpatialTolerance, 0.1f);
+    MaxSubsteps = FMath::Max(InMaxSubsteps, 1);
+    ElapsedSincePublish = 0.0f;
+    Narrowphase.Reset();
+    Reported.Reset();
+    PendingHits.Reset();
+    NumSteps = 0;
+}
+
+void FAsyncBladeTrace::End()
+{
+    FScopeLock ScopeLock(&Lock);
+
+    bActive = false;
+    bHasSnapshot = false;
+    Snapshot.Capsules.Reset();
+    Narrowphase.Reset();
+    PendingHits.Reset();
+}
+
+bool FAsyncBladeTrace::IsActive() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return bActive;
+}
+
+bool FAsyncBladeTrace::IsUsingBake() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return bActive && bHasBake;
+}
+
+int32 FAsyncBladeTrace::GetNumSteps() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return NumSteps;
+}
+
+void FAsyncBladeTrace::Publish(FSnapshot&& InSnapshot, TArray<FHit>& OutHits)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    OutHits = MoveTemp(PendingHits);
+    PendingHits.Reset();
+    if (!bActive)
+    {
+        return;
+    }
+
+    Snapshot = MoveTemp(InSnapshot);
+    bHasSnapshot = true;
+    ElapsedSincePublish = 0.0f;
+
+    Narrowphase.Reset();
+    for (const FCapsule& Capsule : Snapshot.Capsules)
+    {
+        Narrowphase.AddCapsule(Capsule.A, Capsule.B, Capsule.Radius);
+    }
+    Reported.Init(false, Narrowphase.Num());
+}
+
+void FAsyncBladeTrace::SampleBlade(float Elapsed, FVector& OutStart, FVector& OutTip) const
+{
+    if (!bHasBake)
+    {
+        OutStart = Snapshot.Start;
+        OutTip = Snapshot.Tip;
+        return;
+    }
+
+    // Baked in mesh component space: the montage clock advances at its playrate, the mesh at its velocity
+    Bake.SampleAtTime(Snapshot.MontageTime + Elapsed * Snapshot.PlayRate, OutStart, OutTip);
+    const FVector Offset = Snapshot.MeshVelocity * Elapsed;
+    OutStart = Snapshot.MeshTransform.TransformPosition(OutStart) + Offset;
+    OutTip = Snapshot.MeshTransform.TransformPosition(OutTip) + Offset;
+}
+
+void FAsyncBladeTrace::Step(float DeltaTime)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    if (!bActive || !bHasSnapshot)
+    {
+        return;
+    }
+
+    ++NumSteps;
+    ElapsedSincePublish += DeltaTime;
+
+    FVector Start, Tip;
+    SampleBlade(ElapsedSincePublish, Start, Tip);
+
+    // Skip the first step to avoid hitting at spawn
+    if (!bHasPrevPose)
+    {
+        PrevStart = Start;
+        PrevTip = Tip;
+        bHasPrevPose = true;
+        return;
+    }
+
+    if (Narrowphase.Num() > 0)
+    {
+        // Same swept volume as the game thread narrowphase: the blade at each substep pose, plus the tip's path between poses
+        const float Travel = FMath::Max(FVector::Dist(PrevTip, Tip), FVector::Dist(PrevStart, Start));
+        const int32 NumSubsteps = FMath::Clamp(FMath::CeilToInt(Travel / SpatialTolerance), 1, MaxSubsteps);
+
+        TBitArray<> Hits(false, Narrowphase.Num());
+        FVector PreviousSubstepTip = PrevTip;
+        for (int32 Substep = 1; Substep <= NumSubsteps; ++Substep)
+        {
+            const float Alpha = static_cast<float>(Substep) / NumSubsteps;
+            const FVector SubstepStart = FMath::Lerp(PrevStart, Start, Alpha);
+            const FVector SubstepTip = FMath::Lerp(PrevTip, Tip, Alpha);
+            Narrowphase.TestSegment(SubstepStart, SubstepTip, Radius, Hits);
+            Narrowphase.TestSegment(PreviousSubstepTip, SubstepTip, Radius, Hits);
+            PreviousSubstepTip = SubstepTip;
+        }
+
+        // Each capsule once per publish - the weapon's own hit list handles rehits
+        for (TConstSetBitIterator<> It(Hits); It; ++It)
+        {
+            const int32 Index = It.GetIndex();
+            if (Reported[Index])
+            {
+                continue;
+            }
+            Reported[Index] = true;
+
+            FHit& Hit = PendingHits.AddDefaulted_GetRef();
+            Hit.CapsuleIndex = Index;
+            Narrowphase.GetClosestPoints(Index, Start, Tip, Hit.OnBlade, Hit.OnCapsule);
+            Hit.PrevStart = PrevStart;
+            Hit.PrevTip = PrevTip;
+            Hit.Start = Start;
+            Hit.Tip = Tip;
+        }
+    }
+
+    PrevStart = Start;
+    PrevTip = Tip;
+}
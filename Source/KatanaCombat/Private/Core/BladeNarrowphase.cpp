@@ -0,0 +1,164 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/BladeNarrowphase.h"
+#include "Math/VectorRegister.h"
+
+namespace BladeNarrowphase
+{
+    constexpr float Epsilon = UE_KINDA_SMALL_NUMBER;
+
+    FORCEINLINE VectorRegister4Float Clamp01(const VectorRegister4Float& Value)
+    {
+        return VectorMin(VectorMax(Value, VectorZeroFloat()), VectorOneFloat());
+    }
+}
+
+void FBladeNarrowphase::Reset()
+{
+    AX.Reset();
+    AY.Reset();
+    AZ.Reset();
+    BX.Reset();
+    BY.Reset();
+    BZ.Reset();
+    Radii.Reset();
+    NumCapsules = 0;
+}
+
+int32 FBladeNarrowphase::AddCapsule(const FVector& A, const FVector& B, float Radius)
+{
+    const int32 Index = NumCapsules++;
+
+    // Grow a whole batch at a time - padding lanes are zero capsules masked out of the results
+    if (Index == AX.Num())
+    {
+        AX.AddZeroed(BatchWidth);
+        AY.AddZeroed(BatchWidth);
+        AZ.AddZeroed(BatchWidth);
+        BX.AddZeroed(BatchWidth);
+        BY.AddZeroed(BatchWidth);
+        BZ.AddZeroed(BatchWidth);
+        Radii.AddZeroed(BatchWidth);
+    }
+
+    AX[Index] = static_cast<float>(A.X);
+    AY[Index] = static_cast<float>(A.Y);
+    AZ[Index] = static_cast<float>(A.Z);
+    BX[Index] = static_cast<float>(B.X);
+    BY[Index] = static_cast<float>(B.Y);
+    BZ[Index] = static_cast<float>(B.Z);
+    Radii[Index] = Radius;
+    return Index;
+}
+
+int32 FBladeNarrowphase::TestSegment(const FVector& P, const FVector& Q, float SegmentRadius, TBitArray<>& InOutHits) const
+{
+    using namespace BladeNarrowphase;
+
+    if (InOutHits.Num() < NumCapsules)
+    {
+        InOutHits.Add(false, NumCapsules - InOutHits.Num());
+    }
+
+    // Blade terms are shared by every lane (Ericson, Real-Time Collision Detection 5.1.9)
+    const FVector3f D1(Q - P);
+    const float BladeLengthSq = D1.SizeSquared();
+
+    const VectorRegister4Float PX = VectorSetFloat1(static_cast<float>(P.X));
+    const VectorRegister4Float PY = VectorSetFloat1(static_cast<float>(P.Y));
+    const VectorRegister4Float PZ = VectorSetFloat1(static_cast<float>(P.Z));
+    const VectorRegister4Float D1X = VectorSetFloat1(D1.X);
+    const VectorRegister4Float D1Y = VectorSetFloat1(D1.Y);
+    const VectorRegister4Float D1Z = VectorSetFloat1(D1.Z);
+    const VectorRegister4Float VA = VectorSetFloat1(BladeLengthSq);
+    const VectorRegister4Float VInvA = VectorSetFloat1(BladeLengthSq > Epsilon ? 1.0f / BladeLengthSq : 0.0f);
+    const VectorRegister4Float VSegmentRadius = VectorSetFloat1(SegmentRadius);
+    const VectorRegister4Float VEpsilon = VectorSetFloat1(Epsilon);
+
+    int32 NumNewHits = 0;
+    for (int32 Base = 0; Base < NumCapsules; Base += BatchWidth)
+    {
+        const VectorRegister4Float AXv = VectorLoad(&AX[Base]);
+        const VectorRegister4Float AYv = VectorLoad(&AY[Base]);
+        const VectorRegister4Float AZv = VectorLoad(&AZ[Base]);
+
+        // Capsule axis and blade start relative to it
+        const VectorRegister4Float D2X = VectorSubtract(VectorLoad(&BX[Base]), AXv);
+        const VectorRegister4Float D2Y = VectorSubtract(VectorLoad(&BY[Base]), AYv);
+        const VectorRegister4Float D2Z = VectorSubtract(VectorLoad(&BZ[Base]), AZv);
+        const VectorRegister4Float RX = VectorSubtract(PX, AXv);
+        const VectorRegister4Float RY = VectorSubtract(PY, AYv);
+        const VectorRegister4Float RZ = VectorSubtract(PZ, AZv);
+
+        const VectorRegister4Float E = VectorMultiplyAdd(D2X, D2X, VectorMultiplyAdd(D2Y, D2Y, VectorMultiply(D2Z, D2Z)));
+        const VectorRegister4Float F = VectorMultiplyAdd(D2X, RX, VectorMultiplyAdd(D2Y, RY, VectorMultiply(D2Z, RZ)));
+        const VectorRegister4Float C = VectorMultiplyAdd(D1X, RX, VectorMultiplyAdd(D1Y, RY, VectorMultiply(D1Z, RZ)));
+        const VectorRegister4Float B = VectorMultiplyAdd(D1X, D2X, VectorMultiplyAdd(D1Y, D2Y, VectorMultiply(D1Z, D2Z)));
+
+        // Closest point on the infinite blade line, clamped (0 when parallel)
+        const VectorRegister4Float Denom = VectorSubtract(VectorMultiply(VA, E), VectorMultiply(B, B));
+        const VectorRegister4Float DenomValid = VectorCompareGT(Denom, VEpsilon);
+        const VectorRegister4Float SafeDenom = VectorSelect(DenomValid, Denom, VectorOneFloat());
+        const VectorRegister4Float SLine = VectorSelect(DenomValid,
+            Clamp01(VectorDivide(VectorSubtract(VectorMultiply(B, F), VectorMultiply(C, E)), SafeDenom)),
+            VectorZeroFloat());
+
+        // Matching point on the capsule axis (0 for sphere capsules)
+        const VectorRegister4Float AxisValid = VectorCompareGT(E, VEpsilon);
+        const VectorRegister4Float SafeE = VectorSelect(AxisValid, E, VectorOneFloat());
+        const VectorRegister4Float TRaw = VectorSelect(AxisValid, VectorDivide(VectorMultiplyAdd(B, SLine, F), SafeE), VectorZeroFloat());
+        const VectorRegister4Float T = Clamp01(TRaw);
+
+        // Axis point clamped - recompute the blade point against it
+        const VectorRegister4Float TClamped = VectorCompareNE(T, TRaw);
+        const VectorRegister4Float S = VectorSelect(TClamped, Clamp01(VectorMultiply(VectorSubtract(VectorMultiply(B, T), C), VInvA)), SLine);
+
+        // Offset between the closest points: R + D1 * S - D2 * T
+        const VectorRegister4Float DX = VectorSubtract(VectorMultiplyAdd(D1X, S, RX), VectorMultiply(D2X, T));
+        const VectorRegister4Float DY = VectorSubtract(VectorMultiplyAdd(D1Y, S, RY), VectorMultiply(D2Y, T));
+        const VectorRegister4Float DZ = VectorSubtract(VectorMultiplyAdd(D1Z, S, RZ), VectorMultiply(D2Z, T));
+        const VectorRegister4Float DistSq = VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ)));
+
+        const VectorRegister4Float Reach = VectorAdd(VectorLoad(&Radii[Base]), VSegmentRadius);
+        uint32 HitBits = static_cast<uint32>(VectorMaskBits(VectorCompareLE(DistSq, VectorMultiply(Reach, Reach))));
+
+        // Mask out padding lanes of the last batch
+        const int32 NumLanes = FMath::Min(BatchWidth, NumCapsules - Base);
+        HitBits &= (1u << NumLanes) - 1u;
+
+        while (HitBits)
+        {
+            const int32 Lane = FMath::CountTrailingZeros(HitBits);
+            HitBits &= HitBits - 1u;
+
+            FBitReference Bit = InOutHits[Base + Lane];
+            if (!Bit)
+            {
+                Bit = true;
+                ++NumNewHits;
+            }
+        }
+    }
+
+    return NumNewHits;
+}
+
+void FBladeNarrowphase::GetClosestPoints(int32 Index, const FVector& P, const FVector& Q, FVector& OutOnSegment, FVector& OutOnCapsule) const
+{
+    check(Index >= 0 && Index < NumCapsules);
+
+    const FVector A(AX[Index], AY[Index], AZ[Index]);
+    const FVector B(BX[Index], BY[Index], BZ[Index]);
+
+    FVector OnAxis;
+    FMath::SegmentDistToSegmentSafe(P, Q, A, B, OutOnSegment, OnAxis);
+    OutOnCapsule = OnAxis + (OutOnSegment - OnAxis).GetSafeNormal() * Radii[Index];
+}
+
+float FBladeNarrowphase::SegmentDistSquared(const FVector& P, const FVector& Q, const FVector& A, const FVector& B)
+{
+    FVector OnSegment;
+    FVector OnAxis;
+    FMath::SegmentDistToSegmentSafe(P, Q, A, B, OnSegment, OnAxis);
+    return static_cast<float>(FVector::DistSquared(OnSegment, OnAxis));
+}
@@ -0,0 +1,341 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatAbstractResolutionSubsystem.h"
+#include "Core/CombatComponent.h"
+#include "Core/CombatRegistrySubsystem.h"
+#include "Core/CombatSimCore.h"
+#include "Data/AttackData.h"
+#include "Interfaces/DamageableInterface.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatAbstractResolutionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    Collection.InitializeDependency<UCombatRegistrySubsystem>();
+    Collection.InitializeDependency<UCombatSignificanceSubsystem>();
+    if (UCombatJobSchedulerSubsystem* Scheduler = Collection.InitializeDependency<UCombatJobSchedulerSubsystem>())
+    {
+        Scheduler->RegisterJob<&UCombatAbstractResolutionSubsystem::UpdateFightsJob>(ResolveJob, this, ResolveInterval, ECombatJobPriority::Low, TEXT("AbstractCombat.Resolve"));
+    }
+}
+
+void UCombatAbstractResolutionSubsystem::Deinitialize()
+{
+    if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>() : nullptr)
+    {
+        Scheduler->UnregisterJob(ResolveJob);
+    }
+
+    EndAllFights();
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+
+FCombatAbstractStats UCombatAbstractResolutionSubsystem::CookStats(const UAttackData* LightAttack, const UAttackData* HeavyAttack, float AttackSpacing)
+{
+    FCombatAbstractStats Stats;
+
+    // One swing of each in turn: total output over total time
+    float Damage = 0.0f;
+    float PostureDamage = 0.0f;
+    float Duration = 0.0f;
+    float CounterMultiplier = 0.0f;
+    int32 NumAttacks = 0;
+
+    for (const UAttackData* Attack : { LightAttack, HeavyAttack })
+    {
+        if (!Attack)
+        {
+            continue;
+        }
+
+        const FCombatSimAttackTiming Timing = FCombatSimCore::CookAttackTiming(Attack);
+        Damage += Attack->BaseDamage;
+        PostureDamage += Timing.PostureDamage;
+        Duration += Timing.GetTotalDuration() + AttackSpacing;
+        CounterMultiplier += Attack->CounterDamageMultiplier;
+        ++NumAttacks;
+    }
+
+    if (NumAttacks == 0 || Duration <= KINDA_SMALL_NUMBER)
+    {
+        return Stats;
+    }
+
+    Stats.DamagePerSecond = Damage / Duration;
+    Stats.PostureDamagePerSecond = PostureDamage / Duration;
+    Stats.CounterDamageMultiplier = CounterMultiplier / NumAttacks;
+    return Stats;
+}
+
+void UCombatAbstractResolutionSubsystem::ResolveExchange(const FCombatAbstractStats& Attacker, float DeltaTime, float BlockRate, bool bDefenderGuardBroken, float& OutDamage, float& OutPostureDamage)
+{
+    // A broken guard blocks nothing and takes counter damage
+    if (bDefenderGuardBroken)
+    {
+        OutDamage = Attacker.DamagePerSecond * Attacker.CounterDamageMultiplier * DeltaTime;
+        OutPostureDamage = 0.0f;
+        return;
+    }
+
+    const float Blocked = FMath::Clamp(BlockRate, 0.0f, 1.0f);
+    OutDamage = Attacker.DamagePerSecond * (1.0f - Blocked) * DeltaTime;
+    OutPostureDamage = Attacker.PostureDamagePerSecond * Blocked * DeltaTime;
+}
+
+// ============================================================================
+// FIGHTS
+// ============================================================================
+
+void UCombatAbstractResolutionSubsystem::UpdateFights()
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    // Going fights: resolve, then hand back the ones that stopped qualifying
+    for (int32 FightIndex = Fights.Num() - 1; FightIndex >= 0; --FightIndex)
+    {
+        FAbstractFight& Fight = Fights[FightIndex];
+        if (CanStayAbstract(Fight.Fighters[0]) && CanStayAbstract(Fight.Fighters[1]))
+        {
+            ResolveFight(Fight, Now);
+        }
+
+        // Resolving can end it too (a guard that can't be damaged any more, a destroyed loser)
+        if (!CanStayAbstract(Fight.Fighters[0]) || !CanStayAbstract(Fight.Fighters[1]))
+        {
+            EndFightAt(FightIndex);
+        }
+    }
+
+    UCombatRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UCombatRegistrySubsystem>();
+    if (!Registry)
+    {
+        return;
+    }
+
+    // New fights: pairs locked onto each other that both qualify
+    Registry->RefreshCombatants();
+    const float EngageDistanceSq = FMath::Square(EngageDistance);
+    for (int32 Index = 0; Index < Registry->GetNumCombatants(); ++Index)
+    {
+        const int32 OpponentIndex = Registry->GetCombatantTargetIndex(Index);
+        if (OpponentIndex == INDEX_NONE || OpponentIndex < Index || Registry->GetCombatantTargetIndex(OpponentIndex) != Index)
+        {
+            continue;
+        }
+
+        if (FVector::DistSquared(Registry->GetCombatantLocation(Index), Registry->GetCombatantLocation(OpponentIndex)) > EngageDistanceSq)
+        {
+            continue;
+        }
+
+        AActor* Actors[2] = { Registry->GetCombatantActor(Index), Registry->GetCombatantActor(OpponentIndex) };
+        UCombatComponent* Combats[2] = {
+            Actors[0] ? Actors[0]->FindComponentByClass<UCombatComponent>() : nullptr,
+            Actors[1] ? Actors[1]->FindComponentByClass<UCombatComponent>() : nullptr
+        };
+        if (!CanGoAbstract(Actors[0], Combats[0]) || !CanGoAbstract(Actors[1], Combats[1]))
+        {
+            continue;
+        }
+
+        FAbstractFight& Fight = Fights.AddDefaulted_GetRef();
+        Fight.LastResolveTime = Now;
+        for (int32 Side = 0; Side < 2; ++Side)
+        {
+            FAbstractFighter& Fighter = Fight.Fighters[Side];
+            Fighter.Actor = Actors[Side];
+            Fighter.Combat = Combats[Side];
+            Fighter.Stats = CookStats(Combats[Side]->GetDefaultLightAttack(), Combats[Side]->GetDefaultHeavyAttack(), AttackSpacing);
+            AbstractActors.Add(FObjectKey(Actors[Side]));
+            Suspend(Fighter);
+        }
+    }
+}
+
+void UCombatAbstractResolutionSubsystem::EndAllFights()
+{
+    for (int32 FightIndex = Fights.Num() - 1; FightIndex >= 0; --FightIndex)
+    {
+        EndFightAt(FightIndex);
+    }
+}
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+void UCombatAbstractResolutionSubsystem::UpdateFightsJob(float DeltaTime)
+{
+    UpdateFights();
+}
+
+bool UCombatAbstractResolutionSubsystem::CanGoAbstract(AActor* Actor, const UCombatComponent* Combat) const
+{
+    if (!Actor || !Combat || IsAbstract(Actor))
+    {
+        return false;
+    }
+
+    const APawn* Pawn = Cast<APawn>(Actor);
+    if (Pawn && Pawn->IsPlayerControlled())
+    {
+        return false;
+    }
+
+    // Mid-swing fighters finish their montage first (suspending it would freeze the attack)
+    const ECombatState State = Combat->GetCombatState();
+    if (State != ECombatState::Idle && State != ECombatState::Blocking)
+    {
+        return false;
+    }
+
+    if (!Actor->Implements<UDamageableInterface>() || !IDamageableInterface::Execute_CanBeDamaged(Actor))
+    {
+        return false;
+    }
+
+    return UCombatSignificanceSubsystem::GetSignificanceFor(Actor) <= MaxSignificance;
+}
+
+bool UCombatAbstractResolutionSubsystem::CanStayAbstract(const FAbstractFighter& Fighter) const
+{
+    AActor* Actor = Fighter.Actor.Get();
+    if (!Actor || !Fighter.Combat.IsValid() || Actor->IsActorBeingDestroyed())
+    {
+        return false;
+    }
+
+    return IDamageableInterface::Execute_CanBeDamaged(Actor) && UCombatSignificanceSubsystem::GetSignificanceFor(Actor) <= MaxSignificance;
+}
+
+void UCombatAbstractResolutionSubsystem::ResolveFight(FAbstractFight& Fight, double Now)
+{
+    const float DeltaTime = static_cast<float>(Now - Fight.LastResolveTime);
+    Fight.LastResolveTime = Now;
+    if (DeltaTime <= 0.0f)
+    {
+        return;
+    }
+
+    // Both sides swing at once - compute both before applying either
+    float Damage[2];
+    float PostureDamage[2];
+    for (int32 Side = 0; Side < 2; ++Side)
+    {
+        const UCombatComponent* Defender = Fight.Fighters[1 - Side].Combat.Get();
+        const float DefenderBlockRate = Defender->IsBlocking() ? 1.0f : BlockRate;
+        ResolveExchange(Fight.Fighters[Side].Stats, DeltaTime, DefenderBlockRate, Defender->IsGuardBroken(), Damage[Side], PostureDamage[Side]);
+    }
+
+    for (int32 Side = 0; Side < 2; ++Side)
+    {
+        AActor* Attacker = Fight.Fighters[Side].Actor.Get();
+        AActor* Defender = Fight.Fighters[1 - Side].Actor.Get();
+        if (!Attacker || !Defender || !IDamageableInterface::Execute_CanBeDamaged(Defender))
+        {
+            continue;
+        }
+
+        if (PostureDamage[Side] > 0.0f)
+        {
+            IDamageableInterface::Execute_ApplyPostureDamage(Defender, PostureDamage[Side], Attacker);
+        }
+
+        // Blocked in full (still guarding after the posture damage) - nothing gets through
+        const UCombatComponent* DefenderCombat = Fight.Fighters[1 - Side].Combat.Get();
+        if (Damage[Side] > 0.0f && DefenderCombat && !DefenderCombat->IsBlocking())
+        {
+            FHitReactionInfo HitInfo;
+            HitInfo.Attacker = Attacker;
+            HitInfo.HitDirection = (Defender->GetActorLocation() - Attacker->GetActorLocation()).GetSafeNormal();
+            HitInfo.ImpactPoint = Defender->GetActorLocation();
+            HitInfo.Damage = Damage[Side];
+            IDamageableInterface::Execute_ApplyDamage(Defender, HitInfo);
+        }
+    }
+}
+
+void UCombatAbstractResolutionSubsystem::Suspend(FAbstractFighter& Fighter)
+{
+    AActor* Actor = Fighter.Actor.Get();
+    if (!Actor)
+    {
+        return;
+    }
+
+    // The character and its AI: no ticks means no montages, traces, movement or StateTree
+    AActor* Owners[2] = { Actor, nullptr };
+    if (const APawn* Pawn = Cast<APawn>(Actor))
+    {
+        Owners[1] = Pawn->GetController();
+    }
+
+    for (AActor* Owner : Owners)
+    {
+        if (!Owner)
+        {
+            continue;
+        }
+
+        if (Owner->IsActorTickEnabled())
+        {
+            Owner->SetActorTickEnabled(false);
+            Fighter.SuspendedActors.Add(Owner);
+        }
+
+        Owner->ForEachComponent(false, [&Fighter](UActorComponent* Component)
+        {
+            if (Component->IsComponentTickEnabled())
+            {
+                Component->SetComponentTickEnabled(false);
+                Fighter.SuspendedComponents.Add(Component);
+            }
+        });
+    }
+}
+
+void UCombatAbstractResolutionSubsystem::Resume(FAbstractFighter& Fighter)
+{
+    for (const TWeakObjectPtr<AActor>& Owner : Fighter.SuspendedActors)
+    {
+        if (AActor* SuspendedActor = Owner.Get())
+        {
+            SuspendedActor->SetActorTickEnabled(true);
+        }
+    }
+
+    for (const TWeakObjectPtr<UActorComponent>& Component : Fighter.SuspendedComponents)
+    {
+        if (UActorComponent* SuspendedComponent = Component.Get())
+        {
+            SuspendedComponent->SetComponentTickEnabled(true);
+        }
+    }
+
+    Fighter.SuspendedActors.Reset();
+    Fighter.SuspendedComponents.Reset();
+}
+
+void UCombatAbstractResolutionSubsystem::EndFightAt(int32 FightIndex)
+{
+    FAbstractFight& Fight = Fights[FightIndex];
+    for (FAbstractFighter& Fighter : Fight.Fighters)
+    {
+        Resume(Fighter);
+        AbstractActors.Remove(FObjectKey(Fighter.Actor.Get()));
+    }
+
+    Fights.RemoveAtSwap(FightIndex);
+}
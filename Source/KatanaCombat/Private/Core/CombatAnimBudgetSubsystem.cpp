@@ -0,0 +1,232 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatAnimBudgetSubsystem.h"
+#include "Core/CombatComponent.h"
+#include "Core/TargetingComponent.h"
+#include "Core/WeaponComponent.h"
+#include "IAnimationBudgetAllocator.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatAnimBudgetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (UCombatJobSchedulerSubsystem* Scheduler = Collection.InitializeDependency<UCombatJobSchedulerSubsystem>())
+    {
+        Scheduler->RegisterJob<&UCombatAnimBudgetSubsystem::UpdateMeshSignificanceJob>(UpdateJob, this, UpdateInterval, ECombatJobPriority::High, TEXT("AnimBudget.Update"));
+    }
+}
+
+void UCombatAnimBudgetSubsystem::Deinitialize()
+{
+    if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>() : nullptr)
+    {
+        Scheduler->UnregisterJob(UpdateJob);
+    }
+
+    for (FBudgetedMesh& Entry : Entries)
+    {
+        if (UCombatComponent* CombatComponent = Entry.CombatComponent.Get())
+        {
+            CombatComponent->OnCombatStateChangedNative.RemoveAll(this);
+        }
+    }
+    Entries.Empty();
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// MESHES
+// ============================================================================
+
+void UCombatAnimBudgetSubsystem::RegisterMesh(USkeletalMeshComponent* Mesh)
+{
+    USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(Mesh);
+    AActor* Owner = BudgetedMesh ? BudgetedMesh->GetOwner() : nullptr;
+    if (!Owner || Entries.ContainsByPredicate([BudgetedMesh](const FBudgetedMesh& Entry) { return Entry.Mesh.Get() == BudgetedMesh; }))
+    {
+        return;
+    }
+
+    // Significance comes from here, not the component's own distance heuristic
+    BudgetedMesh->SetAutoCalculateSignificance(false);
+
+    FBudgetedMesh& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Mesh = BudgetedMesh;
+    Entry.Owner = Owner;
+    Entry.CombatComponent = Owner->FindComponentByClass<UCombatComponent>();
+    Entry.WeaponComponent = Owner->FindComponentByClass<UWeaponComponent>();
+
+    // State changes (attack starts in particular) shouldn't wait out the interval
+    if (UCombatComponent* CombatComponent = Entry.CombatComponent.Get())
+    {
+        CombatComponent->OnCombatStateChangedNative.AddUObject(this, &UCombatAnimBudgetSubsystem::OnCombatStateChanged);
+    }
+
+    // Start unthrottled until the first pass ranks it
+    PushSignificance(Entry, 1.0f, true);
+}
+
+void UCombatAnimBudgetSubsystem::UnregisterMesh(USkeletalMeshComponent* Mesh)
+{
+    const int32 Index = Entries.IndexOfByPredicate([Mesh](const FBudgetedMesh& Entry) { return Entry.Mesh.Get() == Mesh; });
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (UCombatComponent* CombatComponent = Entries[Index].CombatComponent.Get())
+    {
+        CombatComponent->OnCombatStateChangedNative.RemoveAll(this);
+    }
+    Entries.RemoveAtSwap(Index);
+}
+
+void UCombatAnimBudgetSubsystem::SetCombatCritical(const AActor* Owner, bool bCritical)
+{
+    for (FBudgetedMesh& Entry : Entries)
+    {
+        if (Entry.Owner.Get() != Owner || Entry.bOwnerCritical == bCritical)
+        {
+            continue;
+        }
+
+        Entry.bOwnerCritical = bCritical;
+
+        // Going critical can't wait for the next pass - the swing is starting now
+        if (bCritical)
+        {
+            PushSignificance(Entry, 1.0f, true);
+        }
+        else if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+        {
+            Scheduler->MarkJobDue(UpdateJob);
+        }
+    }
+}
+
+bool UCombatAnimBudgetSubsystem::IsCombatCritical(const AActor* Owner) const
+{
+    const FBudgetedMesh* Entry = Entries.FindByPredicate([Owner](const FBudgetedMesh& Candidate) { return Candidate.Owner.Get() == Owner; });
+    return Entry && Entry->bPushedCritical;
+}
+
+float UCombatAnimBudgetSubsystem::GetRankSignificance(ECombatSignificance Rank) const
+{
+    switch (Rank)
+    {
+    case ECombatSignificance::Culled:
+        return CulledSignificance;
+    case ECombatSignificance::Low:
+        return LowSignificance;
+    case ECombatSignificance::Medium:
+        return MediumSignificance;
+    default:
+        return HighSignificance;
+    }
+}
+
+void UCombatAnimBudgetSubsystem::UpdateMeshSignificance()
+{
+    ++NumPasses;
+
+    // Local players and whoever they're locked onto are never throttled
+    TArray<const AActor*, TInlineAllocator<4>> PlayerTargets;
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        const APawn* PlayerPawn = PlayerController && PlayerController->IsLocalController() ? PlayerController->GetPawn() : nullptr;
+        if (!PlayerPawn)
+        {
+            continue;
+        }
+
+        PlayerTargets.Add(PlayerPawn);
+        if (const UTargetingComponent* Targeting = PlayerPawn->FindComponentByClass<UTargetingComponent>())
+        {
+            if (const AActor* Target = Targeting->GetCurrentTarget())
+            {
+                PlayerTargets.Add(Target);
+            }
+        }
+    }
+
+    for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+    {
+        FBudgetedMesh& Entry = Entries[Index];
+        if (!Entry.Mesh.IsValid() || !Entry.Owner.IsValid())
+        {
+            Entries.RemoveAtSwap(Index);
+            continue;
+        }
+
+        const bool bCritical = IsEntryCritical(Entry, PlayerTargets);
+        const float Significance = bCritical ? 1.0f : GetRankSignificance(UCombatSignificanceSubsystem::GetSignificanceFor(Entry.Owner.Get()));
+        PushSignificance(Entry, Significance, bCritical);
+    }
+}
+
+// ============================================================================
+// INTERNAL
+// ============================================================================
+
+void UCombatAnimBudgetSubsystem::UpdateMeshSignificanceJob(float DeltaTime)
+{
+    UpdateMeshSignificance();
+}
+
+void UCombatAnimBudgetSubsystem::OnCombatStateChanged(ECombatState NewState)
+{
+    if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+    {
+        Scheduler->MarkJobDue(UpdateJob);
+    }
+}
+
+bool UCombatAnimBudgetSubsystem::IsEntryCritical(const FBudgetedMesh& Entry, TConstArrayView<const AActor*> PlayerTargets) const
+{
+    if (Entry.bOwnerCritical || PlayerTargets.Contains(Entry.Owner.Get()))
+    {
+        return true;
+    }
+
+    // Swing sockets feed the weapon sweeps
+    const UWeaponComponent* WeaponComponent = Entry.WeaponComponent.Get();
+    if (WeaponComponent && WeaponComponent->IsHitDetectionEnabled())
+    {
+        return true;
+    }
+
+    if (const UCombatComponent* CombatComponent = Entry.CombatComponent.Get())
+    {
+        const EAttackPhase Phase = CombatComponent->GetQuerySnapshot().CurrentPhase;
+        return Phase == EAttackPhase::Windup || Phase == EAttackPhase::Active;
+    }
+
+    return false;
+}
+
+void UCombatAnimBudgetSubsystem::PushSignificance(FBudgetedMesh& Entry, float Significance, bool bCritical)
+{
+    if (Entry.bPushedCritical == bCritical && FMath::IsNearlyEqual(Entry.PushedSignificance, Significance))
+    {
+        return;
+    }
+
+    Entry.PushedSignificance = Significance;
+    Entry.bPushedCritical = bCritical;
+
+    // Critical: never skipped, ticks even off screen (hits still need posed sockets), full work
+    if (IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld()))
+    {
+        Allocator->SetComponentSignificance(Entry.Mesh.Get(), Significance, bCritical, bCritical, !bCritical);
+    }
+}
@@ -0,0 +1,297 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatBudgetSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    const TCHAR* GetCategoryName(ECombatBudgetCategory Category)
+    {
+        switch (Category)
+        {
+        case ECombatBudgetCategory::Traces:    return TEXT("Traces");
+        case ECombatBudgetCategory::Targeting: return TEXT("Targeting");
+        case ECombatBudgetCategory::Queue:     return TEXT("Queue");
+        case ECombatBudgetCategory::Anim:      return TEXT("Anim");
+        default:                               return TEXT("Total");
+        }
+    }
+
+    const TCHAR* GetLevelName(ECombatQualityLevel Level)
+    {
+        switch (Level)
+        {
+        case ECombatQualityLevel::Full:    return TEXT("Full");
+        case ECombatQualityLevel::Reduced: return TEXT("Reduced");
+        default:                           return TEXT("Minimal");
+        }
+    }
+}
+
+// ============================================================================
+// TRACKER
+// ============================================================================
+
+bool FCombatBudgetTracker::Update(float FrameMs, float BudgetMs, float DeltaTime)
+{
+    LastFrameMs = FrameMs;
+    SmoothedMs = FMath::Lerp(SmoothedMs, FrameMs, FMath::Clamp(SmoothingAlpha, 0.0f, 1.0f));
+
+    if (BudgetMs <= 0.0f)
+    {
+        const bool bChanged = Level != ECombatQualityLevel::Full;
+        Level = ECombatQualityLevel::Full;
+        OverBudgetTime = 0.0f;
+        UnderBudgetTime = 0.0f;
+        return bChanged;
+    }
+
+    if (SmoothedMs > BudgetMs)
+    {
+        UnderBudgetTime = 0.0f;
+        OverBudgetTime += DeltaTime;
+        if (OverBudgetTime >= DegradeDelay && Level != ECombatQualityLevel::Minimal)
+        {
+            Level = static_cast<ECombatQualityLevel>(static_cast<uint8>(Level) + 1);
+            OverBudgetTime = 0.0f;
+            return true;
+        }
+    }
+    else if (SmoothedMs < BudgetMs * RestoreRatio)
+    {
+        OverBudgetTime = 0.0f;
+        UnderBudgetTime += DeltaTime;
+        if (UnderBudgetTime >= RestoreDelay && Level != ECombatQualityLevel::Full)
+        {
+            Level = static_cast<ECombatQualityLevel>(static_cast<uint8>(Level) - 1);
+            UnderBudgetTime = 0.0f;
+            return true;
+        }
+    }
+    else
+    {
+        // Between the thresholds: hold the current level
+        OverBudgetTime = 0.0f;
+        UnderBudgetTime = 0.0f;
+    }
+
+    return false;
+}
+
+void FCombatBudgetTracker::Reset()
+{
+    Level = ECombatQualityLevel::Full;
+    SmoothedMs = 0.0f;
+    LastFrameMs = 0.0f;
+    OverBudgetTime = 0.0f;
+    UnderBudgetTime = 0.0f;
+}
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+UCombatBudgetSubsystem::UCombatBudgetSubsystem()
+{
+    // Consoles and mobile get roughly half of the desktop frame for the same crowd
+#if PLATFORM_DESKTOP
+    BudgetMs[static_cast<int32>(ECombatBudgetCategory::Traces)] = 1.0f;
+    BudgetMs[static_cast<int32>(ECombatBudgetCategory::Targeting)] = 0.5f;
+    BudgetMs[static_cast<int32>(ECombatBudgetCategory::Queue)] = 0.25f;
+    BudgetMs[static_cast<int32>(ECombatBudgetCategory::Anim)] = 1.0f;
+    TotalBudgetMs = 2.5f;
+#else
+    BudgetMs[static_cast<int32>(ECombatBudgetCategory::Traces)] = 0.5f;
+    BudgetMs[static_cast<int32>(ECombatBudgetCategory::Targeting)] = 0.25f;
+    BudgetMs[static_cast<int32>(ECombatBudgetCategory::Queue)] = 0.15f;
+    BudgetMs[static_cast<int32>(ECombatBudgetCategory::Anim)] = 0.5f;
+    TotalBudgetMs = 1.25f;
+#endif
+}
+
+UCombatBudgetSubsystem* UCombatBudgetSubsystem::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UCombatBudgetSubsystem>() : nullptr;
+}
+
+bool UCombatBudgetSubsystem::IsTickable() const
+{
+    return bEnabled;
+}
+
+TStatId UCombatBudgetSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatBudgetSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatBudgetSubsystem::Tick(float DeltaTime)
+{
+    COMBAT_TRACE_SCOPE(UCombatBudgetSubsystem::Tick);
+
+    Super::Tick(DeltaTime);
+
+    // Totals are shared by every world, so each monitor diffs against its own last sample
+    float CategoryMs[static_cast<int32>(ECombatBudgetCategory::Count)];
+    for (int32 Index = 0; Index < static_cast<int32>(ECombatBudgetCategory::Count); ++Index)
+    {
+        const uint64 TotalCycles = CombatBudget::GetTotalCycles(static_cast<ECombatBudgetCategory>(Index));
+        CategoryMs[Index] = bHasCycleBaseline ? static_cast<float>(FPlatformTime::ToMilliseconds64(TotalCycles - LastTotalCycles[Index])) : 0.0f;
+        LastTotalCycles[Index] = TotalCycles;
+    }
+    bHasCycleBaseline = true;
+
+    EvaluateFrame(CategoryMs, DeltaTime);
+}
+
+// ============================================================================
+// BUDGETS
+// ============================================================================
+
+void UCombatBudgetSubsystem::SetEnabled(bool bInEnabled)
+{
+    bEnabled = bInEnabled;
+    bHasCycleBaseline = false;
+
+    for (FCombatBudgetTracker& Tracker : Trackers)
+    {
+        Tracker.Reset();
+    }
+    TotalTracker.Reset();
+}
+
+void UCombatBudgetSubsystem::EvaluateFrame(TConstArrayView<float> CategoryMs, float DeltaTime)
+{
+    if (!bEnabled)
+    {
+        return;
+    }
+
+    float TotalMs = 0.0f;
+    for (int32 Index = 0; Index < static_cast<int32>(ECombatBudgetCategory::Count); ++Index)
+    {
+        const float FrameMs = CategoryMs.IsValidIndex(Index) ? CategoryMs[Index] : 0.0f;
+        TotalMs += FrameMs;
+
+        if (Trackers[Index].Update(FrameMs, BudgetMs[Index], DeltaTime))
+        {
+            ++NumLevelChanges;
+            COMBAT_LOG(Log, TEXT("[CombatBudget] %s -> %s (%.2f ms, budget %.2f ms)"),
+                GetCategoryName(static_cast<ECombatBudgetCategory>(Index)), GetLevelName(Trackers[Index].Level),
+                Trackers[Index].SmoothedMs, BudgetMs[Index]);
+        }
+    }
+
+    if (TotalTracker.Update(TotalMs, TotalBudgetMs, DeltaTime))
+    {
+        ++NumLevelChanges;
+        COMBAT_LOG(Log, TEXT("[CombatBudget] Total -> %s (%.2f ms, budget %.2f ms)"),
+            GetLevelName(TotalTracker.Level), TotalTracker.SmoothedMs, TotalBudgetMs);
+    }
+}
+
+// ============================================================================
+// QUALITY
+// ============================================================================
+
+ECombatQualityLevel UCombatBudgetSubsystem::GetQualityLevel(ECombatBudgetCategory Category) const
+{
+    return GetTracker(Category).Level;
+}
+
+float UCombatBudgetSubsystem::GetDetailScale(ECombatBudgetCategory Category) const
+{
+    return GetDetailScaleForLevel(GetQualityLevel(Category));
+}
+
+float UCombatBudgetSubsystem::GetDetailScaleFor(const UObject* WorldContextObject, ECombatBudgetCategory Category)
+{
+    const UCombatBudgetSubsystem* Budget = Get(WorldContextObject);
+    return Budget ? Budget->GetDetailScale(Category) : 1.0f;
+}
+
+float UCombatBudgetSubsystem::GetDetailScaleForLevel(ECombatQualityLevel Level) const
+{
+    switch (Level)
+    {
+    case ECombatQualityLevel::Reduced:
+        return FMath::Clamp(ReducedDetailScale, 0.01f, 1.0f);
+    case ECombatQualityLevel::Minimal:
+        return FMath::Clamp(MinimalDetailScale, 0.01f, 1.0f);
+    default:
+        return 1.0f;
+    }
+}
+
+// ============================================================================
+// STATS
+// ============================================================================
+
+const FCombatBudgetTracker& UCombatBudgetSubsystem::GetTracker(ECombatBudgetCategory Category) const
+{
+    const int32 Index = static_cast<int32>(Category);
+    return Index >= 0 && Index < static_cast<int32>(ECombatBudgetCategory::Count) ? Trackers[Index] : TotalTracker;
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatBudgetCommand(
+    TEXT("Combat.Budget"),
+    TEXT("Print combat frame costs and quality levels. Optional arguments: category (Traces, Targeting, Queue, Anim, Total) and its budget in ms (0 = unlimited)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UCombatBudgetSubsystem* Budget = UCombatBudgetSubsystem::Get(World);
+        if (!Budget)
+        {
+            return;
+        }
+
+        if (Args.Num() > 1)
+        {
+            const float NewBudget = FMath::Max(FCString::Atof(*Args[1]), 0.0f);
+            bool bFound = false;
+            for (int32 Index = 0; Index <= static_cast<int32>(ECombatBudgetCategory::Count); ++Index)
+            {
+                if (Args[0].Equals(GetCategoryName(static_cast<ECombatBudgetCategory>(Index)), ESearchCase::IgnoreCase))
+                {
+                    (Index < static_cast<int32>(ECombatBudgetCategory::Count) ? Budget->BudgetMs[Index] : Budget->TotalBudgetMs) = NewBudget;
+                    bFound = true;
+                    break;
+                }
+            }
+
+            if (!bFound)
+            {
+                UE_LOG(LogCombat, Warning, TEXT("[CombatBudget] Unknown category '%s'"), *Args[0]);
+                return;
+            }
+        }
+
+        UE_LOG(LogCombat, Log, TEXT("[CombatBudget] %s, %d level changes"), Budget->IsEnabled() ? TEXT("Enabled") : TEXT("Disabled"), Budget->GetNumLevelChanges());
+        for (int32 Index = 0; Index < static_cast<int32>(ECombatBudgetCategory::Count); ++Index)
+        {
+            const ECombatBudgetCategory Category = static_cast<ECombatBudgetCategory>(Index);
+            const FCombatBudgetTracker& Tracker = Budget->GetTracker(Category);
+            UE_LOG(LogCombat, Log, TEXT("  %-10s %6.2f ms (avg %6.2f) / %5.2f ms  %s"),
+                GetCategoryName(Category), Tracker.LastFrameMs, Tracker.SmoothedMs, Budget->BudgetMs[Index], GetLevelName(Tracker.Level));
+        }
+        const FCombatBudgetTracker& Total = Budget->GetTotalTracker();
+        UE_LOG(LogCombat, Log, TEXT("  %-10s %6.2f ms (avg %6.2f) / %5.2f ms  %s"),
+            TEXT("Total"), Total.LastFrameMs, Total.SmoothedMs, Budget->TotalBudgetMs, GetLevelName(Total.Level));
+    }));
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatBudgetEnableCommand(
+    TEXT("Combat.Budget.Enable"),
+    TEXT("Enable (1) or disable (0) adaptive combat quality. Disabling restores full quality immediately"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (UCombatBudgetSubsystem* Budget = UCombatBudgetSubsystem::Get(World))
+        {
+            Budget->SetEnabled(Args.Num() == 0 || FCString::Atoi(*Args[0]) != 0);
+            UE_LOG(LogCombat, Log, TEXT("[CombatBudget] %s"), Budget->IsEnabled() ? TEXT("Enabled") : TEXT("Disabled"));
+        }
+    }));
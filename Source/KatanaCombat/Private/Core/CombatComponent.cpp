@@ -4,10 +4,23 @@
 #include "MotionWarpingComponent.h"
 #include "Animation/AnimInstance.h"
 #include "Core/TargetingComponent.h"
+#include "Core/ParryWindowSubsystem.h"
+#include "Core/AIDefenseSubsystem.h"
+#include "Core/CombatEventDispatcherSubsystem.h"
+#include "Core/CombatRegistrySubsystem.h"
+#include "Core/CombatScratch.h"
+#include "Core/CombatUIEventSubsystem.h"
+#include "Core/CombatTimerWheelSubsystem.h"
+#include "Core/CombatStateTransitions.h"
+#include "Core/CombatSimCore.h"
+#include "Core/CombatTickManagerSubsystem.h"
+#include "Core/HitStopSubsystem.h"
 #include "Core/WeaponComponent.h"
+#include "Debug/CombatStateTraceSubsystem.h"
 #include "Data/AttackData.h"
 #include "Data/AttackConfiguration.h"
 #include "Data/CombatSettings.h"
+#include "Utilities/MontageUtilityLibrary.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Interfaces/CombatInterface.h"
@@ -39,73 +52,54 @@ void UCombatComponent::BeginPlay()
     if (CombatSettings)
     {
         CurrentPosture = CombatSettings->MaxPosture;
+        bEventDrivenTick = CombatSettings->bEventDrivenCombatTick;
+        bBatchedTick = CombatSettings->bBatchedCombatTick;
     }
-}
 
-void UCombatComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+    if (UCombatTickManagerSubsystem* TickManager = bBatchedTick && GetWorld() ? GetWorld()->GetSubsystem<UCombatTickManagerSubsystem>() : nullptr)
+    {
+        TickManager->RegisterCombatComponent(this);
+    }
+    else
+    {
+        bBatchedTick = false;
+    }
 
-    UpdatePosture(DeltaTime);
+    CommitPosture();
+    RefreshTickEnabled();
 
-    // Update hold state (works for both light and heavy)
-    if (bIsHolding)
+    // UI reads posture through the coalescing bus (sampled once per frame, quantized)
+    if (UCombatUIEventSubsystem* UIEvents = GetWorld() ? GetWorld()->GetSubsystem<UCombatUIEventSubsystem>() : nullptr)
     {
-        UpdateHoldTime(DeltaTime);
+        UIEvents->RegisterCombatComponent(this);
     }
 
-    // Update playback rate blending for holds
-    // PlayRate calculation: 1.0 - Alpha
-    // - Alpha 0.0 → PlayRate 1.0 (normal speed)
-    // - Alpha 1.0 → PlayRate 0.0 (frozen)
-    if (bIsBlendingToHold)
+    // Cross-character queries (who is attacking whom, open windows)
+    if (UCombatRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<UCombatRegistrySubsystem>() : nullptr)
     {
-        // Blend TO hold: increment alpha 0.0 → 1.0 (normal → frozen)
-        HoldBlendAlpha = FMath::Min(1.0f, HoldBlendAlpha + DeltaTime * HoldBlendSpeed);
-        const float PlayRate = 1.0f - HoldBlendAlpha;
+        Registry->RegisterCombatant(this);
+    }
 
-        if (AnimInstance && CurrentAttackData && CurrentAttackData->AttackMontage)
-        {
-            AnimInstance->Montage_SetPlayRate(CurrentAttackData->AttackMontage, PlayRate);
-        }
+    // Rewind Debugger combat track (no-op unless the CombatState trace channel is on)
+    if (UCombatStateTraceSubsystem* StateTrace = UCombatStateTraceSubsystem::Get(this))
+    {
+        StateTrace->RegisterCombatComponent(this);
+    }
+}
 
-        // Check if we've finished blending to hold
-        if (HoldBlendAlpha >= 1.0f)
-        {
-            bIsBlendingToHold = false;
-            HoldBlendAlpha = 1.0f;  // Clamp to exactly 1.0
+void UCombatComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-            // Ensure playback rate is exactly 0.0 (frozen)
-            if (AnimInstance && CurrentAttackData && CurrentAttackData->AttackMontage)
-            {
-                AnimInstance->Montage_SetPlayRate(CurrentAttackData->AttackMontage, 0.0f);
-            }
-        }
-    }
-    else if (bIsBlendingFromHold)
+    // Event-driven tick evaluates posture analytically (GetCurrentPosture)
+    if (!bEventDrivenTick)
     {
-        // Blend FROM hold: decrement alpha 1.0 → 0.0 (frozen → normal)
-        HoldBlendAlpha = FMath::Max(0.0f, HoldBlendAlpha - DeltaTime * HoldBlendSpeed);
-        const float PlayRate = 1.0f - HoldBlendAlpha;
-
-        if (AnimInstance && CurrentAttackData && CurrentAttackData->AttackMontage)
-        {
-            AnimInstance->Montage_SetPlayRate(CurrentAttackData->AttackMontage, PlayRate);
-        }
+        UpdatePosture(DeltaTime);
+    }
 
-        // Check if we've finished blending from hold
-        if (HoldBlendAlpha <= 0.0f)
-        {
-            bIsBlendingFromHold = false;
-            HoldBlendAlpha = 0.0f;  // Clamp to exactly 0.0
+    // Hold playback rate blending runs on UPlayRateEasingSubsystem (StartHoldBlend)
 
-            // Ensure playback rate is exactly 1.0 (normal)
-            if (AnimInstance && CurrentAttackData && CurrentAttackData->AttackMontage)
-            {
-                AnimInstance->Montage_SetPlayRate(CurrentAttackData->AttackMontage, 1.0f);
-            }
-        }
-    }
+    RefreshTickEnabled();
 }
 
 ASamuraiCharacter* UCombatComponent::GetOwnerCharacter()
@@ -140,7 +134,7 @@ UAttackData* UCombatComponent::GetDefaultHeavyAttack() const
 
 void UCombatComponent::OnLightAttackPressed()
 {
-    bLightAttackHeld = true;
+    HeldInputs.Press(EInputType::LightAttack, GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f);
 
     // If we can attack freely (idle state), execute default light attack
     if (CanAttack())
@@ -221,7 +215,7 @@ void UCombatComponent::OnLightAttackPressed()
 
 void UCombatComponent::OnLightAttackReleased()
 {
-    bLightAttackHeld = false;
+    HeldInputs.Release(EInputType::LightAttack, GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f);
 
     if (GetDebugDraw())
     {
@@ -257,7 +251,7 @@ void UCombatComponent::OnLightAttackReleased()
 
 void UCombatComponent::OnHeavyAttackPressed()
 {
-    bHeavyAttackHeld = true;
+    HeldInputs.Press(EInputType::HeavyAttack, GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f);
 
     if (GetDebugDraw())
     {
@@ -358,7 +352,7 @@ void UCombatComponent::OnHeavyAttackPressed()
 
 void UCombatComponent::OnHeavyAttackReleased()
 {
-    bHeavyAttackHeld = false;
+    HeldInputs.Release(EInputType::HeavyAttack, GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f);
 
     if (GetDebugDraw())
     {
@@ -399,17 +393,9 @@ void UCombatComponent::OnEvadePressed()
         SetCombatState(ECombatState::Evading);
 
         // Reset after evade duration
-        if (GetWorld())
+        if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
         {
-            FTimerHandle EvadeTimer;
-            TWeakObjectPtr<UCombatComponent> WeakThis(this);
-            GetWorld()->GetTimerManager().SetTimer(EvadeTimer, [WeakThis]()
-            {
-                if (WeakThis.IsValid())
-                {
-                    WeakThis->SetCombatState(ECombatState::Idle);
-                }
-            }, 0.5f, false);
+            TimerWheel->SetTimer<&UCombatComponent::EndEvade>(EvadeTimer, this, 0.5f);
         }
     }
     else
@@ -419,12 +405,12 @@ void UCombatComponent::OnEvadePressed()
     }
 }
 
-void UCombatComponent::OnBlockPressed()
+void UCombatComponent::OnBlockPressed(float InputTime)
 {
     if (CurrentState == ECombatState::Idle)
     {
         // Try to parry first - if no parry opportunity, will default to blocking
-        TryParry();
+        TryParry(InputTime);
     }
 }
 
@@ -438,17 +424,11 @@ void UCombatComponent::OnBlockReleased()
 
 void UCombatComponent::SetMovementInput(FVector2D Input)
 {
-    // CRITICAL: Ignore movement input entirely during hold state
-    // Prevents conflicts with frozen montage and AnimInstance locomotion updates
-    // Movement input during hold was causing animation state machine conflicts
-    if (bIsHolding)
+    // Single input-sampling stage lives on the character
+    if (OwnerCharacter)
     {
-        // Store zero input to ensure clean state
-        StoredMovementInput = FVector2D::ZeroVector;
-        return;
+        OwnerCharacter->RecordMovementInput(Input);
     }
-
-    StoredMovementInput = Input;
 }
 
 // ============================================================================
@@ -469,7 +449,7 @@ void UCombatComponent::OnAttackPhaseBegin(EAttackPhase Phase)
             // Enable hit detection during active phase
             if (WeaponComponent)
             {
-                WeaponComponent->EnableHitDetection();
+                WeaponComponent->EnableHitDetectionForAttack(CurrentAttackData);
             }
             break;
 
@@ -591,7 +571,7 @@ void UCombatComponent::HandlePhaseBegin(EAttackPhase Phase)
             // AUTOMATIC HIT DETECTION: Enable when Active phase begins
             if (WeaponComponent)
             {
-                WeaponComponent->EnableHitDetection();
+                WeaponComponent->EnableHitDetectionForAttack(CurrentAttackData);
 
                 if (GetDebugDraw())
                 {
@@ -818,26 +798,20 @@ void UCombatComponent::ExecuteComboAttackWithHoldTracking(UAttackData* NextAttac
     // from firing during combo transitions
     bIsHolding = false;
     bIsInHoldWindow = false;
-    bIsBlendingToHold = false;
-    bIsBlendingFromHold = false;
+    StopHoldBlend();
+    EndChargeStages();
     bHoldWindowExpired = false;
     QueuedDirectionalInput = EAttackDirection::None;
     HoldBlendAlpha = 0.0f;
-    CurrentHoldTime = 0.0f;
 
     // Ensure we're in attacking state for combo transitions
     SetCombatState(ECombatState::Attacking);
 
     // Reset combo timer
-    if (GetWorld() && CombatSettings)
+    UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel();
+    if (TimerWheel && CombatSettings)
     {
-        GetWorld()->GetTimerManager().SetTimer(
-            ComboResetTimer,
-            this,
-            &UCombatComponent::ResetComboChain,
-            3.0f, // TODO: Add ComboResetDelay to CombatSettings
-            false
-        );
+        TimerWheel->SetTimer<&UCombatComponent::ResetComboChain>(ComboResetTimer, this, 3.0f); // TODO: Add ComboResetDelay to CombatSettings
     }
 
     if (GetDebugDraw())
@@ -855,11 +829,11 @@ void UCombatComponent::ExecuteComboAttack(UAttackData* NextAttack)
     EInputType InferredType = EInputType::None;
 
     // Try to infer from current buffered states
-    if (bLightAttackHeld || bLightAttackBuffered)
+    if (HeldInputs.IsHeld(EInputType::LightAttack) || bLightAttackBuffered)
     {
         InferredType = EInputType::LightAttack;
     }
-    else if (bHeavyAttackHeld || bHeavyAttackBuffered)
+    else if (HeldInputs.IsHeld(EInputType::HeavyAttack) || bHeavyAttackBuffered)
     {
         InferredType = EInputType::HeavyAttack;
     }
@@ -876,17 +850,12 @@ void UCombatComponent::ExecuteComboAttack(UAttackData* NextAttack)
 // HOLD SYSTEM - UPDATED
 // ============================================================================
 
-void UCombatComponent::UpdateHoldTime(float DeltaTime)
+float UCombatComponent::GetCurrentHoldTime() const
 {
-    if (!CurrentAttackData)
-    {
-        return;
-    }
-
-    CurrentHoldTime += DeltaTime;
-
-    // Don't auto-release on timeout - let the hold window closure handle it
-    // This prevents the animation from jumping to next combo on timeout
+    // Derived from the hold's start stamp - nothing accumulates per tick.
+    // Timeout never auto-releases here; the hold window closure handles it
+    const UWorld* World = GetWorld();
+    return (bIsHolding && CurrentAttackData && World) ? FMath::Max(World->GetTimeSeconds() - HoldStartTime, 0.0f) : 0.0f;
 }
 
 void UCombatComponent::ForceRestoreNormalPlayRate()
@@ -896,8 +865,10 @@ void UCombatComponent::ForceRestoreNormalPlayRate()
         return;
     }
 
-    // Restore our tracked montage if it exists
-    if (CurrentAttackData && CurrentAttackData->AttackMontage)
+    UAnimMontage* ActiveMontage = AnimInstance->GetCurrentActiveMontage();
+
+    // Restore our tracked montage if it is no longer the active one (blending out)
+    if (CurrentAttackData && CurrentAttackData->AttackMontage && CurrentAttackData->AttackMontage != ActiveMontage)
     {
         AnimInstance->Montage_SetPlayRate(CurrentAttackData->AttackMontage, 1.0f);
     }
@@ -907,10 +878,18 @@ void UCombatComponent::ForceRestoreNormalPlayRate()
     // - The montage changed during hold
     // - The montage was interrupted by movement input
     // - State machine tried to transition
-    if (UAnimMontage* ActiveMontage = AnimInstance->GetCurrentActiveMontage())
+    // Dropping every request makes the arbiter write 1.0 once at the end of this frame
+    if (UPlayRateEasingSubsystem* Easing = GetWorld() ? GetWorld()->GetSubsystem<UPlayRateEasingSubsystem>() : nullptr)
+    {
+        Easing->ClearPlayRates(OwnerCharacter);
+    }
+    else if (ActiveMontage)
     {
         AnimInstance->Montage_SetPlayRate(ActiveMontage, 1.0f);
+    }
 
+    if (ActiveMontage)
+    {
         if (GetDebugDraw())
         {
             UE_LOG(LogTemp, Warning, TEXT("[CombatComponent] Force restored playrate to 1.0 for active montage: %s"),
@@ -919,6 +898,150 @@ void UCombatComponent::ForceRestoreNormalPlayRate()
     }
 }
 
+void UCombatComponent::StartHoldBlend(bool bToHold)
+{
+    bIsBlendingToHold = bToHold;
+    bIsBlendingFromHold = !bToHold;
+
+    // PlayRate = 1.0 - Alpha, linear at HoldBlendSpeed alpha/second from wherever the blend currently is
+    const float StartRate = 1.0f - HoldBlendAlpha;
+    const float TargetRate = bToHold ? 0.0f : 1.0f;
+    const float Duration = HoldBlendSpeed > 0.0f ? FMath::Abs(TargetRate - StartRate) / HoldBlendSpeed : 0.0f;
+
+    if (UPlayRateEasingSubsystem* Easing = GetWorld() ? GetWorld()->GetSubsystem<UPlayRateEasingSubsystem>() : nullptr)
+    {
+        HoldBlendEaseHandle = Easing->StartEase(
+            OwnerCharacter,
+            StartRate,
+            TargetRate,
+            Duration,
+            EEasingType::Linear,
+            FOnPlayRateEaseUpdated::CreateUObject(this, &UCombatComponent::OnHoldBlendUpdated),
+            FOnPlayRateEaseFinished::CreateUObject(this, &UCombatComponent::OnHoldBlendFinished));
+    }
+
+    // No scheduler or anim instance - snap to target
+    if (!HoldBlendEaseHandle.IsValid())
+    {
+        OnHoldBlendFinished();
+    }
+}
+
+void UCombatComponent::ResetForTest()
+{
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
+    {
+        for (FCombatTimerHandle* Timer : { &GuardBreakRecoveryTimer, &ComboWindowTimer, &ComboResetTimer, &ParryWindowTimer, &ParryRecoveryTimer,
+                                           &HoldWindowTimer, &CounterWindowTimer, &EvadeTimer, &ChargeStageTimer })
+        {
+            TimerWheel->ClearTimer(*Timer);
+        }
+    }
+
+    StopHoldBlend();
+    ClearChargeStages();
+    EndDuel();
+
+    if (AnimInstance)
+    {
+        AnimInstance->StopAllMontages(0.0f);
+    }
+
+    // State
+    CurrentState = ECombatState::Idle;
+    CurrentPhase = EAttackPhase::None;
+    CurrentAttackData = nullptr;
+
+    // Combo
+    ComboCount = 0;
+    bCanCombo = false;
+    ComboInputBuffer.Reset();
+    bHasQueuedCombo = false;
+    CurrentAttackInputType = EInputType::None;
+
+    // Windows
+    bIsInParryWindow = false;
+    bIsInHoldWindow = false;
+    bIsInCounterWindow = false;
+
+    // Input buffering
+    bLightAttackBuffered = false;
+    bHeavyAttackBuffered = false;
+    bEvadeBuffered = false;
+    bLightAttackInComboWindow = false;
+    bHeavyAttackInComboWindow = false;
+    HeldInputs = FCombatHeldInputs();
+
+    // Charging and holding
+    bIsCharging = false;
+    CurrentChargeTime = 0.0f;
+    ChargeStartTime = 0.0f;
+    bIsHolding = false;
+    HoldStartTime = 0.0f;
+    bHoldWindowExpired = false;
+    QueuedDirectionalInput = EAttackDirection::None;
+    HoldBlendAlpha = 0.0f;
+
+    // Posture: full, anchored now
+    CurrentPosture = GetMaxPosture();
+    PostureAnchorTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+
+    RefreshTickEnabled();
+}
+
+void UCombatComponent::StopHoldBlend()
+{
+    bIsBlendingToHold = false;
+    bIsBlendingFromHold = false;
+
+    if (HoldBlendEaseHandle.IsValid())
+    {
+        if (UPlayRateEasingSubsystem* Easing = GetWorld() ? GetWorld()->GetSubsystem<UPlayRateEasingSubsystem>() : nullptr)
+        {
+            Easing->CancelEase(HoldBlendEaseHandle);
+        }
+        HoldBlendEaseHandle.Reset();
+    }
+}
+
+void UCombatComponent::OnHoldBlendUpdated(float PlayRate)
+{
+    HoldBlendAlpha = 1.0f - PlayRate;
+}
+
+void UCombatComponent::OnHoldBlendFinished()
+{
+    HoldBlendEaseHandle.Reset();
+
+    if (!bIsBlendingToHold && !bIsBlendingFromHold)
+    {
+        return;
+    }
+
+    // Clamp to exactly frozen (1.0) or normal (0.0)
+    const bool bWasBlendingToHold = bIsBlendingToHold;
+    HoldBlendAlpha = bWasBlendingToHold ? 1.0f : 0.0f;
+    bIsBlendingToHold = false;
+    bIsBlendingFromHold = false;
+
+    // Ensure playback rate is exactly 0.0 (frozen) or 1.0 (normal)
+    if (UPlayRateEasingSubsystem* Easing = GetWorld() ? GetWorld()->GetSubsystem<UPlayRateEasingSubsystem>() : nullptr)
+    {
+        if (bWasBlendingToHold)
+        {
+            Easing->RequestPlayRate(OwnerCharacter, EPlayRatePriority::Hold, 0.0f);
+        }
+        else
+        {
+            Easing->ClearPlayRate(OwnerCharacter, EPlayRatePriority::Hold);
+        }
+    }
+    else if (AnimInstance && CurrentAttackData && CurrentAttackData->AttackMontage)
+    {
+        AnimInstance->Montage_SetPlayRate(CurrentAttackData->AttackMontage, 1.0f - HoldBlendAlpha);
+    }
+}
+
 void UCombatComponent::ReleaseHeldLight(bool bWasWindowExpired)
 {
     if (!bIsHolding)
@@ -926,12 +1049,14 @@ void UCombatComponent::ReleaseHeldLight(bool bWasWindowExpired)
         return;
     }
 
+    const float HoldTime = GetCurrentHoldTime();
     bIsHolding = false;
+    EndChargeStages();
 
     if (GetDebugDraw())
     {
         UE_LOG(LogTemp, Warning, TEXT("[CombatComponent] Released held light attack after %.2fs (window expired: %s)"),
-            CurrentHoldTime, bWasWindowExpired ? TEXT("true") : TEXT("false"));
+            HoldTime, bWasWindowExpired ? TEXT("true") : TEXT("false"));
     }
 
     // Re-enable movement
@@ -974,8 +1099,7 @@ void UCombatComponent::ReleaseHeldLight(bool bWasWindowExpired)
                 UE_LOG(LogTemp, Log, TEXT("[CombatComponent] Directional followup found. Executing directional followup"));
             }
             // Stop blending and execute directional attack as a combo
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = false;
+            StopHoldBlend();
             bHoldWindowExpired = false;
             QueuedDirectionalInput = EAttackDirection::None;
             ExecuteComboAttack(FollowUp);
@@ -991,8 +1115,7 @@ void UCombatComponent::ReleaseHeldLight(bool bWasWindowExpired)
                 UE_LOG(LogTemp, Log, TEXT("[CombatComponent] No directional followups available. Using next normal combo"));
             }
             // Stop blending and execute combo
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = false;
+            StopHoldBlend();
             bHoldWindowExpired = false;
             QueuedDirectionalInput = EAttackDirection::None;
             ExecuteComboAttack(CurrentAttackData->NextComboAttack);
@@ -1024,8 +1147,7 @@ void UCombatComponent::ReleaseHeldLight(bool bWasWindowExpired)
         if (AnimInstance->Montage_IsPlaying(CurrentAttackData->AttackMontage))
         {
             // Start blending back to normal speed (0.0 → 1.0)
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = true;
+            StartHoldBlend(false);
             // HoldBlendAlpha is already at 1.0 from the hold blend
 
             // Clear hold window flags
@@ -1050,8 +1172,7 @@ void UCombatComponent::ReleaseHeldLight(bool bWasWindowExpired)
             }
 
             CurrentAttackData = nullptr;
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = false;
+            StopHoldBlend();
             bHoldWindowExpired = false;
             QueuedDirectionalInput = EAttackDirection::None;
             SetCombatState(ECombatState::Idle);
@@ -1061,8 +1182,7 @@ void UCombatComponent::ReleaseHeldLight(bool bWasWindowExpired)
     {
         // No montage to resume - clean up and return to idle
         CurrentAttackData = nullptr;
-        bIsBlendingToHold = false;
-        bIsBlendingFromHold = false;
+        StopHoldBlend();
         bHoldWindowExpired = false;
         QueuedDirectionalInput = EAttackDirection::None;
         SetCombatState(ECombatState::Idle);
@@ -1076,12 +1196,14 @@ void UCombatComponent::ReleaseHeldHeavy(bool bWasWindowExpired)
         return;
     }
 
+    const float HoldTime = GetCurrentHoldTime();
     bIsHolding = false;
+    EndChargeStages();
 
     if (GetDebugDraw())
     {
         UE_LOG(LogTemp, Warning, TEXT("[CombatComponent] Released held heavy attack after %.2fs (window expired: %s)"),
-            CurrentHoldTime, bWasWindowExpired ? TEXT("true") : TEXT("false"));
+            HoldTime, bWasWindowExpired ? TEXT("true") : TEXT("false"));
     }
 
     // Re-enable movement
@@ -1125,8 +1247,7 @@ void UCombatComponent::ReleaseHeldHeavy(bool bWasWindowExpired)
             }
 
             // Stop blending and execute combo WITH EXPLICIT HEAVY INPUT TYPE
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = false;
+            StopHoldBlend();
             bHoldWindowExpired = false;
             QueuedDirectionalInput = EAttackDirection::None;
             // FIX: Use explicit EInputType::HeavyAttack instead of inference
@@ -1143,8 +1264,7 @@ void UCombatComponent::ReleaseHeldHeavy(bool bWasWindowExpired)
                     *CurrentAttackData->NextComboAttack->GetName());
             }
 
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = false;
+            StopHoldBlend();
             bHoldWindowExpired = false;
             QueuedDirectionalInput = EAttackDirection::None;
             // FIX: Use explicit EInputType::HeavyAttack instead of inference
@@ -1176,8 +1296,7 @@ void UCombatComponent::ReleaseHeldHeavy(bool bWasWindowExpired)
         if (AnimInstance->Montage_IsPlaying(CurrentAttackData->AttackMontage))
         {
             // Start blending back to normal speed (0.0 → 1.0)
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = true;
+            StartHoldBlend(false);
             // HoldBlendAlpha is already at 1.0 from the hold blend
 
             // Clear hold window flags
@@ -1201,8 +1320,7 @@ void UCombatComponent::ReleaseHeldHeavy(bool bWasWindowExpired)
             }
 
             CurrentAttackData = nullptr;
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = false;
+            StopHoldBlend();
             bHoldWindowExpired = false;
             QueuedDirectionalInput = EAttackDirection::None;
             SetCombatState(ECombatState::Idle);
@@ -1212,8 +1330,7 @@ void UCombatComponent::ReleaseHeldHeavy(bool bWasWindowExpired)
     {
         // No montage to resume - clean up and return to idle
         CurrentAttackData = nullptr;
-        bIsBlendingToHold = false;
-        bIsBlendingFromHold = false;
+        StopHoldBlend();
         bHoldWindowExpired = false;
         QueuedDirectionalInput = EAttackDirection::None;
         SetCombatState(ECombatState::Idle);
@@ -1224,22 +1341,6 @@ void UCombatComponent::ReleaseHeldHeavy(bool bWasWindowExpired)
 // HEAVY CHARGE SYSTEM
 // ============================================================================
 
-void UCombatComponent::UpdateHeavyCharging(float DeltaTime)
-{
-    if (!CurrentAttackData)
-    {
-        return;
-    }
-
-    CurrentChargeTime += DeltaTime;
-
-    // Auto-release at max charge
-    if (CurrentAttackData && CurrentChargeTime >= CurrentAttackData->MaxChargeTime)
-    {
-        ReleaseChargedHeavy();
-    }
-}
-
 void UCombatComponent::ReleaseChargedHeavy()
 {
     if (!bIsCharging)
@@ -1251,10 +1352,7 @@ void UCombatComponent::ReleaseChargedHeavy()
     SetCombatState(ECombatState::Attacking);
 
     // Resume normal playback speed
-    if (AnimInstance && CurrentAttackData && CurrentAttackData->AttackMontage)
-    {
-        AnimInstance->Montage_SetPlayRate(CurrentAttackData->AttackMontage, 1.0f);
-    }
+    ForceRestoreNormalPlayRate();
 
     if (GetDebugDraw() && CurrentAttackData)
     {
@@ -1264,69 +1362,137 @@ void UCombatComponent::ReleaseChargedHeavy()
 }
 
 // ============================================================================
-// DIRECTIONAL FOLLOW-UPS
+// CHARGE STAGES
 // ============================================================================
 
-void UCombatComponent::ExecuteDirectionalFollowUp(EAttackDirection Direction)
+void UCombatComponent::BeginChargeStages(const UAttackData* Attack, float HoldStartTime)
 {
-    if (!CurrentAttackData)
+    ClearChargeStages();
+
+    if (!Attack || Attack->GetChargeStageTable().IsEmpty())
     {
         return;
     }
 
-    if (UAttackData* FollowUp = CurrentAttackData->DirectionalFollowUps.FindRef(Direction))
-    {
-        CurrentAttackData = FollowUp;
-        PlayAttackMontage(FollowUp);
-    }
+    ChargeAttack = Attack;
+    ChargeStartTime = HoldStartTime;
+    NumChargeStages = Attack->GetChargeStageTable().Num();
+
+    // Enters any stage at 0s (or already passed by a sub-frame hold start) and schedules the next
+    OnChargeStageTimer();
 }
 
-FVector UCombatComponent::GetWorldSpaceMovementInput() const
+void UCombatComponent::EndChargeStages()
 {
-    if (!OwnerCharacter || StoredMovementInput.IsNearlyZero())
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
     {
-        return FVector::ZeroVector;
+        TimerWheel->ClearTimer(ChargeStageTimer);
     }
 
-    // Convert 2D input to world space direction
-    const FRotator ControlRotation = OwnerCharacter->GetControlRotation();
-    const FRotator YawRotation(0, ControlRotation.Yaw, 0);
-
-    const FVector ForwardDir = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X);
-    const FVector RightDir = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y);
+    if (NumChargeStages > 0)
+    {
+        ReleasedChargeStage = ChargeStage;
+    }
+    ChargeStage = INDEX_NONE;
+    NumChargeStages = 0;
+}
 
-    const FVector WorldDir = (ForwardDir * StoredMovementInput.Y) + (RightDir * StoredMovementInput.X);
-    return WorldDir.GetSafeNormal();
+void UCombatComponent::ClearChargeStages()
+{
+    EndChargeStages();
+    ReleasedChargeStage = INDEX_NONE;
+    ChargeAttack.Reset();
 }
 
-EAttackDirection UCombatComponent::GetAttackDirectionFromWorldDirection(const FVector& WorldDir) const
+void UCombatComponent::OnChargeStageTimer()
 {
-    if (!OwnerCharacter || WorldDir.IsNearlyZero())
+    const UAttackData* Attack = ChargeAttack.Get();
+    UWorld* World = GetWorld();
+    if (!Attack || !World || NumChargeStages == 0)
     {
-        return EAttackDirection::Forward;
+        return;
     }
 
-    // Get angle relative to character's forward
-    const FVector CharacterForward = OwnerCharacter->GetActorForwardVector();
-    const float DotProduct = FVector::DotProduct(CharacterForward, WorldDir);
-    const FVector CrossProduct = FVector::CrossProduct(CharacterForward, WorldDir);
+    const FChargeStageTable& Table = Attack->GetChargeStageTable();
+    const float HoldTime = World->GetTimeSeconds() - ChargeStartTime;
+
+    // The wheel fires up to one tick late (more after a hitch): enter every stage passed since, in order,
+    // so listeners see each one
+    const int32 ReachedStage = Table.FindStage(HoldTime + KINDA_SMALL_NUMBER);
+    while (ChargeStage < ReachedStage)
+    {
+        ++ChargeStage;
+        const FChargeStage& Stage = Table.Stages[ChargeStage];
+
+        // A stage playrate takes over from the hold blend
+        if (Stage.PlayRate >= 0.0f)
+        {
+            StopHoldBlend();
+            if (UPlayRateEasingSubsystem* Easing = GetWorld() ? GetWorld()->GetSubsystem<UPlayRateEasingSubsystem>() : nullptr)
+            {
+                Easing->RequestPlayRate(OwnerCharacter, EPlayRatePriority::Hold, Stage.PlayRate);
+            }
+        }
+
+        if (GetDebugDraw())
+        {
+            UE_LOG(LogTemp, Log, TEXT("[CombatComponent] Charge stage %d/%d reached after %.2fs (%s)"),
+                ChargeStage + 1, Table.Num(), HoldTime, *Stage.StageTag.ToString());
+        }
+
+        OnChargeStageChangedNative.Broadcast(ChargeStage, Stage.StageTag);
+        OnChargeStageChanged.Broadcast(ChargeStage, Stage.StageTag);
 
-    // Determine quadrant
-    const float Angle = FMath::RadiansToDegrees(FMath::Acos(DotProduct));
-    const bool bIsRight = CrossProduct.Z > 0.0f;
+        // A listener may have ended the hold
+        if (NumChargeStages == 0)
+        {
+            return;
+        }
+    }
 
-    // 8-directional to 4-directional mapping
-    if (Angle < 45.0f)
+    const float NextStageTime = Table.GetNextStageTime(ChargeStage);
+    if (NextStageTime >= 0.0f)
     {
-        return EAttackDirection::Forward;
+        if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
+        {
+            TimerWheel->SetTimer<&UCombatComponent::OnChargeStageTimer>(ChargeStageTimer, this, NextStageTime - HoldTime);
+        }
     }
-    else if (Angle > 135.0f)
+}
+
+const FChargeStage* UCombatComponent::GetEffectiveChargeStage() const
+{
+    const UAttackData* Attack = ChargeAttack.Get();
+    return Attack ? Attack->GetChargeStageTable().GetStage(ChargeStage != INDEX_NONE ? ChargeStage : ReleasedChargeStage) : nullptr;
+}
+
+float UCombatComponent::GetChargeDamageMultiplier() const
+{
+    const FChargeStage* Stage = GetEffectiveChargeStage();
+    return Stage ? Stage->DamageMultiplier : 1.0f;
+}
+
+float UCombatComponent::GetChargePostureDamageMultiplier() const
+{
+    const FChargeStage* Stage = GetEffectiveChargeStage();
+    return Stage ? Stage->PostureDamageMultiplier : 1.0f;
+}
+
+// ============================================================================
+// DIRECTIONAL FOLLOW-UPS
+// ============================================================================
+
+void UCombatComponent::ExecuteDirectionalFollowUp(EAttackDirection Direction)
+{
+    if (!CurrentAttackData)
     {
-        return EAttackDirection::Backward;
+        return;
     }
-    else
+
+    if (UAttackData* FollowUp = CurrentAttackData->DirectionalFollowUps.FindRef(Direction))
     {
-        return bIsRight ? EAttackDirection::Right : EAttackDirection::Left;
+        CurrentAttackData = FollowUp;
+        PlayAttackMontage(FollowUp);
     }
 }
 
@@ -1348,9 +1514,9 @@ void UCombatComponent::OpenComboWindow(float Duration)
 
     bCanCombo = true;
 
-    if (GetWorld())
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
     {
-        GetWorld()->GetTimerManager().SetTimer(ComboWindowTimer, this, &UCombatComponent::CloseComboWindow, Duration, false);
+        TimerWheel->SetTimer<&UCombatComponent::CloseComboWindow>(ComboWindowTimer, this, Duration);
     }
 
     if (GetDebugDraw())
@@ -1376,9 +1542,9 @@ void UCombatComponent::ResetCombo()
     CurrentAttackData = nullptr;
     ComboInputBuffer.Empty();
 
-    if (GetWorld())
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
     {
-        GetWorld()->GetTimerManager().ClearTimer(ComboResetTimer);
+        TimerWheel->ClearTimer(ComboResetTimer);
     }
 }
 
@@ -1387,6 +1553,25 @@ void UCombatComponent::ResetComboChain()
     ResetCombo();
 }
 
+void UCombatComponent::EndEvade()
+{
+    SetCombatState(ECombatState::Idle);
+}
+
+void UCombatComponent::EndParryRecovery()
+{
+    if (CurrentState == ECombatState::Parrying)
+    {
+        SetCombatState(ECombatState::Idle);
+    }
+}
+
+UCombatTimerWheelSubsystem* UCombatComponent::GetTimerWheel() const
+{
+    const UWorld* World = GetWorld();
+    return World ? World->GetSubsystem<UCombatTimerWheelSubsystem>() : nullptr;
+}
+
 // ============================================================================
 // ATTACK EXECUTION
 // ============================================================================
@@ -1451,16 +1636,12 @@ void UCombatComponent::SetupMotionWarping(UAttackData* AttackData)
         return;
     }
 
-    // Find target in default direction (forward/none)
-    AActor* Target = TargetingComponent->FindTarget(EAttackDirection::None);
+    // Find target in default direction (forward/none) that the attack's baked reach can close on
+    AActor* Target = TargetingComponent->FindTargetForAttack(AttackData, EAttackDirection::None);
 
     if (Target)
     {
-        const FMotionWarpingTarget WarpTarget(
-            AttackData->MotionWarpingConfig.MotionWarpingTargetName,
-            Target->GetActorTransform()
-        );
-        MotionWarpingComponent->AddOrUpdateWarpTarget(WarpTarget);
+        TargetingComponent->SetupMotionWarpForAttack(Target, AttackData);
     }
 }
 
@@ -1513,149 +1694,147 @@ bool UCombatComponent::PlayAttackMontage(UAttackData* AttackData)
         }
     }
 
-    // Set up montage end delegate for cleanup when animation completes or is interrupted
-    FOnMontageEnded OnMontageEndDelegate;
-    OnMontageEndDelegate.BindLambda([this, AttackDataPtr = AttackData](UAnimMontage* Montage, bool bInterrupted)
+    // Native montage end delegate for cleanup when animation completes or is interrupted
+    // (weak UObject binding, the attack it was played for rides along as payload)
+    FOnMontageEnded OnMontageEndDelegate = FOnMontageEnded::CreateUObject(this, &UCombatComponent::OnAttackMontageEnded, AttackData);
+    AnimInstance->Montage_SetEndDelegate(OnMontageEndDelegate, AttackData->AttackMontage);
+
+    // Let AI defenders schedule their reactions against this attack's windows
+    if (UAIDefenseSubsystem* DefenseSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UAIDefenseSubsystem>() : nullptr)
+    {
+        DefenseSubsystem->NotifyAttackStarted(GetOwner(), AnimInstance, AttackData->AttackMontage, AttackData->MontageSection);
+    }
+
+    return true;
+}
+
+void UCombatComponent::OnAttackMontageEnded(UAnimMontage* Montage, bool bInterrupted, UAttackData* EndedAttackData)
+{
+    // FIX: Detect intentional interruptions (combo transitions)
+    // If the montage that ended is NOT the current attack, this was a combo transition
+    // In that case, don't reset to Idle - the new attack is already active
+    if (bInterrupted && CurrentAttackData != nullptr && CurrentAttackData != EndedAttackData)
+    {
+        if (GetDebugDraw())
+        {
+            UE_LOG(LogTemp, Log, TEXT("[CombatComponent] Old montage interrupted by new combo - ignoring (intentional)"));
+        }
+        return; // Combo transition - do nothing
+    }
+
+    // Handle natural completion
+    if (!bInterrupted && CurrentState == ECombatState::Attacking)
     {
-        // FIX: Detect intentional interruptions (combo transitions)
-        // If the montage that ended is NOT the current attack, this was a combo transition
-        // In that case, don't reset to Idle - the new attack is already active
-        if (bInterrupted && CurrentAttackData != nullptr && CurrentAttackData != AttackDataPtr)
+        if (GetDebugDraw())
         {
-            if (GetDebugDraw())
-            {
-                UE_LOG(LogTemp, Log, TEXT("[CombatComponent] Old montage interrupted by new combo - ignoring (intentional)"));
-            }
-            return; // Combo transition - do nothing
+            UE_LOG(LogTemp, Warning, TEXT("[CombatComponent] Attack montage completed naturally - cleaning up"));
         }
 
-        // Handle natural completion
-        if (!bInterrupted && CurrentState == ECombatState::Attacking)
+        // CRITICAL FIX: Call phase end handler BEFORE clearing state
+        // This ensures ProcessRecoveryComplete() is called for buffered inputs outside combo window
+        if (CurrentPhase == EAttackPhase::Recovery)
         {
             if (GetDebugDraw())
             {
-                UE_LOG(LogTemp, Warning, TEXT("[CombatComponent] Attack montage completed naturally - cleaning up"));
-            }
-
-            // CRITICAL FIX: Call phase end handler BEFORE clearing state
-            // This ensures ProcessRecoveryComplete() is called for buffered inputs outside combo window
-            if (CurrentPhase == EAttackPhase::Recovery)
-            {
-                if (GetDebugDraw())
-                {
-                    UE_LOG(LogTemp, Log, TEXT("[PHASE] Montage ended during Recovery → Calling HandlePhaseEnd"));
-                }
-                HandlePhaseEnd(EAttackPhase::Recovery);
+                UE_LOG(LogTemp, Log, TEXT("[PHASE] Montage ended during Recovery → Calling HandlePhaseEnd"));
             }
+            HandlePhaseEnd(EAttackPhase::Recovery);
+        }
 
-            // Natural completion - clean up and return to idle
-            CurrentAttackData = nullptr;
-            CurrentAttackInputType = EInputType::None;
+        // Natural completion - clean up and return to idle
+        CurrentAttackData = nullptr;
+        CurrentAttackInputType = EInputType::None;
 
-            // IMPLICIT RECOVERY END: Montage ends → exit Recovery phase
-            CurrentPhase = EAttackPhase::None;
+        // IMPLICIT RECOVERY END: Montage ends → exit Recovery phase
+        CurrentPhase = EAttackPhase::None;
 
-            if (GetDebugDraw())
-            {
-                UE_LOG(LogTemp, Log, TEXT("[PHASE] Montage ended → None phase (implicit Recovery end)"));
-            }
-            bLightAttackBuffered = false;
-            bHeavyAttackBuffered = false;
-            bLightAttackInComboWindow = false;
-            bHeavyAttackInComboWindow = false;
-            ComboInputBuffer.Empty();
-            bHasQueuedCombo = false;
+        if (GetDebugDraw())
+        {
+            UE_LOG(LogTemp, Log, TEXT("[PHASE] Montage ended → None phase (implicit Recovery end)"));
+        }
+        bLightAttackBuffered = false;
+        bHeavyAttackBuffered = false;
+        bLightAttackInComboWindow = false;
+        bHeavyAttackInComboWindow = false;
+        ComboInputBuffer.Empty();
+        bHasQueuedCombo = false;
 
-            // Clear hold and blend states if montage ends during hold
-            bIsHolding = false;
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = false;
-            HoldBlendAlpha = 0.0f;
+        // Clear hold and blend states if montage ends during hold
+        bIsHolding = false;
+        StopHoldBlend();
+        EndChargeStages();
+        HoldBlendAlpha = 0.0f;
 
-            SetCombatState(ECombatState::Idle);
-        }
-        // CRITICAL SAFETY: Handle montage interruption during hold state
-        else if (bInterrupted && (bIsHolding || bIsBlendingToHold || bIsBlendingFromHold))
+        SetCombatState(ECombatState::Idle);
+    }
+    // CRITICAL SAFETY: Handle montage interruption during hold state
+    else if (bInterrupted && (bIsHolding || bIsBlendingToHold || bIsBlendingFromHold))
+    {
+        if (GetDebugDraw())
         {
-            if (GetDebugDraw())
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[CombatComponent] Attack montage interrupted during hold - force cleanup"));
-            }
+            UE_LOG(LogTemp, Warning, TEXT("[CombatComponent] Attack montage interrupted during hold - force cleanup"));
+        }
 
-            // Force restore normal montage playback rate for any active montage
-            if (AnimInstance)
-            {
-                UAnimMontage* ActiveMontage = AnimInstance->GetCurrentActiveMontage();
-                if (ActiveMontage)
-                {
-                    AnimInstance->Montage_SetPlayRate(ActiveMontage, 1.0f);
-                }
-            }
+        // Force restore normal montage playback rate for any active montage
+        ForceRestoreNormalPlayRate();
 
-            // Re-enable movement (in case it was disabled during hold)
-            if (OwnerCharacter && OwnerCharacter->GetCharacterMovement())
-            {
-                OwnerCharacter->GetCharacterMovement()->SetMovementMode(MOVE_Walking);
-            }
+        // Re-enable movement (in case it was disabled during hold)
+        if (OwnerCharacter && OwnerCharacter->GetCharacterMovement())
+        {
+            OwnerCharacter->GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+        }
 
-            // Clear all hold-related state
-            bIsHolding = false;
-            bIsInHoldWindow = false;
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = false;
-            bHoldWindowExpired = false;
-            QueuedDirectionalInput = EAttackDirection::None;
-            HoldBlendAlpha = 0.0f;
-            CurrentHoldTime = 0.0f;
+        // Clear all hold-related state
+        bIsHolding = false;
+        bIsInHoldWindow = false;
+        StopHoldBlend();
+        EndChargeStages();
+        bHoldWindowExpired = false;
+        QueuedDirectionalInput = EAttackDirection::None;
+        HoldBlendAlpha = 0.0f;
 
-            // FIX: Clear attack state and return to Idle to prevent lockout
-            CurrentAttackData = nullptr;
-            CurrentAttackInputType = EInputType::None;
-            CurrentPhase = EAttackPhase::None;
-            bLightAttackBuffered = false;
-            bHeavyAttackBuffered = false;
-            bLightAttackInComboWindow = false;
-            bHeavyAttackInComboWindow = false;
-            ComboInputBuffer.Empty();
-            bHasQueuedCombo = false;
+        // FIX: Clear attack state and return to Idle to prevent lockout
+        CurrentAttackData = nullptr;
+        CurrentAttackInputType = EInputType::None;
+        CurrentPhase = EAttackPhase::None;
+        bLightAttackBuffered = false;
+        bHeavyAttackBuffered = false;
+        bLightAttackInComboWindow = false;
+        bHeavyAttackInComboWindow = false;
+        ComboInputBuffer.Empty();
+        bHasQueuedCombo = false;
 
-            SetCombatState(ECombatState::Idle);
-        }
-        // FIX: SAFETY - Handle ANY other interruption during Attacking/Holding state
-        else if (bInterrupted && (CurrentState == ECombatState::Attacking || CurrentState == ECombatState::HoldingLightAttack))
+        SetCombatState(ECombatState::Idle);
+    }
+    // FIX: SAFETY - Handle ANY other interruption during Attacking/Holding state
+    else if (bInterrupted && (CurrentState == ECombatState::Attacking || CurrentState == ECombatState::HoldingLightAttack))
+    {
+        if (GetDebugDraw())
         {
-            if (GetDebugDraw())
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[CombatComponent] Attack montage interrupted (non-hold) - force return to Idle"));
-            }
-
-            // Full state cleanup
-            CurrentAttackData = nullptr;
-            CurrentAttackInputType = EInputType::None;
-            CurrentPhase = EAttackPhase::None;
-            bLightAttackBuffered = false;
-            bHeavyAttackBuffered = false;
-            bLightAttackInComboWindow = false;
-            bHeavyAttackInComboWindow = false;
-            ComboInputBuffer.Empty();
-            bHasQueuedCombo = false;
+            UE_LOG(LogTemp, Warning, TEXT("[CombatComponent] Attack montage interrupted (non-hold) - force return to Idle"));
+        }
 
-            // Clear hold state (redundant safety)
-            bIsHolding = false;
-            bIsInHoldWindow = false;
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = false;
-            bHoldWindowExpired = false;
-            QueuedDirectionalInput = EAttackDirection::None;
-            HoldBlendAlpha = 0.0f;
-            CurrentHoldTime = 0.0f;
+        // Full state cleanup
+        CurrentAttackData = nullptr;
+        CurrentAttackInputType = EInputType::None;
+        CurrentPhase = EAttackPhase::None;
+        bLightAttackBuffered = false;
+        bHeavyAttackBuffered = false;
+        bLightAttackInComboWindow = false;
+        bHeavyAttackInComboWindow = false;
+        ComboInputBuffer.Empty();
+        bHasQueuedCombo = false;
 
-            SetCombatState(ECombatState::Idle);
-        }
-    });
-    AnimInstance->Montage_SetEndDelegate(OnMontageEndDelegate, AttackData->AttackMontage);
+        // Clear hold state (redundant safety)
+        bIsHolding = false;
+        bIsInHoldWindow = false;
+        StopHoldBlend();
+        bHoldWindowExpired = false;
+        QueuedDirectionalInput = EAttackDirection::None;
+        HoldBlendAlpha = 0.0f;
 
-    return true;
+        SetCombatState(ECombatState::Idle);
+    }
 }
 
 // ============================================================================
@@ -1664,15 +1843,10 @@ bool UCombatComponent::PlayAttackMontage(UAttackData* AttackData)
 
 void UCombatComponent::SetCombatState(ECombatState NewState)
 {
-    if (CurrentState == NewState)
-    {
-        return;
-    }
-
-    // Validate the state transition
+    // Validate the state transition (same-state requests are silently ignored)
     if (!CanTransitionTo(NewState))
     {
-        if (GetDebugDraw())
+        if (CurrentState != NewState && GetDebugDraw())
         {
             UE_LOG(LogTemp, Error, TEXT("CombatComponent: Invalid state transition %d -> %d blocked!"),
                 static_cast<int32>(CurrentState), static_cast<int32>(NewState));
@@ -1680,6 +1854,9 @@ void UCombatComponent::SetCombatState(ECombatState NewState)
         return;
     }
 
+    // Analytic posture: bank regen at the old state's rate before the rate changes
+    CommitPosture();
+
     const ECombatState OldState = CurrentState;
     CurrentState = NewState;
 
@@ -1696,17 +1873,22 @@ void UCombatComponent::SetCombatState(ECombatState NewState)
         }
     }
 
+    // A dead duelist releases the pair (the survivor goes back to world queries)
+    if (NewState == ECombatState::Dead)
+    {
+        EndDuel();
+    }
+
     // CRITICAL SAFETY: Force exit hold state if entering Dead state
     // Prevents frozen corpses and stuck blend states
     if (NewState == ECombatState::Dead)
     {
+        ClearChargeStages();
+
         if (bIsHolding || bIsBlendingToHold || bIsBlendingFromHold)
         {
             // Force restore normal montage playback rate
-            if (AnimInstance && CurrentAttackData && CurrentAttackData->AttackMontage)
-            {
-                AnimInstance->Montage_SetPlayRate(CurrentAttackData->AttackMontage, 1.0f);
-            }
+            ForceRestoreNormalPlayRate();
 
             // Re-enable movement (in case it was disabled during hold)
             if (OwnerCharacter && OwnerCharacter->GetCharacterMovement())
@@ -1717,12 +1899,10 @@ void UCombatComponent::SetCombatState(ECombatState NewState)
             // Clear all hold-related state
             bIsHolding = false;
             bIsInHoldWindow = false;
-            bIsBlendingToHold = false;
-            bIsBlendingFromHold = false;
+            StopHoldBlend();
             bHoldWindowExpired = false;
             QueuedDirectionalInput = EAttackDirection::None;
             HoldBlendAlpha = 0.0f;
-            CurrentHoldTime = 0.0f;
 
             if (GetDebugDraw())
             {
@@ -1754,26 +1934,28 @@ void UCombatComponent::SetCombatState(ECombatState NewState)
         // Clear hold state
         bIsHolding = false;
         bIsInHoldWindow = false;
-        CurrentHoldTime = 0.0f;
         bHoldWindowExpired = false;
         QueuedDirectionalInput = EAttackDirection::None;
+        ClearChargeStages();
 
         // Clear blend states
-        bIsBlendingToHold = false;
-        bIsBlendingFromHold = false;
+        StopHoldBlend();
         HoldBlendAlpha = 0.0f;
 
         // Clear other window states
-        bIsInParryWindow = false;
+        if (bIsInParryWindow)
+        {
+            CloseParryWindow();
+        }
         bIsInCounterWindow = false;
 
         // Clear any pending timers
-        if (GetWorld())
+        if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
         {
-            GetWorld()->GetTimerManager().ClearTimer(ComboWindowTimer);
-            GetWorld()->GetTimerManager().ClearTimer(HoldWindowTimer);
-            GetWorld()->GetTimerManager().ClearTimer(ParryWindowTimer);
-            GetWorld()->GetTimerManager().ClearTimer(CounterWindowTimer);
+            TimerWheel->ClearTimer(ComboWindowTimer);
+            TimerWheel->ClearTimer(HoldWindowTimer);
+            TimerWheel->ClearTimer(ParryWindowTimer);
+            TimerWheel->ClearTimer(CounterWindowTimer);
         }
 
         if (GetDebugDraw())
@@ -1782,8 +1964,14 @@ void UCombatComponent::SetCombatState(ECombatState NewState)
         }
     }
 
+    OnCombatStateChangedNative.Broadcast(NewState);
     OnCombatStateChanged.Broadcast(NewState);
 
+    if (FCombatEvent* Event = UCombatEventDispatcherSubsystem::PublishFrom(this, ECombatEventKind::CombatState, GetOwner()))
+    {
+        Event->Arg0 = static_cast<uint8>(NewState);
+    }
+
     if (GetDebugDraw())
     {
         UE_LOG(LogTemp, Warning, TEXT("CombatComponent: State %d -> %d"), static_cast<int32>(OldState), static_cast<int32>(NewState));
@@ -1792,109 +1980,70 @@ void UCombatComponent::SetCombatState(ECombatState NewState)
 
 bool UCombatComponent::CanTransitionTo(ECombatState NewState) const
 {
-    // Dead state is terminal - no transitions allowed
-    if (CurrentState == ECombatState::Dead)
+    // One lookup in the shared table (Dead is terminal, same-state never allowed)
+    return CombatStateTransitions::CanTransition(CurrentState, NewState);
+}
+
+bool UCombatComponent::IsAttacking() const
+{
+    return CurrentState == ECombatState::Attacking ||
+           CurrentState == ECombatState::ChargingHeavyAttack ||
+           CurrentState == ECombatState::HoldingLightAttack;
+}
+
+const FCombatQuerySnapshot& UCombatComponent::GetQuerySnapshot() const
+{
+    QuerySnapshot.CombatState = CurrentState;
+    QuerySnapshot.CurrentPhase = CurrentPhase;
+    QuerySnapshot.CurrentAttack = CurrentAttackData;
+    QuerySnapshot.bCanAttack = CanAttack();
+    QuerySnapshot.bIsAttacking = IsAttacking();
+    QuerySnapshot.bIsInParryWindow = bIsInParryWindow;
+    return QuerySnapshot;
+}
+
+const FCombatAnimState& UCombatComponent::PublishAnimState()
+{
+    FCombatAnimState& State = PublishedAnimState;
+
+    const bool bAttackingNow = IsAttacking();
+    const bool bBlockingNow = IsBlocking();
+    const bool bGuardBrokenNow = IsGuardBroken();
+    if (State.CombatState != CurrentState || State.CurrentPhase != CurrentPhase ||
+        State.bIsAttacking != bAttackingNow || State.bIsBlocking != bBlockingNow ||
+        State.bIsGuardBroken != bGuardBrokenNow || State.bIsHolding != bIsHolding)
     {
-        return false;
+        State.CombatState = CurrentState;
+        State.CurrentPhase = CurrentPhase;
+        State.bIsAttacking = bAttackingNow;
+        State.bIsBlocking = bBlockingNow;
+        State.bIsGuardBroken = bGuardBrokenNow;
+        State.bIsHolding = bIsHolding;
+        ++State.StateVersion;
     }
 
-    // Can't transition to the same state
-    if (CurrentState == NewState)
+    if (State.ComboCount != ComboCount || State.bCanCombo != bCanCombo)
     {
-        return false;
+        State.ComboCount = ComboCount;
+        State.bCanCombo = bCanCombo;
+        ++State.ComboVersion;
     }
 
-    // Define valid state transitions
-    switch (CurrentState)
-    {
-        case ECombatState::Idle:
-            // From Idle, can transition to any action state
-            return NewState == ECombatState::Attacking ||
-                   NewState == ECombatState::Blocking ||
-                   NewState == ECombatState::Evading ||
-                   NewState == ECombatState::HoldingLightAttack ||
-                   NewState == ECombatState::ChargingHeavyAttack ||
-                   NewState == ECombatState::HitStunned ||
-                   NewState == ECombatState::GuardBroken ||
-                   NewState == ECombatState::Dead;
-
-        case ECombatState::Attacking:
-            // From Attacking, can transition to hold states, hit reactions, or idle
-            return NewState == ECombatState::Idle ||
-                   NewState == ECombatState::HoldingLightAttack ||
-                   NewState == ECombatState::ChargingHeavyAttack ||
-                   NewState == ECombatState::HitStunned ||
-                   NewState == ECombatState::GuardBroken ||
-                   NewState == ECombatState::Dead;
-
-        case ECombatState::HoldingLightAttack:
-            // From holding, can return to attacking or idle, or be interrupted
-            return NewState == ECombatState::Attacking ||
-                   NewState == ECombatState::Idle ||
-                   NewState == ECombatState::HitStunned ||
-                   NewState == ECombatState::Dead;
-
-        case ECombatState::ChargingHeavyAttack:
-            // From charging, can release to attacking or be interrupted
-            return NewState == ECombatState::Attacking ||
-                   NewState == ECombatState::Idle ||
-                   NewState == ECombatState::HitStunned ||
-                   NewState == ECombatState::Dead;
-
-        case ECombatState::Blocking:
-            // From blocking, can parry, be guard broken, or return to idle
-            return NewState == ECombatState::Idle ||
-                   NewState == ECombatState::Parrying ||
-                   NewState == ECombatState::GuardBroken ||
-                   NewState == ECombatState::HitStunned ||
-                   NewState == ECombatState::Evading ||
-                   NewState == ECombatState::Dead;
-
-        case ECombatState::Parrying:
-            // From parrying, return to idle or counter attack
-            return NewState == ECombatState::Idle ||
-                   NewState == ECombatState::Attacking ||
-                   NewState == ECombatState::Dead;
-
-        case ECombatState::GuardBroken:
-            // From guard broken, can only recover to idle or die
-            return NewState == ECombatState::Idle ||
-                   NewState == ECombatState::Finishing ||  // Can be finished during guard break
-                   NewState == ECombatState::Dead;
-
-        case ECombatState::Finishing:
-            // From finishing, return to idle or die
-            return NewState == ECombatState::Idle ||
-                   NewState == ECombatState::Dead;
-
-        case ECombatState::HitStunned:
-            // From hit stun, recover to idle or be hit again, or die
-            return NewState == ECombatState::Idle ||
-                   NewState == ECombatState::HitStunned ||  // Can be hit again while stunned
-                   NewState == ECombatState::GuardBroken ||
-                   NewState == ECombatState::Dead;
-
-        case ECombatState::Evading:
-            // From evading, return to idle or attack
-            return NewState == ECombatState::Idle ||
-                   NewState == ECombatState::Attacking ||
-                   NewState == ECombatState::Dead;
-
-        case ECombatState::Dead:
-            // Dead is terminal state - only allow reset to Idle (for respawn/tests)
-            return NewState == ECombatState::Idle;
+    const float PosturePercentNow = GetPosturePercent();
+    if (State.PosturePercent != PosturePercentNow)
+    {
+        State.PosturePercent = PosturePercentNow;
+        ++State.PostureVersion;
+    }
 
-        default:
-            // Unknown state - be conservative and deny transition
-            return false;
+    if (State.ChargeStage != ChargeStage || State.NumChargeStages != NumChargeStages)
+    {
+        State.ChargeStage = ChargeStage;
+        State.NumChargeStages = NumChargeStages;
+        ++State.ChargeVersion;
     }
-}
 
-bool UCombatComponent::IsAttacking() const
-{
-    return CurrentState == ECombatState::Attacking ||
-           CurrentState == ECombatState::ChargingHeavyAttack ||
-           CurrentState == ECombatState::HoldingLightAttack;
+    return State;
 }
 
 void UCombatComponent::StopCurrentAttack()
@@ -1937,31 +2086,13 @@ void UCombatComponent::TriggerGuardBreak()
 float UCombatComponent::GetPosturePercent() const
 {
     const float MaxPosture = GetMaxPosture();
-    return MaxPosture > 0.0f ? (CurrentPosture / MaxPosture) : 0.0f;
+    return MaxPosture > 0.0f ? (GetCurrentPosture() / MaxPosture) : 0.0f;
 }
 
 float UCombatComponent::GetCurrentPostureRegenRate() const
 {
-    if (!CombatSettings)
-    {
-        return 0.0f;
-    }
-
-    switch (CurrentState)
-    {
-        case ECombatState::Attacking:
-        case ECombatState::ChargingHeavyAttack:
-        case ECombatState::HoldingLightAttack:
-            return CombatSettings->PostureRegenRate_Attacking;
-
-        case ECombatState::Blocking:
-            return 0.0f;
-
-        case ECombatState::Idle:
-        case ECombatState::Evading:
-        default:
-            return CombatSettings->PostureRegenRate_Idle;
-    }
+    // Same rule the headless simulation uses
+    return CombatSettings ? FCombatSimCore::GetPostureRegenRate(FCombatSimCore::CookConfig(CombatSettings), CurrentState) : 0.0f;
 }
 
 void UCombatComponent::ClearInputBuffers()
@@ -2050,39 +2181,74 @@ void UCombatComponent::ProcessRecoveryComplete()
 // POSTURE SYSTEM
 // ============================================================================
 
-void
+void UCombatComponent::UpdatePosture(float DeltaTime)
+{
+    const float RegenRate = GetCurrentPostureRegenRate();
+    if (RegenRate > 0.0f)
+    {
+        RestorePosture(RegenRate * DeltaTime);
+    }
+}
 
-UCombatComponent::UpdatePosture(float DeltaTime)
+float UCombatComponent::GetCurrentPosture() const
 {
-    if (!CombatSettings || CurrentState == ECombatState::GuardBroken)
+    const UWorld* World = GetWorld();
+    return (bEventDrivenTick && World) ? EvaluatePosture(World->GetTimeSeconds()) : CurrentPosture;
+}
+
+float UCombatComponent::EvaluatePosture(float Time) const
+{
+    if (!CombatSettings)
     {
-        return;
+        return CurrentPosture;
     }
 
-    float RegenRate = 0.0f;
+    return FCombatSimCore::EvaluatePosture(FCombatSimCore::CookConfig(CombatSettings), CurrentState, CurrentPosture, Time - PostureAnchorTime);
+}
 
-    switch (CurrentState)
+void UCombatComponent::CommitPosture()
+{
+    const UWorld* World = GetWorld();
+    if (!bEventDrivenTick || !World)
     {
-        case ECombatState::Attacking:
-        case ECombatState::ChargingHeavyAttack:
-        case ECombatState::HoldingLightAttack:
-            RegenRate = CombatSettings->PostureRegenRate_Attacking;
-            break;
+        return;
+    }
 
-        case ECombatState::Blocking:
-            RegenRate = 0.0f;
-            break;
+    const float Now = World->GetTimeSeconds();
+    CurrentPosture = EvaluatePosture(Now);
+    PostureAnchorTime = Now;
+}
 
-        case ECombatState::Idle:
-        case ECombatState::Evading:
-        default:
-            RegenRate = CombatSettings->PostureRegenRate_Idle;
-            break;
+void UCombatComponent::RefreshTickEnabled()
+{
+    // Batched: the tick manager does the per-frame work
+    if (bBatchedTick)
+    {
+        SetComponentTickEnabled(false);
+        return;
     }
 
-    if (RegenRate > 0.0f)
+    // Per-frame mode always ticks (UpdatePosture); holds are timestamped, so event-driven mode never does
+    if (bEventDrivenTick)
     {
-        RestorePosture(RegenRate * DeltaTime);
+        SetComponentTickEnabled(false);
+    }
+}
+
+void UCombatComponent::GatherBatchedTick(FCombatTickInput& OutInput) const
+{
+    OutInput.Posture = CurrentPosture;
+    OutInput.MaxPosture = GetMaxPosture();
+
+    // Event-driven tick evaluates posture analytically (GetCurrentPosture)
+    OutInput.PostureRegenRate = bEventDrivenTick ? 0.0f : GetCurrentPostureRegenRate();
+}
+
+void UCombatComponent::ApplyBatchedTick(const FCombatTickOutput& Output)
+{
+    if (Output.bPostureChanged)
+    {
+        RestorePosture(Output.Posture - CurrentPosture);
     }
 }
 
@@ -2093,7 +2259,9 @@ float UCombatComponent::GetMaxPosture() const
 
 bool UCombatComponent::ApplyPostureDamage(float Amount)
 {
+    CommitPosture();
     CurrentPosture = FMath::Max(0.0f, CurrentPosture - Amount);
+    PublishPostureEvent();
 
     if (CurrentPosture <= 0.0f)
     {
@@ -2106,24 +2274,32 @@ bool UCombatComponent::ApplyPostureDamage(float Amount)
 
 void UCombatComponent::RestorePosture(float Amount)
 {
+    CommitPosture();
+
     const float MaxPosture = GetMaxPosture();
     CurrentPosture = FMath::Min(MaxPosture, CurrentPosture + Amount);
+    PublishPostureEvent();
+}
+
+void UCombatComponent::PublishPostureEvent()
+{
+    if (FCombatEvent* Event = UCombatEventDispatcherSubsystem::PublishFrom(this, ECombatEventKind::Posture, GetOwner()))
+    {
+        Event->Magnitude = CurrentPosture;
+    }
 }
 
 void UCombatComponent::HandleGuardBreak()
 {
     SetCombatState(ECombatState::GuardBroken);
+    OnGuardBrokenNative.Broadcast();
     OnGuardBroken.Broadcast();
+    UCombatEventDispatcherSubsystem::PublishFrom(this, ECombatEventKind::GuardBroken, GetOwner());
 
-    if (GetWorld() && CombatSettings)
+    UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel();
+    if (TimerWheel && CombatSettings)
     {
-        GetWorld()->GetTimerManager().SetTimer(
-            GuardBreakRecoveryTimer,
-            this,
-            &UCombatComponent::RecoverFromGuardBreak,
-            CombatSettings->GuardBreakStunDuration,
-            false
-        );
+        TimerWheel->SetTimer<&UCombatComponent::RecoverFromGuardBreak>(GuardBreakRecoveryTimer, this, CombatSettings->GuardBreakStunDuration);
     }
 }
 
@@ -2145,9 +2321,9 @@ void UCombatComponent::OpenCounterWindow(float Duration)
 {
     bIsInCounterWindow = true;
 
-    if (GetWorld())
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
     {
-        GetWorld()->GetTimerManager().SetTimer(CounterWindowTimer, this, &UCombatComponent::CloseCounterWindow, Duration, false);
+        TimerWheel->SetTimer<&UCombatComponent::CloseCounterWindow>(CounterWindowTimer, this, Duration);
     }
 }
 
@@ -2155,9 +2331,9 @@ void UCombatComponent::CloseCounterWindow()
 {
     bIsInCounterWindow = false;
 
-    if (GetWorld())
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
     {
-        GetWorld()->GetTimerManager().ClearTimer(CounterWindowTimer);
+        TimerWheel->ClearTimer(CounterWindowTimer);
     }
 }
 
@@ -2169,9 +2345,19 @@ void UCombatComponent::OpenParryWindow(float Duration)
 {
     bIsInParryWindow = true;
 
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
+    {
+        TimerWheel->SetTimer<&UCombatComponent::CloseParryWindow>(ParryWindowTimer, this, Duration);
+    }
+
     if (GetWorld())
     {
-        GetWorld()->GetTimerManager().SetTimer(ParryWindowTimer, this, &UCombatComponent::CloseParryWindow, Duration, false);
+
+        // Make this attacker visible to defenders' TryParry queries
+        if (UParryWindowSubsystem* ParrySubsystem = GetWorld()->GetSubsystem<UParryWindowSubsystem>())
+        {
+            ParrySubsystem->RegisterParryWindow(GetOwner());
+        }
     }
 
     if (GetDebugDraw())
@@ -2184,9 +2370,17 @@ void UCombatComponent::CloseParryWindow()
 {
     bIsInParryWindow = false;
 
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
+    {
+        TimerWheel->ClearTimer(ParryWindowTimer);
+    }
+
     if (GetWorld())
     {
-        GetWorld()->GetTimerManager().ClearTimer(ParryWindowTimer);
+        if (UParryWindowSubsystem* ParrySubsystem = GetWorld()->GetSubsystem<UParryWindowSubsystem>())
+        {
+            ParrySubsystem->UnregisterParryWindow(GetOwner());
+        }
     }
 
     if (GetDebugDraw())
@@ -2210,13 +2404,9 @@ void UCombatComponent::OpenHoldWindow(float Duration)
     // Check if the SAME input type that queued this attack is STILL HELD
     bool bInputStillHeld = false;
 
-    if (CurrentAttackInputType == EInputType::LightAttack && bLightAttackHeld)
-    {
-        bInputStillHeld = true;
-    }
-    else if (CurrentAttackInputType == EInputType::HeavyAttack && bHeavyAttackHeld)
+    if (CurrentAttackInputType == EInputType::LightAttack || CurrentAttackInputType == EInputType::HeavyAttack)
     {
-        bInputStillHeld = true;
+        bInputStillHeld = HeldInputs.IsHeld(CurrentAttackInputType);
     }
 
     // If the correct input is still held, enter hold state
@@ -2224,7 +2414,7 @@ void UCombatComponent::OpenHoldWindow(float Duration)
     {
         // Enter hold state
         bIsHolding = true;
-        CurrentHoldTime = 0.0f;
+        HoldStartTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
 
         // CRITICAL: Clear buffered inputs to prevent them from triggering after hold release
         // This prevents the combo from cycling when holding the button continuously
@@ -2244,9 +2434,14 @@ void UCombatComponent::OpenHoldWindow(float Duration)
         }
 
         // Start smooth blend to hold (1.0 → 0.0 playback rate)
-        bIsBlendingToHold = true;
-        bIsBlendingFromHold = false;
         HoldBlendAlpha = 0.0f;
+        StartHoldBlend(true);
+
+        // Tick while holding (hold time accumulation)
+        RefreshTickEnabled();
+
+        // Stage boundaries are scheduled on the timer wheel (nothing polls between them)
+        BeginChargeStages(CurrentAttackData, GetWorld()->GetTimeSeconds());
 
         // Lock movement during hold
         if (OwnerCharacter && OwnerCharacter->GetCharacterMovement())
@@ -2286,15 +2481,9 @@ void UCombatComponent::OpenHoldWindow(float Duration)
     }
 
     // Set timer to close hold window
-    if (GetWorld())
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
     {
-        GetWorld()->GetTimerManager().SetTimer(
-            HoldWindowTimer,
-            this,
-            &UCombatComponent::CloseHoldWindow,
-            Duration,
-            false
-        );
+        TimerWheel->SetTimer<&UCombatComponent::CloseHoldWindow>(HoldWindowTimer, this, Duration);
     }
 
     if (GetDebugDraw())
@@ -2307,9 +2496,9 @@ void UCombatComponent::CloseHoldWindow()
 {
     bIsInHoldWindow = false;
 
-    if (GetWorld())
+    if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
     {
-        GetWorld()->GetTimerManager().ClearTimer(HoldWindowTimer);
+        TimerWheel->ClearTimer(HoldWindowTimer);
     }
 
     // If button is still held when window closes, mark as "held until timeout"
@@ -2318,16 +2507,9 @@ void UCombatComponent::CloseHoldWindow()
     {
         bHoldWindowExpired = true;
 
-        // Sample directional input NOW at moment of timeout
-        const FVector WorldInput = GetWorldSpaceMovementInput();
-        if (!WorldInput.IsNearlyZero())
-        {
-            QueuedDirectionalInput = GetAttackDirectionFromWorldDirection(WorldInput);
-        }
-        else
-        {
-            QueuedDirectionalInput = EAttackDirection::Forward; // Default forward
-        }
+        // Sample directional input NOW at moment of timeout (relative to facing, default forward)
+        const FCombatDirectionalInput& Input = OwnerCharacter->GetDirectionalInput();
+        QueuedDirectionalInput = Input.HasDirection() ? Input.FacingDirection : EAttackDirection::Forward;
 
         if (GetDebugDraw())
         {
@@ -2348,11 +2530,69 @@ void UCombatComponent::CloseHoldWindow()
     }
 }
 
+// ============================================================================
+// DUEL MODE
+// ============================================================================
+
+bool UCombatComponent::BeginDuel(UCombatComponent* Opponent)
+{
+    if (!Opponent || Opponent == this || CurrentState == ECombatState::Dead || Opponent->CurrentState == ECombatState::Dead)
+    {
+        return false;
+    }
+
+    EndDuel();
+    Opponent->EndDuel();
+
+    DuelOpponentCombat = Opponent;
+    DuelOpponent = Cast<ASamuraiCharacter>(Opponent->GetOwner());
+    Opponent->DuelOpponentCombat = this;
+    Opponent->DuelOpponent = Cast<ASamuraiCharacter>(GetOwner());
+
+    if (TargetingComponent)
+    {
+        TargetingComponent->SetDuelTarget(Opponent->GetOwner());
+    }
+    if (Opponent->TargetingComponent)
+    {
+        Opponent->TargetingComponent->SetDuelTarget(GetOwner());
+    }
+
+    if (GetDebugDraw())
+    {
+        UE_LOG(LogTemp, Log, TEXT("[CombatComponent] Duel started: %s vs %s"), *GetNameSafe(GetOwner()), *GetNameSafe(Opponent->GetOwner()));
+    }
+
+    return true;
+}
+
+void UCombatComponent::EndDuel()
+{
+    UCombatComponent* Opponent = DuelOpponentCombat.Get();
+
+    DuelOpponentCombat.Reset();
+    DuelOpponent.Reset();
+    if (TargetingComponent)
+    {
+        TargetingComponent->ClearDuelTarget();
+    }
+
+    if (Opponent && Opponent->DuelOpponentCombat.Get() == this)
+    {
+        Opponent->DuelOpponentCombat.Reset();
+        Opponent->DuelOpponent.Reset();
+        if (Opponent->TargetingComponent)
+        {
+            Opponent->TargetingComponent->ClearDuelTarget();
+        }
+    }
+}
+
 // ============================================================================
 // PARRY SYSTEM (Defender-Side Detection)
 // ============================================================================
 
-bool UCombatComponent::TryParry()
+bool UCombatComponent::TryParry(float InputTime)
 {
     if (!TargetingComponent || !OwnerCharacter)
     {
@@ -2363,85 +2603,140 @@ bool UCombatComponent::TryParry()
     // Using default value for V1 system backward compatibility
     const float ParryWindowDuration = 0.3f;
 
-    // Find all nearby enemies in range
-    TArray<AActor*> NearbyEnemies;
-    TargetingComponent->GetAllTargetsInRange(NearbyEnemies);
+    AActor* Enemy = nullptr;
+    ASamuraiCharacter* DuelEnemy = nullptr;
 
-    if (GetDebugDraw())
+    UParryWindowSubsystem* ParrySubsystem = GetWorld() ? GetWorld()->GetSubsystem<UParryWindowSubsystem>() : nullptr;
+    const float PressTime = InputTime >= 0.0f ? InputTime : (GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f);
+
+    // Interval test of the press against the attacker's montage windows when it has any,
+    // otherwise the notify-driven flag/registry answer
+    auto WasWindowOpenAtPress = [ParrySubsystem, PressTime](const AActor* Attacker, bool bFlaggedOpen)
     {
-        UE_LOG(LogTemp, Log, TEXT("[CombatComponent] TryParry: Found %d nearby enemies"), NearbyEnemies.Num());
-    }
+        const TOptional<bool> Interval = ParrySubsystem ? ParrySubsystem->EvaluateParryWindowAt(Attacker, PressTime) : TOptional<bool>();
+        return Interval.Get(bFlaggedOpen);
+    };
 
-    // Check each enemy to see if they're in parry window
-    for (AActor* Enemy : NearbyEnemies)
+    if (UCombatComponent* OpponentCombat = DuelOpponentCombat.Get())
     {
-        if (!Enemy || Enemy == OwnerCharacter)
+        // Duel: the only candidate is the opponent - read its window directly, no LOS query
+        const AActor* OpponentActor = OpponentCombat->GetOwner();
+        const bool bFlaggedOpen = OpponentCombat->IsInParryWindow() || (ParrySubsystem && InputTime >= 0.0f && ParrySubsystem->WasParryWindowOpenAt(OpponentActor, InputTime));
+        if (OpponentActor && WasWindowOpenAtPress(OpponentActor, bFlaggedOpen)
+            && FVector::DistSquared(OwnerCharacter->GetActorLocation(), OpponentActor->GetActorLocation()) <= FMath::Square(TargetingComponent->MaxTargetDistance))
         {
-            continue;
+            Enemy = OpponentCombat->GetOwner();
+            DuelEnemy = DuelOpponent.Get();
         }
+    }
+    else
+    {
+        // Only attackers with an open parry window are candidates (registered by AnimNotifyState_ParryWindow)
+        Enemy = ParrySubsystem ? ParrySubsystem->FindParryableAttacker(OwnerCharacter, TargetingComponent->MaxTargetDistance, InputTime) : nullptr;
 
-        // Check if enemy implements combat interface
-        ICombatInterface* EnemyCombat = Cast<ICombatInterface>(Enemy);
-        if (!EnemyCombat)
+        // Registered this frame by a notify that ticked after the press happened
+        if (Enemy && !WasWindowOpenAtPress(Enemy, true))
         {
-            continue;
+            Enemy = nullptr;
         }
 
-        // Check if enemy is in parry window (CRITICAL: Attacker-side state)
-        if (ICombatInterface::Execute_IsInParryWindow(Enemy))
+        // Locked target whose window covers the press but whose notify hasn't ticked yet
+        AActor* Target = TargetingComponent->GetCurrentTarget();
+        if (!Enemy && Target && Target != OwnerCharacter
+            && FVector::DistSquared(OwnerCharacter->GetActorLocation(), Target->GetActorLocation()) <= FMath::Square(TargetingComponent->MaxTargetDistance)
+            && WasWindowOpenAtPress(Target, false))
         {
-            // SUCCESS: Perfect parry!
-            if (GetDebugDraw())
+            Enemy = Target;
+        }
+
+        // Any other attacker locked onto us whose window covers the press (registry scan, no overlap)
+        UCombatRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<UCombatRegistrySubsystem>() : nullptr;
+        if (!Enemy && Registry)
+        {
+            TCombatScratchArray<AActor*> Attackers;
+            Registry->GetAttackersOf(OwnerCharacter, *Attackers, TargetingComponent->MaxTargetDistance);
+            for (AActor* Attacker : *Attackers)
             {
-                UE_LOG(LogTemp, Warning, TEXT("[CombatComponent] PARRY SUCCESS on %s!"), *Enemy->GetName());
+                if (Attacker != Target && WasWindowOpenAtPress(Attacker, false))
+                {
+                    Enemy = Attacker;
+                    break;
+                }
             }
+        }
+
+        if (GetDebugDraw())
+        {
+            UE_LOG(LogTemp, Log, TEXT("[CombatComponent] TryParry: %d open parry windows"), ParrySubsystem ? ParrySubsystem->GetOpenWindowCount() : 0);
+        }
+
+        // Single LOS check on the chosen attacker (previously one per nearby enemy)
+        if (Enemy && TargetingComponent->bRequireLineOfSight && !TargetingComponent->HasLineOfSightTo(Enemy))
+        {
+            Enemy = nullptr;
+        }
+    }
+
+    if (Enemy)
+    {
+        // SUCCESS: Perfect parry!
+        if (GetDebugDraw())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[CombatComponent] PARRY SUCCESS on %s!"), *Enemy->GetName());
+        }
+
+        // Transition to parrying state
+        SetCombatState(ECombatState::Parrying);
 
-            // Transition to parrying state
-            SetCombatState(ECombatState::Parrying);
+        // Fully restore parry executor's posture (reward for successful parry)
+        CommitPosture();
+        CurrentPosture = GetMaxPosture();
+        OnPostureChangedNative.Broadcast(CurrentPosture);
+        OnPostureChanged.Broadcast(CurrentPosture);
+        PublishPostureEvent();
 
-            // Fully restore parry executor's posture (reward for successful parry)
-            CurrentPosture = GetMaxPosture();
-            OnPostureChanged.Broadcast(CurrentPosture);
+        const float ParryPostureDamage = CombatSettings ? CombatSettings->ParryPostureDamage : 40.0f;
+        const float CounterDuration = CombatSettings ? CombatSettings->CounterWindowDuration : 1.5f;
 
+        if (DuelEnemy)
+        {
+            // Duel: direct calls on the cached opponent (no interface dispatch)
+            DuelEnemy->ApplyPostureDamage_Implementation(ParryPostureDamage, OwnerCharacter);
+            DuelEnemy->OpenCounterWindow_Implementation(CounterDuration);
+            DuelEnemy->OnAttackParried_Implementation(OwnerCharacter);
+        }
+        else if (IDamageableInterface* EnemyDamageable = Cast<IDamageableInterface>(Enemy))
+        {
             // Apply posture damage to attacker (punish failed attack)
-            const float ParryPostureDamage = CombatSettings ? CombatSettings->ParryPostureDamage : 40.0f;
-            if (IDamageableInterface* EnemyDamageable = Cast<IDamageableInterface>(Enemy))
-            {
-                IDamageableInterface::Execute_ApplyPostureDamage(Enemy, ParryPostureDamage, OwnerCharacter);
-            }
+            IDamageableInterface::Execute_ApplyPostureDamage(Enemy, ParryPostureDamage, OwnerCharacter);
 
             // Open counter window on attacker (they're vulnerable now)
-            const float CounterDuration = CombatSettings ? CombatSettings->CounterWindowDuration : 1.5f;
-            if (IDamageableInterface* EnemyDamageable = Cast<IDamageableInterface>(Enemy))
-            {
-                IDamageableInterface::Execute_OpenCounterWindow(Enemy, CounterDuration);
-            }
+            IDamageableInterface::Execute_OpenCounterWindow(Enemy, CounterDuration);
 
             // Notify attacker they were parried (for animation/feedback)
-            if (IDamageableInterface* EnemyDamageable = Cast<IDamageableInterface>(Enemy))
-            {
-                IDamageableInterface::Execute_OnAttackParried(Enemy, OwnerCharacter);
-            }
+            IDamageableInterface::Execute_OnAttackParried(Enemy, OwnerCharacter);
+        }
 
-            // Broadcast parry success event
-            OnPerfectParry.Broadcast(Enemy);
+        // Hit-stop on both sides of the parry
+        const float ParryHitStop = CombatSettings ? CombatSettings->ParryHitStopDuration : 0.0f;
+        if (UHitStopSubsystem* HitStop = ParryHitStop > 0.0f && GetWorld() ? GetWorld()->GetSubsystem<UHitStopSubsystem>() : nullptr)
+        {
+            HitStop->RequestHitStop(OwnerCharacter, ParryHitStop, CombatSettings->HitStopTimeDilation);
+            HitStop->RequestHitStop(Enemy, ParryHitStop, CombatSettings->HitStopTimeDilation);
+        }
 
-            // Return to idle after brief parry animation
-            if (GetWorld())
-            {
-                FTimerHandle ParryRecoveryTimer;
-                TWeakObjectPtr<UCombatComponent> WeakThis(this);
-                GetWorld()->GetTimerManager().SetTimer(ParryRecoveryTimer, [WeakThis]()
-                {
-                    if (WeakThis.IsValid() && WeakThis->CurrentState == ECombatState::Parrying)
-                    {
-                        WeakThis->SetCombatState(ECombatState::Idle);
-                    }
-                }, 0.3f, false); // Brief parry recovery window
-            }
+        // Broadcast parry success event
+        OnPerfectParryNative.Broadcast(Enemy);
+        OnPerfectParry.Broadcast(Enemy);
+        UCombatEventDispatcherSubsystem::PublishFrom(this, ECombatEventKind::PerfectParry, GetOwner(), Enemy);
 
-            return true;
+        // Return to idle after brief parry animation
+        if (UCombatTimerWheelSubsystem* TimerWheel = GetTimerWheel())
+        {
+            TimerWheel->SetTimer<&UCombatComponent::EndParryRecovery>(ParryRecoveryTimer, this, 0.3f); // Brief parry recovery window
         }
+
+        return true;
     }
 
     // FAIL: No enemy in parry window - this is just a normal block
@@ -2,26 +2,78 @@
 
 #include "Core/CombatComponentV2.h"
 #include "Core/CombatComponent.h"
+#include "Core/CombatStateTransitions.h"
 #include "Data/AttackData.h"
+#include "Data/AttackConfiguration.h"
 #include "Data/CombatSettings.h"
 #include "Animation/AnimInstance.h"
 #include "Animation/AnimMontage.h"
-#include "DrawDebugHelpers.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Characters/SamuraiCharacter.h"
 #include "Utilities/MontageUtilityLibrary.h"
+#include "Core/MontageCheckpointCache.h"
+#include "Core/PlayRateEasingSubsystem.h"
+#include "Core/ComboPreloadSubsystem.h"
+#include "Core/CombatInputTimingSubsystem.h"
+#include "Core/AIDefenseSubsystem.h"
+#include "Core/CombatEventDispatcherSubsystem.h"
+#include "Core/CombatTimerWheelSubsystem.h"
+#include "GameFramework/PlayerState.h"
+#include "Debug/CombatFieldTelemetry.h"
+#include "Misc/ScopeExit.h"
+#include "Algo/StableSort.h"
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Immediate Input->Execute p50 (ms)"), STAT_CombatLatency_ImmediateExecuteP50, STATGROUP_CombatLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Immediate Input->Execute p95 (ms)"), STAT_CombatLatency_ImmediateExecuteP95, STATGROUP_CombatLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Immediate Input->Execute p99 (ms)"), STAT_CombatLatency_ImmediateExecuteP99, STATGROUP_CombatLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Immediate Input->First Frame p50 (ms)"), STAT_CombatLatency_ImmediateFrameP50, STATGROUP_CombatLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Immediate Input->First Frame p95 (ms)"), STAT_CombatLatency_ImmediateFrameP95, STATGROUP_CombatLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Immediate Input->First Frame p99 (ms)"), STAT_CombatLatency_ImmediateFrameP99, STATGROUP_CombatLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Queued Input->Execute p50 (ms)"), STAT_CombatLatency_QueuedExecuteP50, STATGROUP_CombatLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Queued Input->Execute p95 (ms)"), STAT_CombatLatency_QueuedExecuteP95, STATGROUP_CombatLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Queued Input->Execute p99 (ms)"), STAT_CombatLatency_QueuedExecuteP99, STATGROUP_CombatLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Queued Input->First Frame p50 (ms)"), STAT_CombatLatency_QueuedFrameP50, STATGROUP_CombatLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Queued Input->First Frame p95 (ms)"), STAT_CombatLatency_QueuedFrameP95, STATGROUP_CombatLatency);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Queued Input->First Frame p99 (ms)"), STAT_CombatLatency_QueuedFrameP99, STATGROUP_CombatLatency);
+
+namespace
+{
+	/** Process-wide latency (all V2 components) backing STATGROUP_CombatLatency */
+	FActionLatencyStats GImmediateLatency;
+	FActionLatencyStats GQueuedLatency;
 
-// ============================================================================
-// LOG CATEGORY DEFINITION
-// ============================================================================
+	void PublishLatencyStats()
+	{
+		SET_FLOAT_STAT(STAT_CombatLatency_ImmediateExecuteP50, GImmediateLatency.InputToExecute.P50Ms);
+		SET_FLOAT_STAT(STAT_CombatLatency_ImmediateExecuteP95, GImmediateLatency.InputToExecute.P95Ms);
+		SET_FLOAT_STAT(STAT_CombatLatency_ImmediateExecuteP99, GImmediateLatency.InputToExecute.P99Ms);
+		SET_FLOAT_STAT(STAT_CombatLatency_ImmediateFrameP50, GImmediateLatency.InputToFirstFrame.P50Ms);
+		SET_FLOAT_STAT(STAT_CombatLatency_ImmediateFrameP95, GImmediateLatency.InputToFirstFrame.P95Ms);
+		SET_FLOAT_STAT(STAT_CombatLatency_ImmediateFrameP99, GImmediateLatency.InputToFirstFrame.P99Ms);
+		SET_FLOAT_STAT(STAT_CombatLatency_QueuedExecuteP50, GQueuedLatency.InputToExecute.P50Ms);
+		SET_FLOAT_STAT(STAT_CombatLatency_QueuedExecuteP95, GQueuedLatency.InputToExecute.P95Ms);
+		SET_FLOAT_STAT(STAT_CombatLatency_QueuedExecuteP99, GQueuedLatency.InputToExecute.P99Ms);
+		SET_FLOAT_STAT(STAT_CombatLatency_QueuedFrameP50, GQueuedLatency.InputToFirstFrame.P50Ms);
+		SET_FLOAT_STAT(STAT_CombatLatency_QueuedFrameP95, GQueuedLatency.InputToFirstFrame.P95Ms);
+		SET_FLOAT_STAT(STAT_CombatLatency_QueuedFrameP99, GQueuedLatency.InputToFirstFrame.P99Ms);
+	}
 
-DEFINE_LOG_CATEGORY(LogCombat);
+	FActionLatencyStats& GetGlobalLatency(EActionExecutionMode Mode)
+	{
+		return Mode == EActionExecutionMode::Immediate ? GImmediateLatency : GQueuedLatency;
+	}
+}
 
 UCombatComponentV2::UCombatComponentV2()
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = true;
+
+	// Replicated for the networked input RPCs only - no replicated properties
+	SetIsReplicatedByDefault(true);
+
+	RebuildCheckpointIndex();
 }
 
 void UCombatComponentV2::BeginPlay()
@@ -41,19 +93,70 @@ void UCombatComponentV2::BeginPlay()
 		{
 			UE_LOG(LogCombat, Error, TEXT("[CombatComponentV2] No CombatComponent found on %s"), *OwnerCharacter->GetName());
 		}
-
-		// Bind to montage event delegates for event-driven phase transitions
-		if (UAnimInstance* AnimInstance = OwnerCharacter->GetMesh()->GetAnimInstance())
+		else
 		{
-			AnimInstance->OnMontageBlendingOut.AddDynamic(this, &UCombatComponentV2::OnMontageBlendingOut);
-			AnimInstance->OnMontageEnded.AddDynamic(this, &UCombatComponentV2::OnMontageEnded);
+			RebuildComboGraph();
 
-			if (GetDebugDraw())
+			if (bPrewarmAnimation)
+			{
+				PrewarmAnimation();
+			}
+
+			if (UComboPreloadSubsystem* Preloader = GetWorld() ? GetWorld()->GetSubsystem<UComboPreloadSubsystem>() : nullptr)
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 INIT] Montage event delegates bound (BlendingOut, Ended)"));
+				ComboPreloadHandle = Preloader->OnChainPreloaded.AddUObject(this, &UCombatComponentV2::OnComboChainPreloaded);
+
+				// Moveset-wide bundles for this context, shared by everyone using the configuration
+				if (CombatSettings && CombatSettings->AttackConfiguration && CombatSettings->MovesetBundles.Num() > 0)
+				{
+					Preloader->PreloadMoveset(CombatSettings->AttackConfiguration, CombatSettings->MovesetBundles);
+				}
 			}
+			PreloadComboWindow();
+
+			ChargeStageHandle = CombatComponent->OnChargeStageChangedNative.AddUObject(this, &UCombatComponentV2::OnChargeStageChanged);
+		}
+
+		// Native montage event delegates for event-driven phase transitions
+		// Bound once here, attached to each attack montage instance as it plays (no reflection dispatch)
+		MontageBlendingOutDelegate.BindUObject(this, &UCombatComponentV2::OnMontageBlendingOut);
+		MontageEndedDelegate.BindUObject(this, &UCombatComponentV2::OnMontageEnded);
+
+		if (GetDebugDraw())
+		{
+			COMBAT_LOG(Log, TEXT("[V2 INIT] Montage event delegates bound (BlendingOut, Ended)"));
 		}
 	}
+
+	RefreshTickEnabled();
+}
+
+void UCombatComponentV2::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UComboPreloadSubsystem* Preloader = GetWorld() ? GetWorld()->GetSubsystem<UComboPreloadSubsystem>() : nullptr)
+	{
+		Preloader->OnChainPreloaded.Remove(ComboPreloadHandle);
+		Preloader->ReleaseChain(this);
+	}
+	ComboPreloadHandle.Reset();
+
+	if (CombatComponent)
+	{
+		CombatComponent->OnChargeStageChangedNative.Remove(ChargeStageHandle);
+	}
+	ChargeStageHandle.Reset();
+
+	StopAttackTiming();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UCombatComponentV2::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Checkpoints.GetAllocatedSize()
+		+ VisitedAttacks.GetAllocatedSize() + PendingPredictions.GetAllocatedSize());
 }
 
 void UCombatComponentV2::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -63,18 +166,207 @@ void UCombatComponentV2::TickComponent(float DeltaTime, ELevelTick TickType, FAc
 	// PHASE 9 COMPLETE: V2 is now fully event-driven!
 	// - Input processing: OnInputEvent (immediate)
 	// - Queue execution: ProcessQueuedActions (called on phase transitions)
-	// - Hold easing: OnEaseTimerTick (timer-based, 60Hz)
+	// - Hold easing: UPlayRateEasingSubsystem (shared scheduler, real delta time)
 	// - Phase tracking: OnPhaseTransition (AnimNotify events)
 	//
 	// Only debug visualization remains in tick (harmless, can be disabled)
 
 	// NOTE: Movement sync is EVENT-DRIVEN (called from phase transitions, playrate changes)
-	// NO per-frame logic here except debug visualization
+	// NO per-frame logic here except debug visualization and the pending latency sample
+
+	if (PendingFirstFrame.bPending)
+	{
+		UpdateFirstFrameLatency();
+	}
+
+	if (PendingPredictions.Num() > 0)
+	{
+		UpdatePredictionTimeouts();
+	}
 
 	if (GetDebugDraw())
 	{
 		DrawDebugInfo();
 	}
+
+	RefreshTickEnabled();
+}
+
+void UCombatComponentV2::RefreshTickEnabled()
+{
+	SetComponentTickEnabled(PendingFirstFrame.bPending || PendingPredictions.Num() > 0 || GetDebugDraw());
+}
+
+void UCombatComponentV2::RebuildComboGraph()
+{
+	if (!CombatComponent)
+	{
+		ComboGraph.Reset();
+		return;
+	}
+
+	ComboGraph.Build(CombatComponent->GetDefaultLightAttack(), CombatComponent->GetDefaultHeavyAttack());
+
+	if (ComboGraph.HasCycles())
+	{
+		UE_LOG(LogCombat, Error, TEXT("[CombatComponentV2] Combo graph for %s contains circular combo references (see log above)"),
+			*GetNameSafe(GetOwner()));
+	}
+}
+
+bool UCombatComponentV2::SelectAIMove(float TargetDistance, const FComboMoveUtilityWeights& Weights, FComboMoveChoice& OutChoice) const
+{
+	OutChoice = FComboMoveChoice();
+
+	if (!CombatComponent)
+	{
+		return false;
+	}
+
+	if (!ComboGraph.IsBuiltFor(CombatComponent->GetDefaultLightAttack(), CombatComponent->GetDefaultHeavyAttack()))
+	{
+		const_cast<UCombatComponentV2*>(this)->RebuildComboGraph();
+	}
+
+	// mid-attack presses chain, the same as ResolveAttackForInput
+	const bool bComboWindowActive = HotState.bComboWindowActive || (CurrentAttackData && HotState.CurrentPhase != EAttackPhase::None);
+	const int32 Node = ComboGraph.FindNode(HotState.CurrentPhase != EAttackPhase::None ? CurrentAttackData.Get() : nullptr);
+	if (Node == INDEX_NONE)
+	{
+		return false;
+	}
+
+	return ComboGraph.SelectMove(Node, bComboWindowActive, TargetDistance, Weights, OutChoice);
+}
+
+int32 UCombatComponentV2::PrewarmAnimation()
+{
+	if (!OwnerCharacter || HotState.CurrentPhase != EAttackPhase::None)
+	{
+		return 0;
+	}
+
+	if (!ComboGraph.IsBuiltFor(CombatComponent ? CombatComponent->GetDefaultLightAttack() : nullptr, CombatComponent ? CombatComponent->GetDefaultHeavyAttack() : nullptr))
+	{
+		RebuildComboGraph();
+	}
+
+	TArray<UAnimMontage*> Montages;
+	ComboGraph.GetMontages(Montages);
+
+	const int32 NumTouched = UMontageUtilityLibrary::PrewarmAnimation(OwnerCharacter->GetMesh(), Montages);
+
+	if (GetDebugDraw())
+	{
+		COMBAT_LOG(Log, TEXT("[V2 INIT] Prewarmed %d combo montages on %s"), NumTouched, *OwnerCharacter->GetName());
+	}
+
+	return NumTouched;
+}
+
+void UCombatComponentV2::AddActiveContextTag(FGameplayTag Tag)
+{
+	ActiveContextTags.AddTag(Tag);
+	ActiveContextMaskGeneration = 0;
+}
+
+void UCombatComponentV2::RemoveActiveContextTag(FGameplayTag Tag)
+{
+	ActiveContextTags.RemoveTag(Tag);
+	ActiveContextMaskGeneration = 0;
+}
+
+void UCombatComponentV2::SetActiveContextTags(const FGameplayTagContainer& Tags)
+{
+	ActiveContextTags = Tags;
+	ActiveContextMaskGeneration = 0;
+}
+
+const FCombatContextMask& UCombatComponentV2::GetActiveContextMask() const
+{
+	const FCombatContextTagTable& Table = FCombatContextTagTable::Get();
+	if (ActiveContextMaskGeneration != Table.GetGeneration())
+	{
+		ActiveContextMask = Table.MakeActiveMask(ActiveContextTags);
+		ActiveContextMaskGeneration = Table.GetGeneration();
+	}
+	return ActiveContextMask;
+}
+
+void UCombatComponentV2::PreloadComboWindow()
+{
+	UComboPreloadSubsystem* Preloader = GetWorld() ? GetWorld()->GetSubsystem<UComboPreloadSubsystem>() : nullptr;
+	if (!Preloader || !CombatComponent || !CombatSettings)
+	{
+		return;
+	}
+
+	// Window = starting attacks + the chain ahead of the current attack
+	const UAttackData* Roots[] = { CombatComponent->GetDefaultLightAttack(), CombatComponent->GetDefaultHeavyAttack(), CurrentAttackData.Get() };
+	Preloader->PreloadChain(this, Roots, CombatSettings->ComboPreloadDepth);
+}
+
+void UCombatComponentV2::OnComboChainPreloaded(const UObject* Requester)
+{
+	// Our own window, or moveset bundles of our configuration
+	if (Requester == this || (CombatSettings && Requester == CombatSettings->AttackConfiguration))
+	{
+		// Rebuilt lazily on the next resolution (IsBuiltFor fails after Reset)
+		ComboGraph.Reset();
+	}
+}
+
+void UCombatComponentV2::RecordExecuteLatency(FActionQueueEntry& Action)
+{
+	Action.ExecutedTime = FPlatformTime::Seconds();
+	if (Action.InputReceivedTime <= 0.0)
+	{
+		return;
+	}
+
+	const double Latency = Action.ExecutedTime - Action.InputReceivedTime;
+	QueueStats.GetLatency(Action.ExecutionMode).RecordExecute(Latency);
+	GetGlobalLatency(Action.ExecutionMode).RecordExecute(Latency);
+	PublishLatencyStats();
+	FCombatFieldTelemetry::Get().RecordInputLatency(Action.ExecutionMode, Latency, false);
+
+	// Montage was just started by PlayAttackMontage - wait for it to advance
+	UAnimInstance* AnimInstance = OwnerCharacter && OwnerCharacter->GetMesh() ? OwnerCharacter->GetMesh()->GetAnimInstance() : nullptr;
+	UAnimMontage* Montage = Action.AttackData ? Action.AttackData->AttackMontage.Get() : nullptr;
+	if (AnimInstance && Montage)
+	{
+		PendingFirstFrame.Montage = Montage;
+		PendingFirstFrame.StartPosition = AnimInstance->Montage_GetPosition(Montage);
+		PendingFirstFrame.InputReceivedTime = Action.InputReceivedTime;
+		PendingFirstFrame.Mode = Action.ExecutionMode;
+		PendingFirstFrame.bPending = true;
+		RefreshTickEnabled();
+	}
+}
+
+void UCombatComponentV2::UpdateFirstFrameLatency()
+{
+	UAnimInstance* AnimInstance = OwnerCharacter && OwnerCharacter->GetMesh() ? OwnerCharacter->GetMesh()->GetAnimInstance() : nullptr;
+	UAnimMontage* Montage = PendingFirstFrame.Montage.Get();
+	if (!AnimInstance || !Montage || !AnimInstance->Montage_IsPlaying(Montage))
+	{
+		// Interrupted before it ever animated - no sample
+		PendingFirstFrame.bPending = false;
+		return;
+	}
+
+	// Sampled at component tick, so resolution is one frame
+	if (AnimInstance->Montage_GetPosition(Montage) == PendingFirstFrame.StartPosition)
+	{
+		return;
+	}
+
+	const double Latency = FPlatformTime::Seconds() - PendingFirstFrame.InputReceivedTime;
+	QueueStats.GetLatency(PendingFirstFrame.Mode).RecordFirstFrame(Latency);
+	GetGlobalLatency(PendingFirstFrame.Mode).RecordFirstFrame(Latency);
+	PublishLatencyStats();
+	FCombatFieldTelemetry::Get().RecordInputLatency(PendingFirstFrame.Mode, Latency, true);
+	PendingFirstFrame.bPending = false;
 }
 
 ASamuraiCharacter* UCombatComponentV2::GetOwnerCharacter() const
@@ -93,8 +385,117 @@ bool UCombatComponentV2::GetDebugDraw() const
 // INPUT PROCESSING (V2)
 // ============================================================================
 
-void UCombatComponentV2::OnInputEvent(EInputType InputType, EInputEventType EventType, EInputDirection InputDirection)
+void UCombatComponentV2::OnInputEvent(EInputType InputType, EInputEventType EventType, EInputDirection InputDirection, double InputPlatformTime)
+{
+	// Sub-frame: when the key event was seen, mapped onto world time (clamped to this frame)
+	const UCombatInputTimingSubsystem* InputTiming = GetWorld()->GetSubsystem<UCombatInputTimingSubsystem>();
+	const float CurrentTime = InputTiming && InputPlatformTime > 0.0
+		? InputTiming->PlatformTimeToWorldTime(InputPlatformTime)
+		: GetWorld()->GetTimeSeconds();
+
+	DispatchInputEvent(InputType, EventType, InputDirection, CurrentTime, InputPlatformTime, IsNetworkedMode());
+}
+
+void UCombatComponentV2::SortInputBatch(TArrayView<FCombatInputCommand> Commands)
+{
+	Algo::StableSort(Commands, [](const FCombatInputCommand& A, const FCombatInputCommand& B)
+	{
+		const UCombatComponentV2* ComponentA = A.Component.Get();
+		const UCombatComponentV2* ComponentB = B.Component.Get();
+		return ComponentA != ComponentB ? ComponentA < ComponentB : A.PlatformTime < B.PlatformTime;
+	});
+}
+
+int32 UCombatComponentV2::SubmitInputBatch(TArrayView<FCombatInputCommand> Commands)
 {
+	COMBAT_TRACE_SCOPE(UCombatComponentV2::SubmitInputBatch);
+
+	SortInputBatch(Commands);
+
+	// Shared lookups, refreshed only when a run is in a different world
+	const UWorld* World = nullptr;
+	const UCombatInputTimingSubsystem* InputTiming = nullptr;
+	float WorldTime = 0.0f;
+
+	int32 NumDispatched = 0;
+	for (int32 RunStart = 0; RunStart < Commands.Num();)
+	{
+		UCombatComponentV2* Component = Commands[RunStart].Component.Get();
+		int32 RunEnd = RunStart + 1;
+		while (RunEnd < Commands.Num() && Commands[RunEnd].Component.Get() == Component)
+		{
+			++RunEnd;
+		}
+
+		// Gate the whole run once (ProcessInputEvent still gates each input on combat state)
+		const bool bAccepting = Component && Component->GetWorld() && Component->CombatSettings && Component->CombatSettings->bUseV2System && Component->CombatComponent;
+		if (bAccepting)
+		{
+			if (Component->GetWorld() != World)
+			{
+				World = Component->GetWorld();
+				InputTiming = World->GetSubsystem<UCombatInputTimingSubsystem>();
+				WorldTime = World->GetTimeSeconds();
+			}
+
+			const bool bNetworked = Component->IsNetworkedMode();
+			for (int32 Index = RunStart; Index < RunEnd; ++Index)
+			{
+				const FCombatInputCommand& Command = Commands[Index];
+				const float InputTime = InputTiming && Command.PlatformTime > 0.0
+					? InputTiming->PlatformTimeToWorldTime(Command.PlatformTime)
+					: WorldTime;
+
+				Component->DispatchInputEvent(Command.InputType, Command.EventType, Command.Direction, InputTime, Command.PlatformTime, bNetworked);
+				++NumDispatched;
+			}
+		}
+
+		RunStart = RunEnd;
+	}
+
+	return NumDispatched;
+}
+
+void UCombatComponentV2::DispatchInputEvent(EInputType InputType, EInputEventType EventType, EInputDirection InputDirection, float InputTime, double InputPlatformTime, bool bNetworked)
+{
+	if (!bNetworked)
+	{
+		ProcessInputEvent(InputType, EventType, InputDirection, InputTime, InputPlatformTime);
+		return;
+	}
+
+	switch (GetOwnerRole())
+	{
+		case ROLE_AutonomousProxy:
+		{
+			// Predict locally, let the server confirm
+			const FCombatInputPacket Packet = MakeInputPacket(InputType, EventType, InputDirection, InputTime);
+			ServerSubmitInput(Packet);
+
+			TGuardValue<uint16> SequenceScope(ProcessingNetSequence, Packet.Sequence);
+			ProcessInputEvent(InputType, EventType, InputDirection, InputTime, InputPlatformTime);
+			break;
+		}
+
+		case ROLE_Authority:
+			// Listen-server host or server-side AI: authoritative already, just tell the proxies
+			ProcessInputEvent(InputType, EventType, InputDirection, InputTime, InputPlatformTime);
+			MulticastRelayInput(MakeInputPacket(InputType, EventType, InputDirection, InputTime));
+			break;
+
+		default:
+			// Simulated proxies only replay relayed packets
+			break;
+	}
+}
+
+void UCombatComponentV2::ProcessInputEvent(EInputType InputType, EInputEventType EventType, EInputDirection InputDirection, float InputTime, double InputRealTime)
+{
+	COMBAT_LLM_SCOPE(ActionQueue);
+	COMBAT_TRACE_SCOPE(UCombatComponentV2::OnInputEvent);
+	CombatTrace::OutputInputEvent(GetOwner(), InputType, EventType, HotState.CurrentPhase, InputDirection);
+
 	// Early exit if V2 system is not enabled or dependencies missing
 	if (!CombatSettings || !CombatSettings->bUseV2System || !CombatComponent)
 	{
@@ -106,7 +507,7 @@ void UCombatComponentV2::OnInputEvent(EInputType InputType, EInputEventType Even
 	{
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Warning, TEXT("[V2 INPUT] Input REJECTED - Cannot process in current combat state"));
+			COMBAT_LOG(Warning, TEXT("[V2 INPUT] Input REJECTED - Cannot process in current combat state"));
 		}
 		return;
 	}
@@ -115,7 +516,7 @@ void UCombatComponentV2::OnInputEvent(EInputType InputType, EInputEventType Even
 	// This updates on EVERY input event, so the most recent direction is always stored
 	if (InputDirection != EInputDirection::None)
 	{
-		LastDirectionalInput = InputDirection;
+		HotState.LastDirectionalInput = InputDirection;
 
 		// If we're holding, update the hold's direction (for directional follow-ups)
 		if (HoldState.IsHolding())
@@ -125,7 +526,7 @@ void UCombatComponentV2::OnInputEvent(EInputType InputType, EInputEventType Even
 
 			if (GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 INPUT DIRECTION] Updated hold direction: %s (8-way: %s)"),
+				COMBAT_LOG(Log, TEXT("[V2 INPUT DIRECTION] Updated hold direction: %s (8-way: %s)"),
 					*UEnum::GetValueAsString(AttackDir),
 					*UEnum::GetValueAsString(InputDirection));
 			}
@@ -134,21 +535,34 @@ void UCombatComponentV2::OnInputEvent(EInputType InputType, EInputEventType Even
 		// ALWAYS log directional input capture for debugging
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Warning, TEXT("[V2 INPUT DIRECTION] Captured: %s (will be used for next attack resolution)"),
+			COMBAT_LOG(Warning, TEXT("[V2 INPUT DIRECTION] Captured: %s (will be used for next attack resolution)"),
 				*UEnum::GetValueAsString(InputDirection));
 		}
 	}
 	else if (GetDebugDraw())
 	{
 		// Log when NO directional input provided (this means Blueprint isn't passing it)
-		UE_LOG(LogCombat, Warning, TEXT("[V2 INPUT DIRECTION] NO DIRECTION PROVIDED - Blueprint must pass movement stick direction to OnInputEvent()"));
+		COMBAT_LOG(Warning, TEXT("[V2 INPUT DIRECTION] NO DIRECTION PROVIDED - Blueprint must pass movement stick direction to OnInputEvent()"));
 	}
 
-	// Get current game time
-	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	// Mashing: a press already covered by a queued/rejected press of the same type this phase does nothing more
+	if (EventType == EInputEventType::Press && TryCoalesceInput(InputType))
+	{
+		QueueStats.TotalInputs++;
+		return;
+	}
+
+	// Input time (local time, or the sender's time mapped onto ours for networked inputs)
+	const float CurrentTime = InputTime;
 
 	// Create input action
-	FQueuedInputAction InputAction(InputType, EventType, CurrentTime, bComboWindowActive);
+	FQueuedInputAction InputAction(InputType, EventType, CurrentTime, HotState.bComboWindowActive);
+	InputAction.NetSequence = ProcessingNetSequence;
+	InputAction.Direction = InputDirection;
+	if (InputRealTime > 0.0)
+	{
+		InputAction.ReceivedRealTime = InputRealTime;
+	}
 
 	// Track press/release pairs
 	if (EventType == EInputEventType::Press)
@@ -156,33 +570,36 @@ void UCombatComponentV2::OnInputEvent(EInputType InputType, EInputEventType Even
 		// Check if we can accept new input (not in commit window, not duplicate)
 		if (!CanAcceptNewInput(InputType))
 		{
+			MarkInputCoalesced(InputType);
 			return; // Input rejected
 		}
 
-		HeldInputs.Add(InputType, CurrentTime);
+		HeldInputs.Press(InputType, CurrentTime);
+		++DebugStateVersion;
 
 		if ( GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 INPUT] %s PRESSED at %.2f (Combo: %s, Direction: %s)"),
+			COMBAT_LOG(Log, TEXT("[V2 INPUT] %s PRESSED at %.2f (Combo: %s, Direction: %s)"),
 				*UEnum::GetValueAsString(InputType),
 				CurrentTime,
-				bComboWindowActive ? TEXT("YES") : TEXT("NO"),
+				HotState.bComboWindowActive ? TEXT("YES") : TEXT("NO"),
 				InputDirection != EInputDirection::None ? *UEnum::GetValueAsString(InputDirection) : TEXT("None"));
 		}
 	}
 	else // Release
 	{
-		if (float* PressTime = HeldInputs.Find(InputType))
+		float PressTime = 0.0f;
+		if (HeldInputs.Release(InputType, CurrentTime, &PressTime))
 		{
 			// Found matching press - process as pair
-			FQueuedInputAction PressEvent(InputType, EInputEventType::Press, *PressTime, bComboWindowActive);
+			FQueuedInputAction PressEvent(InputType, EInputEventType::Press, PressTime, HotState.bComboWindowActive);
 			ProcessInputPair(PressEvent, InputAction);
-			HeldInputs.Remove(InputType);
+			++DebugStateVersion;
 		}
 
 		if ( GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 INPUT] %s RELEASED at %.2f"),
+			COMBAT_LOG(Log, TEXT("[V2 INPUT] %s RELEASED at %.2f"),
 				*UEnum::GetValueAsString(InputType),
 				CurrentTime);
 		}
@@ -201,39 +618,227 @@ void UCombatComponentV2::OnInputEvent(EInputType InputType, EInputEventType Even
 	QueueStats.TotalInputs++;
 }
 
-bool UCombatComponentV2::CanProcessInput(EInputType InputType) const
+// ============================================================================
+// NETWORKING
+// ============================================================================
+
+namespace
 {
-	if (!CombatComponent)
+	/** Wrap-aware sequence comparison: is A after B? */
+	bool IsSequenceNewer(uint16 A, uint16 B)
 	{
-		return false;
+		return static_cast<int16>(A - B) > 0;
 	}
+}
 
-	// V2 accepts input in more states than V1
-	ECombatState CurrentState = CombatComponent->GetCombatState();
+bool UCombatComponentV2::IsNetworkedMode() const
+{
+	return bEnableNetworkPrediction && GetNetMode() != NM_Standalone && GetOwner() && GetOwner()->GetIsReplicated();
+}
 
-	switch (CurrentState)
+FCombatInputPacket UCombatComponentV2::MakeInputPacket(EInputType InputType, EInputEventType EventType, EInputDirection InputDirection, float InputTime)
+{
+	// 0 means "not networked" on queued actions, so skip it on wrap
+	if (++LastInputSequence == 0)
 	{
-		case ECombatState::Idle:
-		case ECombatState::Attacking:
-		case ECombatState::Blocking:
-			return true;
+		++LastInputSequence;
+	}
 
-		case ECombatState::Dead:
-		case ECombatState::HitStunned:
-		case ECombatState::GuardBroken:
-			return false;
+	FCombatInputPacket Packet;
+	Packet.InputType = InputType;
+	Packet.EventType = EventType;
+	Packet.Direction = InputDirection;
+	Packet.Sequence = LastInputSequence;
+	Packet.TimestampMs = static_cast<uint32>(InputTime * 1000.0);
+	return Packet;
+}
 
-		default:
-			return true;
+void UCombatComponentV2::ServerSubmitInput_Implementation(const FCombatInputPacket& Packet)
+{
+	// Reliable RPCs arrive in order; this only guards against replays
+	if (LastServerSequence != 0 && !IsSequenceNewer(Packet.Sequence, LastServerSequence))
+	{
+		return;
+	}
+	LastServerSequence = Packet.Sequence;
+
+	// Map the client's clock onto ours using the least-delayed packet seen so far, so press/release
+	// spacing (hold detection) follows the client's timing rather than network jitter.
+	// The small creep lets the offset recover from a single unusually fast packet.
+	const float ServerTime = GetWorld()->GetTimeSeconds();
+	const float Offset = ServerTime - Packet.GetTimestampSeconds();
+	ClientTimeOffset = bHasClientTimeOffset ? FMath::Min(Offset, ClientTimeOffset + 0.001f) : Offset;
+	bHasClientTimeOffset = true;
+
+	const float InputTime = FMath::Min(Packet.GetTimestampSeconds() + ClientTimeOffset, ServerTime);
+
+	{
+		TGuardValue<uint16> SequenceScope(ProcessingNetSequence, Packet.Sequence);
+		ProcessInputEvent(Packet.InputType, Packet.EventType, Packet.Direction, InputTime);
+	}
+
+	MulticastRelayInput(Packet);
+}
+
+void UCombatComponentV2::MulticastRelayInput_Implementation(const FCombatInputPacket& Packet)
+{
+	// The server and the owner already processed this input
+	if (GetOwnerRole() == ROLE_SimulatedProxy)
+	{
+		ProcessInputEvent(Packet.InputType, Packet.EventType, Packet.Direction, GetWorld()->GetTimeSeconds());
+	}
+}
+
+void UCombatComponentV2::OnNetworkedActionExecuted(const FActionQueueEntry& Action)
+{
+	const uint16 Sequence = static_cast<uint16>(Action.InputAction.NetSequence);
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		// Tell the predicting client what really ran, and where its montage started
+		float MontagePosition = 0.0f;
+		if (UAnimInstance* AnimInstance = OwnerCharacter && OwnerCharacter->GetMesh() ? OwnerCharacter->GetMesh()->GetAnimInstance() : nullptr)
+		{
+			MontagePosition = AnimInstance->Montage_GetPosition(Action.AttackData->AttackMontage);
+		}
+
+		ClientConfirmExecution(Sequence, Action.AttackData, MontagePosition);
+	}
+	else if (GetOwnerRole() == ROLE_AutonomousProxy)
+	{
+		FPredictedExecution& Prediction = PendingPredictions.AddDefaulted_GetRef();
+		Prediction.Sequence = Sequence;
+		Prediction.Attack = Action.AttackData;
+		Prediction.ExecutedTime = GetWorld()->GetTimeSeconds();
+		RefreshTickEnabled();
+	}
+}
+
+void UCombatComponentV2::ClientConfirmExecution_Implementation(uint16 Sequence, UAttackData* Attack, float MontagePosition)
+{
+	bool bPredicted = false;
+
+	// Everything up to the confirmed input is settled; older unconfirmed predictions were superseded
+	for (int32 i = PendingPredictions.Num() - 1; i >= 0; --i)
+	{
+		const FPredictedExecution& Prediction = PendingPredictions[i];
+		if (Prediction.Sequence == Sequence && Prediction.Attack.Get() == Attack)
+		{
+			bPredicted = true;
+		}
+
+		if (!IsSequenceNewer(Prediction.Sequence, Sequence))
+		{
+			PendingPredictions.RemoveAt(i);
+		}
+	}
+
+	if (!bPredicted)
+	{
+		ReconcileToServer(Attack, MontagePosition);
+	}
+}
+
+void UCombatComponentV2::ReconcileToServer(UAttackData* Attack, float MontagePosition)
+{
+	if (!Attack || !Attack->AttackMontage)
+	{
+		return;
+	}
+
+	QueueStats.NetMispredictions++;
+	COMBAT_LOG(Log, TEXT("[V2 NET] Misprediction on %s - correcting to %s"), *GetNameSafe(GetOwner()), *Attack->GetName());
+
+	// Whatever we predicted after this point is built on the wrong attack
+	ClearQueue(false);
+
+	if (!PlayAttackMontage(Attack))
+	{
+		return;
+	}
+
+	CurrentAttackData = Attack;
+	HotState.CurrentAttackInputType = Attack->AttackType == EAttackType::Heavy ? EInputType::HeavyAttack : EInputType::LightAttack;
+	HoldState.Reset();
+	DiscoverCheckpoints(Attack->AttackMontage, Attack->GetCheckpointSection());
+
+	// Catch up to where the server's montage is by now
+	const float CaughtUpPosition = MontagePosition + GetEstimatedOneWayLatency();
+	if (UAnimInstance* AnimInstance = OwnerCharacter->GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->Montage_SetPosition(Attack->AttackMontage, CaughtUpPosition);
+	}
+
+	// Skipping ahead doesn't fire the phase notifies we jumped over, so derive the phase from the timing block
+	// (a schedule started below only fires the boundaries still ahead of the caught-up position)
+	FAttackTimingCache Scratch;
+	const FAttackTimingCache& Timing = Attack->GetTimingCache(Scratch);
+
+	EAttackPhase Phase = EAttackPhase::Windup;
+	if (Timing.RecoveryTransitionTime >= 0.0f && CaughtUpPosition >= Timing.RecoveryTransitionTime)
+	{
+		Phase = EAttackPhase::Recovery;
+	}
+	else if (Timing.ActiveTransitionTime >= 0.0f && CaughtUpPosition >= Timing.ActiveTransitionTime)
+	{
+		Phase = EAttackPhase::Active;
+	}
+	SetPhase(Phase);
+	SyncMontageClock();
+	StartAttackTiming(Attack);
+}
+
+void UCombatComponentV2::RollBackPrediction()
+{
+	QueueStats.NetMispredictions++;
+	COMBAT_LOG(Log, TEXT("[V2 NET] Prediction on %s not confirmed - rolling back"), *GetNameSafe(GetOwner()));
+
+	UAnimInstance* AnimInstance = OwnerCharacter && OwnerCharacter->GetMesh() ? OwnerCharacter->GetMesh()->GetAnimInstance() : nullptr;
+	if (AnimInstance && CurrentAttackData && CurrentAttackData->AttackMontage)
+	{
+		AnimInstance->Montage_Stop(CurrentAttackData->ComboBlendOutTime, CurrentAttackData->AttackMontage);
+	}
+
+	ClearQueue(true);
+	SetPhase(EAttackPhase::None);
+}
+
+void UCombatComponentV2::UpdatePredictionTimeouts()
+{
+	// Oldest first: if it's overdue, everything predicted on top of it is suspect too
+	const float Deadline = PredictionConfirmTimeout + 2.0f * GetEstimatedOneWayLatency();
+	if (GetWorld()->GetTimeSeconds() - PendingPredictions[0].ExecutedTime > Deadline)
+	{
+		PendingPredictions.Reset();
+		RollBackPrediction();
 	}
 }
 
+float UCombatComponentV2::GetEstimatedOneWayLatency() const
+{
+	const APlayerState* PlayerState = OwnerCharacter ? OwnerCharacter->GetPlayerState() : nullptr;
+	return PlayerState ? PlayerState->GetPingInMilliseconds() * 0.0005f : 0.0f;
+}
+
+bool UCombatComponentV2::CanProcessInput(EInputType InputType) const
+{
+	if (!CombatComponent)
+	{
+		return false;
+	}
+
+	// V2 accepts input in more states than V1 (everything but Dead/HitStunned/GuardBroken)
+	return CombatStateTransitions::AcceptsInput(CombatComponent->GetCombatState());
+}
+
 // ============================================================================
 // ACTION QUEUE MANAGEMENT
 // ============================================================================
 
 void UCombatComponentV2::QueueAction(const FQueuedInputAction& InputAction, UAttackData* AttackData)
 {
+	COMBAT_TRACE_SCOPE(UCombatComponentV2::QueueAction);
+
 	if (!CombatComponent)
 	{
 		return;
@@ -248,8 +853,9 @@ void UCombatComponentV2::QueueAction(const FQueuedInputAction& InputAction, UAtt
 	// Determine execution mode
 	EActionExecutionMode ExecMode = DetermineExecutionMode(InputAction);
 
-	// Get attack data if not provided
-	if (!AttackData)
+	// Get attack data if not provided (deferred mode: queued entries resolve in ExecuteAction)
+	const bool bDeferResolution = bDeferAttackResolution && ExecMode == EActionExecutionMode::Queued;
+	if (!AttackData && !bDeferResolution)
 	{
 		AttackData = GetAttackForInput(InputAction.InputType);
 	}
@@ -257,6 +863,9 @@ void UCombatComponentV2::QueueAction(const FQueuedInputAction& InputAction, UAtt
 	// Create queue entry
 	FActionQueueEntry Entry(InputAction, AttackData, ExecMode);
 	Entry.Priority = CalculatePriority(Entry);
+	Entry.QueuedTime = FPlatformTime::Seconds();
+	Entry.InputReceivedTime = InputAction.ReceivedRealTime > 0.0 ? InputAction.ReceivedRealTime : Entry.QueuedTime;
+	CombatTrace::OutputQueueEvent(GetOwner(), CombatTrace::EQueueEvent::Queued, InputAction.InputType, ExecMode);
 
 	// PHASE 9: Set TargetPhase for event-driven execution
 	// Immediate: Execute synchronously (no phase wait)
@@ -274,36 +883,34 @@ void UCombatComponentV2::QueueAction(const FQueuedInputAction& InputAction, UAtt
 		// If NO: Clear all pending (combo chain ended, starting fresh)
 
 		UAttackData* ExecutingAttack = Entry.AttackData;
-		bool bHasComboBranches = ExecutingAttack &&
-			(ExecutingAttack->NextComboAttack != nullptr ||
-			 ExecutingAttack->HeavyComboAttack != nullptr ||
-			 ExecutingAttack->DirectionalFollowUps.Num() > 0 ||
-			 ExecutingAttack->HeavyDirectionalFollowUps.Num() > 0);
+		bool bHasComboBranches = ExecutingAttack && ExecutingAttack->HasComboBranches();
 
 		if (bHasComboBranches && ActionQueue.Num() > 0)
 		{
 			// This attack has combo branches - preserve ONLY the FIRST valid combo of each type
 			// This prevents button mashing from executing entire combo chains (max 1 Light + 1 Heavy queued)
-			TArray<FActionQueueEntry> ValidCombos;
 			bool bHasQueuedLight = false;
 			bool bHasQueuedHeavy = false;
 			int32 CancelledCount = 0;
 
-			for (FActionQueueEntry& QueuedEntry : ActionQueue)
+			FActionQueueHandle NextHandle;
+			for (FActionQueueHandle Handle = ActionQueue.First(); Handle.IsValid(); Handle = NextHandle)
 			{
-				if (!QueuedEntry.IsPending())
+				NextHandle = ActionQueue.Next(Handle);
+				if (!ActionQueue.GetHot(Handle).IsPending())
 				{
-					ValidCombos.Add(QueuedEntry); // Keep non-pending
-					continue;
+					continue; // Keep non-pending
 				}
 
+				FActionQueueEntry& QueuedEntry = ActionQueue.Get(Handle);
+
 				// Check if this queued action is a valid combo from executing attack
 				bool bIsValidCombo = false;
 				bool bAlreadyQueued = false;
 
 				if (QueuedEntry.InputAction.InputType == EInputType::LightAttack)
 				{
-					bIsValidCombo = (ExecutingAttack->NextComboAttack != nullptr);
+					bIsValidCombo = (ExecutingAttack->GetNextComboAttack() != nullptr);
 					bAlreadyQueued = bHasQueuedLight;
 					if (bIsValidCombo && !bAlreadyQueued)
 					{
@@ -312,7 +919,7 @@ void UCombatComponentV2::QueueAction(const FQueuedInputAction& InputAction, UAtt
 				}
 				else if (QueuedEntry.InputAction.InputType == EInputType::HeavyAttack)
 				{
-					bIsValidCombo = (ExecutingAttack->HeavyComboAttack != nullptr);
+					bIsValidCombo = (ExecutingAttack->GetHeavyComboAttack() != nullptr);
 					bAlreadyQueued = bHasQueuedHeavy;
 					if (bIsValidCombo && !bAlreadyQueued)
 					{
@@ -320,26 +927,22 @@ void UCombatComponentV2::QueueAction(const FQueuedInputAction& InputAction, UAtt
 					}
 				}
 
-				if (bIsValidCombo && !bAlreadyQueued)
-				{
-					ValidCombos.Add(QueuedEntry); // Keep FIRST valid combo of this type
-				}
-				else
+				if (!bIsValidCombo || bAlreadyQueued)
 				{
 					// Cancel: either invalid combo OR duplicate input (spam prevention)
-					QueuedEntry.State = EActionState::Cancelled;
+					// Only the FIRST valid combo of each type stays queued (max 1 Light + 1 Heavy)
+					ActionQueue.SetState(Handle, EActionState::Cancelled);
+					CombatTrace::OutputQueueEvent(GetOwner(), CombatTrace::EQueueEvent::Cancelled, QueuedEntry.InputAction.InputType, QueuedEntry.ExecutionMode);
 					QueueStats.ActionsCancelled++;
 					CancelledCount++;
+					ActionQueue.Remove(Handle);
 				}
 			}
 
-			// Replace queue with only valid combos (max 1 Light + 1 Heavy)
-			ActionQueue = ValidCombos;
-
 			if (GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 QUEUE] Combo-aware clear: Preserved %d valid combos (anti-spam), cancelled %d"),
-					ValidCombos.Num(), CancelledCount);
+				COMBAT_LOG(Log, TEXT("[V2 QUEUE] Combo-aware clear: Preserved %d valid combos (anti-spam), cancelled %d"),
+					ActionQueue.Num(), CancelledCount);
 			}
 		}
 		else if (ActionQueue.Num() > 0)
@@ -351,22 +954,23 @@ void UCombatComponentV2::QueueAction(const FQueuedInputAction& InputAction, UAtt
 				if (QueuedEntry.IsPending())
 				{
 					QueuedEntry.State = EActionState::Cancelled;
+					CombatTrace::OutputQueueEvent(GetOwner(), CombatTrace::EQueueEvent::Cancelled, QueuedEntry.InputAction.InputType, QueuedEntry.ExecutionMode);
 					QueueStats.ActionsCancelled++;
 					ClearedCount++;
 				}
 			}
 
-			ActionQueue.Empty();
+			ActionQueue.Reset();
 
 			if (GetDebugDraw() && ClearedCount > 0)
 			{
-				UE_LOG(LogCombat, Warning, TEXT("[V2 QUEUE] Cleared %d pending actions (no combo branches - chain ended)"), ClearedCount);
+				COMBAT_LOG(Warning, TEXT("[V2 QUEUE] Cleared %d pending actions (no combo branches - chain ended)"), ClearedCount);
 			}
 		}
 
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 QUEUE] Executing IMMEDIATE action: Type=%s"),
+			COMBAT_LOG(Log, TEXT("[V2 QUEUE] Executing IMMEDIATE action: Type=%s"),
 				*UEnum::GetValueAsString(InputAction.InputType));
 		}
 
@@ -378,14 +982,14 @@ void UCombatComponentV2::QueueAction(const FQueuedInputAction& InputAction, UAtt
 
 			if (GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 QUEUE] Immediate execution SUCCESS"));
+				COMBAT_LOG(Log, TEXT("[V2 QUEUE] Immediate execution SUCCESS"));
 			}
 		}
 		else
 		{
 			if (GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Warning, TEXT("[V2 QUEUE] Immediate execution FAILED"));
+				COMBAT_LOG(Warning, TEXT("[V2 QUEUE] Immediate execution FAILED"));
 			}
 		}
 
@@ -395,15 +999,24 @@ void UCombatComponentV2::QueueAction(const FQueuedInputAction& InputAction, UAtt
 	// Queued mode: Schedule for later execution at Active-end
 	Entry.ScheduledTime = GetExecutionCheckpoint(Entry);
 
-	// Add to queue
-	ActionQueue.Add(Entry);
+	// Add to queue (kept ordered by scheduled time on insert)
+	if (!ActionQueue.Push(Entry).IsValid())
+	{
+		UE_LOG(LogCombat, Warning, TEXT("[V2 QUEUE] Action queue full (%d), dropping input: Type=%s"),
+			FActionQueue::Capacity, *UEnum::GetValueAsString(InputAction.InputType));
+		CombatTrace::OutputQueueEvent(GetOwner(), CombatTrace::EQueueEvent::Cancelled, Entry.InputAction.InputType, Entry.ExecutionMode);
+		QueueStats.ActionsCancelled++;
+		return;
+	}
+
+	FCombatFieldTelemetry::Get().RecordQueueDepth(ActionQueue.Num());
 
-	// Sort by scheduled time
-	SortQueueByTime();
+	// Further presses of this type are redundant until it executes or the phase moves on
+	MarkInputCoalesced(InputAction.InputType);
 
 	if ( GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 QUEUE] Added queued action: Type=%s, Mode=%s, Scheduled=%.2f, Priority=%d"),
+		COMBAT_LOG(Log, TEXT("[V2 QUEUE] Added queued action: Type=%s, Mode=%s, Scheduled=%.2f, Priority=%d"),
 			*UEnum::GetValueAsString(InputAction.InputType),
 			*UEnum::GetValueAsString(ExecMode),
 			Entry.ScheduledTime,
@@ -413,6 +1026,11 @@ void UCombatComponentV2::QueueAction(const FQueuedInputAction& InputAction, UAtt
 
 void UCombatComponentV2::ProcessQueuedActions(EAttackPhase TargetPhase)
 {
+	COMBAT_TRACE_SCOPE(UCombatComponentV2::ProcessQueuedActions);
+	SCOPE_CYCLE_COUNTER(STAT_Combat_ProcessQueue);
+	COMBAT_CSV_SCOPE_IN(Queue, ProcessQueue);
+	COMBAT_BUDGET_SCOPE(Queue);
+
 	// PHASE 9: EVENT-DRIVEN QUEUE PROCESSING (NOT tick-based!)
 	// Execute actions that are waiting for this phase transition
 	// This completely replaces montage-time-based polling
@@ -425,24 +1043,29 @@ void UCombatComponentV2::ProcessQueuedActions(EAttackPhase TargetPhase)
 	int32 ExecutedCount = 0;
 
 	// Process actions targeting this phase (FIFO order maintained)
-	for (int32 i = ActionQueue.Num() - 1; i >= 0; --i)
+	FActionQueueHandle PrevHandle;
+	for (FActionQueueHandle Handle = ActionQueue.Last(); Handle.IsValid(); Handle = PrevHandle)
 	{
-		FActionQueueEntry& Entry = ActionQueue[i];
+		PrevHandle = ActionQueue.Prev(Handle);
+		const FActionQueueHotEntry& Hot = ActionQueue.GetHot(Handle);
 
-		if (!Entry.IsPending())
+		if (!Hot.IsPending())
 		{
 			continue; // Skip non-pending actions
 		}
 
 		// Check if this action targets the current phase transition
-		bool bShouldExecute = (Entry.TargetPhase == TargetPhase);
+		bool bShouldExecute = (Hot.TargetPhase == TargetPhase);
 
 		if (bShouldExecute)
 		{
+			// Only matching entries touch cold storage
+			FActionQueueEntry& Entry = ActionQueue.Get(Handle);
+
 			// Execute action
 			if (ExecuteAction(Entry))
 			{
-				Entry.State = EActionState::Completed;
+				ActionQueue.SetState(Handle, EActionState::Completed);
 				QueueStats.ActionsExecuted++;
 
 				if (Entry.ExecutionMode == EActionExecutionMode::Queued)
@@ -454,40 +1077,45 @@ void UCombatComponentV2::ProcessQueuedActions(EAttackPhase TargetPhase)
 
 				if (GetDebugDraw())
 				{
-					UE_LOG(LogCombat, Log, TEXT("[V2 EVENT-DRIVEN] Executed action on phase %s (TargetPhase: %s)"),
+					COMBAT_LOG(Log, TEXT("[V2 EVENT-DRIVEN] Executed action on phase %s (TargetPhase: %s)"),
 						*UEnum::GetValueAsString(TargetPhase),
 						*UEnum::GetValueAsString(Entry.TargetPhase));
 				}
 
 				// Remove from queue after successful execution
-				ActionQueue.RemoveAt(i);
+				ActionQueue.Remove(Handle);
 			}
 			else
 			{
 				// Execution failed - mark as cancelled
-				Entry.State = EActionState::Cancelled;
+				ActionQueue.SetState(Handle, EActionState::Cancelled);
+				CombatTrace::OutputQueueEvent(GetOwner(), CombatTrace::EQueueEvent::Cancelled, Entry.InputAction.InputType, Entry.ExecutionMode);
 				QueueStats.ActionsCancelled++;
 
 				if (GetDebugDraw())
 				{
-					UE_LOG(LogCombat, Warning, TEXT("[V2 EVENT-DRIVEN] Action execution failed on phase %s, cancelled"),
+					COMBAT_LOG(Warning, TEXT("[V2 EVENT-DRIVEN] Action execution failed on phase %s, cancelled"),
 						*UEnum::GetValueAsString(TargetPhase));
 				}
 
-				ActionQueue.RemoveAt(i);
+				ActionQueue.Remove(Handle);
 			}
 		}
 	}
 
 	if (GetDebugDraw() && ExecutedCount > 0)
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 EVENT-DRIVEN] Processed %d queued actions on phase %s"),
+		COMBAT_LOG(Log, TEXT("[V2 EVENT-DRIVEN] Processed %d queued actions on phase %s"),
 			ExecutedCount, *UEnum::GetValueAsString(TargetPhase));
 	}
 }
 
 void UCombatComponentV2::ProcessQueue(float CurrentMontageTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Combat_ProcessQueue);
+	COMBAT_CSV_SCOPE_IN(Queue, ProcessQueue);
+	COMBAT_BUDGET_SCOPE(Queue);
+
 	// DEPRECATED: Tick-based queue processing
 	// Replaced by event-driven ProcessQueuedActions(TargetPhase) in Phase 9
 	// Keeping this stub for potential backward compatibility or debugging
@@ -499,11 +1127,13 @@ void UCombatComponentV2::ProcessQueue(float CurrentMontageTime)
 
 	// OLD TICK-BASED LOGIC (no longer used):
 	// Process actions that have reached their scheduled time
-	for (int32 i = ActionQueue.Num() - 1; i >= 0; --i)
+	FActionQueueHandle PrevHandle;
+	for (FActionQueueHandle Handle = ActionQueue.Last(); Handle.IsValid(); Handle = PrevHandle)
 	{
-		FActionQueueEntry& Entry = ActionQueue[i];
+		PrevHandle = ActionQueue.Prev(Handle);
+		const FActionQueueHotEntry& Hot = ActionQueue.GetHot(Handle);
 
-		if (!Entry.IsPending())
+		if (!Hot.IsPending())
 		{
 			continue;
 		}
@@ -511,23 +1141,16 @@ void UCombatComponentV2::ProcessQueue(float CurrentMontageTime)
 		// Check if action is ready to execute
 		bool bReadyToExecute = false;
 
-		if (Entry.ScheduledTime < 0.0f)
+		if (Hot.ScheduledTime < 0.0f)
 		{
-			// Sentinel value: Find Active-end checkpoint dynamically
-			for (const FTimerCheckpoint& Checkpoint : Checkpoints)
+			// Sentinel value: Use Active-end checkpoint once it has been registered
+			if (ActiveEndCheckpointTime >= 0.0f && CurrentMontageTime >= ActiveEndCheckpointTime)
 			{
-				if (Checkpoint.WindowType == EActionWindowType::Combo &&
-					Checkpoint.bActive &&
-					Checkpoint.Duration == 0.0f &&
-					CurrentMontageTime >= Checkpoint.MontageTime)
-				{
-					bReadyToExecute = true;
-					Entry.ScheduledTime = Checkpoint.MontageTime; // Update for logging
-					break;
-				}
+				bReadyToExecute = true;
+				ActionQueue.SetScheduledTime(Handle, ActiveEndCheckpointTime); // Update for logging
 			}
 		}
-		else if (CurrentMontageTime >= Entry.ScheduledTime)
+		else if (CurrentMontageTime >= Hot.ScheduledTime)
 		{
 			// Normal scheduled time reached
 			bReadyToExecute = true;
@@ -535,10 +1158,12 @@ void UCombatComponentV2::ProcessQueue(float CurrentMontageTime)
 
 		if (bReadyToExecute)
 		{
+			FActionQueueEntry& Entry = ActionQueue.Get(Handle);
+
 			// Execute action
 			if (ExecuteAction(Entry))
 			{
-				Entry.State = EActionState::Completed;
+				ActionQueue.SetState(Handle, EActionState::Completed);
 				QueueStats.ActionsExecuted++;
 
 				if (Entry.ExecutionMode == EActionExecutionMode::Queued)
@@ -548,20 +1173,22 @@ void UCombatComponentV2::ProcessQueue(float CurrentMontageTime)
 
 				if (GetDebugDraw())
 				{
-					UE_LOG(LogCombat, Log, TEXT("[V2 QUEUE] Executed action at %.2f (scheduled: %.2f)"),
+					COMBAT_LOG(Log, TEXT("[V2 QUEUE] Executed action at %.2f (scheduled: %.2f)"),
 						CurrentMontageTime, Entry.ScheduledTime);
 				}
 
 				// Remove from queue after successful execution
-				ActionQueue.RemoveAt(i);
+				ActionQueue.Remove(Handle);
 			}
 			else
 			{
 				// Execution failed - keep in queue for potential retry
 				// Mark as cancelled if it keeps failing
+				ActionQueue.SetState(Handle, Entry.State); // ExecuteAction marked it Executing
+
 				if (GetDebugDraw())
 				{
-					UE_LOG(LogCombat, Warning, TEXT("[V2 QUEUE] Action execution failed at %.2f, keeping in queue"),
+					COMBAT_LOG(Warning, TEXT("[V2 QUEUE] Action execution failed at %.2f, keeping in queue"),
 						CurrentMontageTime);
 				}
 			}
@@ -571,6 +1198,14 @@ void UCombatComponentV2::ProcessQueue(float CurrentMontageTime)
 
 bool UCombatComponentV2::ExecuteAction(FActionQueueEntry& Action)
 {
+	COMBAT_TRACE_SCOPE(UCombatComponentV2::ExecuteAction);
+
+	// Deferred resolution: resolve once, against the attack this action actually follows
+	if (!Action.AttackData && bDeferAttackResolution)
+	{
+		Action.AttackData = ResolveAttackForInput(Action.InputAction.InputType, Action.InputAction.Direction, Action.InputAction.bInComboWindow);
+	}
+
 	if (!Action.AttackData)
 	{
 		return false;
@@ -595,32 +1230,53 @@ bool UCombatComponentV2::ExecuteAction(FActionQueueEntry& Action)
 				// Transition to Windup phase (event-driven phase management)
 				SetPhase(EAttackPhase::Windup);
 
-				DiscoverCheckpoints(Action.AttackData->AttackMontage);
+				DiscoverCheckpoints(Action.AttackData->AttackMontage, Action.AttackData->GetCheckpointSection());
 
 				// Track current attack for combo progression
 				CurrentAttackData = Action.AttackData;
-				CurrentAttackInputType = Action.InputAction.InputType;
+				HotState.CurrentAttackInputType = Action.InputAction.InputType;
+
+				SyncMontageClock();
+				StartAttackTiming(Action.AttackData);
+
+				// Stream the chain ahead of the new attack
+				PreloadComboWindow();
+
+				RecordExecuteLatency(Action);
+				CombatTrace::OutputQueueEvent(GetOwner(), CombatTrace::EQueueEvent::Executed, Action.InputAction.InputType, Action.ExecutionMode);
+
+				if (Action.InputAction.NetSequence != 0)
+				{
+					OnNetworkedActionExecuted(Action);
+				}
 
 				// CRITICAL FIX: Reset hold state for new attack (clears bActivatedThisAttack)
 				HoldState.Reset();
 
 				// Broadcast attack started event
-				bool bIsCombo = (CurrentPhase == EAttackPhase::Recovery || CurrentPhase == EAttackPhase::Active);
+				bool bIsCombo = (HotState.CurrentPhase == EAttackPhase::Recovery || HotState.CurrentPhase == EAttackPhase::Active);
 				OnAttackStarted.Broadcast(Action.AttackData, Action.InputAction.InputType, bIsCombo);
 
+				if (FCombatEvent* Event = UCombatEventDispatcherSubsystem::PublishFrom(this, ECombatEventKind::AttackStarted, GetOwner()))
+				{
+					Event->AttackData = Action.AttackData;
+					Event->Arg0 = static_cast<uint8>(Action.InputAction.InputType);
+					Event->Arg1 = bIsCombo ? 1 : 0;
+				}
+
 				if (GetDebugDraw())
 				{
 					FString SectionName = Action.AttackData->MontageSection.IsNone() ?
 						TEXT("Default") : Action.AttackData->MontageSection.ToString();
 
-					UE_LOG(LogCombat, Log, TEXT("[V2 EXECUTE] ═══════════════════════════════════════"));
-					UE_LOG(LogCombat, Log, TEXT("[V2 EXECUTE] Attack Data: %s"), *Action.AttackData->GetName());
-					UE_LOG(LogCombat, Log, TEXT("[V2 EXECUTE] Montage: %s"), *Action.AttackData->AttackMontage->GetName());
-					UE_LOG(LogCombat, Log, TEXT("[V2 EXECUTE] Section: %s"), *SectionName);
-					UE_LOG(LogCombat, Log, TEXT("[V2 EXECUTE] Input Type: %s"), *UEnum::GetValueAsString(CurrentAttackInputType));
-					UE_LOG(LogCombat, Log, TEXT("[V2 EXECUTE] Is Combo: %s"), bIsCombo ? TEXT("YES") : TEXT("NO"));
-					UE_LOG(LogCombat, Log, TEXT("[V2 EXECUTE] Checkpoints Discovered: %d"), Checkpoints.Num());
-					UE_LOG(LogCombat, Log, TEXT("[V2 EXECUTE] ═══════════════════════════════════════"));
+					COMBAT_LOG(Log, TEXT("[V2 EXECUTE] ═══════════════════════════════════════"));
+					COMBAT_LOG(Log, TEXT("[V2 EXECUTE] Attack Data: %s"), *Action.AttackData->GetName());
+					COMBAT_LOG(Log, TEXT("[V2 EXECUTE] Montage: %s"), *Action.AttackData->AttackMontage->GetName());
+					COMBAT_LOG(Log, TEXT("[V2 EXECUTE] Section: %s"), *SectionName);
+					COMBAT_LOG(Log, TEXT("[V2 EXECUTE] Input Type: %s"), *UEnum::GetValueAsString(HotState.CurrentAttackInputType));
+					COMBAT_LOG(Log, TEXT("[V2 EXECUTE] Is Combo: %s"), bIsCombo ? TEXT("YES") : TEXT("NO"));
+					COMBAT_LOG(Log, TEXT("[V2 EXECUTE] Checkpoints Discovered: %d"), Checkpoints.Num());
+					COMBAT_LOG(Log, TEXT("[V2 EXECUTE] ═══════════════════════════════════════"));
 				}
 			}
 			break;
@@ -647,7 +1303,7 @@ bool UCombatComponentV2::PlayAttackMontage(UAttackData* AttackData)
 	{
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Warning, TEXT("[V2 MONTAGE] Failed - Invalid AttackData or Montage"));
+			COMBAT_LOG(Warning, TEXT("[V2 MONTAGE] Failed - Invalid AttackData or Montage"));
 		}
 		return false;
 	}
@@ -657,7 +1313,7 @@ bool UCombatComponentV2::PlayAttackMontage(UAttackData* AttackData)
 	{
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Warning, TEXT("[V2 MONTAGE] Failed - No character or mesh"));
+			COMBAT_LOG(Warning, TEXT("[V2 MONTAGE] Failed - No character or mesh"));
 		}
 		return false;
 	}
@@ -667,7 +1323,7 @@ bool UCombatComponentV2::PlayAttackMontage(UAttackData* AttackData)
 	{
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Warning, TEXT("[V2 MONTAGE] Failed - No AnimInstance"));
+			COMBAT_LOG(Warning, TEXT("[V2 MONTAGE] Failed - No AnimInstance"));
 		}
 		return false;
 	}
@@ -676,6 +1332,11 @@ bool UCombatComponentV2::PlayAttackMontage(UAttackData* AttackData)
 	// This prevents hold state leaks (easing, movement locks) from previous attack
 	ClearHoldState();
 
+	if (TryJumpWithinMontage(AnimInstance, AttackData))
+	{
+		return true;
+	}
+
 	// COMBO BLENDING: Determine blend times for smooth transitions
 	// - Blend-out: Current attack's ComboBlendOutTime (0 = instant for first attack)
 	// - Blend-in: New attack's ComboBlendInTime (configurable per attack)
@@ -690,24 +1351,45 @@ bool UCombatComponentV2::PlayAttackMontage(UAttackData* AttackData)
 
 		if (GetDebugDraw() && (BlendOutTime > 0.0f || BlendInTime > 0.0f))
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 BLEND] Combo transition: %s (out=%.2fs) → %s (in=%.2fs)"),
+			COMBAT_LOG(Log, TEXT("[V2 BLEND] Combo transition: %s (out=%.2fs) → %s (in=%.2fs)"),
 				*CurrentAttackData->GetName(), BlendOutTime,
 				*AttackData->GetName(), BlendInTime);
 		}
 	}
 
-	// BLEND-OUT: Stop current montage if blending is requested
+	// INERTIALIZED: cut the previous attack and let the AnimBP's Inertialization node decay the pose
+	// difference, so the overlap evaluates one full-body montage instead of two
 	UAnimMontage* CurrentMontage = AnimInstance->GetCurrentActiveMontage();
-	if (CurrentMontage && BlendOutTime > 0.0f)
+	const float InertialBlendTime = FMath::Max(BlendOutTime, BlendInTime);
+	const bool bInertialize = CurrentMontage && AttackData->ComboBlendMode == EMontageBlendMode::Inertialization && InertialBlendTime > 0.0f;
+
+	// Shared by the inertialized stop and play
+	FMontageBlendSettings InertialBlend(InertialBlendTime);
+	InertialBlend.BlendMode = EMontageBlendMode::Inertialization;
+
+	if (bInertialize)
+	{
+		// The stopped instance still reports blending out / ended - keep the phase alive until the new one plays
+		HotState.bInComboBlend = true;
+
+		AnimInstance->Montage_StopWithBlendSettings(InertialBlend, CurrentMontage);
+
+		if (GetDebugDraw())
+		{
+			COMBAT_LOG(Log, TEXT("[V2 BLEND] Inertialized combo transition over %.2fs"), InertialBlendTime);
+		}
+	}
+	// BLEND-OUT: Stop current montage if blending is requested
+	else if (CurrentMontage && BlendOutTime > 0.0f)
 	{
 		// Mark that we're in combo blend transition - prevents premature phase reset
-		bInComboBlend = true;
+		HotState.bInComboBlend = true;
 
 		AnimInstance->Montage_Stop(BlendOutTime, CurrentMontage);
 
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 BLEND] Combo blend started - bInComboBlend=true (prevents None phase during blend-out)"));
+			COMBAT_LOG(Log, TEXT("[V2 BLEND] Combo blend started - bInComboBlend=true (prevents None phase during blend-out)"));
 		}
 	}
 
@@ -715,11 +1397,22 @@ bool UCombatComponentV2::PlayAttackMontage(UAttackData* AttackData)
 	// It's set during resolution based on whether the attack was found in DirectionalFollowUps map
 
 	// BLEND-IN: Play new montage with blend settings
-	// Note: OnMontageEnded delegate already bound in BeginPlay() for event-driven phase management
+	// Note: montage delegates are attached to the new instance once it's playing (below)
 	const float PlayRate = 1.0f;
 	const float StartPosition = 0.0f;
 
-	if (BlendInTime > 0.0f)
+	if (bInertialize)
+	{
+		AnimInstance->Montage_PlayWithBlendSettings(
+			AttackData->AttackMontage,
+			InertialBlend,
+			PlayRate,
+			EMontagePlayReturnType::MontageLength,
+			StartPosition,
+			false  // Don't stop all montages
+		);
+	}
+	else if (BlendInTime > 0.0f)
 	{
 		// Play with custom blend-in
 		FAlphaBlendArgs BlendIn(BlendInTime);
@@ -738,14 +1431,25 @@ bool UCombatComponentV2::PlayAttackMontage(UAttackData* AttackData)
 		AnimInstance->Montage_Play(AttackData->AttackMontage, PlayRate, EMontagePlayReturnType::MontageLength, StartPosition);
 	}
 
+	// Event-driven phase management: native delegates on this montage instance
+	// (an interrupted previous instance still reports through the delegates attached when it played)
+	AnimInstance->Montage_SetBlendingOutDelegate(MontageBlendingOutDelegate, AttackData->AttackMontage);
+	AnimInstance->Montage_SetEndDelegate(MontageEndedDelegate, AttackData->AttackMontage);
+
+	// Requests left over from the previous attack (hold, charge) must not carry onto this one
+	if (UPlayRateEasingSubsystem* Arbiter = GetPlayRateArbiter())
+	{
+		Arbiter->ClearPlayRates(OwnerCharacter);
+	}
+
 	// Clear blend flag - new montage has started playing, blend transition is complete
-	if (bInComboBlend)
+	if (HotState.bInComboBlend)
 	{
-		bInComboBlend = false;
+		HotState.bInComboBlend = false;
 
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 BLEND] New montage started - bInComboBlend=false (blend transition complete)"));
+			COMBAT_LOG(Log, TEXT("[V2 BLEND] New montage started - bInComboBlend=false (blend transition complete)"));
 		}
 	}
 
@@ -761,7 +1465,7 @@ bool UCombatComponentV2::PlayAttackMontage(UAttackData* AttackData)
 
 			if (GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 MONTAGE] Section-only mode: %s (no auto-advance)"),
+				COMBAT_LOG(Log, TEXT("[V2 MONTAGE] Section-only mode: %s (no auto-advance)"),
 					*AttackData->MontageSection.ToString());
 			}
 		}
@@ -769,11 +1473,62 @@ bool UCombatComponentV2::PlayAttackMontage(UAttackData* AttackData)
 
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 MONTAGE] Playing: %s | Section: %s | Delegate bound"),
+		COMBAT_LOG(Log, TEXT("[V2 MONTAGE] Playing: %s | Section: %s | Delegate bound"),
 			*AttackData->AttackMontage->GetName(),
 			*AttackData->MontageSection.ToString());
 	}
 
+	// Let AI defenders schedule their reactions against this attack's windows
+	if (UAIDefenseSubsystem* DefenseSubsystem = GetWorld()->GetSubsystem<UAIDefenseSubsystem>())
+	{
+		DefenseSubsystem->NotifyAttackStarted(GetOwner(), AnimInstance, AttackData->AttackMontage, AttackData->MontageSection);
+	}
+
+	return true;
+}
+
+bool UCombatComponentV2::TryJumpWithinMontage(UAnimInstance* AnimInstance, UAttackData* AttackData)
+{
+	if (!AttackData->bJumpWithinSharedMontage || AttackData->MontageSection.IsNone()
+		|| !CurrentAttackData || CurrentAttackData->AttackMontage != AttackData->AttackMontage)
+	{
+		return false;
+	}
+
+	// A stopped instance is blending out (interrupted or past its end) - it can't carry the next attack
+	const FAnimMontageInstance* MontageInstance = AnimInstance->GetActiveInstanceForMontage(AttackData->AttackMontage);
+	if (!MontageInstance || MontageInstance->IsStopped() || AttackData->AttackMontage->GetSectionIndex(AttackData->MontageSection) == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Same as a fresh play: full rate from the section start (written now so the new section
+	// never advances at a hold rate; the arbiter then has nothing left to write)
+	AnimInstance->Montage_JumpToSection(AttackData->MontageSection, AttackData->AttackMontage);
+	AnimInstance->Montage_SetPlayRate(AttackData->AttackMontage, 1.0f);
+	if (UPlayRateEasingSubsystem* Arbiter = GetPlayRateArbiter())
+	{
+		Arbiter->ClearPlayRates(OwnerCharacter);
+	}
+
+	if (AttackData->bUseSectionOnly)
+	{
+		AnimInstance->Montage_SetNextSection(AttackData->MontageSection, NAME_None, AttackData->AttackMontage);
+	}
+
+	QueueStats.SectionJumps++;
+
+	if (GetDebugDraw())
+	{
+		COMBAT_LOG(Log, TEXT("[V2 MONTAGE] Section jump: %s -> %s (instance reused)"),
+			*CurrentAttackData->MontageSection.ToString(), *AttackData->MontageSection.ToString());
+	}
+
+	if (UAIDefenseSubsystem* DefenseSubsystem = GetWorld()->GetSubsystem<UAIDefenseSubsystem>())
+	{
+		DefenseSubsystem->NotifyAttackStarted(GetOwner(), AnimInstance, AttackData->AttackMontage, AttackData->MontageSection);
+	}
+
 	return true;
 }
 
@@ -787,6 +1542,7 @@ void UCombatComponentV2::ClearQueue(bool bCancelCurrent)
 			if (Entry.State != EActionState::Completed)
 			{
 				Entry.State = EActionState::Cancelled;
+				CombatTrace::OutputQueueEvent(GetOwner(), CombatTrace::EQueueEvent::Cancelled, Entry.InputAction.InputType, Entry.ExecutionMode);
 				QueueStats.ActionsCancelled++;
 			}
 		}
@@ -799,40 +1555,46 @@ void UCombatComponentV2::ClearQueue(bool bCancelCurrent)
 			if (Entry.IsPending())
 			{
 				Entry.State = EActionState::Cancelled;
+				CombatTrace::OutputQueueEvent(GetOwner(), CombatTrace::EQueueEvent::Cancelled, Entry.InputAction.InputType, Entry.ExecutionMode);
 				QueueStats.ActionsCancelled++;
 			}
 		}
 	}
 
-	ActionQueue.Empty();
+	ActionQueue.Reset();
 
 	// Reset combo state when queue is cleared
 	CurrentAttackData = nullptr;
-	CurrentAttackInputType = EInputType::None;
+	HotState.CurrentAttackInputType = EInputType::None;
 
 	if ( GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 QUEUE] Cleared (CancelCurrent=%s) - Combo state reset"), bCancelCurrent ? TEXT("YES") : TEXT("NO"));
+		COMBAT_LOG(Log, TEXT("[V2 QUEUE] Cleared (CancelCurrent=%s) - Combo state reset"), bCancelCurrent ? TEXT("YES") : TEXT("NO"));
 	}
 }
 
 void UCombatComponentV2::CancelActionsWithPriority(int32 MinPriority)
 {
-	for (int32 i = ActionQueue.Num() - 1; i >= 0; --i)
+	FActionQueueHandle PrevHandle;
+	for (FActionQueueHandle Handle = ActionQueue.Last(); Handle.IsValid(); Handle = PrevHandle)
 	{
-		FActionQueueEntry& Entry = ActionQueue[i];
+		PrevHandle = ActionQueue.Prev(Handle);
+		const FActionQueueHotEntry& Hot = ActionQueue.GetHot(Handle);
 
-		if (Entry.IsPending() && Entry.Priority < MinPriority)
+		if (Hot.IsPending() && Hot.Priority < MinPriority)
 		{
-			Entry.State = EActionState::Cancelled;
+			FActionQueueEntry& Entry = ActionQueue.Get(Handle);
+			ActionQueue.SetState(Handle, EActionState::Cancelled);
+			CombatTrace::OutputQueueEvent(GetOwner(), CombatTrace::EQueueEvent::Cancelled, Entry.InputAction.InputType, Entry.ExecutionMode);
 			QueueStats.ActionsCancelled++;
-			ActionQueue.RemoveAt(i);
 
 			if ( GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 QUEUE] Cancelled action (Priority %d < %d)"),
+				COMBAT_LOG(Log, TEXT("[V2 QUEUE] Cancelled action (Priority %d < %d)"),
 					Entry.Priority, MinPriority);
 			}
+
+			ActionQueue.Remove(Handle);
 		}
 	}
 }
@@ -841,22 +1603,36 @@ void UCombatComponentV2::CancelActionsWithPriority(int32 MinPriority)
 // TIMER CHECKPOINT SYSTEM
 // ============================================================================
 
-void UCombatComponentV2::DiscoverCheckpoints(UAnimMontage* Montage)
+void UCombatComponentV2::DiscoverCheckpoints(UAnimMontage* Montage, FName SectionName)
 {
+	COMBAT_LLM_SCOPE(CheckpointCache);
+	COMBAT_TRACE_SCOPE(UCombatComponentV2::DiscoverCheckpoints);
+	SCOPE_CYCLE_COUNTER(STAT_Combat_DiscoverCheckpoints);
+
 	if (!Montage)
 	{
 		return;
 	}
 
-	// Clear existing checkpoints
-	Checkpoints.Empty();
+	// Clear existing checkpoints (keep allocation - refilled every attack)
+	ResetCheckpoints();
 
-	// Use MontageUtilityLibrary to discover checkpoints from AnimNotifyStates
-	int32 NumDiscovered = UMontageUtilityLibrary::DiscoverCheckpoints(Montage, Checkpoints);
+	// Copy the prebuilt table, or the section's slice of it (notify scan runs once per montage, see UMontageCheckpointCache)
+	if (UMontageCheckpointCache* CheckpointCache = GetWorld() ? GetWorld()->GetSubsystem<UMontageCheckpointCache>() : nullptr)
+	{
+		Checkpoints.Append(CheckpointCache->GetCheckpoints(Montage, SectionName));
+	}
+	else
+	{
+		UMontageUtilityLibrary::DiscoverCheckpoints(Montage, Checkpoints);
+	}
+	const int32 NumDiscovered = Checkpoints.Num();
+	RebuildCheckpointIndex();
+	++DebugStateVersion;
 
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 CHECKPOINTS] Discovered %d checkpoints from montage: %s"),
+		COMBAT_LOG(Log, TEXT("[V2 CHECKPOINTS] Discovered %d checkpoints from montage: %s"),
 			NumDiscovered,
 			*Montage->GetName());
 
@@ -865,15 +1641,11 @@ void UCombatComponentV2::DiscoverCheckpoints(UAnimMontage* Montage)
 	}
 
 	// Update combo window state if any combo checkpoints were found
-	for (const FTimerCheckpoint& Checkpoint : Checkpoints)
+	if (const FTimerCheckpoint* ComboCheckpoint = FindCheckpoint(EActionWindowType::Combo))
 	{
-		if (Checkpoint.WindowType == EActionWindowType::Combo)
-		{
-			bComboWindowActive = true;
-			ComboWindowStart = Checkpoint.MontageTime;
-			ComboWindowDuration = Checkpoint.Duration;
-			break;
-		}
+		HotState.bComboWindowActive = true;
+		HotState.ComboWindowStart = ComboCheckpoint->MontageTime;
+		HotState.ComboWindowDuration = ComboCheckpoint->Duration;
 	}
 }
 
@@ -882,23 +1654,50 @@ void UCombatComponentV2::RegisterCheckpoint(EActionWindowType WindowType, float
 	FTimerCheckpoint Checkpoint(WindowType, StartTime, Duration);
 	Checkpoint.bActive = true;
 
-	Checkpoints.Add(Checkpoint);
+	const int32 NewIndex = Checkpoints.Add(Checkpoint);
+	++DebugStateVersion;
+
+	// Incremental index update (appended, so existing first-of-type entries stay first)
+	int32& TypeIndex = CheckpointIndexByType[static_cast<int32>(WindowType)];
+	if (TypeIndex == INDEX_NONE)
+	{
+		TypeIndex = NewIndex;
+	}
+	NextCheckpointExpiry = FMath::Min(NextCheckpointExpiry, StartTime + Duration);
+	CombatTrace::OutputWindowEvent(GetOwner(), WindowType, true, StartTime);
 
 	// Update combo window state if this is a combo checkpoint
 	if (WindowType == EActionWindowType::Combo)
 	{
-		bComboWindowActive = true;
-		ComboWindowStart = StartTime;
-		ComboWindowDuration = Duration;
+		HotState.bComboWindowActive = true;
+		HotState.ComboWindowStart = StartTime;
+		HotState.ComboWindowDuration = Duration;
 	}
 
 	if ( GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 CHECKPOINTS] Registered: Type=%s, Start=%.2f, Duration=%.2f"),
+		COMBAT_LOG(Log, TEXT("[V2 CHECKPOINTS] Registered: Type=%s, Start=%.2f, Duration=%.2f"),
 			*UEnum::GetValueAsString(WindowType),
 			StartTime,
 			Duration);
 	}
+
+	// Cancel window opening during Recovery releases the actions held for it
+	// (may start the next montage, so nothing may touch this checkpoint afterwards)
+	if (WindowType == EActionWindowType::Cancel && HotState.CurrentPhase == EAttackPhase::Recovery)
+	{
+		ProcessQueuedActions(EAttackPhase::Recovery);
+	}
+}
+
+void UCombatComponentV2::RegisterActiveEndCheckpoint(float MontageTime)
+{
+	ActiveEndCheckpointTime = MontageTime;
+
+	if (GetDebugDraw())
+	{
+		COMBAT_LOG(Log, TEXT("[V2 CHECKPOINTS] Active-end registered at %.2f"), MontageTime);
+	}
 }
 
 bool UCombatComponentV2::HasReachedCheckpoint(const FTimerCheckpoint& Checkpoint, float CurrentTime) const
@@ -913,31 +1712,31 @@ float UCombatComponentV2::GetExecutionCheckpoint(const FActionQueueEntry& Action
 		return 0.0f; // Execute now
 	}
 
+	// Authored cancel window: execute when it opens (never before Active end)
+	const float CancelWindowStart = GetCancelWindowStart();
+	if (CancelWindowStart >= 0.0f)
+	{
+		return FMath::Max(ActiveEndCheckpointTime, CancelWindowStart);
+	}
+
 	// Queued mode: Execute at Active phase end (Active → Recovery transition)
-	// Find the zero-duration Combo checkpoint (registered when transitioning Active → Recovery)
-	// This is the phase transition point, NOT the deprecated combo window
-	for (const FTimerCheckpoint& Checkpoint : Checkpoints)
+	// Explicit Active-end slot (registered in OnPhaseTransition), NOT the deprecated combo window
+	if (ActiveEndCheckpointTime >= 0.0f)
 	{
-		if (Checkpoint.WindowType == EActionWindowType::Combo &&
-		    Checkpoint.bActive &&
-		    Checkpoint.Duration == 0.0f) // Zero-duration = Active-end marker (phase transition)
+		if (GetDebugDraw())
 		{
-			// Return the checkpoint time (Active phase end)
-			if (GetDebugDraw())
-			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 CHECKPOINT] Found Active-end checkpoint at %.2f for queued execution"),
-					Checkpoint.MontageTime);
-			}
-
-			return Checkpoint.MontageTime;
+			COMBAT_LOG(Log, TEXT("[V2 CHECKPOINT] Found Active-end checkpoint at %.2f for queued execution"),
+				ActiveEndCheckpointTime);
 		}
+
+		return ActiveEndCheckpointTime;
 	}
 
 	// Checkpoint not found yet - use sentinel value to indicate "execute at Active-end"
 	// The checkpoint will be created when Active→Recovery transition happens via OnPhaseTransition
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 CHECKPOINT] Active-end checkpoint not found yet, will execute when created"));
+		COMBAT_LOG(Log, TEXT("[V2 CHECKPOINT] Active-end checkpoint not found yet, will execute when created"));
 	}
 
 	//TODO: Consider warning if no Active-end checkpoint found after montage ends
@@ -954,19 +1753,25 @@ void UCombatComponentV2::OnHoldWindowStart(EInputType InputType)
 	// AnimNotify fires at hold window start, we check if button is STILL pressed
 	// This replaces tick-based CheckHoldActivation with event-driven pattern
 
+	// Sub-frame crossing time from the notify, else this frame
+	const float WindowStartTime = PendingHoldWindowStartTime >= 0.0f ? PendingHoldWindowStartTime : GetWorld()->GetTimeSeconds();
+	PendingHoldWindowStartTime = -1.0f;
+
 	if (!CombatComponent || !CurrentAttackData || HoldState.bActivatedThisAttack)
 	{
 		return;
 	}
 
-	// Check if the specified input is currently pressed (via HeldInputs map)
-	const float* PressTime = HeldInputs.Find(InputType);
-	if (!PressTime)
+	// Check if the specified input was down when the window started (press/release stamps, no polling).
+	// Inputs are stamped with sub-frame times, so a press that landed this frame after the crossing
+	// doesn't count, and one released this frame after the crossing still does (released at once).
+	bool bReleasedAfterWindowStart = false;
+	if (!HeldInputs.WasHeldAt(InputType, WindowStartTime, nullptr, &bReleasedAfterWindowStart))
 	{
 		// Button not held - normal combo flow
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Window start, but button not held: %s"),
+			COMBAT_LOG(Log, TEXT("[V2 HOLD] Window start, but button not held: %s"),
 				*UEnum::GetValueAsString(InputType));
 		}
 		return;
@@ -975,10 +1780,20 @@ void UCombatComponentV2::OnHoldWindowStart(EInputType InputType)
 	// Button is held - activate hold behavior
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Button held at window start: %s, activating hold"),
-			*UEnum::GetValueAsString(InputType));
+		COMBAT_LOG(Log, TEXT("[V2 HOLD] Button held at window start: %s, activating hold%s"),
+			*UEnum::GetValueAsString(InputType),
+			bReleasedAfterWindowStart ? TEXT(" (released later this frame)") : TEXT(""));
 	}
 
+	// Held across the crossing but already released: run the hold's release right after activating
+	ON_SCOPE_EXIT
+	{
+		if (bReleasedAfterWindowStart)
+		{
+			DeactivateHold();
+		}
+	};
+
 	// Determine hold behavior based on attack type
 	if (CurrentAttackData->AttackType == EAttackType::Heavy)
 	{
@@ -997,7 +1812,7 @@ void UCombatComponentV2::OnHoldWindowStart(EInputType InputType)
 			{
 				if (GetDebugDraw())
 				{
-					UE_LOG(LogCombat, Warning, TEXT("[V2 HOLD] Failed to jump to charge section: %s"),
+					COMBAT_LOG(Warning, TEXT("[V2 HOLD] Failed to jump to charge section: %s"),
 						*CurrentAttackData->ChargeLoopSection.ToString());
 				}
 				return;
@@ -1010,31 +1825,32 @@ void UCombatComponentV2::OnHoldWindowStart(EInputType InputType)
 			{
 				// STEP 3: Activate hold state (no playrate change for heavy attacks - loops at normal speed)
 				ActivateHold(InputType, 1.0f);
+				CombatComponent->BeginChargeStages(CurrentAttackData, WindowStartTime);
 
 				if (GetDebugDraw())
 				{
-					UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Heavy attack charge loop started: jumped to '%s' and looping"),
+					COMBAT_LOG(Log, TEXT("[V2 HOLD] Heavy attack charge loop started: jumped to '%s' and looping"),
 						*CurrentAttackData->ChargeLoopSection.ToString());
 				}
 			}
 			else if (GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Warning, TEXT("[V2 HOLD] Failed to loop charge section: %s"),
+				COMBAT_LOG(Warning, TEXT("[V2 HOLD] Failed to loop charge section: %s"),
 					*CurrentAttackData->ChargeLoopSection.ToString());
 			}
 		}
 		else if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Warning, TEXT("[V2 HOLD] Heavy attack has no ChargeLoopSection defined"));
+			COMBAT_LOG(Warning, TEXT("[V2 HOLD] Heavy attack has no ChargeLoopSection defined"));
 		}
 	}
 	else if (CurrentAttackData->AttackType == EAttackType::Light)
 	{
 		// LIGHT ATTACK HOLD: Begin EASE-IN slowdown (bidirectional easing system)
-		// Smoothly transition from normal speed to hold slowdown using UE Timer System (NOT tick!)
+		// Smoothly transition from normal speed to hold slowdown using the shared easing scheduler
 
 		// Activate hold state (marks hold as active)
-		HoldState.Activate(InputType, GetWorld()->GetTimeSeconds(), 1.0f);
+		HoldState.Activate(InputType, WindowStartTime, 1.0f);
 
 		// Initialize EASE-IN transition state (1.0 → HoldTargetPlayRate)
 		HoldState.bIsEasing = true;
@@ -1042,20 +1858,15 @@ void UCombatComponentV2::OnHoldWindowStart(EInputType InputType)
 		HoldState.EaseStartTime = GetWorld()->GetTimeSeconds();
 		HoldState.EaseStartPlayRate = 1.0f; // Current playrate (normal speed)
 
-		// Start timer for ease updates (60 Hz for smooth transitions)
-		// Timer calls OnEaseTimerTick() repeatedly until ease completes or is cancelled
-		float TimerInterval = 1.0f / 60.0f; // 60 Hz update rate
-		GetWorld()->GetTimerManager().SetTimer(
-			EaseTimerHandle,
-			this,
-			&UCombatComponentV2::OnEaseTimerTick,
-			TimerInterval,
-			true // Loop
-		);
+		// Scheduler advances the ease every frame and calls OnEaseUpdated/OnEaseFinished
+		StartHoldEase(HoldState.EaseStartPlayRate);
+
+		// Stage boundaries run on the timer wheel (a stage playrate takes over from the ease)
+		CombatComponent->BeginChargeStages(CurrentAttackData, WindowStartTime);
 
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 HOLD TIMER] Light attack EASE-IN started (1.0 → %.2f over %.2fs using %s @ 60Hz)"),
+			COMBAT_LOG(Log, TEXT("[V2 HOLD EASE] Light attack EASE-IN started (1.0 → %.2f over %.2fs using %s)"),
 				CurrentAttackData->HoldTargetPlayRate,
 				CurrentAttackData->HoldEaseInDuration,
 				*UEnum::GetValueAsString(CurrentAttackData->HoldEaseInType));
@@ -1072,13 +1883,16 @@ void UCombatComponentV2::ActivateHold(EInputType InputType, float PlayRate)
 
 	HoldState.Activate(InputType, GetWorld()->GetTimeSeconds(), PlayRate);
 
-	// Apply playrate to montage using utility library
-	ACharacter* Character = Cast<ACharacter>(GetOwner());
-	UMontageUtilityLibrary::SetMontagePlayRate(Character, PlayRate);
+	// Hold playrate goes through the arbiter (applied once at the end of the frame)
+	if (UPlayRateEasingSubsystem* Arbiter = GetPlayRateArbiter())
+	{
+		Arbiter->RequestPlayRate(Cast<ACharacter>(GetOwner()), EPlayRatePriority::Hold, PlayRate);
+	}
+	OnMontagePlayRateChanged();
 
 	if ( GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Activated: Input=%s, PlayRate=%.2f"),
+		COMBAT_LOG(Log, TEXT("[V2 HOLD] Activated: Input=%s, PlayRate=%.2f"),
 			*UEnum::GetValueAsString(InputType),
 			PlayRate);
 	}
@@ -1091,10 +1905,13 @@ void UCombatComponentV2::DeactivateHold()
 		return;
 	}
 
-	// Clear any existing ease timer (ease-in may still be running)
-	if (GetWorld() && EaseTimerHandle.IsValid())
+	// Cancel any running ease (ease-in may still be running)
+	CancelHoldEase();
+
+	// Stage reached stays readable for the release (UCombatComponent::GetReleasedChargeStage)
+	if (CombatComponent)
 	{
-		GetWorld()->GetTimerManager().ClearTimer(EaseTimerHandle);
+		CombatComponent->EndChargeStages();
 	}
 
 	// HEAVY ATTACK: Jump to release section (no easing)
@@ -1115,7 +1932,7 @@ void UCombatComponentV2::DeactivateHold()
 			{
 				if (bJumped)
 				{
-					UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Heavy attack released: jumping to release section '%s'"),
+					COMBAT_LOG(Log, TEXT("[V2 HOLD] Heavy attack released: jumping to release section '%s'"),
 						*CurrentAttackData->ChargeReleaseSection.ToString());
 				}
 				else
@@ -1141,21 +1958,21 @@ void UCombatComponentV2::DeactivateHold()
 
 						if (GetDebugDraw())
 						{
-							UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Heavy attack has no ChargeReleaseSection - blending to idle (%.2fs)"),
+							COMBAT_LOG(Log, TEXT("[V2 HOLD] Heavy attack has no ChargeReleaseSection - blending to idle (%.2fs)"),
 								CurrentAttackData->ChargeReleaseBlendTime);
 						}
 
 						// CRITICAL: Clear attack state immediately (no follow-up attack)
 						// OnMontageEnded will fire after blend completes, but we need to reset NOW
 						CurrentAttackData = nullptr;
-						CurrentAttackInputType = EInputType::None;
+						HotState.CurrentAttackInputType = EInputType::None;
 						SetPhase(EAttackPhase::None);
-						Checkpoints.Empty();
-						ActionQueue.Empty(); // Discard any queued actions - returning to idle
+						ResetCheckpoints();
+						ActionQueue.Reset(); // Discard any queued actions - returning to idle
 
 						if (GetDebugDraw())
 						{
-							UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Heavy attack state cleared - ready for new input"));
+							COMBAT_LOG(Log, TEXT("[V2 HOLD] Heavy attack state cleared - ready for new input"));
 						}
 					}
 				}
@@ -1168,12 +1985,14 @@ void UCombatComponentV2::DeactivateHold()
 	}
 
 	// LIGHT ATTACK: Begin EASE-OUT transition (HoldTargetPlayRate → 1.0)
-	// Reuse the same timer system but reverse the transition
+	// Reuse the same easing scheduler but reverse the transition
 
 	// CRITICAL FIX: Query ACTUAL montage playrate instead of HoldState.CurrentPlayRate
 	// If button released during ease-in, HoldState may not match AnimInstance's actual playrate
+	// (includes a rate requested earlier this frame that the arbiter hasn't applied yet)
 	ACharacter* Character = Cast<ACharacter>(GetOwner());
-	float CurrentPlayRate = UMontageUtilityLibrary::GetMontagePlayRate(Character);
+	const UPlayRateEasingSubsystem* Arbiter = GetPlayRateArbiter();
+	float CurrentPlayRate = Arbiter ? Arbiter->GetPlayRate(Character) : UMontageUtilityLibrary::GetMontagePlayRate(Character);
 
 	// Fallback to HoldState if query fails (shouldn't happen, but safety first)
 	if (CurrentPlayRate <= 0.0f)
@@ -1181,7 +2000,7 @@ void UCombatComponentV2::DeactivateHold()
 		CurrentPlayRate = HoldState.CurrentPlayRate;
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Warning, TEXT("[V2 HOLD] Failed to query montage playrate, using HoldState: %.2f"), CurrentPlayRate);
+			COMBAT_LOG(Warning, TEXT("[V2 HOLD] Failed to query montage playrate, using HoldState: %.2f"), CurrentPlayRate);
 		}
 	}
 
@@ -1193,189 +2012,209 @@ void UCombatComponentV2::DeactivateHold()
 
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Light attack EASE-OUT starting from ACTUAL playrate: %.2f → 1.0"), CurrentPlayRate);
+		COMBAT_LOG(Log, TEXT("[V2 HOLD] Light attack EASE-OUT starting from ACTUAL playrate: %.2f → 1.0"), CurrentPlayRate);
 	}
 
 	// NOTE: We keep HoldState.bIsHolding = true during ease-out
 	// This prevents re-activation during the transition
 	// Deactivate() will be called when ease-out complete
-	// Start timer for EASE-OUT (60 Hz for smooth transitions)
-	float TimerInterval = 1.0f / 60.0f; // 60 Hz update rate
-	GetWorld()->GetTimerManager().SetTimer(
-		EaseTimerHandle,
-		this,
-		&UCombatComponentV2::OnEaseTimerTick,
-		TimerInterval,
-		true // Loop
-	);
+	StartHoldEase(CurrentPlayRate);
 
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 HOLD TIMER] EASE-OUT started (%.2f → 1.0 over %.2fs using %s @ 60Hz)"),
+		COMBAT_LOG(Log, TEXT("[V2 HOLD EASE] EASE-OUT started (%.2f → 1.0 over %.2fs using %s)"),
 			CurrentPlayRate,
 			CurrentAttackData->HoldEaseOutDuration,
 			*UEnum::GetValueAsString(CurrentAttackData->HoldEaseOutType));
 	}
 }
 
-void UCombatComponentV2::OnEaseTimerTick()
+void UCombatComponentV2::StartHoldEase(float StartPlayRate)
 {
-	// V2 TIMER-BASED EASE TRANSITION (NOT tick-based!)
-	// This function is called by FTimerHandle at regular intervals (60 Hz)
-	// Handles BOTH ease-in (1.0 → HoldTargetPlayRate) AND ease-out (HoldTargetPlayRate → 1.0)
-
-	if (!HoldState.bIsEasing || !CurrentAttackData)
+	UPlayRateEasingSubsystem* Easing = GetWorld() ? GetWorld()->GetSubsystem<UPlayRateEasingSubsystem>() : nullptr;
+	if (!Easing || !CurrentAttackData)
 	{
-		// Ease cancelled or completed - clear timer
-		if (GetWorld())
-		{
-			GetWorld()->GetTimerManager().ClearTimer(EaseTimerHandle);
-		}
 		return;
 	}
 
-	// Calculate elapsed time since ease started
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	float ElapsedTime = CurrentTime - HoldState.EaseStartTime;
-
 	// Determine if we're easing IN or OUT using dedicated flag (NOT playrate comparison)
 	// CRITICAL FIX: Using playrate comparison fails when button released during ease-in
 	// EASE-IN: Start = 1.0, Target = HoldTargetPlayRate (bIsEasingOut = false)
 	// EASE-OUT: Start = current playrate, Target = 1.0 (bIsEasingOut = true)
-	bool bIsEasingIn = !HoldState.bIsEasingOut; // Use flag instead of playrate comparison
-	float TargetPlayRate = bIsEasingIn ? CurrentAttackData->HoldTargetPlayRate : 1.0f;
-	float EaseDuration = bIsEasingIn ? CurrentAttackData->HoldEaseInDuration : CurrentAttackData->HoldEaseOutDuration;
-	EEasingType EasingType = bIsEasingIn ? CurrentAttackData->HoldEaseInType : CurrentAttackData->HoldEaseOutType;
+	const bool bIsEasingIn = !HoldState.bIsEasingOut;
+	const float TargetPlayRate = bIsEasingIn ? CurrentAttackData->HoldTargetPlayRate : 1.0f;
+	const float EaseDuration = bIsEasingIn ? CurrentAttackData->HoldEaseInDuration : CurrentAttackData->HoldEaseOutDuration;
+	const EEasingType EasingType = bIsEasingIn ? CurrentAttackData->HoldEaseInType : CurrentAttackData->HoldEaseOutType;
+
+	// Starting an ease on the same character replaces any running one
+	EaseHandle = Easing->StartEase(
+		Cast<ACharacter>(GetOwner()),
+		StartPlayRate,
+		TargetPlayRate,
+		EaseDuration,
+		EasingType,
+		FOnPlayRateEaseUpdated::CreateUObject(this, &UCombatComponentV2::OnEaseUpdated),
+		FOnPlayRateEaseFinished::CreateUObject(this, &UCombatComponentV2::OnEaseFinished));
+}
 
-	// Check if ease transition is complete
-	if (ElapsedTime >= EaseDuration)
+void UCombatComponentV2::CancelHoldEase()
+{
+	if (!EaseHandle.IsValid())
 	{
-		// Ease complete - ensure we're at final target playrate
-		HoldState.bIsEasing = false;
-		HoldState.CurrentPlayRate = TargetPlayRate;
+		return;
+	}
 
-		ACharacter* CharacterRef = Cast<ACharacter>(GetOwner());
-		UMontageUtilityLibrary::SetMontagePlayRate(CharacterRef, HoldState.CurrentPlayRate);
+	if (UPlayRateEasingSubsystem* Easing = GetWorld() ? GetWorld()->GetSubsystem<UPlayRateEasingSubsystem>() : nullptr)
+	{
+		Easing->CancelEase(EaseHandle);
+	}
+	EaseHandle.Reset();
+}
 
-		// Clear timer - ease complete
-		GetWorld()->GetTimerManager().ClearTimer(EaseTimerHandle);
+void UCombatComponentV2::OnChargeStageChanged(int32 Stage, const FGameplayTag& StageTag)
+{
+	const FChargeStage* StageData = CurrentAttackData ? CurrentAttackData->GetChargeStageTable().GetStage(Stage) : nullptr;
+	if (!HoldState.IsHolding() || !StageData || StageData->PlayRate < 0.0f)
+	{
+		return;
+	}
 
-		// If EASE-IN just completed, mark hold as completed (freeze state reached)
-		if (bIsEasingIn)
-		{
-			HoldState.MarkHoldCompleted();
+	// UCombatComponent already requested the stage playrate from the arbiter
+	CancelHoldEase();
+	HoldState.bIsEasing = false;
+	HoldState.CurrentPlayRate = StageData->PlayRate;
+	++DebugStateVersion;
+	OnMontagePlayRateChanged();
 
-			if (GetDebugDraw())
-			{
-				float TotalHoldDuration = CurrentTime - HoldState.CurrentHold.StartTime;
-				UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Light attack freeze reached - hold marked completed (duration: %.2fs)"), TotalHoldDuration);
-			}
-		}
-		// If EASE-OUT just completed, execute follow-up attack ONLY if hold was completed
-		else
-		{
-			// Calculate total hold duration (from activation to release)
-			float TotalHoldDuration = CurrentTime - HoldState.CurrentHold.StartTime;
+	if (GetDebugDraw())
+	{
+		COMBAT_LOG(Log, TEXT("[V2 HOLD] Charge stage %d (%s) -> playrate %.2f"), Stage, *StageTag.ToString(), StageData->PlayRate);
+	}
+}
 
-			// CRITICAL: Only auto-queue follow-up if hold was COMPLETED
-			// Light: Playrate reached 0 (freeze state)
-			// Heavy: Charge loop became active (marked in ActivateHold)
-			if (HoldState.IsHoldCompleted())
-			{
-				// EXECUTE FOLLOW-UP ATTACK (directional only - NO NextComboAttack fallback)
-				UAttackData* FollowUpAttack = nullptr;
+void UCombatComponentV2::OnEaseUpdated(float PlayRate)
+{
+	// Scheduler already applied the playrate to the montage this frame
+	if (!HoldState.bIsEasing)
+	{
+		return;
+	}
 
-				// Check for directional follow-up based on held direction
-				if (CurrentAttackData && HoldState.CurrentHold.Direction != EAttackDirection::None)
-				{
-					// Try to find directional follow-up (TMap returns TObjectPtr<UAttackData>*)
-					TObjectPtr<UAttackData>* DirectionalAttack = CurrentAttackData->DirectionalFollowUps.Find(HoldState.CurrentHold.Direction);
-					if (DirectionalAttack && DirectionalAttack->Get())
-					{
-						FollowUpAttack = DirectionalAttack->Get();
+	HoldState.CurrentPlayRate = PlayRate;
+	OnMontagePlayRateChanged();
 
-						if (GetDebugDraw())
-						{
-							UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Directional follow-up found: Direction=%s, Attack=%s (hold duration: %.2fs)"),
-								*UEnum::GetValueAsString(HoldState.CurrentHold.Direction),
-								*FollowUpAttack->GetName(),
-								TotalHoldDuration);
-						}
-					}
-				}
+	// PHASE 1 FIX: Update movement state after changing playrate
+	// This ensures movement locks/unlocks based on current playrate
+	UpdateMovementFromMontageState();
 
-				// Queue the follow-up attack if found (NO fallback to NextComboAttack)
-				if (FollowUpAttack)
-				{
-					FQueuedInputAction FollowUpInput(
-						HoldState.GetHeldInputType(),          // Same input type as hold
-						EInputEventType::Press,                // Treat as press event
-						GetWorld()->GetTimeSeconds(),          // Current time
-						false                                   // Not in combo window
-					);
+	if (GetDebugDraw())
+	{
+		COMBAT_LOG(Verbose, TEXT("[V2 HOLD EASE] %s playrate: %.2f"),
+			HoldState.bIsEasingOut ? TEXT("EASE-OUT") : TEXT("EASE-IN"),
+			PlayRate);
+	}
+}
+
+void UCombatComponentV2::OnEaseFinished()
+{
+	// Handles BOTH ease-in (1.0 → HoldTargetPlayRate) AND ease-out (HoldTargetPlayRate → 1.0)
+	EaseHandle.Reset();
+
+	if (!HoldState.bIsEasing || !CurrentAttackData)
+	{
+		return;
+	}
 
-					QueueAction(FollowUpInput, FollowUpAttack);
+	// Ease complete - scheduler applied the final target playrate
+	const bool bIsEasingIn = !HoldState.bIsEasingOut;
+	HoldState.bIsEasing = false;
+	HoldState.CurrentPlayRate = bIsEasingIn ? CurrentAttackData->HoldTargetPlayRate : 1.0f;
+	OnMontagePlayRateChanged();
+
+	// If EASE-IN just completed, mark hold as completed (freeze state reached)
+	if (bIsEasingIn)
+	{
+		HoldState.MarkHoldCompleted();
+
+		if (GetDebugDraw())
+		{
+			float TotalHoldDuration = GetWorld()->GetTimeSeconds() - HoldState.CurrentHold.StartTime;
+			COMBAT_LOG(Log, TEXT("[V2 HOLD] Light attack freeze reached - hold marked completed (duration: %.2fs)"), TotalHoldDuration);
+		}
+	}
+	// If EASE-OUT just completed, execute follow-up attack ONLY if hold was completed
+	else
+	{
+		// Calculate total hold duration (from activation to release)
+		float TotalHoldDuration = GetWorld()->GetTimeSeconds() - HoldState.CurrentHold.StartTime;
+
+		// CRITICAL: Only auto-queue follow-up if hold was COMPLETED
+		// Light: Playrate reached 0 (freeze state)
+		// Heavy: Charge loop became active (marked in ActivateHold)
+		if (HoldState.IsHoldCompleted())
+		{
+			// EXECUTE FOLLOW-UP ATTACK (directional only - NO NextComboAttack fallback)
+			UAttackData* FollowUpAttack = nullptr;
+
+			// Check for directional follow-up based on held direction
+			if (CurrentAttackData && HoldState.CurrentHold.Direction != EAttackDirection::None)
+			{
+				// Try to find directional follow-up (hard link, else streamed soft link)
+				if (UAttackData* DirectionalAttack = CurrentAttackData->GetDirectionalFollowUp(EInputType::LightAttack, HoldState.CurrentHold.Direction))
+				{
+					FollowUpAttack = DirectionalAttack;
 
 					if (GetDebugDraw())
 					{
-						UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Directional follow-up queued: %s"), *FollowUpAttack->GetName());
+						COMBAT_LOG(Log, TEXT("[V2 HOLD] Directional follow-up found: Direction=%s, Attack=%s (hold duration: %.2fs)"),
+							*UEnum::GetValueAsString(HoldState.CurrentHold.Direction),
+							*FollowUpAttack->GetName(),
+							TotalHoldDuration);
 					}
 				}
-				else if (GetDebugDraw())
+			}
+
+			// Queue the follow-up attack if found (NO fallback to NextComboAttack)
+			if (FollowUpAttack)
+			{
+				FQueuedInputAction FollowUpInput(
+					HoldState.GetHeldInputType(),          // Same input type as hold
+					EInputEventType::Press,                // Treat as press event
+					GetWorld()->GetTimeSeconds(),          // Current time
+					false                                   // Not in combo window
+				);
+
+				QueueAction(FollowUpInput, FollowUpAttack);
+
+				if (GetDebugDraw())
 				{
-					UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] No directional follow-up configured for direction=%s"),
-						*UEnum::GetValueAsString(HoldState.CurrentHold.Direction));
+					COMBAT_LOG(Log, TEXT("[V2 HOLD] Directional follow-up queued: %s"), *FollowUpAttack->GetName());
 				}
 			}
 			else if (GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Hold not completed - skipping follow-up attack (duration: %.2fs)"),
-					TotalHoldDuration);
+				COMBAT_LOG(Log, TEXT("[V2 HOLD] No directional follow-up configured for direction=%s"),
+					*UEnum::GetValueAsString(HoldState.CurrentHold.Direction));
 			}
-
-			// Deactivate hold state
-			HoldState.Deactivate();
-
-			// PHASE 1 FIX: Procedurally update movement state (replaces manual SetMovementMode)
-			UpdateMovementFromMontageState();
 		}
-
-		if (GetDebugDraw())
+		else if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 HOLD TIMER] %s complete, final playrate: %.2f"),
-				bIsEasingIn ? TEXT("EASE-IN") : TEXT("EASE-OUT"),
-				HoldState.CurrentPlayRate);
+			COMBAT_LOG(Log, TEXT("[V2 HOLD] Hold not completed - skipping follow-up attack (duration: %.2fs)"),
+				TotalHoldDuration);
 		}
-		return;
-	}
-
-	// PROCEDURAL EASING: Calculate playrate using CalculateTransitionPlayRate
-	// This eliminates need for authored curves!
-	float NewPlayRate = UMontageUtilityLibrary::CalculateTransitionPlayRate(
-		HoldState.EaseStartPlayRate,         // Start rate (1.0 or HoldTargetPlayRate)
-		TargetPlayRate,                       // Target rate (HoldTargetPlayRate or 1.0)
-		ElapsedTime,                          // Current time in transition
-		EaseDuration,                         // Transition duration (from AttackData)
-		EasingType                            // Easing curve (EaseInType or EaseOutType)
-	);
-
-	// Update hold state
-	HoldState.CurrentPlayRate = NewPlayRate;
 
-	// Apply playrate to montage
-	ACharacter* Character = Cast<ACharacter>(GetOwner());
-	UMontageUtilityLibrary::SetMontagePlayRate(Character, NewPlayRate);
+		// Deactivate hold state
+		HoldState.Deactivate();
 
-	// PHASE 1 FIX: Update movement state after changing playrate
-	// This ensures movement locks/unlocks based on current playrate
-	UpdateMovementFromMontageState();
+		// PHASE 1 FIX: Procedurally update movement state (replaces manual SetMovementMode)
+		UpdateMovementFromMontageState();
+	}
 
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Verbose, TEXT("[V2 HOLD TIMER] %s playrate: %.2f → %.2f (%.1f%% complete)"),
+		COMBAT_LOG(Log, TEXT("[V2 HOLD EASE] %s complete, final playrate: %.2f"),
 			bIsEasingIn ? TEXT("EASE-IN") : TEXT("EASE-OUT"),
-			HoldState.EaseStartPlayRate, TargetPlayRate,
-			(ElapsedTime / EaseDuration) * 100.0f);
+			HoldState.CurrentPlayRate);
 	}
 }
 
@@ -1385,14 +2224,26 @@ void UCombatComponentV2::OnEaseTimerTick()
 
 void UCombatComponentV2::OnPhaseTransition(EAttackPhase NewPhase)
 {
+	const EAttackPhase PreviousPhase = HotState.CurrentPhase;
+
 	// CRITICAL: Update CurrentPhase FIRST before any other logic
 	// This ensures DetermineExecutionMode sees the correct phase for incoming input
 	SetPhase(NewPhase);
 
+	// Active → Recovery is the "Active end" checkpoint for queued actions
+	if (PreviousPhase == EAttackPhase::Active && NewPhase == EAttackPhase::Recovery)
+	{
+		RegisterActiveEndCheckpoint(UMontageUtilityLibrary::GetCurrentMontageTime(OwnerCharacter));
+	}
+
 	// PHASE 9: EVENT-DRIVEN QUEUE PROCESSING
 	// Execute queued actions that target this phase transition
 	// This replaces tick-based ProcessQueue() polling!
-	ProcessQueuedActions(NewPhase);
+	// Recovery with an authored cancel window still ahead: actions wait for RegisterCheckpoint(Cancel)
+	if (NewPhase != EAttackPhase::Recovery || !IsCancelWindowPending())
+	{
+		ProcessQueuedActions(NewPhase);
+	}
 
 	// EVENT-DRIVEN MOVEMENT SYNC: Update movement state on phase changes
 	// Ensures movement is correct when phases change (no tick needed)
@@ -1400,31 +2251,40 @@ void UCombatComponentV2::OnPhaseTransition(EAttackPhase NewPhase)
 
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 PHASE] Phase transition complete: %s (queue processed event-driven)"),
+		COMBAT_LOG(Log, TEXT("[V2 PHASE] Phase transition complete: %s (queue processed event-driven)"),
 			*UEnum::GetValueAsString(NewPhase));
 	}
 }
 
 void UCombatComponentV2::SetPhase(EAttackPhase NewPhase)
 {
-	if (CurrentPhase == NewPhase)
+	if (HotState.CurrentPhase == NewPhase)
 	{
 		return; // No change needed
 	}
 
-	EAttackPhase OldPhase = CurrentPhase;
-	CurrentPhase = NewPhase;
+	EAttackPhase OldPhase = HotState.CurrentPhase;
+	HotState.CurrentPhase = NewPhase;
 
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 PHASE] Phase transition: %d → %d"),
+		COMBAT_LOG(Log, TEXT("[V2 PHASE] Phase transition: %d → %d"),
 			static_cast<int32>(OldPhase),
 			static_cast<int32>(NewPhase));
 	}
 
+	CombatTrace::OutputPhaseTransition(GetOwner(), OldPhase, NewPhase);
+
 	// Broadcast phase changed event
+	OnPhaseChangedNative.Broadcast(OldPhase, NewPhase);
 	OnPhaseChanged.Broadcast(OldPhase, NewPhase);
 
+	if (FCombatEvent* Event = UCombatEventDispatcherSubsystem::PublishFrom(this, ECombatEventKind::Phase, GetOwner()))
+	{
+		Event->Arg0 = static_cast<uint8>(OldPhase);
+		Event->Arg1 = static_cast<uint8>(NewPhase);
+	}
+
 	// Handle phase-specific logic
 	switch (NewPhase)
 	{
@@ -1432,14 +2292,16 @@ void UCombatComponentV2::SetPhase(EAttackPhase NewPhase)
 
 			if (GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 PHASE] Recovery entered - Commit window cleared"));
+				COMBAT_LOG(Log, TEXT("[V2 PHASE] Recovery entered - Commit window cleared"));
 			}
 			break;
 
 		case EAttackPhase::None:
 			// Attack finished - reset combo state for next attack
+			StopAttackTiming();
+			MontageClock.Stop();
 			CurrentAttackData = nullptr;
-			CurrentAttackInputType = EInputType::None;
+			HotState.CurrentAttackInputType = EInputType::None;
 
 			// CRITICAL: Clear hold state completely (ease timer, flags, movement)
 			// This prevents hold state leaking into next attack
@@ -1447,7 +2309,7 @@ void UCombatComponentV2::SetPhase(EAttackPhase NewPhase)
 
 			if (GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 PHASE] Attack finished - Combo state and hold state cleared"));
+				COMBAT_LOG(Log, TEXT("[V2 PHASE] Attack finished - Combo state and hold state cleared"));
 			}
 			break;
 
@@ -1455,19 +2317,227 @@ void UCombatComponentV2::SetPhase(EAttackPhase NewPhase)
 			break;
 	}
 }
+// ============================================================================
+// SCHEDULED ATTACK TIMING
+// ============================================================================
+
+void UCombatComponentV2::StartAttackTiming(UAttackData* Attack)
+{
+	StopAttackTiming();
+
+	if (!bScheduleAttackTiming || !Attack || !Attack->AttackMontage)
+	{
+		return;
+	}
+
+	// Sections that play on into the next one would also cross that section's notifies
+	if (!Attack->MontageSection.IsNone() && !Attack->bUseSectionOnly)
+	{
+		return;
+	}
+
+	FAttackTimingCache Scratch;
+	const FAttackTimingCache& Timing = Attack->GetTimingCache(Scratch);
+	if (!Timing.bHasValidNotifyTiming || Timing.ActiveTransitionTime < 0.0f || Timing.RecoveryTransitionTime < 0.0f)
+	{
+		return;
+	}
+
+	UAnimInstance* AnimInstance = OwnerCharacter && OwnerCharacter->GetMesh() ? OwnerCharacter->GetMesh()->GetAnimInstance() : nullptr;
+	if (!AnimInstance)
+	{
+		return;
+	}
+
+	// Everything at or behind the current position has already been applied (Windup on start, catch-up on reconcile)
+	const float Position = AnimInstance->Montage_GetPosition(Attack->AttackMontage);
+
+	AttackTimingEvents.Add({ Timing.ActiveTransitionTime, EAttackPhase::Active });
+	AttackTimingEvents.Add({ Timing.RecoveryTransitionTime, EAttackPhase::Recovery });
+	for (const FTimerCheckpoint& Window : Timing.Windows)
+	{
+		AttackTimingEvents.Add({ Window.MontageTime, EAttackPhase::None, Window.WindowType });
+	}
+	AttackTimingEvents.StableSort([](const FAttackTimingEvent& A, const FAttackTimingEvent& B) { return A.MontageTime < B.MontageTime; });
+	AttackTimingEvents.RemoveAll([Position](const FAttackTimingEvent& Event) { return Event.MontageTime < Position; });
+
+	if (AttackTimingEvents.Num() == 0)
+	{
+		return;
+	}
+
+	AttackTimingMontage = Attack->AttackMontage;
+	++AttackTimingSerial;
+	RescheduleAttackTiming();
+
+	if (GetDebugDraw())
+	{
+		COMBAT_LOG(Log, TEXT("[V2 TIMING] Scheduled %d boundaries for %s (notifies ignored)"), AttackTimingEvents.Num(), *Attack->GetName());
+	}
+}
+
+void UCombatComponentV2::StopAttackTiming()
+{
+	if (UCombatTimerWheelSubsystem* TimerWheel = GetWorld() ? GetWorld()->GetSubsystem<UCombatTimerWheelSubsystem>() : nullptr)
+	{
+		TimerWheel->ClearTimer(AttackTimingTimer);
+	}
+
+	AttackTimingEvents.Reset();
+	NextAttackTimingEvent = 0;
+	AttackTimingMontage.Reset();
+	++AttackTimingSerial;
+}
+
+void UCombatComponentV2::RescheduleAttackTiming()
+{
+	if (!AttackTimingEvents.IsValidIndex(NextAttackTimingEvent))
+	{
+		return;
+	}
+
+	UCombatTimerWheelSubsystem* TimerWheel = GetWorld() ? GetWorld()->GetSubsystem<UCombatTimerWheelSubsystem>() : nullptr;
+	if (!TimerWheel)
+	{
+		return;
+	}
+
+	// Frozen hold: nothing to arm, the playrate change that resumes it reschedules
+	const float Delay = MontageClock.GetTimeUntil(AttackTimingEvents[NextAttackTimingEvent].MontageTime, GetWorld()->GetTimeSeconds());
+	if (Delay < 0.0f)
+	{
+		TimerWheel->ClearTimer(AttackTimingTimer);
+		return;
+	}
+
+	TimerWheel->SetTimer<&UCombatComponentV2::OnAttackTimingTimer>(AttackTimingTimer, this, Delay);
+}
+
+void UCombatComponentV2::SyncMontageClock()
+{
+	UAnimInstance* AnimInstance = OwnerCharacter && OwnerCharacter->GetMesh() ? OwnerCharacter->GetMesh()->GetAnimInstance() : nullptr;
+	UAnimMontage* Montage = CurrentAttackData ? CurrentAttackData->AttackMontage.Get() : nullptr;
+	if (!AnimInstance || !Montage || !GetWorld())
+	{
+		MontageClock.Stop();
+		return;
+	}
+
+	MontageClock.Rebase(GetWorld()->GetTimeSeconds(), AnimInstance->Montage_GetPosition(Montage),
+		GetPendingMontagePlayRate(AnimInstance, Montage) * Montage->RateScale);
+}
+
+void UCombatComponentV2::OnMontagePlayRateChanged()
+{
+	SyncMontageClock();
+	RescheduleAttackTiming();
+}
+
+float UCombatComponentV2::GetPendingMontagePlayRate(UAnimInstance* AnimInstance, UAnimMontage* Montage) const
+{
+	// The arbiter only drives the active montage, and applies after the component ticks
+	const UPlayRateEasingSubsystem* Arbiter = GetPlayRateArbiter();
+	if (Arbiter && Montage == AnimInstance->GetCurrentActiveMontage())
+	{
+		return Arbiter->GetPlayRate(OwnerCharacter);
+	}
+
+	return AnimInstance->Montage_GetPlayRate(Montage);
+}
+
+UPlayRateEasingSubsystem* UCombatComponentV2::GetPlayRateArbiter() const
+{
+	return GetWorld() ? GetWorld()->GetSubsystem<UPlayRateEasingSubsystem>() : nullptr;
+}
+
+float UCombatComponentV2::GetTimeUntilCheckpoint(EActionWindowType WindowType) const
+{
+	const int32 Index = CheckpointIndexByType[static_cast<int32>(WindowType)];
+	if (Index == INDEX_NONE || !GetWorld())
+	{
+		return -1.0f;
+	}
+
+	return MontageClock.GetTimeUntil(Checkpoints[Index].MontageTime, GetWorld()->GetTimeSeconds());
+}
+
+void UCombatComponentV2::OnAttackTimingTimer()
+{
+	COMBAT_TRACE_SCOPE(UCombatComponentV2::OnAttackTimingTimer);
+
+	UAnimInstance* AnimInstance = OwnerCharacter && OwnerCharacter->GetMesh() ? OwnerCharacter->GetMesh()->GetAnimInstance() : nullptr;
+	UAnimMontage* Montage = AttackTimingMontage.Get();
+	const FAnimMontageInstance* MontageInstance = AnimInstance && Montage ? AnimInstance->GetActiveInstanceForMontage(Montage) : nullptr;
+	if (!MontageInstance || MontageInstance->IsStopped())
+	{
+		// Interrupted - the montage end path resets the phase
+		StopAttackTiming();
+		return;
+	}
+
+	// The wheel fires up to a tick late: apply every boundary crossed since, in order
+	// (re-anchoring the clock here too, so frame-quantized montage advance can't drift the next delay)
+	const float Position = AnimInstance->Montage_GetPosition(Montage);
+	MontageClock.Rebase(GetWorld()->GetTimeSeconds(), Position, GetPendingMontagePlayRate(AnimInstance, Montage) * Montage->RateScale);
+	const uint32 Serial = AttackTimingSerial;
+	while (AttackTimingEvents.IsValidIndex(NextAttackTimingEvent) && Position + UE_KINDA_SMALL_NUMBER >= AttackTimingEvents[NextAttackTimingEvent].MontageTime)
+	{
+		const FAttackTimingEvent Event = AttackTimingEvents[NextAttackTimingEvent++];
+		FireAttackTimingEvent(Event);
+
+		// The event started the next attack (queued action) or ended this one
+		if (Serial != AttackTimingSerial)
+		{
+			return;
+		}
+	}
+
+	RescheduleAttackTiming();
+}
+
+void UCombatComponentV2::FireAttackTimingEvent(const FAttackTimingEvent& Event)
+{
+	if (GetDebugDraw())
+	{
+		COMBAT_LOG(Log, TEXT("[V2 TIMING] %s at %.2f"),
+			Event.Phase != EAttackPhase::None ? *UEnum::GetValueAsString(Event.Phase) : *UEnum::GetValueAsString(Event.WindowType),
+			Event.MontageTime);
+	}
+
+	if (Event.Phase != EAttackPhase::None)
+	{
+		// Same receivers and order as ASamuraiCharacter::OnAttackPhaseTransition (V1 drives hit detection)
+		if (CombatComponent)
+		{
+			CombatComponent->OnAttackPhaseTransition(Event.Phase);
+		}
+		OnPhaseTransition(Event.Phase);
+		return;
+	}
+
+	// Window checkpoints were copied up front by DiscoverCheckpoints; only the opening itself has an effect
+	CombatTrace::OutputWindowEvent(GetOwner(), Event.WindowType, true, Event.MontageTime);
+	if (Event.WindowType == EActionWindowType::Cancel && HotState.CurrentPhase == EAttackPhase::Recovery)
+	{
+		ProcessQueuedActions(EAttackPhase::Recovery);
+	}
+}
+
 // TODO:: Consider adding OnPhaseEnter/Exit events for more granular control --> Also we know that active phase is when queued input actions can be executed so perhaps having phase specific logic for simple things like this would be prudent
 
 void UCombatComponentV2::OnMontageBlendingOut(UAnimMontage* Montage, bool bInterrupted)
 {
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 MONTAGE] Montage blending out: %s | Interrupted: %s"),
+		COMBAT_LOG(Log, TEXT("[V2 MONTAGE] Montage blending out: %s | Interrupted: %s"),
 			Montage ? *Montage->GetName() : TEXT("None"),
 			bInterrupted ? TEXT("YES") : TEXT("NO"));
 	}
 
 	// Broadcast montage event
-	OnMontageEvent.Broadcast(Montage, bInterrupted, FName("BlendingOut"));
+	static const FName BlendingOutEvent("BlendingOut");
+	OnMontageEventNative.Broadcast(Montage, bInterrupted, BlendingOutEvent);
+	OnMontageEvent.Broadcast(Montage, bInterrupted, BlendingOutEvent);
 
 	// Prepare for next attack during blend out (smoother transitions)
 	// Phase transition to None happens in OnMontageEnded
@@ -1476,15 +2546,19 @@ void UCombatComponentV2::OnMontageBlendingOut(UAnimMontage* Montage, bool bInter
 
 void UCombatComponentV2::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 {
+	COMBAT_TRACE_SCOPE(UCombatComponentV2::OnMontageEnded);
+
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 MONTAGE] Montage ended: %s | Interrupted: %s"),
+		COMBAT_LOG(Log, TEXT("[V2 MONTAGE] Montage ended: %s | Interrupted: %s"),
 			Montage ? *Montage->GetName() : TEXT("None"),
 			bInterrupted ? TEXT("YES") : TEXT("NO"));
 	}
 
 	// Broadcast montage event
-	OnMontageEvent.Broadcast(Montage, bInterrupted, FName("Ended"));
+	static const FName EndedEvent("Ended");
+	OnMontageEventNative.Broadcast(Montage, bInterrupted, EndedEvent);
+	OnMontageEvent.Broadcast(Montage, bInterrupted, EndedEvent);
 
 	// CRITICAL: Execute any pending queued actions BEFORE clearing state
 	// BUT only if their checkpoint was actually reached (ScheduledTime >= 0)
@@ -1493,7 +2567,7 @@ void UCombatComponentV2::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted
 	{
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Warning, TEXT("[V2 MONTAGE] Montage ended with %d queued actions - checking which are ready"), ActionQueue.Num());
+			COMBAT_LOG(Warning, TEXT("[V2 MONTAGE] Montage ended with %d queued actions - checking which are ready"), ActionQueue.Num());
 		}
 
 		// Get montage end time to check if actions reached their checkpoint
@@ -1507,9 +2581,11 @@ void UCombatComponentV2::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted
 		}
 
 		// Execute pending actions that reached their checkpoint
-		for (int32 i = ActionQueue.Num() - 1; i >= 0; --i)
+		FActionQueueHandle PrevHandle;
+		for (FActionQueueHandle Handle = ActionQueue.Last(); Handle.IsValid(); Handle = PrevHandle)
 		{
-			FActionQueueEntry& Entry = ActionQueue[i];
+			PrevHandle = ActionQueue.Prev(Handle);
+			FActionQueueEntry& Entry = ActionQueue.Get(Handle);
 
 			if (Entry.IsPending())
 			{
@@ -1519,12 +2595,13 @@ void UCombatComponentV2::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted
 				{
 					if (GetDebugDraw())
 					{
-						UE_LOG(LogCombat, Warning, TEXT("[V2 QUEUE] Discarding action (checkpoint never reached): Type=%s, ScheduledTime=%.2f"),
+						COMBAT_LOG(Warning, TEXT("[V2 QUEUE] Discarding action (checkpoint never reached): Type=%s, ScheduledTime=%.2f"),
 							*UEnum::GetValueAsString(Entry.InputAction.InputType), Entry.ScheduledTime);
 					}
 
 					// Discard action - checkpoint never happened
-					ActionQueue.RemoveAt(i);
+					CombatTrace::OutputQueueEvent(GetOwner(), CombatTrace::EQueueEvent::Cancelled, Entry.InputAction.InputType, Entry.ExecutionMode);
+					ActionQueue.Remove(Handle);
 					QueueStats.ActionsCancelled++;
 					continue;
 				}
@@ -1534,14 +2611,14 @@ void UCombatComponentV2::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted
 				{
 					if (GetDebugDraw())
 					{
-						UE_LOG(LogCombat, Log, TEXT("[V2 QUEUE] Executing action from ended montage: Type=%s, ScheduledTime=%.2f, MontageEndTime=%.2f"),
+						COMBAT_LOG(Log, TEXT("[V2 QUEUE] Executing action from ended montage: Type=%s, ScheduledTime=%.2f, MontageEndTime=%.2f"),
 							*UEnum::GetValueAsString(Entry.InputAction.InputType), Entry.ScheduledTime, MontageEndTime);
 					}
 
 					// Execute the pending action
 					if (ExecuteAction(Entry))
 					{
-						ActionQueue.RemoveAt(i);
+						ActionQueue.Remove(Handle);
 
 						QueueStats.ActionsExecuted++;
 
@@ -1553,12 +2630,13 @@ void UCombatComponentV2::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted
 				{
 					if (GetDebugDraw())
 					{
-						UE_LOG(LogCombat, Warning, TEXT("[V2 QUEUE] Discarding action (montage ended before checkpoint): Type=%s, ScheduledTime=%.2f, MontageEndTime=%.2f"),
+						COMBAT_LOG(Warning, TEXT("[V2 QUEUE] Discarding action (montage ended before checkpoint): Type=%s, ScheduledTime=%.2f, MontageEndTime=%.2f"),
 							*UEnum::GetValueAsString(Entry.InputAction.InputType), Entry.ScheduledTime, MontageEndTime);
 					}
 
 					// Discard action - montage ended before checkpoint
-					ActionQueue.RemoveAt(i);
+					CombatTrace::OutputQueueEvent(GetOwner(), CombatTrace::EQueueEvent::Cancelled, Entry.InputAction.InputType, Entry.ExecutionMode);
+					ActionQueue.Remove(Handle);
 					QueueStats.ActionsCancelled++;
 				}
 			}
@@ -1568,13 +2646,13 @@ void UCombatComponentV2::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted
 	// STRUCTURAL FIX: Only transition to None if NOT in combo blend
 	// When bInComboBlend=true, we're mid-transition and new montage will start soon
 	// This prevents phase desync: Windup → None → Active (old montage ending during blend-out)
-	if (!bInComboBlend && CurrentPhase != EAttackPhase::Windup && CurrentPhase != EAttackPhase::Active)
+	if (!HotState.bInComboBlend && HotState.CurrentPhase != EAttackPhase::Windup && HotState.CurrentPhase != EAttackPhase::Active)
 	{
 		SetPhase(EAttackPhase::None);
 	}
 
 	// Clear checkpoints for finished montage (new montage will have its own)
-	Checkpoints.Empty();
+	ResetCheckpoints();
 }
 
 //NOTE:: OnMontageEnded is where queued actions get a last chance to execute if their checkpoint was reached.
@@ -1587,7 +2665,7 @@ void UCombatComponentV2::UpdateMovementFromMontageState()
 {
 	// PROCEDURAL MOVEMENT SYNC: Automatically enable/disable movement based on current animation state
 	// This replaces manual DisableMovement/SetMovementMode calls scattered throughout the code
-	// Called from: TickComponent (every frame), PlayAttackMontage (new attack), OnEaseTimerTick (during transitions)
+	// Called from: TickComponent (every frame), PlayAttackMontage (new attack), OnEaseUpdated/OnEaseFinished (during transitions)
 
 	ASamuraiCharacter* Character = GetOwnerCharacter();
 	if (!Character)
@@ -1607,15 +2685,16 @@ void UCombatComponentV2::UpdateMovementFromMontageState()
 	// RULE 1: Lock during hold freeze (playrate < threshold)
 	if (HoldState.IsHolding())
 	{
-		// Query ACTUAL montage playrate (don't trust HoldState.CurrentPlayRate)
-		float CurrentPlayRate = UMontageUtilityLibrary::GetMontagePlayRate(Character);
+		// Query ACTUAL montage playrate (don't trust HoldState.CurrentPlayRate), pending arbiter writes included
+		const UPlayRateEasingSubsystem* Arbiter = GetPlayRateArbiter();
+		float CurrentPlayRate = Arbiter ? Arbiter->GetPlayRate(Character) : UMontageUtilityLibrary::GetMontagePlayRate(Character);
 		if (CurrentPlayRate < 0.5f)
 		{
 			bShouldLockMovement = true;
 
-			if (GetDebugDraw() && !bMovementCurrentlyDisabled)
+			if (GetDebugDraw() && !HotState.bMovementCurrentlyDisabled)
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 MOVEMENT] Locking movement - hold freeze (playrate=%.2f)"), CurrentPlayRate);
+				COMBAT_LOG(Log, TEXT("[V2 MOVEMENT] Locking movement - hold freeze (playrate=%.2f)"), CurrentPlayRate);
 			}
 		}
 	}
@@ -1625,33 +2704,33 @@ void UCombatComponentV2::UpdateMovementFromMontageState()
 	{
 		bShouldLockMovement = true;
 
-		if (GetDebugDraw() && !bMovementCurrentlyDisabled)
+		if (GetDebugDraw() && !HotState.bMovementCurrentlyDisabled)
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 MOVEMENT] Locking movement - ease-in to freeze"));
+			COMBAT_LOG(Log, TEXT("[V2 MOVEMENT] Locking movement - ease-in to freeze"));
 		}
 	}
 
 	// Apply movement state change if needed
-	if (bShouldLockMovement && !bMovementCurrentlyDisabled)
+	if (bShouldLockMovement && !HotState.bMovementCurrentlyDisabled)
 	{
 		// Need to disable movement
 		MovementComp->DisableMovement();
-		bMovementCurrentlyDisabled = true;
+		HotState.bMovementCurrentlyDisabled = true;
 
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 MOVEMENT] Movement DISABLED"));
+			COMBAT_LOG(Log, TEXT("[V2 MOVEMENT] Movement DISABLED"));
 		}
 	}
-	else if (!bShouldLockMovement && bMovementCurrentlyDisabled)
+	else if (!bShouldLockMovement && HotState.bMovementCurrentlyDisabled)
 	{
 		// Need to enable movement
 		MovementComp->SetMovementMode(MOVE_Walking);
-		bMovementCurrentlyDisabled = false;
+		HotState.bMovementCurrentlyDisabled = false;
 
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 MOVEMENT] Movement ENABLED"));
+			COMBAT_LOG(Log, TEXT("[V2 MOVEMENT] Movement ENABLED"));
 		}
 	}
 }
@@ -1661,14 +2740,14 @@ void UCombatComponentV2::ClearHoldState()
 	// CRITICAL: Complete hold state cleanup when starting new attack or on montage end
 	// Prevents state leaks between attacks
 
-	// Cancel any active ease timer
-	if (GetWorld() && EaseTimerHandle.IsValid())
+	// Cancel any active ease
+	if (EaseHandle.IsValid())
 	{
-		GetWorld()->GetTimerManager().ClearTimer(EaseTimerHandle);
+		CancelHoldEase();
 
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Ease timer cleared"));
+			COMBAT_LOG(Log, TEXT("[V2 HOLD] Hold ease cancelled"));
 		}
 	}
 
@@ -1677,9 +2756,14 @@ void UCombatComponentV2::ClearHoldState()
 	{
 		HoldState.Deactivate();
 
+		if (CombatComponent)
+		{
+			CombatComponent->EndChargeStages();
+		}
+
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Hold state cleared"));
+			COMBAT_LOG(Log, TEXT("[V2 HOLD] Hold state cleared"));
 		}
 	}
 
@@ -1687,16 +2771,18 @@ void UCombatComponentV2::ClearHoldState()
 	// This prevents blending artifacts when combo interrupts hold ease mid-transition
 	// Without this, new montage starts with wrong playrate (e.g., 0.75) causing "partial blend" visual issues
 	ASamuraiCharacter* Character = GetOwnerCharacter();
-	if (Character)
+	UPlayRateEasingSubsystem* Arbiter = GetPlayRateArbiter();
+	if (Character && Arbiter)
 	{
-		float CurrentPlayRate = UMontageUtilityLibrary::GetMontagePlayRate(Character);
+		float CurrentPlayRate = Arbiter->GetPlayRate(Character);
 		if (!FMath::IsNearlyEqual(CurrentPlayRate, 1.0f, 0.01f))
 		{
-			UMontageUtilityLibrary::SetMontagePlayRate(Character, 1.0f);
+			Arbiter->ClearPlayRates(Character);
+			OnMontagePlayRateChanged();
 
 			if (GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 HOLD] Playrate restored: %.2f → 1.0"), CurrentPlayRate);
+				COMBAT_LOG(Log, TEXT("[V2 HOLD] Playrate restored: %.2f → 1.0"), CurrentPlayRate);
 			}
 		}
 	}
@@ -1711,15 +2797,7 @@ void UCombatComponentV2::ClearHoldState()
 
 int32 UCombatComponentV2::GetPendingActionCount() const
 {
-	int32 Count = 0;
-	for (const FActionQueueEntry& Entry : ActionQueue)
-	{
-		if (Entry.IsPending())
-		{
-			Count++;
-		}
-	}
-	return Count;
+	return ActionQueue.CountInState(EActionState::Pending);
 }
 
 float UCombatComponentV2::GetHoldDuration() const
@@ -1744,16 +2822,25 @@ void UCombatComponentV2::DrawDebugInfo() const
 		return;
 	}
 
+	UCombatDebugDrawSubsystem* DebugDraw = UCombatDebugDrawSubsystem::Get(this);
+	if (!DebugDraw || !DebugDraw->ShouldDraw(Character))
+	{
+		return;
+	}
+
 	const FVector OwnerLocation = Character->GetActorLocation();
 	const FVector Offset = FVector(0, 0, 100);
 
 	// ============================================================================
 	// PHASE INDICATOR
 	// ============================================================================
-	FString PhaseInfo = FString::Printf(TEXT("Phase: %s"), *UEnum::GetValueAsString(CurrentPhase));
+	const FString& PhaseInfo = DebugPhaseText.Get(static_cast<uint32>(HotState.CurrentPhase), [this]()
+	{
+		return FString::Printf(TEXT("Phase: %s"), *UEnum::GetValueAsString(HotState.CurrentPhase));
+	});
 	FColor PhaseColor = FColor::White;
 
-	switch (CurrentPhase)
+	switch (HotState.CurrentPhase)
 	{
 		case EAttackPhase::Windup:
 			PhaseColor = FColor::Orange;
@@ -1769,74 +2856,114 @@ void UCombatComponentV2::DrawDebugInfo() const
 			break;
 	}
 
-	DrawDebugString(GetWorld(), OwnerLocation + Offset * 0.5f, PhaseInfo, nullptr, PhaseColor, 0.0f, true);
+	DebugDraw->AddString(Character, OwnerLocation + Offset * 0.5f, PhaseInfo, PhaseColor);
 
 	// ============================================================================
 	// QUEUE INFO
 	// ============================================================================
-	FString QueueInfo = FString::Printf(TEXT("V2 Queue: %d pending | %d total"),
-		GetPendingActionCount(),
-		ActionQueue.Num());
+	const int32 PendingCount = GetPendingActionCount();
+	const FString& QueueInfo = DebugQueueText.Get(HashCombineFast(GetTypeHash(PendingCount), GetTypeHash(ActionQueue.Num())), [this, PendingCount]()
+	{
+		return FString::Printf(TEXT("V2 Queue: %d pending | %d total"), PendingCount, ActionQueue.Num());
+	});
 
-	DrawDebugString(GetWorld(), OwnerLocation + Offset, QueueInfo, nullptr, FColor::Cyan, 0.0f, true);
+	DebugDraw->AddString(Character, OwnerLocation + Offset, QueueInfo, FColor::Cyan);
 
-	// Draw individual queued actions
-	int32 ActionIndex = 0;
-	for (const FActionQueueEntry& Entry : ActionQueue)
+	// Individual queued actions (the queue version bumps on every add/execute/cancel)
+	if (DebugActionTextsVersion != ActionQueue.GetVersion())
 	{
-		if (Entry.IsPending())
-		{
-			FString ActionInfo = FString::Printf(TEXT("  [%d] %s @ %.2f (%s)"),
-				ActionIndex++,
-				*UEnum::GetValueAsString(Entry.InputAction.InputType),
-				Entry.ScheduledTime,
-				*UEnum::GetValueAsString(Entry.ExecutionMode));
+		DebugActionTextsVersion = ActionQueue.GetVersion();
+		DebugActionTexts.Reset();
 
-			DrawDebugString(GetWorld(), OwnerLocation + Offset * (1.2f + ActionIndex * 0.3f), ActionInfo,
-				nullptr, FColor::Cyan, 0.0f, true);
+		for (const FActionQueueEntry& Entry : ActionQueue)
+		{
+			if (Entry.IsPending())
+			{
+				DebugActionTexts.Add(FString::Printf(TEXT("  [%d] %s @ %.2f (%s)"),
+					DebugActionTexts.Num(),
+					*UEnum::GetValueAsString(Entry.InputAction.InputType),
+					Entry.ScheduledTime,
+					*UEnum::GetValueAsString(Entry.ExecutionMode)));
+			}
 		}
 	}
 
+	for (int32 ActionIndex = 0; ActionIndex < DebugActionTexts.Num(); ++ActionIndex)
+	{
+		DebugDraw->AddString(Character, OwnerLocation + Offset * (1.2f + (ActionIndex + 1) * 0.3f), DebugActionTexts[ActionIndex], FColor::Cyan);
+	}
+
 	// ============================================================================
 	// HOLD STATE
 	// ============================================================================
 	if (HoldState.IsHolding())
 	{
-		FString HoldInfo = FString::Printf(TEXT("HOLDING: %s (%.2fs) [%s]"),
-			*UEnum::GetValueAsString(HoldState.GetHeldInputType()),
-			GetHoldDuration(),
-			HoldState.IsHoldCompleted() ? TEXT("COMPLETED") : TEXT("Incomplete"));
+		// Keyed on the displayed precision so the label changes at most every 10ms
+		const int32 HoldCentiseconds = FMath::RoundToInt(GetHoldDuration() * 100.0f);
+		const uint32 HoldHash = HashCombineFast(GetTypeHash(static_cast<uint8>(HoldState.GetHeldInputType())),
+			HashCombineFast(GetTypeHash(HoldCentiseconds), static_cast<uint32>(HoldState.IsHoldCompleted())));
+
+		const FString& HoldInfo = DebugHoldText.Get(HoldHash, [this, HoldCentiseconds]()
+		{
+			return FString::Printf(TEXT("HOLDING: %s (%.2fs) [%s]"),
+				*UEnum::GetValueAsString(HoldState.GetHeldInputType()),
+				HoldCentiseconds / 100.0f,
+				HoldState.IsHoldCompleted() ? TEXT("COMPLETED") : TEXT("Incomplete"));
+		});
 
-		DrawDebugString(GetWorld(), OwnerLocation + Offset * 2.5f, HoldInfo, nullptr, FColor::Yellow, 0.0f, true);
+		DebugDraw->AddString(Character, OwnerLocation + Offset * 2.5f, HoldInfo, FColor::Yellow);
 	}
 
 	// ============================================================================
 	// MOVEMENT STATE (Phase 1 Debug)
 	// ============================================================================
-	FString MovementState = bMovementCurrentlyDisabled ? TEXT("DISABLED") : TEXT("ENABLED");
-	FColor MovementColor = bMovementCurrentlyDisabled ? FColor::Red : FColor::Green;
+	const FString& MovementInfo = DebugMovementText.Get(static_cast<uint32>(HotState.bMovementCurrentlyDisabled), [this]()
+	{
+		return FString::Printf(TEXT("Movement: %s"), HotState.bMovementCurrentlyDisabled ? TEXT("DISABLED") : TEXT("ENABLED"));
+	});
+	const FColor MovementColor = HotState.bMovementCurrentlyDisabled ? FColor::Red : FColor::Green;
 
-	DrawDebugString(GetWorld(), OwnerLocation + Offset * 3.0f,
-		FString::Printf(TEXT("Movement: %s"), *MovementState),
-		nullptr, MovementColor, 0.0f, true);
+	DebugDraw->AddString(Character, OwnerLocation + Offset * 3.0f, MovementInfo, MovementColor);
 
 	// ============================================================================
 	// STATS
 	// ============================================================================
-	FString StatsInfo = FString::Printf(TEXT("Stats: %d executed (%d queued + %d immediate) | %d cancelled"),
-		QueueStats.ActionsExecuted,
-		QueueStats.QueuedExecutions,
-		QueueStats.ImmediateExecutions,
-		QueueStats.ActionsCancelled);
+	const uint32 StatsHash = HashCombineFast(
+		HashCombineFast(GetTypeHash(QueueStats.ActionsExecuted), GetTypeHash(QueueStats.QueuedExecutions)),
+		HashCombineFast(GetTypeHash(QueueStats.ImmediateExecutions), GetTypeHash(QueueStats.ActionsCancelled)));
+
+	const FString& StatsInfo = DebugStatsText.Get(StatsHash, [this]()
+	{
+		return FString::Printf(TEXT("Stats: %d executed (%d queued + %d immediate) | %d cancelled"),
+			QueueStats.ActionsExecuted,
+			QueueStats.QueuedExecutions,
+			QueueStats.ImmediateExecutions,
+			QueueStats.ActionsCancelled);
+	});
+
+	DebugDraw->AddString(Character, OwnerLocation + Offset * 3.0f, StatsInfo, FColor::White);
+
+	const uint32 LatencyHash = HashCombineFast(
+		HashCombineFast(GetTypeHash(QueueStats.ImmediateLatency.InputToExecute.P95Ms), GetTypeHash(QueueStats.ImmediateLatency.InputToFirstFrame.P95Ms)),
+		HashCombineFast(GetTypeHash(QueueStats.QueuedLatency.InputToExecute.P95Ms), GetTypeHash(QueueStats.QueuedLatency.InputToFirstFrame.P95Ms)));
+
+	const FString& LatencyInfo = DebugLatencyText.Get(LatencyHash, [this]()
+	{
+		return FString::Printf(TEXT("Latency p95: Immediate %.1fms (frame %.1fms) | Queued %.1fms (frame %.1fms)"),
+			QueueStats.ImmediateLatency.InputToExecute.P95Ms,
+			QueueStats.ImmediateLatency.InputToFirstFrame.P95Ms,
+			QueueStats.QueuedLatency.InputToExecute.P95Ms,
+			QueueStats.QueuedLatency.InputToFirstFrame.P95Ms);
+	});
 
-	DrawDebugString(GetWorld(), OwnerLocation + Offset * 3.0f, StatsInfo, nullptr, FColor::White, 0.0f, true);
+	DebugDraw->AddString(Character, OwnerLocation + Offset * 3.0f, LatencyInfo, FColor::White);
 
 	// ============================================================================
 	// CHECKPOINT TIMELINE (Visual)
 	// ============================================================================
 	if (Checkpoints.Num() > 0 && UMontageUtilityLibrary::GetCurrentMontageTime(Character) >= 0.0f)
 	{
-		// Draw visual timeline using MontageUtilityLibrary
+		// Draw visual timeline using MontageUtilityLibrary (queued on the same debug draw buffer)
 		UMontageUtilityLibrary::DrawCheckpointTimeline(
 			GetWorld(),
 			Character,
@@ -1857,15 +2984,18 @@ void UCombatComponentV2::DrawDebugInfo() const
 	// ============================================================================
 	// COMBO WINDOW INDICATOR
 	// ============================================================================
-	if (bComboWindowActive)
+	if (HotState.bComboWindowActive)
 	{
 		float CurrentTime = UMontageUtilityLibrary::GetCurrentMontageTime(Character);
-		float TimeRemaining = (ComboWindowStart + ComboWindowDuration) - CurrentTime;
+		float TimeRemaining = (HotState.ComboWindowStart + HotState.ComboWindowDuration) - CurrentTime;
+		const int32 RemainingCentiseconds = FMath::RoundToInt(FMath::Max(0.0f, TimeRemaining) * 100.0f);
 
-		FString ComboInfo = FString::Printf(TEXT("COMBO WINDOW: %.2fs remaining"),
-			FMath::Max(0.0f, TimeRemaining));
+		const FString& ComboInfo = DebugComboText.Get(GetTypeHash(RemainingCentiseconds), [RemainingCentiseconds]()
+		{
+			return FString::Printf(TEXT("COMBO WINDOW: %.2fs remaining"), RemainingCentiseconds / 100.0f);
+		});
 
-		DrawDebugString(GetWorld(), OwnerLocation + Offset * 3.5f, ComboInfo, nullptr, FColor::Green, 0.0f, true);
+		DebugDraw->AddString(Character, OwnerLocation + Offset * 3.5f, ComboInfo, FColor::Green);
 	}
 }
 
@@ -1880,7 +3010,7 @@ void UCombatComponentV2::ProcessInputPair(const FQueuedInputAction& PressEvent,
 
 	if ( GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 INPUT] Pair processed: %s held for %.2fs"),
+		COMBAT_LOG(Log, TEXT("[V2 INPUT] Pair processed: %s held for %.2fs"),
 			*UEnum::GetValueAsString(PressEvent.InputType),
 			HoldDuration);
 	}
@@ -1905,7 +3035,13 @@ EActionExecutionMode UCombatComponentV2::DetermineExecutionMode(const FQueuedInp
 
 	// During Windup or Active → Queue for Active end (cannot attack now)
 	// This gives "snappy" execution - input buffered during windup executes at Active end
-	if (CurrentPhase == EAttackPhase::Windup || CurrentPhase == EAttackPhase::Active)
+	if (HotState.CurrentPhase == EAttackPhase::Windup || HotState.CurrentPhase == EAttackPhase::Active)
+	{
+		return EActionExecutionMode::Queued;
+	}
+
+	// During Recovery before an authored cancel window → Queue until the window opens
+	if (HotState.CurrentPhase == EAttackPhase::Recovery && IsCancelWindowPending())
 	{
 		return EActionExecutionMode::Queued;
 	}
@@ -1917,6 +3053,13 @@ EActionExecutionMode UCombatComponentV2::DetermineExecutionMode(const FQueuedInp
 
 UAttackData* UCombatComponentV2::GetAttackForInput(EInputType InputType) const
 {
+	return ResolveAttackForInput(InputType, HotState.LastDirectionalInput, false);
+}
+
+UAttackData* UCombatComponentV2::ResolveAttackForInput(EInputType InputType, EInputDirection Direction, bool bInputInComboWindow) const
+{
+	COMBAT_TRACE_SCOPE(UCombatComponentV2::GetAttackForInput);
+
 	if (!CombatComponent)
 	{
 		return nullptr;
@@ -1928,19 +3071,19 @@ UAttackData* UCombatComponentV2::GetAttackForInput(EInputType InputType) const
 
 	// Determine if we should combo: Check combo window OR valid attack continuation
 	// This fixes combo progression for both queued AND immediate execution
-	bool bShouldCombo = bComboWindowActive;
+	bool bShouldCombo = HotState.bComboWindowActive || bInputInComboWindow;
 
 	// CRITICAL FIX: If we have CurrentAttackData and we're mid-attack (any phase except None),
 	// allow combo continuation even if combo window flag hasn't been set yet
 	// This handles rapid double-taps that queue input during Windup phase (before combo window opens)
-	if (!bShouldCombo && CurrentAttackData && CurrentPhase != EAttackPhase::None)
+	if (!bShouldCombo && CurrentAttackData && HotState.CurrentPhase != EAttackPhase::None)
 	{
 		bShouldCombo = true;
 
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 COMBO] Allowing combo from phase %s (CurrentAttack=%s)"),
-				*UEnum::GetValueAsString(CurrentPhase),
+			COMBAT_LOG(Log, TEXT("[V2 COMBO] Allowing combo from phase %s (CurrentAttack=%s)"),
+				*UEnum::GetValueAsString(HotState.CurrentPhase),
 				*CurrentAttackData->GetName());
 		}
 	}
@@ -1948,23 +3091,23 @@ UAttackData* UCombatComponentV2::GetAttackForInput(EInputType InputType) const
 	// Debug: Log combo resolution context
 	if (GetDebugDraw())
 	{
-		UE_LOG(LogCombat, Warning, TEXT("[V2 COMBO DEBUG] GetAttackForInput: Phase=%s, CurrentAttack=%s, ComboWindow=%s, bShouldCombo=%s"),
-			*UEnum::GetValueAsString(CurrentPhase),
+		COMBAT_LOG(Warning, TEXT("[V2 COMBO DEBUG] GetAttackForInput: Phase=%s, CurrentAttack=%s, ComboWindow=%s, bShouldCombo=%s"),
+			*UEnum::GetValueAsString(HotState.CurrentPhase),
 			CurrentAttackData ? *CurrentAttackData->GetName() : TEXT("nullptr"),
-			bComboWindowActive ? TEXT("ACTIVE") : TEXT("Inactive"),
+			HotState.bComboWindowActive ? TEXT("ACTIVE") : TEXT("Inactive"),
 			bShouldCombo ? TEXT("TRUE") : TEXT("FALSE"));
 	}
 
 	// Convert 8-way input direction to 4-way attack direction for follow-ups
 	EAttackDirection AttackDirection = EAttackDirection::None;
-	if (LastDirectionalInput != EInputDirection::None)
+	if (Direction != EInputDirection::None)
 	{
-		AttackDirection = CombatHelpers::InputToAttackDirection(LastDirectionalInput);
+		AttackDirection = CombatHelpers::InputToAttackDirection(Direction);
 
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 DIRECTIONAL] LastDirectionalInput=%s → AttackDirection=%s"),
-				*UEnum::GetValueAsString(LastDirectionalInput),
+			COMBAT_LOG(Log, TEXT("[V2 DIRECTIONAL] Direction=%s → AttackDirection=%s"),
+				*UEnum::GetValueAsString(Direction),
 				*UEnum::GetValueAsString(AttackDirection));
 		}
 	}
@@ -1973,21 +3116,56 @@ UAttackData* UCombatComponentV2::GetAttackForInput(EInputType InputType) const
 	// V2 CONTEXT-AWARE RESOLUTION (Phase 1)
 	// ========================================================================
 
-	// Clear visited set at start of resolution (cycle detection)
-	const_cast<UCombatComponentV2*>(this)->VisitedAttacks.Empty();
-
-	// Call V2 resolution with context awareness
-	FAttackResolutionResult Result = UMontageUtilityLibrary::ResolveNextAttack_V2(
-		CurrentAttackData,
-		InputType,
-		AttackDirection,
-		HoldState.IsHolding(),
-		bShouldCombo,
-		DefaultLightAttack,
-		DefaultHeavyAttack,
-		ActiveContextTags,  // NEW: Pass runtime context tags
-		const_cast<UCombatComponentV2*>(this)->VisitedAttacks  // NEW: Pass visited set for cycle detection
-	);
+	FAttackResolutionResult Result;
+
+	// PRIORITY 1: Context-sensitive attacks against the cached context bitmask
+	// (not part of the compiled graph - context changes at runtime)
+	Result = UMontageUtilityLibrary::ResolveContextAttack(
+		CurrentAttackData, InputType, DefaultLightAttack, DefaultHeavyAttack, GetActiveContextMask(), ActiveContextTags);
+
+	// Fast path: precompiled transition table (cycles already rejected at build time)
+	int32 ComboNode = INDEX_NONE;
+	if (Result.Attack)
+	{
+		// Resolved by context - skip combo resolution
+	}
+	else if (bUseCompiledComboGraph)
+	{
+		if (!ComboGraph.IsBuiltFor(DefaultLightAttack, DefaultHeavyAttack))
+		{
+			const_cast<UCombatComponentV2*>(this)->RebuildComboGraph();
+		}
+		ComboNode = ComboGraph.FindNode(CurrentAttackData);
+	}
+
+	if (Result.Attack)
+	{
+		// Context variant already resolved
+	}
+	else if (ComboNode != INDEX_NONE)
+	{
+		Result = ComboGraph.Resolve(ComboNode, InputType, AttackDirection, HoldState.IsHolding(), bShouldCombo);
+	}
+	else
+	{
+		// Clear visited set at start of resolution (cycle detection)
+		const_cast<UCombatComponentV2*>(this)->VisitedAttacks.Empty();
+
+		// Call V2 resolution with context awareness
+		Result = UMontageUtilityLibrary::ResolveNextAttack_V2(
+			CurrentAttackData,
+			InputType,
+			AttackDirection,
+			HoldState.IsHolding(),
+			bShouldCombo,
+			DefaultLightAttack,
+			DefaultHeavyAttack,
+			FGameplayTagContainer::EmptyContainer,  // Priority 1 already checked above with the cached mask
+			const_cast<UCombatComponentV2*>(this)->VisitedAttacks  // NEW: Pass visited set for cycle detection
+		);
+	}
+
+	CombatTrace::OutputAttackResolved(GetOwner(), InputType, AttackDirection, HoldState.IsHolding(), bShouldCombo, Result.Path, Result.Attack);
 
 	// Check for cycle detection error
 	if (Result.bCycleDetected)
@@ -2000,11 +3178,11 @@ UAttackData* UCombatComponentV2::GetAttackForInput(EInputType InputType) const
 	// This prevents directional follow-up loop bug
 	if (Result.bShouldClearDirectionalInput)
 	{
-		const_cast<UCombatComponentV2*>(this)->LastDirectionalInput = EInputDirection::None;
+		const_cast<UCombatComponentV2*>(this)->HotState.LastDirectionalInput = EInputDirection::None;
 
 		if (GetDebugDraw())
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] Clearing LastDirectionalInput (directional follow-up completed)"));
+			COMBAT_LOG(Log, TEXT("[V2 RESOLVE] Clearing LastDirectionalInput (directional follow-up completed)"));
 		}
 	}
 
@@ -2022,7 +3200,7 @@ UAttackData* UCombatComponentV2::GetAttackForInput(EInputType InputType) const
 			case EResolutionPath::ContextSensitive: PathName = TEXT("ContextSensitive"); break;
 		}
 
-		UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] ✓ Resolved to: '%s' (Path=%s, ClearInput=%s)"),
+		COMBAT_LOG(Log, TEXT("[V2 RESOLVE] ✓ Resolved to: '%s' (Path=%s, ClearInput=%s)"),
 			*Result.Attack->GetName(),
 			PathName,
 			Result.bShouldClearDirectionalInput ? TEXT("YES") : TEXT("NO"));
@@ -2030,7 +3208,7 @@ UAttackData* UCombatComponentV2::GetAttackForInput(EInputType InputType) const
 
 	// DEPRECATED: bCurrentAttackIsDirectionalFollowUp flag no longer needed with proper clear signal
 	// Keeping for now for backward compatibility, but will be removed in Phase 2
-	const_cast<UCombatComponentV2*>(this)->bCurrentAttackIsDirectionalFollowUp =
+	const_cast<UCombatComponentV2*>(this)->HotState.bCurrentAttackIsDirectionalFollowUp =
 		(Result.Path == EResolutionPath::DirectionalFollowUp);
 
 	return Result.Attack;
@@ -2063,28 +3241,84 @@ int32 UCombatComponentV2::CalculatePriority(const FActionQueueEntry& Action) con
 	}
 }
 
-void UCombatComponentV2::SortQueueByTime()
+FTimerCheckpoint* UCombatComponentV2::FindCheckpoint(EActionWindowType WindowType)
+{
+	const int32 Index = CheckpointIndexByType[static_cast<int32>(WindowType)];
+	return Index != INDEX_NONE ? &Checkpoints[Index] : nullptr;
+}
+
+float UCombatComponentV2::GetCancelWindowStart() const
+{
+	const int32 Index = CheckpointIndexByType[static_cast<int32>(EActionWindowType::Cancel)];
+	return Index != INDEX_NONE ? Checkpoints[Index].MontageTime : -1.0f;
+}
+
+bool UCombatComponentV2::IsCancelWindowPending() const
+{
+	const float CancelWindowStart = GetCancelWindowStart();
+	if (CancelWindowStart < 0.0f)
+	{
+		return false;
+	}
+
+	const float MontageTime = UMontageUtilityLibrary::GetCurrentMontageTime(OwnerCharacter);
+	return MontageTime >= 0.0f && MontageTime < CancelWindowStart;
+}
+
+bool UCombatComponentV2::IsInCancelWindow() const
 {
-	ActionQueue.Sort([](const FActionQueueEntry& A, const FActionQueueEntry& B)
+	const int32 Index = CheckpointIndexByType[static_cast<int32>(EActionWindowType::Cancel)];
+	if (Index == INDEX_NONE)
 	{
-		return A.ScheduledTime < B.ScheduledTime;
-	});
+		return false;
+	}
+
+	const FTimerCheckpoint& Checkpoint = Checkpoints[Index];
+	return UMontageUtilityLibrary::IsTimeInWindow(UMontageUtilityLibrary::GetCurrentMontageTime(OwnerCharacter), Checkpoint.MontageTime, Checkpoint.Duration);
 }
 
-FTimerCheckpoint* UCombatComponentV2::FindCheckpoint(EActionWindowType WindowType)
+void UCombatComponentV2::ResetCheckpoints()
+{
+	Checkpoints.Reset();
+	ActiveEndCheckpointTime = -1.0f;
+	RebuildCheckpointIndex();
+	++CheckpointLayoutVersion;
+	++DebugStateVersion;
+}
+
+void UCombatComponentV2::RebuildCheckpointIndex()
 {
-	for (FTimerCheckpoint& Checkpoint : Checkpoints)
+	for (int32& Index : CheckpointIndexByType)
+	{
+		Index = INDEX_NONE;
+	}
+	NextCheckpointExpiry = MAX_flt;
+
+	for (int32 i = 0; i < Checkpoints.Num(); ++i)
 	{
-		if (Checkpoint.WindowType == WindowType && Checkpoint.bActive)
+		const FTimerCheckpoint& Checkpoint = Checkpoints[i];
+		if (!Checkpoint.bActive)
+		{
+			continue;
+		}
+
+		int32& TypeIndex = CheckpointIndexByType[static_cast<int32>(Checkpoint.WindowType)];
+		if (TypeIndex == INDEX_NONE)
 		{
-			return &Checkpoint;
+			TypeIndex = i;
 		}
+		NextCheckpointExpiry = FMath::Min(NextCheckpointExpiry, Checkpoint.MontageTime + Checkpoint.Duration);
 	}
-	return nullptr;
 }
 
 void UCombatComponentV2::ClearExpiredCheckpoints(float CurrentTime)
 {
+	// Nothing can expire before the earliest window end
+	if (CurrentTime <= NextCheckpointExpiry)
+	{
+		return;
+	}
+
 	for (int32 i = Checkpoints.Num() - 1; i >= 0; --i)
 	{
 		FTimerCheckpoint& Checkpoint = Checkpoints[i];
@@ -2092,23 +3326,58 @@ void UCombatComponentV2::ClearExpiredCheckpoints(float CurrentTime)
 		if (Checkpoint.bActive && CurrentTime > (Checkpoint.MontageTime + Checkpoint.Duration))
 		{
 			Checkpoint.bActive = false;
+			CombatTrace::OutputWindowEvent(GetOwner(), Checkpoint.WindowType, false, CurrentTime);
 
 			// Update combo window state if this was combo checkpoint
 			if (Checkpoint.WindowType == EActionWindowType::Combo)
 			{
-				bComboWindowActive = false;
+				HotState.bComboWindowActive = false;
 			}
 
 			if ( GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Log, TEXT("[V2 CHECKPOINTS] Expired: Type=%s at %.2f"),
+				COMBAT_LOG(Log, TEXT("[V2 CHECKPOINTS] Expired: Type=%s at %.2f"),
 					*UEnum::GetValueAsString(Checkpoint.WindowType),
 					CurrentTime);
 			}
 
 			Checkpoints.RemoveAt(i);
+			++CheckpointLayoutVersion;
+			++DebugStateVersion;
 		}
 	}
+
+	RebuildCheckpointIndex();
+}
+
+bool UCombatComponentV2::TryCoalesceInput(EInputType InputType)
+{
+	// Mask is only trusted while nothing that could change the answer has happened
+	if (CoalescePhase != HotState.CurrentPhase || CoalesceQueueVersion != ActionQueue.GetVersion())
+	{
+		CoalescedInputMask = 0;
+		return false;
+	}
+
+	if ((CoalescedInputMask & (1u << static_cast<uint8>(InputType))) == 0)
+	{
+		return false;
+	}
+
+	QueueStats.CoalescedInputs++;
+	return true;
+}
+
+void UCombatComponentV2::MarkInputCoalesced(EInputType InputType)
+{
+	if (CoalescePhase != HotState.CurrentPhase || CoalesceQueueVersion != ActionQueue.GetVersion())
+	{
+		CoalescedInputMask = 0;
+		CoalescePhase = HotState.CurrentPhase;
+		CoalesceQueueVersion = ActionQueue.GetVersion();
+	}
+
+	CoalescedInputMask |= 1u << static_cast<uint8>(InputType);
 }
 
 bool UCombatComponentV2::CanAcceptNewInput(EInputType InputType) const
@@ -2124,7 +3393,7 @@ bool UCombatComponentV2::CanAcceptNewInput(EInputType InputType) const
 		{
 			if (GetDebugDraw())
 			{
-				UE_LOG(LogCombat, Warning, TEXT("[V2 INPUT] Input REJECTED - Already queued action of same type"));
+				COMBAT_LOG(Warning, TEXT("[V2 INPUT] Input REJECTED - Already queued action of same type"));
 			}
 			return false;
 		}
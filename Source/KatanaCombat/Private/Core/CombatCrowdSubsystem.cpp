@@ -0,0 +1,500 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatCrowdSubsystem.h"
+#include "Core/CombatComponent.h"
+#include "Characters/SamuraiCharacter.h"
+#include "Data/AttackData.h"
+#include "Debug/CombatTrace.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("CrowdSimulation"), STAT_Combat_CrowdSimulation, STATGROUP_KatanaCombat);
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatCrowdSubsystem::Deinitialize()
+{
+    for (const TWeakObjectPtr<ASamuraiCharacter>& Promoted : PromotedActors)
+    {
+        if (ASamuraiCharacter* Actor = Promoted.Get())
+        {
+            Actor->Destroy();
+        }
+    }
+
+    if (RepresentationActor)
+    {
+        RepresentationActor->Destroy();
+        RepresentationActor = nullptr;
+    }
+
+    ProxyMeshes.Empty();
+    Archetypes.Empty();
+    AgentIds.Empty();
+    PromotedActors.Empty();
+    IdToIndex.Empty();
+
+    Super::Deinitialize();
+}
+
+void UCombatCrowdSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SCOPE_CYCLE_COUNTER(STAT_Combat_CrowdSimulation);
+    COMBAT_CSV_SCOPE(CrowdSimulation);
+
+    const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+    const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+
+    TimeUntilTargetRefresh -= DeltaTime;
+    if (TimeUntilTargetRefresh <= 0.0f)
+    {
+        TimeUntilTargetRefresh = TargetRefreshInterval;
+        UpdateTargets();
+    }
+
+    UpdateCombat(DeltaTime);
+    UpdatePromotion(PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector, PlayerPawn != nullptr);
+    FlushRemovals();
+    UpdateRepresentation();
+}
+
+bool UCombatCrowdSubsystem::IsTickable() const
+{
+    return AgentIds.Num() > 0 || PendingRemovals.Num() > 0;
+}
+
+TStatId UCombatCrowdSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatCrowdSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================================
+// AGENTS
+// ============================================================================
+
+int32 UCombatCrowdSubsystem::RegisterArchetype(const FCombatCrowdArchetype& Archetype)
+{
+    const int32 ArchetypeIndex = Archetypes.Add(Archetype);
+
+    TimingOffsets.Add(TimingTable.Num());
+    TimingCounts.Add(Archetype.Attacks.Num());
+    for (const UAttackData* Attack : Archetype.Attacks)
+    {
+        TimingTable.Add(BakeAttackTiming(Attack));
+    }
+
+    ProxyMeshes.Add(nullptr);
+    return ArchetypeIndex;
+}
+
+int32 UCombatCrowdSubsystem::SpawnAgent(int32 ArchetypeIndex, const FTransform& Transform, uint8 Team)
+{
+    if (!Archetypes.IsValidIndex(ArchetypeIndex))
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 AgentId = IdToIndex.Add(AgentIds.Num());
+
+    AgentIds.Add(AgentId);
+    ArchetypeIndices.Add(ArchetypeIndex);
+    Teams.Add(Team);
+    Locations.Add(Transform.GetLocation());
+    Yaws.Add(Transform.Rotator().Yaw);
+    Phases.Add(EAttackPhase::None);
+    PhaseTimers.Add(0.0f);
+    CooldownTimers.Add(0.0f);
+    ComboSteps.Add(0);
+    Postures.Add(Archetypes[ArchetypeIndex].MaxPosture);
+    TargetIds.Add(INDEX_NONE);
+    PromotedActors.AddDefaulted();
+
+    // Pick a target on the next tick rather than waiting out the refresh interval
+    TimeUntilTargetRefresh = 0.0f;
+
+    return AgentId;
+}
+
+void UCombatCrowdSubsystem::SpawnAgentsInRadius(int32 ArchetypeIndex, const FVector& Center, float Radius, int32 Count, uint8 Team)
+{
+    // Golden-angle spiral: even coverage without overlapping spawns
+    const float GoldenAngle = PI * (3.0f - FMath::Sqrt(5.0f));
+
+    for (int32 i = 0; i < Count; ++i)
+    {
+        const float Distance = Radius * FMath::Sqrt((i + 0.5f) / Count);
+        const float Angle = i * GoldenAngle;
+        const FVector Location = Center + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0f);
+        const FRotator Facing = (Center - Location).Rotation();
+
+        SpawnAgent(ArchetypeIndex, FTransform(FRotator(0.0f, Facing.Yaw, 0.0f), Location), Team);
+    }
+}
+
+void UCombatCrowdSubsystem::RemoveAgent(int32 AgentId)
+{
+    if (IsValidAgent(AgentId))
+    {
+        PendingRemovals.AddUnique(AgentId);
+    }
+}
+
+int32 UCombatCrowdSubsystem::GetAgentIndex(int32 AgentId) const
+{
+    return IdToIndex.IsValidIndex(AgentId) ? IdToIndex[AgentId] : INDEX_NONE;
+}
+
+EAttackPhase UCombatCrowdSubsystem::GetAgentPhase(int32 AgentId) const
+{
+    const int32 Index = GetAgentIndex(AgentId);
+    return Index != INDEX_NONE ? Phases[Index] : EAttackPhase::None;
+}
+
+float UCombatCrowdSubsystem::GetAgentPosture(int32 AgentId) const
+{
+    const int32 Index = GetAgentIndex(AgentId);
+    return Index != INDEX_NONE ? Postures[Index] : 0.0f;
+}
+
+FVector UCombatCrowdSubsystem::GetAgentLocation(int32 AgentId) const
+{
+    const int32 Index = GetAgentIndex(AgentId);
+    return Index != INDEX_NONE ? Locations[Index] : FVector::ZeroVector;
+}
+
+ASamuraiCharacter* UCombatCrowdSubsystem::GetPromotedActor(int32 AgentId) const
+{
+    const int32 Index = GetAgentIndex(AgentId);
+    return Index != INDEX_NONE ? PromotedActors[Index].Get() : nullptr;
+}
+
+const FCombatCrowdAttackTiming* UCombatCrowdSubsystem::GetAttackTiming(int32 ArchetypeIndex, int32 AttackIndex) const
+{
+    if (!TimingOffsets.IsValidIndex(ArchetypeIndex) || AttackIndex < 0 || AttackIndex >= TimingCounts[ArchetypeIndex])
+    {
+        return nullptr;
+    }
+
+    return &TimingTable[TimingOffsets[ArchetypeIndex] + AttackIndex];
+}
+
+FCombatCrowdAttackTiming UCombatCrowdSubsystem::BakeAttackTiming(const UAttackData* Attack)
+{
+    return FCombatSimCore::CookAttackTiming(Attack);
+}
+
+// ============================================================================
+// PASSES
+// ============================================================================
+
+void UCombatCrowdSubsystem::UpdateTargets()
+{
+    const int32 NumAgents = AgentIds.Num();
+    const float SearchRadiusSq = FMath::Square(TargetSearchRadius);
+
+    // Brute force over packed locations: cheap for a few hundred agents at this refresh rate
+    for (int32 i = 0; i < NumAgents; ++i)
+    {
+        // Keep fighting whoever we're mid-swing against
+        if (Phases[i] != EAttackPhase::None && GetAgentIndex(TargetIds[i]) != INDEX_NONE)
+        {
+            continue;
+        }
+
+        int32 BestIndex = INDEX_NONE;
+        float BestDistSq = SearchRadiusSq;
+        const FVector& Location = Locations[i];
+        const uint8 Team = Teams[i];
+
+        for (int32 j = 0; j < NumAgents; ++j)
+        {
+            if (Teams[j] == Team)
+            {
+                continue;
+            }
+
+            const float DistSq = FVector::DistSquared2D(Location, Locations[j]);
+            if (DistSq < BestDistSq)
+            {
+                BestDistSq = DistSq;
+                BestIndex = j;
+            }
+        }
+
+        TargetIds[i] = BestIndex != INDEX_NONE ? AgentIds[BestIndex] : INDEX_NONE;
+    }
+}
+
+void UCombatCrowdSubsystem::UpdateCombat(float DeltaTime)
+{
+    const int32 NumAgents = AgentIds.Num();
+
+    for (int32 i = 0; i < NumAgents; ++i)
+    {
+        // Promoted agents are driven by their actor
+        if (PromotedActors[i].IsValid())
+        {
+            continue;
+        }
+
+        const FCombatCrowdArchetype& Archetype = Archetypes[ArchetypeIndices[i]];
+        const int32 TargetIndex = GetAgentIndex(TargetIds[i]);
+
+        CooldownTimers[i] -= DeltaTime;
+
+        if (Phases[i] == EAttackPhase::None)
+        {
+            Postures[i] = FMath::Min(Postures[i] + Archetype.PostureRegenRate * DeltaTime, Archetype.MaxPosture);
+
+            if (TargetIndex == INDEX_NONE)
+            {
+                continue;
+            }
+
+            const FVector ToTarget = (Locations[TargetIndex] - Locations[i]) * FVector(1.0f, 1.0f, 0.0f);
+            const float Distance = ToTarget.Size();
+            if (Distance > KINDA_SMALL_NUMBER)
+            {
+                Yaws[i] = ToTarget.Rotation().Yaw;
+            }
+
+            // Close in, then swing once the cooldown is up
+            if (Distance > Archetype.AttackRange)
+            {
+                const float Step = FMath::Min(Archetype.MoveSpeed * DeltaTime, Distance - Archetype.AttackRange);
+                Locations[i] += ToTarget / Distance * Step;
+            }
+            else if (CooldownTimers[i] <= 0.0f && TimingCounts[ArchetypeIndices[i]] > 0)
+            {
+                Phases[i] = EAttackPhase::Windup;
+                PhaseTimers[i] = GetAttackTiming(ArchetypeIndices[i], ComboSteps[i] % TimingCounts[ArchetypeIndices[i]])->Windup;
+            }
+            continue;
+        }
+
+        const FCombatCrowdAttackTiming& Timing = *GetAttackTiming(ArchetypeIndices[i], ComboSteps[i] % TimingCounts[ArchetypeIndices[i]]);
+        if (!FCombatSimCore::AdvancePhase(Phases[i], PhaseTimers[i], Timing, DeltaTime))
+        {
+            continue;
+        }
+
+        switch (Phases[i])
+        {
+            case EAttackPhase::Active:
+                // Resolve the swing as it goes active; promoted targets take hits through their own actor
+                if (TargetIndex != INDEX_NONE && !PromotedActors[TargetIndex].IsValid()
+                    && FVector::DistSquared2D(Locations[i], Locations[TargetIndex]) <= FMath::Square(Archetype.AttackRange * 1.2f))
+                {
+                    Postures[TargetIndex] -= Timing.PostureDamage;
+                    if (Postures[TargetIndex] <= 0.0f)
+                    {
+                        RemoveAgent(AgentIds[TargetIndex]);
+                    }
+                }
+                break;
+
+            case EAttackPhase::None:
+                CooldownTimers[i] = Archetype.AttackCooldown;
+                ++ComboSteps[i];
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+void UCombatCrowdSubsystem::UpdatePromotion(const FVector& PlayerLocation, bool bHasPlayer)
+{
+    const float PromoteRadiusSq = FMath::Square(PromoteRadius);
+    const float DemoteRadiusSq = FMath::Square(FMath::Max(DemoteRadius, PromoteRadius));
+    const int32 NumAgents = AgentIds.Num();
+
+    for (int32 i = 0; i < NumAgents; ++i)
+    {
+        if (PromotedActors[i].IsValid())
+        {
+            ASamuraiCharacter* Actor = PromotedActors[i].Get();
+
+            // The actor was killed or destroyed by gameplay: the agent goes with it
+            if (Actor->IsActorBeingDestroyed())
+            {
+                RemoveAgent(AgentIds[i]);
+                continue;
+            }
+
+            Locations[i] = Actor->GetActorLocation();
+            Yaws[i] = Actor->GetActorRotation().Yaw;
+
+            if (!bHasPlayer || FVector::DistSquared(Locations[i], PlayerLocation) > DemoteRadiusSq)
+            {
+                DemoteAgent(i);
+            }
+        }
+        else if (!PromotedActors[i].IsExplicitlyNull())
+        {
+            // Actor went away underneath us (GC / level unload)
+            PromotedActors[i].Reset();
+            --NumPromoted;
+            RemoveAgent(AgentIds[i]);
+        }
+        else if (bHasPlayer && NumPromoted < MaxPromotedAgents && FVector::DistSquared(Locations[i], PlayerLocation) < PromoteRadiusSq)
+        {
+            PromoteAgent(i);
+        }
+    }
+}
+
+void UCombatCrowdSubsystem::PromoteAgent(int32 Index)
+{
+    const FCombatCrowdArchetype& Archetype = Archetypes[ArchetypeIndices[Index]];
+    if (!Archetype.PromotedClass)
+    {
+        return;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    const FTransform Transform(FRotator(0.0f, Yaws[Index], 0.0f), Locations[Index]);
+    ASamuraiCharacter* Actor = GetWorld()->SpawnActor<ASamuraiCharacter>(Archetype.PromotedClass, Transform, SpawnParams);
+    if (!Actor)
+    {
+        return;
+    }
+
+    if (!Actor->Controller)
+    {
+        Actor->SpawnDefaultController();
+    }
+
+    // Carry the simulated posture over as a fraction of the actor's own max
+    if (UCombatComponent* CombatComp = Actor->FindComponentByClass<UCombatComponent>())
+    {
+        const float LostFraction = 1.0f - FMath::Clamp(Postures[Index] / Archetype.MaxPosture, 0.0f, 1.0f);
+        if (LostFraction > 0.0f)
+        {
+            CombatComp->ApplyPostureDamage(LostFraction * CombatComp->GetMaxPosture());
+        }
+    }
+
+    PromotedActors[Index] = Actor;
+    Phases[Index] = EAttackPhase::None;
+    PhaseTimers[Index] = 0.0f;
+    ++NumPromoted;
+}
+
+void UCombatCrowdSubsystem::DemoteAgent(int32 Index)
+{
+    ASamuraiCharacter* Actor = PromotedActors[Index].Get();
+    const FCombatCrowdArchetype& Archetype = Archetypes[ArchetypeIndices[Index]];
+
+    if (const UCombatComponent* CombatComp = Actor->FindComponentByClass<UCombatComponent>())
+    {
+        Postures[Index] = CombatComp->GetPosturePercent() * Archetype.MaxPosture;
+    }
+
+    Actor->Destroy();
+    PromotedActors[Index] = nullptr;
+    Phases[Index] = EAttackPhase::None;
+    PhaseTimers[Index] = 0.0f;
+    --NumPromoted;
+}
+
+void UCombatCrowdSubsystem::FlushRemovals()
+{
+    for (const int32 AgentId : PendingRemovals)
+    {
+        const int32 Index = GetAgentIndex(AgentId);
+        if (Index == INDEX_NONE)
+        {
+            continue;
+        }
+
+        if (ASamuraiCharacter* Actor = PromotedActors[Index].Get())
+        {
+            Actor->Destroy();
+            --NumPromoted;
+        }
+
+        const int32 LastIndex = AgentIds.Num() - 1;
+        if (Index != LastIndex)
+        {
+            IdToIndex[AgentIds[LastIndex]] = Index;
+        }
+        IdToIndex[AgentId] = INDEX_NONE;
+
+        AgentIds.RemoveAtSwap(Index, EAllowShrinking::No);
+        ArchetypeIndices.RemoveAtSwap(Index, EAllowShrinking::No);
+        Teams.RemoveAtSwap(Index, EAllowShrinking::No);
+        Locations.RemoveAtSwap(Index, EAllowShrinking::No);
+        Yaws.RemoveAtSwap(Index, EAllowShrinking::No);
+        Phases.RemoveAtSwap(Index, EAllowShrinking::No);
+        PhaseTimers.RemoveAtSwap(Index, EAllowShrinking::No);
+        CooldownTimers.RemoveAtSwap(Index, EAllowShrinking::No);
+        ComboSteps.RemoveAtSwap(Index, EAllowShrinking::No);
+        Postures.RemoveAtSwap(Index, EAllowShrinking::No);
+        TargetIds.RemoveAtSwap(Index, EAllowShrinking::No);
+        PromotedActors.RemoveAtSwap(Index, EAllowShrinking::No);
+    }
+
+    PendingRemovals.Reset();
+}
+
+void UCombatCrowdSubsystem::UpdateRepresentation()
+{
+    for (int32 ArchetypeIndex = 0; ArchetypeIndex < Archetypes.Num(); ++ArchetypeIndex)
+    {
+        UStaticMesh* ProxyMesh = Archetypes[ArchetypeIndex].ProxyMesh;
+        if (!ProxyMesh)
+        {
+            continue;
+        }
+
+        TObjectPtr<UInstancedStaticMeshComponent>& InstancedMesh = ProxyMeshes[ArchetypeIndex];
+        if (!InstancedMesh)
+        {
+            if (!RepresentationActor)
+            {
+                FActorSpawnParameters SpawnParams;
+                SpawnParams.ObjectFlags |= RF_Transient;
+                RepresentationActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+                RepresentationActor->SetRootComponent(NewObject<USceneComponent>(RepresentationActor, TEXT("Root")));
+                RepresentationActor->GetRootComponent()->RegisterComponent();
+            }
+
+            InstancedMesh = NewObject<UInstancedStaticMeshComponent>(RepresentationActor);
+            InstancedMesh->SetStaticMesh(ProxyMesh);
+            InstancedMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+            InstancedMesh->SetupAttachment(RepresentationActor->GetRootComponent());
+            InstancedMesh->RegisterComponent();
+        }
+
+        TArray<FTransform> Transforms;
+        Transforms.Reserve(AgentIds.Num());
+        for (int32 i = 0; i < AgentIds.Num(); ++i)
+        {
+            if (ArchetypeIndices[i] == ArchetypeIndex && PromotedActors[i].IsExplicitlyNull())
+            {
+                Transforms.Emplace(FRotator(0.0f, Yaws[i], 0.0f), Locations[i]);
+            }
+        }
+
+        // Instance count only changes on spawn/removal/promotion; otherwise update in place
+        if (InstancedMesh->GetInstanceCount() != Transforms.Num())
+        {
+            InstancedMesh->ClearInstances();
+            InstancedMesh->AddInstances(Transforms, false, true);
+        }
+        else if (Transforms.Num() > 0)
+        {
+            InstancedMesh->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatDamageAggregatorSubsystem.h"
+#include "Core/HitReactionComponent.h"
+#include "Debug/CombatTrace.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatDamageAggregatorSubsystem::Deinitialize()
+{
+    PendingTargets.Empty();
+    FlushingTargets.Empty();
+
+    Super::Deinitialize();
+}
+
+bool UCombatDamageAggregatorSubsystem::IsTickable() const
+{
+    return PendingTargets.Num() > 0;
+}
+
+TStatId UCombatDamageAggregatorSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatDamageAggregatorSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatDamageAggregatorSubsystem::Tick(float DeltaTime)
+{
+    COMBAT_TRACE_SCOPE(UCombatDamageAggregatorSubsystem::Tick);
+
+    Super::Tick(DeltaTime);
+
+    FlushPendingHits();
+}
+
+// ============================================================================
+// REQUESTS
+// ============================================================================
+
+void UCombatDamageAggregatorSubsystem::QueueFlush(UHitReactionComponent* Target)
+{
+    if (Target)
+    {
+        PendingTargets.Add(Target);
+    }
+}
+
+void UCombatDamageAggregatorSubsystem::FlushPendingHits()
+{
+    // Reactions and listeners may land new hits - those wait for the next flush
+    Swap(FlushingTargets, PendingTargets);
+
+    for (const TWeakObjectPtr<UHitReactionComponent>& Target : FlushingTargets)
+    {
+        if (UHitReactionComponent* HitReaction = Target.Get())
+        {
+            HitReaction->FlushPendingHits();
+        }
+    }
+
+    FlushingTargets.Reset();
+}
@@ -0,0 +1,358 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatDuelSimulator.h"
+#include "Data/AttackData.h"
+#include "Data/AttackConfiguration.h"
+#include "Data/CompiledComboGraph.h"
+#include "Async/ParallelFor.h"
+#include "Math/RandomStream.h"
+
+namespace CombatDuelSimulator
+{
+    /** Heavy if rolled and available, else light (else heavy) */
+    int32 PickMove(int32 Light, int32 Heavy, bool bHeavy)
+    {
+        if (bHeavy && Heavy != INDEX_NONE)
+        {
+            return Heavy;
+        }
+        return Light != INDEX_NONE ? Light : Heavy;
+    }
+
+    /** Per-fighter host state the core doesn't own */
+    struct FFighterRuntime
+    {
+        float Health = 0.0f;
+        float NextDecision = 0.0f;
+        float BlockRemaining = 0.0f;
+
+        /** First index of this fighter's moves in the core's timing table */
+        int32 AttackOffset = 0;
+    };
+}
+
+// ============================================================================
+// MOVESET
+// ============================================================================
+
+FCombatDuelMoveset FCombatDuelMoveset::Cook(const UAttackConfiguration* Configuration)
+{
+    FCombatDuelMoveset Moveset;
+    if (!Configuration)
+    {
+        return Moveset;
+    }
+
+    // Same graph UCombatComponentV2 compiles - move i is graph node i + 1 (node 0 is the root)
+    FCompiledComboGraph Graph;
+    Graph.Build(Configuration->DefaultLightAttack, Configuration->DefaultHeavyAttack);
+
+    auto ToMove = [&Graph](const FAttackResolutionResult& Result)
+    {
+        const int32 Node = Graph.FindNode(Result.Attack);
+        return Node > FCompiledComboGraph::RootNode ? Node - 1 : INDEX_NONE;
+    };
+
+    Moveset.Moves.SetNum(FMath::Max(0, Graph.GetNumNodes() - 1));
+    for (int32 Node = 1; Node < Graph.GetNumNodes(); ++Node)
+    {
+        const UAttackData* Attack = Graph.GetNodeAttack(Node);
+        FCombatDuelMove& Move = Moveset.Moves[Node - 1];
+        Move.Timing = FCombatSimCore::CookAttackTiming(Attack);
+        Move.Damage = Attack ? Attack->BaseDamage : 0.0f;
+        Move.CounterDamageMultiplier = Attack ? Attack->CounterDamageMultiplier : 1.0f;
+        Move.NextLight = ToMove(Graph.Resolve(Node, EInputType::LightAttack, EAttackDirection::None, false, true));
+        Move.NextHeavy = ToMove(Graph.Resolve(Node, EInputType::HeavyAttack, EAttackDirection::None, false, true));
+    }
+
+    Moveset.RootLight = ToMove(Graph.Resolve(FCompiledComboGraph::RootNode, EInputType::LightAttack, EAttackDirection::None, false, false));
+    Moveset.RootHeavy = ToMove(Graph.Resolve(FCompiledComboGraph::RootNode, EInputType::HeavyAttack, EAttackDirection::None, false, false));
+    return Moveset;
+}
+
+// ============================================================================
+// DUELS
+// ============================================================================
+
+FCombatDuelResult FCombatDuelSimulator::RunDuel(const FCombatDuelParams& Params, int32 Seed)
+{
+    using namespace CombatDuelSimulator;
+
+    FCombatDuelResult Result;
+
+    FCombatSimCore Sim;
+    Sim.Config = Params.Config;
+    const float DeltaTime = Sim.Config.FixedTimeStep;
+    if (DeltaTime <= 0.0f)
+    {
+        return Result;
+    }
+
+    FRandomStream Stream(Seed);
+
+    FFighterRuntime Runtime[2];
+    FCombatDuelPolicy Policies[2];
+    int32 NumAttacks = 0;
+    for (int32 FighterIndex = 0; FighterIndex < 2; ++FighterIndex)
+    {
+        const FCombatDuelFighterSetup& Setup = Params.Fighters[FighterIndex];
+        Runtime[FighterIndex].Health = Setup.MaxHealth;
+        Runtime[FighterIndex].AttackOffset = NumAttacks;
+
+        FCombatDuelPolicy& Policy = Policies[FighterIndex];
+        Policy = Setup.Policy;
+        if (Policy.bRandomize)
+        {
+            Policy.Aggression = Stream.FRand();
+            Policy.BlockChance = Stream.FRand() * (1.0f - Policy.Aggression);
+            Policy.HeavyChance = Stream.FRand();
+            Policy.ComboChance = Stream.FRand();
+        }
+
+        // Stagger the first decision so mirror matches don't lock-step
+        Runtime[FighterIndex].NextDecision = Stream.FRand() * Policy.DecisionInterval;
+
+        if (Setup.Moveset)
+        {
+            for (const FCombatDuelMove& Move : Setup.Moveset->Moves)
+            {
+                Sim.AddAttack(Move.Timing);
+            }
+            NumAttacks += Setup.Moveset->Moves.Num();
+        }
+
+        Sim.AddFighter();
+    }
+
+    const int32 MaxSteps = FMath::CeilToInt(Params.MaxDuration / DeltaTime);
+    const int32 StepsPerSample = FMath::Max(1, FMath::RoundToInt(Params.PostureSampleInterval / DeltaTime));
+
+    int32 StepIndex = 0;
+    for (; StepIndex < MaxSteps; ++StepIndex)
+    {
+        if (StepIndex % StepsPerSample == 0)
+        {
+            Result.PostureSamples[0].Add(Sim.GetFighter(0).Posture);
+            Result.PostureSamples[1].Add(Sim.GetFighter(1).Posture);
+        }
+
+        // ------------------------------------------------------------------------
+        // Policies
+        // ------------------------------------------------------------------------
+
+        for (int32 FighterIndex = 0; FighterIndex < 2; ++FighterIndex)
+        {
+            const FCombatDuelFighterSetup& Setup = Params.Fighters[FighterIndex];
+            const FCombatDuelPolicy& Policy = Policies[FighterIndex];
+            FFighterRuntime& Fighter = Runtime[FighterIndex];
+            const FCombatSimFighter& State = Sim.GetFighter(FighterIndex);
+
+            if (!Setup.Moveset)
+            {
+                continue;
+            }
+
+            if (State.State == ECombatState::Blocking)
+            {
+                Fighter.BlockRemaining -= DeltaTime;
+                if (Fighter.BlockRemaining <= 0.0f)
+                {
+                    Sim.SetBlocking(FighterIndex, false);
+                }
+                continue;
+            }
+
+            Fighter.NextDecision -= DeltaTime;
+            if (Fighter.NextDecision > 0.0f)
+            {
+                continue;
+            }
+            Fighter.NextDecision += Policy.DecisionInterval;
+
+            const FCombatDuelMoveset& Moveset = *Setup.Moveset;
+            if (State.State == ECombatState::Idle)
+            {
+                const float Roll = Stream.FRand();
+                if (Roll < Policy.Aggression)
+                {
+                    const int32 Move = PickMove(Moveset.RootLight, Moveset.RootHeavy, Stream.FRand() < Policy.HeavyChance);
+                    if (Move != INDEX_NONE)
+                    {
+                        Sim.RequestAttack(FighterIndex, Fighter.AttackOffset + Move);
+                    }
+                }
+                else if (Roll < Policy.Aggression + Policy.BlockChance && Sim.SetBlocking(FighterIndex, true))
+                {
+                    Fighter.BlockRemaining = Policy.BlockDuration;
+                }
+            }
+            else if (State.State == ECombatState::Attacking && State.AttackIndex != INDEX_NONE && State.QueuedAttackIndex == INDEX_NONE)
+            {
+                if (Stream.FRand() < Policy.ComboChance)
+                {
+                    const FCombatDuelMove& Current = Moveset.Moves[State.AttackIndex - Fighter.AttackOffset];
+                    const int32 Move = PickMove(Current.NextLight, Current.NextHeavy, Stream.FRand() < Policy.HeavyChance);
+                    if (Move != INDEX_NONE)
+                    {
+                        Sim.RequestAttack(FighterIndex, Fighter.AttackOffset + Move);
+                    }
+                }
+            }
+        }
+
+        Sim.Step();
+
+        // ------------------------------------------------------------------------
+        // Hits: every active phase lands on the opponent
+        // ------------------------------------------------------------------------
+
+        for (const FCombatSimEvent& Event : Sim.GetEvents())
+        {
+            if (Event.Type != ECombatSimEventType::PhaseChanged || Event.Phase != EAttackPhase::Active)
+            {
+                continue;
+            }
+
+            const int32 Attacker = Event.FighterIndex;
+            const int32 Defender = 1 - Attacker;
+            const FCombatDuelMove& Move = Params.Fighters[Attacker].Moveset->Moves[Event.AttackIndex - Runtime[Attacker].AttackOffset];
+            const FCombatSimFighter& Target = Sim.GetFighter(Defender);
+
+            if (Target.State == ECombatState::Blocking)
+            {
+                Result.BlockedHits[Attacker]++;
+                Result.PostureDamageDealt[Attacker] += FMath::Min(Move.Timing.PostureDamage, Target.Posture);
+                if (Sim.ApplyPostureDamage(Defender, Move.Timing.PostureDamage))
+                {
+                    Result.GuardBreaksCaused[Attacker]++;
+                }
+            }
+            else
+            {
+                const float Damage = Move.Damage * (Target.State == ECombatState::GuardBroken ? Move.CounterDamageMultiplier : 1.0f);
+                Runtime[Defender].Health -= Damage;
+                Result.DamageDealt[Attacker] += Damage;
+                Result.Hits[Attacker]++;
+            }
+        }
+        Sim.ResetEvents();
+
+        if (Runtime[0].Health <= 0.0f || Runtime[1].Health <= 0.0f)
+        {
+            ++StepIndex;
+            break;
+        }
+    }
+
+    Result.Duration = StepIndex * DeltaTime;
+
+    const bool bDead0 = Runtime[0].Health <= 0.0f;
+    const bool bDead1 = Runtime[1].Health <= 0.0f;
+    if (bDead0 != bDead1)
+    {
+        Result.Winner = bDead1 ? 0 : 1;
+    }
+    else if (!bDead0)
+    {
+        // Timeout: higher remaining health fraction wins
+        Result.bTimedOut = true;
+        const float Fraction0 = Runtime[0].Health / FMath::Max(Params.Fighters[0].MaxHealth, KINDA_SMALL_NUMBER);
+        const float Fraction1 = Runtime[1].Health / FMath::Max(Params.Fighters[1].MaxHealth, KINDA_SMALL_NUMBER);
+        if (!FMath::IsNearlyEqual(Fraction0, Fraction1))
+        {
+            Result.Winner = Fraction0 > Fraction1 ? 0 : 1;
+        }
+    }
+
+    return Result;
+}
+
+void FCombatDuelSimulator::RunDuels(const FCombatDuelParams& Params, int32 NumDuels, int32 BaseSeed, TArray<FCombatDuelResult>& OutResults)
+{
+    OutResults.Reset();
+    OutResults.SetNum(FMath::Max(0, NumDuels));
+
+    // Duels share only read-only params and movesets
+    ParallelFor(OutResults.Num(), [&Params, BaseSeed, &OutResults](int32 DuelIndex)
+    {
+        OutResults[DuelIndex] = RunDuel(Params, BaseSeed + DuelIndex);
+    });
+}
+
+FCombatDuelSummary FCombatDuelSimulator::Summarize(const TArray<FCombatDuelResult>& Results)
+{
+    FCombatDuelSummary Summary;
+    Summary.NumDuels = Results.Num();
+    if (Results.Num() == 0)
+    {
+        return Summary;
+    }
+
+    float TotalDuration = 0.0f;
+    float TotalDamage[2] = {};
+    int32 TotalGuardBreaks[2] = {};
+    int32 TotalBlocked[2] = {};
+    int32 TotalLanded[2] = {};
+    TArray<int32> SampleCounts;
+
+    for (const FCombatDuelResult& Result : Results)
+    {
+        if (Result.Winner == INDEX_NONE)
+        {
+            Summary.Draws++;
+        }
+        else
+        {
+            Summary.Wins[Result.Winner]++;
+        }
+        Summary.Timeouts += Result.bTimedOut ? 1 : 0;
+        TotalDuration += Result.Duration;
+
+        for (int32 FighterIndex = 0; FighterIndex < 2; ++FighterIndex)
+        {
+            const int32 Opponent = 1 - FighterIndex;
+            TotalDamage[FighterIndex] += Result.DamageDealt[FighterIndex];
+            TotalGuardBreaks[FighterIndex] += Result.GuardBreaksCaused[FighterIndex];
+            TotalBlocked[FighterIndex] += Result.BlockedHits[Opponent];
+            TotalLanded[FighterIndex] += Result.BlockedHits[Opponent] + Result.Hits[Opponent];
+
+            const TArray<float>& Samples = Result.PostureSamples[FighterIndex];
+            TArray<float>& Mean = Summary.MeanPosture[FighterIndex];
+            if (Mean.Num() < Samples.Num())
+            {
+                Mean.SetNumZeroed(Samples.Num());
+            }
+            for (int32 SampleIndex = 0; SampleIndex < Samples.Num(); ++SampleIndex)
+            {
+                Mean[SampleIndex] += Samples[SampleIndex];
+            }
+        }
+
+        // Both fighters are sampled together
+        const int32 NumSamples = Result.PostureSamples[0].Num();
+        if (SampleCounts.Num() < NumSamples)
+        {
+            SampleCounts.SetNumZeroed(NumSamples);
+        }
+        for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+        {
+            SampleCounts[SampleIndex]++;
+        }
+    }
+
+    Summary.MeanDuration = TotalDuration / Results.Num();
+    for (int32 FighterIndex = 0; FighterIndex < 2; ++FighterIndex)
+    {
+        Summary.DPS[FighterIndex] = TotalDuration > 0.0f ? TotalDamage[FighterIndex] / TotalDuration : 0.0f;
+        Summary.MeanGuardBreaksCaused[FighterIndex] = static_cast<float>(TotalGuardBreaks[FighterIndex]) / Results.Num();
+        Summary.BlockRate[FighterIndex] = TotalLanded[FighterIndex] > 0 ? static_cast<float>(TotalBlocked[FighterIndex]) / TotalLanded[FighterIndex] : 0.0f;
+
+        TArray<float>& Mean = Summary.MeanPosture[FighterIndex];
+        for (int32 SampleIndex = 0; SampleIndex < Mean.Num(); ++SampleIndex)
+        {
+            Mean[SampleIndex] /= FMath::Max(1, SampleCounts[SampleIndex]);
+        }
+    }
+
+    return Summary;
+}
@@ -0,0 +1,334 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatEventChannelComponent.h"
+#include "Core/CombatComponent.h"
+#include "Data/AttackData.h"
+#include "UObject/CoreNet.h"
+#include "Net/UnrealNetwork.h"
+
+// ============================================================================
+// WIRE FORMAT
+// ============================================================================
+
+void FCombatNetEvent::Serialize(FArchive& Ar, UPackageMap* Map)
+{
+    // 3 bits type
+    uint32 TypeBits = static_cast<uint32>(Type);
+    Ar.SerializeInt(TypeBits, 8);
+    Type = static_cast<ECombatNetEventType>(TypeBits);
+
+    // Target as net GUID (events without one skip it)
+    if (Type != ECombatNetEventType::GuardBroken && Type != ECombatNetEventType::Posture)
+    {
+        UObject* TargetObject = Target.Get();
+        if (Map)
+        {
+            Map->SerializeObject(Ar, AActor::StaticClass(), TargetObject);
+        }
+        if (Ar.IsLoading())
+        {
+            Target = Cast<AActor>(TargetObject);
+        }
+    }
+
+    if (Type == ECombatNetEventType::Posture)
+    {
+        Ar << Magnitude;
+    }
+    else if (Type == ECombatNetEventType::Hit)
+    {
+        Ar << AttackIndex;
+        Ar << Magnitude;
+        Ar << Direction;
+
+        // 11 bits per axis, biased to unsigned
+        for (int16& Axis : ImpactOffset)
+        {
+            uint32 Biased = static_cast<uint32>(FMath::Clamp<int32>(Axis, -ImpactOffsetRange, ImpactOffsetRange - 1) + ImpactOffsetRange);
+            Ar.SerializeInt(Biased, ImpactOffsetRange * 2);
+            Axis = static_cast<int16>(static_cast<int32>(Biased) - ImpactOffsetRange);
+        }
+    }
+}
+
+uint16 FCombatNetEvent::QuantizeMagnitude(float Value)
+{
+    return static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Value * MagnitudeScale), 0, static_cast<int32>(MAX_uint16)));
+}
+
+uint16 FCombatNetEvent::PackDirection(const FVector& InDirection)
+{
+    // Octahedral projection: fold the unit sphere onto a square, quantize each axis to 8 bits
+    const FVector Dir = InDirection.GetSafeNormal();
+    const float L1 = FMath::Abs(Dir.X) + FMath::Abs(Dir.Y) + FMath::Abs(Dir.Z);
+    if (L1 <= UE_SMALL_NUMBER)
+    {
+        return 0;
+    }
+
+    float U = Dir.X / L1;
+    float V = Dir.Y / L1;
+    if (Dir.Z < 0.0f)
+    {
+        const float FoldedU = (1.0f - FMath::Abs(V)) * (U >= 0.0f ? 1.0f : -1.0f);
+        const float FoldedV = (1.0f - FMath::Abs(U)) * (V >= 0.0f ? 1.0f : -1.0f);
+        U = FoldedU;
+        V = FoldedV;
+    }
+
+    const uint16 QU = static_cast<uint16>(FMath::RoundToInt((U * 0.5f + 0.5f) * 255.0f));
+    const uint16 QV = static_cast<uint16>(FMath::RoundToInt((V * 0.5f + 0.5f) * 255.0f));
+    return static_cast<uint16>((QU << 8) | QV);
+}
+
+FVector FCombatNetEvent::UnpackDirection(uint16 Packed)
+{
+    if (Packed == 0)
+    {
+        return FVector::ZeroVector;
+    }
+
+    float U = ((Packed >> 8) / 255.0f) * 2.0f - 1.0f;
+    float V = ((Packed & 0xFF) / 255.0f) * 2.0f - 1.0f;
+    const float Z = 1.0f - FMath::Abs(U) - FMath::Abs(V);
+    if (Z < 0.0f)
+    {
+        const float UnfoldedU = (1.0f - FMath::Abs(V)) * (U >= 0.0f ? 1.0f : -1.0f);
+        const float UnfoldedV = (1.0f - FMath::Abs(U)) * (V >= 0.0f ? 1.0f : -1.0f);
+        U = UnfoldedU;
+        V = UnfoldedV;
+    }
+
+    return FVector(U, V, Z).GetSafeNormal();
+}
+
+bool FCombatNetEventBatch::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    uint32 Count = FMath::Min(Events.Num(), MaxEvents);
+    Ar.SerializeInt(Count, MaxEvents + 1);
+
+    if (Ar.IsLoading())
+    {
+        Events.SetNum(Count);
+    }
+
+    for (uint32 Index = 0; Index < Count; ++Index)
+    {
+        Events[Index].Serialize(Ar, Map);
+    }
+
+    bOutSuccess = !Ar.IsError();
+    return true;
+}
+
+// ============================================================================
+// COMPONENT
+// ============================================================================
+
+UCombatEventChannelComponent::UCombatEventChannelComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false; // Server only, enabled in BeginPlay
+    SetIsReplicatedByDefault(true);
+}
+
+void UCombatEventChannelComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (!ShouldSend())
+    {
+        return;
+    }
+
+    OwnerCombat = GetOwner()->FindComponentByClass<UCombatComponent>();
+    if (OwnerCombat)
+    {
+        OwnerCombat->OnPerfectParryNative.AddUObject(this, &UCombatEventChannelComponent::HandlePerfectParry);
+        OwnerCombat->OnPerfectEvadeNative.AddUObject(this, &UCombatEventChannelComponent::HandlePerfectEvade);
+        OwnerCombat->OnGuardBrokenNative.AddUObject(this, &UCombatEventChannelComponent::HandleGuardBroken);
+        OwnerCombat->OnPostureChangedNative.AddUObject(this, &UCombatEventChannelComponent::HandlePostureChanged);
+    }
+
+    SetComponentTickEnabled(true);
+}
+
+void UCombatEventChannelComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(UCombatEventChannelComponent, MovesetTable);
+}
+
+void UCombatEventChannelComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (PendingEvents.Events.Num() == 0)
+    {
+        return;
+    }
+
+    // Match the owner's net update rate so each update carries at most one batch
+    const float Now = GetWorld()->GetTimeSeconds();
+    const float UpdateInterval = 1.0f / FMath::Max(GetOwner()->GetNetUpdateFrequency(), 1.0f);
+    if (Now - LastFlushTime >= UpdateInterval)
+    {
+        FlushEvents();
+        LastFlushTime = Now;
+    }
+}
+
+// ============================================================================
+// SENDING
+// ============================================================================
+
+bool UCombatEventChannelComponent::ShouldSend() const
+{
+    return GetOwner() && GetOwner()->HasAuthority() && GetNetMode() != NM_Standalone;
+}
+
+void UCombatEventChannelComponent::QueueHitEvent(AActor* Target, const FVector& ImpactPoint, const FVector& Direction, UAttackData* AttackData, float Damage)
+{
+    if (!ShouldSend())
+    {
+        return;
+    }
+
+    FCombatNetEvent& Event = PendingEvents.Events.AddDefaulted_GetRef();
+    Event.Type = ECombatNetEventType::Hit;
+    Event.Target = Target;
+    Event.AttackIndex = GetAttackIndex(AttackData);
+    Event.Magnitude = FCombatNetEvent::QuantizeMagnitude(Damage);
+    Event.Direction = FCombatNetEvent::PackDirection(Direction);
+
+    const FVector Offset = ImpactPoint - GetOwner()->GetActorLocation();
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        Event.ImpactOffset[Axis] = static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Offset[Axis]), -FCombatNetEvent::ImpactOffsetRange, FCombatNetEvent::ImpactOffsetRange - 1));
+    }
+}
+
+void UCombatEventChannelComponent::QueueEvent(ECombatNetEventType Type, AActor* Target, float Magnitude)
+{
+    if (!ShouldSend())
+    {
+        return;
+    }
+
+    // Only the latest posture value per batch matters
+    if (Type == ECombatNetEventType::Posture && PendingEvents.Events.IsValidIndex(PendingPostureIndex))
+    {
+        PendingEvents.Events[PendingPostureIndex].Magnitude = FCombatNetEvent::QuantizeMagnitude(Magnitude);
+        return;
+    }
+
+    FCombatNetEvent& Event = PendingEvents.Events.AddDefaulted_GetRef();
+    Event.Type = Type;
+    Event.Target = Target;
+    Event.Magnitude = FCombatNetEvent::QuantizeMagnitude(Magnitude);
+
+    if (Type == ECombatNetEventType::Posture)
+    {
+        PendingPostureIndex = PendingEvents.Events.Num() - 1;
+    }
+}
+
+void UCombatEventChannelComponent::RegisterMoveset(TConstArrayView<UAttackData*> Attacks)
+{
+    if (!GetOwner() || !GetOwner()->HasAuthority())
+    {
+        return;
+    }
+
+    for (UAttackData* Attack : Attacks)
+    {
+        GetAttackIndex(Attack);
+    }
+}
+
+uint8 UCombatEventChannelComponent::GetAttackIndex(UAttackData* AttackData)
+{
+    if (!AttackData)
+    {
+        return FCombatNetEvent::NoAttack;
+    }
+
+    int32 Index = MovesetTable.Find(AttackData);
+    if (Index == INDEX_NONE)
+    {
+        if (MovesetTable.Num() >= FCombatNetEvent::NoAttack)
+        {
+            return FCombatNetEvent::NoAttack;
+        }
+        Index = MovesetTable.Add(AttackData);
+    }
+
+    return static_cast<uint8>(Index);
+}
+
+void UCombatEventChannelComponent::FlushEvents()
+{
+    MulticastCombatEvents(PendingEvents);
+
+    // Overflow beyond one batch goes out with the next update
+    const int32 NumSent = FMath::Min(PendingEvents.Events.Num(), FCombatNetEventBatch::MaxEvents);
+    PendingEvents.Events.RemoveAt(0, NumSent, EAllowShrinking::No);
+    PendingPostureIndex = PendingPostureIndex >= NumSent ? PendingPostureIndex - NumSent : INDEX_NONE;
+}
+
+void UCombatEventChannelComponent::HandlePerfectParry(AActor* ParriedActor)
+{
+    QueueEvent(ECombatNetEventType::PerfectParry, ParriedActor);
+}
+
+void UCombatEventChannelComponent::HandlePerfectEvade(AActor* EvadedActor)
+{
+    QueueEvent(ECombatNetEventType::PerfectEvade, EvadedActor);
+}
+
+void UCombatEventChannelComponent::HandleGuardBroken()
+{
+    QueueEvent(ECombatNetEventType::GuardBroken, nullptr);
+}
+
+void UCombatEventChannelComponent::HandlePostureChanged(float NewPosture)
+{
+    QueueEvent(ECombatNetEventType::Posture, nullptr, NewPosture);
+}
+
+// ============================================================================
+// RECEIVING
+// ============================================================================
+
+void UCombatEventChannelComponent::MulticastCombatEvents_Implementation(const FCombatNetEventBatch& Batch)
+{
+    // Server already fired the local delegates
+    if (GetOwner()->HasAuthority())
+    {
+        return;
+    }
+
+    const FVector Origin = GetOwner()->GetActorLocation();
+    for (const FCombatNetEvent& Event : Batch.Events)
+    {
+        OnReplicatedCombatEvent.Broadcast(UnpackEvent(Event, Origin));
+    }
+}
+
+FCombatReplicatedEvent UCombatEventChannelComponent::UnpackEvent(const FCombatNetEvent& Event, const FVector& Origin) const
+{
+    FCombatReplicatedEvent Result;
+    Result.Type = Event.Type;
+    Result.Target = Event.Target.Get();
+    Result.Magnitude = FCombatNetEvent::DequantizeMagnitude(Event.Magnitude);
+
+    if (Event.Type == ECombatNetEventType::Hit)
+    {
+        Result.ImpactPoint = Origin + FVector(Event.ImpactOffset[0], Event.ImpactOffset[1], Event.ImpactOffset[2]);
+        Result.Direction = FCombatNetEvent::UnpackDirection(Event.Direction);
+        Result.AttackData = MovesetTable.IsValidIndex(Event.AttackIndex) ? MovesetTable[Event.AttackIndex].Get() : nullptr;
+    }
+
+    return Result;
+}
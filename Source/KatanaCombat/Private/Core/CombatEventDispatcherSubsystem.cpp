@@ -0,0 +1,276 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatEventDispatcherSubsystem.h"
+#include "Data/AttackData.h"
+#include "Debug/CombatTrace.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+const TCHAR* LexToString(ECombatEventKind Kind)
+{
+    switch (Kind)
+    {
+        case ECombatEventKind::Hit:           return TEXT("Hit");
+        case ECombatEventKind::Damage:        return TEXT("Damage");
+        case ECombatEventKind::PerfectParry:  return TEXT("PerfectParry");
+        case ECombatEventKind::GuardBroken:   return TEXT("GuardBroken");
+        case ECombatEventKind::Posture:       return TEXT("Posture");
+        case ECombatEventKind::CombatState:   return TEXT("CombatState");
+        case ECombatEventKind::Phase:         return TEXT("Phase");
+        case ECombatEventKind::AttackStarted: return TEXT("AttackStarted");
+        default:                              return TEXT("Unknown");
+    }
+}
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+UCombatEventDispatcherSubsystem* UCombatEventDispatcherSubsystem::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UCombatEventDispatcherSubsystem>() : nullptr;
+}
+
+void UCombatEventDispatcherSubsystem::Deinitialize()
+{
+    Subscribers.Empty();
+    WatchSubscription.Invalidate();
+    for (TArray<FCombatEventSubscription>& List : KindSubscribers)
+    {
+        List.Empty();
+    }
+    SubscribedKindMask = 0;
+    PendingEvents.Empty();
+    DispatchingEvents.Empty();
+
+    Super::Deinitialize();
+}
+
+bool UCombatEventDispatcherSubsystem::IsTickable() const
+{
+    return PendingEvents.Num() > 0;
+}
+
+TStatId UCombatEventDispatcherSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatEventDispatcherSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatEventDispatcherSubsystem::Tick(float DeltaTime)
+{
+    COMBAT_TRACE_SCOPE(UCombatEventDispatcherSubsystem::Tick);
+
+    Super::Tick(DeltaTime);
+
+    DispatchPendingEvents();
+}
+
+// ============================================================================
+// PUBLISHING
+// ============================================================================
+
+FCombatEvent* UCombatEventDispatcherSubsystem::Publish(ECombatEventKind Kind, AActor* Instigator, AActor* Target)
+{
+    if (!IsListening(Kind))
+    {
+        return nullptr;
+    }
+
+    FCombatEvent& Event = PendingEvents.AddDefaulted_GetRef();
+    Event.Kind = Kind;
+    Event.Instigator = Instigator;
+    Event.Target = Target;
+    return &Event;
+}
+
+FCombatEvent* UCombatEventDispatcherSubsystem::PublishFrom(const UObject* WorldContextObject, ECombatEventKind Kind, AActor* Instigator, AActor* Target)
+{
+    UCombatEventDispatcherSubsystem* Dispatcher = Get(WorldContextObject);
+    return Dispatcher ? Dispatcher->Publish(Kind, Instigator, Target) : nullptr;
+}
+
+void UCombatEventDispatcherSubsystem::DispatchPendingEvents()
+{
+    NumDispatchedLastFrame = 0;
+    NumDeliveredLastFrame = 0;
+
+    if (PendingEvents.Num() == 0)
+    {
+        return;
+    }
+
+    if (bKindListsDirty)
+    {
+        RebuildKindLists();
+    }
+
+    // Callbacks may publish - those wait for the next dispatch
+    Swap(DispatchingEvents, PendingEvents);
+
+    for (const FCombatEvent& Event : DispatchingEvents)
+    {
+        // Indexed, not ranged: callbacks may subscribe (lists are only rebuilt before a dispatch)
+        const TArray<FCombatEventSubscription>& List = KindSubscribers[static_cast<int32>(Event.Kind)];
+        for (int32 ListIndex = 0; ListIndex < List.Num(); ++ListIndex)
+        {
+            const FCombatEventSubscription Handle = List[ListIndex];
+            if (!Subscribers.IsValidIndex(Handle.Index) || Subscribers[Handle.Index].Serial != Handle.Serial)
+            {
+                continue;
+            }
+
+            const FSubscriber& Subscriber = Subscribers[Handle.Index];
+            if (!Subscriber.Filter.Matches(Event))
+            {
+                continue;
+            }
+
+            UObject* Object = Subscriber.Object.Get();
+            if (!Object)
+            {
+                Subscribers.RemoveAt(Handle.Index);
+                bKindListsDirty = true;
+                continue;
+            }
+
+            Subscriber.Thunk(Object, Event);
+            ++NumDeliveredLastFrame;
+        }
+    }
+
+    NumDispatchedLastFrame = DispatchingEvents.Num();
+    DispatchingEvents.Reset();
+}
+
+// ============================================================================
+// SUBSCRIBING
+// ============================================================================
+
+FCombatEventSubscription UCombatEventDispatcherSubsystem::AddSubscriber(UObject* Object, FEventThunk Thunk, const FCombatEventFilter& Filter)
+{
+    FCombatEventSubscription Handle;
+    if (!Object || !Thunk || (Filter.KindMask & FCombatEventFilter::AllKinds) == 0)
+    {
+        return Handle;
+    }
+
+    FSubscriber Subscriber;
+    Subscriber.Object = Object;
+    Subscriber.Thunk = Thunk;
+    Subscriber.Filter = Filter;
+    Subscriber.Serial = NextSerial++;
+
+    Handle.Index = Subscribers.Add(Subscriber);
+    Handle.Serial = Subscriber.Serial;
+
+    // Publishing starts right away; the kind lists catch up before the next dispatch
+    SubscribedKindMask |= Filter.KindMask & FCombatEventFilter::AllKinds;
+    bKindListsDirty = true;
+    return Handle;
+}
+
+bool UCombatEventDispatcherSubsystem::Unsubscribe(FCombatEventSubscription& InOutHandle)
+{
+    const bool bWasSubscribed = IsSubscribed(InOutHandle);
+    if (bWasSubscribed)
+    {
+        Subscribers.RemoveAt(InOutHandle.Index);
+        bKindListsDirty = true;
+    }
+
+    InOutHandle.Invalidate();
+    return bWasSubscribed;
+}
+
+bool UCombatEventDispatcherSubsystem::IsSubscribed(const FCombatEventSubscription& Handle) const
+{
+    return Subscribers.IsValidIndex(Handle.Index) && Subscribers[Handle.Index].Serial == Handle.Serial;
+}
+
+void UCombatEventDispatcherSubsystem::RebuildKindLists()
+{
+    for (TArray<FCombatEventSubscription>& List : KindSubscribers)
+    {
+        List.Reset();
+    }
+
+    SubscribedKindMask = 0;
+    for (auto It = Subscribers.CreateConstIterator(); It; ++It)
+    {
+        const uint32 KindMask = It->Filter.KindMask & FCombatEventFilter::AllKinds;
+        SubscribedKindMask |= KindMask;
+
+        for (int32 Kind = 0; Kind < static_cast<int32>(ECombatEventKind::Count); ++Kind)
+        {
+            if (KindMask & (1u << Kind))
+            {
+                KindSubscribers[Kind].Add({ It.GetIndex(), It->Serial });
+            }
+        }
+    }
+
+    bKindListsDirty = false;
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+
+void UCombatEventDispatcherSubsystem::WatchActor(AActor* Actor)
+{
+    if (!Actor)
+    {
+        Unsubscribe(WatchSubscription);
+        return;
+    }
+
+    FCombatEventFilter Filter;
+    Filter.Involving = Actor;
+    Subscribe<&UCombatEventDispatcherSubsystem::LogEvent>(WatchSubscription, this, Filter);
+}
+
+void UCombatEventDispatcherSubsystem::LogEvent(const FCombatEvent& Event)
+{
+    UE_LOG(LogCombat, Log, TEXT("[CombatEvents] %-13s %s -> %s  magnitude %.2f  args %u/%u  attack %s"),
+        LexToString(Event.Kind),
+        *GetNameSafe(Event.Instigator.Get()),
+        *GetNameSafe(Event.Target.Get()),
+        Event.Magnitude, Event.Arg0, Event.Arg1,
+        *GetNameSafe(Event.AttackData.Get()));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatEventsWatchCommand(
+    TEXT("Combat.Events.Watch"),
+    TEXT("Log every dispatched combat event involving an actor. Argument: actor name (no argument = stop)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UCombatEventDispatcherSubsystem* Dispatcher = UCombatEventDispatcherSubsystem::Get(World);
+        if (!Dispatcher)
+        {
+            return;
+        }
+
+        AActor* Watched = nullptr;
+        if (Args.Num() > 0)
+        {
+            for (TActorIterator<AActor> It(World); It; ++It)
+            {
+                if (It->GetName() == Args[0] || It->GetActorNameOrLabel() == Args[0])
+                {
+                    Watched = *It;
+                    break;
+                }
+            }
+
+            if (!Watched)
+            {
+                UE_LOG(LogCombat, Warning, TEXT("[CombatEvents] No actor named '%s'"), *Args[0]);
+                return;
+            }
+        }
+
+        Dispatcher->WatchActor(Watched);
+        UE_LOG(LogCombat, Log, TEXT("[CombatEvents] Watching: %s"), Watched ? *Watched->GetName() : TEXT("(none)"));
+    }));
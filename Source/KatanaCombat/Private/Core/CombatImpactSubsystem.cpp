@@ -0,0 +1,231 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatImpactSubsystem.h"
+#include "Data/CombatSettings.h"
+#include "Data/AttackData.h"
+#include "Debug/CombatTrace.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraDataChannel.h"
+#include "NiagaraDataChannelAccessor.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Components/PrimitiveComponent.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatImpactSubsystem::Deinitialize()
+{
+    PendingImpacts.Empty();
+    Groups.Empty();
+
+    Super::Deinitialize();
+}
+
+bool UCombatImpactSubsystem::IsTickable() const
+{
+    return PendingImpacts.Num() > 0;
+}
+
+TStatId UCombatImpactSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatImpactSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatImpactSubsystem::Tick(float DeltaTime)
+{
+    COMBAT_TRACE_SCOPE(UCombatImpactSubsystem::Tick);
+
+    Super::Tick(DeltaTime);
+
+    FlushImpacts();
+}
+
+// ============================================================================
+// REQUESTS
+// ============================================================================
+
+void UCombatImpactSubsystem::QueueImpact(const FHitResult& Hit, const UAttackData* AttackData, const UCombatSettings* Settings)
+{
+    if (!Settings || Settings->ImpactEffects.Num() == 0)
+    {
+        return;
+    }
+
+    const EAttackType AttackType = AttackData ? AttackData->AttackType : EAttackType::None;
+    const int32 EffectIndex = FindImpactEffect(Settings, GetHitSurface(Hit), AttackType);
+    if (EffectIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    FPendingImpact& Impact = PendingImpacts.AddDefaulted_GetRef();
+    Impact.Settings = Settings;
+    Impact.EffectIndex = EffectIndex;
+    Impact.Location = Hit.ImpactPoint;
+    Impact.Normal = Hit.ImpactNormal.IsNearlyZero() ? FVector::UpVector : FVector(Hit.ImpactNormal);
+}
+
+int32 UCombatImpactSubsystem::FindImpactEffect(const UCombatSettings* Settings, EPhysicalSurface Surface, EAttackType AttackType)
+{
+    if (!Settings)
+    {
+        return INDEX_NONE;
+    }
+
+    // Score: exact surface beats Default surface, exact attack type beats None (surface weighs more)
+    int32 BestIndex = INDEX_NONE;
+    int32 BestScore = -1;
+    for (int32 Index = 0; Index < Settings->ImpactEffects.Num(); ++Index)
+    {
+        const FCombatImpactEffect& Effect = Settings->ImpactEffects[Index];
+        const bool bSurfaceExact = Effect.Surface == Surface;
+        const bool bAttackExact = Effect.AttackType == AttackType;
+        if ((!bSurfaceExact && Effect.Surface != SurfaceType_Default) || (!bAttackExact && Effect.AttackType != EAttackType::None))
+        {
+            continue;
+        }
+
+        const int32 Score = (bSurfaceExact ? 2 : 0) + (bAttackExact ? 1 : 0);
+        if (Score > BestScore)
+        {
+            BestScore = Score;
+            BestIndex = Index;
+        }
+    }
+
+    return BestIndex;
+}
+
+EPhysicalSurface UCombatImpactSubsystem::GetHitSurface(const FHitResult& Hit)
+{
+    const UPhysicalMaterial* PhysMaterial = Hit.PhysMaterial.Get();
+
+    // Weapon sweeps don't return materials - fall back to the component's simple material
+    if (!PhysMaterial)
+    {
+        if (const UPrimitiveComponent* Component = Hit.GetComponent())
+        {
+            if (const FBodyInstance* Body = Component->GetBodyInstance())
+            {
+                PhysMaterial = Body->GetSimplePhysicalMaterial();
+            }
+        }
+    }
+
+    return UPhysicalMaterial::DetermineSurfaceType(PhysMaterial);
+}
+
+// ============================================================================
+// FLUSH
+// ============================================================================
+
+void UCombatImpactSubsystem::FlushImpacts()
+{
+    UWorld* World = GetWorld();
+    if (!World || World->GetNetMode() == NM_DedicatedServer)
+    {
+        PendingImpacts.Reset();
+        return;
+    }
+
+    COMBAT_CSV_SCOPE(CombatImpacts);
+
+    // Merge the frame's impacts per settings asset and effect
+    Groups.Reset();
+    for (const FPendingImpact& Impact : PendingImpacts)
+    {
+        const UCombatSettings* Settings = Impact.Settings.Get();
+        if (!Settings || !Settings->ImpactEffects.IsValidIndex(Impact.EffectIndex))
+        {
+            continue;
+        }
+
+        FImpactGroup* Group = Groups.FindByPredicate([&Impact, Settings](const FImpactGroup& Existing)
+        {
+            return Existing.Settings == Settings && Existing.EffectIndex == Impact.EffectIndex;
+        });
+        if (!Group)
+        {
+            Group = &Groups.AddDefaulted_GetRef();
+            Group->Settings = Settings;
+            Group->EffectIndex = Impact.EffectIndex;
+        }
+        Group->LocationSum += Impact.Location;
+        ++Group->NumHits;
+    }
+
+    // VFX: one data channel batch per settings asset, else capped pooled spawns
+    TMap<const UCombatSettings*, TArray<const FPendingImpact*, TInlineAllocator<16>>, TInlineSetAllocator<4>> ChannelImpacts;
+    TMap<const UCombatSettings*, int32, TInlineSetAllocator<4>> SpawnsPerSettings;
+    for (const FPendingImpact& Impact : PendingImpacts)
+    {
+        const UCombatSettings* Settings = Impact.Settings.Get();
+        if (!Settings || !Settings->ImpactEffects.IsValidIndex(Impact.EffectIndex))
+        {
+            continue;
+        }
+
+        if (Settings->ImpactDataChannel)
+        {
+            ChannelImpacts.FindOrAdd(Settings).Add(&Impact);
+            continue;
+        }
+
+        UNiagaraSystem* System = Settings->ImpactEffects[Impact.EffectIndex].NiagaraSystem;
+        int32& NumSpawns = SpawnsPerSettings.FindOrAdd(Settings);
+        if (System && NumSpawns < Settings->MaxImpactSpawnsPerFrame)
+        {
+            ++NumSpawns;
+            UNiagaraFunctionLibrary::SpawnSystemAtLocation(World, System, Impact.Location, Impact.Normal.Rotation(),
+                FVector::OneVector, true, true, ENCPoolMethod::AutoRelease);
+        }
+    }
+
+    for (const auto& Pair : ChannelImpacts)
+    {
+        WriteDataChannel(*Pair.Key, Pair.Value);
+    }
+
+    // Audio: one sound per merged group at the centroid of its hits
+    for (const FImpactGroup& Group : Groups)
+    {
+        const FCombatImpactEffect& Effect = Group.Settings->ImpactEffects[Group.EffectIndex];
+        if (Effect.Sound)
+        {
+            const float Volume = Effect.VolumeMultiplier * (1.0f + Effect.VolumePerMergedHit * (Group.NumHits - 1));
+            UGameplayStatics::PlaySoundAtLocation(World, Effect.Sound, Group.LocationSum / Group.NumHits, Volume);
+        }
+    }
+
+    PendingImpacts.Reset();
+}
+
+void UCombatImpactSubsystem::WriteDataChannel(const UCombatSettings& Settings, TConstArrayView<const FPendingImpact*> Impacts)
+{
+    if (Impacts.Num() == 0)
+    {
+        return;
+    }
+
+    static const FName PositionName("Position");
+    static const FName NormalName("Normal");
+    static const FName EffectIndexName("EffectIndex");
+
+    const FNiagaraDataChannelSearchParameters SearchParams(Impacts[0]->Location);
+    UNiagaraDataChannelWriter* Writer = UNiagaraDataChannelLibrary::WriteToNiagaraDataChannel(
+        GetWorld(), Settings.ImpactDataChannel, SearchParams, Impacts.Num(), false, true, true, TEXT("CombatImpactSubsystem"));
+    if (!Writer)
+    {
+        return;
+    }
+
+    for (int32 Index = 0; Index < Impacts.Num(); ++Index)
+    {
+        Writer->WritePosition(PositionName, Index, Impacts[Index]->Location);
+        Writer->WriteVector(NormalName, Index, Impacts[Index]->Normal);
+        Writer->WriteInt(EffectIndexName, Index, Impacts[Index]->EffectIndex);
+    }
+}
@@ -0,0 +1,159 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatInputTimingSubsystem.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "Misc/App.h"
+
+/**
+ * Observes key and mouse button transitions as Slate dispatches them, never consumes them
+ */
+class FCombatInputTimingProcessor : public IInputProcessor
+{
+public:
+    explicit FCombatInputTimingProcessor(UCombatInputTimingSubsystem* InOwner)
+        : Owner(InOwner)
+    {
+    }
+
+    virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override
+    {
+    }
+
+    virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+    {
+        // Auto-repeat isn't a new press
+        if (!InKeyEvent.IsRepeat())
+        {
+            Record(InKeyEvent.GetKey(), true);
+        }
+        return false;
+    }
+
+    virtual bool HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+    {
+        Record(InKeyEvent.GetKey(), false);
+        return false;
+    }
+
+    virtual bool HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override
+    {
+        Record(MouseEvent.GetEffectingButton(), true);
+        return false;
+    }
+
+    virtual bool HandleMouseButtonUpEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override
+    {
+        Record(MouseEvent.GetEffectingButton(), false);
+        return false;
+    }
+
+    virtual const TCHAR* GetDebugName() const override { return TEXT("CombatInputTiming"); }
+
+private:
+    void Record(const FKey& Key, bool bPressed)
+    {
+        if (UCombatInputTimingSubsystem* Subsystem = Owner.Get())
+        {
+            Subsystem->RecordKeyEvent(Key, bPressed, FPlatformTime::Seconds());
+        }
+    }
+
+    TWeakObjectPtr<UCombatInputTimingSubsystem> Owner;
+};
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+bool UCombatInputTimingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatInputTimingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (FSlateApplication::IsInitialized())
+    {
+        InputProcessor = MakeShared<FCombatInputTimingProcessor>(this);
+        FSlateApplication::Get().RegisterInputPreProcessor(InputProcessor);
+    }
+}
+
+void UCombatInputTimingSubsystem::Deinitialize()
+{
+    if (InputProcessor.IsValid() && FSlateApplication::IsInitialized())
+    {
+        FSlateApplication::Get().UnregisterInputPreProcessor(InputProcessor);
+    }
+    InputProcessor.Reset();
+    KeyEvents.Empty();
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+void UCombatInputTimingSubsystem::RecordKeyEvent(const FKey& Key, bool bPressed, double PlatformTime)
+{
+    FKeyEventTimes& Times = KeyEvents.FindOrAdd(Key);
+    (bPressed ? Times.LastPressTime : Times.LastReleaseTime) = PlatformTime;
+}
+
+double UCombatInputTimingSubsystem::GetLatestKeyEventTime(TConstArrayView<FKey> Keys, bool bPressed) const
+{
+    const double OldestAccepted = FPlatformTime::Seconds() - MaxEventAge;
+    double Latest = 0.0;
+
+    for (const FKey& Key : Keys)
+    {
+        if (const FKeyEventTimes* Times = KeyEvents.Find(Key))
+        {
+            const double EventTime = bPressed ? Times->LastPressTime : Times->LastReleaseTime;
+            if (EventTime >= OldestAccepted)
+            {
+                Latest = FMath::Max(Latest, EventTime);
+            }
+        }
+    }
+
+    return Latest;
+}
+
+// ============================================================================
+// CONVERSION
+// ============================================================================
+
+float UCombatInputTimingSubsystem::PlatformTimeToWorldTime(double PlatformTime) const
+{
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return 0.0f;
+    }
+
+    const AWorldSettings* WorldSettings = World->GetWorldSettings();
+    const float TimeDilation = WorldSettings ? WorldSettings->GetEffectiveTimeDilation() : 1.0f;
+
+    return MapPlatformTimeToWorldTime(PlatformTime, FApp::GetCurrentTime(), World->GetTimeSeconds(), World->GetDeltaSeconds(), TimeDilation);
+}
+
+float UCombatInputTimingSubsystem::MapPlatformTimeToWorldTime(double PlatformTime, double FramePlatformTime, float WorldTime, float FrameDeltaTime, float TimeDilation)
+{
+    if (PlatformTime <= 0.0)
+    {
+        return WorldTime;
+    }
+
+    // How long before this frame started the event was seen, in world seconds
+    const double AgeWorldSeconds = (FramePlatformTime - PlatformTime) * TimeDilation;
+    const float Age = static_cast<float>(FMath::Clamp(AgeWorldSeconds, 0.0, static_cast<double>(FMath::Max(FrameDeltaTime, 0.0f))));
+
+    return FMath::Max(0.0f, WorldTime - Age);
+}
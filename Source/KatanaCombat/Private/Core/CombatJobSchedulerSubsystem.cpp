@@ -0,0 +1,253 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "Debug/CombatTrace.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatJobSchedulerSubsystem::Deinitialize()
+{
+    Jobs.Empty();
+    DueJobs.Empty();
+
+    Super::Deinitialize();
+}
+
+void UCombatJobSchedulerSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (const UWorld* World = GetWorld())
+    {
+        RunDueJobs(World->GetTimeSeconds());
+    }
+}
+
+bool UCombatJobSchedulerSubsystem::IsTickable() const
+{
+    return Jobs.Num() > 0;
+}
+
+TStatId UCombatJobSchedulerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatJobSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatJobSchedulerSubsystem::RunDueJobs(double Now, bool bIgnoreBudget)
+{
+    COMBAT_TRACE_SCOPE(UCombatJobSchedulerSubsystem::RunDueJobs);
+    COMBAT_CSV_SCOPE(JobScheduler);
+
+    NumRunLastFrame = 0;
+    NumDeferredLastFrame = 0;
+    NumStarvedLastFrame = 0;
+    TimeSpentLastFrameMs = 0.0f;
+
+    DueJobs.Reset();
+    for (auto It = Jobs.CreateConstIterator(); It; ++It)
+    {
+        if (It->DueTime <= Now)
+        {
+            DueJobs.Add(It.GetIndex());
+        }
+    }
+
+    if (DueJobs.Num() == 0)
+    {
+        return;
+    }
+
+    // Starved first, then priority, then whoever has waited longest
+    const float MaxDeferral = MaxDeferralTime;
+    DueJobs.Sort([this, Now, MaxDeferral](int32 A, int32 B)
+    {
+        const FJob& JobA = Jobs[A];
+        const FJob& JobB = Jobs[B];
+        const bool bStarvedA = Now - JobA.DueTime >= MaxDeferral;
+        const bool bStarvedB = Now - JobB.DueTime >= MaxDeferral;
+        if (bStarvedA != bStarvedB)
+        {
+            return bStarvedA;
+        }
+        if (JobA.Priority != JobB.Priority)
+        {
+            return JobA.Priority < JobB.Priority;
+        }
+        return JobA.DueTime < JobB.DueTime;
+    });
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    for (const int32 Index : DueJobs)
+    {
+        // A job run earlier this frame may have removed this one
+        if (!Jobs.IsValidIndex(Index))
+        {
+            continue;
+        }
+
+        FJob& Job = Jobs[Index];
+        const float SpentMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+        const bool bStarved = Now - Job.DueTime >= MaxDeferral;
+
+        // The first job always runs so the queue keeps moving; after that only what fits
+        if (!bIgnoreBudget && !bStarved && NumRunLastFrame > 0 && SpentMs + Job.AverageCostMs >= FrameBudgetMs)
+        {
+            ++NumDeferredLastFrame;
+            continue;
+        }
+
+        UObject* Object = Job.Object.Get();
+        if (!Object)
+        {
+            Jobs.RemoveAt(Index);
+            continue;
+        }
+
+        const float JobDeltaTime = Job.LastRunTime >= 0.0 ? static_cast<float>(Now - Job.LastRunTime) : Job.Interval;
+        const FJobThunk Thunk = Job.Thunk;
+        const uint32 Serial = Job.Serial;
+
+        // Restart the interval first - the callback may re-register or mark itself due
+        Job.LastRunTime = Now;
+        Job.DueTime = Now + Job.Interval;
+
+        const uint64 JobStartCycles = FPlatformTime::Cycles64();
+        {
+#if COMBAT_TRACE_ENABLED
+            TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(Job.Name);
+#endif
+            Thunk(Object, JobDeltaTime);
+        }
+        const float CostMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - JobStartCycles));
+
+        // The callback may have added jobs (Jobs can reallocate) or removed this one
+        if (Jobs.IsValidIndex(Index) && Jobs[Index].Serial == Serial)
+        {
+            FJob& RanJob = Jobs[Index];
+            RanJob.AverageCostMs = RanJob.AverageCostMs > 0.0f ? FMath::Lerp(RanJob.AverageCostMs, CostMs, 0.2f) : CostMs;
+        }
+
+        ++NumRunLastFrame;
+        NumStarvedLastFrame += bStarved ? 1 : 0;
+    }
+
+    TimeSpentLastFrameMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+
+    CSV_CUSTOM_STAT(KatanaCombat, JobsRun, NumRunLastFrame, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(KatanaCombat, JobsDeferred, NumDeferredLastFrame, ECsvCustomStatOp::Set);
+}
+
+// ============================================================================
+// JOBS
+// ============================================================================
+
+FCombatJobHandle UCombatJobSchedulerSubsystem::AddJob(UObject* Object, FJobThunk Thunk, float Interval, ECombatJobPriority Priority, const TCHAR* Name)
+{
+    FCombatJobHandle Handle;
+    if (!Object || !Thunk)
+    {
+        return Handle;
+    }
+
+    const UWorld* World = GetWorld();
+
+    FJob Job;
+    Job.Object = Object;
+    Job.Thunk = Thunk;
+    Job.Name = Name ? Name : TEXT("CombatJob");
+    Job.Priority = Priority;
+    Job.Interval = FMath::Max(Interval, 0.0f);
+    Job.DueTime = World ? World->GetTimeSeconds() : 0.0;
+    Job.Serial = NextSerial++;
+
+    Handle.Index = Jobs.Add(Job);
+    Handle.Serial = Job.Serial;
+    return Handle;
+}
+
+bool UCombatJobSchedulerSubsystem::UnregisterJob(FCombatJobHandle& InOutHandle)
+{
+    const bool bWasRegistered = FindJob(InOutHandle) != nullptr;
+    if (bWasRegistered)
+    {
+        Jobs.RemoveAt(InOutHandle.Index);
+    }
+
+    InOutHandle.Invalidate();
+    return bWasRegistered;
+}
+
+void UCombatJobSchedulerSubsystem::MarkJobDue(const FCombatJobHandle& Handle)
+{
+    if (FJob* Job = FindJob(Handle))
+    {
+        const UWorld* World = GetWorld();
+        Job->DueTime = FMath::Min(Job->DueTime, World ? World->GetTimeSeconds() : 0.0);
+    }
+}
+
+bool UCombatJobSchedulerSubsystem::IsJobRegistered(const FCombatJobHandle& Handle) const
+{
+    return FindJob(Handle) != nullptr;
+}
+
+UCombatJobSchedulerSubsystem::FJob* UCombatJobSchedulerSubsystem::FindJob(const FCombatJobHandle& Handle)
+{
+    return Jobs.IsValidIndex(Handle.Index) && Jobs[Handle.Index].Serial == Handle.Serial ? &Jobs[Handle.Index] : nullptr;
+}
+
+const UCombatJobSchedulerSubsystem::FJob* UCombatJobSchedulerSubsystem::FindJob(const FCombatJobHandle& Handle) const
+{
+    return Jobs.IsValidIndex(Handle.Index) && Jobs[Handle.Index].Serial == Handle.Serial ? &Jobs[Handle.Index] : nullptr;
+}
+
+// ============================================================================
+// STATS
+// ============================================================================
+
+void UCombatJobSchedulerSubsystem::DumpJobs() const
+{
+    UE_LOG(LogCombat, Log, TEXT("[CombatJobs] %d jobs, budget %.2f ms, max deferral %.2f s (last frame: %d run, %d deferred, %d starved, %.3f ms)"),
+        Jobs.Num(), FrameBudgetMs, MaxDeferralTime, NumRunLastFrame, NumDeferredLastFrame, NumStarvedLastFrame, TimeSpentLastFrameMs);
+
+    for (const FJob& Job : Jobs)
+    {
+        UE_LOG(LogCombat, Log, TEXT("[CombatJobs]   %-32s %-6s every %.2f s, avg %.3f ms (%s)"),
+            Job.Name,
+            Job.Priority == ECombatJobPriority::High ? TEXT("High") : Job.Priority == ECombatJobPriority::Normal ? TEXT("Normal") : TEXT("Low"),
+            Job.Interval, Job.AverageCostMs, *GetNameSafe(Job.Object.Get()));
+    }
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatJobsCommand(
+    TEXT("Combat.Jobs"),
+    TEXT("List scheduled combat jobs. Optional arguments: frame budget in ms, max deferral in seconds"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UCombatJobSchedulerSubsystem* Scheduler = World ? World->GetSubsystem<UCombatJobSchedulerSubsystem>() : nullptr;
+        if (!Scheduler)
+        {
+            return;
+        }
+
+        if (Args.Num() > 0)
+        {
+            Scheduler->FrameBudgetMs = FMath::Max(FCString::Atof(*Args[0]), 0.0f);
+        }
+        if (Args.Num() > 1)
+        {
+            Scheduler->MaxDeferralTime = FMath::Max(FCString::Atof(*Args[1]), 0.0f);
+        }
+
+        Scheduler->DumpJobs();
+    }));
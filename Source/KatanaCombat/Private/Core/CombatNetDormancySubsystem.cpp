@@ -0,0 +1,233 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatNetDormancySubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatNetDormancySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    Collection.InitializeDependency<UCombatRegistrySubsystem>();
+    if (UCombatJobSchedulerSubsystem* Scheduler = Collection.InitializeDependency<UCombatJobSchedulerSubsystem>())
+    {
+        Scheduler->RegisterJob<&UCombatNetDormancySubsystem::UpdateDormancyJob>(UpdateJob, this, UpdateInterval, ECombatJobPriority::Low, TEXT("NetDormancy.Update"));
+    }
+}
+
+void UCombatNetDormancySubsystem::Deinitialize()
+{
+    if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>() : nullptr)
+    {
+        Scheduler->UnregisterJob(UpdateJob);
+    }
+
+    NetCombatants.Empty();
+    NumDormant = 0;
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// DORMANCY
+// ============================================================================
+
+void UCombatNetDormancySubsystem::WakeActor(AActor* Actor)
+{
+    if (!Actor || !Actor->GetIsReplicated() || Actor->NetDormancy == DORM_Never)
+    {
+        return;
+    }
+
+    FNetCombatant& Combatant = FindOrAddCombatant(Actor);
+    Combatant.LastEngagedTime = GetWorld()->GetTimeSeconds();
+    if (Combatant.Tier == ECombatNetTier::Dormant)
+    {
+        SetTier(Combatant, *Actor, ECombatNetTier::Idle);
+    }
+
+    // Placed dormant and never ranked yet
+    if (Actor->NetDormancy > DORM_Awake)
+    {
+        Actor->SetNetDormancy(DORM_Awake);
+        Actor->ForceNetUpdate();
+    }
+}
+
+void UCombatNetDormancySubsystem::WakeActorFor(AActor* Actor)
+{
+    const UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+    UCombatNetDormancySubsystem* Dormancy = World ? World->GetSubsystem<UCombatNetDormancySubsystem>() : nullptr;
+    if (Dormancy && Dormancy->IsServerWorld())
+    {
+        Dormancy->WakeActor(Actor);
+    }
+}
+
+ECombatNetTier UCombatNetDormancySubsystem::GetTier(const AActor* Actor) const
+{
+    const FNetCombatant* Combatant = Actor ? NetCombatants.Find(FObjectKey(Actor)) : nullptr;
+    return Combatant ? Combatant->Tier : ECombatNetTier::Idle;
+}
+
+ECombatNetTier UCombatNetDormancySubsystem::ClassifyCombatant(ECombatantFlags Flags, ECombatState State, bool bHasTarget, bool bTargeted)
+{
+    if (EnumHasAnyFlags(Flags, ECombatantFlags::Attacking | ECombatantFlags::HitDetection))
+    {
+        return ECombatNetTier::Attacking;
+    }
+
+    if (Flags != ECombatantFlags::None || State != ECombatState::Idle || bHasTarget || bTargeted)
+    {
+        return ECombatNetTier::Engaged;
+    }
+
+    return ECombatNetTier::Idle;
+}
+
+void UCombatNetDormancySubsystem::UpdateDormancy()
+{
+    UCombatRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UCombatRegistrySubsystem>();
+    if (!Registry)
+    {
+        return;
+    }
+
+    Registry->RefreshCombatants();
+    ++PassIndex;
+
+    // Being locked onto counts as engaged for the target
+    const int32 NumCombatants = Registry->GetNumCombatants();
+    TBitArray<> Targeted(false, NumCombatants);
+    for (int32 Index = 0; Index < NumCombatants; ++Index)
+    {
+        const int32 TargetIndex = Registry->GetCombatantTargetIndex(Index);
+        if (TargetIndex != INDEX_NONE)
+        {
+            Targeted[TargetIndex] = true;
+        }
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    NumDormant = 0;
+
+    for (int32 Index = 0; Index < NumCombatants; ++Index)
+    {
+        AActor* Actor = Registry->GetCombatantActor(Index);
+        if (!Actor || !Actor->GetIsReplicated() || Actor->NetDormancy == DORM_Never)
+        {
+            continue;
+        }
+
+        FNetCombatant& Combatant = FindOrAddCombatant(Actor);
+        Combatant.LastSeenPass = PassIndex;
+
+        ECombatNetTier NewTier = ClassifyCombatant(Registry->GetCombatantFlags(Index), Registry->GetCombatantState(Index), Registry->GetCombatantTarget(Index) != nullptr, Targeted[Index]);
+        if (NewTier != ECombatNetTier::Idle)
+        {
+            Combatant.LastEngagedTime = Now;
+        }
+        else if (Now - Combatant.LastEngagedTime >= DormancyDelay)
+        {
+            // Players replicate their own movement and input acks - never dormant
+            const APawn* Pawn = Cast<APawn>(Actor);
+            NewTier = Pawn && Pawn->IsPlayerControlled() ? ECombatNetTier::Idle : ECombatNetTier::Dormant;
+        }
+
+        SetTier(Combatant, *Actor, NewTier);
+        NumDormant += NewTier == ECombatNetTier::Dormant ? 1 : 0;
+    }
+
+    // Combatants that left the registry go back to their own settings
+    for (auto It = NetCombatants.CreateIterator(); It; ++It)
+    {
+        if (It.Value().LastSeenPass == PassIndex)
+        {
+            continue;
+        }
+
+        if (AActor* Actor = It.Value().Actor.Get())
+        {
+            SetTier(It.Value(), *Actor, ECombatNetTier::Idle);
+        }
+        It.RemoveCurrent();
+    }
+}
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+void UCombatNetDormancySubsystem::UpdateDormancyJob(float DeltaTime)
+{
+    if (IsServerWorld())
+    {
+        UpdateDormancy();
+    }
+}
+
+bool UCombatNetDormancySubsystem::IsServerWorld() const
+{
+    // Dormancy and priority only mean something to a server's net driver
+    const ENetMode NetMode = GetWorld()->GetNetMode();
+    return NetMode == NM_DedicatedServer || NetMode == NM_ListenServer;
+}
+
+UCombatNetDormancySubsystem::FNetCombatant& UCombatNetDormancySubsystem::FindOrAddCombatant(AActor* Actor)
+{
+    const FObjectKey Key(Actor);
+    if (FNetCombatant* Combatant = NetCombatants.Find(Key))
+    {
+        return *Combatant;
+    }
+
+    FNetCombatant& Combatant = NetCombatants.Add(Key);
+    Combatant.Actor = Actor;
+    Combatant.LastEngagedTime = GetWorld()->GetTimeSeconds();
+    Combatant.DefaultNetPriority = Actor->NetPriority;
+    Combatant.LastSeenPass = PassIndex;
+    return Combatant;
+}
+
+void UCombatNetDormancySubsystem::SetTier(FNetCombatant& Combatant, AActor& Actor, ECombatNetTier NewTier)
+{
+    const ECombatNetTier OldTier = Combatant.Tier;
+    Combatant.Tier = NewTier;
+
+    switch (NewTier)
+    {
+        case ECombatNetTier::Attacking:
+            Actor.NetPriority = AttackerNetPriority;
+            break;
+
+        case ECombatNetTier::Engaged:
+            Actor.NetPriority = EngagedNetPriority;
+            break;
+
+        default:
+            Actor.NetPriority = Combatant.DefaultNetPriority;
+            break;
+    }
+
+    if (NewTier == ECombatNetTier::Dormant)
+    {
+        if (Actor.NetDormancy != DORM_DormantAll)
+        {
+            Actor.SetNetDormancy(DORM_DormantAll);
+        }
+        return;
+    }
+
+    // Engaged, or put to sleep by us: wake and send the state that changed while asleep
+    // (idle actors placed DORM_Initial keep sleeping until they're engaged)
+    const bool bWake = NewTier != ECombatNetTier::Idle || OldTier == ECombatNetTier::Dormant;
+    if (bWake && Actor.NetDormancy > DORM_Awake)
+    {
+        Actor.SetNetDormancy(DORM_Awake);
+        Actor.ForceNetUpdate();
+    }
+}
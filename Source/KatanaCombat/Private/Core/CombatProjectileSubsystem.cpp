@@ -0,0 +1,275 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatProjectileSubsystem.h"
+#include "Core/WeaponComponent.h"
+#include "Core/WeaponTraceSubsystem.h"
+#include "Core/HurtboxComponent.h"
+#include "Data/AttackData.h"
+#include "Debug/CombatTrace.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatProjectileSubsystem::Deinitialize()
+{
+    Locations.Empty();
+    Velocities.Empty();
+    GravityScales.Empty();
+    Radii.Empty();
+    TimesLeft.Empty();
+    HitsLeft.Empty();
+    StopOnWorld.Empty();
+    Weapons.Empty();
+    DenseSlots.Empty();
+    HitActors.Empty();
+    Attacks.Empty();
+    SlotSerials.Empty();
+    SlotDenseIndices.Empty();
+    FreeSlots.Empty();
+
+    Super::Deinitialize();
+}
+
+void UCombatProjectileSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    Integrate(DeltaTime);
+}
+
+bool UCombatProjectileSubsystem::IsTickable() const
+{
+    return Locations.Num() > 0;
+}
+
+TStatId UCombatProjectileSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatProjectileSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================================
+// PROJECTILES
+// ============================================================================
+
+FCombatProjectileHandle UCombatProjectileSubsystem::Launch(UWeaponComponent* Weapon, const FCombatProjectileParams& Params)
+{
+    if (!Weapon)
+    {
+        return FCombatProjectileHandle();
+    }
+
+    // Warm the pool once rather than growing it with every launch of the first volley
+    if (SlotSerials.Num() == 0)
+    {
+        const int32 PoolSize = FMath::Max(InitialPoolSize, 1);
+        Locations.Reserve(PoolSize);
+        Velocities.Reserve(PoolSize);
+        GravityScales.Reserve(PoolSize);
+        Radii.Reserve(PoolSize);
+        TimesLeft.Reserve(PoolSize);
+        HitsLeft.Reserve(PoolSize);
+        StopOnWorld.Reserve(PoolSize);
+        Weapons.Reserve(PoolSize);
+        DenseSlots.Reserve(PoolSize);
+        HitActors.Reserve(PoolSize);
+        Attacks.Reserve(PoolSize);
+        SlotSerials.Reserve(PoolSize);
+        SlotDenseIndices.Reserve(PoolSize);
+        FreeSlots.Reserve(PoolSize);
+    }
+
+    FCombatProjectileHandle Projectile;
+    if (FreeSlots.Num() > 0)
+    {
+        Projectile.Slot = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Projectile.Slot = SlotSerials.Add(0);
+        SlotDenseIndices.Add(INDEX_NONE);
+    }
+    Projectile.Serial = SlotSerials[Projectile.Slot];
+
+    SlotDenseIndices[Projectile.Slot] = Locations.Add(Params.Location);
+    Velocities.Add(Params.Velocity);
+    GravityScales.Add(Params.GravityScale);
+    Radii.Add(FMath::Max(Params.Radius, 0.1f));
+    TimesLeft.Add(Params.Lifetime);
+    HitsLeft.Add(FMath::Max(Params.MaxHits, 1));
+    StopOnWorld.Add(Params.bStopOnWorld);
+    Weapons.Add(Weapon);
+    DenseSlots.Add(Projectile.Slot);
+    HitActors.AddDefaulted();
+    Attacks.Add(Params.Attack);
+
+    return Projectile;
+}
+
+void UCombatProjectileSubsystem::Stop(FCombatProjectileHandle Projectile)
+{
+    const int32 Index = GetDenseIndex(Projectile);
+    if (Index != INDEX_NONE)
+    {
+        RemoveAt(Index);
+    }
+}
+
+bool UCombatProjectileSubsystem::GetProjectileState(FCombatProjectileHandle Projectile, FVector& OutLocation, FVector& OutVelocity) const
+{
+    const int32 Index = GetDenseIndex(Projectile);
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutLocation = Locations[Index];
+    OutVelocity = Velocities[Index];
+    return true;
+}
+
+void UCombatProjectileSubsystem::Integrate(float DeltaTime)
+{
+    COMBAT_CSV_SCOPE_IN(Traces, Projectiles);
+    COMBAT_TRACE_SCOPE(CombatProjectile_Integrate);
+
+    UWorld* World = GetWorld();
+    if (!World || Locations.Num() == 0)
+    {
+        return;
+    }
+
+    // Expire first so the integration pass below runs over projectiles still in flight only
+    for (int32 Index = Locations.Num() - 1; Index >= 0; --Index)
+    {
+        TimesLeft[Index] -= DeltaTime;
+        if (TimesLeft[Index] <= 0.0f || !Weapons[Index].IsValid())
+        {
+            RemoveAt(Index);
+        }
+    }
+
+    const int32 NumProjectiles = Locations.Num();
+    if (NumProjectiles == 0)
+    {
+        return;
+    }
+
+    // Previous locations are the sweep starts; semi-implicit Euler over the dense arrays
+    TArray<FVector, TInlineAllocator<64>> StartLocations(Locations.GetData(), NumProjectiles);
+    const float GravityZ = World->GetGravityZ();
+    for (int32 Index = 0; Index < NumProjectiles; ++Index)
+    {
+        Velocities[Index].Z += GravityZ * GravityScales[Index] * DeltaTime;
+        Locations[Index] += Velocities[Index] * DeltaTime;
+    }
+
+    UWeaponTraceSubsystem* TraceSubsystem = World->GetSubsystem<UWeaponTraceSubsystem>();
+    if (!TraceSubsystem)
+    {
+        return;
+    }
+
+    FMeleeTraceRequest Request;
+    for (int32 Index = 0; Index < NumProjectiles; ++Index)
+    {
+        const UWeaponComponent* Weapon = Weapons[Index].Get();
+
+        Request.Start = StartLocations[Index];
+        Request.End = Locations[Index];
+        Request.Radius = Radii[Index];
+        Request.ObjectParams = Weapon->bUseHurtboxes ? FCollisionObjectQueryParams(UHurtboxComponent::HurtboxChannel) : FCollisionObjectQueryParams(Weapon->TraceChannel);
+        if (StopOnWorld[Index])
+        {
+            Request.ObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
+        }
+
+        // Not the swing params: those ignore whatever the current swing has already hit
+        Request.QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(CombatProjectile), false, Weapon->GetOwner());
+
+        FCombatProjectileHandle Projectile;
+        Projectile.Slot = DenseSlots[Index];
+        Projectile.Serial = SlotSerials[Projectile.Slot];
+        TraceSubsystem->QueueProjectileTrace(Projectile, Request);
+    }
+}
+
+void UCombatProjectileSubsystem::HandleTraceHits(FCombatProjectileHandle Projectile, const TArray<FHitResult>& Hits)
+{
+    // Stopped since its sweep went out (earlier hit, lifetime, Stop)
+    const int32 Index = GetDenseIndex(Projectile);
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    UWeaponComponent* Weapon = Weapons[Index].Get();
+    if (!Weapon)
+    {
+        RemoveAt(Index);
+        return;
+    }
+
+    // Hits are sorted along the sweep, so the first world hit ends the flight
+    for (const FHitResult& Hit : Hits)
+    {
+        const UPrimitiveComponent* HitComponent = Hit.GetComponent();
+        if (StopOnWorld[Index] && HitComponent && HitComponent->GetCollisionObjectType() == ECC_WorldStatic)
+        {
+            RemoveAt(Index);
+            return;
+        }
+
+        AActor* HitActor = Hit.GetActor();
+        if (!HitActor || HitActors[Index].Contains(FObjectKey(HitActor)))
+        {
+            continue;
+        }
+
+        HitActors[Index].Add(FObjectKey(HitActor));
+        if (Weapon->ProcessProjectileHit(Hit, Attacks[Index]) && --HitsLeft[Index] <= 0)
+        {
+            RemoveAt(Index);
+            return;
+        }
+    }
+}
+
+int32 UCombatProjectileSubsystem::GetDenseIndex(FCombatProjectileHandle Projectile) const
+{
+    if (!SlotSerials.IsValidIndex(Projectile.Slot) || SlotSerials[Projectile.Slot] != Projectile.Serial)
+    {
+        return INDEX_NONE;
+    }
+
+    return SlotDenseIndices[Projectile.Slot];
+}
+
+void UCombatProjectileSubsystem::RemoveAt(int32 Index)
+{
+    // Retire the slot: its handles go stale, and it's reused by the next launch
+    const int32 Slot = DenseSlots[Index];
+    ++SlotSerials[Slot];
+    SlotDenseIndices[Slot] = INDEX_NONE;
+    FreeSlots.Add(Slot);
+
+    Locations.RemoveAtSwap(Index, EAllowShrinking::No);
+    Velocities.RemoveAtSwap(Index, EAllowShrinking::No);
+    GravityScales.RemoveAtSwap(Index, EAllowShrinking::No);
+    Radii.RemoveAtSwap(Index, EAllowShrinking::No);
+    TimesLeft.RemoveAtSwap(Index, EAllowShrinking::No);
+    HitsLeft.RemoveAtSwap(Index, EAllowShrinking::No);
+    StopOnWorld.RemoveAtSwap(Index, EAllowShrinking::No);
+    Weapons.RemoveAtSwap(Index, EAllowShrinking::No);
+    DenseSlots.RemoveAtSwap(Index, EAllowShrinking::No);
+    HitActors.RemoveAtSwap(Index, EAllowShrinking::No);
+    Attacks.RemoveAtSwap(Index, EAllowShrinking::No);
+
+    // The projectile that was last now lives at Index
+    if (DenseSlots.IsValidIndex(Index))
+    {
+        SlotDenseIndices[DenseSlots[Index]] = Index;
+    }
+}
@@ -0,0 +1,274 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatRegistrySubsystem.h"
+#include "Core/CombatComponent.h"
+#include "Core/TargetingComponent.h"
+#include "Core/WeaponComponent.h"
+#include "GameFramework/Actor.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatRegistrySubsystem::Deinitialize()
+{
+    Combatants.Empty();
+    Actors.Empty();
+    ActorKeys.Empty();
+    PositionsX.Empty();
+    PositionsY.Empty();
+    PositionsZ.Empty();
+    States.Empty();
+    Phases.Empty();
+    Flags.Empty();
+    Targets.Empty();
+    TargetKeys.Empty();
+    TargetIndices.Empty();
+    CombatantIndices.Empty();
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+void UCombatRegistrySubsystem::RegisterCombatant(UCombatComponent* CombatComponent)
+{
+    AActor* Owner = CombatComponent ? CombatComponent->GetOwner() : nullptr;
+    if (!Owner || CombatantIndices.Contains(FObjectKey(Owner)))
+    {
+        return;
+    }
+
+    const int32 Index = Combatants.Add(CombatComponent);
+    Actors.Add(Owner);
+    ActorKeys.Add(FObjectKey(Owner));
+    PositionsX.AddZeroed();
+    PositionsY.AddZeroed();
+    PositionsZ.AddZeroed();
+    States.Add(ECombatState::Idle);
+    Phases.Add(EAttackPhase::None);
+    Flags.Add(ECombatantFlags::None);
+    Targets.AddDefaulted();
+    TargetKeys.AddDefaulted();
+    TargetIndices.Add(INDEX_NONE);
+
+    CombatantIndices.Add(FObjectKey(Owner), Index);
+
+    // Valid for queries this frame; target indices resolve on the next refresh
+    SampleCombatant(Index, *CombatComponent);
+}
+
+void UCombatRegistrySubsystem::UnregisterCombatant(UCombatComponent* CombatComponent)
+{
+    if (const int32* Index = CombatComponent ? CombatantIndices.Find(FObjectKey(CombatComponent->GetOwner())) : nullptr)
+    {
+        RemoveAtIndex(*Index);
+    }
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+int32 UCombatRegistrySubsystem::GetAttackersOf(const AActor* Target, TArray<AActor*>& OutAttackers, float MaxRange)
+{
+    RefreshIfStale();
+
+    if (!Target)
+    {
+        return 0;
+    }
+
+    const int32* TargetIndex = CombatantIndices.Find(FObjectKey(Target));
+    const FVector TargetLocation = TargetIndex ? GetCombatantLocation(*TargetIndex) : Target->GetActorLocation();
+    const float MaxRangeSq = MaxRange > 0.0f ? FMath::Square(MaxRange) : TNumericLimits<float>::Max();
+    const FObjectKey TargetKey(Target);
+    const int32 StartNum = OutAttackers.Num();
+
+    for (int32 Index = 0; Index < Flags.Num(); ++Index)
+    {
+        if (!EnumHasAnyFlags(Flags[Index], ECombatantFlags::Attacking) || TargetKeys[Index] != TargetKey)
+        {
+            continue;
+        }
+
+        const float DX = PositionsX[Index] - TargetLocation.X;
+        const float DY = PositionsY[Index] - TargetLocation.Y;
+        const float DZ = PositionsZ[Index] - TargetLocation.Z;
+        if (DX * DX + DY * DY + DZ * DZ > MaxRangeSq)
+        {
+            continue;
+        }
+
+        if (AActor* Attacker = Actors[Index].Get())
+        {
+            OutAttackers.Add(Attacker);
+        }
+    }
+
+    return OutAttackers.Num() - StartNum;
+}
+
+int32 UCombatRegistrySubsystem::GetCombatantsTargeting(const AActor* Target, TArray<AActor*>& OutCombatants)
+{
+    RefreshIfStale();
+
+    const FObjectKey TargetKey(Target);
+    const int32 StartNum = OutCombatants.Num();
+
+    for (int32 Index = 0; Index < TargetKeys.Num(); ++Index)
+    {
+        if (Target && TargetKeys[Index] == TargetKey)
+        {
+            if (AActor* Combatant = Actors[Index].Get())
+            {
+                OutCombatants.Add(Combatant);
+            }
+        }
+    }
+
+    return OutCombatants.Num() - StartNum;
+}
+
+int32 UCombatRegistrySubsystem::GetCombatantsWithFlags(ECombatantFlags InFlags, TArray<AActor*>& OutCombatants, const AActor* IgnoreActor)
+{
+    RefreshIfStale();
+
+    const int32 StartNum = OutCombatants.Num();
+
+    for (int32 Index = 0; Index < Flags.Num(); ++Index)
+    {
+        if (!EnumHasAnyFlags(Flags[Index], InFlags))
+        {
+            continue;
+        }
+
+        AActor* Combatant = Actors[Index].Get();
+        if (Combatant && Combatant != IgnoreActor)
+        {
+            OutCombatants.Add(Combatant);
+        }
+    }
+
+    return OutCombatants.Num() - StartNum;
+}
+
+bool UCombatRegistrySubsystem::IsAttacking(const AActor* Attacker, const AActor* Target)
+{
+    const int32 Index = FindCombatant(Attacker);
+    return Index != INDEX_NONE && Target
+        && EnumHasAnyFlags(Flags[Index], ECombatantFlags::Attacking)
+        && TargetKeys[Index] == FObjectKey(Target);
+}
+
+int32 UCombatRegistrySubsystem::FindCombatant(const AActor* Actor)
+{
+    RefreshIfStale();
+
+    const int32* Index = Actor ? CombatantIndices.Find(FObjectKey(Actor)) : nullptr;
+    return Index ? *Index : INDEX_NONE;
+}
+
+void UCombatRegistrySubsystem::RefreshCombatants()
+{
+    LastRefreshFrame = GFrameCounter;
+
+    for (int32 Index = Combatants.Num() - 1; Index >= 0; --Index)
+    {
+        const UCombatComponent* CombatComponent = Combatants[Index].Get();
+        if (!CombatComponent || !Actors[Index].IsValid())
+        {
+            RemoveAtIndex(Index);
+            continue;
+        }
+
+        SampleCombatant(Index, *CombatComponent);
+    }
+
+    // Second pass once every slot is final: targets that are combatants themselves get their index
+    for (int32 Index = 0; Index < TargetKeys.Num(); ++Index)
+    {
+        const int32* TargetIndex = Targets[Index].IsValid() ? CombatantIndices.Find(TargetKeys[Index]) : nullptr;
+        TargetIndices[Index] = TargetIndex ? *TargetIndex : INDEX_NONE;
+    }
+}
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+void UCombatRegistrySubsystem::SampleCombatant(int32 Index, const UCombatComponent& CombatComponent)
+{
+    const FVector Location = Actors[Index]->GetActorLocation();
+    PositionsX[Index] = Location.X;
+    PositionsY[Index] = Location.Y;
+    PositionsZ[Index] = Location.Z;
+
+    States[Index] = CombatComponent.CurrentState;
+    Phases[Index] = CombatComponent.CurrentPhase;
+
+    ECombatantFlags CombatantFlags = ECombatantFlags::None;
+    if (CombatComponent.IsAttacking())
+    {
+        CombatantFlags |= ECombatantFlags::Attacking;
+    }
+    if (CombatComponent.IsBlocking())
+    {
+        CombatantFlags |= ECombatantFlags::Blocking;
+    }
+    if (CombatComponent.bIsInParryWindow)
+    {
+        CombatantFlags |= ECombatantFlags::ParryWindow;
+    }
+    if (CombatComponent.bIsInCounterWindow)
+    {
+        CombatantFlags |= ECombatantFlags::CounterWindow;
+    }
+    if (CombatComponent.WeaponComponent && CombatComponent.WeaponComponent->IsHitDetectionEnabled())
+    {
+        CombatantFlags |= ECombatantFlags::HitDetection;
+    }
+    Flags[Index] = CombatantFlags;
+
+    AActor* Target = CombatComponent.TargetingComponent ? CombatComponent.TargetingComponent->GetCurrentTarget() : nullptr;
+    Targets[Index] = Target;
+    TargetKeys[Index] = Target ? FObjectKey(Target) : FObjectKey();
+}
+
+void UCombatRegistrySubsystem::RemoveAtIndex(int32 Index)
+{
+    if (!Combatants.IsValidIndex(Index))
+    {
+        return;
+    }
+
+    CombatantIndices.Remove(ActorKeys[Index]);
+
+    // Move last entry into the freed slot and patch its index
+    const int32 LastIndex = Combatants.Num() - 1;
+    if (Index != LastIndex)
+    {
+        CombatantIndices.Add(ActorKeys[LastIndex], Index);
+    }
+
+    Combatants.RemoveAtSwap(Index);
+    Actors.RemoveAtSwap(Index);
+    ActorKeys.RemoveAtSwap(Index);
+    PositionsX.RemoveAtSwap(Index);
+    PositionsY.RemoveAtSwap(Index);
+    PositionsZ.RemoveAtSwap(Index);
+    States.RemoveAtSwap(Index);
+    Phases.RemoveAtSwap(Index);
+    Flags.RemoveAtSwap(Index);
+    Targets.RemoveAtSwap(Index);
+    TargetKeys.RemoveAtSwap(Index);
+    TargetIndices.RemoveAtSwap(Index);
+
+    // Target indices of the others may point at the moved or removed slot until the next refresh
+    for (int32& TargetIndex : TargetIndices)
+    {
+        TargetIndex = TargetIndex == Index ? INDEX_NONE : (TargetIndex == LastIndex ? Index : TargetIndex);
+    }
+}
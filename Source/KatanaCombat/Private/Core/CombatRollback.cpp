@@ -0,0 +1,283 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatRollback.h"
+
+// ============================================================================
+// SESSION
+// ============================================================================
+
+void FCombatRollbackSession::Start(const FCombatRollbackConfig& InConfig, int32 InLocalFighter)
+{
+    Config = InConfig;
+    Config.InputDelay = FMath::Max(0, Config.InputDelay);
+    Config.MaxRollbackFrames = FMath::Max(1, Config.MaxRollbackFrames);
+    LocalFighter = FMath::Clamp(InLocalFighter, 0, 1);
+
+    Sim = FCombatSimCore();
+    Sim.Config = Config.Sim;
+
+    int32 NumAttacks = 0;
+    for (int32 FighterIndex = 0; FighterIndex < 2; ++FighterIndex)
+    {
+        AttackOffsets[FighterIndex] = NumAttacks;
+        if (const FCombatDuelMoveset* Moveset = Config.Movesets[FighterIndex])
+        {
+            for (const FCombatDuelMove& Move : Moveset->Moves)
+            {
+                Sim.AddAttack(Move.Timing);
+            }
+            NumAttacks += Moveset->Moves.Num();
+        }
+
+        Sim.AddFighter();
+        Health[FighterIndex] = Config.MaxHealth[FighterIndex];
+    }
+
+    // Room for every frame between the last confirmed one and the furthest input either peer can send
+    const int32 NumSlots = FMath::RoundUpToPowerOfTwo(2 * (Config.MaxRollbackFrames + Config.InputDelay + 1));
+    Slots.Reset();
+    Slots.SetNum(NumSlots);
+    SlotMask = NumSlots - 1;
+
+    CurrentFrame = 0;
+    ConfirmedFrame = 0;
+    RollbackFrame = INDEX_NONE;
+    LastRemoteInput = FCombatRollbackInput();
+    LastRemoteFrame = INDEX_NONE;
+    ConfirmedEvents.Reset();
+    NumRollbacks = 0;
+    NumResimulatedFrames = 0;
+
+    // Nobody can have pressed anything during the first InputDelay frames
+    for (int32 Frame = 0; Frame < Config.InputDelay; ++Frame)
+    {
+        FFrameSlot& Slot = GetSlot(Frame);
+        Slot.bConfirmed[0] = true;
+        Slot.bConfirmed[1] = true;
+    }
+}
+
+int32 FCombatRollbackSession::AdvanceFrame(FCombatRollbackInput LocalInput)
+{
+    if (Slots.Num() == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    Synchronize();
+
+    // Too far ahead of the peer: wait for its inputs rather than predict further
+    if (CurrentFrame - ConfirmedFrame >= Config.MaxRollbackFrames)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 InputFrame = CurrentFrame + Config.InputDelay;
+    FFrameSlot& InputSlot = GetSlot(InputFrame);
+    InputSlot.Inputs[LocalFighter] = LocalInput;
+    InputSlot.bConfirmed[LocalFighter] = true;
+
+    SimulateFrame(CurrentFrame);
+    ++CurrentFrame;
+    UpdateConfirmed();
+
+    return InputFrame;
+}
+
+bool FCombatRollbackSession::AddRemoteInput(int32 Frame, FCombatRollbackInput Input)
+{
+    if (Slots.Num() == 0 || Frame < ConfirmedFrame)
+    {
+        // Already final (resent)
+        return Slots.Num() > 0;
+    }
+
+    if (Frame >= ConfirmedFrame + Slots.Num())
+    {
+        return false;
+    }
+
+    const int32 RemoteFighter = 1 - LocalFighter;
+    FFrameSlot& Slot = GetSlot(Frame);
+    if (Slot.bConfirmed[RemoteFighter])
+    {
+        return true;
+    }
+
+    // Simulated on a prediction that turned out wrong: redo it (and everything after) next frame
+    if (Frame < CurrentFrame && Slot.Inputs[RemoteFighter] != Input)
+    {
+        RollbackFrame = RollbackFrame == INDEX_NONE ? Frame : FMath::Min(RollbackFrame, Frame);
+    }
+
+    Slot.Inputs[RemoteFighter] = Input;
+    Slot.bConfirmed[RemoteFighter] = true;
+
+    if (Frame > LastRemoteFrame)
+    {
+        LastRemoteFrame = Frame;
+        LastRemoteInput = Input;
+    }
+
+    return true;
+}
+
+uint32 FCombatRollbackSession::ComputeChecksum() const
+{
+    uint32 Hash = Sim.ComputeChecksum();
+    Hash = HashCombineFast(Hash, GetTypeHash(Health[0]));
+    Hash = HashCombineFast(Hash, GetTypeHash(Health[1]));
+    return Hash;
+}
+
+// ============================================================================
+// FRAMES
+// ============================================================================
+
+FCombatRollbackSession::FFrameSlot& FCombatRollbackSession::GetSlot(int32 Frame)
+{
+    FFrameSlot& Slot = Slots[Frame & SlotMask];
+    if (Slot.Frame != Frame)
+    {
+        Slot.Frame = Frame;
+        Slot.Inputs[0] = FCombatRollbackInput();
+        Slot.Inputs[1] = FCombatRollbackInput();
+        Slot.bConfirmed[0] = false;
+        Slot.bConfirmed[1] = false;
+        Slot.Events.Reset();
+    }
+    return Slot;
+}
+
+void FCombatRollbackSession::SimulateFrame(int32 Frame)
+{
+    FFrameSlot& Slot = GetSlot(Frame);
+
+    Sim.SaveSnapshot(Slot.State.Sim);
+    Slot.State.Health[0] = Health[0];
+    Slot.State.Health[1] = Health[1];
+
+    // Missing inputs keep holding what the peer last held (new presses can't be guessed)
+    for (int32 FighterIndex = 0; FighterIndex < 2; ++FighterIndex)
+    {
+        if (!Slot.bConfirmed[FighterIndex])
+        {
+            Slot.Inputs[FighterIndex].Buttons = LastRemoteInput.Buttons & FCombatRollbackInput::HeldMask;
+        }
+        ApplyInput(FighterIndex, Slot.Inputs[FighterIndex]);
+    }
+
+    Sim.Step();
+
+    Slot.Events.Reset();
+    ResolveHits(Slot);
+    Sim.ResetEvents();
+}
+
+void FCombatRollbackSession::ApplyInput(int32 FighterIndex, FCombatRollbackInput Input)
+{
+    const FCombatSimFighter& Fighter = Sim.GetFighter(FighterIndex);
+
+    const bool bBlock = Input.IsDown(FCombatRollbackInput::Block);
+    if (bBlock != (Fighter.State == ECombatState::Blocking))
+    {
+        Sim.SetBlocking(FighterIndex, bBlock);
+    }
+
+    Sim.SetHoldRequested(FighterIndex, Input.IsDown(FCombatRollbackInput::Hold));
+
+    const FCombatDuelMoveset* Moveset = Config.Movesets[FighterIndex];
+    const bool bHeavy = Input.IsDown(FCombatRollbackInput::Heavy);
+    if (!Moveset || (!bHeavy && !Input.IsDown(FCombatRollbackInput::Light)))
+    {
+        return;
+    }
+
+    // Mid-swing presses chain through the combo graph, anything else starts from the root
+    int32 Move = bHeavy ? Moveset->RootHeavy : Moveset->RootLight;
+    if (Fighter.State == ECombatState::Attacking && Fighter.AttackIndex != INDEX_NONE)
+    {
+        const FCombatDuelMove& Current = Moveset->Moves[Fighter.AttackIndex - AttackOffsets[FighterIndex]];
+        Move = bHeavy ? Current.NextHeavy : Current.NextLight;
+    }
+
+    if (Move != INDEX_NONE)
+    {
+        Sim.RequestAttack(FighterIndex, AttackOffsets[FighterIndex] + Move);
+    }
+}
+
+void FCombatRollbackSession::ResolveHits(FFrameSlot& Slot)
+{
+    // By index - guard breaks add events while we go
+    for (int32 EventIndex = 0; EventIndex < Sim.GetEvents().Num(); ++EventIndex)
+    {
+        FCombatRollbackEvent& Event = Slot.Events.AddDefaulted_GetRef();
+        Event.Frame = Slot.Frame;
+        Event.SimEvent = Sim.GetEvents()[EventIndex];
+
+        const FCombatSimEvent& SimEvent = Event.SimEvent;
+        if (SimEvent.Type != ECombatSimEventType::PhaseChanged || SimEvent.Phase != EAttackPhase::Active)
+        {
+            continue;
+        }
+
+        // Duel rule: every active phase reaches the opponent
+        const int32 Attacker = SimEvent.FighterIndex;
+        const int32 Defender = 1 - Attacker;
+        const FCombatDuelMove& Move = Config.Movesets[Attacker]->Moves[SimEvent.AttackIndex - AttackOffsets[Attacker]];
+        const FCombatSimFighter& Target = Sim.GetFighter(Defender);
+
+        Event.bHit = true;
+        if (Target.State == ECombatState::Blocking)
+        {
+            Event.bBlocked = true;
+            Event.Damage = Move.Timing.PostureDamage;
+            Sim.ApplyPostureDamage(Defender, Move.Timing.PostureDamage);
+        }
+        else
+        {
+            Event.Damage = Move.Damage * (Target.State == ECombatState::GuardBroken ? Move.CounterDamageMultiplier : 1.0f);
+            Health[Defender] -= Event.Damage;
+        }
+    }
+}
+
+void FCombatRollbackSession::Synchronize()
+{
+    if (RollbackFrame != INDEX_NONE)
+    {
+        const int32 Frame = RollbackFrame;
+        RollbackFrame = INDEX_NONE;
+
+        const FFrameSlot& Slot = GetSlot(Frame);
+        Sim.RestoreSnapshot(Slot.State.Sim);
+        Health[0] = Slot.State.Health[0];
+        Health[1] = Slot.State.Health[1];
+
+        ++NumRollbacks;
+        for (int32 ResimFrame = Frame; ResimFrame < CurrentFrame; ++ResimFrame)
+        {
+            SimulateFrame(ResimFrame);
+            ++NumResimulatedFrames;
+        }
+    }
+
+    UpdateConfirmed();
+}
+
+void FCombatRollbackSession::UpdateConfirmed()
+{
+    // Simulated on both real inputs and nothing pending before it: it can't change any more
+    while (ConfirmedFrame < CurrentFrame && RollbackFrame == INDEX_NONE)
+    {
+        const FFrameSlot& Slot = Slots[ConfirmedFrame & SlotMask];
+        if (Slot.Frame != ConfirmedFrame || !Slot.bConfirmed[0] || !Slot.bConfirmed[1])
+        {
+            break;
+        }
+
+        ConfirmedEvents.Append(Slot.Events);
+        ++ConfirmedFrame;
+    }
+}
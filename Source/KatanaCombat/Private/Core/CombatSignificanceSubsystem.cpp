@@ -0,0 +1,190 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatSignificanceSubsystem.h"
+#include "Core/TargetingComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatSignificanceSubsystem::Deinitialize()
+{
+    Actors.Empty();
+    ActorKeys.Empty();
+    Ranks.Empty();
+    ActorIndices.Empty();
+
+    Super::Deinitialize();
+}
+
+void UCombatSignificanceSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    TimeUntilUpdate -= DeltaTime;
+    if (TimeUntilUpdate > 0.0f)
+    {
+        return;
+    }
+
+    TimeUntilUpdate = UpdateInterval;
+    UpdateSignificance();
+}
+
+bool UCombatSignificanceSubsystem::IsTickable() const
+{
+    return Actors.Num() > 0;
+}
+
+TStatId UCombatSignificanceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================================
+// ACTORS
+// ============================================================================
+
+void UCombatSignificanceSubsystem::RegisterActor(AActor* Actor)
+{
+    if (!Actor || ActorIndices.Contains(FObjectKey(Actor)))
+    {
+        return;
+    }
+
+    ActorIndices.Add(FObjectKey(Actor), Actors.Num());
+    Actors.Add(Actor);
+    ActorKeys.Add(FObjectKey(Actor));
+    Ranks.Add(ECombatSignificance::High);
+}
+
+void UCombatSignificanceSubsystem::UnregisterActor(AActor* Actor)
+{
+    if (const int32* Index = ActorIndices.Find(FObjectKey(Actor)))
+    {
+        RemoveAt(*Index);
+    }
+}
+
+ECombatSignificance UCombatSignificanceSubsystem::GetSignificance(const AActor* Actor) const
+{
+    const int32* Index = ActorIndices.Find(FObjectKey(Actor));
+    return Index ? Ranks[*Index] : ECombatSignificance::High;
+}
+
+ECombatSignificance UCombatSignificanceSubsystem::GetSignificanceFor(const AActor* Actor)
+{
+    const UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+    const UCombatSignificanceSubsystem* Significance = World ? World->GetSubsystem<UCombatSignificanceSubsystem>() : nullptr;
+    return Significance ? Significance->GetSignificance(Actor) : ECombatSignificance::High;
+}
+
+ECombatSignificance UCombatSignificanceSubsystem::RankActor(float Distance, float ScreenSize, bool bRecentlyRendered, bool bEngaged) const
+{
+    // Whoever is fighting the player always gets full fidelity
+    if (bEngaged)
+    {
+        return ECombatSignificance::High;
+    }
+
+    if (Distance > CullDistance || (!bRecentlyRendered && Distance > UnseenCullDistance))
+    {
+        return ECombatSignificance::Culled;
+    }
+
+    if (Distance <= HighDistance)
+    {
+        return ECombatSignificance::High;
+    }
+
+    if (!bRecentlyRendered)
+    {
+        return ECombatSignificance::Low;
+    }
+
+    if (ScreenSize >= HighScreenSize)
+    {
+        return ECombatSignificance::High;
+    }
+
+    return ScreenSize >= MediumScreenSize ? ECombatSignificance::Medium : ECombatSignificance::Low;
+}
+
+void UCombatSignificanceSubsystem::UpdateSignificance()
+{
+    APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+    const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+
+    // No local view (dedicated server, loading) - nothing to rank against
+    if (!PlayerController || !PlayerController->PlayerCameraManager)
+    {
+        for (ECombatSignificance& Rank : Ranks)
+        {
+            Rank = ECombatSignificance::High;
+        }
+        return;
+    }
+
+    const FVector ViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+    const float HalfFOVRadians = FMath::DegreesToRadians(FMath::Max(PlayerController->PlayerCameraManager->GetFOVAngle(), 1.0f) * 0.5f);
+    const float ScreenScale = 1.0f / FMath::Tan(HalfFOVRadians);
+
+    // The player's current target is engaged with the player
+    const UTargetingComponent* PlayerTargeting = PlayerPawn ? PlayerPawn->FindComponentByClass<UTargetingComponent>() : nullptr;
+    const AActor* PlayerTarget = PlayerTargeting ? PlayerTargeting->GetCurrentTarget() : nullptr;
+
+    for (int32 Index = Actors.Num() - 1; Index >= 0; --Index)
+    {
+        const AActor* Actor = Actors[Index].Get();
+        if (!Actor)
+        {
+            RemoveAt(Index);
+            continue;
+        }
+
+        // Engaged: the player, the player's target, or anyone targeting the player
+        bool bEngaged = Actor == PlayerPawn || Actor == PlayerTarget;
+        if (!bEngaged && PlayerPawn)
+        {
+            const UTargetingComponent* Targeting = Actor->FindComponentByClass<UTargetingComponent>();
+            bEngaged = Targeting && Targeting->GetCurrentTarget() == PlayerPawn;
+        }
+
+        const float Distance = FVector::Dist(ViewLocation, Actor->GetActorLocation());
+
+        // Projected bounding sphere height as a fraction of the screen height
+        FVector Origin;
+        FVector Extent;
+        Actor->GetActorBounds(true, Origin, Extent);
+        const float ScreenSize = Distance > KINDA_SMALL_NUMBER ? (Extent.Size() * ScreenScale) / Distance : 1.0f;
+
+        Ranks[Index] = RankActor(Distance, ScreenSize, Actor->WasRecentlyRendered(RecentlyRenderedTolerance), bEngaged);
+    }
+}
+
+// ============================================================================
+// INTERNAL
+// ============================================================================
+
+void UCombatSignificanceSubsystem::RemoveAt(int32 Index)
+{
+    ActorIndices.Remove(ActorKeys[Index]);
+
+    const int32 LastIndex = Actors.Num() - 1;
+    if (Index != LastIndex)
+    {
+        Actors[Index] = Actors[LastIndex];
+        ActorKeys[Index] = ActorKeys[LastIndex];
+        Ranks[Index] = Ranks[LastIndex];
+        ActorIndices.Add(ActorKeys[Index], Index);
+    }
+
+    Actors.Pop(EAllowShrinking::No);
+    ActorKeys.Pop(EAllowShrinking::No);
+    Ranks.Pop(EAllowShrinking::No);
+}
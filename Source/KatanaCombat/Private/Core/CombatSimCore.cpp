@@ -0,0 +1,402 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatSimCore.h"
+#include "Core/CombatStateTransitions.h"
+#include "Data/AttackData.h"
+#include "Data/CombatSettings.h"
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+int32 FCombatSimCore::AddFighter()
+{
+    FCombatSimFighter& Fighter = Fighters.AddDefaulted_GetRef();
+    Fighter.Posture = Config.MaxPosture;
+    return Fighters.Num() - 1;
+}
+
+// ============================================================================
+// INPUT
+// ============================================================================
+
+bool FCombatSimCore::RequestAttack(int32 FighterIndex, int32 AttackIndex)
+{
+    if (!Fighters.IsValidIndex(FighterIndex) || !Attacks.IsValidIndex(AttackIndex))
+    {
+        return false;
+    }
+
+    FCombatSimFighter& Fighter = Fighters[FighterIndex];
+
+    // Mid-attack: buffer as the follow-up (latest input wins)
+    if (Fighter.State == ECombatState::Attacking || Fighter.State == ECombatState::HoldingLightAttack)
+    {
+        Fighter.QueuedAttackIndex = AttackIndex;
+        return true;
+    }
+
+    if (!CombatStateTransitions::CanTransition(Fighter.State, ECombatState::Attacking))
+    {
+        return false;
+    }
+
+    Fighter.State = ECombatState::Attacking;
+    StartAttack(FighterIndex, AttackIndex);
+    return true;
+}
+
+void FCombatSimCore::SetHoldRequested(int32 FighterIndex, bool bHold)
+{
+    if (Fighters.IsValidIndex(FighterIndex))
+    {
+        Fighters[FighterIndex].bHoldRequested = bHold;
+    }
+}
+
+bool FCombatSimCore::SetBlocking(int32 FighterIndex, bool bBlock)
+{
+    if (!Fighters.IsValidIndex(FighterIndex))
+    {
+        return false;
+    }
+
+    FCombatSimFighter& Fighter = Fighters[FighterIndex];
+    if (bBlock)
+    {
+        return TrySetState(Fighter, ECombatState::Blocking);
+    }
+
+    return Fighter.State == ECombatState::Blocking && TrySetState(Fighter, ECombatState::Idle);
+}
+
+bool FCombatSimCore::ApplyPostureDamage(int32 FighterIndex, float Amount)
+{
+    if (!Fighters.IsValidIndex(FighterIndex))
+    {
+        return false;
+    }
+
+    FCombatSimFighter& Fighter = Fighters[FighterIndex];
+    Fighter.Posture = FMath::Max(0.0f, Fighter.Posture - Amount);
+
+    if (Fighter.Posture > 0.0f || !TrySetState(Fighter, ECombatState::GuardBroken))
+    {
+        return false;
+    }
+
+    // Guard break interrupts the attack and drops the buffered follow-up
+    Fighter.Phase = EAttackPhase::None;
+    Fighter.PhaseRemaining = 0.0f;
+    Fighter.AttackIndex = INDEX_NONE;
+    Fighter.QueuedAttackIndex = INDEX_NONE;
+    Fighter.GuardBreakRemaining = Config.GuardBreakStunDuration;
+    AddEvent(FighterIndex, ECombatSimEventType::GuardBroken);
+    return true;
+}
+
+// ============================================================================
+// SIMULATION
+// ============================================================================
+
+int32 FCombatSimCore::Advance(float DeltaTime)
+{
+    if (Config.FixedTimeStep <= 0.0f)
+    {
+        return 0;
+    }
+
+    Accumulator += FMath::Max(0.0f, DeltaTime);
+
+    int32 NumSteps = 0;
+    while (Accumulator >= Config.FixedTimeStep)
+    {
+        Accumulator -= Config.FixedTimeStep;
+        Step();
+        ++NumSteps;
+    }
+    return NumSteps;
+}
+
+void FCombatSimCore::Step()
+{
+    for (int32 i = 0; i < Fighters.Num(); ++i)
+    {
+        StepFighter(i, Config.FixedTimeStep);
+    }
+    ++StepCount;
+}
+
+void FCombatSimCore::StepFighter(int32 FighterIndex, float DeltaTime)
+{
+    FCombatSimFighter& Fighter = Fighters[FighterIndex];
+
+    Fighter.Posture = EvaluatePosture(Config, Fighter.State, Fighter.Posture, DeltaTime);
+
+    if (Fighter.State == ECombatState::GuardBroken)
+    {
+        Fighter.GuardBreakRemaining -= DeltaTime;
+        if (Fighter.GuardBreakRemaining <= 0.0f && TrySetState(Fighter, ECombatState::Idle))
+        {
+            Fighter.GuardBreakRemaining = 0.0f;
+            Fighter.Posture = FMath::Min(Config.MaxPosture, Fighter.Posture + Config.MaxPosture * Config.GuardBreakRecoveryPercent);
+            AddEvent(FighterIndex, ECombatSimEventType::GuardRecovered);
+        }
+        return;
+    }
+
+    if (Fighter.AttackIndex == INDEX_NONE)
+    {
+        // Combo chain times out between attacks
+        if (Fighter.ComboResetRemaining > 0.0f)
+        {
+            Fighter.ComboResetRemaining -= DeltaTime;
+            if (Fighter.ComboResetRemaining <= 0.0f)
+            {
+                Fighter.ComboResetRemaining = 0.0f;
+                Fighter.ComboCount = 0;
+            }
+        }
+        return;
+    }
+
+    // Holding freezes the windup (release resumes it)
+    if (Fighter.bHoldRequested && Fighter.Phase == EAttackPhase::Windup)
+    {
+        if (Fighter.State == ECombatState::Attacking)
+        {
+            TrySetState(Fighter, ECombatState::HoldingLightAttack);
+        }
+        Fighter.HoldTime += DeltaTime;
+        return;
+    }
+    if (Fighter.State == ECombatState::HoldingLightAttack)
+    {
+        TrySetState(Fighter, ECombatState::Attacking);
+    }
+
+    if (!AdvancePhase(Fighter.Phase, Fighter.PhaseRemaining, Attacks[Fighter.AttackIndex], DeltaTime))
+    {
+        return;
+    }
+
+    if (Fighter.Phase != EAttackPhase::None)
+    {
+        AddEvent(FighterIndex, ECombatSimEventType::PhaseChanged, Fighter.Phase, Fighter.AttackIndex);
+        return;
+    }
+
+    // Recovered: chain the buffered follow-up or drop back to idle
+    const int32 FinishedAttack = Fighter.AttackIndex;
+    Fighter.AttackIndex = INDEX_NONE;
+    AddEvent(FighterIndex, ECombatSimEventType::AttackFinished, EAttackPhase::None, FinishedAttack);
+
+    if (Fighter.QueuedAttackIndex != INDEX_NONE)
+    {
+        const int32 NextAttack = Fighter.QueuedAttackIndex;
+        Fighter.QueuedAttackIndex = INDEX_NONE;
+        StartAttack(FighterIndex, NextAttack);
+    }
+    else
+    {
+        TrySetState(Fighter, ECombatState::Idle);
+        Fighter.ComboResetRemaining = Config.ComboResetDelay;
+    }
+}
+
+void FCombatSimCore::StartAttack(int32 FighterIndex, int32 AttackIndex)
+{
+    FCombatSimFighter& Fighter = Fighters[FighterIndex];
+    Fighter.AttackIndex = AttackIndex;
+    Fighter.Phase = EAttackPhase::Windup;
+    Fighter.PhaseRemaining = Attacks[AttackIndex].Windup;
+    Fighter.HoldTime = 0.0f;
+    Fighter.ComboResetRemaining = 0.0f;
+    ++Fighter.ComboCount;
+
+    AddEvent(FighterIndex, ECombatSimEventType::AttackStarted, EAttackPhase::Windup, AttackIndex);
+}
+
+bool FCombatSimCore::TrySetState(FCombatSimFighter& Fighter, ECombatState NewState)
+{
+    if (!CombatStateTransitions::CanTransition(Fighter.State, NewState))
+    {
+        return false;
+    }
+
+    Fighter.State = NewState;
+    return true;
+}
+
+void FCombatSimCore::AddEvent(int32 FighterIndex, ECombatSimEventType Type, EAttackPhase Phase, int32 AttackIndex)
+{
+    FCombatSimEvent& Event = Events.AddDefaulted_GetRef();
+    Event.FighterIndex = FighterIndex;
+    Event.Type = Type;
+    Event.Phase = Phase;
+    Event.AttackIndex = AttackIndex;
+}
+
+uint32 FCombatSimCore::ComputeChecksum() const
+{
+    // Field by field - struct padding isn't deterministic
+    uint32 Hash = GetTypeHash(StepCount);
+    for (const FCombatSimFighter& Fighter : Fighters)
+    {
+        Hash = HashCombineFast(Hash, GetTypeHash(static_cast<uint8>(Fighter.State)));
+        Hash = HashCombineFast(Hash, GetTypeHash(static_cast<uint8>(Fighter.Phase)));
+        Hash = HashCombineFast(Hash, GetTypeHash(Fighter.PhaseRemaining));
+        Hash = HashCombineFast(Hash, GetTypeHash(Fighter.Posture));
+        Hash = HashCombineFast(Hash, GetTypeHash(Fighter.AttackIndex));
+        Hash = HashCombineFast(Hash, GetTypeHash(Fighter.QueuedAttackIndex));
+        Hash = HashCombineFast(Hash, GetTypeHash(Fighter.ComboCount));
+        Hash = HashCombineFast(Hash, GetTypeHash(Fighter.ComboResetRemaining));
+        Hash = HashCombineFast(Hash, GetTypeHash(Fighter.GuardBreakRemaining));
+        Hash = HashCombineFast(Hash, GetTypeHash(Fighter.bHoldRequested));
+        Hash = HashCombineFast(Hash, GetTypeHash(Fighter.HoldTime));
+    }
+    return Hash;
+}
+
+// ============================================================================
+// SNAPSHOTS
+// ============================================================================
+
+bool FCombatSimCore::SaveSnapshot(FCombatSimSnapshot& OutSnapshot) const
+{
+    if (Fighters.Num() > FCombatSimSnapshot::MaxFighters)
+    {
+        return false;
+    }
+
+    FMemory::Memcpy(OutSnapshot.Fighters, Fighters.GetData(), Fighters.Num() * sizeof(FCombatSimFighter));
+    OutSnapshot.NumFighters = Fighters.Num();
+    OutSnapshot.Accumulator = Accumulator;
+    OutSnapshot.StepCount = StepCount;
+    return true;
+}
+
+void FCombatSimCore::RestoreSnapshot(const FCombatSimSnapshot& Snapshot)
+{
+    check(Snapshot.NumFighters == Fighters.Num());
+
+    FMemory::Memcpy(Fighters.GetData(), Snapshot.Fighters, Snapshot.NumFighters * sizeof(FCombatSimFighter));
+    Accumulator = Snapshot.Accumulator;
+    StepCount = Snapshot.StepCount;
+}
+
+// ============================================================================
+// SHARED RULES
+// ============================================================================
+
+float FCombatSimCore::GetPostureRegenRate(const FCombatSimConfig& InConfig, ECombatState State)
+{
+    switch (State)
+    {
+        case ECombatState::Attacking:
+        case ECombatState::ChargingHeavyAttack:
+        case ECombatState::HoldingLightAttack:
+            return InConfig.PostureRegenRate_Attacking;
+
+        case ECombatState::Blocking:
+        case ECombatState::GuardBroken:
+            return 0.0f;
+
+        case ECombatState::Idle:
+        case ECombatState::Evading:
+        default:
+            return InConfig.PostureRegenRate_Idle;
+    }
+}
+
+float FCombatSimCore::EvaluatePosture(const FCombatSimConfig& InConfig, ECombatState State, float Posture, float Elapsed)
+{
+    const float RegenRate = GetPostureRegenRate(InConfig, State);
+    if (RegenRate <= 0.0f)
+    {
+        return Posture;
+    }
+
+    return FMath::Min(InConfig.MaxPosture, Posture + RegenRate * FMath::Max(0.0f, Elapsed));
+}
+
+bool FCombatSimCore::AdvancePhase(EAttackPhase& Phase, float& PhaseRemaining, const FCombatSimAttackTiming& Timing, float DeltaTime)
+{
+    if (Phase == EAttackPhase::None)
+    {
+        return false;
+    }
+
+    PhaseRemaining -= DeltaTime;
+    if (PhaseRemaining > 0.0f)
+    {
+        return false;
+    }
+
+    switch (Phase)
+    {
+        case EAttackPhase::Windup:
+            Phase = EAttackPhase::Active;
+            PhaseRemaining += Timing.Active;
+            break;
+
+        case EAttackPhase::Active:
+            Phase = EAttackPhase::Recovery;
+            PhaseRemaining += Timing.Recovery;
+            break;
+
+        default:
+            Phase = EAttackPhase::None;
+            PhaseRemaining = 0.0f;
+            break;
+    }
+    return true;
+}
+
+// ============================================================================
+// COOKING
+// ============================================================================
+
+FCombatSimAttackTiming FCombatSimCore::CookAttackTiming(const UAttackData* Attack)
+{
+    FCombatSimAttackTiming Timing;
+    if (!Attack)
+    {
+        return Timing;
+    }
+
+    Timing.PostureDamage = Attack->PostureDamage;
+
+    // Folded durations (legacy phase states, else manual timing) - also valid without a montage
+    FAttackTimingCache Scratch;
+    const FAttackTimingCache& Cache = Attack->GetTimingCache(Scratch);
+    Timing.Windup = Cache.PhaseDurations.WindupDuration;
+    Timing.Active = Cache.PhaseDurations.ActiveDuration;
+    Timing.Recovery = Cache.PhaseDurations.RecoveryDuration;
+
+    // Phase transition notifies give the exact split of the section
+    if (Attack->AttackMontage && Cache.ActiveTransitionTime >= Cache.SectionStart && Cache.RecoveryTransitionTime >= Cache.ActiveTransitionTime)
+    {
+        Timing.Windup = Cache.ActiveTransitionTime - Cache.SectionStart;
+        Timing.Active = Cache.RecoveryTransitionTime - Cache.ActiveTransitionTime;
+        Timing.Recovery = FMath::Max(Cache.SectionEnd - Cache.RecoveryTransitionTime, 0.0f);
+    }
+
+    return Timing;
+}
+
+FCombatSimConfig FCombatSimCore::CookConfig(const UCombatSettings* Settings)
+{
+    FCombatSimConfig SimConfig;
+    if (!Settings)
+    {
+        return SimConfig;
+    }
+
+    SimConfig.MaxPosture = Settings->MaxPosture;
+    SimConfig.PostureRegenRate_Attacking = Settings->PostureRegenRate_Attacking;
+    SimConfig.PostureRegenRate_Idle = Settings->PostureRegenRate_Idle;
+    SimConfig.GuardBreakStunDuration = Settings->GuardBreakStunDuration;
+    SimConfig.GuardBreakRecoveryPercent = Settings->GuardBreakRecoveryPercent;
+    return SimConfig;
+}
@@ -0,0 +1,110 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatTickManagerSubsystem.h"
+#include "Core/CombatComponent.h"
+#include "Async/ParallelFor.h"
+#include "Debug/CombatTrace.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatTickManagerSubsystem::Deinitialize()
+{
+    Components.Empty();
+    Gathered.Empty();
+    Inputs.Empty();
+    Outputs.Empty();
+
+    Super::Deinitialize();
+}
+
+bool UCombatTickManagerSubsystem::IsTickable() const
+{
+    return Components.Num() > 0;
+}
+
+TStatId UCombatTickManagerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatTickManagerSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatTickManagerSubsystem::Tick(float DeltaTime)
+{
+    COMBAT_TRACE_SCOPE(UCombatTickManagerSubsystem::Tick);
+
+    Super::Tick(DeltaTime);
+
+    // Pass 1: gather (game thread - reads UObjects)
+    Gathered.Reset();
+    Inputs.Reset();
+
+    for (int32 i = Components.Num() - 1; i >= 0; --i)
+    {
+        UCombatComponent* CombatComponent = Components[i].Get();
+        if (!CombatComponent)
+        {
+            Components.RemoveAtSwap(i, EAllowShrinking::No);
+            continue;
+        }
+
+        Gathered.Add(CombatComponent);
+        CombatComponent->GatherBatchedTick(Inputs.AddDefaulted_GetRef());
+    }
+
+    // Pass 2: evaluate (worker threads - plain data only)
+    EvaluateBatch(Inputs, DeltaTime, Outputs, MinParallelBatch);
+
+    // Pass 3: write back and apply side effects (game thread, serial)
+    for (int32 i = 0; i < Gathered.Num(); ++i)
+    {
+        // An earlier write-back's side effects may have destroyed this one
+        if (IsValid(Gathered[i]))
+        {
+            Gathered[i]->ApplyBatchedTick(Outputs[i]);
+        }
+    }
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+void UCombatTickManagerSubsystem::RegisterCombatComponent(UCombatComponent* CombatComponent)
+{
+    if (CombatComponent)
+    {
+        Components.AddUnique(CombatComponent);
+    }
+}
+
+void UCombatTickManagerSubsystem::UnregisterCombatComponent(UCombatComponent* CombatComponent)
+{
+    Components.RemoveSwap(CombatComponent, EAllowShrinking::No);
+}
+
+// ============================================================================
+// EVALUATION
+// ============================================================================
+
+void UCombatTickManagerSubsystem::Evaluate(const FCombatTickInput& Input, float DeltaTime, FCombatTickOutput& Output)
+{
+    Output.Posture = Input.Posture;
+    Output.bPostureChanged = false;
+    if (Input.PostureRegenRate > 0.0f && Input.Posture < Input.MaxPosture)
+    {
+        Output.Posture = FMath::Min(Input.MaxPosture, Input.Posture + Input.PostureRegenRate * DeltaTime);
+        Output.bPostureChanged = true;
+    }
+}
+
+void UCombatTickManagerSubsystem::EvaluateBatch(TConstArrayView<FCombatTickInput> Inputs, float DeltaTime, TArray<FCombatTickOutput>& OutOutputs, int32 MinParallelBatch)
+{
+    OutOutputs.SetNumUninitialized(Inputs.Num(), EAllowShrinking::No);
+
+    const EParallelForFlags Flags = Inputs.Num() < MinParallelBatch ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+    ParallelFor(Inputs.Num(), [Inputs, DeltaTime, &OutOutputs](int32 Index)
+    {
+        Evaluate(Inputs[Index], DeltaTime, OutOutputs[Index]);
+    }, Flags);
+}
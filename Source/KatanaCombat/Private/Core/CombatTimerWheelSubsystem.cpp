@@ -0,0 +1,307 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatTimerWheelSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Debug/CombatTrace.h"
+
+// ============================================================================
+// TICK FUNCTION
+// ============================================================================
+
+void FCombatTimerWheelTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Target && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Target->Advance(DeltaTime);
+    }
+}
+
+FString FCombatTimerWheelTickFunction::DiagnosticMessage()
+{
+    return TEXT("UCombatTimerWheelSubsystem::Advance");
+}
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatTimerWheelSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    for (int32& Head : ListHeads)
+    {
+        Head = INDEX_NONE;
+    }
+
+    // Enough for a crowded encounter without growing mid-fight
+    Nodes.Reserve(256);
+
+    TickFunction.Target = this;
+    TickFunction.bCanEverTick = true;
+    TickFunction.TickGroup = TG_PrePhysics;
+}
+
+void UCombatTimerWheelSubsystem::Deinitialize()
+{
+    if (TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.UnRegisterTickFunction();
+    }
+    TickFunction.Target = nullptr;
+
+    for (int32& Head : ListHeads)
+    {
+        Head = INDEX_NONE;
+    }
+    Nodes.Empty();
+    FreeHead = INDEX_NONE;
+    NumActiveTimers = 0;
+
+    Super::Deinitialize();
+}
+
+void UCombatTimerWheelSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (InWorld.PersistentLevel && !TickFunction.IsTickFunctionRegistered())
+    {
+        TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+    }
+}
+
+void UCombatTimerWheelSubsystem::Advance(float DeltaTime)
+{
+    COMBAT_TRACE_SCOPE(UCombatTimerWheelSubsystem::Advance);
+
+    Accumulator += FMath::Max(0.0f, DeltaTime);
+    const uint64 StepsDue = static_cast<uint64>(Accumulator / Resolution);
+    Accumulator -= StepsDue * Resolution;
+
+    // Empty wheel - nothing can cascade or fire, just move the clock
+    if (NumActiveTimers == 0)
+    {
+        CurrentTick += StepsDue;
+        return;
+    }
+
+    for (uint64 i = 0; i < StepsDue; ++i)
+    {
+        Step();
+    }
+}
+
+// ============================================================================
+// TIMERS
+// ============================================================================
+
+FCombatTimerHandle UCombatTimerWheelSubsystem::Schedule(UObject* Object, FTimerThunk Thunk, float Delay)
+{
+    FCombatTimerHandle Handle;
+    if (!Object || !Thunk)
+    {
+        return Handle;
+    }
+
+    int32 NodeIndex = FreeHead;
+    if (NodeIndex != INDEX_NONE)
+    {
+        FreeHead = Nodes[NodeIndex].Next;
+    }
+    else
+    {
+        NodeIndex = Nodes.AddDefaulted();
+    }
+
+    // Time of tick N is (N - CurrentTick) * Resolution - Accumulator from now
+    const uint64 DelayTicks = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble((FMath::Max(0.0f, Delay) + Accumulator) / Resolution)));
+
+    FTimerNode& Node = Nodes[NodeIndex];
+    Node.Object = Object;
+    Node.Thunk = Thunk;
+    Node.ExpireTick = CurrentTick + DelayTicks;
+    InsertNode(NodeIndex);
+    ++NumActiveTimers;
+
+    Handle.Index = NodeIndex;
+    Handle.Serial = Node.Serial;
+    return Handle;
+}
+
+bool UCombatTimerWheelSubsystem::ClearTimer(FCombatTimerHandle& InOutHandle)
+{
+    const bool bWasActive = FindNode(InOutHandle) != nullptr;
+    if (bWasActive)
+    {
+        FreeNode(InOutHandle.Index);
+    }
+
+    InOutHandle.Invalidate();
+    return bWasActive;
+}
+
+bool UCombatTimerWheelSubsystem::IsTimerActive(const FCombatTimerHandle& Handle) const
+{
+    return FindNode(Handle) != nullptr;
+}
+
+float UCombatTimerWheelSubsystem::GetTimerRemaining(const FCombatTimerHandle& Handle) const
+{
+    const FTimerNode* Node = FindNode(Handle);
+    if (!Node)
+    {
+        return 0.0f;
+    }
+
+    return FMath::Max(0.0f, (Node->ExpireTick - CurrentTick) * Resolution - Accumulator);
+}
+
+const UCombatTimerWheelSubsystem::FTimerNode* UCombatTimerWheelSubsystem::FindNode(const FCombatTimerHandle& Handle) const
+{
+    if (!Nodes.IsValidIndex(Handle.Index))
+    {
+        return nullptr;
+    }
+
+    const FTimerNode& Node = Nodes[Handle.Index];
+    return (Node.Serial == Handle.Serial && Node.List != INDEX_NONE) ? &Node : nullptr;
+}
+
+// ============================================================================
+// WHEEL
+// ============================================================================
+
+void UCombatTimerWheelSubsystem::InsertNode(int32 NodeIndex)
+{
+    FTimerNode& Node = Nodes[NodeIndex];
+
+    // Further out than the top level spans - park at the horizon
+    constexpr uint64 MaxDelta = (uint64(1) << (SlotBits * NumLevels)) - 1;
+    if (Node.ExpireTick - CurrentTick > MaxDelta)
+    {
+        Node.ExpireTick = CurrentTick + MaxDelta;
+    }
+
+    // Lowest level whose span covers the remaining ticks
+    const uint64 Delta = Node.ExpireTick - CurrentTick;
+    int32 Level = 0;
+    while (Level < NumLevels - 1 && Delta >= (uint64(1) << (SlotBits * (Level + 1))))
+    {
+        ++Level;
+    }
+
+    const int32 Slot = static_cast<int32>((Node.ExpireTick >> (SlotBits * Level)) & SlotMask);
+    LinkNode(NodeIndex, Level * SlotsPerLevel + Slot);
+}
+
+void UCombatTimerWheelSubsystem::LinkNode(int32 NodeIndex, int32 List)
+{
+    FTimerNode& Node = Nodes[NodeIndex];
+    Node.List = List;
+    Node.Prev = INDEX_NONE;
+    Node.Next = ListHeads[List];
+    if (Node.Next != INDEX_NONE)
+    {
+        Nodes[Node.Next].Prev = NodeIndex;
+    }
+    ListHeads[List] = NodeIndex;
+}
+
+void UCombatTimerWheelSubsystem::UnlinkNode(int32 NodeIndex)
+{
+    FTimerNode& Node = Nodes[NodeIndex];
+    if (Node.Prev != INDEX_NONE)
+    {
+        Nodes[Node.Prev].Next = Node.Next;
+    }
+    else
+    {
+        ListHeads[Node.List] = Node.Next;
+    }
+
+    if (Node.Next != INDEX_NONE)
+    {
+        Nodes[Node.Next].Prev = Node.Prev;
+    }
+
+    Node.Prev = INDEX_NONE;
+    Node.Next = INDEX_NONE;
+    Node.List = INDEX_NONE;
+}
+
+void UCombatTimerWheelSubsystem::FreeNode(int32 NodeIndex)
+{
+    UnlinkNode(NodeIndex);
+
+    FTimerNode& Node = Nodes[NodeIndex];
+    Node.Object.Reset();
+    Node.Thunk = nullptr;
+    ++Node.Serial;
+    Node.Next = FreeHead;
+    FreeHead = NodeIndex;
+
+    --NumActiveTimers;
+}
+
+void UCombatTimerWheelSubsystem::Cascade(int32 Level)
+{
+    const int32 Slot = static_cast<int32>((CurrentTick >> (SlotBits * Level)) & SlotMask);
+    const int32 List = Level * SlotsPerLevel + Slot;
+
+    // Detach the whole slot, then redistribute (every node now expires within this level's slot span)
+    int32 NodeIndex = ListHeads[List];
+    ListHeads[List] = INDEX_NONE;
+
+    while (NodeIndex != INDEX_NONE)
+    {
+        const int32 Next = Nodes[NodeIndex].Next;
+        InsertNode(NodeIndex);
+        NodeIndex = Next;
+    }
+}
+
+void UCombatTimerWheelSubsystem::Step()
+{
+    ++CurrentTick;
+
+    // Crossing a level boundary pulls the next slot of the level above down
+    for (int32 Level = 1; Level < NumLevels; ++Level)
+    {
+        if ((CurrentTick & ((uint64(1) << (SlotBits * Level)) - 1)) != 0)
+        {
+            break;
+        }
+        Cascade(Level);
+    }
+
+    const int32 Slot = static_cast<int32>(CurrentTick & SlotMask);
+    if (ListHeads[Slot] == INDEX_NONE)
+    {
+        return;
+    }
+
+    // Move the due slot to the firing list so callbacks can set/clear timers freely
+    ListHeads[FiringList] = ListHeads[Slot];
+    ListHeads[Slot] = INDEX_NONE;
+    for (int32 NodeIndex = ListHeads[FiringList]; NodeIndex != INDEX_NONE; NodeIndex = Nodes[NodeIndex].Next)
+    {
+        Nodes[NodeIndex].List = FiringList;
+    }
+
+    while (ListHeads[FiringList] != INDEX_NONE)
+    {
+        const int32 NodeIndex = ListHeads[FiringList];
+        UObject* Object = Nodes[NodeIndex].Object.Get();
+        const FTimerThunk Thunk = Nodes[NodeIndex].Thunk;
+
+        // Free before the call - the callback may reschedule through the same handle
+        FreeNode(NodeIndex);
+
+        if (Object)
+        {
+            Thunk(Object);
+        }
+    }
+}
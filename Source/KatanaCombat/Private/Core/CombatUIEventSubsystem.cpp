@@ -0,0 +1,200 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CombatUIEventSubsystem.h"
+#include "Core/CombatComponent.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UCombatUIEventSubsystem::Deinitialize()
+{
+    OnCombatUIUpdate.Clear();
+    OnCombatUIUpdateNative.Clear();
+    StateIndices.Empty();
+    States.Empty();
+
+    Super::Deinitialize();
+}
+
+void UCombatUIEventSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    Flush();
+}
+
+bool UCombatUIEventSubsystem::IsTickable() const
+{
+    return States.Num() > 0;
+}
+
+TStatId UCombatUIEventSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatUIEventSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================================
+// SOURCES
+// ============================================================================
+
+void UCombatUIEventSubsystem::RegisterCombatComponent(UCombatComponent* CombatComponent)
+{
+    if (!CombatComponent || !CombatComponent->GetOwner())
+    {
+        return;
+    }
+
+    FindOrAddState(CombatComponent->GetOwner()).CombatComponent = CombatComponent;
+}
+
+void UCombatUIEventSubsystem::UnregisterCombatComponent(UCombatComponent* CombatComponent)
+{
+    if (!CombatComponent)
+    {
+        return;
+    }
+
+    if (const int32* Index = StateIndices.Find(FObjectKey(CombatComponent->GetOwner())))
+    {
+        States[*Index].CombatComponent.Reset();
+    }
+}
+
+void UCombatUIEventSubsystem::NotifyHealthChanged(AActor* Actor, float HealthPercent)
+{
+    if (Actor)
+    {
+        FindOrAddState(Actor).PendingHealth = FMath::Clamp(HealthPercent, 0.0f, 1.0f);
+    }
+}
+
+void UCombatUIEventSubsystem::NotifyStunChanged(AActor* Actor, bool bStunned)
+{
+    if (Actor)
+    {
+        FActorUIState& State = FindOrAddState(Actor);
+        State.bPendingStunned = bStunned;
+        State.bStunDirty = true;
+    }
+}
+
+void UCombatUIEventSubsystem::RemoveActor(AActor* Actor)
+{
+    if (const int32* Index = StateIndices.Find(FObjectKey(Actor)))
+    {
+        RemoveStateAt(*Index);
+    }
+}
+
+// ============================================================================
+// EVENTS
+// ============================================================================
+
+void UCombatUIEventSubsystem::Flush()
+{
+    const UWorld* World = GetWorld();
+    const double Now = World ? World->GetTimeSeconds() : 0.0;
+
+    // Collect first: listeners may register or remove actors while handling an update
+    TArray<FCombatUIUpdate, TInlineAllocator<16>> Updates;
+
+    for (int32 Index = States.Num() - 1; Index >= 0; --Index)
+    {
+        FActorUIState& State = States[Index];
+        AActor* Actor = State.Actor.Get();
+        if (!Actor)
+        {
+            RemoveStateAt(Index);
+            continue;
+        }
+
+        // Posture is sampled, not pushed: one read per actor per frame regardless of how often it regenerated
+        if (const UCombatComponent* CombatComponent = State.CombatComponent.Get())
+        {
+            State.PendingPosture = CombatComponent->GetPosturePercent();
+        }
+
+        const float Posture = State.PendingPosture >= 0.0f ? Quantize(State.PendingPosture) : State.EmittedPosture;
+        const float Health = State.PendingHealth >= 0.0f ? Quantize(State.PendingHealth) : State.EmittedHealth;
+
+        const bool bPostureChanged = Posture != State.EmittedPosture;
+        const bool bHealthChanged = Health != State.EmittedHealth;
+        const bool bStunChanged = State.bStunDirty && State.bPendingStunned != State.bEmittedStunned;
+        State.bStunDirty = false;
+
+        if (!bPostureChanged && !bHealthChanged && !bStunChanged)
+        {
+            continue;
+        }
+
+        // Throttle continuous values; stun edges always go out immediately
+        if (!bStunChanged && Now - State.LastEmitTime < MinUpdateInterval)
+        {
+            continue;
+        }
+
+        State.EmittedPosture = Posture;
+        State.EmittedHealth = Health;
+        State.bEmittedStunned = State.bPendingStunned;
+        State.LastEmitTime = Now;
+
+        FCombatUIUpdate& Update = Updates.AddDefaulted_GetRef();
+        Update.Actor = Actor;
+        Update.PosturePercent = Posture >= 0.0f ? Posture : 1.0f;
+        Update.HealthPercent = Health >= 0.0f ? Health : 1.0f;
+        Update.bStunned = State.bEmittedStunned;
+        Update.bPostureChanged = bPostureChanged;
+        Update.bHealthChanged = bHealthChanged;
+        Update.bStunChanged = bStunChanged;
+    }
+
+    for (const FCombatUIUpdate& Update : Updates)
+    {
+        OnCombatUIUpdateNative.Broadcast(Update);
+        OnCombatUIUpdate.Broadcast(Update);
+    }
+}
+
+float UCombatUIEventSubsystem::Quantize(float Percent) const
+{
+    const float Clamped = FMath::Clamp(Percent, 0.0f, 1.0f);
+    if (QuantizationStep <= 0.0f)
+    {
+        return Clamped;
+    }
+
+    return FMath::Clamp(FMath::RoundToFloat(Clamped / QuantizationStep) * QuantizationStep, 0.0f, 1.0f);
+}
+
+// ============================================================================
+// INTERNAL
+// ============================================================================
+
+UCombatUIEventSubsystem::FActorUIState& UCombatUIEventSubsystem::FindOrAddState(AActor* Actor)
+{
+    if (const int32* Index = StateIndices.Find(FObjectKey(Actor)))
+    {
+        return States[*Index];
+    }
+
+    const int32 NewIndex = States.AddDefaulted();
+    States[NewIndex].Key = FObjectKey(Actor);
+    States[NewIndex].Actor = Actor;
+    StateIndices.Add(FObjectKey(Actor), NewIndex);
+    return States[NewIndex];
+}
+
+void UCombatUIEventSubsystem::RemoveStateAt(int32 Index)
+{
+    StateIndices.Remove(States[Index].Key);
+
+    const int32 LastIndex = States.Num() - 1;
+    if (Index != LastIndex)
+    {
+        States[Index] = MoveTemp(States[LastIndex]);
+        StateIndices.Add(States[Index].Key, Index);
+    }
+    States.Pop(EAllowShrinking::No);
+}
@@ -0,0 +1,355 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/ComboPreloadSubsystem.h"
+#include "Data/AttackData.h"
+#include "Data/AttackConfiguration.h"
+#include "Debug/CombatTrace.h"
+#include "Algo/Compare.h"
+#include "Engine/AssetManager.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UComboPreloadSubsystem::Deinitialize()
+{
+    for (TPair<FObjectKey, FComboPreloadWindow>& Pair : Windows)
+    {
+        if (Pair.Value.Handle.IsValid())
+        {
+            Pair.Value.Handle->CancelHandle();
+        }
+    }
+    Windows.Empty();
+
+    for (const TPair<FObjectKey, FMovesetBundleRequest>& Pair : Movesets)
+    {
+        if (Pair.Value.Handle.IsValid())
+        {
+            Pair.Value.Handle->CancelHandle();
+        }
+    }
+    Movesets.Empty();
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// PRELOADING
+// ============================================================================
+
+void UComboPreloadSubsystem::PreloadChain(const UObject* Requester, TConstArrayView<const UAttackData*> Roots, int32 PreloadDepth)
+{
+    COMBAT_LLM_SCOPE(AttackGraph);
+    if (!Requester)
+    {
+        return;
+    }
+
+    if (PreloadDepth <= 0)
+    {
+        ReleaseChain(Requester);
+        return;
+    }
+
+    const FObjectKey RequesterKey(Requester);
+    FComboPreloadWindow& Window = Windows.FindOrAdd(RequesterKey);
+
+    Window.Depth = PreloadDepth;
+    Window.Roots.Reset(Roots.Num());
+    for (const UAttackData* Root : Roots)
+    {
+        if (Root)
+        {
+            Window.Roots.Add(Root);
+        }
+    }
+
+    RequestWindow(RequesterKey, Window);
+}
+
+void UComboPreloadSubsystem::ReleaseChain(const UObject* Requester)
+{
+    FComboPreloadWindow Window;
+    if (Windows.RemoveAndCopyValue(FObjectKey(Requester), Window) && Window.Handle.IsValid())
+    {
+        Window.Handle->CancelHandle();
+    }
+}
+
+bool UComboPreloadSubsystem::IsChainLoading(const UObject* Requester) const
+{
+    const FComboPreloadWindow* Window = Windows.Find(FObjectKey(Requester));
+    return Window && Window->Handle.IsValid() && Window->Handle->IsLoadingInProgress();
+}
+
+void UComboPreloadSubsystem::GatherChainPaths(TConstArrayView<const UAttackData*> Roots, int32 Depth, TArray<FSoftObjectPath>& OutPaths, bool& bOutHasUnloaded)
+{
+    OutPaths.Reset();
+    bOutHasUnloaded = false;
+
+    // Breadth-first, one level per combo link
+    TSet<const UAttackData*> Visited;
+    TArray<const UAttackData*, TInlineAllocator<16>> Frontier;
+    TArray<const UAttackData*, TInlineAllocator<16>> NextFrontier;
+
+    for (const UAttackData* Root : Roots)
+    {
+        if (Root && !Visited.Contains(Root))
+        {
+            Visited.Add(Root);
+            Frontier.Add(Root);
+        }
+    }
+
+    for (int32 Level = 0; Level < Depth && Frontier.Num() > 0; ++Level)
+    {
+        NextFrontier.Reset();
+        for (const UAttackData* Node : Frontier)
+        {
+            Node->ForEachComboLink([&](const FSoftObjectPath& SoftPath, UAttackData* Link)
+            {
+                if (!SoftPath.IsNull())
+                {
+                    OutPaths.AddUnique(SoftPath);
+                }
+
+                if (!Link)
+                {
+                    bOutHasUnloaded = true; // Nodes behind this link are found once it loads
+                }
+                else if (!Visited.Contains(Link))
+                {
+                    Visited.Add(Link);
+                    NextFrontier.Add(Link);
+                }
+            });
+        }
+        Swap(Frontier, NextFrontier);
+    }
+}
+
+void UComboPreloadSubsystem::RequestWindow(FObjectKey RequesterKey, FComboPreloadWindow& Window)
+{
+    COMBAT_LLM_SCOPE(AttackGraph);
+    TArray<const UAttackData*, TInlineAllocator<4>> Roots;
+    for (const TWeakObjectPtr<const UAttackData>& Root : Window.Roots)
+    {
+        if (const UAttackData* Resolved = Root.Get())
+        {
+            Roots.Add(Resolved);
+        }
+    }
+
+    TArray<FSoftObjectPath> Paths;
+    bool bHasUnloaded = false;
+    GatherChainPaths(Roots, Window.Depth, Paths, bHasUnloaded);
+
+    // New handle first, then drop the old one - nodes in both windows stay resident
+    TSharedPtr<FStreamableHandle> PreviousHandle = MoveTemp(Window.Handle);
+
+    if (Paths.Num() > 0)
+    {
+        Window.Handle = StreamableManager.RequestAsyncLoad(
+            MoveTemp(Paths),
+            FStreamableDelegate::CreateUObject(this, &UComboPreloadSubsystem::OnWindowLoaded, RequesterKey),
+            FStreamableManager::DefaultAsyncLoadPriority);
+    }
+
+    if (PreviousHandle.IsValid())
+    {
+        PreviousHandle->ReleaseHandle();
+    }
+
+    COMBAT_LOG(Verbose, TEXT("[COMBO PRELOAD] Window for %s: %d soft links (depth %d)%s"),
+        *GetNameSafe(RequesterKey.ResolveObjectPtr()), Window.Handle.IsValid() ? Window.Handle->GetRequestedAssets().Num() : 0,
+        Window.Depth, bHasUnloaded ? TEXT(" - loading") : TEXT(""));
+}
+
+void UComboPreloadSubsystem::OnWindowLoaded(FObjectKey RequesterKey)
+{
+    COMBAT_LLM_SCOPE(AttackGraph);
+    FComboPreloadWindow* Window = Windows.Find(RequesterKey);
+    if (!Window)
+    {
+        return;
+    }
+
+    // Newly loaded nodes may link further - extend the window when that found new soft links
+    // (links that failed to load stay unresolved and are not requested again)
+    TArray<const UAttackData*, TInlineAllocator<4>> Roots;
+    for (const TWeakObjectPtr<const UAttackData>& Root : Window->Roots)
+    {
+        if (const UAttackData* Resolved = Root.Get())
+        {
+            Roots.Add(Resolved);
+        }
+    }
+
+    TArray<FSoftObjectPath> Paths;
+    bool bHasUnloaded = false;
+    GatherChainPaths(Roots, Window->Depth, Paths, bHasUnloaded);
+
+    if (Window->Handle.IsValid() && Paths.Num() > Window->Handle->GetRequestedAssets().Num())
+    {
+        RequestWindow(RequesterKey, *Window);
+        return;
+    }
+
+    OnChainPreloaded.Broadcast(RequesterKey.ResolveObjectPtr());
+}
+
+
+// ============================================================================
+// MOVESET BUNDLES
+// ============================================================================
+
+void UComboPreloadSubsystem::PreloadMoveset(const UAttackConfiguration* Configuration, TConstArrayView<FName> Bundles)
+{
+    COMBAT_LLM_SCOPE(AttackGraph);
+    if (!Configuration)
+    {
+        return;
+    }
+
+    if (Bundles.Num() == 0)
+    {
+        ReleaseMoveset(Configuration);
+        return;
+    }
+
+    const FObjectKey ConfigurationKey(Configuration);
+    FMovesetBundleRequest& Request = Movesets.FindOrAdd(ConfigurationKey);
+    if (Request.Configuration.Get() == Configuration && Algo::Compare(Request.Bundles, Bundles))
+    {
+        return;
+    }
+
+    Request.Configuration = Configuration;
+    Request.Bundles.Reset(Bundles.Num());
+    Request.Bundles.Append(Bundles.GetData(), Bundles.Num());
+
+    RequestMoveset(ConfigurationKey, Request);
+}
+
+void UComboPreloadSubsystem::ReleaseMoveset(const UAttackConfiguration* Configuration)
+{
+    FMovesetBundleRequest Request;
+    if (!Movesets.RemoveAndCopyValue(FObjectKey(Configuration), Request))
+    {
+        return;
+    }
+
+    if (Request.bUsesAssetManager && UAssetManager::IsInitialized() && Configuration)
+    {
+        const TArray<FName> AllBundles = { UAttackConfiguration::CoreBundleName, UAttackConfiguration::ExtendedBundleName };
+        UAssetManager::Get().ChangeBundleStateForPrimaryAssets({ Configuration->GetPrimaryAssetId() }, {}, AllBundles);
+    }
+
+    if (Request.Handle.IsValid())
+    {
+        Request.Handle->CancelHandle();
+    }
+}
+
+TConstArrayView<FName> UComboPreloadSubsystem::GetMovesetBundles(const UAttackConfiguration* Configuration) const
+{
+    const FMovesetBundleRequest* Request = Movesets.Find(FObjectKey(Configuration));
+    return Request ? TConstArrayView<FName>(Request->Bundles) : TConstArrayView<FName>();
+}
+
+bool UComboPreloadSubsystem::IsMovesetLoading(const UAttackConfiguration* Configuration) const
+{
+    const FMovesetBundleRequest* Request = Movesets.Find(FObjectKey(Configuration));
+    return Request && Request->Handle.IsValid() && Request->Handle->IsLoadingInProgress();
+}
+
+void UComboPreloadSubsystem::GatherMovesetPaths(const FMovesetBundleRequest& Request, TArray<FSoftObjectPath>& OutPaths)
+{
+    OutPaths.Reset();
+
+    const UAttackConfiguration* Configuration = Request.Configuration.Get();
+    if (!Configuration)
+    {
+        return;
+    }
+
+    TArray<FSoftObjectPath> BundlePaths;
+    for (const FName BundleName : Request.Bundles)
+    {
+        bool bHasUnloaded = false;
+        Configuration->GatherBundlePaths(BundleName, BundlePaths, bHasUnloaded);
+        for (const FSoftObjectPath& Path : BundlePaths)
+        {
+            OutPaths.AddUnique(Path);
+        }
+    }
+}
+
+void UComboPreloadSubsystem::RequestMoveset(FObjectKey ConfigurationKey, FMovesetBundleRequest& Request)
+{
+    COMBAT_LLM_SCOPE(AttackGraph);
+    const UAttackConfiguration* Configuration = Request.Configuration.Get();
+    if (!Configuration)
+    {
+        return;
+    }
+
+    const FStreamableDelegate OnLoaded = FStreamableDelegate::CreateUObject(this, &UComboPreloadSubsystem::OnMovesetLoaded, ConfigurationKey);
+
+    // New handle first, then drop the old one - assets in both requests stay resident
+    TSharedPtr<FStreamableHandle> PreviousHandle = MoveTemp(Request.Handle);
+
+    // Registered primary asset: the Asset Manager owns bundle state and has the full graph from the cooked bundle data
+    UAssetManager* AssetManager = UAssetManager::IsInitialized() ? &UAssetManager::Get() : nullptr;
+    const FPrimaryAssetId AssetId = Configuration->GetPrimaryAssetId();
+    Request.bUsesAssetManager = AssetManager && AssetId.IsValid() && AssetManager->GetPrimaryAssetPath(AssetId).IsValid();
+
+    if (Request.bUsesAssetManager)
+    {
+        Request.Handle = AssetManager->LoadPrimaryAsset(AssetId, Request.Bundles, OnLoaded, FStreamableManager::DefaultAsyncLoadPriority);
+    }
+    else
+    {
+        TArray<FSoftObjectPath> Paths;
+        GatherMovesetPaths(Request, Paths);
+        if (Paths.Num() > 0)
+        {
+            Request.Handle = StreamableManager.RequestAsyncLoad(MoveTemp(Paths), OnLoaded, FStreamableManager::DefaultAsyncLoadPriority);
+        }
+    }
+
+    if (PreviousHandle.IsValid())
+    {
+        PreviousHandle->ReleaseHandle();
+    }
+
+    COMBAT_LOG(Verbose, TEXT("[COMBO PRELOAD] Moveset %s: %d bundles, %d assets%s"),
+        *GetNameSafe(Configuration), Request.Bundles.Num(),
+        Request.Handle.IsValid() ? Request.Handle->GetRequestedAssets().Num() : 0,
+        Request.bUsesAssetManager ? TEXT(" (asset manager)") : TEXT(""));
+}
+
+void UComboPreloadSubsystem::OnMovesetLoaded(FObjectKey ConfigurationKey)
+{
+    COMBAT_LLM_SCOPE(AttackGraph);
+    FMovesetBundleRequest* Request = Movesets.Find(ConfigurationKey);
+    if (!Request)
+    {
+        return;
+    }
+
+    // Walked bundles only know the graph up to the first unloaded link - request again if the loaded nodes link further
+    if (!Request->bUsesAssetManager && Request->Handle.IsValid())
+    {
+        TArray<FSoftObjectPath> Paths;
+        GatherMovesetPaths(*Request, Paths);
+        if (Paths.Num() > Request->Handle->GetRequestedAssets().Num())
+        {
+            RequestMoveset(ConfigurationKey, *Request);
+            return;
+        }
+    }
+
+    OnChainPreloaded.Broadcast(ConfigurationKey.ResolveObjectPtr());
+}
@@ -2,21 +2,134 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Core/HitReactionComponent.h"
+#include "Core/CombatComponent.h"
+#include "Core/CombatDamageAggregatorSubsystem.h"
+#include "Core/CombatEventDispatcherSubsystem.h"
+#include "Core/CombatNetDormancySubsystem.h"
+#include "Core/CombatUIEventSubsystem.h"
+#include "Core/CombatSignificanceSubsystem.h"
+#include "Core/CombatBudgetSubsystem.h"
+#include "Core/CombatTimerWheelSubsystem.h"
+#include "Data/AttackData.h"
+#include "Data/CombatArchetype.h"
 #include "GameFramework/Character.h"
 #include "Animation/AnimInstance.h"
 #include "Animation/AnimMontage.h"
+#include "Debug/CombatTrace.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// REACTION TABLE
+// ============================================================================
+
+void FHitReactionTable::Build(const FHitReactionAnimSet& Light, const FHitReactionAnimSet& Heavy, const FHitReactionAnimSet& Stunned, const TMap<FName, TSoftObjectPtr<UAnimMontage>>& Finishers)
+{
+    // Flattened [State][Severity][Direction] - stunned slots fall back to the standing montage
+    Reactions.SetNumZeroed(NumStateBuckets * NumSeverityBuckets * NumDirectionBuckets);
+
+    const EAttackDirection Directions[NumDirectionBuckets] = { EAttackDirection::Forward, EAttackDirection::Backward, EAttackDirection::Left, EAttackDirection::Right };
+    auto GetSetMontage = [](const FHitReactionAnimSet& Set, EAttackDirection Direction) -> UAnimMontage*
+    {
+        switch (Direction)
+        {
+            case EAttackDirection::Backward: return Set.BackHit;
+            case EAttackDirection::Left:     return Set.LeftHit;
+            case EAttackDirection::Right:    return Set.RightHit;
+            default:                         return Set.FrontHit;
+        }
+    };
+
+    for (int32 Severity = 0; Severity < NumSeverityBuckets; ++Severity)
+    {
+        const FHitReactionAnimSet& AnimSet = Severity ? Heavy : Light;
+        for (const EAttackDirection Direction : Directions)
+        {
+            UAnimMontage* Standing = GetSetMontage(AnimSet, Direction);
+            UAnimMontage* StunnedMontage = GetSetMontage(Stunned, Direction);
+
+            Reactions[GetReactionIndex(false, Severity != 0, Direction)] = Standing;
+            Reactions[GetReactionIndex(true, Severity != 0, Direction)] = StunnedMontage ? StunnedMontage : Standing;
+        }
+    }
+
+    // Intern finisher names - ids index the flat montage array
+    FinisherIds.Reset(Finishers.Num());
+    FinisherMontages.Reset(Finishers.Num());
+    for (const TPair<FName, TSoftObjectPtr<UAnimMontage>>& Pair : Finishers)
+    {
+        FinisherIds.Add(Pair.Key);
+        FinisherMontages.Add(Pair.Value);
+    }
+}
+
+void FHitReactionTable::Reset()
+{
+    Reactions.Empty();
+    FinisherIds.Empty();
+    FinisherMontages.Empty();
+}
+
+UAnimMontage* FHitReactionTable::GetReaction(bool bStunned, bool bHeavy, EAttackDirection Direction) const
+{
+    const int32 Index = GetReactionIndex(bStunned, bHeavy, Direction);
+    return Reactions.IsValidIndex(Index) ? Reactions[Index].Get() : nullptr;
+}
+
+int32 FHitReactionTable::GetReactionIndex(bool bStunned, bool bHeavy, EAttackDirection Direction)
+{
+    // EAttackDirection: None=0, Forward..Right=1..4 (None defaults to front)
+    const int32 DirectionBucket = FMath::Max(static_cast<int32>(Direction) - 1, 0);
+    return ((static_cast<int32>(bStunned) * NumSeverityBuckets) + static_cast<int32>(bHeavy)) * NumDirectionBuckets + DirectionBucket;
+}
+
+// ============================================================================
+// HIT AGGREGATE
+// ============================================================================
+
+void FCombatHitAggregate::AddHit(const FHitReactionInfo& HitInfo)
+{
+    // Severity: stun picks the reaction bucket, damage breaks ties
+    const bool bStronger = NumHits == 0
+        || HitInfo.StunDuration > StrongestHit.StunDuration
+        || (HitInfo.StunDuration == StrongestHit.StunDuration && HitInfo.Damage > StrongestHit.Damage);
+    if (bStronger)
+    {
+        StrongestHit = HitInfo;
+    }
+
+    TotalDamage += HitInfo.Damage;
+    ++NumHits;
+}
+
+void FCombatHitAggregate::AddBlockedHit(const FHitReactionInfo& HitInfo, float PostureDamage)
+{
+    // Blocked-only frames still report who hit us
+    if (NumHits == 0 && NumBlockedHits == 0)
+    {
+        StrongestHit = HitInfo;
+    }
+
+    TotalPostureDamage += PostureDamage;
+    ++NumBlockedHits;
+}
+
+// ============================================================================
+// COMPONENT
+// ============================================================================
 
 UHitReactionComponent::UHitReactionComponent()
 {
-    PrimaryComponentTick.bCanEverTick = true;
-    PrimaryComponentTick.bStartWithTickEnabled = false; // Only tick when stunned
+    // Stun expiry is timer-driven - no tick needed
+    PrimaryComponentTick.bCanEverTick = false;
     
     bHasSuperArmor = false;
     bIsInvulnerable = false;
     DamageResistance = 1.0f;
     
     bIsStunned = false;
-    StunTimeRemaining = 0.0f;
+    StunEndTime = 0.0f;
 }
 
 void UHitReactionComponent::BeginPlay()
@@ -28,16 +141,37 @@ void UHitReactionComponent::BeginPlay()
     {
         AnimInstance = OwnerCharacter->GetMesh()->GetAnimInstance();
     }
+
+    RebuildReactionTable();
+
+    // Finisher assets follow posture; without streaming they stay resident like hard references
+    OwnerCombat = GetOwner()->FindComponentByClass<UCombatComponent>();
+    if (bStreamFinisherAssets && OwnerCombat)
+    {
+        OwnerCombat->OnPostureChangedNative.AddUObject(this, &UHitReactionComponent::HandlePostureChanged);
+    }
+    else
+    {
+        RequestFinisherAssets();
+    }
+
+    // Ranked for reaction fidelity
+    if (UCombatSignificanceSubsystem* Significance = GetWorld() ? GetWorld()->GetSubsystem<UCombatSignificanceSubsystem>() : nullptr)
+    {
+        Significance->RegisterActor(GetOwner());
+    }
 }
 
-void UHitReactionComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UHitReactionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-    
-    if (bIsStunned)
+    if (OwnerCombat)
     {
-        UpdateStun(DeltaTime);
+        OwnerCombat->OnPostureChangedNative.RemoveAll(this);
     }
+
+    ReleaseFinisherAssets();
+
+    Super::EndPlay(EndPlayReason);
 }
 
 // ============================================================================
@@ -51,12 +185,27 @@ float UHitReactionComponent::ApplyDamage(const FHitReactionInfo& HitInfo)
     {
         return 0.0f;
     }
+
+    // Dormant victims must replicate the reaction
+    UCombatNetDormancySubsystem::WakeActorFor(GetOwner());
     
     // Calculate final damage
     float FinalDamage = HitInfo.Damage * DamageResistance;
-    
+
+    // Events and the reaction wait for the end of the frame, merged with any other hits
+    const bool bFirstPendingHit = PendingHits.IsEmpty();
+    PendingHits.AddHit(HitInfo);
+    if (!bFirstPendingHit || QueuePendingFlush())
+    {
+        return FinalDamage;
+    }
+
+    PendingHits.Reset();
+
     // Broadcast event
+    OnDamageReceivedNative.Broadcast(HitInfo);
     OnDamageReceived.Broadcast(HitInfo);
+    PublishDamageEvent(HitInfo);
     
     // Play hit reaction if not super armored
     if (!bHasSuperArmor)
@@ -67,6 +216,75 @@ float UHitReactionComponent::ApplyDamage(const FHitReactionInfo& HitInfo)
     return FinalDamage;
 }
 
+void UHitReactionComponent::RecordBlockedHit(const FHitReactionInfo& HitInfo, float PostureDamage)
+{
+    UCombatNetDormancySubsystem::WakeActorFor(GetOwner());
+
+    const bool bFirstPendingHit = PendingHits.IsEmpty();
+    PendingHits.AddBlockedHit(HitInfo, PostureDamage);
+    if (bFirstPendingHit && !QueuePendingFlush())
+    {
+        FlushPendingHits();
+    }
+}
+
+bool UHitReactionComponent::QueuePendingFlush()
+{
+    if (!bAggregateHitsPerFrame)
+    {
+        return false;
+    }
+
+    UCombatDamageAggregatorSubsystem* Aggregator = GetWorld() ? GetWorld()->GetSubsystem<UCombatDamageAggregatorSubsystem>() : nullptr;
+    if (!Aggregator)
+    {
+        return false;
+    }
+
+    Aggregator->QueueFlush(this);
+    return true;
+}
+
+void UHitReactionComponent::FlushPendingHits()
+{
+    if (PendingHits.IsEmpty())
+    {
+        return;
+    }
+
+    // Listeners may land new hits - those start the next aggregate
+    const FCombatHitAggregate Hits = PendingHits;
+    PendingHits.Reset();
+
+    if (Hits.NumHits > 0)
+    {
+        // One damage event for the frame: strongest hit's context, everyone's damage
+        FHitReactionInfo Merged = Hits.StrongestHit;
+        Merged.Damage = Hits.TotalDamage;
+        OnDamageReceivedNative.Broadcast(Merged);
+        OnDamageReceived.Broadcast(Merged);
+        PublishDamageEvent(Merged);
+
+        // One reaction - state (invulnerable, super armor) is read at flush time
+        if (!bHasSuperArmor && !bIsInvulnerable)
+        {
+            PlayHitReaction(Hits.StrongestHit);
+        }
+    }
+
+    OnHitsAggregatedNative.Broadcast(Hits);
+}
+
+void UHitReactionComponent::PublishDamageEvent(const FHitReactionInfo& HitInfo)
+{
+    if (FCombatEvent* Event = UCombatEventDispatcherSubsystem::PublishFrom(this, ECombatEventKind::Damage, HitInfo.Attacker, GetOwner()))
+    {
+        Event->AttackData = HitInfo.AttackData.Get();
+        Event->Location = HitInfo.ImpactPoint;
+        Event->Magnitude = HitInfo.Damage;
+    }
+}
+
 void UHitReactionComponent::PlayHitReaction(const FHitReactionInfo& HitInfo)
 {
     if (!AnimInstance)
@@ -74,25 +292,61 @@ void UHitReactionComponent::PlayHitReaction(const FHitReactionInfo& HitInfo)
         return;
     }
 
-    if (UAnimMontage* ReactionMontage = SelectHitReactionMontage(HitInfo))
-    {
-        AnimInstance->Montage_Play(ReactionMontage);
-        
-        // Determine direction from hit
-        EAttackDirection Direction = GetHitDirectionRelativeToFacing(HitInfo.HitDirection);
-        
-        // Determine if heavy based on stun duration threshold
-        const bool bIsHeavy = (HitInfo.StunDuration > 0.3f);
-        
-        // Broadcast event
-        OnHitReactionStarted.Broadcast(Direction, bIsHeavy);
-        
-        // Apply hitstun if specified
-        if (HitInfo.StunDuration > 0.0f)
+    if (!Archetype && !LocalReactionTable.IsBuilt())
+    {
+        RebuildReactionTable();
+    }
+
+    // Determine direction from hit
+    const EAttackDirection Direction = GetHitDirectionRelativeToFacing(HitInfo.HitDirection);
+
+    // Determine if heavy based on stun duration threshold
+    const bool bIsHeavy = (HitInfo.StunDuration > GetHeavyHitStunThreshold());
+
+    // Anim over budget: mid-range actors flinch too, only high-significance actors keep full reactions
+    const ECombatSignificance Significance = UCombatSignificanceSubsystem::GetSignificanceFor(GetOwner());
+    const ECombatSignificance MaxFlinchSignificance = UCombatBudgetSubsystem::GetDetailScaleFor(this, ECombatBudgetCategory::Anim) < 1.0f
+        ? ECombatSignificance::Medium
+        : ECombatSignificance::Low;
+    if (bUseProceduralFlinch && Significance != ECombatSignificance::Culled && Significance <= MaxFlinchSignificance)
+    {
+        // Background actor - additive flinch, the montage slot keeps whatever it was playing
+        StartFlinch(Direction, bIsHeavy);
+    }
+    else if (UAnimMontage* ReactionMontage = SelectHitReactionMontage(HitInfo))
+    {
+        // Nobody can see a culled actor react - skip the montage, keep the events and stun
+        if (Significance != ECombatSignificance::Culled)
         {
-            ApplyHitStun(HitInfo.StunDuration);
+            AnimInstance->Montage_Play(ReactionMontage);
         }
     }
+    else
+    {
+        return;
+    }
+
+    // Broadcast event
+    OnHitReactionStarted.Broadcast(Direction, bIsHeavy);
+
+    // Apply hitstun if specified
+    if (HitInfo.StunDuration > 0.0f)
+    {
+        ApplyHitStun(HitInfo.StunDuration);
+    }
+}
+
+void UHitReactionComponent::StartFlinch(EAttackDirection Direction, bool bIsHeavy)
+{
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    FlinchStartTime = World->GetTimeSeconds();
+    FlinchIntensity = bIsHeavy ? 1.0f : LightFlinchIntensity;
+    FlinchDirection = Direction;
 }
 
 void UHitReactionComponent::ApplyHitStun(float Duration)
@@ -102,40 +356,239 @@ void UHitReactionComponent::ApplyHitStun(float Duration)
         return;
     }
     
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    // Schedule expiry (re-stun replaces the pending end)
     bIsStunned = true;
-    StunTimeRemaining = Duration;
-    SetComponentTickEnabled(true);
+    StunEndTime = World->GetTimeSeconds() + Duration;
+    if (UCombatTimerWheelSubsystem* TimerWheel = World->GetSubsystem<UCombatTimerWheelSubsystem>())
+    {
+        TimerWheel->SetTimer<&UHitReactionComponent::EndStun>(StunTimer, this, Duration);
+    }
     
     OnStunBegin.Broadcast(Duration);
+
+    if (UCombatUIEventSubsystem* UIEvents = World->GetSubsystem<UCombatUIEventSubsystem>())
+    {
+        UIEvents->NotifyStunChanged(GetOwner(), true);
+    }
 }
 
 void UHitReactionComponent::PlayGuardBrokenReaction()
 {
-    if (!AnimInstance || !GuardBrokenMontage)
+    UAnimMontage* Montage = ResolveStreamedMontage(GetGuardBrokenMontageRef());
+    if (!AnimInstance || !Montage)
     {
         return;
     }
     
-    AnimInstance->Montage_Play(GuardBrokenMontage);
+    AnimInstance->Montage_Play(Montage);
 }
 
 bool UHitReactionComponent::PlayFinisherVictimAnimation(FName FinisherName)
 {
-    if (!AnimInstance)
+    if (!Archetype && LocalReactionTable.FinisherIds.Num() != FinisherVictimAnimations.Num())
+    {
+        RebuildReactionTable();
+    }
+
+    return PlayFinisherVictimAnimationById(FindFinisherId(FinisherName));
+}
+
+bool UHitReactionComponent::PlayFinisherVictimAnimationById(int32 FinisherId)
+{
+    const TArray<TSoftObjectPtr<UAnimMontage>>& FinisherMontages = GetReactionTable().FinisherMontages;
+    if (!AnimInstance || !FinisherMontages.IsValidIndex(FinisherId))
     {
         return false;
     }
-    
-    TObjectPtr<UAnimMontage>* FoundMontage = FinisherVictimAnimations.Find(FinisherName);
-    if (!FoundMontage || !(*FoundMontage))
+
+    UAnimMontage* Montage = ResolveStreamedMontage(FinisherMontages[FinisherId]);
+    if (!Montage)
     {
         return false;
     }
     
-    AnimInstance->Montage_Play(*FoundMontage);
+    AnimInstance->Montage_Play(Montage);
     return true;
 }
 
+int32 UHitReactionComponent::FindFinisherId(FName FinisherName) const
+{
+    return GetReactionTable().FindFinisherId(FinisherName);
+}
+
+void UHitReactionComponent::RebuildReactionTable()
+{
+    if (Archetype)
+    {
+        LocalReactionTable.Reset();
+        return;
+    }
+
+    LocalReactionTable.Build(LightHitReactions, HeavyHitReactions, StunnedHitReactions, FinisherVictimAnimations);
+}
+
+// ============================================================================
+// ARCHETYPE
+// ============================================================================
+
+void UHitReactionComponent::SetArchetype(const UCombatArchetype* InArchetype)
+{
+    Archetype = InArchetype;
+    RebuildReactionTable();
+
+    // The request covered the previous configuration's montages
+    if (AreFinisherAssetsRequested())
+    {
+        ReleaseFinisherAssets();
+        RequestFinisherAssets();
+    }
+}
+
+UAnimMontage* UHitReactionComponent::GetGuardBrokenMontage() const
+{
+    return GetGuardBrokenMontageRef().Get();
+}
+
+const TSoftObjectPtr<UAnimMontage>& UHitReactionComponent::GetGuardBrokenMontageRef() const
+{
+    return Archetype ? Archetype->GuardBrokenMontage : GuardBrokenMontage;
+}
+
+float UHitReactionComponent::GetHeavyHitStunThreshold() const
+{
+    return Archetype ? Archetype->HeavyHitStunThreshold : HeavyHitStunThreshold;
+}
+
+void UHitReactionComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+    Super::GetResourceSizeEx(CumulativeResourceSize);
+
+    // An archetype's shared table is counted once, on the archetype
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(LocalReactionTable.GetAllocatedSize());
+}
+
+const FHitReactionTable& UHitReactionComponent::GetReactionTable() const
+{
+    return Archetype ? Archetype->GetReactionTable() : LocalReactionTable;
+}
+
+// ============================================================================
+// FINISHER STREAMING
+// ============================================================================
+
+void UHitReactionComponent::RequestFinisherAssets()
+{
+    if (UWorld* World = GetWorld())
+    {
+        if (UCombatTimerWheelSubsystem* TimerWheel = World->GetSubsystem<UCombatTimerWheelSubsystem>())
+        {
+            TimerWheel->ClearTimer(FinisherReleaseTimer);
+        }
+    }
+
+    if (FinisherAssetsHandle.IsValid())
+    {
+        return;
+    }
+
+    TArray<FSoftObjectPath> Paths;
+    if (!GetGuardBrokenMontageRef().IsNull())
+    {
+        Paths.Add(GetGuardBrokenMontageRef().ToSoftObjectPath());
+    }
+    for (const TSoftObjectPtr<UAnimMontage>& Montage : GetReactionTable().FinisherMontages)
+    {
+        if (!Montage.IsNull())
+        {
+            Paths.AddUnique(Montage.ToSoftObjectPath());
+        }
+    }
+
+    if (Paths.Num() == 0)
+    {
+        return;
+    }
+
+    // One handle for the whole set - released together once posture recovers
+    FinisherAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths), FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+
+    COMBAT_LOG(Verbose, TEXT("[HIT REACTION] %s streaming %d finisher assets"), *GetNameSafe(GetOwner()),
+        FinisherAssetsHandle.IsValid() ? FinisherAssetsHandle->GetRequestedAssets().Num() : 0);
+}
+
+void UHitReactionComponent::ReleaseFinisherAssets()
+{
+    if (UWorld* World = GetWorld())
+    {
+        if (UCombatTimerWheelSubsystem* TimerWheel = World->GetSubsystem<UCombatTimerWheelSubsystem>())
+        {
+            TimerWheel->ClearTimer(FinisherReleaseTimer);
+        }
+    }
+
+    if (FinisherAssetsHandle.IsValid())
+    {
+        FinisherAssetsHandle->ReleaseHandle();
+        FinisherAssetsHandle.Reset();
+    }
+}
+
+bool UHitReactionComponent::AreFinisherAssetsRequested() const
+{
+    return FinisherAssetsHandle.IsValid();
+}
+
+bool UHitReactionComponent::AreFinisherAssetsLoading() const
+{
+    return FinisherAssetsHandle.IsValid() && FinisherAssetsHandle->IsLoadingInProgress();
+}
+
+void UHitReactionComponent::HandlePostureChanged(float NewPosture)
+{
+    if (!OwnerCombat)
+    {
+        return;
+    }
+
+    // Guard break (and the finisher after it) is close - get the assets in ahead of time
+    if (OwnerCombat->GetPosturePercent() < FinisherStreamingPostureThreshold)
+    {
+        RequestFinisherAssets();
+        return;
+    }
+
+    // Recovered: keep them for a while in case posture drops again, then let them go
+    UCombatTimerWheelSubsystem* TimerWheel = GetWorld() ? GetWorld()->GetSubsystem<UCombatTimerWheelSubsystem>() : nullptr;
+    if (FinisherAssetsHandle.IsValid() && TimerWheel && !TimerWheel->IsTimerActive(FinisherReleaseTimer))
+    {
+        TimerWheel->SetTimer<&UHitReactionComponent::ReleaseFinisherAssets>(FinisherReleaseTimer, this, FinisherReleaseDelay);
+    }
+}
+
+UAnimMontage* UHitReactionComponent::ResolveStreamedMontage(const TSoftObjectPtr<UAnimMontage>& Montage) const
+{
+    if (Montage.IsNull())
+    {
+        return nullptr;
+    }
+
+    if (UAnimMontage* Loaded = Montage.Get())
+    {
+        return Loaded;
+    }
+
+    // Posture fell faster than the stream (or streaming is off for this path) - hitch rather than skip the reaction
+    COMBAT_LOG(Warning, TEXT("[HIT REACTION] %s loading %s synchronously (finisher assets not streamed in yet)"),
+        *GetNameSafe(GetOwner()), *Montage.ToString());
+    return Montage.LoadSynchronous();
+}
+
 // ============================================================================
 // STATE QUERIES
 // ============================================================================
@@ -145,33 +598,47 @@ bool UHitReactionComponent::CanBeDamaged() const
     return !bIsInvulnerable;
 }
 
+float UHitReactionComponent::GetRemainingStunTime() const
+{
+    const UWorld* World = GetWorld();
+    if (!bIsStunned || !World)
+    {
+        return 0.0f;
+    }
+
+    return FMath::Max(0.0f, StunEndTime - World->GetTimeSeconds());
+}
+
+float UHitReactionComponent::GetFlinchAlpha() const
+{
+    const UWorld* World = GetWorld();
+    if (FlinchStartTime < 0.0f || !World)
+    {
+        return 0.0f;
+    }
+
+    const float Elapsed = (World->GetTimeSeconds() - FlinchStartTime) / FlinchDuration;
+    if (Elapsed >= 1.0f)
+    {
+        return 0.0f;
+    }
+
+    // Full weight on impact, quadratic ease-out
+    const float Remaining = 1.0f - Elapsed;
+    return FlinchIntensity * Remaining * Remaining;
+}
+
 // ============================================================================
 // INTERNAL HELPERS
 // ============================================================================
 
 UAnimMontage* UHitReactionComponent::SelectHitReactionMontage(const FHitReactionInfo& HitInfo) const
 {
-    // Determine which animation set to use based on stun duration/damage
-    // Light reactions for shorter stun, heavy for longer
-    const bool bIsHeavyReaction = (HitInfo.StunDuration > 0.3f);
-    const FHitReactionAnimSet& AnimSet = bIsHeavyReaction ? HeavyHitReactions : LightHitReactions;
-    
-    // Determine hit direction relative to character
+    // Light reactions for shorter stun, heavy for longer (threshold is data-driven)
+    const bool bIsHeavyReaction = (HitInfo.StunDuration > GetHeavyHitStunThreshold());
+    const EAttackDirection Direction = GetHitDirectionRelativeToFacing(HitInfo.HitDirection);
 
-    // Select directional animation
-    switch (const EAttackDirection Direction = GetHitDirectionRelativeToFacing(HitInfo.HitDirection))
-    {
-        case EAttackDirection::Forward:
-            return AnimSet.FrontHit;
-        case EAttackDirection::Backward:
-            return AnimSet.BackHit;
-        case EAttackDirection::Left:
-            return AnimSet.LeftHit;
-        case EAttackDirection::Right:
-            return AnimSet.RightHit;
-        default:
-            return AnimSet.FrontHit; // Default to front
-    }
+    return GetReactionTable().GetReaction(bIsStunned, bIsHeavyReaction, Direction);
 }
 
 EAttackDirection UHitReactionComponent::GetHitDirectionRelativeToFacing(const FVector& HitDirection) const
@@ -200,21 +667,23 @@ EAttackDirection UHitReactionComponent::GetHitDirectionRelativeToFacing(const FV
     }
 }
 
-void UHitReactionComponent::UpdateStun(float DeltaTime)
-{
-    StunTimeRemaining -= DeltaTime;
-    
-    if (StunTimeRemaining <= 0.0f)
-    {
-        EndStun();
-    }
-}
-
 void UHitReactionComponent::EndStun()
 {
     bIsStunned = false;
-    StunTimeRemaining = 0.0f;
-    SetComponentTickEnabled(false);
+    StunEndTime = 0.0f;
+
+    if (UWorld* World = GetWorld())
+    {
+        if (UCombatTimerWheelSubsystem* TimerWheel = World->GetSubsystem<UCombatTimerWheelSubsystem>())
+        {
+            TimerWheel->ClearTimer(StunTimer);
+        }
+
+        if (UCombatUIEventSubsystem* UIEvents = World->GetSubsystem<UCombatUIEventSubsystem>())
+        {
+            UIEvents->NotifyStunChanged(GetOwner(), false);
+        }
+    }
     
     OnStunEnd.Broadcast();
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/HitStopSubsystem.h"
+#include "Debug/CombatTrace.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UHitStopSubsystem::Deinitialize()
+{
+    ClearAllHitStops();
+
+    Super::Deinitialize();
+}
+
+bool UHitStopSubsystem::IsTickable() const
+{
+    return ActorStops.Num() > 0 || bGlobalActive;
+}
+
+TStatId UHitStopSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UHitStopSubsystem, STATGROUP_Tickables);
+}
+
+void UHitStopSubsystem::Tick(float DeltaTime)
+{
+    COMBAT_TRACE_SCOPE(UHitStopSubsystem::Tick);
+
+    Super::Tick(DeltaTime);
+
+    const float Now = GetRealTime();
+
+    // One pass: write each actor's merged dilation only if it changed, restore expired ones
+    for (auto It = ActorStops.CreateIterator(); It; ++It)
+    {
+        FActorHitStop& Stop = It.Value();
+        AActor* Actor = Stop.Actor.Get();
+        if (!Actor)
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        if (Now >= Stop.EndTime)
+        {
+            if (Stop.AppliedDilation >= 0.0f)
+            {
+                Actor->CustomTimeDilation = Stop.BaseDilation;
+                ++NumDilationWrites;
+            }
+            It.RemoveCurrent();
+            continue;
+        }
+
+        const float Desired = Stop.BaseDilation * Stop.TimeDilation;
+        if (Stop.AppliedDilation != Desired)
+        {
+            Actor->CustomTimeDilation = Desired;
+            Stop.AppliedDilation = Desired;
+            ++NumDilationWrites;
+        }
+    }
+
+    if (bGlobalActive)
+    {
+        if (Now >= GlobalEndTime)
+        {
+            ApplyGlobalDilation(1.0f);
+            bGlobalActive = false;
+        }
+        else
+        {
+            ApplyGlobalDilation(GlobalDilation);
+        }
+    }
+}
+
+// ============================================================================
+// REQUESTS
+// ============================================================================
+
+void UHitStopSubsystem::RequestHitStop(AActor* Actor, float Duration, float TimeDilation)
+{
+    if (!Actor || Duration <= 0.0f)
+    {
+        return;
+    }
+
+    const float EndTime = GetRealTime() + Duration;
+    TimeDilation = FMath::Clamp(TimeDilation, 0.0001f, 1.0f);
+
+    FActorHitStop* Stop = ActorStops.Find(FObjectKey(Actor));
+    if (!Stop)
+    {
+        Stop = &ActorStops.Add(FObjectKey(Actor));
+        Stop->Actor = Actor;
+        Stop->BaseDilation = Actor->CustomTimeDilation;
+        Stop->TimeDilation = TimeDilation;
+        Stop->EndTime = EndTime;
+        return;
+    }
+
+    // Merge with the running stop
+    Stop->TimeDilation = FMath::Min(Stop->TimeDilation, TimeDilation);
+    Stop->EndTime = FMath::Max(Stop->EndTime, EndTime);
+}
+
+void UHitStopSubsystem::RequestGlobalHitStop(float Duration, float TimeDilation)
+{
+    if (Duration <= 0.0f)
+    {
+        return;
+    }
+
+    const float EndTime = GetRealTime() + Duration;
+    TimeDilation = FMath::Clamp(TimeDilation, 0.0001f, 1.0f);
+
+    GlobalDilation = bGlobalActive ? FMath::Min(GlobalDilation, TimeDilation) : TimeDilation;
+    GlobalEndTime = bGlobalActive ? FMath::Max(GlobalEndTime, EndTime) : EndTime;
+    bGlobalActive = true;
+}
+
+void UHitStopSubsystem::ClearAllHitStops()
+{
+    for (TPair<FObjectKey, FActorHitStop>& Pair : ActorStops)
+    {
+        AActor* Actor = Pair.Value.Actor.Get();
+        if (Actor && Pair.Value.AppliedDilation >= 0.0f)
+        {
+            Actor->CustomTimeDilation = Pair.Value.BaseDilation;
+        }
+    }
+    ActorStops.Reset();
+
+    if (bGlobalActive)
+    {
+        ApplyGlobalDilation(1.0f);
+        bGlobalActive = false;
+    }
+}
+
+bool UHitStopSubsystem::IsActorInHitStop(const AActor* Actor) const
+{
+    return Actor && ActorStops.Contains(FObjectKey(Actor));
+}
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+float UHitStopSubsystem::GetRealTime() const
+{
+    const UWorld* World = GetWorld();
+    return World ? static_cast<float>(World->GetRealTimeSeconds()) : 0.0f;
+}
+
+void UHitStopSubsystem::ApplyGlobalDilation(float Dilation)
+{
+    if (AppliedGlobalDilation == Dilation)
+    {
+        return;
+    }
+
+    AWorldSettings* WorldSettings = GetWorld() ? GetWorld()->GetWorldSettings() : nullptr;
+    if (WorldSettings)
+    {
+        WorldSettings->SetTimeDilation(Dilation);
+        AppliedGlobalDilation = Dilation;
+        ++NumDilationWrites;
+    }
+}
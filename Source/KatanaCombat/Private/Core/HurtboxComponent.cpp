@@ -0,0 +1,24 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/HurtboxComponent.h"
+
+UHurtboxComponent::UHurtboxComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+
+    // Queried only by object type - no physics, no overlaps, no responses
+    SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+    SetCollisionObjectType(HurtboxChannel);
+    SetCollisionResponseToAllChannels(ECR_Ignore);
+    SetGenerateOverlapEvents(false);
+    SetCanEverAffectNavigation(false);
+    CanCharacterStepUpOn = ECB_No;
+    bReturnMaterialOnMove = false;
+
+    InitCapsuleSize(10.0f, 20.0f);
+}
+
+const UHurtboxComponent* UHurtboxComponent::FromHit(const FHitResult& Hit)
+{
+    return Cast<UHurtboxComponent>(Hit.GetComponent());
+}
@@ -0,0 +1,164 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/LagCompensationSubsystem.h"
+#include "Core/TargetRegistrySubsystem.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void ULagCompensationSubsystem::Deinitialize()
+{
+    Histories.Empty();
+
+    Super::Deinitialize();
+}
+
+void ULagCompensationSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    RecordSnapshot(GetWorld()->GetTimeSeconds());
+}
+
+bool ULagCompensationSubsystem::IsTickable() const
+{
+    // Only a server with remote clients has anything to compensate for
+    const UWorld* World = GetWorld();
+    return World && (World->GetNetMode() == NM_DedicatedServer || World->GetNetMode() == NM_ListenServer);
+}
+
+TStatId ULagCompensationSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(ULagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+void ULagCompensationSubsystem::RecordSnapshot(float Time)
+{
+    const UTargetRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<UTargetRegistrySubsystem>() : nullptr;
+    if (!Registry)
+    {
+        return;
+    }
+
+    for (const TWeakObjectPtr<AActor>& WeakActor : Registry->GetRegisteredTargets())
+    {
+        const AActor* Actor = WeakActor.Get();
+        if (!Actor)
+        {
+            continue;
+        }
+
+        FLagCompensationHistory& History = Histories.FindOrAdd(FObjectKey(Actor));
+        if (History.Samples.Num() == 0)
+        {
+            History.Actor = const_cast<AActor*>(Actor);
+            History.Samples.Reserve(HistoryCapacity);
+        }
+
+        // Fill the ring, then overwrite oldest
+        const FLagCompensationSample Sample = MakeSample(Actor, Time);
+        if (History.Samples.Num() < HistoryCapacity)
+        {
+            History.Samples.Add(Sample);
+        }
+        else
+        {
+            History.Samples[History.Head] = Sample;
+        }
+        History.Head = (History.Head + 1) % HistoryCapacity;
+    }
+
+    // Purge destroyed actors
+    for (auto It = Histories.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().Actor.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+FLagCompensationSample ULagCompensationSubsystem::MakeSample(const AActor* Actor, float Time)
+{
+    FLagCompensationSample Sample;
+    Sample.Time = Time;
+    Sample.Location = Actor->GetActorLocation();
+
+    if (const ACharacter* Character = Cast<ACharacter>(Actor))
+    {
+        const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+        Sample.Radius = Capsule->GetScaledCapsuleRadius();
+        Sample.HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+    }
+    else
+    {
+        // Approximate non-characters with an upright capsule around their bounds
+        FVector Origin;
+        FVector Extent;
+        Actor->GetActorBounds(true, Origin, Extent);
+        Sample.Location = Origin;
+        Sample.Radius = FMath::Max(Extent.X, Extent.Y);
+        Sample.HalfHeight = FMath::Max(Extent.Z, Sample.Radius);
+    }
+
+    return Sample;
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+bool ULagCompensationSubsystem::GetRewoundSample(const AActor* Actor, float Time, FLagCompensationSample& OutSample) const
+{
+    const FLagCompensationHistory* History = Actor ? Histories.Find(FObjectKey(Actor)) : nullptr;
+    if (!History || History->Samples.Num() == 0)
+    {
+        return false;
+    }
+
+    const TArray<FLagCompensationSample>& Samples = History->Samples;
+    const int32 Num = Samples.Num();
+
+    // Oldest sample sits at Head once the ring is full, at 0 before that
+    const int32 Oldest = Num < HistoryCapacity ? 0 : History->Head;
+    auto SampleAt = [&](int32 Age) -> const FLagCompensationSample& { return Samples[(Oldest + Age) % Num]; };
+
+    if (Time <= SampleAt(0).Time)
+    {
+        OutSample = SampleAt(0);
+        return true;
+    }
+
+    // Walk back from newest until we find the pair bracketing Time
+    for (int32 Age = Num - 1; Age > 0; --Age)
+    {
+        const FLagCompensationSample& After = SampleAt(Age);
+        const FLagCompensationSample& Before = SampleAt(Age - 1);
+        if (Time >= Before.Time)
+        {
+            if (Time >= After.Time)
+            {
+                OutSample = After;
+                return true;
+            }
+
+            const float Alpha = (Time - Before.Time) / FMath::Max(After.Time - Before.Time, UE_KINDA_SMALL_NUMBER);
+            OutSample.Time = Time;
+            OutSample.Location = FMath::Lerp(Before.Location, After.Location, Alpha);
+            OutSample.Radius = FMath::Lerp(Before.Radius, After.Radius, Alpha);
+            OutSample.HalfHeight = FMath::Lerp(Before.HalfHeight, After.HalfHeight, Alpha);
+            return true;
+        }
+    }
+
+    OutSample = SampleAt(0);
+    return true;
+}
@@ -0,0 +1,229 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/LineOfSightSubsystem.h"
+#include "Core/CombatBudgetSubsystem.h"
+#include "Debug/CombatTrace.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void ULineOfSightSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (UCombatJobSchedulerSubsystem* Scheduler = Collection.InitializeDependency<UCombatJobSchedulerSubsystem>())
+    {
+        Scheduler->RegisterJob<&ULineOfSightSubsystem::EvictStaleEntries>(EvictionJob, this, EvictionInterval, ECombatJobPriority::Low, TEXT("LineOfSight.Evict"));
+    }
+
+    Budget = Collection.InitializeDependency<UCombatBudgetSubsystem>();
+}
+
+void ULineOfSightSubsystem::Deinitialize()
+{
+    if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>() : nullptr)
+    {
+        Scheduler->UnregisterJob(EvictionJob);
+    }
+
+    InvalidateCache();
+
+    Super::Deinitialize();
+}
+
+void ULineOfSightSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    CollectCompletedTraces();
+    SubmitQueuedTraces();
+}
+
+bool ULineOfSightSubsystem::IsTickable() const
+{
+    return Cache.Num() > 0 || PendingTraces.Num() > 0;
+}
+
+TStatId ULineOfSightSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(ULineOfSightSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+bool ULineOfSightSubsystem::HasLineOfSight(AActor* Viewer, AActor* Target, ECollisionChannel TraceChannel, float MaxAge)
+{
+    UWorld* World = GetWorld();
+    if (!World || !Viewer || !Target)
+    {
+        return false;
+    }
+
+    const double Now = World->GetTimeSeconds();
+    const FLineOfSightKey Key(FObjectKey(Viewer), FObjectKey(Target));
+
+    FLineOfSightEntry* Entry = Cache.Find(Key);
+    if (!Entry)
+    {
+        // Nothing to fall back on yet - trace once now, refresh asynchronously afterwards
+        FLineOfSightEntry& NewEntry = Cache.Add(Key);
+        NewEntry.Viewer = Viewer;
+        NewEntry.Target = Target;
+        NewEntry.TraceChannel = TraceChannel;
+        NewEntry.bVisible = TraceLineOfSight(Viewer, Target, TraceChannel);
+        NewEntry.LastTraceTime = Now;
+        NewEntry.LastQueryTime = Now;
+        return NewEntry.bVisible;
+    }
+
+    Entry->LastQueryTime = Now;
+    Entry->TraceChannel = TraceChannel;
+
+    // Targeting over budget: results stay fresh longer, fewer refresh traces
+    const float EffectiveMaxAge = Budget ? MaxAge / Budget->GetDetailScale(ECombatBudgetCategory::Targeting) : MaxAge;
+
+    if (Now - Entry->LastTraceTime > EffectiveMaxAge && !Entry->bRefreshQueued && !Entry->bTraceInFlight)
+    {
+        Entry->bRefreshQueued = true;
+        RefreshQueue.Add(Key);
+    }
+
+    return Entry->bVisible;
+}
+
+void ULineOfSightSubsystem::InvalidateCache()
+{
+    Cache.Empty();
+    RefreshQueue.Empty();
+    PendingTraces.Empty();
+}
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+bool ULineOfSightSubsystem::TraceLineOfSight(AActor* Viewer, AActor* Target, ECollisionChannel TraceChannel) const
+{
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatLineOfSight), false, Viewer);
+    QueryParams.AddIgnoredActor(Target);
+
+    FHitResult HitResult;
+    COMBAT_COUNT_PHYSICS_QUERY();
+    const bool bHit = GetWorld()->LineTraceSingleByChannel(
+        HitResult,
+        Viewer->GetActorLocation(),
+        Target->GetActorLocation(),
+        TraceChannel,
+        QueryParams
+    );
+
+    return !bHit; // No hit means clear line of sight
+}
+
+void ULineOfSightSubsystem::CollectCompletedTraces()
+{
+    UWorld* World = GetWorld();
+    if (!World || PendingTraces.Num() == 0)
+    {
+        return;
+    }
+
+    const double Now = World->GetTimeSeconds();
+    FTraceDatum TraceData;
+
+    for (const FPendingLineOfSightTrace& Pending : PendingTraces)
+    {
+        FLineOfSightEntry* Entry = Cache.Find(Pending.Key);
+        if (!Entry)
+        {
+            continue; // Evicted or invalidated while in flight
+        }
+
+        Entry->bTraceInFlight = false;
+        if (World->QueryTraceData(Pending.Handle, TraceData))
+        {
+            Entry->bVisible = !TraceData.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+            Entry->LastTraceTime = Now;
+        }
+    }
+
+    PendingTraces.Reset();
+}
+
+void ULineOfSightSubsystem::SubmitQueuedTraces()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    int32 Submitted = 0;
+    int32 QueueIndex = 0;
+
+    for (; QueueIndex < RefreshQueue.Num() && Submitted < TraceBudgetPerFrame; ++QueueIndex)
+    {
+        const FLineOfSightKey& Key = RefreshQueue[QueueIndex];
+        FLineOfSightEntry* Entry = Cache.Find(Key);
+        if (!Entry)
+        {
+            continue;
+        }
+
+        Entry->bRefreshQueued = false;
+
+        AActor* Viewer = Entry->Viewer.Get();
+        AActor* Target = Entry->Target.Get();
+        if (!Viewer || !Target)
+        {
+            Cache.Remove(Key);
+            continue;
+        }
+
+        FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatLineOfSight), false, Viewer);
+        QueryParams.AddIgnoredActor(Target);
+
+        FPendingLineOfSightTrace& Pending = PendingTraces.AddDefaulted_GetRef();
+        Pending.Key = Key;
+        COMBAT_COUNT_PHYSICS_QUERY();
+        Pending.Handle = World->AsyncLineTraceByChannel(
+            EAsyncTraceType::Single,
+            Viewer->GetActorLocation(),
+            Target->GetActorLocation(),
+            Entry->TraceChannel,
+            QueryParams
+        );
+
+        Entry->bTraceInFlight = true;
+        ++Submitted;
+    }
+
+    // Anything past the budget waits for next frame, oldest first
+    RefreshQueue.RemoveAt(0, QueueIndex, EAllowShrinking::No);
+}
+
+void ULineOfSightSubsystem::EvictStaleEntries(float DeltaTime)
+{
+    COMBAT_TRACE_SCOPE(ULineOfSightSubsystem::EvictStaleEntries);
+
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    const double Now = World->GetTimeSeconds();
+    for (auto It = Cache.CreateIterator(); It; ++It)
+    {
+        const FLineOfSightEntry& Entry = It.Value();
+        if (!Entry.bTraceInFlight && !Entry.bRefreshQueued && Now - Entry.LastQueryTime > EvictionAge)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
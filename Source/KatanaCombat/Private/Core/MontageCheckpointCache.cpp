@@ -0,0 +1,130 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/MontageCheckpointCache.h"
+#include "Animation/AnimMontage.h"
+#include "Algo/BinarySearch.h"
+#include "Utilities/MontageUtilityLibrary.h"
+#include "Debug/CombatTrace.h"
+
+// ============================================================================
+// TABLE
+// ============================================================================
+
+TConstArrayView<FTimerCheckpoint> FMontageCheckpointTable::GetCheckpoints(FName SectionName) const
+{
+    if (SectionName.IsNone())
+    {
+        return Checkpoints;
+    }
+
+    for (const FSectionRange& Section : Sections)
+    {
+        if (Section.SectionName == SectionName)
+        {
+            return TConstArrayView<FTimerCheckpoint>(Checkpoints.GetData() + Section.First, Section.Num);
+        }
+    }
+
+    return TConstArrayView<FTimerCheckpoint>();
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void UMontageCheckpointCache::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+#if WITH_EDITOR
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddUObject(this, &UMontageCheckpointCache::OnObjectModified);
+#endif
+}
+
+void UMontageCheckpointCache::Deinitialize()
+{
+#if WITH_EDITOR
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+#endif
+
+    Tables.Empty();
+
+    Super::Deinitialize();
+}
+
+#if WITH_EDITOR
+void UMontageCheckpointCache::OnObjectModified(UObject* Object)
+{
+    if (const UAnimMontage* Montage = Cast<UAnimMontage>(Object))
+    {
+        InvalidateMontage(Montage);
+    }
+}
+#endif
+
+// ============================================================================
+// LOOKUP
+// ============================================================================
+
+const FMontageCheckpointTable* UMontageCheckpointCache::FindOrBuildTable(UAnimMontage* Montage)
+{
+    if (!Montage)
+    {
+        return nullptr;
+    }
+
+    const FObjectKey Key(Montage);
+    if (const FMontageCheckpointTable* Existing = Tables.Find(Key))
+    {
+        return Existing;
+    }
+
+    COMBAT_LLM_SCOPE(CheckpointCache);
+    FMontageCheckpointTable& Table = Tables.Add(Key);
+    BuildTable(Montage, Table);
+    return &Table;
+}
+
+TConstArrayView<FTimerCheckpoint> UMontageCheckpointCache::GetCheckpoints(UAnimMontage* Montage, FName SectionName)
+{
+    const FMontageCheckpointTable* Table = FindOrBuildTable(Montage);
+    return Table ? Table->GetCheckpoints(SectionName) : TConstArrayView<FTimerCheckpoint>();
+}
+
+SIZE_T UMontageCheckpointCache::GetAllocatedSize() const
+{
+    SIZE_T Size = Tables.GetAllocatedSize();
+    for (const TPair<FObjectKey, FMontageCheckpointTable>& Pair : Tables)
+    {
+        Size += Pair.Value.Checkpoints.GetAllocatedSize() + Pair.Value.Sections.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void UMontageCheckpointCache::InvalidateMontage(const UAnimMontage* Montage)
+{
+    Tables.Remove(FObjectKey(Montage));
+}
+
+void UMontageCheckpointCache::BuildTable(UAnimMontage* Montage, FMontageCheckpointTable& OutTable)
+{
+    COMBAT_TRACE_SCOPE(UMontageCheckpointCache::BuildTable);
+
+    UMontageUtilityLibrary::DiscoverCheckpoints(Montage, OutTable.Checkpoints);
+
+    // Checkpoints are sorted by time, so each section owns a contiguous range
+    const FMontageSectionTable* SectionTable = UMontageUtilityLibrary::GetSectionTable(Montage);
+    OutTable.Sections.Reset();
+    for (int32 SectionIndex = 0; SectionIndex < SectionTable->Num(); ++SectionIndex)
+    {
+        FMontageCheckpointTable::FSectionRange& Range = OutTable.Sections.AddDefaulted_GetRef();
+        Range.SectionName = SectionTable->Names[SectionIndex];
+        Range.First = Algo::LowerBoundBy(OutTable.Checkpoints, SectionTable->StartTimes[SectionIndex], &FTimerCheckpoint::MontageTime);
+        Range.Num = Algo::LowerBoundBy(OutTable.Checkpoints, SectionTable->EndTimes[SectionIndex], &FTimerCheckpoint::MontageTime) - Range.First;
+    }
+
+    OutTable.Checkpoints.Shrink();
+
+    COMBAT_LOG(Verbose, TEXT("[CHECKPOINT CACHE] Built table for %s: %d checkpoints, %d sections"),
+        *Montage->GetName(), OutTable.Checkpoints.Num(), OutTable.Sections.Num());
+}
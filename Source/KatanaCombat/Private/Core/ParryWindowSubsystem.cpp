@@ -0,0 +1,175 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/ParryWindowSubsystem.h"
+#include "Core/MontageCheckpointCache.h"
+#include "GameFramework/Character.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Engine/World.h"
+
+void UParryWindowSubsystem::Deinitialize()
+{
+    OpenParryWindows.Empty();
+    RecentlyClosedWindows.Empty();
+
+    Super::Deinitialize();
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+void UParryWindowSubsystem::RegisterParryWindow(AActor* Attacker)
+{
+    if (Attacker)
+    {
+        OpenParryWindows.AddUnique(Attacker);
+    }
+}
+
+void UParryWindowSubsystem::UnregisterParryWindow(AActor* Attacker)
+{
+    if (OpenParryWindows.RemoveSwap(Attacker) == 0 || !GetWorld())
+    {
+        return;
+    }
+
+    const float Now = GetWorld()->GetTimeSeconds();
+    RecentlyClosedWindows.RemoveAllSwap([Now, Attacker](const FClosedParryWindow& Closed)
+    {
+        return Now - Closed.CloseTime > ClosedWindowMemory || Closed.Attacker == Attacker || !Closed.Attacker.IsValid();
+    });
+    RecentlyClosedWindows.Add({ Attacker, Now });
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+AActor* UParryWindowSubsystem::FindParryableAttacker(const AActor* Defender, float MaxRange, float InputTime) const
+{
+    if (!Defender)
+    {
+        return nullptr;
+    }
+
+    const FVector DefenderLocation = Defender->GetActorLocation();
+    float BestDistanceSq = FMath::Square(MaxRange);
+    AActor* BestAttacker = nullptr;
+
+    for (const TWeakObjectPtr<AActor>& WeakAttacker : OpenParryWindows)
+    {
+        AActor* Attacker = WeakAttacker.Get();
+        if (!Attacker || Attacker == Defender)
+        {
+            continue;
+        }
+
+        const float DistanceSq = FVector::DistSquared(DefenderLocation, Attacker->GetActorLocation());
+        if (DistanceSq <= BestDistanceSq)
+        {
+            BestDistanceSq = DistanceSq;
+            BestAttacker = Attacker;
+        }
+    }
+
+    // Press happened before a window that has since closed (processed late)
+    if (InputTime >= 0.0f)
+    {
+        for (const FClosedParryWindow& Closed : RecentlyClosedWindows)
+        {
+            AActor* Attacker = Closed.Attacker.Get();
+            if (!Attacker || Attacker == Defender || Closed.CloseTime < InputTime)
+            {
+                continue;
+            }
+
+            const float DistanceSq = FVector::DistSquared(DefenderLocation, Attacker->GetActorLocation());
+            if (DistanceSq <= BestDistanceSq)
+            {
+                BestDistanceSq = DistanceSq;
+                BestAttacker = Attacker;
+            }
+        }
+    }
+
+    return BestAttacker;
+}
+
+bool UParryWindowSubsystem::IsParryWindowOpen(const AActor* Attacker) const
+{
+    return Attacker && OpenParryWindows.ContainsByPredicate([Attacker](const TWeakObjectPtr<AActor>& WeakAttacker)
+    {
+        return WeakAttacker.Get() == Attacker;
+    });
+}
+
+bool UParryWindowSubsystem::WasParryWindowOpenAt(const AActor* Attacker, float Time) const
+{
+    return IsParryWindowOpen(Attacker) || ClosedAfter(Attacker, Time);
+}
+
+bool UParryWindowSubsystem::ClosedAfter(const AActor* Attacker, float Time) const
+{
+    if (!Attacker)
+    {
+        return false;
+    }
+
+    for (const FClosedParryWindow& Closed : RecentlyClosedWindows)
+    {
+        if (Closed.Attacker.Get() == Attacker && Closed.CloseTime >= Time)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+TOptional<bool> UParryWindowSubsystem::EvaluateParryWindowAt(const AActor* Attacker, float Time) const
+{
+    const ACharacter* Character = Cast<ACharacter>(Attacker);
+    UWorld* World = GetWorld();
+    const USkeletalMeshComponent* Mesh = Character ? Character->GetMesh() : nullptr;
+    const UAnimInstance* AnimInstance = Mesh ? Mesh->GetAnimInstance() : nullptr;
+    UAnimMontage* Montage = AnimInstance ? AnimInstance->GetCurrentActiveMontage() : nullptr;
+    UMontageCheckpointCache* CheckpointCache = World ? World->GetSubsystem<UMontageCheckpointCache>() : nullptr;
+    if (!Montage || !CheckpointCache)
+    {
+        return {};
+    }
+
+    const TConstArrayView<FTimerCheckpoint> Checkpoints = CheckpointCache->GetCheckpoints(Montage);
+    if (!Checkpoints.ContainsByPredicate([](const FTimerCheckpoint& Checkpoint) { return Checkpoint.WindowType == EActionWindowType::Parry; }))
+    {
+        // Windows opened from code (AI telegraphs) - only the registry knows
+        return {};
+    }
+
+    // Position is as of the attacker's last pose tick: this frame if it already ran, else the previous one
+    const float Now = World->GetTimeSeconds();
+    const float SampleTime = Mesh->PoseTickedThisFrame() ? Now : Now - World->GetDeltaSeconds();
+    const float PlayRate = AnimInstance->Montage_GetPlayRate(Montage) * Montage->RateScale * Attacker->CustomTimeDilation;
+    const float MontageTime = ExtrapolateMontageTime(AnimInstance->Montage_GetPosition(Montage), SampleTime, PlayRate, Time);
+
+    return IsInParryCheckpoint(Checkpoints, MontageTime);
+}
+
+bool UParryWindowSubsystem::IsInParryCheckpoint(TConstArrayView<FTimerCheckpoint> Checkpoints, float MontageTime)
+{
+    for (const FTimerCheckpoint& Checkpoint : Checkpoints)
+    {
+        // Sorted by start - nothing later can contain MontageTime
+        if (Checkpoint.MontageTime > MontageTime)
+        {
+            break;
+        }
+
+        if (Checkpoint.WindowType == EActionWindowType::Parry && MontageTime <= Checkpoint.MontageTime + Checkpoint.Duration)
+        {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,342 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/PlayRateEasingSubsystem.h"
+#include "GameFramework/Character.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Debug/CombatTrace.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UPlayRateEasingSubsystem::Deinitialize()
+{
+    ActiveEases.Empty();
+    Arbiters.Empty();
+    NumDirtyArbiters = 0;
+
+    Super::Deinitialize();
+}
+
+bool UPlayRateEasingSubsystem::IsTickable() const
+{
+    return ActiveEases.Num() > 0 || NumDirtyArbiters > 0;
+}
+
+TStatId UPlayRateEasingSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UPlayRateEasingSubsystem, STATGROUP_Tickables);
+}
+
+void UPlayRateEasingSubsystem::Tick(float DeltaTime)
+{
+    COMBAT_TRACE_SCOPE(UPlayRateEasingSubsystem::Tick);
+
+    Super::Tick(DeltaTime);
+
+    // Pass 1: advance every ease and evaluate all easing curves in one batch
+    const int32 NumEases = ActiveEases.Num();
+    Alphas.SetNumUninitialized(NumEases, EAllowShrinking::No);
+    EasingTypes.SetNumUninitialized(NumEases, EAllowShrinking::No);
+    EasedAlphas.SetNumUninitialized(NumEases, EAllowShrinking::No);
+
+    for (int32 i = 0; i < NumEases; ++i)
+    {
+        FActiveEase& Ease = ActiveEases[i];
+        Ease.Elapsed += DeltaTime;
+        Ease.bFinished = Ease.Elapsed >= Ease.Duration;
+        Alphas[i] = Ease.Duration > 0.0f ? Ease.Elapsed / Ease.Duration : 1.0f;
+        EasingTypes[i] = Ease.EasingType;
+    }
+
+    UMontageUtilityLibrary::EvaluateEasingBatch(Alphas, EasingTypes, EasedAlphas);
+
+    for (int32 i = 0; i < NumEases; ++i)
+    {
+        FActiveEase& Ease = ActiveEases[i];
+        Ease.CurrentRate = Ease.bFinished ? Ease.TargetRate : FMath::Lerp(Ease.StartRate, Ease.TargetRate, EasedAlphas[i]);
+    }
+
+    // Pass 2: request eased playrates, retire finished/orphaned eases, then apply every
+    // character's winning rate (one call per anim instance)
+    UpdatedEaseIds.Reset();
+    FinishedCallbacks.Reset();
+
+    for (int32 i = ActiveEases.Num() - 1; i >= 0; --i)
+    {
+        FActiveEase& Ease = ActiveEases[i];
+        ACharacter* Character = Ease.Character.Get();
+        if (!Character || !Ease.AnimInstance.IsValid())
+        {
+            ActiveEases.RemoveAtSwap(i, EAllowShrinking::No);
+            continue;
+        }
+
+        RequestPlayRate(Character, EPlayRatePriority::Hold, Ease.CurrentRate);
+
+        if (Ease.bFinished)
+        {
+            FinishedCallbacks.Add(MoveTemp(Ease.OnFinished));
+            ActiveEases.RemoveAtSwap(i, EAllowShrinking::No);
+        }
+        else if (Ease.OnUpdated.IsBound())
+        {
+            UpdatedEaseIds.Add(Ease.Id);
+        }
+    }
+
+    FlushPlayRates();
+
+    // Pass 3: callbacks (may start/cancel eases, so look each one up again)
+    for (const uint32 Id : UpdatedEaseIds)
+    {
+        const int32 Index = FindEaseIndex(Id);
+        if (Index != INDEX_NONE)
+        {
+            // Copy out - the callback may add eases and reallocate ActiveEases
+            const FOnPlayRateEaseUpdated OnUpdated = ActiveEases[Index].OnUpdated;
+            OnUpdated.ExecuteIfBound(ActiveEases[Index].CurrentRate);
+        }
+    }
+
+    for (FOnPlayRateEaseFinished& Callback : FinishedCallbacks)
+    {
+        Callback.ExecuteIfBound();
+    }
+    FinishedCallbacks.Reset();
+}
+
+// ============================================================================
+// EASES
+// ============================================================================
+
+FPlayRateEaseHandle UPlayRateEasingSubsystem::StartEase(ACharacter* Character, float StartRate, float TargetRate, float Duration,
+    EEasingType EasingType, FOnPlayRateEaseUpdated OnUpdated, FOnPlayRateEaseFinished OnFinished)
+{
+    FPlayRateEaseHandle Handle;
+
+    UAnimInstance* AnimInstance = (Character && Character->GetMesh()) ? Character->GetMesh()->GetAnimInstance() : nullptr;
+    if (!AnimInstance)
+    {
+        return Handle;
+    }
+
+    // One ease per anim instance - replace any running ease
+    FActiveEase* Ease = ActiveEases.FindByPredicate([AnimInstance](const FActiveEase& Existing)
+    {
+        return Existing.AnimInstance.Get() == AnimInstance;
+    });
+    if (!Ease)
+    {
+        Ease = &ActiveEases.AddDefaulted_GetRef();
+    }
+
+    Ease->Id = NextEaseId++;
+    if (NextEaseId == 0)
+    {
+        NextEaseId = 1; // Skip invalid id on wrap
+    }
+    Ease->Character = Character;
+    Ease->AnimInstance = AnimInstance;
+    Ease->StartRate = StartRate;
+    Ease->TargetRate = TargetRate;
+    Ease->Duration = Duration;
+    Ease->Elapsed = 0.0f;
+    Ease->CurrentRate = StartRate;
+    Ease->EasingType = EasingType;
+    Ease->bFinished = false;
+    Ease->OnUpdated = MoveTemp(OnUpdated);
+    Ease->OnFinished = MoveTemp(OnFinished);
+
+    Handle.Id = Ease->Id;
+    return Handle;
+}
+
+bool UPlayRateEasingSubsystem::CancelEase(FPlayRateEaseHandle& Handle)
+{
+    const int32 Index = FindEaseIndex(Handle.Id);
+    Handle.Reset();
+
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    ActiveEases.RemoveAtSwap(Index, EAllowShrinking::No);
+    return true;
+}
+
+bool UPlayRateEasingSubsystem::IsEaseActive(FPlayRateEaseHandle Handle) const
+{
+    return FindEaseIndex(Handle.Id) != INDEX_NONE;
+}
+
+// ============================================================================
+// ARBITRATION
+// ============================================================================
+
+float UPlayRateEasingSubsystem::FPlayRateArbiter::GetResolvedRate() const
+{
+    if (RequestMask == 0)
+    {
+        return 1.0f;
+    }
+
+    // Highest set bit = highest priority
+    return Rates[FMath::FloorLog2(RequestMask)];
+}
+
+void UPlayRateEasingSubsystem::RequestPlayRate(ACharacter* Character, EPlayRatePriority Priority, float PlayRate)
+{
+    if (!Character)
+    {
+        return;
+    }
+
+    FPlayRateArbiter* Arbiter = FindArbiter(Character);
+    if (!Arbiter)
+    {
+        Arbiter = &Arbiters.AddDefaulted_GetRef();
+        Arbiter->Character = Character;
+    }
+
+    const int32 Slot = static_cast<int32>(Priority);
+    Arbiter->Rates[Slot] = PlayRate;
+    Arbiter->RequestMask |= 1 << Slot;
+
+    if (!Arbiter->bDirty)
+    {
+        Arbiter->bDirty = true;
+        ++NumDirtyArbiters;
+    }
+}
+
+void UPlayRateEasingSubsystem::ClearPlayRate(ACharacter* Character, EPlayRatePriority Priority)
+{
+    FPlayRateArbiter* Arbiter = FindArbiter(Character);
+    const uint8 Bit = 1 << static_cast<int32>(Priority);
+    if (!Arbiter || !(Arbiter->RequestMask & Bit))
+    {
+        return;
+    }
+
+    Arbiter->RequestMask &= ~Bit;
+
+    if (!Arbiter->bDirty)
+    {
+        Arbiter->bDirty = true;
+        ++NumDirtyArbiters;
+    }
+}
+
+void UPlayRateEasingSubsystem::ClearPlayRates(ACharacter* Character)
+{
+    if (!Character)
+    {
+        return;
+    }
+
+    // Restores land even on characters that never requested through here (direct montage writes)
+    FPlayRateArbiter* Arbiter = FindArbiter(Character);
+    if (!Arbiter)
+    {
+        Arbiter = &Arbiters.AddDefaulted_GetRef();
+        Arbiter->Character = Character;
+    }
+
+    Arbiter->RequestMask = 0;
+
+    if (!Arbiter->bDirty)
+    {
+        Arbiter->bDirty = true;
+        ++NumDirtyArbiters;
+    }
+}
+
+float UPlayRateEasingSubsystem::GetPlayRate(const ACharacter* Character) const
+{
+    const FPlayRateArbiter* Arbiter = FindArbiter(Character);
+    if (Arbiter && Arbiter->bDirty)
+    {
+        return Arbiter->GetResolvedRate();
+    }
+
+    return UMontageUtilityLibrary::GetMontagePlayRate(const_cast<ACharacter*>(Character));
+}
+
+void UPlayRateEasingSubsystem::FlushPlayRates()
+{
+    if (NumDirtyArbiters == 0)
+    {
+        return;
+    }
+
+    for (int32 i = Arbiters.Num() - 1; i >= 0; --i)
+    {
+        FPlayRateArbiter& Arbiter = Arbiters[i];
+        ACharacter* Character = Arbiter.Character.Get();
+        if (!Character)
+        {
+            Arbiters.RemoveAtSwap(i, EAllowShrinking::No);
+            continue;
+        }
+
+        if (!Arbiter.bDirty)
+        {
+            continue;
+        }
+        Arbiter.bDirty = false;
+
+        UAnimInstance* AnimInstance = Arbiter.AnimInstance.Get();
+        if (!AnimInstance)
+        {
+            AnimInstance = Character->GetMesh() ? Character->GetMesh()->GetAnimInstance() : nullptr;
+            Arbiter.AnimInstance = AnimInstance;
+        }
+
+        // Only the winning rate, and only when it changes anything
+        UAnimMontage* Montage = AnimInstance ? AnimInstance->GetCurrentActiveMontage() : nullptr;
+        const float PlayRate = Arbiter.GetResolvedRate();
+        if (Montage && AnimInstance->Montage_GetPlayRate(Montage) != PlayRate)
+        {
+            AnimInstance->Montage_SetPlayRate(Montage, PlayRate);
+            ++NumPlayRateWrites;
+        }
+
+        // Nothing requested any more - the restore to 1.0 was the last write
+        if (Arbiter.RequestMask == 0)
+        {
+            Arbiters.RemoveAtSwap(i, EAllowShrinking::No);
+        }
+    }
+
+    NumDirtyArbiters = 0;
+}
+
+UPlayRateEasingSubsystem::FPlayRateArbiter* UPlayRateEasingSubsystem::FindArbiter(const ACharacter* Character)
+{
+    return Character ? Arbiters.FindByPredicate([Character](const FPlayRateArbiter& Arbiter)
+    {
+        return Arbiter.Character.Get() == Character;
+    }) : nullptr;
+}
+
+const UPlayRateEasingSubsystem::FPlayRateArbiter* UPlayRateEasingSubsystem::FindArbiter(const ACharacter* Character) const
+{
+    return const_cast<UPlayRateEasingSubsystem*>(this)->FindArbiter(Character);
+}
+
+int32 UPlayRateEasingSubsystem::FindEaseIndex(uint32 Id) const
+{
+    if (Id == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    return ActiveEases.IndexOfByPredicate([Id](const FActiveEase& Ease)
+    {
+        return Ease.Id == Id;
+    });
+}
@@ -0,0 +1,215 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/TargetRegistrySubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UTargetRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (UWorld* World = GetWorld())
+    {
+        ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UTargetRegistrySubsystem::OnActorSpawned));
+    }
+}
+
+void UTargetRegistrySubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+    }
+
+    TargetActors.Empty();
+    TargetKeys.Empty();
+    PositionsX.Empty();
+    PositionsY.Empty();
+    PositionsZ.Empty();
+    TargetCells.Empty();
+    TargetIndices.Empty();
+    Cells.Empty();
+
+    Super::Deinitialize();
+}
+
+void UTargetRegistrySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Level-placed pawns don't go through the spawn handler
+    for (TActorIterator<APawn> It(&InWorld); It; ++It)
+    {
+        RegisterTarget(*It);
+    }
+}
+
+void UTargetRegistrySubsystem::OnActorSpawned(AActor* Actor)
+{
+    if (Cast<APawn>(Actor))
+    {
+        RegisterTarget(Actor);
+    }
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+void UTargetRegistrySubsystem::RegisterTarget(AActor* Actor)
+{
+    if (!Actor || TargetIndices.Contains(FObjectKey(Actor)))
+    {
+        return;
+    }
+
+    const FVector Location = Actor->GetActorLocation();
+    const FIntPoint Cell = GetCellCoord(Location.X, Location.Y);
+
+    const int32 Index = TargetActors.Add(Actor);
+    TargetKeys.Add(FObjectKey(Actor));
+    PositionsX.Add(Location.X);
+    PositionsY.Add(Location.Y);
+    PositionsZ.Add(Location.Z);
+    TargetCells.Add(Cell);
+
+    TargetIndices.Add(FObjectKey(Actor), Index);
+    Cells.FindOrAdd(Cell).Add(Index);
+}
+
+void UTargetRegistrySubsystem::UnregisterTarget(AActor* Actor)
+{
+    if (const int32* Index = TargetIndices.Find(FObjectKey(Actor)))
+    {
+        RemoveAtIndex(*Index);
+    }
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+int32 UTargetRegistrySubsystem::QueryTargetsInRadius(const FVector& Center, float Radius, TArray<AActor*>& OutActors, const AActor* IgnoreActor)
+{
+    if (LastRefreshFrame != GFrameCounter)
+    {
+        RefreshPositions();
+        LastRefreshFrame = GFrameCounter;
+    }
+
+    const FIntPoint MinCell = GetCellCoord(Center.X - Radius, Center.Y - Radius);
+    const FIntPoint MaxCell = GetCellCoord(Center.X + Radius, Center.Y + Radius);
+    const float RadiusSq = FMath::Square(Radius);
+    const int32 StartNum = OutActors.Num();
+
+    for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+    {
+        for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+        {
+            const TArray<int32, TInlineAllocator<8>>* CellIndices = Cells.Find(FIntPoint(CellX, CellY));
+            if (!CellIndices)
+            {
+                continue;
+            }
+
+            for (const int32 Index : *CellIndices)
+            {
+                const float DX = PositionsX[Index] - Center.X;
+                const float DY = PositionsY[Index] - Center.Y;
+                const float DZ = PositionsZ[Index] - Center.Z;
+                if (DX * DX + DY * DY + DZ * DZ > RadiusSq)
+                {
+                    continue;
+                }
+
+                AActor* Actor = TargetActors[Index].Get();
+                if (Actor && Actor != IgnoreActor)
+                {
+                    OutActors.Add(Actor);
+                }
+            }
+        }
+    }
+
+    return OutActors.Num() - StartNum;
+}
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+void UTargetRegistrySubsystem::RefreshPositions()
+{
+    for (int32 Index = TargetActors.Num() - 1; Index >= 0; --Index)
+    {
+        const AActor* Actor = TargetActors[Index].Get();
+        if (!Actor)
+        {
+            RemoveAtIndex(Index);
+            continue;
+        }
+
+        const FVector Location = Actor->GetActorLocation();
+        PositionsX[Index] = Location.X;
+        PositionsY[Index] = Location.Y;
+        PositionsZ[Index] = Location.Z;
+
+        // Only touch the grid when the actor crosses a cell boundary
+        const FIntPoint NewCell = GetCellCoord(Location.X, Location.Y);
+        if (NewCell != TargetCells[Index])
+        {
+            if (TArray<int32, TInlineAllocator<8>>* OldCell = Cells.Find(TargetCells[Index]))
+            {
+                OldCell->RemoveSwap(Index);
+            }
+            Cells.FindOrAdd(NewCell).Add(Index);
+            TargetCells[Index] = NewCell;
+        }
+    }
+}
+
+void UTargetRegistrySubsystem::RemoveAtIndex(int32 Index)
+{
+    if (!TargetActors.IsValidIndex(Index))
+    {
+        return;
+    }
+
+    // Remove from its cell and the actor → index map
+    if (TArray<int32, TInlineAllocator<8>>* Cell = Cells.Find(TargetCells[Index]))
+    {
+        Cell->RemoveSwap(Index);
+        if (Cell->Num() == 0)
+        {
+            Cells.Remove(TargetCells[Index]);
+        }
+    }
+    TargetIndices.Remove(TargetKeys[Index]);
+
+    // Move last entry into the freed slot and patch its references
+    const int32 LastIndex = TargetActors.Num() - 1;
+    if (Index != LastIndex)
+    {
+        if (TArray<int32, TInlineAllocator<8>>* LastCell = Cells.Find(TargetCells[LastIndex]))
+        {
+            const int32 SlotInCell = LastCell->Find(LastIndex);
+            if (SlotInCell != INDEX_NONE)
+            {
+                (*LastCell)[SlotInCell] = Index;
+            }
+        }
+        TargetIndices.Add(TargetKeys[LastIndex], Index);
+    }
+
+    TargetActors.RemoveAtSwap(Index);
+    TargetKeys.RemoveAtSwap(Index);
+    PositionsX.RemoveAtSwap(Index);
+    PositionsY.RemoveAtSwap(Index);
+    PositionsZ.RemoveAtSwap(Index);
+    TargetCells.RemoveAtSwap(Index);
+}
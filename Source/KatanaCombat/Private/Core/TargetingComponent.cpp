@@ -1,16 +1,29 @@
 ﻿// Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Core/TargetingComponent.h"
+#include "Core/TargetRegistrySubsystem.h"
+#include "Core/LineOfSightSubsystem.h"
+#include "Core/CombatSignificanceSubsystem.h"
+#include "Core/CombatScratch.h"
+#include "Core/HurtboxComponent.h"
+#include "Data/AttackData.h"
+#include "Data/CombatArchetype.h"
+#include "Debug/CombatTrace.h"
 #include "GameFramework/Character.h"
+#include "Animation/AnimInstance.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "MotionWarpingComponent.h"
 #include "Kismet/GameplayStatics.h"
-#include "DrawDebugHelpers.h"
+#include "Debug/CombatDebugDrawSubsystem.h"
+#include "Algo/Sort.h"
 #include "Engine/OverlapResult.h"
 #include "Engine/World.h"
 
 UTargetingComponent::UTargetingComponent()
 {
-    PrimaryComponentTick.bCanEverTick = false;
+    // Ticks only while warp targets are tracked
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
     
     DirectionalConeAngle = 60.0f;
     MaxTargetDistance = 1000.0f;
@@ -30,6 +43,17 @@ void UTargetingComponent::BeginPlay()
     {
         MotionWarpingComponent = OwnerCharacter->FindComponentByClass<UMotionWarpingComponent>();
     }
+
+    SetComponentTickInterval(WarpTrackingInterval);
+}
+
+void UTargetingComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+    Super::GetResourceSizeEx(CumulativeResourceSize);
+
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(CachedTargetScores.GetAllocatedSize()
+        + CachedDirectionX.GetAllocatedSize() + CachedDirectionY.GetAllocatedSize() + CachedDirectionZ.GetAllocatedSize()
+        + CachedDistanceSquared.GetAllocatedSize() + CachedVisibility.GetAllocatedSize() + QueryPassMask.GetAllocatedSize());
 }
 
 // ============================================================================
@@ -60,17 +84,27 @@ AActor* UTargetingComponent::FindTargetInDirection(const FVector& DirectionVecto
     return FindBestTarget(NormalizedDirection);
 }
 
+AActor* UTargetingComponent::FindTargetForAttack(const UAttackData* AttackData, EAttackDirection Direction)
+{
+    if (!OwnerCharacter)
+    {
+        return nullptr;
+    }
+
+    // Only warping attacks are limited by reach; the rest keep the component's own range
+    const bool bLimitByReach = AttackData && AttackData->MotionWarpingConfig.bUseMotionWarping;
+    const float MaxDistance = bLimitByReach ? AttackData->GetMaxTargetDistance() : -1.0f;
+
+    return FindBestTarget(GetDirectionVector(Direction, false), MaxDistance);
+}
+
 int32 UTargetingComponent::GetAllTargetsInRange(TArray<AActor*>& OutTargets)
 {
     OutTargets.Empty();
     
-    GetActorsInRange(OutTargets);
-    FilterByTargetableClass(OutTargets);
-    
-    if (bRequireLineOfSight)
-    {
-        FilterByLineOfSight(OutTargets);
-    }
+    // Same fused query as target selection, without the cone - served from the per-frame score cache
+    RefreshTargetScores();
+    QueryCandidates(FVector::ZeroVector, MAX_flt, MAX_int32, OutTargets);
     
     return OutTargets.Num();
 }
@@ -110,6 +144,7 @@ bool UTargetingComponent::HasLineOfSightTo(AActor* Target) const
     QueryParams.AddIgnoredActor(OwnerCharacter);
     QueryParams.AddIgnoredActor(Target);
     
+    COMBAT_COUNT_PHYSICS_QUERY();
     const bool bHit = GetWorld()->LineTraceSingleByChannel(
         HitResult,
         Start,
@@ -227,10 +262,35 @@ bool UTargetingComponent::SetupMotionWarp(AActor* Target, FName WarpTargetName,
         WarpLocation,
         LookAtRotation
     );
+
+    TrackWarpTarget(WarpTargetName, Target, nullptr, MaxDistance);
     
     return true;
 }
 
+bool UTargetingComponent::SetupMotionWarpForAttack(AActor* Target, const UAttackData* AttackData)
+{
+    if (!MotionWarpingComponent || !Target || !OwnerCharacter || !AttackData)
+    {
+        return false;
+    }
+
+    const FName WarpTargetName = AttackData->MotionWarpingConfig.MotionWarpingTargetName;
+
+    FVector WarpLocation;
+    FRotator LookAtRotation;
+    if (!CalculateAttackWarp(Target->GetActorLocation(), AttackData, WarpLocation, LookAtRotation))
+    {
+        MotionWarpingComponent->RemoveWarpTarget(WarpTargetName);
+        StopTrackingWarpTarget(WarpTargetName);
+        return false;
+    }
+
+    MotionWarpingComponent->AddOrUpdateWarpTargetFromLocationAndRotation(WarpTargetName, WarpLocation, LookAtRotation);
+    TrackWarpTarget(WarpTargetName, Target, AttackData, -1.0f);
+    return true;
+}
+
 void UTargetingComponent::ClearMotionWarp(FName WarpTargetName)
 {
     if (!MotionWarpingComponent)
@@ -246,6 +306,114 @@ void UTargetingComponent::ClearMotionWarp(FName WarpTargetName)
     {
         MotionWarpingComponent->RemoveWarpTarget(WarpTargetName);
     }
+
+    StopTrackingWarpTarget(WarpTargetName);
+}
+
+// ============================================================================
+// MOTION WARPING - TARGET TRACKING
+// ============================================================================
+
+void UTargetingComponent::TrackWarpTarget(FName WarpTargetName, AActor* Target, const UAttackData* AttackData, float MaxDistance)
+{
+    StopTrackingWarpTarget(WarpTargetName);
+
+    if (!bTrackWarpTargets || !Target)
+    {
+        return;
+    }
+
+    FTrackedWarp& Tracked = TrackedWarps.AddDefaulted_GetRef();
+    Tracked.WarpTargetName = WarpTargetName;
+    Tracked.Target = Target;
+    Tracked.AttackData = AttackData;
+    Tracked.MaxDistance = MaxDistance;
+    Tracked.LastTargetLocation = Target->GetActorLocation();
+
+    // The attack montage usually starts right after the warp is set up, so fall back to whatever plays on the first update
+    Tracked.Montage = AttackData ? AttackData->AttackMontage.Get() : nullptr;
+
+    SetComponentTickInterval(WarpTrackingInterval);
+    SetComponentTickEnabled(true);
+}
+
+void UTargetingComponent::StopTrackingWarpTarget(FName WarpTargetName)
+{
+    if (WarpTargetName == NAME_None)
+    {
+        TrackedWarps.Reset();
+    }
+    else
+    {
+        TrackedWarps.RemoveAll([WarpTargetName](const FTrackedWarp& Tracked) { return Tracked.WarpTargetName == WarpTargetName; });
+    }
+
+    if (TrackedWarps.Num() == 0)
+    {
+        SetComponentTickEnabled(false);
+    }
+}
+
+void UTargetingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    COMBAT_TRACE_SCOPE(UTargetingComponent::TrackWarpTargets);
+
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    const UAnimInstance* AnimInstance = OwnerCharacter && OwnerCharacter->GetMesh() ? OwnerCharacter->GetMesh()->GetAnimInstance() : nullptr;
+    const float ThresholdSquared = FMath::Square(WarpTrackingMovementThreshold);
+
+    for (int32 Index = TrackedWarps.Num() - 1; Index >= 0; --Index)
+    {
+        FTrackedWarp& Tracked = TrackedWarps[Index];
+
+        if (!Tracked.Montage.IsValid() && AnimInstance)
+        {
+            Tracked.Montage = AnimInstance->GetCurrentActiveMontage();
+        }
+
+        // Done once the target is gone, the attack is over or someone else removed the warp target
+        const AActor* Target = Tracked.Target.Get();
+        const bool bMontagePlaying = AnimInstance && Tracked.Montage.IsValid() && AnimInstance->Montage_IsPlaying(Tracked.Montage.Get());
+        if (!Target || !bMontagePlaying || !MotionWarpingComponent || !MotionWarpingComponent->FindWarpTarget(Tracked.WarpTargetName))
+        {
+            TrackedWarps.RemoveAtSwap(Index);
+            continue;
+        }
+
+        // Cheap early out: the warp point only moves with the target
+        const FVector TargetLocation = Target->GetActorLocation();
+        if (FVector::DistSquared(TargetLocation, Tracked.LastTargetLocation) <= ThresholdSquared)
+        {
+            continue;
+        }
+
+        Tracked.LastTargetLocation = TargetLocation;
+
+        FVector WarpLocation;
+        FRotator LookAtRotation;
+        if (const UAttackData* AttackData = Tracked.AttackData.Get())
+        {
+            // Target came within plain root motion range mid-lunge: keep the last warp point rather than snapping back
+            if (!CalculateAttackWarp(TargetLocation, AttackData, WarpLocation, LookAtRotation))
+            {
+                continue;
+            }
+        }
+        else
+        {
+            WarpLocation = CalculateWarpLocation(Tracked.Target.Get(), Tracked.MaxDistance);
+            LookAtRotation = (TargetLocation - OwnerCharacter->GetActorLocation()).Rotation();
+        }
+
+        MotionWarpingComponent->AddOrUpdateWarpTargetFromLocationAndRotation(Tracked.WarpTargetName, WarpLocation, LookAtRotation);
+        ++NumWarpTrackingUpdates;
+    }
+
+    if (TrackedWarps.Num() == 0)
+    {
+        SetComponentTickEnabled(false);
+    }
 }
 
 // ============================================================================
@@ -261,117 +429,295 @@ void UTargetingComponent::GetActorsInRange(TArray<AActor*>& OutActors) const
     
     const FVector OwnerLocation = OwnerCharacter->GetActorLocation();
     
-    TArray<FOverlapResult> Overlaps;
+    // Fast path: spatial hash of registered pawns, no physics scene query
+    if (bUseTargetRegistry)
+    {
+        if (UTargetRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UTargetRegistrySubsystem>())
+        {
+            Registry->QueryTargetsInRadius(OwnerLocation, MaxTargetDistance, OutActors, OwnerCharacter);
+            FilterBySignificance(OutActors);
+            return;
+        }
+    }
+    
+    TCombatScratchArray<FOverlapResult> Overlaps;
     FCollisionQueryParams QueryParams;
     QueryParams.AddIgnoredActor(OwnerCharacter);
     
-    GetWorld()->OverlapMultiByChannel(
-        Overlaps,
-        OwnerLocation,
-        FQuat::Identity,
-        ECC_Pawn,
-        FCollisionShape::MakeSphere(MaxTargetDistance),
-        QueryParams
-    );
+    COMBAT_COUNT_PHYSICS_QUERY();
+    if (bUseHurtboxes)
+    {
+        GetWorld()->OverlapMultiByObjectType(
+            *Overlaps,
+            OwnerLocation,
+            FQuat::Identity,
+            FCollisionObjectQueryParams(UHurtboxComponent::HurtboxChannel),
+            FCollisionShape::MakeSphere(MaxTargetDistance),
+            QueryParams
+        );
+    }
+    else
+    {
+        GetWorld()->OverlapMultiByChannel(
+            *Overlaps,
+            OwnerLocation,
+            FQuat::Identity,
+            ECC_Pawn,
+            FCollisionShape::MakeSphere(MaxTargetDistance),
+            QueryParams
+        );
+    }
     
-    for (const FOverlapResult& Overlap : Overlaps)
+    for (const FOverlapResult& Overlap : *Overlaps)
     {
         if (AActor* Actor = Overlap.GetActor())
         {
-            OutActors.Add(Actor);
+            // Several hurtboxes per actor
+            if (bUseHurtboxes)
+            {
+                OutActors.AddUnique(Actor);
+            }
+            else
+            {
+                OutActors.Add(Actor);
+            }
         }
     }
+
+    FilterBySignificance(OutActors);
 }
 
-void UTargetingComponent::FilterByTargetableClass(TArray<AActor*>& InOutActors) const
+void UTargetingComponent::FilterBySignificance(TArray<AActor*>& InOutActors) const
 {
-    if (TargetableClasses.Num() == 0)
+    const UCombatSignificanceSubsystem* Significance = bSkipCulledCandidates ? GetWorld()->GetSubsystem<UCombatSignificanceSubsystem>() : nullptr;
+    if (!Significance)
     {
-        return; // No filter if empty
+        return;
     }
-    
-    InOutActors.RemoveAll([this](const AActor* Actor)
+
+    InOutActors.RemoveAllSwap([this, Significance](const AActor* Actor)
     {
-        if (!Actor)
-        {
-            return true;
-        }
-        
-        for (const TSubclassOf<AActor>& TargetClass : TargetableClasses)
-        {
-            if (Actor->IsA(TargetClass))
-            {
-                return false; // Keep it
-            }
-        }
-        
-        return true; // Remove it
-    });
+        return Actor != CurrentTarget && Significance->GetSignificance(Actor) == ECombatSignificance::Culled;
+    }, EAllowShrinking::No);
 }
 
-void UTargetingComponent::FilterByCone(TArray<AActor*>& InOutActors, const FVector& Direction) const
+void UTargetingComponent::SetArchetype(const UCombatArchetype* InArchetype)
 {
-    InOutActors.RemoveAll([this, &Direction](const AActor* Actor)
-    {
-        return !IsTargetInCone(const_cast<AActor*>(Actor), Direction, -1.0f);
-    });
+    Archetype = InArchetype;
+    InvalidateTargetScores();
 }
 
-void UTargetingComponent::FilterByLineOfSight(TArray<AActor*>& InOutActors) const
+const TArray<TSubclassOf<AActor>>& UTargetingComponent::GetTargetableClasses() const
 {
-    InOutActors.RemoveAll([this](const AActor* Actor)
+    return Archetype ? Archetype->TargetableClasses : TargetableClasses;
+}
+
+bool UTargetingComponent::IsTargetableClass(const AActor* Actor, const TArray<TSubclassOf<AActor>>& Classes)
+{
+    if (!Actor)
+    {
+        return false;
+    }
+    
+    if (Classes.Num() == 0)
+    {
+        return true; // No filter if empty
+    }
+    
+    for (const TSubclassOf<AActor>& TargetClass : Classes)
     {
-        return !HasLineOfSightTo(const_cast<AActor*>(Actor));
-    });
+        if (Actor->IsA(TargetClass))
+        {
+            return true;
+        }
+    }
+    
+    return false;
 }
 
-void UTargetingComponent::SortByDistance(TArray<AActor*>& InOutActors) const
+bool UTargetingComponent::IsCandidateVisible(int32 Index, ULineOfSightSubsystem* LineOfSight) const
+{
+    ECandidateVisibility& Visibility = CachedVisibility[Index];
+    if (Visibility == ECandidateVisibility::Unknown)
+    {
+        // Last known visibility - refreshes are queued and traced asynchronously under a shared budget
+        AActor* Target = CachedTargetScores[Index].Target;
+        const bool bVisible = LineOfSight
+            ? LineOfSight->HasLineOfSight(OwnerCharacter, Target, LineOfSightChannel, LineOfSightCacheTTL)
+            : HasLineOfSightTo(Target);
+        Visibility = bVisible ? ECandidateVisibility::Visible : ECandidateVisibility::Blocked;
+    }
+    
+    return Visibility == ECandidateVisibility::Visible;
+}
+
+void UTargetingComponent::RefreshTargetScores() const
 {
     if (!OwnerCharacter)
     {
+        CachedTargetScores.Reset();
+        CachedDirectionX.Reset();
+        CachedDirectionY.Reset();
+        CachedDirectionZ.Reset();
+        CachedDistanceSquared.Reset();
+        CachedVisibility.Reset();
         return;
     }
     
     const FVector OwnerLocation = OwnerCharacter->GetActorLocation();
     
-    InOutActors.Sort([&OwnerLocation](const AActor& A, const AActor& B)
+    // Same frame and owner hasn't moved meaningfully - cached table is still valid
+    if (CachedScoresFrame == GFrameCounter &&
+        FVector::DistSquared(OwnerLocation, CachedScoresOwnerLocation) <= FMath::Square(ScoreCacheMovementThreshold))
+    {
+        return;
+    }
+    
+    TCombatScratchArray<AActor*> PotentialTargets;
+    GetActorsInRange(*PotentialTargets);
+    
+    // One sweep: class filter and a single location fetch per candidate (squared distance is the sort key)
+    struct FCandidate
     {
-        const float DistA = FVector::DistSquared(OwnerLocation, A.GetActorLocation());
-        const float DistB = FVector::DistSquared(OwnerLocation, B.GetActorLocation());
-        return DistA < DistB;
-    });
+        AActor* Actor;
+        FVector3f Offset;
+        float DistanceSquared;
+    };
+    
+    const TArray<TSubclassOf<AActor>>& Classes = GetTargetableClasses();
+    TArray<FCandidate, TInlineAllocator<32>> Candidates;
+    Candidates.Reserve(PotentialTargets->Num());
+    for (AActor* Actor : *PotentialTargets)
+    {
+        if (IsTargetableClass(Actor, Classes))
+        {
+            const FVector3f Offset(Actor->GetActorLocation() - OwnerLocation);
+            Candidates.Add({ Actor, Offset, Offset.SizeSquared() });
+        }
+    }
+    
+    // Nearest first, on the precomputed key (line of sight is deferred to the queries)
+    Algo::SortBy(Candidates, &FCandidate::DistanceSquared);
+    
+    const FVector3f OwnerForward(OwnerCharacter->GetActorForwardVector());
+    const float InvMaxDistance = 1.0f / FMath::Max(MaxTargetDistance, KINDA_SMALL_NUMBER);
+    const int32 NumCandidates = Candidates.Num();
+    
+    CachedTargetScores.Reset(NumCandidates);
+    CachedDirectionX.SetNumUninitialized(NumCandidates, EAllowShrinking::No);
+    CachedDirectionY.SetNumUninitialized(NumCandidates, EAllowShrinking::No);
+    CachedDirectionZ.SetNumUninitialized(NumCandidates, EAllowShrinking::No);
+    CachedDistanceSquared.SetNumUninitialized(NumCandidates, EAllowShrinking::No);
+    CachedVisibility.Init(bRequireLineOfSight ? ECandidateVisibility::Unknown : ECandidateVisibility::Visible, NumCandidates);
+    
+    for (int32 Index = 0; Index < NumCandidates; ++Index)
+    {
+        const FCandidate& Candidate = Candidates[Index];
+        const float Distance = FMath::Sqrt(Candidate.DistanceSquared);
+        const FVector3f Direction = Distance > KINDA_SMALL_NUMBER ? Candidate.Offset / Distance : FVector3f::ZeroVector;
+        
+        FTargetScore& Score = CachedTargetScores.AddDefaulted_GetRef();
+        Score.Target = Candidate.Actor;
+        Score.DistanceScore = 1.0f - FMath::Clamp(Distance * InvMaxDistance, 0.0f, 1.0f);
+        Score.FacingScore = FVector3f::DotProduct(OwnerForward, Direction);
+        Score.TotalScore = Score.DistanceScore;
+        
+        CachedDirectionX[Index] = Direction.X;
+        CachedDirectionY[Index] = Direction.Y;
+        CachedDirectionZ[Index] = Direction.Z;
+        CachedDistanceSquared[Index] = Candidate.DistanceSquared;
+    }
+    
+    CachedScoresFrame = GFrameCounter;
+    CachedScoresOwnerLocation = OwnerLocation;
 }
 
-AActor* UTargetingComponent::FindBestTarget(const FVector& Direction) const
+void UTargetingComponent::QueryCandidates(const FVector& Direction, float MaxDistanceSquared, int32 MaxResults, TArray<AActor*>& OutTargets) const
 {
-    TArray<AActor*> PotentialTargets;
-    
-    // Get all actors in range
-    GetActorsInRange(PotentialTargets);
-    
-    // Filter by targetable class
-    FilterByTargetableClass(PotentialTargets);
+    const int32 NumCandidates = CachedTargetScores.Num();
+    if (NumCandidates == 0 || MaxResults <= 0)
+    {
+        return;
+    }
     
-    // Filter by directional cone
-    FilterByCone(PotentialTargets, Direction);
+    // Zero direction = no cone (every dot product is 0, so accept from -1)
+    const bool bUseCone = !Direction.IsNearlyZero();
+    const float MinDot = bUseCone ? FMath::Cos(FMath::DegreesToRadians(DirectionalConeAngle)) : -1.0f;
+    const float DirX = static_cast<float>(Direction.X);
+    const float DirY = static_cast<float>(Direction.Y);
+    const float DirZ = static_cast<float>(Direction.Z);
+    
+    // Fused cone + range pass: plain float arrays, no branches, no actor access (vectorizes)
+    QueryPassMask.SetNumUninitialized(NumCandidates, EAllowShrinking::No);
+    const float* RESTRICT X = CachedDirectionX.GetData();
+    const float* RESTRICT Y = CachedDirectionY.GetData();
+    const float* RESTRICT Z = CachedDirectionZ.GetData();
+    const float* RESTRICT DistanceSquared = CachedDistanceSquared.GetData();
+    uint8* RESTRICT Pass = QueryPassMask.GetData();
+    for (int32 Index = 0; Index < NumCandidates; ++Index)
+    {
+        const float Dot = DirX * X[Index] + DirY * Y[Index] + DirZ * Z[Index];
+        Pass[Index] = static_cast<uint8>((Dot >= MinDot) & (DistanceSquared[Index] <= MaxDistanceSquared));
+    }
     
-    // Filter by line of sight
-    if (bRequireLineOfSight)
+    // Survivors best score first (cache order); line of sight only for the ones we reach
+    ULineOfSightSubsystem* LineOfSight = bRequireLineOfSight && bUseAsyncLineOfSight && GetWorld() ? GetWorld()->GetSubsystem<ULineOfSightSubsystem>() : nullptr;
+    for (int32 Index = 0; Index < NumCandidates; ++Index)
     {
-        FilterByLineOfSight(PotentialTargets);
+        if (!Pass[Index])
+        {
+            // Nearest first: once past the range limit every remaining candidate is too
+            if (DistanceSquared[Index] > MaxDistanceSquared)
+            {
+                break;
+            }
+            continue;
+        }
+        
+        AActor* Target = CachedTargetScores[Index].Target;
+        if (!IsValid(Target) || !IsCandidateVisible(Index, LineOfSight))
+        {
+            continue;
+        }
+        
+        OutTargets.Add(Target);
+        if (OutTargets.Num() >= MaxResults)
+        {
+            break;
+        }
+    }
+}
+
+AActor* UTargetingComponent::FindBestTarget(const FVector& Direction, float MaxDistance) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_Combat_FindTarget);
+    COMBAT_CSV_SCOPE_IN(Targeting, FindTarget);
+    COMBAT_BUDGET_SCOPE(Targeting);
+
+    // Duel: the opponent is the only target - no world query
+    if (AActor* Opponent = DuelTarget.Get())
+    {
+        const float Limit = MaxDistance > 0.0f ? FMath::Min(MaxDistance, MaxTargetDistance) : MaxTargetDistance;
+        const bool bInRange = OwnerCharacter
+            && FVector::DistSquared(OwnerCharacter->GetActorLocation(), Opponent->GetActorLocation()) <= FMath::Square(Limit);
+        return bInRange ? Opponent : nullptr;
     }
+
+    RefreshTargetScores();
     
-    // Sort by distance
-    SortByDistance(PotentialTargets);
+    // Best visible candidate in the cone (debug draw wants every survivor)
+    const float MaxDistanceSquared = MaxDistance > 0.0f ? FMath::Square(MaxDistance) : MAX_flt;
+    TCombatScratchArray<AActor*> Survivors;
+    QueryCandidates(Direction, MaxDistanceSquared, bDebugDraw ? MAX_int32 : 1, *Survivors);
+    AActor* BestTarget = Survivors->Num() > 0 ? (*Survivors)[0] : nullptr;
     
     // Debug visualization
     if (bDebugDraw)
     {
-        AActor* SelectedTarget = (PotentialTargets.Num() > 0) ? PotentialTargets[0] : nullptr;
-        DrawDebugTargeting(PotentialTargets, SelectedTarget, Direction);
+        DrawDebugTargeting(*Survivors, BestTarget, Direction);
     }
     
-    return (PotentialTargets.Num() > 0) ? PotentialTargets[0] : nullptr;
+    return BestTarget;
 }
 
 // ============================================================================
@@ -406,13 +752,40 @@ FVector UTargetingComponent::CalculateWarpLocation(AActor* Target, float MaxDist
     return OwnerLocation + (ToTarget.GetSafeNormal() * MaxDistance);
 }
 
+bool UTargetingComponent::CalculateAttackWarp(const FVector& TargetLocation, const UAttackData* AttackData, FVector& OutLocation, FRotator& OutRotation) const
+{
+    const FMotionWarpingConfig& Config = AttackData->MotionWarpingConfig;
+    const FVector OwnerLocation = OwnerCharacter->GetActorLocation();
+    const FVector ToTarget = TargetLocation - OwnerLocation;
+    const float Distance = ToTarget.Size2D();
+
+    // Close enough for the authored root motion alone
+    if (Distance < Config.MinWarpDistance)
+    {
+        return false;
+    }
+
+    OutRotation = FRotator(0.0f, ToTarget.Rotation().Yaw, 0.0f);
+
+    // Root motion covers ActiveReach on its own; warp stretches the rest, up to MaxWarpDistance
+    OutLocation = OwnerLocation;
+    if (Config.bWarpTranslation)
+    {
+        const float WarpDistance = FMath::Min(Distance, AttackData->GetActiveReach() + Config.MaxWarpDistance);
+        OutLocation += ToTarget.GetSafeNormal2D() * WarpDistance;
+    }
+
+    return true;
+}
+
 // ============================================================================
 // DEBUG VISUALIZATION
 // ============================================================================
 
 void UTargetingComponent::DrawDebugTargeting(const TArray<AActor*>& PotentialTargets, AActor* SelectedTarget, const FVector& SearchDirection) const
 {
-    if (!GetWorld() || !OwnerCharacter)
+    UCombatDebugDrawSubsystem* DebugDraw = UCombatDebugDrawSubsystem::Get(this);
+    if (!DebugDraw || !OwnerCharacter || !DebugDraw->ShouldDraw(OwnerCharacter))
     {
         return;
     }
@@ -420,16 +793,14 @@ void UTargetingComponent::DrawDebugTargeting(const TArray<AActor*>& PotentialTar
     const FVector OwnerLocation = OwnerCharacter->GetActorLocation();
     
     // Draw search cone
-    DrawDebugCone(
-        GetWorld(),
+    DebugDraw->AddCone(
+        OwnerCharacter,
         OwnerLocation,
         SearchDirection,
         MaxTargetDistance,
         FMath::DegreesToRadians(DirectionalConeAngle),
-        FMath::DegreesToRadians(DirectionalConeAngle),
         12,
         FColor::Yellow,
-        false,
         0.1f
     );
     
@@ -442,8 +813,8 @@ void UTargetingComponent::DrawDebugTargeting(const TArray<AActor*>& PotentialTar
         }
         
         const FColor Color = (Target == SelectedTarget) ? FColor::Green : FColor::Orange;
-        DrawDebugSphere(GetWorld(), Target->GetActorLocation(), 50.0f, 12, Color, false, 0.1f);
-        DrawDebugLine(GetWorld(), OwnerLocation, Target->GetActorLocation(), Color, false, 0.1f);
+        DebugDraw->AddSphere(OwnerCharacter, Target->GetActorLocation(), 50.0f, 12, Color, 0.1f);
+        DebugDraw->AddLine(OwnerCharacter, OwnerLocation, Target->GetActorLocation(), Color, 0.0f, 0.1f);
     }
 }
 
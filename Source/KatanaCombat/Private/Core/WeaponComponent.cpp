@@ -2,15 +2,36 @@
 
 #include "Core/WeaponComponent.h"
 #include "Core/CombatComponent.h"
+#include "Core/WeaponTraceSubsystem.h"
+#include "Core/TargetRegistrySubsystem.h"
+#include "Core/LagCompensationSubsystem.h"
+#include "Core/CombatSignificanceSubsystem.h"
+#include "Core/CombatEventDispatcherSubsystem.h"
+#include "Core/CombatBudgetSubsystem.h"
+#include "Core/CombatScratch.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatAttackProfiler.h"
 #include "Data/AttackData.h"
+#include "Core/HitReactionComponent.h"
+#include "Core/HurtboxComponent.h"
+#include "Interfaces/DamageableInterface.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/GameStateBase.h"
 #include "Components/SkeletalMeshComponent.h"
-#include "DrawDebugHelpers.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "Debug/CombatDebugDrawSubsystem.h"
 
 UWeaponComponent::UWeaponComponent()
 {
     PrimaryComponentTick.bCanEverTick = true;
     PrimaryComponentTick.bStartWithTickEnabled = false; // Only tick when hit detection enabled
+    PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+    SetIsReplicatedByDefault(true); // ServerClaimHit
+    SwingSignificance = ECombatSignificance::High;
 }
 
 void UWeaponComponent::BeginPlay()
@@ -23,6 +44,28 @@ void UWeaponComponent::BeginPlay()
     {
         OwnerMesh = OwnerCharacter->GetMesh();
     }
+
+    // Dedicated server with baked blades: montages still drive notifies and root motion, the pose is never read
+    bBakedBladeActive = bServerUseBakedBlade && GetWorld() && GetWorld()->GetNetMode() == NM_DedicatedServer;
+    if (bBakedBladeActive && bServerSkipPoseEvaluation && OwnerMesh)
+    {
+        OwnerMesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+    }
+
+    // Sweep after this frame's animation has finished evaluating
+    SetTickGroup(TraceTickGroup);
+    if (bTickAfterOwnerMesh && OwnerMesh)
+    {
+        AddTickPrerequisiteComponent(OwnerMesh);
+    }
+    
+    ResetSwingQueryParams();
+
+    // Ranked for sweep precision and debug drawing
+    if (UCombatSignificanceSubsystem* Significance = GetWorld() ? GetWorld()->GetSubsystem<UCombatSignificanceSubsystem>() : nullptr)
+    {
+        Significance->RegisterActor(GetOwner());
+    }
 }
 
 void UWeaponComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -31,10 +74,25 @@ void UWeaponComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActo
     
     if (bHitDetectionEnabled)
     {
-        PerformWeaponTrace();
+        if (bAsyncTraceActive)
+        {
+            UpdateAsyncTrace(DeltaTime);
+        }
+        else
+        {
+            PerformWeaponTrace();
+        }
     }
 }
 
+void UWeaponComponent::AsyncPhysicsTickComponent(float DeltaTime, float SimTime)
+{
+    Super::AsyncPhysicsTickComponent(DeltaTime, SimTime);
+    
+    // Physics thread: only the plain-data trace is touched here
+    AsyncTrace.Step(DeltaTime);
+}
+
 // ============================================================================
 // HIT DETECTION CONTROL
 // ============================================================================
@@ -48,22 +106,118 @@ void UWeaponComponent::EnableHitDetection()
     
     bHitDetectionEnabled = true;
     bFirstTrace = true;
-    SetComponentTickEnabled(true);
+    NumSwingFramesCulled = 0;
+    HitDetectionEnabledTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+    SwingSignificance = UCombatSignificanceSubsystem::GetSignificanceFor(GetOwner());
+    SwingDetailScale = UCombatBudgetSubsystem::GetDetailScaleFor(this, ECombatBudgetCategory::Traces);
+    
+    // Server validating a remote owner only opens the window for claims; other clients' copies never hit
+    const EHitAuthority Authority = GetHitAuthority();
+    if (Authority == EHitAuthority::Validate || Authority == EHitAuthority::None)
+    {
+        return;
+    }
+    
+    // Batched mode: subsystem gathers our segments each frame, no component tick needed
+    UWeaponTraceSubsystem* TraceSubsystem = bUseBatchedTraces && GetWorld() ? GetWorld()->GetSubsystem<UWeaponTraceSubsystem>() : nullptr;
+    if (TraceSubsystem)
+    {
+        TraceSubsystem->RegisterWeapon(this);
+    }
+    else
+    {
+        SetComponentTickEnabled(true);
+    }
     
     // Store initial positions
     PreviousStartLocation = GetSocketLocation(WeaponStartSocket);
     PreviousTipLocation = GetSocketLocation(WeaponEndSocket);
+    
+    StartAsyncTrace();
+}
+
+void UWeaponComponent::EnableHitDetectionForAttack(UAttackData* InSwingAttack)
+{
+    // Already open (combo cancelled into the next attack mid-window): follow the new attack, its poses seed on the next gather
+    if (bHitDetectionEnabled)
+    {
+        FCombatAttackProfiler::Get().AddSwing(SwingAttack);
+        SwingAttack = InSwingAttack;
+        if (bUseAsyncPhysicsTrace)
+        {
+            StartAsyncTrace();
+        }
+        return;
+    }
+    
+    EnableHitDetection();
+    SwingAttack = InSwingAttack;
+    if (bUseAsyncPhysicsTrace)
+    {
+        // Again for the window's own attack (its bake, or a profile that needs per-frame tracing)
+        StartAsyncTrace();
+    }
+    
+    // Preload the swing's volumes: size and seed their poses now rather than on the first traced frame
+    if (SwingAttack && SwingAttack->HitVolumeProfile.HasVolumes())
+    {
+        const TArray<FAttackHitVolume>& Volumes = SwingAttack->HitVolumeProfile.Volumes;
+        PreviousVolumeStarts.SetNum(Volumes.Num());
+        PreviousVolumeTips.SetNum(Volumes.Num());
+        
+        for (int32 Index = 0; Index < Volumes.Num(); ++Index)
+        {
+            PreviousVolumeStarts[Index] = GetSocketLocation(Volumes[Index].StartSocket.IsNone() ? WeaponStartSocket : Volumes[Index].StartSocket);
+            PreviousVolumeTips[Index] = GetSocketLocation(Volumes[Index].EndSocket.IsNone() ? WeaponEndSocket : Volumes[Index].EndSocket);
+        }
+        
+        ProfileAttack = SwingAttack;
+        bProfilePosesPrimed = true;
+    }
 }
 
 void UWeaponComponent::DisableHitDetection()
 {
+    if (bHitDetectionEnabled)
+    {
+        HitDetectionDisabledTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+        
+        FCombatAttackProfiler& AttackProfiler = FCombatAttackProfiler::Get();
+        if (AttackProfiler.IsEnabled())
+        {
+            AttackProfiler.AddSwing(GetSwingAttack());
+        }
+    }
+    
+    if (bAsyncTraceActive)
+    {
+        // Steps since the last frame still hit - deliver them while the swing's attack is known
+        TArray<FAsyncBladeTrace::FHit> Hits;
+        AsyncTrace.Publish(FAsyncBladeTrace::FSnapshot(), Hits);
+        DeliverAsyncTraceHits(Hits);
+        
+        AsyncTrace.End();
+        SetAsyncPhysicsTickEnabled(false);
+        bAsyncTraceActive = false;
+    }
+    AsyncTraceComponents.Reset();
+    
+    SwingAttack = nullptr;
+    bProfilePosesPrimed = false;
     bHitDetectionEnabled = false;
     SetComponentTickEnabled(false);
+    
+    if (UWeaponTraceSubsystem* TraceSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UWeaponTraceSubsystem>() : nullptr)
+    {
+        TraceSubsystem->UnregisterWeapon(this);
+    }
 }
 
 void UWeaponComponent::ResetHitActors()
 {
-    HitActors.Empty();
+    HitActors.Reset();
+    HitActorKeys.Reset();
+    ResetSwingQueryParams();
     bFirstTrace = true;
 }
 
@@ -75,10 +229,22 @@ void UWeaponComponent::SetWeaponSockets(FName StartSocket, FName EndSocket)
 {
     WeaponStartSocket = StartSocket;
     WeaponEndSocket = EndSocket;
+    bPoseSocketsCached = false;
 }
 
 FVector UWeaponComponent::GetSocketLocation(FName SocketName) const
 {
+    FVector PoseLocation;
+    if (bBakedBladeActive && GetBakedSocketLocation(SocketName, PoseLocation))
+    {
+        return PoseLocation;
+    }
+
+    if (bReadSocketsFromPose && GetPoseSocketLocation(SocketName, PoseLocation))
+    {
+        return PoseLocation;
+    }
+
     if (OwnerMesh && OwnerMesh->DoesSocketExist(SocketName))
     {
         return OwnerMesh->GetSocketLocation(SocketName);
@@ -93,13 +259,116 @@ FVector UWeaponComponent::GetSocketLocation(FName SocketName) const
     return FVector::ZeroVector;
 }
 
+void UWeaponComponent::CachePoseSockets() const
+{
+    bPoseSocketsCached = true;
+    PoseSocketAsset = OwnerMesh ? OwnerMesh->GetSkinnedAsset() : nullptr;
+
+    auto Resolve = [this](FName SocketName, FPoseSocket& OutSocket)
+    {
+        OutSocket = FPoseSocket();
+        OutSocket.Name = SocketName;
+        if (!OwnerMesh || SocketName.IsNone())
+        {
+            return;
+        }
+
+        if (const USkeletalMeshSocket* Socket = OwnerMesh->GetSocketByName(SocketName))
+        {
+            OutSocket.BoneIndex = OwnerMesh->GetBoneIndex(Socket->BoneName);
+            OutSocket.BoneToSocket = Socket->GetSocketLocalTransform();
+        }
+        else
+        {
+            // Bone names are valid sockets too
+            OutSocket.BoneIndex = OwnerMesh->GetBoneIndex(SocketName);
+        }
+    };
+
+    Resolve(WeaponStartSocket, StartPoseSocket);
+    Resolve(WeaponEndSocket, EndPoseSocket);
+}
+
+bool UWeaponComponent::GetPoseSocketLocation(FName SocketName, FVector& OutLocation) const
+{
+    if (!OwnerMesh)
+    {
+        return false;
+    }
+
+    if (!bPoseSocketsCached || PoseSocketAsset.Get() != OwnerMesh->GetSkinnedAsset())
+    {
+        CachePoseSockets();
+    }
+
+    const FPoseSocket* PoseSocket = SocketName == StartPoseSocket.Name ? &StartPoseSocket
+        : SocketName == EndPoseSocket.Name ? &EndPoseSocket
+        : nullptr;
+
+    const TArrayView<const FTransform> Pose = OwnerMesh->GetComponentSpaceTransforms();
+    if (!PoseSocket || !Pose.IsValidIndex(PoseSocket->BoneIndex))
+    {
+        return false;
+    }
+
+    // Same result as GetSocketLocation, minus the per-call socket and bone name lookups
+    const FVector ComponentSpaceLocation = Pose[PoseSocket->BoneIndex].TransformPosition(PoseSocket->BoneToSocket.GetLocation());
+    OutLocation = OwnerMesh->GetComponentTransform().TransformPosition(ComponentSpaceLocation);
+    return true;
+}
+
+bool UWeaponComponent::GetBakedSocketLocation(FName SocketName, FVector& OutLocation) const
+{
+    if (!OwnerMesh || (SocketName != WeaponStartSocket && SocketName != WeaponEndSocket))
+    {
+        return false;
+    }
+
+    const UAttackData* Attack = SwingAttack ? SwingAttack.Get() : GetCurrentAttackData();
+    const FAttackSwingVolume* SwingVolume = Attack ? Attack->GetSwingVolume() : nullptr;
+    if (!SwingVolume || SwingVolume->StartSocket != WeaponStartSocket || SwingVolume->EndSocket != WeaponEndSocket)
+    {
+        return false;
+    }
+
+    // Baked in mesh component space with the root locked, like the runtime mesh under root motion
+    FVector Start, Tip;
+    SwingVolume->SampleAtTime(GetSwingMontageTime(Attack, *SwingVolume), Start, Tip);
+    OutLocation = OwnerMesh->GetComponentTransform().TransformPosition(SocketName == WeaponStartSocket ? Start : Tip);
+    return true;
+}
+
+float UWeaponComponent::GetSwingMontageTime(const UAttackData* Attack, const FAttackSwingVolume& SwingVolume) const
+{
+    const UAnimInstance* AnimInstance = OwnerMesh ? OwnerMesh->GetAnimInstance() : nullptr;
+    if (const FAnimMontageInstance* MontageInstance = AnimInstance ? AnimInstance->GetActiveInstanceForMontage(Attack->AttackMontage) : nullptr)
+    {
+        return MontageInstance->GetPosition();
+    }
+
+    // Mesh not ticking at all (phase timers opened the window at the Active start)
+    const float Elapsed = HitDetectionEnabledTime > 0.0f && GetWorld() ? GetWorld()->GetTimeSeconds() - HitDetectionEnabledTime : 0.0f;
+    return SwingVolume.WindowStartTime + Elapsed;
+}
+
 // ============================================================================
 // HIT QUERIES
 // ============================================================================
 
 bool UWeaponComponent::WasActorAlreadyHit(AActor* Actor) const
 {
-    return HitActors.Contains(Actor);
+    return Actor && HitActorKeys.Contains(FObjectKey(Actor));
+}
+
+bool UWeaponComponent::CanHitActor(AActor* Actor) const
+{
+    if (!Actor)
+    {
+        return false;
+    }
+
+    const FWeaponHitTarget* Target = HitActorKeys.Find(FObjectKey(Actor));
+    return !Target || Target->CanRehit(GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f);
 }
 
 // ============================================================================
@@ -108,98 +377,939 @@ bool UWeaponComponent::WasActorAlreadyHit(AActor* Actor) const
 
 void UWeaponComponent::PerformWeaponTrace()
 {
-    if (!OwnerCharacter || !OwnerMesh)
+    SCOPE_CYCLE_COUNTER(STAT_Combat_PerformWeaponTrace);
+    COMBAT_CSV_SCOPE_IN(Traces, PerformWeaponTrace);
+    COMBAT_BUDGET_SCOPE(Traces);
+    FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Trace);
+
+    TArray<FWeaponSweepSegment, TInlineAllocator<16>> Segments;
+    if (!GatherSweepSegments(Segments) || TryBladeNarrowphase())
     {
         return;
     }
+    AttackProfileScope.AddSweeps(Segments.Num());
+    
+    // Perform swept traces from previous to current blade pose
+    const FCollisionObjectQueryParams HurtboxParams(UHurtboxComponent::HurtboxChannel);
+    TCombatScratchArray<FHitResult> HitResults;
+    for (const FWeaponSweepSegment& Segment : Segments)
+    {
+        HitResults->Reset();
+        COMBAT_COUNT_PHYSICS_QUERY();
+        if (bUseHurtboxes)
+        {
+            GetWorld()->SweepMultiByObjectType(
+                *HitResults,
+                Segment.Start,
+                Segment.End,
+                Segment.Rotation,
+                HurtboxParams,
+                Segment.Shape,
+                SwingQueryParams
+            );
+        }
+        else
+        {
+            GetWorld()->SweepMultiByChannel(
+                *HitResults,
+                Segment.Start,
+                Segment.End,
+                Segment.Rotation,
+                TraceChannel,
+                Segment.Shape,
+                SwingQueryParams
+            );
+        }
+        
+        ProcessSweepResults(*HitResults, Segment.Start, Segment.End);
+    }
+}
+
+bool UWeaponComponent::GatherSweepSegments(TArray<FWeaponSweepSegment, TInlineAllocator<16>>& OutSegments)
+{
+    if (!OwnerCharacter || !OwnerMesh)
+    {
+        return false;
+    }
     
+    // Per-attack hit volumes replace the default sweep
     const FVector StartLocation = GetSocketLocation(WeaponStartSocket);
     const FVector EndLocation = GetSocketLocation(WeaponEndSocket);
     
+    // Default blade pose for hit claims (profile volumes are validated against the blade too)
+    LastSweepPrevStart = PreviousStartLocation;
+    LastSweepPrevTip = PreviousTipLocation;
+    LastSweepStart = StartLocation;
+    LastSweepTip = EndLocation;
+    bLastSweepIsBlade = false;
+    
+    // Per-attack hit volumes replace the default sweep
+    UAttackData* AttackData = SwingAttack ? SwingAttack.Get() : GetCurrentAttackData();
+    FCombatAttackProfiler::Get().SetScopeAttack(AttackData);
+    
+    // Nobody near the baked swing: keep the blade pose moving, sweep nothing this frame
+    if (IsSwingVolumeClear(AttackData))
+    {
+        PreviousStartLocation = StartLocation;
+        PreviousTipLocation = EndLocation;
+        bFirstTrace = false;
+        ++NumSwingFramesCulled;
+        CSV_CUSTOM_STAT(KatanaCombatTraces, SwingFramesCulled, 1, ECsvCustomStatOp::Accumulate);
+        return false;
+    }
+    
+    if (AttackData && AttackData->HitVolumeProfile.HasVolumes())
+    {
+        GatherProfileSweepSegments(AttackData->HitVolumeProfile, AttackData, OutSegments);
+        
+        // Keep default pose current so a follow-up attack without a profile doesn't sweep from a stale pose
+        PreviousStartLocation = StartLocation;
+        PreviousTipLocation = EndLocation;
+        return OutSegments.Num() > 0;
+    }
+    
     // Skip first trace to avoid hitting at spawn
     if (bFirstTrace)
     {
         PreviousStartLocation = StartLocation;
         PreviousTipLocation = EndLocation;
         bFirstTrace = false;
+        return false;
+    }
+    
+    if (bUseBladeSweep)
+    {
+        // Blade sweep: cover the whole start→tip segment with adaptive substepping
+        BuildBladeSweepSegments(PreviousStartLocation, PreviousTipLocation, StartLocation, EndLocation, TraceRadius, OutSegments);
+        bLastSweepIsBlade = true;
+    }
+    else
+    {
+        // Legacy: single sphere sweep along the tip path
+        FWeaponSweepSegment& Segment = OutSegments.AddDefaulted_GetRef();
+        Segment.Start = PreviousTipLocation;
+        Segment.End = EndLocation;
+        Segment.Shape = FCollisionShape::MakeSphere(TraceRadius);
+    }
+    
+    // Store current positions for next frame
+    PreviousStartLocation = StartLocation;
+    PreviousTipLocation = EndLocation;
+    
+    return OutSegments.Num() > 0;
+}
+
+bool UWeaponComponent::IsSwingVolumeClear(const UAttackData* AttackData)
+{
+    // Profiles trace their own sockets, which the blade bake doesn't cover
+    const FAttackSwingVolume* SwingVolume = bUseSwingVolumeCulling && AttackData && !AttackData->HitVolumeProfile.HasVolumes() ? AttackData->GetSwingVolume() : nullptr;
+    if (!SwingVolume || SwingVolume->StartSocket != WeaponStartSocket || SwingVolume->EndSocket != WeaponEndSocket)
+    {
+        return false;
+    }
+    
+    UWorld* World = GetWorld();
+    UTargetRegistrySubsystem* Registry = World ? World->GetSubsystem<UTargetRegistrySubsystem>() : nullptr;
+    if (!Registry || !OwnerMesh)
+    {
+        return false;
+    }
+    
+    // The bake follows the mesh, so one transform places the whole swing (registry distances are to actor origins)
+    const FBox WorldBounds = SwingVolume->Bounds.TransformBy(OwnerMesh->GetComponentTransform()).ExpandBy(SwingVolumeTargetMargin + TraceRadius);
+    
+    NarrowphaseCandidates.Reset();
+    Registry->QueryTargetsInRadius(WorldBounds.GetCenter(), WorldBounds.GetExtent().Size(), NarrowphaseCandidates, GetOwner());
+    
+    bool bClear = true;
+    for (AActor* Candidate : NarrowphaseCandidates)
+    {
+        if (Candidate != OwnerCharacter && CanHitActor(Candidate) && WorldBounds.IsInsideOrOn(Candidate->GetActorLocation()))
+        {
+            bClear = false;
+            break;
+        }
+    }
+    
+    NarrowphaseCandidates.Reset();
+    return bClear;
+}
+
+bool UWeaponComponent::TryBladeNarrowphase()
+{
+    UWorld* World = GetWorld();
+    UTargetRegistrySubsystem* Registry = bUseBladeNarrowphase && bLastSweepIsBlade && World ? World->GetSubsystem<UTargetRegistrySubsystem>() : nullptr;
+    if (!Registry)
+    {
+        return false;
+    }
+    
+    COMBAT_CSV_SCOPE_IN(Traces, BladeNarrowphase);
+    
+    // Broadphase: registered pawns near the swept blade
+    const FVector BladeCenter = (LastSweepPrevStart + LastSweepPrevTip + LastSweepStart + LastSweepTip) * 0.25f;
+    const float BladeReach = FMath::Max(FVector::Dist(BladeCenter, LastSweepPrevTip), FVector::Dist(BladeCenter, LastSweepTip));
+    constexpr float CapsuleSlack = 100.0f;
+    
+    Narrowphase.Reset();
+    NarrowphaseComponents.Reset();
+    GatherTargetCapsules(BladeCenter, BladeReach + TraceRadius + CapsuleSlack, [this](UCapsuleComponent* Capsule)
+    {
+        const FVector Center = Capsule->GetComponentLocation();
+        const FVector Axis = Capsule->GetUpVector() * Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere();
+        Narrowphase.AddCapsule(Center - Axis, Center + Axis, Capsule->GetScaledCapsuleRadius());
+        NarrowphaseComponents.Add(Capsule);
+    });
+    
+    if (Narrowphase.Num() > 0)
+    {
+        // Same swept volume as the blade sweep: the blade at each substep pose, plus the tip's path between poses
+        const int32 NumSubsteps = FMath::Min(CalculateSweepSubsteps(LastSweepPrevTip - LastSweepPrevStart, LastSweepTip - LastSweepStart), GetSignificanceSubstepCap());
+        TArray<FVector, TInlineAllocator<17>> Bases;
+        TArray<FVector, TInlineAllocator<17>> Blades;
+        BuildBladePoses(LastSweepPrevStart, LastSweepPrevTip, LastSweepStart, LastSweepTip, NumSubsteps, Bases, Blades);
+        
+        TBitArray<> Hits(false, Narrowphase.Num());
+        for (int32 PoseIndex = 0; PoseIndex < Bases.Num(); ++PoseIndex)
+        {
+            const FVector Tip = Bases[PoseIndex] + Blades[PoseIndex];
+            Narrowphase.TestSegment(Bases[PoseIndex], Tip, TraceRadius, Hits);
+            if (PoseIndex > 0)
+            {
+                Narrowphase.TestSegment(Bases[PoseIndex - 1] + Blades[PoseIndex - 1], Tip, TraceRadius, Hits);
+            }
+        }
+        
+        // Report in component order (first hurtbox per actor wins ProcessHit's dedup)
+        TCombatScratchArray<FHitResult> HitResults;
+        const FCollisionObjectQueryParams WorldParams(FCollisionObjectQueryParams::InitType::AllStaticObjects);
+        for (TConstSetBitIterator<> It(Hits); It; ++It)
+        {
+            UPrimitiveComponent* Component = NarrowphaseComponents[It.GetIndex()];
+            
+            FVector OnBlade;
+            FVector OnCapsule;
+            Narrowphase.GetClosestPoints(It.GetIndex(), LastSweepStart, LastSweepTip, OnBlade, OnCapsule);
+            
+            // The physics scene is only consulted for world geometry between the blade and the target
+            if (bNarrowphaseWorldBlocking)
+            {
+                COMBAT_COUNT_PHYSICS_QUERY();
+                FCombatAttackProfiler::Get().AddScopeSweeps(1);
+                if (World->LineTraceTestByObjectType(LastSweepStart, OnCapsule, WorldParams, SwingQueryParams))
+                {
+                    continue;
+                }
+            }
+            
+            FHitResult& Hit = HitResults->Emplace_GetRef(Component->GetOwner(), Component, OnCapsule, (OnBlade - OnCapsule).GetSafeNormal());
+            Hit.bBlockingHit = true;
+            Hit.TraceStart = LastSweepPrevTip;
+            Hit.TraceEnd = LastSweepTip;
+        }
+        
+        ProcessSweepResults(*HitResults, LastSweepPrevTip, LastSweepTip);
+    }
+    
+    NarrowphaseComponents.Reset();
+    return true;
+}
+
+void UWeaponComponent::GatherTargetCapsules(const FVector& Center, float Reach, TFunctionRef<void(UCapsuleComponent*)> AddCapsule)
+{
+    UTargetRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<UTargetRegistrySubsystem>() : nullptr;
+    if (!Registry)
+    {
         return;
     }
     
-    // Setup trace parameters
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(OwnerCharacter);
-    QueryParams.bTraceComplex = false;
-    QueryParams.bReturnPhysicalMaterial = false;
+    // Broadphase: registered pawns near the blade
+    NarrowphaseCandidates.Reset();
+    Registry->QueryTargetsInRadius(Center, Reach, NarrowphaseCandidates, GetOwner());
     
-    // Ignore already hit actors
-    for (AActor* HitActor : HitActors)
+    // Candidate capsules: the actor's hurtboxes, or its root capsule when it has none
+    for (AActor* Candidate : NarrowphaseCandidates)
     {
-        if (HitActor)
+        if (Candidate == OwnerCharacter || !CanHitActor(Candidate))
         {
-            QueryParams.AddIgnoredActor(HitActor);
+            continue;
+        }
+        
+        TInlineComponentArray<UHurtboxComponent*> Hurtboxes(Candidate);
+        bool bAddedHurtbox = false;
+        for (UHurtboxComponent* Hurtbox : Hurtboxes)
+        {
+            if (Hurtbox->IsQueryCollisionEnabled())
+            {
+                AddCapsule(Hurtbox);
+                bAddedHurtbox = true;
+            }
+        }
+        
+        UCapsuleComponent* RootCapsule = Cast<UCapsuleComponent>(Candidate->GetRootComponent());
+        if (!bAddedHurtbox && RootCapsule && RootCapsule->IsQueryCollisionEnabled())
+        {
+            AddCapsule(RootCapsule);
         }
     }
     
-    // Perform swept sphere trace from previous to current position
-    TArray<FHitResult> HitResults;
-    const bool bHit = GetWorld()->SweepMultiByChannel(
-        HitResults,
-        PreviousTipLocation,
-        EndLocation,
-        FQuat::Identity,
-        TraceChannel,
-        FCollisionShape::MakeSphere(TraceRadius),
-        QueryParams
-    );
+    NarrowphaseCandidates.Reset();
+}
+
+void UWeaponComponent::StartAsyncTrace()
+{
+    const UAttackData* Attack = GetSwingAttack();
+    const EHitAuthority Authority = GetHitAuthority();
+    const bool bWasActive = bAsyncTraceActive;
+    bAsyncTraceActive = bUseAsyncPhysicsTrace && bUseBladeSweep && bHitDetectionEnabled && OwnerMesh
+        && (Authority == EHitAuthority::Local || Authority == EHitAuthority::Claim)
+        && !(Attack && Attack->HitVolumeProfile.HasVolumes());
     
-    // Process all hits
-    if (bHit)
+    UWeaponTraceSubsystem* TraceSubsystem = bUseBatchedTraces && GetWorld() ? GetWorld()->GetSubsystem<UWeaponTraceSubsystem>() : nullptr;
+    if (!bAsyncTraceActive)
     {
-        for (const FHitResult& Hit : HitResults)
+        // Followed into an attack that needs per-frame tracing: hand the window back
+        if (bWasActive)
         {
-            if (Hit.GetActor() && Hit.GetActor() != OwnerCharacter)
+            AsyncTrace.End();
+            SetAsyncPhysicsTickEnabled(false);
+            AsyncTraceComponents.Reset();
+            if (TraceSubsystem)
             {
-                ProcessHit(Hit);
+                TraceSubsystem->RegisterWeapon(this);
+                SetComponentTickEnabled(false);
             }
         }
+        return;
+    }
+    
+    // Only a bake of our own blade sockets can stand in for the pose
+    const FAttackSwingVolume* SwingVolume = Attack ? Attack->GetSwingVolume() : nullptr;
+    if (SwingVolume && (SwingVolume->StartSocket != WeaponStartSocket || SwingVolume->EndSocket != WeaponEndSocket))
+    {
+        SwingVolume = nullptr;
+    }
+    AsyncTrace.Begin(SwingVolume, TraceRadius, SweepSpatialTolerance, GetSignificanceSubstepCap());
+    
+    // Physics steps the trace; the component tick only publishes the blade and delivers hits
+    if (TraceSubsystem)
+    {
+        TraceSubsystem->UnregisterWeapon(this);
+    }
+    SetComponentTickEnabled(true);
+    bAsyncTraceStepsOnGameThread = !UPhysicsSettings::Get()->bTickPhysicsAsync;
+    SetAsyncPhysicsTickEnabled(!bAsyncTraceStepsOnGameThread);
+    
+    // First steps work from the pose the window opened on
+    UpdateAsyncTrace(0.0f);
+}
+
+void UWeaponComponent::UpdateAsyncTrace(float DeltaTime)
+{
+    COMBAT_CSV_SCOPE_IN(Traces, AsyncTraceUpdate);
+    COMBAT_BUDGET_SCOPE(Traces);
+    const UAttackData* Attack = GetSwingAttack();
+    FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Trace, Attack);
+    
+    if (bAsyncTraceStepsOnGameThread && DeltaTime > 0.0f)
+    {
+        AsyncTrace.Step(DeltaTime);
+    }
+    
+    FAsyncBladeTrace::FSnapshot Snapshot;
+    Snapshot.MeshTransform = OwnerMesh->GetComponentTransform();
+    Snapshot.MeshVelocity = GetOwner()->GetVelocity();
+    Snapshot.Start = GetSocketLocation(WeaponStartSocket);
+    Snapshot.Tip = GetSocketLocation(WeaponEndSocket);
+    
+    // Targets the blade can reach before the next publish: anywhere in the baked swing, or around the held pose
+    FVector Center = (Snapshot.Start + Snapshot.Tip) * 0.5f;
+    float Reach = FVector::Dist(Center, Snapshot.Tip);
+    const FAttackSwingVolume* SwingVolume = AsyncTrace.IsUsingBake() && Attack ? Attack->GetSwingVolume() : nullptr;
+    if (SwingVolume)
+    {
+        Snapshot.MontageTime = GetSwingMontageTime(Attack, *SwingVolume);
+        
+        const UAnimInstance* AnimInstance = OwnerMesh->GetAnimInstance();
+        const FAnimMontageInstance* MontageInstance = AnimInstance ? AnimInstance->GetActiveInstanceForMontage(Attack->AttackMontage) : nullptr;
+        Snapshot.PlayRate = MontageInstance ? MontageInstance->GetPlayRate() * Attack->AttackMontage->RateScale : 1.0f;
+        
+        const FBox WorldBounds = SwingVolume->Bounds.TransformBy(Snapshot.MeshTransform);
+        Center = WorldBounds.GetCenter();
+        Reach = WorldBounds.GetExtent().Size();
+    }
+    
+    constexpr float CapsuleSlack = 100.0f;
+    TArray<TWeakObjectPtr<UPrimitiveComponent>> Components;
+    GatherTargetCapsules(Center, Reach + TraceRadius + CapsuleSlack, [&Snapshot, &Components](UCapsuleComponent* Capsule)
+    {
+        const FVector CapsuleCenter = Capsule->GetComponentLocation();
+        const FVector Axis = Capsule->GetUpVector() * Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere();
+        FAsyncBladeTrace::FCapsule& Entry = Snapshot.Capsules.AddDefaulted_GetRef();
+        Entry.A = CapsuleCenter - Axis;
+        Entry.B = CapsuleCenter + Axis;
+        Entry.Radius = Capsule->GetScaledCapsuleRadius();
+        Components.Add(Capsule);
+    });
+    
+    // Hits refer to the capsules published last frame - deliver them before those are replaced
+    TArray<FAsyncBladeTrace::FHit> Hits;
+    AsyncTrace.Publish(MoveTemp(Snapshot), Hits);
+    DeliverAsyncTraceHits(Hits);
+    AsyncTraceComponents = MoveTemp(Components);
+}
+
+void UWeaponComponent::DeliverAsyncTraceHits(TConstArrayView<FAsyncBladeTrace::FHit> Hits)
+{
+    UWorld* World = GetWorld();
+    const FCollisionObjectQueryParams WorldParams(FCollisionObjectQueryParams::InitType::AllStaticObjects);
+    for (const FAsyncBladeTrace::FHit& AsyncHit : Hits)
+    {
+        UPrimitiveComponent* Component = AsyncTraceComponents.IsValidIndex(AsyncHit.CapsuleIndex) ? AsyncTraceComponents[AsyncHit.CapsuleIndex].Get() : nullptr;
+        if (!Component || !Component->GetOwner() || !World)
+        {
+            continue;
+        }
+        
+        // Same world blocking rule as the game thread narrowphase
+        if (bNarrowphaseWorldBlocking)
+        {
+            COMBAT_COUNT_PHYSICS_QUERY();
+            FCombatAttackProfiler::Get().AddScopeSweeps(1);
+            if (World->LineTraceTestByObjectType(AsyncHit.Start, AsyncHit.OnCapsule, WorldParams, SwingQueryParams))
+            {
+                continue;
+            }
+        }
+        
+        // Hit claims carry the pose the physics step swept
+        LastSweepPrevStart = AsyncHit.PrevStart;
+        LastSweepPrevTip = AsyncHit.PrevTip;
+        LastSweepStart = AsyncHit.Start;
+        LastSweepTip = AsyncHit.Tip;
+        bLastSweepIsBlade = true;
+        
+        FHitResult Hit(Component->GetOwner(), Component, AsyncHit.OnCapsule, (AsyncHit.OnBlade - AsyncHit.OnCapsule).GetSafeNormal());
+        Hit.bBlockingHit = true;
+        Hit.TraceStart = AsyncHit.PrevTip;
+        Hit.TraceEnd = AsyncHit.Tip;
+        ProcessHit(Hit);
+        
+        if (ShouldDebugDraw())
+        {
+            DrawDebugTrace(AsyncHit.PrevTip, AsyncHit.Tip, true, Hit);
+        }
+    }
+}
+
+void UWeaponComponent::ResetSwingQueryParams()
+{
+    SwingQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(WeaponTrace), false, OwnerCharacter);
+    SwingQueryParams.bReturnPhysicalMaterial = false;
+    
+    // Exhausted targets are appended in AddHitActor as the swing progresses (multi-hit targets stay traceable)
+    for (AActor* HitActor : HitActors)
+    {
+        const FWeaponHitTarget* Target = HitActor ? HitActorKeys.Find(FObjectKey(HitActor)) : nullptr;
+        if (Target && Target->IsExhausted())
+        {
+            SwingQueryParams.AddIgnoredActor(HitActor);
+        }
+    }
+}
+
+void UWeaponComponent::ProcessSweepResults(const TArray<FHitResult>& HitResults, const FVector& Start, const FVector& End)
+{
+    // Process all hits
+    for (const FHitResult& Hit : HitResults)
+    {
+        if (Hit.GetActor() && Hit.GetActor() != OwnerCharacter)
+        {
+            ProcessHit(Hit);
+        }
     }
     
     // Debug visualization
-    if (bDebugDraw)
+    if (ShouldDebugDraw())
     {
-        DrawDebugTrace(PreviousTipLocation, EndLocation, bHit, bHit ? HitResults[0] : FHitResult());
+        const bool bHit = HitResults.Num() > 0;
+        DrawDebugTrace(Start, End, bHit, bHit ? HitResults[0] : FHitResult());
     }
+}
+
+void UWeaponComponent::GatherProfileSweepSegments(const FAttackHitVolumeProfile& Profile, UAttackData* AttackData, TArray<FWeaponSweepSegment, TInlineAllocator<16>>& OutSegments)
+{
+    const int32 NumVolumes = Profile.Volumes.Num();
     
-    // Store current positions for next frame
-    PreviousStartLocation = StartLocation;
-    PreviousTipLocation = EndLocation;
+    // New swing or new attack - seed previous poses, nothing to sweep yet
+    // (poses primed on enable are already this swing's starting poses)
+    const bool bSeedPoses = (bFirstTrace && !bProfilePosesPrimed) || ProfileAttack != AttackData || PreviousVolumeStarts.Num() != NumVolumes;
+    bProfilePosesPrimed = false;
+    
+    const float TimeSinceEnabled = GetWorld() ? GetWorld()->GetTimeSeconds() - HitDetectionEnabledTime : 0.0f;
+    const EAttackPhase CurrentPhase = GetCurrentAttackPhase();
+    
+    PreviousVolumeStarts.SetNum(NumVolumes);
+    PreviousVolumeTips.SetNum(NumVolumes);
+    
+    for (int32 Index = 0; Index < NumVolumes; ++Index)
+    {
+        const FAttackHitVolume& Volume = Profile.Volumes[Index];
+        const FVector StartLocation = GetSocketLocation(Volume.StartSocket.IsNone() ? WeaponStartSocket : Volume.StartSocket);
+        const FVector EndLocation = GetSocketLocation(Volume.EndSocket.IsNone() ? WeaponEndSocket : Volume.EndSocket);
+        
+        // Phase None on either side means "don't filter" (unknown phase or any-phase volume)
+        const bool bPhaseMatches = Volume.Phase == EAttackPhase::None || CurrentPhase == EAttackPhase::None || Volume.Phase == CurrentPhase;
+        
+        if (!bSeedPoses && bPhaseMatches && Volume.IsActiveAt(TimeSinceEnabled))
+        {
+            BuildVolumeSweepSegments(Volume, PreviousVolumeStarts[Index], PreviousVolumeTips[Index], StartLocation, EndLocation, OutSegments);
+        }
+        
+        PreviousVolumeStarts[Index] = StartLocation;
+        PreviousVolumeTips[Index] = EndLocation;
+    }
+    
+    ProfileAttack = AttackData;
+    bFirstTrace = false;
+}
+
+void UWeaponComponent::BuildBladeSweepSegments(const FVector& PrevStart, const FVector& PrevTip, const FVector& StartLocation, const FVector& EndLocation, float Radius, TArray<FWeaponSweepSegment, TInlineAllocator<16>>& OutSegments) const
+{
+    const int32 NumSubsteps = FMath::Min(CalculateSweepSubsteps(PrevTip - PrevStart, EndLocation - StartLocation), GetSignificanceSubstepCap());
+    const int32 NumPoints = CalculateBladeSamplePoints(FMath::Max(FVector::Dist(PrevStart, PrevTip), FVector::Dist(StartLocation, EndLocation)), Radius);
+    
+    TArray<FVector, TInlineAllocator<17>> PoseBases;
+    TArray<FVector, TInlineAllocator<17>> PoseBlades;
+    BuildBladePoses(PrevStart, PrevTip, StartLocation, EndLocation, NumSubsteps, PoseBases, PoseBlades);
+    
+    const FCollisionShape SweepShape = FCollisionShape::MakeSphere(Radius);
+    OutSegments.Reserve(OutSegments.Num() + NumSubsteps * NumPoints);
+    
+    for (int32 Step = 0; Step < NumSubsteps; ++Step)
+    {
+        for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+        {
+            const float Alpha = static_cast<float>(PointIndex) / static_cast<float>(NumPoints - 1);
+            
+            FWeaponSweepSegment& Segment = OutSegments.AddDefaulted_GetRef();
+            Segment.Start = PoseBases[Step] + PoseBlades[Step] * Alpha;
+            Segment.End = PoseBases[Step + 1] + PoseBlades[Step + 1] * Alpha;
+            Segment.Shape = SweepShape;
+        }
+        
+        if (ShouldDebugDraw())
+        {
+            if (UCombatDebugDrawSubsystem* DebugDraw = UCombatDebugDrawSubsystem::Get(this))
+            {
+                DebugDraw->AddLine(OwnerCharacter, PoseBases[Step + 1], PoseBases[Step + 1] + PoseBlades[Step + 1], 
+                                   FColor::Cyan, 1.0f, DebugDrawDuration);
+            }
+        }
+    }
+}
+
+void UWeaponComponent::BuildVolumeSweepSegments(const FAttackHitVolume& Volume, const FVector& PrevStart, const FVector& PrevTip, const FVector& StartLocation, const FVector& EndLocation, TArray<FWeaponSweepSegment, TInlineAllocator<16>>& OutSegments) const
+{
+    // Spheres use the multi-point blade sweep with the volume's radius
+    if (Volume.Shape == EHitVolumeShape::Sphere)
+    {
+        BuildBladeSweepSegments(PrevStart, PrevTip, StartLocation, EndLocation, Volume.Radius, OutSegments);
+        return;
+    }
+    
+    // Capsules/boxes cover the whole start→tip span, so only angular substeps are needed
+    const int32 NumSubsteps = FMath::Min(CalculateSweepSubsteps(PrevTip - PrevStart, EndLocation - StartLocation), GetSignificanceSubstepCap());
+    
+    TArray<FVector, TInlineAllocator<17>> PoseBases;
+    TArray<FVector, TInlineAllocator<17>> PoseBlades;
+    BuildBladePoses(PrevStart, PrevTip, StartLocation, EndLocation, NumSubsteps, PoseBases, PoseBlades);
+    
+    for (int32 Step = 0; Step < NumSubsteps; ++Step)
+    {
+        // Sweeps can't rotate - orient each substep at its end pose
+        const FVector& Blade = PoseBlades[Step + 1];
+        const float HalfLength = Blade.Size() * 0.5f;
+        
+        FWeaponSweepSegment& Segment = OutSegments.AddDefaulted_GetRef();
+        Segment.Start = PoseBases[Step] + PoseBlades[Step] * 0.5f;
+        Segment.End = PoseBases[Step + 1] + Blade * 0.5f;
+        Segment.Rotation = Blade.IsNearlyZero() ? FQuat::Identity : FRotationMatrix::MakeFromZ(Blade).ToQuat();
+        
+        if (Volume.Shape == EHitVolumeShape::Capsule)
+        {
+            Segment.Shape = FCollisionShape::MakeCapsule(Volume.Radius, HalfLength + Volume.Radius);
+        }
+        else
+        {
+            const FVector HalfExtent(Volume.BoxHalfExtent.X, Volume.BoxHalfExtent.Y, Volume.BoxHalfExtent.Z > 0.0f ? Volume.BoxHalfExtent.Z : HalfLength);
+            Segment.Shape = FCollisionShape::MakeBox(HalfExtent);
+        }
+    }
+}
+
+void UWeaponComponent::BuildBladePoses(const FVector& PrevStart, const FVector& PrevTip, const FVector& StartLocation, const FVector& EndLocation, int32 NumSubsteps,
+                                       TArray<FVector, TInlineAllocator<17>>& OutBases, TArray<FVector, TInlineAllocator<17>>& OutBlades)
+{
+    const FVector PreviousBlade = PrevTip - PrevStart;
+    const FVector CurrentBlade = EndLocation - StartLocation;
+    
+    // Build intermediate blade poses (base + start→tip vector) for each substep boundary
+    // Base moves linearly, blade direction rotates about the base so the tip follows an arc
+    const FQuat BladeRotation = FQuat::FindBetweenVectors(PreviousBlade, CurrentBlade);
+    const float PreviousLength = PreviousBlade.Size();
+    const float CurrentLength = CurrentBlade.Size();
+    const bool bCanRotate = PreviousLength > KINDA_SMALL_NUMBER && CurrentLength > KINDA_SMALL_NUMBER;
+    
+    OutBases.Reset(NumSubsteps + 1);
+    OutBlades.Reset(NumSubsteps + 1);
+    
+    for (int32 Step = 0; Step <= NumSubsteps; ++Step)
+    {
+        const float T = static_cast<float>(Step) / static_cast<float>(NumSubsteps);
+        OutBases.Add(FMath::Lerp(PrevStart, StartLocation, T));
+        
+        if (bCanRotate)
+        {
+            const FVector Direction = FQuat::Slerp(FQuat::Identity, BladeRotation, T).RotateVector(PreviousBlade / PreviousLength);
+            OutBlades.Add(Direction * FMath::Lerp(PreviousLength, CurrentLength, T));
+        }
+        else
+        {
+            OutBlades.Add(FMath::Lerp(PreviousBlade, CurrentBlade, T));
+        }
+    }
+}
+
+int32 UWeaponComponent::CalculateSweepSubsteps(const FVector& PreviousBlade, const FVector& CurrentBlade) const
+{
+    const float BladeLength = FMath::Max(PreviousBlade.Size(), CurrentBlade.Size());
+    const float Tolerance = FMath::Max(SweepSpatialTolerance, 0.1f);
+    
+    // Tolerance covers the whole blade - a single chord is already close enough
+    if (BladeLength <= Tolerance || PreviousBlade.IsNearlyZero() || CurrentBlade.IsNearlyZero())
+    {
+        return 1;
+    }
+    
+    // Angle swept by the blade this frame
+    const float CosAngle = FVector::DotProduct(PreviousBlade.GetSafeNormal(), CurrentBlade.GetSafeNormal());
+    const float SweptAngle = FMath::Acos(FMath::Clamp(CosAngle, -1.0f, 1.0f));
+    
+    // Sagitta of an arc of angle Phi at radius L: L * (1 - cos(Phi / 2))
+    // Largest per-substep angle that keeps the chord within tolerance of the tip's arc
+    const float MaxStepAngle = 2.0f * FMath::Acos(1.0f - Tolerance / BladeLength);
+    if (MaxStepAngle <= KINDA_SMALL_NUMBER)
+    {
+        return FMath::Max(MaxSweepSubsteps, 1);
+    }
+    
+    return FMath::Clamp(FMath::CeilToInt(SweptAngle / MaxStepAngle), 1, FMath::Max(MaxSweepSubsteps, 1));
+}
+
+int32 UWeaponComponent::GetSignificanceSubstepCap() const
+{
+    // Claim validation calls CalculateSweepSubsteps directly and always runs at full precision
+    int32 Cap = 1;
+    switch (SwingSignificance)
+    {
+    case ECombatSignificance::High:
+        Cap = FMath::Max(MaxSweepSubsteps, 1);
+        break;
+    case ECombatSignificance::Medium:
+        Cap = FMath::Max(MaxSweepSubsteps / 2, 1);
+        break;
+    default:
+        return 1;
+    }
+    
+    // Trace budget exceeded: fewer substeps until the monitor restores quality
+    return FMath::Max(FMath::CeilToInt(Cap * SwingDetailScale), 1);
+}
+
+bool UWeaponComponent::ShouldDebugDraw() const
+{
+    if (!bDebugDraw || SwingSignificance < ECombatSignificance::Medium)
+    {
+        return false;
+    }
+    
+    const UCombatDebugDrawSubsystem* DebugDraw = UCombatDebugDrawSubsystem::Get(this);
+    return DebugDraw && DebugDraw->ShouldDraw(OwnerCharacter);
+}
+
+int32 UWeaponComponent::CalculateBladeSamplePoints(float BladeLength, float Radius) const
+{
+    // Adjacent spheres overlap when spacing <= 2 * radius; tolerance allows a small gap on top
+    const float MaxSpacing = 2.0f * Radius + FMath::Max(SweepSpatialTolerance, 0.1f);
+    const int32 RequiredPoints = FMath::CeilToInt(BladeLength / MaxSpacing) + 1;
+    
+    const int32 MaxPoints = FMath::Max(FMath::CeilToInt(MaxBladeSamplePoints * SwingDetailScale), 2);
+    return FMath::Clamp(RequiredPoints, 2, MaxPoints);
 }
 
 void UWeaponComponent::ProcessHit(const FHitResult& Hit)
 {
     AActor* HitActor = Hit.GetActor();
     
-    if (!HitActor || WasActorAlreadyHit(HitActor))
+    if (!HitActor || !CanHitActor(HitActor))
     {
         return;
     }
     
-    // Add to hit list
-    AddHitActor(HitActor);
+    // Add to hit list (or count the rehit)
+    const UAttackData* HitAttack = GetSwingAttack();
+    FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Hit, HitAttack);
+    AddHitActor(HitActor, HitAttack);
     
-    // Get current attack data
-    UAttackData* AttackData = GetCurrentAttackData();
+    // Owning client: the server decides whether this hit counts
+    if (GetHitAuthority() == EHitAuthority::Claim)
+    {
+        FWeaponHitClaim Claim;
+        Claim.HitActor = HitActor;
+        const AGameStateBase* GameState = GetWorld()->GetGameState();
+        Claim.ServerTime = GameState ? static_cast<float>(GameState->GetServerWorldTimeSeconds()) : GetWorld()->GetTimeSeconds();
+        Claim.PrevStart = LastSweepPrevStart;
+        Claim.PrevTip = LastSweepPrevTip;
+        Claim.Start = LastSweepStart;
+        Claim.Tip = LastSweepTip;
+        ServerClaimHit(Claim);
+        return;
+    }
     
-    // Broadcast hit event
+    BroadcastHit(HitActor, Hit, GetCurrentAttackData());
+}
+
+bool UWeaponComponent::ProcessProjectileHit(const FHitResult& Hit, UAttackData* AttackData)
+{
+    AActor* HitActor = Hit.GetActor();
+    if (!HitActor || HitActor == GetOwner())
+    {
+        return false;
+    }
+
+    // Projectiles are simulated by the server (or standalone); client copies only fly
+    const EHitAuthority Authority = GetHitAuthority();
+    if (Authority != EHitAuthority::Local && Authority != EHitAuthority::Validate)
+    {
+        return false;
+    }
+
+    FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Hit, AttackData);
+    BroadcastHit(HitActor, Hit, AttackData);
+    return true;
+}
+
+void UWeaponComponent::BroadcastHit(AActor* HitActor, const FHitResult& Hit, UAttackData* AttackData)
+{
+    CombatTrace::OutputHit(GetOwner(), HitActor, AttackData);
+
+    // Broadcast hit event (C++ listeners, then Blueprint)
+    OnWeaponHitNative.Broadcast(HitActor, Hit, AttackData);
     OnWeaponHit.Broadcast(HitActor, Hit, AttackData);
+
+    if (FCombatEvent* Event = UCombatEventDispatcherSubsystem::PublishFrom(this, ECombatEventKind::Hit, GetOwner(), HitActor))
+    {
+        Event->AttackData = AttackData;
+        Event->Location = Hit.ImpactPoint;
+    }
+}
+
+// ============================================================================
+// SERVER HIT VALIDATION
+// ============================================================================
+
+UWeaponComponent::EHitAuthority UWeaponComponent::GetHitAuthority() const
+{
+    if (!bServerHitValidation || !OwnerCharacter || GetNetMode() == NM_Standalone)
+    {
+        return EHitAuthority::Local;
+    }
+    
+    if (OwnerCharacter->HasAuthority())
+    {
+        // AI and the listen host's own character have no client to claim for them
+        return OwnerCharacter->IsLocallyControlled() || !OwnerCharacter->IsPlayerControlled() ? EHitAuthority::Local : EHitAuthority::Validate;
+    }
+    
+    return OwnerCharacter->IsLocallyControlled() ? EHitAuthority::Claim : EHitAuthority::None;
+}
+
+void UWeaponComponent::ServerClaimHit_Implementation(const FWeaponHitClaim& Claim)
+{
+    SCOPE_CYCLE_COUNTER(STAT_Combat_ValidateHitClaim);
+    
+    AActor* HitActor = Claim.HitActor;
+    if (!HitActor || HitActor == GetOwner() || !CanHitActor(HitActor) || GetHitAuthority() != EHitAuthority::Validate)
+    {
+        return;
+    }
+    
+    FHitResult Hit;
+    if (ValidateHitClaim(Claim, Hit))
+    {
+        ProcessHit(Hit);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("[WeaponComponent] Rejected hit claim on %s from %s"), *GetNameSafe(HitActor), *GetNameSafe(GetOwner()));
+    }
 }
 
-void UWeaponComponent::AddHitActor(AActor* Actor)
+bool UWeaponComponent::ValidateHitClaim(const FWeaponHitClaim& Claim, FHitResult& OutHit) const
 {
-    if (Actor && !WasActorAlreadyHit(Actor))
+    const UWorld* World = GetWorld();
+    const ULagCompensationSubsystem* LagCompensation = World ? World->GetSubsystem<ULagCompensationSubsystem>() : nullptr;
+    if (!World || !OwnerCharacter)
+    {
+        return false;
+    }
+    
+    const float Now = World->GetTimeSeconds();
+    const float MaxRewindTime = LagCompensation ? LagCompensation->MaxRewindTime : 0.0f;
+    
+    // Claim must land inside our own hit window (plus the rewind window for claims in flight when it closed)
+    if (!bHitDetectionEnabled && (HitDetectionDisabledTime < 0.0f || Now - HitDetectionDisabledTime > MaxRewindTime))
     {
+        return false;
+    }
+    
+    // Claimed blade must be roughly where our copy of the animation has it
+    if (FVector::DistSquared(FVector(Claim.Start), GetSocketLocation(WeaponStartSocket)) > FMath::Square(MaxClaimPoseError))
+    {
+        return false;
+    }
+    
+    // Broadphase: target must be in the spatial hash near the swept blade
+    // (query uses present positions, so pad by how far a target could have moved during the rewind)
+    const float RewindTime = FMath::Clamp(Now - Claim.ServerTime, 0.0f, MaxRewindTime);
+    const FVector BladeCenter = (Claim.PrevStart + Claim.PrevTip + Claim.Start + Claim.Tip) * 0.25f;
+    const float BladeReach = FMath::Max(FVector::Dist(BladeCenter, Claim.PrevTip), FVector::Dist(BladeCenter, Claim.Tip));
+    constexpr float MaxTargetSpeed = 1000.0f;
+    constexpr float CapsuleSlack = 100.0f;
+    if (UTargetRegistrySubsystem* Registry = World->GetSubsystem<UTargetRegistrySubsystem>())
+    {
+        TCombatScratchArray<AActor*> Candidates;
+        Registry->QueryTargetsInRadius(BladeCenter, BladeReach + CapsuleSlack + RewindTime * MaxTargetSpeed, *Candidates, GetOwner());
+        if (!Candidates->Contains(Claim.HitActor.Get()))
+        {
+            return false;
+        }
+    }
+    
+    // Target pose at the time the client swung
+    FLagCompensationSample Target;
+    if (!LagCompensation || !LagCompensation->GetRewoundSample(Claim.HitActor, Now - RewindTime, Target))
+    {
+        // No history (e.g. target not registered) - fall back to the present pose
+        FVector Extent;
+        Claim.HitActor->GetActorBounds(true, Target.Location, Extent);
+        Target.Radius = FMath::Max(Extent.X, Extent.Y);
+        Target.HalfHeight = FMath::Max(Extent.Z, Target.Radius);
+    }
+    
+    const float Reach = TraceRadius + Target.Radius + HitValidationTolerance;
+    const FVector AxisOffset(0.0f, 0.0f, FMath::Max(Target.HalfHeight - Target.Radius, 0.0f));
+    const FVector CapsuleBottom = Target.Location - AxisOffset;
+    const FVector CapsuleTop = Target.Location + AxisOffset;
+    
+    // Re-run the swept blade: test the blade at each substep pose, plus the tip's path between poses
+    const int32 NumSubsteps = CalculateSweepSubsteps(Claim.PrevTip - Claim.PrevStart, Claim.Tip - Claim.Start);
+    TArray<FVector, TInlineAllocator<17>> Bases;
+    TArray<FVector, TInlineAllocator<17>> Blades;
+    BuildBladePoses(Claim.PrevStart, Claim.PrevTip, Claim.Start, Claim.Tip, NumSubsteps, Bases, Blades);
+    
+    for (int32 PoseIndex = 0; PoseIndex < Bases.Num(); ++PoseIndex)
+    {
+        const FVector Base = Bases[PoseIndex];
+        const FVector Tip = Base + Blades[PoseIndex];
+        
+        FVector OnBlade;
+        FVector OnCapsule;
+        FMath::SegmentDistToSegmentSafe(Base, Tip, CapsuleBottom, CapsuleTop, OnBlade, OnCapsule);
+        bool bHit = FVector::DistSquared(OnBlade, OnCapsule) <= FMath::Square(Reach);
+        
+        if (!bHit && PoseIndex > 0)
+        {
+            const FVector PrevTip = Bases[PoseIndex - 1] + Blades[PoseIndex - 1];
+            FMath::SegmentDistToSegmentSafe(PrevTip, Tip, CapsuleBottom, CapsuleTop, OnBlade, OnCapsule);
+            bHit = FVector::DistSquared(OnBlade, OnCapsule) <= FMath::Square(Reach);
+        }
+        
+        if (bHit)
+        {
+            const FVector Normal = (OnBlade - OnCapsule).GetSafeNormal();
+            OutHit = FHitResult(Claim.HitActor, nullptr, OnCapsule + Normal * Target.Radius, Normal);
+            OutHit.bBlockingHit = true;
+            OutHit.TraceStart = Claim.PrevTip;
+            OutHit.TraceEnd = Claim.Tip;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+void UWeaponComponent::AddHitActor(AActor* Actor, const UAttackData* AttackData)
+{
+    if (!Actor)
+    {
+        return;
+    }
+    
+    // One entry per target: the damage route resolves on first hit, later hits only touch the cooldown
+    const FObjectKey Key(Actor);
+    FWeaponHitTarget* Target = HitActorKeys.Find(Key);
+    if (!Target)
+    {
+        Target = &HitActorKeys.Add(Key, FWeaponHitTarget::Resolve(Actor));
         HitActors.Add(Actor);
     }
+    
+    const float Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+    Target->RecordHit(Now, AttackData ? AttackData->MaxHitsPerTarget : 1, AttackData ? AttackData->RehitInterval : 0.0f);
+    
+    if (Target->IsExhausted())
+    {
+        SwingQueryParams.AddIgnoredActor(Actor);
+    }
+}
+
+FWeaponHitTarget FWeaponHitTarget::Resolve(AActor* Actor)
+{
+    FWeaponHitTarget Target;
+    if (!Actor)
+    {
+        return Target;
+    }
+
+    UClass* ActorClass = Actor->GetClass();
+    if (ActorClass->ImplementsInterface(UDamageableInterface::StaticClass()))
+    {
+        // Native only if the C++ class implements it and no Blueprint subclass overrides the events hits use
+        // (a Blueprint override lives on a non-native UFunction in the generated class)
+        const auto IsNativeEvent = [ActorClass](FName FunctionName)
+        {
+            const UFunction* Function = ActorClass->FindFunctionByName(FunctionName);
+            return Function && Function->HasAnyFunctionFlags(FUNC_Native);
+        };
+
+        IDamageableInterface* Native = Cast<IDamageableInterface>(Actor);
+        if (Native
+            && IsNativeEvent(GET_FUNCTION_NAME_CHECKED(IDamageableInterface, ApplyDamage))
+            && IsNativeEvent(GET_FUNCTION_NAME_CHECKED(IDamageableInterface, IsInCounterWindow)))
+        {
+            Target.NativeDamageable = Native;
+        }
+        else
+        {
+            Target.bBlueprintDamageable = true;
+        }
+        return Target;
+    }
+
+    Target.HitReaction = Actor->FindComponentByClass<UHitReactionComponent>();
+    return Target;
 }
 
 UAttackData* UWeaponComponent::GetCurrentAttackData() const
@@ -218,9 +1328,25 @@ UAttackData* UWeaponComponent::GetCurrentAttackData() const
     return nullptr;
 }
 
+EAttackPhase UWeaponComponent::GetCurrentAttackPhase() const
+{
+    if (!OwnerCharacter)
+    {
+        return EAttackPhase::None;
+    }
+    
+    if (UCombatComponent* CombatComp = OwnerCharacter->FindComponentByClass<UCombatComponent>())
+    {
+        return CombatComp->GetCurrentPhase();
+    }
+    
+    return EAttackPhase::None;
+}
+
 void UWeaponComponent::DrawDebugTrace(const FVector& Start, const FVector& End, bool bHit, const FHitResult& Hit) const
 {
-    if (!GetWorld())
+    UCombatDebugDrawSubsystem* DebugDraw = UCombatDebugDrawSubsystem::Get(this);
+    if (!DebugDraw)
     {
         return;
     }
@@ -228,16 +1354,16 @@ void UWeaponComponent::DrawDebugTrace(const FVector& Start, const FVector& End,
     const FColor TraceColor = bHit ? FColor::Red : FColor::Green;
     
     // Draw line from start to end
-    DrawDebugLine(GetWorld(), Start, End, TraceColor, false, DebugDrawDuration, 0, 2.0f);
+    DebugDraw->AddLine(OwnerCharacter, Start, End, TraceColor, 2.0f, DebugDrawDuration);
     
     // Draw sphere at tip
-    DrawDebugSphere(GetWorld(), End, TraceRadius, 12, TraceColor, false, DebugDrawDuration);
+    DebugDraw->AddSphere(OwnerCharacter, End, TraceRadius, 12, TraceColor, DebugDrawDuration);
     
     // Draw hit point if we hit something
     if (bHit)
     {
-        DrawDebugPoint(GetWorld(), Hit.ImpactPoint, 10.0f, FColor::Orange, false, DebugDrawDuration);
-        DrawDebugLine(GetWorld(), Hit.ImpactPoint, Hit.ImpactPoint + Hit.ImpactNormal * 30.0f, 
-                     FColor::Yellow, false, DebugDrawDuration, 0, 2.0f);
+        DebugDraw->AddPoint(OwnerCharacter, Hit.ImpactPoint, 10.0f, FColor::Orange, DebugDrawDuration);
+        DebugDraw->AddLine(OwnerCharacter, Hit.ImpactPoint, Hit.ImpactPoint + Hit.ImpactNormal * 30.0f, 
+                           FColor::Yellow, 2.0f, DebugDrawDuration);
     }
 }
\ No newline at end of file
@@ -0,0 +1,261 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/WeaponTraceSubsystem.h"
+#include "Core/WeaponComponent.h"
+#include "Core/HurtboxComponent.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatAttackProfiler.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+void UWeaponTraceSubsystem::Deinitialize()
+{
+    ActiveWeapons.Empty();
+    PendingTraces.Empty();
+    PendingMeleeTraces.Empty();
+    PendingProjectileTraces.Empty();
+    DeliveringProjectileTraces.Empty();
+
+    Super::Deinitialize();
+}
+
+void UWeaponTraceSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Results first so hits from last frame's swings land before new sweeps go out
+    DeliverPendingTraces();
+    DeliverPendingMeleeTraces();
+    DeliverPendingProjectileTraces();
+    SubmitWeaponTraces();
+}
+
+bool UWeaponTraceSubsystem::IsTickable() const
+{
+    return ActiveWeapons.Num() > 0 || PendingTraces.Num() > 0 || PendingMeleeTraces.Num() > 0 || PendingProjectileTraces.Num() > 0;
+}
+
+TStatId UWeaponTraceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UWeaponTraceSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+void UWeaponTraceSubsystem::RegisterWeapon(UWeaponComponent* Weapon)
+{
+    if (Weapon)
+    {
+        ActiveWeapons.AddUnique(Weapon);
+    }
+}
+
+void UWeaponTraceSubsystem::UnregisterWeapon(UWeaponComponent* Weapon)
+{
+    ActiveWeapons.RemoveSwap(Weapon);
+}
+
+void UWeaponTraceSubsystem::QueueMeleeTrace(const FMeleeTraceRequest& Request, FOnMeleeTraceHits&& OnHits)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    FPendingMeleeTrace& Pending = PendingMeleeTraces.AddDefaulted_GetRef();
+    Pending.OnHits = MoveTemp(OnHits);
+    Pending.SubmitFrame = GFrameCounter;
+    COMBAT_COUNT_PHYSICS_QUERY();
+    Pending.Handle = World->AsyncSweepByObjectType(
+        Request.TraceType,
+        Request.Start,
+        Request.End,
+        FQuat::Identity,
+        Request.ObjectParams,
+        FCollisionShape::MakeSphere(Request.Radius),
+        Request.QueryParams
+    );
+}
+
+void UWeaponTraceSubsystem::QueueProjectileTrace(FCombatProjectileHandle Projectile, const FMeleeTraceRequest& Request)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    FPendingProjectileTrace& Pending = PendingProjectileTraces.AddDefaulted_GetRef();
+    Pending.Projectile = Projectile;
+    Pending.SubmitFrame = GFrameCounter;
+    COMBAT_COUNT_PHYSICS_QUERY();
+    Pending.Handle = World->AsyncSweepByObjectType(
+        Request.TraceType,
+        Request.Start,
+        Request.End,
+        FQuat::Identity,
+        Request.ObjectParams,
+        FCollisionShape::MakeSphere(Request.Radius),
+        Request.QueryParams
+    );
+}
+
+// ============================================================================
+// BATCH PROCESSING
+// ============================================================================
+
+void UWeaponTraceSubsystem::DeliverPendingTraces()
+{
+    UWorld* World = GetWorld();
+    if (!World || PendingTraces.Num() == 0)
+    {
+        return;
+    }
+
+    // Swap out so hit callbacks that enable/disable weapons can't mutate the list we're iterating
+    TArray<FPendingWeaponTrace> TracesToDeliver = MoveTemp(PendingTraces);
+    PendingTraces.Reset();
+
+    FTraceDatum TraceData;
+    for (const FPendingWeaponTrace& Pending : TracesToDeliver)
+    {
+        UWeaponComponent* Weapon = Pending.Weapon.Get();
+        if (!Weapon || !World->QueryTraceData(Pending.Handle, TraceData))
+        {
+            continue;
+        }
+
+        FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Trace, Weapon->GetSwingAttack());
+        Weapon->ProcessSweepResults(TraceData.OutHits, TraceData.Start, TraceData.End);
+    }
+}
+
+void UWeaponTraceSubsystem::DeliverPendingMeleeTraces()
+{
+    UWorld* World = GetWorld();
+    if (!World || PendingMeleeTraces.Num() == 0)
+    {
+        return;
+    }
+
+    // Melee traces are queued at any point in the frame - ones from this frame aren't done yet
+    TArray<FPendingMeleeTrace> TracesToDeliver;
+    for (int32 Index = PendingMeleeTraces.Num() - 1; Index >= 0; --Index)
+    {
+        if (PendingMeleeTraces[Index].SubmitFrame < GFrameCounter)
+        {
+            TracesToDeliver.Add(MoveTemp(PendingMeleeTraces[Index]));
+            PendingMeleeTraces.RemoveAtSwap(Index, EAllowShrinking::No);
+        }
+    }
+
+    FTraceDatum TraceData;
+    for (int32 Index = TracesToDeliver.Num() - 1; Index >= 0; --Index)
+    {
+        FPendingMeleeTrace& Pending = TracesToDeliver[Index];
+        if (World->QueryTraceData(Pending.Handle, TraceData))
+        {
+            Pending.OnHits.ExecuteIfBound(TraceData.OutHits);
+        }
+    }
+}
+
+void UWeaponTraceSubsystem::DeliverPendingProjectileTraces()
+{
+    UWorld* World = GetWorld();
+    UCombatProjectileSubsystem* ProjectileSubsystem = World ? World->GetSubsystem<UCombatProjectileSubsystem>() : nullptr;
+    if (!ProjectileSubsystem || PendingProjectileTraces.Num() == 0)
+    {
+        return;
+    }
+
+    // The projectile tick may already have queued this frame's sweeps - those wait for the next pass
+    DeliveringProjectileTraces.Reset();
+    for (int32 Index = PendingProjectileTraces.Num() - 1; Index >= 0; --Index)
+    {
+        if (PendingProjectileTraces[Index].SubmitFrame < GFrameCounter)
+        {
+            DeliveringProjectileTraces.Add(PendingProjectileTraces[Index]);
+            PendingProjectileTraces.RemoveAtSwap(Index, EAllowShrinking::No);
+        }
+    }
+
+    FTraceDatum TraceData;
+    for (const FPendingProjectileTrace& Pending : DeliveringProjectileTraces)
+    {
+        if (World->QueryTraceData(Pending.Handle, TraceData))
+        {
+            ProjectileSubsystem->HandleTraceHits(Pending.Projectile, TraceData.OutHits);
+        }
+    }
+}
+
+void UWeaponTraceSubsystem::SubmitWeaponTraces()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    TArray<FWeaponSweepSegment, TInlineAllocator<16>> Segments;
+
+    for (int32 Index = ActiveWeapons.Num() - 1; Index >= 0; --Index)
+    {
+        UWeaponComponent* Weapon = ActiveWeapons[Index].Get();
+        if (!Weapon || !Weapon->IsHitDetectionEnabled())
+        {
+            ActiveWeapons.RemoveAtSwap(Index);
+            continue;
+        }
+
+        Segments.Reset();
+        FCombatAttackProfileScope AttackProfileScope(ECombatAttackCost::Trace);
+        // Narrowphase weapons resolve synchronously - there's no physics query to batch
+        if (!Weapon->GatherSweepSegments(Segments) || Weapon->TryBladeNarrowphase())
+        {
+            continue;
+        }
+
+        // Params maintained per swing by the weapon, shared by all of its segments
+        const FCollisionQueryParams& QueryParams = Weapon->GetSweepQueryParams();
+        AttackProfileScope.AddSweeps(Segments.Num());
+
+        for (const FWeaponSweepSegment& Segment : Segments)
+        {
+            FPendingWeaponTrace& Pending = PendingTraces.AddDefaulted_GetRef();
+            Pending.Weapon = Weapon;
+            COMBAT_COUNT_PHYSICS_QUERY();
+            if (Weapon->bUseHurtboxes)
+            {
+                Pending.Handle = World->AsyncSweepByObjectType(
+                    EAsyncTraceType::Multi,
+                    Segment.Start,
+                    Segment.End,
+                    Segment.Rotation,
+                    FCollisionObjectQueryParams(UHurtboxComponent::HurtboxChannel),
+                    Segment.Shape,
+                    QueryParams
+                );
+            }
+            else
+            {
+                Pending.Handle = World->AsyncSweepByChannel(
+                    EAsyncTraceType::Multi,
+                    Segment.Start,
+                    Segment.End,
+                    Segment.Rotation,
+                    Weapon->TraceChannel,
+                    Segment.Shape,
+                    QueryParams
+                );
+            }
+        }
+    }
+}
@@ -1,13 +1,110 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Data/AttackConfiguration.h"
+#include "Data/AttackData.h"
+#include "Core/ComboPreloadSubsystem.h"
+
+const FName UAttackConfiguration::CoreBundleName(TEXT("Core"));
+const FName UAttackConfiguration::ExtendedBundleName(TEXT("Extended"));
+
+namespace AttackConfigurationBundles
+{
+	/** Walk depth for the Extended bundle (deeper than any authored chain) */
+	constexpr int32 MaxExtendedDepth = 32;
+}
 
 UAttackConfiguration::UAttackConfiguration()
 {
 	// Initialize to nullptr - must be configured in data asset
 	DefaultLightAttack = nullptr;
 	DefaultHeavyAttack = nullptr;
-	SprintAttack = nullptr;
-	JumpAttack = nullptr;
-	PlungingAttack = nullptr;
-}
\ No newline at end of file
+}
+
+void UAttackConfiguration::GatherBundlePaths(FName BundleName, TArray<FSoftObjectPath>& OutPaths, bool& bOutHasUnloaded) const
+{
+	OutPaths.Reset();
+	bOutHasUnloaded = false;
+
+	const UAttackData* DefaultRoots[] = { DefaultLightAttack.Get(), DefaultHeavyAttack.Get() };
+
+	TArray<FSoftObjectPath> CorePaths;
+	bool bCoreHasUnloaded = false;
+	UComboPreloadSubsystem::GatherChainPaths(DefaultRoots, CoreBundleDepth, CorePaths, bCoreHasUnloaded);
+
+	if (BundleName == CoreBundleName)
+	{
+		OutPaths = MoveTemp(CorePaths);
+		bOutHasUnloaded = bCoreHasUnloaded;
+		return;
+	}
+
+	if (BundleName != ExtendedBundleName)
+	{
+		return;
+	}
+
+	// Movement attacks are Extended roots; walk behind the ones already loaded
+	TArray<const UAttackData*, TInlineAllocator<5>> Roots(DefaultRoots, UE_ARRAY_COUNT(DefaultRoots));
+	for (const TSoftObjectPtr<UAttackData>* MovementAttack : { &SprintAttack, &JumpAttack, &PlungingAttack })
+	{
+		if (MovementAttack->IsNull())
+		{
+			continue;
+		}
+
+		OutPaths.AddUnique(MovementAttack->ToSoftObjectPath());
+		if (const UAttackData* Loaded = MovementAttack->Get())
+		{
+			Roots.Add(Loaded);
+		}
+		else
+		{
+			bOutHasUnloaded = true;
+		}
+	}
+
+	TArray<FSoftObjectPath> ReachablePaths;
+	bool bReachableHasUnloaded = false;
+	UComboPreloadSubsystem::GatherChainPaths(Roots, AttackConfigurationBundles::MaxExtendedDepth, ReachablePaths, bReachableHasUnloaded);
+	bOutHasUnloaded |= bReachableHasUnloaded;
+
+	// Everything the Core bundle doesn't already cover
+	for (const FSoftObjectPath& Path : ReachablePaths)
+	{
+		if (!CorePaths.Contains(Path))
+		{
+			OutPaths.AddUnique(Path);
+		}
+	}
+}
+
+#if WITH_EDITORONLY_DATA
+void UAttackConfiguration::UpdateAssetBundleData()
+{
+	// Picks up the AssetBundles meta on the movement attacks
+	Super::UpdateAssetBundleData();
+
+	for (const FName BundleName : { CoreBundleName, ExtendedBundleName })
+	{
+		// Load as we go until the walk reaches every node (bounded by the graph size)
+		TArray<FSoftObjectPath> Paths;
+		bool bHasUnloaded = true;
+		for (int32 Pass = 0; bHasUnloaded && Pass <= AttackConfigurationBundles::MaxExtendedDepth; ++Pass)
+		{
+			GatherBundlePaths(BundleName, Paths, bHasUnloaded);
+			if (bHasUnloaded)
+			{
+				for (const FSoftObjectPath& Path : Paths)
+				{
+					Path.TryLoad();
+				}
+			}
+		}
+
+		for (const FSoftObjectPath& Path : Paths)
+		{
+			AssetBundleData.AddBundleAsset(BundleName, Path.GetAssetPath());
+		}
+	}
+}
+#endif
\ No newline at end of file
@@ -4,13 +4,23 @@
 #include "Animation/AnimMontage.h"
 #include "Animation/AnimNotifyState_AttackPhase.h"
 #include "Animation/AnimNotify_AttackPhaseTransition.h"
+#include "UObject/AssetRegistryTagsContext.h"
+#include "Algo/BinarySearch.h"
+#include "Utilities/MontageUtilityLibrary.h"
 
 #if WITH_EDITOR
+#include "Data/ComboGraphValidationCache.h"
 #include "Misc/DataValidation.h"
+#include "UObject/ObjectSaveContext.h"
 #endif
 
 DEFINE_LOG_CATEGORY_STATIC(LogAttackData, Log, All);
 
+const FName UAttackData::AttackMontageTagName(TEXT("AttackMontage"));
+const FName UAttackData::MontageSectionTagName(TEXT("MontageSection"));
+const FName UAttackData::AttackTypeTagName(TEXT("AttackType"));
+const FName UAttackData::ComboLinksTagName(TEXT("ComboLinks"));
+
 UAttackData::UAttackData()
 {
     // Default values are already set in header file via inline initialization
@@ -18,194 +28,596 @@ UAttackData::UAttackData()
 }
 
 // ============================================================================
-// SECTION & TIMING QUERIES
+// SECTION & TIMING QUERIES (read the cooked timing block)
 // ============================================================================
 
 void UAttackData::GetSectionTimeRange(float& OutStart, float& OutEnd) const
 {
-    OutStart = 0.0f;
-    OutEnd = 0.0f;
-    
+    FAttackTimingCache Scratch;
+    const FAttackTimingCache& Timing = GetTimingCache(Scratch);
+
+    OutStart = Timing.SectionStart;
+    OutEnd = Timing.SectionEnd;
+}
+
+float UAttackData::GetSectionLength() const
+{
+    float Start, End;
+    GetSectionTimeRange(Start, End);
+    return FMath::Max(0.0f, End - Start);
+}
+
+float UAttackData::GetActiveReach() const
+{
+    FAttackTimingCache Scratch;
+    const FAttackTimingCache& Timing = GetTimingCache(Scratch);
+
+    // Root space forward is +X; backward steps never reduce reach below standing still
+    return FMath::Max(Timing.ActiveEndOffset.X, 0.0f);
+}
+
+float UAttackData::GetMaxTargetDistance() const
+{
+    const bool bWarpsTranslation = MotionWarpingConfig.bUseMotionWarping && MotionWarpingConfig.bWarpTranslation;
+    return GetActiveReach() + (bWarpsTranslation ? MotionWarpingConfig.MaxWarpDistance : 0.0f);
+}
+
+bool UAttackData::HasValidNotifyTimingInSection() const
+{
     if (!AttackMontage)
     {
-        return;
+        return false;
     }
+
+    FAttackTimingCache Scratch;
+    return GetTimingCache(Scratch).bHasValidNotifyTiming;
+}
+
+void UAttackData::GetEffectiveTiming(float& OutWindup, float& OutActive, float& OutRecovery) const
+{
+    OutWindup = 0.0f;
+    OutActive = 0.0f;
+    OutRecovery = 0.0f;
     
-    // If no section specified, use entire montage
-    if (MontageSection == NAME_None)
+    if (!AttackMontage)
     {
-        OutStart = 0.0f;
-        OutEnd = AttackMontage->CalculateSequenceLength();
+        UE_LOG(LogAttackData, Warning, TEXT("%s: No AttackMontage assigned"), *GetName());
         return;
     }
     
-    // Find section index
-    const int32 SectionIndex = AttackMontage->GetSectionIndex(MontageSection);
-    if (SectionIndex == INDEX_NONE)
+    // Primary: durations extracted from AnimNotifyStates when the block was generated
+    FAttackTimingCache Scratch;
+    const FAttackTimingCache& Timing = GetTimingCache(Scratch);
+
+    if (Timing.bHasValidNotifyTiming && !Timing.bHasLegacyPhaseDurations)
     {
-        UE_LOG(LogAttackData, Warning, TEXT("%s: MontageSection '%s' not found in montage '%s'"), 
-               *GetName(), *MontageSection.ToString(), *AttackMontage->GetName());
-        return;
+        // Notify timing without all three legacy states - durations are the manual fallback
+        UE_LOG(LogAttackData, Warning, TEXT("%s: Phase notifies incomplete for duration timing. Check timing fallback mode."), *GetName());
     }
-    
-    // Get section start time
-    OutStart = AttackMontage->GetAnimCompositeSection(SectionIndex).GetTime();
-    
-    // Find next section or end of montage
-    OutEnd = AttackMontage->CalculateSequenceLength();
-    
-    for (int32 i = 0; i < AttackMontage->CompositeSections.Num(); ++i)
+
+    // Folded when the block was generated: legacy state durations, else manual timing
+    OutWindup = Timing.PhaseDurations.WindupDuration;
+    OutActive = Timing.PhaseDurations.ActiveDuration;
+    OutRecovery = Timing.PhaseDurations.RecoveryDuration;
+}
+
+// ============================================================================
+// COOKED TIMING
+// ============================================================================
+
+bool FAttackTimingCache::Matches(const FAttackTimingCache& Other) const
+{
+    constexpr float Tolerance = KINDA_SMALL_NUMBER;
+
+    if (bIsBuilt != Other.bIsBuilt
+        || SourceMontage != Other.SourceMontage
+        || SourceSection != Other.SourceSection
+        || bHasValidNotifyTiming != Other.bHasValidNotifyTiming
+        || bHasLegacyPhaseStates != Other.bHasLegacyPhaseStates
+        || bHasLegacyPhaseDurations != Other.bHasLegacyPhaseDurations
+        || !FMath::IsNearlyEqual(SectionStart, Other.SectionStart, Tolerance)
+        || !FMath::IsNearlyEqual(SectionEnd, Other.SectionEnd, Tolerance)
+        || !FMath::IsNearlyEqual(ActiveTransitionTime, Other.ActiveTransitionTime, Tolerance)
+        || !FMath::IsNearlyEqual(RecoveryTransitionTime, Other.RecoveryTransitionTime, Tolerance)
+        || bHasRootMotion != Other.bHasRootMotion
+        || !RootMotionDisplacement.Equals(Other.RootMotionDisplacement, Tolerance)
+        || !ActiveStartOffset.Equals(Other.ActiveStartOffset, Tolerance)
+        || !ActiveEndOffset.Equals(Other.ActiveEndOffset, Tolerance)
+        || Windows.Num() != Other.Windows.Num())
+    {
+        return false;
+    }
+
+    if (!FMath::IsNearlyEqual(PhaseDurations.WindupDuration, Other.PhaseDurations.WindupDuration, Tolerance)
+        || !FMath::IsNearlyEqual(PhaseDurations.ActiveDuration, Other.PhaseDurations.ActiveDuration, Tolerance)
+        || !FMath::IsNearlyEqual(PhaseDurations.RecoveryDuration, Other.PhaseDurations.RecoveryDuration, Tolerance))
+    {
+        return false;
+    }
+
+    for (int32 i = 0; i < Windows.Num(); ++i)
     {
-        if (i != SectionIndex)
+        if (Windows[i].WindowType != Other.Windows[i].WindowType
+            || !FMath::IsNearlyEqual(Windows[i].MontageTime, Other.Windows[i].MontageTime, Tolerance)
+            || !FMath::IsNearlyEqual(Windows[i].Duration, Other.Windows[i].Duration, Tolerance))
         {
-            const float OtherSectionStart = AttackMontage->CompositeSections[i].GetTime();
-            if (OtherSectionStart > OutStart && OtherSectionStart < OutEnd)
-            {
-                OutEnd = OtherSectionStart;
-            }
+            return false;
         }
     }
+
+    return true;
 }
 
-float UAttackData::GetSectionLength() const
+const FAttackTimingCache& UAttackData::GetTimingCache(FAttackTimingCache& Scratch) const
 {
-    float Start, End;
-    GetSectionTimeRange(Start, End);
-    return FMath::Max(0.0f, End - Start);
+    if (TimingCache.IsValidFor(AttackMontage, MontageSection))
+    {
+        return TimingCache;
+    }
+
+    // Montage/section changed since the block was cooked (or never cooked) - scan once into the caller's scratch
+    BuildTimingCache(Scratch);
+    return Scratch;
 }
 
-// ============================================================================
-// NOTIFY TIMING VALIDATION & EXTRACTION
-// ============================================================================
+void UAttackData::RefreshTimingCache()
+{
+    BuildTimingCache(TimingCache);
+}
 
-bool UAttackData::HasValidNotifyTimingInSection() const
+void UAttackData::BuildTimingCache(FAttackTimingCache& OutCache) const
 {
+    // Deprecated timing only exists in editor; cooked builds keep the durations folded at cook
+#if WITH_EDITORONLY_DATA
+    const FAttackPhaseTimingOverride FallbackDurations = ManualTiming;
+    const bool bUseNotifyDurations = bUseAnimNotifyTiming;
+#else
+    const FAttackPhaseTimingOverride FallbackDurations = TimingCache.PhaseDurations;
+    const bool bUseNotifyDurations = true;
+#endif
+
+    OutCache = FAttackTimingCache();
+    OutCache.PhaseDurations = FallbackDurations;
+    OutCache.SourceMontage = AttackMontage;
+    OutCache.SourceSection = MontageSection;
+    OutCache.bIsBuilt = true;
+
     if (!AttackMontage)
     {
-        return false;
+        return;
+    }
+
+    // ------------------------------------------------------------------------
+    // Section range
+    // ------------------------------------------------------------------------
+
+    // If no section specified, use entire montage
+    if (MontageSection == NAME_None)
+    {
+        OutCache.SectionStart = 0.0f;
+        OutCache.SectionEnd = AttackMontage->CalculateSequenceLength();
+    }
+    else
+    {
+        // Shared section metadata (a local table when cooking off the game thread)
+        FMontageSectionTable LocalSections;
+        const FMontageSectionTable* Sections = IsInGameThread() ? UMontageUtilityLibrary::GetSectionTable(AttackMontage) : nullptr;
+        if (!Sections)
+        {
+            LocalSections.Build(AttackMontage);
+            Sections = &LocalSections;
+        }
+
+        const int32 SectionIndex = Sections->FindSection(MontageSection);
+        if (SectionIndex == INDEX_NONE)
+        {
+            UE_LOG(LogAttackData, Warning, TEXT("%s: MontageSection '%s' not found in montage '%s'"), 
+                   *GetName(), *MontageSection.ToString(), *AttackMontage->GetName());
+            return;
+        }
+
+        // Section start, up to the next section or the end of the montage
+        OutCache.SectionStart = Sections->StartTimes[SectionIndex];
+        OutCache.SectionEnd = Sections->EndTimes[SectionIndex];
     }
 
-    float SectionStart, SectionEnd;
-    GetSectionTimeRange(SectionStart, SectionEnd);
+    const float SectionStart = OutCache.SectionStart;
+    const float SectionEnd = OutCache.SectionEnd;
 
-    bool bHasActiveTransition = false;
-    bool bHasRecoveryTransition = false;
+    // ------------------------------------------------------------------------
+    // Phase boundaries
+    // ------------------------------------------------------------------------
+    // NEW SYSTEM: AnimNotify_AttackPhaseTransition events (Windup → Active, Active → Recovery)
+    // DEPRECATED: AnimNotifyState_AttackPhase states (one per phase, still honoured)
 
-    // NEW SYSTEM: Check for AnimNotify_AttackPhaseTransition events
-    // We need exactly 2 transition events:
-    // 1. Windup → Active transition
-    // 2. Active → Recovery transition
+    float WindupStart = -1.0f, WindupEnd = -1.0f;
+    float ActiveStart = -1.0f, ActiveEnd = -1.0f;
+    float RecoveryStart = -1.0f, RecoveryEnd = -1.0f;
 
     for (const FAnimNotifyEvent& NotifyEvent : AttackMontage->Notifies)
     {
         const float NotifyTime = NotifyEvent.GetTriggerTime();
 
         // Check if notify is within our section
-        if (NotifyTime >= SectionStart && NotifyTime < SectionEnd)
+        if (NotifyTime < SectionStart || NotifyTime >= SectionEnd)
         {
-            // Check for new event-based phase transitions
-            if (const UAnimNotify_AttackPhaseTransition* TransitionNotify = Cast<UAnimNotify_AttackPhaseTransition>(NotifyEvent.Notify))
+            continue;
+        }
+
+        if (const UAnimNotify_AttackPhaseTransition* TransitionNotify = Cast<UAnimNotify_AttackPhaseTransition>(NotifyEvent.Notify))
+        {
+            if (TransitionNotify->TransitionToPhase == EAttackPhase::Active)
             {
-                if (TransitionNotify->TransitionToPhase == EAttackPhase::Active)
-                {
-                    bHasActiveTransition = true;
-                }
-                else if (TransitionNotify->TransitionToPhase == EAttackPhase::Recovery)
-                {
-                    bHasRecoveryTransition = true;
-                }
+                OutCache.ActiveTransitionTime = NotifyTime;
             }
+            else if (TransitionNotify->TransitionToPhase == EAttackPhase::Recovery)
+            {
+                OutCache.RecoveryTransitionTime = NotifyTime;
+            }
+        }
+
+        if (const UAnimNotifyState_AttackPhase* PhaseNotify = Cast<UAnimNotifyState_AttackPhase>(NotifyEvent.NotifyStateClass))
+        {
+            OutCache.bHasLegacyPhaseStates = true;
 
-            // DEPRECATED: Also check for old AnimNotifyState_AttackPhase for backward compatibility
-            if (const UAnimNotifyState_AttackPhase* PhaseNotify = Cast<UAnimNotifyState_AttackPhase>(NotifyEvent.NotifyStateClass))
+            const float EndTime = NotifyEvent.GetEndTriggerTime();
+            switch (PhaseNotify->Phase)
             {
-                // Old system is deprecated but still functional
-                // If found, consider it valid (but log deprecation warning)
-                static bool bDeprecationWarningLogged = false;
-                if (!bDeprecationWarningLogged)
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("[AttackData] Found deprecated AnimNotifyState_AttackPhase in montage. Please migrate to AnimNotify_AttackPhaseTransition."));
-                    bDeprecationWarningLogged = true;
-                }
-                return true; // Old system found - consider valid for now
+                case EAttackPhase::Windup:
+                    WindupStart = NotifyTime;
+                    WindupEnd = EndTime;
+                    break;
+                case EAttackPhase::Active:
+                    ActiveStart = NotifyTime;
+                    ActiveEnd = EndTime;
+                    break;
+                case EAttackPhase::Recovery:
+                    RecoveryStart = NotifyTime;
+                    RecoveryEnd = EndTime;
+                    break;
+                default:
+                    break;
             }
         }
     }
 
-    // NEW SYSTEM: Valid if has both required transitions
-    return bHasActiveTransition && bHasRecoveryTransition;
+    static bool bDeprecationWarningLogged = false;
+    if (OutCache.bHasLegacyPhaseStates && !bDeprecationWarningLogged)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AttackData] Found deprecated AnimNotifyState_AttackPhase in montage. Please migrate to AnimNotify_AttackPhaseTransition."));
+        bDeprecationWarningLogged = true;
+    }
+
+    // Old system found - consider valid for now; new system needs both transitions
+    OutCache.bHasValidNotifyTiming = OutCache.bHasLegacyPhaseStates
+        || (OutCache.ActiveTransitionTime >= 0.0f && OutCache.RecoveryTransitionTime >= 0.0f);
+
+    if (WindupStart >= 0.0f && ActiveStart >= 0.0f && RecoveryStart >= 0.0f)
+    {
+        OutCache.bHasLegacyPhaseDurations = true;
+        if (bUseNotifyDurations)
+        {
+            OutCache.PhaseDurations.WindupDuration = WindupEnd - WindupStart;
+            OutCache.PhaseDurations.ActiveDuration = ActiveEnd - ActiveStart;
+            OutCache.PhaseDurations.RecoveryDuration = RecoveryEnd - RecoveryStart;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Action windows (sorted by montage time)
+    // ------------------------------------------------------------------------
+
+    UMontageUtilityLibrary::DiscoverCheckpoints(AttackMontage, OutCache.Windows);
+    OutCache.Windows.RemoveAll([SectionStart, SectionEnd](const FTimerCheckpoint& Window)
+    {
+        return Window.MontageTime < SectionStart || Window.MontageTime >= SectionEnd;
+    });
+
+    // ------------------------------------------------------------------------
+    // Root motion and reach (so warp/targeting never sample the animation)
+    // ------------------------------------------------------------------------
+
+    if (!AttackMontage->HasRootMotion())
+    {
+        return;
+    }
+
+    // Active range: transition notifies, else legacy Active state, else the whole section
+    float ActiveStartTime = OutCache.ActiveTransitionTime >= 0.0f ? OutCache.ActiveTransitionTime : ActiveStart;
+    float ActiveEndTime = OutCache.RecoveryTransitionTime >= 0.0f ? OutCache.RecoveryTransitionTime : ActiveEnd;
+    if (ActiveStartTime < 0.0f)
+    {
+        ActiveStartTime = SectionStart;
+    }
+    if (ActiveEndTime < ActiveStartTime)
+    {
+        ActiveEndTime = SectionEnd;
+    }
+
+    const FAnimExtractContext ExtractContext;
+    OutCache.bHasRootMotion = true;
+    OutCache.RootMotionDisplacement = AttackMontage->ExtractRootMotionFromTrackRange(SectionStart, SectionEnd, ExtractContext).GetTranslation();
+    OutCache.ActiveStartOffset = AttackMontage->ExtractRootMotionFromTrackRange(SectionStart, ActiveStartTime, ExtractContext).GetTranslation();
+    OutCache.ActiveEndOffset = AttackMontage->ExtractRootMotionFromTrackRange(SectionStart, ActiveEndTime, ExtractContext).GetTranslation();
 }
 
-void UAttackData::GetEffectiveTiming(float& OutWindup, float& OutActive, float& OutRecovery) const
+// ============================================================================
+// SWING VOLUME
+// ============================================================================
+
+void FAttackSwingVolume::GetSample(int32 Index, FVector& OutStart, FVector& OutTip) const
 {
-    OutWindup = 0.0f;
-    OutActive = 0.0f;
-    OutRecovery = 0.0f;
-    
-    if (!AttackMontage)
+    const uint16* Values = &QuantizedPoses[Index * ValuesPerSample];
+    const FVector Step = Bounds.GetSize() / static_cast<double>(MAX_uint16);
+    OutStart = Bounds.Min + FVector(Values[0], Values[1], Values[2]) * Step;
+    OutTip = Bounds.Min + FVector(Values[3], Values[4], Values[5]) * Step;
+}
+
+void FAttackSwingVolume::SampleAtTime(float MontageTime, FVector& OutStart, FVector& OutTip) const
+{
+    const int32 NumSamples = GetNumSamples();
+    const float Position = SampleInterval > 0.0f ? (MontageTime - StartTime) / SampleInterval : 0.0f;
+    const float Clamped = FMath::Clamp(Position, 0.0f, static_cast<float>(NumSamples - 1));
+    const int32 Index = FMath::Min(FMath::FloorToInt(Clamped), FMath::Max(NumSamples - 2, 0));
+
+    GetSample(Index, OutStart, OutTip);
+    if (Index + 1 < NumSamples)
+    {
+        FVector NextStart, NextTip;
+        GetSample(Index + 1, NextStart, NextTip);
+
+        const float Alpha = Clamped - static_cast<float>(Index);
+        OutStart = FMath::Lerp(OutStart, NextStart, Alpha);
+        OutTip = FMath::Lerp(OutTip, NextTip, Alpha);
+    }
+}
+
+void FAttackSwingVolume::Build(TConstArrayView<FVector> Starts, TConstArrayView<FVector> Tips, float InRadius)
+{
+    check(Starts.Num() == Tips.Num());
+
+    Radius = FMath::Max(InRadius, 0.0f);
+    Bounds = FBox(ForceInit);
+    QuantizedPoses.Reset(Starts.Num() * ValuesPerSample);
+    if (Starts.Num() == 0)
     {
-        UE_LOG(LogAttackData, Warning, TEXT("%s: No AttackMontage assigned"), *GetName());
         return;
     }
-    
-    // Primary: Try to extract from AnimNotifyStates if enabled
-    if (bUseAnimNotifyTiming && HasValidNotifyTimingInSection())
-    {
-        float SectionStart, SectionEnd;
-        GetSectionTimeRange(SectionStart, SectionEnd);
-        
-        float WindupStart = -1.0f, WindupEnd = -1.0f;
-        float ActiveStart = -1.0f, ActiveEnd = -1.0f;
-        float RecoveryStart = -1.0f, RecoveryEnd = -1.0f;
-        
-        for (const FAnimNotifyEvent& NotifyEvent : AttackMontage->Notifies)
+
+    for (int32 Index = 0; Index < Starts.Num(); ++Index)
+    {
+        Bounds += Starts[Index];
+        Bounds += Tips[Index];
+    }
+    Bounds = Bounds.ExpandBy(Radius);
+
+    // Every point is inside the inflated box, so the 16-bit grid over it never clamps
+    const FVector Size = Bounds.GetSize();
+    auto Quantize = [this, &Size](const FVector& Point)
+    {
+        for (int32 Axis = 0; Axis < 3; ++Axis)
         {
-            const float NotifyTime = NotifyEvent.GetTriggerTime();
-            
-            if (NotifyTime >= SectionStart && NotifyTime < SectionEnd)
-            {
-                if (const UAnimNotifyState_AttackPhase* PhaseNotify = Cast<UAnimNotifyState_AttackPhase>(NotifyEvent.NotifyStateClass))
-                {
-                    const float StartTime = NotifyEvent.GetTriggerTime();
-                    const float EndTime = NotifyEvent.GetEndTriggerTime();
-                    
-                    switch (PhaseNotify->Phase)
-                    {
-                        case EAttackPhase::Windup:
-                            WindupStart = StartTime;
-                            WindupEnd = EndTime;
-                            break;
-                        case EAttackPhase::Active:
-                            ActiveStart = StartTime;
-                            ActiveEnd = EndTime;
-                            break;
-                        case EAttackPhase::Recovery:
-                            RecoveryStart = StartTime;
-                            RecoveryEnd = EndTime;
-                            break;
-                        default:
-                            break;
-                    }
-                }
-            }
+            const double Alpha = Size[Axis] > UE_KINDA_SMALL_NUMBER ? (Point[Axis] - Bounds.Min[Axis]) / Size[Axis] : 0.0;
+            QuantizedPoses.Add(static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Alpha * MAX_uint16), 0, static_cast<int32>(MAX_uint16))));
+        }
+    };
+
+    for (int32 Index = 0; Index < Starts.Num(); ++Index)
+    {
+        Quantize(Starts[Index]);
+        Quantize(Tips[Index]);
+    }
+}
+
+void FAttackSwingVolume::Reset()
+{
+    *this = FAttackSwingVolume();
+}
+
+// ============================================================================
+// COMBO LINK QUERIES
+// ============================================================================
+
+UAttackData* UAttackData::GetComboLink(EInputType InputType) const
+{
+    const bool bHeavy = (InputType == EInputType::HeavyAttack);
+    if (UAttackData* HardLink = bHeavy ? HeavyComboAttack.Get() : NextComboAttack.Get())
+    {
+        return HardLink;
+    }
+
+    // Soft link resolves only once streamed in (never loads synchronously here)
+    return bHeavy ? SoftHeavyComboAttack.Get() : SoftNextComboAttack.Get();
+}
+
+UAttackData* UAttackData::GetDirectionalFollowUp(EInputType InputType, EAttackDirection InDirection, bool* bOutHasEntry) const
+{
+    const bool bHeavy = (InputType == EInputType::HeavyAttack);
+
+    if (const TObjectPtr<UAttackData>* HardLink = (bHeavy ? HeavyDirectionalFollowUps : DirectionalFollowUps).Find(InDirection))
+    {
+        if (bOutHasEntry)
+        {
+            *bOutHasEntry = true;
         }
-        
-        if (WindupStart >= 0.0f && ActiveStart >= 0.0f && RecoveryStart >= 0.0f)
+        return HardLink->Get();
+    }
+
+    if (const TSoftObjectPtr<UAttackData>* SoftLink = (bHeavy ? SoftHeavyDirectionalFollowUps : SoftDirectionalFollowUps).Find(InDirection))
+    {
+        if (bOutHasEntry)
         {
-            OutWindup = WindupEnd - WindupStart;
-            OutActive = ActiveEnd - ActiveStart;
-            OutRecovery = RecoveryEnd - RecoveryStart;
-            return;
+            *bOutHasEntry = true;
         }
-        
-        // If we reach here, bUseAnimNotifyTiming is true but notifies are invalid
-        UE_LOG(LogAttackData, Warning, TEXT("%s: bUseAnimNotifyTiming=true but notifies incomplete. Check timing fallback mode."), *GetName());
+        return SoftLink->Get();
+    }
+
+    if (bOutHasEntry)
+    {
+        *bOutHasEntry = false;
+    }
+    return nullptr;
+}
+
+bool UAttackData::HasDirectionalFollowUps(EInputType InputType) const
+{
+    return InputType == EInputType::HeavyAttack
+        ? (HeavyDirectionalFollowUps.Num() > 0 || SoftHeavyDirectionalFollowUps.Num() > 0)
+        : (DirectionalFollowUps.Num() > 0 || SoftDirectionalFollowUps.Num() > 0);
+}
+
+bool UAttackData::HasComboBranches() const
+{
+    return NextComboAttack || HeavyComboAttack || !SoftNextComboAttack.IsNull() || !SoftHeavyComboAttack.IsNull()
+        || HasDirectionalFollowUps(EInputType::LightAttack) || HasDirectionalFollowUps(EInputType::HeavyAttack);
+}
+
+void UAttackData::ForEachComboLink(TFunctionRef<void(const FSoftObjectPath& SoftPath, UAttackData* Attack)> Visitor) const
+{
+    static const FSoftObjectPath HardPath;
+
+    auto VisitHard = [&Visitor](UAttackData* Attack)
+    {
+        if (Attack)
+        {
+            Visitor(HardPath, Attack);
+        }
+    };
+    auto VisitSoft = [&Visitor](const TSoftObjectPtr<UAttackData>& Link)
+    {
+        if (!Link.IsNull())
+        {
+            Visitor(Link.ToSoftObjectPath(), Link.Get());
+        }
+    };
+
+    VisitHard(NextComboAttack);
+    VisitHard(HeavyComboAttack);
+    VisitSoft(SoftNextComboAttack);
+    VisitSoft(SoftHeavyComboAttack);
+
+    for (const auto& Pair : DirectionalFollowUps)
+    {
+        VisitHard(Pair.Value);
+    }
+    for (const auto& Pair : HeavyDirectionalFollowUps)
+    {
+        VisitHard(Pair.Value);
+    }
+    for (const auto& Pair : SoftDirectionalFollowUps)
+    {
+        VisitSoft(Pair.Value);
+    }
+    for (const auto& Pair : SoftHeavyDirectionalFollowUps)
+    {
+        VisitSoft(Pair.Value);
+    }
+    for (const TObjectPtr<UAttackData>& Variant : ContextVariants)
+    {
+        VisitHard(Variant);
+    }
+}
+
+// ============================================================================
+// CHARGE STAGES
+// ============================================================================
+
+void FChargeStageTable::Build(TConstArrayView<FChargeStage> Authored, FChargeStageTable& OutTable)
+{
+    OutTable.Stages.Reset();
+    OutTable.Stages.Append(Authored.GetData(), Authored.Num());
+
+    for (FChargeStage& Stage : OutTable.Stages)
+    {
+        Stage.HoldTime = FMath::Max(Stage.HoldTime, 0.0f);
+    }
+
+    OutTable.Stages.StableSort([](const FChargeStage& A, const FChargeStage& B) { return A.HoldTime < B.HoldTime; });
+}
+
+int32 FChargeStageTable::FindStage(float HoldTime) const
+{
+    // Last stage whose threshold has been reached
+    return Algo::UpperBoundBy(Stages, HoldTime, &FChargeStage::HoldTime) - 1;
+}
+
+const FChargeStageTable& UAttackData::GetChargeStageTable() const
+{
+    if (!bChargeStageTableBuilt)
+    {
+        FChargeStageTable::Build(ChargeStages, ChargeStageTable);
+        bChargeStageTableBuilt = true;
+    }
+    return ChargeStageTable;
+}
+
+// ============================================================================
+// CONTEXT MATCHING
+// ============================================================================
+
+void UAttackData::CompileContextMasks() const
+{
+    const FCombatContextTagTable& Table = FCombatContextTagTable::Get();
+    if (ContextMaskGeneration == Table.GetGeneration())
+    {
+        return;
+    }
+
+    RequiredContextMask = Table.MakeQueryMask(RequiredContextTags);
+    BlockedContextMask = Table.MakeQueryMask(BlockedContextTags);
+    ContextMaskGeneration = Table.GetGeneration();
+
+    // Resolution path is decided once here instead of per resolution
+    ContextResolutionPath = EResolutionPath::ContextSensitive;
+    if (RequiredContextTags.HasTag(CombatContextTags::ParryCounter))
+    {
+        ContextResolutionPath = EResolutionPath::ParryCounter;
+    }
+    else if (RequiredContextTags.HasTag(CombatContextTags::LowHealthFinisher))
+    {
+        ContextResolutionPath = EResolutionPath::LowHealthFinisher;
     }
-    
-    // Fallback: Use manual timing
-    OutWindup = ManualTiming.WindupDuration;
-    OutActive = ManualTiming.ActiveDuration;
-    OutRecovery = ManualTiming.RecoveryDuration;
+}
+
+void UAttackData::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
+{
+    Super::GetAssetRegistryTags(Context);
+
+    const FString MontagePath = AttackMontage ? FSoftObjectPath(AttackMontage.Get()).ToString() : FString();
+    Context.AddTag(FAssetRegistryTag(AttackMontageTagName, MontagePath, FAssetRegistryTag::TT_Alphabetical));
+    Context.AddTag(FAssetRegistryTag(MontageSectionTagName, MontageSection.ToString(), FAssetRegistryTag::TT_Alphabetical));
+    Context.AddTag(FAssetRegistryTag(AttackTypeTagName, StaticEnum<EAttackType>()->GetNameStringByValue(static_cast<int64>(AttackType)), FAssetRegistryTag::TT_Alphabetical));
+
+    // Hard links report the linked object's path, soft links their stored path (loaded or not)
+    FString ComboLinks;
+    ForEachComboLink([&ComboLinks](const FSoftObjectPath& SoftPath, UAttackData* Attack)
+    {
+        if (!ComboLinks.IsEmpty())
+        {
+            ComboLinks += TEXT(";");
+        }
+        ComboLinks += SoftPath.IsNull() ? FSoftObjectPath(Attack).ToString() : SoftPath.ToString();
+    });
+    Context.AddTag(FAssetRegistryTag(ComboLinksTagName, ComboLinks, FAssetRegistryTag::TT_Hidden));
+}
+
+bool UAttackData::MatchesContext(const FCombatContextMask& ActiveMask, const FGameplayTagContainer& ActiveContext) const
+{
+    CompileContextMasks();
+
+    // Tag without a bit (more than FCombatContextTagTable::MaxBits, or outside Context) - exact container semantics
+    if (RequiredContextMask.bOverflow || BlockedContextMask.bOverflow)
+    {
+        return ActiveContext.HasAll(RequiredContextTags) && !ActiveContext.HasAny(BlockedContextTags);
+    }
+
+    return ActiveMask.HasAll(RequiredContextMask) && !ActiveMask.HasAny(BlockedContextMask);
+}
+
+EResolutionPath UAttackData::GetContextResolutionPath() const
+{
+    CompileContextMasks();
+    return ContextResolutionPath;
 }
 
 #if WITH_EDITOR
@@ -256,6 +668,15 @@ void UAttackData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedE
     
     const FName PropertyName = PropertyChangedEvent.GetPropertyName();
     
+    // Combo links may have changed - revalidate this attack and what leads to it
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UAttackData, NextComboAttack)
+        || PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UAttackData, HeavyComboAttack)
+        || PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UAttackData, DirectionalFollowUps)
+        || PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UAttackData, HeavyDirectionalFollowUps))
+    {
+        FComboGraphValidationCache::Get().Invalidate(this);
+    }
+
     // If montage changed, validate section still exists
     if (PropertyName == GET_MEMBER_NAME_CHECKED(UAttackData, AttackMontage))
     {
@@ -271,6 +692,28 @@ void UAttackData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedE
         }
     }
     
+    // Context tags edited - recompile masks on next match
+    if (PropertyName == GET_MEMBER_NAME_CHECKED(UAttackData, RequiredContextTags)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UAttackData, BlockedContextTags))
+    {
+        ContextMaskGeneration = 0;
+    }
+
+    // Stage edits (including inner fields) - recompile the table on next use
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UAttackData, ChargeStages))
+    {
+        bChargeStageTableBuilt = false;
+    }
+
+    // Keep the cooked timing block in step with the montage/section it was built from
+    if (PropertyName == GET_MEMBER_NAME_CHECKED(UAttackData, AttackMontage)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UAttackData, MontageSection)
+        || PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UAttackData, ManualTiming)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UAttackData, bUseAnimNotifyTiming))
+    {
+        RefreshTimingCache();
+    }
+    
     // If timing mode changed to AnimNotify, validate notifies exist
     if (PropertyName == GET_MEMBER_NAME_CHECKED(UAttackData, bUseAnimNotifyTiming))
     {
@@ -282,6 +725,19 @@ void UAttackData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedE
     }
 }
 
+void UAttackData::PreSave(FObjectPreSaveContext SaveContext)
+{
+    // Notifies may have been edited on the montage since the last save - regenerate from source.
+    // Also the cook-time transform: the deprecated timing is folded into PhaseDurations here and
+    // the editor-only properties themselves are stripped from the cooked asset.
+    RefreshTimingCache();
+
+    // Links set outside the details panel (scripts, undo) are picked up here, before validate-on-save
+    FComboGraphValidationCache::Get().Invalidate(this);
+
+    Super::PreSave(SaveContext);
+}
+
 // ============================================================================
 // CONTEXT SYSTEM VALIDATION (Phase 1)
 // ============================================================================
@@ -291,9 +747,8 @@ EDataValidationResult UAttackData::IsDataValid(FDataValidationContext& Context)
     EDataValidationResult Result = EDataValidationResult::Valid;
     TArray<FText> ValidationErrors;
 
-    // Run all validation checks
-    TSet<const UAttackData*> Visited;
-    const bool bHasCycles = DetectCycles(Visited, ValidationErrors);
+    // Run all validation checks (cycles from the shared cache - only edited subgraphs are rewalked)
+    const bool bHasCycles = FComboGraphValidationCache::Get().GetCycleErrors(this, ValidationErrors);
     const bool bDirectionalValid = ValidateDirectionalFollowUps(ValidationErrors);
     const bool bTerminalValid = ValidateTerminalTag(ValidationErrors);
 
@@ -460,6 +915,15 @@ bool UAttackData::ValidateTerminalTag(TArray<FText>& Errors) const
             )));
             bIsValid = false;
         }
+
+        if (!SoftNextComboAttack.IsNull() || !SoftHeavyComboAttack.IsNull() || SoftDirectionalFollowUps.Num() > 0 || SoftHeavyDirectionalFollowUps.Num() > 0)
+        {
+            Errors.Add(FText::FromString(FString::Printf(
+                TEXT("%s: Has 'Attack.Capability.Terminal' tag but soft combo links (Combos|Streaming) are set. Terminal attacks cannot have follow-ups."),
+                *GetName()
+            )));
+            bIsValid = false;
+        }
     }
 
     return bIsValid;
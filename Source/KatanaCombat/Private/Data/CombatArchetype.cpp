@@ -0,0 +1,21 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Data/CombatArchetype.h"
+
+const FHitReactionTable& UCombatArchetype::GetReactionTable() const
+{
+    if (!ReactionTable.IsBuilt())
+    {
+        ReactionTable.Build(LightHitReactions, HeavyHitReactions, StunnedHitReactions, FinisherVictimAnimations);
+    }
+    return ReactionTable;
+}
+
+#if WITH_EDITOR
+void UCombatArchetype::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    ReactionTable.Reset();
+}
+#endif
@@ -0,0 +1,112 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Data/CombatContextMask.h"
+#include "GameplayTagsManager.h"
+#include "Debug/CombatTrace.h"
+
+namespace CombatContextTags
+{
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(ParryCounter, "Context.ParryCounter", "Successful parry - parry counter attacks available");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(LowHealthFinisher, "Context.LowHealthFinisher", "Target at low health - finisher attacks available");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(DirectionalFollowUp, "Context.DirectionalFollowUp", "Attack reached via hold-and-release");
+}
+
+const FName FCombatContextTagTable::ContextRootName(TEXT("Context"));
+
+const FCombatContextTagTable& FCombatContextTagTable::Get()
+{
+    static FCombatContextTagTable Table;
+    if (Table.bNeedsRebuild)
+    {
+        Table.Build();
+    }
+    return Table;
+}
+
+void FCombatContextTagTable::Build()
+{
+    bNeedsRebuild = false;
+    BitIndices.Reset();
+    ++Generation;
+    if (Generation == 0)
+    {
+        Generation = 1;
+    }
+
+    UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+
+#if WITH_EDITOR
+    // Tags can be added/renamed while the editor runs - drop bit assignments when the tree changes
+    static bool bBoundRefresh = false;
+    if (!bBoundRefresh)
+    {
+        bBoundRefresh = true;
+        TagsManager.OnEditorRefreshGameplayTagTree.AddLambda([]()
+        {
+            const_cast<FCombatContextTagTable&>(Get()).bNeedsRebuild = true;
+        });
+    }
+#endif
+
+    const FGameplayTag ContextRoot = FGameplayTag::RequestGameplayTag(ContextRootName, false);
+    if (!ContextRoot.IsValid())
+    {
+        return;
+    }
+
+    // Root first, then descendants (parents always precede children in the tag tree order)
+    BitIndices.Add(ContextRoot, 0);
+    const FGameplayTagContainer Children = TagsManager.RequestGameplayTagChildren(ContextRoot);
+    for (const FGameplayTag& Tag : Children)
+    {
+        if (BitIndices.Num() >= MaxBits)
+        {
+            UE_LOG(LogCombat, Warning, TEXT("[CONTEXT] More than %d Context tags - '%s' and later tags use container matching"),
+                MaxBits, *Tag.ToString());
+            break;
+        }
+        BitIndices.Add(Tag, BitIndices.Num());
+    }
+
+    UE_LOG(LogCombat, Log, TEXT("[CONTEXT] Compiled %d context tags to bits"), BitIndices.Num());
+}
+
+int32 FCombatContextTagTable::GetBitIndex(const FGameplayTag& Tag) const
+{
+    const int32* Found = BitIndices.Find(Tag);
+    return Found ? *Found : INDEX_NONE;
+}
+
+FCombatContextMask FCombatContextTagTable::MakeActiveMask(const FGameplayTagContainer& Tags) const
+{
+    // Tags without a bit cannot satisfy a non-overflowing query, so they are simply skipped
+    FCombatContextMask Mask;
+    for (const FGameplayTag& Tag : Tags)
+    {
+        for (FGameplayTag Current = Tag; Current.IsValid(); Current = Current.RequestDirectParent())
+        {
+            const int32 Bit = GetBitIndex(Current);
+            if (Bit != INDEX_NONE)
+            {
+                Mask.Bits |= (uint64(1) << Bit);
+            }
+        }
+    }
+    return Mask;
+}
+
+FCombatContextMask FCombatContextTagTable::MakeQueryMask(const FGameplayTagContainer& Tags) const
+{
+    FCombatContextMask Mask;
+    for (const FGameplayTag& Tag : Tags)
+    {
+        const int32 Bit = GetBitIndex(Tag);
+        if (Bit == INDEX_NONE)
+        {
+            Mask.bOverflow = true;
+            continue;
+        }
+        Mask.Bits |= (uint64(1) << Bit);
+    }
+    return Mask;
+}
@@ -0,0 +1,229 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Data/ComboGraphValidationCache.h"
+
+#if WITH_EDITOR
+
+#include "Data/AttackData.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	/** The links UAttackData::DetectCycles walks (hard links only - no loads) */
+	void GatherHardLinks(const UAttackData* Attack, TArray<const UAttackData*, TInlineAllocator<16>>& OutLinks)
+	{
+		OutLinks.Reset();
+
+		auto AddLink = [&OutLinks](const UAttackData* Link)
+		{
+			if (Link)
+			{
+				OutLinks.AddUnique(Link);
+			}
+		};
+
+		AddLink(Attack->NextComboAttack);
+		AddLink(Attack->HeavyComboAttack);
+		for (const auto& Pair : Attack->DirectionalFollowUps)
+		{
+			AddLink(Pair.Value);
+		}
+		for (const auto& Pair : Attack->HeavyDirectionalFollowUps)
+		{
+			AddLink(Pair.Value);
+		}
+	}
+
+	enum class ENodeVisit : uint8
+	{
+		Unvisited,
+		InProgress,
+		Done
+	};
+}
+
+FComboGraphValidationCache& FComboGraphValidationCache::Get()
+{
+	static FComboGraphValidationCache Cache;
+	return Cache;
+}
+
+bool FComboGraphValidationCache::GetCycleErrors(const UAttackData* Attack, TArray<FText>& OutErrors)
+{
+	if (!Attack)
+	{
+		return false;
+	}
+
+	FString CycleAttackName;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		TMap<FObjectKey, uint8> VisitState;
+		Validate(Attack, VisitState);
+
+		const FNode& Node = Nodes.FindChecked(FObjectKey(Attack));
+		if (!Node.bReachesCycle)
+		{
+			return false;
+		}
+		CycleAttackName = Node.CycleAttackName;
+	}
+
+	OutErrors.Add(FText::FromString(FString::Printf(
+		TEXT("%s: Circular reference detected in combo chain! Attack references itself through combo links."),
+		*CycleAttackName
+	)));
+	return true;
+}
+
+bool FComboGraphValidationCache::ReachesCycle(const UAttackData* Attack)
+{
+	if (!Attack)
+	{
+		return false;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	TMap<FObjectKey, uint8> VisitState;
+	Validate(Attack, VisitState);
+	return Nodes.FindChecked(FObjectKey(Attack)).bReachesCycle;
+}
+
+void FComboGraphValidationCache::Invalidate(const UAttackData* Attack)
+{
+	if (!Attack)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	FNode* Node = Nodes.Find(FObjectKey(Attack));
+	if (!Node)
+	{
+		return;
+	}
+
+	Node->bLinksValid = false;
+
+	// Only the attack and what leads to it can change result - successors keep theirs
+	TArray<FObjectKey, TInlineAllocator<32>> Pending;
+	Pending.Add(FObjectKey(Attack));
+	while (Pending.Num() > 0)
+	{
+		FNode* Dirty = Nodes.Find(Pending.Pop(EAllowShrinking::No));
+		if (!Dirty || !Dirty->bResultValid)
+		{
+			continue;
+		}
+
+		Dirty->bResultValid = false;
+		Pending.Append(Dirty->Predecessors);
+	}
+}
+
+void FComboGraphValidationCache::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Nodes.Reset();
+}
+
+FComboGraphValidationCache::FNode& FComboGraphValidationCache::UpdateLinks(const UAttackData* Attack)
+{
+	const FObjectKey Key(Attack);
+	FNode& Node = Nodes.FindOrAdd(Key);
+	if (Node.bLinksValid)
+	{
+		return Node;
+	}
+
+	Node.Attack = Attack;
+	Node.bLinksValid = true;
+	Node.bResultValid = false;
+
+	TArray<const UAttackData*, TInlineAllocator<16>> Links;
+	GatherHardLinks(Attack, Links);
+
+	// Old links drop their reverse entry; new ones are created on first sight
+	TArray<FObjectKey> OldSuccessors = MoveTemp(Node.Successors);
+	Node.Successors.Reset(Links.Num());
+	for (const UAttackData* Link : Links)
+	{
+		Node.Successors.Add(FObjectKey(Link));
+	}
+
+	const TArray<FObjectKey> NewSuccessors = Node.Successors;
+	for (const FObjectKey& Successor : OldSuccessors)
+	{
+		if (FNode* SuccessorNode = Nodes.Find(Successor))
+		{
+			SuccessorNode->Predecessors.RemoveSingleSwap(Key, EAllowShrinking::No);
+		}
+	}
+	for (int32 Index = 0; Index < Links.Num(); ++Index)
+	{
+		FNode& SuccessorNode = Nodes.FindOrAdd(NewSuccessors[Index]);
+		SuccessorNode.Attack = Links[Index];
+		SuccessorNode.Predecessors.Add(Key);
+	}
+
+	// Adding successors may have moved this node
+	return Nodes.FindChecked(Key);
+}
+
+void FComboGraphValidationCache::Validate(const UAttackData* Attack, TMap<FObjectKey, uint8>& VisitState)
+{
+	const FObjectKey Key(Attack);
+	if (UpdateLinks(Attack).bResultValid)
+	{
+		return;
+	}
+
+	VisitState.Add(Key, static_cast<uint8>(ENodeVisit::InProgress));
+
+	bool bReachesCycle = false;
+	FString CycleAttackName;
+	const TArray<FObjectKey> Successors = Nodes.FindChecked(Key).Successors;
+	for (const FObjectKey& Successor : Successors)
+	{
+		const FNode& SuccessorNode = Nodes.FindChecked(Successor);
+		const UAttackData* SuccessorAttack = SuccessorNode.Attack.Get();
+		if (!SuccessorAttack)
+		{
+			continue;
+		}
+
+		const uint8* State = VisitState.Find(Successor);
+		if (State && *State == static_cast<uint8>(ENodeVisit::InProgress))
+		{
+			// Back edge - the loop closes at the successor
+			if (!bReachesCycle)
+			{
+				CycleAttackName = SuccessorAttack->GetName();
+			}
+			bReachesCycle = true;
+			continue;
+		}
+
+		Validate(SuccessorAttack, VisitState);
+
+		const FNode& ValidatedNode = Nodes.FindChecked(Successor);
+		if (ValidatedNode.bReachesCycle && !bReachesCycle)
+		{
+			CycleAttackName = ValidatedNode.CycleAttackName;
+			bReachesCycle = true;
+		}
+	}
+
+	VisitState.Add(Key, static_cast<uint8>(ENodeVisit::Done));
+
+	FNode& Node = Nodes.FindChecked(Key);
+	Node.bReachesCycle = bReachesCycle;
+	Node.CycleAttackName = MoveTemp(CycleAttackName);
+	Node.bResultValid = true;
+	++NumNodesValidated;
+}
+
+#endif // WITH_EDITOR
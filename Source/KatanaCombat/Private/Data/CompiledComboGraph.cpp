@@ -0,0 +1,436 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Data/CompiledComboGraph.h"
+#include "Data/AttackData.h"
+#include "Core/CombatSimCore.h"
+#include "Debug/CombatTrace.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	/** Every attack directly reachable from Attack through combo links (soft links only once loaded) */
+	void GatherLinks(const UAttackData* Attack, TArray<UAttackData*, TInlineAllocator<16>>& OutLinks)
+	{
+		OutLinks.Reset();
+		Attack->ForEachComboLink([&OutLinks](const FSoftObjectPath&, UAttackData* Link)
+		{
+			if (Link)
+			{
+				OutLinks.Add(Link);
+			}
+		});
+	}
+
+	/** Cooked metadata the AI move selection reads */
+	FCompiledComboNodeInfo BuildNodeInfo(const UAttackData* Attack)
+	{
+		FCompiledComboNodeInfo Info;
+		if (!Attack)
+		{
+			return Info;
+		}
+
+		const FCombatSimAttackTiming Timing = FCombatSimCore::CookAttackTiming(Attack);
+		Info.WindupDuration = Timing.Windup;
+		Info.ActiveDuration = Timing.Active;
+		Info.RecoveryDuration = Timing.Recovery;
+		Info.Reach = Attack->GetMaxTargetDistance();
+		Info.ExpectedDamage = Attack->BaseDamage;
+		Info.PostureDamage = Attack->PostureDamage;
+
+		FAttackTimingCache Scratch;
+		for (const FTimerCheckpoint& Window : Attack->GetTimingCache(Scratch).Windows)
+		{
+			if (Window.WindowType == EActionWindowType::Parry)
+			{
+				Info.ParryWindow += Window.Duration;
+			}
+		}
+
+		return Info;
+	}
+
+	enum class ENodeVisit : uint8
+	{
+		Unvisited,
+		InProgress,
+		Done
+	};
+}
+
+// ============================================================================
+// BUILD
+// ============================================================================
+
+void FCompiledComboGraph::Reset()
+{
+	Attacks.Reset();
+	Transitions.Reset();
+	NodeInfos.Reset();
+	NodeIndices.Reset();
+	CycleEdges.Reset();
+	DefaultLightAttack = nullptr;
+	DefaultHeavyAttack = nullptr;
+	bIsBuilt = false;
+	bHasCycles = false;
+}
+
+void FCompiledComboGraph::Build(UAttackData* InDefaultLightAttack, UAttackData* InDefaultHeavyAttack)
+{
+	COMBAT_LLM_SCOPE(AttackGraph);
+	Reset();
+
+	DefaultLightAttack = InDefaultLightAttack;
+	DefaultHeavyAttack = InDefaultHeavyAttack;
+
+	// Root node represents "no current attack"
+	Attacks.Add(nullptr);
+
+	// Breadth-first walk assigns node indices to every reachable attack
+	auto AddNode = [this](UAttackData* Attack)
+	{
+		if (Attack && !NodeIndices.Contains(Attack))
+		{
+			NodeIndices.Add(Attack, Attacks.Add(Attack));
+		}
+	};
+
+	AddNode(DefaultLightAttack);
+	AddNode(DefaultHeavyAttack);
+
+	TArray<UAttackData*, TInlineAllocator<16>> Links;
+	for (int32 NodeIdx = 1; NodeIdx < Attacks.Num(); ++NodeIdx)
+	{
+		GatherLinks(Attacks[NodeIdx], Links);
+		for (UAttackData* Link : Links)
+		{
+			AddNode(Link);
+		}
+	}
+
+	// Fill the flat transition table
+	Transitions.SetNum(Attacks.Num() * SlotsPerNode);
+	for (int32 NodeIdx = 0; NodeIdx < Attacks.Num(); ++NodeIdx)
+	{
+		const UAttackData* Current = Attacks[NodeIdx];
+		for (EInputType InputType : { EInputType::LightAttack, EInputType::HeavyAttack })
+		{
+			for (int32 DirIdx = 0; DirIdx < NumDirectionSlots; ++DirIdx)
+			{
+				const EAttackDirection Direction = static_cast<EAttackDirection>(DirIdx);
+				for (int32 HoldIdx = 0; HoldIdx < 2; ++HoldIdx)
+				{
+					for (int32 ComboIdx = 0; ComboIdx < 2; ++ComboIdx)
+					{
+						const int32 Slot = GetSlotIndex(InputType, Direction, HoldIdx != 0, ComboIdx != 0);
+						Transitions[NodeIdx * SlotsPerNode + Slot] = CompileTransition(Current, InputType, Direction, HoldIdx != 0, ComboIdx != 0);
+					}
+				}
+			}
+		}
+	}
+
+	// AI metadata, so move selection never touches the attack assets
+	NodeInfos.SetNum(Attacks.Num());
+	for (int32 NodeIdx = 1; NodeIdx < Attacks.Num(); ++NodeIdx)
+	{
+		NodeInfos[NodeIdx] = BuildNodeInfo(Attacks[NodeIdx]);
+	}
+
+	// Cycle detection happens here once instead of per resolution
+	TArray<uint8> VisitState;
+	VisitState.SetNumZeroed(Attacks.Num());
+	for (int32 NodeIdx = 1; NodeIdx < Attacks.Num(); ++NodeIdx)
+	{
+		if (VisitState[NodeIdx] == static_cast<uint8>(ENodeVisit::Unvisited) && DetectCyclesFrom(NodeIdx, VisitState))
+		{
+			bHasCycles = true;
+		}
+	}
+
+	bIsBuilt = true;
+
+	UE_LOG(LogCombat, Log, TEXT("[COMBO GRAPH] Compiled %d attack nodes (%d transitions)%s"),
+		Attacks.Num() - 1, Transitions.Num(), bHasCycles ? TEXT(" - contains cycles") : TEXT(""));
+}
+
+FCompiledComboTransition FCompiledComboGraph::CompileTransition(
+	const UAttackData* Current,
+	EInputType InputType,
+	EAttackDirection Direction,
+	bool bIsHolding,
+	bool bComboWindowActive) const
+{
+	FCompiledComboTransition Transition;
+
+	auto ToNode = [this](const UAttackData* Attack)
+	{
+		const int32* Found = Attack ? NodeIndices.Find(Attack) : nullptr;
+		return Found ? *Found : INDEX_NONE;
+	};
+
+	if (Current)
+	{
+		// PRIORITY 2: Directional follow-up (hold + direction)
+		if (bIsHolding && Direction != EAttackDirection::None)
+		{
+			if (const UAttackData* Directional = Current->GetDirectionalFollowUp(InputType, Direction))
+			{
+				Transition.Target = ToNode(Directional);
+				Transition.Path = EResolutionPath::DirectionalFollowUp;
+				Transition.bShouldClearDirectionalInput = true;
+				return Transition;
+			}
+		}
+
+		// PRIORITY 3: Normal combo chain (mirrors GetComboAttack: a mapped direction wins, even if empty)
+		if (bComboWindowActive)
+		{
+			bool bHasDirectionalEntry = false;
+			const UAttackData* Directional = Direction != EAttackDirection::None
+				? Current->GetDirectionalFollowUp(InputType, Direction, &bHasDirectionalEntry)
+				: nullptr;
+			const UAttackData* ComboAttack = bHasDirectionalEntry ? Directional : Current->GetComboLink(InputType);
+
+			if (ComboAttack)
+			{
+				Transition.Target = ToNode(ComboAttack);
+				Transition.Path = EResolutionPath::NormalCombo;
+				return Transition;
+			}
+		}
+	}
+
+	// PRIORITY 4: Default attacks
+	Transition.Target = ToNode(InputType == EInputType::HeavyAttack ? DefaultHeavyAttack.Get() : DefaultLightAttack.Get());
+	Transition.Path = EResolutionPath::Default;
+	return Transition;
+}
+
+bool FCompiledComboGraph::DetectCyclesFrom(int32 Node, TArray<uint8>& VisitState) const
+{
+	VisitState[Node] = static_cast<uint8>(ENodeVisit::InProgress);
+
+	bool bFoundCycle = false;
+	TArray<UAttackData*, TInlineAllocator<16>> Links;
+	GatherLinks(Attacks[Node], Links);
+
+	for (UAttackData* Link : Links)
+	{
+		const int32 LinkNode = NodeIndices.FindChecked(Link);
+		const ENodeVisit State = static_cast<ENodeVisit>(VisitState[LinkNode]);
+
+		if (State == ENodeVisit::InProgress)
+		{
+			UE_LOG(LogCombat, Error, TEXT("[COMBO GRAPH] Circular reference in combo chain: '%s' → '%s'"),
+				*Attacks[Node]->GetName(), *Link->GetName());
+			CycleEdges.Emplace(Node, LinkNode);
+			bFoundCycle = true;
+		}
+		else if (State == ENodeVisit::Unvisited && DetectCyclesFrom(LinkNode, VisitState))
+		{
+			bFoundCycle = true;
+		}
+	}
+
+	VisitState[Node] = static_cast<uint8>(ENodeVisit::Done);
+	return bFoundCycle;
+}
+
+// ============================================================================
+// INSPECTION
+// ============================================================================
+
+void FCompiledComboGraph::GetResolvableSuccessors(int32 Node, TArray<int32>& OutNodes) const
+{
+	OutNodes.Reset();
+
+	if (!Attacks.IsValidIndex(Node))
+	{
+		return;
+	}
+
+	for (int32 Slot = 0; Slot < SlotsPerNode; ++Slot)
+	{
+		const int32 Target = Transitions[Node * SlotsPerNode + Slot].Target;
+		if (Target != INDEX_NONE && Target != RootNode)
+		{
+			OutNodes.AddUnique(Target);
+		}
+	}
+}
+
+void FCompiledComboGraph::GetLinkedNodes(int32 Node, TArray<int32>& OutNodes) const
+{
+	OutNodes.Reset();
+
+	if (Node == RootNode)
+	{
+		for (const UAttackData* Default : { DefaultLightAttack.Get(), DefaultHeavyAttack.Get() })
+		{
+			if (const int32* Found = NodeIndices.Find(Default))
+			{
+				OutNodes.AddUnique(*Found);
+			}
+		}
+		return;
+	}
+
+	if (!Attacks.IsValidIndex(Node))
+	{
+		return;
+	}
+
+	TArray<UAttackData*, TInlineAllocator<16>> Links;
+	GatherLinks(Attacks[Node], Links);
+	for (UAttackData* Link : Links)
+	{
+		OutNodes.AddUnique(NodeIndices.FindChecked(Link));
+	}
+}
+
+void FCompiledComboGraph::GetMontages(TArray<UAnimMontage*>& OutMontages) const
+{
+	OutMontages.Reset();
+
+	for (const UAttackData* Attack : Attacks)
+	{
+		if (Attack && Attack->AttackMontage)
+		{
+			OutMontages.AddUnique(Attack->AttackMontage.Get());
+		}
+	}
+}
+
+// ============================================================================
+// AI MOVE SELECTION
+// ============================================================================
+
+const FCompiledComboNodeInfo& FCompiledComboGraph::GetNodeInfo(int32 Node) const
+{
+	static const FCompiledComboNodeInfo Empty;
+	return NodeInfos.IsValidIndex(Node) ? NodeInfos[Node] : Empty;
+}
+
+float FCompiledComboGraph::ScoreMove(const FCompiledComboNodeInfo& Info, const FComboMoveUtilityWeights& Weights)
+{
+	const float Duration = FMath::Max(Info.GetTotalDuration(), UE_KINDA_SMALL_NUMBER);
+	return Weights.DamageWeight * Info.ExpectedDamage / Duration
+		+ Weights.PostureWeight * Info.PostureDamage / Duration
+		- Weights.WindupWeight * Info.WindupDuration
+		- Weights.ParryRiskWeight * Info.ParryWindow;
+}
+
+bool FCompiledComboGraph::SelectMove(
+	int32 Node,
+	bool bComboWindowActive,
+	float TargetDistance,
+	const FComboMoveUtilityWeights& Weights,
+	FComboMoveChoice& OutChoice,
+	const FRandomStream* RandomStream) const
+{
+	OutChoice = FComboMoveChoice();
+
+	if (!Attacks.IsValidIndex(Node))
+	{
+		return false;
+	}
+
+	// Several slots usually resolve to the same attack: score each target once
+	TArray<int32, TInlineAllocator<16>> ScoredTargets;
+	bool bFound = false;
+
+	for (EInputType InputType : { EInputType::LightAttack, EInputType::HeavyAttack })
+	{
+		for (int32 DirIdx = 0; DirIdx < NumDirectionSlots; ++DirIdx)
+		{
+			const EAttackDirection Direction = static_cast<EAttackDirection>(DirIdx);
+			const int32 Slot = GetSlotIndex(InputType, Direction, false, bComboWindowActive);
+			const int32 Target = Transitions[Node * SlotsPerNode + Slot].Target;
+			if (Target == INDEX_NONE || Target == RootNode || ScoredTargets.Contains(Target))
+			{
+				continue;
+			}
+			ScoredTargets.Add(Target);
+
+			const FCompiledComboNodeInfo& Info = NodeInfos[Target];
+			if (TargetDistance >= 0.0f && Info.Reach + Weights.ReachTolerance < TargetDistance)
+			{
+				continue;
+			}
+
+			float Score = ScoreMove(Info, Weights);
+			if (Weights.Variation > 0.0f)
+			{
+				const float Roll = RandomStream ? RandomStream->FRand() : FMath::FRand();
+				Score += FMath::Abs(Score) * Weights.Variation * Roll;
+			}
+
+			if (!bFound || Score > OutChoice.Score)
+			{
+				OutChoice.Node = Target;
+				OutChoice.InputType = InputType;
+				OutChoice.Direction = Direction;
+				OutChoice.Score = Score;
+				bFound = true;
+			}
+		}
+	}
+
+	return bFound;
+}
+
+// ============================================================================
+// RUNTIME RESOLUTION
+// ============================================================================
+
+int32 FCompiledComboGraph::GetSlotIndex(EInputType InputType, EAttackDirection Direction, bool bIsHolding, bool bComboWindowActive)
+{
+	int32 InputSlot = INDEX_NONE;
+	switch (InputType)
+	{
+		case EInputType::LightAttack: InputSlot = 0; break;
+		case EInputType::HeavyAttack: InputSlot = 1; break;
+		default: return INDEX_NONE; // Other input types don't have attacks
+	}
+
+	const int32 DirSlot = FMath::Clamp(static_cast<int32>(Direction), 0, NumDirectionSlots - 1);
+	return ((InputSlot * NumDirectionSlots + DirSlot) * 2 + (bIsHolding ? 1 : 0)) * 2 + (bComboWindowActive ? 1 : 0);
+}
+
+int32 FCompiledComboGraph::FindNode(const UAttackData* Attack) const
+{
+	if (!Attack)
+	{
+		return bIsBuilt ? RootNode : INDEX_NONE;
+	}
+
+	const int32* Found = NodeIndices.Find(Attack);
+	return Found ? *Found : INDEX_NONE;
+}
+
+FAttackResolutionResult FCompiledComboGraph::Resolve(
+	int32 Node,
+	EInputType InputType,
+	EAttackDirection Direction,
+	bool bIsHolding,
+	bool bComboWindowActive) const
+{
+	FAttackResolutionResult Result;
+
+	const int32 Slot = GetSlotIndex(InputType, Direction, bIsHolding, bComboWindowActive);
+	if (Slot == INDEX_NONE || !Attacks.IsValidIndex(Node))
+	{
+		return Result;
+	}
+
+	const FCompiledComboTransition& Transition = Transitions[Node * SlotsPerNode + Slot];
+	if (Transition.Target != INDEX_NONE)
+	{
+		Result.Attack = Attacks[Transition.Target];
+		Result.Path = Transition.Path;
+		Result.bShouldClearDirectionalInput = Transition.bShouldClearDirectionalInput;
+	}
+
+	return Result;
+}
@@ -0,0 +1,268 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatAttackProfiler.h"
+#include "Debug/CombatTrace.h"
+#include "Data/AttackData.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+const TCHAR* LexToString(ECombatAttackCost Cost)
+{
+	switch (Cost)
+	{
+		case ECombatAttackCost::Trace: return TEXT("Trace");
+		case ECombatAttackCost::Notify: return TEXT("Notify");
+		case ECombatAttackCost::Hit: return TEXT("Hit");
+		default: return TEXT("Unknown");
+	}
+}
+
+uint64 FCombatAttackCostStats::GetTotalCycles() const
+{
+	uint64 Total = 0;
+	for (const uint64 CostCycles : Cycles)
+	{
+		Total += CostCycles;
+	}
+	return Total;
+}
+
+FCombatAttackProfiler& FCombatAttackProfiler::Get()
+{
+	static FCombatAttackProfiler Profiler;
+	return Profiler;
+}
+
+void FCombatAttackProfiler::SetEnabled(bool bInEnabled)
+{
+	check(IsInGameThread());
+	bEnabled.store(bInEnabled, std::memory_order_relaxed);
+
+#if CSV_PROFILER
+	// Bound on first use so the profiler costs nothing until someone asks for it
+	if (bInEnabled && !bCsvDelegatesBound)
+	{
+		if (FCsvProfiler* CsvProfiler = FCsvProfiler::Get())
+		{
+			CsvProfiler->OnCSVProfileStart().AddRaw(this, &FCombatAttackProfiler::OnCsvProfileStart);
+			CsvProfiler->OnCSVProfileEnd().AddRaw(this, &FCombatAttackProfiler::OnCsvProfileEnd);
+			bCsvDelegatesBound = true;
+		}
+	}
+#endif
+}
+
+FCombatAttackCostStats& FCombatAttackProfiler::FindOrAddStats(const UAttackData* Attack)
+{
+	FCombatAttackCostStats& Entry = Stats.FindOrAdd(FObjectKey(Attack));
+	if (Entry.AttackName.IsEmpty())
+	{
+		Entry.AttackName = Attack->GetPathName();
+	}
+	return Entry;
+}
+
+void FCombatAttackProfiler::AddSwing(const UAttackData* Attack)
+{
+	if (Attack && IsEnabled())
+	{
+		++FindOrAddStats(Attack).NumSwings;
+	}
+}
+
+void FCombatAttackProfiler::AddCost(const UAttackData* Attack, ECombatAttackCost Cost, uint64 Cycles, int32 NumSweeps)
+{
+	if (!Attack || Cost >= ECombatAttackCost::Count)
+	{
+		return;
+	}
+
+	FCombatAttackCostStats& Entry = FindOrAddStats(Attack);
+	Entry.Cycles[static_cast<int32>(Cost)] += Cycles;
+	++Entry.NumCalls[static_cast<int32>(Cost)];
+	Entry.NumSweeps += NumSweeps;
+}
+
+void FCombatAttackProfiler::SetScopeAttack(const UAttackData* Attack)
+{
+	if (CurrentScope && !CurrentScope->Attack)
+	{
+		CurrentScope->Attack = Attack;
+	}
+}
+
+void FCombatAttackProfiler::AddScopeSweeps(int32 NumSweeps)
+{
+	if (CurrentScope)
+	{
+		CurrentScope->NumSweeps += NumSweeps;
+	}
+}
+
+const FCombatAttackCostStats* FCombatAttackProfiler::FindStats(const UAttackData* Attack) const
+{
+	return Attack ? Stats.Find(FObjectKey(Attack)) : nullptr;
+}
+
+void FCombatAttackProfiler::GetStats(TArray<FCombatAttackCostStats>& OutStats) const
+{
+	Stats.GenerateValueArray(OutStats);
+	OutStats.Sort([](const FCombatAttackCostStats& A, const FCombatAttackCostStats& B)
+	{
+		return A.GetTotalCycles() > B.GetTotalCycles();
+	});
+}
+
+void FCombatAttackProfiler::Reset()
+{
+	Stats.Reset();
+}
+
+void FCombatAttackProfiler::LogReport(int32 MaxRows) const
+{
+	TArray<FCombatAttackCostStats> Rows;
+	GetStats(Rows);
+
+	UE_LOG(LogCombat, Log, TEXT("[AttackProfiler] %d attacks%s"), Rows.Num(), IsEnabled() ? TEXT("") : TEXT(" (stopped)"));
+	UE_LOG(LogCombat, Log, TEXT("  %-40s %6s %9s %9s %8s %9s %6s %9s %6s %9s"),
+		TEXT("Attack"), TEXT("Swings"), TEXT("Total ms"), TEXT("Trace ms"), TEXT("Sweeps"), TEXT("Notify ms"), TEXT("Count"), TEXT("Hit ms"), TEXT("Count"), TEXT("us/swing"));
+
+	const int32 NumRows = MaxRows > 0 ? FMath::Min(MaxRows, Rows.Num()) : Rows.Num();
+	for (int32 Index = 0; Index < NumRows; ++Index)
+	{
+		const FCombatAttackCostStats& Row = Rows[Index];
+		const double TotalMs = FPlatformTime::ToMilliseconds64(Row.GetTotalCycles());
+		UE_LOG(LogCombat, Log, TEXT("  %-40s %6d %9.3f %9.3f %8lld %9.3f %6lld %9.3f %6lld %9.1f"),
+			*FPaths::GetBaseFilename(Row.AttackName), Row.NumSwings, TotalMs,
+			FPlatformTime::ToMilliseconds64(Row.GetCycles(ECombatAttackCost::Trace)), Row.NumSweeps,
+			FPlatformTime::ToMilliseconds64(Row.GetCycles(ECombatAttackCost::Notify)), Row.GetNumCalls(ECombatAttackCost::Notify),
+			FPlatformTime::ToMilliseconds64(Row.GetCycles(ECombatAttackCost::Hit)), Row.GetNumCalls(ECombatAttackCost::Hit),
+			Row.NumSwings > 0 ? TotalMs * 1000.0 / Row.NumSwings : 0.0);
+	}
+}
+
+bool FCombatAttackProfiler::ExportToCSV(const FString& FilePath) const
+{
+	TArray<FCombatAttackCostStats> Rows;
+	GetStats(Rows);
+
+	FString Csv = TEXT("Attack,Swings,TotalMs,TraceMs,TracedFrames,Sweeps,NotifyMs,Notifies,HitMs,Hits,MsPerSwing,SweepsPerSwing\n");
+	for (const FCombatAttackCostStats& Row : Rows)
+	{
+		const double TotalMs = FPlatformTime::ToMilliseconds64(Row.GetTotalCycles());
+		const double PerSwing = Row.NumSwings > 0 ? 1.0 / Row.NumSwings : 0.0;
+		Csv += FString::Printf(TEXT("%s,%d,%.4f,%.4f,%lld,%lld,%.4f,%lld,%.4f,%lld,%.4f,%.2f\n"),
+			*Row.AttackName, Row.NumSwings, TotalMs,
+			FPlatformTime::ToMilliseconds64(Row.GetCycles(ECombatAttackCost::Trace)), Row.GetNumCalls(ECombatAttackCost::Trace), Row.NumSweeps,
+			FPlatformTime::ToMilliseconds64(Row.GetCycles(ECombatAttackCost::Notify)), Row.GetNumCalls(ECombatAttackCost::Notify),
+			FPlatformTime::ToMilliseconds64(Row.GetCycles(ECombatAttackCost::Hit)), Row.GetNumCalls(ECombatAttackCost::Hit),
+			TotalMs * PerSwing, Row.NumSweeps * PerSwing);
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
+
+void FCombatAttackProfiler::OnCsvProfileStart()
+{
+	// The table covers the same frames as the capture
+	if (IsEnabled())
+	{
+		Reset();
+	}
+}
+
+void FCombatAttackProfiler::OnCsvProfileEnd()
+{
+#if CSV_PROFILER
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	const FString CsvFilePath = FCsvProfiler::Get()->GetOutputFilename();
+	const FString FilePath = CsvFilePath.IsEmpty()
+		? FPaths::ProjectSavedDir() / TEXT("Combat") / FString::Printf(TEXT("AttackProfile_%s.csv"), *FDateTime::Now().ToString())
+		: FPaths::ChangeExtension(CsvFilePath, TEXT("attacks.csv"));
+
+	if (ExportToCSV(FilePath))
+	{
+		UE_LOG(LogCombat, Log, TEXT("[AttackProfiler] Wrote %d attacks for the CSV profile to %s"), Stats.Num(), *FilePath);
+	}
+#endif
+}
+
+void FCombatAttackProfileScope::Begin()
+{
+	FCombatAttackProfiler& Profiler = FCombatAttackProfiler::Get();
+	Parent = Profiler.CurrentScope;
+	Profiler.CurrentScope = this;
+	StartCycles = FPlatformTime::Cycles64();
+}
+
+void FCombatAttackProfileScope::End()
+{
+	const uint64 Elapsed = FPlatformTime::Cycles64() - StartCycles;
+
+	FCombatAttackProfiler& Profiler = FCombatAttackProfiler::Get();
+	Profiler.CurrentScope = Parent;
+
+	// Exclusive time: whatever the nested scopes took is theirs
+	Profiler.AddCost(Attack, Cost, Elapsed > ChildCycles ? Elapsed - ChildCycles : 0, NumSweeps);
+	if (Parent)
+	{
+		Parent->ChildCycles += Elapsed;
+	}
+	else
+	{
+		CSV_CUSTOM_STAT(KatanaCombat, AttackProfileMs, FPlatformTime::ToMilliseconds64(Elapsed), ECsvCustomStatOp::Accumulate);
+	}
+}
+
+static FAutoConsoleCommand GCombatAttackProfileStartCommand(
+	TEXT("Combat.AttackProfile.Start"),
+	TEXT("Start attributing weapon trace, notify and hit processing time to attacks (keeps the current table; Combat.AttackProfile.Reset clears it)"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FCombatAttackProfiler::Get().SetEnabled(true);
+		UE_LOG(LogCombat, Log, TEXT("[AttackProfiler] Started"));
+	}));
+
+static FAutoConsoleCommand GCombatAttackProfileStopCommand(
+	TEXT("Combat.AttackProfile.Stop"),
+	TEXT("Stop attributing combat time to attacks (the table is kept for Combat.AttackProfile.Dump)"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FCombatAttackProfiler::Get().SetEnabled(false);
+		UE_LOG(LogCombat, Log, TEXT("[AttackProfiler] Stopped"));
+	}));
+
+static FAutoConsoleCommand GCombatAttackProfileResetCommand(
+	TEXT("Combat.AttackProfile.Reset"),
+	TEXT("Clear the per-attack cost table"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FCombatAttackProfiler::Get().Reset();
+	}));
+
+static FAutoConsoleCommand GCombatAttackProfileDumpCommand(
+	TEXT("Combat.AttackProfile.Dump"),
+	TEXT("Log per-attack combat cost, most expensive first, and write it as CSV. Optional argument: output path (default Saved/Combat/AttackProfile_<time>.csv)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FCombatAttackProfiler& Profiler = FCombatAttackProfiler::Get();
+		Profiler.LogReport();
+
+		const FString FilePath = Args.Num() > 0
+			? Args[0]
+			: FPaths::ProjectSavedDir() / TEXT("Combat") / FString::Printf(TEXT("AttackProfile_%s.csv"), *FDateTime::Now().ToString());
+
+		if (Profiler.ExportToCSV(FilePath))
+		{
+			UE_LOG(LogCombat, Log, TEXT("[AttackProfiler] Wrote %d attacks to %s"), Profiler.GetNumAttacks(), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[AttackProfiler] Failed to write %s"), *FilePath);
+		}
+	}));
@@ -0,0 +1,614 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatBenchmarkDirector.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatCapture.h"
+#include "Characters/SamuraiCharacter.h"
+#include "Core/AIDefenseComponent.h"
+#include "Camera/CameraActor.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+ACombatBenchmarkDirector::ACombatBenchmarkDirector()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	FighterClass = ASamuraiCharacter::StaticClass();
+}
+
+void ACombatBenchmarkDirector::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bAutoStart)
+	{
+		StartBenchmark();
+	}
+}
+
+void ACombatBenchmarkDirector::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+#if CSV_PROFILER
+	if (bStartedCsvCapture)
+	{
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+	bStartedCsvCapture = false;
+
+	Cleanup();
+	RestoreTimeStep();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+// ============================================================================
+// RUN
+// ============================================================================
+
+void ACombatBenchmarkDirector::StartBenchmark()
+{
+	if (IsRunning() || !FighterClass)
+	{
+		return;
+	}
+
+	// AI defense rolls use the global stream; seed it so every run plays the same fight
+	FMath::RandInit(RandomSeed);
+
+	ReplayStreams.Reset();
+	if (!ReplayCapturePath.IsEmpty() && !LoadReplayCapture())
+	{
+		return;
+	}
+
+	ElapsedTime = 0.0f;
+	FrameTimesMs.Reset();
+	GameThreadTimeSumMs = 0.0;
+	CsvFileName.Reset();
+
+	SpawnDuels();
+	SpawnCamera();
+
+	// Replays: same step every frame, so the recorded inputs land on the same frames in every build
+	if (ReplayStreams.Num() > 0 && !bAppliedFixedTimeStep)
+	{
+		bSavedUseFixedTimeStep = FApp::UseFixedTimeStep();
+		SavedFixedDeltaTime = FApp::GetFixedDeltaTime();
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(ReplayFixedTimeStep);
+		bAppliedFixedTimeStep = true;
+	}
+
+	Phase = EPhase::Warmup;
+	SetActorTickEnabled(true);
+
+	if (ReplayStreams.Num() > 0)
+	{
+		UE_LOG(LogCombat, Log, TEXT("[CombatBenchmark] Started replay of %s: %d fighters on %d streams, %.0fs warm-up, %.0fs capture, %.4fs steps"),
+			*ReplayCapturePath, Fighters.Num(), ReplayStreams.Num(), WarmupTime, Duration, ReplayFixedTimeStep);
+	}
+	else
+	{
+		UE_LOG(LogCombat, Log, TEXT("[CombatBenchmark] Started: %d fighters, %.0fs warm-up, %.0fs capture, seed %d"), Fighters.Num(), WarmupTime, Duration, RandomSeed);
+	}
+}
+
+bool ACombatBenchmarkDirector::LoadReplayCapture()
+{
+	FCombatCaptureReader Reader;
+	if (!Reader.Open(ReplayCapturePath))
+	{
+		UE_LOG(LogCombat, Warning, TEXT("[CombatBenchmark] Could not read capture %s"), *ReplayCapturePath);
+		return false;
+	}
+
+	TArray<FString> OwnerNames;
+	FCombatReplayStream::FromCapture(Reader, ReplayStreams, &OwnerNames);
+	ReplayStreams.RemoveAll([](const FCombatReplayStream& Stream) { return Stream.IsEmpty(); });
+	if (ReplayStreams.Num() == 0)
+	{
+		UE_LOG(LogCombat, Warning, TEXT("[CombatBenchmark] Capture %s has no recorded inputs"), *ReplayCapturePath);
+		return false;
+	}
+
+	UE_LOG(LogCombat, Log, TEXT("[CombatBenchmark] Loaded %d input streams from %s (%s)"), ReplayStreams.Num(), *ReplayCapturePath, *FString::Join(OwnerNames, TEXT(", ")));
+	return true;
+}
+
+void ACombatBenchmarkDirector::RestoreTimeStep()
+{
+	if (bAppliedFixedTimeStep)
+	{
+		FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+		FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+		bAppliedFixedTimeStep = false;
+	}
+}
+
+void ACombatBenchmarkDirector::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	ElapsedTime += DeltaSeconds;
+
+	for (FFighter& Fighter : Fighters)
+	{
+		if (Fighter.ReplayStream != INDEX_NONE)
+		{
+			DriveReplayFighter(Fighter);
+		}
+		else
+		{
+			DriveFighter(Fighter);
+		}
+	}
+	UpdateCamera();
+
+	if (Phase == EPhase::Warmup)
+	{
+		if (ElapsedTime >= WarmupTime)
+		{
+			BeginCapture();
+		}
+		return;
+	}
+
+	// undilated frame time, so hit stop doesn't skew the numbers (wall clock under a fixed timestep)
+	const double NowSeconds = FPlatformTime::Seconds();
+	FrameTimesMs.Add(bAppliedFixedTimeStep ? (NowSeconds - LastFrameSeconds) * 1000.0 : FApp::GetDeltaTime() * 1000.0);
+	LastFrameSeconds = NowSeconds;
+	GameThreadTimeSumMs += FPlatformTime::ToMilliseconds(GGameThreadTime);
+
+	if (ElapsedTime >= WarmupTime + Duration)
+	{
+		FinishBenchmark();
+	}
+}
+
+void ACombatBenchmarkDirector::SpawnDuels()
+{
+	UWorld* World = GetWorld();
+	const int32 Columns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumDuels)));
+	const FVector GridOrigin = GetActorLocation() - FVector(Columns - 1, Columns - 1, 0.0f) * DuelSpacing * 0.5f;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	for (int32 Duel = 0; Duel < NumDuels; ++Duel)
+	{
+		const FVector DuelCenter = GridOrigin + FVector(Duel % Columns, Duel / Columns, 0.0f) * DuelSpacing;
+
+		for (int32 Side = 0; Side < 2; ++Side)
+		{
+			const FVector Offset(Side == 0 ? -DuelDistance * 0.5f : DuelDistance * 0.5f, 0.0f, 0.0f);
+			const FRotator Facing(0.0f, Side == 0 ? 0.0f : 180.0f, 0.0f);
+
+			ASamuraiCharacter* Character = World->SpawnActor<ASamuraiCharacter>(FighterClass, DuelCenter + Offset, Facing, SpawnParams);
+			if (!Character)
+			{
+				continue;
+			}
+
+			if (!Character->GetController())
+			{
+				Character->SpawnDefaultController();
+			}
+
+			// Defend against each other, not just the player. Replays already carry the recorded blocks and parries
+			UAIDefenseComponent* Defense = Character->FindComponentByClass<UAIDefenseComponent>();
+			if (!Defense && ReplayStreams.Num() == 0)
+			{
+				Defense = NewObject<UAIDefenseComponent>(Character);
+				Character->AddInstanceComponent(Defense);
+				Defense->RegisterComponent();
+			}
+			if (Defense)
+			{
+				Defense->bOnlyDefendAgainstPlayers = false;
+				Defense->bDefenseEnabled = ReplayStreams.Num() == 0;
+			}
+
+			FFighter& Fighter = Fighters.AddDefaulted_GetRef();
+			Fighter.Character = Character;
+			Fighter.Stream.Initialize(RandomSeed + Duel * 2 + Side);
+			Fighter.NextActionTime = Fighter.Stream.FRandRange(0.0f, 1.0f);
+			Fighter.ReplayStream = ReplayStreams.Num() > 0 ? (Fighters.Num() - 1) % ReplayStreams.Num() : INDEX_NONE;
+		}
+	}
+}
+
+void ACombatBenchmarkDirector::DriveFighter(FFighter& Fighter)
+{
+	ASamuraiCharacter* Character = Fighter.Character.Get();
+	if (!Character)
+	{
+		return;
+	}
+
+	if (Fighter.HeldInput != EInputType::None && ElapsedTime >= Fighter.ReleaseTime)
+	{
+		Character->SubmitCombatInput(Fighter.HeldInput, EInputEventType::Release, EInputDirection::Forward);
+		Fighter.HeldInput = EInputType::None;
+	}
+
+	if (Fighter.HeldInput != EInputType::None || ElapsedTime < Fighter.NextActionTime)
+	{
+		return;
+	}
+
+	// Offense only: light combo taps, held heavies and pauses. Blocks and parries come from UAIDefenseComponent
+	const float Roll = Fighter.Stream.FRand();
+	if (Roll < 0.6f)
+	{
+		Fighter.HeldInput = EInputType::LightAttack;
+		Fighter.ReleaseTime = ElapsedTime + 0.08f;
+		Fighter.NextActionTime = ElapsedTime + Fighter.Stream.FRandRange(0.35f, 0.6f);
+	}
+	else if (Roll < 0.85f)
+	{
+		Fighter.HeldInput = EInputType::HeavyAttack;
+		Fighter.ReleaseTime = ElapsedTime + Fighter.Stream.FRandRange(0.2f, 0.9f);
+		Fighter.NextActionTime = Fighter.ReleaseTime + 0.8f;
+	}
+	else
+	{
+		Fighter.NextActionTime = ElapsedTime + Fighter.Stream.FRandRange(0.5f, 1.0f);
+		return;
+	}
+
+	Character->SubmitCombatInput(Fighter.HeldInput, EInputEventType::Press, EInputDirection::Forward);
+}
+
+void ACombatBenchmarkDirector::DriveReplayFighter(FFighter& Fighter)
+{
+	ASamuraiCharacter* Character = Fighter.Character.Get();
+	if (!Character)
+	{
+		return;
+	}
+
+	const FCombatReplayStream& Stream = ReplayStreams[Fighter.ReplayStream];
+
+	// Stream played out: let go of anything the capture ended on and loop after the gap
+	if (Fighter.NextReplayInput >= Stream.Inputs.Num() && ElapsedTime >= Fighter.ReplayLoopStart + Stream.Duration + ReplayLoopGap)
+	{
+		for (uint32 Held = Fighter.HeldReplayInputs; Held != 0; Held &= Held - 1)
+		{
+			Character->SubmitCombatInput(static_cast<EInputType>(FMath::CountTrailingZeros(Held)), EInputEventType::Release);
+		}
+		Fighter.HeldReplayInputs = 0;
+		Fighter.NextReplayInput = 0;
+		Fighter.ReplayLoopStart = ElapsedTime;
+	}
+
+	const float StreamTime = ElapsedTime - Fighter.ReplayLoopStart;
+	while (Fighter.NextReplayInput < Stream.Inputs.Num() && Stream.Inputs[Fighter.NextReplayInput].Time <= StreamTime)
+	{
+		const FCombatReplayInput& Input = Stream.Inputs[Fighter.NextReplayInput++];
+		Character->SubmitCombatInput(Input.InputType, Input.EventType, Input.Direction);
+
+		const uint32 InputBit = 1u << static_cast<uint32>(Input.InputType);
+		Fighter.HeldReplayInputs = Input.EventType == EInputEventType::Press ? (Fighter.HeldReplayInputs | InputBit) : (Fighter.HeldReplayInputs & ~InputBit);
+	}
+}
+
+void ACombatBenchmarkDirector::SpawnCamera()
+{
+	BenchmarkCamera = GetWorld()->SpawnActor<ACameraActor>(GetActorLocation(), FRotator::ZeroRotator);
+	UpdateCamera();
+
+	if (APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+	{
+		PlayerController->SetViewTarget(BenchmarkCamera);
+	}
+}
+
+void ACombatBenchmarkDirector::UpdateCamera()
+{
+	if (!BenchmarkCamera)
+	{
+		return;
+	}
+
+	const float Angle = 2.0f * PI * ElapsedTime / CameraOrbitPeriod;
+	const FVector Center = GetActorLocation();
+	const FVector Location = Center + FVector(FMath::Cos(Angle) * CameraOrbitRadius, FMath::Sin(Angle) * CameraOrbitRadius, CameraHeight);
+
+	BenchmarkCamera->SetActorLocationAndRotation(Location, (Center - Location).Rotation());
+}
+
+void ACombatBenchmarkDirector::BeginCapture()
+{
+	Phase = EPhase::Capture;
+	FrameTimesMs.Reserve(FMath::CeilToInt(Duration * 120.0f));
+	LastFrameSeconds = FPlatformTime::Seconds();
+
+	for (int32 Index = 0; Index < static_cast<int32>(ECombatBudgetCategory::Count); ++Index)
+	{
+		CaptureStartCycles[Index] = CombatBudget::GetTotalCycles(static_cast<ECombatBudgetCategory>(Index));
+	}
+	CaptureStartQueries = CombatBudget::GetTotalPhysicsQueries();
+
+#if CSV_PROFILER
+	// don't hijack a capture someone else started (-csvCaptureFrames etc.), just add our metadata to it
+	if (bRecordCsvProfile && !FCsvProfiler::Get()->IsCapturing())
+	{
+		const FString RunName = ReplayStreams.Num() > 0 ? TEXT("CombatReplay_") + FPaths::GetBaseFilename(ReplayCapturePath) : TEXT("CombatBenchmark");
+		CsvFileName = FString::Printf(TEXT("%s_%s_%dx2_%s.csv"), *RunName, ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()), NumDuels, *FDateTime::Now().ToString());
+		FCsvProfiler::Get()->BeginCapture(-1, FString(), CsvFileName);
+		bStartedCsvCapture = true;
+	}
+#endif
+
+	CSV_METADATA(TEXT("CombatBenchmarkFighters"), *FString::FromInt(Fighters.Num()));
+	CSV_METADATA(TEXT("CombatBenchmarkSeed"), *FString::FromInt(RandomSeed));
+	CSV_METADATA(TEXT("CombatBenchmarkMap"), *GetWorld()->GetMapName());
+	if (ReplayStreams.Num() > 0)
+	{
+		CSV_METADATA(TEXT("CombatBenchmarkCapture"), *FPaths::GetCleanFilename(ReplayCapturePath));
+	}
+}
+
+void ACombatBenchmarkDirector::FinishBenchmark()
+{
+#if CSV_PROFILER
+	if (bStartedCsvCapture)
+	{
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+	bStartedCsvCapture = false;
+
+	FCombatBenchmarkResult Result;
+	Result.NumFighters = Fighters.Num();
+	Result.NumFrames = FrameTimesMs.Num();
+	Result.Duration = Duration;
+	Result.CsvFileName = CsvFileName;
+	Result.CapturePath = ReplayStreams.Num() > 0 ? ReplayCapturePath : FString();
+
+	if (FrameTimesMs.Num() > 0)
+	{
+		double Sum = 0.0;
+		for (const float FrameMs : FrameTimesMs)
+		{
+			Sum += FrameMs;
+		}
+
+		TArray<float> Sorted = FrameTimesMs;
+		Sorted.Sort();
+
+		Result.AvgFrameMs = Sum / Sorted.Num();
+		Result.P95FrameMs = Sorted[FMath::Min(FMath::FloorToInt(Sorted.Num() * 0.95f), Sorted.Num() - 1)];
+		Result.MaxFrameMs = Sorted.Last();
+		Result.AvgGameThreadMs = GameThreadTimeSumMs / Sorted.Num();
+
+		for (int32 Index = 0; Index < static_cast<int32>(ECombatBudgetCategory::Count); ++Index)
+		{
+			const uint64 Cycles = CombatBudget::GetTotalCycles(static_cast<ECombatBudgetCategory>(Index)) - CaptureStartCycles[Index];
+			Result.AvgSystemMs[Index] = FPlatformTime::ToMilliseconds64(Cycles) / Sorted.Num();
+		}
+		Result.AvgPhysicsQueries = static_cast<double>(CombatBudget::GetTotalPhysicsQueries() - CaptureStartQueries) / Sorted.Num();
+	}
+
+	UE_LOG(LogCombat, Log, TEXT("[CombatBenchmark] Finished: %d fighters, %d frames, frame avg %.2fms p95 %.2fms max %.2fms, game thread avg %.2fms"),
+		Result.NumFighters, Result.NumFrames, Result.AvgFrameMs, Result.P95FrameMs, Result.MaxFrameMs, Result.AvgGameThreadMs);
+	UE_LOG(LogCombat, Log, TEXT("[CombatBenchmark] Combat per frame: traces %.3fms, targeting %.3fms, queue %.3fms, anim %.3fms, %.1f physics queries"),
+		Result.AvgSystemMs[static_cast<int32>(ECombatBudgetCategory::Traces)], Result.AvgSystemMs[static_cast<int32>(ECombatBudgetCategory::Targeting)],
+		Result.AvgSystemMs[static_cast<int32>(ECombatBudgetCategory::Queue)], Result.AvgSystemMs[static_cast<int32>(ECombatBudgetCategory::Anim)], Result.AvgPhysicsQueries);
+
+	AppendReport(Result);
+	Cleanup();
+	RestoreTimeStep();
+
+	OnBenchmarkFinishedNative.Broadcast(Result);
+}
+
+void ACombatBenchmarkDirector::Cleanup()
+{
+	Phase = EPhase::Idle;
+	SetActorTickEnabled(false);
+
+	for (const FFighter& Fighter : Fighters)
+	{
+		if (ASamuraiCharacter* Character = Fighter.Character.Get())
+		{
+			if (AController* Controller = Character->GetController())
+			{
+				Controller->Destroy();
+			}
+			Character->Destroy();
+		}
+	}
+	Fighters.Reset();
+
+	if (BenchmarkCamera)
+	{
+		APlayerController* PlayerController = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+		if (PlayerController && PlayerController->GetViewTarget() == BenchmarkCamera && PlayerController->GetPawn())
+		{
+			PlayerController->SetViewTarget(PlayerController->GetPawn());
+		}
+
+		BenchmarkCamera->Destroy();
+		BenchmarkCamera = nullptr;
+	}
+}
+
+// ============================================================================
+// REPORT
+// ============================================================================
+
+FString ACombatBenchmarkDirector::GetReportPath()
+{
+	return FPaths::ProfilingDir() / TEXT("CombatBenchmark") / TEXT("CombatBenchmarkReport.csv");
+}
+
+FString ACombatBenchmarkDirector::GetReplayReportPath()
+{
+	return FPaths::ProfilingDir() / TEXT("CombatBenchmark") / TEXT("CombatReplayReport.csv");
+}
+
+void ACombatBenchmarkDirector::AppendReport(const FCombatBenchmarkResult& Result) const
+{
+	// Replays keep their own report: rows only compare against runs of the same capture
+	if (!Result.CapturePath.IsEmpty())
+	{
+		AppendReplayReport(Result);
+		return;
+	}
+
+	const FString ReportPath = GetReportPath();
+
+	FString Row;
+	if (!IFileManager::Get().FileExists(*ReportPath))
+	{
+		Row += TEXT("Timestamp,BuildVersion,Changelist,Platform,Configuration,Map,Fighters,Seed,Duration,Frames,AvgFrameMs,P95FrameMs,MaxFrameMs,AvgGameThreadMs,CsvFile\n");
+	}
+
+	Row += FString::Printf(TEXT("%s,%s,%u,%s,%s,%s,%d,%d,%.1f,%d,%.3f,%.3f,%.3f,%.3f,%s\n"),
+		*FDateTime::Now().ToIso8601(),
+		FApp::GetBuildVersion(),
+		FEngineVersion::Current().GetChangelist(),
+		ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()),
+		LexToString(FApp::GetBuildConfiguration()),
+		*GetWorld()->GetMapName(),
+		Result.NumFighters,
+		RandomSeed,
+		Result.Duration,
+		Result.NumFrames,
+		Result.AvgFrameMs,
+		Result.P95FrameMs,
+		Result.MaxFrameMs,
+		Result.AvgGameThreadMs,
+		*Result.CsvFileName);
+
+	if (FFileHelper::SaveStringToFile(Row, *ReportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogCombat, Log, TEXT("[CombatBenchmark] Report: %s"), *ReportPath);
+	}
+}
+
+void ACombatBenchmarkDirector::AppendReplayReport(const FCombatBenchmarkResult& Result) const
+{
+	static_assert(static_cast<int32>(ECombatBudgetCategory::Count) == 4, "Replay report columns list every budget category");
+
+	const FString ReportPath = GetReplayReportPath();
+
+	FString Row;
+	if (!IFileManager::Get().FileExists(*ReportPath))
+	{
+		Row += TEXT("Timestamp,BuildVersion,Changelist,Platform,Configuration,Map,Capture,Fighters,Streams,Duration,Frames,AvgFrameMs,P95FrameMs,MaxFrameMs,AvgGameThreadMs,TracesMs,TargetingMs,QueueMs,AnimMs,PhysicsQueries,CsvFile\n");
+	}
+
+	Row += FString::Printf(TEXT("%s,%s,%u,%s,%s,%s,%s,%d,%d,%.1f,%d,%.3f,%.3f,%.3f,%.3f,%.4f,%.4f,%.4f,%.4f,%.2f,%s\n"),
+		*FDateTime::Now().ToIso8601(),
+		FApp::GetBuildVersion(),
+		FEngineVersion::Current().GetChangelist(),
+		ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()),
+		LexToString(FApp::GetBuildConfiguration()),
+		*GetWorld()->GetMapName(),
+		*FPaths::GetCleanFilename(Result.CapturePath),
+		Result.NumFighters,
+		ReplayStreams.Num(),
+		Result.Duration,
+		Result.NumFrames,
+		Result.AvgFrameMs,
+		Result.P95FrameMs,
+		Result.MaxFrameMs,
+		Result.AvgGameThreadMs,
+		Result.AvgSystemMs[static_cast<int32>(ECombatBudgetCategory::Traces)],
+		Result.AvgSystemMs[static_cast<int32>(ECombatBudgetCategory::Targeting)],
+		Result.AvgSystemMs[static_cast<int32>(ECombatBudgetCategory::Queue)],
+		Result.AvgSystemMs[static_cast<int32>(ECombatBudgetCategory::Anim)],
+		Result.AvgPhysicsQueries,
+		*Result.CsvFileName);
+
+	if (FFileHelper::SaveStringToFile(Row, *ReportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogCombat, Log, TEXT("[CombatBenchmark] Replay report: %s"), *ReportPath);
+	}
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatBenchmarkCommand(
+	TEXT("Combat.Benchmark"),
+	TEXT("Run the combat benchmark at the player's location. Optional arguments: duels (default 8), capture seconds (default 60)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || !World->IsGameWorld())
+		{
+			return;
+		}
+
+		const APlayerController* PlayerController = World->GetFirstPlayerController();
+		const FVector Location = PlayerController && PlayerController->GetPawn() ? PlayerController->GetPawn()->GetActorLocation() : FVector::ZeroVector;
+
+		ACombatBenchmarkDirector* Director = World->SpawnActorDeferred<ACombatBenchmarkDirector>(ACombatBenchmarkDirector::StaticClass(), FTransform(Location));
+		if (!Director)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0)
+		{
+			Director->NumDuels = FMath::Clamp(FCString::Atoi(*Args[0]), 1, 128);
+		}
+		if (Args.Num() > 1)
+		{
+			Director->Duration = FMath::Max(FCString::Atof(*Args[1]), 1.0f);
+		}
+		Director->bAutoStart = true;
+
+		// one-shot: the director goes away with its fight
+		Director->OnBenchmarkFinishedNative.AddWeakLambda(Director, [Director](const FCombatBenchmarkResult&) { Director->SetLifeSpan(0.1f); });
+		Director->FinishSpawning(FTransform(Location));
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatBenchmarkReplayCommand(
+	TEXT("Combat.Benchmark.Replay"),
+	TEXT("Benchmark a combat capture: fighters replay its recorded inputs with the perf stats enabled. Arguments: capture path (.kcap), optional duels (default 8), capture seconds (default 60)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || !World->IsGameWorld() || Args.Num() == 0)
+		{
+			return;
+		}
+
+		const APlayerController* PlayerController = World->GetFirstPlayerController();
+		const FVector Location = PlayerController && PlayerController->GetPawn() ? PlayerController->GetPawn()->GetActorLocation() : FVector::ZeroVector;
+
+		ACombatBenchmarkDirector* Director = World->SpawnActorDeferred<ACombatBenchmarkDirector>(ACombatBenchmarkDirector::StaticClass(), FTransform(Location));
+		if (!Director)
+		{
+			return;
+		}
+
+		Director->ReplayCapturePath = Args[0];
+		if (Args.Num() > 1)
+		{
+			Director->NumDuels = FMath::Clamp(FCString::Atoi(*Args[1]), 1, 128);
+		}
+		if (Args.Num() > 2)
+		{
+			Director->Duration = FMath::Max(FCString::Atof(*Args[2]), 1.0f);
+		}
+		Director->bAutoStart = true;
+
+		// one-shot: the director goes away with its fight
+		Director->OnBenchmarkFinishedNative.AddWeakLambda(Director, [Director](const FCombatBenchmarkResult&) { Director->SetLifeSpan(0.1f); });
+		Director->FinishSpawning(FTransform(Location));
+	}));
\ No newline at end of file
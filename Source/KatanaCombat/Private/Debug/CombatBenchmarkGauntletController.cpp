@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatBenchmarkGauntletController.h"
+#include "Debug/CombatBenchmarkDirector.h"
+#include "Debug/CombatTrace.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CommandLine.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+
+void UCombatBenchmarkGauntletController::OnInit()
+{
+	Super::OnInit();
+
+	FParse::Value(FCommandLine::Get(), TEXT("CombatBenchmarkMap="), BenchmarkMap);
+	FParse::Value(FCommandLine::Get(), TEXT("CombatBenchmarkTimeout="), TimeoutSeconds);
+
+	UE_LOG(LogCombat, Log, TEXT("[CombatBenchmark] Gauntlet controller initialized (map: %s)"), BenchmarkMap.IsEmpty() ? TEXT("startup map") : *BenchmarkMap);
+}
+
+void UCombatBenchmarkGauntletController::OnPostMapChange(UWorld* World)
+{
+	Super::OnPostMapChange(World);
+
+	// Travelled away mid-run (crash recovery, seamless travel): the director went with the old world
+	if (bStarted && !Director.IsValid())
+	{
+		UE_LOG(LogCombat, Error, TEXT("[CombatBenchmark] Map changed during the run"));
+		EndTest(1);
+	}
+}
+
+void UCombatBenchmarkGauntletController::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	TimeRunning += TimeDelta;
+	if (TimeRunning > TimeoutSeconds)
+	{
+		UE_LOG(LogCombat, Error, TEXT("[CombatBenchmark] Timed out after %.0fs"), TimeoutSeconds);
+		EndTest(1);
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (bStarted || !World || !World->HasBegunPlay())
+	{
+		return;
+	}
+
+	// Load the benchmark level first if the client started elsewhere
+	if (!BenchmarkMap.IsEmpty() && !GetCurrentMap().Equals(FPackageName::GetShortName(BenchmarkMap), ESearchCase::IgnoreCase))
+	{
+		if (!bMapRequested)
+		{
+			bMapRequested = true;
+			UGameplayStatics::OpenLevel(World, FName(*BenchmarkMap));
+		}
+		return;
+	}
+
+	StartBenchmark(World);
+}
+
+void UCombatBenchmarkGauntletController::StartBenchmark(UWorld* World)
+{
+	bStarted = true;
+
+	// A director placed in the level carries its tuned layout; otherwise use defaults at the origin
+	TActorIterator<ACombatBenchmarkDirector> It(World);
+	ACombatBenchmarkDirector* FoundDirector = It ? *It : World->SpawnActor<ACombatBenchmarkDirector>(FVector::ZeroVector, FRotator::ZeroRotator);
+	if (!FoundDirector)
+	{
+		UE_LOG(LogCombat, Error, TEXT("[CombatBenchmark] Could not spawn a benchmark director"));
+		EndTest(1);
+		return;
+	}
+
+	FParse::Value(FCommandLine::Get(), TEXT("CombatBenchmarkDuels="), FoundDirector->NumDuels);
+	FParse::Value(FCommandLine::Get(), TEXT("CombatBenchmarkDuration="), FoundDirector->Duration);
+	FParse::Value(FCommandLine::Get(), TEXT("CombatBenchmarkWarmup="), FoundDirector->WarmupTime);
+	FParse::Value(FCommandLine::Get(), TEXT("CombatBenchmarkSeed="), FoundDirector->RandomSeed);
+	FParse::Value(FCommandLine::Get(), TEXT("CombatBenchmarkReplay="), FoundDirector->ReplayCapturePath);
+
+	// The director won't start on a missing capture, don't wait out the timeout for it
+	if (!FoundDirector->ReplayCapturePath.IsEmpty() && !FPaths::FileExists(FoundDirector->ReplayCapturePath))
+	{
+		UE_LOG(LogCombat, Error, TEXT("[CombatBenchmark] Capture %s not found"), *FoundDirector->ReplayCapturePath);
+		EndTest(1);
+		return;
+	}
+
+	Director = FoundDirector;
+	FoundDirector->OnBenchmarkFinishedNative.AddUObject(this, &UCombatBenchmarkGauntletController::OnBenchmarkFinished);
+
+	// Placed directors may already be running from bAutoStart
+	FoundDirector->StartBenchmark();
+}
+
+void UCombatBenchmarkGauntletController::OnBenchmarkFinished(const FCombatBenchmarkResult& Result)
+{
+	const bool bReplay = !Result.CapturePath.IsEmpty();
+	UE_LOG(LogCombat, Display, TEXT("[CombatBenchmark] Result: %d fighters, frame avg %.2fms p95 %.2fms, report %s"),
+		Result.NumFighters, Result.AvgFrameMs, Result.P95FrameMs, bReplay ? *ACombatBenchmarkDirector::GetReplayReportPath() : *ACombatBenchmarkDirector::GetReportPath());
+
+	EndTest(Result.NumFrames > 0 ? 0 : 1);
+}
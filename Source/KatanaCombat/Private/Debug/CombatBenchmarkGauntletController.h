@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GauntletTestController.h"
+#include "CombatBenchmarkGauntletController.generated.h"
+
+class ACombatBenchmarkDirector;
+struct FCombatBenchmarkResult;
+
+/**
+ * Gauntlet entry point for the combat benchmark
+ *
+ * Launch with -gauntlet=CombatBenchmarkGauntletController. Loads -CombatBenchmarkMap (default: the map the
+ * client started in), uses the ACombatBenchmarkDirector placed in it or spawns one at the world origin,
+ * runs it and exits with 0 once the report row is written (1 on timeout or if no frames were captured).
+ *
+ * Optional overrides: -CombatBenchmarkDuels=N -CombatBenchmarkDuration=Seconds -CombatBenchmarkWarmup=Seconds
+ * -CombatBenchmarkSeed=N -CombatBenchmarkTimeout=Seconds
+ *
+ * -CombatBenchmarkReplay=Path.kcap replays a field capture instead of the scripted fight; the row goes to
+ * CombatReplayReport.csv with per-system combat time, so a build's regressions show up against the
+ * fights QA actually recorded.
+ */
+UCLASS()
+class UCombatBenchmarkGauntletController : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+	virtual void OnTick(float TimeDelta) override;
+
+private:
+	/** Find or spawn the director in the loaded benchmark map and start it */
+	void StartBenchmark(UWorld* World);
+
+	void OnBenchmarkFinished(const FCombatBenchmarkResult& Result);
+
+	FString BenchmarkMap;
+	float TimeoutSeconds = 600.0f;
+	float TimeRunning = 0.0f;
+
+	bool bMapRequested = false;
+	bool bStarted = false;
+
+	TWeakObjectPtr<ACombatBenchmarkDirector> Director;
+};
@@ -0,0 +1,850 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatCapture.h"
+#include "Debug/CombatTrace.h"
+#include "Data/AttackData.h"
+#include "Animation/AnimMontage.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/IConsoleManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+namespace
+{
+	/** Flush a chunk once its payload reaches this size, or FlushInterval after the last flush */
+	constexpr int32 FlushBytes = 64 * 1024;
+
+	/** Event record flags (low 3 bits = ECombatRecordedEventType) */
+	constexpr uint8 EventTypeMask = 0x07;
+	constexpr uint8 EventFlag_Owner = 0x08;
+	constexpr uint8 EventFlag_Subject = 0x10;
+	constexpr uint8 EventFlag_Args = 0x20;
+	constexpr uint8 EventFlag_Value = 0x40;
+
+	void WriteVarUInt(TArray<uint8>& Out, uint64 Value)
+	{
+		do
+		{
+			const uint8 Byte = Value & 0x7F;
+			Value >>= 7;
+			Out.Add(Value ? (Byte | 0x80) : Byte);
+		}
+		while (Value);
+	}
+
+	/** Zigzag so small negative deltas (events recorded slightly out of order across threads) stay small */
+	void WriteVarInt(TArray<uint8>& Out, int64 Value)
+	{
+		WriteVarUInt(Out, (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63));
+	}
+
+	void WriteString(TArray<uint8>& Out, const FString& Value)
+	{
+		const FTCHARToUTF8 Utf8(*Value);
+		WriteVarUInt(Out, Utf8.Length());
+		Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+
+	void WriteRaw(TArray<uint8>& Out, const void* Value, int32 NumBytes)
+	{
+		Out.Append(static_cast<const uint8*>(Value), NumBytes);
+	}
+
+	/** Bounds-checked cursor over mapped bytes */
+	struct FByteCursor
+	{
+		const uint8* Ptr;
+		const uint8* End;
+
+		bool ReadVarUInt(uint64& Out)
+		{
+			Out = 0;
+			for (int32 Shift = 0; Shift < 64 && Ptr < End; Shift += 7)
+			{
+				const uint8 Byte = *Ptr++;
+				Out |= static_cast<uint64>(Byte & 0x7F) << Shift;
+				if (!(Byte & 0x80))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool ReadVarInt(int64& Out)
+		{
+			uint64 ZigZag = 0;
+			if (!ReadVarUInt(ZigZag))
+			{
+				return false;
+			}
+			Out = static_cast<int64>(ZigZag >> 1) ^ -static_cast<int64>(ZigZag & 1);
+			return true;
+		}
+
+		bool ReadRaw(void* Out, int32 NumBytes)
+		{
+			if (End - Ptr < NumBytes)
+			{
+				return false;
+			}
+			FMemory::Memcpy(Out, Ptr, NumBytes);
+			Ptr += NumBytes;
+			return true;
+		}
+
+		bool ReadString(FString& Out)
+		{
+			uint64 Length = 0;
+			if (!ReadVarUInt(Length) || static_cast<uint64>(End - Ptr) < Length)
+			{
+				return false;
+			}
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const UTF8CHAR*>(Ptr), static_cast<int32>(Length));
+			Out = FString(Converted.Length(), Converted.Get());
+			Ptr += Length;
+			return true;
+		}
+	};
+
+	/** Decode a names chunk into Names (grown to the highest index); stops at the first bad record */
+	void DecodeNames(FByteCursor Cursor, uint32 NumRecords, TArray<FCombatCaptureName>& Names)
+	{
+		for (uint32 i = 0; i < NumRecords; ++i)
+		{
+			uint64 Index = 0;
+			uint8 Kind = 0;
+			FCombatCaptureName Name;
+			if (!Cursor.ReadVarUInt(Index) || !Cursor.ReadRaw(&Kind, 1) || !Cursor.ReadString(Name.Name) || !Cursor.ReadString(Name.Detail) || Index == 0 || Index > MAX_int32)
+			{
+				break;
+			}
+			Name.Kind = static_cast<ECombatCaptureNameKind>(Kind);
+			if (static_cast<int32>(Index) >= Names.Num())
+			{
+				Names.SetNum(static_cast<int32>(Index) + 1);
+			}
+			Names[static_cast<int32>(Index)] = MoveTemp(Name);
+		}
+	}
+
+	/** Decode an events chunk (deltas restart per chunk); stops at the first bad record */
+	void DecodeEvents(FByteCursor Cursor, uint32 NumRecords, TFunctionRef<void(const FCombatRecordedEvent&)> Visitor)
+	{
+		const double CyclesPerMicro = 1.0 / (FPlatformTime::GetSecondsPerCycle64() * 1000000.0);
+		int64 Micros = 0;
+		uint64 Owner = 0;
+
+		for (uint32 i = 0; i < NumRecords; ++i)
+		{
+			uint8 Flags = 0;
+			int64 DeltaMicros = 0;
+			if (!Cursor.ReadRaw(&Flags, 1) || !Cursor.ReadVarInt(DeltaMicros))
+			{
+				break;
+			}
+
+			FCombatRecordedEvent Event;
+			Event.Type = static_cast<ECombatRecordedEventType>(Flags & EventTypeMask);
+
+			uint64 Subject = 0;
+			bool bValid = true;
+			if (Flags & EventFlag_Owner)
+			{
+				bValid &= Cursor.ReadVarUInt(Owner);
+			}
+			if (Flags & EventFlag_Subject)
+			{
+				bValid &= Cursor.ReadVarUInt(Subject);
+			}
+			if (Flags & EventFlag_Args)
+			{
+				uint8 Args[4];
+				bValid &= Cursor.ReadRaw(Args, sizeof(Args));
+				Event.Arg0 = Args[0];
+				Event.Arg1 = Args[1];
+				Event.Arg2 = Args[2];
+				Event.Arg3 = Args[3];
+			}
+			if (Flags & EventFlag_Value)
+			{
+				bValid &= Cursor.ReadRaw(&Event.Value, sizeof(Event.Value));
+			}
+			if (!bValid)
+			{
+				break;
+			}
+
+			Micros += DeltaMicros;
+			Event.Cycle = static_cast<uint64>(FMath::Max<int64>(Micros, 0) * CyclesPerMicro);
+			Event.OwnerId = static_cast<uint32>(Owner);
+			Event.SubjectId = static_cast<uint32>(Subject);
+			Visitor(Event);
+		}
+	}
+
+	/** Console capture (heap-owned so engine exit, not static destruction, closes it) */
+	FCombatCaptureWriter* GActiveCapture = nullptr;
+
+	void StopActiveCapture()
+	{
+		delete GActiveCapture;
+		GActiveCapture = nullptr;
+	}
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+FCombatCaptureWriter::FCombatCaptureWriter()
+	: WritePipe(TEXT("CombatCaptureWrite"))
+{
+}
+
+FCombatCaptureWriter::~FCombatCaptureWriter()
+{
+	Stop();
+}
+
+FCombatCaptureWriter* FCombatCaptureWriter::GetActive()
+{
+	return GActiveCapture;
+}
+
+bool FCombatCaptureWriter::Start(const FString& InFilePath)
+{
+	check(IsInGameThread());
+	if (bCapturing)
+	{
+		return false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(InFilePath));
+	FileHandle = PlatformFile.OpenWrite(*InFilePath);
+	if (!FileHandle)
+	{
+		return false;
+	}
+
+	FilePath = InFilePath;
+	Sink = [Handle = FileHandle](const uint8* Data, int32 NumBytes)
+	{
+		Handle->Write(Data, NumBytes);
+	};
+	BeginCapture(1.0);
+	return true;
+}
+
+bool FCombatCaptureWriter::StartStream(FSink&& InSink, const FString& Description, double InFlushInterval)
+{
+	check(IsInGameThread());
+	if (bCapturing || !InSink)
+	{
+		return false;
+	}
+
+	FilePath = Description;
+	Sink = MoveTemp(InSink);
+	BeginCapture(InFlushInterval);
+	return true;
+}
+
+void FCombatCaptureWriter::BeginCapture(double InFlushInterval)
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+
+	FlushInterval = FMath::Max(InFlushInterval, 0.0);
+	StartCycle = FPlatformTime::Cycles64();
+	RecorderPosition = FCombatEventRecorder::Get().GetNumRecorded();
+	LastFlushTime = FPlatformTime::Seconds();
+
+	NameIndices.Reset();
+	NumNames = 0;
+	NamesPayload.Reset();
+	EventsPayload.Reset(FlushBytes + 256);
+	NumPendingNames = 0;
+	NumPendingEvents = 0;
+	PendingLost = 0;
+	PreviousMicros = 0;
+	PreviousOwner = 0;
+	NumEventsWritten = 0;
+	NumEventsLost = 0;
+
+	FCombatCaptureHeader Header;
+	Header.StartUnixTime = FDateTime::UtcNow().ToUnixTimestamp();
+	Header.StartCycle = StartCycle;
+	NumBytesWritten = sizeof(Header);
+
+	NumBytesQueued.store(sizeof(Header), std::memory_order_relaxed);
+	WritePipe.Launch(TEXT("CombatCaptureWrite"), [this, Header]()
+	{
+		Sink(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+		NumBytesQueued.fetch_sub(sizeof(Header), std::memory_order_relaxed);
+	});
+
+	bCapturing = true;
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCombatCaptureWriter::Tick));
+}
+
+void FCombatCaptureWriter::Stop()
+{
+	if (!bCapturing)
+	{
+		return;
+	}
+
+	FTSTicker::RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	Drain();
+	Flush();
+
+	WritePipe.WaitUntilEmpty();
+	Sink.Reset();
+	delete FileHandle;
+	FileHandle = nullptr;
+	bCapturing = false;
+
+	UE_LOG(LogCombat, Log, TEXT("[CombatCapture] Wrote %llu events (%llu lost) in %.1f KB to %s"),
+		NumEventsWritten, NumEventsLost, NumBytesWritten / 1024.0, *FilePath);
+}
+
+bool FCombatCaptureWriter::Tick(float DeltaTime)
+{
+	Drain();
+
+	if (EventsPayload.Num() >= FlushBytes || FPlatformTime::Seconds() - LastFlushTime >= FlushInterval)
+	{
+		Flush();
+	}
+	return true;
+}
+
+void FCombatCaptureWriter::Drain()
+{
+	check(IsInGameThread());
+	if (!bCapturing)
+	{
+		return;
+	}
+
+	COMBAT_LLM_SCOPE(DebugRecorder);
+
+	uint64 NumLost = 0;
+	DrainBuffer.Reset();
+	RecorderPosition = FCombatEventRecorder::Get().ReadSince(RecorderPosition, DrainBuffer, NumLost);
+	PendingLost += NumLost;
+
+	for (const FCombatRecordedEvent& Event : DrainBuffer)
+	{
+		EncodeEvent(Event);
+		if (EventsPayload.Num() >= FlushBytes)
+		{
+			Flush();
+		}
+	}
+}
+
+uint32 FCombatCaptureWriter::GetNameIndex(uint32 UniqueId)
+{
+	if (UniqueId == 0)
+	{
+		return 0;
+	}
+
+	// Object IDs are recycled once an object dies, so a cached index is only reused for the same live object
+	const FUObjectItem* Item = GUObjectArray.IndexToObject(static_cast<int32>(UniqueId));
+	const UObject* Object = Item ? static_cast<const UObject*>(Item->Object) : nullptr;
+	if (Object && Object->GetUniqueID() != UniqueId)
+	{
+		Object = nullptr;
+	}
+
+	if (const FNameSlot* Existing = NameIndices.Find(UniqueId))
+	{
+		if (Existing->Object.Get() == Object)
+		{
+			return Existing->Index;
+		}
+	}
+
+	FCombatCaptureName Name;
+	if (const UAttackData* Attack = Cast<UAttackData>(Object))
+	{
+		Name.Kind = ECombatCaptureNameKind::Attack;
+		Name.Name = Attack->GetPathName();
+		Name.Detail = Attack->AttackMontage ? Attack->AttackMontage->GetPathName() : FString();
+	}
+	else if (Object && Object->IsAsset())
+	{
+		Name.Kind = ECombatCaptureNameKind::Asset;
+		Name.Name = Object->GetPathName();
+	}
+	else if (Object)
+	{
+		Name.Kind = ECombatCaptureNameKind::Object;
+		Name.Name = Object->GetName();
+	}
+	else
+	{
+		Name.Kind = ECombatCaptureNameKind::Unresolved;
+		Name.Name = FString::Printf(TEXT("#%u"), UniqueId);
+	}
+
+	const uint32 Index = ++NumNames;
+	NameIndices.Add(UniqueId, { Index, FWeakObjectPtr(Object) });
+
+	WriteVarUInt(NamesPayload, Index);
+	NamesPayload.Add(static_cast<uint8>(Name.Kind));
+	WriteString(NamesPayload, Name.Name);
+	WriteString(NamesPayload, Name.Detail);
+	++NumPendingNames;
+
+	return Index;
+}
+
+void FCombatCaptureWriter::EncodeEvent(const FCombatRecordedEvent& Event)
+{
+	const uint64 Micros = static_cast<uint64>(FMath::Max(FPlatformTime::ToSeconds64(Event.Cycle - FMath::Min(Event.Cycle, StartCycle)), 0.0) * 1000000.0);
+	const uint32 Owner = GetNameIndex(Event.OwnerId);
+	const uint32 Subject = GetNameIndex(Event.SubjectId);
+	const bool bHasArgs = (Event.Arg0 | Event.Arg1 | Event.Arg2 | Event.Arg3) != 0;
+
+	uint8 Flags = static_cast<uint8>(Event.Type) & EventTypeMask;
+	Flags |= Owner != PreviousOwner ? EventFlag_Owner : 0;
+	Flags |= Subject != 0 ? EventFlag_Subject : 0;
+	Flags |= bHasArgs ? EventFlag_Args : 0;
+	Flags |= Event.Value != 0.0f ? EventFlag_Value : 0;
+
+	EventsPayload.Add(Flags);
+	WriteVarInt(EventsPayload, static_cast<int64>(Micros) - static_cast<int64>(PreviousMicros));
+	if (Flags & EventFlag_Owner)
+	{
+		WriteVarUInt(EventsPayload, Owner);
+	}
+	if (Flags & EventFlag_Subject)
+	{
+		WriteVarUInt(EventsPayload, Subject);
+	}
+	if (bHasArgs)
+	{
+		const uint8 Args[4] = { Event.Arg0, Event.Arg1, Event.Arg2, Event.Arg3 };
+		WriteRaw(EventsPayload, Args, sizeof(Args));
+	}
+	if (Flags & EventFlag_Value)
+	{
+		WriteRaw(EventsPayload, &Event.Value, sizeof(Event.Value));
+	}
+
+	PreviousMicros = Micros;
+	PreviousOwner = Owner;
+	++NumPendingEvents;
+}
+
+void FCombatCaptureWriter::Flush()
+{
+	LastFlushTime = FPlatformTime::Seconds();
+	if (!bCapturing || (NumPendingNames == 0 && NumPendingEvents == 0 && PendingLost == 0))
+	{
+		return;
+	}
+
+	COMBAT_LLM_SCOPE(DebugRecorder);
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(NamesPayload.Num() + EventsPayload.Num() + 3 * CombatCapture::ChunkHeaderSize + 10);
+
+	auto AppendChunk = [&Buffer](CombatCapture::EChunkType Type, const TArray<uint8>& Payload, uint32 NumRecords)
+	{
+		const uint32 PayloadSize = Payload.Num();
+		Buffer.Add(static_cast<uint8>(Type));
+		WriteRaw(Buffer, &PayloadSize, sizeof(PayloadSize));
+		WriteRaw(Buffer, &NumRecords, sizeof(NumRecords));
+		Buffer.Append(Payload);
+	};
+
+	// Names first: the events below may reference them
+	if (NumPendingNames > 0)
+	{
+		AppendChunk(CombatCapture::EChunkType::Names, NamesPayload, NumPendingNames);
+	}
+	if (PendingLost > 0)
+	{
+		TArray<uint8> LostPayload;
+		WriteVarUInt(LostPayload, PendingLost);
+		AppendChunk(CombatCapture::EChunkType::Lost, LostPayload, 1);
+	}
+	if (NumPendingEvents > 0)
+	{
+		AppendChunk(CombatCapture::EChunkType::Events, EventsPayload, NumPendingEvents);
+	}
+
+	NumEventsWritten += NumPendingEvents;
+	NumEventsLost += PendingLost;
+	NumBytesWritten += Buffer.Num();
+
+	NamesPayload.Reset();
+	EventsPayload.Reset();
+	NumPendingNames = 0;
+	NumPendingEvents = 0;
+	PendingLost = 0;
+
+	// Deltas restart per chunk so each chunk decodes on its own
+	PreviousMicros = 0;
+	PreviousOwner = 0;
+
+	// Stop waits for the pipe before the sink goes away
+	NumBytesQueued.fetch_add(Buffer.Num(), std::memory_order_relaxed);
+	WritePipe.Launch(TEXT("CombatCaptureWrite"), [this, Buffer = MoveTemp(Buffer)]()
+	{
+		Sink(Buffer.GetData(), Buffer.Num());
+		NumBytesQueued.fetch_sub(Buffer.Num(), std::memory_order_relaxed);
+	});
+}
+
+// ============================================================================
+// STREAM DECODER
+// ============================================================================
+
+FCombatCaptureStreamDecoder::FCombatCaptureStreamDecoder()
+{
+	Names.AddDefaulted();
+}
+
+void FCombatCaptureStreamDecoder::Reset()
+{
+	Pending.Reset();
+	ReadOffset = 0;
+	Header = FCombatCaptureHeader();
+	bHasHeader = false;
+	bValid = true;
+	Names.Reset();
+	Names.AddDefaulted();
+	++NamesVersion;
+	NumEvents = 0;
+	NumLostEvents = 0;
+}
+
+bool FCombatCaptureStreamDecoder::Feed(const uint8* Bytes, int32 NumBytes, TFunctionRef<void(const FCombatRecordedEvent&)> Visitor)
+{
+	if (!bValid)
+	{
+		return false;
+	}
+
+	COMBAT_LLM_SCOPE(DebugRecorder);
+	Pending.Append(Bytes, NumBytes);
+
+	if (!bHasHeader)
+	{
+		if (Pending.Num() < static_cast<int32>(sizeof(FCombatCaptureHeader)))
+		{
+			return true;
+		}
+
+		FMemory::Memcpy(&Header, Pending.GetData(), sizeof(Header));
+		if (Header.Magic != CombatCapture::Magic || Header.Version > CombatCapture::Version || Header.HeaderSize < sizeof(FCombatCaptureHeader))
+		{
+			bValid = false;
+			return false;
+		}
+		if (Pending.Num() < Header.HeaderSize)
+		{
+			return true;
+		}
+
+		bHasHeader = true;
+		ReadOffset = Header.HeaderSize;
+	}
+
+	// Decode whole chunks; a partial one waits for the rest of its bytes
+	while (Pending.Num() - ReadOffset >= CombatCapture::ChunkHeaderSize)
+	{
+		const uint8* ChunkHeader = Pending.GetData() + ReadOffset;
+		const CombatCapture::EChunkType Type = static_cast<CombatCapture::EChunkType>(ChunkHeader[0]);
+		uint32 ChunkSize = 0;
+		uint32 NumRecords = 0;
+		FMemory::Memcpy(&ChunkSize, ChunkHeader + 1, sizeof(ChunkSize));
+		FMemory::Memcpy(&NumRecords, ChunkHeader + 5, sizeof(NumRecords));
+
+		if (static_cast<int64>(Pending.Num() - ReadOffset - CombatCapture::ChunkHeaderSize) < ChunkSize)
+		{
+			break;
+		}
+
+		const uint8* Payload = ChunkHeader + CombatCapture::ChunkHeaderSize;
+		const FByteCursor Cursor{ Payload, Payload + ChunkSize };
+		if (Type == CombatCapture::EChunkType::Names)
+		{
+			DecodeNames(Cursor, NumRecords, Names);
+			++NamesVersion;
+		}
+		else if (Type == CombatCapture::EChunkType::Events)
+		{
+			DecodeEvents(Cursor, NumRecords, Visitor);
+			NumEvents += NumRecords;
+		}
+		else if (Type == CombatCapture::EChunkType::Lost)
+		{
+			FByteCursor LostCursor = Cursor;
+			uint64 NumLost = 0;
+			if (LostCursor.ReadVarUInt(NumLost))
+			{
+				NumLostEvents += NumLost;
+			}
+		}
+
+		ReadOffset += CombatCapture::ChunkHeaderSize + static_cast<int32>(ChunkSize);
+	}
+
+	// Compact once the decoded prefix dominates (keeps the buffer at about one chunk)
+	if (ReadOffset > 0 && ReadOffset >= Pending.Num() / 2)
+	{
+		Pending.RemoveAt(0, ReadOffset, EAllowShrinking::No);
+		ReadOffset = 0;
+	}
+
+	return true;
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+FCombatCaptureReader::FCombatCaptureReader()
+{
+	Names.AddDefaulted();
+}
+
+FCombatCaptureReader::~FCombatCaptureReader()
+{
+	Close();
+}
+
+bool FCombatCaptureReader::Open(const FString& FilePath)
+{
+	Close();
+
+	FOpenMappedResult Result = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*FilePath);
+	if (Result.HasError())
+	{
+		return false;
+	}
+	MappedFile = Result.StealValue();
+
+	const int64 FileSize = MappedFile->GetFileSize();
+	if (FileSize < static_cast<int64>(sizeof(FCombatCaptureHeader)))
+	{
+		Close();
+		return false;
+	}
+
+	MappedRegion.Reset(MappedFile->MapRegion(0, FileSize));
+	if (!MappedRegion)
+	{
+		Close();
+		return false;
+	}
+
+	Data = MappedRegion->GetMappedPtr();
+	Size = MappedRegion->GetMappedSize();
+
+	FMemory::Memcpy(&Header, Data, sizeof(Header));
+	if (Header.Magic != CombatCapture::Magic || Header.Version > CombatCapture::Version || Header.HeaderSize < sizeof(FCombatCaptureHeader) || Header.HeaderSize > Size)
+	{
+		Close();
+		return false;
+	}
+
+	// Index chunks; a truncated tail (crash mid-write) simply ends the capture
+	int64 Offset = Header.HeaderSize;
+	while (Offset + CombatCapture::ChunkHeaderSize <= Size)
+	{
+		FChunk Chunk;
+		const CombatCapture::EChunkType Type = static_cast<CombatCapture::EChunkType>(Data[Offset]);
+		FMemory::Memcpy(&Chunk.Size, Data + Offset + 1, sizeof(Chunk.Size));
+		FMemory::Memcpy(&Chunk.NumRecords, Data + Offset + 5, sizeof(Chunk.NumRecords));
+		Chunk.Offset = Offset + CombatCapture::ChunkHeaderSize;
+
+		if (Chunk.Offset + Chunk.Size > Size)
+		{
+			break;
+		}
+		Offset = Chunk.Offset + Chunk.Size;
+
+		FByteCursor Cursor{ Data + Chunk.Offset, Data + Chunk.Offset + Chunk.Size };
+		if (Type == CombatCapture::EChunkType::Names)
+		{
+			DecodeNames(Cursor, Chunk.NumRecords, Names);
+		}
+		else if (Type == CombatCapture::EChunkType::Events)
+		{
+			EventChunks.Add(Chunk);
+			NumEvents += Chunk.NumRecords;
+		}
+		else if (Type == CombatCapture::EChunkType::Lost)
+		{
+			uint64 NumLost = 0;
+			if (Cursor.ReadVarUInt(NumLost))
+			{
+				NumLostEvents += NumLost;
+			}
+		}
+		// Unknown chunk types are skipped (written by a newer version)
+	}
+
+	return true;
+}
+
+void FCombatCaptureReader::Close()
+{
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	Data = nullptr;
+	Size = 0;
+
+	Header = FCombatCaptureHeader();
+	Names.Reset();
+	Names.AddDefaulted();
+	EventChunks.Reset();
+	NumEvents = 0;
+	NumLostEvents = 0;
+}
+
+uint32 FCombatCaptureReader::FindName(const FString& Name) const
+{
+	for (int32 Index = 1; Index < Names.Num(); ++Index)
+	{
+		if (Names[Index].Name == Name)
+		{
+			return Index;
+		}
+	}
+	return 0;
+}
+
+void FCombatCaptureReader::ForEachEvent(TFunctionRef<void(const FCombatRecordedEvent&)> Visitor) const
+{
+	for (const FChunk& Chunk : EventChunks)
+	{
+		DecodeEvents(FByteCursor{ Data + Chunk.Offset, Data + Chunk.Offset + Chunk.Size }, Chunk.NumRecords, Visitor);
+	}
+}
+
+int32 FCombatCaptureReader::ReadEvents(TArray<FCombatRecordedEvent>& OutEvents, uint32 OwnerIndex) const
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+	OutEvents.Reset();
+	if (OwnerIndex == 0)
+	{
+		OutEvents.Reserve(static_cast<int32>(NumEvents));
+	}
+
+	ForEachEvent([&OutEvents, OwnerIndex](const FCombatRecordedEvent& Event)
+	{
+		if (OwnerIndex == 0 || Event.OwnerId == OwnerIndex)
+		{
+			OutEvents.Add(Event);
+		}
+	});
+	return OutEvents.Num();
+}
+
+bool FCombatCaptureReader::ExportToCSV(const FString& CsvPath) const
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+
+	FString Csv = TEXT("Cycle,Seconds,Type,Owner,Subject,Arg0,Arg1,Arg2,Arg3,Value\n");
+	Csv.Reserve(static_cast<int32>(NumEvents) * 64);
+
+	ForEachEvent([this, &Csv](const FCombatRecordedEvent& Event)
+	{
+		Csv += FString::Printf(TEXT("%llu,%.6f,%s,%s,%s,%u,%u,%u,%u,%.4f\n"),
+			Event.Cycle,
+			FPlatformTime::ToSeconds64(Event.Cycle),
+			LexToString(Event.Type),
+			*GetName(Event.OwnerId),
+			*GetName(Event.SubjectId),
+			Event.Arg0, Event.Arg1, Event.Arg2, Event.Arg3,
+			Event.Value);
+	});
+
+	return FFileHelper::SaveStringToFile(Csv, *CsvPath);
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+
+static FAutoConsoleCommand GCombatCaptureStartCommand(
+	TEXT("Combat.Capture.Start"),
+	TEXT("Stream combat events to a capture file until Combat.Capture.Stop. Optional argument: output path (default Saved/Combat/Capture_<time>.kcap)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (GActiveCapture && GActiveCapture->IsCapturing())
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatCapture] Already capturing to %s"), *GActiveCapture->GetFilePath());
+			return;
+		}
+
+		const FString FilePath = Args.Num() > 0
+			? Args[0]
+			: FPaths::ProjectSavedDir() / TEXT("Combat") / FString::Printf(TEXT("Capture_%s.kcap"), *FDateTime::Now().ToString());
+
+		static bool bRegisteredExit = false;
+		if (!bRegisteredExit)
+		{
+			bRegisteredExit = true;
+			FCoreDelegates::OnEnginePreExit.AddStatic(&StopActiveCapture);
+		}
+
+		StopActiveCapture();
+		GActiveCapture = new FCombatCaptureWriter();
+		if (GActiveCapture->Start(FilePath))
+		{
+			UE_LOG(LogCombat, Log, TEXT("[CombatCapture] Capturing to %s"), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatCapture] Failed to open %s"), *FilePath);
+			StopActiveCapture();
+		}
+	}));
+
+static FAutoConsoleCommand GCombatCaptureStopCommand(
+	TEXT("Combat.Capture.Stop"),
+	TEXT("Finish the capture started with Combat.Capture.Start"),
+	FConsoleCommandDelegate::CreateStatic(&StopActiveCapture));
+
+static FAutoConsoleCommand GCombatCaptureExportCommand(
+	TEXT("Combat.Capture.Export"),
+	TEXT("Convert a capture file to CSV. Arguments: capture path, optional CSV path (default: next to the capture)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatCapture] Usage: Combat.Capture.Export <CapturePath> [CsvPath]"));
+			return;
+		}
+
+		FCombatCaptureReader Reader;
+		if (!Reader.Open(Args[0]))
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatCapture] Could not read %s"), *Args[0]);
+			return;
+		}
+
+		const FString CsvPath = Args.Num() > 1 ? Args[1] : FPaths::ChangeExtension(Args[0], TEXT("csv"));
+		if (Reader.ExportToCSV(CsvPath))
+		{
+			UE_LOG(LogCombat, Log, TEXT("[CombatCapture] Exported %lld events (%llu lost while capturing) to %s"), Reader.GetNumEvents(), Reader.GetNumLostEvents(), *CsvPath);
+		}
+	}));
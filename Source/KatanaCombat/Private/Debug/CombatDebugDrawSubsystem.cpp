@@ -0,0 +1,260 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatDebugDrawSubsystem.h"
+#include "Debug/CombatTrace.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/LineBatchComponent.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+UCombatDebugDrawSubsystem* UCombatDebugDrawSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCombatDebugDrawSubsystem>() : nullptr;
+}
+
+bool UCombatDebugDrawSubsystem::IsTickable() const
+{
+	return Primitives.Num() > 0 || NumDrawnLastFrame > 0;
+}
+
+TStatId UCombatDebugDrawSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatDebugDrawSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatDebugDrawSubsystem::Tick(float DeltaTime)
+{
+	COMBAT_TRACE_SCOPE(UCombatDebugDrawSubsystem::Tick);
+
+	Super::Tick(DeltaTime);
+
+	NumDrawnLastFrame = 0;
+	NumDroppedLastFrame = 0;
+
+	if (Primitives.Num() == 0)
+	{
+		return;
+	}
+
+	// Over budget: nearest owners first (the queue is rebuilt every frame, so order doesn't carry over)
+	int32 NumToDraw = Primitives.Num();
+	if (MaxPrimitivesPerFrame > 0 && NumToDraw > MaxPrimitivesPerFrame)
+	{
+		Primitives.StableSort([](const FPrimitive& A, const FPrimitive& B) { return A.DistanceSq < B.DistanceSq; });
+		NumDroppedLastFrame = NumToDraw - MaxPrimitivesPerFrame;
+		NumToDraw = MaxPrimitivesPerFrame;
+	}
+
+#if ENABLE_DRAW_DEBUG
+	UWorld* World = GetWorld();
+
+	// Lines are the bulk of it (spheres and timelines are made of them) - one batcher call for all
+	TArray<FBatchedLine> Lines;
+	Lines.Reserve(NumToDraw);
+
+	for (int32 Index = 0; Index < NumToDraw; ++Index)
+	{
+		const FPrimitive& Primitive = Primitives[Index];
+		switch (Primitive.Type)
+		{
+			case EPrimitiveType::Line:
+				Lines.Emplace(Primitive.A, Primitive.B, FLinearColor(Primitive.Color), Primitive.Duration, Primitive.Size, SDPG_World);
+				break;
+			case EPrimitiveType::Sphere:
+				DrawDebugSphere(World, Primitive.A, Primitive.Size, Primitive.Segments, Primitive.Color, false, Primitive.Duration);
+				break;
+			case EPrimitiveType::Point:
+				DrawDebugPoint(World, Primitive.A, Primitive.Size, Primitive.Color, false, Primitive.Duration);
+				break;
+			case EPrimitiveType::Cone:
+				DrawDebugCone(World, Primitive.A, Primitive.B, Primitive.Size, Primitive.Angle, Primitive.Angle, Primitive.Segments, Primitive.Color, false, Primitive.Duration);
+				break;
+			case EPrimitiveType::String:
+				DrawDebugString(World, Primitive.A, Strings[Primitive.TextIndex], nullptr, Primitive.Color, Primitive.Duration, true);
+				break;
+		}
+	}
+
+	if (Lines.Num() > 0)
+	{
+		if (ULineBatchComponent* LineBatcher = World ? World->GetLineBatcher(UWorld::ELineBatcherType::World) : nullptr)
+		{
+			LineBatcher->DrawLines(Lines);
+		}
+	}
+#endif
+
+	NumDrawnLastFrame = NumToDraw;
+	Primitives.Reset();
+	Strings.Reset();
+}
+
+// ============================================================================
+// RELEVANCE
+// ============================================================================
+
+void UCombatDebugDrawSubsystem::UpdateViewLocation() const
+{
+	if (ViewLocationFrame == GFrameCounter)
+	{
+		return;
+	}
+	ViewLocationFrame = GFrameCounter;
+
+	const APlayerController* PlayerController = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	bHasViewLocation = PlayerController && PlayerController->PlayerCameraManager;
+	ViewLocation = bHasViewLocation ? PlayerController->PlayerCameraManager->GetCameraLocation() : FVector::ZeroVector;
+}
+
+bool UCombatDebugDrawSubsystem::ShouldDraw(const AActor* Owner) const
+{
+#if ENABLE_DRAW_DEBUG
+	if (!Owner)
+	{
+		return false;
+	}
+
+	if (const AActor* Selected = SelectedActor.Get())
+	{
+		return Owner == Selected;
+	}
+
+	if (MaxDrawDistance <= 0.0f)
+	{
+		return true;
+	}
+
+	// No local view (server, automation) - nothing to measure against
+	UpdateViewLocation();
+	return !bHasViewLocation || FVector::DistSquared(Owner->GetActorLocation(), ViewLocation) <= FMath::Square(MaxDrawDistance);
+#else
+	return false;
+#endif
+}
+
+// ============================================================================
+// PRIMITIVES
+// ============================================================================
+
+UCombatDebugDrawSubsystem::FPrimitive& UCombatDebugDrawSubsystem::AddPrimitive(const AActor* Owner, EPrimitiveType Type, const FColor& Color, float Duration)
+{
+	UpdateViewLocation();
+
+	FPrimitive& Primitive = Primitives.AddDefaulted_GetRef();
+	Primitive.Type = Type;
+	Primitive.Color = Color;
+	Primitive.Duration = Duration;
+	Primitive.DistanceSq = (Owner && bHasViewLocation) ? FVector::DistSquared(Owner->GetActorLocation(), ViewLocation) : 0.0f;
+	return Primitive;
+}
+
+void UCombatDebugDrawSubsystem::AddLine(const AActor* Owner, const FVector& Start, const FVector& End, const FColor& Color, float Thickness, float Duration)
+{
+	FPrimitive& Primitive = AddPrimitive(Owner, EPrimitiveType::Line, Color, Duration);
+	Primitive.A = Start;
+	Primitive.B = End;
+	Primitive.Size = Thickness;
+}
+
+void UCombatDebugDrawSubsystem::AddSphere(const AActor* Owner, const FVector& Center, float Radius, int32 Segments, const FColor& Color, float Duration)
+{
+	FPrimitive& Primitive = AddPrimitive(Owner, EPrimitiveType::Sphere, Color, Duration);
+	Primitive.A = Center;
+	Primitive.Size = Radius;
+	Primitive.Segments = Segments;
+}
+
+void UCombatDebugDrawSubsystem::AddPoint(const AActor* Owner, const FVector& Position, float Size, const FColor& Color, float Duration)
+{
+	FPrimitive& Primitive = AddPrimitive(Owner, EPrimitiveType::Point, Color, Duration);
+	Primitive.A = Position;
+	Primitive.Size = Size;
+}
+
+void UCombatDebugDrawSubsystem::AddCone(const AActor* Owner, const FVector& Origin, const FVector& Direction, float Length, float HalfAngleRadians, int32 Segments, const FColor& Color, float Duration)
+{
+	FPrimitive& Primitive = AddPrimitive(Owner, EPrimitiveType::Cone, Color, Duration);
+	Primitive.A = Origin;
+	Primitive.B = Direction;
+	Primitive.Size = Length;
+	Primitive.Angle = HalfAngleRadians;
+	Primitive.Segments = Segments;
+}
+
+void UCombatDebugDrawSubsystem::AddString(const AActor* Owner, const FVector& Location, const FString& Text, const FColor& Color, float Duration)
+{
+	FPrimitive& Primitive = AddPrimitive(Owner, EPrimitiveType::String, Color, Duration);
+	Primitive.A = Location;
+	Primitive.TextIndex = Strings.Add(Text);
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatDebugDrawSelectCommand(
+	TEXT("Combat.DebugDraw.Select"),
+	TEXT("Limit combat debug drawing to one actor. Argument: actor name (no argument = draw every actor near the camera)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UCombatDebugDrawSubsystem* DebugDraw = UCombatDebugDrawSubsystem::Get(World);
+		if (!DebugDraw)
+		{
+			return;
+		}
+
+		AActor* Selected = nullptr;
+		if (Args.Num() > 0)
+		{
+			for (TActorIterator<AActor> It(World); It; ++It)
+			{
+				if (It->GetName() == Args[0] || It->GetActorNameOrLabel() == Args[0])
+				{
+					Selected = *It;
+					break;
+				}
+			}
+
+			if (!Selected)
+			{
+				UE_LOG(LogCombat, Warning, TEXT("[CombatDebugDraw] No actor named '%s'"), *Args[0]);
+				return;
+			}
+		}
+
+		DebugDraw->SetSelectedActor(Selected);
+		UE_LOG(LogCombat, Log, TEXT("[CombatDebugDraw] Selected: %s"), Selected ? *Selected->GetName() : TEXT("(all within range)"));
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatDebugDrawBudgetCommand(
+	TEXT("Combat.DebugDraw.Budget"),
+	TEXT("Combat debug draw limits. Optional arguments: max primitives per frame (0 = unlimited), max distance from camera in cm (0 = unlimited)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UCombatDebugDrawSubsystem* DebugDraw = UCombatDebugDrawSubsystem::Get(World);
+		if (!DebugDraw)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0)
+		{
+			DebugDraw->MaxPrimitivesPerFrame = FMath::Max(FCString::Atoi(*Args[0]), 0);
+		}
+		if (Args.Num() > 1)
+		{
+			DebugDraw->MaxDrawDistance = FMath::Max(FCString::Atof(*Args[1]), 0.0f);
+		}
+
+		UE_LOG(LogCombat, Log, TEXT("[CombatDebugDraw] Budget: %d primitives, %.0f cm (last frame: %d drawn, %d dropped)"),
+			DebugDraw->MaxPrimitivesPerFrame, DebugDraw->MaxDrawDistance,
+			DebugDraw->GetNumDrawnLastFrame(), DebugDraw->GetNumDroppedLastFrame());
+	}));
@@ -12,7 +12,7 @@
 UCombatDebugWidget::UCombatDebugWidget()
 {
 	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false; // only while the overlay is shown
 
 	bIsVisible = false;
 	CurrentTime = 0.0f;
@@ -85,6 +85,7 @@ void UCombatDebugWidget::ShowDebugOverlay()
 
 	CreateWidget();
 	bIsVisible = true;
+	SetComponentTickEnabled(true);
 
 	UE_LOG(LogTemp, Log, TEXT("[CombatDebugWidget] Debug overlay shown"));
 }
@@ -98,6 +99,7 @@ void UCombatDebugWidget::HideDebugOverlay()
 
 	RemoveWidget();
 	bIsVisible = false;
+	SetComponentTickEnabled(false);
 
 	UE_LOG(LogTemp, Log, TEXT("[CombatDebugWidget] Debug overlay hidden"));
 }
@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatEventRecorder.h"
+#include "Debug/CombatTrace.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+static_assert(FMath::IsPowerOfTwo(FCombatEventRecorder::Capacity), "Ring index masking requires a power-of-two capacity");
+
+const TCHAR* LexToString(ECombatRecordedEventType Type)
+{
+	static const TCHAR* TypeNames[] = { TEXT("Input"), TEXT("AttackResolved"), TEXT("Queue"), TEXT("Phase"), TEXT("Window"), TEXT("Hit") };
+	const uint8 TypeIndex = static_cast<uint8>(Type);
+	return TypeIndex < UE_ARRAY_COUNT(TypeNames) ? TypeNames[TypeIndex] : TEXT("Unknown");
+}
+
+FCombatEventRecorder& FCombatEventRecorder::Get()
+{
+	// Heap-allocated so the ring shows up under its LLM tag; never freed (Record can run during static shutdown)
+	static FCombatEventRecorder* Recorder = []
+	{
+		COMBAT_LLM_SCOPE(DebugRecorder);
+		return new FCombatEventRecorder();
+	}();
+	return *Recorder;
+}
+
+void FCombatEventRecorder::Record(const FCombatRecordedEvent& Event)
+{
+	if (!bEnabled.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	const uint64 Index = WriteIndex.fetch_add(1, std::memory_order_relaxed);
+	FSlot& Slot = Slots[Index & (Capacity - 1)];
+
+	// Odd sequence marks the slot as being written (readers skip it)
+	Slot.Sequence.store(2 * Index + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	Slot.Event = Event;
+	Slot.Sequence.store(2 * Index + 2, std::memory_order_release);
+}
+
+int32 FCombatEventRecorder::Snapshot(TArray<FCombatRecordedEvent>& OutEvents, int32 MaxEvents, uint32 OwnerId) const
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+	OutEvents.Reset();
+
+	const uint64 End = WriteIndex.load(std::memory_order_acquire);
+	const uint64 Count = FMath::Min<uint64>(End, FMath::Clamp<uint64>(MaxEvents, 0, Capacity));
+	OutEvents.Reserve(static_cast<int32>(Count));
+
+	for (uint64 Index = End - Count; Index < End; ++Index)
+	{
+		const FSlot& Slot = Slots[Index & (Capacity - 1)];
+
+		const uint64 Expected = 2 * Index + 2;
+		if (Slot.Sequence.load(std::memory_order_acquire) != Expected)
+		{
+			continue; // Still being written or already overwritten
+		}
+
+		const FCombatRecordedEvent Event = Slot.Event;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Slot.Sequence.load(std::memory_order_relaxed) != Expected)
+		{
+			continue; // Overwritten while copying
+		}
+
+		if (OwnerId == 0 || Event.OwnerId == OwnerId)
+		{
+			OutEvents.Add(Event);
+		}
+	}
+
+	return OutEvents.Num();
+}
+
+uint64 FCombatEventRecorder::ReadSince(uint64 StartIndex, TArray<FCombatRecordedEvent>& OutEvents, uint64& OutNumLost) const
+{
+	const uint64 End = WriteIndex.load(std::memory_order_acquire);
+	const uint64 Begin = FMath::Max(StartIndex, End > Capacity ? End - Capacity : 0);
+	OutNumLost = Begin - StartIndex;
+
+	for (uint64 Index = Begin; Index < End; ++Index)
+	{
+		const FSlot& Slot = Slots[Index & (Capacity - 1)];
+
+		const uint64 Expected = 2 * Index + 2;
+		const uint64 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+		if (Sequence < Expected)
+		{
+			return Index; // Claimed but not published yet - pick it up next call
+		}
+		if (Sequence != Expected)
+		{
+			++OutNumLost;
+			continue; // Already overwritten by a later lap
+		}
+
+		const FCombatRecordedEvent Event = Slot.Event;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Slot.Sequence.load(std::memory_order_relaxed) != Expected)
+		{
+			++OutNumLost;
+			continue; // Overwritten while copying
+		}
+
+		OutEvents.Add(Event);
+	}
+
+	return End;
+}
+
+bool FCombatEventRecorder::ExportToCSV(const FString& FilePath) const
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+	TArray<FCombatRecordedEvent> Events;
+	Snapshot(Events);
+
+	auto GetObjectName = [](uint32 UniqueId) -> FString
+	{
+		if (UniqueId == 0)
+		{
+			return FString();
+		}
+		const FUObjectItem* Item = GUObjectArray.IndexToObject(static_cast<int32>(UniqueId));
+		const UObject* Object = Item ? static_cast<const UObject*>(Item->Object) : nullptr;
+		return Object && Object->GetUniqueID() == UniqueId ? Object->GetName() : FString::Printf(TEXT("#%u"), UniqueId);
+	};
+
+	FString Csv = TEXT("Cycle,Seconds,Type,Owner,Subject,Arg0,Arg1,Arg2,Arg3,Value\n");
+	Csv.Reserve(Events.Num() * 64);
+
+	const uint64 FirstCycle = Events.Num() > 0 ? Events[0].Cycle : 0;
+	for (const FCombatRecordedEvent& Event : Events)
+	{
+		Csv += FString::Printf(TEXT("%llu,%.6f,%s,%s,%s,%u,%u,%u,%u,%.4f\n"),
+			Event.Cycle,
+			FPlatformTime::ToSeconds64(Event.Cycle - FirstCycle),
+			LexToString(Event.Type),
+			*GetObjectName(Event.OwnerId),
+			*GetObjectName(Event.SubjectId),
+			Event.Arg0, Event.Arg1, Event.Arg2, Event.Arg3,
+			Event.Value);
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
+
+static FAutoConsoleCommand GCombatDumpEventsCommand(
+	TEXT("Combat.DumpEvents"),
+	TEXT("Write the combat event recorder ring as CSV. Optional argument: output path (default Saved/Combat/CombatEvents_<time>.csv)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString FilePath = Args.Num() > 0
+			? Args[0]
+			: FPaths::ProjectSavedDir() / TEXT("Combat") / FString::Printf(TEXT("CombatEvents_%s.csv"), *FDateTime::Now().ToString());
+
+		if (FCombatEventRecorder::Get().ExportToCSV(FilePath))
+		{
+			UE_LOG(LogCombat, Log, TEXT("[CombatEventRecorder] Wrote %llu recorded events (last %u kept) to %s"),
+				FCombatEventRecorder::Get().GetNumRecorded(), FCombatEventRecorder::Capacity, *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatEventRecorder] Failed to write %s"), *FilePath);
+		}
+	}));
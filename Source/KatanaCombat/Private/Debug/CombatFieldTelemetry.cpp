@@ -0,0 +1,333 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatFieldTelemetry.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "Interfaces/IHttpRequest.h"
+#include "HttpModule.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+	void AppendHistogram(FString& Json, const TCHAR* Name, const FCombatFieldHistogram& Histogram)
+	{
+		Json += FString::Printf(TEXT("\"%s\":{\"n\":%u,\"mean\":%.3f,\"p50\":%.3f,\"p95\":%.3f,\"p99\":%.3f,\"max\":%.3f,\"base\":%g,\"b\":["),
+			Name, Histogram.SampleCount, Histogram.GetMean(), Histogram.GetPercentile(0.50), Histogram.GetPercentile(0.95),
+			Histogram.GetPercentile(0.99), Histogram.Max, Histogram.Base);
+
+		// sparse: most buckets of a session are empty
+		bool bFirst = true;
+		for (int32 Index = 0; Index < FCombatFieldHistogram::NumBuckets; ++Index)
+		{
+			if (Histogram.Buckets[Index] > 0)
+			{
+				Json += FString::Printf(TEXT("%s[%d,%u]"), bFirst ? TEXT("") : TEXT(","), Index, Histogram.Buckets[Index]);
+				bFirst = false;
+			}
+		}
+		Json += TEXT("]}");
+	}
+
+	FString EscapeJson(const FString& Value)
+	{
+		return Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+	}
+
+	uint64 GetTotalBudgetCycles()
+	{
+		uint64 TotalCycles = 0;
+		for (int32 Index = 0; Index < static_cast<int32>(ECombatBudgetCategory::Count); ++Index)
+		{
+			TotalCycles += CombatBudget::GetTotalCycles(static_cast<ECombatBudgetCategory>(Index));
+		}
+		return TotalCycles;
+	}
+}
+
+// ============================================================================
+// HISTOGRAM
+// ============================================================================
+
+double FCombatFieldHistogram::GetPercentile(double Percentile) const
+{
+	if (SampleCount == 0)
+	{
+		return 0.0;
+	}
+
+	const uint32 Target = FMath::Max<uint32>(1, static_cast<uint32>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 1.0) * SampleCount)));
+	uint32 Cumulative = 0;
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Cumulative += Buckets[Index];
+		if (Cumulative >= Target)
+		{
+			return FMath::Min(GetBucketUpper(Index), Max);
+		}
+	}
+	return Max;
+}
+
+// ============================================================================
+// BATCH
+// ============================================================================
+
+FString FCombatFieldTelemetryBatch::ToJson() const
+{
+	FString Json;
+	Json.Reserve(1024);
+
+	Json += FString::Printf(TEXT("{\"session\":\"%s\",\"seq\":%d,\"duration\":%.1f,\"frames\":%d,"), *SessionId, Sequence, Duration, NumCombatFrames);
+	Json += FString::Printf(TEXT("\"device\":{\"platform\":\"%s\",\"cpu\":\"%s\",\"gpu\":\"%s\",\"cores\":%d},"),
+		*EscapeJson(FPlatformProperties::IniPlatformName()), *EscapeJson(FPlatformMisc::GetCPUBrand().TrimStartAndEnd()),
+		*EscapeJson(FPlatformMisc::GetPrimaryGPUBrand().TrimStartAndEnd()), FPlatformMisc::NumberOfCores());
+	Json += FString::Printf(TEXT("\"actions\":{\"queued\":%d,\"executed\":%d,\"cancelled\":%d},"), ActionsQueued, ActionsExecuted, ActionsCancelled);
+
+	AppendHistogram(Json, TEXT("immediate_execute_ms"), InputToExecuteMs[0]);
+	Json += TEXT(",");
+	AppendHistogram(Json, TEXT("queued_execute_ms"), InputToExecuteMs[1]);
+	Json += TEXT(",");
+	AppendHistogram(Json, TEXT("immediate_first_frame_ms"), InputToFirstFrameMs[0]);
+	Json += TEXT(",");
+	AppendHistogram(Json, TEXT("queued_first_frame_ms"), InputToFirstFrameMs[1]);
+	Json += TEXT(",");
+	AppendHistogram(Json, TEXT("queue_depth"), QueueDepth);
+	Json += TEXT(",");
+	AppendHistogram(Json, TEXT("combat_frame_ms"), CombatFrameMs);
+	Json += TEXT(",");
+	AppendHistogram(Json, TEXT("traces_per_frame"), TracesPerFrame);
+	Json += TEXT("}");
+
+	return Json;
+}
+
+// ============================================================================
+// SESSION
+// ============================================================================
+
+FCombatFieldTelemetry& FCombatFieldTelemetry::Get()
+{
+	static FCombatFieldTelemetry Telemetry;
+	return Telemetry;
+}
+
+FCombatFieldTelemetry::~FCombatFieldTelemetry()
+{
+	// static destruction: too late to upload, the engine is gone
+	bEnabled = false;
+}
+
+void FCombatFieldTelemetry::Start(const FString& InUploadUrl, double InUploadInterval)
+{
+	if (bEnabled)
+	{
+		Stop();
+	}
+
+	static bool bRegisteredExit = false;
+	if (!bRegisteredExit)
+	{
+		bRegisteredExit = true;
+		FCoreDelegates::OnEnginePreExit.AddLambda([]() { FCombatFieldTelemetry::Get().Stop(); });
+	}
+
+	UploadUrl = InUploadUrl;
+	UploadInterval = FMath::Max(InUploadInterval, 1.0);
+	SessionId = FGuid::NewGuid().ToString(EGuidFormats::DigitsLower);
+	NextSequence = 0;
+	bEnabled = true;
+
+	BeginBatch();
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCombatFieldTelemetry::Tick));
+
+	UE_LOG(LogCombat, Log, TEXT("[FieldTelemetry] Session %s started (%s every %.0fs)"), *SessionId, UploadUrl.IsEmpty() ? TEXT("file") : *UploadUrl, UploadInterval);
+}
+
+void FCombatFieldTelemetry::Stop()
+{
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	Flush();
+	bEnabled = false;
+
+	UE_LOG(LogCombat, Log, TEXT("[FieldTelemetry] Session %s stopped after %d batches"), *SessionId, NextSequence);
+}
+
+void FCombatFieldTelemetry::Flush()
+{
+	FCombatFieldTelemetryBatch Closed = TakeBatch();
+	if (Closed.IsEmpty())
+	{
+		// nothing sent: the open batch takes the unused number so receivers see no gap
+		Batch.Sequence = Closed.Sequence;
+		NextSequence = Closed.Sequence + 1;
+		return;
+	}
+
+	const FString Json = Closed.ToJson();
+	if (Uploader)
+	{
+		Uploader(Json);
+	}
+	else
+	{
+		Upload(Closed, Json);
+	}
+}
+
+FCombatFieldTelemetryBatch FCombatFieldTelemetry::TakeBatch()
+{
+	Batch.Duration = FPlatformTime::Seconds() - BatchStartTime;
+	FCombatFieldTelemetryBatch Closed = MoveTemp(Batch);
+	BeginBatch();
+	return Closed;
+}
+
+void FCombatFieldTelemetry::BeginBatch()
+{
+	Batch = FCombatFieldTelemetryBatch();
+	Batch.SessionId = SessionId;
+	Batch.Sequence = NextSequence++;
+	BatchStartTime = FPlatformTime::Seconds();
+
+	// frame deltas restart here
+	LastBudgetCycles = GetTotalBudgetCycles();
+	LastPhysicsQueries = CombatBudget::GetTotalPhysicsQueries();
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+void FCombatFieldTelemetry::RecordQueueEvent(CombatTrace::EQueueEvent Event)
+{
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	switch (Event)
+	{
+		case CombatTrace::EQueueEvent::Queued:
+			++Batch.ActionsQueued;
+			break;
+		case CombatTrace::EQueueEvent::Executed:
+			++Batch.ActionsExecuted;
+			break;
+		case CombatTrace::EQueueEvent::Cancelled:
+			++Batch.ActionsCancelled;
+			break;
+	}
+}
+
+void FCombatFieldTelemetry::SampleFrame()
+{
+	const uint64 BudgetCycles = GetTotalBudgetCycles();
+	const uint64 PhysicsQueries = CombatBudget::GetTotalPhysicsQueries();
+	const uint64 FrameCycles = BudgetCycles - LastBudgetCycles;
+	const uint64 FrameQueries = PhysicsQueries - LastPhysicsQueries;
+	LastBudgetCycles = BudgetCycles;
+	LastPhysicsQueries = PhysicsQueries;
+
+	// menus and loading screens would only pile up zeros
+	if (FrameCycles == 0 && FrameQueries == 0)
+	{
+		return;
+	}
+
+	++Batch.NumCombatFrames;
+	Batch.CombatFrameMs.Add(FPlatformTime::ToMilliseconds64(FrameCycles));
+	Batch.TracesPerFrame.Add(static_cast<double>(FrameQueries));
+}
+
+bool FCombatFieldTelemetry::Tick(float DeltaTime)
+{
+	SampleFrame();
+
+	if (FPlatformTime::Seconds() - BatchStartTime >= UploadInterval)
+	{
+		Flush();
+	}
+
+	return true;
+}
+
+void FCombatFieldTelemetry::Upload(const FCombatFieldTelemetryBatch& Closed, const FString& Json) const
+{
+	if (!UploadUrl.IsEmpty())
+	{
+		const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+		Request->SetURL(UploadUrl);
+		Request->SetVerb(TEXT("POST"));
+		Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+		Request->SetContentAsString(Json);
+		Request->OnProcessRequestComplete().BindLambda([](FHttpRequestPtr, FHttpResponsePtr Response, bool bSucceeded)
+		{
+			if (!bSucceeded || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+			{
+				UE_LOG(LogCombat, Verbose, TEXT("[FieldTelemetry] Upload failed (%d)"), Response.IsValid() ? Response->GetResponseCode() : 0);
+			}
+		});
+		Request->ProcessRequest();
+		return;
+	}
+
+	// no endpoint: leave the batch for a platform service (or a developer) to collect
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Combat/FieldTelemetry") / FString::Printf(TEXT("%s_%04d.json"), *Closed.SessionId, Closed.Sequence);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [FilePath, Json]()
+	{
+		FFileHelper::SaveStringToFile(Json, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	});
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+
+static FAutoConsoleCommand GCombatFieldTelemetryStartCommand(
+	TEXT("Combat.FieldTelemetry.Start"),
+	TEXT("Aggregate combat latency and cost into batches uploaded every 5 minutes. Optional argument: upload URL (default: files in Saved/Combat/FieldTelemetry)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FCombatFieldTelemetry::Get().Start(Args.Num() > 0 ? Args[0] : FString());
+	}));
+
+static FAutoConsoleCommand GCombatFieldTelemetryStopCommand(
+	TEXT("Combat.FieldTelemetry.Stop"),
+	TEXT("Upload the open batch and stop the field telemetry session"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FCombatFieldTelemetry::Get().Stop();
+	}));
+
+static FAutoConsoleCommand GCombatFieldTelemetryDumpCommand(
+	TEXT("Combat.FieldTelemetry.Dump"),
+	TEXT("Log the batch aggregating now as it would be uploaded"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		UE_LOG(LogCombat, Log, TEXT("[FieldTelemetry] %s"), *FCombatFieldTelemetry::Get().GetCurrentBatch().ToJson());
+	}));
+
+/** -CombatFieldTelemetry[=Url]: record from startup */
+static FDelayedAutoRegisterHelper GCombatFieldTelemetryCommandLine(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+{
+	FString Url;
+	if (FParse::Value(FCommandLine::Get(), TEXT("CombatFieldTelemetry="), Url) || FParse::Param(FCommandLine::Get(), TEXT("CombatFieldTelemetry")))
+	{
+		FCombatFieldTelemetry::Get().Start(Url);
+	}
+});
@@ -0,0 +1,292 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatHitchDetector.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Tasks/Task.h"
+#include "UObject/UObjectArray.h"
+
+namespace
+{
+	const TCHAR* GetBudgetCategoryName(int32 Index)
+	{
+		static const TCHAR* CategoryNames[] = { TEXT("Traces"), TEXT("Targeting"), TEXT("Queue"), TEXT("Anim") };
+		static_assert(UE_ARRAY_COUNT(CategoryNames) == static_cast<int32>(ECombatBudgetCategory::Count), "One name per budget category");
+		return CategoryNames[Index];
+	}
+
+	FString ResolveObjectName(uint32 UniqueId)
+	{
+		const FUObjectItem* Item = GUObjectArray.IndexToObject(static_cast<int32>(UniqueId));
+		const UObject* Object = Item ? static_cast<const UObject*>(Item->Object) : nullptr;
+		return Object && Object->GetUniqueID() == UniqueId ? Object->GetName() : FString::Printf(TEXT("#%u"), UniqueId);
+	}
+}
+
+// ============================================================================
+// REPORT
+// ============================================================================
+
+double FCombatHitchReport::GetCombatMs() const
+{
+	double CombatMs = 0.0;
+	for (const double CategoryMs : SystemMs)
+	{
+		CombatMs += CategoryMs;
+	}
+	return CombatMs;
+}
+
+int32 FCombatHitchReport::CountFrameEvents(ECombatRecordedEventType Type) const
+{
+	int32 Count = 0;
+	for (const FCombatRecordedEvent& Event : Events)
+	{
+		Count += Event.Type == Type && Event.Cycle >= FrameStartCycle ? 1 : 0;
+	}
+	return Count;
+}
+
+FString FCombatHitchReport::ToString() const
+{
+	auto GetName = [this](uint32 UniqueId) -> FString
+	{
+		const FString* Name = ObjectNames.Find(UniqueId);
+		return UniqueId == 0 ? FString() : Name ? *Name : FString::Printf(TEXT("#%u"), UniqueId);
+	};
+
+	FString Text;
+	Text.Reserve(256 + Events.Num() * 64);
+
+	Text += FString::Printf(TEXT("Combat hitch %s: %.1fms frame, %.2fms combat, %llu physics queries, %llu events\n"),
+		*Time.ToString(), FrameMs, GetCombatMs(), PhysicsQueries, NumFrameEvents);
+
+	Text += TEXT("Systems:");
+	for (int32 Index = 0; Index < static_cast<int32>(ECombatBudgetCategory::Count); ++Index)
+	{
+		Text += FString::Printf(TEXT(" %s %.3fms"), GetBudgetCategoryName(Index), SystemMs[Index]);
+	}
+	Text += TEXT("\n");
+
+	// what the frame was made of: a cleave is a run of hits, a wave spawn a burst of phase changes
+	Text += TEXT("Frame events:");
+	for (uint8 Type = 0; Type <= static_cast<uint8>(ECombatRecordedEventType::Hit); ++Type)
+	{
+		if (const int32 Count = CountFrameEvents(static_cast<ECombatRecordedEventType>(Type)))
+		{
+			Text += FString::Printf(TEXT(" %s %d"), LexToString(static_cast<ECombatRecordedEventType>(Type)), Count);
+		}
+	}
+	Text += TEXT("\n\n");
+
+	// times from the frame start: negative events led up to the hitch
+	Text += TEXT("Ms,Type,Owner,Subject,Arg0,Arg1,Arg2,Arg3,Value\n");
+	for (const FCombatRecordedEvent& Event : Events)
+	{
+		const double Ms = Event.Cycle >= FrameStartCycle
+			? FPlatformTime::ToMilliseconds64(Event.Cycle - FrameStartCycle)
+			: -FPlatformTime::ToMilliseconds64(FrameStartCycle - Event.Cycle);
+		Text += FString::Printf(TEXT("%.3f,%s,%s,%s,%u,%u,%u,%u,%.4f\n"),
+			Ms, LexToString(Event.Type), *GetName(Event.OwnerId), *GetName(Event.SubjectId),
+			Event.Arg0, Event.Arg1, Event.Arg2, Event.Arg3, Event.Value);
+	}
+
+	return Text;
+}
+
+// ============================================================================
+// DETECTOR
+// ============================================================================
+
+FCombatHitchDetector& FCombatHitchDetector::Get()
+{
+	static FCombatHitchDetector Detector;
+	return Detector;
+}
+
+FCombatHitchDetector::~FCombatHitchDetector()
+{
+	// static destruction: the ticker is already gone
+	bEnabled = false;
+}
+
+void FCombatHitchDetector::Start(double InThresholdMs, int32 InNumEvents)
+{
+	static bool bRegisteredExit = false;
+	if (!bRegisteredExit)
+	{
+		bRegisteredExit = true;
+		FCoreDelegates::OnEnginePreExit.AddLambda([]() { FCombatHitchDetector::Get().Stop(); });
+	}
+
+	ThresholdMs = FMath::Max(InThresholdMs, 1.0);
+	NumEvents = FMath::Clamp(InNumEvents, 0, static_cast<int32>(FCombatEventRecorder::Capacity));
+	NumHitches = 0;
+	NumReports = 0;
+	LastReportTime = -UE_BIG_NUMBER;
+
+	// frame timing restarts here
+	FrameStartCycle = FPlatformTime::Cycles64();
+	for (int32 Index = 0; Index < static_cast<int32>(ECombatBudgetCategory::Count); ++Index)
+	{
+		FrameStartBudgetCycles[Index] = CombatBudget::GetTotalCycles(static_cast<ECombatBudgetCategory>(Index));
+	}
+	FrameStartPhysicsQueries = CombatBudget::GetTotalPhysicsQueries();
+	FrameStartNumRecorded = FCombatEventRecorder::Get().GetNumRecorded();
+
+	if (!bEnabled)
+	{
+		bEnabled = true;
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCombatHitchDetector::Tick));
+	}
+
+	UE_LOG(LogCombat, Log, TEXT("[CombatHitch] Reporting frames over %.0fms with the last %d combat events"), ThresholdMs, NumEvents);
+}
+
+void FCombatHitchDetector::Stop()
+{
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+	bEnabled = false;
+
+	UE_LOG(LogCombat, Log, TEXT("[CombatHitch] Stopped after %d hitches (%d reported)"), NumHitches, NumReports);
+}
+
+bool FCombatHitchDetector::CheckFrame(double FrameSeconds)
+{
+	if (!bEnabled)
+	{
+		return false;
+	}
+
+	// totals now become the start of the next frame either way
+	uint64 BudgetCycles[static_cast<int32>(ECombatBudgetCategory::Count)];
+	for (int32 Index = 0; Index < static_cast<int32>(ECombatBudgetCategory::Count); ++Index)
+	{
+		BudgetCycles[Index] = CombatBudget::GetTotalCycles(static_cast<ECombatBudgetCategory>(Index));
+	}
+	const uint64 PhysicsQueries = CombatBudget::GetTotalPhysicsQueries();
+	const uint64 NumRecorded = FCombatEventRecorder::Get().GetNumRecorded();
+	const uint64 FrameEndCycle = FPlatformTime::Cycles64();
+
+	const double FrameMs = FrameSeconds * 1000.0;
+	bool bReported = false;
+	if (FrameMs > ThresholdMs)
+	{
+		++NumHitches;
+
+		const double Now = FPlatformTime::Seconds();
+		if (NumReports < MaxReports && Now - LastReportTime >= MinReportInterval)
+		{
+			++NumReports;
+			LastReportTime = Now;
+			bReported = true;
+
+			FCombatHitchReport Report;
+			Report.Time = FDateTime::Now();
+			Report.FrameMs = FrameMs;
+			Report.FrameStartCycle = FrameStartCycle;
+			for (int32 Index = 0; Index < static_cast<int32>(ECombatBudgetCategory::Count); ++Index)
+			{
+				Report.SystemMs[Index] = FPlatformTime::ToMilliseconds64(BudgetCycles[Index] - FrameStartBudgetCycles[Index]);
+			}
+			Report.PhysicsQueries = PhysicsQueries - FrameStartPhysicsQueries;
+			Report.NumFrameEvents = NumRecorded - FrameStartNumRecorded;
+
+			{
+				COMBAT_LLM_SCOPE(DebugRecorder);
+				FCombatEventRecorder::Get().Snapshot(Report.Events, NumEvents);
+
+				// names now: the cleaved enemies may be gone by the time anyone reads the report
+				for (const FCombatRecordedEvent& Event : Report.Events)
+				{
+					for (const uint32 UniqueId : { Event.OwnerId, Event.SubjectId })
+					{
+						if (UniqueId != 0 && !Report.ObjectNames.Contains(UniqueId))
+						{
+							Report.ObjectNames.Add(UniqueId, ResolveObjectName(UniqueId));
+						}
+					}
+				}
+			}
+
+			UE_LOG(LogCombat, Warning, TEXT("[CombatHitch] %.1fms frame: %.2fms combat, %llu physics queries, %llu events, %d hits"),
+				Report.FrameMs, Report.GetCombatMs(), Report.PhysicsQueries, Report.NumFrameEvents, Report.CountFrameEvents(ECombatRecordedEventType::Hit));
+
+			if (ReportHandler)
+			{
+				ReportHandler(Report);
+			}
+			else
+			{
+				WriteReport(Report);
+			}
+		}
+	}
+
+	FrameStartCycle = FrameEndCycle;
+	FMemory::Memcpy(FrameStartBudgetCycles, BudgetCycles, sizeof(BudgetCycles));
+	FrameStartPhysicsQueries = PhysicsQueries;
+	FrameStartNumRecorded = NumRecorded;
+
+	return bReported;
+}
+
+bool FCombatHitchDetector::Tick(float DeltaTime)
+{
+	// wall clock, not DeltaTime: fixed or clamped timesteps would hide the hitch
+	CheckFrame(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - FrameStartCycle));
+	return true;
+}
+
+void FCombatHitchDetector::WriteReport(const FCombatHitchReport& Report)
+{
+	// formatted here, written off the game thread: this frame is already long enough
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Combat/Hitches") / FString::Printf(TEXT("Hitch_%s_%.0fms.txt"), *Report.Time.ToString(), Report.FrameMs);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [FilePath, Text = Report.ToString()]()
+	{
+		FFileHelper::SaveStringToFile(Text, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	});
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+
+static FAutoConsoleCommand GCombatHitchStartCommand(
+	TEXT("Combat.Hitch.Start"),
+	TEXT("Report long frames with the combat events and system timers that led to them. Optional arguments: threshold ms (default 50), events per report (default 128)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FCombatHitchDetector::Get().Start(Args.Num() > 0 ? FCString::Atod(*Args[0]) : 50.0, Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 128);
+	}));
+
+static FAutoConsoleCommand GCombatHitchStopCommand(
+	TEXT("Combat.Hitch.Stop"),
+	TEXT("Stop reporting long frames"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FCombatHitchDetector::Get().Stop();
+	}));
+
+/** On by default outside the editor and Shipping; -CombatHitchCapture[=ThresholdMs] anywhere else */
+static FDelayedAutoRegisterHelper GCombatHitchCommandLine(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+{
+	double Threshold = 50.0;
+	const bool bRequested = FParse::Value(FCommandLine::Get(), TEXT("CombatHitchCapture="), Threshold) || FParse::Param(FCommandLine::Get(), TEXT("CombatHitchCapture"));
+	const bool bByDefault = !UE_BUILD_SHIPPING && !GIsEditor && !FParse::Param(FCommandLine::Get(), TEXT("NoCombatHitchCapture"));
+	if (bRequested || bByDefault)
+	{
+		FCombatHitchDetector::Get().Start(Threshold);
+	}
+});
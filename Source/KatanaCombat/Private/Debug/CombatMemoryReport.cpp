@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatEventRecorder.h"
+#include "Characters/SamuraiCharacter.h"
+#include "Core/CombatComponentV2.h"
+#include "Core/HitReactionComponent.h"
+#include "Core/MontageCheckpointCache.h"
+#include "Data/CombatArchetype.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/ArchiveCountMem.h"
+
+namespace
+{
+	/** Object itself + reflected containers + native containers reported through GetResourceSizeEx */
+	SIZE_T GetCombatObjectSize(UObject* Object)
+	{
+		FArchiveCountMem Counter(Object);
+		return Object->GetClass()->GetStructureSize() + Counter.GetMax() + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	/** Components declared by the combat module (engine components like movement are left out) */
+	bool IsCombatComponent(const UActorComponent* Component)
+	{
+		return Component && Component->GetClass()->GetOutermost() == UCombatComponentV2::StaticClass()->GetOutermost();
+	}
+
+	void DumpWorld(UWorld* World, const FString& NameFilter, SIZE_T& InOutTotal)
+	{
+		TSet<const UCombatArchetype*> Archetypes;
+		int32 NumCharacters = 0;
+		SIZE_T WorldTotal = 0;
+
+		for (TActorIterator<ASamuraiCharacter> It(World); It; ++It)
+		{
+			ASamuraiCharacter* Character = *It;
+			if (!NameFilter.IsEmpty() && !Character->GetName().Contains(NameFilter))
+			{
+				continue;
+			}
+
+			SIZE_T CharacterTotal = 0;
+			FString Breakdown;
+			for (UActorComponent* Component : Character->GetComponents())
+			{
+				if (IsCombatComponent(Component))
+				{
+					const SIZE_T Size = GetCombatObjectSize(Component);
+					CharacterTotal += Size;
+					Breakdown += FString::Printf(TEXT(" %s=%.1f"), *Component->GetClass()->GetName(), Size / 1024.0);
+				}
+			}
+
+			UE_LOG(LogCombat, Log, TEXT("  %-32s %8.1f KB |%s"), *Character->GetName(), CharacterTotal / 1024.0, *Breakdown);
+			WorldTotal += CharacterTotal;
+			++NumCharacters;
+
+			if (Character->CombatArchetype)
+			{
+				Archetypes.Add(Character->CombatArchetype);
+			}
+		}
+
+		// Shared data, counted once per world
+		if (const UMontageCheckpointCache* CheckpointCache = World->GetSubsystem<UMontageCheckpointCache>())
+		{
+			const SIZE_T Size = CheckpointCache->GetAllocatedSize();
+			UE_LOG(LogCombat, Log, TEXT("  Checkpoint cache: %d montages, %.1f KB"), CheckpointCache->GetNumCachedMontages(), Size / 1024.0);
+			WorldTotal += Size;
+		}
+
+		for (const UCombatArchetype* Archetype : Archetypes)
+		{
+			const SIZE_T Size = Archetype->GetReactionTable().GetAllocatedSize();
+			UE_LOG(LogCombat, Log, TEXT("  Archetype %s: reaction table %.1f KB (shared)"), *Archetype->GetName(), Size / 1024.0);
+			WorldTotal += Size;
+		}
+
+		UE_LOG(LogCombat, Log, TEXT("  %s: %d characters, %.1f KB (%.1f KB per character)"),
+			*World->GetName(), NumCharacters, WorldTotal / 1024.0, NumCharacters > 0 ? WorldTotal / 1024.0 / NumCharacters : 0.0);
+		InOutTotal += WorldTotal;
+	}
+}
+
+static FAutoConsoleCommand GCombatDumpMemoryCommand(
+	TEXT("Combat.DumpMemory"),
+	TEXT("Log combat memory per character (combat components, reflected and native containers) plus shared caches. Optional argument: character name filter. Run with -llm for per-tag totals (Combat/*)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString NameFilter = Args.Num() > 0 ? Args[0] : FString();
+		SIZE_T Total = 0;
+
+		UE_LOG(LogCombat, Log, TEXT("[CombatMemory] Per-character combat memory (KB):"));
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (World && World->IsGameWorld())
+			{
+				DumpWorld(World, NameFilter, Total);
+			}
+		}
+
+		UE_LOG(LogCombat, Log, TEXT("[CombatMemory] Event recorder ring: %.1f KB"), sizeof(FCombatEventRecorder) / 1024.0);
+		UE_LOG(LogCombat, Log, TEXT("[CombatMemory] Total (excluding recorder): %.1f KB"), Total / 1024.0);
+	}));
@@ -0,0 +1,415 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatReplayComponent.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatCapture.h"
+#include "Core/CombatComponentV2.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr uint32 ReplayFileMagic = 0x4B435250; // "KCRP"
+	constexpr uint32 ReplayFileVersion = 1;
+}
+
+// ============================================================================
+// STREAM
+// ============================================================================
+
+bool FCombatReplayStream::IsComparedEvent(const FCombatRecordedEvent& Event)
+{
+	return Event.Type == ECombatRecordedEventType::Phase || Event.Type == ECombatRecordedEventType::Queue;
+}
+
+FCombatReplayExpectedEvent FCombatReplayStream::ToExpected(const FCombatRecordedEvent& Event)
+{
+	FCombatReplayExpectedEvent Expected;
+	Expected.Type = Event.Type;
+	Expected.Arg0 = Event.Arg0;
+	Expected.Arg1 = Event.Arg1;
+	Expected.Arg2 = Event.Arg2;
+	return Expected;
+}
+
+FCombatReplayStream FCombatReplayStream::FromEvents(TConstArrayView<FCombatRecordedEvent> Events, uint32 OwnerId)
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+	FCombatReplayStream Stream;
+
+	uint64 FirstCycle = 0;
+	bool bHasFirst = false;
+
+	for (const FCombatRecordedEvent& Event : Events)
+	{
+		if (Event.OwnerId != OwnerId)
+		{
+			continue;
+		}
+
+		// Stream starts at the first input - earlier phase/queue events belong to another run
+		if (!bHasFirst)
+		{
+			if (Event.Type != ECombatRecordedEventType::Input)
+			{
+				continue;
+			}
+			FirstCycle = Event.Cycle;
+			bHasFirst = true;
+		}
+
+		const float Time = static_cast<float>(FPlatformTime::ToSeconds64(Event.Cycle - FirstCycle));
+		Stream.Duration = FMath::Max(Stream.Duration, Time);
+
+		if (Event.Type == ECombatRecordedEventType::Input)
+		{
+			FCombatReplayInput& Input = Stream.Inputs.AddDefaulted_GetRef();
+			Input.Time = Time;
+			Input.InputType = static_cast<EInputType>(Event.Arg0);
+			Input.EventType = static_cast<EInputEventType>(Event.Arg1);
+			Input.Direction = static_cast<EInputDirection>(Event.Arg3);
+		}
+		else if (IsComparedEvent(Event))
+		{
+			Stream.Expected.Add(ToExpected(Event));
+		}
+	}
+
+	return Stream;
+}
+
+int32 FCombatReplayStream::FromCapture(const FCombatCaptureReader& Reader, TArray<FCombatReplayStream>& OutStreams, TArray<FString>* OutOwnerNames)
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+	OutStreams.Reset();
+	if (OutOwnerNames)
+	{
+		OutOwnerNames->Reset();
+	}
+
+	// One pass over the capture, split by owner
+	TMap<uint32, TArray<FCombatRecordedEvent>> OwnerEvents;
+	TSet<uint32> OwnersWithInput;
+	Reader.ForEachEvent([&OwnerEvents, &OwnersWithInput](const FCombatRecordedEvent& Event)
+	{
+		if (Event.OwnerId == 0)
+		{
+			return;
+		}
+
+		OwnerEvents.FindOrAdd(Event.OwnerId).Add(Event);
+		if (Event.Type == ECombatRecordedEventType::Input)
+		{
+			OwnersWithInput.Add(Event.OwnerId);
+		}
+	});
+
+	// Name table order, so the same capture always yields the same stream order
+	OwnerEvents.KeySort(TLess<uint32>());
+	for (const TPair<uint32, TArray<FCombatRecordedEvent>>& Pair : OwnerEvents)
+	{
+		if (!OwnersWithInput.Contains(Pair.Key))
+		{
+			continue;
+		}
+
+		OutStreams.Add(FromEvents(Pair.Value, Pair.Key));
+		if (OutOwnerNames)
+		{
+			OutOwnerNames->Add(Reader.GetName(Pair.Key));
+		}
+	}
+
+	return OutStreams.Num();
+}
+
+FArchive& operator<<(FArchive& Ar, FCombatReplayStream& Stream)
+{
+	Ar << Stream.Duration;
+
+	int32 NumInputs = Stream.Inputs.Num();
+	Ar << NumInputs;
+	if (Ar.IsLoading())
+	{
+		Stream.Inputs.SetNum(NumInputs);
+	}
+	for (FCombatReplayInput& Input : Stream.Inputs)
+	{
+		Ar << Input.Time << Input.InputType << Input.EventType << Input.Direction;
+	}
+
+	int32 NumExpected = Stream.Expected.Num();
+	Ar << NumExpected;
+	if (Ar.IsLoading())
+	{
+		Stream.Expected.SetNum(NumExpected);
+	}
+	for (FCombatReplayExpectedEvent& Expected : Stream.Expected)
+	{
+		Ar << Expected.Type << Expected.Arg0 << Expected.Arg1 << Expected.Arg2;
+	}
+
+	return Ar;
+}
+
+bool FCombatReplayStream::SaveToFile(const FString& FilePath) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = ReplayFileMagic;
+	uint32 Version = ReplayFileVersion;
+	Writer << Magic << Version;
+	Writer << const_cast<FCombatReplayStream&>(*this);
+
+	return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FCombatReplayStream::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic << Version;
+	if (Magic != ReplayFileMagic || Version != ReplayFileVersion)
+	{
+		UE_LOG(LogCombat, Warning, TEXT("[CombatReplay] %s is not a combat replay (or was written by another version)"), *FilePath);
+		return false;
+	}
+
+	Reader << *this;
+	return !Reader.IsError();
+}
+
+// ============================================================================
+// COMPARISON
+// ============================================================================
+
+FCombatReplayResult FCombatReplayResult::Compare(TConstArrayView<FCombatReplayExpectedEvent> Expected, TConstArrayView<FCombatReplayExpectedEvent> Actual)
+{
+	FCombatReplayResult Result;
+	Result.NumCompared = FMath::Min(Expected.Num(), Actual.Num());
+
+	for (int32 i = 0; i < Result.NumCompared; ++i)
+	{
+		if (!(Expected[i] == Actual[i]))
+		{
+			Result.FirstMismatchIndex = i;
+			Result.Description = FString::Printf(TEXT("Event %d differs: expected type %d (%d,%d,%d), got type %d (%d,%d,%d)"),
+				i,
+				static_cast<int32>(Expected[i].Type), Expected[i].Arg0, Expected[i].Arg1, Expected[i].Arg2,
+				static_cast<int32>(Actual[i].Type), Actual[i].Arg0, Actual[i].Arg1, Actual[i].Arg2);
+			return Result;
+		}
+	}
+
+	if (Expected.Num() != Actual.Num())
+	{
+		Result.FirstMismatchIndex = Result.NumCompared;
+		Result.Description = FString::Printf(TEXT("Event count differs: expected %d, got %d"), Expected.Num(), Actual.Num());
+		return Result;
+	}
+
+	Result.bMatched = true;
+	Result.Description = FString::Printf(TEXT("Matched %d events"), Result.NumCompared);
+	return Result;
+}
+
+// ============================================================================
+// COMPONENT
+// ============================================================================
+
+UCombatReplayComponent::UCombatReplayComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	// Inputs must reach V2 before it reacts to this frame's notifies
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UCombatReplayComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (AActor* Owner = GetOwner())
+	{
+		CombatComponent = Owner->FindComponentByClass<UCombatComponentV2>();
+		if (!CombatComponent)
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatReplay] No CombatComponentV2 found on %s"), *Owner->GetName());
+		}
+	}
+}
+
+void UCombatReplayComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bReplaying)
+	{
+		StopReplay();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool UCombatReplayComponent::SaveCapture(const FString& FilePath) const
+{
+	TArray<FCombatRecordedEvent> Events;
+	FCombatEventRecorder::Get().Snapshot(Events);
+
+	const FCombatReplayStream Stream = FCombatReplayStream::FromEvents(Events, GetOwner() ? GetOwner()->GetUniqueID() : 0);
+	if (Stream.IsEmpty())
+	{
+		UE_LOG(LogCombat, Warning, TEXT("[CombatReplay] No recorded input for %s - nothing to save"), *GetNameSafe(GetOwner()));
+		return false;
+	}
+
+	return Stream.SaveToFile(FilePath);
+}
+
+bool UCombatReplayComponent::StartReplayFromFile(const FString& FilePath)
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+	FCombatReplayStream Stream;
+	return Stream.LoadFromFile(FilePath) && StartReplay(Stream);
+}
+
+bool UCombatReplayComponent::StartReplayFromCapture(const FString& CapturePath)
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+	FCombatCaptureReader Reader;
+	if (!Reader.Open(CapturePath))
+	{
+		UE_LOG(LogCombat, Warning, TEXT("[CombatReplay] Could not read capture %s"), *CapturePath);
+		return false;
+	}
+
+	const uint32 OwnerIndex = Reader.FindName(GetNameSafe(GetOwner()));
+	if (OwnerIndex == 0)
+	{
+		UE_LOG(LogCombat, Warning, TEXT("[CombatReplay] %s does not appear in capture %s"), *GetNameSafe(GetOwner()), *CapturePath);
+		return false;
+	}
+
+	TArray<FCombatRecordedEvent> Events;
+	Reader.ReadEvents(Events, OwnerIndex);
+	return StartReplay(FCombatReplayStream::FromEvents(Events, OwnerIndex));
+}
+
+bool UCombatReplayComponent::StartReplay(const FCombatReplayStream& Stream)
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+	if (!CombatComponent || Stream.IsEmpty())
+	{
+		return false;
+	}
+
+	if (bReplaying)
+	{
+		StopReplay();
+	}
+
+	ActiveStream = Stream;
+	ReplayTime = 0.0f;
+	NextInputIndex = 0;
+	RecordStartIndex = FCombatEventRecorder::Get().GetNumRecorded();
+
+	// Start from a clean component so the first input sees the same state as the capture
+	CombatComponent->ClearQueue(true);
+
+	// Same step every frame regardless of hitches
+	bSavedUseFixedTimeStep = FApp::UseFixedTimeStep();
+	SavedFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(FixedTimeStep);
+
+	bReplaying = true;
+	SetComponentTickEnabled(true);
+
+	UE_LOG(LogCombat, Log, TEXT("[CombatReplay] Replaying %d inputs (%.2fs, %d expected events) at %.4fs steps"),
+		ActiveStream.Inputs.Num(), ActiveStream.Duration, ActiveStream.Expected.Num(), FixedTimeStep);
+	return true;
+}
+
+void UCombatReplayComponent::StopReplay()
+{
+	if (bReplaying)
+	{
+		FinishReplay();
+	}
+}
+
+void UCombatReplayComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!bReplaying)
+	{
+		return;
+	}
+
+	if (!IsValid(CombatComponent))
+	{
+		FinishReplay();
+		return;
+	}
+
+	// Dispatch every input due by the end of this step
+	ReplayTime += FixedTimeStep;
+	while (ActiveStream.Inputs.IsValidIndex(NextInputIndex) && ActiveStream.Inputs[NextInputIndex].Time <= ReplayTime)
+	{
+		const FCombatReplayInput& Input = ActiveStream.Inputs[NextInputIndex++];
+		CombatComponent->OnInputEvent(Input.InputType, Input.EventType, Input.Direction);
+	}
+
+	const bool bAllInputsSent = NextInputIndex >= ActiveStream.Inputs.Num();
+	if (bAllInputsSent && ReplayTime >= ActiveStream.Duration + SettleTime)
+	{
+		FinishReplay();
+	}
+}
+
+void UCombatReplayComponent::FinishReplay()
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+	bReplaying = false;
+	SetComponentTickEnabled(false);
+
+	FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+
+	// Events recorded since the replay started, for this owner only
+	const FCombatEventRecorder& Recorder = FCombatEventRecorder::Get();
+	const uint64 NumSinceStart = Recorder.GetNumRecorded() - RecordStartIndex;
+
+	TArray<FCombatRecordedEvent> Events;
+	Recorder.Snapshot(Events, static_cast<int32>(FMath::Min<uint64>(NumSinceStart, FCombatEventRecorder::Capacity)), GetOwner() ? GetOwner()->GetUniqueID() : 0);
+
+	TArray<FCombatReplayExpectedEvent> Actual;
+	Actual.Reserve(Events.Num());
+	for (const FCombatRecordedEvent& Event : Events)
+	{
+		if (FCombatReplayStream::IsComparedEvent(Event))
+		{
+			Actual.Add(FCombatReplayStream::ToExpected(Event));
+		}
+	}
+
+	LastResult = FCombatReplayResult::Compare(ActiveStream.Expected, Actual);
+	if (NumSinceStart > FCombatEventRecorder::Capacity)
+	{
+		LastResult.Description += TEXT(" (recorder ring wrapped during replay - comparison is truncated)");
+	}
+
+	UE_LOG(LogCombat, Log, TEXT("[CombatReplay] %s: %s"), LastResult.bMatched ? TEXT("MATCH") : TEXT("MISMATCH"), *LastResult.Description);
+	OnReplayFinished.Broadcast(LastResult);
+}
@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatStateTraceSubsystem.h"
+#include "Core/CombatComponent.h"
+#include "Core/CombatComponentV2.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+// ============================================================================
+// SUBSYSTEM
+// ============================================================================
+
+UCombatStateTraceSubsystem* UCombatStateTraceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCombatStateTraceSubsystem>() : nullptr;
+}
+
+bool UCombatStateTraceSubsystem::IsTickable() const
+{
+	return Sources.Num() > 0 && (CombatTrace::IsCombatStateTraceEnabled() || bWasEnabled);
+}
+
+TStatId UCombatStateTraceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatStateTraceSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatStateTraceSubsystem::Tick(float DeltaTime)
+{
+	COMBAT_TRACE_SCOPE(UCombatStateTraceSubsystem::Tick);
+
+	Super::Tick(DeltaTime);
+
+	const bool bEnabled = CombatTrace::IsCombatStateTraceEnabled();
+	const bool bResendAll = bEnabled && !bWasEnabled;
+	bWasEnabled = bEnabled;
+
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	CombatTrace::FCombatStateSample Sample;
+	for (int32 Index = Sources.Num() - 1; Index >= 0; --Index)
+	{
+		FSource& Source = Sources[Index];
+		const UCombatComponent* CombatComponent = Source.CombatComponent.Get();
+		if (!CombatComponent)
+		{
+			Sources.RemoveAtSwap(Index, EAllowShrinking::No);
+			continue;
+		}
+
+		MakeSample(CombatComponent, Source.CombatComponentV2.Get(), Sample);
+		if (!bResendAll && Source.bHasLastSample && Sample == Source.LastSample)
+		{
+			continue;
+		}
+
+		CombatTrace::OutputCombatState(CombatComponent->GetOwner(), Sample);
+		Source.LastSample = Sample;
+		Source.bHasLastSample = true;
+		++NumSamplesSent;
+	}
+}
+
+// ============================================================================
+// SOURCES
+// ============================================================================
+
+void UCombatStateTraceSubsystem::RegisterCombatComponent(UCombatComponent* CombatComponent)
+{
+	if (!CombatComponent || !CombatComponent->GetOwner())
+	{
+		return;
+	}
+
+	for (const FSource& Source : Sources)
+	{
+		if (Source.CombatComponent == CombatComponent)
+		{
+			return;
+		}
+	}
+
+	FSource& Source = Sources.AddDefaulted_GetRef();
+	Source.CombatComponent = CombatComponent;
+	Source.CombatComponentV2 = CombatComponent->GetOwner()->FindComponentByClass<UCombatComponentV2>();
+}
+
+void UCombatStateTraceSubsystem::MakeSample(const UCombatComponent* CombatComponent, const UCombatComponentV2* CombatComponentV2, CombatTrace::FCombatStateSample& OutSample)
+{
+	OutSample.Phase = CombatComponentV2 ? CombatComponentV2->GetCurrentPhase() : (CombatComponent ? CombatComponent->GetCurrentPhase() : EAttackPhase::None);
+	OutSample.CombatState = CombatComponent ? CombatComponent->GetCombatState() : ECombatState::Idle;
+	OutSample.Posture = CombatComponent ? static_cast<int16>(FMath::RoundToInt(CombatComponent->GetCurrentPosture())) : 0;
+	OutSample.MaxPosture = CombatComponent ? static_cast<int16>(FMath::RoundToInt(CombatComponent->GetMaxPosture())) : 0;
+	OutSample.ActiveWindows = 0;
+	OutSample.Queue.Reset();
+
+	if (!CombatComponentV2)
+	{
+		return;
+	}
+
+	for (const FTimerCheckpoint& Checkpoint : CombatComponentV2->Checkpoints)
+	{
+		if (Checkpoint.bActive)
+		{
+			OutSample.ActiveWindows |= static_cast<uint8>(1u << static_cast<uint8>(Checkpoint.WindowType));
+		}
+	}
+
+	for (const FActionQueueEntry& Entry : CombatComponentV2->ActionQueue)
+	{
+		OutSample.Queue.Add(static_cast<uint8>((static_cast<uint8>(Entry.InputAction.InputType) & 0x0F) | (static_cast<uint8>(Entry.State) << 4)));
+	}
+}
@@ -0,0 +1,314 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatTelemetry.h"
+
+#if COMBAT_TELEMETRY_ENABLED
+
+#include "Debug/CombatTrace.h"
+#include "Common/TcpSocketBuilder.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/Parse.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+namespace
+{
+	constexpr int32 SocketBufferSize = 64 * 1024;
+
+	void DestroySocket(FSocket*& Socket)
+	{
+		if (Socket)
+		{
+			Socket->Close();
+			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+			Socket = nullptr;
+		}
+	}
+
+	/** Console / command line server (heap-owned so engine exit, not static destruction, closes it) */
+	FCombatTelemetryServer* GActiveTelemetry = nullptr;
+
+	void StopActiveTelemetry()
+	{
+		delete GActiveTelemetry;
+		GActiveTelemetry = nullptr;
+	}
+
+	void StartActiveTelemetry(int32 Port)
+	{
+		static bool bRegisteredExit = false;
+		if (!bRegisteredExit)
+		{
+			bRegisteredExit = true;
+			FCoreDelegates::OnEnginePreExit.AddStatic(&StopActiveTelemetry);
+		}
+
+		StopActiveTelemetry();
+		GActiveTelemetry = new FCombatTelemetryServer();
+		if (GActiveTelemetry->Start(Port))
+		{
+			UE_LOG(LogCombat, Log, TEXT("[CombatTelemetry] Listening on port %d"), Port);
+		}
+		else
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatTelemetry] Could not listen on port %d"), Port);
+			StopActiveTelemetry();
+		}
+	}
+}
+
+// ============================================================================
+// SERVER
+// ============================================================================
+
+FCombatTelemetryServer::~FCombatTelemetryServer()
+{
+	Stop();
+}
+
+FCombatTelemetryServer* FCombatTelemetryServer::GetActive()
+{
+	return GActiveTelemetry;
+}
+
+bool FCombatTelemetryServer::Start(int32 InPort)
+{
+	check(IsInGameThread());
+	if (ListenSocket)
+	{
+		return false;
+	}
+
+	ListenSocket = FTcpSocketBuilder(TEXT("CombatTelemetryListen"))
+		.AsReusable()
+		.AsNonBlocking()
+		.BoundToPort(InPort)
+		.Listening(1)
+		.Build();
+	if (!ListenSocket)
+	{
+		return false;
+	}
+
+	Port = InPort;
+	NumBytesSent.store(0, std::memory_order_relaxed);
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FCombatTelemetryServer::Tick));
+	return true;
+}
+
+void FCombatTelemetryServer::Stop()
+{
+	if (!ListenSocket)
+	{
+		return;
+	}
+
+	FTSTicker::RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	DropClient(TEXT("server stopped"));
+	DestroySocket(ListenSocket);
+}
+
+bool FCombatTelemetryServer::Tick(float DeltaTime)
+{
+	if (ClientSocket)
+	{
+		if (bSendFailed.load(std::memory_order_relaxed))
+		{
+			DropClient(TEXT("viewer disconnected"));
+		}
+		else if (Writer && Writer->GetNumBytesQueued() > MaxQueuedBytes)
+		{
+			DropClient(TEXT("viewer too slow"));
+		}
+	}
+
+	// One viewer at a time; later connections wait in the backlog until the current one leaves
+	bool bHasPendingConnection = false;
+	if (!ClientSocket && ListenSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
+	{
+		AcceptClient();
+	}
+	return true;
+}
+
+void FCombatTelemetryServer::AcceptClient()
+{
+	ClientSocket = ListenSocket->Accept(TEXT("CombatTelemetryViewer"));
+	if (!ClientSocket)
+	{
+		return;
+	}
+
+	// Sends run on the writer's pipe, so blocking there never stalls the game thread
+	int32 ActualSize = 0;
+	ClientSocket->SetNonBlocking(false);
+	ClientSocket->SetNoDelay(true);
+	ClientSocket->SetSendBufferSize(SocketBufferSize, ActualSize);
+	bSendFailed.store(false, std::memory_order_relaxed);
+
+	FSocket* Socket = ClientSocket;
+	Writer = MakeUnique<FCombatCaptureWriter>();
+	const bool bStarted = Writer->StartStream([this, Socket](const uint8* Data, int32 NumBytes)
+	{
+		while (NumBytes > 0 && !bSendFailed.load(std::memory_order_relaxed))
+		{
+			int32 NumSent = 0;
+			if (!Socket->Send(Data, NumBytes, NumSent) || NumSent <= 0)
+			{
+				bSendFailed.store(true, std::memory_order_relaxed);
+				return;
+			}
+			Data += NumSent;
+			NumBytes -= NumSent;
+			NumBytesSent.fetch_add(NumSent, std::memory_order_relaxed);
+		}
+	}, FString::Printf(TEXT("telemetry viewer on port %d"), Port), FlushInterval);
+
+	if (!bStarted)
+	{
+		DropClient(TEXT("could not start the stream"));
+		return;
+	}
+
+	UE_LOG(LogCombat, Log, TEXT("[CombatTelemetry] Viewer connected on port %d"), Port);
+}
+
+void FCombatTelemetryServer::DropClient(const TCHAR* Reason)
+{
+	if (!ClientSocket)
+	{
+		return;
+	}
+
+	// Fail the sends still queued (and unblock one in progress) so stopping the writer can't hang on a stalled viewer
+	bSendFailed.store(true, std::memory_order_relaxed);
+	ClientSocket->Shutdown(ESocketShutdownMode::ReadWrite);
+	if (Writer)
+	{
+		Writer->Stop();
+		Writer.Reset();
+	}
+
+	DestroySocket(ClientSocket);
+	UE_LOG(LogCombat, Log, TEXT("[CombatTelemetry] Viewer dropped (%s), %lld bytes sent"), Reason, GetNumBytesSent());
+}
+
+// ============================================================================
+// CLIENT
+// ============================================================================
+
+FCombatTelemetryClient::~FCombatTelemetryClient()
+{
+	Disconnect();
+}
+
+bool FCombatTelemetryClient::Connect(const FString& Host, int32 Port)
+{
+	Disconnect();
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	TSharedPtr<FInternetAddr> Address = SocketSubsystem->GetAddressFromString(Host);
+	if (!Address.IsValid() || !Address->IsValid())
+	{
+		const FAddressInfoResult Resolved = SocketSubsystem->GetAddressInfo(*Host, nullptr, EAddressInfoFlags::Default, NAME_None, ESocketType::SOCKTYPE_Streaming);
+		if (Resolved.ReturnCode != SE_NO_ERROR || Resolved.Results.Num() == 0)
+		{
+			return false;
+		}
+		Address = Resolved.Results[0].Address->Clone();
+	}
+	Address->SetPort(Port);
+
+	Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("CombatTelemetryClient"), Address->GetProtocolType());
+	if (!Socket)
+	{
+		return false;
+	}
+
+	int32 ActualSize = 0;
+	Socket->SetReceiveBufferSize(SocketBufferSize, ActualSize);
+	if (!Socket->Connect(*Address))
+	{
+		DestroySocket(Socket);
+		return false;
+	}
+
+	Socket->SetNonBlocking(true);
+	Decoder.Reset();
+	NumBytesReceived = 0;
+	return true;
+}
+
+void FCombatTelemetryClient::Disconnect()
+{
+	DestroySocket(Socket);
+}
+
+bool FCombatTelemetryClient::Poll(TFunctionRef<void(const FCombatRecordedEvent&)> Visitor)
+{
+	if (!Socket)
+	{
+		return false;
+	}
+
+	uint32 PendingSize = 0;
+	while (Socket->HasPendingData(PendingSize) && PendingSize > 0)
+	{
+		ReceiveBuffer.SetNumUninitialized(FMath::Min<uint32>(PendingSize, SocketBufferSize), EAllowShrinking::No);
+
+		int32 NumRead = 0;
+		if (!Socket->Recv(ReceiveBuffer.GetData(), ReceiveBuffer.Num(), NumRead) || NumRead <= 0)
+		{
+			break;
+		}
+
+		NumBytesReceived += NumRead;
+		if (!Decoder.Feed(ReceiveBuffer.GetData(), NumRead, Visitor))
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatTelemetry] Stream is not a combat capture - disconnecting"));
+			Disconnect();
+			return false;
+		}
+	}
+
+	if (Socket->GetConnectionState() != SCS_Connected)
+	{
+		Disconnect();
+		return false;
+	}
+	return true;
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+
+static FAutoConsoleCommand GCombatTelemetryStartCommand(
+	TEXT("Combat.Telemetry.Start"),
+	TEXT("Stream combat events to a remote viewer (editor: Window > Katana Combat Telemetry). Optional argument: port (default 41650)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		StartActiveTelemetry(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : FCombatTelemetryServer::DefaultPort);
+	}));
+
+static FAutoConsoleCommand GCombatTelemetryStopCommand(
+	TEXT("Combat.Telemetry.Stop"),
+	TEXT("Stop the server started with Combat.Telemetry.Start or -CombatTelemetry"),
+	FConsoleCommandDelegate::CreateStatic(&StopActiveTelemetry));
+
+/** -CombatTelemetry[=Port]: listen from startup (consoles, where typing the command is awkward) */
+static FDelayedAutoRegisterHelper GCombatTelemetryCommandLine(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+{
+	int32 Port = FCombatTelemetryServer::DefaultPort;
+	if (FParse::Value(FCommandLine::Get(), TEXT("CombatTelemetry="), Port) || FParse::Param(FCommandLine::Get(), TEXT("CombatTelemetry")))
+	{
+		StartActiveTelemetry(Port);
+	}
+});
+
+#endif // COMBAT_TELEMETRY_ENABLED
@@ -0,0 +1,280 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatTrace.h"
+#include "Utilities/MontageUtilityLibrary.h"
+#include "Data/AttackData.h"
+#include "ActionQueueTypes.h"
+#include "Debug/CombatEventRecorder.h"
+#include "Debug/CombatFieldTelemetry.h"
+#include "HAL/PlatformTime.h"
+#include "ObjectTrace.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY(LogCombat);
+
+DEFINE_STAT(STAT_Combat_PerformWeaponTrace);
+DEFINE_STAT(STAT_Combat_ValidateHitClaim);
+DEFINE_STAT(STAT_Combat_FindTarget);
+DEFINE_STAT(STAT_Combat_ProcessQueue);
+DEFINE_STAT(STAT_Combat_ResolveNextAttack);
+DEFINE_STAT(STAT_Combat_DiscoverCheckpoints);
+DEFINE_STAT(STAT_Combat_AnimNotify);
+
+CSV_DEFINE_CATEGORY_MODULE(KATANACOMBAT_API, KatanaCombat, true);
+CSV_DEFINE_CATEGORY_MODULE(KATANACOMBAT_API, KatanaCombatTraces, true);
+CSV_DEFINE_CATEGORY_MODULE(KATANACOMBAT_API, KatanaCombatQueue, true);
+CSV_DEFINE_CATEGORY_MODULE(KATANACOMBAT_API, KatanaCombatTargeting, true);
+CSV_DEFINE_CATEGORY_MODULE(KATANACOMBAT_API, KatanaCombatAnim, true);
+
+namespace CombatBudget
+{
+	static std::atomic<uint64> GTotalCycles[static_cast<int32>(ECombatBudgetCategory::Count)];
+
+	void AddCycles(ECombatBudgetCategory Category, uint64 Cycles)
+	{
+		GTotalCycles[static_cast<int32>(Category)].fetch_add(Cycles, std::memory_order_relaxed);
+	}
+
+	uint64 GetTotalCycles(ECombatBudgetCategory Category)
+	{
+		return GTotalCycles[static_cast<int32>(Category)].load(std::memory_order_relaxed);
+	}
+
+	static std::atomic<uint64> GTotalPhysicsQueries{ 0 };
+
+	void AddPhysicsQueries(uint32 NumQueries)
+	{
+		GTotalPhysicsQueries.fetch_add(NumQueries, std::memory_order_relaxed);
+	}
+
+	uint64 GetTotalPhysicsQueries()
+	{
+		return GTotalPhysicsQueries.load(std::memory_order_relaxed);
+	}
+}
+
+LLM_DEFINE_TAG(Combat);
+LLM_DEFINE_TAG(Combat_Components);
+LLM_DEFINE_TAG(Combat_CheckpointCache);
+LLM_DEFINE_TAG(Combat_ActionQueue);
+LLM_DEFINE_TAG(Combat_AttackGraph);
+LLM_DEFINE_TAG(Combat_DebugRecorder);
+LLM_DEFINE_TAG(Combat_DopeSheet);
+
+#if COMBAT_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(CombatChannel)
+
+UE_TRACE_EVENT_BEGIN(Combat, AttackResolved)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, OwnerId)
+	UE_TRACE_EVENT_FIELD(uint32, AttackId)
+	UE_TRACE_EVENT_FIELD(uint8, InputType)
+	UE_TRACE_EVENT_FIELD(uint8, Direction)
+	UE_TRACE_EVENT_FIELD(uint8, Path)
+	UE_TRACE_EVENT_FIELD(bool, bIsHolding)
+	UE_TRACE_EVENT_FIELD(bool, bComboWindowActive)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Combat, InputEvent)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, OwnerId)
+	UE_TRACE_EVENT_FIELD(uint8, InputType)
+	UE_TRACE_EVENT_FIELD(uint8, EventType)
+	UE_TRACE_EVENT_FIELD(uint8, Phase)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Combat, PhaseTransition)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, OwnerId)
+	UE_TRACE_EVENT_FIELD(uint8, OldPhase)
+	UE_TRACE_EVENT_FIELD(uint8, NewPhase)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Combat, WindowEvent)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, OwnerId)
+	UE_TRACE_EVENT_FIELD(uint8, WindowType)
+	UE_TRACE_EVENT_FIELD(bool, bOpened)
+	UE_TRACE_EVENT_FIELD(float, MontageTime)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Combat, Hit)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, OwnerId)
+	UE_TRACE_EVENT_FIELD(uint32, TargetId)
+	UE_TRACE_EVENT_FIELD(uint32, AttackId)
+UE_TRACE_EVENT_END()
+
+// Separate channel: sampled every frame a character's state changes, too chatty to ride along with -trace=combat
+UE_TRACE_CHANNEL_DEFINE(CombatStateChannel)
+
+UE_TRACE_EVENT_BEGIN(Combat, CombatState)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(double, RecordingTime)
+	UE_TRACE_EVENT_FIELD(uint64, ObjectId)
+	UE_TRACE_EVENT_FIELD(uint8, Phase)
+	UE_TRACE_EVENT_FIELD(uint8, CombatState)
+	UE_TRACE_EVENT_FIELD(int16, Posture)
+	UE_TRACE_EVENT_FIELD(int16, MaxPosture)
+	UE_TRACE_EVENT_FIELD(uint8, ActiveWindows)
+	UE_TRACE_EVENT_FIELD(uint8[], Queue)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Combat, QueueEvent)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, OwnerId)
+	UE_TRACE_EVENT_FIELD(uint8, Event)
+	UE_TRACE_EVENT_FIELD(uint8, InputType)
+	UE_TRACE_EVENT_FIELD(uint8, Mode)
+UE_TRACE_EVENT_END()
+
+#endif // COMBAT_TRACE_ENABLED
+
+namespace
+{
+	uint32 GetObjectId(const UObject* Object)
+	{
+		return Object ? Object->GetUniqueID() : 0;
+	}
+
+	void RecordEvent(ECombatRecordedEventType Type, const UObject* Owner, const UObject* Subject, uint8 Arg0, uint8 Arg1 = 0, uint8 Arg2 = 0, float Value = 0.0f, uint8 Arg3 = 0)
+	{
+		FCombatRecordedEvent Event;
+		Event.Cycle = FPlatformTime::Cycles64();
+		Event.OwnerId = GetObjectId(Owner);
+		Event.SubjectId = GetObjectId(Subject);
+		Event.Type = Type;
+		Event.Arg0 = Arg0;
+		Event.Arg1 = Arg1;
+		Event.Arg2 = Arg2;
+		Event.Arg3 = Arg3;
+		Event.Value = Value;
+		FCombatEventRecorder::Get().Record(Event);
+	}
+}
+
+void CombatTrace::OutputAttackResolved(const UObject* Owner, EInputType InputType, EAttackDirection Direction,
+	bool bIsHolding, bool bComboWindowActive, EResolutionPath Path, const UAttackData* Attack)
+{
+	RecordEvent(ECombatRecordedEventType::AttackResolved, Owner, Attack,
+		static_cast<uint8>(InputType), static_cast<uint8>(Path), static_cast<uint8>(Direction));
+
+#if COMBAT_TRACE_ENABLED
+	UE_TRACE_LOG(Combat, AttackResolved, CombatChannel)
+		<< AttackResolved.Cycle(FPlatformTime::Cycles64())
+		<< AttackResolved.OwnerId(Owner ? Owner->GetUniqueID() : 0)
+		<< AttackResolved.AttackId(Attack ? Attack->GetUniqueID() : 0)
+		<< AttackResolved.InputType(static_cast<uint8>(InputType))
+		<< AttackResolved.Direction(static_cast<uint8>(Direction))
+		<< AttackResolved.Path(static_cast<uint8>(Path))
+		<< AttackResolved.bIsHolding(bIsHolding)
+		<< AttackResolved.bComboWindowActive(bComboWindowActive);
+#endif
+}
+
+void CombatTrace::OutputInputEvent(const UObject* Owner, EInputType InputType, EInputEventType EventType, EAttackPhase Phase,
+	EInputDirection Direction)
+{
+	RecordEvent(ECombatRecordedEventType::Input, Owner, nullptr,
+		static_cast<uint8>(InputType), static_cast<uint8>(EventType), static_cast<uint8>(Phase), 0.0f, static_cast<uint8>(Direction));
+
+#if COMBAT_TRACE_ENABLED
+	UE_TRACE_LOG(Combat, InputEvent, CombatChannel)
+		<< InputEvent.Cycle(FPlatformTime::Cycles64())
+		<< InputEvent.OwnerId(Owner ? Owner->GetUniqueID() : 0)
+		<< InputEvent.InputType(static_cast<uint8>(InputType))
+		<< InputEvent.EventType(static_cast<uint8>(EventType))
+		<< InputEvent.Phase(static_cast<uint8>(Phase));
+#endif
+}
+
+void CombatTrace::OutputPhaseTransition(const UObject* Owner, EAttackPhase OldPhase, EAttackPhase NewPhase)
+{
+	RecordEvent(ECombatRecordedEventType::Phase, Owner, nullptr, static_cast<uint8>(OldPhase), static_cast<uint8>(NewPhase));
+
+#if COMBAT_TRACE_ENABLED
+	UE_TRACE_LOG(Combat, PhaseTransition, CombatChannel)
+		<< PhaseTransition.Cycle(FPlatformTime::Cycles64())
+		<< PhaseTransition.OwnerId(Owner ? Owner->GetUniqueID() : 0)
+		<< PhaseTransition.OldPhase(static_cast<uint8>(OldPhase))
+		<< PhaseTransition.NewPhase(static_cast<uint8>(NewPhase));
+#endif
+}
+
+void CombatTrace::OutputWindowEvent(const UObject* Owner, EActionWindowType WindowType, bool bOpened, float MontageTime)
+{
+	RecordEvent(ECombatRecordedEventType::Window, Owner, nullptr, static_cast<uint8>(WindowType), bOpened ? 1 : 0, 0, MontageTime);
+
+#if COMBAT_TRACE_ENABLED
+	UE_TRACE_LOG(Combat, WindowEvent, CombatChannel)
+		<< WindowEvent.Cycle(FPlatformTime::Cycles64())
+		<< WindowEvent.OwnerId(Owner ? Owner->GetUniqueID() : 0)
+		<< WindowEvent.WindowType(static_cast<uint8>(WindowType))
+		<< WindowEvent.bOpened(bOpened)
+		<< WindowEvent.MontageTime(MontageTime);
+#endif
+}
+
+void CombatTrace::OutputQueueEvent(const UObject* Owner, EQueueEvent Event, EInputType InputType, EActionExecutionMode Mode)
+{
+	FCombatFieldTelemetry::Get().RecordQueueEvent(Event);
+
+	RecordEvent(ECombatRecordedEventType::Queue, Owner, nullptr,
+		static_cast<uint8>(Event), static_cast<uint8>(InputType), static_cast<uint8>(Mode));
+
+#if COMBAT_TRACE_ENABLED
+	UE_TRACE_LOG(Combat, QueueEvent, CombatChannel)
+		<< QueueEvent.Cycle(FPlatformTime::Cycles64())
+		<< QueueEvent.OwnerId(Owner ? Owner->GetUniqueID() : 0)
+		<< QueueEvent.Event(static_cast<uint8>(Event))
+		<< QueueEvent.InputType(static_cast<uint8>(InputType))
+		<< QueueEvent.Mode(static_cast<uint8>(Mode));
+#endif
+}
+
+void CombatTrace::OutputHit(const UObject* Owner, const UObject* HitActor, const UAttackData* Attack)
+{
+	RecordEvent(ECombatRecordedEventType::Hit, Owner, HitActor, Attack ? static_cast<uint8>(Attack->AttackType) : 0);
+
+#if COMBAT_TRACE_ENABLED
+	UE_TRACE_LOG(Combat, Hit, CombatChannel)
+		<< Hit.Cycle(FPlatformTime::Cycles64())
+		<< Hit.OwnerId(GetObjectId(Owner))
+		<< Hit.TargetId(GetObjectId(HitActor))
+		<< Hit.AttackId(GetObjectId(Attack));
+#endif
+}
+
+bool CombatTrace::IsCombatStateTraceEnabled()
+{
+#if COMBAT_TRACE_ENABLED
+	return UE_TRACE_CHANNELEXPR_IS_ENABLED(CombatStateChannel);
+#else
+	return false;
+#endif
+}
+
+void CombatTrace::OutputCombatState(const UObject* Owner, const FCombatStateSample& Sample)
+{
+#if COMBAT_TRACE_ENABLED && OBJECT_TRACE_ENABLED
+	if (!Owner || !UE_TRACE_CHANNELEXPR_IS_ENABLED(CombatStateChannel))
+	{
+		return;
+	}
+
+	// Rewind Debugger tracks are keyed by object trace IDs, so make sure the owner has one
+	TRACE_OBJECT(Owner);
+
+	UE_TRACE_LOG(Combat, CombatState, CombatStateChannel)
+		<< CombatState.Cycle(FPlatformTime::Cycles64())
+		<< CombatState.RecordingTime(FObjectTrace::GetWorldElapsedTime(Owner->GetWorld()))
+		<< CombatState.ObjectId(FObjectTrace::GetObjectId(Owner))
+		<< CombatState.Phase(static_cast<uint8>(Sample.Phase))
+		<< CombatState.CombatState(static_cast<uint8>(Sample.CombatState))
+		<< CombatState.Posture(Sample.Posture)
+		<< CombatState.MaxPosture(Sample.MaxPosture)
+		<< CombatState.ActiveWindows(Sample.ActiveWindows)
+		<< CombatState.Queue(Sample.Queue.GetData(), Sample.Queue.Num());
+#endif
+}
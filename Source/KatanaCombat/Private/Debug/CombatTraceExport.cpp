@@ -0,0 +1,377 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Debug/CombatTraceExport.h"
+#include "Debug/CombatCapture.h"
+#include "Debug/CombatTrace.h"
+#include "ActionQueueTypes.h"
+#include "Utilities/MontageUtilityLibrary.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+namespace
+{
+	/** Chunk size handed to the archive */
+	constexpr int32 FlushThreshold = 64 * 1024;
+
+	template<typename TEnum>
+	FString GetEnumName(uint8 Value)
+	{
+		const UEnum* Enum = StaticEnum<TEnum>();
+		return Enum ? Enum->GetNameStringByValue(Value) : FString::FromInt(Value);
+	}
+
+	FString EscapeJson(const FString& Text)
+	{
+		return Text.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+	}
+
+	/** Live object name for a recorder ID (#id once the object is gone) */
+	FString ResolveLiveObjectName(uint32 UniqueId)
+	{
+		const FUObjectItem* Item = GUObjectArray.IndexToObject(static_cast<int32>(UniqueId));
+		const UObject* Object = Item ? static_cast<const UObject*>(Item->Object) : nullptr;
+		return Object && Object->GetUniqueID() == UniqueId ? Object->GetName() : FString::Printf(TEXT("#%u"), UniqueId);
+	}
+}
+
+FCombatTraceEventWriter::~FCombatTraceEventWriter()
+{
+	Close();
+}
+
+bool FCombatTraceEventWriter::Open(const FString& FilePath, uint64 InBaseCycle, FNameResolver InResolveName)
+{
+	COMBAT_LLM_SCOPE(DebugRecorder);
+	Close();
+
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer)
+	{
+		return false;
+	}
+
+	ResolveName = MoveTemp(InResolveName);
+	BaseCycle = InBaseCycle;
+	LastMicros = 0;
+	Owners.Reset();
+	NextAsyncId = 1;
+	NumTraceEvents = 0;
+	Buffer.Reset();
+	Buffer.Reserve(FlushThreshold + 1024);
+
+	static const ANSICHAR Preamble[] = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	Buffer.Append(Preamble, UE_ARRAY_COUNT(Preamble) - 1);
+	return true;
+}
+
+void FCombatTraceEventWriter::Close()
+{
+	if (!Writer)
+	{
+		return;
+	}
+
+	// Spans still open end at the last event (the recording stopped, they didn't)
+	for (TPair<uint32, FOwnerState>& Pair : Owners)
+	{
+		FOwnerState& Owner = Pair.Value;
+		for (const TPair<uint8, FOpenSpan>& Input : Owner.HeldInputs)
+		{
+			WriteAsync(Owner, static_cast<int32>(ELane::Inputs), Input.Value.Name, Input.Value.Micros, LastMicros, TEXT("Input"), NextAsyncId++);
+		}
+		for (const TPair<uint8, TArray<uint64>>& Queued : Owner.QueuedActions)
+		{
+			for (const uint64 StartMicros : Queued.Value)
+			{
+				WriteAsync(Owner, static_cast<int32>(ELane::Queue), GetEnumName<EInputType>(Queued.Key) + TEXT(" (Pending)"), StartMicros, LastMicros, TEXT("Queue"), NextAsyncId++);
+			}
+		}
+		for (const TPair<uint8, FOpenSpan>& Window : Owner.OpenWindows)
+		{
+			WriteComplete(Owner, static_cast<int32>(ELane::FirstWindow) + Window.Key, Window.Value.Name, Window.Value.Micros, LastMicros, TEXT("Window"));
+		}
+		if (Owner.Phase.IsSet())
+		{
+			WriteComplete(Owner, static_cast<int32>(ELane::Phase), Owner.Phase->Name, Owner.Phase->Micros, LastMicros, TEXT("Phase"));
+		}
+	}
+	Owners.Reset();
+
+	static const ANSICHAR Epilogue[] = "\n]}\n";
+	Buffer.Append(Epilogue, UE_ARRAY_COUNT(Epilogue) - 1);
+	FlushBuffer();
+
+	Writer->Close();
+	Writer.Reset();
+	ResolveName = FNameResolver();
+}
+
+void FCombatTraceEventWriter::AddEvent(const FCombatRecordedEvent& Event)
+{
+	if (!Writer || Event.OwnerId == 0)
+	{
+		return;
+	}
+
+	const uint64 Micros = ToMicros(Event.Cycle);
+	LastMicros = FMath::Max(LastMicros, Micros);
+	FOwnerState& Owner = GetOwnerState(Event.OwnerId);
+
+	switch (Event.Type)
+	{
+		case ECombatRecordedEventType::Input:
+		{
+			NameLane(Owner, static_cast<int32>(ELane::Inputs), TEXT("Inputs"));
+
+			// Press opens a span per input type; a press without a release closes the previous one
+			FOpenSpan Held;
+			if (Owner.HeldInputs.RemoveAndCopyValue(Event.Arg0, Held))
+			{
+				WriteAsync(Owner, static_cast<int32>(ELane::Inputs), Held.Name, Held.Micros, Micros, TEXT("Input"), NextAsyncId++);
+			}
+			if (static_cast<EInputEventType>(Event.Arg1) == EInputEventType::Press)
+			{
+				Owner.HeldInputs.Add(Event.Arg0, { Micros, GetEnumName<EInputType>(Event.Arg0) });
+			}
+			break;
+		}
+
+		case ECombatRecordedEventType::Queue:
+		{
+			NameLane(Owner, static_cast<int32>(ELane::Queue), TEXT("Queue"));
+
+			// Queue events carry no action ID - actions of one input type leave in the order they were queued
+			TArray<uint64>& Queued = Owner.QueuedActions.FindOrAdd(Event.Arg1);
+			const CombatTrace::EQueueEvent QueueEvent = static_cast<CombatTrace::EQueueEvent>(Event.Arg0);
+			if (QueueEvent == CombatTrace::EQueueEvent::Queued)
+			{
+				Queued.Add(Micros);
+			}
+			else if (Queued.Num() > 0)
+			{
+				const TCHAR* Outcome = QueueEvent == CombatTrace::EQueueEvent::Executed ? TEXT(" (Executed)") : TEXT(" (Cancelled)");
+				WriteAsync(Owner, static_cast<int32>(ELane::Queue), GetEnumName<EInputType>(Event.Arg1) + Outcome, Queued[0], Micros, TEXT("Queue"), NextAsyncId++);
+				Queued.RemoveAt(0, EAllowShrinking::No);
+			}
+			break;
+		}
+
+		case ECombatRecordedEventType::Phase:
+		{
+			NameLane(Owner, static_cast<int32>(ELane::Phase), TEXT("Phase"));
+
+			if (Owner.Phase.IsSet())
+			{
+				WriteComplete(Owner, static_cast<int32>(ELane::Phase), Owner.Phase->Name, Owner.Phase->Micros, Micros, TEXT("Phase"));
+				Owner.Phase.Reset();
+			}
+			if (static_cast<EAttackPhase>(Event.Arg1) != EAttackPhase::None)
+			{
+				Owner.Phase = FOpenSpan{ Micros, GetEnumName<EAttackPhase>(Event.Arg1) };
+			}
+			break;
+		}
+
+		case ECombatRecordedEventType::Window:
+		{
+			const int32 Lane = static_cast<int32>(ELane::FirstWindow) + Event.Arg0;
+			const FString WindowName = GetEnumName<EActionWindowType>(Event.Arg0);
+			NameLane(Owner, Lane, *FString::Printf(TEXT("%s Window"), *WindowName));
+
+			FOpenSpan Window;
+			if (Owner.OpenWindows.RemoveAndCopyValue(Event.Arg0, Window))
+			{
+				WriteComplete(Owner, Lane, Window.Name, Window.Micros, Micros, TEXT("Window"));
+			}
+			if (Event.Arg1 != 0)
+			{
+				Owner.OpenWindows.Add(Event.Arg0, { Micros, WindowName });
+			}
+			break;
+		}
+
+		case ECombatRecordedEventType::AttackResolved:
+			NameLane(Owner, static_cast<int32>(ELane::Events), TEXT("Events"));
+			WriteInstant(Owner, static_cast<int32>(ELane::Events), TEXT("Attack ") + GetName(Event.SubjectId), Micros, TEXT("Attack"),
+				GetEnumName<EResolutionPath>(Event.Arg1));
+			break;
+
+		case ECombatRecordedEventType::Hit:
+			NameLane(Owner, static_cast<int32>(ELane::Events), TEXT("Events"));
+			WriteInstant(Owner, static_cast<int32>(ELane::Events), TEXT("Hit ") + GetName(Event.SubjectId), Micros, TEXT("Hit"), FString());
+			break;
+	}
+}
+
+bool FCombatTraceEventWriter::ExportEvents(const FString& FilePath, TConstArrayView<FCombatRecordedEvent> Events, uint64 BaseCycle, FNameResolver InResolveName)
+{
+	FCombatTraceEventWriter TraceWriter;
+	if (!TraceWriter.Open(FilePath, BaseCycle, MoveTemp(InResolveName)))
+	{
+		return false;
+	}
+
+	for (const FCombatRecordedEvent& Event : Events)
+	{
+		TraceWriter.AddEvent(Event);
+	}
+	TraceWriter.Close();
+	return true;
+}
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+FCombatTraceEventWriter::FOwnerState& FCombatTraceEventWriter::GetOwnerState(uint32 OwnerId)
+{
+	if (FOwnerState* Existing = Owners.Find(OwnerId))
+	{
+		return *Existing;
+	}
+
+	FOwnerState& Owner = Owners.Add(OwnerId);
+	Owner.ProcessId = Owners.Num();
+	WriteMetadata(Owner.ProcessId, 0, TEXT("process_name"), GetName(OwnerId));
+	return Owner;
+}
+
+void FCombatTraceEventWriter::NameLane(FOwnerState& Owner, int32 Lane, const TCHAR* LaneName)
+{
+	const uint32 Bit = 1u << FMath::Min(Lane, 31);
+	if ((Owner.NamedLanes & Bit) == 0)
+	{
+		Owner.NamedLanes |= Bit;
+		WriteMetadata(Owner.ProcessId, Lane, TEXT("thread_name"), LaneName);
+	}
+}
+
+uint64 FCombatTraceEventWriter::ToMicros(uint64 Cycle) const
+{
+	return Cycle > BaseCycle ? static_cast<uint64>(FPlatformTime::ToSeconds64(Cycle - BaseCycle) * 1000000.0 + 0.5) : 0;
+}
+
+FString FCombatTraceEventWriter::GetName(uint32 Id) const
+{
+	if (Id == 0)
+	{
+		return TEXT("None");
+	}
+	return ResolveName ? ResolveName(Id) : FString::Printf(TEXT("#%u"), Id);
+}
+
+void FCombatTraceEventWriter::WriteComplete(const FOwnerState& Owner, int32 Lane, const FString& Name, uint64 StartMicros, uint64 EndMicros, const TCHAR* Category)
+{
+	WriteRecord(FString::Printf(TEXT("{\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%llu,\"dur\":%llu,\"cat\":\"%s\",\"name\":\"%s\"}"),
+		Owner.ProcessId, Lane, StartMicros, EndMicros - FMath::Min(StartMicros, EndMicros), Category, *EscapeJson(Name)));
+}
+
+void FCombatTraceEventWriter::WriteAsync(const FOwnerState& Owner, int32 Lane, const FString& Name, uint64 StartMicros, uint64 EndMicros, const TCHAR* Category, uint64 Id)
+{
+	const FString EscapedName = EscapeJson(Name);
+	WriteRecord(FString::Printf(TEXT("{\"ph\":\"b\",\"pid\":%d,\"tid\":%d,\"ts\":%llu,\"cat\":\"%s\",\"name\":\"%s\",\"id\":%llu}"),
+		Owner.ProcessId, Lane, StartMicros, Category, *EscapedName, Id));
+	WriteRecord(FString::Printf(TEXT("{\"ph\":\"e\",\"pid\":%d,\"tid\":%d,\"ts\":%llu,\"cat\":\"%s\",\"name\":\"%s\",\"id\":%llu}"),
+		Owner.ProcessId, Lane, FMath::Max(StartMicros, EndMicros), Category, *EscapedName, Id));
+}
+
+void FCombatTraceEventWriter::WriteInstant(const FOwnerState& Owner, int32 Lane, const FString& Name, uint64 Micros, const TCHAR* Category, const FString& Detail)
+{
+	WriteRecord(FString::Printf(TEXT("{\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%d,\"ts\":%llu,\"cat\":\"%s\",\"name\":\"%s\",\"args\":{\"detail\":\"%s\"}}"),
+		Owner.ProcessId, Lane, Micros, Category, *EscapeJson(Name), *EscapeJson(Detail)));
+}
+
+void FCombatTraceEventWriter::WriteMetadata(int32 ProcessId, int32 ThreadId, const TCHAR* MetadataName, const FString& Value)
+{
+	WriteRecord(FString::Printf(TEXT("{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"args\":{\"name\":\"%s\"}}"),
+		ProcessId, ThreadId, MetadataName, *EscapeJson(Value)));
+}
+
+void FCombatTraceEventWriter::WriteRecord(const FString& Json)
+{
+	if (NumTraceEvents > 0)
+	{
+		Buffer.Append(",\n", 2);
+	}
+
+	const FTCHARToUTF8 Utf8(*Json);
+	Buffer.Append(Utf8.Get(), Utf8.Length());
+	++NumTraceEvents;
+
+	if (Buffer.Num() >= FlushThreshold)
+	{
+		FlushBuffer();
+	}
+}
+
+void FCombatTraceEventWriter::FlushBuffer()
+{
+	if (Writer && Buffer.Num() > 0)
+	{
+		Writer->Serialize(Buffer.GetData(), Buffer.Num());
+	}
+	Buffer.Reset();
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+
+static FAutoConsoleCommand GCombatExportTraceCommand(
+	TEXT("Combat.ExportTrace"),
+	TEXT("Write the combat event recorder ring as Chrome trace JSON (chrome://tracing, ui.perfetto.dev). Optional argument: output path (default Saved/Combat/CombatTrace_<time>.json)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString FilePath = Args.Num() > 0
+			? Args[0]
+			: FPaths::ProjectSavedDir() / TEXT("Combat") / FString::Printf(TEXT("CombatTrace_%s.json"), *FDateTime::Now().ToString());
+
+		TArray<FCombatRecordedEvent> Events;
+		FCombatEventRecorder::Get().Snapshot(Events);
+
+		const uint64 BaseCycle = Events.Num() > 0 ? Events[0].Cycle : 0;
+		if (FCombatTraceEventWriter::ExportEvents(FilePath, Events, BaseCycle, &ResolveLiveObjectName))
+		{
+			UE_LOG(LogCombat, Log, TEXT("[CombatTraceExport] Wrote %d recorded events to %s"), Events.Num(), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatTraceExport] Failed to write %s"), *FilePath);
+		}
+	}));
+
+static FAutoConsoleCommand GCombatCaptureExportTraceCommand(
+	TEXT("Combat.Capture.ExportTrace"),
+	TEXT("Convert a capture file to Chrome trace JSON. Arguments: capture path, optional JSON path (default: next to the capture)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatTraceExport] Usage: Combat.Capture.ExportTrace <CapturePath> [JsonPath]"));
+			return;
+		}
+
+		FCombatCaptureReader Reader;
+		if (!Reader.Open(Args[0]))
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatTraceExport] Could not read %s"), *Args[0]);
+			return;
+		}
+
+		// Streams straight from the mapped capture - events are never all decoded at once
+		const FString JsonPath = Args.Num() > 1 ? Args[1] : FPaths::ChangeExtension(Args[0], TEXT("json"));
+		FCombatTraceEventWriter TraceWriter;
+		if (!TraceWriter.Open(JsonPath, 0, [&Reader](uint32 Index) { return Reader.GetName(Index); }))
+		{
+			UE_LOG(LogCombat, Warning, TEXT("[CombatTraceExport] Failed to write %s"), *JsonPath);
+			return;
+		}
+
+		Reader.ForEachEvent([&TraceWriter](const FCombatRecordedEvent& Event) { TraceWriter.AddEvent(Event); });
+		TraceWriter.Close();
+		UE_LOG(LogCombat, Log, TEXT("[CombatTraceExport] Exported %lld events (%d trace events) to %s"), Reader.GetNumEvents(), TraceWriter.GetNumTraceEvents(), *JsonPath);
+	}));
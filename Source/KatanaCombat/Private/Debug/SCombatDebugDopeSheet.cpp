@@ -2,9 +2,46 @@
 
 #include "Debug/SCombatDebugDopeSheet.h"
 #include "Core/CombatComponentV2.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatEventRecorder.h"
 #include "Rendering/DrawElements.h"
 #include "Fonts/FontMeasure.h"
 #include "Framework/Application/SlateApplication.h"
+#include "Widgets/SInvalidationPanel.h"
+#include "Widgets/SLeafWidget.h"
+#include "Widgets/SOverlay.h"
+#include "Algo/BinarySearch.h"
+
+/**
+ * Leaf that paints the dope sheet's static layers, so they can be cached by an SInvalidationPanel
+ */
+class SCombatDopeSheetLayer : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SCombatDopeSheetLayer) {}
+	SLATE_END_ARGS()
+
+	/** Owner is the dope sheet this layer is a child of (outlives it) */
+	void Construct(const FArguments& InArgs, const SCombatDebugDopeSheet* InOwner)
+	{
+		Owner = InOwner;
+	}
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle,
+		bool bParentEnabled) const override
+	{
+		return Owner->PaintStaticLayers(AllottedGeometry, OutDrawElements, LayerId);
+	}
+
+	virtual FVector2D ComputeDesiredSize(float) const override
+	{
+		return Owner->GetSheetSize();
+	}
+
+private:
+	const SCombatDebugDopeSheet* Owner = nullptr;
+};
 
 // Color definitions
 const FLinearColor SCombatDebugDopeSheet::ComboWindowColor = FLinearColor(0.2f, 0.8f, 0.2f, 0.7f);        // Green
@@ -29,12 +66,31 @@ void SCombatDebugDopeSheet::Construct(const FArguments& InArgs, UCombatComponent
 	ViewRangeMax = InArgs._ViewRangeMax;
 	CurrentTime = InArgs._CurrentTime;
 
+	ChildSlot
+	[
+		SNew(SInvalidationPanel)
+		[
+			SAssignNew(StaticLayer, SCombatDopeSheetLayer, this)
+		]
+	];
+
 	BuildTracks();
 }
 
 int32 SCombatDebugDopeSheet::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
 	const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId,
 	const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	// Cached layers (replayed by the invalidation panel unless they were invalidated)
+	LayerId = SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled) + 1;
+
+	// Draw playhead (on top)
+	DrawPlayhead(AllottedGeometry, OutDrawElements, LayerId);
+
+	return LayerId;
+}
+
+int32 SCombatDebugDopeSheet::PaintStaticLayers(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId) const
 {
 	// Draw background
 	FSlateDrawElement::MakeBox(
@@ -55,13 +111,10 @@ int32 SCombatDebugDopeSheet::OnPaint(const FPaintArgs& Args, const FGeometry& Al
 	// Draw tracks
 	DrawTracks(AllottedGeometry, OutDrawElements, LayerId);
 
-	// Draw playhead (on top)
-	DrawPlayhead(AllottedGeometry, OutDrawElements, LayerId);
-
 	return LayerId;
 }
 
-FVector2D SCombatDebugDopeSheet::ComputeDesiredSize(float) const
+FVector2D SCombatDebugDopeSheet::GetSheetSize() const
 {
 	const float TotalHeight = TimelineHeight + (Tracks.Num() * (TrackHeight + TrackSpacing)) + 20.0f;
 	return FVector2D(800.0f, TotalHeight);
@@ -69,36 +122,68 @@ FVector2D SCombatDebugDopeSheet::ComputeDesiredSize(float) const
 
 void SCombatDebugDopeSheet::RefreshData()
 {
+	COMBAT_LLM_SCOPE(DopeSheet);
 	if (!CombatComponent.IsValid())
 	{
 		return;
 	}
 
-	// Rebuild tracks with current data
-	BuildTracks();
+	if (Tracks.Num() != NumTracks)
+	{
+		BuildTracks();
+		return;
+	}
+
+	// Nothing visualized changed since the last refresh (the common case at 30Hz)
+	const uint32 StateVersion = CombatComponent->GetDebugStateVersion();
+	if (StateVersion == LastStateVersion)
+	{
+		return;
+	}
+
+	UpdateWindowTracks();
+	UpdateInputEventTrack();
+	UpdateActionQueueTrack();
+	RebuildTrackGeometry();
+	LastStateVersion = StateVersion;
 }
 
 void SCombatDebugDopeSheet::SetViewRange(float Min, float Max)
 {
+	if (Min == ViewRangeMin && Max == ViewRangeMax)
+	{
+		return;
+	}
+
 	ViewRangeMin = Min;
 	ViewRangeMax = Max;
+	InvalidateStaticLayers();
 }
 
 void SCombatDebugDopeSheet::SetCurrentTime(float Time)
 {
+	if (Time == CurrentTime)
+	{
+		return;
+	}
+
+	// Only the playhead moves - the cached layers stay valid
 	CurrentTime = Time;
+	Invalidate(EInvalidateWidgetReason::Paint);
 }
 
 void SCombatDebugDopeSheet::BuildTracks()
 {
-	Tracks.Empty();
-
-	if (!CombatComponent.IsValid())
-	{
-		return;
-	}
-
-	// Window tracks
+	COMBAT_LLM_SCOPE(DopeSheet);
+	Tracks.Reset();
+	TrackGeometry.Reset();
+	InputEventKeys.Reset();
+	QueueEventKeys.Reset();
+	NumCheckpointsApplied = 0;
+	InvalidateStaticLayers(EInvalidateWidgetReason::Layout);
+
+	// Window tracks (added in EActionWindowType order - track index == enum value)
+	Tracks.Reserve(NumTracks);
 	AddWindowTrack(TEXT("Combo Window"), EActionWindowType::Combo, ComboWindowColor);
 	AddWindowTrack(TEXT("Parry Window"), EActionWindowType::Parry, ParryWindowColor);
 	AddWindowTrack(TEXT("Cancel Window"), EActionWindowType::Cancel, CancelWindowColor);
@@ -110,121 +195,390 @@ void SCombatDebugDopeSheet::BuildTracks()
 
 	// Action queue track
 	AddActionQueueTrack();
-}
+	TrackGeometry.SetNum(NumTracks);
 
-void SCombatDebugDopeSheet::AddWindowTrack(const FString& Name, EActionWindowType WindowType, FLinearColor Color)
-{
+	// Recorded mode: the tracks stay empty until AppendRecordedEvents
 	if (!CombatComponent.IsValid())
 	{
 		return;
 	}
 
-	FDopeSheetTrack Track(Name, Color, TrackHeight);
+	// Fill from current state
+	LastCheckpointLayoutVersion = CombatComponent->GetCheckpointLayoutVersion();
+	UpdateWindowTracks();
+	UpdateInputEventTrack();
+	UpdateActionQueueTrack();
+	RebuildTrackGeometry();
+	LastStateVersion = CombatComponent->GetDebugStateVersion();
+}
+
+void SCombatDebugDopeSheet::AddWindowTrack(const FString& Name, EActionWindowType WindowType, FLinearColor Color)
+{
+	check(Tracks.Num() == static_cast<int32>(WindowType));
+
+	FDopeSheetTrack& Track = Tracks.Add_GetRef(FDopeSheetTrack(Name, Color, TrackHeight));
+	Track.Events.Reserve(EventReserve);
+}
+
+void SCombatDebugDopeSheet::AddInputEventTrack()
+{
+	FDopeSheetTrack& Track = Tracks.Add_GetRef(FDopeSheetTrack(TEXT("Input Events"), FLinearColor::White, TrackHeight));
+	Track.Events.Reserve(EventReserve);
+	InputEventKeys.Reserve(EventReserve);
+}
+
+void SCombatDebugDopeSheet::AddActionQueueTrack()
+{
+	FDopeSheetTrack& Track = Tracks.Add_GetRef(FDopeSheetTrack(TEXT("Action Queue"), FLinearColor::White, TrackHeight));
+	Track.Events.Reserve(FActionQueue::Capacity);
+	QueueEventKeys.Reserve(FActionQueue::Capacity);
+}
 
-	// Find all checkpoints of this type
+void SCombatDebugDopeSheet::UpdateWindowTracks()
+{
 	const TArray<FTimerCheckpoint>& Checkpoints = CombatComponent->Checkpoints;
-	for (const FTimerCheckpoint& Checkpoint : Checkpoints)
+
+	// Checkpoints were removed or reset - start over (event storage is kept)
+	const uint32 LayoutVersion = CombatComponent->GetCheckpointLayoutVersion();
+	if (LayoutVersion != LastCheckpointLayoutVersion || NumCheckpointsApplied > Checkpoints.Num())
 	{
-		if (Checkpoint.WindowType == WindowType)
+		for (int32 TrackIndex = 0; TrackIndex < NumWindowTracks; ++TrackIndex)
 		{
-			// Add as duration bar
-			Track.Events.Add(FDopeSheetEvent(
-				Checkpoint.MontageTime,
-				Name,
-				Color,
-				true, // Is duration
-				Checkpoint.Duration
-			));
+			Tracks[TrackIndex].Events.Reset();
+			MarkTrackDirty(TrackIndex);
 		}
+		NumCheckpointsApplied = 0;
+		LastCheckpointLayoutVersion = LayoutVersion;
 	}
 
-	Tracks.Add(Track);
+	// Append only checkpoints registered since the last refresh
+	for (int32 i = NumCheckpointsApplied; i < Checkpoints.Num(); ++i)
+	{
+		const FTimerCheckpoint& Checkpoint = Checkpoints[i];
+		FDopeSheetTrack& Track = Tracks[static_cast<int32>(Checkpoint.WindowType)];
+
+		// Add as duration bar
+		Track.Events.Emplace(
+			Checkpoint.MontageTime,
+			Track.TrackName,
+			Track.TrackColor,
+			true, // Is duration
+			Checkpoint.Duration
+		);
+		MarkTrackDirty(static_cast<int32>(Checkpoint.WindowType));
+	}
+	NumCheckpointsApplied = Checkpoints.Num();
 }
 
-void SCombatDebugDopeSheet::AddInputEventTrack()
+void SCombatDebugDopeSheet::UpdateInputEventTrack()
 {
-	if (!CombatComponent.IsValid())
+	FDopeSheetTrack& Track = Tracks[InputEventTrackIndex];
+
+	// Held inputs (currently pressed) - only entries that changed are relabelled
+	int32 Index = 0;
+	const FCombatHeldInputs& HeldInputs = CombatComponent->HeldInputs;
+	for (int32 TypeIndex = 1; TypeIndex < FCombatHeldInputs::NumInputs; ++TypeIndex)
 	{
-		return;
-	}
+		const EInputType InputType = static_cast<EInputType>(TypeIndex);
+		if (!HeldInputs.IsHeld(InputType))
+		{
+			continue;
+		}
 
-	FDopeSheetTrack Track(TEXT("Input Events"), FLinearColor::White, TrackHeight);
+		const FInputEventKey Key{ InputType, HeldInputs.GetPressTime(InputType) };
+		if (InputEventKeys.IsValidIndex(Index) && InputEventKeys[Index] == Key)
+		{
+			++Index;
+			continue;
+		}
 
-	// Add held inputs (currently pressed)
-	const TMap<EInputType, float>& HeldInputs = CombatComponent->HeldInputs;
-	for (const TPair<EInputType, float>& Pair : HeldInputs)
-	{
-		FString InputName = UEnum::GetValueAsString(Pair.Key);
+		FString InputName = UEnum::GetValueAsString(InputType);
 		InputName.RemoveFromStart(TEXT("EInputType::"));
 
-		Track.Events.Add(FDopeSheetEvent(
-			Pair.Value,
-			InputName + TEXT(" (Press)"),
-			InputPressColor,
-			false // Marker
-		));
+		const FDopeSheetEvent Event(Key.PressTime, InputName + TEXT(" (Press)"), InputPressColor, false);
+		MarkTrackDirty(InputEventTrackIndex);
+		if (InputEventKeys.IsValidIndex(Index))
+		{
+			InputEventKeys[Index] = Key;
+			Track.Events[Index] = Event;
+		}
+		else
+		{
+			InputEventKeys.Add(Key);
+			Track.Events.Add(Event);
+		}
+		++Index;
 	}
 
 	// Note: Release events are not stored, only press events
 	// In a full implementation, you'd store a history of press/release pairs
 
-	Tracks.Add(Track);
+	if (Index != Track.Events.Num())
+	{
+		MarkTrackDirty(InputEventTrackIndex);
+	}
+	InputEventKeys.SetNum(Index, EAllowShrinking::No);
+	Track.Events.SetNum(Index, EAllowShrinking::No);
 }
 
-void SCombatDebugDopeSheet::AddActionQueueTrack()
+void SCombatDebugDopeSheet::UpdateActionQueueTrack()
 {
-	if (!CombatComponent.IsValid())
+	FDopeSheetTrack& Track = Tracks[ActionQueueTrackIndex];
+
+	// Patch queued actions in scheduled order - unchanged entries keep their event
+	int32 Index = 0;
+	for (const FActionQueueEntry& Action : CombatComponent->ActionQueue)
 	{
-		return;
+		const FQueueEventKey Key{ Action.InputAction.InputType, Action.State, Action.ScheduledTime };
+		if (QueueEventKeys.IsValidIndex(Index) && QueueEventKeys[Index] == Key)
+		{
+			++Index;
+			continue;
+		}
+
+		MarkTrackDirty(ActionQueueTrackIndex);
+		if (QueueEventKeys.IsValidIndex(Index))
+		{
+			QueueEventKeys[Index] = Key;
+			Track.Events[Index] = MakeActionEvent(Action);
+		}
+		else
+		{
+			QueueEventKeys.Add(Key);
+			Track.Events.Add(MakeActionEvent(Action));
+		}
+		++Index;
+	}
+
+	if (Index != Track.Events.Num())
+	{
+		MarkTrackDirty(ActionQueueTrackIndex);
+	}
+	QueueEventKeys.SetNum(Index, EAllowShrinking::No);
+	Track.Events.SetNum(Index, EAllowShrinking::No);
+}
+
+FDopeSheetEvent SCombatDebugDopeSheet::MakeActionEvent(const FActionQueueEntry& Action)
+{
+	FLinearColor StateColor;
+	FString StateName;
+
+	switch (Action.State)
+	{
+		case EActionState::Pending:
+			StateColor = ActionPendingColor;
+			StateName = TEXT("Pending");
+			break;
+		case EActionState::Executing:
+			StateColor = ActionExecutingColor;
+			StateName = TEXT("Executing");
+			break;
+		case EActionState::Completed:
+			StateColor = ActionCompletedColor;
+			StateName = TEXT("Completed");
+			break;
+		case EActionState::Cancelled:
+			StateColor = ActionCancelledColor;
+			StateName = TEXT("Cancelled");
+			break;
+		default:
+			StateColor = FLinearColor::White;
+			StateName = TEXT("Unknown");
+			break;
 	}
 
-	FDopeSheetTrack Track(TEXT("Action Queue"), FLinearColor::White, TrackHeight);
+	FString InputName = UEnum::GetValueAsString(Action.InputAction.InputType);
+	InputName.RemoveFromStart(TEXT("EInputType::"));
 
-	// Add queued actions
-	const TArray<FActionQueueEntry>& ActionQueue = CombatComponent->ActionQueue;
-	for (const FActionQueueEntry& Action : ActionQueue)
+	FString Label = FString::Printf(TEXT("%s (%s)"), *InputName, *StateName);
+
+	return FDopeSheetEvent(
+		Action.ScheduledTime,
+		Label,
+		StateColor,
+		false // Marker
+	);
+}
+
+void SCombatDebugDopeSheet::AppendRecordedEvents(TConstArrayView<FCombatRecordedEvent> Events)
+{
+	COMBAT_LLM_SCOPE(DopeSheet);
+	if (Tracks.Num() != NumTracks)
+	{
+		BuildTracks();
+	}
+
+	for (const FCombatRecordedEvent& Event : Events)
 	{
-		FLinearColor StateColor;
-		FString StateName;
+		AppendRecordedEvent(Event);
+	}
 
-		switch (Action.State)
+	TrimRecordedEvents();
+	RebuildTrackGeometry();
+}
+
+void SCombatDebugDopeSheet::AppendRecordedEvent(const FCombatRecordedEvent& Event)
+{
+	const float Time = static_cast<float>(FPlatformTime::ToSeconds64(Event.Cycle));
+	LatestRecordedTime = FMath::Max(LatestRecordedTime, Time);
+
+	switch (Event.Type)
+	{
+		case ECombatRecordedEventType::Window:
 		{
-			case EActionState::Pending:
-				StateColor = ActionPendingColor;
-				StateName = TEXT("Pending");
-				break;
-			case EActionState::Executing:
-				StateColor = ActionExecutingColor;
-				StateName = TEXT("Executing");
-				break;
-			case EActionState::Completed:
-				StateColor = ActionCompletedColor;
-				StateName = TEXT("Completed");
-				break;
-			case EActionState::Cancelled:
-				StateColor = ActionCancelledColor;
-				StateName = TEXT("Cancelled");
-				break;
-			default:
-				StateColor = FLinearColor::White;
-				StateName = TEXT("Unknown");
-				break;
+			const int32 TrackIndex = Event.Arg0;
+			if (TrackIndex >= NumWindowTracks)
+			{
+				return;
+			}
+
+			FDopeSheetTrack& Track = Tracks[TrackIndex];
+			if (Event.Arg1 != 0)
+			{
+				// Opened: the bar grows when the matching expire arrives
+				OpenWindowStart[TrackIndex] = Time;
+				Track.Events.Emplace(Time, Track.TrackName, Track.TrackColor, true, 0.0f);
+			}
+			else if (OpenWindowStart[TrackIndex] >= 0.0f)
+			{
+				for (int32 Index = Track.Events.Num() - 1; Index >= 0; --Index)
+				{
+					if (Track.Events[Index].Time == OpenWindowStart[TrackIndex])
+					{
+						Track.Events[Index].Duration = Time - OpenWindowStart[TrackIndex];
+						break;
+					}
+				}
+				OpenWindowStart[TrackIndex] = -1.0f;
+			}
+			MarkTrackDirty(TrackIndex);
+			break;
 		}
 
-		FString InputName = UEnum::GetValueAsString(Action.InputAction.InputType);
-		InputName.RemoveFromStart(TEXT("EInputType::"));
+		case ECombatRecordedEventType::Input:
+		{
+			const EInputType InputType = static_cast<EInputType>(Event.Arg0);
+			const bool bPress = static_cast<EInputEventType>(Event.Arg1) == EInputEventType::Press;
+
+			FString InputName = UEnum::GetValueAsString(InputType);
+			InputName.RemoveFromStart(TEXT("EInputType::"));
+
+			Tracks[InputEventTrackIndex].Events.Emplace(Time, InputName + (bPress ? TEXT(" (Press)") : TEXT(" (Release)")),
+				bPress ? InputPressColor : InputReleaseColor, false);
+			MarkTrackDirty(InputEventTrackIndex);
+			break;
+		}
+
+		case ECombatRecordedEventType::Queue:
+		{
+			FActionQueueEntry Action;
+			Action.InputAction.InputType = static_cast<EInputType>(Event.Arg1);
+			Action.ScheduledTime = Time;
+			switch (static_cast<CombatTrace::EQueueEvent>(Event.Arg0))
+			{
+				case CombatTrace::EQueueEvent::Queued:    Action.State = EActionState::Pending; break;
+				case CombatTrace::EQueueEvent::Executed:  Action.State = EActionState::Executing; break;
+				case CombatTrace::EQueueEvent::Cancelled: Action.State = EActionState::Cancelled; break;
+			}
+
+			Tracks[ActionQueueTrackIndex].Events.Add(MakeActionEvent(Action));
+			MarkTrackDirty(ActionQueueTrackIndex);
+			break;
+		}
+
+		default:
+			break;
+	}
+}
 
-		FString Label = FString::Printf(TEXT("%s (%s)"), *InputName, *StateName);
+void SCombatDebugDopeSheet::TrimRecordedEvents()
+{
+	const float OldestTime = LatestRecordedTime - RecordedHistorySeconds;
+
+	// Events arrive oldest first, so everything to drop is at the front of each track
+	for (int32 TrackIndex = 0; TrackIndex < Tracks.Num(); ++TrackIndex)
+	{
+		TArray<FDopeSheetEvent>& Events = Tracks[TrackIndex].Events;
+
+		int32 NumExpired = 0;
+		while (NumExpired < Events.Num() && Events[NumExpired].Time + Events[NumExpired].Duration < OldestTime
+			&& !(TrackIndex < NumWindowTracks && Events[NumExpired].Time == OpenWindowStart[TrackIndex]))
+		{
+			++NumExpired;
+		}
+
+		if (NumExpired > 0)
+		{
+			Events.RemoveAt(0, NumExpired, EAllowShrinking::No);
+			MarkTrackDirty(TrackIndex);
+		}
+	}
+}
 
-		Track.Events.Add(FDopeSheetEvent(
-			Action.ScheduledTime,
-			Label,
-			StateColor,
-			false // Marker
-		));
+void SCombatDebugDopeSheet::ClearRecordedEvents()
+{
+	for (int32 TrackIndex = 0; TrackIndex < Tracks.Num(); ++TrackIndex)
+	{
+		Tracks[TrackIndex].Events.Reset();
+		MarkTrackDirty(TrackIndex);
+	}
+
+	for (float& Start : OpenWindowStart)
+	{
+		Start = -1.0f;
 	}
+	LatestRecordedTime = 0.0f;
+	RebuildTrackGeometry();
+}
 
-	Tracks.Add(Track);
+void SCombatDebugDopeSheet::MarkTrackDirty(int32 TrackIndex)
+{
+	if (TrackGeometry.IsValidIndex(TrackIndex))
+	{
+		TrackGeometry[TrackIndex].bDirty = true;
+	}
+}
+
+void SCombatDebugDopeSheet::RebuildTrackGeometry()
+{
+	COMBAT_LLM_SCOPE(DopeSheet);
+	bool bAnyRebuilt = false;
+
+	for (int32 TrackIndex = 0; TrackIndex < TrackGeometry.Num(); ++TrackIndex)
+	{
+		FTrackGeometry& Geometry = TrackGeometry[TrackIndex];
+		if (!Geometry.bDirty)
+		{
+			continue;
+		}
+
+		Geometry.Spans.Reset();
+		Geometry.MaxDuration = 0.0f;
+		for (const FDopeSheetEvent& Event : Tracks[TrackIndex].Events)
+		{
+			const float Duration = Event.bIsDuration ? FMath::Max(Event.Duration, 0.0f) : 0.0f;
+			Geometry.Spans.Add({ Event.Time, Event.Time + Duration, Event.Color, Event.bIsDuration });
+			Geometry.MaxDuration = FMath::Max(Geometry.MaxDuration, Duration);
+		}
+
+		// Stable: overlapping events keep their paint order
+		Geometry.Spans.StableSort([](const FTrackSpan& A, const FTrackSpan& B) { return A.Start < B.Start; });
+		Geometry.bDirty = false;
+		bAnyRebuilt = true;
+	}
+
+	if (bAnyRebuilt)
+	{
+		InvalidateStaticLayers();
+	}
+}
+
+void SCombatDebugDopeSheet::InvalidateStaticLayers(EInvalidateWidgetReason Reason)
+{
+	if (StaticLayer.IsValid())
+	{
+		StaticLayer->Invalidate(Reason);
+	}
 }
 
 void SCombatDebugDopeSheet::DrawTimeline(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32& LayerId) const
@@ -298,6 +652,7 @@ void SCombatDebugDopeSheet::DrawTracks(const FGeometry& AllottedGeometry, FSlate
 	const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
 	const float TimelineWidth = LocalSize.X - HeaderWidth;
 	const FSlateFontInfo FontInfo = FCoreStyle::Get().GetFontStyle("Regular");
+	const float TimeRange = ViewRangeMax - ViewRangeMin;
 
 	for (int32 TrackIndex = 0; TrackIndex < Tracks.Num(); ++TrackIndex)
 	{
@@ -345,15 +700,32 @@ void SCombatDebugDopeSheet::DrawTracks(const FGeometry& AllottedGeometry, FSlate
 
 		LayerId++;
 
-		// Draw events
-		for (const FDopeSheetEvent& Event : Track.Events)
+		// Draw events in the view range: nothing before ViewRangeMin - MaxDuration can reach into view
+		const FTrackGeometry* Geometry = TrackGeometry.IsValidIndex(TrackIndex) ? &TrackGeometry[TrackIndex] : nullptr;
+		if (!Geometry || TimeRange <= 0.0f)
 		{
-			const float EventX = TimeToPixel(Event.Time, TimelineWidth) + HeaderWidth;
+			LayerId++;
+			continue;
+		}
+
+		const TArray<FTrackSpan>& Spans = Geometry->Spans;
+		const int32 FirstSpan = Algo::LowerBoundBy(Spans, ViewRangeMin - Geometry->MaxDuration, &FTrackSpan::Start);
+		for (int32 SpanIndex = FirstSpan; SpanIndex < Spans.Num() && Spans[SpanIndex].Start <= ViewRangeMax; ++SpanIndex)
+		{
+			const FTrackSpan& Event = Spans[SpanIndex];
 
 			if (Event.bIsDuration)
 			{
-				// Draw as bar
-				const float EventWidth = (Event.Duration / (ViewRangeMax - ViewRangeMin)) * TimelineWidth;
+				// Draw as bar, clipped to the view range
+				const float VisibleStart = FMath::Max(Event.Start, ViewRangeMin);
+				const float VisibleEnd = FMath::Min(Event.End, ViewRangeMax);
+				if (VisibleEnd < VisibleStart)
+				{
+					continue;
+				}
+
+				const float EventX = TimeToPixel(VisibleStart, TimelineWidth) + HeaderWidth;
+				const float EventWidth = ((VisibleEnd - VisibleStart) / TimeRange) * TimelineWidth;
 
 				FSlateDrawElement::MakeBox(
 					OutDrawElements,
@@ -367,9 +739,10 @@ void SCombatDebugDopeSheet::DrawTracks(const FGeometry& AllottedGeometry, FSlate
 					Event.Color
 				);
 			}
-			else
+			else if (Event.Start >= ViewRangeMin)
 			{
 				// Draw as marker (diamond/circle)
+				const float EventX = TimeToPixel(Event.Start, TimelineWidth) + HeaderWidth;
 				const float MarkerSize = 8.0f;
 				const FVector2D MarkerCenter(EventX, TrackY + TrackHeight * 0.5f);
 
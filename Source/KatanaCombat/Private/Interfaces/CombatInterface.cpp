@@ -0,0 +1,35 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Interfaces/CombatInterface.h"
+#include "GameFramework/Actor.h"
+
+const FCombatQuerySnapshot* ICombatInterface::GetQuerySnapshot(const AActor* Actor)
+{
+	// Native cast only finds C++ implementers - Blueprint-only implementers fall through to nullptr
+	const ICombatInterface* CombatInterface = Cast<const ICombatInterface>(Actor);
+	return CombatInterface ? CombatInterface->GetCombatQuerySnapshot() : nullptr;
+}
+
+bool ICombatInterface::QueryCombatState(const AActor* Actor, FCombatQuerySnapshot& OutSnapshot)
+{
+	if (const FCombatQuerySnapshot* Snapshot = GetQuerySnapshot(Actor))
+	{
+		OutSnapshot = *Snapshot;
+		return true;
+	}
+
+	if (!Actor || !Actor->Implements<UCombatInterface>())
+	{
+		return false;
+	}
+
+	// Blueprint shim - one reflection thunk per query
+	UObject* Object = const_cast<AActor*>(Actor);
+	OutSnapshot.CombatState = Execute_GetCombatState(Object);
+	OutSnapshot.CurrentPhase = Execute_GetCurrentPhase(Object);
+	OutSnapshot.CurrentAttack = Execute_GetCurrentAttack(Object);
+	OutSnapshot.bCanAttack = Execute_CanPerformAttack(Object);
+	OutSnapshot.bIsAttacking = Execute_IsAttacking(Object);
+	OutSnapshot.bIsInParryWindow = Execute_IsInParryWindow(Object);
+	return true;
+}
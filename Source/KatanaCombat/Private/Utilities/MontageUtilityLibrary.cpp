@@ -8,12 +8,14 @@
 #include "Animation/AnimNotifyState_ComboWindow.h"
 #include "Animation/AnimNotifyState_ParryWindow.h"
 #include "Animation/AnimNotifyState_HoldWindow.h"
-#include "DrawDebugHelpers.h"
+#include "Animation/AnimNotifyState_CancelWindow.h"
+#include "Debug/CombatDebugDrawSubsystem.h"
 #include "Engine/World.h"
 #include "Data/AttackData.h"
-
-// Forward declare LogCombat (defined in CombatComponentV2.h)
-DECLARE_LOG_CATEGORY_EXTERN(LogCombat, Log, All);
+#include "Debug/CombatTrace.h"
+#include "Core/MontageCheckpointCache.h"
+#include "UObject/ObjectKey.h"
+#include "Components/SkeletalMeshComponent.h"
 
 // ============================================================================
 // MONTAGE TIME QUERIES
@@ -128,6 +130,9 @@ float UMontageUtilityLibrary::GetMontagePlayRate(ACharacter* Character)
 
 int32 UMontageUtilityLibrary::DiscoverCheckpoints(UAnimMontage* Montage, TArray<FTimerCheckpoint>& OutCheckpoints)
 {
+	COMBAT_TRACE_SCOPE(UMontageUtilityLibrary::DiscoverCheckpoints);
+	SCOPE_CYCLE_COUNTER(STAT_Combat_DiscoverCheckpoints);
+
 	OutCheckpoints.Empty();
 
 	if (!Montage)
@@ -159,7 +164,11 @@ int32 UMontageUtilityLibrary::DiscoverCheckpoints(UAnimMontage* Montage, TArray<
 				WindowType = EActionWindowType::Hold;
 				bIsWindowNotify = true;
 			}
-			// Note: Cancel windows can be added here when AnimNotifyState_CancelWindow is implemented
+			else if (Cast<UAnimNotifyState_CancelWindow>(NotifyEvent.NotifyStateClass))
+			{
+				WindowType = EActionWindowType::Cancel;
+				bIsWindowNotify = true;
+			}
 
 			if (bIsWindowNotify)
 			{
@@ -202,6 +211,50 @@ bool UMontageUtilityLibrary::IsTimeInWindow(float CurrentTime, float StartTime,
 // PROCEDURAL EASING
 // ============================================================================
 
+namespace
+{
+	constexpr int32 NumEasingTypes = static_cast<int32>(EEasingType::EaseInOutSine) + 1;
+	constexpr int32 NumEasingEntries = UMontageUtilityLibrary::NumEasingSamples + 1;
+
+	/** Flat per-type sample tables, built once from the exact EvaluateEasing math */
+	struct FEasingLookupTables
+	{
+		alignas(16) float Samples[NumEasingTypes][NumEasingEntries];
+
+		FEasingLookupTables()
+		{
+			for (int32 Type = 0; Type < NumEasingTypes; ++Type)
+			{
+				for (int32 i = 0; i < NumEasingEntries; ++i)
+				{
+					const float Alpha = static_cast<float>(i) / UMontageUtilityLibrary::NumEasingSamples;
+					Samples[Type][i] = UMontageUtilityLibrary::EvaluateEasing(Alpha, static_cast<EEasingType>(Type));
+				}
+			}
+		}
+	};
+
+	const FEasingLookupTables& GetEasingTables()
+	{
+		static const FEasingLookupTables Tables;
+		return Tables;
+	}
+
+	FORCEINLINE const float* GetEasingSamples(EEasingType EasingType)
+	{
+		const int32 Type = static_cast<int32>(EasingType);
+		return GetEasingTables().Samples[Type < NumEasingTypes ? Type : 0];
+	}
+
+	FORCEINLINE float SampleEasing(const float* Samples, float Alpha)
+	{
+		const float Scaled = FMath::Clamp(Alpha, 0.0f, 1.0f) * UMontageUtilityLibrary::NumEasingSamples;
+		const int32 Index = FMath::Min(static_cast<int32>(Scaled), UMontageUtilityLibrary::NumEasingSamples - 1);
+		const float Frac = Scaled - static_cast<float>(Index);
+		return Samples[Index] + (Samples[Index + 1] - Samples[Index]) * Frac;
+	}
+}
+
 float UMontageUtilityLibrary::EvaluateEasing(float Alpha, EEasingType EasingType)
 {
 	// Clamp alpha to [0, 1]
@@ -248,6 +301,37 @@ float UMontageUtilityLibrary::EvaluateEasing(float Alpha, EEasingType EasingType
 	}
 }
 
+float UMontageUtilityLibrary::EvaluateEasingLUT(float Alpha, EEasingType EasingType)
+{
+	return SampleEasing(GetEasingSamples(EasingType), Alpha);
+}
+
+void UMontageUtilityLibrary::EvaluateEasingBatch(TConstArrayView<float> Alphas, EEasingType EasingType, TArrayView<float> OutEased)
+{
+	check(OutEased.Num() >= Alphas.Num());
+
+	const float* Samples = GetEasingSamples(EasingType);
+	const float* In = Alphas.GetData();
+	float* Out = OutEased.GetData();
+	const int32 Num = Alphas.Num();
+
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Out[i] = SampleEasing(Samples, In[i]);
+	}
+}
+
+void UMontageUtilityLibrary::EvaluateEasingBatch(TConstArrayView<float> Alphas, TConstArrayView<EEasingType> EasingTypes, TArrayView<float> OutEased)
+{
+	check(EasingTypes.Num() == Alphas.Num() && OutEased.Num() >= Alphas.Num());
+
+	const int32 Num = Alphas.Num();
+	for (int32 i = 0; i < Num; ++i)
+	{
+		OutEased[i] = SampleEasing(GetEasingSamples(EasingTypes[i]), Alphas[i]);
+	}
+}
+
 float UMontageUtilityLibrary::EaseLerp(float Start, float End, float Alpha, EEasingType EasingType)
 {
 	float EasedAlpha = EvaluateEasing(Alpha, EasingType);
@@ -276,8 +360,8 @@ float UMontageUtilityLibrary::CalculateTransitionPlayRate(
 	}
 	else
 	{
-		// Use procedural easing
-		Alpha = EvaluateEasing(Alpha, EasingType);
+		// Use procedural easing (lookup table - called per frame per easing character)
+		Alpha = EvaluateEasingLUT(Alpha, EasingType);
 	}
 
 	return FMath::Lerp(StartRate, TargetRate, Alpha);
@@ -365,65 +449,155 @@ int32 UMontageUtilityLibrary::GetHoldStageIndex(float HoldDuration, const TArray
 // MONTAGE SECTION UTILITIES
 // ============================================================================
 
-TArray<FName> UMontageUtilityLibrary::GetMontageSections(UAnimMontage* Montage)
+namespace
 {
-	TArray<FName> SectionNames;
+	/** Montage -> section table, shared by every world (montages are assets) */
+	TMap<FObjectKey, FMontageSectionTable>& GetSectionTables()
+	{
+		static TMap<FObjectKey, FMontageSectionTable> SectionTables;
+		return SectionTables;
+	}
 
-	if (!Montage)
+	/** Tables kept before entries for unloaded montages are swept */
+	constexpr int32 SectionTableSweepThreshold = 256;
+}
+
+void FMontageSectionTable::Build(const UAnimMontage* Montage)
+{
+	const int32 NumSections = Montage ? Montage->CompositeSections.Num() : 0;
+	Names.Reset(NumSections);
+	StartTimes.Reset(NumSections);
+	EndTimes.Reset(NumSections);
+	Length = Montage ? Montage->GetPlayLength() : 0.0f;
+
+	for (int32 SectionIndex = 0; SectionIndex < NumSections; ++SectionIndex)
 	{
-		return SectionNames;
+		Names.Add(Montage->CompositeSections[SectionIndex].SectionName);
+		StartTimes.Add(Montage->CompositeSections[SectionIndex].GetTime());
 	}
 
-	// Get composite sections from montage
-	const TArray<FCompositeSection>& CompositeSections = Montage->CompositeSections;
-	for (const FCompositeSection& Section : CompositeSections)
+	// Sections end where the next one (by time) starts, so out-of-order section lists still get the right ranges
+	for (int32 SectionIndex = 0; SectionIndex < NumSections; ++SectionIndex)
 	{
-		SectionNames.Add(Section.SectionName);
+		float EndTime = FMath::Max(Length, StartTimes[SectionIndex]);
+		for (const float OtherStart : StartTimes)
+		{
+			if (OtherStart > StartTimes[SectionIndex] && OtherStart < EndTime)
+			{
+				EndTime = OtherStart;
+			}
+		}
+		EndTimes.Add(EndTime);
+	}
+}
+
+int32 FMontageSectionTable::FindSectionAtTime(float MontageTime) const
+{
+	for (int32 SectionIndex = 0; SectionIndex < Num(); ++SectionIndex)
+	{
+		// The last moment of the montage still belongs to the section that ends there
+		const float EndTime = EndTimes[SectionIndex];
+		if (MontageTime >= StartTimes[SectionIndex] && (MontageTime < EndTime || (MontageTime == EndTime && EndTime == Length)))
+		{
+			return SectionIndex;
+		}
 	}
 
-	return SectionNames;
+	return INDEX_NONE;
 }
 
-float UMontageUtilityLibrary::GetSectionStartTime(UAnimMontage* Montage, FName SectionName)
+const FMontageSectionTable* UMontageUtilityLibrary::GetSectionTable(const UAnimMontage* Montage)
 {
+	check(IsInGameThread());
+
 	if (!Montage)
 	{
-		return -1.0f;
+		return nullptr;
 	}
 
-	int32 SectionIndex = Montage->GetSectionIndex(SectionName);
-	if (SectionIndex == INDEX_NONE)
+	TMap<FObjectKey, FMontageSectionTable>& SectionTables = GetSectionTables();
+
+#if WITH_EDITOR
+	// Section edits must show up in PIE without a restart
+	static FDelegateHandle ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddLambda([](UObject* Object)
 	{
-		return -1.0f;
+		if (Cast<UAnimMontage>(Object))
+		{
+			GetSectionTables().Remove(FObjectKey(Object));
+		}
+	});
+#endif
+
+	const FObjectKey Key(Montage);
+	if (const FMontageSectionTable* Table = SectionTables.Find(Key))
+	{
+		return Table;
 	}
 
-	return Montage->GetAnimCompositeSection(SectionIndex).GetTime();
+	// Entries for montages that were unloaded never resolve again
+	if (SectionTables.Num() >= SectionTableSweepThreshold)
+	{
+		for (auto It = SectionTables.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	FMontageSectionTable& Table = SectionTables.Add(Key);
+	Table.Build(Montage);
+	return &Table;
 }
 
-float UMontageUtilityLibrary::GetSectionDuration(UAnimMontage* Montage, FName SectionName)
+int32 UMontageUtilityLibrary::ResolveSectionIndices(const UAnimMontage* Montage, TConstArrayView<FName> SectionNames, TArray<int32>& OutIndices)
 {
-	if (!Montage)
-	{
-		return -1.0f;
-	}
+	OutIndices.Reset(SectionNames.Num());
 
-	int32 SectionIndex = Montage->GetSectionIndex(SectionName);
-	if (SectionIndex == INDEX_NONE)
+	const FMontageSectionTable* Table = GetSectionTable(Montage);
+	int32 NumResolved = 0;
+	for (const FName& SectionName : SectionNames)
 	{
-		return -1.0f;
+		const int32 SectionIndex = Table ? Table->FindSection(SectionName) : INDEX_NONE;
+		OutIndices.Add(SectionIndex);
+		NumResolved += SectionIndex != INDEX_NONE ? 1 : 0;
 	}
 
-	// Get section start time
-	float SectionStartTime = Montage->GetAnimCompositeSection(SectionIndex).GetTime();
+	return NumResolved;
+}
 
-	// Find next section or use montage end
-	float SectionEndTime = Montage->GetPlayLength();
-	if (SectionIndex + 1 < Montage->CompositeSections.Num())
+bool UMontageUtilityLibrary::JumpToSectionIndex(UAnimInstance* AnimInstance, UAnimMontage* Montage, int32 SectionIndex)
+{
+	const FMontageSectionTable* Table = GetSectionTable(Montage);
+	if (!AnimInstance || !Table || !Table->IsValidIndex(SectionIndex))
 	{
-		SectionEndTime = Montage->GetAnimCompositeSection(SectionIndex + 1).GetTime();
+		return false;
 	}
 
-	return SectionEndTime - SectionStartTime;
+	// The montage instance only takes names; the index was validated against the cached table
+	AnimInstance->Montage_JumpToSection(Table->Names[SectionIndex], Montage);
+	return true;
+}
+
+TArray<FName> UMontageUtilityLibrary::GetMontageSections(UAnimMontage* Montage)
+{
+	const FMontageSectionTable* Table = GetSectionTable(Montage);
+	return Table ? TArray<FName>(Table->Names) : TArray<FName>();
+}
+
+float UMontageUtilityLibrary::GetSectionStartTime(UAnimMontage* Montage, FName SectionName)
+{
+	const FMontageSectionTable* Table = GetSectionTable(Montage);
+	const int32 SectionIndex = Table ? Table->FindSection(SectionName) : INDEX_NONE;
+	return SectionIndex != INDEX_NONE ? Table->StartTimes[SectionIndex] : -1.0f;
+}
+
+float UMontageUtilityLibrary::GetSectionDuration(UAnimMontage* Montage, FName SectionName)
+{
+	const FMontageSectionTable* Table = GetSectionTable(Montage);
+	const int32 SectionIndex = Table ? Table->FindSection(SectionName) : INDEX_NONE;
+	return SectionIndex != INDEX_NONE ? Table->GetDuration(SectionIndex) : -1.0f;
 }
 
 FName UMontageUtilityLibrary::GetCurrentSectionName(ACharacter* Character)
@@ -445,8 +619,10 @@ FName UMontageUtilityLibrary::GetCurrentSectionName(ACharacter* Character)
 		return NAME_None;
 	}
 
-	// Get current section from montage instance
-	return AnimInstance->Montage_GetCurrentSection(CurrentMontage);
+	// Current section from the cached section table
+	const FMontageSectionTable* SectionTable = GetSectionTable(CurrentMontage);
+	const int32 SectionIndex = SectionTable->FindSectionAtTime(AnimInstance->Montage_GetPosition(CurrentMontage));
+	return SectionIndex != INDEX_NONE ? SectionTable->Names[SectionIndex] : NAME_None;
 }
 
 bool UMontageUtilityLibrary::JumpToSectionWithBlend(ACharacter* Character, FName SectionName, float BlendTime)
@@ -479,16 +655,13 @@ bool UMontageUtilityLibrary::JumpToSectionWithBlend(ACharacter* Character, FName
 	}
 	else
 	{
-		// Get current section and target section indices
-		int32 TargetSectionIndex = CurrentMontage->GetSectionIndex(SectionName);
-		if (TargetSectionIndex == INDEX_NONE)
+		// Get target section start time
+		const float TargetSectionStartTime = GetSectionStartTime(CurrentMontage, SectionName);
+		if (TargetSectionStartTime < 0.0f)
 		{
 			return false; // Section doesn't exist
 		}
 
-		// Get target section start time
-		float TargetSectionStartTime = CurrentMontage->GetAnimCompositeSection(TargetSectionIndex).GetTime();
-
 		// Get current playrate to maintain it through the blend
 		float CurrentPlayRate = AnimInstance->Montage_GetPlayRate(CurrentMontage);
 
@@ -618,7 +791,8 @@ bool UMontageUtilityLibrary::CrossfadeMontage(
 	UAnimMontage* TargetMontage,
 	float BlendTime,
 	float StartPosition,
-	float PlayRate)
+	float PlayRate,
+	bool bInertialize)
 {
 	if (!Character || !TargetMontage)
 	{
@@ -631,6 +805,22 @@ bool UMontageUtilityLibrary::CrossfadeMontage(
 		return false;
 	}
 
+	if (bInertialize)
+	{
+		// Both stop and play request inertialization: the outgoing montage drops out at once and only the
+		// target is evaluated while the Inertialization node decays the pose offset
+		FMontageBlendSettings BlendSettings(BlendTime);
+		BlendSettings.BlendMode = EMontageBlendMode::Inertialization;
+
+		if (UAnimMontage* CurrentMontage = AnimInstance->GetCurrentActiveMontage())
+		{
+			AnimInstance->Montage_StopWithBlendSettings(BlendSettings, CurrentMontage);
+		}
+
+		AnimInstance->Montage_PlayWithBlendSettings(TargetMontage, BlendSettings, PlayRate, EMontagePlayReturnType::MontageLength, StartPosition, true);
+		return true;
+	}
+
 	// Stop current montage with blend out
 	UAnimMontage* CurrentMontage = AnimInstance->GetCurrentActiveMontage();
 	if (CurrentMontage)
@@ -667,6 +857,67 @@ bool UMontageUtilityLibrary::BlendOutMontage(ACharacter* Character, float BlendO
 	return true;
 }
 
+// ============================================================================
+// ANIMATION PREWARM
+// ============================================================================
+
+int32 UMontageUtilityLibrary::PrewarmAnimation(USkeletalMeshComponent* Mesh, TConstArrayView<UAnimMontage*> Montages)
+{
+	COMBAT_TRACE_SCOPE(UMontageUtilityLibrary::PrewarmAnimation);
+
+	if (!Mesh || !Mesh->GetSkeletalMeshAsset())
+	{
+		return 0;
+	}
+
+	// Characters spawned hidden may not have initialized their anim instance yet
+	if (!Mesh->GetAnimInstance())
+	{
+		Mesh->InitAnim(false);
+	}
+
+	UAnimInstance* AnimInstance = Mesh->GetAnimInstance();
+	if (!AnimInstance)
+	{
+		return 0;
+	}
+
+	// First pose: one zero-length update and evaluation
+	Mesh->TickAnimation(0.0f, false);
+	Mesh->RefreshBoneTransforms();
+
+	UMontageCheckpointCache* CheckpointCache = Mesh->GetWorld() ? Mesh->GetWorld()->GetSubsystem<UMontageCheckpointCache>() : nullptr;
+
+	TArray<UAnimMontage*, TInlineAllocator<16>> Touched;
+	for (UAnimMontage* Montage : Montages)
+	{
+		if (!Montage || Touched.Contains(Montage))
+		{
+			continue;
+		}
+		Touched.Add(Montage);
+
+		if (CheckpointCache)
+		{
+			CheckpointCache->FindOrBuildTable(Montage);
+		}
+
+		// Creates the montage instance and resolves its slot group, then frees it before anything ticks
+		if (AnimInstance->Montage_Play(Montage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, false) > 0.0f)
+		{
+			AnimInstance->Montage_Stop(0.0f, Montage);
+		}
+	}
+
+	// Stopped instances are cleaned up on the next update - do it now rather than on the first gameplay frame
+	if (Touched.Num() > 0)
+	{
+		Mesh->TickAnimation(0.0f, false);
+	}
+
+	return Touched.Num();
+}
+
 // ============================================================================
 // DEBUG & VISUALIZATION
 // ============================================================================
@@ -683,8 +934,8 @@ void UMontageUtilityLibrary::DrawCheckpointTimeline(
 		return;
 	}
 
-	UWorld* World = WorldContextObject->GetWorld();
-	if (!World)
+	UCombatDebugDrawSubsystem* DebugDraw = UCombatDebugDrawSubsystem::Get(WorldContextObject);
+	if (!DebugDraw || !DebugDraw->ShouldDraw(Character))
 	{
 		return;
 	}
@@ -715,12 +966,12 @@ void UMontageUtilityLibrary::DrawCheckpointTimeline(
 	FVector TimelineStart = ActorLocation + FVector(0, 0, YOffset);
 	FVector TimelineEnd = TimelineStart + FVector(TimelineWidth, 0, 0);
 
-	DrawDebugLine(World, TimelineStart, TimelineEnd, FColor::White, false, DrawDuration, 0, 2.0f);
+	DebugDraw->AddLine(Character, TimelineStart, TimelineEnd, FColor::White, 2.0f, DrawDuration);
 
 	// Draw current time marker
 	float CurrentX = (CurrentTime / MontageDuration) * TimelineWidth;
 	FVector MarkerPos = TimelineStart + FVector(CurrentX, 0, 0);
-	DrawDebugLine(World, MarkerPos, MarkerPos + FVector(0, 0, TimelineHeight), FColor::Green, false, DrawDuration, 0, 3.0f);
+	DebugDraw->AddLine(Character, MarkerPos, MarkerPos + FVector(0, 0, TimelineHeight), FColor::Green, 3.0f, DrawDuration);
 
 	// Draw checkpoints
 	for (const FTimerCheckpoint& Checkpoint : Checkpoints)
@@ -759,7 +1010,7 @@ void UMontageUtilityLibrary::DrawCheckpointTimeline(
 			WindowColor = FColor::Green;
 		}
 
-		DrawDebugLine(World, WindowStart, WindowEnd, WindowColor, false, DrawDuration, 0, 5.0f);
+		DebugDraw->AddLine(Character, WindowStart, WindowEnd, WindowColor, 5.0f, DrawDuration);
 	}
 }
 
@@ -811,6 +1062,63 @@ void UMontageUtilityLibrary::LogCheckpoints(const TArray<FTimerCheckpoint>& Chec
 // ATTACK RESOLUTION (Combo Progression)
 // ============================================================================
 
+FAttackResolutionResult UMontageUtilityLibrary::ResolveContextAttack(
+	const UAttackData* CurrentAttack,
+	EInputType InputType,
+	const UAttackData* DefaultLightAttack,
+	const UAttackData* DefaultHeavyAttack,
+	const FCombatContextMask& ActiveContextMask,
+	const FGameplayTagContainer& ActiveContext)
+{
+	FAttackResolutionResult Result;
+
+	EAttackType WantedType = EAttackType::Light;
+	const UAttackData* DefaultAttack = nullptr;
+	switch (InputType)
+	{
+		case EInputType::LightAttack:
+			DefaultAttack = DefaultLightAttack;
+			break;
+
+		case EInputType::HeavyAttack:
+			WantedType = EAttackType::Heavy;
+			DefaultAttack = DefaultHeavyAttack;
+			break;
+
+		default:
+			return Result; // Other input types don't have attacks
+	}
+
+	// No active context - nothing can have its requirements met
+	if (ActiveContextMask.IsEmpty() && ActiveContext.IsEmpty())
+	{
+		return Result;
+	}
+
+	for (const UAttackData* Source : { CurrentAttack, DefaultAttack })
+	{
+		if (!Source)
+		{
+			continue;
+		}
+
+		for (UAttackData* Variant : Source->ContextVariants)
+		{
+			if (Variant && Variant->AttackType == WantedType && !Variant->RequiredContextTags.IsEmpty()
+				&& Variant->MatchesContext(ActiveContextMask, ActiveContext))
+			{
+				Result.Attack = Variant;
+				Result.Path = Variant->GetContextResolutionPath();
+				COMBAT_LOG(Verbose, TEXT("[V2 RESOLVE] ✓ Resolved to context variant of '%s': '%s'"),
+					*Source->GetName(), *Variant->GetName());
+				return Result;
+			}
+		}
+	}
+
+	return Result;
+}
+
 UAttackData* UMontageUtilityLibrary::GetComboAttack(
 	UAttackData* CurrentAttack,
 	EInputType InputType,
@@ -826,40 +1134,42 @@ UAttackData* UMontageUtilityLibrary::GetComboAttack(
 	if (InputType == EInputType::LightAttack)
 	{
 		// Check for directional follow-up first (if direction specified)
-		if (Direction != EAttackDirection::None && CurrentAttack->DirectionalFollowUps.Num() > 0)
+		if (Direction != EAttackDirection::None && CurrentAttack->HasDirectionalFollowUps(EInputType::LightAttack))
 		{
-			if (TObjectPtr<UAttackData>* DirectionalAttack = CurrentAttack->DirectionalFollowUps.Find(Direction))
+			bool bHasEntry = false;
+			UAttackData* DirectionalAttack = CurrentAttack->GetDirectionalFollowUp(EInputType::LightAttack, Direction, &bHasEntry);
+			if (bHasEntry)
 			{
-				UE_LOG(LogTemp, Log, TEXT("[COMBO RESOLVE] Found directional light follow-up from '%s': '%s'"),
-					*CurrentAttack->GetName(), *(*DirectionalAttack)->GetName());
-				return *DirectionalAttack;
+				COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Found directional light follow-up from '%s': '%s'"),
+					*CurrentAttack->GetName(), *GetNameSafe(DirectionalAttack));
+				return DirectionalAttack;
 			}
 			else
 			{
-				UE_LOG(LogTemp, Warning, TEXT("[COMBO RESOLVE] Direction '%s' specified but no directional follow-up found for '%s'"),
+				COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Direction '%s' specified but no directional follow-up found for '%s'"),
 					*UEnum::GetValueAsString(Direction), *CurrentAttack->GetName());
 			}
 		}
 
 		// Normal light combo chain (fallback from directional or no direction specified)
-		UAttackData* NextAttack = CurrentAttack->NextComboAttack;
+		UAttackData* NextAttack = CurrentAttack->GetNextComboAttack();
 		if (NextAttack)
 		{
-			UE_LOG(LogTemp, Log, TEXT("[COMBO RESOLVE] Light combo chain: '%s' → '%s'"),
+			COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Light combo chain: '%s' → '%s'"),
 				*CurrentAttack->GetName(), *NextAttack->GetName());
 		}
 		else
 		{
 			// Terminal node - check if this is a dead-end (no NextComboAttack AND no DirectionalFollowUps)
 			// If so, return nullptr to signal combo reset instead of allowing infinite loops
-			if (CurrentAttack->DirectionalFollowUps.Num() == 0)
+			if (!CurrentAttack->HasDirectionalFollowUps(EInputType::LightAttack))
 			{
-				UE_LOG(LogTemp, Warning, TEXT("[COMBO RESOLVE] Terminal node '%s' (no NextComboAttack, no DirectionalFollowUps) → combo chain ends, resetting to default"),
+				COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Terminal node '%s' (no NextComboAttack, no DirectionalFollowUps) → combo chain ends, resetting to default"),
 					*CurrentAttack->GetName());
 				return nullptr; // Combo reset - ResolveNextAttack will use default attack
 			}
 
-			UE_LOG(LogTemp, Warning, TEXT("[COMBO RESOLVE] Light combo chain ends at '%s' (NextComboAttack is nullptr, but has DirectionalFollowUps)"),
+			COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Light combo chain ends at '%s' (NextComboAttack is nullptr, but has DirectionalFollowUps)"),
 				*CurrentAttack->GetName());
 		}
 		return NextAttack;
@@ -869,40 +1179,42 @@ UAttackData* UMontageUtilityLibrary::GetComboAttack(
 	if (InputType == EInputType::HeavyAttack)
 	{
 		// Check for heavy directional follow-up first (if direction specified)
-		if (Direction != EAttackDirection::None && CurrentAttack->HeavyDirectionalFollowUps.Num() > 0)
+		if (Direction != EAttackDirection::None && CurrentAttack->HasDirectionalFollowUps(EInputType::HeavyAttack))
 		{
-			if (TObjectPtr<UAttackData>* DirectionalAttack = CurrentAttack->HeavyDirectionalFollowUps.Find(Direction))
+			bool bHasEntry = false;
+			UAttackData* DirectionalAttack = CurrentAttack->GetDirectionalFollowUp(EInputType::HeavyAttack, Direction, &bHasEntry);
+			if (bHasEntry)
 			{
-				UE_LOG(LogTemp, Log, TEXT("[COMBO RESOLVE] Found directional heavy follow-up from '%s': '%s'"),
-					*CurrentAttack->GetName(), *(*DirectionalAttack)->GetName());
-				return *DirectionalAttack;
+				COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Found directional heavy follow-up from '%s': '%s'"),
+					*CurrentAttack->GetName(), *GetNameSafe(DirectionalAttack));
+				return DirectionalAttack;
 			}
 			else
 			{
-				UE_LOG(LogTemp, Warning, TEXT("[COMBO RESOLVE] Direction '%s' specified but no heavy directional follow-up found for '%s'"),
+				COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Direction '%s' specified but no heavy directional follow-up found for '%s'"),
 					*UEnum::GetValueAsString(Direction), *CurrentAttack->GetName());
 			}
 		}
 
 		// Normal heavy branch
-		UAttackData* HeavyBranch = CurrentAttack->HeavyComboAttack;
+		UAttackData* HeavyBranch = CurrentAttack->GetHeavyComboAttack();
 		if (HeavyBranch)
 		{
-			UE_LOG(LogTemp, Log, TEXT("[COMBO RESOLVE] Heavy combo branch: '%s' → '%s'"),
+			COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Heavy combo branch: '%s' → '%s'"),
 				*CurrentAttack->GetName(), *HeavyBranch->GetName());
 		}
 		else
 		{
 			// Terminal node - check if this is a dead-end (no HeavyComboAttack AND no HeavyDirectionalFollowUps)
 			// If so, return nullptr to signal combo reset instead of allowing infinite loops
-			if (CurrentAttack->HeavyDirectionalFollowUps.Num() == 0)
+			if (!CurrentAttack->HasDirectionalFollowUps(EInputType::HeavyAttack))
 			{
-				UE_LOG(LogTemp, Warning, TEXT("[COMBO RESOLVE] Terminal node '%s' (no HeavyComboAttack, no HeavyDirectionalFollowUps) → combo chain ends, resetting to default"),
+				COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Terminal node '%s' (no HeavyComboAttack, no HeavyDirectionalFollowUps) → combo chain ends, resetting to default"),
 					*CurrentAttack->GetName());
 				return nullptr; // Combo reset - ResolveNextAttack will use default attack
 			}
 
-			UE_LOG(LogTemp, Warning, TEXT("[COMBO RESOLVE] Heavy combo branch ends at '%s' (HeavyComboAttack is nullptr, but has HeavyDirectionalFollowUps)"),
+			COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Heavy combo branch ends at '%s' (HeavyComboAttack is nullptr, but has HeavyDirectionalFollowUps)"),
 				*CurrentAttack->GetName());
 		}
 		return HeavyBranch;
@@ -922,10 +1234,12 @@ UAttackData* UMontageUtilityLibrary::ResolveNextAttack(
 	UAttackData* DefaultHeavyAttack,
 	EAttackDirection Direction)
 {
+	COMBAT_TRACE_SCOPE(UMontageUtilityLibrary::ResolveNextAttack);
+
 	const TCHAR* InputTypeName = InputType == EInputType::LightAttack ? TEXT("Light") :
 	                             InputType == EInputType::HeavyAttack ? TEXT("Heavy") : TEXT("Other");
 
-	UE_LOG(LogTemp, Log, TEXT("[COMBO RESOLVE] ResolveNextAttack: Input=%s, ComboWindow=%s, CurrentAttack=%s, Holding=%s"),
+	COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] ResolveNextAttack: Input=%s, ComboWindow=%s, CurrentAttack=%s, Holding=%s"),
 		InputTypeName,
 		bComboWindowActive ? TEXT("ACTIVE") : TEXT("Inactive"),
 		CurrentAttack ? *CurrentAttack->GetName() : TEXT("nullptr"),
@@ -934,28 +1248,28 @@ UAttackData* UMontageUtilityLibrary::ResolveNextAttack(
 	// If combo window is active and we have a current attack, try to combo
 	if (bComboWindowActive && CurrentAttack)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[COMBO RESOLVE] Attempting combo progression from '%s'..."), *CurrentAttack->GetName());
+		COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Attempting combo progression from '%s'..."), *CurrentAttack->GetName());
 		UAttackData* ComboAttack = GetComboAttack(CurrentAttack, InputType, Direction);
 
 		// If combo chain continues, use it
 		if (ComboAttack)
 		{
-			UE_LOG(LogTemp, Log, TEXT("[COMBO RESOLVE] ✓ Resolved to combo: '%s'"), *ComboAttack->GetName());
+			COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] ✓ Resolved to combo: '%s'"), *ComboAttack->GetName());
 			return ComboAttack;
 		}
 
 		// If combo chain ends (nullptr), fall through to default attacks
-		UE_LOG(LogTemp, Warning, TEXT("[COMBO RESOLVE] Combo chain ended, falling back to default attack"));
+		COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] Combo chain ended, falling back to default attack"));
 	}
 	else
 	{
 		if (!bComboWindowActive)
 		{
-			UE_LOG(LogTemp, Log, TEXT("[COMBO RESOLVE] No combo window → using default attack"));
+			COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] No combo window → using default attack"));
 		}
 		if (!CurrentAttack)
 		{
-			UE_LOG(LogTemp, Log, TEXT("[COMBO RESOLVE] No current attack → using default attack"));
+			COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] No current attack → using default attack"));
 		}
 	}
 
@@ -977,7 +1291,7 @@ UAttackData* UMontageUtilityLibrary::ResolveNextAttack(
 
 	if (ResolvedAttack)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[COMBO RESOLVE] ✓ Resolved to default: '%s'"), *ResolvedAttack->GetName());
+		COMBAT_LOG(Verbose, TEXT("[COMBO RESOLVE] ✓ Resolved to default: '%s'"), *ResolvedAttack->GetName());
 	}
 	else
 	{
@@ -1002,6 +1316,9 @@ FAttackResolutionResult UMontageUtilityLibrary::ResolveNextAttack_V2(
 	const FGameplayTagContainer& ActiveContext,
 	TSet<UAttackData*>& VisitedAttacks)
 {
+	COMBAT_TRACE_SCOPE(UMontageUtilityLibrary::ResolveNextAttack_V2);
+	SCOPE_CYCLE_COUNTER(STAT_Combat_ResolveNextAttack);
+
 	FAttackResolutionResult Result;
 
 	// Safety: Check for cycle (visited this attack already)
@@ -1022,7 +1339,7 @@ FAttackResolutionResult UMontageUtilityLibrary::ResolveNextAttack_V2(
 	const TCHAR* InputTypeName = InputType == EInputType::LightAttack ? TEXT("Light") :
 	                             InputType == EInputType::HeavyAttack ? TEXT("Heavy") : TEXT("Other");
 
-	UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] Input=%s, Direction=%d, Holding=%s, ComboWindow=%s, CurrentAttack=%s"),
+	COMBAT_LOG(Verbose, TEXT("[V2 RESOLVE] Input=%s, Direction=%d, Holding=%s, ComboWindow=%s, CurrentAttack=%s"),
 		InputTypeName,
 		static_cast<int32>(Direction),
 		bIsHolding ? TEXT("Yes") : TEXT("No"),
@@ -1030,29 +1347,38 @@ FAttackResolutionResult UMontageUtilityLibrary::ResolveNextAttack_V2(
 		CurrentAttack ? *CurrentAttack->GetName() : TEXT("nullptr"));
 
 	// ========================================================================
-	// PRIORITY 1: Context-Sensitive Attacks (Future: Parry Counters, Finishers)
+	// PRIORITY 1: Context-Sensitive Attacks (Parry Counters, Finishers)
 	// ========================================================================
-	// TODO Phase 2: Check RequiredContextTags against ActiveContext
-	// For now, skip this priority (no context-sensitive attacks yet)
+	// Callers with a cached mask (CombatComponentV2) run ResolveContextAttack themselves;
+	// here the container is compiled only when there is any context at all
+	if (!ActiveContext.IsEmpty())
+	{
+		const FCombatContextMask ActiveMask = FCombatContextTagTable::Get().MakeActiveMask(ActiveContext);
+		Result = ResolveContextAttack(CurrentAttack, InputType, DefaultLightAttack, DefaultHeavyAttack, ActiveMask, ActiveContext);
+		if (Result.Attack)
+		{
+			return Result;
+		}
+	}
 
 	// ========================================================================
 	// PRIORITY 2: Directional Follow-Ups (if holding + direction + current attack has directionals)
 	// ========================================================================
 	if (bIsHolding && Direction != EAttackDirection::None && CurrentAttack)
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] Checking directional follow-ups (Hold detected)..."));
+		COMBAT_LOG(Verbose, TEXT("[V2 RESOLVE] Checking directional follow-ups (Hold detected)..."));
 
 		// Check input-type-specific directional maps
 		UAttackData* DirectionalAttack = nullptr;
-		if (InputType == EInputType::HeavyAttack && CurrentAttack->HeavyDirectionalFollowUps.Contains(Direction))
+		if (InputType == EInputType::HeavyAttack || InputType == EInputType::LightAttack)
 		{
-			DirectionalAttack = CurrentAttack->HeavyDirectionalFollowUps[Direction];
-			UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] Found HeavyDirectionalFollowUp for direction %d"), static_cast<int32>(Direction));
-		}
-		else if (InputType == EInputType::LightAttack && CurrentAttack->DirectionalFollowUps.Contains(Direction))
-		{
-			DirectionalAttack = CurrentAttack->DirectionalFollowUps[Direction];
-			UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] Found DirectionalFollowUp for direction %d"), static_cast<int32>(Direction));
+			bool bHasEntry = false;
+			DirectionalAttack = CurrentAttack->GetDirectionalFollowUp(InputType, Direction, &bHasEntry);
+			if (bHasEntry)
+			{
+				COMBAT_LOG(Verbose, TEXT("[V2 RESOLVE] Found %s for direction %d"),
+					InputType == EInputType::HeavyAttack ? TEXT("HeavyDirectionalFollowUp") : TEXT("DirectionalFollowUp"), static_cast<int32>(Direction));
+			}
 		}
 
 		if (DirectionalAttack)
@@ -1060,12 +1386,12 @@ FAttackResolutionResult UMontageUtilityLibrary::ResolveNextAttack_V2(
 			Result.Attack = DirectionalAttack;
 			Result.Path = EResolutionPath::DirectionalFollowUp;
 			Result.bShouldClearDirectionalInput = true; // KEY FIX: Signal to clear LastDirectionalInput
-			UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] ✓ Resolved to DirectionalFollowUp: '%s' (CLEAR SIGNAL)"), *DirectionalAttack->GetName());
+			COMBAT_LOG(Verbose, TEXT("[V2 RESOLVE] ✓ Resolved to DirectionalFollowUp: '%s' (CLEAR SIGNAL)"), *DirectionalAttack->GetName());
 			return Result;
 		}
 		else
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] No directional follow-up found for direction %d"), static_cast<int32>(Direction));
+			COMBAT_LOG(Verbose, TEXT("[V2 RESOLVE] No directional follow-up found for direction %d"), static_cast<int32>(Direction));
 		}
 	}
 
@@ -1074,19 +1400,19 @@ FAttackResolutionResult UMontageUtilityLibrary::ResolveNextAttack_V2(
 	// ========================================================================
 	if (bComboWindowActive && CurrentAttack)
 	{
-		UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] Checking combo chain (ComboWindow active)..."));
+		COMBAT_LOG(Verbose, TEXT("[V2 RESOLVE] Checking combo chain (ComboWindow active)..."));
 
 		UAttackData* ComboAttack = GetComboAttack(CurrentAttack, InputType, Direction);
 		if (ComboAttack)
 		{
 			Result.Attack = ComboAttack;
 			Result.Path = EResolutionPath::NormalCombo;
-			UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] ✓ Resolved to NormalCombo: '%s'"), *ComboAttack->GetName());
+			COMBAT_LOG(Verbose, TEXT("[V2 RESOLVE] ✓ Resolved to NormalCombo: '%s'"), *ComboAttack->GetName());
 			return Result;
 		}
 		else
 		{
-			UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] Combo chain ended (nullptr), falling back to default"));
+			COMBAT_LOG(Verbose, TEXT("[V2 RESOLVE] Combo chain ended (nullptr), falling back to default"));
 		}
 	}
 
@@ -1112,7 +1438,7 @@ FAttackResolutionResult UMontageUtilityLibrary::ResolveNextAttack_V2(
 	{
 		Result.Attack = DefaultAttack;
 		Result.Path = EResolutionPath::Default;
-		UE_LOG(LogCombat, Log, TEXT("[V2 RESOLVE] ✓ Resolved to Default: '%s'"), *DefaultAttack->GetName());
+		COMBAT_LOG(Verbose, TEXT("[V2 RESOLVE] ✓ Resolved to Default: '%s'"), *DefaultAttack->GetName());
 	}
 	else
 	{
@@ -1149,8 +1475,8 @@ bool UMontageUtilityLibrary::LoopMontageSection(ACharacter* Character, FName Loo
 	}
 
 	// Verify section exists
-	int32 SectionIndex = CurrentMontage->GetSectionIndex(LoopSectionName);
-	if (SectionIndex == INDEX_NONE)
+	const FMontageSectionTable* SectionTable = GetSectionTable(CurrentMontage);
+	if (SectionTable->FindSection(LoopSectionName) == INDEX_NONE)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[Hold] LoopMontageSection failed: Section '%s' not found in montage '%s'"),
 			*LoopSectionName.ToString(), *CurrentMontage->GetName());
@@ -1168,47 +1494,6 @@ bool UMontageUtilityLibrary::LoopMontageSection(ACharacter* Character, FName Loo
 
 EAttackDirection UMontageUtilityLibrary::GetDirectionFromInput(FVector2D DirectionInput, float DeadzoneThreshold)
 {
-	// Check if input magnitude is below deadzone
-	float InputMagnitude = DirectionInput.Length();
-	if (InputMagnitude < DeadzoneThreshold)
-	{
-		return EAttackDirection::None;
-	}
-
-	// Normalize input
-	FVector2D NormalizedInput = DirectionInput.GetSafeNormal();
-
-	// Calculate angle in degrees (0° = forward, increases clockwise)
-	// Atan2 returns radians, convert to degrees
-	// Note: Y is forward in UE, X is right
-	float Angle = FMath::Atan2(NormalizedInput.X, NormalizedInput.Y) * (180.0f / PI);
-
-	// Normalize angle to [0, 360)
-	if (Angle < 0.0f)
-	{
-		Angle += 360.0f;
-	}
-
-	// Map angle to 4 cardinal directions (90° quadrants)
-	// Forward: 315° to 45° (90° cone)
-	// Right: 45° to 135° (90° cone)
-	// Backward: 135° to 225° (90° cone)
-	// Left: 225° to 315° (90° cone)
-
-	if (Angle >= 315.0f || Angle < 45.0f)
-	{
-		return EAttackDirection::Forward;
-	}
-	else if (Angle >= 45.0f && Angle < 135.0f)
-	{
-		return EAttackDirection::Right;
-	}
-	else if (Angle >= 135.0f && Angle < 225.0f)
-	{
-		return EAttackDirection::Backward;
-	}
-	else // 225.0° to 315.0°
-	{
-		return EAttackDirection::Left;
-	}
+	// Same 90-degree cones as the per-frame input sample (FCombatDirectionalInput)
+	return CombatHelpers::VectorToAttackDirection(DirectionInput, DeadzoneThreshold);
 }
\ No newline at end of file
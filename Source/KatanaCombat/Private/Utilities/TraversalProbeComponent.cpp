@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utilities/TraversalProbeComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "CollisionQueryParams.h"
+
+UTraversalProbeComponent::UTraversalProbeComponent()
+{
+	// Probes are query-driven - no tick needed
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+bool UTraversalProbeComponent::FindWall(const FVector& Direction, float Distance, float Radius, FHitResult& OutHit)
+{
+	const AActor* Owner = GetOwner();
+	UWorld* World = GetWorld();
+	if (!Owner || !World)
+	{
+		return false;
+	}
+
+	const FVector Origin = Owner->GetActorLocation();
+
+	if (!IsCacheValid(WallCache, Origin, Direction, Distance, Radius))
+	{
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TraversalWallProbe), false, Owner);
+		const FVector End = Origin + Direction * Distance;
+
+		WallCache.Hit = FHitResult();
+		WallCache.bHit = Radius > 0.0f
+			? World->SweepSingleByChannel(WallCache.Hit, Origin, End, FQuat::Identity, ProbeChannel, FCollisionShape::MakeSphere(Radius), QueryParams)
+			: World->LineTraceSingleByChannel(WallCache.Hit, Origin, End, ProbeChannel, QueryParams);
+
+		WallCache.Origin = Origin;
+		WallCache.Direction = Direction;
+		WallCache.Distance = Distance;
+		WallCache.Radius = Radius;
+		WallCache.Time = World->GetTimeSeconds();
+		++NumProbes;
+
+		// A new wall invalidates the ledge above the old one
+		LedgeCache.Time = -1.0;
+	}
+
+	OutHit = WallCache.Hit;
+	return WallCache.bHit;
+}
+
+bool UTraversalProbeComponent::FindLedge(const FVector& Direction, float Distance, float Radius, float MaxLedgeHeight, FHitResult& OutLedgeHit)
+{
+	FHitResult WallHit;
+	if (!FindWall(Direction, Distance, Radius, WallHit))
+	{
+		return false;
+	}
+
+	const FVector Origin = GetOwner()->GetActorLocation();
+
+	if (!IsCacheValid(LedgeCache, Origin, Direction, MaxLedgeHeight, Radius))
+	{
+		// Trace down onto the wall top, just past the wall face
+		const FVector IntoWall = -WallHit.ImpactNormal.GetSafeNormal2D() * FMath::Max(Radius, 5.0f);
+		const FVector Start = FVector(WallHit.ImpactPoint.X, WallHit.ImpactPoint.Y, Origin.Z + MaxLedgeHeight) + IntoWall;
+		const FVector End = FVector(Start.X, Start.Y, WallHit.ImpactPoint.Z);
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TraversalLedgeProbe), false, GetOwner());
+
+		LedgeCache.Hit = FHitResult();
+		LedgeCache.bHit = GetWorld()->LineTraceSingleByChannel(LedgeCache.Hit, Start, End, ProbeChannel, QueryParams)
+			&& !LedgeCache.Hit.bStartPenetrating;
+
+		LedgeCache.Origin = Origin;
+		LedgeCache.Direction = Direction;
+		LedgeCache.Distance = MaxLedgeHeight;
+		LedgeCache.Radius = Radius;
+		LedgeCache.Time = GetWorld()->GetTimeSeconds();
+		++NumProbes;
+	}
+
+	OutLedgeHit = LedgeCache.Hit;
+	return LedgeCache.bHit;
+}
+
+void UTraversalProbeComponent::InvalidateCache()
+{
+	WallCache.Time = -1.0;
+	LedgeCache.Time = -1.0;
+}
+
+bool UTraversalProbeComponent::IsCacheValid(const FProbeCache& Cache, const FVector& Origin, const FVector& Direction, float Distance, float Radius) const
+{
+	if (Cache.Time < 0.0 || GetWorld()->GetTimeSeconds() - Cache.Time > CacheDuration)
+	{
+		return false;
+	}
+
+	return FVector::DistSquared(Cache.Origin, Origin) <= FMath::Square(CacheTolerance)
+		&& Cache.Direction.Equals(Direction, 0.01f)
+		&& FMath::IsNearlyEqual(Cache.Distance, Distance)
+		&& FMath::IsNearlyEqual(Cache.Radius, Radius);
+}
\ No newline at end of file
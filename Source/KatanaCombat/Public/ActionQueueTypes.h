@@ -19,6 +19,7 @@
 
 // Forward declarations
 class UAttackData;
+class UCombatComponentV2;
 
 /**
  * Input event types for the V2 system
@@ -100,7 +101,7 @@ struct FQueuedInputAction
 	UPROPERTY(BlueprintReadOnly, Category = "Input")
 	EInputEventType EventType = EInputEventType::Press;
 
-	/** Game time when input occurred */
+	/** World time when input occurred (sub-frame when the key event's platform time is known) */
 	UPROPERTY(BlueprintReadOnly, Category = "Input")
 	float Timestamp = 0.0f;
 
@@ -108,6 +109,18 @@ struct FQueuedInputAction
 	UPROPERTY(BlueprintReadOnly, Category = "Input")
 	bool bInComboWindow = false;
 
+	/** Platform time (FPlatformTime::Seconds) the key event was seen, or when the input reached the component - unaffected by time dilation */
+	UPROPERTY(BlueprintReadOnly, Category = "Input")
+	double ReceivedRealTime = 0.0;
+
+	/** Networked mode: sequence of the input packet this came from (0 = local only) */
+	UPROPERTY(BlueprintReadOnly, Category = "Input")
+	int32 NetSequence = 0;
+
+	/** Direction held when this input arrived (deferred resolution uses this, not the component's latest) */
+	UPROPERTY(BlueprintReadOnly, Category = "Input")
+	EInputDirection Direction = EInputDirection::None;
+
 	FQueuedInputAction() = default;
 
 	FQueuedInputAction(EInputType InType, EInputEventType InEvent, float InTime, bool bComboWindow = false)
@@ -115,6 +128,7 @@ struct FQueuedInputAction
 		, EventType(InEvent)
 		, Timestamp(InTime)
 		, bInComboWindow(bComboWindow)
+		, ReceivedRealTime(FPlatformTime::Seconds())
 	{
 	}
 
@@ -125,6 +139,86 @@ struct FQueuedInputAction
 	bool IsRelease() const { return EventType == EInputEventType::Release; }
 };
 
+/**
+ * Compact wire form of one V2 input (networked mode)
+ * Clients send these instead of queue/montage state; the server replays them through its own queue
+ * Serialized as 7 bytes: packed type/event/direction, sequence, client timestamp
+ */
+USTRUCT()
+struct FCombatInputPacket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EInputType InputType = EInputType::None;
+
+	UPROPERTY()
+	EInputEventType EventType = EInputEventType::Press;
+
+	UPROPERTY()
+	EInputDirection Direction = EInputDirection::None;
+
+	/** Per-component input sequence (wraps, never 0) */
+	UPROPERTY()
+	uint16 Sequence = 0;
+
+	/** Sender's world time in milliseconds (only used as deltas between packets) */
+	UPROPERTY()
+	uint32 TimestampMs = 0;
+
+	float GetTimestampSeconds() const { return TimestampMs * 0.001f; }
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+	{
+		// 3 bits input type, 1 bit event, 4 bits direction
+		uint8 Packed = 0;
+		if (Ar.IsSaving())
+		{
+			Packed = (static_cast<uint8>(InputType) & 0x7)
+				| ((EventType == EInputEventType::Release ? 1 : 0) << 3)
+				| ((static_cast<uint8>(Direction) & 0xF) << 4);
+		}
+
+		Ar << Packed;
+		Ar << Sequence;
+		Ar << TimestampMs;
+
+		if (Ar.IsLoading())
+		{
+			InputType = static_cast<EInputType>(Packed & 0x7);
+			EventType = (Packed & (1 << 3)) ? EInputEventType::Release : EInputEventType::Press;
+			Direction = static_cast<EInputDirection>(FMath::Min<uint8>(Packed >> 4, static_cast<uint8>(EInputDirection::ForwardLeft)));
+		}
+
+		bOutSuccess = true;
+		return true;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FCombatInputPacket> : public TStructOpsTypeTraitsBase2<FCombatInputPacket>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+/**
+ * One input for UCombatComponentV2::SubmitInputBatch
+ * Same arguments as OnInputEvent plus the component it's for, so many AI characters can be fed in one pass
+ */
+struct FCombatInputCommand
+{
+	TWeakObjectPtr<UCombatComponentV2> Component;
+	EInputType InputType = EInputType::None;
+	EInputEventType EventType = EInputEventType::Press;
+	EInputDirection Direction = EInputDirection::None;
+
+	/** FPlatformTime::Seconds() the input was issued (0 = now) */
+	double PlatformTime = 0.0;
+};
+
 /**
  * Timer checkpoint defining when an action can execute
  */
@@ -160,6 +254,69 @@ struct FTimerCheckpoint
 	}
 };
 
+/**
+ * Montage-time clock for the playing attack
+ *
+ * Montage time advances linearly at the playrate between playrate changes, so the clock keeps one
+ * anchor (world time, montage time, rate) and answers "montage time now" and "world seconds until
+ * montage time T" in O(1) without reading the montage position. Whoever changes the playrate
+ * rebases it (Rebase with the real position keeps frame quantization from accumulating).
+ */
+struct FMontageClock
+{
+	/** Start (or re-anchor) the clock at a known montage position */
+	void Rebase(double WorldTime, float MontageTime, float InPlayRate)
+	{
+		AnchorWorldTime = WorldTime;
+		AnchorMontageTime = MontageTime;
+		PlayRate = InPlayRate;
+		bRunning = true;
+	}
+
+	/** Change the rate from WorldTime on, integrating the time played at the old rate */
+	void SetPlayRate(double WorldTime, float InPlayRate)
+	{
+		Rebase(WorldTime, GetMontageTime(WorldTime), InPlayRate);
+	}
+
+	void Stop() { bRunning = false; }
+	bool IsRunning() const { return bRunning; }
+	float GetPlayRate() const { return PlayRate; }
+
+	/** Montage time at WorldTime (assuming no playrate change since the last rebase) */
+	float GetMontageTime(double WorldTime) const
+	{
+		return AnchorMontageTime + static_cast<float>(WorldTime - AnchorWorldTime) * PlayRate;
+	}
+
+	/**
+	 * World seconds from WorldTime until the montage reaches MontageTime at the current rate
+	 * @return 0 if already reached, < 0 if it never will (stopped, frozen or playing away from it)
+	 */
+	float GetTimeUntil(float MontageTime, double WorldTime) const
+	{
+		if (!bRunning)
+		{
+			return -1.0f;
+		}
+
+		const float Remaining = MontageTime - GetMontageTime(WorldTime);
+		if (Remaining <= 0.0f && PlayRate >= 0.0f)
+		{
+			return 0.0f;
+		}
+
+		const float Seconds = FMath::Abs(PlayRate) > UE_KINDA_SMALL_NUMBER ? Remaining / PlayRate : -1.0f;
+		return Seconds >= 0.0f ? Seconds : -1.0f;
+	}
+
+private:
+	double AnchorWorldTime = 0.0;
+	float AnchorMontageTime = 0.0f;
+	float PlayRate = 0.0f;
+	bool bRunning = false;
+};
+
 /**
  * Action queued for execution
  */
@@ -196,6 +353,19 @@ struct FActionQueueEntry
 	UPROPERTY(BlueprintReadOnly, Category = "Action")
 	float ScheduledTime = 0.0f;
 
+	/** Latency stamps (platform seconds, 0 = not reached yet) */
+	UPROPERTY(BlueprintReadOnly, Category = "Action|Latency")
+	double InputReceivedTime = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Action|Latency")
+	double QueuedTime = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Action|Latency")
+	double ExecutedTime = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Action|Latency")
+	double FirstFrameTime = 0.0;
+
 	FActionQueueEntry() = default;
 
 	FActionQueueEntry(const FQueuedInputAction& InInput, UAttackData* InAttack, EActionExecutionMode InMode, int32 InPriority = 0)
@@ -222,6 +392,294 @@ struct FActionQueueEntry
 	bool IsExecuting() const { return State == EActionState::Executing; }
 };
 
+/**
+ * Hot fields of a queued entry, packed so queue scans touch one cache line per 8 entries
+ * The slot index into FActionQueue's parallel arrays is the entry's handle (generation lives alongside)
+ */
+struct FActionQueueHotEntry
+{
+	float ScheduledTime = 0.0f;
+	int16 Priority = 0;
+	EActionState State = EActionState::Pending;
+	EAttackPhase TargetPhase = EAttackPhase::None;
+
+	bool IsPending() const { return State == EActionState::Pending; }
+};
+static_assert(sizeof(FActionQueueHotEntry) == 8, "Keep FActionQueueHotEntry packed");
+
+/**
+ * Handle to an entry in FActionQueue
+ * Slot + generation, so a handle to a removed entry never aliases a newer one
+ */
+struct FActionQueueHandle
+{
+	static constexpr uint8 InvalidSlot = 0xFF;
+
+	uint8 Slot = InvalidSlot;
+	uint16 Generation = 0;
+
+	bool IsValid() const { return Slot != InvalidSlot; }
+
+	bool operator==(const FActionQueueHandle& Other) const { return Slot == Other.Slot && Generation == Other.Generation; }
+	bool operator!=(const FActionQueueHandle& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Fixed-capacity action queue (V2)
+ *
+ * Entries live in inline slots and are threaded into a doubly-linked list ordered by
+ * ScheduledTime (stable: equal times keep insertion order). Nothing allocates or shifts
+ * during play:
+ * - Push: claim a free slot (bitmask), insert by walking back from the tail (O(1) for in-order input)
+ * - Remove: O(1) unlink by handle
+ * - Iteration: range-for walks entries in scheduled order
+ *
+ * To remove while iterating, fetch Next()/Prev() before calling Remove().
+ *
+ * Storage is split hot/cold: scheduling fields (time, priority, state, target phase) live in a
+ * packed FActionQueueHotEntry array that Push and the per-phase scans read, while the full
+ * FActionQueueEntry (input, attack, latency stamps) is only touched for entries that match.
+ * Once queued, change State/ScheduledTime through SetState/SetScheduledTime so both stay in sync.
+ */
+USTRUCT()
+struct FActionQueue
+{
+	GENERATED_BODY()
+
+	/** Max queued actions per component (CanAcceptNewInput keeps real usage far below this) */
+	static constexpr int32 Capacity = 16;
+
+	// ============================================================================
+	// MUTATION
+	// ============================================================================
+
+	/** Insert entry ordered by ScheduledTime, returns invalid handle if the queue is full */
+	FActionQueueHandle Push(const FActionQueueEntry& Entry)
+	{
+		if (FreeMask == 0)
+		{
+			return FActionQueueHandle();
+		}
+
+		const uint8 Slot = static_cast<uint8>(FMath::CountTrailingZeros(FreeMask));
+		FreeMask &= ~(1u << Slot);
+		Entries[Slot] = Entry;
+		Hot[Slot].ScheduledTime = Entry.ScheduledTime;
+		Hot[Slot].Priority = static_cast<int16>(FMath::Clamp<int32>(Entry.Priority, MIN_int16, MAX_int16));
+		Hot[Slot].State = Entry.State;
+		Hot[Slot].TargetPhase = Entry.TargetPhase;
+		++Count;
+		++Version;
+
+		// Walk back from the tail to the last entry scheduled at or before this one
+		uint8 After = Tail;
+		while (After != FActionQueueHandle::InvalidSlot && Hot[After].ScheduledTime > Entry.ScheduledTime)
+		{
+			After = PrevSlot[After];
+		}
+
+		PrevSlot[Slot] = After;
+		NextSlot[Slot] = (After != FActionQueueHandle::InvalidSlot) ? NextSlot[After] : Head;
+
+		if (NextSlot[Slot] != FActionQueueHandle::InvalidSlot)
+		{
+			PrevSlot[NextSlot[Slot]] = Slot;
+		}
+		else
+		{
+			Tail = Slot;
+		}
+
+		if (After != FActionQueueHandle::InvalidSlot)
+		{
+			NextSlot[After] = Slot;
+		}
+		else
+		{
+			Head = Slot;
+		}
+
+		return MakeHandle(Slot);
+	}
+
+	/** Remove entry by handle (O(1)), returns false for stale/invalid handles */
+	bool Remove(FActionQueueHandle Handle)
+	{
+		if (!IsValidHandle(Handle))
+		{
+			return false;
+		}
+
+		const uint8 Slot = Handle.Slot;
+		if (PrevSlot[Slot] != FActionQueueHandle::InvalidSlot)
+		{
+			NextSlot[PrevSlot[Slot]] = NextSlot[Slot];
+		}
+		else
+		{
+			Head = NextSlot[Slot];
+		}
+
+		if (NextSlot[Slot] != FActionQueueHandle::InvalidSlot)
+		{
+			PrevSlot[NextSlot[Slot]] = PrevSlot[Slot];
+		}
+		else
+		{
+			Tail = PrevSlot[Slot];
+		}
+
+		Entries[Slot] = FActionQueueEntry(); // Drop AttackData reference
+		Hot[Slot] = FActionQueueHotEntry();
+		++Generations[Slot];
+		FreeMask |= (1u << Slot);
+		--Count;
+		++Version;
+		return true;
+	}
+
+	/** Remove all entries (invalidates every outstanding handle) */
+	void Reset()
+	{
+		for (int32 Slot = 0; Slot < Capacity; ++Slot)
+		{
+			if ((FreeMask & (1u << Slot)) == 0)
+			{
+				Entries[Slot] = FActionQueueEntry();
+				Hot[Slot] = FActionQueueHotEntry();
+				++Generations[Slot];
+			}
+		}
+
+		FreeMask = (1u << Capacity) - 1;
+		Head = FActionQueueHandle::InvalidSlot;
+		Tail = FActionQueueHandle::InvalidSlot;
+		Count = 0;
+		++Version;
+	}
+
+	// ============================================================================
+	// QUERIES
+	// ============================================================================
+
+	int32 Num() const { return Count; }
+	bool IsEmpty() const { return Count == 0; }
+
+	/** Bumped on every Push/Remove/Reset (debug views diff against it) */
+	uint32 GetVersion() const { return Version; }
+	bool IsFull() const { return FreeMask == 0; }
+
+	bool IsValidHandle(FActionQueueHandle Handle) const
+	{
+		return Handle.Slot < Capacity
+			&& (FreeMask & (1u << Handle.Slot)) == 0
+			&& Generations[Handle.Slot] == Handle.Generation;
+	}
+
+	/** Entry for handle, nullptr if stale */
+	FActionQueueEntry* Find(FActionQueueHandle Handle) { return IsValidHandle(Handle) ? &Entries[Handle.Slot] : nullptr; }
+	const FActionQueueEntry* Find(FActionQueueHandle Handle) const { return IsValidHandle(Handle) ? &Entries[Handle.Slot] : nullptr; }
+
+	/** Entry for a handle known to be valid */
+	FActionQueueEntry& Get(FActionQueueHandle Handle) { check(IsValidHandle(Handle)); return Entries[Handle.Slot]; }
+	const FActionQueueEntry& Get(FActionQueueHandle Handle) const { check(IsValidHandle(Handle)); return Entries[Handle.Slot]; }
+
+	/** Hot fields for a handle known to be valid (scan these before touching the full entry) */
+	const FActionQueueHotEntry& GetHot(FActionQueueHandle Handle) const { check(IsValidHandle(Handle)); return Hot[Handle.Slot]; }
+
+	/** Update an entry's state (hot and cold copies) */
+	void SetState(FActionQueueHandle Handle, EActionState NewState)
+	{
+		check(IsValidHandle(Handle));
+		Hot[Handle.Slot].State = NewState;
+		Entries[Handle.Slot].State = NewState;
+	}
+
+	/** Update an entry's scheduled time (hot and cold copies, does not re-sort) */
+	void SetScheduledTime(FActionQueueHandle Handle, float NewTime)
+	{
+		check(IsValidHandle(Handle));
+		Hot[Handle.Slot].ScheduledTime = NewTime;
+		Entries[Handle.Slot].ScheduledTime = NewTime;
+	}
+
+	/** Count entries in a state (hot array only, slot order) */
+	int32 CountInState(EActionState InState) const
+	{
+		int32 Result = 0;
+		for (uint32 Used = ~FreeMask & ((1u << Capacity) - 1); Used != 0; Used &= Used - 1)
+		{
+			Result += Hot[FMath::CountTrailingZeros(Used)].State == InState ? 1 : 0;
+		}
+		return Result;
+	}
+
+	/** Earliest / latest scheduled entry */
+	FActionQueueHandle First() const { return MakeHandle(Head); }
+	FActionQueueHandle Last() const { return MakeHandle(Tail); }
+
+	/** Neighbours in scheduled order (invalid handle at either end) */
+	FActionQueueHandle Next(FActionQueueHandle Handle) const { return IsValidHandle(Handle) ? MakeHandle(NextSlot[Handle.Slot]) : FActionQueueHandle(); }
+	FActionQueueHandle Prev(FActionQueueHandle Handle) const { return IsValidHandle(Handle) ? MakeHandle(PrevSlot[Handle.Slot]) : FActionQueueHandle(); }
+
+	// ============================================================================
+	// ITERATION (scheduled order, do not Remove() inside range-for)
+	// ============================================================================
+
+	template <typename QueueType, typename EntryType>
+	struct TIterator
+	{
+		QueueType* Queue;
+		uint8 Slot;
+
+		EntryType& operator*() const { return Queue->Entries[Slot]; }
+		EntryType* operator->() const { return &Queue->Entries[Slot]; }
+		TIterator& operator++() { Slot = Queue->NextSlot[Slot]; return *this; }
+		bool operator!=(const TIterator& Other) const { return Slot != Other.Slot; }
+	};
+
+	using FIterator = TIterator<FActionQueue, FActionQueueEntry>;
+	using FConstIterator = TIterator<const FActionQueue, const FActionQueueEntry>;
+
+	FIterator begin() { return FIterator{ this, Head }; }
+	FIterator end() { return FIterator{ this, FActionQueueHandle::InvalidSlot }; }
+	FConstIterator begin() const { return FConstIterator{ this, Head }; }
+	FConstIterator end() const { return FConstIterator{ this, FActionQueueHandle::InvalidSlot }; }
+
+private:
+	FActionQueueHandle MakeHandle(uint8 Slot) const
+	{
+		FActionQueueHandle Handle;
+		if (Slot != FActionQueueHandle::InvalidSlot)
+		{
+			Handle.Slot = Slot;
+			Handle.Generation = Generations[Slot];
+		}
+		return Handle;
+	}
+
+	/** Cold storage: full entries (UPROPERTY so AttackData references are tracked) */
+	UPROPERTY(VisibleAnywhere, Category = "Queue")
+	FActionQueueEntry Entries[Capacity];
+
+	/** Hot storage: parallel to Entries */
+	FActionQueueHotEntry Hot[Capacity];
+
+	uint16 Generations[Capacity] = {};
+	uint8 NextSlot[Capacity] = {};
+	uint8 PrevSlot[Capacity] = {};
+
+	uint8 Head = FActionQueueHandle::InvalidSlot;
+	uint8 Tail = FActionQueueHandle::InvalidSlot;
+
+	/** Bit set = slot free */
+	uint32 FreeMask = (1u << Capacity) - 1;
+
+	int32 Count = 0;
+
+	uint32 Version = 0;
+};
+
 /**
  * Hold event instance - tracks a single hold activation
  * Each hold gets a unique ID to prevent state confusion across multiple holds
@@ -383,6 +841,189 @@ struct FHoldState
 	}
 };
 
+/**
+ * V2 state read every frame by the anim instance, AI and UI, packed into one block
+ * Written only by UCombatComponentV2; readers take the whole block (UCombatComponentV2::GetHotState)
+ * 12 bytes: two floats, three byte enums and the flags
+ */
+USTRUCT(BlueprintType)
+struct FCombatV2HotState
+{
+	GENERATED_BODY()
+
+	/** Combo window start (world time) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
+	float ComboWindowStart = 0.0f;
+
+	/** Combo window duration */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
+	float ComboWindowDuration = 0.0f;
+
+	/** Current attack phase (tracked independently from V1) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
+	EAttackPhase CurrentPhase = EAttackPhase::None;
+
+	/** Input type that triggered current attack (Light/Heavy) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
+	EInputType CurrentAttackInputType = EInputType::None;
+
+	/** Last captured 8-way directional input (used for directional attacks, evades, holds) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
+	EInputDirection LastDirectionalInput = EInputDirection::None;
+
+	/** Is combo window currently active? */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
+	uint8 bComboWindowActive : 1;
+
+	/** Is character movement currently disabled? (for procedural sync) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
+	uint8 bMovementCurrentlyDisabled : 1;
+
+	/** Is currently in combo blend transition? (prevents premature phase reset) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
+	uint8 bInComboBlend : 1;
+
+	/** Was current attack triggered by directional follow-up? (prevents infinite directional loops) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
+	uint8 bCurrentAttackIsDirectionalFollowUp : 1;
+
+	FCombatV2HotState()
+		: bComboWindowActive(false)
+		, bMovementCurrentlyDisabled(false)
+		, bInComboBlend(false)
+		, bCurrentAttackIsDirectionalFollowUp(false)
+	{
+	}
+};
+
+/**
+ * Fixed-size latency histogram (quarter-octave buckets from 0.5 ms to ~2 s)
+ * Allocation-free so it can be fed from the input path every attack.
+ * Percentiles resolve to the bucket upper bound (~19% precision), capped at the observed max.
+ */
+struct FActionLatencyHistogram
+{
+	static constexpr int32 NumBuckets = 48;
+	static constexpr double BaseMs = 0.5;
+	static constexpr int32 BucketsPerOctave = 4;
+
+	uint32 Buckets[NumBuckets] = {};
+	uint32 SampleCount = 0;
+	double MaxMs = 0.0;
+
+	void Add(double Seconds)
+	{
+		const double Ms = FMath::Max(Seconds * 1000.0, 0.0);
+		const int32 Index = Ms <= BaseMs ? 0
+			: FMath::Min(FMath::CeilToInt32(BucketsPerOctave * FMath::Log2(Ms / BaseMs)), NumBuckets - 1);
+		++Buckets[Index];
+		++SampleCount;
+		MaxMs = FMath::Max(MaxMs, Ms);
+	}
+
+	/** Upper bound of bucket Index in milliseconds */
+	static double GetBucketUpperMs(int32 Index)
+	{
+		return BaseMs * FMath::Pow(2.0, static_cast<double>(Index) / BucketsPerOctave);
+	}
+
+	/** Percentile in milliseconds (Percentile in [0,1]); 0 when empty */
+	double GetPercentileMs(double Percentile) const
+	{
+		if (SampleCount == 0)
+		{
+			return 0.0;
+		}
+
+		const uint32 Target = FMath::Max<uint32>(1, static_cast<uint32>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 1.0) * SampleCount)));
+		uint32 Cumulative = 0;
+		for (int32 Index = 0; Index < NumBuckets; ++Index)
+		{
+			Cumulative += Buckets[Index];
+			if (Cumulative >= Target)
+			{
+				return FMath::Min(GetBucketUpperMs(Index), MaxMs);
+			}
+		}
+		return MaxMs;
+	}
+
+	void Reset()
+	{
+		*this = FActionLatencyHistogram();
+	}
+};
+
+/**
+ * Latency percentile summary (milliseconds)
+ */
+USTRUCT(BlueprintType)
+struct FActionLatencySummary
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 SampleCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	float P50Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	float P95Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	float P99Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	float MaxMs = 0.0f;
+
+	void Update(const FActionLatencyHistogram& Histogram)
+	{
+		SampleCount = static_cast<int32>(Histogram.SampleCount);
+		P50Ms = static_cast<float>(Histogram.GetPercentileMs(0.50));
+		P95Ms = static_cast<float>(Histogram.GetPercentileMs(0.95));
+		P99Ms = static_cast<float>(Histogram.GetPercentileMs(0.99));
+		MaxMs = static_cast<float>(Histogram.MaxMs);
+	}
+};
+
+/**
+ * Input-to-action latency for one execution mode
+ */
+USTRUCT(BlueprintType)
+struct FActionLatencyStats
+{
+	GENERATED_BODY()
+
+	/** Input received -> ExecuteAction succeeded (includes queue wait for Queued mode) */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	FActionLatencySummary InputToExecute;
+
+	/** Input received -> montage observed advancing (first animated frame) */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	FActionLatencySummary InputToFirstFrame;
+
+	FActionLatencyHistogram ExecuteHistogram;
+	FActionLatencyHistogram FirstFrameHistogram;
+
+	void RecordExecute(double Seconds)
+	{
+		ExecuteHistogram.Add(Seconds);
+		InputToExecute.Update(ExecuteHistogram);
+	}
+
+	void RecordFirstFrame(double Seconds)
+	{
+		FirstFrameHistogram.Add(Seconds);
+		InputToFirstFrame.Update(FirstFrameHistogram);
+	}
+
+	void Reset()
+	{
+		*this = FActionLatencyStats();
+	}
+};
+
 /**
  * Queue statistics for debugging
  */
@@ -411,6 +1052,36 @@ struct FQueueStats
 	UPROPERTY(BlueprintReadOnly, Category = "Stats")
 	int32 ImmediateExecutions = 0;
 
+	/** Networked mode: predicted executions the server disagreed with (corrected by reconciliation) */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 NetMispredictions = 0;
+
+	/** Redundant presses collapsed before resolution (button mashing) */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 CoalescedInputs = 0;
+
+	/** Combo attacks started by jumping sections on the already playing montage (no new instance) */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 SectionJumps = 0;
+
+	/** Input latency for actions executed synchronously */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	FActionLatencyStats ImmediateLatency;
+
+	/** Input latency for actions buffered to a phase transition */
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	FActionLatencyStats QueuedLatency;
+
+	FActionLatencyStats& GetLatency(EActionExecutionMode Mode)
+	{
+		return Mode == EActionExecutionMode::Immediate ? ImmediateLatency : QueuedLatency;
+	}
+
+	const FActionLatencyStats& GetLatency(EActionExecutionMode Mode) const
+	{
+		return Mode == EActionExecutionMode::Immediate ? ImmediateLatency : QueuedLatency;
+	}
+
 	void Reset()
 	{
 		TotalInputs = 0;
@@ -418,5 +1089,10 @@ struct FQueueStats
 		ActionsCancelled = 0;
 		QueuedExecutions = 0;
 		ImmediateExecutions = 0;
+		NetMispredictions = 0;
+		CoalescedInputs = 0;
+		SectionJumps = 0;
+		ImmediateLatency.Reset();
+		QueuedLatency.Reset();
 	}
 };
\ No newline at end of file
@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifyState_ActionWindow_Base.h"
+#include "AnimNotifyState_CancelWindow.generated.h"
+
+/**
+ * AnimNotifyState that marks where recovery may be cancelled into the next action
+ *
+ * Usage:
+ * 1. Add to attack montage during Recovery phase
+ * 2. Window start is the earliest point a buffered action may interrupt recovery
+ * 3. Without this notify, recovery is cancellable as soon as it begins (V2 default)
+ *
+ * Cancel Window Timeline:
+ * [──Windup──][──Active──][──Recovery──]
+ *                                ▲▲▲▲▲
+ *                            Cancel Window
+ *
+ * V2 behavior when the montage has a cancel window:
+ * - Input during Windup/Active/early Recovery → Queued
+ * - Window opens → queued actions execute (interrupting recovery)
+ * - Input inside or after the window → Immediate
+ *
+ * V1 has no authored cancel windows (recovery cancel is driven by the combo window).
+ */
+UCLASS(meta = (DisplayName = "Cancel Window"))
+class KATANACOMBAT_API UAnimNotifyState_CancelWindow : public UAnimNotifyState_ActionWindow_Base
+{
+	GENERATED_BODY()
+
+public:
+	UAnimNotifyState_CancelWindow();
+
+	virtual FString GetNotifyName_Implementation() const override;
+
+#if WITH_EDITOR
+	virtual bool CanBePlaced(UAnimSequenceBase* Animation) const override { return true; }
+#endif
+
+protected:
+	// ============================================================================
+	// ACTIONWINDOW_BASE INTERFACE
+	// ============================================================================
+
+	virtual EActionWindowType GetWindowType() const override { return EActionWindowType::Cancel; }
+	virtual void OnOpenWindow_V1(class UCombatComponent* CombatComp, float Duration) override;
+	virtual void OnCloseWindow_V1(class UCombatComponent* CombatComp) override;
+};
\ No newline at end of file
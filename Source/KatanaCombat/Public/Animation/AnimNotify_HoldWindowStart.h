@@ -73,6 +73,12 @@ public:
 
 	virtual FString GetNotifyName_Implementation() const override;
 
+	/**
+	 * World time the montage crossed this notify, within the current frame
+	 * Falls back to the frame time outside montages or while paused.
+	 */
+	static float GetCrossingWorldTime(const USkeletalMeshComponent* MeshComp, const UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference);
+
 #if WITH_EDITOR
 	virtual bool CanBePlaced(UAnimSequenceBase* Animation) const override { return true; }
 #endif
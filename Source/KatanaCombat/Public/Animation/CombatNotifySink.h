@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatNotifySink.generated.h"
+
+class AActor;
+class USkeletalMeshComponent;
+class UCombatComponent;
+class UCombatComponentV2;
+class UWeaponComponent;
+class UAttackData;
+
+/**
+ * Resolved combat receivers for one skeletal mesh
+ *
+ * AnimNotifies used to Cast the owner, read CombatSettings->bUseV2System and run
+ * FindComponentByClass on every NotifyBegin/NotifyEnd. The sink resolves all of that once
+ * and is cached on USamuraiAnimInstance, so notifies dispatch straight to the receivers.
+ *
+ * Meshes driven by other anim instance classes fall back to resolving per notify.
+ */
+USTRUCT()
+struct KATANACOMBAT_API FCombatNotifySink
+{
+	GENERATED_BODY()
+
+	/** V1 combat component (window open/close when V2 is not active) */
+	UPROPERTY(Transient)
+	TObjectPtr<UCombatComponent> CombatComponent = nullptr;
+
+	/** V2 combat component - only set when the owner created the V2 stack (CombatSettings->bUseV2System) */
+	UPROPERTY(Transient)
+	TObjectPtr<UCombatComponentV2> CombatComponentV2 = nullptr;
+
+	/** Owner implementing ICombatInterface (phase transitions, hold start, hit detection) */
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> CombatInterfaceOwner = nullptr;
+
+	/** Owner's weapon - hit detection toggles go straight here, skipping the interface round trip */
+	UPROPERTY(Transient)
+	TObjectPtr<UWeaponComponent> WeaponComponent = nullptr;
+
+	/** Has Resolve() run since the last Reset()? */
+	bool bResolved = false;
+
+	/**
+	 * Resolve receivers from the mesh owner
+	 * @param Owner - Actor owning the skeletal mesh (may be null for editor previews)
+	 */
+	void Resolve(AActor* Owner);
+
+	/** Clear receivers (next Get resolves again) */
+	void Reset();
+
+	/** Is V2 checkpoint registration active for this mesh? */
+	bool UsesV2() const { return CombatComponentV2 != nullptr; }
+
+	/** Attack the owner is playing (from whichever combat stack is active), nullptr between attacks */
+	const UAttackData* GetCurrentAttack() const;
+
+	/**
+	 * Get the sink for a mesh - cached on USamuraiAnimInstance, resolved into Fallback otherwise
+	 * @param MeshComp - Mesh the notify fired on
+	 * @param Fallback - Scratch sink for anim instances without a cache
+	 * @return Sink to dispatch to (null if MeshComp is null)
+	 */
+	static const FCombatNotifySink* Get(const USkeletalMeshComponent* MeshComp, FCombatNotifySink& Fallback);
+};
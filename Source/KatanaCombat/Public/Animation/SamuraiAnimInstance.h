@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
 #include "CombatTypes.h"
+#include "Animation/CombatNotifySink.h"
 #include "SamuraiAnimInstance.generated.h"
 
 class UCombatComponent;
@@ -12,12 +13,60 @@ class UHitReactionComponent;
 class ACharacter;
 class UCharacterMovementComponent;
 
+/**
+ * Game-thread snapshot consumed by NativeThreadSafeUpdateAnimation
+ * Gathered once per frame in NativeUpdateAnimation so the worker thread never touches components
+ */
+struct FSamuraiAnimSnapshot
+{
+    /** False if owner/movement references are missing (skip update) */
+    bool bValid = false;
+
+    // Movement
+    FVector Velocity = FVector::ZeroVector;
+    FVector Forward = FVector::ForwardVector;
+    FVector Right = FVector::RightVector;
+    bool bIsFalling = false;
+    uint32 MovementVersion = 0;
+
+    // Combat (published by UCombatComponent::PublishAnimState, carries its own versions)
+    bool bHasCombat = false;
+    FCombatAnimState Combat;
+
+    // Hit reaction
+    bool bHasHitReaction = false;
+    bool bIsStunned = false;
+    float RemainingStunTime = 0.0f;
+    float FlinchAlpha = 0.0f;
+    EAttackDirection FlinchDirection = EAttackDirection::None;
+    uint32 HitReactionVersion = 0;
+};
+
+/**
+ * Snapshot versions already applied to the anim variables (worker thread only)
+ * MAX_uint32 forces the next update to apply
+ */
+struct FSamuraiAnimAppliedVersions
+{
+    uint32 Movement = MAX_uint32;
+    uint32 MovementState = MAX_uint32;
+    uint32 State = MAX_uint32;
+    uint32 Combo = MAX_uint32;
+    uint32 Posture = MAX_uint32;
+    uint32 Charge = MAX_uint32;
+    uint32 ChargeState = MAX_uint32;
+    uint32 HitReaction = MAX_uint32;
+
+    void Reset() { *this = FSamuraiAnimAppliedVersions(); }
+};
+
 /**
  * Animation instance for samurai character
  * Synchronizes combat state with animation blueprint and routes AnimNotify callbacks
  * 
  * Responsibilities:
  * 1. Sync combat state variables to Animation Blueprint every frame
+ *    (game thread gathers FSamuraiAnimSnapshot, NativeThreadSafeUpdateAnimation derives variables on a worker thread)
  * 2. Route AnimNotify callbacks from animations to appropriate components
  * 3. Provide state information for Animation Blueprint logic
  * 
@@ -41,6 +90,7 @@ class KATANACOMBAT_API USamuraiAnimInstance : public UAnimInstance
 public:
     virtual void NativeInitializeAnimation() override;
     virtual void NativeUpdateAnimation(float DeltaTime) override;
+    virtual void NativeThreadSafeUpdateAnimation(float DeltaTime) override;
 
     // ============================================================================
     // COMBAT STATE (Read by Animation Blueprint)
@@ -127,7 +177,7 @@ public:
     // CHARGE (Read by Animation Blueprint)
     // ============================================================================
 
-    /** Heavy attack charge percentage (0-1, for VFX timing) */
+    /** Heavy attack charge percentage (0-1, for VFX timing; stages reached / stage count with charge stages) */
     UPROPERTY(BlueprintReadOnly, Category = "Combat|Charge")
     float ChargePercent = 0.0f;
 
@@ -135,6 +185,10 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Combat|Charge")
     bool bIsCharging = false;
 
+    /** Charge stage of the current hold (-1 = none, see UAttackData::ChargeStages) */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat|Charge")
+    int32 ChargeStage = INDEX_NONE;
+
     // ============================================================================
     // HIT REACTIONS (Read by Animation Blueprint)
     // ============================================================================
@@ -147,6 +201,14 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Combat|Hit Reaction")
     float HitIntensity = 0.0f;
 
+    /** Procedural flinch weight (0-1, drives the additive flinch layer for low-significance actors) */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat|Hit Reaction")
+    float FlinchAlpha = 0.0f;
+
+    /** Direction of the current procedural flinch (selects the additive flinch pose) */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat|Hit Reaction")
+    EAttackDirection FlinchDirection = EAttackDirection::None;
+
     // ============================================================================
     // ANIMNOTIFY ROUTING
     // ============================================================================
@@ -205,8 +267,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Animation")
     void OnDisableHitDetection();
 
+    /**
+     * Get the resolved notify receivers for this mesh (resolved on first use)
+     * AnimNotifies dispatch through this instead of casting/searching components per fire
+     * @return Cached combat notify sink
+     */
+    const FCombatNotifySink& GetCombatNotifySink();
+
+    /** Drop the cached notify sink (ASamuraiCharacter::SelectCombatBackend calls this when the stack changes) */
+    void InvalidateCombatNotifySink() { CombatNotifySink.Reset(); }
+
 protected:
-    /** Update all animation variables from components (called in NativeUpdateAnimation) */
+    /** Gather component state into Snapshot (game thread, NativeUpdateAnimation) */
+    void GatherSnapshot();
+
+    /** Update all animation variables from Snapshot (worker thread, NativeThreadSafeUpdateAnimation) */
     void UpdateAnimationVariables();
 
     /** Update combat state variables */
@@ -247,4 +322,14 @@ private:
     /** Hit reaction component (for stun state) */
     UPROPERTY()
     TObjectPtr<UHitReactionComponent> HitReactionComponent;
+
+    /** Component state gathered on the game thread for the thread-safe update */
+    FSamuraiAnimSnapshot Snapshot;
+
+    /** Versions last applied - sub-updates skip when their version is unchanged */
+    FSamuraiAnimAppliedVersions AppliedVersions;
+
+    /** Resolved AnimNotify receivers (see GetCombatNotifySink) */
+    UPROPERTY(Transient)
+    FCombatNotifySink CombatNotifySink;
 };
\ No newline at end of file
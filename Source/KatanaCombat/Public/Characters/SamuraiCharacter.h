@@ -7,6 +7,8 @@
 #include "Interfaces/CombatInterface.h"
 #include "Interfaces/DamageableInterface.h"
 #include "CombatTypes.h"
+#include "ActionQueueTypes.h"
+#include "Engine/EngineBaseTypes.h"
 #include "SamuraiCharacter.generated.h"
 
 // Forward declarations
@@ -17,9 +19,54 @@ class UTargetingComponent;
 class UMotionWarpingComponent;
 class UWeaponComponent;
 class UHitReactionComponent;
+class UCombatEventChannelComponent;
+class UCombatArchetype;
 class UInputMappingContext;
 class UInputAction;
 struct FInputActionValue;
+class ASamuraiCharacter;
+
+/**
+ * Latched input stage: dispatches the character's held combat inputs after its controller has
+ * processed input and before the mesh updates animation (TG_PrePhysics)
+ */
+USTRUCT()
+struct FCombatInputLatchTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    ASamuraiCharacter* Target = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FCombatInputLatchTickFunction> : public TStructOpsTypeTraitsBase2<FCombatInputLatchTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+/**
+ * Aggregated combat tick: runs the character's combat component updates from one tick function
+ * (TG_DuringPhysics, after the character's own tick) instead of one registered tick per component
+ */
+USTRUCT()
+struct FCombatAggregateTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    ASamuraiCharacter* Target = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FCombatAggregateTickFunction> : public TStructOpsTypeTraitsBase2<FCombatAggregateTickFunction>
+{
+    enum { WithCopy = false };
+};
 
 /**
  * Main character class implementing combat and damageable interfaces
@@ -37,10 +84,13 @@ class KATANACOMBAT_API ASamuraiCharacter : public ACharacter, public ICombatInte
     GENERATED_BODY()
 
 public:
-    ASamuraiCharacter();
+    ASamuraiCharacter(const FObjectInitializer& ObjectInitializer);
 
+    virtual void PostInitializeComponents() override;
     virtual void Tick(float DeltaTime) override;
     virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+    virtual void RegisterActorTickFunctions(bool bRegister) override;
+    virtual void NotifyControllerChanged() override;
 
     // ============================================================================
     // CONFIGURATION
@@ -50,6 +100,13 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Settings")
     TObjectPtr<class UCombatSettings> CombatSettings;
 
+    /**
+     * Shared combat configuration for this kind of character (settings, hit reactions, targeting filter)
+     * Applied to the components before BeginPlay; when unset, each component uses its own properties
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat|Settings")
+    TObjectPtr<UCombatArchetype> CombatArchetype;
+
     // ============================================================================
     // COMPONENTS
     // ============================================================================
@@ -69,14 +126,25 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
     TObjectPtr<UMotionWarpingComponent> MotionWarpingComponent;
 
-    /** V2 combat component (alternative implementation) */
+    /** Replicates hits, parries and posture changes to remote machines */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+    TObjectPtr<UCombatEventChannelComponent> CombatEventChannel;
+
+    /** V2 combat component, layered over CombatComponent - only created when CombatSettings->bUseV2System is set */
+    UPROPERTY(Transient, VisibleInstanceOnly, BlueprintReadOnly, Category = "Combat")
     TObjectPtr<UCombatComponentV2> CombatComponentV2;
 
-    /** Debug visualization widget for V2 system */
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+    /** Debug visualization widget for V2 system (created with CombatComponentV2) */
+    UPROPERTY(Transient, VisibleInstanceOnly, BlueprintReadOnly, Category = "Combat")
     TObjectPtr<UCombatDebugWidget> CombatDebugWidget;
 
+    /**
+     * Create or drop the V2 stack (CombatComponentV2 + its debug widget) to match CombatSettings
+     * Runs at spawn from PostInitializeComponents, so characters on the V1 path never construct, register or tick V2.
+     * Call again after swapping CombatSettings at runtime; notifies re-resolve their dispatch target.
+     */
+    void SelectCombatBackend();
+
 
 
     // ============================================================================
@@ -107,6 +175,86 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
     TObjectPtr<UInputAction> ToggleDebugAction;
 
+    // ============================================================================
+    // COMBAT INPUT
+    // ============================================================================
+
+    /**
+     * Route a combat input to whichever combat system is active (V2 queue or V1 handlers)
+     * Player input handlers go through here, and AI controllers use it to drive the same
+     * attack pipeline (queue, weapon traces, instrumentation) without a PlayerController
+     * @param InputType - Which action (light, heavy, block, evade)
+     * @param EventType - Press or release
+     * @param Direction - Directional input for V2 directional attacks (ignored by V1)
+     * @param InputPlatformTime - FPlatformTime::Seconds() the key event was seen (0 = now, e.g. AI)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Combat|Input")
+    void SubmitCombatInput(EInputType InputType, EInputEventType EventType, EInputDirection Direction = EInputDirection::None, double InputPlatformTime = 0.0);
+
+    /**
+     * Hold locally controlled players' V2 inputs for the latched input stage instead of dispatching them from the input callback
+     * The stage runs after the controller has processed input and before the mesh updates animation, so an
+     * attack started by this frame's input plays this frame whichever order the rest of the world ticks in
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat|Input")
+    bool bLatchCombatInput = true;
+
+    /**
+     * Player input handlers' entry point: hold the input for the latched stage, or submit it now
+     * when the stage is off or has already run this frame
+     */
+    void LatchCombatInput(EInputType InputType, EInputEventType EventType, EInputDirection Direction, double InputPlatformTime);
+
+    /** Dispatch the held inputs through SubmitCombatInput (normally done by the latched stage, before animation) */
+    void ProcessLatchedInputs();
+
+    /** Inputs held for the latched stage */
+    int32 GetNumLatchedInputs() const { return LatchedInputs.Num(); }
+
+    /** Is the latched stage running for this character (locally controlled player with V2)? */
+    bool IsInputLatchActive() const { return InputLatchTickFunction.IsTickFunctionRegistered() && InputLatchTickFunction.IsTickFunctionEnabled(); }
+
+    /** The latched stage's tick function (the mesh tick waits on it) */
+    const FCombatInputLatchTickFunction& GetInputLatchTickFunction() const { return InputLatchTickFunction; }
+
+    // ============================================================================
+    // AGGREGATED COMBAT TICK
+    // ============================================================================
+
+    /**
+     * Tick CombatComponent, CombatComponentV2, TargetingComponent and CombatDebugWidget from one tick function, in that order
+     * Their own tick functions are unregistered at BeginPlay and their tick enabled flag only says whether they have
+     * work, so a component with nothing to do costs a branch instead of a tick task. WeaponComponent keeps its own
+     * tick (it traces after animation), HitReactionComponent never ticks
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat|Tick")
+    bool bAggregateCombatTick = true;
+
+    /** Run the aggregated components' updates (normally done by the aggregated tick) */
+    void TickCombatComponents(float DeltaTime, ELevelTick TickType);
+
+    /** Take over the tick functions of the combat components (BeginPlay, and again after the V2 stack is swapped) */
+    void AggregateCombatTicks();
+
+    /** Components ticked by the aggregated tick */
+    int32 GetNumAggregatedCombatTicks() const { return AggregatedCombatTicks.Num(); }
+
+    /** The aggregated tick's tick function */
+    const FCombatAggregateTickFunction& GetCombatAggregateTickFunction() const { return CombatAggregateTickFunction; }
+
+    /**
+     * This frame's directional input (sampled on the first read each frame)
+     * The single source for world direction, 4/8-way buckets and magnitude
+     */
+    UFUNCTION(BlueprintPure, Category = "Combat|Input")
+    const FCombatDirectionalInput& GetDirectionalInput() const;
+
+    /**
+     * Feed raw movement input (Move handler; AI or Blueprint-driven characters)
+     * @param MovementVector - Movement input (X = right, Y = forward)
+     */
+    void RecordMovementInput(const FVector2D& MovementVector);
+
     // ============================================================================
     // ICombatInterface IMPLEMENTATION
     // ============================================================================
@@ -123,6 +271,7 @@ public:
     virtual void OnAttackPhaseTransition_Implementation(EAttackPhase NewPhase) override;
     virtual bool IsInParryWindow_Implementation() const override;
     virtual void OnHoldWindowStart_Implementation(EInputType InputType) override;
+    virtual const FCombatQuerySnapshot* GetCombatQuerySnapshot() const override;
 
     // ============================================================================
     // IDamageableInterface IMPLEMENTATION
@@ -189,9 +338,51 @@ protected:
      */
     EInputDirection GetDirectionalInputFromMovement(const FVector2D& MovementVector) const;
 
+    /**
+     * When the key behind an input action changed, from UCombatInputTimingSubsystem
+     * @param Action - Action whose Started/Completed callback is running
+     * @param bPressed - Press (Started) or release (Completed)
+     * @return Platform time of the latest matching key event, 0 if unknown
+     */
+    double GetInputPlatformTime(const UInputAction* Action, bool bPressed) const;
+
     /** Last captured movement vector (for directional input) */
     FVector2D LastMovementInput;
 
+    /** GFrameCounter when LastMovementInput arrived (Move only fires while the stick is deflected) */
+    uint64 LastMovementInputFrame = 0;
+
+    /** Cached per-frame sample behind GetDirectionalInput */
+    mutable FCombatDirectionalInput DirectionalInputSample;
+
+    /** Enable the latched stage for locally controlled players and make it wait on their controller */
+    void UpdateInputLatch();
+
+    /** Inputs held by LatchCombatInput until the latched stage */
+    TArray<FCombatInputCommand, TInlineAllocator<4>> LatchedInputs;
+
+    FCombatInputLatchTickFunction InputLatchTickFunction;
+
+    /** Controller the latched stage waits on */
+    TWeakObjectPtr<AController> InputLatchController;
+
+    /** GFrameCounter the latched stage last ran (inputs arriving after it go straight through) */
+    uint64 LastInputLatchFrame = 0;
+
+    /** A component ticked by the aggregated tick */
+    struct FAggregatedCombatTick
+    {
+        UActorComponent* Component = nullptr;
+
+        /** Time since the component last ticked, for components with a tick interval */
+        float PendingDeltaTime = 0.0f;
+    };
+
+    /** Aggregated components in update order */
+    TArray<FAggregatedCombatTick, TInlineAllocator<4>> AggregatedCombatTicks;
+
+    FCombatAggregateTickFunction CombatAggregateTickFunction;
+
     // ============================================================================
     // WEAPON HIT PROCESSING
     // ============================================================================
@@ -4,12 +4,16 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "GameplayTagContainer.h"
 #include "CombatTypes.generated.h"
 
 // Forward declarations
 class UAttackData;
 class UAnimMontage;
 class AActor;
+class UNiagaraSystem;
+class USoundBase;
 
 // ============================================================================
 // ENUMS
@@ -137,6 +141,42 @@ enum class ETimingFallbackMode : uint8
     DisallowMontage         UMETA(DisplayName = "Disallow Montage")
 };
 
+/**
+ * Collision shape used by an attack hit volume
+ */
+UENUM(BlueprintType)
+enum class EHitVolumeShape : uint8
+{
+    Sphere          UMETA(DisplayName = "Sphere (Blade Sweep)"),
+    Capsule         UMETA(DisplayName = "Capsule"),
+    Box             UMETA(DisplayName = "Box")
+};
+
+/**
+ * Body zone a hurtbox covers (damage zones)
+ */
+UENUM(BlueprintType)
+enum class EHurtboxZone : uint8
+{
+    None            UMETA(DisplayName = "None"),
+    Head            UMETA(DisplayName = "Head"),
+    Torso           UMETA(DisplayName = "Torso"),
+    Arms            UMETA(DisplayName = "Arms"),
+    Legs            UMETA(DisplayName = "Legs")
+};
+
+/**
+ * Defensive reaction an AI schedules against an incoming attack
+ */
+UENUM(BlueprintType)
+enum class EAIDefenseAction : uint8
+{
+    None            UMETA(DisplayName = "None"),
+    Block           UMETA(DisplayName = "Block"),
+    Parry           UMETA(DisplayName = "Parry"),
+    Evade           UMETA(DisplayName = "Evade")
+};
+
 // ============================================================================
 // STRUCTS
 // ============================================================================
@@ -338,6 +378,10 @@ struct FHitReactionInfo
     UPROPERTY(BlueprintReadWrite, Category = "Hit Reaction")
     FVector ImpactPoint = FVector::ZeroVector;
 
+    /** Body zone that was hit (None when the sweep didn't hit a hurtbox) */
+    UPROPERTY(BlueprintReadWrite, Category = "Hit Reaction")
+    EHurtboxZone HitZone = EHurtboxZone::None;
+
     FHitReactionInfo()
         : Attacker(nullptr)
         , HitDirection(FVector::ForwardVector)
@@ -346,6 +390,7 @@ struct FHitReactionInfo
         , StunDuration(0.0f)
         , bWasCounter(false)
         , ImpactPoint(FVector::ZeroVector)
+        , HitZone(EHurtboxZone::None)
     {
     }
 };
@@ -408,6 +453,184 @@ struct FMotionWarpingConfig
     bool bRequireLineOfSight = true;
 };
 
+/**
+ * Single hit volume traced by UWeaponComponent while an attack is active
+ * Volume spans StartSocket→EndSocket (shape Z axis aligned with the sockets)
+ */
+USTRUCT(BlueprintType)
+struct FAttackHitVolume
+{
+    GENERATED_BODY()
+
+    /** Shape to sweep */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Volume")
+    EHitVolumeShape Shape = EHitVolumeShape::Capsule;
+
+    /** Base socket (None = weapon component's WeaponStartSocket) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Volume")
+    FName StartSocket = NAME_None;
+
+    /** Tip socket (None = weapon component's WeaponEndSocket) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Volume")
+    FName EndSocket = NAME_None;
+
+    /** Sphere/capsule radius (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Volume",
+        meta = (EditCondition = "Shape != EHitVolumeShape::Box", ClampMin = "0.1"))
+    float Radius = 5.0f;
+
+    /** Box half extents (cm), Z is along the sockets; Z = 0 uses half the socket distance */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Volume",
+        meta = (EditCondition = "Shape == EHitVolumeShape::Box"))
+    FVector BoxHalfExtent = FVector(5.0f, 5.0f, 0.0f);
+
+    /** Phase this volume is traced in (None = any phase while hit detection is enabled) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Volume")
+    EAttackPhase Phase = EAttackPhase::Active;
+
+    /** Seconds after hit detection enables before this volume starts tracing */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Volume", meta = (ClampMin = "0.0"))
+    float ActiveRangeStart = 0.0f;
+
+    /** Seconds after hit detection enables when this volume stops tracing (0 = until disabled) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Volume", meta = (ClampMin = "0.0"))
+    float ActiveRangeEnd = 0.0f;
+
+    /** Is this volume live at the given time since hit detection was enabled? */
+    bool IsActiveAt(float TimeSinceEnabled) const
+    {
+        return TimeSinceEnabled >= ActiveRangeStart && (ActiveRangeEnd <= 0.0f || TimeSinceEnabled <= ActiveRangeEnd);
+    }
+};
+
+/**
+ * Per-attack hit volume profile
+ * Empty profile = weapon component's default sweep (TraceRadius + weapon sockets)
+ */
+USTRUCT(BlueprintType)
+struct FAttackHitVolumeProfile
+{
+    GENERATED_BODY()
+
+    /** Volumes traced for this attack (replace the weapon's default sweep when non-empty) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Volume")
+    TArray<FAttackHitVolume> Volumes;
+
+    bool HasVolumes() const { return Volumes.Num() > 0; }
+};
+
+/**
+ * Combat query block for native callers (AI conditions, parry checks, UI)
+ * Same answers as the ICombatInterface query events, read directly instead of through their reflection thunks
+ * (see ICombatInterface::GetCombatQuerySnapshot)
+ */
+struct FCombatQuerySnapshot
+{
+    ECombatState CombatState = ECombatState::Idle;
+    EAttackPhase CurrentPhase = EAttackPhase::None;
+
+    /** Attack being performed, or nullptr if not attacking */
+    UAttackData* CurrentAttack = nullptr;
+
+    bool bCanAttack = false;
+    bool bIsAttacking = false;
+
+    /** Attacker-side parry window (this actor can be parried) */
+    bool bIsInParryWindow = false;
+};
+
+/**
+ * Combat state snapshot for animation
+ * Published by UCombatComponent on the game thread, read by USamuraiAnimInstance on the anim worker thread
+ * Each group carries a change counter so consumers can skip work when nothing changed
+ */
+USTRUCT(BlueprintType)
+struct FCombatAnimState
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    ECombatState CombatState = ECombatState::Idle;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    EAttackPhase CurrentPhase = EAttackPhase::None;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    bool bIsAttacking = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    bool bIsBlocking = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    bool bIsGuardBroken = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    bool bIsHolding = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    int32 ComboCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    bool bCanCombo = false;
+
+    /** Posture as percentage (0-1) */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    float PosturePercent = 1.0f;
+
+    /** Charge stage of the current hold (INDEX_NONE = none reached / not holding) */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    int32 ChargeStage = INDEX_NONE;
+
+    /** Stages in the current attack's charge table (0 = attack has no stages) */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    int32 NumChargeStages = 0;
+
+    /** Bumped when CombatState, CurrentPhase or any state flag changes */
+    uint32 StateVersion = 0;
+
+    /** Bumped when ComboCount or bCanCombo changes */
+    uint32 ComboVersion = 0;
+
+    /** Bumped when PosturePercent changes */
+    uint32 PostureVersion = 0;
+
+    /** Bumped when ChargeStage or NumChargeStages changes */
+    uint32 ChargeVersion = 0;
+};
+
+/**
+ * Impact feedback for one surface / attack type pair (UCombatImpactSubsystem)
+ * Lookup prefers an exact match, then Default surface, then AttackType None (any attack)
+ */
+USTRUCT(BlueprintType)
+struct FCombatImpactEffect
+{
+    GENERATED_BODY()
+
+    /** Surface of the hit component's physical material */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Impact")
+    TEnumAsByte<EPhysicalSurface> Surface = SurfaceType_Default;
+
+    /** Attack type this effect is for (None = any) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Impact")
+    EAttackType AttackType = EAttackType::None;
+
+    /** Spawned from the Niagara component pool when no impact data channel is set */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Impact")
+    TObjectPtr<UNiagaraSystem> NiagaraSystem = nullptr;
+
+    /** Played once per frame at the centroid of this effect's hits */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Impact")
+    TObjectPtr<USoundBase> Sound = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Impact", meta = (ClampMin = "0.0"))
+    float VolumeMultiplier = 1.0f;
+
+    /** Extra volume per additional merged hit (a three-enemy cleave plays one louder sound) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Impact", meta = (ClampMin = "0.0"))
+    float VolumePerMergedHit = 0.15f;
+};
+
 // ============================================================================
 // DELEGATES
 // ============================================================================
@@ -426,6 +649,18 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnGuardBroken);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPerfectParry, AActor*, ParriedActor);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPerfectEvade, AActor*, EvadedActor);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFinisherAvailable, AActor*, Target);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnChargeStageChanged, int32, Stage, FGameplayTag, StageTag);
+
+// Native counterparts for C++ listeners (broadcast alongside the dynamic ones, no reflection dispatch)
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCombatStateChangedNative, ECombatState /*NewState*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnAttackHitNative, AActor* /*HitActor*/, float /*Damage*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPostureChangedNative, float /*NewPosture*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnV2PhaseChangedNative, EAttackPhase /*OldPhase*/, EAttackPhase /*NewPhase*/);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnV2MontageEventNative, UAnimMontage* /*Montage*/, bool /*bInterrupted*/, FName /*EventName*/);
+DECLARE_MULTICAST_DELEGATE(FOnGuardBrokenNative);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPerfectParryNative, AActor* /*ParriedActor*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPerfectEvadeNative, AActor* /*EvadedActor*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnChargeStageChangedNative, int32 /*Stage*/, const FGameplayTag& /*StageTag*/);
 
 // ============================================================================
 // HELPER FUNCTIONS (Input Direction Conversion)
@@ -463,6 +698,21 @@ namespace CombatHelpers
 		}
 	}
 
+	/** Convert 4-way attack direction back to the input that produces it (AI input, replays) */
+	inline EInputDirection AttackToInputDirection(EAttackDirection AttackDir)
+	{
+		switch (AttackDir)
+		{
+			case EAttackDirection::Forward:		return EInputDirection::Forward;
+			case EAttackDirection::Backward:	return EInputDirection::Backward;
+			case EAttackDirection::Left:		return EInputDirection::Left;
+			case EAttackDirection::Right:		return EInputDirection::Right;
+			case EAttackDirection::None:
+			default:
+				return EInputDirection::None;
+		}
+	}
+
 	/**
 	 * Calculate 8-way input direction from 2D input vector
 	 * @param InputVector - Normalized 2D input (X=right, Y=forward)
@@ -504,4 +754,239 @@ namespace CombatHelpers
 		else // 292.5f - 337.5f
 			return EInputDirection::BackwardRight;
 	}
-}
\ No newline at end of file
+
+	/**
+	 * Map a yaw relative to some forward axis to a 4-way attack direction
+	 * @param YawDegrees - Relative yaw (-180..180, positive = right)
+	 */
+	inline EAttackDirection YawToAttackDirection(float YawDegrees)
+	{
+		if (YawDegrees >= -45.0f && YawDegrees < 45.0f)
+			return EAttackDirection::Forward;
+		else if (YawDegrees >= 45.0f && YawDegrees < 135.0f)
+			return EAttackDirection::Right;
+		else if (YawDegrees >= -135.0f && YawDegrees < -45.0f)
+			return EAttackDirection::Left;
+		else
+			return EAttackDirection::Backward;
+	}
+
+	/**
+	 * Calculate 4-way attack direction from 2D input vector (90-degree cones around each axis)
+	 * @param InputVector - 2D input (X=right, Y=forward)
+	 * @param DeadZone - Minimum magnitude to register input
+	 * @return 4-way direction, None inside the deadzone
+	 */
+	inline EAttackDirection VectorToAttackDirection(const FVector2D& InputVector, float DeadZone = 0.2f)
+	{
+		if (InputVector.Size() < DeadZone)
+		{
+			return EAttackDirection::None;
+		}
+
+		return YawToAttackDirection(FMath::RadiansToDegrees(FMath::Atan2(InputVector.X, InputVector.Y)));
+	}
+
+	/**
+	 * Yaw of a world direction relative to a facing (-180..180 degrees, positive = right)
+	 * @param Direction - Normalized world direction
+	 * @param Forward - Facing forward axis
+	 * @param Right - Facing right axis
+	 */
+	inline float RelativeYawDegrees(const FVector& Direction, const FVector& Forward, const FVector& Right)
+	{
+		return FMath::RadiansToDegrees(FMath::Atan2(FVector::DotProduct(Direction, Right), FVector::DotProduct(Direction, Forward)));
+	}
+}
+
+// ============================================================================
+// DIRECTIONAL INPUT
+// ============================================================================
+
+/**
+ * Directional input sampled once per frame (ASamuraiCharacter::GetDirectionalInput)
+ * Attack handlers, the combat components and follow-up resolution all read this instead of
+ * re-deriving camera-relative vectors, angles and buckets from their own copies of the stick.
+ */
+USTRUCT(BlueprintType)
+struct FCombatDirectionalInput
+{
+    GENERATED_BODY()
+
+    /** Stick/keys deadzone shared by every consumer */
+    static constexpr float DeadZone = 0.25f;
+
+    /** Raw movement input this frame (X = right, Y = forward), zero once the stick is released */
+    UPROPERTY(BlueprintReadOnly, Category = "Input")
+    FVector2D RawInput = FVector2D::ZeroVector;
+
+    /** Length of RawInput */
+    UPROPERTY(BlueprintReadOnly, Category = "Input")
+    float Magnitude = 0.0f;
+
+    /** Camera-relative world direction (normalized, zero inside the deadzone) */
+    UPROPERTY(BlueprintReadOnly, Category = "Input")
+    FVector WorldDirection = FVector::ZeroVector;
+
+    /** 8-way bucket of the stick (camera space) */
+    UPROPERTY(BlueprintReadOnly, Category = "Input")
+    EInputDirection Direction8 = EInputDirection::None;
+
+    /** 4-way bucket of the stick (camera space) */
+    UPROPERTY(BlueprintReadOnly, Category = "Input")
+    EAttackDirection Direction4 = EAttackDirection::None;
+
+    /** 4-way bucket of WorldDirection relative to the character's facing */
+    UPROPERTY(BlueprintReadOnly, Category = "Input")
+    EAttackDirection FacingDirection = EAttackDirection::None;
+
+    /** GFrameCounter when sampled */
+    uint64 FrameNumber = 0;
+
+    /** Is the stick outside the deadzone? */
+    bool HasDirection() const { return Direction8 != EInputDirection::None; }
+
+    /**
+     * Derive everything from one raw input
+     * @param InRawInput - Movement input (X = right, Y = forward)
+     * @param ControlRotation - Camera/control rotation (only yaw is used)
+     * @param ActorForward - Character facing forward axis
+     * @param ActorRight - Character facing right axis
+     */
+    static FCombatDirectionalInput Build(const FVector2D& InRawInput, const FRotator& ControlRotation, const FVector& ActorForward, const FVector& ActorRight)
+    {
+        FCombatDirectionalInput Sample;
+        Sample.RawInput = InRawInput;
+        Sample.Magnitude = InRawInput.Size();
+        if (Sample.Magnitude < DeadZone)
+        {
+            return Sample;
+        }
+
+        const FRotationMatrix YawMatrix(FRotator(0.0f, ControlRotation.Yaw, 0.0f));
+        Sample.WorldDirection = (YawMatrix.GetUnitAxis(EAxis::X) * InRawInput.Y + YawMatrix.GetUnitAxis(EAxis::Y) * InRawInput.X).GetSafeNormal();
+        Sample.Direction8 = CombatHelpers::VectorToInputDirection(InRawInput, DeadZone);
+        Sample.Direction4 = CombatHelpers::VectorToAttackDirection(InRawInput, DeadZone);
+        Sample.FacingDirection = CombatHelpers::YawToAttackDirection(CombatHelpers::RelativeYawDegrees(Sample.WorldDirection, ActorForward, ActorRight));
+        return Sample;
+    }
+};
+/**
+ * Event-driven held-button tracker
+ * Press/release events set and clear one bit per EInputType and stamp the time; nothing is polled or
+ * accumulated per tick. Hold duration is derived on demand from the press stamp, and the last release
+ * is kept so a hold window crossed mid-frame can still see a press released later in that frame.
+ */
+USTRUCT(BlueprintType)
+struct FCombatHeldInputs
+{
+    GENERATED_BODY()
+
+    static constexpr int32 NumInputs = static_cast<int32>(EInputType::Special) + 1;
+
+    /** One bit per EInputType currently held */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input")
+    uint8 HeldMask = 0;
+
+    /** Press time of each held input (world seconds, valid while its bit is set) */
+    float PressTimes[NumInputs] = {};
+
+    /** Press/release times of the latest completed hold per input (< 0 = none yet) */
+    float LastPressTimes[NumInputs] = { -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f };
+    float LastReleaseTimes[NumInputs] = { -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f };
+
+    /** Mark Type held from Time (a repeated press restamps it) */
+    void Press(EInputType Type, float Time)
+    {
+        const int32 Index = static_cast<int32>(Type);
+        HeldMask |= Bit(Type);
+        PressTimes[Index] = Time;
+    }
+
+    /**
+     * Clear Type's bit
+     * @param OutPressTime - Receives the matching press time
+     * @return False if Type wasn't held (release without a tracked press)
+     */
+    bool Release(EInputType Type, float Time, float* OutPressTime = nullptr)
+    {
+        if (!IsHeld(Type))
+        {
+            return false;
+        }
+
+        const int32 Index = static_cast<int32>(Type);
+        HeldMask &= ~Bit(Type);
+        LastPressTimes[Index] = PressTimes[Index];
+        LastReleaseTimes[Index] = Time;
+        if (OutPressTime)
+        {
+            *OutPressTime = PressTimes[Index];
+        }
+        return true;
+    }
+
+    bool IsHeld(EInputType Type) const { return Type != EInputType::None && (HeldMask & Bit(Type)) != 0; }
+    bool IsAnyHeld() const { return HeldMask != 0; }
+
+    /** Press time of a held input (< 0 when not held) */
+    float GetPressTime(EInputType Type) const { return IsHeld(Type) ? PressTimes[static_cast<int32>(Type)] : -1.0f; }
+
+    /** Seconds Type has been held at Now (0 when not held) */
+    float GetHoldDuration(EInputType Type, float Now) const
+    {
+        return IsHeld(Type) ? FMath::Max(Now - PressTimes[static_cast<int32>(Type)], 0.0f) : 0.0f;
+    }
+
+    /**
+     * Was Type down at Time? Covers both a press still held and one released after Time
+     * @param OutPressTime - Press time of the hold that spans Time
+     * @param bOutReleasedSince - True when that hold has already been released
+     */
+    bool WasHeldAt(EInputType Type, float Time, float* OutPressTime = nullptr, bool* bOutReleasedSince = nullptr) const
+    {
+        if (Type == EInputType::None)
+        {
+            return false;
+        }
+
+        const int32 Index = static_cast<int32>(Type);
+        float PressTime = -1.0f;
+        bool bReleased = false;
+        if (IsHeld(Type))
+        {
+            if (PressTimes[Index] > Time)
+            {
+                return false;
+            }
+            PressTime = PressTimes[Index];
+        }
+        else if (LastReleaseTimes[Index] >= 0.0f && LastPressTimes[Index] <= Time && LastReleaseTimes[Index] > Time)
+        {
+            PressTime = LastPressTimes[Index];
+            bReleased = true;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (OutPressTime)
+        {
+            *OutPressTime = PressTime;
+        }
+        if (bOutReleasedSince)
+        {
+            *bOutReleasedSince = bReleased;
+        }
+        return true;
+    }
+
+    /** Forget everything (nothing held) */
+    void Reset()
+    {
+        *this = FCombatHeldInputs();
+    }
+
+    static uint8 Bit(EInputType Type) { return static_cast<uint8>(1u << static_cast<uint8>(Type)); }
+};
\ No newline at end of file
@@ -0,0 +1,142 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CombatTypes.h"
+#include "Core/CombatTimerWheelSubsystem.h"
+#include "AIDefenseComponent.generated.h"
+
+struct FTimerCheckpoint;
+
+/**
+ * When to press and how long to hold a planned defense (seconds from the attack's start)
+ */
+struct FAIDefensePlan
+{
+    EAIDefenseAction Action = EAIDefenseAction::None;
+    float PressDelay = 0.0f;
+    float HoldTime = 0.0f;
+
+    bool IsValid() const { return Action != EAIDefenseAction::None; }
+};
+
+/**
+ * Predictive AI defense
+ *
+ * Nothing is polled: when an attack starts near this character, UAIDefenseSubsystem hands over
+ * the attack montage's cached checkpoint table, position and play rate. The component rolls a
+ * reaction, computes exactly when the attacker's parry window opens and closes, and schedules
+ * the block/evade press (and block release) on the combat timer wheel. At fire time it presses
+ * through ASamuraiCharacter::SubmitCombatInput, the same path as the player.
+ *
+ * Timing is limited by ReactionTime, so a reaction the AI couldn't humanly make in time degrades
+ * (parry -> late parry -> block) or is dropped.
+ */
+UCLASS(ClassGroup=(Combat), meta=(BlueprintSpawnableComponent))
+class KATANACOMBAT_API UAIDefenseComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UAIDefenseComponent();
+
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // ============================================================================
+    // CONFIGURATION
+    // ============================================================================
+
+    /** React to attacks at all */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Defense")
+    bool bDefenseEnabled = true;
+
+    /** Only react to attacks from player-controlled characters */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Defense")
+    bool bOnlyDefendAgainstPlayers = true;
+
+    /** Probability of attempting a parry (rolled first) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Defense", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float ParryChance = 0.25f;
+
+    /** Probability of blocking */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Defense", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float BlockChance = 0.35f;
+
+    /** Probability of evading (whatever is left over takes the hit) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Defense", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float EvadeChance = 0.15f;
+
+    /** Earliest the AI can act after an attack starts (seconds) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Defense", meta = (ClampMin = "0.0"))
+    float ReactionTime = 0.2f;
+
+    /** Where in the attacker's parry window the parry press lands (0 = opening, 1 = closing) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Defense", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float ParryWindowFraction = 0.4f;
+
+    /** Block is raised this long before the attacker's parry window opens */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Defense", meta = (ClampMin = "0.0"))
+    float BlockLeadTime = 0.1f;
+
+    /** Block is held this long after the parry window closes (covers the strike that follows it) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Defense", meta = (ClampMin = "0.0"))
+    float BlockHoldTime = 0.4f;
+
+    /** Attacks further away than this are ignored (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Defense", meta = (ClampMin = "0.0"))
+    float MaxReactDistance = 400.0f;
+
+    // ============================================================================
+    // SCHEDULING
+    // ============================================================================
+
+    /**
+     * An attack started nearby (called by UAIDefenseSubsystem)
+     * @param Attacker - Attacking actor
+     * @param Checkpoints - Attack montage's cached window checkpoints (current section)
+     * @param MontagePosition - Attack montage position now
+     * @param PlayRate - Effective attack play rate
+     */
+    void OnAttackStarted(AActor* Attacker, TConstArrayView<FTimerCheckpoint> Checkpoints, float MontagePosition, float PlayRate);
+
+    /**
+     * Work out press time and hold for a reaction (pure - no side effects)
+     * @param Action - Reaction to plan
+     * @param Checkpoints - Attack window checkpoints (sorted by montage time)
+     * @param MontagePosition - Attack montage position now
+     * @param PlayRate - Effective attack play rate (montage seconds per world second)
+     * @return Plan (Action None if the reaction can't be made in time); parry may degrade to block
+     */
+    FAIDefensePlan PlanDefense(EAIDefenseAction Action, TConstArrayView<FTimerCheckpoint> Checkpoints, float MontagePosition, float PlayRate) const;
+
+    /** Drop the scheduled reaction (and let go of a held block) */
+    UFUNCTION(BlueprintCallable, Category = "AI Defense")
+    void CancelPendingDefense();
+
+    /** Reaction currently scheduled or being held */
+    UFUNCTION(BlueprintPure, Category = "AI Defense")
+    EAIDefenseAction GetPendingAction() const { return PendingPlan.Action; }
+
+private:
+    /** Roll which reaction to attempt */
+    EAIDefenseAction RollDefenseAction() const;
+
+    /** Timer callbacks */
+    void PressDefenseInput();
+    void ReleaseDefenseInput();
+
+    /** Plan being executed */
+    FAIDefensePlan PendingPlan;
+
+    /** Attacker the plan answers (the press is dropped if it's gone) */
+    TWeakObjectPtr<AActor> PendingAttacker;
+
+    /** Block is pressed and waiting for its release */
+    bool bBlockHeld = false;
+
+    FCombatTimerHandle PressTimer;
+    FCombatTimerHandle ReleaseTimer;
+};
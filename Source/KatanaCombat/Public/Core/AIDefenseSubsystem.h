@@ -0,0 +1,58 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AIDefenseSubsystem.generated.h"
+
+class UAIDefenseComponent;
+class UAnimInstance;
+class UAnimMontage;
+
+/**
+ * Registry of AI defenders (UAIDefenseComponent)
+ *
+ * Combat components report each attack montage they start. If any defender is registered, the
+ * subsystem looks up the montage's cached checkpoint table once and hands it to the defenders in
+ * range, which schedule their reactions on the combat timer wheel. Nothing ticks; with no
+ * defenders an attack start costs one array check.
+ */
+UCLASS()
+class KATANACOMBAT_API UAIDefenseSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    // ============================================================================
+    // REGISTRATION
+    // ============================================================================
+
+    /** Start receiving attack starts (no-op if already registered) */
+    void RegisterDefender(UAIDefenseComponent* Defender);
+
+    /** Stop receiving attack starts */
+    void UnregisterDefender(UAIDefenseComponent* Defender);
+
+    /** Number of registered defenders */
+    int32 GetNumDefenders() const { return Defenders.Num(); }
+
+    // ============================================================================
+    // EVENTS
+    // ============================================================================
+
+    /**
+     * An attack montage started playing (called by the combat components after any section jump)
+     * @param Attacker - Attacking actor
+     * @param AnimInstance - Anim instance playing the montage
+     * @param Montage - Attack montage
+     * @param SectionName - Section the attack plays (NAME_None = whole montage)
+     */
+    void NotifyAttackStarted(AActor* Attacker, const UAnimInstance* AnimInstance, UAnimMontage* Montage, FName SectionName);
+
+private:
+    /** Registered defenders (small - AI characters with defense enabled) */
+    TArray<TWeakObjectPtr<UAIDefenseComponent>> Defenders;
+};
@@ -0,0 +1,133 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/BladeNarrowphase.h"
+#include "Data/AttackData.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Blade hit detection stepped from the Chaos async physics tick (UWeaponComponent::bUseAsyncPhysicsTrace)
+ *
+ * Every game frame the weapon publishes a snapshot: where to put the blade (the swing's baked trajectory
+ * with the montage clock and mesh transform to place it, or just the last evaluated pose) and the capsules
+ * of the targets near the swing. Each fixed physics step advances the montage clock from the snapshot,
+ * samples the blade and tests the swept segment against the capsules with FBladeNarrowphase, so hit
+ * detection runs at the physics rate whatever the frame rate. Hits are queued and handed back to the game
+ * thread with its next publish.
+ *
+ * Plain data behind one lock (held by a step while it tests, and by a publish while it swaps) - nothing
+ * here touches UObjects, so Step is safe on the physics thread.
+ */
+class KATANACOMBAT_API FAsyncBladeTrace
+{
+public:
+    /** Target capsule (world space) */
+    struct FCapsule
+    {
+        FVector A = FVector::ZeroVector;
+        FVector B = FVector::ZeroVector;
+        float Radius = 0.0f;
+    };
+
+    /** Game thread state the physics steps work from until the next publish */
+    struct FSnapshot
+    {
+        /** Owner mesh component-to-world (places baked samples) and its velocity (extrapolated between publishes) */
+        FTransform MeshTransform = FTransform::Identity;
+        FVector MeshVelocity = FVector::ZeroVector;
+
+        /** Montage time at publish and its effective playrate (the baked blade's clock advances from here each step) */
+        float MontageTime = 0.0f;
+        float PlayRate = 1.0f;
+
+        /** Evaluated blade pose (world space) - used when the swing has no bake */
+        FVector Start = FVector::ZeroVector;
+        FVector Tip = FVector::ZeroVector;
+
+        /** Targets near the swing (hits report indices into this) */
+        TArray<FCapsule> Capsules;
+    };
+
+    /** One capsule the blade reached during a step */
+    struct FHit
+    {
+        /** Index into the capsules of the snapshot published before the hit was taken */
+        int32 CapsuleIndex = INDEX_NONE;
+
+        /** Closest points between the blade and the capsule */
+        FVector OnBlade = FVector::ZeroVector;
+        FVector OnCapsule = FVector::ZeroVector;
+
+        /** Blade pose swept by the step (previous and current) */
+        FVector PrevStart = FVector::ZeroVector;
+        FVector PrevTip = FVector::ZeroVector;
+        FVector Start = FVector::ZeroVector;
+        FVector Tip = FVector::ZeroVector;
+    };
+
+    /**
+     * Start a swing (game thread), discarding any unpublished hits
+     * @param SwingVolume - Baked trajectory to sample (copied), nullptr to sweep the published pose
+     * @param InRadius - Blade thickness
+     * @param InSpatialTolerance - Largest blade travel (cm) per substep within one physics step
+     * @param InMaxSubsteps - Substep cap per physics step
+     */
+    void Begin(const FAttackSwingVolume* SwingVolume, float InRadius, float InSpatialTolerance, int32 InMaxSubsteps);
+
+    /** Stop stepping (game thread) */
+    void End();
+
+    bool IsActive() const;
+
+    /** Does the swing sample a baked trajectory (rather than the published pose)? */
+    bool IsUsingBake() const;
+
+    /**
+     * Take the hits found since the last publish, then replace the snapshot (game thread)
+     * @param Snapshot - New state for the following steps
+     * @param OutHits - Receives the hits (reset first); capsule indices refer to the previous snapshot
+     */
+    void Publish(FSnapshot&& Snapshot, TArray<FHit>& OutHits);
+
+    /**
+     * Advance one fixed step (physics thread; UWeaponComponent::AsyncPhysicsTickComponent)
+     * The first step of a swing only seeds the previous pose, like the first traced frame.
+     */
+    void Step(float DeltaTime);
+
+    /** Physics steps run this swing */
+    int32 GetNumSteps() const;
+
+private:
+    /** Blade pose a step's worth of seconds after the snapshot */
+    void SampleBlade(float Elapsed, FVector& OutStart, FVector& OutTip) const;
+
+    mutable FCriticalSection Lock;
+
+    bool bActive = false;
+    bool bHasSnapshot = false;
+    bool bHasBake = false;
+    bool bHasPrevPose = false;
+
+    FAttackSwingVolume Bake;
+    float Radius = 0.0f;
+    float SpatialTolerance = 10.0f;
+    int32 MaxSubsteps = 1;
+
+    FSnapshot Snapshot;
+
+    /** Seconds stepped since the snapshot was published */
+    float ElapsedSincePublish = 0.0f;
+
+    FVector PrevStart = FVector::ZeroVector;
+    FVector PrevTip = FVector::ZeroVector;
+
+    /** Snapshot capsules, and the ones already reported against it */
+    FBladeNarrowphase Narrowphase;
+    TBitArray<> Reported;
+
+    TArray<FHit> PendingHits;
+    int32 NumSteps = 0;
+};
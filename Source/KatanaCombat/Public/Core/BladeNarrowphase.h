@@ -0,0 +1,69 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Blade-vs-capsule narrowphase for weapon hits on pawns
+ *
+ * Capsules are stored SoA and tested against a swept blade segment four at a time with the
+ * engine's portable vector registers (SSE / NEON) - a closest-points segment-segment distance
+ * per lane compared against the combined radius. Plain data, no UObjects and no physics scene;
+ * UWeaponComponent fills it with hurtbox capsules pulled from UTargetRegistrySubsystem.
+ */
+struct KATANACOMBAT_API FBladeNarrowphase
+{
+    /** Capsules tested per vector batch */
+    static constexpr int32 BatchWidth = 4;
+
+    /** Remove every capsule (keeps allocations) */
+    void Reset();
+
+    /**
+     * Add a capsule
+     * @param A - Axis start (hemisphere center)
+     * @param B - Axis end (hemisphere center, may equal A for a sphere)
+     * @param Radius - Capsule radius
+     * @return Capsule index (hit bits use the same order)
+     */
+    int32 AddCapsule(const FVector& A, const FVector& B, float Radius);
+
+    /** Number of capsules added since the last reset */
+    int32 Num() const { return NumCapsules; }
+
+    /**
+     * Test a blade segment against every capsule
+     * @param P - Segment start
+     * @param Q - Segment end
+     * @param SegmentRadius - Blade thickness (sweep radius)
+     * @param InOutHits - One bit per capsule, set for capsules within reach (sized to Num() if smaller)
+     * @return Number of newly set bits
+     */
+    int32 TestSegment(const FVector& P, const FVector& Q, float SegmentRadius, TBitArray<>& InOutHits) const;
+
+    /**
+     * Closest points between a segment and one capsule's axis (scalar - once per hit)
+     * @param Index - Capsule index
+     * @param OutOnSegment - Closest point on the segment
+     * @param OutOnCapsule - Closest point on the capsule surface
+     */
+    void GetClosestPoints(int32 Index, const FVector& P, const FVector& Q, FVector& OutOnSegment, FVector& OutOnCapsule) const;
+
+    /**
+     * Squared distance between two segments (scalar reference for the vector kernel)
+     */
+    static float SegmentDistSquared(const FVector& P, const FVector& Q, const FVector& A, const FVector& B);
+
+private:
+    /** Axis endpoints and radii, padded to a multiple of BatchWidth */
+    TArray<float> AX;
+    TArray<float> AY;
+    TArray<float> AZ;
+    TArray<float> BX;
+    TArray<float> BY;
+    TArray<float> BZ;
+    TArray<float> Radii;
+
+    int32 NumCapsules = 0;
+};
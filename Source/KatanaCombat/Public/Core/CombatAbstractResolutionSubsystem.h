@@ -0,0 +1,137 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "Core/CombatSignificanceSubsystem.h"
+#include "CombatAbstractResolutionSubsystem.generated.h"
+
+class UAttackData;
+class UCombatComponent;
+
+/**
+ * Expected output of one fighter, cooked from its default attacks
+ */
+struct FCombatAbstractStats
+{
+    /** Health damage per second of steady swinging */
+    float DamagePerSecond = 0.0f;
+
+    /** Posture damage per second against a guard */
+    float PostureDamagePerSecond = 0.0f;
+
+    /** Damage multiplier against a guard-broken opponent */
+    float CounterDamageMultiplier = 1.0f;
+};
+
+/**
+ * Statistical combat for offscreen AI-vs-AI fights
+ *
+ * Two low-significance combatants locked onto each other (both at or below MaxSignificance,
+ * neither player-controlled, both between attacks) leave full simulation: the actors, their
+ * components and their controllers stop ticking, so no montages, traces or AI run. Every
+ * ResolveInterval each side deals its expected output for the elapsed time - DamagePerSecond
+ * through IDamageableInterface::ApplyDamage for the unblocked share, PostureDamagePerSecond through
+ * ApplyPostureDamage for the blocked share - so posture, guard breaks and damage events still
+ * follow the normal rules. Fights go back to full simulation as soon as either side becomes
+ * significant, can no longer be damaged, or is gone.
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatAbstractResolutionSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // ============================================================================
+    // CONFIGURATION
+    // ============================================================================
+
+    /** Time between resolution passes (seconds) */
+    float ResolveInterval = 0.5f;
+
+    /** Highest significance a fighter may have to be resolved abstractly */
+    ECombatSignificance MaxSignificance = ECombatSignificance::Low;
+
+    /** Fighters farther apart than this stay fully simulated (cm) */
+    float EngageDistance = 400.0f;
+
+    /** Share of incoming swings assumed blocked (posture instead of health damage) */
+    float BlockRate = 0.3f;
+
+    /** Pause between one swing's recovery and the next windup (seconds) */
+    float AttackSpacing = 0.5f;
+
+    // ============================================================================
+    // FIGHTS
+    // ============================================================================
+
+    /** Is the actor in an abstract fight? */
+    bool IsAbstract(const AActor* Actor) const { return Actor && AbstractActors.Contains(FObjectKey(Actor)); }
+
+    int32 GetNumFights() const { return Fights.Num(); }
+
+    /** Expected output of swinging these attacks in turn (null attacks are skipped) */
+    static FCombatAbstractStats CookStats(const UAttackData* LightAttack, const UAttackData* HeavyAttack, float AttackSpacing);
+
+    /**
+     * Expected exchange over DeltaTime
+     * @param OutDamage - Health damage to the defender
+     * @param OutPostureDamage - Posture damage to the defender's guard
+     */
+    static void ResolveExchange(const FCombatAbstractStats& Attacker, float DeltaTime, float BlockRate, bool bDefenderGuardBroken, float& OutDamage, float& OutPostureDamage);
+
+    /** Start, resolve and end fights now (normally done by the scheduled job) */
+    void UpdateFights();
+
+    /** Put every abstract fighter back into full simulation */
+    void EndAllFights();
+
+private:
+    struct FAbstractFighter
+    {
+        TWeakObjectPtr<AActor> Actor;
+        TWeakObjectPtr<UCombatComponent> Combat;
+        FCombatAbstractStats Stats;
+
+        /** What we stopped ticking (restarted on resume) */
+        TArray<TWeakObjectPtr<AActor>> SuspendedActors;
+        TArray<TWeakObjectPtr<UActorComponent>> SuspendedComponents;
+    };
+
+    struct FAbstractFight
+    {
+        FAbstractFighter Fighters[2];
+        double LastResolveTime = 0.0;
+    };
+
+    /** Scheduled job: UpdateFights */
+    void UpdateFightsJob(float DeltaTime);
+
+    /** Could the combatant be resolved abstractly right now? */
+    bool CanGoAbstract(AActor* Actor, const UCombatComponent* Combat) const;
+
+    /** Should an abstract fighter keep going? */
+    bool CanStayAbstract(const FAbstractFighter& Fighter) const;
+
+    /** Deal each side's output since the last pass */
+    void ResolveFight(FAbstractFight& Fight, double Now);
+
+    void Suspend(FAbstractFighter& Fighter);
+    void Resume(FAbstractFighter& Fighter);
+    void EndFightAt(int32 FightIndex);
+
+    FCombatJobHandle ResolveJob;
+
+    TArray<FAbstractFight> Fights;
+    TSet<FObjectKey> AbstractActors;
+};
@@ -0,0 +1,123 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTypes.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "Core/CombatSignificanceSubsystem.h"
+#include "CombatAnimBudgetSubsystem.generated.h"
+
+class USkeletalMeshComponent;
+class USkeletalMeshComponentBudgeted;
+class UCombatComponent;
+class UWeaponComponent;
+
+/**
+ * Feeds combat state into the engine Animation Budget Allocator
+ *
+ * Character meshes (USkeletalMeshComponentBudgeted) register here instead of computing their own
+ * significance. A scheduled pass pushes each mesh's significance to the allocator:
+ * - Combat-critical meshes are never throttled: attack in Windup or Active, weapon hit detection on,
+ *   locked onto by a local player, or flagged by the owner (SetCombatCritical). Swing sockets have to
+ *   be posed every frame for the weapon sweeps to resolve hits correctly.
+ * - Everything else uses its UCombatSignificanceSubsystem rank, so idle and distant characters are
+ *   the ones the allocator skips and interpolates.
+ *
+ * Only changes are pushed. Combat state changes trigger a pass on the next scheduler update.
+ * Without the allocator (plugin disabled, a.Budget.Enabled 0) this does nothing.
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatAnimBudgetSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // ============================================================================
+    // CONFIGURATION
+    // ============================================================================
+
+    /** Time between significance passes (seconds) */
+    float UpdateInterval = 0.1f;
+
+    /** Allocator significance per combat rank (critical meshes always use 1) */
+    float CulledSignificance = 0.1f;
+    float LowSignificance = 0.4f;
+    float MediumSignificance = 0.7f;
+    float HighSignificance = 0.9f;
+
+    // ============================================================================
+    // MESHES
+    // ============================================================================
+
+    /**
+     * Manage a character mesh's significance (no-op for meshes that aren't USkeletalMeshComponentBudgeted)
+     * @param Mesh - Owner's main skeletal mesh
+     */
+    void RegisterMesh(USkeletalMeshComponent* Mesh);
+
+    /** Stop managing a mesh */
+    void UnregisterMesh(USkeletalMeshComponent* Mesh);
+
+    /**
+     * Owner-driven override for actors without a combat component (e.g. AI swings driven by montages)
+     * Applied to the allocator immediately
+     * @param Owner - Actor owning a registered mesh
+     * @param bCritical - True to never throttle the mesh until cleared
+     */
+    void SetCombatCritical(const AActor* Owner, bool bCritical);
+
+    /** Is this actor's mesh currently exempt from throttling? (as of the last pass) */
+    bool IsCombatCritical(const AActor* Owner) const;
+
+    /** Number of managed meshes */
+    int32 GetNumMeshes() const { return Entries.Num(); }
+
+    /** Significance passes run so far */
+    int32 GetNumPasses() const { return NumPasses; }
+
+    /** Push every mesh's significance now (normally done by the scheduled job) */
+    void UpdateMeshSignificance();
+
+    /** Allocator significance for a combat rank */
+    float GetRankSignificance(ECombatSignificance Rank) const;
+
+private:
+    struct FBudgetedMesh
+    {
+        TWeakObjectPtr<USkeletalMeshComponentBudgeted> Mesh;
+        TWeakObjectPtr<AActor> Owner;
+        TWeakObjectPtr<UCombatComponent> CombatComponent;
+        TWeakObjectPtr<UWeaponComponent> WeaponComponent;
+
+        /** Set by the owner (SetCombatCritical) */
+        bool bOwnerCritical = false;
+
+        /** Last values pushed to the allocator (negative = never pushed) */
+        float PushedSignificance = -1.0f;
+        bool bPushedCritical = false;
+    };
+
+    /** Scheduled job: one significance pass */
+    void UpdateMeshSignificanceJob(float DeltaTime);
+
+    /** Owner's combat state changed - run a pass on the next scheduler update */
+    void OnCombatStateChanged(ECombatState NewState);
+
+    /** Is the entry combat-critical right now? */
+    bool IsEntryCritical(const FBudgetedMesh& Entry, TConstArrayView<const AActor*> PlayerTargets) const;
+
+    /** Push the entry's significance to the allocator if it changed */
+    void PushSignificance(FBudgetedMesh& Entry, float Significance, bool bCritical);
+
+    TArray<FBudgetedMesh> Entries;
+
+    /** Significance pass job on the combat job scheduler */
+    FCombatJobHandle UpdateJob;
+
+    int32 NumPasses = 0;
+};
@@ -0,0 +1,148 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Debug/CombatTrace.h"
+#include "CombatBudgetSubsystem.generated.h"
+
+/**
+ * How far a system has been scaled back to get under its frame budget
+ */
+UENUM(BlueprintType)
+enum class ECombatQualityLevel : uint8
+{
+    Full,
+    Reduced,
+    Minimal
+};
+
+/**
+ * Smoothed cost and hysteresis for one budget
+ *
+ * Steps down a level once the smoothed cost has stayed over budget for DegradeDelay, and back up
+ * once it has stayed under RestoreRatio of the budget for RestoreDelay. The gap between the two
+ * thresholds (and the longer restore delay) keeps a system hovering at its budget from flapping.
+ */
+struct KATANACOMBAT_API FCombatBudgetTracker
+{
+    /** Feed one frame's cost; returns true if the level changed */
+    bool Update(float FrameMs, float BudgetMs, float DeltaTime);
+
+    void Reset();
+
+    ECombatQualityLevel Level = ECombatQualityLevel::Full;
+
+    /** Exponential moving average of the frame cost (ms) */
+    float SmoothedMs = 0.0f;
+
+    /** Cost of the last frame fed in (ms) */
+    float LastFrameMs = 0.0f;
+
+    /** Weight of the newest frame in SmoothedMs */
+    float SmoothingAlpha = 0.1f;
+
+    /** Seconds over budget before stepping down */
+    float DegradeDelay = 0.25f;
+
+    /** Seconds under RestoreRatio * budget before stepping back up */
+    float RestoreDelay = 2.0f;
+
+    /** Fraction of the budget the cost must drop below before quality is restored */
+    float RestoreRatio = 0.6f;
+
+private:
+    float OverBudgetTime = 0.0f;
+    float UnderBudgetTime = 0.0f;
+};
+
+/**
+ * Adaptive combat quality: holds each combat system to a per-frame time budget
+ *
+ * Reads the time charged by COMBAT_BUDGET_SCOPE every frame and lowers a system's quality while it
+ * stays over budget, restoring it once there is headroom again:
+ * - Traces:    fewer blade sample points and sweep substeps (UWeaponComponent)
+ * - Targeting: line of sight results stay cached longer (ULineOfSightSubsystem)
+ * - Anim:      medium-significance actors flinch additively instead of playing reaction montages
+ * - Total:     AI LOD tiers are picked as if enemies were further away (UCombatEnemyLODSubsystem)
+ *
+ * Default budgets depend on the platform; a budget of 0 leaves that system at full quality.
+ * Console: Combat.Budget [Category Ms] (prints costs and levels), Combat.Budget.Enable 0/1
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatBudgetSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UCombatBudgetSubsystem();
+
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    /** Subsystem for Owner's world (nullptr in worlds without one, e.g. during teardown) */
+    static UCombatBudgetSubsystem* Get(const UObject* WorldContextObject);
+
+    // ============================================================================
+    // BUDGETS
+    // ============================================================================
+
+    /** Per-frame budget for each category (ms, 0 = unlimited) */
+    float BudgetMs[static_cast<int32>(ECombatBudgetCategory::Count)];
+
+    /** Budget for all categories together (ms, 0 = unlimited) - drives AI LOD */
+    float TotalBudgetMs = 0.0f;
+
+    /** Monitor off = everything at full quality */
+    void SetEnabled(bool bInEnabled);
+    bool IsEnabled() const { return bEnabled; }
+
+    /** Feed one frame of measured costs (Tick does this from the budget scopes) */
+    void EvaluateFrame(TConstArrayView<float> CategoryMs, float DeltaTime);
+
+    // ============================================================================
+    // QUALITY
+    // ============================================================================
+
+    ECombatQualityLevel GetQualityLevel(ECombatBudgetCategory Category) const;
+    ECombatQualityLevel GetTotalQualityLevel() const { return TotalTracker.Level; }
+
+    /** Detail multiplier for a category: 1 at full quality, ReducedDetailScale / MinimalDetailScale below */
+    float GetDetailScale(ECombatBudgetCategory Category) const;
+    float GetTotalDetailScale() const { return GetDetailScaleForLevel(TotalTracker.Level); }
+
+    /** Detail scale for Category in Object's world (1 if there is no monitor) */
+    static float GetDetailScaleFor(const UObject* WorldContextObject, ECombatBudgetCategory Category);
+
+    float ReducedDetailScale = 0.5f;
+    float MinimalDetailScale = 0.25f;
+
+    // ============================================================================
+    // STATS
+    // ============================================================================
+
+    const FCombatBudgetTracker& GetTracker(ECombatBudgetCategory Category) const;
+    const FCombatBudgetTracker& GetTotalTracker() const { return TotalTracker; }
+
+    /** Level changes since the subsystem started */
+    int32 GetNumLevelChanges() const { return NumLevelChanges; }
+
+private:
+    float GetDetailScaleForLevel(ECombatQualityLevel Level) const;
+
+    FCombatBudgetTracker Trackers[static_cast<int32>(ECombatBudgetCategory::Count)];
+    FCombatBudgetTracker TotalTracker;
+
+    /** CombatBudget::GetTotalCycles at the last tick */
+    uint64 LastTotalCycles[static_cast<int32>(ECombatBudgetCategory::Count)] = {};
+    bool bHasCycleBaseline = false;
+
+    bool bEnabled = true;
+    int32 NumLevelChanges = 0;
+};
\ No newline at end of file
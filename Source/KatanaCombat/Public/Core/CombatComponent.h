@@ -6,6 +6,8 @@
 #include "CombatTypes.h"
 #include "Characters/SamuraiCharacter.h"
 #include "Components/ActorComponent.h"
+#include "Core/PlayRateEasingSubsystem.h"
+#include "Core/CombatTimerWheelSubsystem.h"
 #include "CombatComponent.generated.h"
 
 // Forward declarations
@@ -19,6 +21,9 @@ class UWeaponComponent;
 class UMotionWarpingComponent;
 class ACharacter;
 class UCombatComponentV2;
+struct FChargeStage;
+struct FCombatTickInput;
+struct FCombatTickOutput;
 
 /**
  * Main combat component handling state machine, attacks, posture, combos, and parry/counter mechanics
@@ -49,8 +54,13 @@ class KATANACOMBAT_API UCombatComponent : public UActorComponent
     friend class FAttackExecutionTest;
     friend class FMemorySafetyTest;
     friend class FPhasesVsWindowsTest;
+    friend class FAnalyticPostureTest;
+    friend class FCombatTickManagerTest;
 #endif
 
+    friend class UCombatTickManagerSubsystem;
+    friend class UCombatRegistrySubsystem;
+
 public:
     UCombatComponent();
 
@@ -106,10 +116,29 @@ public:
     /** Force set combat state bypassing validation - FOR TESTING ONLY */
     void ForceSetStateForTest(ECombatState NewState) { CurrentState = NewState; }
 
+    /**
+     * Return to the just-spawned state (timers, montages, windows, buffers, holds, posture) - FOR TESTING ONLY
+     * Lets pooled test characters be reused between cases. Delegate bindings and cached references are kept
+     */
+    void ResetForTest();
+
     /** Is currently in any attack state? */
     UFUNCTION(BlueprintPure, Category = "Combat|State")
     bool IsAttacking() const;
 
+    /**
+     * Publish the animation state block (game thread, once per anim update)
+     * Bumps the block's change counters only for groups whose values changed
+     * @return Versioned state block read by the anim worker thread
+     */
+    const FCombatAnimState& PublishAnimState();
+
+    /**
+     * Native query block (ICombatInterface::GetCombatQuerySnapshot on the owner)
+     * Refreshed from the live state on every call, so it never lags a transition
+     */
+    const FCombatQuerySnapshot& GetQuerySnapshot() const;
+
     /**
      * Is currently holding an attack? (frozen at 0.0 playrate)
      * Used by AnimInstance to prevent locomotion updates during hold state
@@ -189,7 +218,7 @@ public:
      * @return Current posture value
      */
     UFUNCTION(BlueprintPure, Category = "Combat|Posture")
-    float GetCurrentPosture() const { return CurrentPosture; }
+    float GetCurrentPosture() const;
 
     /**
      * Get max posture
@@ -252,11 +281,12 @@ public:
 
     /**
      * Attempt perfect parry (call during parry window)
-     * Defender-side detection: Checks nearby attackers for IsInParryWindow()
+     * Defender-side detection: Queries UParryWindowSubsystem for attackers with an open parry window
+     * @param InputTime - Sub-frame world time of the block press (< 0 = now); windows that closed after it still count
      * @return True if parry was successful
      */
     UFUNCTION(BlueprintCallable, Category = "Combat|Defense")
-    bool TryParry();
+    bool TryParry(float InputTime = -1.0f);
 
     // ============================================================================
     // PARRY WINDOWS
@@ -280,6 +310,39 @@ public:
     /** Close parry window */
     void CloseParryWindow();
 
+    // ============================================================================
+    // DUEL MODE (1v1 fast path)
+    // ============================================================================
+
+    /**
+     * Lock this combatant and Opponent into a duel (both sides are paired)
+     * While dueling, parry checks, hit routing and targeting go straight to the cached opponent:
+     * no parry subsystem query, line of sight trace, targeting overlap or interface dispatch.
+     * Ends any duel either side was already in; ends automatically when either side dies.
+     * @param Opponent - Other combatant's component
+     * @return True if the duel started
+     */
+    UFUNCTION(BlueprintCallable, Category = "Combat|Duel")
+    bool BeginDuel(UCombatComponent* Opponent);
+
+    /** End the current duel on both sides (no-op if not dueling) */
+    UFUNCTION(BlueprintCallable, Category = "Combat|Duel")
+    void EndDuel();
+
+    /** Is this combatant locked into a duel with a live opponent? */
+    UFUNCTION(BlueprintPure, Category = "Combat|Duel")
+    bool IsInDuel() const { return DuelOpponentCombat.IsValid(); }
+
+    /** Opponent's combat component while dueling (nullptr otherwise) */
+    UFUNCTION(BlueprintPure, Category = "Combat|Duel")
+    UCombatComponent* GetDuelOpponentCombat() const { return DuelOpponentCombat.Get(); }
+
+    /** Opponent's character while dueling (nullptr otherwise, or if the opponent is not a samurai) */
+    ASamuraiCharacter* GetDuelOpponent() const { return DuelOpponent.Get(); }
+
+    /** Is Actor the duel opponent? (pointer compare, safe on hot paths) */
+    bool IsDuelOpponent(const AActor* Actor) const { return Actor && IsInDuel() && DuelOpponentCombat->GetOwner() == Actor; }
+
     // ============================================================================
     // HOLD WINDOWS
     // ============================================================================
@@ -301,6 +364,41 @@ public:
     /** Close hold window */
     void CloseHoldWindow();
 
+    // ============================================================================
+    // CHARGE STAGES
+    // ============================================================================
+
+    /**
+     * Start stepping through an attack's charge stages (no-op if it has none)
+     * One timer wheel event is scheduled per stage boundary, so a hold costs nothing between
+     * stages. Called when a hold starts (V1 OpenHoldWindow, V2 OnHoldWindowStart).
+     * @param Attack - Attack being held
+     * @param HoldStartTime - World time the hold began (stages already passed are entered at once)
+     */
+    void BeginChargeStages(const UAttackData* Attack, float HoldStartTime);
+
+    /** Stop advancing on release or interruption (the stage reached stays available as the released stage) */
+    void EndChargeStages();
+
+    /** Stop advancing and forget the released stage (back to idle, death) */
+    void ClearChargeStages();
+
+    /** Stage of the active hold (INDEX_NONE = not holding or before the first stage) */
+    UFUNCTION(BlueprintPure, Category = "Combat|Charge")
+    int32 GetChargeStage() const { return ChargeStage; }
+
+    /** Stage the last hold ended in (INDEX_NONE if none was reached); reset when the next hold starts */
+    UFUNCTION(BlueprintPure, Category = "Combat|Charge")
+    int32 GetReleasedChargeStage() const { return ReleasedChargeStage; }
+
+    /** Damage multiplier of the active (else released) stage, 1 without one */
+    UFUNCTION(BlueprintPure, Category = "Combat|Charge")
+    float GetChargeDamageMultiplier() const;
+
+    /** Posture damage multiplier of the active (else released) stage, 1 without one */
+    UFUNCTION(BlueprintPure, Category = "Combat|Charge")
+    float GetChargePostureDamageMultiplier() const;
+
     // ============================================================================
     // COUNTER WINDOWS
     // ============================================================================
@@ -327,7 +425,7 @@ public:
     // INPUT HANDLING
     // ============================================================================
 
-    /** Store movement input for directional attacks */
+    /** Feed movement input for directional attacks (forwards to the owner's per-frame input sample) */
     UFUNCTION(BlueprintCallable, Category = "Combat|Input")
     void SetMovementInput(FVector2D Input);
 
@@ -343,8 +441,11 @@ public:
     /** Heavy attack button released */
     void OnHeavyAttackReleased();
 
-    /** Block button pressed */
-    void OnBlockPressed();
+    /**
+     * Block button pressed
+     * @param InputTime - Sub-frame world time of the press (< 0 = now), used for parry timing
+     */
+    void OnBlockPressed(float InputTime = -1.0f);
 
     /** Block button released */
     void OnBlockReleased();
@@ -428,6 +529,19 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Combat|Events")
     FOnAttackHit OnAttackHit;
 
+    /** Broadcast when a hold reaches a charge stage (anim, VFX and audio cues) */
+    UPROPERTY(BlueprintAssignable, Category = "Combat|Events")
+    FOnChargeStageChanged OnChargeStageChanged;
+
+    // Native versions of the events above for C++ listeners (the dynamic ones are for Blueprints)
+    FOnCombatStateChangedNative OnCombatStateChangedNative;
+    FOnPostureChangedNative OnPostureChangedNative;
+    FOnGuardBrokenNative OnGuardBrokenNative;
+    FOnPerfectParryNative OnPerfectParryNative;
+    FOnPerfectEvadeNative OnPerfectEvadeNative;
+    FOnAttackHitNative OnAttackHitNative;
+    FOnChargeStageChangedNative OnChargeStageChangedNative;
+
 protected:
     
     virtual void BeginPlay() override;
@@ -453,12 +567,27 @@ private:
     // POSTURE
     // ============================================================================
 
-    /** Current posture value (0-100) */
+    /** Last published animation state block (see PublishAnimState) */
+    FCombatAnimState PublishedAnimState;
+
+    /** Native query block handed out by GetQuerySnapshot */
+    mutable FCombatQuerySnapshot QuerySnapshot;
+
+    /** Current posture value (0-100). Event-driven tick: posture at PostureAnchorTime (use GetCurrentPosture) */
     UPROPERTY(VisibleAnywhere, Category = "Combat|Posture")
     float CurrentPosture = 100.0f;
 
+    /** World time CurrentPosture was last committed (event-driven tick only) */
+    float PostureAnchorTime = 0.0f;
+
+    /** Cached CombatSettings->bEventDrivenCombatTick (analytic posture, tick only while holding) */
+    bool bEventDrivenTick = false;
+
+    /** Cached CombatSettings->bBatchedCombatTick (per-frame work runs on UCombatTickManagerSubsystem) */
+    bool bBatchedTick = false;
+
     /** Timer for guard break recovery */
-    FTimerHandle GuardBreakRecoveryTimer;
+    FCombatTimerHandle GuardBreakRecoveryTimer;
 
     // ============================================================================
     // COMBO SYSTEM - HYBRID (Responsive + Snappy)
@@ -473,10 +602,10 @@ private:
     bool bCanCombo = false;
 
     /** Timer for combo window */
-    FTimerHandle ComboWindowTimer;
+    FCombatTimerHandle ComboWindowTimer;
 
     /** Timer to reset combo after timeout */
-    FTimerHandle ComboResetTimer;
+    FCombatTimerHandle ComboResetTimer;
 
     /** Queued combo inputs during combo window (snappy path) */
     TArray<EInputType> ComboInputBuffer;
@@ -496,7 +625,20 @@ private:
     bool bIsInParryWindow = false;
 
     /** Timer to close parry window */
-    FTimerHandle ParryWindowTimer;
+    FCombatTimerHandle ParryWindowTimer;
+
+    /** Timer to leave the parrying state after a successful parry */
+    FCombatTimerHandle ParryRecoveryTimer;
+
+    // ============================================================================
+    // DUEL
+    // ============================================================================
+
+    /** Paired opponent (set on both sides by BeginDuel) */
+    TWeakObjectPtr<UCombatComponent> DuelOpponentCombat;
+
+    /** Opponent's character, cached for direct (non-interface) hit and parry calls */
+    TWeakObjectPtr<ASamuraiCharacter> DuelOpponent;
 
     // ============================================================================
     // HOLD WINDOW
@@ -507,7 +649,7 @@ private:
     bool bIsInHoldWindow = false;
 
     /** Timer to close hold window */
-    FTimerHandle HoldWindowTimer;
+    FCombatTimerHandle HoldWindowTimer;
 
     // ============================================================================
     // COUNTER WINDOW
@@ -518,7 +660,7 @@ private:
     bool bIsInCounterWindow = false;
 
     /** Timer to close counter window */
-    FTimerHandle CounterWindowTimer;
+    FCombatTimerHandle CounterWindowTimer;
 
     // ============================================================================
     // INPUT BUFFERING - RESPONSIVE PATH
@@ -533,17 +675,17 @@ private:
     /** Buffered evade input */
     bool bEvadeBuffered = false;
 
+    /** Timer returning to idle after an evade */
+    FCombatTimerHandle EvadeTimer;
+
     /** Was light attack buffered during combo window? */
     bool bLightAttackInComboWindow = false;
 
     /** Was heavy attack buffered during combo window? */
     bool bHeavyAttackInComboWindow = false;
 
-    /** Is light attack button held? */
-    bool bLightAttackHeld = false;
-
-    /** Is heavy attack button held? */
-    bool bHeavyAttackHeld = false;
+    /** Attack buttons currently held, stamped on press/release (no per-frame polling) */
+    FCombatHeldInputs HeldInputs;
 
     // ============================================================================
     // CHARGING (Heavy Attacks)
@@ -555,6 +697,22 @@ private:
     /** Current charge time */
     float CurrentChargeTime = 0.0f;
 
+    /** Attack whose charge stages are (or were last) active */
+    TWeakObjectPtr<const UAttackData> ChargeAttack;
+
+    /** Stage reached by the active hold / by the last hold when it ended (INDEX_NONE = none) */
+    int32 ChargeStage = INDEX_NONE;
+    int32 ReleasedChargeStage = INDEX_NONE;
+
+    /** Stage count while stages are active (0 otherwise, published to the anim instance) */
+    int32 NumChargeStages = 0;
+
+    /** World time the active hold began */
+    float ChargeStartTime = 0.0f;
+
+    /** Fires at the next stage boundary */
+    FCombatTimerHandle ChargeStageTimer;
+
     // ============================================================================
     // HOLD STATE (Light Attacks)
     // ============================================================================
@@ -562,8 +720,8 @@ private:
     /** Currently holding light attack? */
     bool bIsHolding = false;
 
-    /** Current hold time */
-    float CurrentHoldTime = 0.0f;
+    /** World time the current hold began (hold time is derived from it, see GetCurrentHoldTime) */
+    float HoldStartTime = 0.0f;
 
     /** Did the hold window expire while button was still held? */
     bool bHoldWindowExpired = false;
@@ -571,24 +729,20 @@ private:
     /** Directional input queued during hold window (sampled during hold, not on release) */
     EAttackDirection QueuedDirectionalInput = EAttackDirection::None;
 
-    /** Playback rate blending for holds */
+    /** Playback rate blending for holds (driven by UPlayRateEasingSubsystem) */
     bool bIsBlendingToHold = false;
     bool bIsBlendingFromHold = false;
     float HoldBlendAlpha = 0.0f;
 
+    /** Active hold blend ease */
+    FPlayRateEaseHandle HoldBlendEaseHandle;
+
 public:
 
     UPROPERTY(EditAnywhere, Category = "Combat")
     float HoldBlendSpeed = 5.0f;  // Speed of blend (0 to 1 in ~0.2 seconds at default 5.0)
 
 private:
-    // ============================================================================
-    // MOVEMENT INPUT
-    // ============================================================================
-
-    /** Stored movement input (X = Right, Y = Forward) for directional follow-ups */
-    FVector2D StoredMovementInput = FVector2D::ZeroVector;
-
     // ============================================================================
     // CACHED REFERENCES
     // ============================================================================
@@ -621,9 +775,28 @@ private:
     // INTERNAL HELPERS - STATE & POSTURE
     // ============================================================================
 
-    /** Update posture regeneration per frame */
+    /** Update posture regeneration per frame (per-frame tick mode only) */
     void UpdatePosture(float DeltaTime);
 
+    /**
+     * Evaluate analytic posture at a world time (CurrentPosture + state regen since PostureAnchorTime)
+     * @param Time - World time in seconds
+     * @return Posture at Time, clamped to max
+     */
+    float EvaluatePosture(float Time) const;
+
+    /** Fold elapsed regen into CurrentPosture and re-anchor (call before posture or state changes) */
+    void CommitPosture();
+
+    /** Enable the component tick only while something changes per frame (event-driven tick) */
+    void RefreshTickEnabled();
+
+    /** Snapshot per-frame state for the batched tick (game thread) */
+    void GatherBatchedTick(FCombatTickInput& OutInput) const;
+
+    /** Apply the batched tick's result (game thread, same effects as TickComponent) */
+    void ApplyBatchedTick(const FCombatTickOutput& Output);
+
     /** Regenerate posture based on current state */
     void RegeneratePosture(float DeltaTime);
 
@@ -636,12 +809,43 @@ private:
     /** Trigger guard break state */
     void HandleGuardBreak();
 
+    /** Publish the current posture to the combat event dispatcher (discrete changes only) */
+    void PublishPostureEvent();
+
+    // ============================================================================
+    // INTERNAL HELPERS - HOLD BLENDING
+    // ============================================================================
+
+    /**
+     * Start linear playrate blend at HoldBlendSpeed from the current HoldBlendAlpha
+     * @param bToHold - True: blend to frozen (0.0), false: blend back to normal (1.0)
+     */
+    void StartHoldBlend(bool bToHold);
+
+    /** Stop any hold blend in progress (playrate left as is) */
+    void StopHoldBlend();
+
+    /** Easing scheduler callback: hold blend advanced */
+    void OnHoldBlendUpdated(float PlayRate);
+
+    /** Easing scheduler callback: hold blend reached its target */
+    void OnHoldBlendFinished();
+
     /** Handle guard break recovery after stun duration */
     void RecoverFromGuardBreak();
 
     /** Reset combo chain after timeout */
     void ResetComboChain();
 
+    /** Return to idle once the evade duration elapses */
+    void EndEvade();
+
+    /** Return to idle after a successful parry (if still parrying) */
+    void EndParryRecovery();
+
+    /** Combat timer wheel for this world (window/recovery timers) */
+    UCombatTimerWheelSubsystem* GetTimerWheel() const;
+
     // ============================================================================
     // INTERNAL HELPERS - COMBO SYSTEM (Hybrid)
     // ============================================================================
@@ -683,12 +887,6 @@ private:
     /** Clear all input buffers */
     void ClearInputBuffers();
 
-    /** Convert stored 2D input to a normalized world space direction */
-    FVector GetWorldSpaceMovementInput() const;
-
-    /** Convert a world-space direction to an attack direction relative to owner */
-    EAttackDirection GetAttackDirectionFromWorldDirection(const FVector& WorldDir) const;
-
     // ============================================================================
     // INTERNAL HELPERS - ANIMATION & MOTION WARPING
     // ============================================================================
@@ -699,6 +897,12 @@ private:
     /** Play attack montage */
     bool PlayAttackMontage(UAttackData* AttackData);
 
+    /**
+     * End delegate of an attack montage (bound per play)
+     * @param EndedAttackData - Attack the montage was played for (differs from CurrentAttackData after a combo transition)
+     */
+    void OnAttackMontageEnded(UAnimMontage* Montage, bool bInterrupted, UAttackData* EndedAttackData);
+
     // ============================================================================
     // INTERNAL HELPERS - CHARGING & HOLDING
     // ============================================================================
@@ -706,14 +910,17 @@ private:
     /** Start charging heavy attack */
     void StartChargingHeavy();
 
-    /** Update heavy attack charging */
-    void UpdateHeavyCharging(float DeltaTime);
-
     /** Release charged heavy attack */
     void ReleaseChargedHeavy();
 
-    /** Update hold time (works for both light and heavy) */
-    void UpdateHoldTime(float DeltaTime);
+    /** Enter every stage reached by now and schedule the next boundary (timer wheel callback) */
+    void OnChargeStageTimer();
+
+    /** Active stage if holding, else the released one (nullptr if none) */
+    const FChargeStage* GetEffectiveChargeStage() const;
+
+    /** Seconds the current hold has lasted (0 when not holding) */
+    float GetCurrentHoldTime() const;
 
     /**
      * Release held light attack with directional input
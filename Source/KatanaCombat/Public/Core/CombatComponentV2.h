@@ -4,25 +4,19 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Animation/AnimInstance.h"
 #include "GameplayTagContainer.h"
 #include "ActionQueueTypes.h"
 #include "CombatTypes.h"
+#include "Data/CompiledComboGraph.h"
+#include "Data/CombatContextMask.h"
+#include "Core/PlayRateEasingSubsystem.h"
+#include "Core/CombatTimerWheelSubsystem.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatDebugDrawSubsystem.h"
 #include "Characters/SamuraiCharacter.h"
 #include "CombatComponentV2.generated.h"
 
-// ============================================================================
-// LOG CATEGORY
-// ============================================================================
-
-/**
- * Log category for Combat System
- * Usage: UE_LOG(LogCombat, Log, TEXT("Message"));
- * Console: Log LogCombat Verbose (enable detailed logging)
- * Console: Log LogCombat Warning (only warnings/errors)
- * Console: Log LogCombat Off (disable all combat logging)
- */
-DECLARE_LOG_CATEGORY_EXTERN(LogCombat, Log, All);
-
 /**
  * V2 Combat System - Timer-Based Action Queue
  *
@@ -50,6 +44,7 @@ class UCombatComponent;
 class UAttackData;
 class UCombatSettings;
 class UAnimInstance;
+class UPlayRateEasingSubsystem;
 
 UCLASS(Blueprintable, ClassGroup = (Combat), meta = (BlueprintSpawnableComponent))
 class KATANACOMBAT_API UCombatComponentV2 : public UActorComponent
@@ -61,6 +56,9 @@ public:
 
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	/** Adds the non-reflected input bookkeeping containers (Combat.DumpMemory, memreport) */
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 	// ============================================================================
 	// CONFIGURATION
 	// ============================================================================
@@ -97,9 +95,23 @@ public:
 	 * @param InputType - Type of input (LightAttack, HeavyAttack, Evade, Block)
 	 * @param EventType - Press or Release
 	 * @param InputDirection - Optional 8-way directional input (captured from movement stick/keys)
+	 * @param InputPlatformTime - FPlatformTime::Seconds() the key event was seen (UCombatInputTimingSubsystem);
+	 *        0 stamps the input with the current world time
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Input")
-	void OnInputEvent(EInputType InputType, EInputEventType EventType, EInputDirection InputDirection = EInputDirection::None);
+	void OnInputEvent(EInputType InputType, EInputEventType EventType, EInputDirection InputDirection = EInputDirection::None, double InputPlatformTime = 0.0);
+
+	/**
+	 * Feed many components' inputs in one pass (AI driven through the attack token subsystem)
+	 * Commands are sorted in place by component, then time; each component's inputs then run in order through
+	 * the same path as OnInputEvent. World time, input timing and the per-component V2/network gates are
+	 * looked up once per run instead of once per input
+	 * @return Number of inputs dispatched (commands for destroyed or V2-disabled components are dropped)
+	 */
+	static int32 SubmitInputBatch(TArrayView<FCombatInputCommand> Commands);
+
+	/** Order a batch the way SubmitInputBatch runs it: grouped by component, oldest first (stable) */
+	static void SortInputBatch(TArrayView<FCombatInputCommand> Commands);
 
 	/**
 	 * Check if input can be processed
@@ -108,6 +120,40 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Combat|Input")
 	bool CanProcessInput(EInputType InputType) const;
 
+	// ============================================================================
+	// NETWORKING (V2)
+	// ============================================================================
+
+	/**
+	 * Networked mode (ignored in standalone)
+	 * The owning client predicts queue execution and montage playback locally and sends each input to the
+	 * server as an FCombatInputPacket. The server replays it through its own queue, confirms every execution
+	 * back to the owner and relays the packet to other clients, which replay it too. Queue and montage state
+	 * are never replicated; mispredictions are corrected by ReconcileToServer / RollBackPrediction.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Network")
+	bool bEnableNetworkPrediction = true;
+
+	/** Time (on top of the round trip) a predicted execution waits for confirmation before it is rolled back */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Network", meta = (ClampMin = "0.05", Units = "s"))
+	float PredictionConfirmTimeout = 0.25f;
+
+	/** Is this component running the networked input path? */
+	UFUNCTION(BlueprintPure, Category = "Combat|Network")
+	bool IsNetworkedMode() const;
+
+	/** Owning client -> server: one input */
+	UFUNCTION(Server, Reliable)
+	void ServerSubmitInput(const FCombatInputPacket& Packet);
+
+	/** Server -> owning client: the input with this sequence executed Attack, with its montage starting at MontagePosition */
+	UFUNCTION(Client, Reliable)
+	void ClientConfirmExecution(uint16 Sequence, UAttackData* Attack, float MontagePosition);
+
+	/** Server -> everyone: an accepted input, replayed by simulated proxies */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastRelayInput(const FCombatInputPacket& Packet);
+
 	// ============================================================================
 	// ACTION QUEUE MANAGEMENT
 	// ============================================================================
@@ -170,9 +216,10 @@ public:
 	/**
 	 * Discover checkpoints from current montage
 	 * Scans AnimNotifyStates for window timings
+	 * @param SectionName - Only windows starting in this section (NAME_None = whole montage)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Timing")
-	void DiscoverCheckpoints(class UAnimMontage* Montage);
+	void DiscoverCheckpoints(class UAnimMontage* Montage, FName SectionName = NAME_None);
 
 	/**
 	 * Register checkpoint from AnimNotifyState
@@ -181,6 +228,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat|Timing")
 	void RegisterCheckpoint(EActionWindowType WindowType, float StartTime, float Duration);
 
+	/**
+	 * Record the Active → Recovery transition time for the current montage
+	 * Queued actions scheduled for "Active end" resolve to this time
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Timing")
+	void RegisterActiveEndCheckpoint(float MontageTime);
+
 	/**
 	 * Check if montage time has reached checkpoint
 	 */
@@ -194,6 +248,32 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Combat|Timing")
 	float GetExecutionCheckpoint(const FActionQueueEntry& Action) const;
 
+	/**
+	 * Drive phase transitions and window openings from each attack's cooked timing
+	 * When an attack starts, its Active/Recovery boundaries and window starts are scheduled on the
+	 * combat timer wheel (montage time scaled by the live playrate, rescheduled when holds change it)
+	 * and phase/window notifies are ignored - they remain the authoring format only.
+	 * Attacks without cooked phase timing, or that play on past their own section, still use notifies.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Timing")
+	bool bScheduleAttackTiming = false;
+
+	/** Is the current attack's timing scheduled (its phase/window notifies should be ignored)? */
+	bool IsAttackTimingScheduled() const { return AttackTimingEvents.Num() > 0; }
+
+	/** Currently executing attack (nullptr between attacks) */
+	UAttackData* GetCurrentAttack() const { return CurrentAttackData; }
+
+	/**
+	 * World seconds until the current montage reaches a checkpoint, at the live playrate
+	 * @return 0 if already reached, < 0 if there is no such checkpoint or it won't be reached (frozen hold)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Combat|Timing")
+	float GetTimeUntilCheckpoint(EActionWindowType WindowType) const;
+
+	/** Montage-time clock of the current attack (rebased on every playrate change V2 makes) */
+	const FMontageClock& GetMontageClock() const { return MontageClock; }
+
 	// ============================================================================
 	// HOLD SYSTEM (V2)
 	// ============================================================================
@@ -203,7 +283,7 @@ public:
 	 * V2 SYSTEM: Event-driven hold detection - checks button state at window start
 	 *
 	 * Implementation:
-	 * - Checks if corresponding button is STILL pressed (via HeldInputs map)
+	 * - Checks if corresponding button was down at the window's start time (HeldInputs press/release stamps)
 	 * - Light attacks: Calls ActivateHold() to begin ease slowdown
 	 * - Heavy attacks: Calls ActivateHold() and loops charge section
 	 *
@@ -212,6 +292,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat|Hold")
 	void OnHoldWindowStart(EInputType InputType);
 
+	/**
+	 * Sub-frame world time the next OnHoldWindowStart's notify was crossed (consumed by that call)
+	 * Presses after it and releases before it are judged against this instead of the frame time.
+	 */
+	void SetHoldWindowStartTime(float WorldTime) { PendingHoldWindowStartTime = WorldTime; }
+
 
 	/**
 	 * Activate hold state
@@ -265,7 +351,7 @@ public:
 
 	/** Is queue empty? */
 	UFUNCTION(BlueprintPure, Category = "Combat|State")
-	bool IsQueueEmpty() const { return ActionQueue.Num() == 0; }
+	bool IsQueueEmpty() const { return ActionQueue.IsEmpty(); }
 
 	/** Get number of pending actions */
 	UFUNCTION(BlueprintPure, Category = "Combat|State")
@@ -281,11 +367,23 @@ public:
 
 	/** Get current attack phase */
 	UFUNCTION(BlueprintPure, Category = "Combat|State")
-	EAttackPhase GetCurrentPhase() const { return CurrentPhase; }
+	EAttackPhase GetCurrentPhase() const { return HotState.CurrentPhase; }
 
 	/** Is combo window active? */
 	UFUNCTION(BlueprintPure, Category = "Combat|State")
-	bool IsInComboWindow() const { return bComboWindowActive; }
+	bool IsInComboWindow() const { return HotState.bComboWindowActive; }
+
+	/** Last captured 8-way directional input */
+	UFUNCTION(BlueprintPure, Category = "Combat|State")
+	EInputDirection GetLastDirectionalInput() const { return HotState.LastDirectionalInput; }
+
+	/** Phase, combo window, last direction and flags in one read (anim instance, AI, UI, snapshots) */
+	UFUNCTION(BlueprintPure, Category = "Combat|State")
+	const FCombatV2HotState& GetHotState() const { return HotState; }
+
+	/** Is the current montage inside its authored cancel window? */
+	UFUNCTION(BlueprintPure, Category = "Combat|State")
+	bool IsInCancelWindow() const;
 
 	// ============================================================================
 	// EVENT DELEGATES (Blueprint-exposed)
@@ -299,6 +397,9 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Combat|Events")
 	FOnV2PhaseChanged OnPhaseChanged;
 
+	/** Native version of OnPhaseChanged for C++ listeners */
+	FOnV2PhaseChangedNative OnPhaseChangedNative;
+
 	/** Fires when combo window state changes (opened/closed) */
 	UPROPERTY(BlueprintAssignable, Category = "Combat|Events")
 	FOnV2ComboWindowChanged OnComboWindowChanged;
@@ -311,11 +412,14 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Combat|Events")
 	FOnV2MontageEvent OnMontageEvent;
 
+	/** Native version of OnMontageEvent for C++ listeners */
+	FOnV2MontageEventNative OnMontageEventNative;
+
 	// ============================================================================
 	// DEBUG / VISUALIZATION
 	// ============================================================================
 
-	/** Draw queue state and checkpoints */
+	/** Queue state and checkpoints for UCombatDebugDrawSubsystem (skipped unless this character is selected or near the camera) */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Debug")
 	void DrawDebugInfo() const;
 
@@ -327,13 +431,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat|Debug")
 	void ResetStats() { QueueStats.Reset(); }
 
+	/** Changes whenever visualized state (checkpoints, held inputs, action queue) changes */
+	uint32 GetDebugStateVersion() const { return DebugStateVersion + ActionQueue.GetVersion(); }
+
+	/** Changes when checkpoints are removed or reset (not when appended) */
+	uint32 GetCheckpointLayoutVersion() const { return CheckpointLayoutVersion; }
+
 	// ============================================================================
 	// PUBLIC STATE (for debug visualization)
 	// ============================================================================
 
-	/** Action queue (FIFO execution) */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
-	TArray<FActionQueueEntry> ActionQueue;
+	/** Action queue (FIFO execution, fixed capacity, ordered by scheduled time on insert) */
+	UPROPERTY(VisibleAnywhere, Category = "Combat|State")
+	FActionQueue ActionQueue;
 
 	/** Timer checkpoints for current montage */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
@@ -343,13 +453,12 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
 	FHoldState HoldState;
 
-	/** Currently held inputs (for press/release matching) */
+	/** Held inputs bitmask with press/release stamps (press/release matching, hold window checks) */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
-	TMap<EInputType, float> HeldInputs;
+	FCombatHeldInputs HeldInputs;
 
-	/** Last captured 8-way directional input (used for directional attacks, evades, holds) */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|State")
-	EInputDirection LastDirectionalInput = EInputDirection::None;
+	/** Set by SetHoldWindowStartTime, < 0 when the notify gave no crossing time */
+	float PendingHoldWindowStartTime = -1.0f;
 
 	// ============================================================================
 	// CONTEXT TRACKING (Phase 1 - Context-Aware Resolution)
@@ -363,6 +472,21 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat|Context")
 	FGameplayTagContainer ActiveContextTags;
 
+	/** Activate a context tag (e.g. Context.ParryCounter after a successful parry) */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Context")
+	void AddActiveContextTag(FGameplayTag Tag);
+
+	/** Deactivate a context tag */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Context")
+	void RemoveActiveContextTag(FGameplayTag Tag);
+
+	/** Replace the whole active context */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Context")
+	void SetActiveContextTags(const FGameplayTagContainer& Tags);
+
+	/** Compiled ActiveContextTags (recompiled when the tags or the project tag table change) */
+	const FCombatContextMask& GetActiveContextMask() const;
+
 	/**
 	 * Visited attacks during current resolution (cycle detection)
 	 * Cleared at start of each resolution, prevents infinite loops
@@ -379,59 +503,265 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Context")
 	int32 MaxChainDepth = 10;
 
-protected:
-	virtual void BeginPlay() override;
+	/**
+	 * Resolve combos through the precompiled combo graph (built on BeginPlay)
+	 * When disabled, or for attacks outside the compiled graph, falls back to ResolveNextAttack_V2
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Context")
+	bool bUseCompiledComboGraph = true;
 
-	/** Is combo window currently active? */
-	UPROPERTY(VisibleAnywhere, Category = "Combat|State")
-	bool bComboWindowActive = false;
+	/**
+	 * Queued actions resolve their attack when they execute instead of when the input arrives
+	 * Entries keep the raw input plus its own direction/combo-window context, so cancelled entries cost
+	 * no resolution and each entry resolves against the attack it actually follows (fixes stale
+	 * LastDirectionalInput snapshots looping directional follow-ups). Immediate actions resolve on arrival.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Context")
+	bool bDeferAttackResolution = true;
 
-	/** Combo window start time */
-	UPROPERTY(VisibleAnywhere, Category = "Combat|State")
-	float ComboWindowStart = 0.0f;
+	/** Rebuild the compiled combo graph from the current AttackConfiguration defaults */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Context")
+	void RebuildComboGraph();
 
-	/** Combo window duration */
-	UPROPERTY(VisibleAnywhere, Category = "Combat|State")
-	float ComboWindowDuration = 0.0f;
+	/**
+	 * Warm the owner's anim instance and every montage in the compiled combo graph on BeginPlay
+	 * Moves montage instance creation and the first pose off the first attack (see UMontageUtilityLibrary::PrewarmAnimation)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Context")
+	bool bPrewarmAnimation = true;
+
+	/**
+	 * Initialize the owner's anim instance and pre-touch every montage reachable through the combo graph
+	 * Only call while the owner is not attacking (montages are played and stopped in place)
+	 * @return Number of montages touched
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Context")
+	int32 PrewarmAnimation();
+
+	/**
+	 * Pick the AI's next attack from the compiled combo graph (see FCompiledComboGraph::SelectMove)
+	 * Continues from the current attack with the same combo rules as input resolution
+	 * @param TargetDistance - Distance to the target (negative = ignore reach)
+	 * @return false when no move qualifies or the current attack isn't part of the graph
+	 */
+	bool SelectAIMove(float TargetDistance, const FComboMoveUtilityWeights& Weights, FComboMoveChoice& OutChoice) const;
+
+	/** Compiled combo graph (inspection and AI move selection; rebuilt on BeginPlay) */
+	const FCompiledComboGraph& GetComboGraph() const { return ComboGraph; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/** Queue statistics */
 	UPROPERTY(VisibleAnywhere, Category = "Combat|State")
 	FQueueStats QueueStats;
 
-	/** Current attack phase (tracked independently from V1) */
+	/** Phase, combo window, last direction and flags (see FCombatV2HotState) */
 	UPROPERTY(VisibleAnywhere, Category = "Combat|State")
-	EAttackPhase CurrentPhase = EAttackPhase::None;
+	FCombatV2HotState HotState;
 
 	/** Currently executing attack (for combo progression tracking) */
 	UPROPERTY(VisibleAnywhere, Category = "Combat|State")
 	TObjectPtr<UAttackData> CurrentAttackData = nullptr;
 
-	/** Input type that triggered current attack (Light/Heavy) */
-	UPROPERTY(VisibleAnywhere, Category = "Combat|State")
-	EInputType CurrentAttackInputType = EInputType::None;
+	/** Active light attack hold ease (advanced by UPlayRateEasingSubsystem, NOT a per-component timer) */
+	FPlayRateEaseHandle EaseHandle;
+
+	/** Flat combo transition table compiled from the default attacks (cycle-checked at build time) */
+	UPROPERTY(Transient)
+	FCompiledComboGraph ComboGraph;
+
+	/** Binding to UComboPreloadSubsystem::OnChainPreloaded */
+	FDelegateHandle ComboPreloadHandle;
+
+	/** Binding to CombatComponent->OnChargeStageChangedNative */
+	FDelegateHandle ChargeStageHandle;
+
+	/** Native montage delegates (bound at BeginPlay, attached to every attack montage instance we play) */
+	FOnMontageBlendingOutStarted MontageBlendingOutDelegate;
+	FOnMontageEnded MontageEndedDelegate;
+
+	/** Cached bitmask of ActiveContextTags (see GetActiveContextMask) */
+	mutable FCombatContextMask ActiveContextMask;
+
+	/** Tag table generation ActiveContextMask was compiled against (0 = dirty) */
+	mutable uint32 ActiveContextMaskGeneration = 0;
+
+	/** Debug view change counters (see GetDebugStateVersion) */
+	uint32 DebugStateVersion = 0;
+	uint32 CheckpointLayoutVersion = 0;
+
+	/** Debug labels, rebuilt only when what they show changes (see DrawDebugInfo) */
+	mutable FCombatDebugText DebugPhaseText;
+	mutable FCombatDebugText DebugQueueText;
+	mutable FCombatDebugText DebugHoldText;
+	mutable FCombatDebugText DebugMovementText;
+	mutable FCombatDebugText DebugStatsText;
+	mutable FCombatDebugText DebugLatencyText;
+	mutable FCombatDebugText DebugComboText;
+	mutable TArray<FString> DebugActionTexts;
+	mutable uint32 DebugActionTextsVersion = MAX_uint32;
+
+	/** Networked mode: a locally predicted execution awaiting server confirmation */
+	struct FPredictedExecution
+	{
+		uint16 Sequence = 0;
+		TWeakObjectPtr<UAttackData> Attack;
+		float ExecutedTime = 0.0f;
+	};
+	TArray<FPredictedExecution, TInlineAllocator<4>> PendingPredictions;
+
+	/** Last sequence handed out by MakeInputPacket (0 = none yet) */
+	uint16 LastInputSequence = 0;
+
+	/** Sequence of the input currently being processed (stamped onto queued actions, 0 = local) */
+	uint16 ProcessingNetSequence = 0;
+
+	/** Server: last sequence accepted from the owning client */
+	uint16 LastServerSequence = 0;
+
+	/** Server: client world time -> server world time (smallest observed, i.e. least queuing delay) */
+	float ClientTimeOffset = 0.0f;
+	bool bHasClientTimeOffset = false;
+
+	/** Executed action still waiting for its montage to advance (input-to-first-frame sample) */
+	struct FPendingFirstFrameSample
+	{
+		TWeakObjectPtr<UAnimMontage> Montage;
+		float StartPosition = 0.0f;
+		double InputReceivedTime = 0.0;
+		EActionExecutionMode Mode = EActionExecutionMode::Queued;
+		bool bPending = false;
+	};
+	FPendingFirstFrameSample PendingFirstFrame;
+
+	/** Boundary of a scheduled attack (bScheduleAttackTiming) */
+	struct FAttackTimingEvent
+	{
+		float MontageTime = 0.0f;
+
+		/** Phase entered here (None = WindowType opens here) */
+		EAttackPhase Phase = EAttackPhase::None;
+		EActionWindowType WindowType = EActionWindowType::Combo;
+	};
+
+	/** Current attack's remaining boundaries, sorted by montage time (empty = notify driven) */
+	TArray<FAttackTimingEvent, TInlineAllocator<8>> AttackTimingEvents;
+	int32 NextAttackTimingEvent = 0;
+	TWeakObjectPtr<UAnimMontage> AttackTimingMontage;
+	FCombatTimerHandle AttackTimingTimer;
+
+	/** Bumped whenever the schedule is replaced or stopped (detects re-entrant attack starts) */
+	uint32 AttackTimingSerial = 0;
+
+	/** Current attack's montage time vs world time (see FMontageClock) */
+	FMontageClock MontageClock;
 
-	/** Timer handle for light attack ease transition (V2 timer-based, NOT tick-based) */
-	FTimerHandle EaseTimerHandle;
+	// ============================================================================
+	// INTERNAL HELPERS
+	// ============================================================================
 
-	/** Is character movement currently disabled? (for procedural sync) */
-	bool bMovementCurrentlyDisabled = false;
+	/**
+	 * Start the hold ease for the current direction (HoldState.bIsEasingOut) via the shared easing scheduler
+	 * @param StartPlayRate - Playrate the ease starts from
+	 */
+	void StartHoldEase(float StartPlayRate);
 
-	/** Is currently in combo blend transition? (prevents premature phase reset) */
-	bool bInComboBlend = false;
+	/** Cancel the running hold ease (no callbacks fire) */
+	void CancelHoldEase();
 
-	/** Was current attack triggered by directional follow-up? (prevents infinite directional loops) */
-	bool bCurrentAttackIsDirectionalFollowUp = false;
+	/** Easing scheduler callback: playrate advanced this frame */
+	void OnEaseUpdated(float PlayRate);
 
-	// ============================================================================
-	// INTERNAL HELPERS
-	// ============================================================================
+	/** Easing scheduler callback: ease reached its target playrate */
+	void OnEaseFinished();
+
+	/** Stream the soft combo links reachable from the defaults and the current attack (CombatSettings->ComboPreloadDepth) */
+	void PreloadComboWindow();
 
-	/** Timer callback for procedural ease transitions (V2 timer-based, NOT tick-based) */
-	void OnEaseTimerTick();
+	/** Preload completion - recompile the combo graph so streamed nodes resolve through it */
+	void OnComboChainPreloaded(const UObject* Requester);
+
+	/** A stage playrate replaces the hold ease (stages are stepped by UCombatComponent) */
+	void OnChargeStageChanged(int32 Stage, const FGameplayTag& StageTag);
+
+	/**
+	 * Input path shared by local, predicted, server-replayed and relayed inputs
+	 * @param InputTime - World time the input happened (the sender's time mapped onto ours for replayed inputs)
+	 * @param InputRealTime - Platform time the input was seen locally (0 = now), for latency stats
+	 */
+	void ProcessInputEvent(EInputType InputType, EInputEventType EventType, EInputDirection InputDirection, float InputTime, double InputRealTime = 0.0);
+
+	/**
+	 * Route a local input by network role (process, predict and send, or relay) - shared by OnInputEvent and SubmitInputBatch
+	 * @param bNetworked - IsNetworkedMode(), already checked by the caller
+	 */
+	void DispatchInputEvent(EInputType InputType, EInputEventType EventType, EInputDirection InputDirection, float InputTime, double InputPlatformTime, bool bNetworked);
+
+	/** Build the wire packet for a local input (advances the sequence) */
+	FCombatInputPacket MakeInputPacket(EInputType InputType, EInputEventType EventType, EInputDirection InputDirection, float InputTime);
+
+	/** An action that came from a networked input executed: confirm it (server) or remember the prediction (owner) */
+	void OnNetworkedActionExecuted(const FActionQueueEntry& Action);
+
+	/** Owner: the server executed something we didn't predict - play its attack, caught up by the one-way latency */
+	void ReconcileToServer(UAttackData* Attack, float MontagePosition);
+
+	/** Owner: the server never confirmed our prediction - cancel the predicted attack */
+	void RollBackPrediction();
+
+	/** Owner: roll back predictions that outlived the confirmation deadline */
+	void UpdatePredictionTimeouts();
+
+	/** Half the owner's round trip (seconds), 0 without a player state */
+	float GetEstimatedOneWayLatency() const;
+
+	/** Stamp an executed action and feed the input-to-execute histogram for its mode */
+	void RecordExecuteLatency(FActionQueueEntry& Action);
+
+	/** Tick: close PendingFirstFrame once the montage has advanced past its start position */
+	void UpdateFirstFrameLatency();
+
+	/** Tick only while there is per-frame work: a first-frame sample, unconfirmed predictions or debug draw */
+	void RefreshTickEnabled();
+
+	/** bScheduleAttackTiming: build the schedule for an attack that just started (no-op if it can't be scheduled) */
+	void StartAttackTiming(UAttackData* Attack);
+
+	/** Drop the schedule (attack finished or interrupted) */
+	void StopAttackTiming();
+
+	/** Re-anchor MontageClock at the current attack montage's real position and playrate */
+	void SyncMontageClock();
+
+	/** Every V2 playrate change ends here: rebase the clock and re-arm the scheduled boundary */
+	void OnMontagePlayRateChanged();
+
+	/** Playrate the montage plays at once this frame's arbitrated playrate requests are applied */
+	float GetPendingMontagePlayRate(UAnimInstance* AnimInstance, UAnimMontage* Montage) const;
+
+	/** Shared playrate easing scheduler / arbiter (nullptr outside a game world) */
+	UPlayRateEasingSubsystem* GetPlayRateArbiter() const;
+
+	/** Re-arm the timer for the next boundary from MontageClock */
+	void RescheduleAttackTiming();
+
+	/** Timer wheel callback: fire every boundary the montage has reached */
+	void OnAttackTimingTimer();
+
+	/** Body of a phase notify / window opening, shared by the scheduled path */
+	void FireAttackTimingEvent(const FAttackTimingEvent& Event);
+
+	/**
+	 * Same-montage combo fast path: jump the running instance to AttackData's section
+	 * Keeps the montage instance and its delegates; false if the montage isn't already playing
+	 */
+	bool TryJumpWithinMontage(UAnimInstance* AnimInstance, UAttackData* AttackData);
 
 	/**
 	 * Procedurally update movement state based on montage/hold state
-	 * Called from: TickComponent, PlayAttackMontage, OnEaseTimerTick
+	 * Called from: TickComponent, PlayAttackMontage, OnEaseUpdated/OnEaseFinished
 	 * Ensures movement is always synced with animation state
 	 */
 	void UpdateMovementFromMontageState();
@@ -448,21 +778,72 @@ protected:
 	/** Determine execution mode for input */
 	EActionExecutionMode DetermineExecutionMode(const FQueuedInputAction& InputAction) const;
 
-	/** Get attack data for input type */
+	/** Get attack data for input type (current direction and combo window) */
 	UAttackData* GetAttackForInput(EInputType InputType) const;
 
+	/**
+	 * Resolve attack data from explicit input context
+	 * @param InputType - Input being resolved
+	 * @param Direction - Direction captured with the input (None = no directional follow-up)
+	 * @param bInputInComboWindow - Input arrived while the combo window was open
+	 */
+	UAttackData* ResolveAttackForInput(EInputType InputType, EInputDirection Direction, bool bInputInComboWindow) const;
+
 	/** Calculate action priority */
 	int32 CalculatePriority(const FActionQueueEntry& Action) const;
 
-	/** Sort queue by scheduled time */
-	void SortQueueByTime();
-
-	/** Find next checkpoint of type */
+	/** Find next checkpoint of type (O(1) via CheckpointIndexByType) */
 	FTimerCheckpoint* FindCheckpoint(EActionWindowType WindowType);
 
-	/** Clear expired checkpoints */
+	/** Start of the current montage's authored cancel window (< 0 = none authored) */
+	float GetCancelWindowStart() const;
+
+	/** Montage has a cancel window that has not opened yet (recovery is not cancellable) */
+	bool IsCancelWindowPending() const;
+
+	/** Clear expired checkpoints (early-out until NextCheckpointExpiry) */
 	void ClearExpiredCheckpoints(float CurrentTime);
 
+	/** Clear all checkpoints and the Active-end marker */
+	void ResetCheckpoints();
+
+	/** Rebuild per-type index and next expiry after Checkpoints changes structurally */
+	void RebuildCheckpointIndex();
+
+	static constexpr int32 NumCheckpointWindowTypes = static_cast<int32>(EActionWindowType::Recovery) + 1;
+
+	/** First active checkpoint per EActionWindowType (index into Checkpoints, INDEX_NONE = none) */
+	int32 CheckpointIndexByType[NumCheckpointWindowTypes];
+
+	/** Active → Recovery transition time for the current montage (< 0 = not reached yet) */
+	float ActiveEndCheckpointTime = -1.0f;
+
+	/** Earliest end time among active checkpoints (MAX_flt = nothing to expire) */
+	float NextCheckpointExpiry = MAX_flt;
+
 	/** Check if can accept new input (prevents double-queueing same input) */
 	bool CanAcceptNewInput(EInputType InputType) const;
+
+	// ============================================================================
+	// INPUT COALESCING
+	// ============================================================================
+
+	/**
+	 * Presses of these input types are redundant until the phase or queue changes
+	 * (one bit per EInputType, set once a press of that type queued or was rejected as a duplicate)
+	 */
+	uint32 CoalescedInputMask = 0;
+
+	/** Phase and queue version the mask was built against (either changing invalidates it) */
+	EAttackPhase CoalescePhase = EAttackPhase::None;
+	uint32 CoalesceQueueVersion = 0;
+
+	/**
+	 * Collapse a redundant press before it reaches attack resolution and the queue
+	 * @return True if the press was coalesced (counted in QueueStats.CoalescedInputs, no further work)
+	 */
+	bool TryCoalesceInput(EInputType InputType);
+
+	/** Remember that further presses of this type are redundant for the current phase/queue */
+	void MarkInputCoalesced(EInputType InputType);
 };
\ No newline at end of file
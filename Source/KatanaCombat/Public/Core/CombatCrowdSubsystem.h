@@ -0,0 +1,220 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTypes.h"
+#include "Core/CombatSimCore.h"
+#include "CombatCrowdSubsystem.generated.h"
+
+class ASamuraiCharacter;
+class UAttackData;
+class UStaticMesh;
+class UInstancedStaticMeshComponent;
+
+/**
+ * Shared configuration for a group of low-fidelity crowd agents
+ */
+USTRUCT(BlueprintType)
+struct KATANACOMBAT_API FCombatCrowdArchetype
+{
+    GENERATED_BODY()
+
+    /** Actor spawned when an agent gets close enough to the player to need full fidelity */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    TSubclassOf<ASamuraiCharacter> PromotedClass;
+
+    /** Attacks cycled through by simulated agents (timing is baked once at registration) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    TArray<TObjectPtr<UAttackData>> Attacks;
+
+    /** Instanced mesh drawn for simulated agents (nothing is drawn if unset) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd|Representation")
+    TObjectPtr<UStaticMesh> ProxyMesh;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd", meta = (ClampMin = "1.0"))
+    float MaxPosture = 100.0f;
+
+    /** Posture regained per second while not attacking */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd", meta = (ClampMin = "0.0"))
+    float PostureRegenRate = 10.0f;
+
+    /** Approach speed (cm/s) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd", meta = (ClampMin = "0.0"))
+    float MoveSpeed = 300.0f;
+
+    /** Distance at which agents stop and swing (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd", meta = (ClampMin = "0.0"))
+    float AttackRange = 180.0f;
+
+    /** Pause between the end of one attack's recovery and the next windup (seconds) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd", meta = (ClampMin = "0.0"))
+    float AttackCooldown = 1.0f;
+};
+
+/** Phase durations and damage of one attack, baked from UAttackData (shared with the sim core) */
+using FCombatCrowdAttackTiming = FCombatSimAttackTiming;
+
+/**
+ * Low-fidelity combat simulation for large battles
+ *
+ * Agents are rows in SoA arrays (location, phase, phase timer, posture, target) rather than
+ * actors. Each frame the whole crowd is advanced in a few flat passes:
+ * 1. Targets - amortized nearest-enemy search on TargetRefreshInterval
+ * 2. Combat - approach, then Windup -> Active -> Recovery driven by the baked timing table
+ *    (FCombatSimCore::AdvancePhase). Active frames deal posture damage; a broken agent is removed
+ * 3. Promotion - agents within PromoteRadius of the player become full ASamuraiCharacter
+ *    actors (posture carried over); promoted actors beyond DemoteRadius fold back into the crowd
+ * 4. Representation - one instanced static mesh per archetype for simulated agents
+ *
+ * Simulated agents only fight each other; the player only ever meets promoted actors.
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatCrowdSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    // ============================================================================
+    // CONFIGURATION
+    // ============================================================================
+
+    /** Agents closer than this to the player are promoted to actors (cm) */
+    float PromoteRadius = 2500.0f;
+
+    /** Promoted actors farther than this from the player are demoted back to agents (cm, > PromoteRadius for hysteresis) */
+    float DemoteRadius = 3000.0f;
+
+    /** Cap on simultaneously promoted actors */
+    int32 MaxPromotedAgents = 16;
+
+    /** How often agents re-pick their nearest enemy (seconds) */
+    float TargetRefreshInterval = 0.5f;
+
+    /** Agents ignore enemies beyond this distance (cm) */
+    float TargetSearchRadius = 4000.0f;
+
+    // ============================================================================
+    // AGENTS
+    // ============================================================================
+
+    /**
+     * Register an archetype and bake its attack timing table
+     * @return Archetype index for SpawnAgent
+     */
+    UFUNCTION(BlueprintCallable, Category = "Combat|Crowd")
+    int32 RegisterArchetype(const FCombatCrowdArchetype& Archetype);
+
+    /**
+     * Add a simulated agent
+     * @param ArchetypeIndex - From RegisterArchetype
+     * @param Transform - Spawn location and facing
+     * @param Team - Agents attack agents of other teams
+     * @return Agent id (stable until the agent is removed), INDEX_NONE if the archetype is invalid
+     */
+    UFUNCTION(BlueprintCallable, Category = "Combat|Crowd")
+    int32 SpawnAgent(int32 ArchetypeIndex, const FTransform& Transform, uint8 Team);
+
+    /** Scatter Count agents in a disc around Center */
+    UFUNCTION(BlueprintCallable, Category = "Combat|Crowd")
+    void SpawnAgentsInRadius(int32 ArchetypeIndex, const FVector& Center, float Radius, int32 Count, uint8 Team);
+
+    /** Remove an agent (destroys its promoted actor, if any) */
+    UFUNCTION(BlueprintCallable, Category = "Combat|Crowd")
+    void RemoveAgent(int32 AgentId);
+
+    UFUNCTION(BlueprintPure, Category = "Combat|Crowd")
+    int32 GetNumAgents() const { return AgentIds.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "Combat|Crowd")
+    int32 GetNumPromotedAgents() const { return NumPromoted; }
+
+    bool IsValidAgent(int32 AgentId) const { return GetAgentIndex(AgentId) != INDEX_NONE; }
+    EAttackPhase GetAgentPhase(int32 AgentId) const;
+    float GetAgentPosture(int32 AgentId) const;
+    FVector GetAgentLocation(int32 AgentId) const;
+
+    /** Promoted actor for an agent (nullptr while simulated) */
+    ASamuraiCharacter* GetPromotedActor(int32 AgentId) const;
+
+    /** Baked timing for an archetype's attack slot (nullptr if out of range) */
+    const FCombatCrowdAttackTiming* GetAttackTiming(int32 ArchetypeIndex, int32 AttackIndex) const;
+
+    /** Phase durations the crowd uses for an attack (notify timing, else legacy durations, else manual timing) */
+    static FCombatCrowdAttackTiming BakeAttackTiming(const UAttackData* Attack);
+
+private:
+    // ============================================================================
+    // PASSES
+    // ============================================================================
+
+    void UpdateTargets();
+    void UpdateCombat(float DeltaTime);
+    void UpdatePromotion(const FVector& PlayerLocation, bool bHasPlayer);
+    void UpdateRepresentation();
+
+    void PromoteAgent(int32 Index);
+    void DemoteAgent(int32 Index);
+    void FlushRemovals();
+
+    int32 GetAgentIndex(int32 AgentId) const;
+
+    // ============================================================================
+    // ARCHETYPES
+    // ============================================================================
+
+    UPROPERTY(Transient)
+    TArray<FCombatCrowdArchetype> Archetypes;
+
+    /** Flat timing table; archetype N owns [TimingOffsets[N], TimingOffsets[N] + TimingCounts[N]) */
+    TArray<FCombatCrowdAttackTiming> TimingTable;
+    TArray<int32> TimingOffsets;
+    TArray<int32> TimingCounts;
+
+    // ============================================================================
+    // SOA STORAGE (dense, swap-removed)
+    // ============================================================================
+
+    TArray<int32> AgentIds;
+    TArray<int32> ArchetypeIndices;
+    TArray<uint8> Teams;
+    TArray<FVector> Locations;
+    TArray<float> Yaws;
+    TArray<EAttackPhase> Phases;
+    TArray<float> PhaseTimers;
+    TArray<float> CooldownTimers;
+    TArray<int32> ComboSteps;
+    TArray<float> Postures;
+    TArray<int32> TargetIds;
+    TArray<TWeakObjectPtr<ASamuraiCharacter>> PromotedActors;
+
+    /** Agent id -> dense index (INDEX_NONE once removed); ids are never reused */
+    TArray<int32> IdToIndex;
+
+    /** Ids to remove at the end of the frame (removal mid-pass would reshuffle the arrays) */
+    TArray<int32> PendingRemovals;
+
+    int32 NumPromoted = 0;
+    float TimeUntilTargetRefresh = 0.0f;
+
+    // ============================================================================
+    // REPRESENTATION
+    // ============================================================================
+
+    UPROPERTY(Transient)
+    TObjectPtr<AActor> RepresentationActor;
+
+    /** One instanced mesh per archetype (null when the archetype has no proxy mesh) */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UInstancedStaticMeshComponent>> ProxyMeshes;
+};
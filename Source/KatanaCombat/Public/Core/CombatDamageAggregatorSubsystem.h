@@ -0,0 +1,53 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatDamageAggregatorSubsystem.generated.h"
+
+class UHitReactionComponent;
+
+/**
+ * Flushes per-target hit accumulators once per frame
+ *
+ * UHitReactionComponent::ApplyDamage only accumulates: damage and posture are summed and the most
+ * severe hit is kept. The first hit of a frame registers its target here, and Tick (after every
+ * tick group, so after TG_PostUpdateWork weapon traces) flushes each target once: one damage
+ * event, one aggregated event and at most one reaction montage per target per frame, however many
+ * blades, projectiles or cleave targets landed at once.
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatDamageAggregatorSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    // ============================================================================
+    // REQUESTS
+    // ============================================================================
+
+    /** Flush Target with the rest of this frame's hits (call once, on its first pending hit) */
+    void QueueFlush(UHitReactionComponent* Target);
+
+    /** Flush every pending target now (also run by Tick) */
+    void FlushPendingHits();
+
+    /** Targets waiting for this frame's flush */
+    int32 GetNumPendingTargets() const { return PendingTargets.Num(); }
+
+private:
+    TArray<TWeakObjectPtr<UHitReactionComponent>> PendingTargets;
+
+    /** Per-flush scratch (flushing may queue targets for the next frame) */
+    TArray<TWeakObjectPtr<UHitReactionComponent>> FlushingTargets;
+};
\ No newline at end of file
@@ -0,0 +1,157 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/CombatSimCore.h"
+
+class UAttackConfiguration;
+
+/**
+ * One cooked attack of a duel moveset, with its light/heavy combo follow-ups
+ */
+struct FCombatDuelMove
+{
+    FCombatSimAttackTiming Timing;
+    float Damage = 0.0f;
+    float CounterDamageMultiplier = 1.0f;
+
+    /** Move index a light/heavy input chains into during this attack (INDEX_NONE = none) */
+    int32 NextLight = INDEX_NONE;
+    int32 NextHeavy = INDEX_NONE;
+};
+
+/**
+ * A fighter's moveset as plain tables (cooked once on the game thread, read-only while simulating)
+ */
+struct KATANACOMBAT_API FCombatDuelMoveset
+{
+    TArray<FCombatDuelMove> Moves;
+
+    /** Opening attacks (INDEX_NONE = none) */
+    int32 RootLight = INDEX_NONE;
+    int32 RootHeavy = INDEX_NONE;
+
+    bool IsEmpty() const { return RootLight == INDEX_NONE && RootHeavy == INDEX_NONE; }
+
+    /**
+     * Cook the combo chains reachable from a configuration's default attacks
+     * Follow-ups are resolved through FCompiledComboGraph with no direction and the combo window open
+     */
+    static FCombatDuelMoveset Cook(const UAttackConfiguration* Configuration);
+};
+
+/**
+ * Randomized input policy (all chances 0..1, rolled at every decision)
+ */
+struct FCombatDuelPolicy
+{
+    /** Chance to open an attack when idle */
+    float Aggression = 0.6f;
+
+    /** Chance to raise guard when idle and not attacking */
+    float BlockChance = 0.3f;
+
+    /** Chance an attack input is heavy */
+    float HeavyChance = 0.3f;
+
+    /** Chance to buffer the combo follow-up during an attack */
+    float ComboChance = 0.7f;
+
+    /** Seconds guard is held once raised */
+    float BlockDuration = 0.6f;
+
+    /** Seconds between decisions (reaction time) */
+    float DecisionInterval = 0.2f;
+
+    /** Draw the four chances uniformly per duel instead (explores the policy space) */
+    bool bRandomize = false;
+};
+
+struct FCombatDuelFighterSetup
+{
+    /** Must outlive the duel */
+    const FCombatDuelMoveset* Moveset = nullptr;
+    FCombatDuelPolicy Policy;
+    float MaxHealth = 100.0f;
+};
+
+struct FCombatDuelParams
+{
+    FCombatSimConfig Config;
+    FCombatDuelFighterSetup Fighters[2];
+
+    /** Duel ends in a timeout after this long (seconds) */
+    float MaxDuration = 60.0f;
+
+    /** Posture curve sample spacing (seconds) */
+    float PostureSampleInterval = 0.5f;
+};
+
+struct FCombatDuelResult
+{
+    /** Fighter index of the winner (INDEX_NONE = draw) */
+    int32 Winner = INDEX_NONE;
+    bool bTimedOut = false;
+    float Duration = 0.0f;
+
+    float DamageDealt[2] = {};
+    float PostureDamageDealt[2] = {};
+    int32 Hits[2] = {};
+    int32 BlockedHits[2] = {};
+    int32 GuardBreaksCaused[2] = {};
+
+    /** Posture every PostureSampleInterval until the duel ended */
+    TArray<float> PostureSamples[2];
+};
+
+/**
+ * Aggregate of a batch of duels
+ */
+struct FCombatDuelSummary
+{
+    int32 NumDuels = 0;
+    int32 Wins[2] = {};
+    int32 Draws = 0;
+    int32 Timeouts = 0;
+    float MeanDuration = 0.0f;
+
+    /** Health damage per second of duel time */
+    float DPS[2] = {};
+
+    float MeanGuardBreaksCaused[2] = {};
+
+    /** Blocked share of landed swings on this fighter */
+    float BlockRate[2] = {};
+
+    /** Mean posture per sample index over the duels still running at that time */
+    TArray<float> MeanPosture[2];
+
+    float GetWinRate(int32 FighterIndex) const { return NumDuels > 0 ? static_cast<float>(Wins[FighterIndex]) / NumDuels : 0.0f; }
+};
+
+/**
+ * Headless duel simulator for balance sweeps
+ *
+ * Each duel is two fighters in their own FCombatSimCore, driven by randomized input policies
+ * over cooked movesets. Every Active phase lands on the opponent: blocked swings deal posture
+ * damage, open ones deal health damage (times the attack's counter multiplier while the
+ * opponent is guard broken). First to 0 health loses; at the time limit the higher health
+ * fraction wins. A duel is fully determined by its params and seed, so batches can run in
+ * parallel and still reproduce.
+ */
+class KATANACOMBAT_API FCombatDuelSimulator
+{
+public:
+    /** Run one duel */
+    static FCombatDuelResult RunDuel(const FCombatDuelParams& Params, int32 Seed);
+
+    /**
+     * Run NumDuels duels across worker threads (duel i uses seed BaseSeed + i)
+     * @param OutResults - One result per duel, in seed order
+     */
+    static void RunDuels(const FCombatDuelParams& Params, int32 NumDuels, int32 BaseSeed, TArray<FCombatDuelResult>& OutResults);
+
+    /** Win rates, DPS and mean posture curves of a batch */
+    static FCombatDuelSummary Summarize(const TArray<FCombatDuelResult>& Results);
+};
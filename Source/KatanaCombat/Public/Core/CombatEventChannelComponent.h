@@ -0,0 +1,235 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CombatEventChannelComponent.generated.h"
+
+class UAttackData;
+class UCombatComponent;
+
+/**
+ * Kind of replicated combat event
+ */
+UENUM(BlueprintType)
+enum class ECombatNetEventType : uint8
+{
+    Hit             UMETA(DisplayName = "Hit"),
+    PerfectParry    UMETA(DisplayName = "Perfect Parry"),
+    PerfectEvade    UMETA(DisplayName = "Perfect Evade"),
+    GuardBroken     UMETA(DisplayName = "Guard Broken"),
+    Posture         UMETA(DisplayName = "Posture")
+};
+
+/**
+ * Unpacked combat event as seen by listeners on remote machines
+ */
+USTRUCT(BlueprintType)
+struct KATANACOMBAT_API FCombatReplicatedEvent
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    ECombatNetEventType Type = ECombatNetEventType::Hit;
+
+    /** Hit/parried/evaded actor (null for GuardBroken and Posture) */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    TObjectPtr<AActor> Target = nullptr;
+
+    /** Hit only: world impact point (1 cm precision within 10 m of the instigator) */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    FVector ImpactPoint = FVector::ZeroVector;
+
+    /** Hit only: hit direction (~1.5° precision) */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    FVector Direction = FVector::ZeroVector;
+
+    /** Hit only: attack resolved through the moveset table (null if the table hasn't replicated yet) */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    TObjectPtr<UAttackData> AttackData = nullptr;
+
+    /** Hit: damage dealt. Posture: new posture value */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    float Magnitude = 0.0f;
+};
+
+/**
+ * Quantized wire form of one combat event
+ * Hits cost ~10 bytes plus the target's net GUID; other events 1-3 bytes.
+ */
+struct KATANACOMBAT_API FCombatNetEvent
+{
+    ECombatNetEventType Type = ECombatNetEventType::Hit;
+
+    TWeakObjectPtr<AActor> Target;
+
+    /** Index into the instigator's replicated moveset table (NoAttack if none) */
+    uint8 AttackIndex = NoAttack;
+
+    /** Damage or posture in 1/16 units (max ~4096) */
+    uint16 Magnitude = 0;
+
+    /** Octahedral-encoded unit direction, 8 bits per axis (0 = none) */
+    uint16 Direction = 0;
+
+    /** Impact point relative to the instigator in cm, 11 bits per axis on the wire */
+    int16 ImpactOffset[3] = { 0, 0, 0 };
+
+    static constexpr uint8 NoAttack = 0xFF;
+    static constexpr int32 ImpactOffsetRange = 1024;
+    static constexpr float MagnitudeScale = 16.0f;
+
+    /** Read or write this event (Map resolves the target; may be null outside of replication) */
+    void Serialize(FArchive& Ar, UPackageMap* Map);
+
+    static uint16 QuantizeMagnitude(float Value);
+    static float DequantizeMagnitude(uint16 Value) { return Value / MagnitudeScale; }
+    static uint16 PackDirection(const FVector& Direction);
+    static FVector UnpackDirection(uint16 Packed);
+};
+
+/**
+ * Events gathered between two net updates of the instigator, sent as one RPC
+ */
+USTRUCT()
+struct KATANACOMBAT_API FCombatNetEventBatch
+{
+    GENERATED_BODY()
+
+    TArray<FCombatNetEvent, TInlineAllocator<8>> Events;
+
+    /** Events per batch (5 bit count); the rest wait for the next flush */
+    static constexpr int32 MaxEvents = 31;
+
+    bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FCombatNetEventBatch> : public TStructOpsTypeTraitsBase2<FCombatNetEventBatch>
+{
+    enum
+    {
+        WithNetSerializer = true
+    };
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnReplicatedCombatEvent, const FCombatReplicatedEvent&, Event);
+
+/**
+ * Replicated channel for combat events that are otherwise local delegates only
+ * (OnWeaponHit/OnAttackHit, OnPerfectParry, OnPerfectEvade, OnGuardBroken, OnPostureChanged)
+ * 
+ * On the server, events are quantized as they happen and queued; the queue is flushed once per
+ * net update of the owner as a single unreliable multicast. Attacks travel as a one-byte index
+ * into a replicated moveset table instead of an asset path. Posture changes within one batch
+ * collapse to the latest value.
+ * 
+ * Remote machines receive the unpacked events through OnReplicatedCombatEvent (cosmetics only -
+ * gameplay stays server-side). Does nothing in standalone.
+ */
+UCLASS(ClassGroup=(Combat), meta=(BlueprintSpawnableComponent))
+class KATANACOMBAT_API UCombatEventChannelComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UCombatEventChannelComponent();
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    // ============================================================================
+    // SENDING (server)
+    // ============================================================================
+
+    /**
+     * Queue a hit for replication
+     * @param Target - Actor hit
+     * @param ImpactPoint - World impact point
+     * @param Direction - Hit direction
+     * @param AttackData - Attack that hit (added to the moveset table if new)
+     * @param Damage - Damage dealt
+     */
+    void QueueHitEvent(AActor* Target, const FVector& ImpactPoint, const FVector& Direction, UAttackData* AttackData, float Damage);
+
+    /** Queue a non-hit event (Magnitude is only used by Posture) */
+    void QueueEvent(ECombatNetEventType Type, AActor* Target, float Magnitude = 0.0f);
+
+    /**
+     * Add attacks to the moveset table up front so their first hit doesn't race the table replication
+     * @param Attacks - Attacks this character can perform
+     */
+    void RegisterMoveset(TConstArrayView<UAttackData*> Attacks);
+
+    /** Events waiting for the next flush */
+    int32 GetNumPendingEvents() const { return PendingEvents.Events.Num(); }
+
+    // ============================================================================
+    // RECEIVING (remote)
+    // ============================================================================
+
+    /** Fired on remote machines for every event received */
+    UPROPERTY(BlueprintAssignable, Category = "Combat|Network")
+    FOnReplicatedCombatEvent OnReplicatedCombatEvent;
+
+    /**
+     * Unpack a wire event relative to an instigator
+     * @param Event - Quantized event
+     * @param Origin - Instigator location the impact offset is relative to
+     * @return Listener-facing event
+     */
+    FCombatReplicatedEvent UnpackEvent(const FCombatNetEvent& Event, const FVector& Origin) const;
+
+protected:
+    virtual void BeginPlay() override;
+
+    UFUNCTION(NetMulticast, Unreliable)
+    void MulticastCombatEvents(const FCombatNetEventBatch& Batch);
+
+private:
+    // ============================================================================
+    // STATE
+    // ============================================================================
+
+    /** Attacks referenced by events; clients resolve FCombatNetEvent::AttackIndex through this (max 255) */
+    UPROPERTY(Replicated)
+    TArray<TObjectPtr<UAttackData>> MovesetTable;
+
+    /** Events since the last flush */
+    FCombatNetEventBatch PendingEvents;
+
+    /** Index of the queued posture event (posture updates in one batch collapse into it) */
+    int32 PendingPostureIndex = INDEX_NONE;
+
+    float LastFlushTime = 0.0f;
+
+    /** Owner's combat component (event source) */
+    UPROPERTY()
+    TObjectPtr<UCombatComponent> OwnerCombat;
+
+    // ============================================================================
+    // INTERNAL HELPERS
+    // ============================================================================
+
+    /** Is this the server of a networked game? */
+    bool ShouldSend() const;
+
+    /** Moveset table index for an attack (appended if new, NoAttack if the table is full) */
+    uint8 GetAttackIndex(UAttackData* AttackData);
+
+    /** Send pending events and start a new batch */
+    void FlushEvents();
+
+    UFUNCTION()
+    void HandlePerfectParry(AActor* ParriedActor);
+
+    UFUNCTION()
+    void HandlePerfectEvade(AActor* EvadedActor);
+
+    UFUNCTION()
+    void HandleGuardBroken();
+
+    UFUNCTION()
+    void HandlePostureChanged(float NewPosture);
+};
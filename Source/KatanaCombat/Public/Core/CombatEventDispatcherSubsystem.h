@@ -0,0 +1,262 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatEventDispatcherSubsystem.generated.h"
+
+class UAttackData;
+
+/**
+ * Topic of a dispatched combat event (see FCombatEvent for each kind's payload)
+ */
+enum class ECombatEventKind : uint8
+{
+    /** Weapon hit landed (Instigator = attacker, Target = hit actor, AttackData, Location = impact point) */
+    Hit,
+
+    /** Damage taken, one per target per frame (Instigator = attacker, Target = victim, Magnitude = damage) */
+    Damage,
+
+    /** Perfect parry (Instigator = parrying actor, Target = parried attacker) */
+    PerfectParry,
+
+    /** Guard broken (Instigator = guard broken actor) */
+    GuardBroken,
+
+    /** Posture changed by damage, restore or parry - not analytic regen (Instigator = owner, Magnitude = new posture) */
+    Posture,
+
+    /** V1 combat state changed (Instigator = owner, Arg0 = new ECombatState) */
+    CombatState,
+
+    /** V2 attack phase changed (Instigator = owner, Arg0 = old EAttackPhase, Arg1 = new EAttackPhase) */
+    Phase,
+
+    /** V2 attack started (Instigator = owner, AttackData, Arg0 = EInputType, Arg1 = combo) */
+    AttackStarted,
+
+    Count
+};
+
+KATANACOMBAT_API const TCHAR* LexToString(ECombatEventKind Kind);
+
+/**
+ * One combat event (POD queued by value, delivered once at the end of the frame)
+ */
+struct FCombatEvent
+{
+    ECombatEventKind Kind = ECombatEventKind::Hit;
+
+    /** Kind-specific small payload */
+    uint8 Arg0 = 0;
+    uint8 Arg1 = 0;
+
+    TWeakObjectPtr<AActor> Instigator;
+    TWeakObjectPtr<AActor> Target;
+    TWeakObjectPtr<const UAttackData> AttackData;
+
+    FVector Location = FVector::ZeroVector;
+    float Magnitude = 0.0f;
+};
+
+/**
+ * What a subscriber wants delivered; every set field must match
+ */
+struct FCombatEventFilter
+{
+    static constexpr uint32 AllKinds = (1u << static_cast<uint32>(ECombatEventKind::Count)) - 1;
+
+    static constexpr uint32 KindBit(ECombatEventKind Kind) { return 1u << static_cast<uint32>(Kind); }
+
+    /** Event kinds to receive (KindBit mask) */
+    uint32 KindMask = AllKinds;
+
+    /** Only events this actor instigated (unset = any) */
+    TWeakObjectPtr<AActor> Instigator;
+
+    /** Only events targeting this actor (unset = any) */
+    TWeakObjectPtr<AActor> Target;
+
+    /** Only events this actor instigated or is the target of (unset = any) */
+    TWeakObjectPtr<AActor> Involving;
+
+    FCombatEventFilter() = default;
+    explicit FCombatEventFilter(std::initializer_list<ECombatEventKind> Kinds)
+        : KindMask(0)
+    {
+        for (const ECombatEventKind Kind : Kinds)
+        {
+            KindMask |= KindBit(Kind);
+        }
+    }
+
+    /** Does an event pass (compares weak pointers by index and serial, nothing is resolved) */
+    bool Matches(const FCombatEvent& Event) const
+    {
+        return (KindMask & KindBit(Event.Kind)) != 0
+            && (Instigator.IsExplicitlyNull() || Instigator == Event.Instigator)
+            && (Target.IsExplicitlyNull() || Target == Event.Target)
+            && (Involving.IsExplicitlyNull() || Involving == Event.Instigator || Involving == Event.Target);
+    }
+};
+
+/**
+ * Handle to a combat event subscription (Index INDEX_NONE = none)
+ * The serial goes stale when the subscription is removed, so old handles never alias new ones
+ */
+struct FCombatEventSubscription
+{
+    int32 Index = INDEX_NONE;
+    uint32 Serial = 0;
+
+    bool IsValid() const { return Index != INDEX_NONE; }
+    void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+/**
+ * Topic-filtered combat event dispatcher
+ *
+ * The component delegates (OnWeaponHit, OnDamageReceived, OnPerfectParry, OnPhaseChanged, ...) call
+ * every listener for every owner's event, and listeners then throw most of them away by actor or
+ * type. Here sources publish into one per-frame event array instead, and subscribers register a
+ * filter (kinds, instigator, target, involving). Tick drains the array in one pass: each event only
+ * visits the subscribers of its kind, filters are plain weak-pointer compares, and the callback is a
+ * compile-time member function thunk (as on the timer wheel) - no reflection, no dynamic delegates.
+ *
+ * Publishing a kind nobody subscribed to returns immediately. Events published while dispatching
+ * (including from callbacks) are delivered next frame. The component delegates still fire as before.
+ *
+ * Console: Combat.Events.Watch [ActorName] logs every event involving the actor (no name = stop)
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatEventDispatcherSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    /** Subsystem for an object's world (nullptr in worlds without one, e.g. during teardown) */
+    static UCombatEventDispatcherSubsystem* Get(const UObject* WorldContextObject);
+
+    // ============================================================================
+    // PUBLISHING
+    // ============================================================================
+
+    /** Does any subscriber want this kind? (skip building the event when not) */
+    bool IsListening(ECombatEventKind Kind) const { return (SubscribedKindMask & FCombatEventFilter::KindBit(Kind)) != 0; }
+
+    /**
+     * Queue an event for this frame's dispatch
+     * @return The queued event to fill the rest of the payload (valid until the next Publish), or
+     *         nullptr when no subscriber wants this kind
+     */
+    FCombatEvent* Publish(ECombatEventKind Kind, AActor* Instigator, AActor* Target = nullptr);
+
+    /** Publish through the dispatcher of an object's world (nullptr without one, or nobody listening) */
+    static FCombatEvent* PublishFrom(const UObject* WorldContextObject, ECombatEventKind Kind, AActor* Instigator, AActor* Target = nullptr);
+
+    /** Deliver every queued event now (also run by Tick) */
+    void DispatchPendingEvents();
+
+    /** Events waiting for this frame's dispatch */
+    int32 GetNumPendingEvents() const { return PendingEvents.Num(); }
+
+    // ============================================================================
+    // SUBSCRIBING
+    // ============================================================================
+
+    /**
+     * Deliver events passing Filter to Method on Object, replacing the subscription InOutHandle refers to
+     * Usage: Subscribe<&UMyWidget::HandleCombatEvent>(EventSubscription, this, FCombatEventFilter({ ECombatEventKind::Damage }));
+     * Method signature: void (const FCombatEvent& Event)
+     * @param InOutHandle - Subscription to replace; receives the new handle
+     * @param Object - Callback target (held weakly - the subscription is dropped once it's gone)
+     * @param Filter - Events to receive
+     */
+    template<auto Method, typename T>
+    void Subscribe(FCombatEventSubscription& InOutHandle, T* Object, const FCombatEventFilter& Filter)
+    {
+        Unsubscribe(InOutHandle);
+        InOutHandle = AddSubscriber(Object, &Invoke<T, Method>, Filter);
+    }
+
+    /**
+     * Remove a subscription
+     * @param InOutHandle - Subscription to remove (invalidated on return)
+     * @return True if a subscription was removed
+     */
+    bool Unsubscribe(FCombatEventSubscription& InOutHandle);
+
+    /** Is this subscription still registered? */
+    bool IsSubscribed(const FCombatEventSubscription& Handle) const;
+
+    /** Number of subscriptions */
+    int32 GetNumSubscribers() const { return Subscribers.Num(); }
+
+    /** Log every event involving Actor (nullptr = stop watching) */
+    void WatchActor(AActor* Actor);
+
+    // ============================================================================
+    // STATS
+    // ============================================================================
+
+    /** Events dispatched / callbacks made in the last dispatch */
+    int32 GetNumDispatchedLastFrame() const { return NumDispatchedLastFrame; }
+    int32 GetNumDeliveredLastFrame() const { return NumDeliveredLastFrame; }
+
+private:
+    /** Type-erased callback: casts the object back and calls the member function */
+    using FEventThunk = void (*)(UObject*, const FCombatEvent&);
+
+    template<typename T, auto Method>
+    static void Invoke(UObject* Object, const FCombatEvent& Event)
+    {
+        (static_cast<T*>(Object)->*Method)(Event);
+    }
+
+    FCombatEventSubscription AddSubscriber(UObject* Object, FEventThunk Thunk, const FCombatEventFilter& Filter);
+
+    /** Rebuild the per-kind subscriber lists and kind mask (after subscriptions changed) */
+    void RebuildKindLists();
+
+    /** Combat.Events.Watch subscriber */
+    void LogEvent(const FCombatEvent& Event);
+
+    FCombatEventSubscription WatchSubscription;
+
+    struct FSubscriber
+    {
+        TWeakObjectPtr<UObject> Object;
+        FEventThunk Thunk = nullptr;
+        FCombatEventFilter Filter;
+        uint32 Serial = 0;
+    };
+
+    /** Registered subscriptions (handle index = sparse index) */
+    TSparseArray<FSubscriber> Subscribers;
+    uint32 NextSerial = 1;
+
+    /** Subscription handles per event kind (handles, so removals during dispatch are caught) */
+    TArray<FCombatEventSubscription> KindSubscribers[static_cast<int32>(ECombatEventKind::Count)];
+    bool bKindListsDirty = false;
+
+    /** Kinds with at least one subscriber */
+    uint32 SubscribedKindMask = 0;
+
+    /** Events queued this frame, and the batch being delivered */
+    TArray<FCombatEvent> PendingEvents;
+    TArray<FCombatEvent> DispatchingEvents;
+
+    int32 NumDispatchedLastFrame = 0;
+    int32 NumDeliveredLastFrame = 0;
+};
\ No newline at end of file
@@ -0,0 +1,93 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTypes.h"
+#include "CombatImpactSubsystem.generated.h"
+
+class UCombatSettings;
+class UAttackData;
+struct FHitResult;
+
+/**
+ * Impact feedback (VFX + audio) for weapon hits
+ *
+ * Hits only record intent; once per frame the subsystem resolves each hit's effect from the
+ * attacker's UCombatSettings::ImpactEffects (surface x attack type) and emits the whole frame's
+ * impacts together, so a wide cleave doesn't spawn a burst of components in one frame:
+ * - VFX: one Niagara Data Channel write per settings asset with every impact as an element when
+ *   ImpactDataChannel is set, otherwise systems from Niagara's component pool (auto-release,
+ *   capped per frame by MaxImpactSpawnsPerFrame)
+ * - Audio: one fire-and-forget sound per effect per frame at the centroid of its hits (no audio
+ *   component), louder with each merged hit
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatImpactSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    // ============================================================================
+    // REQUESTS
+    // ============================================================================
+
+    /**
+     * Queue impact feedback for a hit (emitted with the rest of this frame's hits)
+     * @param Hit - Weapon hit (impact point, normal and hit component's surface)
+     * @param AttackData - Attack that hit (selects the attack type)
+     * @param Settings - Attacker's settings holding the impact table
+     */
+    void QueueImpact(const FHitResult& Hit, const UAttackData* AttackData, const UCombatSettings* Settings);
+
+    /** Impacts waiting for this frame's flush */
+    int32 GetNumPendingImpacts() const { return PendingImpacts.Num(); }
+
+    /**
+     * Find the effect for a surface / attack type pair
+     * @return Index into Settings->ImpactEffects, INDEX_NONE if nothing matches
+     */
+    static int32 FindImpactEffect(const UCombatSettings* Settings, EPhysicalSurface Surface, EAttackType AttackType);
+
+    /** Surface of a hit (returned physical material, else the hit component's simple material) */
+    static EPhysicalSurface GetHitSurface(const FHitResult& Hit);
+
+private:
+    struct FPendingImpact
+    {
+        TWeakObjectPtr<const UCombatSettings> Settings;
+        int32 EffectIndex = INDEX_NONE;
+        FVector Location = FVector::ZeroVector;
+        FVector Normal = FVector::UpVector;
+    };
+
+    /** Merged per-frame group: one effect of one settings asset */
+    struct FImpactGroup
+    {
+        const UCombatSettings* Settings = nullptr;
+        int32 EffectIndex = INDEX_NONE;
+        FVector LocationSum = FVector::ZeroVector;
+        int32 NumHits = 0;
+    };
+
+    TArray<FPendingImpact> PendingImpacts;
+
+    /** Per-frame scratch */
+    TArray<FImpactGroup> Groups;
+
+    /** Emit every pending impact (called once per frame) */
+    void FlushImpacts();
+
+    /** Write one settings asset's impacts to its data channel as a single batch */
+    void WriteDataChannel(const UCombatSettings& Settings, TConstArrayView<const FPendingImpact*> Impacts);
+};
@@ -0,0 +1,95 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InputCoreTypes.h"
+#include "CombatInputTimingSubsystem.generated.h"
+
+class FCombatInputTimingProcessor;
+
+/**
+ * Platform timestamps for combat inputs
+ *
+ * Enhanced Input callbacks run during the world tick, so anything stamped there with world time
+ * is quantized to the frame. The engine exposes no OS message timestamps; the earliest point it
+ * sees a key is the Slate input preprocessor, which runs when platform messages are dispatched -
+ * before the world tick that fires the Enhanced Input callback. This subsystem registers one,
+ * records FPlatformTime::Seconds() per key press/release there, and maps those times back onto
+ * world time so the V2 queue, hold checks and parry evaluation compare sub-frame times.
+ *
+ * Mapped times never reach further back than one frame: an input can't be credited to a moment
+ * the game never simulated.
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatInputTimingSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Key events older than this (seconds) are stale - the action fired from something else */
+    static constexpr double MaxEventAge = 0.25;
+
+    // ============================================================================
+    // RECORDING
+    // ============================================================================
+
+    /**
+     * Record a key transition (called by the input preprocessor; tests call it directly)
+     * @param Key - Key or button that changed
+     * @param bPressed - Press (true) or release (false)
+     * @param PlatformTime - FPlatformTime::Seconds() when the event was seen
+     */
+    void RecordKeyEvent(const FKey& Key, bool bPressed, double PlatformTime);
+
+    /**
+     * Most recent recorded press/release among a set of keys
+     * @param Keys - Keys mapped to the action that fired
+     * @param bPressed - Look up presses (true) or releases (false)
+     * @return Platform time of the latest matching event, 0 if none is recent enough
+     */
+    double GetLatestKeyEventTime(TConstArrayView<FKey> Keys, bool bPressed) const;
+
+    // ============================================================================
+    // CONVERSION
+    // ============================================================================
+
+    /**
+     * Map a platform timestamp onto this world's clock
+     * @param PlatformTime - FPlatformTime::Seconds() of the event (0 = unknown, returns world time now)
+     * @return World time the event happened at, within the current frame
+     */
+    float PlatformTimeToWorldTime(double PlatformTime) const;
+
+    /**
+     * Pure mapping used by PlatformTimeToWorldTime
+     * @param PlatformTime - Event platform time
+     * @param FramePlatformTime - Platform time the current frame started (FApp::GetCurrentTime)
+     * @param WorldTime - World time of the current frame
+     * @param FrameDeltaTime - World delta of the current frame (how far back an event may be credited)
+     * @param TimeDilation - World time dilation (real seconds to world seconds)
+     */
+    static float MapPlatformTimeToWorldTime(double PlatformTime, double FramePlatformTime, float WorldTime, float FrameDeltaTime, float TimeDilation);
+
+private:
+    struct FKeyEventTimes
+    {
+        double LastPressTime = 0.0;
+        double LastReleaseTime = 0.0;
+    };
+
+    /** Latest transitions per key (small - only keys touched this session) */
+    TMap<FKey, FKeyEventTimes> KeyEvents;
+
+    /** Slate preprocessor feeding RecordKeyEvent (null without Slate, e.g. commandlets and tests) */
+    TSharedPtr<FCombatInputTimingProcessor> InputProcessor;
+};
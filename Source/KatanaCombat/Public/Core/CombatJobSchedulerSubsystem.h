@@ -0,0 +1,179 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatJobSchedulerSubsystem.generated.h"
+
+/**
+ * Order due jobs run in when the frame budget can't fit them all
+ */
+enum class ECombatJobPriority : uint8
+{
+    /** Gameplay-visible (AI decisions) */
+    High,
+
+    /** Presentation (UI culling) */
+    Normal,
+
+    /** Housekeeping (cache eviction, stale entry pruning) */
+    Low
+};
+
+/**
+ * Handle to a scheduled combat job (Index INDEX_NONE = none)
+ * The serial goes stale when the job is unregistered, so old handles never alias new jobs
+ */
+struct FCombatJobHandle
+{
+    int32 Index = INDEX_NONE;
+    uint32 Serial = 0;
+
+    bool IsValid() const { return Index != INDEX_NONE; }
+    void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+/**
+ * Time-sliced scheduler for combat work that doesn't have to land on a given frame
+ * (AI LOD evaluation, attack token pruning, life bar culling, line-of-sight cache eviction)
+ *
+ * Systems register a recurring job with an interval and a priority instead of doing the work in
+ * their own tick. Each frame the jobs that are due run highest priority first, oldest first, until
+ * FrameBudgetMs is spent; the rest slip to the next frame. A job that would not fit in what's left of
+ * the budget (judged by its average cost) waits too, but the first due job always runs so the queue
+ * keeps moving. Starvation protection: a job overdue by more than MaxDeferralTime runs regardless of
+ * budget.
+ *
+ * Callbacks are a weak object + a compile-time member function thunk (as on the timer wheel)
+ * receiving the world seconds since the job's last run. Intervals restart from the actual run, so a
+ * deferred job doesn't burst to catch up. World time drives the schedule (paused worlds don't run jobs).
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatJobSchedulerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    /** Game thread milliseconds per frame spent on due jobs (starved jobs may exceed it) */
+    float FrameBudgetMs = 0.5f;
+
+    /** A due job deferred longer than this runs even over budget (seconds) */
+    float MaxDeferralTime = 0.25f;
+
+    /**
+     * Run the jobs due at Now within the frame budget (what Tick does with the world time)
+     * @param Now - World time to run at
+     * @param bIgnoreBudget - Run every due job (flushing before a save, tests)
+     */
+    void RunDueJobs(double Now, bool bIgnoreBudget = false);
+
+    // ============================================================================
+    // JOBS
+    // ============================================================================
+
+    /**
+     * Run Method on Object every Interval seconds, replacing the job InOutHandle refers to
+     * Usage: RegisterJob<&UMySubsystem::RefreshCache>(RefreshJob, this, 0.5f, ECombatJobPriority::Low);
+     * Method signature: void (float DeltaTime) - world seconds since the job last ran
+     * @param InOutHandle - Job to replace; receives the new handle
+     * @param Object - Callback target (held weakly - the job is dropped once it's gone)
+     * @param Interval - Seconds between runs (0 = every frame the budget allows)
+     * @param Priority - Order against other due jobs
+     * @param Name - Shown in traces and Combat.Jobs (must outlive the job, e.g. a literal)
+     */
+    template<auto Method, typename T>
+    void RegisterJob(FCombatJobHandle& InOutHandle, T* Object, float Interval, ECombatJobPriority Priority, const TCHAR* Name)
+    {
+        UnregisterJob(InOutHandle);
+        InOutHandle = AddJob(Object, &Invoke<T, Method>, Interval, Priority, Name);
+    }
+
+    /**
+     * Stop a job
+     * @param InOutHandle - Job to stop (invalidated on return)
+     * @return True if a registered job was removed
+     */
+    bool UnregisterJob(FCombatJobHandle& InOutHandle);
+
+    /** Make a job due now (e.g. a newcomer that should be evaluated right away) */
+    void MarkJobDue(const FCombatJobHandle& Handle);
+
+    /** Is this job still registered? */
+    bool IsJobRegistered(const FCombatJobHandle& Handle) const;
+
+    /** Number of registered jobs */
+    int32 GetNumJobs() const { return Jobs.Num(); }
+
+    // ============================================================================
+    // STATS
+    // ============================================================================
+
+    /** Jobs run / left for a later frame by the budget in the last tick */
+    int32 GetNumRunLastFrame() const { return NumRunLastFrame; }
+    int32 GetNumDeferredLastFrame() const { return NumDeferredLastFrame; }
+
+    /** Jobs run over budget because they had waited longer than MaxDeferralTime, last tick */
+    int32 GetNumStarvedLastFrame() const { return NumStarvedLastFrame; }
+
+    /** Milliseconds spent running jobs in the last tick */
+    float GetTimeSpentLastFrameMs() const { return TimeSpentLastFrameMs; }
+
+    /** Log every job with its interval and average cost */
+    void DumpJobs() const;
+
+private:
+    /** Type-erased callback: casts the object back and calls the member function */
+    using FJobThunk = void (*)(UObject*, float);
+
+    template<typename T, auto Method>
+    static void Invoke(UObject* Object, float DeltaTime)
+    {
+        (static_cast<T*>(Object)->*Method)(DeltaTime);
+    }
+
+    FCombatJobHandle AddJob(UObject* Object, FJobThunk Thunk, float Interval, ECombatJobPriority Priority, const TCHAR* Name);
+
+    struct FJob
+    {
+        TWeakObjectPtr<UObject> Object;
+        FJobThunk Thunk = nullptr;
+        const TCHAR* Name = nullptr;
+        ECombatJobPriority Priority = ECombatJobPriority::Normal;
+        float Interval = 0.0f;
+
+        /** World time the job is next due, and last ran (< 0 = never) */
+        double DueTime = 0.0;
+        double LastRunTime = -1.0;
+
+        /** Smoothed cost of one run (ms), used to decide whether it fits what's left of the budget */
+        float AverageCostMs = 0.0f;
+
+        uint32 Serial = 0;
+    };
+
+    /** Job for a handle (nullptr if stale) */
+    FJob* FindJob(const FCombatJobHandle& Handle);
+    const FJob* FindJob(const FCombatJobHandle& Handle) const;
+
+    /** Registered jobs (handle index = sparse index) */
+    TSparseArray<FJob> Jobs;
+    uint32 NextSerial = 1;
+
+    /** Due job indices (per-frame scratch) */
+    TArray<int32> DueJobs;
+
+    int32 NumRunLastFrame = 0;
+    int32 NumDeferredLastFrame = 0;
+    int32 NumStarvedLastFrame = 0;
+    float TimeSpentLastFrameMs = 0.0f;
+};
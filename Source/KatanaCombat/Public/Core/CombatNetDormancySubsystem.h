@@ -0,0 +1,130 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CombatTypes.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "Core/CombatRegistrySubsystem.h"
+#include "CombatNetDormancySubsystem.generated.h"
+
+/**
+ * How much replication a combatant gets (higher = more)
+ */
+enum class ECombatNetTier : uint8
+{
+    /** Out of combat for DormancyDelay - dormant, costs no bandwidth or server replication time */
+    Dormant,
+
+    /** Awake but not engaged (waiting out DormancyDelay) - default priority */
+    Idle,
+
+    /** Blocking, in a window, locked on or targeted - EngagedNetPriority */
+    Engaged,
+
+    /** Attacking or sweeping its weapon - AttackerNetPriority */
+    Attacking
+};
+
+/**
+ * Combat-driven net dormancy and priority for replicated combatants (server side)
+ *
+ * A scheduled pass reads the combat registry every UpdateInterval and ranks each combatant:
+ * attackers first, then everyone engaged (blocking, in a window, out of Idle, locked on, or the
+ * target of someone locked on), then idle. Engaged combatants stay awake with a raised
+ * NetPriority; combatants left out of combat for DormancyDelay go DORM_DormantAll, so bandwidth
+ * follows the number of fighters rather than the level's population.
+ *
+ * WakeActor wakes a combatant at once and restarts its DormancyDelay - called when it's hit
+ * (UHitReactionComponent) and when its squad activates (UCombatSquadSubsystem). Player pawns and
+ * actors set to DORM_Never are never put to sleep.
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatNetDormancySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // ============================================================================
+    // CONFIGURATION
+    // ============================================================================
+
+    /** Time between ranking passes (seconds) */
+    float UpdateInterval = 0.2f;
+
+    /** Time out of combat before a combatant goes dormant (seconds) */
+    float DormancyDelay = 3.0f;
+
+    /** NetPriority of attacking combatants */
+    float AttackerNetPriority = 3.0f;
+
+    /** NetPriority of engaged combatants that aren't attacking */
+    float EngagedNetPriority = 2.0f;
+
+    // ============================================================================
+    // DORMANCY
+    // ============================================================================
+
+    /** Wake an actor now and keep it awake for at least DormancyDelay */
+    void WakeActor(AActor* Actor);
+
+    /** WakeActor through the actor's world subsystem (no-op without one, or off the server) */
+    static void WakeActorFor(AActor* Actor);
+
+    /** Tier from the last pass (Idle for actors the pass hasn't seen) */
+    ECombatNetTier GetTier(const AActor* Actor) const;
+
+    /** Tier for a combatant's registry state (dormancy also needs DormancyDelay out of combat) */
+    static ECombatNetTier ClassifyCombatant(ECombatantFlags Flags, ECombatState State, bool bHasTarget, bool bTargeted);
+
+    /** Combatants the last pass put to sleep */
+    int32 GetNumDormant() const { return NumDormant; }
+
+    /** Rank every combatant now (normally done by the scheduled job on servers) */
+    void UpdateDormancy();
+
+private:
+    /** Per-combatant replication state */
+    struct FNetCombatant
+    {
+        TWeakObjectPtr<AActor> Actor;
+
+        /** World time the combatant was last engaged or woken */
+        double LastEngagedTime = 0.0;
+
+        /** NetPriority before we changed it */
+        float DefaultNetPriority = 1.0f;
+
+        ECombatNetTier Tier = ECombatNetTier::Idle;
+
+        /** Pass that last saw the combatant in the registry */
+        uint32 LastSeenPass = 0;
+    };
+
+    /** Scheduled job: UpdateDormancy on servers */
+    void UpdateDormancyJob(float DeltaTime);
+
+    /** Listen or dedicated server (standalone and clients have nothing to replicate) */
+    bool IsServerWorld() const;
+
+    FNetCombatant& FindOrAddCombatant(AActor* Actor);
+
+    /** Apply a tier's dormancy and priority to the actor */
+    void SetTier(FNetCombatant& Combatant, AActor& Actor, ECombatNetTier NewTier);
+
+    FCombatJobHandle UpdateJob;
+
+    TMap<FObjectKey, FNetCombatant> NetCombatants;
+
+    uint32 PassIndex = 0;
+    int32 NumDormant = 0;
+};
@@ -0,0 +1,168 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CombatProjectileSubsystem.generated.h"
+
+class UAttackData;
+class UWeaponComponent;
+
+/**
+ * Launch settings for a pooled projectile (kunai, arrow, thrown blade)
+ */
+USTRUCT(BlueprintType)
+struct FCombatProjectileParams
+{
+    GENERATED_BODY()
+
+    /** Attack the hits are reported with (damage, hit stun, reactions - same as a swing) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+    TObjectPtr<UAttackData> Attack;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+    FVector Location = FVector::ZeroVector;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+    FVector Velocity = FVector::ZeroVector;
+
+    /** Multiplier on world gravity (0 = straight line) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile", meta = (ClampMin = "0.0"))
+    float GravityScale = 1.0f;
+
+    /** Sweep sphere radius */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile", meta = (ClampMin = "0.1"))
+    float Radius = 4.0f;
+
+    /** Seconds before the projectile is returned to the pool without hitting anything */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile", meta = (ClampMin = "0.0"))
+    float Lifetime = 3.0f;
+
+    /** Actors hit before the projectile stops (more than 1 pierces) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile", meta = (ClampMin = "1"))
+    int32 MaxHits = 1;
+
+    /** Stop on world geometry (WorldStatic) instead of passing through */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+    bool bStopOnWorld = true;
+};
+
+/**
+ * Projectile in the pool. Goes stale once the projectile stops (the slot's serial moves on when it is reused)
+ */
+struct FCombatProjectileHandle
+{
+    int32 Slot = INDEX_NONE;
+    uint32 Serial = 0;
+
+    bool IsValid() const { return Slot != INDEX_NONE; }
+    bool operator==(const FCombatProjectileHandle& Other) const { return Slot == Other.Slot && Serial == Other.Serial; }
+};
+
+/**
+ * Pooled projectiles that hit through the weapon hit pipeline
+ *
+ * Projectiles aren't actors: the pool stores them as parallel arrays (structure of arrays) and one
+ * tick integrates every projectile in flight, then queues each frame's sweep with UWeaponTraceSubsystem
+ * so they go out in the same async batch as weapon swings. Hits come back the next frame and are
+ * reported by the launching weapon (UWeaponComponent::ProcessProjectileHit), so OnWeaponHit listeners
+ * and the UAttackData damage path handle them like any other hit.
+ *
+ * Stopped projectiles swap-remove out of the dense arrays and their slots are reused, so a crowd of
+ * ranged enemies costs no actor spawns, no per-projectile ticks and no allocations once the pool is warm.
+ *
+ * Hits only count where the weapon is the hit authority (standalone or server); client copies of a
+ * launch fly without reporting hits. Rendering is up to the caller (GetProjectileLocations for instanced meshes).
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatProjectileSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    // ============================================================================
+    // PROJECTILES
+    // ============================================================================
+
+    /**
+     * Launch a projectile from the pool
+     * @param Weapon - Weapon that reports the hits (its owner is never hit, its hurtbox and channel settings pick the targets)
+     * @param Params - Launch settings
+     * @return Handle to the projectile, invalid if the weapon is missing
+     */
+    FCombatProjectileHandle Launch(UWeaponComponent* Weapon, const FCombatProjectileParams& Params);
+
+    /** Blueprint version of Launch */
+    UFUNCTION(BlueprintCallable, Category = "Combat|Projectile", meta = (DisplayName = "Launch Projectile"))
+    bool K2_Launch(UWeaponComponent* Weapon, const FCombatProjectileParams& Params) { return Launch(Weapon, Params).IsValid(); }
+
+    /** Return a projectile to the pool now */
+    void Stop(FCombatProjectileHandle Projectile);
+
+    /** Is the projectile still in flight? */
+    bool IsActive(FCombatProjectileHandle Projectile) const { return GetDenseIndex(Projectile) != INDEX_NONE; }
+
+    /** Current location and velocity of a projectile. Returns false once it has stopped */
+    bool GetProjectileState(FCombatProjectileHandle Projectile, FVector& OutLocation, FVector& OutVelocity) const;
+
+    /** Locations of every projectile in flight (dense, order changes as projectiles stop) */
+    TConstArrayView<FVector> GetProjectileLocations() const { return Locations; }
+
+    /** Number of projectiles in flight */
+    int32 GetNumProjectiles() const { return Locations.Num(); }
+
+    /** Slots allocated so far (in flight + pooled) */
+    int32 GetPoolSize() const { return SlotSerials.Num(); }
+
+    /** Move every projectile one step and queue its sweep (normally done by Tick) */
+    void Integrate(float DeltaTime);
+
+    /**
+     * Hits of a projectile's sweep (called by UWeaponTraceSubsystem the frame after it was queued)
+     * Reports hits through the weapon until the projectile runs out of hits or meets the world
+     */
+    void HandleTraceHits(FCombatProjectileHandle Projectile, const TArray<FHitResult>& Hits);
+
+    /** Slots reserved the first time a projectile launches, so a volley doesn't grow the arrays one by one */
+    int32 InitialPoolSize = 64;
+
+private:
+    /** Dense index of a projectile in flight, or INDEX_NONE */
+    int32 GetDenseIndex(FCombatProjectileHandle Projectile) const;
+
+    /** Swap-remove a projectile from the dense arrays and free its slot */
+    void RemoveAt(int32 Index);
+
+    // Dense per-projectile arrays (one entry per projectile in flight, same order)
+    TArray<FVector> Locations;
+    TArray<FVector> Velocities;
+    TArray<float> GravityScales;
+    TArray<float> Radii;
+    TArray<float> TimesLeft;
+    TArray<int32> HitsLeft;
+    TArray<bool> StopOnWorld;
+    TArray<TWeakObjectPtr<UWeaponComponent>> Weapons;
+    TArray<int32> DenseSlots;
+
+    /** Actors each projectile has already hit (piercing projectiles hit each actor once) */
+    TArray<TArray<FObjectKey, TInlineAllocator<2>>> HitActors;
+
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UAttackData>> Attacks;
+
+    // Slot table: handle -> dense index, serials invalidate handles when a slot is reused
+    TArray<uint32> SlotSerials;
+    TArray<int32> SlotDenseIndices;
+    TArray<int32> FreeSlots;
+};
@@ -0,0 +1,164 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CombatTypes.h"
+#include "CombatRegistrySubsystem.generated.h"
+
+class UCombatComponent;
+
+/**
+ * Per-combatant state bits in the registry (one byte scanned per combatant)
+ */
+enum class ECombatantFlags : uint8
+{
+    None = 0,
+
+    /** Attacking, charging or holding an attack */
+    Attacking = 1 << 0,
+
+    Blocking = 1 << 1,
+
+    /** Attacker-side parry window open (can be parried) */
+    ParryWindow = 1 << 2,
+
+    /** Counter window open (was just parried) */
+    CounterWindow = 1 << 3,
+
+    /** Weapon hit detection enabled */
+    HitDetection = 1 << 4
+};
+ENUM_CLASS_FLAGS(ECombatantFlags);
+
+/**
+ * World registry of everyone fighting (actors with a UCombatComponent)
+ *
+ * Answers the cross-character questions ("who is attacking me", "who can be parried", "who is
+ * targeting X") from SoA arrays sampled once per frame instead of overlaps plus interface calls:
+ * attack state and phase, open windows, locked-on target and position per combatant. Combat
+ * components register at BeginPlay; destroyed combatants are purged on the next refresh.
+ *
+ * Arrays refresh lazily on the first query of a frame. Per-index accessors read the last refresh
+ * (use FindCombatant, which refreshes, to get an index).
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatRegistrySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    // ============================================================================
+    // REGISTRATION
+    // ============================================================================
+
+    /** Add a combat component's owner (no-op if already registered) */
+    void RegisterCombatant(UCombatComponent* CombatComponent);
+
+    /** Remove a combat component's owner */
+    void UnregisterCombatant(UCombatComponent* CombatComponent);
+
+    /** Number of registered combatants (may include stale entries until the next refresh) */
+    int32 GetNumCombatants() const { return Combatants.Num(); }
+
+    // ============================================================================
+    // QUERIES
+    // ============================================================================
+
+    /**
+     * Gather combatants attacking a target (attacking and locked onto it)
+     * @param Target - Actor being attacked
+     * @param OutAttackers - Attackers (appended)
+     * @param MaxRange - Only attackers within this distance of the target (<= 0 = any distance)
+     * @return Number of attackers added
+     */
+    int32 GetAttackersOf(const AActor* Target, TArray<AActor*>& OutAttackers, float MaxRange = 0.0f);
+
+    /**
+     * Gather combatants locked onto a target
+     * @return Number of combatants added
+     */
+    int32 GetCombatantsTargeting(const AActor* Target, TArray<AActor*>& OutCombatants);
+
+    /**
+     * Gather combatants with any of the given flags set
+     * @param Flags - Flags to test (any match)
+     * @param OutCombatants - Combatants (appended)
+     * @param IgnoreActor - Actor to exclude (usually the querier)
+     * @return Number of combatants added
+     */
+    int32 GetCombatantsWithFlags(ECombatantFlags Flags, TArray<AActor*>& OutCombatants, const AActor* IgnoreActor = nullptr);
+
+    /**
+     * Is the attacker attacking the target right now? (indexed lookup)
+     * @return True if the attacker is a combatant, attacking and locked onto the target
+     */
+    bool IsAttacking(const AActor* Attacker, const AActor* Target);
+
+    /**
+     * Index of a combatant in this frame's arrays (refreshes them if stale)
+     * @return Index for the accessors below, or INDEX_NONE if the actor isn't a combatant
+     */
+    int32 FindCombatant(const AActor* Actor);
+
+    AActor* GetCombatantActor(int32 Index) const { return Actors[Index].Get(); }
+    FVector GetCombatantLocation(int32 Index) const { return FVector(PositionsX[Index], PositionsY[Index], PositionsZ[Index]); }
+    ECombatState GetCombatantState(int32 Index) const { return States[Index]; }
+    EAttackPhase GetCombatantPhase(int32 Index) const { return Phases[Index]; }
+    ECombatantFlags GetCombatantFlags(int32 Index) const { return Flags[Index]; }
+
+    /** Locked-on target of a combatant (nullptr if none) */
+    AActor* GetCombatantTarget(int32 Index) const { return Targets[Index].Get(); }
+
+    /** Combatant index of a combatant's target (INDEX_NONE if it has none or the target isn't a combatant) */
+    int32 GetCombatantTargetIndex(int32 Index) const { return TargetIndices[Index]; }
+
+    /** Sample every combatant now (normally done by the first query each frame) */
+    void RefreshCombatants();
+
+private:
+    // ============================================================================
+    // SOA STORAGE
+    // ============================================================================
+
+    TArray<TWeakObjectPtr<UCombatComponent>> Combatants;
+    TArray<TWeakObjectPtr<AActor>> Actors;
+    TArray<FObjectKey> ActorKeys;
+    TArray<float> PositionsX;
+    TArray<float> PositionsY;
+    TArray<float> PositionsZ;
+    TArray<ECombatState> States;
+    TArray<EAttackPhase> Phases;
+    TArray<ECombatantFlags> Flags;
+    TArray<TWeakObjectPtr<AActor>> Targets;
+    TArray<FObjectKey> TargetKeys;
+    TArray<int32> TargetIndices;
+
+    /** Actor → index into SoA arrays */
+    TMap<FObjectKey, int32> CombatantIndices;
+
+    /** Frame the arrays were last refreshed (lazy, first query per frame) */
+    uint64 LastRefreshFrame = MAX_uint64;
+
+    // ============================================================================
+    // INTERNAL HELPERS
+    // ============================================================================
+
+    void RefreshIfStale()
+    {
+        if (LastRefreshFrame != GFrameCounter)
+        {
+            RefreshCombatants();
+        }
+    }
+
+    /** Sample one combatant's state into its slot */
+    void SampleCombatant(int32 Index, const UCombatComponent& CombatComponent);
+
+    /** Swap-remove entry at Index from all SoA arrays */
+    void RemoveAtIndex(int32 Index);
+};
@@ -0,0 +1,182 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/CombatDuelSimulator.h"
+
+/**
+ * One fighter's input for one frame (what duel peers exchange - a single byte)
+ * Light/Heavy are presses that frame, Hold/Block are held buttons
+ */
+struct FCombatRollbackInput
+{
+    enum EButton : uint8
+    {
+        Light = 1 << 0,
+        Heavy = 1 << 1,
+        Hold = 1 << 2,
+        Block = 1 << 3,
+
+        /** Held buttons - what a missing input is predicted to keep doing */
+        HeldMask = Hold | Block
+    };
+
+    uint8 Buttons = 0;
+
+    bool IsDown(EButton Button) const { return (Buttons & Button) != 0; }
+
+    bool operator==(const FCombatRollbackInput& Other) const { return Buttons == Other.Buttons; }
+    bool operator!=(const FCombatRollbackInput& Other) const { return Buttons != Other.Buttons; }
+};
+
+/**
+ * Duel state at the start of a frame - one fixed-size, memcpy-able block (about a hundred bytes)
+ */
+struct FCombatRollbackState
+{
+    FCombatSimSnapshot Sim;
+    float Health[2] = {};
+};
+static_assert(std::is_trivially_copyable_v<FCombatRollbackState>, "Rollback states are saved and restored with memcpy");
+
+/**
+ * Something a confirmed frame did - the host plays montages, VFX and audio from these
+ */
+struct FCombatRollbackEvent
+{
+    int32 Frame = 0;
+    FCombatSimEvent SimEvent;
+
+    /** Set on the attacker's PhaseChanged -> Active event when the swing lands */
+    bool bHit = false;
+
+    /** The defender was blocking (Damage is posture damage rather than health) */
+    bool bBlocked = false;
+
+    float Damage = 0.0f;
+};
+
+struct FCombatRollbackConfig
+{
+    FCombatSimConfig Sim;
+
+    /** Per fighter, must outlive the session */
+    const FCombatDuelMoveset* Movesets[2] = {};
+
+    float MaxHealth[2] = { 100.0f, 100.0f };
+
+    /** Frames local input waits before it's simulated (hides this much latency without rolling back) */
+    int32 InputDelay = 2;
+
+    /** Most frames simulated past the last confirmed one; AdvanceFrame stalls beyond this */
+    int32 MaxRollbackFrames = 8;
+};
+
+/**
+ * Rollback session for a 1v1 duel on FCombatSimCore
+ *
+ * Both peers run the same session; fighter 0 and 1 are the same characters on both. Every tick
+ * the host calls AdvanceFrame with its local input and sends the returned frame and input to the
+ * peer, which hands it to AddRemoteInput. Local input is simulated InputDelay frames later;
+ * frames whose remote input hasn't arrived are simulated on a prediction (the last remote input's
+ * held buttons). When a remote input contradicts its prediction, the next AdvanceFrame restores
+ * that frame's snapshot and resimulates up to the present - queued attacks, phases, posture and
+ * health only, so nothing is replayed on screen.
+ *
+ * Presentation runs on confirmed frames only (both inputs known, never resimulated again):
+ * GetConfirmedEvents lists what they did, once each, in frame order. Hits follow the duel rule
+ * (FCombatDuelSimulator): every Active phase reaches the opponent, blocked swings deal posture
+ * damage, open ones deal health damage.
+ */
+class KATANACOMBAT_API FCombatRollbackSession
+{
+public:
+    /** Reset to frame 0 with full health and posture (fighter LocalFighter's input is local) */
+    void Start(const FCombatRollbackConfig& InConfig, int32 InLocalFighter);
+
+    /**
+     * Resolve pending rollbacks, then simulate the next frame unless too far ahead of the peer
+     * @param LocalInput - This tick's local input (dropped when stalled - nothing was simulated)
+     * @return Frame LocalInput was scheduled for (send it to the peer), INDEX_NONE when stalled
+     */
+    int32 AdvanceFrame(FCombatRollbackInput LocalInput);
+
+    /**
+     * The peer's input for a frame (any order, duplicates ignored)
+     * @return False if the frame is too far ahead to hold yet
+     */
+    bool AddRemoteInput(int32 Frame, FCombatRollbackInput Input);
+
+    /** Roll back for remote inputs received since the last frame and confirm what they complete (AdvanceFrame starts with this) */
+    void Synchronize();
+
+    /** Next frame to simulate */
+    int32 GetCurrentFrame() const { return CurrentFrame; }
+
+    /** Frames before this one are final */
+    int32 GetConfirmedFrame() const { return ConfirmedFrame; }
+
+    /** Live (possibly predicted) state of a fighter */
+    const FCombatSimFighter& GetFighter(int32 FighterIndex) const { return Sim.GetFighter(FighterIndex); }
+    float GetHealth(int32 FighterIndex) const { return Health[FighterIndex]; }
+
+    /** Events of frames confirmed since the last ResetConfirmedEvents */
+    const TArray<FCombatRollbackEvent>& GetConfirmedEvents() const { return ConfirmedEvents; }
+    void ResetConfirmedEvents() { ConfirmedEvents.Reset(); }
+
+    /** Hash of the live state (compare confirmed frames across peers to detect desyncs) */
+    uint32 ComputeChecksum() const;
+
+    /** Rollbacks so far / frames simulated again because of them */
+    int32 GetNumRollbacks() const { return NumRollbacks; }
+    int32 GetNumResimulatedFrames() const { return NumResimulatedFrames; }
+
+private:
+    struct FFrameSlot
+    {
+        int32 Frame = INDEX_NONE;
+        FCombatRollbackInput Inputs[2];
+        bool bConfirmed[2] = {};
+
+        /** State before the frame was simulated */
+        FCombatRollbackState State;
+
+        /** What simulating the frame raised (replaced on resimulation) */
+        TArray<FCombatRollbackEvent, TInlineAllocator<4>> Events;
+    };
+
+    /** Slot for a frame, reset if it still holds an older frame */
+    FFrameSlot& GetSlot(int32 Frame);
+
+    void SimulateFrame(int32 Frame);
+    void ApplyInput(int32 FighterIndex, FCombatRollbackInput Input);
+    void ResolveHits(FFrameSlot& Slot);
+    void UpdateConfirmed();
+
+    FCombatRollbackConfig Config;
+    int32 LocalFighter = 0;
+    int32 AttackOffsets[2] = {};
+
+    FCombatSimCore Sim;
+    float Health[2] = {};
+
+    /** Ring of recent frames (power of two) */
+    TArray<FFrameSlot> Slots;
+    int32 SlotMask = 0;
+
+    int32 CurrentFrame = 0;
+    int32 ConfirmedFrame = 0;
+
+    /** Earliest simulated frame whose prediction turned out wrong (INDEX_NONE = none) */
+    int32 RollbackFrame = INDEX_NONE;
+
+    /** Latest remote input received (predictions repeat its held buttons) */
+    FCombatRollbackInput LastRemoteInput;
+    int32 LastRemoteFrame = INDEX_NONE;
+
+    TArray<FCombatRollbackEvent> ConfirmedEvents;
+
+    int32 NumRollbacks = 0;
+    int32 NumResimulatedFrames = 0;
+};
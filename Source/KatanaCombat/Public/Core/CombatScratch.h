@@ -0,0 +1,122 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/CoreDelegates.h"
+
+/**
+ * Game-thread pool of reusable scratch arrays for combat queries (traces, overlaps, target lists)
+ *
+ * Query results have to land in plain TArrays (the physics scene's SweepMulti / OverlapMulti only
+ * take the default allocator), so instead of a custom allocator the pool lends out whole arrays:
+ * a query borrows one, fills it and hands it back emptied but with its allocation kept. Nested
+ * queries borrow separate arrays, so after the first few frames no combat query touches the heap.
+ *
+ * At the end of every frame arrays a spike grew past MaxRetainedBytes give their memory back.
+ * Borrow through TCombatScratchArray, never directly.
+ */
+template<typename ElementType>
+class TCombatScratchPool
+{
+public:
+    /** Free arrays keep allocations up to this size across frames */
+    static constexpr SIZE_T MaxRetainedBytes = 64 * 1024;
+
+    static TCombatScratchPool& Get()
+    {
+        static TCombatScratchPool Pool;
+        return Pool;
+    }
+
+    /** Lend an empty array (game thread only) */
+    TArray<ElementType>* Acquire()
+    {
+        check(IsInGameThread());
+
+        ++NumOutstanding;
+        if (FreeArrays.Num() > 0)
+        {
+            return FreeArrays.Pop(EAllowShrinking::No);
+        }
+
+        return Arrays.Add_GetRef(MakeUnique<TArray<ElementType>>()).Get();
+    }
+
+    /** Take a lent array back (emptied, allocation kept) */
+    void Release(TArray<ElementType>* Array)
+    {
+        check(IsInGameThread());
+
+        Array->Reset();
+        FreeArrays.Push(Array);
+        --NumOutstanding;
+    }
+
+    /** Arrays the pool has created (the deepest query nesting seen so far) */
+    int32 GetNumArrays() const { return Arrays.Num(); }
+
+    /** Arrays lent out right now */
+    int32 GetNumOutstanding() const { return NumOutstanding; }
+
+private:
+    TCombatScratchPool()
+    {
+        EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &TCombatScratchPool::OnEndFrame);
+    }
+
+    ~TCombatScratchPool()
+    {
+        FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    }
+
+    void OnEndFrame()
+    {
+        for (TArray<ElementType>* Array : FreeArrays)
+        {
+            if (Array->GetAllocatedSize() > MaxRetainedBytes)
+            {
+                Array->Empty();
+            }
+        }
+    }
+
+    TArray<TUniquePtr<TArray<ElementType>>> Arrays;
+    TArray<TArray<ElementType>*> FreeArrays;
+    int32 NumOutstanding = 0;
+    FDelegateHandle EndFrameHandle;
+};
+
+/**
+ * Scratch array borrowed from TCombatScratchPool for the current scope
+ *
+ *     TCombatScratchArray<FHitResult> HitResults;
+ *     World->SweepMultiByChannel(*HitResults, ...);
+ *
+ * Off the game thread it falls back to an array of its own.
+ */
+template<typename ElementType>
+class TCombatScratchArray : public FNoncopyable
+{
+public:
+    TCombatScratchArray()
+        : Array(IsInGameThread() ? TCombatScratchPool<ElementType>::Get().Acquire() : &LocalArray)
+    {
+    }
+
+    ~TCombatScratchArray()
+    {
+        if (Array != &LocalArray)
+        {
+            TCombatScratchPool<ElementType>::Get().Release(Array);
+        }
+    }
+
+    TArray<ElementType>& Get() const { return *Array; }
+    TArray<ElementType>& operator*() const { return *Array; }
+    TArray<ElementType>* operator->() const { return Array; }
+
+private:
+    TArray<ElementType>* Array;
+    TArray<ElementType> LocalArray;
+};
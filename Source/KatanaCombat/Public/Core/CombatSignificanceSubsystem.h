@@ -0,0 +1,114 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CombatSignificanceSubsystem.generated.h"
+
+/**
+ * How much combat work an actor deserves this frame (higher = more)
+ */
+UENUM(BlueprintType)
+enum class ECombatSignificance : uint8
+{
+    /** Far away and unseen - minimum fidelity, skipped where possible */
+    Culled,
+
+    /** Visible but small, or unseen and nearby */
+    Low,
+
+    /** Visible at mid range */
+    Medium,
+
+    /** Close, large on screen, or engaged with the player */
+    High
+};
+
+/**
+ * Ranks combat actors by distance, screen size and engagement with the player
+ *
+ * One ranking pass every UpdateInterval; consumers only read the cached rank:
+ * - UWeaponComponent - sweep substep cap per swing, debug drawing
+ * - UTargetingComponent - culled actors are not target candidates
+ * - UHitReactionComponent - culled actors skip the reaction montage (events and stun still apply)
+ *
+ * Actors are registered by their weapon and hit reaction components. Unregistered actors
+ * (and every actor when there is no local player) rank High.
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatSignificanceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    // ============================================================================
+    // CONFIGURATION
+    // ============================================================================
+
+    /** Time between ranking passes (seconds) */
+    float UpdateInterval = 0.2f;
+
+    /** Anything this close to the player view ranks High (cm) */
+    float HighDistance = 1500.0f;
+
+    /** Unseen actors beyond this distance are Culled (cm) */
+    float UnseenCullDistance = 4000.0f;
+
+    /** Everything beyond this distance is Culled (cm) */
+    float CullDistance = 8000.0f;
+
+    /** Fraction of the screen height an actor must cover to rank High */
+    float HighScreenSize = 0.1f;
+
+    /** Fraction of the screen height an actor must cover to rank Medium */
+    float MediumScreenSize = 0.03f;
+
+    /** Actors not rendered within this many seconds count as unseen */
+    float RecentlyRenderedTolerance = 0.2f;
+
+    // ============================================================================
+    // ACTORS
+    // ============================================================================
+
+    /** Add an actor to the ranking (no-op if already registered) */
+    void RegisterActor(AActor* Actor);
+
+    /** Remove an actor from the ranking */
+    void UnregisterActor(AActor* Actor);
+
+    /** Cached rank (High for unregistered actors) */
+    ECombatSignificance GetSignificance(const AActor* Actor) const;
+
+    /** Cached rank from the actor's world subsystem (High if there is none) */
+    static ECombatSignificance GetSignificanceFor(const AActor* Actor);
+
+    /** Rank for one actor from its view distance, screen size and engagement */
+    ECombatSignificance RankActor(float Distance, float ScreenSize, bool bRecentlyRendered, bool bEngaged) const;
+
+    /** Run the ranking pass now instead of waiting for the interval */
+    void UpdateSignificance();
+
+private:
+    /** Registered actors (swap-removed) and their cached rank */
+    TArray<TWeakObjectPtr<AActor>> Actors;
+    TArray<FObjectKey> ActorKeys;
+    TArray<ECombatSignificance> Ranks;
+
+    /** Actor -> index into Actors/Ranks */
+    TMap<FObjectKey, int32> ActorIndices;
+
+    float TimeUntilUpdate = 0.0f;
+
+    void RemoveAt(int32 Index);
+};
@@ -0,0 +1,234 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTypes.h"
+
+class UAttackData;
+class UCombatSettings;
+
+/**
+ * Phase durations and damage of one attack, cooked from UAttackData
+ */
+struct FCombatSimAttackTiming
+{
+    float Windup = 0.0f;
+    float Active = 0.0f;
+    float Recovery = 0.0f;
+    float PostureDamage = 0.0f;
+
+    float GetTotalDuration() const { return Windup + Active + Recovery; }
+};
+
+/**
+ * Tunables the simulation reads (cooked from UCombatSettings)
+ */
+struct FCombatSimConfig
+{
+    float MaxPosture = 100.0f;
+    float PostureRegenRate_Attacking = 50.0f;
+    float PostureRegenRate_Idle = 20.0f;
+    float GuardBreakStunDuration = 2.0f;
+    float GuardBreakRecoveryPercent = 0.5f;
+
+    /** Combo chain resets after this long without a follow-up (seconds) */
+    float ComboResetDelay = 3.0f;
+
+    /** Simulation step (seconds) */
+    float FixedTimeStep = 1.0f / 60.0f;
+};
+
+/**
+ * One fighter's simulation state (plain data - copyable, hashable, no references)
+ */
+struct FCombatSimFighter
+{
+    ECombatState State = ECombatState::Idle;
+    EAttackPhase Phase = EAttackPhase::None;
+
+    /** Seconds left in the current phase */
+    float PhaseRemaining = 0.0f;
+
+    float Posture = 100.0f;
+
+    /** Attack being performed (index into the timing table, INDEX_NONE when not attacking) */
+    int32 AttackIndex = INDEX_NONE;
+
+    /** Attack to start when the current one recovers (one-slot combo buffer) */
+    int32 QueuedAttackIndex = INDEX_NONE;
+
+    int32 ComboCount = 0;
+    float ComboResetRemaining = 0.0f;
+    float GuardBreakRemaining = 0.0f;
+
+    /** Input held - windup freezes while holding (hold-and-release attacks) */
+    bool bHoldRequested = false;
+    float HoldTime = 0.0f;
+};
+
+/**
+ * Every fighter's state in one fixed-size block (memcpy-able - rollback snapshots)
+ * Holds up to MaxFighters fighters, enough for a duel
+ */
+struct FCombatSimSnapshot
+{
+    static constexpr int32 MaxFighters = 2;
+
+    FCombatSimFighter Fighters[MaxFighters];
+    int32 NumFighters = 0;
+    float Accumulator = 0.0f;
+    uint64 StepCount = 0;
+};
+static_assert(std::is_trivially_copyable_v<FCombatSimSnapshot>, "Snapshots are saved and restored with memcpy");
+
+/** What happened during a step (consumed by the adapter: play montages, broadcast, apply hits) */
+enum class ECombatSimEventType : uint8
+{
+    AttackStarted,
+    PhaseChanged,
+    AttackFinished,
+    GuardBroken,
+    GuardRecovered
+};
+
+struct FCombatSimEvent
+{
+    int32 FighterIndex = INDEX_NONE;
+    ECombatSimEventType Type = ECombatSimEventType::PhaseChanged;
+    EAttackPhase Phase = EAttackPhase::None;
+    int32 AttackIndex = INDEX_NONE;
+};
+
+/**
+ * Deterministic combat simulation core
+ *
+ * The attack phase, hold, combo chaining, posture and guard break rules as plain data and
+ * functions: no UObjects, no world, no timers. State advances only in fixed steps of
+ * Config.FixedTimeStep (Advance accumulates real time), so the same inputs always produce the
+ * same state - usable headless, off the game thread, for rollback/prediction or in benchmarks.
+ *
+ * Attacks are indices into a cooked timing table (CookAttackTiming). Spatial questions (who a
+ * swing hits) stay with the host: it reacts to PhaseChanged -> Active events and calls
+ * ApplyPostureDamage. State changes go through the shared CombatStateTransitions table.
+ *
+ * The static helpers are the same rules for hosts that keep their own storage
+ * (UCombatComponent's analytic posture, UCombatCrowdSubsystem's SoA agents).
+ */
+class KATANACOMBAT_API FCombatSimCore
+{
+public:
+    FCombatSimConfig Config;
+
+    // ============================================================================
+    // SETUP
+    // ============================================================================
+
+    /** Add an attack to the timing table (returns its index) */
+    int32 AddAttack(const FCombatSimAttackTiming& Timing) { return Attacks.Add(Timing); }
+
+    /** Add a fighter at full posture (returns its index) */
+    int32 AddFighter();
+
+    int32 GetNumFighters() const { return Fighters.Num(); }
+    const FCombatSimFighter& GetFighter(int32 FighterIndex) const { return Fighters[FighterIndex]; }
+    const FCombatSimAttackTiming* GetAttackTiming(int32 AttackIndex) const { return Attacks.IsValidIndex(AttackIndex) ? &Attacks[AttackIndex] : nullptr; }
+
+    // ============================================================================
+    // INPUT (applied immediately, takes effect from the next step)
+    // ============================================================================
+
+    /**
+     * Start an attack, or buffer it as the combo follow-up if already attacking
+     * @return True if started or buffered
+     */
+    bool RequestAttack(int32 FighterIndex, int32 AttackIndex);
+
+    /** Press/release the attack input (holding during windup freezes the attack) */
+    void SetHoldRequested(int32 FighterIndex, bool bHold);
+
+    /** Enter or leave the blocking state */
+    bool SetBlocking(int32 FighterIndex, bool bBlock);
+
+    /**
+     * Deal posture damage (guard breaks at 0)
+     * @return True if this broke the fighter's guard
+     */
+    bool ApplyPostureDamage(int32 FighterIndex, float Amount);
+
+    // ============================================================================
+    // SIMULATION
+    // ============================================================================
+
+    /**
+     * Accumulate real time and run as many fixed steps as are due
+     * @return Number of steps run
+     */
+    int32 Advance(float DeltaTime);
+
+    /** Run exactly one fixed step */
+    void Step();
+
+    /** Events raised since the last ResetEvents */
+    const TArray<FCombatSimEvent>& GetEvents() const { return Events; }
+    void ResetEvents() { Events.Reset(); }
+
+    /** Steps run since construction */
+    uint64 GetStepCount() const { return StepCount; }
+
+    /** Hash of every fighter's state (determinism checks, desync detection) */
+    uint32 ComputeChecksum() const;
+
+    // ============================================================================
+    // SNAPSHOTS (rollback)
+    // ============================================================================
+
+    /**
+     * Copy every fighter's state into a snapshot
+     * @return False if there are more fighters than a snapshot holds
+     */
+    bool SaveSnapshot(FCombatSimSnapshot& OutSnapshot) const;
+
+    /** Put every fighter back as saved (fighter count must match; pending events are kept) */
+    void RestoreSnapshot(const FCombatSimSnapshot& Snapshot);
+
+    // ============================================================================
+    // SHARED RULES
+    // ============================================================================
+
+    /** Posture regained per second in a state */
+    static float GetPostureRegenRate(const FCombatSimConfig& InConfig, ECombatState State);
+
+    /** Posture after Elapsed seconds in State (no regen while guard broken, capped at max) */
+    static float EvaluatePosture(const FCombatSimConfig& InConfig, ECombatState State, float Posture, float Elapsed);
+
+    /**
+     * Advance an attack's phase timer, carrying overshoot into the next phase
+     * Windup -> Active -> Recovery -> None; at most one transition per call
+     * @return True if the phase changed
+     */
+    static bool AdvancePhase(EAttackPhase& Phase, float& PhaseRemaining, const FCombatSimAttackTiming& Timing, float DeltaTime);
+
+    // ============================================================================
+    // COOKING (UObject data -> plain tables)
+    // ============================================================================
+
+    /** Phase durations for an attack (notify timing, else legacy durations, else manual timing) */
+    static FCombatSimAttackTiming CookAttackTiming(const UAttackData* Attack);
+
+    /** Simulation tunables from combat settings (defaults if null) */
+    static FCombatSimConfig CookConfig(const UCombatSettings* Settings);
+
+private:
+    void StepFighter(int32 FighterIndex, float DeltaTime);
+    void StartAttack(int32 FighterIndex, int32 AttackIndex);
+    bool TrySetState(FCombatSimFighter& Fighter, ECombatState NewState);
+    void AddEvent(int32 FighterIndex, ECombatSimEventType Type, EAttackPhase Phase = EAttackPhase::None, int32 AttackIndex = INDEX_NONE);
+
+    TArray<FCombatSimAttackTiming> Attacks;
+    TArray<FCombatSimFighter> Fighters;
+    TArray<FCombatSimEvent> Events;
+
+    float Accumulator = 0.0f;
+    uint64 StepCount = 0;
+};
@@ -0,0 +1,153 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTypes.h"
+
+/**
+ * Extra condition a transition needs beyond being in the table
+ * Guarded transitions are never taken by CanTransition - only by code paths that satisfy the guard
+ */
+enum class ECombatTransitionGuard : uint8
+{
+    None,
+
+    /** Leaving Dead (respawn/reset paths only) */
+    Respawn
+};
+
+/**
+ * Compile-time combat state transition table
+ *
+ * Single source of truth for "can this state go to that state", shared by UCombatComponent
+ * (V1 and the V2 input gate) and the AI StateTree conditions. Each row is a bitmask of
+ * target states, so a check is one array load and a shift - no branching over ECombatState.
+ * Same-state transitions are never allowed.
+ */
+namespace CombatStateTransitions
+{
+    inline constexpr int32 NumStates = static_cast<int32>(ECombatState::Dead) + 1;
+    static_assert(NumStates <= 16, "Transition rows are uint16 bitmasks");
+
+    constexpr uint16 Bit(ECombatState State)
+    {
+        return static_cast<uint16>(1u << static_cast<uint8>(State));
+    }
+
+    struct FTable
+    {
+        /** Unguarded transitions, indexed [from] with one bit per target state */
+        uint16 Allowed[NumStates] = {};
+
+        /** Transitions that need a guard (not included in Allowed) */
+        uint16 Guarded[NumStates] = {};
+
+        /** Guard per [from][to] (None unless the bit is set in Guarded) */
+        ECombatTransitionGuard Guards[NumStates][NumStates] = {};
+
+        /** States that accept new combat input (V2 action queue gate) */
+        uint16 AcceptsInput = 0;
+    };
+
+    constexpr FTable BuildTable()
+    {
+        using S = ECombatState;
+        FTable Table;
+
+        auto Allow = [&Table](S From, uint16 ToMask)
+        {
+            Table.Allowed[static_cast<uint8>(From)] |= ToMask;
+        };
+        auto AllowGuarded = [&Table](S From, S To, ECombatTransitionGuard Guard)
+        {
+            Table.Guarded[static_cast<uint8>(From)] |= Bit(To);
+            Table.Guards[static_cast<uint8>(From)][static_cast<uint8>(To)] = Guard;
+        };
+
+        // From Idle, can transition to any action state
+        Allow(S::Idle, Bit(S::Attacking) | Bit(S::Blocking) | Bit(S::Evading) | Bit(S::HoldingLightAttack)
+            | Bit(S::ChargingHeavyAttack) | Bit(S::HitStunned) | Bit(S::GuardBroken) | Bit(S::Dead));
+
+        // From Attacking, can transition to hold states, hit reactions, or idle
+        Allow(S::Attacking, Bit(S::Idle) | Bit(S::HoldingLightAttack) | Bit(S::ChargingHeavyAttack)
+            | Bit(S::HitStunned) | Bit(S::GuardBroken) | Bit(S::Dead));
+
+        // From holding, can return to attacking or idle, or be interrupted
+        Allow(S::HoldingLightAttack, Bit(S::Attacking) | Bit(S::Idle) | Bit(S::HitStunned) | Bit(S::Dead));
+
+        // From charging, can release to attacking or be interrupted
+        Allow(S::ChargingHeavyAttack, Bit(S::Attacking) | Bit(S::Idle) | Bit(S::HitStunned) | Bit(S::Dead));
+
+        // From blocking, can parry, be guard broken, evade or return to idle
+        Allow(S::Blocking, Bit(S::Idle) | Bit(S::Parrying) | Bit(S::GuardBroken) | Bit(S::HitStunned)
+            | Bit(S::Evading) | Bit(S::Dead));
+
+        // From parrying, return to idle or counter attack
+        Allow(S::Parrying, Bit(S::Idle) | Bit(S::Attacking) | Bit(S::Dead));
+
+        // From guard broken, recover to idle, be finished or die
+        Allow(S::GuardBroken, Bit(S::Idle) | Bit(S::Finishing) | Bit(S::Dead));
+
+        // From finishing, return to idle or die
+        Allow(S::Finishing, Bit(S::Idle) | Bit(S::Dead));
+
+        // From hit stun, recover to idle, be guard broken or die
+        Allow(S::HitStunned, Bit(S::Idle) | Bit(S::GuardBroken) | Bit(S::Dead));
+
+        // From evading, return to idle or attack
+        Allow(S::Evading, Bit(S::Idle) | Bit(S::Attacking) | Bit(S::Dead));
+
+        // Dead is terminal - only an explicit respawn resets it
+        AllowGuarded(S::Dead, S::Idle, ECombatTransitionGuard::Respawn);
+
+        // Same-state transitions are never allowed
+        for (int32 State = 0; State < NumStates; ++State)
+        {
+            Table.Allowed[State] &= ~static_cast<uint16>(1u << State);
+        }
+
+        // Locked out of new input while dead, stunned or guard broken
+        Table.AcceptsInput = static_cast<uint16>(((1u << NumStates) - 1) & ~(Bit(S::Dead) | Bit(S::HitStunned) | Bit(S::GuardBroken)));
+
+        return Table;
+    }
+
+    inline constexpr FTable Table = BuildTable();
+
+    /** Can From go to To without a guard? (one lookup) */
+    constexpr bool CanTransition(ECombatState From, ECombatState To)
+    {
+        return (Table.Allowed[static_cast<uint8>(From)] >> static_cast<uint8>(To)) & 1u;
+    }
+
+    /** Guard required for From -> To (None if unguarded or not in the table) */
+    constexpr ECombatTransitionGuard GetGuard(ECombatState From, ECombatState To)
+    {
+        return Table.Guards[static_cast<uint8>(From)][static_cast<uint8>(To)];
+    }
+
+    /** Can From go to To once Guard has been satisfied? */
+    constexpr bool CanTransitionGuarded(ECombatState From, ECombatState To, ECombatTransitionGuard Guard)
+    {
+        return CanTransition(From, To)
+            || (((Table.Guarded[static_cast<uint8>(From)] >> static_cast<uint8>(To)) & 1u) && GetGuard(From, To) == Guard);
+    }
+
+    /** Target states reachable from From without a guard */
+    constexpr uint16 GetAllowedMask(ECombatState From)
+    {
+        return Table.Allowed[static_cast<uint8>(From)];
+    }
+
+    /** Does this state accept new combat input? */
+    constexpr bool AcceptsInput(ECombatState State)
+    {
+        return (Table.AcceptsInput >> static_cast<uint8>(State)) & 1u;
+    }
+
+    static_assert(CanTransition(ECombatState::Idle, ECombatState::Attacking), "Idle must reach Attacking");
+    static_assert(!CanTransition(ECombatState::Dead, ECombatState::Idle), "Dead only leaves through the respawn guard");
+    static_assert(CanTransitionGuarded(ECombatState::Dead, ECombatState::Idle, ECombatTransitionGuard::Respawn), "Respawn resets Dead");
+    static_assert(!CanTransition(ECombatState::HitStunned, ECombatState::HitStunned), "No same-state transitions");
+}
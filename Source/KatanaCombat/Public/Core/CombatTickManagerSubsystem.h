@@ -0,0 +1,99 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTickManagerSubsystem.generated.h"
+
+class UCombatComponent;
+
+/**
+ * Per-character snapshot gathered on the game thread (plain data - safe to read from workers)
+ */
+struct FCombatTickInput
+{
+    float Posture = 0.0f;
+    float MaxPosture = 0.0f;
+
+    /** Posture regained per second in the current state (0 = no per-frame regen) */
+    float PostureRegenRate = 0.0f;
+};
+
+/**
+ * Evaluated per-character result, written back serially
+ */
+struct FCombatTickOutput
+{
+    float Posture = 0.0f;
+    bool bPostureChanged = false;
+};
+
+/**
+ * Batched combat component tick
+ *
+ * Components whose settings enable bBatchedCombatTick register here at BeginPlay and stop
+ * ticking themselves. Each frame the manager:
+ * 1. Gathers every registered component's per-frame state (game thread)
+ * 2. Evaluates posture regen for all of them as parallel tasks (ParallelFor,
+ *    single-threaded below MinParallelBatch where task overhead would dominate)
+ * 3. Writes results back one component at a time (game thread), so posture changes and any
+ *    delegates they trigger run serially exactly as the component tick would
+ *
+ * Per-frame combat cost then scales across worker threads instead of with character count.
+ * Montage plays, easing and timers stay event-driven (UPlayRateEasingSubsystem,
+ * UCombatTimerWheelSubsystem) and are never touched from worker threads.
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatTickManagerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    /** Below this many components evaluation stays on the game thread */
+    int32 MinParallelBatch = 32;
+
+    // ============================================================================
+    // REGISTRATION
+    // ============================================================================
+
+    /** Tick this component from the batch (no-op if already registered) */
+    void RegisterCombatComponent(UCombatComponent* CombatComponent);
+
+    /** Stop batching a combat component */
+    void UnregisterCombatComponent(UCombatComponent* CombatComponent);
+
+    /** Number of registered components (including ones destroyed since the last tick) */
+    int32 GetNumRegistered() const { return Components.Num(); }
+
+    // ============================================================================
+    // EVALUATION
+    // ============================================================================
+
+    /** Pure per-character evaluation (what each parallel task runs) */
+    static void Evaluate(const FCombatTickInput& Input, float DeltaTime, FCombatTickOutput& Output);
+
+    /**
+     * Evaluate a whole batch, in parallel when large enough
+     * @param Inputs - Gathered snapshots
+     * @param OutOutputs - One result per input (resized to match)
+     */
+    static void EvaluateBatch(TConstArrayView<FCombatTickInput> Inputs, float DeltaTime, TArray<FCombatTickOutput>& OutOutputs, int32 MinParallelBatch);
+
+private:
+    TArray<TWeakObjectPtr<UCombatComponent>> Components;
+
+    /** Per-frame scratch (parallel to the live components gathered this frame) */
+    TArray<UCombatComponent*> Gathered;
+    TArray<FCombatTickInput> Inputs;
+    TArray<FCombatTickOutput> Outputs;
+};
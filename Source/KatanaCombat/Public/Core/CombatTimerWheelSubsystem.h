@@ -0,0 +1,187 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "CombatTimerWheelSubsystem.generated.h"
+
+class UCombatTimerWheelSubsystem;
+
+/**
+ * Handle to a combat timer (Index INDEX_NONE = none)
+ * The serial goes stale when the timer fires or is cleared, so old handles never alias new timers
+ */
+struct FCombatTimerHandle
+{
+    int32 Index = INDEX_NONE;
+    uint32 Serial = 0;
+
+    bool IsValid() const { return Index != INDEX_NONE; }
+    void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+/**
+ * Drains the timer wheel at a fixed point in the frame (TG_PrePhysics)
+ */
+USTRUCT()
+struct FCombatTimerWheelTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    UCombatTimerWheelSubsystem* Target = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FCombatTimerWheelTickFunction> : public TStructOpsTypeTraitsBase2<FCombatTimerWheelTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+/**
+ * Hierarchical timer wheel for short-lived combat timers (combo/parry/counter/hold windows,
+ * evade and recovery timeouts, hitstun)
+ *
+ * Replaces FTimerManager for per-character combat timers. Timers are nodes in a pooled array
+ * linked into wheel slots by index, scheduled at a fixed resolution (1/120 s):
+ * - Level 0 covers the next 64 ticks one slot per tick; each higher level covers 64x more and
+ *   cascades down into the level below as the wheel turns
+ * - Set/clear are O(1) and allocation-free once the pool has grown to the peak timer count
+ * - Callbacks are a weak object + a compile-time member function thunk, so there are no
+ *   delegate or lambda allocations
+ *
+ * The wheel is drained once per frame in TG_PrePhysics with the world delta time (paused
+ * worlds don't advance, matching FTimerManager). Timers may fire up to one resolution step late.
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatTimerWheelSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    /** Seconds per wheel tick */
+    static constexpr float Resolution = 1.0f / 120.0f;
+
+    /**
+     * Advance the wheel by DeltaTime, firing every timer that expires (called by the tick function)
+     * @param DeltaTime - World seconds since the last advance
+     */
+    void Advance(float DeltaTime);
+
+    // ============================================================================
+    // TIMERS
+    // ============================================================================
+
+    /**
+     * Schedule Method on Object after Delay, replacing the timer InOutHandle refers to
+     * Usage: SetTimer<&UMyComponent::OnTimeout>(TimeoutTimer, this, 0.5f);
+     * @param InOutHandle - Timer to replace; receives the new handle
+     * @param Object - Callback target (held weakly - the timer is skipped if it's gone)
+     * @param Delay - Seconds until the callback (rounded up to the wheel resolution, at least one tick)
+     */
+    template<auto Method, typename T>
+    void SetTimer(FCombatTimerHandle& InOutHandle, T* Object, float Delay)
+    {
+        ClearTimer(InOutHandle);
+        InOutHandle = Schedule(Object, &Invoke<T, Method>, Delay);
+    }
+
+    /**
+     * Cancel a timer without firing it
+     * @param InOutHandle - Timer to cancel (invalidated on return)
+     * @return True if a pending timer was cancelled
+     */
+    bool ClearTimer(FCombatTimerHandle& InOutHandle);
+
+    /** Is this timer still pending? */
+    bool IsTimerActive(const FCombatTimerHandle& Handle) const;
+
+    /** Seconds until the timer fires (0 if not pending) */
+    float GetTimerRemaining(const FCombatTimerHandle& Handle) const;
+
+    /** Number of pending timers */
+    int32 GetNumActiveTimers() const { return NumActiveTimers; }
+
+private:
+    /** Type-erased callback: casts the object back and calls the member function */
+    using FTimerThunk = void (*)(UObject*);
+
+    template<typename T, auto Method>
+    static void Invoke(UObject* Object)
+    {
+        (static_cast<T*>(Object)->*Method)();
+    }
+
+    FCombatTimerHandle Schedule(UObject* Object, FTimerThunk Thunk, float Delay);
+
+    // ============================================================================
+    // WHEEL
+    // ============================================================================
+
+    static constexpr int32 SlotBits = 6;
+    static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+    static constexpr int32 SlotMask = SlotsPerLevel - 1;
+    static constexpr int32 NumLevels = 4;
+
+    /** List id of the slot currently being fired (outside the wheel, so callbacks can clear its timers) */
+    static constexpr int32 FiringList = NumLevels * SlotsPerLevel;
+
+    struct FTimerNode
+    {
+        TWeakObjectPtr<UObject> Object;
+        FTimerThunk Thunk = nullptr;
+        uint64 ExpireTick = 0;
+        uint32 Serial = 1;
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+
+        /** Slot list this node is linked into (INDEX_NONE = free) */
+        int32 List = INDEX_NONE;
+    };
+
+    /** Link a node into the slot matching its expiry */
+    void InsertNode(int32 NodeIndex);
+
+    void LinkNode(int32 NodeIndex, int32 List);
+    void UnlinkNode(int32 NodeIndex);
+
+    /** Return a node to the pool (bumps its serial so handles go stale) */
+    void FreeNode(int32 NodeIndex);
+
+    /** Re-insert every timer of a higher-level slot into the levels below */
+    void Cascade(int32 Level);
+
+    /** Advance one wheel tick and fire the timers that expire on it */
+    void Step();
+
+    const FTimerNode* FindNode(const FCombatTimerHandle& Handle) const;
+
+    /** Pooled timer nodes (never shrinks - free nodes are chained through Next) */
+    TArray<FTimerNode> Nodes;
+    int32 FreeHead = INDEX_NONE;
+
+    /** Head node of each slot list, plus the firing list */
+    int32 ListHeads[NumLevels * SlotsPerLevel + 1];
+
+    /** Wheel ticks elapsed since the world started */
+    uint64 CurrentTick = 0;
+
+    /** Seconds carried over into the next tick */
+    float Accumulator = 0.0f;
+
+    int32 NumActiveTimers = 0;
+
+    FCombatTimerWheelTickFunction TickFunction;
+};
@@ -0,0 +1,149 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CombatUIEventSubsystem.generated.h"
+
+class UCombatComponent;
+
+/**
+ * One coalesced UI update for an actor (at most one per actor per frame)
+ */
+USTRUCT(BlueprintType)
+struct KATANACOMBAT_API FCombatUIUpdate
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat|UI")
+    TObjectPtr<AActor> Actor = nullptr;
+
+    /** Posture percent (0-1), quantized to the bus step */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat|UI")
+    float PosturePercent = 1.0f;
+
+    /** Health percent (0-1), quantized to the bus step */
+    UPROPERTY(BlueprintReadOnly, Category = "Combat|UI")
+    float HealthPercent = 1.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat|UI")
+    bool bStunned = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat|UI")
+    bool bPostureChanged = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat|UI")
+    bool bHealthChanged = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Combat|UI")
+    bool bStunChanged = false;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCombatUIUpdate, const FCombatUIUpdate&, Update);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCombatUIUpdateNative, const FCombatUIUpdate&);
+
+/**
+ * Throttled, coalescing event bus for combat UI (posture, health and stun bars)
+ *
+ * Gameplay delegates (OnPostureChanged, OnStunBegin, ...) fire on every change, so a widget bound
+ * to them redraws on each one. The bus instead merges everything that happened to an actor during
+ * a frame and emits at most one FCombatUIUpdate for it at the end of the frame, and only when a
+ * value moved by at least one QuantizationStep (default 1%).
+ *
+ * - Posture is sampled once per frame from registered combat components (regen is analytic in
+ *   event-driven mode and never broadcasts, so there is nothing to subscribe to)
+ * - Health and stun are pushed by their owners (NotifyHealthChanged / NotifyStunChanged)
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatUIEventSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    // ============================================================================
+    // CONFIGURATION
+    // ============================================================================
+
+    /** Percent values are snapped to multiples of this before comparing (0 = emit any change) */
+    float QuantizationStep = 0.01f;
+
+    /** Minimum time between two updates for the same actor (seconds, 0 = once per frame). Stun changes are never delayed */
+    float MinUpdateInterval = 0.0f;
+
+    // ============================================================================
+    // SOURCES
+    // ============================================================================
+
+    /** Sample this component's posture every frame (no-op if already registered) */
+    void RegisterCombatComponent(UCombatComponent* CombatComponent);
+
+    /** Stop sampling a combat component's posture */
+    void UnregisterCombatComponent(UCombatComponent* CombatComponent);
+
+    /** Record a health change (merged with anything else this frame) */
+    void NotifyHealthChanged(AActor* Actor, float HealthPercent);
+
+    /** Record a stun begin/end (merged with anything else this frame) */
+    void NotifyStunChanged(AActor* Actor, bool bStunned);
+
+    /** Forget an actor's last emitted values (call when the actor is destroyed or pooled) */
+    void RemoveActor(AActor* Actor);
+
+    // ============================================================================
+    // EVENTS
+    // ============================================================================
+
+    /** One update per changed actor per frame */
+    UPROPERTY(BlueprintAssignable, Category = "Combat|UI")
+    FOnCombatUIUpdate OnCombatUIUpdate;
+
+    /** Native version of OnCombatUIUpdate for C++/Slate listeners */
+    FOnCombatUIUpdateNative OnCombatUIUpdateNative;
+
+    /** Flush pending changes now instead of waiting for Tick */
+    void Flush();
+
+    /** Snap a percent to QuantizationStep */
+    float Quantize(float Percent) const;
+
+private:
+    /** Last emitted and pending state for one actor */
+    struct FActorUIState
+    {
+        FObjectKey Key;
+        TWeakObjectPtr<AActor> Actor;
+        TWeakObjectPtr<UCombatComponent> CombatComponent;
+
+        float EmittedPosture = -1.0f;
+        float EmittedHealth = -1.0f;
+        bool bEmittedStunned = false;
+
+        float PendingPosture = -1.0f;
+        float PendingHealth = -1.0f;
+        bool bPendingStunned = false;
+        bool bStunDirty = false;
+
+        double LastEmitTime = TNumericLimits<double>::Lowest();
+    };
+
+    FActorUIState& FindOrAddState(AActor* Actor);
+
+    /** Actor -> index into States */
+    TMap<FObjectKey, int32> StateIndices;
+
+    /** Per-actor state (swap-removed) */
+    TArray<FActorUIState> States;
+
+    void RemoveStateAt(int32 Index);
+};
@@ -0,0 +1,130 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/ObjectKey.h"
+#include "ComboPreloadSubsystem.generated.h"
+
+class UAttackData;
+class UAttackConfiguration;
+
+/** Broadcast when a requester's combo window finished streaming (compiled combo graphs should rebuild) */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnComboChainPreloaded, const UObject* /*Requester*/);
+
+/**
+ * Streams soft-linked combo chains ahead of use
+ * 
+ * Each requester (usually a combat component) keeps one preload window: its root attacks plus
+ * every node reachable within PreloadDepth combo links. Soft links in the window are requested
+ * through one FStreamableManager handle; hard links are walked but cost nothing extra. Moving the
+ * window (new current attack) swaps in a new handle and releases the old one, so nodes that fell
+ * out of reach become collectable again. Nodes behind a soft link that is still loading are
+ * discovered once it arrives, then the window is requested again.
+ */
+UCLASS()
+class KATANACOMBAT_API UComboPreloadSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+
+    // ============================================================================
+    // PRELOADING
+    // ============================================================================
+
+    /**
+     * Move the requester's preload window
+     * @param Requester - Owner of the window (one window per requester)
+     * @param Roots - Attacks the window starts from (defaults + current attack); nullptrs are ignored
+     * @param PreloadDepth - Combo links to follow from the roots (0 = release the window)
+     */
+    void PreloadChain(const UObject* Requester, TConstArrayView<const UAttackData*> Roots, int32 PreloadDepth);
+
+    /** Release the requester's window (streamed nodes become collectable) */
+    void ReleaseChain(const UObject* Requester);
+
+    /** Is any soft link in the requester's window still loading? */
+    bool IsChainLoading(const UObject* Requester) const;
+
+    /**
+     * Soft paths reachable from the roots within Depth links (loaded or not)
+     * Walks through hard links and loaded soft links; stops at unloaded soft links
+     * @param bOutHasUnloaded - Set when the walk stopped at an unloaded soft link
+     */
+    static void GatherChainPaths(TConstArrayView<const UAttackData*> Roots, int32 Depth, TArray<FSoftObjectPath>& OutPaths, bool& bOutHasUnloaded);
+
+    /** Fired after a requester's window finished loading */
+    FOnComboChainPreloaded OnChainPreloaded;
+
+    // ============================================================================
+    // MOVESET BUNDLES
+    // ============================================================================
+
+    /**
+     * Keep exactly these asset bundles of a moveset loaded (e.g. Core in exploration, Core + Extended in combat)
+     * Goes through UAssetManager when the configuration is a registered primary asset (cooked bundle data),
+     * otherwise streams the bundles walked from the loaded moveset (UAttackConfiguration::GatherBundlePaths)
+     * OnChainPreloaded fires with the configuration as requester once the bundles are in
+     * @param Configuration - Moveset to load
+     * @param Bundles - Bundles to keep (empty = release the moveset)
+     */
+    void PreloadMoveset(const UAttackConfiguration* Configuration, TConstArrayView<FName> Bundles);
+
+    /** Release every bundle of a moveset (its soft links become collectable) */
+    void ReleaseMoveset(const UAttackConfiguration* Configuration);
+
+    /** Bundles currently requested for a moveset (empty if none) */
+    TConstArrayView<FName> GetMovesetBundles(const UAttackConfiguration* Configuration) const;
+
+    /** Is any bundle of the moveset still loading? */
+    bool IsMovesetLoading(const UAttackConfiguration* Configuration) const;
+
+private:
+    /** One requester's preload window */
+    struct FComboPreloadWindow
+    {
+        TArray<TWeakObjectPtr<const UAttackData>> Roots;
+        int32 Depth = 0;
+        TSharedPtr<FStreamableHandle> Handle;
+    };
+
+    /** Request every soft path of the window (replaces the window's previous handle) */
+    void RequestWindow(FObjectKey RequesterKey, FComboPreloadWindow& Window);
+
+    /** Streamable completion - walk behind newly loaded links, then notify */
+    void OnWindowLoaded(FObjectKey RequesterKey);
+
+    /** One moveset's requested bundles */
+    struct FMovesetBundleRequest
+    {
+        TWeakObjectPtr<const UAttackConfiguration> Configuration;
+        TArray<FName> Bundles;
+        TSharedPtr<FStreamableHandle> Handle;
+
+        /** Bundle state lives in the Asset Manager (registered primary asset) */
+        bool bUsesAssetManager = false;
+    };
+
+    /** Request the moveset's bundles (replaces the request's previous handle) */
+    void RequestMoveset(FObjectKey ConfigurationKey, FMovesetBundleRequest& Request);
+
+    /** Streamable completion - walk behind newly loaded links, then notify */
+    void OnMovesetLoaded(FObjectKey ConfigurationKey);
+
+    /** Soft paths of every requested bundle, walked from the loaded moveset */
+    static void GatherMovesetPaths(const FMovesetBundleRequest& Request, TArray<FSoftObjectPath>& OutPaths);
+
+    FStreamableManager StreamableManager;
+
+    TMap<FObjectKey, FComboPreloadWindow> Windows;
+
+    TMap<FObjectKey, FMovesetBundleRequest> Movesets;
+};
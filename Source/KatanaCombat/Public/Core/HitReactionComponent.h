@@ -5,11 +5,104 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "CombatTypes.h"
+#include "Core/CombatTimerWheelSubsystem.h"
 #include "HitReactionComponent.generated.h"
 
 class UAnimMontage;
 class ACharacter;
 class UAnimInstance;
+class UCombatArchetype;
+class UCombatComponent;
+struct FStreamableHandle;
+
+/**
+ * Hit reactions baked for lookup: flat [State][Severity][Direction] montages and interned finishers
+ * Built per component from its own sets, or once per UCombatArchetype and shared
+ */
+USTRUCT()
+struct KATANACOMBAT_API FHitReactionTable
+{
+    GENERATED_BODY()
+
+    static constexpr int32 NumSeverityBuckets = 2;  // Light, Heavy
+    static constexpr int32 NumDirectionBuckets = 4; // Forward, Backward, Left, Right
+    static constexpr int32 NumStateBuckets = 2;     // Standing, Stunned
+
+    /** Flat reaction montages indexed by GetReactionIndex (state, severity, direction) */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UAnimMontage>> Reactions;
+
+    /** Interned finisher names (index = finisher id) */
+    TArray<FName> FinisherIds;
+
+    /** Finisher victim montages (parallel to FinisherIds, streamed on demand) */
+    UPROPERTY(Transient)
+    TArray<TSoftObjectPtr<UAnimMontage>> FinisherMontages;
+
+    /** Bake the table (stunned slots fall back to the standing montage) */
+    void Build(const FHitReactionAnimSet& Light, const FHitReactionAnimSet& Heavy, const FHitReactionAnimSet& Stunned, const TMap<FName, TSoftObjectPtr<UAnimMontage>>& Finishers);
+
+    /** Drop the baked data */
+    void Reset();
+
+    bool IsBuilt() const { return Reactions.Num() > 0; }
+
+    /** Heap bytes held by the table */
+    SIZE_T GetAllocatedSize() const { return Reactions.GetAllocatedSize() + FinisherIds.GetAllocatedSize() + FinisherMontages.GetAllocatedSize(); }
+
+    /** Reaction montage for a hit (nullptr if unset) */
+    UAnimMontage* GetReaction(bool bStunned, bool bHeavy, EAttackDirection Direction) const;
+
+    /** Finisher name to id (INDEX_NONE if unknown) - FName compare is an index compare, no hashing */
+    int32 FindFinisherId(FName FinisherName) const { return FinisherIds.IndexOfByKey(FinisherName); }
+
+    /**
+     * Flat reaction table index
+     * @param bStunned - Hit landed during hitstun
+     * @param bHeavy - Stun duration above the heavy threshold
+     * @param Direction - Hit direction relative to facing
+     */
+    static int32 GetReactionIndex(bool bStunned, bool bHeavy, EAttackDirection Direction);
+};
+
+/**
+ * Every hit a target took in one frame, merged (see UCombatDamageAggregatorSubsystem)
+ */
+USTRUCT(BlueprintType)
+struct KATANACOMBAT_API FCombatHitAggregate
+{
+    GENERATED_BODY()
+
+    /** Most severe hit of the frame (longest stun, then most damage) - drives the one reaction played */
+    UPROPERTY(BlueprintReadOnly, Category = "Hit Reaction")
+    FHitReactionInfo StrongestHit;
+
+    /** Damage of every hit that got through, as sent by the attackers */
+    UPROPERTY(BlueprintReadOnly, Category = "Hit Reaction")
+    float TotalDamage = 0.0f;
+
+    /** Posture damage of every blocked hit (already applied when the hit landed) */
+    UPROPERTY(BlueprintReadOnly, Category = "Hit Reaction")
+    float TotalPostureDamage = 0.0f;
+
+    /** Hits that got through */
+    UPROPERTY(BlueprintReadOnly, Category = "Hit Reaction")
+    int32 NumHits = 0;
+
+    /** Hits taken on the guard */
+    UPROPERTY(BlueprintReadOnly, Category = "Hit Reaction")
+    int32 NumBlockedHits = 0;
+
+    bool IsEmpty() const { return NumHits == 0 && NumBlockedHits == 0; }
+
+    /** Add a hit that got through */
+    void AddHit(const FHitReactionInfo& HitInfo);
+
+    /** Add a hit taken on the guard */
+    void AddBlockedHit(const FHitReactionInfo& HitInfo, float PostureDamage);
+
+    void Reset() { *this = FCombatHitAggregate(); }
+};
 
 /**
  * Handles receiving damage, playing hit reactions, and managing stun states
@@ -34,11 +127,10 @@ class KATANACOMBAT_API UHitReactionComponent : public UActorComponent
 public:
     UHitReactionComponent();
 
-    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-
     // ============================================================================
     // CONFIGURATION - HIT REACTION ANIMATIONS
     // ============================================================================
+    // Per-instance sets below are only used when no archetype is set (see SetArchetype)
 
     /** Light hit reactions (minimal stagger) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions|Light")
@@ -48,13 +140,54 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions|Heavy")
     FHitReactionAnimSet HeavyHitReactions;
 
-    /** Guard broken animation (posture depleted) */
+    /** Hits landing while already stunned (empty slots fall back to the light/heavy set) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions|Stunned")
+    FHitReactionAnimSet StunnedHitReactions;
+
+    /** Stun duration above which a hit uses the heavy reaction bucket */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions", meta = (ClampMin = "0.0"))
+    float HeavyHitStunThreshold = 0.3f;
+
+    /**
+     * Low-significance actors flinch procedurally instead of playing a full-body montage
+     * (medium-significance ones too while UCombatBudgetSubsystem has anim quality reduced)
+     * The anim instance exposes GetFlinchAlpha/GetFlinchDirection for an additive layer, so the
+     * montage slot is never interrupted and multi-target hits cost no montage evaluations
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions|Flinch")
+    bool bUseProceduralFlinch = true;
+
+    /** How long a procedural flinch takes to decay (seconds) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions|Flinch", meta = (ClampMin = "0.01", EditCondition = "bUseProceduralFlinch"))
+    float FlinchDuration = 0.25f;
+
+    /** Peak flinch alpha for light hits (heavy hits peak at 1) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions|Flinch", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bUseProceduralFlinch"))
+    float LightFlinchIntensity = 0.5f;
+
+    /** Guard broken animation (posture depleted, streamed with the finishers) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions")
-    TObjectPtr<UAnimMontage> GuardBrokenMontage = nullptr;
+    TSoftObjectPtr<UAnimMontage> GuardBrokenMontage;
 
-    /** Finisher victim animations (paired with attacker finisher) */
+    /** Finisher victim animations (paired with attacker finisher, streamed on demand) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions|Finishers")
-    TMap<FName, TObjectPtr<UAnimMontage>> FinisherVictimAnimations;
+    TMap<FName, TSoftObjectPtr<UAnimMontage>> FinisherVictimAnimations;
+
+    /**
+     * Stream the guard broken and finisher montages only while they're likely to play
+     * Loading starts once posture drops below FinisherStreamingPostureThreshold and the assets are released
+     * FinisherReleaseDelay after it recovers; off = load them on BeginPlay and keep them for the component's lifetime
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions|Finishers")
+    bool bStreamFinisherAssets = true;
+
+    /** Posture percent (0-1) below which the finisher assets start streaming in */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions|Finishers", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bStreamFinisherAssets"))
+    float FinisherStreamingPostureThreshold = 0.3f;
+
+    /** Time posture must stay above the threshold before the finisher assets are released (seconds) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Reactions|Finishers", meta = (ClampMin = "0.0", EditCondition = "bStreamFinisherAssets"))
+    float FinisherReleaseDelay = 10.0f;
 
     // ============================================================================
     // CONFIGURATION - DAMAGE MODIFIERS
@@ -73,6 +206,14 @@ public:
         meta = (ClampMin = "0.0", ClampMax = "1.0"))
     float DamageResistance = 1.0f;
 
+    /**
+     * Merge every hit taken in a frame into one damage event and one reaction (the most severe hit)
+     * Multi-hit frames (cleaves, several attackers) otherwise restart the reaction montage per hit
+     * Damage is still returned per hit; events and the reaction follow at the end of the frame
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage Modifiers")
+    bool bAggregateHitsPerFrame = true;
+
     // ============================================================================
     // DAMAGE APPLICATION
     // ============================================================================
@@ -85,6 +226,22 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Hit Reaction")
     float ApplyDamage(const FHitReactionInfo& HitInfo);
 
+    /**
+     * Record a hit taken on the guard (posture already applied) in this frame's aggregate
+     * @param HitInfo - Blocked hit
+     * @param PostureDamage - Posture damage the block cost
+     */
+    void RecordBlockedHit(const FHitReactionInfo& HitInfo, float PostureDamage);
+
+    /**
+     * Broadcast this frame's hits and play the strongest reaction now
+     * Run by UCombatDamageAggregatorSubsystem at the end of the frame - no-op without pending hits
+     */
+    void FlushPendingHits();
+
+    /** Hits waiting for this frame's flush */
+    const FCombatHitAggregate& GetPendingHits() const { return PendingHits; }
+
     /**
      * Play appropriate hit reaction based on hit direction and intensity
      * Automatically selects correct animation from configured sets
@@ -114,6 +271,63 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Hit Reaction")
     bool PlayFinisherVictimAnimation(FName FinisherName);
 
+    /**
+     * Play finisher victim animation by interned id (see FindFinisherId)
+     * @param FinisherId - Id resolved from the finisher name
+     * @return True if animation was found and played
+     */
+    bool PlayFinisherVictimAnimationById(int32 FinisherId);
+
+    /**
+     * Resolve a finisher name to its interned id (stable until the next RebuildReactionTable)
+     * @param FinisherName - Key in FinisherVictimAnimations
+     * @return Finisher id, or INDEX_NONE if unknown
+     */
+    int32 FindFinisherId(FName FinisherName) const;
+
+    /**
+     * Rebuild the flat reaction table and finisher ids from the configured sets
+     * Called on BeginPlay - call again after changing reaction sets at runtime
+     * No-op with an archetype (its shared table is used instead)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Hit Reaction")
+    void RebuildReactionTable();
+
+    // ============================================================================
+    // ARCHETYPE
+    // ============================================================================
+
+    /**
+     * Read reaction configuration from a shared archetype instead of this component's properties
+     * @param InArchetype - Shared archetype (nullptr = use per-instance properties)
+     */
+    void SetArchetype(const UCombatArchetype* InArchetype);
+
+    /** Shared archetype (nullptr if configured per instance) */
+    const UCombatArchetype* GetArchetype() const { return Archetype; }
+
+    /** Guard broken montage (archetype or per-instance; nullptr until streamed in) */
+    UAnimMontage* GetGuardBrokenMontage() const;
+
+    // ============================================================================
+    // FINISHER STREAMING
+    // ============================================================================
+
+    /** Start streaming the guard broken and finisher montages (no-op if already requested) */
+    void RequestFinisherAssets();
+
+    /** Drop the streaming request (assets become collectable unless something else holds them) */
+    void ReleaseFinisherAssets();
+
+    /** Have the finisher assets been requested (loading or loaded)? */
+    bool AreFinisherAssetsRequested() const;
+
+    /** Are the requested finisher assets still loading? */
+    bool AreFinisherAssetsLoading() const;
+
+    /** Heavy reaction stun threshold (archetype or per-instance) */
+    float GetHeavyHitStunThreshold() const;
+
     // ============================================================================
     // STATE QUERIES
     // ============================================================================
@@ -126,11 +340,29 @@ public:
     bool IsStunned() const { return bIsStunned; }
 
     /**
-     * Get remaining stun time
+     * Get remaining stun time (derived from the scheduled stun end time)
      * @return Seconds of stun remaining
      */
     UFUNCTION(BlueprintPure, Category = "Hit Reaction")
-    float GetRemainingStunTime() const { return StunTimeRemaining; }
+    float GetRemainingStunTime() const;
+
+    /**
+     * Get world time the current stun ends
+     * @return Stun end time in world seconds (0 if not stunned)
+     */
+    UFUNCTION(BlueprintPure, Category = "Hit Reaction")
+    float GetStunEndTime() const { return bIsStunned ? StunEndTime : 0.0f; }
+
+    /**
+     * Current procedural flinch weight (peaks on hit, eases out over FlinchDuration)
+     * @return Additive flinch alpha (0 when not flinching)
+     */
+    UFUNCTION(BlueprintPure, Category = "Hit Reaction")
+    float GetFlinchAlpha() const;
+
+    /** Direction of the most recent procedural flinch */
+    UFUNCTION(BlueprintPure, Category = "Hit Reaction")
+    EAttackDirection GetFlinchDirection() const { return FlinchDirection; }
 
     /**
      * Can be damaged right now?
@@ -150,6 +382,14 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Hit Reaction")
     FOnDamageReceived OnDamageReceived;
 
+    /** Native version of OnDamageReceived for C++ listeners */
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnDamageReceivedNative, const FHitReactionInfo& /*HitInfo*/);
+    FOnDamageReceivedNative OnDamageReceivedNative;
+
+    /** Once per frame with every hit taken in it (also fires for blocked-only frames) */
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnHitsAggregatedNative, const FCombatHitAggregate& /*Hits*/);
+    FOnHitsAggregatedNative OnHitsAggregatedNative;
+
     /** Event called when hit reaction starts playing */
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHitReactionStarted, EAttackDirection, Direction, bool, bIsHeavyHit);
 
@@ -168,8 +408,12 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Hit Reaction")
     FOnStunEnd OnStunEnd;
 
+    /** Adds the local reaction table (Combat.DumpMemory, memreport) */
+    virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
     // ============================================================================
@@ -180,9 +424,29 @@ private:
     UPROPERTY(VisibleAnywhere, Category = "Hit Reaction")
     bool bIsStunned = false;
 
-    /** Remaining stun time (seconds) */
+    /** World time the current stun ends (seconds) */
     UPROPERTY(VisibleAnywhere, Category = "Hit Reaction")
-    float StunTimeRemaining = 0.0f;
+    float StunEndTime = 0.0f;
+
+    /** Fires EndStun at StunEndTime on the combat timer wheel (no per-frame tick) */
+    FCombatTimerHandle StunTimer;
+
+    /** World time the last procedural flinch started (negative = never) */
+    float FlinchStartTime = -1.0f;
+
+    /** Peak alpha of the last procedural flinch */
+    float FlinchIntensity = 0.0f;
+
+    EAttackDirection FlinchDirection = EAttackDirection::None;
+
+    /** Hits taken since the last flush */
+    FCombatHitAggregate PendingHits;
+
+    /** Queue this component with the aggregator (false = no aggregator, flush immediately) */
+    bool QueuePendingFlush();
+
+    /** Publish a damage event to the combat event dispatcher */
+    void PublishDamageEvent(const FHitReactionInfo& HitInfo);
 
     // ============================================================================
     // CACHED REFERENCES
@@ -196,6 +460,44 @@ private:
     UPROPERTY()
     TObjectPtr<UAnimInstance> AnimInstance;
 
+    // ============================================================================
+    // REACTION TABLE
+    // ============================================================================
+
+    /** Shared configuration (reactions, finishers and thresholds come from here when set) */
+    UPROPERTY(Transient)
+    TObjectPtr<const UCombatArchetype> Archetype;
+
+    /** Table baked from the per-instance sets (empty with an archetype) */
+    UPROPERTY(Transient)
+    FHitReactionTable LocalReactionTable;
+
+    /** Archetype's shared table, or the local one */
+    const FHitReactionTable& GetReactionTable() const;
+
+    // ============================================================================
+    // FINISHER STREAMING
+    // ============================================================================
+
+    /** Owner's combat component (posture source for streaming) */
+    UPROPERTY(Transient)
+    TObjectPtr<UCombatComponent> OwnerCombat;
+
+    /** Keeps the guard broken and finisher montages resident while valid */
+    TSharedPtr<FStreamableHandle> FinisherAssetsHandle;
+
+    /** Fires ReleaseFinisherAssets once posture has stayed above the threshold for FinisherReleaseDelay */
+    FCombatTimerHandle FinisherReleaseTimer;
+
+    /** Guard broken montage path (archetype or per-instance) */
+    const TSoftObjectPtr<UAnimMontage>& GetGuardBrokenMontageRef() const;
+
+    /** Posture moved - request the assets under the threshold, schedule their release above it */
+    void HandlePostureChanged(float NewPosture);
+
+    /** Resolve a streamed montage, loading it synchronously if streaming hasn't finished (logs the hitch) */
+    UAnimMontage* ResolveStreamedMontage(const TSoftObjectPtr<UAnimMontage>& Montage) const;
+
     // ============================================================================
     // INTERNAL HELPERS
     // ============================================================================
@@ -214,9 +516,9 @@ private:
      */
     EAttackDirection GetHitDirectionRelativeToFacing(const FVector& HitDirection) const;
 
-    /** Update stun timer (called in Tick) */
-    void UpdateStun(float DeltaTime);
+    /** Start a procedural flinch (replaces any flinch in progress) */
+    void StartFlinch(EAttackDirection Direction, bool bIsHeavy);
 
-    /** End current stun */
+    /** End current stun (StunTimer callback) */
     void EndStun();
 };
\ No newline at end of file
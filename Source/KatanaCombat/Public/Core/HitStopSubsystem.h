@@ -0,0 +1,101 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "HitStopSubsystem.generated.h"
+
+/**
+ * Hit-stop scheduler: brief time dilation on hits and parries
+ *
+ * Requests only record intent; the subsystem applies every actor's dilation (and the optional
+ * global dilation) once per frame in Tick, writing each value only when it changes. Overlapping
+ * requests on the same actor merge - the strongest dilation and the latest end time win - so a
+ * heavy cleave hitting five enemies costs one write per actor instead of one per hit.
+ *
+ * Per-actor hit-stop scales AActor::CustomTimeDilation (multiplying any base dilation the actor
+ * already had, restored afterwards), so it composes with montage playrates set by hold/easing code.
+ * Durations are measured in real time so a global hit-stop doesn't stretch itself.
+ */
+UCLASS()
+class KATANACOMBAT_API UHitStopSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    // ============================================================================
+    // REQUESTS
+    // ============================================================================
+
+    /**
+     * Dilate one actor's time for a short duration
+     * @param Actor - Actor to slow (attacker or victim)
+     * @param Duration - Real-time seconds
+     * @param TimeDilation - Dilation while active (0.05 = nearly frozen)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Combat|Hit Stop")
+    void RequestHitStop(AActor* Actor, float Duration, float TimeDilation = 0.05f);
+
+    /**
+     * Dilate the whole world for a short duration (e.g. perfect parry)
+     * @param Duration - Real-time seconds
+     * @param TimeDilation - Global dilation while active
+     */
+    UFUNCTION(BlueprintCallable, Category = "Combat|Hit Stop")
+    void RequestGlobalHitStop(float Duration, float TimeDilation = 0.1f);
+
+    /** Restore every actor and the world immediately */
+    UFUNCTION(BlueprintCallable, Category = "Combat|Hit Stop")
+    void ClearAllHitStops();
+
+    /** Is this actor currently dilated (or about to be, next frame)? */
+    UFUNCTION(BlueprintPure, Category = "Combat|Hit Stop")
+    bool IsActorInHitStop(const AActor* Actor) const;
+
+    /** Actors with an active or pending hit-stop */
+    int32 GetNumActiveHitStops() const { return ActorStops.Num(); }
+
+    /** Dilation writes issued since the world started (for profiling) */
+    int32 GetNumDilationWrites() const { return NumDilationWrites; }
+
+private:
+    struct FActorHitStop
+    {
+        TWeakObjectPtr<AActor> Actor;
+
+        /** Actor's own CustomTimeDilation before hit-stop (restored at the end) */
+        float BaseDilation = 1.0f;
+
+        /** Merged request: strongest dilation, latest end (real time) */
+        float TimeDilation = 1.0f;
+        float EndTime = 0.0f;
+
+        /** Dilation last written to the actor (-1 = not yet applied) */
+        float AppliedDilation = -1.0f;
+    };
+
+    /** Actor → merged hit-stop */
+    TMap<FObjectKey, FActorHitStop> ActorStops;
+
+    /** Merged global request (EndTime 0 = none) */
+    float GlobalDilation = 1.0f;
+    float GlobalEndTime = 0.0f;
+    float AppliedGlobalDilation = 1.0f;
+    bool bGlobalActive = false;
+
+    int32 NumDilationWrites = 0;
+
+    float GetRealTime() const;
+    void ApplyGlobalDilation(float Dilation);
+};
@@ -0,0 +1,45 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/CapsuleComponent.h"
+#include "CombatTypes.h"
+#include "HurtboxComponent.generated.h"
+
+/**
+ * Simple damage-zone shape on the dedicated hurtbox object channel
+ *
+ * Attach a handful to the character mesh's bones (head, torso, upper/lower limbs). Weapons and
+ * targeting with bUseHurtboxes query only this object channel, so they never touch character
+ * capsules, render meshes or world geometry, and the hit component tells the zone.
+ *
+ * Channel setup: map HurtboxChannel (ECC_GameTraceChannel1) to an object channel named
+ * "Hurtbox" with default response Ignore in Project Settings > Collision. Hurtboxes are query
+ * only and ignore every channel; object-type queries find them regardless of responses.
+ */
+UCLASS(ClassGroup=(Combat), meta=(BlueprintSpawnableComponent))
+class KATANACOMBAT_API UHurtboxComponent : public UCapsuleComponent
+{
+    GENERATED_BODY()
+
+public:
+    UHurtboxComponent();
+
+    /** Object channel every hurtbox uses (configured as "Hurtbox" in the project's collision settings) */
+    static constexpr ECollisionChannel HurtboxChannel = ECC_GameTraceChannel1;
+
+    /** Body zone this shape covers */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hurtbox")
+    EHurtboxZone Zone = EHurtboxZone::Torso;
+
+    /** Damage multiplier for hits on this zone */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hurtbox", meta = (ClampMin = "0.0"))
+    float DamageMultiplier = 1.0f;
+
+    /**
+     * Hurtbox a hit landed on
+     * @return Hurtbox component of the hit, nullptr if the hit wasn't on a hurtbox
+     */
+    static const UHurtboxComponent* FromHit(const FHitResult& Hit);
+};
@@ -0,0 +1,97 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "LagCompensationSubsystem.generated.h"
+
+/**
+ * One recorded pose of a target (capsule-shaped, upright)
+ */
+struct FLagCompensationSample
+{
+    float Time = 0.0f;
+    FVector Location = FVector::ZeroVector;
+    float Radius = 0.0f;
+    float HalfHeight = 0.0f;
+};
+
+/**
+ * Fixed-capacity ring of samples for one actor
+ */
+struct FLagCompensationHistory
+{
+    TWeakObjectPtr<AActor> Actor;
+    TArray<FLagCompensationSample> Samples;
+
+    /** Index the next sample is written to */
+    int32 Head = 0;
+};
+
+/**
+ * Server-side position history used to validate client hit claims at the time the client saw them
+ * 
+ * Every actor in UTargetRegistrySubsystem gets a small ring buffer of (time, location, capsule)
+ * samples recorded once per frame on the server. UWeaponComponent rewinds a claimed target to the
+ * attacker's timestamp and re-runs its blade check against that pose, so a hit that was fair on
+ * the attacker's screen stays fair at 100+ ms latency without the server tracing every client frame.
+ * 
+ * Does nothing in standalone or on clients.
+ */
+UCLASS()
+class KATANACOMBAT_API ULagCompensationSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    // ============================================================================
+    // CONFIGURATION
+    // ============================================================================
+
+    /** Samples kept per actor (at 60 Hz, 32 samples cover ~0.5 s) */
+    static constexpr int32 HistoryCapacity = 32;
+
+    /** Furthest back a claim may be rewound (seconds) - older claims are clamped to this */
+    float MaxRewindTime = 0.4f;
+
+    // ============================================================================
+    // RECORDING
+    // ============================================================================
+
+    /** Record the current pose of every registered target (called from Tick, exposed for tests) */
+    void RecordSnapshot(float Time);
+
+    // ============================================================================
+    // QUERIES
+    // ============================================================================
+
+    /**
+     * Pose of an actor at a past time, interpolated between the bracketing samples
+     * @param Actor - Actor to rewind
+     * @param Time - World time to rewind to (clamped to the oldest/newest sample)
+     * @param OutSample - Rewound pose
+     * @return False if the actor has no history
+     */
+    bool GetRewoundSample(const AActor* Actor, float Time, FLagCompensationSample& OutSample) const;
+
+    /** Number of actors with history */
+    int32 GetNumTrackedActors() const { return Histories.Num(); }
+
+private:
+    /** Actor → ring buffer */
+    TMap<FObjectKey, FLagCompensationHistory> Histories;
+
+    /** Build a sample from an actor's current transform and collision */
+    static FLagCompensationSample MakeSample(const AActor* Actor, float Time);
+};
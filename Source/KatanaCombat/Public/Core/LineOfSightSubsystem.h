@@ -0,0 +1,110 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "UObject/ObjectKey.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "LineOfSightSubsystem.generated.h"
+
+class UCombatBudgetSubsystem;
+
+/**
+ * Async, budgeted line-of-sight cache shared by all targeting components
+ * 
+ * Visibility is cached per (viewer, target) pair. Queries return the last known result;
+ * once a result is older than the caller's TTL a refresh is queued and issued as an async
+ * line trace, with at most TraceBudgetPerFrame traces submitted per frame. The first query
+ * for a pair has nothing to fall back on, so it traces synchronously once. Pairs nobody asks
+ * about any more are evicted by a low priority job on UCombatJobSchedulerSubsystem.
+ */
+UCLASS()
+class KATANACOMBAT_API ULineOfSightSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    // ============================================================================
+    // QUERIES
+    // ============================================================================
+
+    /**
+     * Get last known visibility between viewer and target
+     * Queues an async refresh when the cached result is older than MaxAge
+     * @param Viewer - Actor looking (ignored by the trace)
+     * @param Target - Actor being looked at (ignored by the trace)
+     * @param TraceChannel - Channel that blocks visibility
+     * @param MaxAge - Seconds a cached result stays fresh (stretched while the targeting budget is exceeded)
+     * @return True if target was visible at last check
+     */
+    bool HasLineOfSight(AActor* Viewer, AActor* Target, ECollisionChannel TraceChannel, float MaxAge);
+
+    /** Drop every cached result (e.g. after a level streams in) */
+    void InvalidateCache();
+
+    /** Max async traces submitted per frame across all viewers */
+    int32 TraceBudgetPerFrame = 16;
+
+    /** Cached pairs not queried for this long are evicted (seconds) */
+    float EvictionAge = 2.0f;
+
+    /** Seconds between eviction passes */
+    float EvictionInterval = 0.5f;
+
+private:
+    using FLineOfSightKey = TTuple<FObjectKey, FObjectKey>;
+
+    /** Cached visibility for one viewer/target pair */
+    struct FLineOfSightEntry
+    {
+        TWeakObjectPtr<AActor> Viewer;
+        TWeakObjectPtr<AActor> Target;
+        TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+        double LastTraceTime = 0.0;
+        double LastQueryTime = 0.0;
+        bool bVisible = false;
+        bool bRefreshQueued = false;
+        bool bTraceInFlight = false;
+    };
+
+    /** Async trace awaiting results */
+    struct FPendingLineOfSightTrace
+    {
+        FLineOfSightKey Key;
+        FTraceHandle Handle;
+    };
+
+    TMap<FLineOfSightKey, FLineOfSightEntry> Cache;
+
+    /** Pairs waiting for a trace slot (FIFO) */
+    TArray<FLineOfSightKey> RefreshQueue;
+
+    /** Traces submitted last frame */
+    TArray<FPendingLineOfSightTrace> PendingTraces;
+
+    /** Synchronous trace used on first query for a pair */
+    bool TraceLineOfSight(AActor* Viewer, AActor* Target, ECollisionChannel TraceChannel) const;
+
+    void CollectCompletedTraces();
+    void SubmitQueuedTraces();
+    /** Scheduled job: drop pairs no one has queried for EvictionAge */
+    void EvictStaleEntries(float DeltaTime);
+
+    FCombatJobHandle EvictionJob;
+
+    /** Scales MaxAge while targeting is over budget */
+    UPROPERTY(Transient)
+    TObjectPtr<UCombatBudgetSubsystem> Budget;
+};
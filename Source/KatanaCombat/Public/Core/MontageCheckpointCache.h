@@ -0,0 +1,89 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ActionQueueTypes.h"
+#include "MontageCheckpointCache.generated.h"
+
+class UAnimMontage;
+
+/**
+ * Immutable checkpoint table for one montage
+ * Checkpoints are sorted by montage time; sections index contiguous ranges into it
+ */
+struct FMontageCheckpointTable
+{
+    /** All window checkpoints in the montage, sorted by MontageTime */
+    TArray<FTimerCheckpoint> Checkpoints;
+
+    /** Composite section -> [First, First + Num) range into Checkpoints */
+    struct FSectionRange
+    {
+        FName SectionName;
+        int32 First = 0;
+        int32 Num = 0;
+    };
+    TArray<FSectionRange, TInlineAllocator<4>> Sections;
+
+    /** Checkpoints that start inside a section (NAME_None = whole montage) */
+    TConstArrayView<FTimerCheckpoint> GetCheckpoints(FName SectionName = NAME_None) const;
+};
+
+/**
+ * Per-world cache of montage checkpoint tables
+ *
+ * UMontageUtilityLibrary::DiscoverCheckpoints scans every notify of a montage and sorts the
+ * result. Chained combos start new montages several times per second per character, so the
+ * scan runs once per montage here and later lookups return the prebuilt table.
+ *
+ * Tables are keyed by FObjectKey (never aliases a reloaded/reallocated montage). In editor
+ * builds a montage's table is dropped when the asset is modified.
+ */
+UCLASS()
+class KATANACOMBAT_API UMontageCheckpointCache : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /**
+     * Get (building on first use) the checkpoint table for a montage
+     * @param Montage - Montage to look up
+     * @return Cached table (pointer valid until the next lookup), or nullptr if Montage is null
+     */
+    const FMontageCheckpointTable* FindOrBuildTable(UAnimMontage* Montage);
+
+    /**
+     * Convenience: checkpoints for a montage / section
+     * @param Montage - Montage to look up
+     * @param SectionName - Composite section name (NAME_None = whole montage)
+     * @return View into the cached table (empty if none), valid until the table is invalidated
+     */
+    TConstArrayView<FTimerCheckpoint> GetCheckpoints(UAnimMontage* Montage, FName SectionName = NAME_None);
+
+    /** Drop a cached table (e.g. after notifies were edited at runtime) */
+    void InvalidateMontage(const UAnimMontage* Montage);
+
+    /** Number of cached montages */
+    int32 GetNumCachedMontages() const { return Tables.Num(); }
+
+    /** Heap bytes held by the cached tables (Combat.DumpMemory) */
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    /** Build a fresh table from the montage's notifies */
+    static void BuildTable(UAnimMontage* Montage, FMontageCheckpointTable& OutTable);
+
+#if WITH_EDITOR
+    void OnObjectModified(UObject* Object);
+    FDelegateHandle ObjectModifiedHandle;
+#endif
+
+    /** Montage -> checkpoint table */
+    TMap<FObjectKey, FMontageCheckpointTable> Tables;
+};
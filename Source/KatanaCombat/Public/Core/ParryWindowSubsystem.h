@@ -0,0 +1,123 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ParryWindowSubsystem.generated.h"
+
+struct FTimerCheckpoint;
+
+/**
+ * Registry of attackers whose parry window is currently open
+ * 
+ * Attackers register when AnimNotifyState_ParryWindow opens their window and unregister
+ * when it closes (notify end, timer expiry, or state reset). Defenders resolve a parry
+ * by querying this short list instead of overlap-scanning nearby pawns on every block press.
+ *
+ * Closed windows are remembered for a moment with their close time, so a block press that
+ * happened before the close but is processed a frame later (sub-frame input timestamps) still
+ * finds its attacker.
+ *
+ * Block presses are judged with EvaluateParryWindowAt where possible: an interval test of the
+ * press time against the attacker's montage parry windows, independent of frame rate and of
+ * whether the window notifies have ticked yet this frame.
+ */
+UCLASS()
+class KATANACOMBAT_API UParryWindowSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    // ============================================================================
+    // REGISTRATION
+    // ============================================================================
+
+    /**
+     * Mark attacker as parryable (parry window opened)
+     * @param Attacker - Actor whose attack can now be parried
+     */
+    void RegisterParryWindow(AActor* Attacker);
+
+    /**
+     * Remove attacker from registry (parry window closed)
+     * @param Attacker - Actor whose window closed
+     */
+    void UnregisterParryWindow(AActor* Attacker);
+
+    // ============================================================================
+    // QUERIES
+    // ============================================================================
+
+    /**
+     * Find closest attacker with an open parry window
+     * @param Defender - Actor attempting the parry (excluded from results)
+     * @param MaxRange - Maximum distance from defender (cm)
+     * @param InputTime - World time of the block press (< 0 = now): windows closed after it still count
+     * @return Closest parryable attacker in range, or nullptr
+     */
+    AActor* FindParryableAttacker(const AActor* Defender, float MaxRange, float InputTime = -1.0f) const;
+
+    /**
+     * Is this actor's parry window registered as open?
+     * @param Attacker - Actor to check
+     * @return True if registered
+     */
+    bool IsParryWindowOpen(const AActor* Attacker) const;
+
+    /**
+     * Was this actor's parry window open at a given world time?
+     * @param Attacker - Actor to check
+     * @param Time - World time to test (open now, or closed after Time)
+     * @return True if open then
+     */
+    bool WasParryWindowOpenAt(const AActor* Attacker, float Time) const;
+
+    /**
+     * Interval test: was the attacker's montage inside a parry window at a given world time?
+     * Maps Time onto the attacker's active montage (position at its last pose tick, current play
+     * rate and time dilation) and tests it against the montage's cached parry checkpoints.
+     * @param Attacker - Attacking character
+     * @param Time - World time of the block press
+     * @return Whether a window was open then; unset when the attacker has no montage with parry windows
+     */
+    TOptional<bool> EvaluateParryWindowAt(const AActor* Attacker, float Time) const;
+
+    /**
+     * Pure interval test against parry checkpoints
+     * @param Checkpoints - Montage checkpoints (any window types, parry ones are tested)
+     * @param MontageTime - Montage time to test
+     * @return True if MontageTime lies in any parry window's [start, end]
+     */
+    static bool IsInParryCheckpoint(TConstArrayView<FTimerCheckpoint> Checkpoints, float MontageTime);
+
+    /**
+     * Montage time at world time Time, from a position sampled at SampleTime
+     * @param PlayRate - Effective montage rate (montage rate x rate scale x time dilation)
+     */
+    static float ExtrapolateMontageTime(float SamplePosition, float SampleTime, float PlayRate, float Time) { return SamplePosition + (Time - SampleTime) * PlayRate; }
+
+    /** How long closed windows are remembered (seconds) - longer than any frame an input can be credited back */
+    static constexpr float ClosedWindowMemory = 0.1f;
+
+    /** Number of attackers with open parry windows */
+    int32 GetOpenWindowCount() const { return OpenParryWindows.Num(); }
+
+private:
+    /** Attackers with open parry windows (kept tiny - only attackers mid-telegraph) */
+    TArray<TWeakObjectPtr<AActor>> OpenParryWindows;
+
+    struct FClosedParryWindow
+    {
+        TWeakObjectPtr<AActor> Attacker;
+        float CloseTime = 0.0f;
+    };
+
+    /** Windows closed within ClosedWindowMemory */
+    TArray<FClosedParryWindow> RecentlyClosedWindows;
+
+    /** Is this window in RecentlyClosedWindows with a close time after Time? */
+    bool ClosedAfter(const AActor* Attacker, float Time) const;
+};
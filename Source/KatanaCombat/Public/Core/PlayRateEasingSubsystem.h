@@ -0,0 +1,205 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Utilities/MontageUtilityLibrary.h"
+#include "PlayRateEasingSubsystem.generated.h"
+
+class ACharacter;
+class UAnimInstance;
+
+/** Called every frame an ease advances (after the new playrate was applied) */
+DECLARE_DELEGATE_OneParam(FOnPlayRateEaseUpdated, float /*PlayRate*/);
+
+/** Called once when an ease reaches its target (not called on cancel/replace) */
+DECLARE_DELEGATE(FOnPlayRateEaseFinished);
+
+/**
+ * Who is asking for a montage playrate - when several ask for the same character, the highest wins
+ */
+enum class EPlayRatePriority : uint8
+{
+    /** Gameplay rates with no stronger claim */
+    Default,
+
+    /** Hold freeze, hold eases and charge stage rates */
+    Hold,
+
+    /** Montage freeze frames on hit (wins over everything) */
+    HitStop,
+
+    Num
+};
+
+/**
+ * Handle to an active playrate ease (Id 0 = none)
+ */
+struct FPlayRateEaseHandle
+{
+    uint32 Id = 0;
+
+    bool IsValid() const { return Id != 0; }
+    void Reset() { Id = 0; }
+};
+
+/**
+ * Shared montage playrate easing scheduler and per-character playrate arbiter
+ *
+ * Replaces per-component looping 60 Hz timers for hold ease-in/ease-out. All active eases
+ * advance once per frame with the real (dilated) world delta time, so easing no longer aliases
+ * with the frame rate. Each frame evaluates every ease first, then applies playrates in one
+ * pass (one Montage_SetPlayRate per anim instance), then fires callbacks.
+ *
+ * One ease per anim instance: starting a new ease on the same character replaces the old one.
+ *
+ * Playrate writes from gameplay (hold activate/release, charge stages, restores) go through
+ * RequestPlayRate / ClearPlayRate instead of setting the montage directly. Requests are kept
+ * per character and priority (EPlayRatePriority); eases request at Hold priority. In the apply
+ * pass each character that changed this frame gets the winning rate (1.0 once nothing is
+ * requested) written once, and only if the montage isn't already playing at it.
+ */
+UCLASS()
+class KATANACOMBAT_API UPlayRateEasingSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    // ============================================================================
+    // EASES
+    // ============================================================================
+
+    /**
+     * Ease the character's active montage playrate from StartRate to TargetRate
+     * @param Character - Character whose active montage is eased
+     * @param StartRate - Playrate at elapsed = 0
+     * @param TargetRate - Playrate at elapsed = Duration
+     * @param Duration - Ease duration in seconds (<= 0 snaps to target next frame)
+     * @param EasingType - Procedural easing curve
+     * @param OnUpdated - Optional per-frame callback
+     * @param OnFinished - Optional completion callback
+     * @return Handle for cancellation (invalid if Character has no anim instance)
+     */
+    FPlayRateEaseHandle StartEase(ACharacter* Character, float StartRate, float TargetRate, float Duration, EEasingType EasingType,
+        FOnPlayRateEaseUpdated OnUpdated = FOnPlayRateEaseUpdated(), FOnPlayRateEaseFinished OnFinished = FOnPlayRateEaseFinished());
+
+    /**
+     * Stop an ease without applying its target or firing OnFinished
+     * @param Handle - Ease to cancel (reset on return)
+     * @return True if an active ease was cancelled
+     */
+    bool CancelEase(FPlayRateEaseHandle& Handle);
+
+    /** Is this ease still running? */
+    bool IsEaseActive(FPlayRateEaseHandle Handle) const;
+
+    /** Number of running eases */
+    int32 GetActiveEaseCount() const { return ActiveEases.Num(); }
+
+    // ============================================================================
+    // ARBITRATION
+    // ============================================================================
+
+    /**
+     * Ask for a playrate on the character's active montage (applied in this frame's apply pass)
+     * @param Character - Character whose active montage is driven
+     * @param Priority - Request slot; replaces any earlier request at the same priority
+     * @param PlayRate - Requested playrate
+     */
+    void RequestPlayRate(ACharacter* Character, EPlayRatePriority Priority, float PlayRate);
+
+    /** Drop the character's request at this priority (the next one down, or 1.0, is applied) */
+    void ClearPlayRate(ACharacter* Character, EPlayRatePriority Priority);
+
+    /** Drop every request for the character (1.0 is applied) */
+    void ClearPlayRates(ACharacter* Character);
+
+    /**
+     * Playrate the character's active montage plays at once this frame's requests are applied
+     * @return Winning pending rate, else the active montage's rate (1.0 if none)
+     */
+    float GetPlayRate(const ACharacter* Character) const;
+
+    /** Apply pending requests now (normally done by Tick after eases advance) */
+    void FlushPlayRates();
+
+    /** Characters with requests or pending writes */
+    int32 GetArbiterCount() const { return Arbiters.Num(); }
+
+    /** Montage_SetPlayRate calls issued by the apply pass since the world started (for profiling) */
+    int32 GetNumPlayRateWrites() const { return NumPlayRateWrites; }
+
+private:
+    struct FActiveEase
+    {
+        uint32 Id = 0;
+        TWeakObjectPtr<ACharacter> Character;
+        TWeakObjectPtr<UAnimInstance> AnimInstance;
+        float StartRate = 1.0f;
+        float TargetRate = 1.0f;
+        float Duration = 0.0f;
+        float Elapsed = 0.0f;
+        float CurrentRate = 1.0f;
+        EEasingType EasingType = EEasingType::Linear;
+        bool bFinished = false;
+        FOnPlayRateEaseUpdated OnUpdated;
+        FOnPlayRateEaseFinished OnFinished;
+    };
+
+    /** Playrate requests for one character */
+    struct FPlayRateArbiter
+    {
+        TWeakObjectPtr<ACharacter> Character;
+
+        /** Resolved on first write and kept until the mesh swaps instances */
+        TWeakObjectPtr<UAnimInstance> AnimInstance;
+
+        float Rates[static_cast<int32>(EPlayRatePriority::Num)] = {};
+
+        /** Bit per EPlayRatePriority with a request */
+        uint8 RequestMask = 0;
+
+        /** Changed since the last apply pass */
+        bool bDirty = false;
+
+        /** Highest priority request, or 1.0 */
+        float GetResolvedRate() const;
+    };
+
+    int32 FindEaseIndex(uint32 Id) const;
+
+    FPlayRateArbiter* FindArbiter(const ACharacter* Character);
+    const FPlayRateArbiter* FindArbiter(const ACharacter* Character) const;
+
+    /** Running eases (small - only characters mid hold transition) */
+    TArray<FActiveEase> ActiveEases;
+
+    /** Per-frame scratch: batched easing evaluation (parallel to ActiveEases) */
+    TArray<float, TInlineAllocator<16>> Alphas;
+    TArray<EEasingType, TInlineAllocator<16>> EasingTypes;
+    TArray<float, TInlineAllocator<16>> EasedAlphas;
+
+    /** Per-frame scratch: eases to notify after playrates are applied */
+    TArray<uint32, TInlineAllocator<16>> UpdatedEaseIds;
+    TArray<FOnPlayRateEaseFinished, TInlineAllocator<16>> FinishedCallbacks;
+
+    /** Characters with playrate requests (small - only characters mid hold, charge or restore) */
+    TArray<FPlayRateArbiter> Arbiters;
+
+    /** Arbiters with a pending write */
+    int32 NumDirtyArbiters = 0;
+
+    int32 NumPlayRateWrites = 0;
+
+    uint32 NextEaseId = 1;
+};
@@ -0,0 +1,112 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "TargetRegistrySubsystem.generated.h"
+
+/**
+ * Spatial hash of targetable actors for UTargetingComponent range queries
+ * 
+ * Replaces per-query physics overlaps with a query against cache-friendly SoA position arrays
+ * bucketed into a 2D grid. Pawns register automatically when spawned (and at world BeginPlay
+ * for level-placed pawns); positions refresh lazily once per frame on the first query, and
+ * actors only move between grid cells when they cross a cell boundary.
+ * 
+ * Distances are measured to actor origins (not collision bounds like the old overlap).
+ */
+UCLASS()
+class KATANACOMBAT_API UTargetRegistrySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    // ============================================================================
+    // REGISTRATION
+    // ============================================================================
+
+    /**
+     * Add actor to the spatial index (no-op if already registered)
+     * @param Actor - Targetable actor
+     */
+    void RegisterTarget(AActor* Actor);
+
+    /**
+     * Remove actor from the spatial index
+     * @param Actor - Actor to remove
+     */
+    void UnregisterTarget(AActor* Actor);
+
+    // ============================================================================
+    // QUERIES
+    // ============================================================================
+
+    /**
+     * Gather registered actors within radius of a point
+     * @param Center - Query center
+     * @param Radius - Query radius (cm)
+     * @param OutActors - Actors in range (appended)
+     * @param IgnoreActor - Actor to exclude (usually the querier)
+     * @return Number of actors added
+     */
+    int32 QueryTargetsInRadius(const FVector& Center, float Radius, TArray<AActor*>& OutActors, const AActor* IgnoreActor = nullptr);
+
+    /** Number of actors currently indexed */
+    int32 GetNumRegisteredTargets() const { return TargetActors.Num(); }
+
+    /** Every indexed actor (may contain stale entries until the next refresh purges them) */
+    TConstArrayView<TWeakObjectPtr<AActor>> GetRegisteredTargets() const { return TargetActors; }
+
+    /** Grid cell edge length (cm) - roughly a close-combat engagement radius */
+    static constexpr float CellSize = 500.0f;
+
+private:
+    // ============================================================================
+    // SOA STORAGE
+    // ============================================================================
+
+    TArray<TWeakObjectPtr<AActor>> TargetActors;
+    TArray<FObjectKey> TargetKeys;
+    TArray<float> PositionsX;
+    TArray<float> PositionsY;
+    TArray<float> PositionsZ;
+    TArray<FIntPoint> TargetCells;
+
+    /** Actor → index into SoA arrays */
+    TMap<FObjectKey, int32> TargetIndices;
+
+    /** Grid cell → indices of actors in that cell */
+    TMap<FIntPoint, TArray<int32, TInlineAllocator<8>>> Cells;
+
+    /** Frame positions were last refreshed (lazy, first query per frame) */
+    uint64 LastRefreshFrame = MAX_uint64;
+
+    FDelegateHandle ActorSpawnedHandle;
+
+    // ============================================================================
+    // INTERNAL HELPERS
+    // ============================================================================
+
+    void OnActorSpawned(AActor* Actor);
+
+    /** Refresh positions and cell membership, purging destroyed actors */
+    void RefreshPositions();
+
+    /** Swap-remove entry at Index from all SoA arrays and its cell */
+    void RemoveAtIndex(int32 Index);
+
+    static FIntPoint GetCellCoord(float X, float Y)
+    {
+        return FIntPoint(FMath::FloorToInt(X / CellSize), FMath::FloorToInt(Y / CellSize));
+    }
+};
@@ -11,6 +11,10 @@
 class ACharacter;
 class AActor;
 class UMotionWarpingComponent;
+class UAttackData;
+class UCombatArchetype;
+class ULineOfSightSubsystem;
+class UAnimMontage;
 
 /**
  * Handles directional cone-based targeting and motion warping setup
@@ -51,10 +55,68 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting")
     TEnumAsByte<ECollisionChannel> LineOfSightChannel = ECC_Visibility;
 
-    /** Actor classes to consider as targets (empty = all actors) */
+    /**
+     * Use last known visibility from ULineOfSightSubsystem during target selection
+     * Stale results refresh via budgeted async traces instead of blocking traces per candidate
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting", meta = (EditCondition = "bRequireLineOfSight"))
+    bool bUseAsyncLineOfSight = true;
+
+    /** How long a cached line of sight result stays fresh (seconds) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting", meta = (EditCondition = "bRequireLineOfSight && bUseAsyncLineOfSight", ClampMin = "0.0"))
+    float LineOfSightCacheTTL = 0.2f;
+
+    /**
+     * Query UTargetRegistrySubsystem's spatial hash instead of a physics overlap
+     * Disable to fall back to OverlapMultiByChannel on ECC_Pawn
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting")
+    bool bUseTargetRegistry = true;
+
+    /** Physics fallback overlaps the hurtbox object channel (UHurtboxComponent) instead of ECC_Pawn */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting", meta = (EditCondition = "!bUseTargetRegistry"))
+    bool bUseHurtboxes = false;
+
+    /** Leave actors ranked Culled by UCombatSignificanceSubsystem out of the candidate set (the current target is always kept) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting")
+    bool bSkipCulledCandidates = true;
+
+    /**
+     * Owner movement (cm) that invalidates this frame's cached target scores
+     * Scores are always rebuilt on a new frame; this only matters for repeated queries within one frame
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting", meta = (ClampMin = "0.0"))
+    float ScoreCacheMovementThreshold = 25.0f;
+
+    /** Actor classes to consider as targets (empty = all actors; ignored when an archetype is set) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting")
     TArray<TSubclassOf<AActor>> TargetableClasses;
 
+    /**
+     * Read the targetable class filter from a shared archetype instead of TargetableClasses
+     * @param InArchetype - Shared archetype (nullptr = use per-instance properties)
+     */
+    void SetArchetype(const UCombatArchetype* InArchetype);
+
+    /** Targetable class filter in effect (archetype or per-instance) */
+    const TArray<TSubclassOf<AActor>>& GetTargetableClasses() const;
+
+    /**
+     * Keep motion warp targets following a moving target while the attack montage plays
+     * The warp point is recomputed from the target's transform (no new target query) at WarpTrackingInterval,
+     * and only once the target has moved past WarpTrackingMovementThreshold since the last update
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting|Motion Warping")
+    bool bTrackWarpTargets = false;
+
+    /** Time between warp target updates while tracking (seconds, 0 = every frame) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting|Motion Warping", meta = (EditCondition = "bTrackWarpTargets", ClampMin = "0.0"))
+    float WarpTrackingInterval = 0.05f;
+
+    /** Target movement (cm) since the last update before the warp point is moved */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting|Motion Warping", meta = (EditCondition = "bTrackWarpTargets", ClampMin = "0.0"))
+    float WarpTrackingMovementThreshold = 15.0f;
+
     /** Enable debug visualization */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting|Debug")
     bool bDebugDraw = false;
@@ -79,6 +141,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Targeting")
     AActor* FindTargetInDirection(const FVector& DirectionVector);
 
+    /**
+     * Find nearest target an attack can actually close on (within its baked reach + warp allowance)
+     * Reach comes from the attack's cooked timing block; the animation is never sampled
+     * @param AttackData - Attack about to execute (no reach filter if it does not warp)
+     * @param Direction - Attack direction (None = use character forward)
+     * @return Target actor, or nullptr if none in reach
+     */
+    UFUNCTION(BlueprintCallable, Category = "Targeting")
+    AActor* FindTargetForAttack(const UAttackData* AttackData, EAttackDirection Direction = EAttackDirection::None);
+
     /**
      * Get all potential targets in range (no direction filter)
      * @param OutTargets - Array to fill with found targets
@@ -154,6 +226,22 @@ public:
     UFUNCTION(BlueprintPure, Category = "Targeting")
     bool HasTarget() const { return CurrentTarget != nullptr; }
 
+    // ============================================================================
+    // DUEL TARGET (set by UCombatComponent::BeginDuel)
+    // ============================================================================
+
+    /**
+     * Answer every target query with this actor (no overlap, class, cone or line of sight checks)
+     * Distance limits still apply
+     */
+    void SetDuelTarget(AActor* Target) { DuelTarget = Target; }
+
+    /** Back to world queries */
+    void ClearDuelTarget() { DuelTarget.Reset(); }
+
+    /** Duel opponent answering target queries (nullptr outside a duel) */
+    AActor* GetDuelTarget() const { return DuelTarget.Get(); }
+
     // ============================================================================
     // MOTION WARPING INTEGRATION
     // ============================================================================
@@ -168,6 +256,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Targeting|Motion Warping")
     bool SetupMotionWarp(AActor* Target, FName WarpTargetName = "AttackTarget", float MaxDistance = -1.0f);
 
+    /**
+     * Setup motion warping for an attack from its baked root motion
+     * Warps only the distance the attack's own root motion does not already cover (up to MaxWarpDistance);
+     * closer than MinWarpDistance the warp target is cleared and root motion plays as authored
+     * @param Target - Target to warp toward
+     * @param AttackData - Attack about to execute
+     * @return True if a warp target was set
+     */
+    UFUNCTION(BlueprintCallable, Category = "Targeting|Motion Warping")
+    bool SetupMotionWarpForAttack(AActor* Target, const UAttackData* AttackData);
+
     /**
      * Clear motion warp targets
      * @param WarpTargetName - Name of warp target to clear (NAME_None = all)
@@ -175,9 +274,24 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Targeting|Motion Warping")
     void ClearMotionWarp(FName WarpTargetName = NAME_None);
 
+    /** Is any warp target following its target? */
+    bool IsTrackingWarpTargets() const { return TrackedWarps.Num() > 0; }
+
+    /** Warp target updates made by tracking since BeginPlay */
+    int32 GetNumWarpTrackingUpdates() const { return NumWarpTrackingUpdates; }
+
+    /** Force the next query to rebuild cached target scores (e.g. after teleporting the owner) */
+    void InvalidateTargetScores() { CachedScoresFrame = MAX_uint64; }
+
+    /** Adds the target score caches (Combat.DumpMemory, memreport) */
+    virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 protected:
     virtual void BeginPlay() override;
 
+    /** Only enabled while warp targets are tracked */
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
 private:
     // ============================================================================
     // STATE
@@ -187,6 +301,65 @@ private:
     UPROPERTY()
     TObjectPtr<AActor> CurrentTarget = nullptr;
 
+    /** Duel opponent short-circuiting target queries */
+    TWeakObjectPtr<AActor> DuelTarget;
+
+    /**
+     * Direction-independent candidates (range + class filtered), nearest first
+     * Rebuilt at most once per frame unless the owner moves past ScoreCacheMovementThreshold
+     */
+    mutable TArray<FTargetScore> CachedTargetScores;
+
+    /**
+     * Owner → candidate unit vectors and squared distances, parallel to CachedTargetScores
+     * Kept as separate float arrays so the cone + range test is one branch-free loop
+     */
+    mutable TArray<float> CachedDirectionX;
+    mutable TArray<float> CachedDirectionY;
+    mutable TArray<float> CachedDirectionZ;
+    mutable TArray<float> CachedDistanceSquared;
+
+    enum class ECandidateVisibility : uint8
+    {
+        Unknown,
+        Visible,
+        Blocked
+    };
+
+    /** Line of sight per cached candidate, resolved only when a query reaches it */
+    mutable TArray<ECandidateVisibility> CachedVisibility;
+
+    /** Scratch for the fused pass (one flag per cached candidate) */
+    mutable TArray<uint8> QueryPassMask;
+
+    /** Frame CachedTargetScores was built on */
+    mutable uint64 CachedScoresFrame = MAX_uint64;
+
+    /** Owner location when CachedTargetScores was built */
+    mutable FVector CachedScoresOwnerLocation = FVector::ZeroVector;
+
+    /** Warp target following a moving target */
+    struct FTrackedWarp
+    {
+        FName WarpTargetName;
+        TWeakObjectPtr<AActor> Target;
+
+        /** Set for SetupMotionWarpForAttack (warp recomputed from its config), null for SetupMotionWarp */
+        TWeakObjectPtr<const UAttackData> AttackData;
+        float MaxDistance = -1.0f;
+
+        /** Tracking ends once this stops playing (null = the montage playing on the first update) */
+        TWeakObjectPtr<UAnimMontage> Montage;
+
+        /** Target location the warp point was last computed from */
+        FVector LastTargetLocation = FVector::ZeroVector;
+    };
+
+    /** Tracked warp targets (usually one, the current attack's) */
+    TArray<FTrackedWarp, TInlineAllocator<1>> TrackedWarps;
+
+    int32 NumWarpTrackingUpdates = 0;
+
     // ============================================================================
     // CACHED REFERENCES
     // ============================================================================
@@ -197,31 +370,50 @@ private:
     UPROPERTY()
     TObjectPtr<UMotionWarpingComponent> MotionWarpingComponent;
 
+    /** Shared configuration (class filter comes from here when set) */
+    UPROPERTY(Transient)
+    TObjectPtr<const UCombatArchetype> Archetype;
+
     // ============================================================================
     // INTERNAL HELPERS - TARGET FINDING
     // ============================================================================
 
-    /** Get all actors in sphere around owner */
+    /** Get all actors in sphere around owner (spatial hash, or physics overlap fallback) */
     void GetActorsInRange(TArray<AActor*>& OutActors) const;
 
-    /** Filter actors by targetable class */
-    void FilterByTargetableClass(TArray<AActor*>& InOutActors) const;
+    /** Is Actor one of the targetable classes? (empty filter = any actor) */
+    static bool IsTargetableClass(const AActor* Actor, const TArray<TSubclassOf<AActor>>& Classes);
+
+    /** Drop candidates ranked Culled by the combat significance pass */
+    void FilterBySignificance(TArray<AActor*>& InOutActors) const;
 
-    /** Filter actors by directional cone */
-    void FilterByCone(TArray<AActor*>& InOutActors, const FVector& Direction) const;
+    /** Rebuild CachedTargetScores if stale (new frame or owner moved past threshold) */
+    void RefreshTargetScores() const;
 
-    /** Filter actors by line of sight */
-    void FilterByLineOfSight(TArray<AActor*>& InOutActors) const;
+    /**
+     * Line of sight to a cached candidate, resolved once per cache rebuild
+     * Uses cached async visibility, or a blocking trace if bUseAsyncLineOfSight is off
+     */
+    bool IsCandidateVisible(int32 Index, ULineOfSightSubsystem* LineOfSight) const;
 
-    /** Sort actors by distance (nearest first) */
-    void SortByDistance(TArray<AActor*>& InOutActors) const;
+    /**
+     * Fused target query over the cached candidates
+     * One pass computes the cone dot product and range test for every candidate; survivors are then taken
+     * best score first (the cache is nearest first) and only those pay for line of sight
+     * @param Direction - World space search direction (normalized)
+     * @param MaxDistanceSquared - Range limit for this query
+     * @param MaxResults - Stop after this many visible survivors
+     * @param OutTargets - Visible survivors, best first
+     */
+    void QueryCandidates(const FVector& Direction, float MaxDistanceSquared, int32 MaxResults, TArray<AActor*>& OutTargets) const;
 
     /**
      * Find best target using filtering pipeline
      * @param Direction - World space search direction
+     * @param MaxDistance - Additional distance limit (<= 0 = MaxTargetDistance only)
      * @return Best target, or nullptr
      */
-    AActor* FindBestTarget(const FVector& Direction) const;
+    AActor* FindBestTarget(const FVector& Direction, float MaxDistance = -1.0f) const;
 
     // ============================================================================
     // INTERNAL HELPERS - MOTION WARPING
@@ -230,6 +422,18 @@ private:
     /** Calculate warp target location based on distance constraints */
     FVector CalculateWarpLocation(AActor* Target, float MaxDistance) const;
 
+    /**
+     * Warp target for an attack from its baked root motion
+     * @return False if the target is close enough for the authored root motion alone
+     */
+    bool CalculateAttackWarp(const FVector& TargetLocation, const UAttackData* AttackData, FVector& OutLocation, FRotator& OutRotation) const;
+
+    /** Start (or restart) following Target with the named warp target, if bTrackWarpTargets */
+    void TrackWarpTarget(FName WarpTargetName, AActor* Target, const UAttackData* AttackData, float MaxDistance);
+
+    /** Stop following with the named warp target (NAME_None = all) */
+    void StopTrackingWarpTarget(FName WarpTargetName);
+
     // ============================================================================
     // DEBUG VISUALIZATION
     // ============================================================================
@@ -4,11 +4,113 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "CollisionShape.h"
+#include "CollisionQueryParams.h"
+#include "UObject/ObjectKey.h"
+#include "Engine/NetSerialization.h"
+#include "CombatTypes.h"
+#include "Core/BladeNarrowphase.h"
+#include "Core/AsyncBladeTrace.h"
 #include "WeaponComponent.generated.h"
 
+enum class ECombatSignificance : uint8;
+
 class UAttackData;
+struct FAttackSwingVolume;
 class ACharacter;
 class USkeletalMeshComponent;
+class UHitReactionComponent;
+class UPrimitiveComponent;
+class UCapsuleComponent;
+class IDamageableInterface;
+
+/**
+ * Single swept shape produced by a weapon for one frame
+ * Built once, then swept synchronously or submitted to UWeaponTraceSubsystem as an async batch
+ */
+struct FWeaponSweepSegment
+{
+    FVector Start = FVector::ZeroVector;
+    FVector End = FVector::ZeroVector;
+    FQuat Rotation = FQuat::Identity;
+    FCollisionShape Shape;
+};
+
+/**
+ * How damage reaches an actor hit this swing
+ * Resolved once when the actor enters the swing registry, so applying a hit is a direct call
+ */
+struct FWeaponHitTarget
+{
+    /** Native IDamageableInterface with no Blueprint override of the hit events - call _Implementation directly */
+    IDamageableInterface* NativeDamageable = nullptr;
+
+    /** Implements (or overrides) IDamageableInterface in Blueprint - must go through Execute_ */
+    bool bBlueprintDamageable = false;
+
+    /** Hits landed on this target this window, and how many the attack allows (UAttackData::MaxHitsPerTarget) */
+    uint8 NumHits = 0;
+    uint8 MaxHits = 1;
+
+    /** World time the next hit may land (UAttackData::RehitInterval after the last one) */
+    float NextHitTime = 0.0f;
+
+    /** No damage interface, but a hit reaction component that can take the hit */
+    UHitReactionComponent* HitReaction = nullptr;
+
+    /** Does this target take damage at all? */
+    bool IsDamageable() const { return NativeDamageable || bBlueprintDamageable || HitReaction; }
+
+    /** No hits left this window - sweeps can ignore the actor */
+    bool IsExhausted() const { return NumHits >= MaxHits; }
+
+    /** May another hit land at world time Now? */
+    bool CanRehit(float Now) const { return !IsExhausted() && Now >= NextHitTime; }
+
+    /**
+     * Count a hit landing at Now
+     * @param InMaxHits - Attack's hits per target (the latest attack wins when a combo follows into the same window)
+     * @param RehitInterval - Cooldown before the next one (never zero: overlapping segments of one frame count once)
+     */
+    void RecordHit(float Now, int32 InMaxHits, float RehitInterval)
+    {
+        MaxHits = static_cast<uint8>(FMath::Clamp(InMaxHits, 1, 255));
+        NumHits = static_cast<uint8>(FMath::Min(NumHits + 1, 255));
+        NextHitTime = Now + FMath::Max(RehitInterval, UE_KINDA_SMALL_NUMBER);
+    }
+
+    /** Resolve the route for an actor (class reflection + component lookup - once per target per swing) */
+    static FWeaponHitTarget Resolve(AActor* Actor);
+};
+
+/**
+ * Hit reported by an owning client for server-side validation
+ * Carries the blade pose the client swept so the server can re-run the check against rewound targets
+ */
+USTRUCT()
+struct FWeaponHitClaim
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TObjectPtr<AActor> HitActor;
+
+    /** Server world time the client saw when it swept (GameState clock) */
+    UPROPERTY()
+    float ServerTime = 0.0f;
+
+    UPROPERTY()
+    FVector_NetQuantize PrevStart;
+
+    UPROPERTY()
+    FVector_NetQuantize PrevTip;
+
+    UPROPERTY()
+    FVector_NetQuantize Start;
+
+    UPROPERTY()
+    FVector_NetQuantize Tip;
+};
 
 /**
  * Handles weapon-based hit detection via socket tracing
@@ -23,9 +125,16 @@ class USkeletalMeshComponent;
  * Hit Detection Flow:
  * - EnableHitDetection() called by AnimNotify at start of Active phase
  * - Every tick: Swept sphere trace from weapon_start to weapon_end
+ *   (blade sweep mode interpolates points along the blade and substeps fast swings)
  * - Hit actors tracked to prevent double-hitting
  * - DisableHitDetection() called by AnimNotify at end of Active phase
  * - ResetHitActors() called at start of new attack
+ * 
+ * Server Hit Validation (bServerHitValidation, networked games only):
+ * - The owning client sweeps as usual but sends each hit to the server as a claim instead of broadcasting
+ * - The server skips tracing for remotely controlled owners; it rewinds the claimed target via
+ *   ULagCompensationSubsystem to the client's timestamp and re-checks the swept blade against it
+ * - Confirmed claims broadcast OnWeaponHit on the server (authoritative)
  */
 UCLASS(ClassGroup=(Combat), meta=(BlueprintSpawnableComponent))
 class KATANACOMBAT_API UWeaponComponent : public UActorComponent
@@ -36,6 +145,7 @@ public:
     UWeaponComponent();
 
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    virtual void AsyncPhysicsTickComponent(float DeltaTime, float SimTime) override;
 
     // ============================================================================
     // CONFIGURATION
@@ -57,6 +167,127 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon")
     TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Pawn;
 
+    /**
+     * Sweep only the hurtbox object channel (UHurtboxComponent) instead of TraceChannel
+     * Sweeps skip character capsules, meshes and world geometry, and hits carry their damage zone.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon")
+    bool bUseHurtboxes = false;
+
+    /**
+     * Sweep the whole blade (start→tip) instead of only the tip
+     * Interpolates sample points along the blade and substeps fast swings so thin targets
+     * can't slip between frames. Disable to fall back to the legacy single tip sweep.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Sweep")
+    bool bUseBladeSweep = true;
+
+    /**
+     * Maximum allowed gap (cm) between the swept volume and the true blade path
+     * Drives both sample point spacing along the blade and angular substep count.
+     * Larger = fewer sweeps, smaller = tighter coverage on fast swings.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Sweep", meta = (EditCondition = "bUseBladeSweep", ClampMin = "0.1"))
+    float SweepSpatialTolerance = 10.0f;
+
+    /** Upper bound on sample points along the blade (per substep) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Sweep", meta = (EditCondition = "bUseBladeSweep", ClampMin = "2", ClampMax = "16"))
+    int32 MaxBladeSamplePoints = 6;
+
+    /** Upper bound on angular substeps per frame (caps cost of very fast swings at low frame rates) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Sweep", meta = (EditCondition = "bUseBladeSweep", ClampMin = "1", ClampMax = "16"))
+    int32 MaxSweepSubsteps = 8;
+
+    /**
+     * Route sweeps through UWeaponTraceSubsystem instead of ticking this component
+     * Segments from every active weapon are submitted as one batch of async sweeps and
+     * OnWeaponHit fires in a single pass the following frame (one frame of latency).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Sweep")
+    bool bUseBatchedTraces = false;
+
+    /**
+     * Test the swept blade against pawn capsules directly instead of sweeping the physics scene
+     * Candidates come from UTargetRegistrySubsystem; their hurtboxes (or root capsule when they have
+     * none) go through FBladeNarrowphase. Hit volume profiles and the legacy tip sweep still use physics.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Sweep", meta = (EditCondition = "bUseBladeSweep"))
+    bool bUseBladeNarrowphase = false;
+
+    /** Narrowphase hits need a clear line from the blade base to the impact through world geometry (one line trace per hit) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Sweep", meta = (EditCondition = "bUseBladeNarrowphase || bUseAsyncPhysicsTrace"))
+    bool bNarrowphaseWorldBlocking = true;
+
+    /**
+     * Test the blade against target capsules on the Chaos async physics tick (FAsyncBladeTrace) instead of once per frame
+     * Each fixed physics step places the blade from the swing's baked trajectory (or the last evaluated pose when there
+     * is no current bake) and narrowphases it against the capsules gathered on the game thread; hits are delivered on the
+     * next frame as usual, so detection no longer depends on frame rate. Needs Project Settings > Physics > Tick Physics
+     * Async, otherwise the steps run on the game thread once per frame. Hit volume profiles and the legacy tip sweep
+     * still trace per frame.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Sweep", meta = (EditCondition = "bUseBladeSweep"))
+    bool bUseAsyncPhysicsTrace = false;
+
+    /**
+     * Skip a frame's sweeps while no registered target is inside the attack's baked swing volume (UAttackData::SwingVolume)
+     * Attacks with a hit volume profile, a stale bake or a bake of other sockets always sweep. Only pawns are in
+     * UTargetRegistrySubsystem, so leave this off for weapons that must also hit non-pawn damageables.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Sweep")
+    bool bUseSwingVolumeCulling = false;
+
+    /** How far (cm) a target's origin may sit outside the swing volume and still count as inside (capsule radius, hurtbox reach) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Sweep", meta = (EditCondition = "bUseSwingVolumeCulling", ClampMin = "0.0"))
+    float SwingVolumeTargetMargin = 100.0f;
+
+    /**
+     * Tick group for component-ticked sweeps (applied at BeginPlay)
+     * TG_PostUpdateWork sweeps this frame's finished pose; earlier groups read last frame's pose
+     * or force a wait on parallel animation evaluation.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Weapon|Sweep")
+    TEnumAsByte<ETickingGroup> TraceTickGroup = TG_PostUpdateWork;
+
+    /** Also make the owner mesh's tick a prerequisite (it completes after parallel animation evaluation) */
+    UPROPERTY(EditDefaultsOnly, Category = "Weapon|Sweep")
+    bool bTickAfterOwnerMesh = true;
+
+    /**
+     * Read weapon sockets straight from the mesh's component-space pose through cached bone indices
+     * instead of resolving socket names on every query. Disable to use USkeletalMeshComponent::GetSocketLocation.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Sweep")
+    bool bReadSocketsFromPose = true;
+
+    /**
+     * Owning clients claim hits and the server validates them against lag-compensated target poses
+     * Ignored in standalone. Characters controlled on the server (AI, listen host) trace authoritatively as usual.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Network")
+    bool bServerHitValidation = true;
+
+    /** Extra distance (cm) allowed between the claimed blade and the rewound target capsule (absorbs quantization and interpolation error) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Network", meta = (EditCondition = "bServerHitValidation", ClampMin = "0.0"))
+    float HitValidationTolerance = 15.0f;
+
+    /** Max distance (cm) between the claimed blade base and the server's own weapon socket */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Network", meta = (EditCondition = "bServerHitValidation", ClampMin = "0.0"))
+    float MaxClaimPoseError = 150.0f;
+
+    /**
+     * Dedicated servers read the blade from the swing's baked trajectory (UAttackData::SwingVolume) at the current
+     * montage time instead of the evaluated pose. The mesh transform already carries root motion and motion warping
+     * (both move the actor), so only montages need to tick. Swings without a current bake, and hit volume profile
+     * sockets, still read the pose.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Network")
+    bool bServerUseBakedBlade = false;
+
+    /** With bServerUseBakedBlade, switch the dedicated server's owner mesh to OnlyTickMontagesWhenNotRendered at BeginPlay */
+    UPROPERTY(EditDefaultsOnly, Category = "Weapon|Network", meta = (EditCondition = "bServerUseBakedBlade"))
+    bool bServerSkipPoseEvaluation = true;
+
     /** Enable debug visualization */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weapon|Debug")
     bool bDebugDraw = false;
@@ -76,6 +307,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Weapon")
     void EnableHitDetection();
 
+    /**
+     * Enable hit detection for a swing whose attack is already known (notifies, phase begin)
+     * The attack's hit volume poses are seeded now, so the first traced frame already sweeps, and
+     * the window skips the per-frame current attack lookup.
+     * @param SwingAttack - Attack the window belongs to (nullptr = look it up every frame, as EnableHitDetection)
+     */
+    void EnableHitDetectionForAttack(UAttackData* SwingAttack);
+
     /**
      * Disable hit detection (called by AnimNotify_ToggleHitDetection)
      * Stops tracing and preserves hit actor list for current attack
@@ -130,11 +369,41 @@ public:
     bool WasActorAlreadyHit(AActor* Actor) const;
 
     /**
-     * Get list of all actors hit by current attack
-     * @return Array of hit actors
+     * Check if a hit on actor would count now (never hit, or a multi-hit attack with hits left and its rehit cooldown over)
+     * @param Actor - Actor to check
+     * @return True if the next hit on actor is processed
      */
     UFUNCTION(BlueprintPure, Category = "Weapon")
-    TArray<AActor*> GetHitActors() const { return HitActors; }
+    bool CanHitActor(AActor* Actor) const;
+
+    /**
+     * Get list of all actors hit by current attack
+     * @return View of hit actors (no copy, invalidated by ResetHitActors)
+     */
+    TConstArrayView<TObjectPtr<AActor>> GetHitActors() const { return HitActors; }
+
+    /**
+     * Damage route cached for an actor hit this swing
+     * @param Actor - Actor reported by OnWeaponHit
+     * @return Cached route, or nullptr if the actor was not hit this swing
+     */
+    const FWeaponHitTarget* GetHitTarget(const AActor* Actor) const { return Actor ? HitActorKeys.Find(FObjectKey(Actor)) : nullptr; }
+
+    /**
+     * Report a hit by a projectile this weapon launched (UCombatProjectileSubsystem)
+     * Broadcasts like a swing hit, but stays out of the swing's hit list - each projectile tracks its own targets
+     * @param Hit - Hit result from the projectile's sweep
+     * @param AttackData - Attack the projectile was launched with
+     * @return True if the hit was broadcast (false for the owner, or where this weapon isn't the hit authority)
+     */
+    bool ProcessProjectileHit(const FHitResult& Hit, UAttackData* AttackData);
+
+    /**
+     * Blueprint version of GetHitActors
+     * @return Copy of hit actors array
+     */
+    UFUNCTION(BlueprintPure, Category = "Weapon", meta = (DisplayName = "Get Hit Actors"))
+    TArray<AActor*> K2_GetHitActors() const { return HitActors; }
 
     /**
      * Get count of actors hit by current attack
@@ -143,6 +412,18 @@ public:
     UFUNCTION(BlueprintPure, Category = "Weapon")
     int32 GetHitActorCount() const { return HitActors.Num(); }
 
+    /** Blade sockets come from baked trajectories rather than the pose (dedicated server with bServerUseBakedBlade) */
+    bool IsUsingBakedBlade() const { return bBakedBladeActive; }
+
+    /** Frames of the current (or last) swing whose sweeps were skipped by swing volume culling */
+    int32 GetNumSwingFramesCulled() const { return NumSwingFramesCulled; }
+
+    /** Is the open window detected on the async physics tick (bUseAsyncPhysicsTrace)? */
+    bool IsUsingAsyncPhysicsTrace() const { return bAsyncTraceActive; }
+
+    /** Physics steps the current (or last) async swing has run */
+    int32 GetNumAsyncTraceSteps() const { return AsyncTrace.GetNumSteps(); }
+
     // ============================================================================
     // HIT EVENTS
     // ============================================================================
@@ -156,10 +437,20 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Weapon")
     FOnWeaponHit OnWeaponHit;
 
+    /** Native version of OnWeaponHit for C++ listeners (fires first, every hit) */
+    DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnWeaponHitNative, AActor* /*HitActor*/, const FHitResult& /*HitResult*/, UAttackData* /*AttackData*/);
+    FOnWeaponHitNative OnWeaponHitNative;
+
 protected:
     virtual void BeginPlay() override;
 
+    /** Owning client → server: a hit to validate against lag-compensated target poses */
+    UFUNCTION(Server, Reliable)
+    void ServerClaimHit(const FWeaponHitClaim& Claim);
+
 private:
+    friend class UWeaponTraceSubsystem;
+
     // ============================================================================
     // STATE
     // ============================================================================
@@ -172,6 +463,12 @@ private:
     UPROPERTY()
     TArray<TObjectPtr<AActor>> HitActors;
 
+    /** Per-swing hit registry - O(1) membership for HitActors, plus each target's resolved damage route */
+    TMap<FObjectKey, FWeaponHitTarget, TInlineSetAllocator<16>> HitActorKeys;
+
+    /** Collision params for the current swing (built on reset, hit actors appended as they're hit) */
+    FCollisionQueryParams SwingQueryParams;
+
     /** Previous frame's weapon tip location (for swept trace) */
     FVector PreviousTipLocation;
 
@@ -181,6 +478,73 @@ private:
     /** Is this the first trace since hit detection enabled? */
     bool bFirstTrace = true;
 
+    /** World time when hit detection was last enabled (hit volume active ranges are relative to this) */
+    float HitDetectionEnabledTime = 0.0f;
+
+    /** Owner's combat significance, sampled when hit detection is enabled (scales sweep precision for the swing) */
+    ECombatSignificance SwingSignificance;
+
+    /** UCombatBudgetSubsystem trace detail scale, sampled with SwingSignificance (caps substeps and blade samples) */
+    float SwingDetailScale = 1.0f;
+
+    /** Angular substep cap for this swing: MaxSweepSubsteps at High significance, half at Medium, one below */
+    int32 GetSignificanceSubstepCap() const;
+
+    /** Debug drawing is skipped for low-significance owners and ones UCombatDebugDrawSubsystem filters out */
+    bool ShouldDebugDraw() const;
+
+    /** World time when hit detection was last disabled (late claims are accepted for up to MaxRewindTime after) */
+    float HitDetectionDisabledTime = -1.0f;
+
+    /** Default blade pose swept by the last GatherSweepSegments (sent with hit claims) */
+    FVector LastSweepPrevStart = FVector::ZeroVector;
+    FVector LastSweepPrevTip = FVector::ZeroVector;
+    FVector LastSweepStart = FVector::ZeroVector;
+    FVector LastSweepTip = FVector::ZeroVector;
+
+    /** Last GatherSweepSegments swept the default blade (not a hit volume profile or the legacy tip) */
+    bool bLastSweepIsBlade = false;
+
+    /** Resolved at BeginPlay from bServerUseBakedBlade and the net mode */
+    bool bBakedBladeActive = false;
+
+    /** Frames this swing skipped because its swing volume was clear */
+    int32 NumSwingFramesCulled = 0;
+
+    /** Narrowphase scratch (filled and emptied within one call) */
+    FBladeNarrowphase Narrowphase;
+    TArray<UPrimitiveComponent*> NarrowphaseComponents;
+    TArray<AActor*> NarrowphaseCandidates;
+
+    /** Stepped on the physics thread while bAsyncTraceActive */
+    FAsyncBladeTrace AsyncTrace;
+
+    /** The open window is detected by AsyncTrace instead of per-frame sweeps */
+    bool bAsyncTraceActive = false;
+
+    /** Physics doesn't tick async in this project: the game thread steps AsyncTrace once per frame */
+    bool bAsyncTraceStepsOnGameThread = false;
+
+    /** Components behind the capsules of the last published snapshot (hit capsule indices point here) */
+    TArray<TWeakObjectPtr<UPrimitiveComponent>> AsyncTraceComponents;
+
+    /** Attack whose hit volume profile the per-volume poses belong to */
+    UPROPERTY()
+    TObjectPtr<UAttackData> ProfileAttack;
+
+    /** Attack the open window was enabled for (EnableHitDetectionForAttack), cleared on disable */
+    UPROPERTY()
+    TObjectPtr<UAttackData> SwingAttack;
+
+    /** Per-volume poses were seeded on enable - the first gather sweeps from them instead of re-seeding */
+    bool bProfilePosesPrimed = false;
+
+    /** Previous frame's start location per hit volume */
+    TArray<FVector> PreviousVolumeStarts;
+
+    /** Previous frame's tip location per hit volume */
+    TArray<FVector> PreviousVolumeTips;
+
     // ============================================================================
     // CACHED REFERENCES
     // ============================================================================
@@ -193,6 +557,40 @@ private:
     UPROPERTY()
     TObjectPtr<USkeletalMeshComponent> OwnerMesh;
 
+    /** Weapon socket resolved to a bone of the owner mesh's pose */
+    struct FPoseSocket
+    {
+        FName Name;
+        int32 BoneIndex = INDEX_NONE;
+
+        /** Socket relative to its bone (identity when the name is a bone) */
+        FTransform BoneToSocket = FTransform::Identity;
+    };
+
+    /** Start/end sockets for bReadSocketsFromPose (rebuilt when the sockets or the mesh asset change) */
+    mutable FPoseSocket StartPoseSocket;
+    mutable FPoseSocket EndPoseSocket;
+    mutable TWeakObjectPtr<const UObject> PoseSocketAsset;
+    mutable bool bPoseSocketsCached = false;
+
+    /** Resolve the start/end sockets against the owner mesh's current asset */
+    void CachePoseSockets() const;
+
+    /**
+     * Socket location from the component-space pose
+     * @return False if the socket isn't a cached start/end socket or its bone isn't in the pose
+     */
+    bool GetPoseSocketLocation(FName SocketName, FVector& OutLocation) const;
+
+    /**
+     * Start/end socket location from the swing's baked trajectory (bServerUseBakedBlade)
+     * @return False if the socket isn't the start/end socket or the swing has no current bake of them
+     */
+    bool GetBakedSocketLocation(FName SocketName, FVector& OutLocation) const;
+
+    /** Montage time of the attack's playing instance, else extrapolated from when the window opened */
+    float GetSwingMontageTime(const UAttackData* Attack, const FAttackSwingVolume& SwingVolume) const;
+
     // ============================================================================
     // INTERNAL HELPERS
     // ============================================================================
@@ -203,6 +601,114 @@ private:
      */
     void PerformWeaponTrace();
 
+    /**
+     * Build this frame's sweep segments and advance the stored previous blade pose
+     * @param OutSegments - Segments to sweep (appended)
+     * @return True if there is anything to sweep this frame
+     */
+    bool GatherSweepSegments(TArray<FWeaponSweepSegment, TInlineAllocator<16>>& OutSegments);
+
+    /**
+     * Broadphase against the attack's baked swing volume: is no registered target anywhere near this swing?
+     * @return False if culling doesn't apply (disabled, no current bake, no target registry) or a target is inside - sweep as usual
+     */
+    bool IsSwingVolumeClear(const UAttackData* AttackData);
+
+    /**
+     * Resolve the last gathered blade pose with FBladeNarrowphase instead of physics sweeps
+     * @return False if the narrowphase doesn't apply (disabled, not a blade sweep, no target registry) - sweep as usual
+     */
+    bool TryBladeNarrowphase();
+
+    /**
+     * Collect the capsules a blade near Center could hit: hurtboxes of registered targets, or their root capsule when they have none
+     * @param AddCapsule - Called per capsule (skips the owner and actors that can't be hit now)
+     */
+    void GatherTargetCapsules(const FVector& Center, float Reach, TFunctionRef<void(UCapsuleComponent*)> AddCapsule);
+
+    /** Hand the window to AsyncTrace if bUseAsyncPhysicsTrace applies to the swing, per-frame tracing otherwise */
+    void StartAsyncTrace();
+
+    /** Game thread half of the async trace: deliver the steps' hits and publish this frame's blade and targets */
+    void UpdateAsyncTrace(float DeltaTime);
+
+    /** Turn async trace hits against the last published capsules into ProcessHit calls */
+    void DeliverAsyncTraceHits(TConstArrayView<FAsyncBladeTrace::FHit> Hits);
+
+    /**
+     * Collision params for this weapon's sweeps (owner and already-hit actors ignored)
+     * @return Params maintained incrementally for the current swing
+     */
+    const FCollisionQueryParams& GetSweepQueryParams() const { return SwingQueryParams; }
+
+    /** Rebuild SwingQueryParams from scratch (owner only, called when the hit list resets) */
+    void ResetSwingQueryParams();
+
+    /**
+     * Process results from one sweep segment (sync or batched)
+     * @param HitResults - Hits returned by the sweep
+     * @param Start - Segment start (debug draw)
+     * @param End - Segment end (debug draw)
+     */
+    void ProcessSweepResults(const TArray<FHitResult>& HitResults, const FVector& Start, const FVector& End);
+
+    /**
+     * Build segments for the current attack's hit volume profile (replaces the default sweep)
+     * Tracks a previous pose per volume; volumes outside their phase/active range are skipped
+     * @param Profile - Hit volume profile from the current attack
+     * @param AttackData - Attack owning the profile (poses reseed when it changes)
+     * @param OutSegments - Segments to sweep (appended)
+     */
+    void GatherProfileSweepSegments(const FAttackHitVolumeProfile& Profile, UAttackData* AttackData, TArray<FWeaponSweepSegment, TInlineAllocator<16>>& OutSegments);
+
+    /**
+     * Build sphere segments for start→tip sample points between two blade poses
+     * Sample count and substep count adapt to blade length, angular velocity and SweepSpatialTolerance
+     * @param PrevStart - Last frame's base location
+     * @param PrevTip - Last frame's tip location
+     * @param StartLocation - Current base location
+     * @param EndLocation - Current tip location
+     * @param Radius - Sphere radius
+     * @param OutSegments - Segments to sweep (appended)
+     */
+    void BuildBladeSweepSegments(const FVector& PrevStart, const FVector& PrevTip, const FVector& StartLocation, const FVector& EndLocation, float Radius, TArray<FWeaponSweepSegment, TInlineAllocator<16>>& OutSegments) const;
+
+    /**
+     * Build segments for a single authored hit volume between two poses
+     * Capsules/boxes span the whole start→tip segment and are only substepped angularly
+     * @param Volume - Authored volume
+     * @param PrevStart - Last frame's base location
+     * @param PrevTip - Last frame's tip location
+     * @param StartLocation - Current base location
+     * @param EndLocation - Current tip location
+     * @param OutSegments - Segments to sweep (appended)
+     */
+    void BuildVolumeSweepSegments(const FAttackHitVolume& Volume, const FVector& PrevStart, const FVector& PrevTip, const FVector& StartLocation, const FVector& EndLocation, TArray<FWeaponSweepSegment, TInlineAllocator<16>>& OutSegments) const;
+
+    /**
+     * Interpolate blade poses (base + start→tip vector) at each substep boundary
+     * Base moves linearly; blade direction rotates about the base so the tip follows an arc
+     */
+    static void BuildBladePoses(const FVector& PrevStart, const FVector& PrevTip, const FVector& StartLocation, const FVector& EndLocation, int32 NumSubsteps,
+                                TArray<FVector, TInlineAllocator<17>>& OutBases, TArray<FVector, TInlineAllocator<17>>& OutBlades);
+
+    /**
+     * Calculate how many angular substeps are needed so the chord between substeps
+     * deviates from the tip's arc by no more than SweepSpatialTolerance
+     * @param PreviousBlade - Last frame's start→tip vector
+     * @param CurrentBlade - This frame's start→tip vector
+     * @return Substep count in [1, MaxSweepSubsteps]
+     */
+    int32 CalculateSweepSubsteps(const FVector& PreviousBlade, const FVector& CurrentBlade) const;
+
+    /**
+     * Calculate how many sample points are needed along the blade so adjacent swept spheres overlap within tolerance
+     * @param BladeLength - Start→tip length
+     * @param Radius - Sphere radius being swept
+     * @return Sample count in [2, MaxBladeSamplePoints], fewer while the trace budget is exceeded
+     */
+    int32 CalculateBladeSamplePoints(float BladeLength, float Radius) const;
+
     /**
      * Process a hit result
      * Checks if actor was already hit, adds to list, broadcasts event
@@ -210,11 +716,38 @@ private:
      */
     void ProcessHit(const FHitResult& Hit);
 
+    /** Trace output, OnWeaponHit and the combat event for a hit that counts (swing or projectile) */
+    void BroadcastHit(AActor* HitActor, const FHitResult& Hit, UAttackData* AttackData);
+
+    /** How this instance participates in hit detection under bServerHitValidation */
+    enum class EHitAuthority : uint8
+    {
+        /** Trace and broadcast locally (standalone, or owner controlled on the server) */
+        Local,
+        /** Owning client: trace, send claims, don't broadcast */
+        Claim,
+        /** Server for a remote owner: no tracing, validate claims */
+        Validate,
+        /** Other clients' copies: no hit detection */
+        None
+    };
+    EHitAuthority GetHitAuthority() const;
+
+    /**
+     * Re-run the swept blade check for a claim against the target's rewound capsule
+     * @param Claim - Client's claim
+     * @param OutHit - Synthesized hit on success
+     * @return True if the claim holds up
+     */
+    bool ValidateHitClaim(const FWeaponHitClaim& Claim, FHitResult& OutHit) const;
+
     /**
-     * Add actor to hit list
+     * Add actor to hit list, or count another hit on it
+     * Exhausted targets are ignored by the swing's sweeps; multi-hit targets stay traceable until then.
      * @param Actor - Actor to add
+     * @param AttackData - Attack whose rehit rules apply (nullptr = single hit)
      */
-    void AddHitActor(AActor* Actor);
+    void AddHitActor(AActor* Actor, const UAttackData* AttackData);
 
     /**
      * Get current attack data from combat component
@@ -222,6 +755,18 @@ private:
      */
     UAttackData* GetCurrentAttackData() const;
 
+    /**
+     * Attack the current swing is charged to
+     * @return The window's attack if it was opened for one, the current attack data otherwise
+     */
+    UAttackData* GetSwingAttack() const { return SwingAttack ? SwingAttack.Get() : GetCurrentAttackData(); }
+
+    /**
+     * Get current attack phase from combat component
+     * @return Current phase, or None if unknown
+     */
+    EAttackPhase GetCurrentAttackPhase() const;
+
     /**
      * Draw debug visualization for trace
      * @param Start - Trace start location
@@ -0,0 +1,151 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "Core/CombatProjectileSubsystem.h"
+#include "WeaponTraceSubsystem.generated.h"
+
+class UWeaponComponent;
+
+/** Receives the hits of a queued melee trace */
+DECLARE_DELEGATE_OneParam(FOnMeleeTraceHits, const TArray<FHitResult>& /*Hits*/);
+
+/**
+ * One-shot sphere sweep for attackers without a UWeaponComponent (e.g. ACombatEnemy/ACombatCharacter)
+ * Object types are filtered by the physics scene rather than per hit
+ */
+struct FMeleeTraceRequest
+{
+    FVector Start = FVector::ZeroVector;
+    FVector End = FVector::ZeroVector;
+    float Radius = 0.0f;
+
+    /** Multi collects every hit along the sweep, Single stops at the first */
+    EAsyncTraceType TraceType = EAsyncTraceType::Multi;
+
+    FCollisionObjectQueryParams ObjectParams;
+    FCollisionQueryParams QueryParams;
+};
+
+/**
+ * Batches weapon hit detection for every active UWeaponComponent in the world
+ * 
+ * Instead of each weapon ticking and sweeping synchronously, weapons with bUseBatchedTraces
+ * register here while hit detection is enabled. Each frame the subsystem:
+ * 1. Delivers results of last frame's async sweeps (OnWeaponHit fires in one pass)
+ * 2. Gathers this frame's sweep segments from all registered weapons
+ * 3. Submits them as one batch via AsyncSweepByChannel
+ * 
+ * Trace cost scales with active swings rather than weapon component count.
+ * 
+ * One-shot melee traces (QueueMeleeTrace) share the same pipeline: they are submitted
+ * async when queued and delivered in the first pass after the frame they were queued on.
+ * Projectile sweeps (UCombatProjectileSubsystem) are delivered the same way, straight back
+ * to the projectile subsystem instead of through a per-trace delegate.
+ */
+UCLASS()
+class KATANACOMBAT_API UWeaponTraceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SUBSYSTEM
+    // ============================================================================
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    // ============================================================================
+    // REGISTRATION
+    // ============================================================================
+
+    /**
+     * Start batching traces for a weapon (called from EnableHitDetection)
+     * @param Weapon - Weapon component with hit detection enabled
+     */
+    void RegisterWeapon(UWeaponComponent* Weapon);
+
+    /**
+     * Stop batching traces for a weapon (called from DisableHitDetection)
+     * Sweeps already in flight are still delivered next frame
+     * @param Weapon - Weapon component to remove
+     */
+    void UnregisterWeapon(UWeaponComponent* Weapon);
+
+    /**
+     * Queue a one-shot async melee sweep
+     * @param Request - Sweep shape, object types and params
+     * @param OnHits - Called with the hits next frame (not called if the trace is lost, e.g. on world teardown)
+     */
+    void QueueMeleeTrace(const FMeleeTraceRequest& Request, FOnMeleeTraceHits&& OnHits);
+
+    /**
+     * Queue a projectile's sweep for this frame (called by UCombatProjectileSubsystem)
+     * @param Projectile - Projectile the hits are handed back for next frame
+     * @param Request - Sweep shape, object types and params
+     */
+    void QueueProjectileTrace(FCombatProjectileHandle Projectile, const FMeleeTraceRequest& Request);
+
+    /** Number of weapons currently submitting sweeps */
+    int32 GetActiveWeaponCount() const { return ActiveWeapons.Num(); }
+
+    /** Number of async sweeps awaiting delivery */
+    int32 GetPendingTraceCount() const { return PendingTraces.Num() + PendingMeleeTraces.Num() + PendingProjectileTraces.Num(); }
+
+private:
+    /** Async sweep in flight, tagged with the weapon that requested it */
+    struct FPendingWeaponTrace
+    {
+        TWeakObjectPtr<UWeaponComponent> Weapon;
+        FTraceHandle Handle;
+    };
+
+    /** One-shot melee sweep in flight */
+    struct FPendingMeleeTrace
+    {
+        FOnMeleeTraceHits OnHits;
+        FTraceHandle Handle;
+        uint64 SubmitFrame = 0;
+    };
+
+    /** Projectile sweep in flight */
+    struct FPendingProjectileTrace
+    {
+        FCombatProjectileHandle Projectile;
+        FTraceHandle Handle;
+        uint64 SubmitFrame = 0;
+    };
+
+    /** Weapons with hit detection enabled in batched mode */
+    TArray<TWeakObjectPtr<UWeaponComponent>> ActiveWeapons;
+
+    /** Sweeps submitted last frame, delivered at the start of this frame's pass */
+    TArray<FPendingWeaponTrace> PendingTraces;
+
+    /** Melee sweeps queued by non-weapon attackers */
+    TArray<FPendingMeleeTrace> PendingMeleeTraces;
+
+    /** Projectile sweeps, one per projectile in flight per frame */
+    TArray<FPendingProjectileTrace> PendingProjectileTraces;
+
+    /** Kept between deliveries so the projectile batch doesn't allocate every frame */
+    TArray<FPendingProjectileTrace> DeliveringProjectileTraces;
+
+    /** Deliver completed async sweeps to their weapons */
+    void DeliverPendingTraces();
+
+    /** Deliver melee sweeps queued before this frame */
+    void DeliverPendingMeleeTraces();
+
+    /** Hand projectile sweeps queued before this frame back to the projectile subsystem */
+    void DeliverPendingProjectileTraces();
+
+    /** Gather segments from all active weapons and submit async sweeps */
+    void SubmitWeaponTraces();
+};
@@ -26,6 +26,11 @@ class UAttackData;
  * - Reference from CombatSettings to create complete combat presets
  * - Mix and match with different CombatSettings for variety
  *
+ * Asset bundles (UAssetManager / UComboPreloadSubsystem::PreloadMoveset):
+ * - "Core": soft combo links within CoreBundleDepth of the default attacks
+ * - "Extended": the movement attacks and every other soft link reachable from the moveset
+ * Only soft links stream; hard links load with the configuration as before.
+ *
  * Example:
  * - AttackConfig_Katana: Fast, light attacks with quick directional follow-ups
  * - AttackConfig_Greatsword: Slow, heavy attacks with powerful directional slashes
@@ -56,14 +61,41 @@ public:
 	// ============================================================================
 
 	/** Sprint attack (attack while sprinting - not yet implemented) */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Attacks")
-	TObjectPtr<UAttackData> SprintAttack;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Attacks", meta = (AssetBundles = "Extended"))
+	TSoftObjectPtr<UAttackData> SprintAttack;
 
 	/** Jump attack (attack while jumping - not yet implemented) */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Attacks")
-	TObjectPtr<UAttackData> JumpAttack;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Attacks", meta = (AssetBundles = "Extended"))
+	TSoftObjectPtr<UAttackData> JumpAttack;
 
 	/** Plunging attack (attack while falling - not yet implemented) */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Attacks")
-	TObjectPtr<UAttackData> PlungingAttack;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Attacks", meta = (AssetBundles = "Extended"))
+	TSoftObjectPtr<UAttackData> PlungingAttack;
+
+	// ============================================================================
+	// ASSET BUNDLES
+	// ============================================================================
+
+	/** Bundle with the first follow-ups of the default attacks (load wherever this moveset can fight) */
+	static const FName CoreBundleName;
+
+	/** Bundle with the rest of the moveset (load when the full moveset is in play) */
+	static const FName ExtendedBundleName;
+
+	/** Combo links from the default attacks that go in the Core bundle */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Bundles", meta = (ClampMin = "0", ClampMax = "8"))
+	int32 CoreBundleDepth = 1;
+
+	/**
+	 * Soft paths in a bundle, walked from the loaded moveset
+	 * Stops at soft links that aren't loaded yet (their nodes are found once they arrive)
+	 * @param BundleName - CoreBundleName or ExtendedBundleName
+	 * @param bOutHasUnloaded - Set when the walk stopped at an unloaded soft link
+	 */
+	void GatherBundlePaths(FName BundleName, TArray<FSoftObjectPath>& OutPaths, bool& bOutHasUnloaded) const;
+
+#if WITH_EDITORONLY_DATA
+	/** Adds the combo graph to the bundles the Asset Manager cooks (loads soft links to walk the whole graph) */
+	virtual void UpdateAssetBundleData() override;
+#endif
 };
\ No newline at end of file
@@ -8,10 +8,231 @@
 #include "GameplayTagContainer.h"
 #include "CombatTypes.h"
 #include "Utilities/MontageUtilityLibrary.h"
+#include "ActionQueueTypes.h"
+#include "Data/CombatContextMask.h"
 #include "AttackData.generated.h"
 
 class UAnimMontage;
 
+/**
+ * Cooked timing block for one attack
+ * Generated in editor from the montage's notifies/sections (on save, and when the montage or
+ * section changes) so runtime queries never scan AttackMontage->Notifies.
+ * Stale when the attack's montage/section no longer match the source it was built from.
+ */
+USTRUCT()
+struct KATANACOMBAT_API FAttackTimingCache
+{
+    GENERATED_BODY()
+
+    /** Montage this block was generated from */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    TObjectPtr<UAnimMontage> SourceMontage = nullptr;
+
+    /** Section this block was generated from */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    FName SourceSection = NAME_None;
+
+    /** Section start (montage time) */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    float SectionStart = 0.0f;
+
+    /** Section end (montage time) */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    float SectionEnd = 0.0f;
+
+    /** Windup → Active boundary (AnimNotify_AttackPhaseTransition, montage time, -1 = none) */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    float ActiveTransitionTime = -1.0f;
+
+    /** Active → Recovery boundary (AnimNotify_AttackPhaseTransition, montage time, -1 = none) */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    float RecoveryTransitionTime = -1.0f;
+
+    /** Required phase notifies present in the section (see HasValidNotifyTimingInSection) */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    bool bHasValidNotifyTiming = false;
+
+    /** Deprecated AnimNotifyState_AttackPhase states found in the section */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    bool bHasLegacyPhaseStates = false;
+
+    /**
+     * Effective phase durations, folded when the block is generated: legacy AnimNotifyState_AttackPhase
+     * durations when all three states were found (and notify timing is on), else the manual timing.
+     * Cooked builds only carry this copy - the deprecated timing properties are editor-only data.
+     */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    FAttackPhaseTimingOverride PhaseDurations;
+
+    /** All three legacy phase states were found (PhaseDurations comes from them) */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    bool bHasLegacyPhaseDurations = false;
+
+    /** Combo/parry/hold windows starting inside the section, sorted by montage time */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    TArray<FTimerCheckpoint> Windows;
+
+    /** Montage extracts root motion (offsets below are zero otherwise) */
+    UPROPERTY(VisibleAnywhere, Category = "Root Motion")
+    bool bHasRootMotion = false;
+
+    /** Root motion over the whole section (root space, cm) */
+    UPROPERTY(VisibleAnywhere, Category = "Root Motion")
+    FVector RootMotionDisplacement = FVector::ZeroVector;
+
+    /** Root motion from section start to the start of Active (root space, cm) */
+    UPROPERTY(VisibleAnywhere, Category = "Root Motion")
+    FVector ActiveStartOffset = FVector::ZeroVector;
+
+    /** Root motion from section start to the end of Active (root space, cm) */
+    UPROPERTY(VisibleAnywhere, Category = "Root Motion")
+    FVector ActiveEndOffset = FVector::ZeroVector;
+
+    /** Was this block generated at all? */
+    UPROPERTY(VisibleAnywhere, Category = "Timing")
+    bool bIsBuilt = false;
+
+    /** Was this block generated from this montage/section? */
+    bool IsValidFor(const UAnimMontage* Montage, FName Section) const
+    {
+        return bIsBuilt && SourceMontage == Montage && SourceSection == Section;
+    }
+
+    /** Same timing as another block (tolerant float compare) */
+    bool Matches(const FAttackTimingCache& Other) const;
+};
+
+/**
+ * Baked blade trajectory for one attack: the weapon sockets sampled across the Active phase
+ * Generated in editor (UAttackDataTools::BakeSwingVolume) from the montage pose at a fixed rate.
+ * Positions are owner-mesh component space, quantized to 16 bits per axis across Bounds; Bounds is
+ * conservative (every sampled pose, inflated by Radius) so UWeaponComponent can skip a frame's sweeps
+ * when no registered target is near the swing at all.
+ */
+USTRUCT()
+struct KATANACOMBAT_API FAttackSwingVolume
+{
+    GENERATED_BODY()
+
+    /** Montage the trajectory was sampled from */
+    UPROPERTY(VisibleAnywhere, Category = "Swing Volume")
+    TObjectPtr<UAnimMontage> SourceMontage = nullptr;
+
+    /** Section the trajectory was sampled from */
+    UPROPERTY(VisibleAnywhere, Category = "Swing Volume")
+    FName SourceSection = NAME_None;
+
+    /** Blade sockets that were sampled */
+    UPROPERTY(VisibleAnywhere, Category = "Swing Volume")
+    FName StartSocket = NAME_None;
+
+    UPROPERTY(VisibleAnywhere, Category = "Swing Volume")
+    FName EndSocket = NAME_None;
+
+    /** Blade radius the bounds were inflated by (cm) */
+    UPROPERTY(VisibleAnywhere, Category = "Swing Volume")
+    float Radius = 0.0f;
+
+    /** Seconds between samples (montage time) */
+    UPROPERTY(VisibleAnywhere, Category = "Swing Volume")
+    float SampleInterval = 0.0f;
+
+    /** Montage time of the first sample */
+    UPROPERTY(VisibleAnywhere, Category = "Swing Volume")
+    float StartTime = 0.0f;
+
+    /** Montage time the hit window opens (Active start; samples begin one interval earlier) */
+    UPROPERTY(VisibleAnywhere, Category = "Swing Volume")
+    float WindowStartTime = 0.0f;
+
+    /** Component-space box around every sampled blade pose, inflated by Radius */
+    UPROPERTY(VisibleAnywhere, Category = "Swing Volume")
+    FBox Bounds = FBox(ForceInit);
+
+    /** Per sample: start xyz, tip xyz, each 0..65535 across Bounds */
+    UPROPERTY()
+    TArray<uint16> QuantizedPoses;
+
+    /** Values per sample in QuantizedPoses */
+    static constexpr int32 ValuesPerSample = 6;
+
+    int32 GetNumSamples() const { return QuantizedPoses.Num() / ValuesPerSample; }
+
+    /** Was this trajectory baked from this montage/section? */
+    bool IsValidFor(const UAnimMontage* Montage, FName Section) const
+    {
+        return GetNumSamples() > 0 && SourceMontage == Montage && SourceSection == Section;
+    }
+
+    /** Sampled blade pose (component space, within half a quantization step) */
+    void GetSample(int32 Index, FVector& OutStart, FVector& OutTip) const;
+
+    /** Blade pose at a montage time, interpolated between samples (clamped to the baked range) */
+    void SampleAtTime(float MontageTime, FVector& OutStart, FVector& OutTip) const;
+
+    /** Bounds and quantize sampled blade poses (Starts and Tips pair up; sources and sockets are left to the caller) */
+    void Build(TConstArrayView<FVector> Starts, TConstArrayView<FVector> Tips, float InRadius);
+
+    void Reset();
+};
+
+/**
+ * One stage of a multi-stage charged hold (light hold or heavy charge)
+ * A stage is reached once the input has been held for HoldTime; releasing in it uses its multipliers.
+ */
+USTRUCT(BlueprintType)
+struct KATANACOMBAT_API FChargeStage
+{
+    GENERATED_BODY()
+
+    /** Seconds held before this stage is reached */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Charge", meta = (ClampMin = "0.0", Units = "s"))
+    float HoldTime = 0.5f;
+
+    /** Montage playrate from this stage on (< 0 = leave the hold's own playrate alone) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Charge")
+    float PlayRate = -1.0f;
+
+    /** Damage multiplier when released in this stage */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Charge", meta = (ClampMin = "0.0"))
+    float DamageMultiplier = 1.0f;
+
+    /** Posture damage multiplier when released in this stage */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Charge", meta = (ClampMin = "0.0"))
+    float PostureDamageMultiplier = 1.0f;
+
+    /** Sent with the stage change (anim layers, VFX, audio cues) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Charge")
+    FGameplayTag StageTag;
+};
+
+/**
+ * ChargeStages compiled for runtime: sorted by HoldTime, at most a handful of entries
+ * Stage indices are into the sorted table; INDEX_NONE = held, but before the first stage.
+ */
+struct KATANACOMBAT_API FChargeStageTable
+{
+    TArray<FChargeStage, TInlineAllocator<4>> Stages;
+
+    /** Sort authored stages into a table (negative hold times clamp to 0) */
+    static void Build(TConstArrayView<FChargeStage> Authored, FChargeStageTable& OutTable);
+
+    int32 Num() const { return Stages.Num(); }
+    bool IsEmpty() const { return Stages.Num() == 0; }
+
+    const FChargeStage* GetStage(int32 Stage) const { return Stages.IsValidIndex(Stage) ? &Stages[Stage] : nullptr; }
+
+    /** Stage reached after holding for HoldTime */
+    int32 FindStage(float HoldTime) const;
+
+    /** Hold time at which the stage after Stage begins (< 0 if Stage is the last) */
+    float GetNextStageTime(int32 Stage) const
+    {
+        return Stages.IsValidIndex(Stage + 1) ? Stages[Stage + 1].HoldTime : -1.0f;
+    }
+};
+
 /**
  * Defines a single attack's properties and behavior
  * Extended with combo chains, posture damage, and montage section support
@@ -53,6 +274,16 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attack|Montage Section")
     bool bJumpToSectionStart = true;
 
+    /**
+     * If true and the previous attack is still playing this same montage, jump the running instance to
+     * MontageSection instead of starting a new one (no blend - sections should flow into each other)
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attack|Montage Section")
+    bool bJumpWithinSharedMontage = true;
+
+    /** Section whose checkpoints apply to this attack (NAME_None = whole montage, when later sections play on) */
+    FName GetCheckpointSection() const { return bUseSectionOnly ? MontageSection : NAME_None; }
+
     // ============================================================================
     // DAMAGE & POSTURE
     // ============================================================================
@@ -72,6 +303,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
     float HitStunDuration = 0.0f;
 
+    /** Hit-stop on attacker and victim when this attack lands (< 0 = CombatSettings default, 0 = none) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+    float HitStopDuration = -1.0f;
+
     // ============================================================================
     // COMBO SYSTEM
     // ============================================================================
@@ -92,6 +327,29 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combos")
     TMap<EAttackDirection, TObjectPtr<UAttackData>> HeavyDirectionalFollowUps;
 
+    // ============================================================================
+    // COMBO STREAMING (Soft links - loaded ahead of use by UComboPreloadSubsystem)
+    // ============================================================================
+    // Soft links are used when the matching hard link above is empty. They keep the
+    // combo graph (and every montage it references) out of the character's load;
+    // the preloader streams the nodes reachable from the current attack instead.
+
+    /** Soft light combo link (used when NextComboAttack is empty) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combos|Streaming")
+    TSoftObjectPtr<UAttackData> SoftNextComboAttack;
+
+    /** Soft heavy combo link (used when HeavyComboAttack is empty) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combos|Streaming")
+    TSoftObjectPtr<UAttackData> SoftHeavyComboAttack;
+
+    /** Soft directional follow-ups (used for directions missing from DirectionalFollowUps) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combos|Streaming")
+    TMap<EAttackDirection, TSoftObjectPtr<UAttackData>> SoftDirectionalFollowUps;
+
+    /** Soft heavy directional follow-ups (used for directions missing from HeavyDirectionalFollowUps) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combos|Streaming")
+    TMap<EAttackDirection, TSoftObjectPtr<UAttackData>> SoftHeavyDirectionalFollowUps;
+
     /** Time window for combo input (after this attack starts recovery) */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combos")
     float ComboInputWindow = 0.6f;
@@ -110,6 +368,16 @@ public:
         meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "0.5"))
     float ComboBlendInTime = 0.1f;
 
+    /**
+     * How a combo transition INTO this attack blends
+     * Standard: both montages are evaluated while the previous one blends out.
+     * Inertialization: the previous montage is cut and the pose difference decays over
+     * max(ComboBlendOutTime, ComboBlendInTime), so only one montage is evaluated during rapid chains.
+     * Requires an Inertialization node after the montage slot in the AnimBP (without one the cut pops).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combos|Blending")
+    EMontageBlendMode ComboBlendMode = EMontageBlendMode::Standard;
+
     // ============================================================================
     // HEAVY ATTACK CHARGING (Only visible when AttackType == Heavy)
     // ============================================================================
@@ -193,6 +461,25 @@ public:
         meta = (EditCondition = "AttackType == EAttackType::Light && bCanHold", EditConditionHides))
     EEasingType HoldEaseOutType = EEasingType::EaseInQuad;
 
+    // ============================================================================
+    // CHARGE STAGES (Light holds and heavy charges)
+    // ============================================================================
+
+    /**
+     * Stages the hold passes through while the input stays down (any order, sorted when compiled)
+     * Transitions are scheduled on the combat timer wheel when the hold starts, so nothing runs
+     * between stage boundaries; each change is broadcast (UCombatComponent::OnChargeStageChanged)
+     * and published to the anim instance.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attack Type|Charge Stages")
+    TArray<FChargeStage> ChargeStages;
+
+    /** ChargeStages compiled into a sorted table (lazy; recompiled after InvalidateChargeStageTable) */
+    const FChargeStageTable& GetChargeStageTable() const;
+
+    /** Recompile the stage table on next use (after editing ChargeStages at runtime) */
+    void InvalidateChargeStageTable() { bChargeStageTableBuilt = false; }
+
     // ============================================================================
     // TIMING SYSTEM (Event-Based Phase Transitions)
     // ============================================================================
@@ -203,8 +490,10 @@ public:
     // - Recovery end is implicit (montage end)
     //
     // DEPRECATED: Old AnimNotifyState_AttackPhase system (6 events per attack)
-    // These properties are kept for backward compatibility but are no longer used
+    // These properties are kept for backward compatibility in editor only - their effect is folded
+    // into TimingCache.PhaseDurations when the block is generated (and on cook)
 
+#if WITH_EDITORONLY_DATA
     /** DEPRECATED: Timing is now always event-driven (AnimNotify_AttackPhaseTransition) */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Timing (Deprecated)")
     bool bUseAnimNotifyTiming = true;
@@ -218,6 +507,7 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Timing (Deprecated)",
         meta = (EditCondition = "!bUseAnimNotifyTiming", EditConditionHides))
     FAttackPhaseTimingOverride ManualTiming;
+#endif
 
     // ============================================================================
     // MOTION WARPING
@@ -226,6 +516,41 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Motion Warping")
     FMotionWarpingConfig MotionWarpingConfig;
 
+    // ============================================================================
+    // HIT VOLUMES
+    // ============================================================================
+
+    /**
+     * Shapes traced by UWeaponComponent for this attack
+     * Leave empty to use the weapon's default blade sweep
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Volumes")
+    FAttackHitVolumeProfile HitVolumeProfile;
+
+    /**
+     * Blade trajectory over the Active phase, baked in editor (Attack Data Tools → Bake Swing Volume)
+     * Lets UWeaponComponent skip sweeps while no target is inside the swing. Rebake after retiming the montage.
+     */
+    UPROPERTY(VisibleAnywhere, Category = "Hit Volumes", AdvancedDisplay)
+    FAttackSwingVolume SwingVolume;
+
+    /**
+     * Times one hit window may hit the same target (flurries, spinning slashes)
+     * 1 = the usual single hit per target per window
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Volumes|Multi-Hit", meta = (ClampMin = "1", ClampMax = "255"))
+    int32 MaxHitsPerTarget = 1;
+
+    /** Shortest time between two hits on the same target (seconds) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Volumes|Multi-Hit", meta = (EditCondition = "MaxHitsPerTarget > 1", ClampMin = "0.0", Units = "s"))
+    float RehitInterval = 0.2f;
+
+    /** Baked swing volume when it matches the current montage/section (nullptr = not baked or stale) */
+    const FAttackSwingVolume* GetSwingVolume() const
+    {
+        return SwingVolume.IsValidFor(AttackMontage, MontageSection) ? &SwingVolume : nullptr;
+    }
+
     // ============================================================================
     // CONTEXT & TAGS (V2 Combat System)
     // ============================================================================
@@ -255,6 +580,23 @@ public:
         meta = (Categories = "Context"))
     FGameplayTagContainer RequiredContextTags;
 
+    /**
+     * Context that makes this attack unusable (any active tag blocks it)
+     * Example: Context.Airborne on a grounded finisher
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Context|Tags",
+        meta = (Categories = "Context"))
+    FGameplayTagContainer BlockedContextTags;
+
+    /**
+     * Context-sensitive replacements (PRIORITY 1 in attack resolution)
+     * When this attack is current (or is the default for the input), the first variant of the
+     * input's attack type whose RequiredContextTags are all active and BlockedContextTags are not wins.
+     * Variants without RequiredContextTags are ignored.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Context|Tags")
+    TArray<TObjectPtr<UAttackData>> ContextVariants;
+
     // ============================================================================
     // RUNTIME QUERIES (used by CombatComponent)
     // ============================================================================
@@ -267,6 +609,17 @@ public:
     UFUNCTION(BlueprintPure, Category = "Attack Data")
     float GetSectionLength() const;
 
+    /** Forward distance root motion carries the attacker by the end of Active (cm, from the cooked block) */
+    UFUNCTION(BlueprintPure, Category = "Attack Data")
+    float GetActiveReach() const;
+
+    /**
+     * Farthest target this attack can close on: active reach plus the warp allowance
+     * (MotionWarpingConfig.MaxWarpDistance when translation warping is enabled)
+     */
+    UFUNCTION(BlueprintPure, Category = "Attack Data")
+    float GetMaxTargetDistance() const;
+
     /** DEPRECATED: Check if attack has valid phase transitions (always returns true for new system) */
     UFUNCTION(BlueprintPure, Category = "Attack Data")
     bool HasValidNotifyTimingInSection() const;
@@ -275,6 +628,111 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Attack Data")
     void GetEffectiveTiming(float& OutWindup, float& OutActive, float& OutRecovery) const;
 
+    // ============================================================================
+    // COOKED TIMING
+    // ============================================================================
+
+    /**
+     * Timing block for the current montage/section
+     * Returns the cooked block when it matches; otherwise builds into Scratch (e.g. montage assigned at runtime)
+     */
+    const FAttackTimingCache& GetTimingCache(FAttackTimingCache& Scratch) const;
+
+    /**
+     * Scan the montage's notifies and sections into a timing block (the only notify scan)
+     * Cooked builds have no manual timing - blocks built at runtime reuse the cooked PhaseDurations
+     */
+    void BuildTimingCache(FAttackTimingCache& OutCache) const;
+
+    /** Regenerate the cooked block from the current montage/section */
+    void RefreshTimingCache();
+
+    /** Cooked timing block (generated in editor, saved with the asset) */
+    UPROPERTY(VisibleAnywhere, Category = "Timing|Cooked", AdvancedDisplay)
+    FAttackTimingCache TimingCache;
+
+private:
+    /** Compile Required/BlockedContextTags against the current tag table (lazy, per table generation) */
+    void CompileContextMasks() const;
+
+    mutable FCombatContextMask RequiredContextMask;
+    mutable FCombatContextMask BlockedContextMask;
+    mutable EResolutionPath ContextResolutionPath = EResolutionPath::ContextSensitive;
+    mutable uint32 ContextMaskGeneration = 0;
+
+    mutable FChargeStageTable ChargeStageTable;
+    mutable bool bChargeStageTableBuilt = false;
+
+public:
+
+    // ============================================================================
+    // COMBO LINK QUERIES (hard link first, then loaded soft link)
+    // ============================================================================
+
+    /** Chain link for an input (nullptr if none, or if the soft link is not loaded yet) */
+    UAttackData* GetComboLink(EInputType InputType) const;
+
+    /** Light combo link (NextComboAttack, else loaded SoftNextComboAttack) */
+    UAttackData* GetNextComboAttack() const { return GetComboLink(EInputType::LightAttack); }
+
+    /** Heavy combo link (HeavyComboAttack, else loaded SoftHeavyComboAttack) */
+    UAttackData* GetHeavyComboAttack() const { return GetComboLink(EInputType::HeavyAttack); }
+
+    /**
+     * Directional follow-up for an input and direction
+     * @param bOutHasEntry - Set when the direction is mapped at all (even to nothing / an unloaded asset)
+     * @return Follow-up attack, or nullptr if unmapped or not loaded yet
+     */
+    UAttackData* GetDirectionalFollowUp(EInputType InputType, EAttackDirection InDirection, bool* bOutHasEntry = nullptr) const;
+
+    /** Does this attack have any directional follow-ups (hard or soft) for an input? */
+    bool HasDirectionalFollowUps(EInputType InputType) const;
+
+    /** Does this attack link anywhere (hard or soft, loaded or not)? */
+    bool HasComboBranches() const;
+
+    // ============================================================================
+    // CONTEXT MATCHING (compiled tag bitmasks)
+    // ============================================================================
+
+    /**
+     * Is this attack usable in the given context?
+     * Two mask ANDs; falls back to container queries only if a tag did not get a bit
+     * @param ActiveMask - Compiled active context (FCombatContextTagTable::MakeActiveMask)
+     * @param ActiveContext - Same context as tags (only read on overflow)
+     */
+    bool MatchesContext(const FCombatContextMask& ActiveMask, const FGameplayTagContainer& ActiveContext) const;
+
+    /** Resolution path reported when this attack is picked as a context variant */
+    EResolutionPath GetContextResolutionPath() const;
+
+    /** Recompile context masks on next match (after editing context tags at runtime) */
+    void InvalidateContextMasks() { ContextMaskGeneration = 0; }
+
+    /**
+     * Visit every combo link out of this attack
+     * @param Visitor - Called with the soft path (empty for hard links) and the resolved attack (nullptr if not loaded)
+     */
+    void ForEachComboLink(TFunctionRef<void(const FSoftObjectPath& SoftPath, UAttackData* Attack)> Visitor) const;
+
+    // ============================================================================
+    // ASSET REGISTRY TAGS (editor queries run from metadata, no load)
+    // ============================================================================
+
+    /** Montage object path (empty if unset) */
+    static const FName AttackMontageTagName;
+
+    /** Montage section name */
+    static const FName MontageSectionTagName;
+
+    /** EAttackType name (e.g. "Light") */
+    static const FName AttackTypeTagName;
+
+    /** Object paths of every combo link (ForEachComboLink order), ';'-separated */
+    static const FName ComboLinksTagName;
+
+    virtual void GetAssetRegistryTags(FAssetRegistryTagsContext Context) const override;
+
 #if WITH_EDITOR
     // ============================================================================
     // EDITOR-ONLY FUNCTIONALITY
@@ -298,6 +756,9 @@ public:
     // Post-edit hooks for editor validation
     virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 
+    /** Regenerates the cooked timing block, folding in the deprecated timing (also runs when cooking) */
+    virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+
     // ============================================================================
     // CONTEXT SYSTEM VALIDATION (Phase 1)
     // ============================================================================
@@ -311,6 +772,7 @@ public:
 
     /**
      * Detect circular references in combo chains using depth-first search
+     * Uncached full walk - validation goes through FComboGraphValidationCache instead
      * @param Visited - Set of already-visited attacks (prevents infinite loops)
      * @param Errors - Accumulated error messages
      * @return True if cycle detected
@@ -0,0 +1,89 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CombatTypes.h"
+#include "Core/HitReactionComponent.h"
+#include "CombatArchetype.generated.h"
+
+class UCombatSettings;
+class UAnimMontage;
+
+/**
+ * Shared, immutable combat configuration for a kind of character
+ *
+ * Every enemy of a type references one archetype instead of carrying its own copy of combat settings,
+ * hit reaction sets, finisher victim animations and targeting filters. Components read configuration
+ * through it and keep only their mutable state, so spawning copies no config and the baked reaction
+ * table exists once per archetype rather than once per character.
+ *
+ * Characters without an archetype fall back to their per-instance component properties.
+ */
+UCLASS(BlueprintType)
+class KATANACOMBAT_API UCombatArchetype : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // ============================================================================
+    // SETTINGS
+    // ============================================================================
+
+    /** Combat tuning for this archetype (overrides the character's CombatSettings when set) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+    TObjectPtr<UCombatSettings> CombatSettings;
+
+    // ============================================================================
+    // HIT REACTIONS
+    // ============================================================================
+
+    /** Light hit reactions (minimal stagger) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Reactions|Light")
+    FHitReactionAnimSet LightHitReactions;
+
+    /** Heavy hit reactions (full directional stagger) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Reactions|Heavy")
+    FHitReactionAnimSet HeavyHitReactions;
+
+    /** Hits landing while already stunned (empty slots fall back to the light/heavy set) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Reactions|Stunned")
+    FHitReactionAnimSet StunnedHitReactions;
+
+    /** Stun duration above which a hit uses the heavy reaction bucket */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Reactions", meta = (ClampMin = "0.0"))
+    float HeavyHitStunThreshold = 0.3f;
+
+    /** Guard broken animation (posture depleted) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Reactions")
+    TSoftObjectPtr<UAnimMontage> GuardBrokenMontage;
+
+    /** Finisher victim animations (paired with attacker finisher, streamed by each UHitReactionComponent on demand) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Reactions|Finishers")
+    TMap<FName, TSoftObjectPtr<UAnimMontage>> FinisherVictimAnimations;
+
+    // ============================================================================
+    // TARGETING
+    // ============================================================================
+
+    /** Actor classes to consider as targets (empty = all actors) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Targeting")
+    TArray<TSubclassOf<AActor>> TargetableClasses;
+
+    // ============================================================================
+    // BAKED DATA
+    // ============================================================================
+
+    /** Reaction table built from the sets above (built on first use, shared by every character) */
+    const FHitReactionTable& GetReactionTable() const;
+
+#if WITH_EDITOR
+    /** Rebakes the reaction table after edits */
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+    UPROPERTY(Transient)
+    mutable FHitReactionTable ReactionTable;
+};
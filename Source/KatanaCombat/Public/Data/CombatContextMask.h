@@ -0,0 +1,84 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "NativeGameplayTags.h"
+
+/** Native context tags used by attack resolution */
+namespace CombatContextTags
+{
+    /** Successful parry - enables parry counter variants */
+    KATANACOMBAT_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(ParryCounter);
+
+    /** Target at low health - enables finisher variants */
+    KATANACOMBAT_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(LowHealthFinisher);
+
+    /** Attack reached via hold-and-release */
+    KATANACOMBAT_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(DirectionalFollowUp);
+}
+
+/**
+ * Context tags compiled to a fixed-width bitset
+ * 
+ * Bits are assigned once per project by FCombatContextTagTable (every tag under "Context").
+ * Matching is then two ANDs instead of FGameplayTagContainer queries:
+ * - Active masks carry each active tag plus its parents (mirrors FGameplayTagContainer::HasTag)
+ * - Query masks (required/blocked) carry the exact tags
+ * Query masks with tags that did not get a bit are flagged bOverflow; callers fall back to containers.
+ */
+struct KATANACOMBAT_API FCombatContextMask
+{
+    uint64 Bits = 0;
+
+    /** Contains tags without a bit (only set on query masks) */
+    bool bOverflow = false;
+
+    bool IsEmpty() const { return Bits == 0 && !bOverflow; }
+
+    /** Every bit of Required is set (Required must not overflow) */
+    bool HasAll(const FCombatContextMask& Required) const { return (Bits & Required.Bits) == Required.Bits; }
+
+    /** Any bit of Other is set (Other must not overflow) */
+    bool HasAny(const FCombatContextMask& Other) const { return (Bits & Other.Bits) != 0; }
+};
+
+/**
+ * Per-project context tag -> bit table
+ * Built on first use from the gameplay tag tree; rebuilt in editor when the tag tree changes
+ * (GetGeneration changes, so cached masks know to recompile).
+ */
+class KATANACOMBAT_API FCombatContextTagTable
+{
+public:
+    static constexpr int32 MaxBits = 64;
+
+    /** Root of the compiled tags */
+    static const FName ContextRootName;
+
+    /** Shared table (builds on first use) */
+    static const FCombatContextTagTable& Get();
+
+    /** Mask for runtime context: each tag plus its parent tags */
+    FCombatContextMask MakeActiveMask(const FGameplayTagContainer& Tags) const;
+
+    /** Mask for attack requirements: exact tags (bOverflow if any tag has no bit) */
+    FCombatContextMask MakeQueryMask(const FGameplayTagContainer& Tags) const;
+
+    /** Bit index of a tag (INDEX_NONE if not compiled) */
+    int32 GetBitIndex(const FGameplayTag& Tag) const;
+
+    /** Number of assigned bits */
+    int32 GetNumBits() const { return BitIndices.Num(); }
+
+    /** Changes every rebuild (never 0) */
+    uint32 GetGeneration() const { return Generation; }
+
+private:
+    void Build();
+
+    TMap<FGameplayTag, int32> BitIndices;
+    uint32 Generation = 0;
+    bool bNeedsRebuild = true;
+};
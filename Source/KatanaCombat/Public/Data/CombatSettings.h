@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "CombatTypes.h"
 #include "CombatSettings.generated.h"
 
+class UNiagaraDataChannelAsset;
+
 /**
  * Global combat tuning values
  * Use this data asset to configure posture, timing, and other combat parameters
@@ -22,7 +25,10 @@ public:
     // SYSTEM CONFIGURATION
     // ============================================================================
 
-    /** Enable V2 combat system (timer-based action queue) instead of V1 (immediate execution) */
+    /**
+     * Enable V2 combat system (timer-based action queue) instead of V1 (immediate execution)
+     * Read at spawn: characters only create the V2 components when this is set (ASamuraiCharacter::SelectCombatBackend)
+     */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "System")
     bool bUseV2System = false;
 
@@ -30,6 +36,20 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "System")
     bool bDebugDraw = false;
 
+    /**
+     * Event-driven V1 CombatComponent tick: posture is evaluated analytically (last change + regen rate by state)
+     * and the component only ticks while holding. Idle characters cost no combat tick. Disable for per-frame posture regen.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "System")
+    bool bEventDrivenCombatTick = true;
+
+    /**
+     * Batched V1 CombatComponent tick: per-frame posture and hold time for every character are evaluated together
+     * on UCombatTickManagerSubsystem (in parallel for large crowds) instead of one component tick each
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "System")
+    bool bBatchedCombatTick = false;
+
     // ============================================================================
     // POSTURE SYSTEM
     // ============================================================================
@@ -66,6 +86,21 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attacks")
     TObjectPtr<class UAttackConfiguration> AttackConfiguration;
 
+    /**
+     * Combo links streamed ahead of the current attack (V2, soft combo links only)
+     * Hard-linked attacks load with the character regardless. 0 = no preloading
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attacks", meta = (ClampMin = "0", ClampMax = "8"))
+    int32 ComboPreloadDepth = 2;
+
+    /**
+     * AttackConfiguration asset bundles kept loaded while a character with these settings is in play (V2)
+     * "Core" = first follow-ups of the default attacks, "Extended" = the rest. Settings sharing a configuration
+     * share its bundles (the last character to start decides). Empty = leave bundle state alone
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attacks")
+    TArray<FName> MovesetBundles = { TEXT("Core") };
+
     // ============================================================================
     // COUNTER SYSTEM
     // ============================================================================
@@ -78,6 +113,42 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Counter")
     float CounterDamageMultiplier = 1.5f;
 
+    // ============================================================================
+    // HIT STOP
+    // ============================================================================
+
+    /** Hit-stop applied to attacker and victim on a hit (real-time seconds, 0 = off; attacks can override) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Stop", meta = (ClampMin = "0.0"))
+    float HitStopDuration = 0.06f;
+
+    /** Time dilation during a hit-stop (0.05 = nearly frozen) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Stop", meta = (ClampMin = "0.0001", ClampMax = "1.0"))
+    float HitStopTimeDilation = 0.05f;
+
+    /** Hit-stop applied to parrier and attacker on a perfect parry (0 = off) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Stop", meta = (ClampMin = "0.0"))
+    float ParryHitStopDuration = 0.12f;
+
+    // ============================================================================
+    // IMPACT FEEDBACK
+    // ============================================================================
+
+    /** VFX/audio per surface and attack type, queued on every weapon hit (UCombatImpactSubsystem) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Impacts")
+    TArray<FCombatImpactEffect> ImpactEffects;
+
+    /**
+     * Optional Niagara Data Channel for impact VFX
+     * When set, a frame's impacts are written as one batch (Position, Normal, EffectIndex)
+     * and a single listening system renders them, instead of each impact spawning a pooled component.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Impacts")
+    TObjectPtr<UNiagaraDataChannelAsset> ImpactDataChannel = nullptr;
+
+    /** Cap on pooled Niagara components spawned per frame (extra impacts that frame are dropped) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Impacts", meta = (ClampMin = "1"))
+    int32 MaxImpactSpawnsPerFrame = 4;
+
     // ============================================================================
     // MOTION WARPING DEFAULTS
     // ============================================================================
@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "HAL/CriticalSection.h"
+
+#if WITH_EDITOR
+
+class UAttackData;
+
+/**
+ * Combo Graph Validation Cache (editor only)
+ *
+ * Memoized cycle check over the hard combo links of every AttackData asset validated so far.
+ * Each node keeps its links and whether a cycle is reachable from it; a node's result is computed
+ * once from its successors' cached results instead of re-walking the whole chain per asset.
+ *
+ * Invalidation is incremental: when an attack is edited or saved (UAttackData::PostEditChangeProperty,
+ * PreSave) only its links are regathered, and only it and the attacks that can reach it (reverse
+ * links) are revalidated on the next query. Everything downstream keeps its result.
+ *
+ * Thread safe (BatchAnalyze queries it from worker threads).
+ */
+class KATANACOMBAT_API FComboGraphValidationCache
+{
+public:
+	static FComboGraphValidationCache& Get();
+
+	/**
+	 * Add the cycle error for an attack that reaches a circular combo chain
+	 * @return True if a cycle is reachable from Attack
+	 */
+	bool GetCycleErrors(const UAttackData* Attack, TArray<FText>& OutErrors);
+
+	/** Is a cycle reachable from Attack? (validates Attack and its dirty successors) */
+	bool ReachesCycle(const UAttackData* Attack);
+
+	/** Attack's links changed - revalidate it and everything that leads to it on the next query */
+	void Invalidate(const UAttackData* Attack);
+
+	/** Discard every cached node */
+	void Reset();
+
+	/** Nodes validated since construction (a node counts again each time it is revalidated) */
+	int32 GetNumNodesValidated() const { return NumNodesValidated; }
+
+	int32 GetNumNodes() const { return Nodes.Num(); }
+
+private:
+	struct FNode
+	{
+		TWeakObjectPtr<const UAttackData> Attack;
+
+		/** Hard combo links, as last gathered */
+		TArray<FObjectKey> Successors;
+
+		/** Nodes linking here (walked on invalidation) */
+		TArray<FObjectKey> Predecessors;
+
+		/** Attack where the reachable loop closes (reported in the error) */
+		FString CycleAttackName;
+
+		bool bLinksValid = false;
+		bool bResultValid = false;
+		bool bReachesCycle = false;
+	};
+
+	/** Regather a node's links if they are stale, keeping the reverse links in step */
+	FNode& UpdateLinks(const UAttackData* Attack);
+
+	/** Memoized depth-first search: a back edge or a successor that reaches a cycle marks the node */
+	void Validate(const UAttackData* Attack, TMap<FObjectKey, uint8>& VisitState);
+
+	TMap<FObjectKey, FNode> Nodes;
+	FCriticalSection Lock;
+	int32 NumNodesValidated = 0;
+};
+
+#endif // WITH_EDITOR
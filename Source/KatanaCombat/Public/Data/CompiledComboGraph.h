@@ -0,0 +1,234 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTypes.h"
+#include "Utilities/MontageUtilityLibrary.h"
+#include "CompiledComboGraph.generated.h"
+
+// Forward declarations
+class UAttackData;
+class UAnimMontage;
+struct FRandomStream;
+
+/**
+ * Single precompiled transition out of a combo graph node
+ * Target is an index into FCompiledComboGraph::Attacks (INDEX_NONE = no attack)
+ */
+struct FCompiledComboTransition
+{
+	int32 Target = INDEX_NONE;
+	EResolutionPath Path = EResolutionPath::Default;
+	bool bShouldClearDirectionalInput = false;
+};
+
+/**
+ * Per-node metadata precomputed at build time for AI move selection
+ * Durations come from the attack's cooked timing block (see FCombatSimCore::CookAttackTiming)
+ */
+struct FCompiledComboNodeInfo
+{
+	/** Farthest target the attack closes on (UAttackData::GetMaxTargetDistance, cm) */
+	float Reach = 0.0f;
+
+	/** Phase durations (seconds) */
+	float WindupDuration = 0.0f;
+	float ActiveDuration = 0.0f;
+	float RecoveryDuration = 0.0f;
+
+	/** Health and posture damage of a clean hit */
+	float ExpectedDamage = 0.0f;
+	float PostureDamage = 0.0f;
+
+	/** Total length of the attack's parry windows - how long a defender has to parry it (seconds) */
+	float ParryWindow = 0.0f;
+
+	float GetTotalDuration() const { return WindupDuration + ActiveDuration + RecoveryDuration; }
+};
+
+/**
+ * Weights of the AI move utility score
+ *
+ *   Score = DamageWeight * damage/s + PostureWeight * posture/s - WindupWeight * windup - ParryRiskWeight * parry window
+ *
+ * Rates are over the move's total duration, so a quick jab and a slow finisher compete on damage per
+ * time committed. Exposed on StateTree tasks so each archetype can be tuned without Blueprint logic.
+ */
+USTRUCT(BlueprintType)
+struct KATANACOMBAT_API FComboMoveUtilityWeights
+{
+	GENERATED_BODY()
+
+	/** Score per point of health damage per second */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Move Selection", meta = (ClampMin = "0.0"))
+	float DamageWeight = 1.0f;
+
+	/** Score per point of posture damage per second */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Move Selection", meta = (ClampMin = "0.0"))
+	float PostureWeight = 0.5f;
+
+	/** Penalty per second of windup (raise against targets that punish slow starts) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Move Selection", meta = (ClampMin = "0.0"))
+	float WindupWeight = 10.0f;
+
+	/** Penalty per second of parry window (raise against targets that parry well) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Move Selection", meta = (ClampMin = "0.0"))
+	float ParryRiskWeight = 20.0f;
+
+	/** Moves whose reach falls short of the target by more than this are skipped (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Move Selection", meta = (ClampMin = "0.0", Units = "cm"))
+	float ReachTolerance = 50.0f;
+
+	/** Random share of the score added per candidate, so equal moves alternate (0 = always the best) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Move Selection", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Variation = 0.2f;
+};
+
+/**
+ * Move picked by FCompiledComboGraph::SelectMove: the input to press and the attack it resolves to
+ */
+struct FComboMoveChoice
+{
+	int32 Node = INDEX_NONE;
+	EInputType InputType = EInputType::None;
+	EAttackDirection Direction = EAttackDirection::None;
+	float Score = 0.0f;
+};
+
+/**
+ * Compiled Combo Graph
+ *
+ * Flat, precompiled form of the combo chains reachable from an AttackConfiguration's
+ * default attacks. Built on BeginPlay (and again when streamed combo nodes finish loading)
+ * by walking the hard and loaded soft combo links; afterwards resolving an input is a node lookup
+ * plus a single array index instead of a pointer/TMap walk.
+ *
+ * Layout:
+ * - Attacks[0] is the root node (no current attack); every other node is one UAttackData
+ * - Transitions holds SlotsPerNode entries per node, indexed by
+ *   (input type, attack direction, holding, combo window active)
+ *
+ * Cycle detection runs once at build time (see bHasCycles) rather than on every input.
+ * Resolution semantics match UMontageUtilityLibrary::ResolveNextAttack_V2.
+ */
+USTRUCT()
+struct KATANACOMBAT_API FCompiledComboGraph
+{
+	GENERATED_BODY()
+
+	/** Node index used when there is no current attack */
+	static constexpr int32 RootNode = 0;
+
+	/** Light/Heavy x 5 directions x holding x combo window */
+	static constexpr int32 NumInputSlots = 2;
+	static constexpr int32 NumDirectionSlots = 5;
+	static constexpr int32 SlotsPerNode = NumInputSlots * NumDirectionSlots * 2 * 2;
+
+	/**
+	 * Compile the graph reachable from the given default attacks
+	 * Replaces any previously compiled data
+	 */
+	void Build(UAttackData* InDefaultLightAttack, UAttackData* InDefaultHeavyAttack);
+
+	/** Discard compiled data */
+	void Reset();
+
+	/** Was this graph compiled from these defaults? (cheap staleness check) */
+	bool IsBuiltFor(const UAttackData* InDefaultLightAttack, const UAttackData* InDefaultHeavyAttack) const
+	{
+		return bIsBuilt && DefaultLightAttack == InDefaultLightAttack && DefaultHeavyAttack == InDefaultHeavyAttack;
+	}
+
+	/** Node index for an attack (RootNode for nullptr, INDEX_NONE if not part of this graph) */
+	int32 FindNode(const UAttackData* Attack) const;
+
+	/**
+	 * Resolve the next attack from a compiled node
+	 * @param Node - Node index from FindNode (must be valid)
+	 * @return Resolution result; Attack is nullptr for non-attack input or missing defaults
+	 */
+	FAttackResolutionResult Resolve(int32 Node, EInputType InputType, EAttackDirection Direction, bool bIsHolding, bool bComboWindowActive) const;
+
+	/** Did build-time validation find a circular combo reference? */
+	bool HasCycles() const { return bHasCycles; }
+
+	/** Number of compiled nodes (including root) */
+	int32 GetNumNodes() const { return Attacks.Num(); }
+
+	// ============================================================================
+	// AI MOVE SELECTION
+	// ============================================================================
+
+	/** Precomputed metadata of a node (the root and invalid indices return zeros) */
+	const FCompiledComboNodeInfo& GetNodeInfo(int32 Node) const;
+
+	/**
+	 * Pick the next move from Node by utility score over the precomputed node metadata
+	 * Candidates are the distinct attacks Node's un-held transitions resolve to (light/heavy x direction),
+	 * so a call is a few dozen table reads - cheap enough to run at every AI decision.
+	 * @param TargetDistance - Distance to the target; moves that can't reach it are skipped (negative = ignore reach)
+	 * @param RandomStream - Source of the score variation (nullptr = FMath::FRand)
+	 * @return false if no move qualifies
+	 */
+	bool SelectMove(int32 Node, bool bComboWindowActive, float TargetDistance, const FComboMoveUtilityWeights& Weights,
+		FComboMoveChoice& OutChoice, const FRandomStream* RandomStream = nullptr) const;
+
+	/** Utility score of moving into Node (no reach check, no variation) */
+	static float ScoreMove(const FCompiledComboNodeInfo& Info, const FComboMoveUtilityWeights& Weights);
+
+	// ============================================================================
+	// INSPECTION (editor graph view, debug tools - not for the resolve path)
+	// ============================================================================
+
+	/** Attack at a node (nullptr for root or an invalid index) */
+	UAttackData* GetNodeAttack(int32 Node) const { return Attacks.IsValidIndex(Node) ? Attacks[Node].Get() : nullptr; }
+
+	/** Distinct nodes some input can resolve to from Node (compiled transitions, no root) */
+	void GetResolvableSuccessors(int32 Node, TArray<int32>& OutNodes) const;
+
+	/** Nodes Node links to as authored (combo links, follow-ups, context variants; root links to the defaults) */
+	void GetLinkedNodes(int32 Node, TArray<int32>& OutNodes) const;
+
+	/** Distinct attack montages across every compiled node (animation prewarm) */
+	void GetMontages(TArray<UAnimMontage*>& OutMontages) const;
+
+	/** Back edges (From, To) found by build-time cycle detection */
+	const TArray<TPair<int32, int32>>& GetCycleEdges() const { return CycleEdges; }
+
+private:
+	/** Flat slot index for a transition (INDEX_NONE for non-attack input) */
+	static int32 GetSlotIndex(EInputType InputType, EAttackDirection Direction, bool bIsHolding, bool bComboWindowActive);
+
+	/** Compile a single transition using ResolveNextAttack_V2 priority rules */
+	FCompiledComboTransition CompileTransition(const UAttackData* Current, EInputType InputType, EAttackDirection Direction, bool bIsHolding, bool bComboWindowActive) const;
+
+	/** Depth-first search over combo links, returns true if a back edge is found */
+	bool DetectCyclesFrom(int32 Node, TArray<uint8>& VisitState) const;
+
+	/** Compiled nodes (index 0 = root / nullptr) */
+	UPROPERTY()
+	TArray<TObjectPtr<UAttackData>> Attacks;
+
+	/** Defaults this graph was compiled from */
+	UPROPERTY()
+	TObjectPtr<UAttackData> DefaultLightAttack = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UAttackData> DefaultHeavyAttack = nullptr;
+
+	/** SlotsPerNode transitions per node */
+	TArray<FCompiledComboTransition> Transitions;
+
+	/** AI metadata per node (root entry is zeros) */
+	TArray<FCompiledComboNodeInfo> NodeInfos;
+
+	/** Attack -> node index */
+	TMap<const UAttackData*, int32> NodeIndices;
+
+	/** Back edges recorded by DetectCyclesFrom */
+	mutable TArray<TPair<int32, int32>> CycleEdges;
+
+	bool bIsBuilt = false;
+	bool bHasCycles = false;
+};
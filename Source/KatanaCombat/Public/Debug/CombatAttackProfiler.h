@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
+
+class UAttackData;
+class FCombatAttackProfileScope;
+
+/**
+ * What an attack profiler scope is charged as
+ */
+enum class ECombatAttackCost : uint8
+{
+	/** Sweep gathering, physics queries and blade narrowphase (once per traced frame) */
+	Trace,
+
+	/** Combat anim notify dispatch while the attack plays */
+	Notify,
+
+	/** Hit processing - ProcessHit and everything its listeners do (damage, reactions, events) */
+	Hit,
+
+	Count
+};
+
+KATANACOMBAT_API const TCHAR* LexToString(ECombatAttackCost Cost);
+
+/**
+ * Totals charged to one attack
+ */
+struct FCombatAttackCostStats
+{
+	/** Asset path, kept so the row outlives the asset */
+	FString AttackName;
+
+	/** Hit detection windows that closed on this attack */
+	int32 NumSwings = 0;
+
+	/** Physics queries issued by its traces (sweep segments and narrowphase world tests) */
+	int64 NumSweeps = 0;
+
+	/** Exclusive cycles per ECombatAttackCost (nested scopes are not counted twice) */
+	uint64 Cycles[static_cast<int32>(ECombatAttackCost::Count)] = {};
+
+	/** Scopes charged per ECombatAttackCost: traced frames, notifies, hits */
+	int64 NumCalls[static_cast<int32>(ECombatAttackCost::Count)] = {};
+
+	uint64 GetCycles(ECombatAttackCost Cost) const { return Cycles[static_cast<int32>(Cost)]; }
+	int64 GetNumCalls(ECombatAttackCost Cost) const { return NumCalls[static_cast<int32>(Cost)]; }
+	uint64 GetTotalCycles() const;
+};
+
+/**
+ * Per-attack CPU cost attribution (off by default)
+ *
+ * While enabled, the weapon trace, the combat anim notifies and hit processing charge their time
+ * to the UAttackData that caused it, so designers can see which moves are expensive: long active
+ * windows show up as trace time, notify-heavy montages as notify time, wide hit volumes as sweeps
+ * per swing. A disabled scope costs one relaxed load.
+ *
+ * Game thread only (every instrumented site runs there). A CSV profile recorded while enabled
+ * starts the table over and writes it next to the capture as <csv>.attacks.csv when it ends;
+ * the profiled time per frame is in KatanaCombat/AttackProfileMs.
+ *
+ * Console: Combat.AttackProfile.Start / Combat.AttackProfile.Stop / Combat.AttackProfile.Reset,
+ *          Combat.AttackProfile.Dump [Path] logs the table by total cost and writes it as CSV
+ *          (default Saved/Combat/AttackProfile_<time>.csv)
+ */
+class KATANACOMBAT_API FCombatAttackProfiler
+{
+public:
+	static FCombatAttackProfiler& Get();
+
+	/** Start/stop attributing (stopping keeps the table) */
+	void SetEnabled(bool bInEnabled);
+	bool IsEnabled() const { return bEnabled.load(std::memory_order_relaxed); }
+
+	/** Count a finished swing (hit detection window) */
+	void AddSwing(const UAttackData* Attack);
+
+	/** Charge time to an attack directly (normally done by FCombatAttackProfileScope) */
+	void AddCost(const UAttackData* Attack, ECombatAttackCost Cost, uint64 Cycles, int32 NumSweeps = 0);
+
+	/** Give the innermost open scope its attack, if it was opened before the attack was known */
+	void SetScopeAttack(const UAttackData* Attack);
+
+	/** Count physics queries against the innermost open scope */
+	void AddScopeSweeps(int32 NumSweeps);
+
+	/** Totals for one attack (nullptr if nothing was charged to it) */
+	const FCombatAttackCostStats* FindStats(const UAttackData* Attack) const;
+
+	/** Every attack's totals, most expensive first */
+	void GetStats(TArray<FCombatAttackCostStats>& OutStats) const;
+
+	int32 GetNumAttacks() const { return Stats.Num(); }
+
+	void Reset();
+
+	/** Log the table (MaxRows 0 = every attack) */
+	void LogReport(int32 MaxRows = 0) const;
+
+	/** Write the table as CSV (attack, swings, per-cost ms and calls, sweeps, per-swing averages) */
+	bool ExportToCSV(const FString& FilePath) const;
+
+private:
+	friend class FCombatAttackProfileScope;
+
+	FCombatAttackProfiler() = default;
+
+	FCombatAttackCostStats& FindOrAddStats(const UAttackData* Attack);
+
+	void OnCsvProfileStart();
+	void OnCsvProfileEnd();
+
+	TMap<FObjectKey, FCombatAttackCostStats> Stats;
+
+	/** Innermost open scope */
+	FCombatAttackProfileScope* CurrentScope = nullptr;
+
+	std::atomic<bool> bEnabled{ false };
+	bool bCsvDelegatesBound = false;
+};
+
+/**
+ * Charges the enclosing scope to an attack
+ * Time spent in nested scopes goes to those instead, e.g. a hit inside a trace is charged as Hit only.
+ * Scopes left without an attack charge nothing.
+ */
+class FCombatAttackProfileScope
+{
+public:
+	explicit FCombatAttackProfileScope(ECombatAttackCost InCost, const UAttackData* InAttack = nullptr)
+		: Attack(InAttack)
+		, Cost(InCost)
+	{
+		if (FCombatAttackProfiler::Get().IsEnabled())
+		{
+			Begin();
+		}
+	}
+
+	~FCombatAttackProfileScope()
+	{
+		if (StartCycles != 0)
+		{
+			End();
+		}
+	}
+
+	/** Attack to charge, once it is known */
+	void SetAttack(const UAttackData* InAttack) { Attack = InAttack; }
+
+	void AddSweeps(int32 InNumSweeps) { NumSweeps += InNumSweeps; }
+
+	/** Is the profiler timing this scope? */
+	bool IsActive() const { return StartCycles != 0; }
+
+private:
+	friend class FCombatAttackProfiler;
+
+	KATANACOMBAT_API void Begin();
+	KATANACOMBAT_API void End();
+
+	const UAttackData* Attack = nullptr;
+	FCombatAttackProfileScope* Parent = nullptr;
+	uint64 StartCycles = 0;
+	uint64 ChildCycles = 0;
+	int32 NumSweeps = 0;
+	ECombatAttackCost Cost;
+};
@@ -0,0 +1,234 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CombatTypes.h"
+#include "Debug/CombatReplayComponent.h"
+#include "Debug/CombatTrace.h"
+#include "CombatBenchmarkDirector.generated.h"
+
+class ASamuraiCharacter;
+class ACameraActor;
+
+/**
+ * Summary of one benchmark run (also appended to the cross-build report)
+ */
+struct FCombatBenchmarkResult
+{
+	int32 NumFighters = 0;
+	int32 NumFrames = 0;
+	float Duration = 0.0f;
+	float AvgFrameMs = 0.0f;
+	float P95FrameMs = 0.0f;
+	float MaxFrameMs = 0.0f;
+	float AvgGameThreadMs = 0.0f;
+
+	/** Combat time per frame by system (CombatBudget categories, ms) */
+	float AvgSystemMs[static_cast<int32>(ECombatBudgetCategory::Count)] = {};
+
+	/** Combat physics queries per frame */
+	float AvgPhysicsQueries = 0.0f;
+
+	/** Capture the fighters replayed (empty for the scripted fight) */
+	FString CapturePath;
+
+	/** CSV profile written for this run (empty if the capture was already running or CSV is compiled out) */
+	FString CsvFileName;
+};
+
+/**
+ * Reproducible combat benchmark
+ *
+ * Spawns a fixed number of AI-vs-AI duels in a grid around the actor, orbits a scripted camera over
+ * the arena and, after a warm-up, captures a CSV profile (KatanaCombat* categories: traces, queue,
+ * targeting, anim) for a fixed duration. Offense follows a seeded script in world time and defense
+ * comes from UAIDefenseComponent, so every run plays the same fight regardless of frame rate.
+ *
+ * The summary is appended to Saved/Profiling/CombatBenchmark/CombatBenchmarkReport.csv, one row per
+ * run tagged with build version, changelist, platform and configuration for comparison across builds.
+ *
+ * Replay mode (ReplayCapturePath set) drives the fighters from a combat capture (.kcap) instead - a QA
+ * session or bug report - on a fixed timestep, so two builds run identical real-world input sequences.
+ * Fighter i plays the capture's input stream i % streams, looping. Those runs go to
+ * CombatReplayReport.csv with per-system combat time (traces, targeting, queue, anim) and physics
+ * queries per frame next to the frame times.
+ *
+ * Place one in a benchmark level, spawn it with Combat.Benchmark / Combat.Benchmark.Replay, or let
+ * UCombatBenchmarkGauntletController drive it (-gauntlet=CombatBenchmarkGauntletController).
+ */
+UCLASS()
+class KATANACOMBAT_API ACombatBenchmarkDirector : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ACombatBenchmarkDirector();
+
+	// ============================================================================
+	// CONFIGURATION
+	// ============================================================================
+
+	/** Character spawned for both sides of every duel */
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	TSubclassOf<ASamuraiCharacter> FighterClass;
+
+	/** Number of duels (fighters = 2x) */
+	UPROPERTY(EditAnywhere, Category = "Benchmark", meta = (ClampMin = 1, ClampMax = 128))
+	int32 NumDuels = 8;
+
+	/** Distance between duel centers in the grid (cm) */
+	UPROPERTY(EditAnywhere, Category = "Benchmark", meta = (ClampMin = 0, Units = "cm"))
+	float DuelSpacing = 500.0f;
+
+	/** Distance between the two fighters of a duel (cm) */
+	UPROPERTY(EditAnywhere, Category = "Benchmark", meta = (ClampMin = 0, Units = "cm"))
+	float DuelDistance = 180.0f;
+
+	/** Time the fight runs before capture starts (shader/asset warm-up, first-hit hitches) */
+	UPROPERTY(EditAnywhere, Category = "Benchmark", meta = (ClampMin = 0, Units = "s"))
+	float WarmupTime = 5.0f;
+
+	/** Captured time */
+	UPROPERTY(EditAnywhere, Category = "Benchmark", meta = (ClampMin = 1, Units = "s"))
+	float Duration = 60.0f;
+
+	/** Seed for the offense script and the AI defense rolls */
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	int32 RandomSeed = 1337;
+
+	/** Start on BeginPlay (placed in a benchmark level) */
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	bool bAutoStart = false;
+
+	/** Record a CSV profile of the captured time */
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	bool bRecordCsvProfile = true;
+
+	/** Camera orbit around the arena (radius, height in cm; period in s) */
+	UPROPERTY(EditAnywhere, Category = "Benchmark|Camera", meta = (ClampMin = 0, Units = "cm"))
+	float CameraOrbitRadius = 1500.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Benchmark|Camera", meta = (Units = "cm"))
+	float CameraHeight = 700.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Benchmark|Camera", meta = (ClampMin = 1, Units = "s"))
+	float CameraOrbitPeriod = 30.0f;
+
+	/** Combat capture (.kcap) whose recorded inputs drive the fighters instead of the offense script (empty = scripted) */
+	UPROPERTY(EditAnywhere, Category = "Benchmark|Replay", meta = (FilePathFilter = "kcap"))
+	FString ReplayCapturePath;
+
+	/** Fixed simulation step while replaying a capture, so every run sees the inputs on the same frames */
+	UPROPERTY(EditAnywhere, Category = "Benchmark|Replay", meta = (ClampMin = "0.001", Units = "s"))
+	float ReplayFixedTimeStep = 1.0f / 60.0f;
+
+	/** Idle time between the end of a replayed stream and its next loop */
+	UPROPERTY(EditAnywhere, Category = "Benchmark|Replay", meta = (ClampMin = 0, Units = "s"))
+	float ReplayLoopGap = 1.0f;
+
+	// ============================================================================
+	// RUN
+	// ============================================================================
+
+	/** Spawn the fight and camera and start the warm-up (no-op while running) */
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	void StartBenchmark();
+
+	UFUNCTION(BlueprintPure, Category = "Benchmark")
+	bool IsRunning() const { return Phase != EPhase::Idle; }
+
+	/** Fires once the capture ends */
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnCombatBenchmarkFinished, const FCombatBenchmarkResult& /*Result*/);
+	FOnCombatBenchmarkFinished OnBenchmarkFinishedNative;
+
+	/** Path of the cross-build report */
+	static FString GetReportPath();
+
+	/** Path of the cross-build report for capture replays */
+	static FString GetReplayReportPath();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
+
+private:
+	enum class EPhase : uint8
+	{
+		Idle,
+		Warmup,
+		Capture
+	};
+
+	/** One side of a duel and its offense script */
+	struct FFighter
+	{
+		TWeakObjectPtr<ASamuraiCharacter> Character;
+		FRandomStream Stream;
+		float NextActionTime = 0.0f;
+		float ReleaseTime = -1.0f;
+		EInputType HeldInput = EInputType::None;
+
+		/** Replay mode: stream index, next input and when the current loop started */
+		int32 ReplayStream = INDEX_NONE;
+		int32 NextReplayInput = 0;
+		float ReplayLoopStart = 0.0f;
+
+		/** Replay mode: inputs pressed and not yet released (bit per EInputType) */
+		uint32 HeldReplayInputs = 0;
+	};
+
+	void SpawnDuels();
+	void SpawnCamera();
+	void UpdateCamera();
+	void DriveFighter(FFighter& Fighter);
+
+	/** Load ReplayCapturePath into ReplayStreams. Returns false if it has no inputs */
+	bool LoadReplayCapture();
+
+	/** Feed the fighter the inputs of its replay stream that are due */
+	void DriveReplayFighter(FFighter& Fighter);
+
+	/** Undo the replay fixed timestep */
+	void RestoreTimeStep();
+
+	void BeginCapture();
+	void FinishBenchmark();
+	void AppendReport(const FCombatBenchmarkResult& Result) const;
+	void AppendReplayReport(const FCombatBenchmarkResult& Result) const;
+	void Cleanup();
+
+	TArray<FFighter> Fighters;
+
+	UPROPERTY(Transient)
+	TObjectPtr<ACameraActor> BenchmarkCamera;
+
+	EPhase Phase = EPhase::Idle;
+
+	/** Seconds since StartBenchmark (world time, drives the script and camera) */
+	float ElapsedTime = 0.0f;
+
+	/** Captured frames (undilated frame and game thread time, ms) */
+	TArray<float> FrameTimesMs;
+	double GameThreadTimeSumMs = 0.0;
+
+	FString CsvFileName;
+	bool bStartedCsvCapture = false;
+
+	/** Replay mode: one input stream per captured owner */
+	TArray<FCombatReplayStream> ReplayStreams;
+
+	/** Wall clock at the previous captured frame (frame times under a fixed timestep) */
+	double LastFrameSeconds = 0.0;
+
+	/** CombatBudget totals when the capture started */
+	uint64 CaptureStartCycles[static_cast<int32>(ECombatBudgetCategory::Count)] = {};
+	uint64 CaptureStartQueries = 0;
+
+	/** Engine fixed-timestep state restored after a replay run */
+	bool bAppliedFixedTimeStep = false;
+	bool bSavedUseFixedTimeStep = false;
+	double SavedFixedDeltaTime = 0.0;
+};
@@ -0,0 +1,311 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Debug/CombatEventRecorder.h"
+#include "Tasks/Pipe.h"
+#include "UObject/WeakObjectPtr.h"
+#include <atomic>
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Combat capture file (.kcap)
+ *
+ *   Header   fixed 32 bytes (FCombatCaptureHeader)
+ *   Chunks   [uint8 type][uint32 payload bytes][uint32 record count][payload], appended as the session runs
+ *
+ * Names chunk  - per record: varint index, uint8 ECombatCaptureNameKind, string name, string detail
+ *                (strings are varint length + UTF-8). Index 0 is "none"; every index is defined before
+ *                the first event chunk that uses it.
+ * Events chunk - delta-encoded FCombatRecordedEvents; time and owner deltas restart in every chunk so a
+ *                capture cut short by a crash reads up to its last complete chunk.
+ * Lost chunk   - varint count of events overwritten in the recorder ring before they were drained.
+ *
+ * A typical event costs 4-8 bytes (one hour of a busy fight is a few MB).
+ */
+namespace CombatCapture
+{
+	constexpr uint32 Magic = 0x5041434B; // "KCAP"
+	constexpr uint16 Version = 1;
+
+	enum class EChunkType : uint8
+	{
+		Names = 1,
+		Events = 2,
+		Lost = 3
+	};
+
+	/** Bytes in front of every chunk payload */
+	constexpr int32 ChunkHeaderSize = 9;
+}
+
+/**
+ * What a name table entry refers to
+ */
+enum class ECombatCaptureNameKind : uint8
+{
+	/** Actor or other object (Name = object name) */
+	Object,
+
+	/** UAttackData (Name = asset path, Detail = attack montage path) */
+	Attack,
+
+	/** Any other asset, e.g. an anim montage (Name = asset path) */
+	Asset,
+
+	/** Object was gone before it could be resolved (Name = #UniqueId) */
+	Unresolved
+};
+
+/**
+ * Fixed file header
+ */
+struct FCombatCaptureHeader
+{
+	uint32 Magic = CombatCapture::Magic;
+	uint16 Version = CombatCapture::Version;
+	uint16 HeaderSize = sizeof(FCombatCaptureHeader);
+
+	/** UTC time the capture started (Unix seconds) */
+	int64 StartUnixTime = 0;
+
+	/** FPlatformTime::Cycles64 at start on the capturing machine (event times are microseconds from here) */
+	uint64 StartCycle = 0;
+
+	uint64 Reserved = 0;
+};
+static_assert(sizeof(FCombatCaptureHeader) == 32, "Capture header layout is part of the file format");
+
+/**
+ * Name table entry
+ */
+struct FCombatCaptureName
+{
+	ECombatCaptureNameKind Kind = ECombatCaptureNameKind::Object;
+	FString Name;
+	FString Detail;
+};
+
+/**
+ * Streams FCombatEventRecorder into a capture file while the game runs
+ *
+ * A core ticker drains the recorder ring every frame on the game thread, resolves object IDs it
+ * hasn't seen yet into the name table and delta-encodes the events into a chunk buffer. Full
+ * buffers (or one per FlushInterval) are handed to a background pipe that appends them to the file,
+ * so the game thread never waits on IO.
+ *
+ * StartStream sends the same bytes (header, then chunks) to any sink instead, e.g. a telemetry
+ * socket (FCombatTelemetryServer) - the receiving end decodes them with FCombatCaptureStreamDecoder.
+ *
+ * Console: Combat.Capture.Start [Path] / Combat.Capture.Stop (default Saved/Combat/Capture_<time>.kcap)
+ */
+class KATANACOMBAT_API FCombatCaptureWriter
+{
+public:
+	/** Receives the header and then each flushed batch of chunks, in order, on a background task */
+	using FSink = TUniqueFunction<void(const uint8* Data, int32 NumBytes)>;
+
+	FCombatCaptureWriter();
+	~FCombatCaptureWriter();
+
+	/** Capture started from the console (nullptr when none) */
+	static FCombatCaptureWriter* GetActive();
+
+	/** Create the file and start draining from the recorder's current position */
+	bool Start(const FString& FilePath);
+
+	/**
+	 * Start draining into a sink instead of a file
+	 * @param Description	Shown in logs in place of the file path
+	 * @param FlushInterval	Longest time events wait in the chunk buffer (seconds; lower = less latency, more, smaller chunks)
+	 */
+	bool StartStream(FSink&& Sink, const FString& Description, double FlushInterval = 1.0);
+
+	/** Drain what's left, flush and close the file (blocks until the background writes finish) */
+	void Stop();
+
+	bool IsCapturing() const { return bCapturing; }
+	const FString& GetFilePath() const { return FilePath; }
+
+	/** Drain the recorder now (normally done by the ticker each frame) */
+	void Drain();
+
+	/** Close the pending chunks and queue them for the background writer (normally done by the ticker) */
+	void Flush();
+
+	uint64 GetNumEventsWritten() const { return NumEventsWritten; }
+	uint64 GetNumEventsLost() const { return NumEventsLost; }
+	int64 GetNumBytesWritten() const { return NumBytesWritten; }
+
+	/** Bytes handed to the background writer that the sink hasn't taken yet (a slow sink shows up here) */
+	int64 GetNumBytesQueued() const { return NumBytesQueued.load(std::memory_order_relaxed); }
+
+private:
+	/** Index for a recorder object ID, adding a name record on first sight (0 = none) */
+	uint32 GetNameIndex(uint32 UniqueId);
+
+	void EncodeEvent(const FCombatRecordedEvent& Event);
+
+	/** Shared by Start and StartStream once the sink is set */
+	void BeginCapture(double InFlushInterval);
+
+	bool Tick(float DeltaTime);
+
+	FString FilePath;
+	bool bCapturing = false;
+	double FlushInterval = 1.0;
+
+	/** Owned by the file sink, closed once WritePipe is empty */
+	IFileHandle* FileHandle = nullptr;
+
+	/** Called only by tasks on WritePipe once the capture starts */
+	FSink Sink;
+	UE::Tasks::FPipe WritePipe;
+	std::atomic<int64> NumBytesQueued{ 0 };
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	uint64 StartCycle = 0;
+	uint64 RecorderPosition = 0;
+	double LastFlushTime = 0.0;
+
+	/** Recorder object ID -> name table index (plus the object it named, IDs are recycled) */
+	struct FNameSlot
+	{
+		uint32 Index = 0;
+		FWeakObjectPtr Object;
+	};
+	TMap<uint32, FNameSlot> NameIndices;
+	uint32 NumNames = 0;
+
+	/** Pending chunk payloads */
+	TArray<uint8> NamesPayload;
+	TArray<uint8> EventsPayload;
+	uint32 NumPendingNames = 0;
+	uint32 NumPendingEvents = 0;
+	uint64 PendingLost = 0;
+
+	/** Delta state of the open events chunk */
+	uint64 PreviousMicros = 0;
+	uint32 PreviousOwner = 0;
+
+	/** Scratch for draining (kept to avoid reallocating every frame) */
+	TArray<FCombatRecordedEvent> DrainBuffer;
+
+	uint64 NumEventsWritten = 0;
+	uint64 NumEventsLost = 0;
+	int64 NumBytesWritten = 0;
+};
+
+/**
+ * Decodes a capture arriving in pieces (telemetry socket), chunk by chunk as each one completes
+ *
+ * Produces the same events as FCombatCaptureReader: OwnerId / SubjectId are name table indices and
+ * Cycle is this machine's FPlatformTime cycles from the start of the stream.
+ */
+class KATANACOMBAT_API FCombatCaptureStreamDecoder
+{
+public:
+	FCombatCaptureStreamDecoder();
+
+	/**
+	 * Append received bytes and decode every chunk that is now complete
+	 * @return false once the stream is not a capture (bad header) - reset before reusing
+	 */
+	bool Feed(const uint8* Bytes, int32 NumBytes, TFunctionRef<void(const FCombatRecordedEvent&)> Visitor);
+
+	void Reset();
+
+	bool HasHeader() const { return bHasHeader; }
+	bool IsValid() const { return bValid; }
+	const FCombatCaptureHeader& GetHeader() const { return Header; }
+
+	/** Name table so far (index 0 = none) */
+	const TArray<FCombatCaptureName>& GetNames() const { return Names; }
+	const FString& GetName(uint32 Index) const { return Names.IsValidIndex(Index) ? Names[Index].Name : Names[0].Name; }
+
+	/** Bumped whenever names are added */
+	uint32 GetNamesVersion() const { return NamesVersion; }
+
+	int64 GetNumEvents() const { return NumEvents; }
+	uint64 GetNumLostEvents() const { return NumLostEvents; }
+
+private:
+	/** Received bytes not yet decoded (ReadOffset onwards) */
+	TArray<uint8> Pending;
+	int32 ReadOffset = 0;
+
+	FCombatCaptureHeader Header;
+	bool bHasHeader = false;
+	bool bValid = true;
+
+	TArray<FCombatCaptureName> Names;
+	uint32 NamesVersion = 0;
+	int64 NumEvents = 0;
+	uint64 NumLostEvents = 0;
+};
+
+/**
+ * Reads a capture through a memory mapping (playback, offline analysis)
+ *
+ * Open validates the header, indexes the chunks and decodes the name table; events are decoded
+ * straight from the mapped pages on demand. Decoded events carry name table indices in OwnerId and
+ * SubjectId and Cycle in this machine's FPlatformTime cycles from the capture start, so they work
+ * with everything that consumes recorder snapshots (FCombatReplayStream::FromEvents etc.).
+ */
+class KATANACOMBAT_API FCombatCaptureReader
+{
+public:
+	FCombatCaptureReader();
+	~FCombatCaptureReader();
+
+	bool Open(const FString& FilePath);
+	void Close();
+	bool IsOpen() const { return Data != nullptr; }
+
+	const FCombatCaptureHeader& GetHeader() const { return Header; }
+
+	int64 GetNumEvents() const { return NumEvents; }
+	uint64 GetNumLostEvents() const { return NumLostEvents; }
+
+	/** Name table (index 0 = none) */
+	const TArray<FCombatCaptureName>& GetNames() const { return Names; }
+	const FString& GetName(uint32 Index) const { return Names.IsValidIndex(Index) ? Names[Index].Name : Names[0].Name; }
+
+	/** Index of the first entry with this name (0 if absent) */
+	uint32 FindName(const FString& Name) const;
+
+	/** Decode every event in file order */
+	void ForEachEvent(TFunctionRef<void(const FCombatRecordedEvent&)> Visitor) const;
+
+	/** Decode events (OwnerIndex 0 = all owners) */
+	int32 ReadEvents(TArray<FCombatRecordedEvent>& OutEvents, uint32 OwnerIndex = 0) const;
+
+	/** Write the capture as CSV in the Combat.DumpEvents layout */
+	bool ExportToCSV(const FString& CsvPath) const;
+
+private:
+	struct FChunk
+	{
+		int64 Offset = 0;
+		uint32 Size = 0;
+		uint32 NumRecords = 0;
+	};
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+
+	FCombatCaptureHeader Header;
+	TArray<FCombatCaptureName> Names;
+	TArray<FChunk> EventChunks;
+	int64 NumEvents = 0;
+	uint64 NumLostEvents = 0;
+};
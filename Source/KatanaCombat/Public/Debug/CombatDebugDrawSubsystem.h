@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatDebugDrawSubsystem.generated.h"
+
+/**
+ * Cached debug label: the string is only rebuilt when the caller's state hash changes
+ *
+ * Owners keep one per label (mutable, drawn from const debug functions) so a character standing in
+ * the same phase with the same queue doesn't Printf / UEnum::GetValueAsString every frame.
+ */
+struct FCombatDebugText
+{
+	/** Returns the cached text, calling Build only if StateHash differs from the last call */
+	const FString& Get(uint32 StateHash, TFunctionRef<FString()> Build)
+	{
+		if (!bValid || StateHash != Hash)
+		{
+			Text = Build();
+			Hash = StateHash;
+			bValid = true;
+		}
+		return Text;
+	}
+
+	void Reset() { bValid = false; }
+
+private:
+	FString Text;
+	uint32 Hash = 0;
+	bool bValid = false;
+};
+
+/**
+ * Batched, budgeted combat debug drawing
+ *
+ * Components queue primitives here instead of calling DrawDebug* directly. Everything queued in a
+ * frame is flushed once in Tick: lines go to the world line batcher in a single call, and when the
+ * frame has more primitives than MaxPrimitivesPerFrame the ones closest to the viewer win.
+ *
+ * Callers check ShouldDraw(Owner) before building anything, so characters that are not selected
+ * (Combat.DebugDraw.Select) or are further than MaxDrawDistance from the local camera pay nothing.
+ *
+ * Console: Combat.DebugDraw.Select [ActorName] (no name = clear), Combat.DebugDraw.Budget [Max] [Distance]
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatDebugDrawSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ============================================================================
+	// SUBSYSTEM
+	// ============================================================================
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	/** Subsystem for Owner's world (nullptr in worlds without one, e.g. during teardown) */
+	static UCombatDebugDrawSubsystem* Get(const UObject* WorldContextObject);
+
+	// ============================================================================
+	// RELEVANCE
+	// ============================================================================
+
+	/** Should debug for this actor be built this frame? (selected, or near the viewer with nothing selected) */
+	bool ShouldDraw(const AActor* Owner) const;
+
+	/** Draw only this actor's debug (nullptr = every actor within MaxDrawDistance) */
+	void SetSelectedActor(AActor* Actor) { SelectedActor = Actor; }
+	AActor* GetSelectedActor() const { return SelectedActor.Get(); }
+
+	/** Primitives flushed per frame across all owners (0 = unlimited) */
+	int32 MaxPrimitivesPerFrame = 512;
+
+	/** Owners further than this from the local camera are skipped (cm, 0 = unlimited) */
+	float MaxDrawDistance = 3000.0f;
+
+	// ============================================================================
+	// PRIMITIVES
+	// ============================================================================
+	// Duration 0 draws for one frame; longer durations are handed to the line batcher with that lifetime.
+
+	void AddLine(const AActor* Owner, const FVector& Start, const FVector& End, const FColor& Color, float Thickness = 0.0f, float Duration = 0.0f);
+	void AddSphere(const AActor* Owner, const FVector& Center, float Radius, int32 Segments, const FColor& Color, float Duration = 0.0f);
+	void AddPoint(const AActor* Owner, const FVector& Position, float Size, const FColor& Color, float Duration = 0.0f);
+	void AddCone(const AActor* Owner, const FVector& Origin, const FVector& Direction, float Length, float HalfAngleRadians, int32 Segments, const FColor& Color, float Duration = 0.0f);
+	void AddString(const AActor* Owner, const FVector& Location, const FString& Text, const FColor& Color, float Duration = 0.0f);
+
+	// ============================================================================
+	// STATS
+	// ============================================================================
+
+	/** Primitives waiting for the next flush */
+	int32 GetNumQueuedPrimitives() const { return Primitives.Num(); }
+
+	/** Primitives drawn / dropped by the budget in the last flush */
+	int32 GetNumDrawnLastFrame() const { return NumDrawnLastFrame; }
+	int32 GetNumDroppedLastFrame() const { return NumDroppedLastFrame; }
+
+private:
+	enum class EPrimitiveType : uint8
+	{
+		Line,
+		Sphere,
+		Point,
+		Cone,
+		String
+	};
+
+	struct FPrimitive
+	{
+		EPrimitiveType Type = EPrimitiveType::Line;
+		FColor Color = FColor::White;
+		FVector A = FVector::ZeroVector;
+		FVector B = FVector::ZeroVector;
+
+		/** Thickness (line), radius (sphere), size (point), length (cone) */
+		float Size = 0.0f;
+
+		/** Half angle in radians (cone) */
+		float Angle = 0.0f;
+		int32 Segments = 0;
+		float Duration = 0.0f;
+
+		/** Owner distance to the viewer, squared (budget priority) */
+		float DistanceSq = 0.0f;
+
+		/** Index into Strings (string) */
+		int32 TextIndex = INDEX_NONE;
+	};
+
+	FPrimitive& AddPrimitive(const AActor* Owner, EPrimitiveType Type, const FColor& Color, float Duration);
+
+	/** Refresh the cached viewer location (once per frame) */
+	void UpdateViewLocation() const;
+
+	TArray<FPrimitive> Primitives;
+	TArray<FString> Strings;
+
+	TWeakObjectPtr<AActor> SelectedActor;
+
+	mutable FVector ViewLocation = FVector::ZeroVector;
+	mutable bool bHasViewLocation = false;
+	mutable uint64 ViewLocationFrame = MAX_uint64;
+
+	int32 NumDrawnLastFrame = 0;
+	int32 NumDroppedLastFrame = 0;
+};
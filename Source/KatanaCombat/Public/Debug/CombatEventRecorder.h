@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Kind of event captured by FCombatEventRecorder
+ */
+enum class ECombatRecordedEventType : uint8
+{
+	/** Arg0 = EInputType, Arg1 = EInputEventType, Arg2 = EAttackPhase, Arg3 = EInputDirection */
+	Input,
+
+	/** Arg0 = EInputType, Arg1 = EResolutionPath, Arg2 = EAttackDirection, SubjectId = attack */
+	AttackResolved,
+
+	/** Arg0 = CombatTrace::EQueueEvent, Arg1 = EInputType, Arg2 = EActionExecutionMode */
+	Queue,
+
+	/** Arg0 = old EAttackPhase, Arg1 = new EAttackPhase */
+	Phase,
+
+	/** Arg0 = EActionWindowType, Arg1 = opened (1) / closed (0), Value = montage time */
+	Window,
+
+	/** SubjectId = hit actor, Arg0 = EAttackType of the attack (0 if unknown) */
+	Hit
+};
+
+KATANACOMBAT_API const TCHAR* LexToString(ECombatRecordedEventType Type);
+
+/**
+ * One recorded combat event (POD - copied into the ring by value)
+ */
+struct FCombatRecordedEvent
+{
+	/** FPlatformTime::Cycles64 at record time */
+	uint64 Cycle = 0;
+
+	/** Object IDs (UObject::GetUniqueID, 0 = none) - names are resolved at export time */
+	uint32 OwnerId = 0;
+	uint32 SubjectId = 0;
+
+	/** Type-specific payload (see ECombatRecordedEventType) */
+	float Value = 0.0f;
+	ECombatRecordedEventType Type = ECombatRecordedEventType::Input;
+	uint8 Arg0 = 0;
+	uint8 Arg1 = 0;
+	uint8 Arg2 = 0;
+	uint8 Arg3 = 0;
+};
+
+/**
+ * Always-on black-box recorder for combat events
+ *
+ * Fixed-size ring (no allocation after startup) that overwrites the oldest events.
+ * Writers claim a slot with one atomic increment and publish it through a per-slot
+ * sequence number, so recording never locks and readers (dope sheet, exporter) can
+ * snapshot from any thread while the game keeps writing. Torn slots are skipped.
+ *
+ * Fed by the CombatTrace::Output* functions, so it stays enabled in Shipping builds
+ * where the Insights channel compiles out.
+ * Console: Combat.DumpEvents [Path] writes the ring as CSV (default Saved/Combat/),
+ *          Combat.ExportTrace [Path] as Chrome trace JSON (FCombatTraceEventWriter)
+ */
+class KATANACOMBAT_API FCombatEventRecorder
+{
+public:
+	/** Ring size (power of two) */
+	static constexpr uint32 Capacity = 4096;
+
+	static FCombatEventRecorder& Get();
+
+	/** Append an event (lock-free, safe from any thread) */
+	void Record(const FCombatRecordedEvent& Event);
+
+	/**
+	 * Copy the most recent events, oldest first
+	 * @param OutEvents - Receives the events (reset first)
+	 * @param MaxEvents - Cap on events copied
+	 * @param OwnerId - Only events for this owner (0 = all)
+	 * @return Number of events copied
+	 */
+	int32 Snapshot(TArray<FCombatRecordedEvent>& OutEvents, int32 MaxEvents = Capacity, uint32 OwnerId = 0) const;
+
+	/**
+	 * Copy every event recorded from StartIndex on, oldest first (streaming consumers, e.g. FCombatCaptureWriter)
+	 * @param StartIndex - Recorder position returned by the previous call (0 = from the oldest kept event)
+	 * @param OutEvents - Receives the events (appended)
+	 * @param OutNumLost - Events at or after StartIndex already overwritten or torn
+	 * @return Position to continue from (stops before a slot still being written)
+	 */
+	uint64 ReadSince(uint64 StartIndex, TArray<FCombatRecordedEvent>& OutEvents, uint64& OutNumLost) const;
+
+	/** Total events recorded since startup (including overwritten ones) */
+	uint64 GetNumRecorded() const { return WriteIndex.load(std::memory_order_acquire); }
+
+	/** Stop/resume recording (Record becomes a single relaxed load when disabled) */
+	void SetEnabled(bool bInEnabled) { bEnabled.store(bInEnabled, std::memory_order_relaxed); }
+	bool IsEnabled() const { return bEnabled.load(std::memory_order_relaxed); }
+
+	/** Write the current ring as CSV (cycle, seconds, type, owner, subject, args, value) */
+	bool ExportToCSV(const FString& FilePath) const;
+
+private:
+	FCombatEventRecorder() = default;
+
+	struct FSlot
+	{
+		/** 2*Index+1 while being written, 2*Index+2 once published */
+		std::atomic<uint64> Sequence{ 0 };
+		FCombatRecordedEvent Event;
+	};
+
+	FSlot Slots[Capacity];
+	std::atomic<uint64> WriteIndex{ 0 };
+	std::atomic<bool> bEnabled{ true };
+};
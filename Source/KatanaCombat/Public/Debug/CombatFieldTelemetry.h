@@ -0,0 +1,198 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Debug/CombatTrace.h"
+#include "ActionQueueTypes.h"
+
+/**
+ * Log-bucketed histogram for field telemetry: quarter octaves from Base, fixed size and allocation free
+ * Same layout as FActionLatencyHistogram with a caller-chosen base, so it also fits sub-millisecond
+ * costs and small counts. Percentiles resolve to the bucket upper bound, capped at the observed max.
+ */
+struct FCombatFieldHistogram
+{
+	static constexpr int32 NumBuckets = 48;
+	static constexpr int32 BucketsPerOctave = 4;
+
+	double Base = 1.0;
+	uint32 Buckets[NumBuckets] = {};
+	uint32 SampleCount = 0;
+	double Max = 0.0;
+	double Sum = 0.0;
+
+	explicit FCombatFieldHistogram(double InBase = 1.0)
+		: Base(InBase)
+	{
+	}
+
+	void Add(double Value)
+	{
+		Value = FMath::Max(Value, 0.0);
+		const int32 Index = Value <= Base ? 0
+			: FMath::Min(FMath::CeilToInt32(BucketsPerOctave * FMath::Log2(Value / Base)), NumBuckets - 1);
+		++Buckets[Index];
+		++SampleCount;
+		Max = FMath::Max(Max, Value);
+		Sum += Value;
+	}
+
+	/** Upper bound of bucket Index */
+	double GetBucketUpper(int32 Index) const
+	{
+		return Base * FMath::Pow(2.0, static_cast<double>(Index) / BucketsPerOctave);
+	}
+
+	/** Percentile (Percentile in [0,1]); 0 when empty */
+	double GetPercentile(double Percentile) const;
+
+	double GetMean() const { return SampleCount > 0 ? Sum / SampleCount : 0.0; }
+
+	/** Clear the samples, keeping the base */
+	void Reset()
+	{
+		*this = FCombatFieldHistogram(Base);
+	}
+};
+
+/**
+ * One upload: everything aggregated since the previous batch of the session
+ */
+struct KATANACOMBAT_API FCombatFieldTelemetryBatch
+{
+	FString SessionId;
+
+	/** Batches of a session count up from 0 */
+	int32 Sequence = 0;
+
+	/** Seconds covered by this batch */
+	double Duration = 0.0;
+
+	/** Frames with combat work (only those are sampled below) */
+	int32 NumCombatFrames = 0;
+
+	/** Input received -> action executed / montage first advancing, by EActionExecutionMode (ms) */
+	FCombatFieldHistogram InputToExecuteMs[2] = { FCombatFieldHistogram(0.5), FCombatFieldHistogram(0.5) };
+	FCombatFieldHistogram InputToFirstFrameMs[2] = { FCombatFieldHistogram(0.5), FCombatFieldHistogram(0.5) };
+
+	/** V2 queue depth after each queued action */
+	FCombatFieldHistogram QueueDepth = FCombatFieldHistogram(1.0);
+
+	/** Combat frame budget (all categories) per frame with combat work (ms) */
+	FCombatFieldHistogram CombatFrameMs = FCombatFieldHistogram(0.01);
+
+	/** Physics queries issued by combat per frame with combat work */
+	FCombatFieldHistogram TracesPerFrame = FCombatFieldHistogram(1.0);
+
+	int32 ActionsQueued = 0;
+	int32 ActionsExecuted = 0;
+	int32 ActionsCancelled = 0;
+
+	/** Nothing was recorded */
+	bool IsEmpty() const { return NumCombatFrames == 0 && ActionsQueued == 0 && ActionsExecuted == 0 && ActionsCancelled == 0; }
+
+	/** Compact JSON: summaries plus sparse [bucket, count] pairs, with the device it came from */
+	FString ToJson() const;
+};
+
+/**
+ * On-device aggregation of combat input latency and cost for real player hardware
+ *
+ * While a session runs, the V2 queue and CombatBudget feed fixed-size histograms (no per-event
+ * storage, nothing streamed): input latency by execution mode, queue depth, queued / executed /
+ * cancelled actions, combat ms per frame and combat physics queries per frame. Every UploadInterval
+ * the aggregate is closed into an FCombatFieldTelemetryBatch, serialized to a few hundred bytes of
+ * JSON and handed to the uploader - an HTTP POST to UploadUrl, or a file under
+ * Saved/Combat/FieldTelemetry when no URL is set (for a platform service to pick up).
+ *
+ * Recording happens on the game thread. Off by default; games start it once the player has opted in.
+ * Console: Combat.FieldTelemetry.Start [Url] / Combat.FieldTelemetry.Stop / Combat.FieldTelemetry.Dump;
+ * command line: -CombatFieldTelemetry[=Url]
+ */
+class KATANACOMBAT_API FCombatFieldTelemetry
+{
+public:
+	/** Receives each serialized batch on the game thread */
+	using FUploader = TUniqueFunction<void(const FString& Json)>;
+
+	static FCombatFieldTelemetry& Get();
+
+	~FCombatFieldTelemetry();
+
+	/**
+	 * Start a session (a new session ID; an open one is uploaded first)
+	 * @param InUploadUrl		HTTP endpoint the batches are POSTed to (empty = write them to Saved/Combat/FieldTelemetry)
+	 * @param InUploadInterval	Seconds between batches
+	 */
+	void Start(const FString& InUploadUrl = FString(), double InUploadInterval = 300.0);
+
+	/** Upload what's left and stop recording */
+	void Stop();
+
+	bool IsEnabled() const { return bEnabled; }
+
+	/** Replace the default uploader (platform telemetry service, tests). Pass nullptr to restore it */
+	void SetUploader(FUploader&& InUploader) { Uploader = MoveTemp(InUploader); }
+
+	/** Close the current batch and upload it (skipped when nothing was recorded) */
+	void Flush();
+
+	/** Close the current batch and return it instead of uploading */
+	FCombatFieldTelemetryBatch TakeBatch();
+
+	/** Batch still aggregating */
+	const FCombatFieldTelemetryBatch& GetCurrentBatch() const { return Batch; }
+
+	/** Sample this frame's combat cost (normally done by the ticker every frame) */
+	void SampleFrame();
+
+	// Recording (called by the combat systems; no-ops while disabled)
+	void RecordInputLatency(EActionExecutionMode Mode, double Seconds, bool bFirstFrame)
+	{
+		if (bEnabled)
+		{
+			FCombatFieldHistogram* Histograms = bFirstFrame ? Batch.InputToFirstFrameMs : Batch.InputToExecuteMs;
+			Histograms[Mode == EActionExecutionMode::Immediate ? 0 : 1].Add(Seconds * 1000.0);
+		}
+	}
+
+	void RecordQueueDepth(int32 Depth)
+	{
+		if (bEnabled)
+		{
+			Batch.QueueDepth.Add(Depth);
+		}
+	}
+
+	void RecordQueueEvent(CombatTrace::EQueueEvent Event);
+
+private:
+	FCombatFieldTelemetry() = default;
+
+	bool Tick(float DeltaTime);
+
+	/** Default uploader: POST to UploadUrl, or write a file */
+	void Upload(const FCombatFieldTelemetryBatch& Closed, const FString& Json) const;
+
+	/** Start the next batch of the session */
+	void BeginBatch();
+
+	bool bEnabled = false;
+
+	FString SessionId;
+	int32 NextSequence = 0;
+	FString UploadUrl;
+	double UploadInterval = 300.0;
+	double BatchStartTime = 0.0;
+
+	FCombatFieldTelemetryBatch Batch;
+	FUploader Uploader;
+
+	/** CombatBudget totals at the last frame sample */
+	uint64 LastBudgetCycles = 0;
+	uint64 LastPhysicsQueries = 0;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
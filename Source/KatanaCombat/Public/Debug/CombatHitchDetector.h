@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Debug/CombatEventRecorder.h"
+#include "Debug/CombatTrace.h"
+
+/**
+ * What combat was doing during one long frame
+ */
+struct KATANACOMBAT_API FCombatHitchReport
+{
+	/** Local time the hitch was detected */
+	FDateTime Time;
+
+	/** Wall clock length of the frame (ms) */
+	double FrameMs = 0.0;
+
+	/** FPlatformTime::Cycles64 when the frame started (events from here on happened during it) */
+	uint64 FrameStartCycle = 0;
+
+	/** Combat frame budget charged during the frame, by ECombatBudgetCategory (ms) */
+	double SystemMs[static_cast<int32>(ECombatBudgetCategory::Count)] = {};
+
+	/** Physics queries issued by combat during the frame */
+	uint64 PhysicsQueries = 0;
+
+	/** Events recorded during the frame (may be more than Events holds) */
+	uint64 NumFrameEvents = 0;
+
+	/** Last events of the recorder, oldest first, including some from before the frame */
+	TArray<FCombatRecordedEvent> Events;
+
+	/** Object names for the IDs in Events, resolved while the objects were still alive */
+	TMap<uint32, FString> ObjectNames;
+
+	/** Combat budget over all categories (ms) */
+	double GetCombatMs() const;
+
+	/** Events of one type recorded during the frame (within Events) */
+	int32 CountFrameEvents(ECombatRecordedEventType Type) const;
+
+	/** Readable report: summary, per-type counts of the frame, then the event list relative to the frame start */
+	FString ToString() const;
+};
+
+/**
+ * Captures combat context for frames that run over a threshold
+ *
+ * A core ticker times every frame on the wall clock and keeps the CombatBudget totals of the previous
+ * one - a handful of atomic loads, cheap enough to leave on in Development and Test builds. When a frame
+ * exceeds ThresholdMs, the last NumEvents entries of FCombatEventRecorder and the combat system timers
+ * for that frame go into an FCombatHitchReport, written to Saved/Combat/Hitches on a background task.
+ * A wave spawn shows up as a burst of phase events, a cleave as a run of hits from one owner.
+ *
+ * Reports are rate limited (MinReportInterval, MaxReports per session) so a slow area can't flood the disk.
+ * Starts by itself in non-editor, non-shipping builds (-NoCombatHitchCapture to opt out).
+ * Console: Combat.Hitch.Start [ThresholdMs] [NumEvents] / Combat.Hitch.Stop; command line: -CombatHitchCapture[=ThresholdMs]
+ */
+class KATANACOMBAT_API FCombatHitchDetector
+{
+public:
+	/** Receives each report on the game thread */
+	using FReportHandler = TUniqueFunction<void(const FCombatHitchReport& Report)>;
+
+	static FCombatHitchDetector& Get();
+
+	~FCombatHitchDetector();
+
+	/**
+	 * Start timing frames (restarts the report count)
+	 * @param InThresholdMs	Frames longer than this are reported
+	 * @param InNumEvents	Recorder entries copied into each report
+	 */
+	void Start(double InThresholdMs = 50.0, int32 InNumEvents = 128);
+
+	void Stop();
+
+	bool IsEnabled() const { return bEnabled; }
+
+	/** Replace the default file writer (tests, a crash reporter). Pass nullptr to restore it */
+	void SetReportHandler(FReportHandler&& InHandler) { ReportHandler = MoveTemp(InHandler); }
+
+	/**
+	 * Check a frame that took FrameSeconds (normally done by the ticker every frame with the wall clock time)
+	 * @return true if it was reported
+	 */
+	bool CheckFrame(double FrameSeconds);
+
+	/** Shortest time between two reports (s) */
+	double MinReportInterval = 5.0;
+
+	/** Reports per session, after which hitches are only counted */
+	int32 MaxReports = 20;
+
+	double GetThresholdMs() const { return ThresholdMs; }
+	int32 GetNumHitches() const { return NumHitches; }
+	int32 GetNumReports() const { return NumReports; }
+
+private:
+	FCombatHitchDetector() = default;
+
+	bool Tick(float DeltaTime);
+
+	/** Default handler: write the report to Saved/Combat/Hitches */
+	static void WriteReport(const FCombatHitchReport& Report);
+
+	bool bEnabled = false;
+	double ThresholdMs = 50.0;
+	int32 NumEvents = 128;
+
+	int32 NumHitches = 0;
+	int32 NumReports = 0;
+	double LastReportTime = -UE_BIG_NUMBER;
+
+	/** Start of the frame being timed */
+	uint64 FrameStartCycle = 0;
+
+	/** CombatBudget totals and recorder position at the start of the frame */
+	uint64 FrameStartBudgetCycles[static_cast<int32>(ECombatBudgetCategory::Count)] = {};
+	uint64 FrameStartPhysicsQueries = 0;
+	uint64 FrameStartNumRecorded = 0;
+
+	FReportHandler ReportHandler;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
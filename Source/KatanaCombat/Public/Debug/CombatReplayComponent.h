@@ -0,0 +1,189 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CombatTypes.h"
+#include "Debug/CombatEventRecorder.h"
+#include "CombatReplayComponent.generated.h"
+
+class UCombatComponentV2;
+class FCombatCaptureReader;
+
+/**
+ * One input of a recorded stream (seconds from the first captured event)
+ */
+struct FCombatReplayInput
+{
+	float Time = 0.0f;
+	EInputType InputType = EInputType::None;
+	EInputEventType EventType = EInputEventType::Press;
+	EInputDirection Direction = EInputDirection::None;
+};
+
+/**
+ * Phase/queue event the replay must reproduce (compared by type and args, not time)
+ */
+struct FCombatReplayExpectedEvent
+{
+	ECombatRecordedEventType Type = ECombatRecordedEventType::Phase;
+	uint8 Arg0 = 0;
+	uint8 Arg1 = 0;
+	uint8 Arg2 = 0;
+
+	bool operator==(const FCombatReplayExpectedEvent& Other) const
+	{
+		return Type == Other.Type && Arg0 == Other.Arg0 && Arg1 == Other.Arg1 && Arg2 == Other.Arg2;
+	}
+};
+
+/**
+ * Recorded input stream plus the phase/queue events it produced
+ */
+struct KATANACOMBAT_API FCombatReplayStream
+{
+	TArray<FCombatReplayInput> Inputs;
+	TArray<FCombatReplayExpectedEvent> Expected;
+
+	/** Seconds from the first captured event to the last one */
+	float Duration = 0.0f;
+
+	bool IsEmpty() const { return Inputs.Num() == 0; }
+
+	/** Build a stream from recorded events of one owner (oldest first, as returned by FCombatEventRecorder::Snapshot) */
+	static FCombatReplayStream FromEvents(TConstArrayView<FCombatRecordedEvent> Events, uint32 OwnerId);
+
+	/**
+	 * Build one stream per owner with inputs in a capture (QA sessions, bug reports), in name table order
+	 * @param OutOwnerNames - Optional: the owner each stream was recorded from
+	 * @return Number of streams
+	 */
+	static int32 FromCapture(const FCombatCaptureReader& Reader, TArray<FCombatReplayStream>& OutStreams, TArray<FString>* OutOwnerNames = nullptr);
+
+	/** Is this event compared during replay? (phase transitions and queue ops) */
+	static bool IsComparedEvent(const FCombatRecordedEvent& Event);
+
+	static FCombatReplayExpectedEvent ToExpected(const FCombatRecordedEvent& Event);
+
+	bool SaveToFile(const FString& FilePath) const;
+	bool LoadFromFile(const FString& FilePath);
+
+	friend FArchive& operator<<(FArchive& Ar, FCombatReplayStream& Stream);
+};
+
+/**
+ * Outcome of a replay
+ */
+USTRUCT(BlueprintType)
+struct FCombatReplayResult
+{
+	GENERATED_BODY()
+
+	/** Every expected event was reproduced in order and nothing extra happened */
+	UPROPERTY(BlueprintReadOnly, Category = "Replay")
+	bool bMatched = false;
+
+	/** Events compared (min of expected/actual counts) */
+	UPROPERTY(BlueprintReadOnly, Category = "Replay")
+	int32 NumCompared = 0;
+
+	/** Index of the first differing event (INDEX_NONE when matched) */
+	UPROPERTY(BlueprintReadOnly, Category = "Replay")
+	int32 FirstMismatchIndex = INDEX_NONE;
+
+	/** Human-readable summary for logs/bug reports */
+	UPROPERTY(BlueprintReadOnly, Category = "Replay")
+	FString Description;
+
+	/** Compare expected events against events produced by the replay */
+	static KATANACOMBAT_API FCombatReplayResult Compare(TConstArrayView<FCombatReplayExpectedEvent> Expected, TConstArrayView<FCombatReplayExpectedEvent> Actual);
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCombatReplayFinished, const FCombatReplayResult&, Result);
+
+/**
+ * Deterministic replay of a recorded combat input stream
+ *
+ * Captures the owner's inputs from FCombatEventRecorder, then drives
+ * UCombatComponentV2::OnInputEvent from that stream on a fixed timestep
+ * (FApp fixed delta time for the duration of the replay) and compares the
+ * resulting phase/queue events against the capture.
+ *
+ * Uses: identical workloads for perf regression runs, and reproducing timing
+ * bugs (e.g. directional follow-up loops) from a bug report capture.
+ * Live input is not blocked - leave the controller alone during a replay.
+ */
+UCLASS(Blueprintable, ClassGroup = (Combat), meta = (BlueprintSpawnableComponent))
+class KATANACOMBAT_API UCombatReplayComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCombatReplayComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Fixed simulation step used while replaying */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Replay", meta = (ClampMin = "0.001"))
+	float FixedTimeStep = 1.0f / 60.0f;
+
+	/** Extra time simulated after the last captured event before comparing */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Replay", meta = (ClampMin = "0.0"))
+	float SettleTime = 1.0f;
+
+	/** Broadcast when a replay finishes (or is stopped) */
+	UPROPERTY(BlueprintAssignable, Category = "Combat|Replay")
+	FOnCombatReplayFinished OnReplayFinished;
+
+	/** Capture this owner's recorded events into a replay file */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Replay")
+	bool SaveCapture(const FString& FilePath) const;
+
+	/** Load a replay file and start replaying it */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Replay")
+	bool StartReplayFromFile(const FString& FilePath);
+
+	/** Replay this owner's inputs from a streamed capture (.kcap, matched by owner name) */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Replay")
+	bool StartReplayFromCapture(const FString& CapturePath);
+
+	/** Start replaying a stream (restarts if already replaying) */
+	bool StartReplay(const FCombatReplayStream& Stream);
+
+	/** Abort the current replay (reports the partial comparison) */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Replay")
+	void StopReplay();
+
+	UFUNCTION(BlueprintPure, Category = "Combat|Replay")
+	bool IsReplaying() const { return bReplaying; }
+
+	UFUNCTION(BlueprintPure, Category = "Combat|Replay")
+	const FCombatReplayResult& GetLastResult() const { return LastResult; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	UPROPERTY()
+	TObjectPtr<UCombatComponentV2> CombatComponent;
+
+	FCombatReplayStream ActiveStream;
+	FCombatReplayResult LastResult;
+
+	/** Simulated replay clock (advances FixedTimeStep per tick) */
+	float ReplayTime = 0.0f;
+	int32 NextInputIndex = 0;
+
+	/** Recorder position when the replay started (events after it are the replay's output) */
+	uint64 RecordStartIndex = 0;
+
+	bool bReplaying = false;
+
+	/** Engine fixed-timestep state restored after the replay */
+	bool bSavedUseFixedTimeStep = false;
+	double SavedFixedDeltaTime = 0.0;
+
+	void FinishReplay();
+};
@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Debug/CombatTrace.h"
+#include "CombatStateTraceSubsystem.generated.h"
+
+class UCombatComponent;
+class UCombatComponentV2;
+
+/**
+ * Samples every registered character's combat state once per frame onto the CombatState trace channel
+ *
+ * The combat components are event driven and mostly don't tick, so the Rewind Debugger's combat track
+ * (KatanaCombatEditor) is fed from here instead: phase, ECombatState, posture, the V2 queue and the
+ * active checkpoints, sent only on frames where something changed. Does nothing (and doesn't tick)
+ * unless the channel is enabled: -trace=default,object,combatstate or Trace.Enable CombatState.
+ */
+UCLASS()
+class KATANACOMBAT_API UCombatStateTraceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ============================================================================
+	// SUBSYSTEM
+	// ============================================================================
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	static UCombatStateTraceSubsystem* Get(const UObject* WorldContextObject);
+
+	// ============================================================================
+	// SOURCES
+	// ============================================================================
+
+	/** Sample this component (and its owner's V2 component, if any) while the channel is on */
+	void RegisterCombatComponent(UCombatComponent* CombatComponent);
+
+	/** Build the sample for one character (V2 phase wins when both components exist) */
+	static void MakeSample(const UCombatComponent* CombatComponent, const UCombatComponentV2* CombatComponentV2, CombatTrace::FCombatStateSample& OutSample);
+
+	int32 GetNumSources() const { return Sources.Num(); }
+
+	/** Samples sent since the subsystem started */
+	int32 GetNumSamplesSent() const { return NumSamplesSent; }
+
+private:
+	struct FSource
+	{
+		TWeakObjectPtr<UCombatComponent> CombatComponent;
+		TWeakObjectPtr<UCombatComponentV2> CombatComponentV2;
+
+		CombatTrace::FCombatStateSample LastSample;
+		bool bHasLastSample = false;
+	};
+
+	/** Registered characters (swap-removed once the component is gone) */
+	TArray<FSource> Sources;
+
+	/** Was the channel on last frame? (resend everything after it's re-enabled) */
+	bool bWasEnabled = false;
+
+	int32 NumSamplesSent = 0;
+};
@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Debug/CombatCapture.h"
+#include <atomic>
+
+class FSocket;
+
+/** Remote telemetry is a development tool - compiled out of Shipping */
+#ifndef COMBAT_TELEMETRY_ENABLED
+	#define COMBAT_TELEMETRY_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+#if COMBAT_TELEMETRY_ENABLED
+
+/**
+ * Streams the combat event recorder from a running game to one remote viewer over TCP
+ *
+ * The stream is a capture (.kcap) sent live: header, then names / events / lost chunks flushed
+ * every FlushInterval by an FCombatCaptureWriter, so a busy fight costs a few KB/s and the device
+ * only pays for draining the recorder ring - nothing is drawn on target. Sends happen on the
+ * writer's background pipe; a viewer that falls more than MaxQueuedBytes behind is dropped rather
+ * than letting the queue grow.
+ *
+ * The editor connects with FCombatTelemetryClient (Window > Katana Combat Telemetry).
+ * Console: Combat.Telemetry.Start [Port] / Combat.Telemetry.Stop; command line: -CombatTelemetry[=Port]
+ */
+class KATANACOMBAT_API FCombatTelemetryServer
+{
+public:
+	static constexpr int32 DefaultPort = 41650;
+
+	FCombatTelemetryServer() = default;
+	~FCombatTelemetryServer();
+
+	/** Server started from the console or command line (nullptr when none) */
+	static FCombatTelemetryServer* GetActive();
+
+	/** Listen for a viewer (the stream starts when one connects) */
+	bool Start(int32 InPort = DefaultPort);
+
+	/** Drop the viewer and stop listening */
+	void Stop();
+
+	bool IsListening() const { return ListenSocket != nullptr; }
+	bool IsStreaming() const { return ClientSocket != nullptr; }
+	int32 GetPort() const { return Port; }
+
+	/** Bytes sent to viewers since Start */
+	int64 GetNumBytesSent() const { return NumBytesSent.load(std::memory_order_relaxed); }
+
+	/** Longest time an event waits before it's sent (seconds) */
+	double FlushInterval = 0.1;
+
+	/** Viewer is dropped when this much is waiting to be sent */
+	int64 MaxQueuedBytes = 4 * 1024 * 1024;
+
+private:
+	bool Tick(float DeltaTime);
+
+	void AcceptClient();
+	void DropClient(const TCHAR* Reason);
+
+	FSocket* ListenSocket = nullptr;
+	FSocket* ClientSocket = nullptr;
+	int32 Port = 0;
+
+	/** Recreated per viewer so each one gets a header and full name table */
+	TUniquePtr<FCombatCaptureWriter> Writer;
+
+	/** Set by the send task when the viewer went away */
+	std::atomic<bool> bSendFailed{ false };
+	std::atomic<int64> NumBytesSent{ 0 };
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
+
+/**
+ * Receives an FCombatTelemetryServer stream and decodes it as it arrives
+ *
+ * Non-blocking: Poll reads whatever is waiting and hands decoded events to the visitor
+ * (editor tick, tests). Event times are seconds from the start of the stream.
+ */
+class KATANACOMBAT_API FCombatTelemetryClient
+{
+public:
+	FCombatTelemetryClient() = default;
+	~FCombatTelemetryClient();
+
+	/** Connect to Host (name or address) on Port */
+	bool Connect(const FString& Host, int32 Port = FCombatTelemetryServer::DefaultPort);
+	void Disconnect();
+
+	bool IsConnected() const { return Socket != nullptr; }
+
+	/** Decode everything received since the last poll (false once the connection closed) */
+	bool Poll(TFunctionRef<void(const FCombatRecordedEvent&)> Visitor);
+
+	const FCombatCaptureStreamDecoder& GetDecoder() const { return Decoder; }
+	int64 GetNumBytesReceived() const { return NumBytesReceived; }
+
+private:
+	FSocket* Socket = nullptr;
+	FCombatCaptureStreamDecoder Decoder;
+	TArray<uint8> ReceiveBuffer;
+	int64 NumBytesReceived = 0;
+};
+
+#endif // COMBAT_TELEMETRY_ENABLED
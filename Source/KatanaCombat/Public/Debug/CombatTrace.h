@@ -0,0 +1,236 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/PlatformTime.h"
+#include "Trace/Trace.h"
+#include "CombatTypes.h"
+
+class UAttackData;
+enum class EResolutionPath : uint8;
+enum class EInputEventType : uint8;
+enum class EActionWindowType : uint8;
+enum class EActionExecutionMode : uint8;
+
+// ============================================================================
+// LOG CATEGORY
+// ============================================================================
+
+/**
+ * Log category for Combat System
+ * Usage: UE_LOG(LogCombat, Log, TEXT("Message"));
+ * Console: Log LogCombat Verbose (enable detailed logging)
+ * Console: Log LogCombat Warning (only warnings/errors)
+ * Console: Log LogCombat Off (disable all combat logging)
+ */
+DECLARE_LOG_CATEGORY_EXTERN(LogCombat, Log, All);
+
+// ============================================================================
+// STATS
+// ============================================================================
+
+/** Hot-path cycle counters (console: stat KatanaCombat) */
+DECLARE_STATS_GROUP(TEXT("KatanaCombat"), STATGROUP_KatanaCombat, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PerformWeaponTrace"), STAT_Combat_PerformWeaponTrace, STATGROUP_KatanaCombat, KATANACOMBAT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ValidateHitClaim"), STAT_Combat_ValidateHitClaim, STATGROUP_KatanaCombat, KATANACOMBAT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindTarget"), STAT_Combat_FindTarget, STATGROUP_KatanaCombat, KATANACOMBAT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ProcessQueue"), STAT_Combat_ProcessQueue, STATGROUP_KatanaCombat, KATANACOMBAT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ResolveNextAttack_V2"), STAT_Combat_ResolveNextAttack, STATGROUP_KatanaCombat, KATANACOMBAT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DiscoverCheckpoints"), STAT_Combat_DiscoverCheckpoints, STATGROUP_KatanaCombat, KATANACOMBAT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AnimNotify"), STAT_Combat_AnimNotify, STATGROUP_KatanaCombat, KATANACOMBAT_API);
+
+/**
+ * CSV profiler categories (csvprofile start / ACombatEnemySpawner stress mode / ACombatBenchmarkDirector)
+ * KatanaCombat holds crowd/impact timings and PhysicsQueries, the scene query count per frame.
+ * The per-system categories mirror the hot cycle counters and can be toggled with -csvCategories.
+ */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(KATANACOMBAT_API, KatanaCombat);
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(KATANACOMBAT_API, KatanaCombatTraces);    // Weapon sweeps and blade narrowphase
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(KATANACOMBAT_API, KatanaCombatQueue);     // V2 action queue processing
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(KATANACOMBAT_API, KatanaCombatTargeting); // Target selection
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(KATANACOMBAT_API, KatanaCombatAnim);      // Anim instance updates and combat notifies
+
+#define COMBAT_CSV_SCOPE(Stat) CSV_SCOPED_TIMING_STAT(KatanaCombat, Stat)
+
+/** Time the enclosing scope in a per-system category, e.g. COMBAT_CSV_SCOPE_IN(Traces, PerformWeaponTrace) */
+#define COMBAT_CSV_SCOPE_IN(Category, Stat) CSV_SCOPED_TIMING_STAT(KatanaCombat##Category, Stat)
+#define COMBAT_COUNT_PHYSICS_QUERY() do { CSV_CUSTOM_STAT(KatanaCombat, PhysicsQueries, 1, ECsvCustomStatOp::Accumulate); CombatBudget::AddPhysicsQueries(1); } while (0)
+
+/**
+ * Frame budget categories (UCombatBudgetSubsystem). Mirror the CSV categories; charged with
+ * COMBAT_BUDGET_SCOPE at each system's top-level entry points so the timings are readable at runtime.
+ */
+enum class ECombatBudgetCategory : uint8
+{
+	Traces,
+	Targeting,
+	Queue,
+	Anim,
+	Count
+};
+
+namespace CombatBudget
+{
+	/** Add time to a category (thread safe - anim updates charge from worker threads) */
+	KATANACOMBAT_API void AddCycles(ECombatBudgetCategory Category, uint64 Cycles);
+
+	/** Cycles charged to a category since startup (readers diff consecutive samples) */
+	KATANACOMBAT_API uint64 GetTotalCycles(ECombatBudgetCategory Category);
+
+	/** Count combat physics queries (COMBAT_COUNT_PHYSICS_QUERY, thread safe) */
+	KATANACOMBAT_API void AddPhysicsQueries(uint32 NumQueries);
+
+	/** Combat physics queries since startup (readers diff consecutive samples) */
+	KATANACOMBAT_API uint64 GetTotalPhysicsQueries();
+
+	struct FScope
+	{
+		explicit FScope(ECombatBudgetCategory InCategory)
+			: Category(InCategory)
+			, StartCycles(FPlatformTime::Cycles64())
+		{
+		}
+
+		~FScope()
+		{
+			AddCycles(Category, FPlatformTime::Cycles64() - StartCycles);
+		}
+
+	private:
+		ECombatBudgetCategory Category;
+		uint64 StartCycles;
+	};
+}
+
+/** Charge the enclosing scope to a frame budget, e.g. COMBAT_BUDGET_SCOPE(Traces). Outermost scopes only - nesting counts twice */
+#define COMBAT_BUDGET_SCOPE(Category) CombatBudget::FScope PREPROCESSOR_JOIN(CombatBudgetScope, __LINE__)(ECombatBudgetCategory::Category)
+
+/** Input-to-action latency percentiles (console: stat CombatLatency) */
+DECLARE_STATS_GROUP(TEXT("Combat Latency"), STATGROUP_CombatLatency, STATCAT_Advanced);
+
+// ============================================================================
+// MEMORY TRACKING
+// ============================================================================
+
+/**
+ * Low Level Memory Tracker tags (run with -llm; console: stat LLMFULL, or -trace=memtag for Insights)
+ * Everything nests under Combat. Combat.DumpMemory prints the per-character breakdown.
+ */
+LLM_DECLARE_TAG_API(Combat, KATANACOMBAT_API);
+LLM_DECLARE_TAG_API(Combat_Components, KATANACOMBAT_API);      // Combat components created with each character
+LLM_DECLARE_TAG_API(Combat_CheckpointCache, KATANACOMBAT_API); // UMontageCheckpointCache tables and per-attack copies
+LLM_DECLARE_TAG_API(Combat_ActionQueue, KATANACOMBAT_API);     // V2 component (inline action queue) and input bookkeeping
+LLM_DECLARE_TAG_API(Combat_AttackGraph, KATANACOMBAT_API);     // Compiled combo graphs and combo preload windows
+LLM_DECLARE_TAG_API(Combat_DebugRecorder, KATANACOMBAT_API);   // Event recorder snapshots, CSV export, replay streams
+LLM_DECLARE_TAG_API(Combat_DopeSheet, KATANACOMBAT_API);       // Debug dope sheet tracks
+
+/** Tag allocations in the enclosing scope, e.g. COMBAT_LLM_SCOPE(CheckpointCache) */
+#define COMBAT_LLM_SCOPE(Tag) LLM_SCOPE_BYTAG(Combat_##Tag)
+
+// ============================================================================
+// COMBAT TRACING
+// ============================================================================
+//
+// Hot-path instrumentation for the combat system:
+// - COMBAT_LOG:         UE_LOG on LogCombat that compiles out in Shipping/Test
+// - COMBAT_TRACE_SCOPE: CPU profiler scope visible in Unreal Insights
+// - CombatTrace::*:     structured trace events on the Combat channel (no string formatting),
+//                       also captured by FCombatEventRecorder in every build configuration
+//
+// Use COMBAT_LOG for per-input / per-frame diagnostics. Warnings and errors that
+// indicate bad data should keep using UE_LOG so they survive into shipping builds.
+// - stat KatanaCombat:  cycle counters for the hot functions (SCOPE_CYCLE_COUNTER(STAT_Combat_*))
+// - CSV KatanaCombat*:  the same hot functions by system plus per-frame physics query counts (COMBAT_CSV_SCOPE_IN / COMBAT_COUNT_PHYSICS_QUERY)
+// - COMBAT_BUDGET_SCOPE: per-system frame time read back by UCombatBudgetSubsystem (available in every build configuration)
+// - FCombatAttackProfiler: the same hot paths charged to the UAttackData that caused them (Combat.AttackProfile.*)
+//
+// Enable structured events with: -trace=cpu,combat
+// Per-frame combat state for the Rewind Debugger track: -trace=default,object,combatstate
+
+#ifndef COMBAT_VERBOSE_LOGGING
+	#define COMBAT_VERBOSE_LOGGING !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+#endif
+
+#if COMBAT_VERBOSE_LOGGING
+	#define COMBAT_LOG(Verbosity, Format, ...) UE_LOG(LogCombat, Verbosity, Format, ##__VA_ARGS__)
+#else
+	#define COMBAT_LOG(Verbosity, Format, ...) do {} while (0)
+#endif
+
+#define COMBAT_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+#if COMBAT_TRACE_ENABLED
+	#define COMBAT_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE(Name)
+#else
+	#define COMBAT_TRACE_SCOPE(Name)
+#endif
+
+namespace CombatTrace
+{
+	/** Queue lifecycle step reported by OutputQueueEvent */
+	enum class EQueueEvent : uint8
+	{
+		Queued,
+		Executed,
+		Cancelled
+	};
+
+	// Always compiled: events feed FCombatEventRecorder even when the trace channel is compiled out
+	/** Emit an AttackResolved event (owner/attack are sent as object IDs, not names) */
+	KATANACOMBAT_API void OutputAttackResolved(const UObject* Owner, EInputType InputType, EAttackDirection Direction,
+		bool bIsHolding, bool bComboWindowActive, EResolutionPath Path, const UAttackData* Attack);
+
+	/** Emit an InputEvent event for raw V2 input (direction is recorded for replay, not traced) */
+	KATANACOMBAT_API void OutputInputEvent(const UObject* Owner, EInputType InputType, EInputEventType EventType, EAttackPhase Phase,
+		EInputDirection Direction = EInputDirection::None);
+
+	/** Emit a PhaseTransition event (V2 phase state changed) */
+	KATANACOMBAT_API void OutputPhaseTransition(const UObject* Owner, EAttackPhase OldPhase, EAttackPhase NewPhase);
+
+	/** Emit a WindowEvent event (action window checkpoint opened or expired) */
+	KATANACOMBAT_API void OutputWindowEvent(const UObject* Owner, EActionWindowType WindowType, bool bOpened, float MontageTime);
+
+	/** Emit a QueueEvent event (action queued, executed or cancelled) */
+	KATANACOMBAT_API void OutputQueueEvent(const UObject* Owner, EQueueEvent Event, EInputType InputType, EActionExecutionMode Mode);
+
+	/** Emit a Hit event (weapon trace registered a new hit actor) */
+	KATANACOMBAT_API void OutputHit(const UObject* Owner, const UObject* HitActor, const UAttackData* Attack);
+
+	/**
+	 * Compact combat state of one character, sampled per frame for the Rewind Debugger
+	 * (UCombatStateTraceSubsystem) and only sent when it differs from the previous sample
+	 */
+	struct FCombatStateSample
+	{
+		EAttackPhase Phase = EAttackPhase::None;
+		ECombatState CombatState = ECombatState::Idle;
+
+		/** Posture rounded to whole points (sub-point regen doesn't produce a new sample) */
+		int16 Posture = 0;
+		int16 MaxPosture = 0;
+
+		/** Bit per EActionWindowType with an active checkpoint */
+		uint8 ActiveWindows = 0;
+
+		/** V2 queue in scheduled order, one byte per entry: EInputType in the low nibble, EActionState in the high nibble */
+		TArray<uint8, TInlineAllocator<8>> Queue;
+
+		bool operator==(const FCombatStateSample& Other) const
+		{
+			return Phase == Other.Phase && CombatState == Other.CombatState && Posture == Other.Posture
+				&& MaxPosture == Other.MaxPosture && ActiveWindows == Other.ActiveWindows && Queue == Other.Queue;
+		}
+		bool operator!=(const FCombatStateSample& Other) const { return !(*this == Other); }
+	};
+
+	/** Is the CombatState channel recording? (false whenever tracing is compiled out) */
+	KATANACOMBAT_API bool IsCombatStateTraceEnabled();
+
+	/** Emit a CombatState event on the CombatState channel (trace only - not recorded, the recorder already has the transitions) */
+	KATANACOMBAT_API void OutputCombatState(const UObject* Owner, const FCombatStateSample& Sample);
+}
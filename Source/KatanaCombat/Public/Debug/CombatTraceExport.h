@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Debug/CombatEventRecorder.h"
+
+class FArchive;
+
+/**
+ * Streams recorded combat events to a Chrome Trace Event JSON file (chrome://tracing, ui.perfetto.dev)
+ *
+ * Every owner becomes a process named after it, with one thread per lane:
+ *   Inputs   press -> release spans per input type (async, presses can overlap)
+ *   Queue    queued -> executed / cancelled lifetime per action (async, matched FIFO per input type)
+ *   Phase    one complete span per attack phase
+ *   Windows  one lane per EActionWindowType, opened -> closed
+ *   Events   instants for resolved attacks and hits
+ *
+ * Events are written as they are added (spans when they close), so only open spans are held in
+ * memory. Timestamps are microseconds from BaseCycle. Spans still open at Close end at the last event.
+ *
+ * Console: Combat.ExportTrace [Path] (recorder ring), Combat.Capture.ExportTrace <CapturePath> [JsonPath]
+ */
+class KATANACOMBAT_API FCombatTraceEventWriter
+{
+public:
+	/** Resolves an owner/subject ID to a display name */
+	using FNameResolver = TFunction<FString(uint32 /*Id*/)>;
+
+	FCombatTraceEventWriter() = default;
+	~FCombatTraceEventWriter();
+
+	/**
+	 * Create the file and write the JSON preamble
+	 * @param BaseCycle - Cycle that maps to timestamp 0 (events before it clamp to 0)
+	 * @param InResolveName - Names for owners and hit subjects (#id when unset)
+	 */
+	bool Open(const FString& FilePath, uint64 BaseCycle, FNameResolver InResolveName = FNameResolver());
+
+	/** Convert one event (events must arrive in time order per owner) */
+	void AddEvent(const FCombatRecordedEvent& Event);
+
+	/** Close open spans, finish the JSON array and the file */
+	void Close();
+
+	bool IsOpen() const { return Writer != nullptr; }
+
+	/** Trace events written so far (spans, instants and metadata) */
+	int32 GetNumTraceEvents() const { return NumTraceEvents; }
+
+	/** Convert a batch of events in one go */
+	static bool ExportEvents(const FString& FilePath, TConstArrayView<FCombatRecordedEvent> Events, uint64 BaseCycle, FNameResolver InResolveName = FNameResolver());
+
+private:
+	enum class ELane : uint8
+	{
+		Inputs = 1,
+		Queue,
+		Phase,
+		Events,
+		FirstWindow
+	};
+
+	struct FOpenSpan
+	{
+		uint64 Micros = 0;
+		FString Name;
+	};
+
+	/** Per owner: the lanes it has named and the spans it still has open */
+	struct FOwnerState
+	{
+		int32 ProcessId = 0;
+		uint32 NamedLanes = 0;
+		TMap<uint8, FOpenSpan> HeldInputs;
+		TMap<uint8, TArray<uint64>> QueuedActions;
+		TMap<uint8, FOpenSpan> OpenWindows;
+		TOptional<FOpenSpan> Phase;
+	};
+
+	FOwnerState& GetOwnerState(uint32 OwnerId);
+	void NameLane(FOwnerState& Owner, int32 Lane, const TCHAR* LaneName);
+
+	uint64 ToMicros(uint64 Cycle) const;
+	FString GetName(uint32 Id) const;
+
+	void WriteComplete(const FOwnerState& Owner, int32 Lane, const FString& Name, uint64 StartMicros, uint64 EndMicros, const TCHAR* Category);
+	void WriteAsync(const FOwnerState& Owner, int32 Lane, const FString& Name, uint64 StartMicros, uint64 EndMicros, const TCHAR* Category, uint64 Id);
+	void WriteInstant(const FOwnerState& Owner, int32 Lane, const FString& Name, uint64 Micros, const TCHAR* Category, const FString& Detail);
+	void WriteMetadata(int32 ProcessId, int32 ThreadId, const TCHAR* MetadataName, const FString& Value);
+
+	/** Append one JSON object to the array (flushed to disk in chunks) */
+	void WriteRecord(const FString& Json);
+	void FlushBuffer();
+
+	TUniquePtr<FArchive> Writer;
+	FNameResolver ResolveName;
+	uint64 BaseCycle = 0;
+	uint64 LastMicros = 0;
+
+	TMap<uint32, FOwnerState> Owners;
+	uint64 NextAsyncId = 1;
+
+	/** Pending UTF-8 text not yet handed to the archive */
+	TArray<ANSICHAR> Buffer;
+	int32 NumTraceEvents = 0;
+};
@@ -7,6 +7,8 @@
 #include "ActionQueueTypes.h"
 
 class UCombatComponentV2;
+struct FCombatRecordedEvent;
+class SCombatDopeSheetLayer;
 
 /**
  * Visual event marker for dope sheet
@@ -69,6 +71,14 @@ struct FDopeSheetTrack
  * - Input event markers (Press/Release)
  * - Action queue visualization (Pending/Executing/Completed)
  * - Playhead showing current montage time
+ *
+ * Retained: the background, grid, timeline and tracks are painted by a child layer inside an
+ * SInvalidationPanel and only repainted when the data, view range or size changes. Each track's
+ * events are cached in time space sorted by start, so a repaint binary searches to the visible
+ * range instead of walking every event. Only the playhead is painted every frame.
+ *
+ * Without a component the sheet is fed recorded events instead (AppendRecordedEvents), e.g. from a
+ * device streaming over FCombatTelemetryClient; times are then seconds from the start of the stream.
  */
 class KATANACOMBAT_API SCombatDebugDopeSheet : public SCompoundWidget
 {
@@ -93,14 +103,12 @@ public:
 	/** Constructs this widget with InArgs */
 	void Construct(const FArguments& InArgs, UCombatComponentV2* InCombatComponent);
 
-	/** SWidget overrides */
+	/** SWidget overrides (children paint the cached layers, the playhead is drawn on top) */
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
 		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle,
 		bool bParentEnabled) const override;
 
-	virtual FVector2D ComputeDesiredSize(float) const override;
-
-	/** Update data from combat component */
+	/** Update data from combat component (no-op unless UCombatComponentV2::GetDebugStateVersion changed) */
 	void RefreshData();
 
 	/** Set view range */
@@ -109,13 +117,91 @@ public:
 	/** Set current playback time */
 	void SetCurrentTime(float Time);
 
+	/**
+	 * Append one owner's recorded events, oldest first (sheets constructed without a component)
+	 * Window open/expire pairs become bars, inputs and queue steps become markers.
+	 */
+	void AppendRecordedEvents(TConstArrayView<FCombatRecordedEvent> Events);
+
+	/** Forget every recorded event (e.g. when switching owner) */
+	void ClearRecordedEvents();
+
+	/** Time of the newest recorded event (seconds) */
+	float GetLatestRecordedTime() const { return LatestRecordedTime; }
+
+	/** Recorded events further than this behind the newest are dropped (seconds) */
+	float RecordedHistorySeconds = 30.0f;
+
 private:
+	friend class SCombatDopeSheetLayer;
+
 	/** Combat component being visualized */
 	TWeakObjectPtr<UCombatComponentV2> CombatComponent;
 
-	/** Timeline tracks */
+	/** Timeline tracks (window tracks first in EActionWindowType order, then input, then queue) */
 	TArray<FDopeSheetTrack> Tracks;
 
+	static constexpr int32 NumWindowTracks = 5;
+	static constexpr int32 InputEventTrackIndex = NumWindowTracks;
+	static constexpr int32 ActionQueueTrackIndex = NumWindowTracks + 1;
+	static constexpr int32 NumTracks = NumWindowTracks + 2;
+	static constexpr int32 EventReserve = 8;
+
+	/** What each input/queue event was built from (changed entries are the only ones relabelled) */
+	struct FInputEventKey
+	{
+		EInputType InputType;
+		float PressTime;
+		bool operator==(const FInputEventKey& Other) const { return InputType == Other.InputType && PressTime == Other.PressTime; }
+	};
+
+	struct FQueueEventKey
+	{
+		EInputType InputType;
+		EActionState State;
+		float ScheduledTime;
+		bool operator==(const FQueueEventKey& Other) const { return InputType == Other.InputType && State == Other.State && ScheduledTime == Other.ScheduledTime; }
+	};
+
+	TArray<FInputEventKey> InputEventKeys;
+	TArray<FQueueEventKey> QueueEventKeys;
+
+	/** One track event in time space */
+	struct FTrackSpan
+	{
+		float Start;
+		float End;
+		FLinearColor Color;
+		bool bIsDuration;
+	};
+
+	/** Per-track paint cache, sorted by Start (MaxDuration bounds how far back a visible bar can start) */
+	struct FTrackGeometry
+	{
+		TArray<FTrackSpan> Spans;
+		float MaxDuration = 0.0f;
+		bool bDirty = true;
+	};
+
+	TArray<FTrackGeometry> TrackGeometry;
+
+	/** Static layers, repainted only when invalidated */
+	TSharedPtr<SCombatDopeSheetLayer> StaticLayer;
+
+	/** Component versions the tracks were last patched against */
+	uint32 LastStateVersion = 0;
+	uint32 LastCheckpointLayoutVersion = 0;
+
+	/** Checkpoints already appended to the window tracks */
+	int32 NumCheckpointsApplied = 0;
+
+	/** Recorded mode: start of each window still open (negative = closed) and the newest event time */
+	float OpenWindowStart[NumWindowTracks] = { -1.0f, -1.0f, -1.0f, -1.0f, -1.0f };
+	float LatestRecordedTime = 0.0f;
+
+	void AppendRecordedEvent(const FCombatRecordedEvent& Event);
+	void TrimRecordedEvents();
+
 	/** View range */
 	float ViewRangeMin;
 	float ViewRangeMax;
@@ -151,6 +237,19 @@ private:
 	void AddInputEventTrack();
 	void AddActionQueueTrack();
 
+	/** Incremental patching (called when the component's debug state version moves) */
+	void UpdateWindowTracks();
+	void UpdateInputEventTrack();
+	void UpdateActionQueueTrack();
+	static FDopeSheetEvent MakeActionEvent(const FActionQueueEntry& Action);
+
+	/** Retained paint cache */
+	void MarkTrackDirty(int32 TrackIndex);
+	void RebuildTrackGeometry();
+	void InvalidateStaticLayers(EInvalidateWidgetReason Reason = EInvalidateWidgetReason::Paint);
+	FVector2D GetSheetSize() const;
+	int32 PaintStaticLayers(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId) const;
+
 	/** Drawing helpers */
 	void DrawTimeline(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32& LayerId) const;
 	void DrawTracks(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32& LayerId) const;
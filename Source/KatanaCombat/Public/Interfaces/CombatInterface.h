@@ -8,6 +8,7 @@
 #include "CombatInterface.generated.h"
 
 class UAttackData;
+class AActor;
 
 // This class does not need to be modified.
 UINTERFACE(MinimalAPI, Blueprintable)
@@ -123,4 +124,28 @@ public:
 	 */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Combat")
 	void OnHoldWindowStart(EInputType InputType);
+
+	// ============================================================================
+	// NATIVE QUERIES
+	// ============================================================================
+
+	/**
+	 * Native fast path for the query events (CanPerformAttack, GetCombatState, IsAttacking, GetCurrentAttack,
+	 * GetCurrentPhase, IsInParryWindow). The events stay the Blueprint-facing shim
+	 * @return Current query block, or nullptr if the implementer has none (Blueprint-only implementers)
+	 * The pointer stays owned by the implementer - read it when querying instead of caching the values
+	 */
+	virtual const FCombatQuerySnapshot* GetCombatQuerySnapshot() const { return nullptr; }
+
+	/**
+	 * Query block of a natively implemented combat actor
+	 * @return nullptr if the actor doesn't implement the interface in C++ (or provides no block)
+	 */
+	static const FCombatQuerySnapshot* GetQuerySnapshot(const AActor* Actor);
+
+	/**
+	 * Fill a query block for any combat actor: the native block when there is one, otherwise the query events
+	 * @return False if the actor doesn't implement the interface (OutSnapshot is left untouched)
+	 */
+	static bool QueryCombatState(const AActor* Actor, FCombatQuerySnapshot& OutSnapshot);
 };
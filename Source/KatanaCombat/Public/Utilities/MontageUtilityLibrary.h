@@ -13,6 +13,7 @@
 // Forward declarations
 struct FTimerCheckpoint;
 enum class EActionWindowType : uint8;
+class USkeletalMeshComponent;
 
 /**
  * Procedural easing types for smooth transitions
@@ -135,6 +136,38 @@ struct KATANACOMBAT_API FAttackResolutionResult
 	bool IsValid() const { return Attack != nullptr && !bCycleDetected; }
 };
 
+/**
+ * Immutable section metadata for one montage, built once and shared by everything that works with sections
+ * Indices match UAnimMontage::CompositeSections, so combat code can resolve section names once and
+ * use integer indices afterwards
+ */
+struct KATANACOMBAT_API FMontageSectionTable
+{
+	TArray<FName, TInlineAllocator<4>> Names;
+
+	/** Montage time each section starts at */
+	TArray<float, TInlineAllocator<4>> StartTimes;
+
+	/** Montage time each section ends at: the next section to start after it, or the montage end */
+	TArray<float, TInlineAllocator<4>> EndTimes;
+
+	/** Montage play length */
+	float Length = 0.0f;
+
+	int32 Num() const { return Names.Num(); }
+	bool IsValidIndex(int32 SectionIndex) const { return Names.IsValidIndex(SectionIndex); }
+	float GetDuration(int32 SectionIndex) const { return EndTimes[SectionIndex] - StartTimes[SectionIndex]; }
+
+	/** Section index for a name, or INDEX_NONE */
+	int32 FindSection(FName SectionName) const { return SectionName.IsNone() ? INDEX_NONE : Names.IndexOfByKey(SectionName); }
+
+	/** Section playing at a montage time, or INDEX_NONE outside every section */
+	int32 FindSectionAtTime(float MontageTime) const;
+
+	/** Fill from a montage's composite sections */
+	void Build(const UAnimMontage* Montage);
+};
+
 /**
  * Montage Utility Library
  *
@@ -202,6 +235,8 @@ public:
 	/**
 	 * Set playrate for current montage
 	 * Safe - checks for valid montage before setting
+	 * Writes immediately; combat code requests rates from UPlayRateEasingSubsystem instead, which
+	 * applies the winning request once per frame
 	 *
 	 * @param Character - Character whose montage to modify
 	 * @param PlayRate - New playrate (0.0 = frozen, 1.0 = normal, >1.0 = fast)
@@ -307,6 +342,38 @@ public:
 		UCurveFloat* Curve = nullptr
 	);
 
+	/** Samples per easing lookup table (table holds NumEasingSamples + 1 entries, both endpoints exact) */
+	static constexpr int32 NumEasingSamples = 256;
+
+	/**
+	 * Evaluate easing through the precomputed lookup table (linear interpolation between samples)
+	 * Hot-path alternative to EvaluateEasing - no transcendental math per call
+	 *
+	 * @param Alpha - Input value (clamped to 0.0 - 1.0)
+	 * @param EasingType - Type of easing to apply
+	 * @return Eased alpha value (0.0 - 1.0)
+	 */
+	static float EvaluateEasingLUT(float Alpha, EEasingType EasingType);
+
+	/**
+	 * Evaluate many alphas against one easing curve
+	 * Branch-free inner loop over contiguous floats (vectorizes)
+	 *
+	 * @param Alphas - Input values (clamped to 0.0 - 1.0)
+	 * @param EasingType - Type of easing to apply to every alpha
+	 * @param OutEased - Receives eased values (must be at least Alphas.Num() long)
+	 */
+	static void EvaluateEasingBatch(TConstArrayView<float> Alphas, EEasingType EasingType, TArrayView<float> OutEased);
+
+	/**
+	 * Evaluate many alphas, each with its own easing curve (easing scheduler path)
+	 *
+	 * @param Alphas - Input values (clamped to 0.0 - 1.0)
+	 * @param EasingTypes - Easing type per alpha (same length as Alphas)
+	 * @param OutEased - Receives eased values (must be at least Alphas.Num() long)
+	 */
+	static void EvaluateEasingBatch(TConstArrayView<float> Alphas, TConstArrayView<EEasingType> EasingTypes, TArrayView<float> OutEased);
+
 	// ============================================================================
 	// ADVANCED HOLD MECHANICS (Stateless calculations)
 	// ============================================================================
@@ -333,6 +400,9 @@ public:
 	 * Get playrate for multi-stage hold progression
 	 * Example: 1.0 → 0.5 (Stage 1) → 0.2 (Stage 2) → 0.0 (Fully charged)
 	 *
+	 * Per-frame lookup for Blueprint-driven holds; attacks with authored UAttackData::ChargeStages are
+	 * stepped by UCombatComponent on stage boundaries instead.
+	 *
 	 * @param HoldDuration - How long button has been held
 	 * @param StageThresholds - Array of time thresholds for each stage (must be sorted ascending)
 	 * @param StagePlayRates - Array of playrates for each stage (must match threshold count)
@@ -408,6 +478,36 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat|Montage Utilities|Sections", meta = (DisplayName = "Jump To Section With Blend"))
 	static bool JumpToSectionWithBlend(ACharacter* Character, FName SectionName, float BlendTime = 0.0f);
 
+	/**
+	 * Get (building on first use) the section metadata for a montage
+	 * Tables are built once per montage (game thread only); in editor builds a table is rebuilt after the montage is modified
+	 * Off the game thread, build a local FMontageSectionTable instead
+	 *
+	 * @param Montage - Montage to look up
+	 * @return Cached table (pointer valid until the next lookup), or nullptr if Montage is null
+	 */
+	static const FMontageSectionTable* GetSectionTable(const UAnimMontage* Montage);
+
+	/**
+	 * Resolve section names to indices once, for integer section jumps afterwards
+	 *
+	 * @param Montage - Montage the sections belong to
+	 * @param SectionNames - Names to resolve
+	 * @param OutIndices - One index per name (INDEX_NONE for names the montage doesn't have)
+	 * @return Number of names that resolved
+	 */
+	static int32 ResolveSectionIndices(const UAnimMontage* Montage, TConstArrayView<FName> SectionNames, TArray<int32>& OutIndices);
+
+	/**
+	 * Jump a playing montage to a section by index
+	 *
+	 * @param AnimInstance - Anim instance playing the montage
+	 * @param Montage - Montage to jump in
+	 * @param SectionIndex - Index from GetSectionTable / ResolveSectionIndices
+	 * @return True if the index is valid and the jump was issued
+	 */
+	static bool JumpToSectionIndex(UAnimInstance* AnimInstance, UAnimMontage* Montage, int32 SectionIndex);
+
 	// ============================================================================
 	// WINDOW STATE QUERIES
 	// ============================================================================
@@ -480,6 +580,8 @@ public:
 	 * @param BlendTime - Duration of crossfade
 	 * @param StartPosition - Where to start in target montage (default: 0.0)
 	 * @param PlayRate - Playrate for new montage (default: 1.0)
+	 * @param bInertialize - Cut the current montage and let the AnimBP's Inertialization node hide the pop
+	 *                       over BlendTime (one montage evaluated instead of two; needs the node after the slot)
 	 * @return True if crossfade initiated
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Montage Utilities|Blending", meta = (DisplayName = "Crossfade Montage"))
@@ -488,7 +590,8 @@ public:
 		UAnimMontage* TargetMontage,
 		float BlendTime = 0.2f,
 		float StartPosition = 0.0f,
-		float PlayRate = 1.0f
+		float PlayRate = 1.0f,
+		bool bInertialize = false
 	);
 
 	/**
@@ -502,13 +605,31 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat|Montage Utilities|Blending", meta = (DisplayName = "Blend Out Montage"))
 	static bool BlendOutMontage(ACharacter* Character, float BlendOutTime = 0.2f);
 
+	// ============================================================================
+	// ANIMATION PREWARM
+	// ============================================================================
+
+	/**
+	 * Pay a mesh's first-use animation costs up front (level load, pooled spawns)
+	 * Initializes the anim instance if it hasn't been yet (NativeInitializeAnimation, slot setup), evaluates
+	 * a first pose, then plays and immediately stops every montage so montage instance creation, slot lookups
+	 * and checkpoint tables are done before the first attack. Nothing ticks between play and stop, so no
+	 * notifies fire.
+	 *
+	 * @param Mesh - Mesh to warm up
+	 * @param Montages - Montages to pre-touch (null and duplicate entries are skipped)
+	 * @return Number of montages touched
+	 */
+	static int32 PrewarmAnimation(USkeletalMeshComponent* Mesh, TConstArrayView<UAnimMontage*> Montages);
+
 	// ============================================================================
 	// DEBUG & VISUALIZATION
 	// ============================================================================
 
 	/**
 	 * Draw debug timeline for montage checkpoints
-	 * Shows all windows on screen as visual timeline
+	 * Shows all windows on screen as visual timeline (queued on UCombatDebugDrawSubsystem, so the
+	 * character's debug selection, distance filter and primitive budget apply)
 	 *
 	 * @param World - World context for drawing
 	 * @param Character - Character to visualize
@@ -631,6 +752,23 @@ public:
 		UPARAM(ref) TSet<class UAttackData*>& VisitedAttacks
 	);
 
+	/**
+	 * PRIORITY 1 of ResolveNextAttack_V2: context-sensitive attack (parry counter, finisher, ...)
+	 * Checks CurrentAttack's ContextVariants, then the input's default attack's ContextVariants
+	 *
+	 * @param ActiveContextMask - Compiled active context (cache it; see FCombatContextTagTable::MakeActiveMask)
+	 * @param ActiveContext - Same context as tags (only read for tags without a bit)
+	 * @return Resolution result; Attack is nullptr if no variant matches
+	 */
+	static FAttackResolutionResult ResolveContextAttack(
+		const class UAttackData* CurrentAttack,
+		EInputType InputType,
+		const class UAttackData* DefaultLightAttack,
+		const class UAttackData* DefaultHeavyAttack,
+		const struct FCombatContextMask& ActiveContextMask,
+		const FGameplayTagContainer& ActiveContext
+	);
+
 	/**
 	 * Get combo attack from current attack data
 	 * Traverses AttackData combo pointers based on input type
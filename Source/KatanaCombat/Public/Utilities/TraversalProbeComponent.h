@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/HitResult.h"
+#include "TraversalProbeComponent.generated.h"
+
+/**
+ * Shared wall/ledge probe for platforming characters
+ *
+ * Wall jump and ledge checks are input-driven, and rapid input (mashing jump against a wall,
+ * jump + drop in quick succession) re-runs the same sweep from almost the same spot. The probe
+ * keeps the last wall and ledge results and answers repeated queries from them while the owner
+ * stays within CacheTolerance of where the query ran and the result is younger than CacheDuration.
+ *
+ * Coyote time needs no trace and stays on the characters (LastFallTime).
+ */
+UCLASS(ClassGroup = (Traversal), meta = (BlueprintSpawnableComponent))
+class KATANACOMBAT_API UTraversalProbeComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTraversalProbeComponent();
+
+	// ============================================================================
+	// CONFIGURATION
+	// ============================================================================
+
+	/** How long a probe result stays valid (seconds) */
+	UPROPERTY(EditAnywhere, Category = "Traversal Probe", meta = (ClampMin = "0.0", Units = "s"))
+	float CacheDuration = 0.1f;
+
+	/** How far the owner can move before a cached result is discarded (cm) */
+	UPROPERTY(EditAnywhere, Category = "Traversal Probe", meta = (ClampMin = "0.0", Units = "cm"))
+	float CacheTolerance = 10.0f;
+
+	/** Collision channel walls and ledges are probed against */
+	UPROPERTY(EditAnywhere, Category = "Traversal Probe")
+	TEnumAsByte<ECollisionChannel> ProbeChannel = ECC_Visibility;
+
+	// ============================================================================
+	// QUERIES
+	// ============================================================================
+
+	/**
+	 * Look for a wall in front of the owner
+	 * @param Direction - Probe direction (normalized)
+	 * @param Distance - Probe length (cm)
+	 * @param Radius - Sphere radius (cm, 0 = line trace)
+	 * @param OutHit - Wall hit (valid when returning true)
+	 * @return True if a wall was found
+	 */
+	bool FindWall(const FVector& Direction, float Distance, float Radius, FHitResult& OutHit);
+
+	/**
+	 * Look for a ledge top above the last wall hit (reuses FindWall's cached hit)
+	 * @param Direction, Distance, Radius - Wall probe, as for FindWall
+	 * @param MaxLedgeHeight - Highest ledge above the owner's location (cm)
+	 * @param OutLedgeHit - Ledge top hit (valid when returning true)
+	 * @return True if the wall in front of the owner has a walkable top within MaxLedgeHeight
+	 */
+	bool FindLedge(const FVector& Direction, float Distance, float Radius, float MaxLedgeHeight, FHitResult& OutLedgeHit);
+
+	/** Drop cached results (call after teleports or launches) */
+	UFUNCTION(BlueprintCallable, Category = "Traversal Probe")
+	void InvalidateCache();
+
+	/** Number of sweeps actually issued (cache misses) */
+	int32 GetNumProbes() const { return NumProbes; }
+
+private:
+	/** One cached query and its result */
+	struct FProbeCache
+	{
+		FVector Origin = FVector::ZeroVector;
+		FVector Direction = FVector::ZeroVector;
+		float Distance = 0.0f;
+		float Radius = 0.0f;
+		double Time = -1.0;
+		bool bHit = false;
+		FHitResult Hit;
+	};
+
+	/** True if Cache answers a query with these parameters from Origin */
+	bool IsCacheValid(const FProbeCache& Cache, const FVector& Origin, const FVector& Direction, float Distance, float Radius) const;
+
+	FProbeCache WallCache;
+	FProbeCache LedgeCache;
+
+	int32 NumProbes = 0;
+};
\ No newline at end of file
@@ -0,0 +1,210 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatAttackTokenSubsystem.h"
+#include "CombatPlayerInfoSubsystem.h"
+#include "Core/CombatComponentV2.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+
+void UCombatAttackTokenSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UCombatJobSchedulerSubsystem* Scheduler = Collection.InitializeDependency<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->RegisterJob<&UCombatAttackTokenSubsystem::PruneStaleTokens>(PruneJob, this, PruneInterval, ECombatJobPriority::Low, TEXT("AttackTokens.Prune"));
+	}
+}
+
+void UCombatAttackTokenSubsystem::Deinitialize()
+{
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->UnregisterJob(PruneJob);
+		Scheduler->UnregisterJob(InputJob);
+	}
+
+	PendingInputs.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UCombatAttackTokenSubsystem::CanAcquireToken(const AActor* Attacker, const AActor* Target) const
+{
+	if (!Attacker || !Target)
+	{
+		return false;
+	}
+
+	// already holding a token on this target?
+	if (const FObjectKey* HeldTarget = AttackerTargets.Find(Attacker))
+	{
+		if (*HeldTarget == FObjectKey(Target))
+		{
+			return true;
+		}
+	}
+
+	return HasFreeToken(Targets.Find(Target));
+}
+
+bool UCombatAttackTokenSubsystem::TryAcquireToken(AActor* Attacker, AActor* Target)
+{
+	if (!CanAcquireToken(Attacker, Target))
+	{
+		return false;
+	}
+
+	// nothing to do if we already hold it
+	if (const FObjectKey* HeldTarget = AttackerTargets.Find(Attacker))
+	{
+		if (*HeldTarget == FObjectKey(Target))
+		{
+			return true;
+		}
+	}
+
+	// only one token per attacker
+	ReleaseToken(Attacker);
+
+	FTargetTokens& Tokens = Targets.FindOrAdd(Target);
+	Tokens.Holders.Add(Attacker);
+	Tokens.LastGrantTime = GetWorld()->GetTimeSeconds();
+	AttackerTargets.Add(Attacker, Target);
+
+	return true;
+}
+
+void UCombatAttackTokenSubsystem::ReleaseToken(const AActor* Attacker)
+{
+	FObjectKey HeldTarget;
+	if (!AttackerTargets.RemoveAndCopyValue(Attacker, HeldTarget))
+	{
+		return;
+	}
+
+	if (FTargetTokens* Tokens = Targets.Find(HeldTarget))
+	{
+		Tokens->Holders.RemoveAllSwap([Attacker](const TWeakObjectPtr<AActor>& Holder) { return !Holder.IsValid() || Holder.Get() == Attacker; });
+	}
+}
+
+AActor* UCombatAttackTokenSubsystem::ResolveTarget(AActor* Target) const
+{
+	if (Target)
+	{
+		return Target;
+	}
+
+	// fall back to the first local player
+	if (UCombatPlayerInfoSubsystem* PlayerInfoSubsystem = GetWorld()->GetSubsystem<UCombatPlayerInfoSubsystem>())
+	{
+		if (const FCombatPlayerInfo* PlayerInfo = PlayerInfoSubsystem->GetPlayerInfo(0))
+		{
+			return PlayerInfo->Pawn.Get();
+		}
+	}
+
+	return nullptr;
+}
+
+void UCombatAttackTokenSubsystem::SubmitInput(UCombatComponentV2* Component, EInputType InputType, EInputEventType EventType, EInputDirection Direction)
+{
+	if (!Component)
+	{
+		return;
+	}
+
+	FCombatInputCommand& Command = PendingInputs.AddDefaulted_GetRef();
+	Command.Component = Component;
+	Command.InputType = InputType;
+	Command.EventType = EventType;
+	Command.Direction = Direction;
+	Command.PlatformTime = FPlatformTime::Seconds();
+
+	// first input of the batch: flush on the next scheduler update
+	UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>();
+	if (Scheduler && !Scheduler->IsJobRegistered(InputJob))
+	{
+		Scheduler->RegisterJob<&UCombatAttackTokenSubsystem::FlushInputsJob>(InputJob, this, 0.0f, ECombatJobPriority::High, TEXT("AttackTokens.FlushInputs"));
+	}
+}
+
+int32 UCombatAttackTokenSubsystem::FlushInputs()
+{
+	if (PendingInputs.Num() == 0)
+	{
+		return 0;
+	}
+
+	// inputs that cause more inputs (delegates, StateTree) land in the next batch
+	Swap(PendingInputs, SendingInputs);
+	const int32 NumDispatched = UCombatComponentV2::SubmitInputBatch(SendingInputs);
+	SendingInputs.Reset();
+
+	return NumDispatched;
+}
+
+void UCombatAttackTokenSubsystem::FlushInputsJob(float DeltaTime)
+{
+	FlushInputs();
+
+	// nothing left to send: stop running until the next submission
+	if (PendingInputs.Num() == 0)
+	{
+		if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+		{
+			Scheduler->UnregisterJob(InputJob);
+		}
+	}
+}
+
+bool UCombatAttackTokenSubsystem::HasFreeToken(const FTargetTokens* Tokens) const
+{
+	// nobody has attacked this target yet
+	if (!Tokens)
+	{
+		return true;
+	}
+
+	// count live holders only, in case an attacker was destroyed without releasing
+	int32 NumHolders = 0;
+	for (const TWeakObjectPtr<AActor>& Holder : Tokens->Holders)
+	{
+		NumHolders += Holder.IsValid() ? 1 : 0;
+	}
+
+	if (NumHolders >= MaxAttackersPerTarget)
+	{
+		return false;
+	}
+
+	// stagger attack starts
+	return GetWorld()->GetTimeSeconds() - Tokens->LastGrantTime >= MinAttackStartSpacing;
+}
+
+void UCombatAttackTokenSubsystem::PruneStaleTokens(float DeltaTime)
+{
+	// attackers destroyed without releasing their token
+	for (auto It = AttackerTargets.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = Targets.CreateIterator(); It; ++It)
+	{
+		FTargetTokens& Tokens = It.Value();
+		Tokens.Holders.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Holder) { return !Holder.IsValid(); });
+
+		// keep the entry while its start spacing still matters
+		const bool bSpacingExpired = GetWorld()->GetTimeSeconds() - Tokens.LastGrantTime >= MinAttackStartSpacing;
+		if (!It.Key().ResolveObjectPtr() || (Tokens.Holders.Num() == 0 && bSpacingExpired))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "ActionQueueTypes.h"
+#include "CombatAttackTokenSubsystem.generated.h"
+
+/**
+ *  Attack token manager for AI
+ *  Each target hands out a limited number of attack tokens, and consecutive tokens on the same
+ *  target are spaced out in time. Attackers hold a token for the duration of their attack, so
+ *  only a few enemies commit at once and their attack starts are staggered
+ *  Tokens left behind by attackers or targets that were destroyed are pruned by a scheduled job
+ *  AI characters on the V2 action queue submit their inputs here too, and everything submitted in a frame
+ *  reaches the queues in one UCombatComponentV2::SubmitInputBatch
+ */
+UCLASS()
+class UCombatAttackTokenSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns true if the attacker already holds, or could acquire right now, a token on the target */
+	bool CanAcquireToken(const AActor* Attacker, const AActor* Target) const;
+
+	/** Grants the attacker a token on the target if one is available. Returns true if the attacker holds a token */
+	bool TryAcquireToken(AActor* Attacker, AActor* Target);
+
+	/** Releases any token held by the attacker */
+	void ReleaseToken(const AActor* Attacker);
+
+	/** Returns the target to use for the attacker: the given one, or the first local player's pawn if none */
+	AActor* ResolveTarget(AActor* Target) const;
+
+	/** Queues an input for an AI character's V2 component. Sent with the rest of the frame's inputs on the next scheduler update */
+	void SubmitInput(UCombatComponentV2* Component, EInputType InputType, EInputEventType EventType, EInputDirection Direction = EInputDirection::None);
+
+	/** Sends the queued inputs now (normally done by the scheduled job). Returns the number dispatched */
+	int32 FlushInputs();
+
+	/** Returns the number of inputs waiting for the next flush */
+	int32 GetNumPendingInputs() const { return PendingInputs.Num(); }
+
+	/** Max number of attackers allowed on the same target at once */
+	int32 MaxAttackersPerTarget = 2;
+
+	/** Min time between two attackers starting on the same target */
+	float MinAttackStartSpacing = 0.4f;
+
+	/** Time between stale token pruning passes */
+	float PruneInterval = 1.0f;
+
+	// ~begin UWorldSubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// ~end UWorldSubsystem interface
+
+protected:
+
+	/** Scheduled job: drops holders that are gone and targets nobody holds a token on any more */
+	void PruneStaleTokens(float DeltaTime);
+
+	/** Scheduled job: sends the queued inputs, then unregisters itself until more arrive */
+	void FlushInputsJob(float DeltaTime);
+
+	/** Pruning job on the combat job scheduler */
+	FCombatJobHandle PruneJob;
+
+	/** Input flush job, only registered while inputs are waiting */
+	FCombatJobHandle InputJob;
+
+	/** Inputs submitted since the last flush, in submission order */
+	TArray<FCombatInputCommand> PendingInputs;
+
+	/** Batch being sent (swapped with PendingInputs so inputs submitted while sending wait for the next flush) */
+	TArray<FCombatInputCommand> SendingInputs;
+
+	/** Token state for a single target */
+	struct FTargetTokens
+	{
+		/** Attackers currently holding a token */
+		TArray<TWeakObjectPtr<AActor>, TInlineAllocator<4>> Holders;
+
+		/** World time the last token was granted */
+		double LastGrantTime = -UE_BIG_NUMBER;
+	};
+
+	/** Token state, by target */
+	TMap<FObjectKey, FTargetTokens> Targets;
+
+	/** Target each attacker holds a token on */
+	TMap<FObjectKey, FObjectKey> AttackerTargets;
+
+	/** Checks availability for an attacker that doesn't hold a token yet */
+	bool HasFreeToken(const FTargetTokens* Tokens) const;
+};
@@ -8,11 +8,26 @@
 #include "Components/WidgetComponent.h"
 #include "Engine/DamageEvents.h"
 #include "CombatLifeBar.h"
+#include "CombatLifeBarSubsystem.h"
+#include "Core/CombatUIEventSubsystem.h"
 #include "TimerManager.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Animation/AnimInstance.h"
-
-ACombatEnemy::ACombatEnemy()
+#include "BrainComponent.h"
+#include "CombatEnemyLODSubsystem.h"
+#include "CombatAttackTokenSubsystem.h"
+#include "CombatRagdollSubsystem.h"
+#include "Core/WeaponTraceSubsystem.h"
+#include "Core/WeaponComponent.h"
+#include "Core/CombatAnimBudgetSubsystem.h"
+#include "IAnimationBudgetAllocator.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "Debug/CombatTrace.h"
+#include "Utilities/MontageUtilityLibrary.h"
+
+ACombatEnemy::ACombatEnemy(const FObjectInitializer& ObjectInitializer)
+	// use a budgeted mesh so the animation budget allocator can throttle idle and distant enemies
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
 	PrimaryActorTick.bCanEverTick = true;
 
@@ -32,6 +47,10 @@ ACombatEnemy::ACombatEnemy()
 	LifeBar = CreateDefaultSubobject<UWidgetComponent>(TEXT("LifeBar"));
 	LifeBar->SetupAttachment(RootComponent);
 
+	// create the weapon component. It only ticks while hit detection is enabled
+	WeaponComponent = CreateDefaultSubobject<UWeaponComponent>(TEXT("WeaponComponent"));
+	WeaponComponent->bUseBatchedTraces = true;
+
 	// set the collision capsule size
 	GetCapsuleComponent()->SetCapsuleSize(35.0f, 90.0f);
 
@@ -40,6 +59,29 @@ ACombatEnemy::ACombatEnemy()
 
 	// reset HP to maximum
 	CurrentHP = MaxHP;
+
+	// let the engine skip anim updates based on screen size
+	GetMesh()->bEnableUpdateRateOptimizations = true;
+
+	// default AI LOD tiers: full rate up close, throttled mid-range, nearly free in the background
+	FCombatEnemyLODTier& NearTier = LODTiers.AddDefaulted_GetRef();
+	NearTier.MaxDistance = 1500.0f;
+
+	FCombatEnemyLODTier& MidTier = LODTiers.AddDefaulted_GetRef();
+	MidTier.MaxDistance = 4000.0f;
+	MidTier.AITickInterval = 0.1f;
+	MidTier.MovementTickInterval = 0.033f;
+	MidTier.AnimTickInterval = 0.033f;
+	MidTier.AnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	MidTier.bSimpleAttackTrace = true;
+
+	FCombatEnemyLODTier& FarTier = LODTiers.AddDefaulted_GetRef();
+	FarTier.MaxDistance = 8000.0f;
+	FarTier.AITickInterval = 0.5f;
+	FarTier.MovementTickInterval = 0.1f;
+	FarTier.AnimTickInterval = 0.1f;
+	FarTier.AnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	FarTier.bSimpleAttackTrace = true;
 }
 
 void ACombatEnemy::DoAIComboAttack()
@@ -59,6 +101,9 @@ void ACombatEnemy::DoAIComboAttack()
 	// reset the attack counter
 	CurrentComboAttack = 0;
 
+	// never let the animation budget throttle a swing
+	SetAnimBudgetCritical(true);
+
 	// play the attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
@@ -90,6 +135,9 @@ void ACombatEnemy::DoAIChargedAttack()
 	// reset the charge loop counter
 	CurrentChargeLoop = 0;
 
+	// never let the animation budget throttle a swing
+	SetAnimBudgetCritical(true);
+
 	// play the attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
@@ -109,69 +157,122 @@ void ACombatEnemy::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 	// reset the attacking flag
 	bIsAttacking = false;
 
+	// the animation budget may throttle us again
+	SetAnimBudgetCritical(false);
+
 	// call the attack completed delegate so the StateTree can continue execution
 	OnAttackCompleted.ExecuteIfBound();
 }
 
 void ACombatEnemy::DoAttackTrace(FName DamageSourceBone)
 {
-	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
+	COMBAT_CSV_SCOPE_IN(Traces, EnemyAttackTrace);
+	COMBAT_BUDGET_SCOPE(Traces);
+
+	// sweep the weapon sockets for a short window, same pipeline as the Samurai characters
+	if (bUseWeaponComponent && WeaponComponent)
+	{
+		WeaponComponent->ResetHitActors();
+		WeaponComponent->EnableHitDetection();
+
+		GetWorld()->GetTimerManager().SetTimer(WeaponTraceTimer, this, &ACombatEnemy::EndWeaponTrace, WeaponTraceWindow);
+		return;
+	}
+
+	FMeleeTraceRequest Request;
 
 	// start at the provided socket location, sweep forward
-	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
-	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
+	Request.Start = GetMesh()->GetSocketLocation(DamageSourceBone);
+	Request.End = Request.Start + (GetActorForwardVector() * MeleeTraceDistance);
+	Request.Radius = MeleeTraceRadius;
 
 	// enemies only affect Pawn collision objects; they don't knock back boxes
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
-
-	// use a sphere shape for the sweep
-	FCollisionShape CollisionShape;
-	CollisionShape.SetSphere(MeleeTraceRadius);
+	Request.ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
 
 	// ignore self
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
+	Request.QueryParams.AddIgnoredActor(this);
 
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	// lower LOD tiers only need the first hit
+	if (LODTiers.IsValidIndex(CurrentLODTier) && LODTiers[CurrentLODTier].bSimpleAttackTrace)
 	{
-		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
-		{
-			/** does the actor have the player tag? */
-			if (CurrentHit.GetActor()->ActorHasTag(FName("Player")))
-			{
-				// check if the actor is damageable
-				ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
-
-				if (Damageable)
-				{
-					// knock upwards and away from the impact normal
-					const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
-
-					// pass the damage event to the actor
-					Damageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
-
-				}
-			}
-		}
+		Request.TraceType = EAsyncTraceType::Single;
+	}
+
+	// sweep through the shared batched trace pipeline. Hits are applied next frame
+	if (UWeaponTraceSubsystem* TraceSubsystem = GetWorld()->GetSubsystem<UWeaponTraceSubsystem>())
+	{
+		TraceSubsystem->QueueMeleeTrace(Request, FOnMeleeTraceHits::CreateUObject(this, &ACombatEnemy::ProcessAttackHits));
+	}
+}
+
+void ACombatEnemy::ProcessAttackHits(const TArray<FHitResult>& Hits)
+{
+	// ignore traces that land after we died
+	if (CurrentHP <= 0.0f)
+	{
+		return;
+	}
+
+	// iterate over each object hit
+	for (const FHitResult& CurrentHit : Hits)
+	{
+		ApplyMeleeHit(CurrentHit);
 	}
 }
 
+void ACombatEnemy::ApplyMeleeHit(const FHitResult& Hit)
+{
+	AActor* HitActor = Hit.GetActor();
+	if (!HitActor)
+	{
+		return;
+	}
+
+	// only resolve actors we haven't seen on the last hit; it's almost always the player again
+	if (HitActor != CachedHitActor.Get())
+	{
+		CachedHitActor = HitActor;
+
+		// does the actor have the player tag, and is it damageable?
+		CachedHitDamageable = HitActor->ActorHasTag(FName("Player")) ? Cast<ICombatDamageable>(HitActor) : nullptr;
+	}
+
+	if (CachedHitDamageable)
+	{
+		// knock upwards and away from the impact normal
+		const FVector Impulse = (Hit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+
+		// pass the damage event to the actor
+		CachedHitDamageable->ApplyDamage(MeleeDamage, this, Hit.ImpactPoint, Impulse);
+	}
+}
+
+void ACombatEnemy::OnWeaponHit(AActor* HitActor, const FHitResult& HitResult, UAttackData* AttackData)
+{
+	// ignore hits that land after we died
+	if (CurrentHP <= 0.0f)
+	{
+		return;
+	}
+
+	ApplyMeleeHit(HitResult);
+}
+
+void ACombatEnemy::EndWeaponTrace()
+{
+	WeaponComponent->DisableHitDetection();
+}
+
 void ACombatEnemy::CheckCombo()
 {
 	// increase the combo counter
 	++CurrentComboAttack;
 
 	// do we still have attacks to play in this string?
-	if (CurrentComboAttack < TargetComboCount)
+	if (CurrentComboAttack < TargetComboCount && ComboSectionIndices.IsValidIndex(CurrentComboAttack))
 	{
 		// jump to the next attack section
-		if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
-		{
-			AnimInstance->Montage_JumpToSection(ComboSectionNames[CurrentComboAttack], ComboAttackMontage);
-		}
+		UMontageUtilityLibrary::JumpToSectionIndex(GetMesh()->GetAnimInstance(), ComboAttackMontage, ComboSectionIndices[CurrentComboAttack]);
 	}
 }
 
@@ -181,10 +282,7 @@ void ACombatEnemy::CheckChargedAttack()
 	++CurrentChargeLoop;
 
 	// jump to either the loop or attack section of the montage depending on whether we hit the loop target
-	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
-	{
-		AnimInstance->Montage_JumpToSection(CurrentChargeLoop >= TargetChargeLoops ? ChargeAttackSection : ChargeLoopSection, ChargedAttackMontage);
-	}
+	UMontageUtilityLibrary::JumpToSectionIndex(GetMesh()->GetAnimInstance(), ChargedAttackMontage, CurrentChargeLoop >= TargetChargeLoops ? ChargeAttackSectionIndex : ChargeLoopSectionIndex);
 }
 
 void ACombatEnemy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
@@ -222,7 +320,7 @@ void ACombatEnemy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector
 void ACombatEnemy::HandleDeath()
 {
 	// hide the life bar
-	LifeBar->SetHiddenInGame(true);
+	SetLifeBarVisible(false);
 
 	// disable the collision capsule to avoid being hit again while dead
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -230,8 +328,28 @@ void ACombatEnemy::HandleDeath()
 	// disable character movement
 	GetCharacterMovement()->DisableMovement();
 
-	// enable full ragdoll physics
-	GetMesh()->SetSimulatePhysics(true);
+	// ragdoll within the world's budget, or right away if there is none
+	if (UCombatRagdollSubsystem* RagdollSubsystem = GetWorld()->GetSubsystem<UCombatRagdollSubsystem>())
+	{
+		RagdollSubsystem->RequestRagdoll(this);
+	}
+	else
+	{
+		StartRagdollPhysics();
+	}
+
+	// stop any weapon sweep in progress
+	GetWorld()->GetTimerManager().ClearTimer(WeaponTraceTimer);
+	WeaponComponent->DisableHitDetection();
+
+	// a swing cut short by death no longer needs full-rate animation
+	SetAnimBudgetCritical(false);
+
+	// dead enemies don't hold up the attack queue
+	if (UCombatAttackTokenSubsystem* TokenSubsystem = GetWorld()->GetSubsystem<UCombatAttackTokenSubsystem>())
+	{
+		TokenSubsystem->ReleaseToken(this);
+	}
 
 	// call the died delegate to notify any subscribers
 	OnEnemyDied.Broadcast();
@@ -247,10 +365,198 @@ void ACombatEnemy::ApplyHealing(float Healing, AActor* Healer)
 
 void ACombatEnemy::RemoveFromLevel()
 {
+	// pooled enemies go back to their pool instead of being destroyed
+	if (OnReturnToPool.IsBound())
+	{
+		OnReturnToPool.Execute(this);
+		return;
+	}
+
 	// destroy this actor
 	Destroy();
 }
 
+void ACombatEnemy::DeactivateForPool()
+{
+	// stop any pending removal
+	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+
+	// give up our ragdoll slot or place in the ragdoll queue
+	if (UCombatRagdollSubsystem* RagdollSubsystem = GetWorld()->GetSubsystem<UCombatRagdollSubsystem>())
+	{
+		RagdollSubsystem->ReleaseRagdoll(this);
+	}
+
+	// stop thinking
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->StopLogic(TEXT("Pooled"));
+		}
+	}
+
+	// stop any attack animations
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->StopAllMontages(0.0f);
+	}
+
+	// turn off physics, unfreeze the pose and put the mesh back under the capsule
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->bNoSkeletonUpdate = false;
+	GetMesh()->SetComponentTickEnabled(true);
+	GetMesh()->SetPhysicsBlendWeight(0.0f);
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	GetMesh()->SetRelativeTransform(MeshRelativeTransform);
+
+	// hide and disable everything
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GetCharacterMovement()->DisableMovement();
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	SetLifeBarVisible(false);
+
+	// the next spawn gets a fresh set of death subscribers
+	OnEnemyDied.Clear();
+}
+
+void ACombatEnemy::PrewarmAnimation()
+{
+	// play and stop each attack montage once while nobody is watching
+	UAnimMontage* Montages[] = { ComboAttackMontage, ChargedAttackMontage };
+	UMontageUtilityLibrary::PrewarmAnimation(GetMesh(), Montages);
+}
+
+void ACombatEnemy::StartRagdollPhysics()
+{
+	// enable full ragdoll physics
+	GetMesh()->SetSimulatePhysics(true);
+}
+
+void ACombatEnemy::FreezeRagdollPose()
+{
+	// stop simulating, then stop updating bones so the mesh keeps its settled pose
+	GetMesh()->PutAllRigidBodiesToSleep();
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->bNoSkeletonUpdate = true;
+	GetMesh()->SetComponentTickEnabled(false);
+}
+
+bool ACombatEnemy::PlayDeathMontage()
+{
+	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+	if (!DeathMontage || !AnimInstance)
+	{
+		return false;
+	}
+
+	// stop the attacks and play the death animation (authored without auto blend out, so it holds its last frame)
+	AnimInstance->StopAllMontages(0.1f);
+	return AnimInstance->Montage_Play(DeathMontage) > 0.0f;
+}
+
+void ACombatEnemy::SetCurrentHP(float NewHP)
+{
+	CurrentHP = FMath::Clamp(NewHP, 0.0f, MaxHP);
+
+	// update the life bar
+	SetLifeBarPercentage(MaxHP > 0.0f ? CurrentHP / MaxHP : 0.0f);
+}
+
+void ACombatEnemy::ActivateFromPool(const FTransform& SpawnTransform)
+{
+	// move to the spawn point
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	// reset HP and attack state
+	CurrentHP = MaxHP;
+	bIsAttacking = false;
+	CurrentComboAttack = 0;
+	CurrentChargeLoop = 0;
+
+	// restore the life bar
+	SetLifeBarVisible(true);
+	SetLifeBarPercentage(1.0f);
+
+	// show and re-enable everything
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	// start the StateTree again from its initial state, after HP has been topped up
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->RestartLogic();
+		}
+	}
+}
+
+void ACombatEnemy::UpdateLOD(float DistanceToPlayer)
+{
+	if (LODTiers.Num() == 0)
+	{
+		return;
+	}
+
+	// pick the first tier that covers this distance, or the last one
+	int32 TierIndex = LODTiers.Num() - 1;
+	for (int32 Index = 0; Index < LODTiers.Num(); ++Index)
+	{
+		if (DistanceToPlayer <= LODTiers[Index].MaxDistance)
+		{
+			TierIndex = Index;
+			break;
+		}
+	}
+
+	if (TierIndex != CurrentLODTier)
+	{
+		ApplyLODTier(TierIndex);
+	}
+}
+
+void ACombatEnemy::ApplyLODTier(int32 TierIndex)
+{
+	CurrentLODTier = TierIndex;
+	const FCombatEnemyLODTier& Tier = LODTiers[TierIndex];
+
+	// actor and StateTree
+	SetActorTickInterval(Tier.AITickInterval);
+
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->SetComponentTickInterval(Tier.AITickInterval);
+		}
+	}
+
+	// movement
+	GetCharacterMovement()->SetComponentTickInterval(Tier.MovementTickInterval);
+
+	// animation. The animation budget allocator owns the mesh tick while it's running
+	const IAnimationBudgetAllocator* AnimBudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (!Cast<USkeletalMeshComponentBudgeted>(GetMesh()) || !AnimBudgetAllocator || !AnimBudgetAllocator->GetEnabled())
+	{
+		GetMesh()->SetComponentTickInterval(Tier.AnimTickInterval);
+		GetMesh()->VisibilityBasedAnimTickOption = Tier.AnimTickOption;
+	}
+}
+
+void ACombatEnemy::SetAnimBudgetCritical(bool bCritical)
+{
+	if (UCombatAnimBudgetSubsystem* AnimBudget = GetWorld()->GetSubsystem<UCombatAnimBudgetSubsystem>())
+	{
+		AnimBudget->SetCombatCritical(this, bCritical);
+	}
+}
+
 float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
 	// only process damage if the character is still alive
@@ -271,7 +577,7 @@ float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEv
 	else
 	{
 		// update the life bar
-		LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
+		SetLifeBarPercentage(CurrentHP / MaxHP);
 
 		// enable partial ragdoll physics, but keep the pelvis vertical
 		GetMesh()->SetPhysicsBlendWeight(0.5f);
@@ -305,18 +611,123 @@ void ACombatEnemy::BeginPlay()
 	// we top the HP before BeginPlay so StateTree picks it up at the right value
 	Super::BeginPlay();
 
-	// get the life bar widget from the widget comp
-	LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
-	check(LifeBarWidget);
+	if (bUseBatchedLifeBar)
+	{
+		// draw the life bar through the shared layer and keep the widget component as the anchor only
+		LifeBar->SetHiddenInGame(true);
+		LifeBar->SetComponentTickEnabled(false);
+
+		if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+		{
+			LifeBarId = LifeBars->RegisterBar(LifeBar, LifeBarColor);
+		}
+	}
+	else
+	{
+		// get the life bar widget from the widget comp
+		LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
+		check(LifeBarWidget);
+	}
 
 	// fill the life bar
-	LifeBarWidget->SetLifePercentage(1.0f);
+	SetLifeBarPercentage(1.0f);
+
+	// remember the mesh placement so pooled enemies can recover from ragdoll
+	MeshRelativeTransform = GetMesh()->GetRelativeTransform();
+
+	// resolve the combo and charge sections once so attacks jump by section index
+	UMontageUtilityLibrary::ResolveSectionIndices(ComboAttackMontage, ComboSectionNames, ComboSectionIndices);
+	if (const FMontageSectionTable* ChargeSections = UMontageUtilityLibrary::GetSectionTable(ChargedAttackMontage))
+	{
+		ChargeLoopSectionIndex = ChargeSections->FindSection(ChargeLoopSection);
+		ChargeAttackSectionIndex = ChargeSections->FindSection(ChargeAttackSection);
+	}
+
+	// listen for weapon component hits
+	WeaponComponent->OnWeaponHitNative.AddUObject(this, &ACombatEnemy::OnWeaponHit);
+
+	// join AI LOD management
+	if (UCombatEnemyLODSubsystem* LODSubsystem = GetWorld()->GetSubsystem<UCombatEnemyLODSubsystem>())
+	{
+		LODSubsystem->RegisterEnemy(this);
+	}
+
+	// let combat state decide when the animation budget may throttle us
+	if (UCombatAnimBudgetSubsystem* AnimBudget = GetWorld()->GetSubsystem<UCombatAnimBudgetSubsystem>())
+	{
+		AnimBudget->RegisterMesh(GetMesh());
+	}
 }
 
 void ACombatEnemy::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the death timer
+	// clear the death and weapon trace timers
 	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+	GetWorld()->GetTimerManager().ClearTimer(WeaponTraceTimer);
+
+	// leave AI LOD management
+	if (UCombatEnemyLODSubsystem* LODSubsystem = GetWorld()->GetSubsystem<UCombatEnemyLODSubsystem>())
+	{
+		LODSubsystem->UnregisterEnemy(this);
+	}
+
+	// leave animation budget management
+	if (UCombatAnimBudgetSubsystem* AnimBudget = GetWorld()->GetSubsystem<UCombatAnimBudgetSubsystem>())
+	{
+		AnimBudget->UnregisterMesh(GetMesh());
+	}
+
+	// release the batched life bar
+	if (LifeBarId != INDEX_NONE)
+	{
+		if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+		{
+			LifeBars->UnregisterBar(LifeBarId);
+		}
+		LifeBarId = INDEX_NONE;
+	}
+
+	// give back any attack token
+	if (UCombatAttackTokenSubsystem* TokenSubsystem = GetWorld()->GetSubsystem<UCombatAttackTokenSubsystem>())
+	{
+		TokenSubsystem->ReleaseToken(this);
+	}
+}
+
+void ACombatEnemy::SetLifeBarPercentage(float Percent)
+{
+	// let other UI listeners know through the coalescing bus
+	if (UCombatUIEventSubsystem* UIEvents = GetWorld()->GetSubsystem<UCombatUIEventSubsystem>())
+	{
+		UIEvents->NotifyHealthChanged(this, Percent);
+	}
+
+	if (LifeBarId != INDEX_NONE)
+	{
+		if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+		{
+			LifeBars->SetBarPercentage(LifeBarId, Percent);
+		}
+	}
+	else if (LifeBarWidget)
+	{
+		LifeBarWidget->SetLifePercentage(Percent);
+	}
+}
+
+void ACombatEnemy::SetLifeBarVisible(bool bVisible)
+{
+	if (LifeBarId != INDEX_NONE)
+	{
+		if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+		{
+			LifeBars->SetBarVisible(LifeBarId, bVisible);
+		}
+	}
+	else
+	{
+		LifeBar->SetHiddenInGame(!bVisible);
+	}
 }
@@ -8,11 +8,14 @@
 #include "CombatDamageable.h"
 #include "Animation/AnimMontage.h"
 #include "Engine/TimerHandle.h"
+#include "Components/SkinnedMeshComponent.h"
 #include "CombatEnemy.generated.h"
 
 class UWidgetComponent;
 class UCombatLifeBar;
 class UAnimMontage;
+class UWeaponComponent;
+class UAttackData;
 
 /** Completed attack animation delegate for StateTree */
 DECLARE_DELEGATE(FOnEnemyAttackCompleted);
@@ -23,6 +26,42 @@ DECLARE_DELEGATE(FOnEnemyLanded);
 /** Enemy died delegate */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyDied);
 
+/**
+ *  Per-tier AI level of detail settings
+ */
+USTRUCT(BlueprintType)
+struct FCombatEnemyLODTier
+{
+	GENERATED_BODY()
+
+	/** This tier applies up to this distance from the nearest player */
+	UPROPERTY(EditAnywhere, Category="LOD", meta = (ClampMin = 0, Units = "cm"))
+	float MaxDistance = 0.0f;
+
+	/** Tick interval for the actor and its StateTree. Zero ticks every frame */
+	UPROPERTY(EditAnywhere, Category="LOD", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
+	float AITickInterval = 0.0f;
+
+	/** Tick interval for the character movement component */
+	UPROPERTY(EditAnywhere, Category="LOD", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
+	float MovementTickInterval = 0.0f;
+
+	/** Tick interval for the skeletal mesh (animation update rate) */
+	UPROPERTY(EditAnywhere, Category="LOD", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
+	float AnimTickInterval = 0.0f;
+
+	/** Whether animation keeps updating when the mesh isn't rendered */
+	UPROPERTY(EditAnywhere, Category="LOD")
+	EVisibilityBasedAnimTickOption AnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+	/** If true, melee attack traces stop at the first blocking hit instead of collecting every overlap */
+	UPROPERTY(EditAnywhere, Category="LOD")
+	bool bSimpleAttackTrace = false;
+};
+
+/** Pooled enemy ready to be returned to its pool */
+DECLARE_DELEGATE_OneParam(FOnEnemyReturnToPool, class ACombatEnemy*);
+
 /**
  *  An AI-controlled character with combat capabilities.
  *  Its bundled AI Controller runs logic through StateTree
@@ -36,10 +75,14 @@ class ACombatEnemy : public ACharacter, public ICombatAttacker, public ICombatDa
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UWidgetComponent* LifeBar;
 
+	/** Weapon component, used for melee hit detection when bUseWeaponComponent is set */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UWeaponComponent* WeaponComponent;
+
 public:
 	
 	/** Constructor */
-	ACombatEnemy();
+	ACombatEnemy(const FObjectInitializer& ObjectInitializer);
 
 protected:
 
@@ -63,6 +106,17 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	UCombatLifeBar* LifeBarWidget;
 
+	/** If true, the life bar is drawn by the shared life bar layer instead of the per-actor widget component */
+	UPROPERTY(EditAnywhere, Category="Damage")
+	bool bUseBatchedLifeBar = true;
+
+	/** Batched life bar fill color */
+	UPROPERTY(EditAnywhere, Category="Damage")
+	FLinearColor LifeBarColor = FLinearColor::Red;
+
+	/** Id of this enemy's bar in the life bar subsystem */
+	int32 LifeBarId = INDEX_NONE;
+
 	/** If true, the character is currently playing an attack animation */
 	bool bIsAttacking = false;
 
@@ -70,6 +124,17 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 500, Units = "cm"))
 	float MeleeTraceDistance = 75.0f;
 
+	/** If true, attack traces run through the weapon component's socket sweep instead of a single forward sphere sweep */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace")
+	bool bUseWeaponComponent = false;
+
+	/** How long the weapon component keeps sweeping after each attack trace notify */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (EditCondition = "bUseWeaponComponent", ClampMin = 0.01, ClampMax = 2, Units = "s"))
+	float WeaponTraceWindow = 0.15f;
+
+	/** Ends the weapon component sweep window */
+	FTimerHandle WeaponTraceTimer;
+
 	/** Radius of the sphere trace for melee attacks */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 500, Units = "cm"))
 	float MeleeTraceRadius = 50.0f;
@@ -112,6 +177,11 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Charged")
 	FName ChargeAttackSection;
 
+	/** Combo and charge sections resolved to montage section indices on BeginPlay (INDEX_NONE = section is missing) */
+	TArray<int32> ComboSectionIndices;
+	int32 ChargeLoopSectionIndex = INDEX_NONE;
+	int32 ChargeAttackSectionIndex = INDEX_NONE;
+
 	/** Minimum number of charge animation loops that will be played by the AI */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Charged", meta = (ClampMin = 1, ClampMax = 20))
 	int32 MinChargeLoops = 2;
@@ -133,6 +203,24 @@ protected:
 	/** Enemy death timer */
 	FTimerHandle DeathTimer;
 
+	/** Baked death animation played instead of a ragdoll when the ragdoll budget is full (see UCombatRagdollSubsystem). Disable auto blend out so it holds its last frame */
+	UPROPERTY(EditAnywhere, Category="Death")
+	TObjectPtr<UAnimMontage> DeathMontage;
+
+	/** Mesh transform relative to the capsule, restored when a ragdolled pooled enemy is reused */
+	FTransform MeshRelativeTransform;
+
+	/** Last actor hit by a melee trace, and its damageable interface if it's the player (null otherwise) */
+	TWeakObjectPtr<AActor> CachedHitActor;
+	ICombatDamageable* CachedHitDamageable = nullptr;
+
+	/** AI LOD tiers, nearest first. Enemies beyond the last tier's distance use the last tier */
+	UPROPERTY(EditAnywhere, Category="LOD")
+	TArray<FCombatEnemyLODTier> LODTiers;
+
+	/** Index of the LOD tier currently applied */
+	int32 CurrentLODTier = INDEX_NONE;
+
 	/** Attack montage ended delegate */
 	FOnMontageEnded OnAttackMontageEnded;
 
@@ -147,6 +235,9 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="Events")
 	FOnEnemyDied OnEnemyDied;
 
+	/** If bound, the enemy is handed back to its pool after death instead of being destroyed */
+	FOnEnemyReturnToPool OnReturnToPool;
+
 public:
 
 	/** Performs an AI-initiated combo attack. Number of hits will be decided by this character */
@@ -158,6 +249,40 @@ public:
 	/** Called from a delegate when the attack montage ends */
 	void AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted);
 
+public:
+
+	/** Hides and deactivates this enemy so it can be parked in a pool. Stops the StateTree and clears death subscribers */
+	void DeactivateForPool();
+
+	/** Reactivates a pooled enemy at the given transform with full HP, reset attack state and a fresh StateTree run */
+	void ActivateFromPool(const FTransform& SpawnTransform);
+
+	/** Initializes the anim instance and pre-touches the combo and charged attack montages, so the first attack doesn't hitch */
+	void PrewarmAnimation();
+
+	/** Enables full ragdoll physics on the mesh. Called by the ragdoll budget once this death has a slot */
+	void StartRagdollPhysics();
+
+	/** Stops simulating and holds the mesh in its current pose. Called by the ragdoll budget once the ragdoll settles */
+	void FreezeRagdollPose();
+
+	/** Plays the death montage, if there is one. Returns true if it's playing */
+	bool PlayDeathMontage();
+
+	/** Sets the current HP and updates the life bar. Used to restore checkpoint snapshots */
+	void SetCurrentHP(float NewHP);
+
+	/** Picks and applies the LOD tier for the given distance to the nearest player */
+	void UpdateLOD(float DistanceToPlayer);
+
+protected:
+
+	/** Applies a LOD tier's tick rates to the actor, StateTree, movement and mesh */
+	void ApplyLODTier(int32 TierIndex);
+
+	/** Exempts the mesh from animation budget throttling while an attack plays */
+	void SetAnimBudgetCritical(bool bCritical);
+
 public:
 
 	// ~begin ICombatAttacker interface
@@ -175,6 +300,23 @@ public:
 
 	// ~end ICombatAttacker interface
 
+protected:
+
+	/** Applies damage for the hits of a batched attack trace */
+	void ProcessAttackHits(const TArray<FHitResult>& Hits);
+
+	/** Applies melee damage for a single hit if it landed on the player */
+	void ApplyMeleeHit(const FHitResult& Hit);
+
+	/** Handles weapon component hits */
+	UFUNCTION()
+	void OnWeaponHit(AActor* HitActor, const FHitResult& HitResult, UAttackData* AttackData);
+
+	/** Stops the weapon component sweep at the end of the trace window */
+	void EndWeaponTrace();
+
+public:
+
 	// ~begin ICombatDamageable interface
 
 	/** Handles damage and knockback events */
@@ -214,4 +356,10 @@ protected:
 
 	/** EndPlay cleanup */
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
+	/** Updates the life bar fill on whichever life bar is in use */
+	void SetLifeBarPercentage(float Percent);
+
+	/** Shows or hides whichever life bar is in use */
+	void SetLifeBarVisible(bool bVisible);
 };
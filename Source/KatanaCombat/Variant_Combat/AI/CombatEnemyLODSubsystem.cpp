@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatEnemyLODSubsystem.h"
+#include "CombatEnemy.h"
+#include "CombatPlayerInfoSubsystem.h"
+#include "Core/CombatBudgetSubsystem.h"
+#include "Engine/World.h"
+
+void UCombatEnemyLODSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UCombatJobSchedulerSubsystem* Scheduler = Collection.InitializeDependency<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->RegisterJob<&UCombatEnemyLODSubsystem::UpdateLODs>(UpdateJob, this, UpdateInterval, ECombatJobPriority::High, TEXT("EnemyLOD.Update"));
+	}
+}
+
+void UCombatEnemyLODSubsystem::Deinitialize()
+{
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->UnregisterJob(UpdateJob);
+	}
+
+	Super::Deinitialize();
+}
+
+void UCombatEnemyLODSubsystem::RegisterEnemy(ACombatEnemy* Enemy)
+{
+	Enemies.AddUnique(Enemy);
+
+	// evaluate the newcomer right away
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->MarkJobDue(UpdateJob);
+	}
+}
+
+void UCombatEnemyLODSubsystem::UnregisterEnemy(ACombatEnemy* Enemy)
+{
+	Enemies.RemoveSwap(Enemy);
+}
+
+void UCombatEnemyLODSubsystem::UpdateLODs(float DeltaTime)
+{
+	if (Enemies.Num() == 0)
+	{
+		return;
+	}
+
+	UCombatPlayerInfoSubsystem* PlayerInfoSubsystem = GetWorld()->GetSubsystem<UCombatPlayerInfoSubsystem>();
+	if (!PlayerInfoSubsystem)
+	{
+		return;
+	}
+
+	const TConstArrayView<FCombatPlayerInfo> Players = PlayerInfoSubsystem->GetAllPlayerInfo();
+
+	// combat over its frame budget: every enemy picks a tier as if it were further away (the nearest keep theirs longest)
+	const UCombatBudgetSubsystem* Budget = UCombatBudgetSubsystem::Get(this);
+	const float BudgetDistanceScale = Budget ? 1.0f / Budget->GetTotalDetailScale() : 1.0f;
+
+	// drop stale entries
+	Enemies.RemoveAllSwap([](const TWeakObjectPtr<ACombatEnemy>& Enemy) { return !Enemy.IsValid(); });
+
+	for (const TWeakObjectPtr<ACombatEnemy>& EnemyPtr : Enemies)
+	{
+		ACombatEnemy* Enemy = EnemyPtr.Get();
+
+		// skip pooled enemies parked out of play
+		if (Enemy->IsHidden())
+		{
+			continue;
+		}
+
+		// find the nearest player
+		const FVector EnemyLocation = Enemy->GetActorLocation();
+		float NearestDistanceSquared = TNumericLimits<float>::Max();
+
+		for (const FCombatPlayerInfo& Player : Players)
+		{
+			if (Player.Pawn.IsValid())
+			{
+				NearestDistanceSquared = FMath::Min(NearestDistanceSquared, static_cast<float>(FVector::DistSquared(EnemyLocation, Player.Location)));
+			}
+		}
+
+		float Distance = FMath::Sqrt(NearestDistanceSquared) * BudgetDistanceScale;
+
+		// offscreen enemies can get away with less detail
+		if (!Enemy->WasRecentlyRendered(UpdateInterval))
+		{
+			Distance *= OffscreenDistanceScale;
+		}
+
+		Enemy->UpdateLOD(Distance);
+	}
+}
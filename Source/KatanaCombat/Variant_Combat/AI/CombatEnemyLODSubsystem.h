@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "CombatEnemyLODSubsystem.generated.h"
+
+class ACombatEnemy;
+
+/**
+ *  Distance-bucket AI level of detail for combat enemies
+ *  Periodically measures each registered enemy's distance to the nearest player and whether it was
+ *  recently rendered, then lets the enemy pick and apply its LOD tier (see ACombatEnemy::LODTiers)
+ *  Evaluations run as a job on the combat job scheduler, so a large crowd shares the frame budget
+ *  with the other non-critical combat work instead of spiking the frame it lands on
+ *  While combat as a whole is over budget (UCombatBudgetSubsystem) distances are scaled up, dropping enemies to cheaper tiers
+ */
+UCLASS()
+class UCombatEnemyLODSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Adds an enemy to LOD management */
+	void RegisterEnemy(ACombatEnemy* Enemy);
+
+	/** Removes an enemy from LOD management */
+	void UnregisterEnemy(ACombatEnemy* Enemy);
+
+	/** Time between LOD evaluations */
+	float UpdateInterval = 0.25f;
+
+	/** Enemies not rendered recently are treated as this much farther away */
+	float OffscreenDistanceScale = 2.0f;
+
+	// ~begin UWorldSubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// ~end UWorldSubsystem interface
+
+protected:
+
+	/** Scheduled job: measures every enemy and applies its LOD tier */
+	void UpdateLODs(float DeltaTime);
+
+	/** Enemies under LOD management */
+	TArray<TWeakObjectPtr<ACombatEnemy>> Enemies;
+
+	/** LOD evaluation job on the combat job scheduler */
+	FCombatJobHandle UpdateJob;
+};
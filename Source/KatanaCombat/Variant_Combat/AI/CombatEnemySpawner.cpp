@@ -7,10 +7,18 @@
 #include "Components/ArrowComponent.h"
 #include "TimerManager.h"
 #include "CombatEnemy.h"
+#include "CombatSpawnQueueSubsystem.h"
+#include "Debug/CombatTrace.h"
+#include "KatanaCombat.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
 
 ACombatEnemySpawner::ACombatEnemySpawner()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	// only ticks while a stress test is running
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// create the root
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
@@ -31,6 +39,24 @@ void ACombatEnemySpawner::BeginPlay()
 {
 	Super::BeginPlay();
 	
+	// spawn the pooled enemies up front, before anyone is watching
+	// streamed encounters prewarm once their activation volume has loaded the enemy class
+	if (bUseEnemyPool && !IsStreamedEncounter())
+	{
+		PrewarmEnemyPool();
+	}
+
+	// stress test mode replaces the regular spawn flow
+	if (bStressTestMode)
+	{
+		if (bShouldSpawnEnemiesImmediately)
+		{
+			GetWorld()->GetTimerManager().SetTimer(StressTimer, this, &ACombatEnemySpawner::StartStressTest, InitialSpawnDelay);
+		}
+
+		return;
+	}
+
 	// should we spawn an enemy right away?
 	if (bShouldSpawnEnemiesImmediately)
 	{
@@ -44,28 +70,317 @@ void ACombatEnemySpawner::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the spawn timer
+	// clear the spawn timers
 	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+	GetWorld()->GetTimerManager().ClearTimer(StressTimer);
+
+	// nothing queued should finish after we're gone
+	CancelQueuedSpawns();
+
+	// make sure a stress capture isn't left running
+	if (bStartedStressCsvCapture)
+	{
+		FinishStressTest();
+	}
+
+	// pooled enemies are level actors and get cleaned up with the level
+	EnemyPool.Reset();
+}
+
+void ACombatEnemySpawner::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	// drop enemies that have died or been destroyed (pooled enemies are never destroyed, so check HP too)
+	StressEnemies.RemoveAllSwap([](const TWeakObjectPtr<ACombatEnemy>& Enemy) { return !Enemy.IsValid() || Enemy->IsActorBeingDestroyed() || Enemy->CurrentHP <= 0.0f; });
+
+	// undilated frame time, so slomo doesn't skew the numbers
+	const double FrameTimeMs = FApp::GetDeltaTime() * 1000.0;
+	StressWaveFrameTimeSum += FrameTimeMs;
+	StressWaveFrameTimeMax = FMath::Max(StressWaveFrameTimeMax, FrameTimeMs);
+	StressWaveGameThreadTimeSum += FPlatformTime::ToMilliseconds(GGameThreadTime);
+	++StressWaveFrameCount;
+
+	// frame and game thread time are captured by the CSV profiler itself, add the crowd size alongside
+	CSV_CUSTOM_STAT(KatanaCombat, StressLiveEnemies, StressEnemies.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(KatanaCombat, StressWave, StressWavesSpawned, ECsvCustomStatOp::Set);
 }
 
 void ACombatEnemySpawner::SpawnEnemy()
 {
+	// a streamed encounter might still be loading. Spawn once it's in
+	if (!GetEnemyClass() && EnemyPool.Num() == 0 && IsStreamedEncounter())
+	{
+		bSpawnPendingLoad = true;
+		return;
+	}
+
+	// spawn the enemy at the reference capsule's transform
+	RequestEnemyAt(SpawnCapsule->GetComponentTransform(), EQueuedSpawnPurpose::Regular);
+}
+
+void ACombatEnemySpawner::RequestEnemyAt(const FTransform& SpawnTransform, EQueuedSpawnPurpose Purpose)
+{
+	UCombatSpawnQueueSubsystem* SpawnQueue = bTimeSliceSpawns ? GetWorld()->GetSubsystem<UCombatSpawnQueueSubsystem>() : nullptr;
+	if (!SpawnQueue)
+	{
+		OnEnemySpawned(SpawnEnemyAt(SpawnTransform), Purpose);
+		return;
+	}
+
+	FCombatQueuedSpawn Spawn;
+	Spawn.Requester = this;
+	Spawn.SpawnTransform = SpawnTransform;
+	Spawn.bPrewarmAnimation = bUseEnemyPool && bPrewarmPoolAnimation;
+	Spawn.bActivate = Purpose != EQueuedSpawnPurpose::Pool;
+	Spawn.OnSpawned.BindUObject(this, &ACombatEnemySpawner::OnQueuedEnemySpawned, Purpose);
+
+	// reuse a pooled enemy if we have one, otherwise the queue builds a new one
+	while (Spawn.bActivate && bUseEnemyPool && EnemyPool.Num() > 0 && !Spawn.Enemy.IsValid())
+	{
+		ACombatEnemy* PooledEnemy = EnemyPool.Pop(EAllowShrinking::No);
+		if (IsValid(PooledEnemy))
+		{
+			Spawn.Enemy = PooledEnemy;
+		}
+	}
+
+	if (!Spawn.Enemy.IsValid())
+	{
+		Spawn.EnemyClass = GetEnemyClass();
+		if (!Spawn.EnemyClass.IsValid())
+		{
+			return;
+		}
+	}
+
+	++NumQueuedSpawns;
+	SpawnQueue->QueueSpawn(MoveTemp(Spawn));
+}
+
+void ACombatEnemySpawner::OnQueuedEnemySpawned(ACombatEnemy* Enemy, EQueuedSpawnPurpose Purpose)
+{
+	--NumQueuedSpawns;
+
+	// pooled enemies come back to us instead of destroying themselves
+	if (Enemy && bUseEnemyPool)
+	{
+		Enemy->OnReturnToPool.BindUObject(this, &ACombatEnemySpawner::ReturnEnemyToPool);
+	}
+
+	if (Purpose == EQueuedSpawnPurpose::Pool)
+	{
+		if (Enemy)
+		{
+			EnemyPool.Add(Enemy);
+		}
+		return;
+	}
+
+	OnEnemySpawned(Enemy, Purpose);
+}
+
+void ACombatEnemySpawner::OnEnemySpawned(ACombatEnemy* Enemy, EQueuedSpawnPurpose Purpose)
+{
+	if (!Enemy)
+	{
+		return;
+	}
+
+	if (Purpose == EQueuedSpawnPurpose::Stress)
+	{
+		StressEnemies.Add(Enemy);
+		return;
+	}
+
+	// subscribe to the death delegate
+	Enemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+
+	// keep track of it for checkpoint snapshots
+	LiveEnemies.Add(Enemy);
+}
+
+void ACombatEnemySpawner::CancelQueuedSpawns()
+{
+	UCombatSpawnQueueSubsystem* SpawnQueue = NumQueuedSpawns > 0 ? GetWorld()->GetSubsystem<UCombatSpawnQueueSubsystem>() : nullptr;
+	NumQueuedSpawns = 0;
+	if (!SpawnQueue)
+	{
+		return;
+	}
+
+	TArray<ACombatEnemy*> HeldEnemies;
+	SpawnQueue->CancelSpawns(this, HeldEnemies);
+
+	// parked or pooled, never activated: straight back where they came from
+	for (ACombatEnemy* Enemy : HeldEnemies)
+	{
+		if (bUseEnemyPool)
+		{
+			Enemy->OnReturnToPool.BindUObject(this, &ACombatEnemySpawner::ReturnEnemyToPool);
+			ReturnEnemyToPool(Enemy);
+		}
+		else
+		{
+			Enemy->Destroy();
+		}
+	}
+}
+
+ACombatEnemy* ACombatEnemySpawner::SpawnEnemyAt(const FTransform& SpawnTransform)
+{
+	// reuse a pooled enemy if we have one
+	while (bUseEnemyPool && EnemyPool.Num() > 0)
+	{
+		ACombatEnemy* PooledEnemy = EnemyPool.Pop(EAllowShrinking::No);
+		if (IsValid(PooledEnemy))
+		{
+			PooledEnemy->ActivateFromPool(SpawnTransform);
+			return PooledEnemy;
+		}
+	}
+
 	// ensure the enemy class is valid
+	UClass* Class = GetEnemyClass();
+	if (!Class)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(Class, SpawnTransform, SpawnParams);
+
+	// pooled enemies come back to us instead of destroying themselves
+	if (SpawnedEnemy && bUseEnemyPool)
+	{
+		SpawnedEnemy->OnReturnToPool.BindUObject(this, &ACombatEnemySpawner::ReturnEnemyToPool);
+	}
+
+	return SpawnedEnemy;
+}
+
+void ACombatEnemySpawner::PrewarmEnemyPool()
+{
+	UClass* Class = GetEnemyClass();
+	if (!Class)
+	{
+		return;
+	}
+
+	EnemyPool.Reserve(PoolPrewarmCount);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 Index = 0; Index < PoolPrewarmCount; ++Index)
+	{
+		// park them at the spawner, they're hidden and collisionless until used
+		if (ACombatEnemy* Enemy = GetWorld()->SpawnActor<ACombatEnemy>(Class, SpawnCapsule->GetComponentTransform(), SpawnParams))
+		{
+			Enemy->OnReturnToPool.BindUObject(this, &ACombatEnemySpawner::ReturnEnemyToPool);
+
+			// pay the anim instance's first use costs now, while we're loading
+			if (bPrewarmPoolAnimation)
+			{
+				Enemy->PrewarmAnimation();
+			}
+
+			Enemy->DeactivateForPool();
+			EnemyPool.Add(Enemy);
+		}
+	}
+}
+
+UClass* ACombatEnemySpawner::GetEnemyClass() const
+{
 	if (IsValid(EnemyClass))
 	{
-		// spawn the enemy at the reference capsule's transform
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		return EnemyClass;
+	}
+
+	// only resolves while the activation volume keeps the encounter loaded
+	return StreamedEnemyClass.Get();
+}
+
+void ACombatEnemySpawner::GetEncounterAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	if (!StreamedEnemyClass.IsNull())
+	{
+		OutAssets.Add(StreamedEnemyClass.ToSoftObjectPath());
+	}
+
+	for (const TSoftObjectPtr<UObject>& Asset : StreamedAssets)
+	{
+		if (!Asset.IsNull())
+		{
+			OutAssets.Add(Asset.ToSoftObjectPath());
+		}
+	}
+}
+
+void ACombatEnemySpawner::OnEncounterLoaded()
+{
+	bEncounterLoaded = true;
+
+	// fill the pool now that the enemy class is available. The player is nearby by now, so spread it over frames
+	if (bUseEnemyPool && EnemyPool.Num() == 0)
+	{
+		if (bTimeSliceSpawns && GetWorld()->GetSubsystem<UCombatSpawnQueueSubsystem>())
+		{
+			// the waiting spawn goes first instead of queueing behind the whole pool
+			if (bSpawnPendingLoad)
+			{
+				bSpawnPendingLoad = false;
+				SpawnEnemy();
+			}
 
-		ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+			for (int32 Index = 0; Index < PoolPrewarmCount; ++Index)
+			{
+				RequestEnemyAt(SpawnCapsule->GetComponentTransform(), EQueuedSpawnPurpose::Pool);
+			}
+		}
+		else
+		{
+			PrewarmEnemyPool();
+		}
+	}
 
-		// was the enemy successfully created?
-		if (SpawnedEnemy)
+	// run the spawn that was waiting on the load
+	if (bSpawnPendingLoad)
+	{
+		bSpawnPendingLoad = false;
+		SpawnEnemy();
+	}
+}
+
+void ACombatEnemySpawner::OnEncounterUnloaded()
+{
+	bEncounterLoaded = false;
+
+	// idle pooled enemies would keep the encounter's assets alive, so let them go
+	// live enemies keep theirs until they're gone
+	CancelQueuedSpawns();
+	for (ACombatEnemy* Enemy : EnemyPool)
+	{
+		if (IsValid(Enemy))
 		{
-			// subscribe to the death delegate
-			SpawnedEnemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+			Enemy->OnReturnToPool.Unbind();
+			Enemy->Destroy();
 		}
 	}
+
+	EnemyPool.Reset();
+}
+
+void ACombatEnemySpawner::ReturnEnemyToPool(ACombatEnemy* Enemy)
+{
+	if (IsValid(Enemy))
+	{
+		Enemy->DeactivateForPool();
+		EnemyPool.Add(Enemy);
+	}
 }
 
 void ACombatEnemySpawner::OnEnemyDied()
@@ -99,6 +414,103 @@ void ACombatEnemySpawner::SpawnerDepleted()
 	}
 }
 
+void ACombatEnemySpawner::StartStressTest()
+{
+	StressWavesSpawned = 0;
+	StressEnemies.Reset();
+	StressWaveFrameTimeSum = 0.0;
+	StressWaveGameThreadTimeSum = 0.0;
+	StressWaveFrameTimeMax = 0.0;
+	StressWaveFrameCount = 0;
+
+#if CSV_PROFILER
+	// don't hijack a capture someone else started, just add our stats to it
+	if (bRecordStressCsvProfile && !FCsvProfiler::Get()->IsCapturing())
+	{
+		const FString FileName = FString::Printf(TEXT("CombatStress_%dx%d_%s.csv"), StressWaveCount, StressEnemiesPerWave, *FDateTime::Now().ToString());
+		FCsvProfiler::Get()->BeginCapture(-1, FString(), FileName);
+		bStartedStressCsvCapture = true;
+	}
+#endif
+
+	CSV_METADATA(TEXT("CombatStressWaves"), *FString::FromInt(StressWaveCount));
+	CSV_METADATA(TEXT("CombatStressEnemiesPerWave"), *FString::FromInt(StressEnemiesPerWave));
+
+	UE_LOG(LogKatanaCombat, Log, TEXT("Combat stress test started: %d waves x %d enemies every %.1fs"), StressWaveCount, StressEnemiesPerWave, StressWaveInterval);
+
+	SetActorTickEnabled(true);
+
+	// spawn the first wave now, the rest on the timer
+	SpawnStressWave();
+}
+
+void ACombatEnemySpawner::SpawnStressWave()
+{
+	// summarize the wave that just ended before the crowd grows
+	if (StressWavesSpawned > 0)
+	{
+		LogStressWaveSummary();
+	}
+
+	const FTransform BaseTransform = SpawnCapsule->GetComponentTransform();
+
+	for (int32 Index = 0; Index < StressEnemiesPerWave; ++Index)
+	{
+		// golden angle spiral gives an even spread without overlapping the previous waves
+		const int32 SpawnIndex = StressWavesSpawned * StressEnemiesPerWave + Index;
+		const int32 TotalToSpawn = StressWaveCount * StressEnemiesPerWave;
+		const float Radius = StressSpawnRadius * FMath::Sqrt((SpawnIndex + 0.5f) / TotalToSpawn);
+		const float Angle = SpawnIndex * 2.39996323f;
+
+		FTransform SpawnTransform = BaseTransform;
+		SpawnTransform.AddToTranslation(FVector(FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius, 0.0f));
+
+		RequestEnemyAt(SpawnTransform, EQueuedSpawnPurpose::Stress);
+	}
+
+	++StressWavesSpawned;
+
+	// schedule the next wave, or the end of the run
+	if (StressWavesSpawned < StressWaveCount)
+	{
+		GetWorld()->GetTimerManager().SetTimer(StressTimer, this, &ACombatEnemySpawner::SpawnStressWave, StressWaveInterval);
+	}
+	else
+	{
+		GetWorld()->GetTimerManager().SetTimer(StressTimer, this, &ACombatEnemySpawner::FinishStressTest, FMath::Max(StressProfileTailTime, 0.1f));
+	}
+}
+
+void ACombatEnemySpawner::LogStressWaveSummary()
+{
+	const int32 NumFrames = FMath::Max(StressWaveFrameCount, 1);
+
+	UE_LOG(LogKatanaCombat, Log, TEXT("Combat stress wave %d: %d live enemies, frame avg %.2fms max %.2fms, game thread avg %.2fms"),
+		StressWavesSpawned, StressEnemies.Num(), StressWaveFrameTimeSum / NumFrames, StressWaveFrameTimeMax, StressWaveGameThreadTimeSum / NumFrames);
+
+	StressWaveFrameTimeSum = 0.0;
+	StressWaveGameThreadTimeSum = 0.0;
+	StressWaveFrameTimeMax = 0.0;
+	StressWaveFrameCount = 0;
+}
+
+void ACombatEnemySpawner::FinishStressTest()
+{
+	LogStressWaveSummary();
+	SetActorTickEnabled(false);
+
+#if CSV_PROFILER
+	if (bStartedStressCsvCapture)
+	{
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+
+	bStartedStressCsvCapture = false;
+
+	UE_LOG(LogKatanaCombat, Log, TEXT("Combat stress test finished after %d waves"), StressWavesSpawned);
+}
+
 void ACombatEnemySpawner::ToggleInteraction(AActor* ActivationInstigator)
 {
 	// stub
@@ -115,6 +527,13 @@ void ACombatEnemySpawner::ActivateInteraction(AActor* ActivationInstigator)
 	// raise the activation flag
 	bHasBeenActivated = true;
 
+	// stress test mode starts the waves instead
+	if (bStressTestMode)
+	{
+		StartStressTest();
+		return;
+	}
+
 	// spawn the first enemy
 	SpawnEnemy();
 }
@@ -123,3 +542,91 @@ void ACombatEnemySpawner::DeactivateInteraction(AActor* ActivationInstigator)
 {
 	// stub
 }
+
+void ACombatEnemySpawner::SerializeEncounterState(FArchive& Ar)
+{
+	// drop enemies that have died or been destroyed (pooled enemies are never destroyed, so check HP too)
+	LiveEnemies.RemoveAllSwap([](const TWeakObjectPtr<ACombatEnemy>& Enemy) { return !Enemy.IsValid() || Enemy->IsActorBeingDestroyed() || Enemy->CurrentHP <= 0.0f; });
+
+	uint8 bActivated = bHasBeenActivated;
+	Ar << SpawnCount;
+	Ar << bActivated;
+	bHasBeenActivated = bActivated != 0;
+
+	int32 NumEnemies = LiveEnemies.Num();
+	Ar << NumEnemies;
+
+	// one compact record per live enemy
+	struct FEnemyRecord
+	{
+		FVector3f Location;
+		float Yaw;
+		float HP;
+	};
+
+	TArray<FEnemyRecord, TInlineAllocator<8>> Records;
+	Records.SetNum(NumEnemies);
+
+	for (int32 Index = 0; Index < NumEnemies; ++Index)
+	{
+		FEnemyRecord& Record = Records[Index];
+
+		if (Ar.IsSaving())
+		{
+			const ACombatEnemy* Enemy = LiveEnemies[Index].Get();
+			Record.Location = FVector3f(Enemy->GetActorLocation());
+			Record.Yaw = Enemy->GetActorRotation().Yaw;
+			Record.HP = Enemy->CurrentHP;
+		}
+
+		Ar << Record.Location;
+		Ar << Record.Yaw;
+		Ar << Record.HP;
+	}
+
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+
+	// cancel any pending spawn or depletion, the snapshot decides what happens next
+	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+	bSpawnPendingLoad = false;
+	CancelQueuedSpawns();
+
+	// put away whoever is fighting right now
+	for (const TWeakObjectPtr<ACombatEnemy>& WeakEnemy : LiveEnemies)
+	{
+		ACombatEnemy* Enemy = WeakEnemy.Get();
+
+		if (Enemy && bUseEnemyPool)
+		{
+			ReturnEnemyToPool(Enemy);
+
+		} else if (Enemy) {
+
+			Enemy->Destroy();
+		}
+	}
+
+	LiveEnemies.Reset();
+
+	// bring the snapshot enemies back in place, reusing pooled actors where we can
+	for (const FEnemyRecord& Record : Records)
+	{
+		const FTransform SpawnTransform(FRotator(0.0f, Record.Yaw, 0.0f), FVector(Record.Location));
+
+		if (ACombatEnemy* Enemy = SpawnEnemyAt(SpawnTransform))
+		{
+			Enemy->SetCurrentHP(Record.HP);
+			Enemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+			LiveEnemies.Add(Enemy);
+		}
+	}
+
+	// nobody left alive at the snapshot but more to come? resume the spawn flow
+	if (LiveEnemies.Num() == 0 && SpawnCount > 0 && (bHasBeenActivated || bShouldSpawnEnemiesImmediately))
+	{
+		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, RespawnDelay);
+	}
+}
@@ -16,6 +16,10 @@ class ACombatEnemy;
  *  Enemies will be spawned one by one, and the spawner will wait until the enemy dies before spawning a new one.
  *  The spawner can be remotely activated through the ICombatActivatable interface
  *  When the last spawned enemy dies, the spawner can also activate other ICombatActivatables
+ *  In stress test mode, the spawner instead spawns hordes in waves and records a CSV profile
+ *  (frame time, KatanaCombat timings, physics query counts) to find the enemy ceiling per platform
+ *  With bTimeSliceSpawns, spawns, waves and the streamed encounter prewarm go through UCombatSpawnQueueSubsystem,
+ *  which spreads them across frames within a millisecond budget
  */
 UCLASS(abstract)
 class ACombatEnemySpawner : public AActor, public ICombatActivatable
@@ -64,6 +68,105 @@ protected:
 	/** Timer to spawn enemies after a delay */
 	FTimerHandle SpawnTimer;
 
+	/** If true, dead enemies are hidden and reused instead of destroyed, avoiding spawn hitches */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Pool")
+	bool bUseEnemyPool = false;
+
+	/** Number of enemies spawned hidden on BeginPlay so the first spawns don't hitch */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Pool", meta = (ClampMin = 0, ClampMax = 500, EditCondition = "bUseEnemyPool"))
+	int32 PoolPrewarmCount = 0;
+
+	/** If true, prewarmed pool enemies also initialize their animation and pre-touch their attack montages */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Pool", meta = (EditCondition = "bUseEnemyPool"))
+	bool bPrewarmPoolAnimation = true;
+
+	/** Inactive enemies ready for reuse */
+	UPROPERTY(Transient)
+	TArray<ACombatEnemy*> EnemyPool;
+
+	/** If true, enemies are built and activated across several frames through the spawn queue instead of all at once */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Spawn Queue")
+	bool bTimeSliceSpawns = true;
+
+	/** What a queued spawn is for, once it's ready */
+	enum class EQueuedSpawnPurpose : uint8
+	{
+		/** Regular one at a time enemy */
+		Regular,
+
+		/** Stress test wave enemy */
+		Stress,
+
+		/** Parked in the pool (streamed encounter prewarm) */
+		Pool
+	};
+
+	/** Spawns this spawner has waiting in the spawn queue */
+	int32 NumQueuedSpawns = 0;
+
+	/** If set (and EnemyClass is not), the enemy class is only loaded while an activation volume streams this encounter in */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Encounter Streaming")
+	TSoftClassPtr<ACombatEnemy> StreamedEnemyClass;
+
+	/** Extra assets loaded and released with the encounter, e.g. the enemies' UAttackData movesets */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Encounter Streaming")
+	TArray<TSoftObjectPtr<UObject>> StreamedAssets;
+
+	/** True while the streamed encounter assets are loaded */
+	bool bEncounterLoaded = false;
+
+	/** Set if a spawn was requested before the streamed enemy class finished loading */
+	bool bSpawnPendingLoad = false;
+
+	/** Regular (non stress test) enemies spawned by this spawner, for checkpoint snapshots */
+	TArray<TWeakObjectPtr<ACombatEnemy>> LiveEnemies;
+
+	/** If true, spawns waves of enemies instead of one at a time and profiles the encounter */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Stress Test")
+	bool bStressTestMode = false;
+
+	/** Number of waves to spawn in stress test mode */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Stress Test", meta = (ClampMin = 1, ClampMax = 100, EditCondition = "bStressTestMode"))
+	int32 StressWaveCount = 5;
+
+	/** Number of enemies spawned per wave. Waves stack: earlier enemies stay alive until killed */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Stress Test", meta = (ClampMin = 1, ClampMax = 200, EditCondition = "bStressTestMode"))
+	int32 StressEnemiesPerWave = 10;
+
+	/** Time between waves */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Stress Test", meta = (ClampMin = 0.5, ClampMax = 120, Units = "s", EditCondition = "bStressTestMode"))
+	float StressWaveInterval = 10.0f;
+
+	/** Radius around the spawn capsule that wave enemies spread across */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Stress Test", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm", EditCondition = "bStressTestMode"))
+	float StressSpawnRadius = 1500.0f;
+
+	/** Time to keep profiling after the last wave spawns */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Stress Test", meta = (ClampMin = 0, ClampMax = 300, Units = "s", EditCondition = "bStressTestMode"))
+	float StressProfileTailTime = 15.0f;
+
+	/** If true, starts a CSV profiler capture for the stress run (written to Saved/Profiling/CSV) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Stress Test", meta = (EditCondition = "bStressTestMode"))
+	bool bRecordStressCsvProfile = true;
+
+	/** Enemies spawned by the stress test that are still alive */
+	TArray<TWeakObjectPtr<ACombatEnemy>> StressEnemies;
+
+	/** Number of waves spawned so far */
+	int32 StressWavesSpawned = 0;
+
+	/** Frame and game thread time accumulated over the current wave, for the per-wave summary log */
+	double StressWaveFrameTimeSum = 0.0;
+	double StressWaveGameThreadTimeSum = 0.0;
+	double StressWaveFrameTimeMax = 0.0;
+	int32 StressWaveFrameCount = 0;
+
+	/** Set if this spawner started the CSV capture and should end it */
+	bool bStartedStressCsvCapture = false;
+
+	/** Timer for stress test waves */
+	FTimerHandle StressTimer;
+
 public:	
 	
 	/** Constructor */
@@ -77,11 +180,38 @@ public:
 	/** Cleanup */
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
+	/** Samples stress test stats (only ticks in stress test mode) */
+	virtual void Tick(float DeltaSeconds) override;
+
 protected:
 
 	/** Spawn an enemy and subscribe to its death event */
 	void SpawnEnemy();
 
+	/** Spawn an enemy at the given transform, reusing a pooled one if available. Its AI Controller runs the StateTree */
+	ACombatEnemy* SpawnEnemyAt(const FTransform& SpawnTransform);
+
+	/** Spawn an enemy at the given transform now, or through the spawn queue with bTimeSliceSpawns. Reuses a pooled one if available */
+	void RequestEnemyAt(const FTransform& SpawnTransform, EQueuedSpawnPurpose Purpose);
+
+	/** Called by the spawn queue once a requested enemy is ready */
+	void OnQueuedEnemySpawned(ACombatEnemy* Enemy, EQueuedSpawnPurpose Purpose);
+
+	/** Finishes a regular or stress spawn: death subscription and tracking */
+	void OnEnemySpawned(ACombatEnemy* Enemy, EQueuedSpawnPurpose Purpose);
+
+	/** Drops this spawner's queued spawns, putting away the enemies they already hold */
+	void CancelQueuedSpawns();
+
+	/** Spawns PoolPrewarmCount inactive enemies into the pool, warming up their animation if bPrewarmPoolAnimation is set */
+	void PrewarmEnemyPool();
+
+	/** Returns the enemy class to spawn: EnemyClass, or the streamed class once loaded */
+	UClass* GetEnemyClass() const;
+
+	/** Deactivates a dead pooled enemy and makes it available for reuse */
+	void ReturnEnemyToPool(ACombatEnemy* Enemy);
+
 	/** Called when the spawned enemy has died */
 	UFUNCTION()
 	void OnEnemyDied();
@@ -89,6 +219,41 @@ protected:
 	/** Called after the last spawned enemy has died */
 	void SpawnerDepleted();
 
+	/** Starts the wave timer and the CSV capture */
+	void StartStressTest();
+
+	/** Spawns StressEnemiesPerWave enemies spread around the spawn capsule */
+	void SpawnStressWave();
+
+	/** Logs the summary for the wave that just ended */
+	void LogStressWaveSummary();
+
+	/** Ends the stress test and the CSV capture */
+	void FinishStressTest();
+
+public:
+
+	/** Returns true if this spawner's enemies are loaded on demand by an activation volume */
+	bool IsStreamedEncounter() const { return !StreamedEnemyClass.IsNull(); }
+
+	/** Returns true while the streamed encounter assets are loaded */
+	bool IsEncounterLoaded() const { return bEncounterLoaded; }
+
+	/** Adds the soft references to load when this encounter streams in */
+	void GetEncounterAssets(TArray<FSoftObjectPath>& OutAssets) const;
+
+	/** Called by the activation volume once the encounter assets are loaded. Prewarms the pool and runs any deferred spawn */
+	void OnEncounterLoaded();
+
+	/** Called by the activation volume before the encounter assets are released. Destroys idle pooled enemies */
+	void OnEncounterUnloaded();
+
+	/**
+	 *  Saves or restores this spawner's encounter state: spawn count, activation and its live enemies' location and HP
+	 *  Restoring puts the live enemies away and brings the snapshot enemies back in place, through the pool when it's in use
+	 */
+	void SerializeEncounterState(FArchive& Ar);
+
 public:
 
 	// ~begin ICombatActivatable interface
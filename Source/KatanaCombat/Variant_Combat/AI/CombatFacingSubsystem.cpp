@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatFacingSubsystem.h"
+#include "AIController.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+
+void UCombatFacingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UCombatJobSchedulerSubsystem* Scheduler = Collection.InitializeDependency<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->RegisterJob<&UCombatFacingSubsystem::UpdateFacingJob>(FacingJob, this, FacingUpdateInterval, ECombatJobPriority::High, TEXT("Facing.Update"));
+	}
+}
+
+void UCombatFacingSubsystem::Deinitialize()
+{
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->UnregisterJob(FacingJob);
+	}
+
+	Facings.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatFacingSubsystem::StartFacingActor(AAIController* Controller, AActor* Target)
+{
+	if (Target)
+	{
+		StartFacing(Controller, Target, Target->GetActorLocation());
+	}
+}
+
+void UCombatFacingSubsystem::StartFacingLocation(AAIController* Controller, const FVector& Location)
+{
+	StartFacing(Controller, nullptr, Location);
+}
+
+void UCombatFacingSubsystem::StartFacing(AAIController* Controller, AActor* Target, const FVector& Location)
+{
+	if (!Controller)
+	{
+		return;
+	}
+
+	FFacing* Facing = Facings.Find(Controller);
+	if (!Facing)
+	{
+		Facing = &Facings.Add(Controller);
+		Facing->Controller = Controller;
+		Facing->bRestoreControlRotationFromPawn = Controller->bSetControlRotationFromPawnOrientation;
+	}
+
+	Facing->Target = Target;
+	Facing->FaceLocation = Location;
+
+	// drop any focus so the controller stops re-aiming every tick, and keep it from overwriting our rotation with the pawn's
+	Controller->ClearFocus(EAIFocusPriority::Gameplay);
+	Controller->bSetControlRotationFromPawnOrientation = false;
+
+	AimController(*Controller, Location);
+}
+
+void UCombatFacingSubsystem::StopFacing(AAIController* Controller)
+{
+	FFacing Facing;
+	if (!Facings.RemoveAndCopyValue(Controller, Facing))
+	{
+		return;
+	}
+
+	Controller->bSetControlRotationFromPawnOrientation = Facing.bRestoreControlRotationFromPawn;
+}
+
+void UCombatFacingSubsystem::AimController(AAIController& Controller, const FVector& Location)
+{
+	const APawn* Pawn = Controller.GetPawn();
+	if (!Pawn)
+	{
+		return;
+	}
+
+	// yaw only, the movement component turns the pawn the rest of the way
+	const FVector ToLocation = Location - Pawn->GetActorLocation();
+	if (ToLocation.SizeSquared2D() > UE_KINDA_SMALL_NUMBER)
+	{
+		Controller.SetControlRotation(FRotator(0.0f, ToLocation.Rotation().Yaw, 0.0f));
+	}
+}
+
+void UCombatFacingSubsystem::UpdateFacingJob(float DeltaTime)
+{
+	UpdateFacing();
+}
+
+void UCombatFacingSubsystem::UpdateFacing()
+{
+	for (auto It = Facings.CreateIterator(); It; ++It)
+	{
+		FFacing& Facing = It.Value();
+
+		// controllers destroyed without stopping
+		AAIController* Controller = Facing.Controller.Get();
+		if (!Controller)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// locations were aimed at once on start
+		if (!Facing.Target.IsExplicitlyNull())
+		{
+			if (const AActor* Target = Facing.Target.Get())
+			{
+				Facing.FaceLocation = Target->GetActorLocation();
+				AimController(*Controller, Facing.FaceLocation);
+			}
+		}
+	}
+}
@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "CombatFacingSubsystem.generated.h"
+
+class AAIController;
+
+/**
+ *  Batched facing for AI
+ *  Instead of keeping a focus on the controller (re-aimed every controller tick), facing controllers get their
+ *  control rotation yaw set directly and the character movement component turns the pawn at its own rotation rate
+ *  (bUseControllerDesiredRotation). Facing an actor re-aims every controller in one scheduled job every
+ *  FacingUpdateInterval; facing a location is set once
+ *  While facing, the controller stops copying the pawn's rotation into its control rotation, and is restored on stop
+ */
+UCLASS()
+class UCombatFacingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Turns the controller's pawn towards the actor, following it until stopped */
+	void StartFacingActor(AAIController* Controller, AActor* Target);
+
+	/** Turns the controller's pawn towards the location */
+	void StartFacingLocation(AAIController* Controller, const FVector& Location);
+
+	/** Stops facing and gives control rotation back to the controller */
+	void StopFacing(AAIController* Controller);
+
+	/** Returns true if the controller is facing through this subsystem */
+	bool IsFacing(const AAIController* Controller) const { return Facings.Contains(Controller); }
+
+	/** Returns the number of controllers facing through this subsystem */
+	int32 GetNumFacing() const { return Facings.Num(); }
+
+	/** Re-aims every controller facing an actor now (normally done by the scheduled job) */
+	void UpdateFacing();
+
+	/** Time between re-aiming controllers that face a moving actor */
+	float FacingUpdateInterval = 0.1f;
+
+	// ~begin UWorldSubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// ~end UWorldSubsystem interface
+
+protected:
+
+	/** A controller facing an actor or a location */
+	struct FFacing
+	{
+		TWeakObjectPtr<AAIController> Controller;
+
+		/** Actor to follow, or null to face FaceLocation */
+		TWeakObjectPtr<AActor> Target;
+		FVector FaceLocation = FVector::ZeroVector;
+
+		/** Controller setting to put back when facing stops */
+		bool bRestoreControlRotationFromPawn = true;
+	};
+
+	/** Registers the facing and aims the controller once */
+	void StartFacing(AAIController* Controller, AActor* Target, const FVector& Location);
+
+	/** Sets the controller's control rotation yaw towards the location */
+	static void AimController(AAIController& Controller, const FVector& Location);
+
+	/** Scheduled job: re-aims controllers facing an actor */
+	void UpdateFacingJob(float DeltaTime);
+
+	/** Facing job on the combat job scheduler */
+	FCombatJobHandle FacingJob;
+
+	/** Facing state, by controller */
+	TMap<FObjectKey, FFacing> Facings;
+};
@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatPlayerInfoSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Interfaces/CombatInterface.h"
+
+const FCombatPlayerInfo* UCombatPlayerInfoSubsystem::GetPlayerInfo(int32 PlayerIndex)
+{
+	RefreshIfStale();
+
+	return Players.IsValidIndex(PlayerIndex) ? &Players[PlayerIndex] : nullptr;
+}
+
+TConstArrayView<FCombatPlayerInfo> UCombatPlayerInfoSubsystem::GetAllPlayerInfo()
+{
+	RefreshIfStale();
+
+	return Players;
+}
+
+void UCombatPlayerInfoSubsystem::RefreshIfStale()
+{
+	// only sample once per frame
+	if (LastRefreshFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	LastRefreshFrame = GFrameCounter;
+	Players.Reset();
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		FCombatPlayerInfo& Info = Players.AddDefaulted_GetRef();
+
+		APlayerController* PlayerController = Iterator->Get();
+		APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		if (!Pawn)
+		{
+			continue;
+		}
+
+		Info.Pawn = Pawn;
+		Info.Location = Pawn->GetActorLocation();
+		Info.Velocity = Pawn->GetVelocity();
+
+		// attack state is only available from pawns using the combat interface
+		FCombatQuerySnapshot CombatQuery;
+		if (ICombatInterface::QueryCombatState(Pawn, CombatQuery))
+		{
+			Info.bIsAttacking = CombatQuery.bIsAttacking;
+		}
+	}
+}
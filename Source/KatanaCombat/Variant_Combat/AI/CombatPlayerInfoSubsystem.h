@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatPlayerInfoSubsystem.generated.h"
+
+class APawn;
+
+/**
+ *  Snapshot of a player's state, shared by every AI reading it in the same frame
+ */
+USTRUCT(BlueprintType)
+struct FCombatPlayerInfo
+{
+	GENERATED_BODY()
+
+	/** Pawn possessed by the player, if any */
+	UPROPERTY(BlueprintReadOnly, Category="Player Info")
+	TWeakObjectPtr<APawn> Pawn;
+
+	/** World location of the pawn */
+	UPROPERTY(BlueprintReadOnly, Category="Player Info")
+	FVector Location = FVector::ZeroVector;
+
+	/** Velocity of the pawn */
+	UPROPERTY(BlueprintReadOnly, Category="Player Info")
+	FVector Velocity = FVector::ZeroVector;
+
+	/** True if the pawn is attacking (pawns implementing ICombatInterface only) */
+	UPROPERTY(BlueprintReadOnly, Category="Player Info")
+	bool bIsAttacking = false;
+};
+
+/**
+ *  World-level cache of player state for AI
+ *  Player pawns are looked up and sampled at most once per frame, on the first query of that frame,
+ *  so any number of enemies can read player info without repeating the same lookups
+ */
+UCLASS()
+class UCombatPlayerInfoSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns the info for the given local player index, or nullptr if there is no such player */
+	const FCombatPlayerInfo* GetPlayerInfo(int32 PlayerIndex = 0);
+
+	/** Returns the info for every player this frame */
+	TConstArrayView<FCombatPlayerInfo> GetAllPlayerInfo();
+
+protected:
+
+	/** Samples every player controller's pawn if we haven't done so this frame */
+	void RefreshIfStale();
+
+	/** Player snapshots, in player controller iteration order (matches UGameplayStatics::GetPlayerPawn indices) */
+	TArray<FCombatPlayerInfo, TInlineAllocator<4>> Players;
+
+	/** Frame the snapshots were taken on */
+	uint64 LastRefreshFrame = MAX_uint64;
+};
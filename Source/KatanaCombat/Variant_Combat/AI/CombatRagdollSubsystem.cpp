@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatRagdollSubsystem.h"
+#include "CombatEnemy.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+
+void UCombatRagdollSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UCombatJobSchedulerSubsystem* Scheduler = Collection.InitializeDependency<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->RegisterJob<&UCombatRagdollSubsystem::UpdateRagdollsJob>(UpdateJob, this, UpdateInterval, ECombatJobPriority::High, TEXT("Ragdolls.Update"));
+	}
+}
+
+void UCombatRagdollSubsystem::Deinitialize()
+{
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->UnregisterJob(UpdateJob);
+	}
+
+	Simulating.Empty();
+	Queued.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatRagdollSubsystem::RequestRagdoll(ACombatEnemy* Enemy)
+{
+	if (!Enemy)
+	{
+		return;
+	}
+
+	// only one request per death
+	ReleaseRagdoll(Enemy);
+
+	if (Simulating.Num() < MaxSimulatedRagdolls)
+	{
+		StartRagdoll(Enemy);
+		return;
+	}
+
+	// over budget: a baked death pose needs no slot at all
+	if (Enemy->PlayDeathMontage())
+	{
+		return;
+	}
+
+	Queued.Add(Enemy);
+
+	// make room on the next scheduler update instead of waiting out the interval
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->MarkJobDue(UpdateJob);
+	}
+}
+
+void UCombatRagdollSubsystem::ReleaseRagdoll(ACombatEnemy* Enemy)
+{
+	Simulating.RemoveAll([Enemy](const FRagdoll& Ragdoll) { return !Ragdoll.Enemy.IsValid() || Ragdoll.Enemy.Get() == Enemy; });
+	Queued.RemoveAll([Enemy](const TWeakObjectPtr<ACombatEnemy>& QueuedEnemy) { return !QueuedEnemy.IsValid() || QueuedEnemy.Get() == Enemy; });
+}
+
+void UCombatRagdollSubsystem::UpdateRagdollsJob(float DeltaTime)
+{
+	UpdateRagdolls();
+}
+
+void UCombatRagdollSubsystem::UpdateRagdolls()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float DeltaTime = LastUpdateTime > 0.0 ? float(Now - LastUpdateTime) : 0.0f;
+	LastUpdateTime = Now;
+
+	// enemies destroyed or pooled without releasing
+	Queued.RemoveAll([](const TWeakObjectPtr<ACombatEnemy>& QueuedEnemy) { return !QueuedEnemy.IsValid(); });
+
+	int32 NumWaiting = Queued.Num();
+	for (int32 Index = 0; Index < Simulating.Num(); ++Index)
+	{
+		FRagdoll& Ragdoll = Simulating[Index];
+		ACombatEnemy* Enemy = Ragdoll.Enemy.Get();
+		if (!Enemy)
+		{
+			Simulating.RemoveAt(Index--);
+			continue;
+		}
+
+		// accumulate time spent nearly still
+		const float Speed = Enemy->GetMesh()->GetPhysicsLinearVelocity().Size();
+		Ragdoll.SettledTime = Speed <= SettleSpeed ? Ragdoll.SettledTime + DeltaTime : 0.0f;
+
+		// freeze once settled, when out of time, or early (oldest first) while deaths are waiting
+		const float SimulatedTime = float(Now - Ragdoll.StartTime);
+		const bool bMakeRoom = NumWaiting > 0 && SimulatedTime >= MinSimulationTime;
+		if (Ragdoll.SettledTime >= SettleTime || SimulatedTime >= MaxSimulationTime || bMakeRoom)
+		{
+			NumWaiting -= bMakeRoom ? 1 : 0;
+			FreezeRagdoll(Index--);
+		}
+	}
+
+	// hand the freed slots to the queue, oldest death first
+	while (Queued.Num() > 0 && Simulating.Num() < MaxSimulatedRagdolls)
+	{
+		if (ACombatEnemy* Enemy = Queued[0].Get())
+		{
+			StartRagdoll(Enemy);
+		}
+		Queued.RemoveAt(0);
+	}
+}
+
+void UCombatRagdollSubsystem::StartRagdoll(ACombatEnemy* Enemy)
+{
+	Enemy->StartRagdollPhysics();
+
+	FRagdoll& Ragdoll = Simulating.AddDefaulted_GetRef();
+	Ragdoll.Enemy = Enemy;
+	Ragdoll.StartTime = GetWorld()->GetTimeSeconds();
+}
+
+void UCombatRagdollSubsystem::FreezeRagdoll(int32 Index)
+{
+	if (ACombatEnemy* Enemy = Simulating[Index].Enemy.Get())
+	{
+		Enemy->FreezeRagdollPose();
+		++NumFrozen;
+	}
+
+	Simulating.RemoveAt(Index);
+}
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "CombatRagdollSubsystem.generated.h"
+
+class ACombatEnemy;
+
+/**
+ *  Ragdoll budget for dead enemies
+ *  At most MaxSimulatedRagdolls bodies simulate at once. Each ragdoll freezes into its last pose once
+ *  it settles (or after MaxSimulationTime), which frees its slot for the next death in the queue
+ *  Deaths over budget play the enemy's DeathMontage instead if it has one, otherwise they wait in the queue;
+ *  while deaths are waiting, ragdolls that have simulated for MinSimulationTime are frozen early, oldest first
+ *  Settle checks run as a job on the combat job scheduler, so nothing ticks per ragdoll
+ */
+UCLASS()
+class UCombatRagdollSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Ragdolls the enemy now if the budget allows, otherwise plays its death montage or queues it */
+	void RequestRagdoll(ACombatEnemy* Enemy);
+
+	/** Forgets the enemy, freeing its slot or queue entry (the enemy is being pooled or destroyed) */
+	void ReleaseRagdoll(ACombatEnemy* Enemy);
+
+	/** Returns the number of ragdolls simulating */
+	int32 GetNumSimulating() const { return Simulating.Num(); }
+
+	/** Returns the number of deaths waiting for a ragdoll slot */
+	int32 GetNumQueued() const { return Queued.Num(); }
+
+	/** Returns the number of ragdolls frozen so far */
+	int32 GetNumFrozen() const { return NumFrozen; }
+
+	/** Checks every ragdoll for settling and hands freed slots to the queue now (normally done by the scheduled job) */
+	void UpdateRagdolls();
+
+	/** Most ragdolls simulating at once */
+	int32 MaxSimulatedRagdolls = 8;
+
+	/** Ragdolls whose root moves slower than this are settling (cm/s) */
+	float SettleSpeed = 15.0f;
+
+	/** Time a ragdoll must stay below SettleSpeed before it freezes */
+	float SettleTime = 0.5f;
+
+	/** Ragdolls freeze after this long even if they never settle */
+	float MaxSimulationTime = 4.0f;
+
+	/** While deaths are queued, ragdolls that have simulated this long are frozen early to make room */
+	float MinSimulationTime = 0.75f;
+
+	/** Time between settle checks */
+	float UpdateInterval = 0.1f;
+
+	// ~begin UWorldSubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// ~end UWorldSubsystem interface
+
+protected:
+
+	/** A simulating ragdoll */
+	struct FRagdoll
+	{
+		TWeakObjectPtr<ACombatEnemy> Enemy;
+
+		/** World time the ragdoll started simulating */
+		double StartTime = 0.0;
+
+		/** Time spent below SettleSpeed so far */
+		float SettledTime = 0.0f;
+	};
+
+	/** Scheduled job: settle checks */
+	void UpdateRagdollsJob(float DeltaTime);
+
+	/** Starts simulating the enemy's mesh and gives it a slot */
+	void StartRagdoll(ACombatEnemy* Enemy);
+
+	/** Freezes the ragdoll in slot Index and frees the slot */
+	void FreezeRagdoll(int32 Index);
+
+	/** Settle check job on the combat job scheduler */
+	FCombatJobHandle UpdateJob;
+
+	/** Ragdolls simulating, oldest first */
+	TArray<FRagdoll> Simulating;
+
+	/** Deaths waiting for a slot, oldest first */
+	TArray<TWeakObjectPtr<ACombatEnemy>> Queued;
+
+	/** World time of the last settle check */
+	double LastUpdateTime = 0.0;
+
+	/** Ragdolls frozen so far */
+	int32 NumFrozen = 0;
+};
@@ -0,0 +1,171 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatSpawnQueueSubsystem.h"
+#include "CombatEnemy.h"
+#include "Debug/CombatTrace.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+
+void UCombatSpawnQueueSubsystem::Deinitialize()
+{
+	Queue.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatSpawnQueueSubsystem::QueueSpawn(FCombatQueuedSpawn&& Spawn)
+{
+	FPendingSpawn& Pending = Queue.AddDefaulted_GetRef();
+	Pending.Step = Spawn.Enemy.IsValid() ? EStep::Activate : EStep::Construct;
+	Pending.Spawn = MoveTemp(Spawn);
+}
+
+void UCombatSpawnQueueSubsystem::CancelSpawns(const UObject* Requester, TArray<ACombatEnemy*>& OutEnemies)
+{
+	Queue.RemoveAll([Requester, &OutEnemies](const FPendingSpawn& Pending)
+	{
+		if (Pending.Spawn.Requester.Get() != Requester)
+		{
+			return false;
+		}
+
+		if (ACombatEnemy* Enemy = Pending.Spawn.Enemy.Get())
+		{
+			// constructed but never finished: not a usable actor yet
+			if (Pending.Step == EStep::Initialize)
+			{
+				Enemy->Destroy();
+			}
+			else
+			{
+				OutEnemies.Add(Enemy);
+			}
+		}
+
+		return true;
+	});
+}
+
+void UCombatSpawnQueueSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ProcessQueue();
+}
+
+bool UCombatSpawnQueueSubsystem::IsTickable() const
+{
+	return Queue.Num() > 0;
+}
+
+TStatId UCombatSpawnQueueSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatSpawnQueueSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatSpawnQueueSubsystem::ProcessQueue(bool bIgnoreBudget)
+{
+	COMBAT_TRACE_SCOPE(CombatSpawnQueue_Process);
+
+	NumStepsLastFrame = 0;
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	double SpentMs = 0.0;
+
+	while (Queue.Num() > 0)
+	{
+		FPendingSpawn& Pending = Queue[0];
+		const int32 StepIndex = static_cast<int32>(Pending.Step);
+
+		// the first step always runs so a tight budget can't stall the queue
+		if (!bIgnoreBudget && NumStepsLastFrame > 0 && SpentMs + AverageStepMs[StepIndex] > FrameBudgetMs)
+		{
+			break;
+		}
+
+		const uint64 StepStartCycles = FPlatformTime::Cycles64();
+		const bool bDone = RunStep(Pending);
+		const float StepMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StepStartCycles));
+
+		AverageStepMs[StepIndex] = AverageStepMs[StepIndex] > 0.0f ? FMath::Lerp(AverageStepMs[StepIndex], StepMs, 0.25f) : StepMs;
+		SpentMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+		++NumStepsLastFrame;
+
+		if (bDone)
+		{
+			// the callback may have queued more spawns, so don't hold on to Pending
+			FCombatQueuedSpawn Finished = MoveTemp(Queue[0].Spawn);
+			Queue.RemoveAt(0, EAllowShrinking::No);
+			Finished.OnSpawned.ExecuteIfBound(Finished.Enemy.Get());
+		}
+	}
+
+	CSV_CUSTOM_STAT(KatanaCombat, SpawnQueueLength, Queue.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(KatanaCombat, SpawnQueueMs, SpentMs, ECsvCustomStatOp::Set);
+}
+
+bool UCombatSpawnQueueSubsystem::RunStep(FPendingSpawn& Pending)
+{
+	FCombatQueuedSpawn& Spawn = Pending.Spawn;
+
+	// whatever we were building or reactivating is gone: drop the spawn
+	if (Pending.Step != EStep::Construct && !Spawn.Enemy.IsValid())
+	{
+		return true;
+	}
+
+	switch (Pending.Step)
+	{
+		case EStep::Construct:
+		{
+			UClass* Class = Spawn.EnemyClass.Get();
+			ACombatEnemy* Enemy = Class ? GetWorld()->SpawnActorDeferred<ACombatEnemy>(Class, Spawn.SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn) : nullptr;
+			if (!Enemy)
+			{
+				return true;
+			}
+
+			// the controller comes in the activate step, so the StateTree never runs on a half built enemy
+			Enemy->AutoPossessAI = EAutoPossessAI::Disabled;
+			Spawn.Enemy = Enemy;
+			Pending.Step = EStep::Initialize;
+			return false;
+		}
+
+		case EStep::Initialize:
+		{
+			ACombatEnemy* Enemy = Spawn.Enemy.Get();
+			Enemy->FinishSpawning(Spawn.SpawnTransform);
+			Enemy->AutoPossessAI = GetDefault<ACombatEnemy>(Enemy->GetClass())->AutoPossessAI;
+
+			// park it until it's activated
+			Enemy->DeactivateForPool();
+			Pending.Step = Spawn.bPrewarmAnimation ? EStep::WarmAnimation : EStep::Activate;
+			return !Spawn.bActivate && !Spawn.bPrewarmAnimation;
+		}
+
+		case EStep::WarmAnimation:
+		{
+			Spawn.Enemy->PrewarmAnimation();
+			Pending.Step = EStep::Activate;
+			return !Spawn.bActivate;
+		}
+
+		case EStep::Activate:
+		{
+			ACombatEnemy* Enemy = Spawn.Enemy.Get();
+			Enemy->ActivateFromPool(Spawn.SpawnTransform);
+
+			// new enemies: possessing starts the StateTree, now that HP and state are set
+			if (!Enemy->GetController())
+			{
+				Enemy->SpawnDefaultController();
+			}
+			return true;
+		}
+
+		default:
+			return true;
+	}
+}
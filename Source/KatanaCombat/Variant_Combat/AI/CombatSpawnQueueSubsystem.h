@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatSpawnQueueSubsystem.generated.h"
+
+class ACombatEnemy;
+
+/** Called once a queued enemy is ready: active and thinking, or parked for a pool */
+DECLARE_DELEGATE_OneParam(FOnQueuedEnemySpawned, ACombatEnemy* /*Enemy*/);
+
+/**
+ *  One enemy to bring into the world through UCombatSpawnQueueSubsystem
+ */
+struct FCombatQueuedSpawn
+{
+	/** Whoever asked for the spawn, for CancelSpawns */
+	TWeakObjectPtr<UObject> Requester;
+
+	/** Class to construct (ignored if Enemy is set) */
+	TWeakObjectPtr<UClass> EnemyClass;
+
+	/** Pooled enemy to reactivate instead of constructing one */
+	TWeakObjectPtr<ACombatEnemy> Enemy;
+
+	FTransform SpawnTransform;
+
+	/** If true, newly constructed enemies also initialize their animation and pre-touch their attack montages */
+	bool bPrewarmAnimation = false;
+
+	/** If false, the enemy is handed over parked (hidden, no controller), e.g. to fill a pool */
+	bool bActivate = true;
+
+	FOnQueuedEnemySpawned OnSpawned;
+};
+
+/**
+ *  Time-sliced enemy spawning
+ *  Constructing an enemy (SpawnActor, component registration, BeginPlay, AI controller and StateTree start)
+ *  costs several milliseconds, and wave transitions or death refills used to stack them in one frame.
+ *  Spawns queued here are split into steps - construct, initialize, warm up animation, activate - and run
+ *  oldest first, as many steps per frame as fit in FrameBudgetMs (the first step of a frame always runs so
+ *  the queue keeps moving). A step whose average cost would overrun what's left of the budget waits a frame.
+ *  New enemies stay hidden and collisionless with no controller until the activate step, so nothing half
+ *  built is ever visible or thinking; pooled enemies skip straight to it
+ */
+UCLASS()
+class UCombatSpawnQueueSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Adds a spawn to the back of the queue */
+	void QueueSpawn(FCombatQueuedSpawn&& Spawn);
+
+	/**
+	 *  Drops every queued spawn of the requester
+	 *  @param OutEnemies	Receives the enemies the cancelled spawns already hold (pooled or built, parked) - unfinished constructions are destroyed
+	 */
+	void CancelSpawns(const UObject* Requester, TArray<ACombatEnemy*>& OutEnemies);
+
+	/** Runs queued steps within the frame budget (what Tick does). Ignoring the budget finishes every spawn now */
+	void ProcessQueue(bool bIgnoreBudget = false);
+
+	/** Returns the number of spawns waiting or in progress */
+	int32 GetNumQueued() const { return Queue.Num(); }
+
+	/** Returns the number of steps run in the last update */
+	int32 GetNumStepsLastFrame() const { return NumStepsLastFrame; }
+
+	/** Game thread milliseconds per frame spent on spawn steps */
+	float FrameBudgetMs = 1.0f;
+
+	// ~begin UTickableWorldSubsystem interface
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// ~end UTickableWorldSubsystem interface
+
+protected:
+
+	/** Next step of a queued spawn */
+	enum class EStep : uint8
+	{
+		/** Deferred SpawnActor: construction and default subobjects */
+		Construct,
+
+		/** FinishSpawning: component registration and BeginPlay, then parked */
+		Initialize,
+
+		/** Anim instance and attack montage first use */
+		WarmAnimation,
+
+		/** Shown, collision and movement on, AI controller possesses and starts the StateTree */
+		Activate,
+
+		Count
+	};
+
+	struct FPendingSpawn
+	{
+		FCombatQueuedSpawn Spawn;
+		EStep Step = EStep::Construct;
+	};
+
+	/** Runs the next step of the spawn at the front of the queue. Returns true once it's done (or failed) */
+	bool RunStep(FPendingSpawn& Pending);
+
+	/** Spawns waiting or in progress, oldest first */
+	TArray<FPendingSpawn> Queue;
+
+	/** Smoothed cost of each step (ms), used to decide whether it fits what's left of the budget */
+	float AverageStepMs[static_cast<int32>(EStep::Count)] = {};
+
+	int32 NumStepsLastFrame = 0;
+};
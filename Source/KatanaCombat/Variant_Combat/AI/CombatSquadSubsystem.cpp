@@ -0,0 +1,232 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatSquadSubsystem.h"
+#include "Core/CombatNetDormancySubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "NavigationSystem.h"
+
+void UCombatSquadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UCombatJobSchedulerSubsystem* Scheduler = Collection.InitializeDependency<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->RegisterJob<&UCombatSquadSubsystem::UpdateSlotsJob>(SlotJob, this, SlotUpdateInterval, ECombatJobPriority::High, TEXT("Squads.UpdateSlots"));
+	}
+}
+
+void UCombatSquadSubsystem::Deinitialize()
+{
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->UnregisterJob(SlotJob);
+	}
+
+	Squads.Empty();
+	MemberSquads.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UCombatSquadSubsystem::JoinSquad(AActor* Member, AActor* Target)
+{
+	if (!Member || !Target || Member == Target)
+	{
+		return false;
+	}
+
+	// already in this squad?
+	if (const FObjectKey* SquadTarget = MemberSquads.Find(Member))
+	{
+		if (*SquadTarget == FObjectKey(Target))
+		{
+			return true;
+		}
+	}
+
+	// only one squad per member
+	LeaveSquad(Member);
+
+	FSquad& Squad = Squads.FindOrAdd(Target);
+	Squad.Target = Target;
+	Squad.Members.AddDefaulted_GetRef().Actor = Member;
+	MemberSquads.Add(Member, Target);
+
+	// the squad is activating: the member replicates from now on
+	UCombatNetDormancySubsystem::WakeActorFor(Member);
+
+	// give the newcomer a slot on the next scheduler update instead of waiting out the interval
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->MarkJobDue(SlotJob);
+	}
+
+	return true;
+}
+
+void UCombatSquadSubsystem::LeaveSquad(const AActor* Member)
+{
+	FObjectKey SquadTarget;
+	if (!MemberSquads.RemoveAndCopyValue(Member, SquadTarget))
+	{
+		return;
+	}
+
+	if (FSquad* Squad = Squads.Find(SquadTarget))
+	{
+		Squad->Members.RemoveAll([Member](const FSquadMember& SquadMember) { return !SquadMember.Actor.IsValid() || SquadMember.Actor.Get() == Member; });
+		if (Squad->Members.Num() == 0)
+		{
+			Squads.Remove(SquadTarget);
+		}
+	}
+}
+
+bool UCombatSquadSubsystem::GetSlotLocation(const AActor* Member, FVector& OutLocation) const
+{
+	const FObjectKey* SquadTarget = Member ? MemberSquads.Find(Member) : nullptr;
+	const FSquad* Squad = SquadTarget ? Squads.Find(*SquadTarget) : nullptr;
+	if (!Squad)
+	{
+		return false;
+	}
+
+	for (const FSquadMember& SquadMember : Squad->Members)
+	{
+		if (SquadMember.Actor.Get() == Member && Squad->Slots.IsValidIndex(SquadMember.SlotIndex))
+		{
+			OutLocation = Squad->Slots[SquadMember.SlotIndex];
+			return true;
+		}
+	}
+
+	return false;
+}
+
+AActor* UCombatSquadSubsystem::GetSquadTarget(const AActor* Member) const
+{
+	const FObjectKey* SquadTarget = Member ? MemberSquads.Find(Member) : nullptr;
+	const FSquad* Squad = SquadTarget ? Squads.Find(*SquadTarget) : nullptr;
+	return Squad ? Squad->Target.Get() : nullptr;
+}
+
+int32 UCombatSquadSubsystem::GetNumSquadMembers(const AActor* Target) const
+{
+	const FSquad* Squad = Target ? Squads.Find(Target) : nullptr;
+	return Squad ? Squad->Members.Num() : 0;
+}
+
+void UCombatSquadSubsystem::UpdateSlotsJob(float DeltaTime)
+{
+	UpdateSlots();
+}
+
+void UCombatSquadSubsystem::UpdateSlots()
+{
+	for (auto It = Squads.CreateIterator(); It; ++It)
+	{
+		FSquad& Squad = It.Value();
+
+		// members destroyed without leaving
+		Squad.Members.RemoveAll([](const FSquadMember& SquadMember) { return !SquadMember.Actor.IsValid(); });
+
+		// drop squads whose target is gone, or that nobody is in any more
+		if (!Squad.Target.IsValid() || Squad.Members.Num() == 0)
+		{
+			for (const FSquadMember& SquadMember : Squad.Members)
+			{
+				MemberSquads.Remove(SquadMember.Actor.Get());
+			}
+
+			It.RemoveCurrent();
+			continue;
+		}
+
+		UpdateSquad(Squad);
+	}
+
+	// members destroyed without leaving, on squads that were removed above
+	for (auto It = MemberSquads.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr() || !Squads.Contains(It.Value()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UCombatSquadSubsystem::BuildRingSlots(const FVector& Center, float Radius, int32 NumSlots, TArray<FVector, TInlineAllocator<8>>& OutSlots)
+{
+	OutSlots.Reset(NumSlots);
+
+	for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+	{
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, UE_TWO_PI * SlotIndex / NumSlots);
+		OutSlots.Add(Center + FVector(Cos * Radius, Sin * Radius, 0.0f));
+	}
+}
+
+void UCombatSquadSubsystem::UpdateSquad(FSquad& Squad)
+{
+	++NumSlotPasses;
+
+	// lay out the ring; slot indices only keep their meaning while the ring size stays the same
+	const int32 NumSlots = FMath::Max(MinSlotsPerRing, Squad.Members.Num());
+	const bool bRingResized = Squad.Slots.Num() != NumSlots;
+	BuildRingSlots(Squad.Target->GetActorLocation(), SlotRadius, NumSlots, Squad.Slots);
+
+	if (bProjectSlotsToNavigation)
+	{
+		if (const UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+		{
+			const FVector QueryExtent(SlotRadius * 0.25f, SlotRadius * 0.25f, 200.0f);
+			for (FVector& Slot : Squad.Slots)
+			{
+				FNavLocation NavLocation;
+				if (NavSystem->ProjectPointToNavigation(Slot, NavLocation, QueryExtent))
+				{
+					Slot = NavLocation.Location;
+				}
+			}
+		}
+	}
+
+	// keep the slots members already hold
+	TBitArray<TInlineAllocator<1>> TakenSlots(false, NumSlots);
+	for (FSquadMember& SquadMember : Squad.Members)
+	{
+		if (bRingResized || !TakenSlots.IsValidIndex(SquadMember.SlotIndex) || TakenSlots[SquadMember.SlotIndex])
+		{
+			SquadMember.SlotIndex = INDEX_NONE;
+			continue;
+		}
+
+		TakenSlots[SquadMember.SlotIndex] = true;
+	}
+
+	// everyone else takes the nearest free slot
+	for (FSquadMember& SquadMember : Squad.Members)
+	{
+		if (SquadMember.SlotIndex != INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FVector MemberLocation = SquadMember.Actor->GetActorLocation();
+		double BestDistanceSq = TNumericLimits<double>::Max();
+		for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+		{
+			const double DistanceSq = FVector::DistSquared(MemberLocation, Squad.Slots[SlotIndex]);
+			if (!TakenSlots[SlotIndex] && DistanceSq < BestDistanceSq)
+			{
+				BestDistanceSq = DistanceSq;
+				SquadMember.SlotIndex = SlotIndex;
+			}
+		}
+
+		TakenSlots[SquadMember.SlotIndex] = true;
+	}
+}
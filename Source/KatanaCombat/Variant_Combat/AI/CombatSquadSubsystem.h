@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "CombatSquadSubsystem.generated.h"
+
+/**
+ *  Squad positioning coordinator for AI
+ *  Enemies fighting the same target form a squad. A scheduled job lays out one ring of surround slots
+ *  around each squad's target every SlotUpdateInterval and hands them out to the members, so positioning
+ *  costs one slot pass per squad instead of one EQS query per enemy
+ *  Slots are sticky: members keep theirs between passes, and only newcomers (or everyone, when the ring
+ *  changes size) are assigned, each to the nearest free slot
+ */
+UCLASS()
+class UCombatSquadSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Adds the member to the squad fighting the target, leaving any other squad. Returns true if the member is in the squad */
+	bool JoinSquad(AActor* Member, AActor* Target);
+
+	/** Removes the member from its squad */
+	void LeaveSquad(const AActor* Member);
+
+	/** Returns true and the member's slot if it has been given one */
+	bool GetSlotLocation(const AActor* Member, FVector& OutLocation) const;
+
+	/** Returns the target of the member's squad, or nullptr if it isn't in one */
+	AActor* GetSquadTarget(const AActor* Member) const;
+
+	/** Returns the number of members in the squad fighting the target */
+	int32 GetNumSquadMembers(const AActor* Target) const;
+
+	/** Returns the number of squads */
+	int32 GetNumSquads() const { return Squads.Num(); }
+
+	/** Returns the number of squad slot passes run so far */
+	int32 GetNumSlotPasses() const { return NumSlotPasses; }
+
+	/** Lays out and assigns the slots of every squad now (normally done by the scheduled job) */
+	void UpdateSlots();
+
+	/** Evenly spaced slots on a ring around the center. Slot 0 points along +X so the ring doesn't turn between passes */
+	static void BuildRingSlots(const FVector& Center, float Radius, int32 NumSlots, TArray<FVector, TInlineAllocator<8>>& OutSlots);
+
+	/** Distance from the target to its ring of slots */
+	float SlotRadius = 250.0f;
+
+	/** Fewest slots on a ring, so small squads still spread out around the target */
+	int32 MinSlotsPerRing = 6;
+
+	/** Time between slot passes */
+	float SlotUpdateInterval = 0.5f;
+
+	/** If true, slots are moved onto the navmesh (slots with no navmesh nearby keep their ring location) */
+	bool bProjectSlotsToNavigation = true;
+
+	// ~begin UWorldSubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// ~end UWorldSubsystem interface
+
+protected:
+
+	/** A squad member and the slot it was given */
+	struct FSquadMember
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		/** Index into the squad's slots, or INDEX_NONE until the next pass */
+		int32 SlotIndex = INDEX_NONE;
+	};
+
+	/** Everyone fighting one target */
+	struct FSquad
+	{
+		TWeakObjectPtr<AActor> Target;
+		TArray<FSquadMember, TInlineAllocator<8>> Members;
+		TArray<FVector, TInlineAllocator<8>> Slots;
+	};
+
+	/** Scheduled job: one slot pass per squad */
+	void UpdateSlotsJob(float DeltaTime);
+
+	/** Lays out the ring around the squad's target and gives every member a slot */
+	void UpdateSquad(FSquad& Squad);
+
+	/** Slot pass job on the combat job scheduler */
+	FCombatJobHandle SlotJob;
+
+	/** Squads, by target */
+	TMap<FObjectKey, FSquad> Squads;
+
+	/** Target of the squad each member is in */
+	TMap<FObjectKey, FObjectKey> MemberSquads;
+
+	/** Slot passes run so far */
+	int32 NumSlotPasses = 0;
+};
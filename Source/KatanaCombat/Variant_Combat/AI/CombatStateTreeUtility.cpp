@@ -8,8 +8,91 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "AIController.h"
 #include "CombatEnemy.h"
-#include "Kismet/GameplayStatics.h"
 #include "StateTreeAsyncExecutionContext.h"
+#include "CombatPlayerInfoSubsystem.h"
+#include "CombatAttackTokenSubsystem.h"
+#include "CombatSquadSubsystem.h"
+#include "CombatFacingSubsystem.h"
+#include "Characters/SamuraiCharacter.h"
+#include "Core/CombatComponent.h"
+#include "Core/CombatComponentV2.h"
+#include "Core/CombatRegistrySubsystem.h"
+#include "Core/CombatStateTransitions.h"
+#include "Interfaces/CombatInterface.h"
+#include "ActionQueueTypes.h"
+
+namespace CombatStateTree
+{
+	/** Acquires an attack token for the attacker if it needs one. Returns false if the attack shouldn't start */
+	bool AcquireAttackToken(AActor* Attacker, AActor* Target, bool bRequireToken)
+	{
+		if (!bRequireToken)
+		{
+			return true;
+		}
+
+		UCombatAttackTokenSubsystem* TokenSubsystem = Attacker->GetWorld()->GetSubsystem<UCombatAttackTokenSubsystem>();
+		if (!TokenSubsystem)
+		{
+			return true;
+		}
+
+		return TokenSubsystem->TryAcquireToken(Attacker, TokenSubsystem->ResolveTarget(Target));
+	}
+
+	/** Acquires an attack token for the attack task if it needs one. Returns false if the attack shouldn't start */
+	bool AcquireAttackToken(const FStateTreeAttackInstanceData& InstanceData)
+	{
+		return AcquireAttackToken(InstanceData.Character, InstanceData.AttackTarget, InstanceData.bRequireAttackToken);
+	}
+
+	/** Releases the attacker's token, if any */
+	void ReleaseAttackToken(AActor* Attacker)
+	{
+		if (UCombatAttackTokenSubsystem* TokenSubsystem = Attacker->GetWorld()->GetSubsystem<UCombatAttackTokenSubsystem>())
+		{
+			TokenSubsystem->ReleaseToken(Attacker);
+		}
+	}
+
+	/** Releases the attack task's token, if any */
+	void ReleaseAttackToken(const FStateTreeAttackInstanceData& InstanceData)
+	{
+		ReleaseAttackToken(InstanceData.Character);
+	}
+
+	/** Picks the samurai attack task's input from the V2 combo graph. Returns false if no move qualifies */
+	bool SelectComboGraphMove(FStateTreeSamuraiAttackInstanceData& InstanceData)
+	{
+		const UCombatComponentV2* CombatComponentV2 = InstanceData.Character->CombatComponentV2;
+		if (!CombatComponentV2)
+		{
+			return false;
+		}
+
+		// same target the token was taken on
+		AActor* Target = InstanceData.AttackTarget;
+		if (!Target)
+		{
+			if (UCombatAttackTokenSubsystem* TokenSubsystem = InstanceData.Character->GetWorld()->GetSubsystem<UCombatAttackTokenSubsystem>())
+			{
+				Target = TokenSubsystem->ResolveTarget(nullptr);
+			}
+		}
+
+		const float TargetDistance = Target ? InstanceData.Character->GetDistanceTo(Target) : -1.0f;
+
+		FComboMoveChoice Choice;
+		if (!CombatComponentV2->SelectAIMove(TargetDistance, InstanceData.MoveWeights, Choice))
+		{
+			return false;
+		}
+
+		InstanceData.PressedInputType = Choice.InputType;
+		InstanceData.PressedDirection = CombatHelpers::AttackToInputDirection(Choice.Direction);
+		return true;
+	}
+}
 
 bool FStateTreeCharacterGroundedCondition::TestCondition(FStateTreeExecutionContext& Context) const
 {
@@ -30,6 +113,52 @@ FText FStateTreeCharacterGroundedCondition::GetDescription(const FGuid& ID, FSta
 
 ////////////////////////////////////////////////////////////////////
 
+bool FStateTreeAttackTokenAvailableCondition::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// without a token manager, everyone may attack
+	UCombatAttackTokenSubsystem* TokenSubsystem = InstanceData.Character->GetWorld()->GetSubsystem<UCombatAttackTokenSubsystem>();
+	if (!TokenSubsystem)
+	{
+		return true;
+	}
+
+	return TokenSubsystem->CanAcquireToken(InstanceData.Character, TokenSubsystem->ResolveTarget(InstanceData.AttackTarget));
+}
+
+#if WITH_EDITOR
+FText FStateTreeAttackTokenAvailableCondition::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Attack Token Available</b>");
+}
+#endif // WITH_EDITOR
+
+////////////////////////////////////////////////////////////////////
+
+bool FStateTreeCombatStateTransitionCondition::TestCondition(FStateTreeExecutionContext& Context) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// no combat component means no combat state to enter
+	const UCombatComponent* Combat = InstanceData.Character ? InstanceData.Character->CombatComponent.Get() : nullptr;
+	if (!Combat)
+	{
+		return false;
+	}
+
+	return CombatStateTransitions::CanTransition(Combat->GetCombatState(), InstanceData.TargetState);
+}
+
+#if WITH_EDITOR
+FText FStateTreeCombatStateTransitionCondition::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Can Enter Combat State</b>");
+}
+#endif // WITH_EDITOR
+
+////////////////////////////////////////////////////////////////////
+
 EStateTreeRunStatus FStateTreeComboAttackTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
 	// have we transitioned from another state?
@@ -38,6 +167,12 @@ EStateTreeRunStatus FStateTreeComboAttackTask::EnterState(FStateTreeExecutionCon
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
+		// wait our turn if too many others are attacking the same target
+		if (!CombatStateTree::AcquireAttackToken(InstanceData))
+		{
+			return EStateTreeRunStatus::Failed;
+		}
+
 		// bind to the on attack completed delegate
 		InstanceData.Character->OnAttackCompleted.BindLambda(
 			[WeakContext = Context.MakeWeakExecutionContext()]()
@@ -64,6 +199,9 @@ void FStateTreeComboAttackTask::ExitState(FStateTreeExecutionContext& Context, c
 
 		// unbind the on attack completed delegate
 		InstanceData.Character->OnAttackCompleted.Unbind();
+
+		// let the next attacker in
+		CombatStateTree::ReleaseAttackToken(InstanceData);
 	}
 }
 
@@ -84,6 +222,12 @@ EStateTreeRunStatus FStateTreeChargedAttackTask::EnterState(FStateTreeExecutionC
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
+		// wait our turn if too many others are attacking the same target
+		if (!CombatStateTree::AcquireAttackToken(InstanceData))
+		{
+			return EStateTreeRunStatus::Failed;
+		}
+
 		// bind to the on attack completed delegate
 		InstanceData.Character->OnAttackCompleted.BindLambda(
 			[WeakContext = Context.MakeWeakExecutionContext()]()
@@ -109,6 +253,9 @@ void FStateTreeChargedAttackTask::ExitState(FStateTreeExecutionContext& Context,
 
 		// unbind the on attack completed delegate
 		InstanceData.Character->OnAttackCompleted.Unbind();
+
+		// let the next attacker in
+		CombatStateTree::ReleaseAttackToken(InstanceData);
 	}
 }
 
@@ -121,6 +268,108 @@ FText FStateTreeChargedAttackTask::GetDescription(const FGuid& ID, FStateTreeDat
 
 ////////////////////////////////////////////////////////////////////
 
+EStateTreeRunStatus FStateTreeSamuraiAttackTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// have we transitioned from another state?
+	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
+	{
+		// get the instance data
+		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+		// wait our turn if too many others are attacking the same target
+		if (!CombatStateTree::AcquireAttackToken(InstanceData.Character, InstanceData.AttackTarget, InstanceData.bRequireAttackToken))
+		{
+			return EStateTreeRunStatus::Failed;
+		}
+
+		InstanceData.PressedInputType = InstanceData.InputType;
+		InstanceData.PressedDirection = InstanceData.Direction;
+
+		// pick the move from the combo graph's cooked metadata
+		if (InstanceData.bSelectFromComboGraph)
+		{
+			if (!CombatStateTree::SelectComboGraphMove(InstanceData))
+			{
+				CombatStateTree::ReleaseAttackToken(InstanceData.Character);
+				return EStateTreeRunStatus::Failed;
+			}
+		}
+
+		InstanceData.ElapsedTime = 0.0f;
+		InstanceData.bReleased = false;
+		InstanceData.bAttackStarted = false;
+
+		// press the input the same way the player would. The combat component decides what it becomes
+		InstanceData.Character->SubmitCombatInput(InstanceData.PressedInputType, EInputEventType::Press, InstanceData.PressedDirection);
+	}
+
+	return EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FStateTreeSamuraiAttackTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	InstanceData.ElapsedTime += DeltaTime;
+
+	// let go of the input once we've held it long enough
+	if (!InstanceData.bReleased && InstanceData.ElapsedTime >= InstanceData.HoldTime)
+	{
+		InstanceData.Character->SubmitCombatInput(InstanceData.PressedInputType, EInputEventType::Release, InstanceData.PressedDirection);
+		InstanceData.bReleased = true;
+	}
+
+	// succeed once the attack has started and played out
+	const FCombatQuerySnapshot* CombatQuery = InstanceData.Character->GetCombatQuerySnapshot();
+	const bool bAttacking = CombatQuery ? CombatQuery->bIsAttacking : ICombatInterface::Execute_IsAttacking(InstanceData.Character);
+	if (bAttacking)
+	{
+		InstanceData.bAttackStarted = true;
+	}
+	else if (InstanceData.bAttackStarted && InstanceData.bReleased)
+	{
+		return EStateTreeRunStatus::Succeeded;
+	}
+
+	// the input was rejected or the attack got stuck
+	if (InstanceData.ElapsedTime >= InstanceData.MaxDuration)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	return EStateTreeRunStatus::Running;
+}
+
+void FStateTreeSamuraiAttackTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// have we transitioned from another state?
+	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
+	{
+		// get the instance data
+		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+		// don't leave the input held if we were interrupted mid-hold
+		if (!InstanceData.bReleased)
+		{
+			InstanceData.Character->SubmitCombatInput(InstanceData.PressedInputType, EInputEventType::Release, InstanceData.PressedDirection);
+			InstanceData.bReleased = true;
+		}
+
+		// let the next attacker in
+		CombatStateTree::ReleaseAttackToken(InstanceData.Character);
+	}
+}
+
+#if WITH_EDITOR
+FText FStateTreeSamuraiAttackTask::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Do Samurai Attack</b>");
+}
+#endif // WITH_EDITOR
+
+////////////////////////////////////////////////////////////////////
+
 EStateTreeRunStatus FStateTreeWaitForLandingTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
 	// have we transitioned from another state?
@@ -171,8 +420,17 @@ EStateTreeRunStatus FStateTreeFaceActorTask::EnterState(FStateTreeExecutionConte
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-		// set the AI Controller's focus
-		InstanceData.Controller->SetFocus(InstanceData.ActorToFaceTowards);
+		// hand facing to the shared facing subsystem if requested
+		UCombatFacingSubsystem* FacingSubsystem = InstanceData.Controller->GetWorld()->GetSubsystem<UCombatFacingSubsystem>();
+		if (InstanceData.bUseMovementRotation && FacingSubsystem)
+		{
+			FacingSubsystem->StartFacingActor(InstanceData.Controller, InstanceData.ActorToFaceTowards);
+		}
+		else
+		{
+			// set the AI Controller's focus
+			InstanceData.Controller->SetFocus(InstanceData.ActorToFaceTowards);
+		}
 	}
 
 	return EStateTreeRunStatus::Running;
@@ -186,6 +444,12 @@ void FStateTreeFaceActorTask::ExitState(FStateTreeExecutionContext& Context, con
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
+		// stop any batched facing
+		if (UCombatFacingSubsystem* FacingSubsystem = InstanceData.Controller->GetWorld()->GetSubsystem<UCombatFacingSubsystem>())
+		{
+			FacingSubsystem->StopFacing(InstanceData.Controller);
+		}
+
 		// clear the AI Controller's focus
 		InstanceData.Controller->ClearFocus(EAIFocusPriority::Gameplay);
 	}
@@ -208,8 +472,17 @@ EStateTreeRunStatus FStateTreeFaceLocationTask::EnterState(FStateTreeExecutionCo
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-		// set the AI Controller's focus
-		InstanceData.Controller->SetFocalPoint(InstanceData.FaceLocation);
+		// hand facing to the shared facing subsystem if requested
+		UCombatFacingSubsystem* FacingSubsystem = InstanceData.Controller->GetWorld()->GetSubsystem<UCombatFacingSubsystem>();
+		if (InstanceData.bUseMovementRotation && FacingSubsystem)
+		{
+			FacingSubsystem->StartFacingLocation(InstanceData.Controller, InstanceData.FaceLocation);
+		}
+		else
+		{
+			// set the AI Controller's focus
+			InstanceData.Controller->SetFocalPoint(InstanceData.FaceLocation);
+		}
 	}
 
 	return EStateTreeRunStatus::Running;
@@ -223,6 +496,12 @@ void FStateTreeFaceLocationTask::ExitState(FStateTreeExecutionContext& Context,
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
+		// stop any batched facing
+		if (UCombatFacingSubsystem* FacingSubsystem = InstanceData.Controller->GetWorld()->GetSubsystem<UCombatFacingSubsystem>())
+		{
+			FacingSubsystem->StopFacing(InstanceData.Controller);
+		}
+
 		// clear the AI Controller's focus
 		InstanceData.Controller->ClearFocus(EAIFocusPriority::Gameplay);
 	}
@@ -266,14 +545,32 @@ EStateTreeRunStatus FStateTreeGetPlayerInfoTask::Tick(FStateTreeExecutionContext
 	// get the instance data
 	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-	// get the character possessed by the first local player
-	InstanceData.TargetPlayerCharacter = Cast<ACharacter>(UGameplayStatics::GetPlayerPawn(InstanceData.Character, 0));
+	// throttle updates if requested
+	InstanceData.TimeUntilUpdate -= DeltaTime;
+	if (InstanceData.TimeUntilUpdate > 0.0f)
+	{
+		return EStateTreeRunStatus::Running;
+	}
+
+	InstanceData.TimeUntilUpdate = InstanceData.TickInterval;
+
+	// get the shared info for the first local player
+	UCombatPlayerInfoSubsystem* PlayerInfoSubsystem = InstanceData.Character->GetWorld()->GetSubsystem<UCombatPlayerInfoSubsystem>();
+	const FCombatPlayerInfo* PlayerInfo = PlayerInfoSubsystem ? PlayerInfoSubsystem->GetPlayerInfo(0) : nullptr;
+
+	InstanceData.TargetPlayerCharacter = PlayerInfo ? Cast<ACharacter>(PlayerInfo->Pawn.Get()) : nullptr;
 
 	// do we have a valid target?
 	if (InstanceData.TargetPlayerCharacter)
 	{
-		// update the last known location
-		InstanceData.TargetPlayerLocation = InstanceData.TargetPlayerCharacter->GetActorLocation();
+		// update the last known state
+		InstanceData.TargetPlayerLocation = PlayerInfo->Location;
+		InstanceData.TargetPlayerVelocity = PlayerInfo->Velocity;
+		InstanceData.bTargetIsAttacking = PlayerInfo->bIsAttacking;
+
+		// who the player is swinging at comes from the combat registry
+		UCombatRegistrySubsystem* Registry = InstanceData.Character->GetWorld()->GetSubsystem<UCombatRegistrySubsystem>();
+		InstanceData.bTargetIsAttackingMe = Registry && Registry->IsAttacking(InstanceData.TargetPlayerCharacter, InstanceData.Character);
 	}
 
 	// update the distance
@@ -287,4 +584,92 @@ FText FStateTreeGetPlayerInfoTask::GetDescription(const FGuid& ID, FStateTreeDat
 {
 	return FText::FromString("<b>Get Player Info</b>");
 }
+#endif // WITH_EDITOR
+
+////////////////////////////////////////////////////////////////////
+
+EStateTreeRunStatus FStateTreeGetSquadSlotTask::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// have we transitioned from another state?
+	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
+	{
+		// get the instance data
+		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+		UWorld* World = InstanceData.Character->GetWorld();
+		UCombatSquadSubsystem* SquadSubsystem = World->GetSubsystem<UCombatSquadSubsystem>();
+		if (!SquadSubsystem)
+		{
+			return EStateTreeRunStatus::Failed;
+		}
+
+		// fall back to the first local player if no target was bound
+		AActor* Target = InstanceData.Target;
+		if (!Target)
+		{
+			if (const UCombatAttackTokenSubsystem* TokenSubsystem = World->GetSubsystem<UCombatAttackTokenSubsystem>())
+			{
+				Target = TokenSubsystem->ResolveTarget(nullptr);
+			}
+		}
+
+		// join the squad surrounding the target
+		if (!SquadSubsystem->JoinSquad(InstanceData.Character, Target))
+		{
+			return EStateTreeRunStatus::Failed;
+		}
+
+		InstanceData.SlotLocation = Target->GetActorLocation();
+		InstanceData.bHasSlot = false;
+	}
+
+	return EStateTreeRunStatus::Running;
+}
+
+EStateTreeRunStatus FStateTreeGetSquadSlotTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	const UCombatSquadSubsystem* SquadSubsystem = InstanceData.Character->GetWorld()->GetSubsystem<UCombatSquadSubsystem>();
+	if (!SquadSubsystem)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	// read the slot we were given on the last squad pass
+	InstanceData.bHasSlot = SquadSubsystem->GetSlotLocation(InstanceData.Character, InstanceData.SlotLocation);
+
+	// the squad is dropped once its target is gone
+	if (!InstanceData.bHasSlot && !SquadSubsystem->GetSquadTarget(InstanceData.Character))
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	return EStateTreeRunStatus::Running;
+}
+
+void FStateTreeGetSquadSlotTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// have we transitioned from another state?
+	if (Transition.ChangeType == EStateTreeStateChangeType::Changed)
+	{
+		// get the instance data
+		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+		// give the slot back to the squad
+		if (UCombatSquadSubsystem* SquadSubsystem = InstanceData.Character->GetWorld()->GetSubsystem<UCombatSquadSubsystem>())
+		{
+			SquadSubsystem->LeaveSquad(InstanceData.Character);
+		}
+
+		InstanceData.bHasSlot = false;
+	}
+}
+
+#if WITH_EDITOR
+FText FStateTreeGetSquadSlotTask::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Get Squad Slot</b>");
+}
 #endif // WITH_EDITOR
\ No newline at end of file
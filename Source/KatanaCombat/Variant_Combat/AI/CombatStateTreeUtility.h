@@ -5,12 +5,15 @@
 #include "CoreMinimal.h"
 #include "StateTreeTaskBase.h"
 #include "StateTreeConditionBase.h"
+#include "CombatTypes.h"
+#include "Data/CompiledComboGraph.h"
 
 #include "CombatStateTreeUtility.generated.h"
 
 class ACharacter;
 class AAIController;
 class ACombatEnemy;
+class ASamuraiCharacter;
 
 /**
  *  Instance data struct for the FStateTreeCharacterGroundedCondition condition
@@ -58,6 +61,100 @@ struct FStateTreeCharacterGroundedCondition : public FStateTreeConditionCommonBa
 
 ////////////////////////////////////////////////////////////////////
 
+/**
+ *  Instance data struct for the FStateTreeAttackTokenAvailableCondition condition
+ */
+USTRUCT()
+struct FStateTreeAttackTokenAvailableConditionInstanceData
+{
+	GENERATED_BODY()
+
+	/** Character that wants to attack */
+	UPROPERTY(EditAnywhere, Category = "Context")
+	ACharacter* Character;
+
+	/** Target of the attack. Defaults to the first local player if not bound */
+	UPROPERTY(EditAnywhere, Category = "Input", meta = (Optional))
+	AActor* AttackTarget = nullptr;
+};
+STATETREE_POD_INSTANCEDATA(FStateTreeAttackTokenAvailableConditionInstanceData);
+
+/**
+ *  StateTree condition to check if the character can get an attack token on its target
+ *  Use it to gate attack states so only a few enemies commit at once (see UCombatAttackTokenSubsystem)
+ */
+USTRUCT(DisplayName = "Attack Token Available")
+struct FStateTreeAttackTokenAvailableCondition : public FStateTreeConditionCommonBase
+{
+	GENERATED_BODY()
+
+	/** Set the instance data type */
+	using FInstanceDataType = FStateTreeAttackTokenAvailableConditionInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Default constructor */
+	FStateTreeAttackTokenAvailableCondition() = default;
+
+	/** Tests the StateTree condition */
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+
+#if WITH_EDITOR
+
+	/** Provides the description string */
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif
+
+};
+
+////////////////////////////////////////////////////////////////////
+
+/**
+ *  Instance data struct for the FStateTreeCombatStateTransitionCondition condition
+ */
+USTRUCT()
+struct FStateTreeCombatStateTransitionConditionInstanceData
+{
+	GENERATED_BODY()
+
+	/** Samurai character whose combat state is checked */
+	UPROPERTY(EditAnywhere, Category = "Context")
+	TObjectPtr<ASamuraiCharacter> Character;
+
+	/** Combat state the character should be able to enter */
+	UPROPERTY(EditAnywhere, Category = "Condition")
+	ECombatState TargetState = ECombatState::Attacking;
+};
+STATETREE_POD_INSTANCEDATA(FStateTreeCombatStateTransitionConditionInstanceData);
+
+/**
+ *  StateTree condition to check if the character's combat state can go to the target state
+ *  Reads the same transition table as the combat component, so AI never commits to a state it will reject
+ */
+USTRUCT(DisplayName = "Can Enter Combat State")
+struct FStateTreeCombatStateTransitionCondition : public FStateTreeConditionCommonBase
+{
+	GENERATED_BODY()
+
+	/** Set the instance data type */
+	using FInstanceDataType = FStateTreeCombatStateTransitionConditionInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Default constructor */
+	FStateTreeCombatStateTransitionCondition() = default;
+
+	/** Tests the StateTree condition */
+	virtual bool TestCondition(FStateTreeExecutionContext& Context) const override;
+
+#if WITH_EDITOR
+
+	/** Provides the description string */
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif
+
+};
+
+////////////////////////////////////////////////////////////////////
+
 /**
  *  Instance data struct for the Combat StateTree tasks
  */
@@ -69,6 +166,14 @@ struct FStateTreeAttackInstanceData
 	/** Character that will perform the attack */
 	UPROPERTY(EditAnywhere, Category = Context)
 	TObjectPtr<ACombatEnemy> Character;
+
+	/** Target of the attack. Defaults to the first local player if not bound */
+	UPROPERTY(EditAnywhere, Category = Input, meta = (Optional))
+	TObjectPtr<AActor> AttackTarget;
+
+	/** If true, the attack only starts if an attack token can be acquired on the target, and fails otherwise */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	bool bRequireAttackToken = true;
 };
 
 /**
@@ -117,6 +222,94 @@ struct FStateTreeChargedAttackTask : public FStateTreeTaskCommonBase
 #endif // WITH_EDITOR
 };
 
+/**
+ *  Instance data struct for the FStateTreeSamuraiAttackTask task
+ */
+USTRUCT()
+struct FStateTreeSamuraiAttackInstanceData
+{
+	GENERATED_BODY()
+
+	/** Samurai character that will perform the attack */
+	UPROPERTY(EditAnywhere, Category = Context)
+	TObjectPtr<ASamuraiCharacter> Character;
+
+	/** Target of the attack. Defaults to the first local player if not bound */
+	UPROPERTY(EditAnywhere, Category = Input, meta = (Optional))
+	TObjectPtr<AActor> AttackTarget;
+
+	/** Combat input to press */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	EInputType InputType = EInputType::LightAttack;
+
+	/** Directional input sent with the press and release */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	EInputDirection Direction = EInputDirection::None;
+
+	/** How long to hold the input before releasing it. Holding drives charged/hold attacks */
+	UPROPERTY(EditAnywhere, Category = Parameter, meta = (ClampMin = 0, Units = "s"))
+	float HoldTime = 0.0f;
+
+	/** Fails the task if the attack hasn't finished after this long */
+	UPROPERTY(EditAnywhere, Category = Parameter, meta = (ClampMin = 0.1, Units = "s"))
+	float MaxDuration = 4.0f;
+
+	/** If true, the attack only starts if an attack token can be acquired on the target, and fails otherwise */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	bool bRequireAttackToken = true;
+
+	/** If true, the input is picked from the compiled combo graph by utility score instead of InputType and Direction. Fails if no move reaches the target */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	bool bSelectFromComboGraph = false;
+
+	/** Utility weights for combo graph move selection */
+	UPROPERTY(EditAnywhere, Category = Parameter, meta = (EditCondition = "bSelectFromComboGraph"))
+	FComboMoveUtilityWeights MoveWeights;
+
+	/** Input and direction this run of the task pressed */
+	EInputType PressedInputType = EInputType::None;
+	EInputDirection PressedDirection = EInputDirection::None;
+
+	/** Time since the input was pressed */
+	float ElapsedTime = 0.0f;
+
+	/** True once the input has been released */
+	bool bReleased = false;
+
+	/** True once the combat component has started the attack */
+	bool bAttackStarted = false;
+};
+
+/**
+ *  StateTree task to attack with an AI-controlled Samurai character
+ *  Presses the combat input through the same path as player input, so the attack runs
+ *  on the V2 action queue (or V1) and hits through the UWeaponComponent pipeline
+ *  With bSelectFromComboGraph the input is chosen from the V2 compiled combo graph's node metadata,
+ *  so the AI uses the whole moveset for one table-driven score per decision
+ */
+USTRUCT(meta=(DisplayName="Samurai Attack", Category="Combat"))
+struct FStateTreeSamuraiAttackTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	/* Ensure we're using the correct instance data struct */
+	using FInstanceDataType = FStateTreeSamuraiAttackInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Runs when the owning state is entered */
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+	/** Runs while the owning state is active */
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+
+	/** Runs when the owning state is ended */
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+#if WITH_EDITOR
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif // WITH_EDITOR
+};
+
 /**
  *  StateTree task to wait for the character to land
  */
@@ -157,10 +350,15 @@ struct FStateTreeFaceActorInstanceData
 	/** Actor that will be faced towards */
 	UPROPERTY(EditAnywhere, Category = Input)
 	TObjectPtr<AActor> ActorToFaceTowards;
+
+	/** If true, the pawn turns at its movement rotation rate and is re-aimed by UCombatFacingSubsystem instead of setting the controller's focus */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	bool bUseMovementRotation = false;
 };
 
 /**
  *  StateTree task to face an AI-Controlled Pawn towards an Actor
+ *  With bUseMovementRotation, facing is batched with other enemies instead of re-aimed every controller tick
  */
 USTRUCT(meta=(DisplayName="Face Towards Actor", Category="Combat"))
 struct FStateTreeFaceActorTask : public FStateTreeTaskCommonBase
@@ -199,10 +397,15 @@ struct FStateTreeFaceLocationInstanceData
 	/** Location that will be faced towards */
 	UPROPERTY(EditAnywhere, Category = Parameter)
 	FVector FaceLocation = FVector::ZeroVector;
+
+	/** If true, the pawn turns at its movement rotation rate through UCombatFacingSubsystem instead of setting the controller's focus */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	bool bUseMovementRotation = false;
 };
 
 /**
  *  StateTree task to face an AI-Controlled Pawn towards a world location
+ *  With bUseMovementRotation, the control rotation is set once and the movement component does the turning
  */
 USTRUCT(meta=(DisplayName="Face Towards Location", Category="Combat"))
 struct FStateTreeFaceLocationTask : public FStateTreeTaskCommonBase
@@ -288,10 +491,30 @@ struct FStateTreeGetPlayerInfoInstanceData
 	/** Distance to the target */
 	UPROPERTY(VisibleAnywhere)
 	float DistanceToTarget = 0.0f;
+
+	/** Last known velocity for the target */
+	UPROPERTY(VisibleAnywhere)
+	FVector TargetPlayerVelocity = FVector::ZeroVector;
+
+	/** If true, the target was attacking at last update */
+	UPROPERTY(VisibleAnywhere)
+	bool bTargetIsAttacking = false;
+
+	/** If true, the target was attacking this character (locked onto it) at last update */
+	UPROPERTY(VisibleAnywhere)
+	bool bTargetIsAttackingMe = false;
+
+	/** Time between updates. Zero updates every tick */
+	UPROPERTY(EditAnywhere, Category = Parameter, meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
+	float TickInterval = 0.0f;
+
+	/** Time left until the next update */
+	float TimeUntilUpdate = 0.0f;
 };
 
 /**
  *  StateTree task to get information about the player character
+ *  Reads from the world's UCombatPlayerInfoSubsystem so all enemies share one player lookup per frame
  */
 USTRUCT(meta=(DisplayName="GetPlayerInfo", Category="Combat"))
 struct FStateTreeGetPlayerInfoTask : public FStateTreeTaskCommonBase
@@ -305,6 +528,61 @@ struct FStateTreeGetPlayerInfoTask : public FStateTreeTaskCommonBase
 	/** Runs while the owning state is active */
 	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
 
+#if WITH_EDITOR
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif // WITH_EDITOR
+};
+
+////////////////////////////////////////////////////////////////////
+
+/**
+ *  Instance data struct for the Get Squad Slot task
+ */
+USTRUCT()
+struct FStateTreeGetSquadSlotInstanceData
+{
+	GENERATED_BODY()
+
+	/** Character that owns this task */
+	UPROPERTY(EditAnywhere, Category = Context)
+	TObjectPtr<ACharacter> Character;
+
+	/** Target the squad surrounds. Defaults to the first local player if not bound */
+	UPROPERTY(EditAnywhere, Category = Input, meta = (Optional))
+	TObjectPtr<AActor> Target;
+
+	/** Slot given to the character, or the target's location until it has one */
+	UPROPERTY(EditAnywhere, Category = Output)
+	FVector SlotLocation = FVector::ZeroVector;
+
+	/** If true, the character has been given a slot */
+	UPROPERTY(EditAnywhere, Category = Output)
+	bool bHasSlot = false;
+};
+
+/**
+ *  StateTree task to get a surround slot around the target
+ *  Joins the target's squad in UCombatSquadSubsystem on enter and leaves it on exit. Slots are laid out once per
+ *  squad on the subsystem's schedule, so use this instead of running a surround EQS query per enemy
+ */
+USTRUCT(meta=(DisplayName="Get Squad Slot", Category="Combat"))
+struct FStateTreeGetSquadSlotTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	/* Ensure we're using the correct instance data struct */
+	using FInstanceDataType = FStateTreeGetSquadSlotInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Runs when the owning state is entered */
+	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+	/** Runs while the owning state is active */
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+
+	/** Runs when the owning state is ended */
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
 #if WITH_EDITOR
 	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
 #endif // WITH_EDITOR
@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "EnvQueryContext_SquadSlot.h"
+#include "CombatSquadSubsystem.h"
+#include "EnvironmentQuery/EnvQueryTypes.h"
+#include "EnvironmentQuery/Items/EnvQueryItemType_Point.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+
+void UEnvQueryContext_SquadSlot::ProvideContext(FEnvQueryInstance& QueryInstance, FEnvQueryContextData& ContextData) const
+{
+	// squads are made of pawns, so look through controllers
+	const AActor* Querier = Cast<AActor>(QueryInstance.Owner.Get());
+	if (const AController* Controller = Cast<AController>(Querier))
+	{
+		Querier = Controller->GetPawn();
+	}
+
+	const UCombatSquadSubsystem* SquadSubsystem = Querier ? Querier->GetWorld()->GetSubsystem<UCombatSquadSubsystem>() : nullptr;
+	if (!SquadSubsystem)
+	{
+		return;
+	}
+
+	// use the slot if we have one, otherwise head for the squad's target
+	FVector SlotLocation;
+	if (SquadSubsystem->GetSlotLocation(Querier, SlotLocation))
+	{
+		UEnvQueryItemType_Point::SetContextHelper(ContextData, SlotLocation);
+	}
+	else if (const AActor* SquadTarget = SquadSubsystem->GetSquadTarget(Querier))
+	{
+		UEnvQueryItemType_Point::SetContextHelper(ContextData, SquadTarget->GetActorLocation());
+	}
+}
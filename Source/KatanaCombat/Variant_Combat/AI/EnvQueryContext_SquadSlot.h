@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnvironmentQuery/EnvQueryContext.h"
+#include "EnvQueryContext_SquadSlot.generated.h"
+
+/**
+ *  UEnvQueryContext_SquadSlot
+ *  EnvQuery Context that returns the querier's squad slot from UCombatSquadSubsystem
+ *  Falls back to the squad's target until a slot has been given out. Use it to score points
+ *  near the slot instead of generating a full surround query per enemy
+ */
+UCLASS()
+class UEnvQueryContext_SquadSlot : public UEnvQueryContext
+{
+	GENERATED_BODY()
+	
+public:
+
+	/** Provides the context locations or actors for this EnvQuery */
+	virtual void ProvideContext(FEnvQueryInstance& QueryInstance, FEnvQueryContextData& ContextData) const override;
+};
@@ -11,10 +11,14 @@
 #include "EnhancedInputSubsystems.h"
 #include "EnhancedInputComponent.h"
 #include "CombatLifeBar.h"
+#include "CombatLifeBarSubsystem.h"
+#include "Core/CombatUIEventSubsystem.h"
 #include "Engine/DamageEvents.h"
 #include "TimerManager.h"
 #include "Engine/LocalPlayer.h"
 #include "CombatPlayerController.h"
+#include "Core/WeaponTraceSubsystem.h"
+#include "Utilities/MontageUtilityLibrary.h"
 
 ACombatCharacter::ACombatCharacter()
 {
@@ -170,7 +174,7 @@ void ACombatCharacter::ResetHP()
 	CurrentHP = MaxHP;
 
 	// update the life bar
-	LifeBarWidget->SetLifePercentage(1.0f);
+	SetLifeBarPercentage(1.0f);
 }
 
 void ACombatCharacter::ComboAttack()
@@ -242,45 +246,56 @@ void ACombatCharacter::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupt
 
 void ACombatCharacter::DoAttackTrace(FName DamageSourceBone)
 {
-	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
+	FMeleeTraceRequest Request;
 
 	// start at the provided socket location, sweep forward
-	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
-	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
+	Request.Start = GetMesh()->GetSocketLocation(DamageSourceBone);
+	Request.End = Request.Start + (GetActorForwardVector() * MeleeTraceDistance);
+	Request.Radius = MeleeTraceRadius;
 
 	// check for pawn and world dynamic collision object types
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
-	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
-
-	// use a sphere shape for the sweep
-	FCollisionShape CollisionShape;
-	CollisionShape.SetSphere(MeleeTraceRadius);
+	Request.ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	Request.ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
 
 	// ignore self
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
+	Request.QueryParams.AddIgnoredActor(this);
 
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	// sweep through the shared batched trace pipeline. Hits are applied next frame
+	if (UWeaponTraceSubsystem* TraceSubsystem = GetWorld()->GetSubsystem<UWeaponTraceSubsystem>())
 	{
-		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
+		TraceSubsystem->QueueMeleeTrace(Request, FOnMeleeTraceHits::CreateUObject(this, &ACombatCharacter::ProcessAttackHits));
+	}
+}
+
+void ACombatCharacter::ProcessAttackHits(const TArray<FHitResult>& Hits)
+{
+	// iterate over each object hit
+	for (const FHitResult& CurrentHit : Hits)
+	{
+		AActor* HitActor = CurrentHit.GetActor();
+		if (!HitActor)
+		{
+			continue;
+		}
+
+		// only resolve the interface for actors we didn't just hit
+		if (HitActor != CachedHitActor.Get())
 		{
-			// check if we've hit a damageable actor
-			ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
+			CachedHitActor = HitActor;
+			CachedHitDamageable = Cast<ICombatDamageable>(HitActor);
+		}
 
-			if (Damageable)
-			{
-				// knock upwards and away from the impact normal
-				const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+		// check if we've hit a damageable actor
+		if (CachedHitDamageable)
+		{
+			// knock upwards and away from the impact normal
+			const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
 
-				// pass the damage event to the actor
-				Damageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
+			// pass the damage event to the actor
+			CachedHitDamageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
 
-				// call the BP handler to play effects, etc.
-				DealtDamage(MeleeDamage, CurrentHit.ImpactPoint);
-			}
+			// call the BP handler to play effects, etc.
+			DealtDamage(MeleeDamage, CurrentHit.ImpactPoint);
 		}
 	}
 }
@@ -300,13 +315,10 @@ void ACombatCharacter::CheckCombo()
 			++ComboCount;
 
 			// do we still have a combo section to play?
-			if (ComboCount < ComboSectionNames.Num())
+			if (ComboCount < ComboSectionIndices.Num())
 			{
 				// jump to the next combo section
-				if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
-				{
-					AnimInstance->Montage_JumpToSection(ComboSectionNames[ComboCount], ComboAttackMontage);
-				}
+				UMontageUtilityLibrary::JumpToSectionIndex(GetMesh()->GetAnimInstance(), ComboAttackMontage, ComboSectionIndices[ComboCount]);
 			}
 		}
 	}
@@ -318,10 +330,7 @@ void ACombatCharacter::CheckChargedAttack()
 	bHasLoopedChargedAttack = true;
 
 	// jump to either the loop or the attack section depending on whether we're still holding the charge button
-	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
-	{
-		AnimInstance->Montage_JumpToSection(bIsChargingAttack ? ChargeLoopSection : ChargeAttackSection, ChargedAttackMontage);
-	}
+	UMontageUtilityLibrary::JumpToSectionIndex(GetMesh()->GetAnimInstance(), ChargedAttackMontage, bIsChargingAttack ? ChargeLoopSectionIndex : ChargeAttackSectionIndex);
 }
 
 void ACombatCharacter::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
@@ -358,7 +367,7 @@ void ACombatCharacter::HandleDeath()
 	GetMesh()->SetSimulatePhysics(true);
 
 	// hide the life bar
-	LifeBar->SetHiddenInGame(true);
+	SetLifeBarVisible(false);
 
 	// pull back the camera
 	GetCameraBoom()->TargetArmLength = DeathCameraDistance;
@@ -398,7 +407,7 @@ float ACombatCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dama
 	else
 	{
 		// update the life bar
-		LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
+		SetLifeBarPercentage(CurrentHP / MaxHP);
 
 		// enable partial ragdoll physics, but keep the pelvis vertical
 		GetMesh()->SetPhysicsBlendWeight(0.5f);
@@ -425,9 +434,23 @@ void ACombatCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// get the life bar from the widget component
-	LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
-	check(LifeBarWidget);
+	if (bUseBatchedLifeBar)
+	{
+		// draw the life bar through the shared layer and keep the widget component as the anchor only
+		LifeBar->SetHiddenInGame(true);
+		LifeBar->SetComponentTickEnabled(false);
+
+		if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+		{
+			LifeBarId = LifeBars->RegisterBar(LifeBar, LifeBarColor);
+		}
+	}
+	else
+	{
+		// get the life bar from the widget component
+		LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
+		check(LifeBarWidget);
+	}
 
 	// initialize the camera
 	GetCameraBoom()->TargetArmLength = DefaultCameraDistance;
@@ -435,8 +458,19 @@ void ACombatCharacter::BeginPlay()
 	// save the relative transform for the mesh so we can reset the ragdoll later
 	MeshStartingTransform = GetMesh()->GetRelativeTransform();
 
+	// resolve the combo and charge sections once so attacks jump by section index
+	UMontageUtilityLibrary::ResolveSectionIndices(ComboAttackMontage, ComboSectionNames, ComboSectionIndices);
+	if (const FMontageSectionTable* ChargeSections = UMontageUtilityLibrary::GetSectionTable(ChargedAttackMontage))
+	{
+		ChargeLoopSectionIndex = ChargeSections->FindSection(ChargeLoopSection);
+		ChargeAttackSectionIndex = ChargeSections->FindSection(ChargeAttackSection);
+	}
+
 	// set the life bar color
-	LifeBarWidget->SetBarColor(LifeBarColor);
+	if (LifeBarWidget)
+	{
+		LifeBarWidget->SetBarColor(LifeBarColor);
+	}
 
 	// reset HP to maximum
 	ResetHP();
@@ -448,6 +482,52 @@ void ACombatCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 	// clear the respawn timer
 	GetWorld()->GetTimerManager().ClearTimer(RespawnTimer);
+
+	// release the batched life bar
+	if (LifeBarId != INDEX_NONE)
+	{
+		if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+		{
+			LifeBars->UnregisterBar(LifeBarId);
+		}
+		LifeBarId = INDEX_NONE;
+	}
+}
+
+void ACombatCharacter::SetLifeBarPercentage(float Percent)
+{
+	// let other UI listeners know through the coalescing bus
+	if (UCombatUIEventSubsystem* UIEvents = GetWorld()->GetSubsystem<UCombatUIEventSubsystem>())
+	{
+		UIEvents->NotifyHealthChanged(this, Percent);
+	}
+
+	if (LifeBarId != INDEX_NONE)
+	{
+		if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+		{
+			LifeBars->SetBarPercentage(LifeBarId, Percent);
+		}
+	}
+	else if (LifeBarWidget)
+	{
+		LifeBarWidget->SetLifePercentage(Percent);
+	}
+}
+
+void ACombatCharacter::SetLifeBarVisible(bool bVisible)
+{
+	if (LifeBarId != INDEX_NONE)
+	{
+		if (UCombatLifeBarSubsystem* LifeBars = GetWorld()->GetSubsystem<UCombatLifeBarSubsystem>())
+		{
+			LifeBars->SetBarVisible(LifeBarId, bVisible);
+		}
+	}
+	else
+	{
+		LifeBar->SetHiddenInGame(!bVisible);
+	}
 }
 
 void ACombatCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
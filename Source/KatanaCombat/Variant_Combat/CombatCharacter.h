@@ -89,6 +89,13 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	TObjectPtr<UCombatLifeBar> LifeBarWidget;
 
+	/** If true, the life bar is drawn by the shared life bar layer instead of the per-actor widget component */
+	UPROPERTY(EditAnywhere, Category="Damage")
+	bool bUseBatchedLifeBar = true;
+
+	/** Id of this character's bar in the life bar subsystem */
+	int32 LifeBarId = INDEX_NONE;
+
 	/** Max amount of time that may elapse for a non-combo attack input to not be considered stale */
 	UPROPERTY(EditAnywhere, Category="Melee Attack", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
 	float AttackInputCacheTimeTolerance = 1.0f;
@@ -146,6 +153,11 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Charged")
 	FName ChargeAttackSection;
 
+	/** Combo and charge sections resolved to montage section indices on BeginPlay (INDEX_NONE = section is missing) */
+	TArray<int32> ComboSectionIndices;
+	int32 ChargeLoopSectionIndex = INDEX_NONE;
+	int32 ChargeAttackSectionIndex = INDEX_NONE;
+
 	/** Flag that determines if the player is currently holding the charged attack input */
 	bool bIsChargingAttack = false;
 	
@@ -251,6 +263,17 @@ public:
 
 	// ~end CombatAttacker interface
 
+protected:
+
+	/** Applies damage for the hits of a batched attack trace */
+	void ProcessAttackHits(const TArray<FHitResult>& Hits);
+
+	/** Last actor hit by a melee trace, and its damageable interface (null if not damageable) */
+	TWeakObjectPtr<AActor> CachedHitActor;
+	ICombatDamageable* CachedHitDamageable = nullptr;
+
+public:
+
 	// ~begin CombatDamageable interface
 
 	/** Handles damage and knockback events */
@@ -293,6 +316,12 @@ protected:
 	/** Cleanup */
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	/** Updates the life bar fill on whichever life bar is in use */
+	void SetLifeBarPercentage(float Percent);
+
+	/** Shows or hides whichever life bar is in use */
+	void SetLifeBarVisible(bool bVisible);
+
 	/** Handles input bindings */
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
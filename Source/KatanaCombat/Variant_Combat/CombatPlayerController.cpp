@@ -7,6 +7,10 @@
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/PlayerStart.h"
 #include "CombatCharacter.h"
+#include "CombatEnemySpawner.h"
+#include "EngineUtils.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
 #include "Blueprint/UserWidget.h"
@@ -76,8 +80,75 @@ void ACombatPlayerController::SetRespawnTransform(const FTransform& NewRespawn)
 	RespawnTransform = NewRespawn;
 }
 
+void ACombatPlayerController::CaptureEncounterSnapshot()
+{
+	if (!bRestoreEncounterOnRespawn)
+	{
+		return;
+	}
+
+	EncounterSnapshot.Reset();
+	FMemoryWriter Writer(EncounterSnapshot);
+
+	// remember how many spawners we wrote so the count can be patched in afterwards
+	int32 NumSpawners = 0;
+	Writer << NumSpawners;
+
+	for (TActorIterator<ACombatEnemySpawner> It(GetWorld()); It; ++It)
+	{
+		FName SpawnerName = It->GetFName();
+		Writer << SpawnerName;
+		It->SerializeEncounterState(Writer);
+		++NumSpawners;
+	}
+
+	Writer.Seek(0);
+	Writer << NumSpawners;
+}
+
+void ACombatPlayerController::RestoreEncounterSnapshot()
+{
+	if (!bRestoreEncounterOnRespawn || EncounterSnapshot.Num() == 0)
+	{
+		return;
+	}
+
+	// look spawners up by name, the snapshot order isn't guaranteed to match iteration order
+	TMap<FName, ACombatEnemySpawner*> Spawners;
+
+	for (TActorIterator<ACombatEnemySpawner> It(GetWorld()); It; ++It)
+	{
+		Spawners.Add(It->GetFName(), *It);
+	}
+
+	FMemoryReader Reader(EncounterSnapshot);
+
+	int32 NumSpawners = 0;
+	Reader << NumSpawners;
+
+	for (int32 Index = 0; Index < NumSpawners && !Reader.IsError(); ++Index)
+	{
+		FName SpawnerName;
+		Reader << SpawnerName;
+
+		ACombatEnemySpawner** Spawner = Spawners.Find(SpawnerName);
+
+		// a spawner that's gone can't be skipped over (its record has no size), so stop here
+		if (!Spawner || !IsValid(*Spawner))
+		{
+			UE_LOG(LogKatanaCombat, Warning, TEXT("Encounter snapshot references missing spawner %s, restore stopped"), *SpawnerName.ToString());
+			break;
+		}
+
+		(*Spawner)->SerializeEncounterState(Reader);
+	}
+}
+
 void ACombatPlayerController::OnPawnDestroyed(AActor* DestroyedActor)
 {
+	// put the encounter back the way it was at the checkpoint
+	RestoreEncounterSnapshot();
+
 	// spawn a new character at the respawn transform
 	if (ACombatCharacter* RespawnedCharacter = GetWorld()->SpawnActor<ACombatCharacter>(CharacterClass, RespawnTransform))
 	{
@@ -43,6 +43,13 @@ protected:
 	/** Transform to respawn the character at. Can be set to create checkpoints */
 	FTransform RespawnTransform;
 
+	/** If true, the encounter state is captured at checkpoints and restored in place when the player respawns */
+	UPROPERTY(EditAnywhere, Category="Respawn")
+	bool bRestoreEncounterOnRespawn = true;
+
+	/** Binary snapshot of the encounter state at the last checkpoint (empty until one is reached) */
+	TArray<uint8> EncounterSnapshot;
+
 protected:
 
 	/** Gameplay initialization */
@@ -59,6 +66,12 @@ public:
 	/** Updates the character respawn transform */
 	void SetRespawnTransform(const FTransform& NewRespawn);
 
+	/** Saves the state of every enemy spawner in the level into the encounter snapshot */
+	void CaptureEncounterSnapshot();
+
+	/** Restores every enemy spawner in the level from the encounter snapshot */
+	void RestoreEncounterSnapshot();
+
 protected:
 
 	/** Called if the possessed pawn is destroyed */
@@ -5,6 +5,11 @@
 #include "Components/BoxComponent.h"
 #include "GameFramework/Character.h"
 #include "CombatActivatable.h"
+#include "CombatEnemySpawner.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 ACombatActivationVolume::ACombatActivationVolume()
 {
@@ -22,6 +27,9 @@ ACombatActivationVolume::ACombatActivationVolume()
 
 	// bind the begin overlap 
 	Box->OnComponentBeginOverlap.AddDynamic(this, &ACombatActivationVolume::OnOverlap);
+
+	// bind the end overlap for encounter streaming
+	Box->OnComponentEndOverlap.AddDynamic(this, &ACombatActivationVolume::OnEndOverlap);
 }
 
 void ACombatActivationVolume::OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -34,6 +42,13 @@ void ACombatActivationVolume::OnOverlap(UPrimitiveComponent* OverlappedComponent
 		// is the Character controlled by a player
 		if (PlayerCharacter->IsPlayerControlled())
 		{
+			// bring the encounter in, or keep it if we're coming back before it was released
+			if (bStreamEncounter)
+			{
+				GetWorld()->GetTimerManager().ClearTimer(ReleaseTimer);
+				StreamInEncounter();
+			}
+
 			// process the actors to activate list
 			for (AActor* CurrentActor : ActorsToActivate)
 			{
@@ -46,4 +61,96 @@ void ACombatActivationVolume::OnOverlap(UPrimitiveComponent* OverlappedComponent
 		}
 	}
 
+}
+
+void ACombatActivationVolume::OnEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	// has the player left the volume?
+	ACharacter* PlayerCharacter = Cast<ACharacter>(OtherActor);
+
+	if (bStreamEncounter && PlayerCharacter && PlayerCharacter->IsPlayerControlled())
+	{
+		// release the encounter if they stay away long enough
+		GetWorld()->GetTimerManager().SetTimer(ReleaseTimer, this, &ACombatActivationVolume::ReleaseEncounter, ReleaseDelay, false);
+	}
+}
+
+void ACombatActivationVolume::StreamInEncounter()
+{
+	// already loading or loaded?
+	if (EncounterHandle.IsValid())
+	{
+		return;
+	}
+
+	// gather the assets of every streamed spawner we activate
+	TArray<FSoftObjectPath> Assets;
+
+	for (AActor* CurrentActor : ActorsToActivate)
+	{
+		if (ACombatEnemySpawner* Spawner = Cast<ACombatEnemySpawner>(CurrentActor))
+		{
+			Spawner->GetEncounterAssets(Assets);
+		}
+	}
+
+	if (Assets.Num() == 0)
+	{
+		return;
+	}
+
+	// also calls back right away if everything is already in memory
+	EncounterHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Assets, FStreamableDelegate::CreateUObject(this, &ACombatActivationVolume::OnEncounterLoaded));
+}
+
+void ACombatActivationVolume::OnEncounterLoaded()
+{
+	// let the spawners prewarm their pools and run any deferred spawns
+	for (AActor* CurrentActor : ActorsToActivate)
+	{
+		ACombatEnemySpawner* Spawner = Cast<ACombatEnemySpawner>(CurrentActor);
+
+		if (Spawner && Spawner->IsStreamedEncounter() && !Spawner->IsEncounterLoaded())
+		{
+			Spawner->OnEncounterLoaded();
+		}
+	}
+}
+
+void ACombatActivationVolume::ReleaseEncounter()
+{
+	if (!EncounterHandle.IsValid())
+	{
+		return;
+	}
+
+	// drop idle pooled enemies so nothing keeps the assets alive
+	for (AActor* CurrentActor : ActorsToActivate)
+	{
+		ACombatEnemySpawner* Spawner = Cast<ACombatEnemySpawner>(CurrentActor);
+
+		if (Spawner && Spawner->IsStreamedEncounter())
+		{
+			Spawner->OnEncounterUnloaded();
+		}
+	}
+
+	// release the assets. They'll be garbage collected once no live enemy uses them
+	EncounterHandle->ReleaseHandle();
+	EncounterHandle.Reset();
+}
+
+void ACombatActivationVolume::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// clear the release timer
+	GetWorld()->GetTimerManager().ClearTimer(ReleaseTimer);
+
+	// release the encounter handle
+	if (EncounterHandle.IsValid())
+	{
+		EncounterHandle->ReleaseHandle();
+		EncounterHandle.Reset();
+	}
 }
\ No newline at end of file
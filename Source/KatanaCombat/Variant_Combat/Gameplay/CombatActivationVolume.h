@@ -7,9 +7,13 @@
 #include "CombatActivationVolume.generated.h"
 
 class UBoxComponent;
+struct FStreamableHandle;
 
 /**
  *  A simple volume that activates a list of actors when the player pawn enters.
+ *  Can also stream an encounter: entering async loads the streamed enemy classes and assets
+ *  of the enemy spawners in the activation list and prewarms their pools, and staying out
+ *  for ReleaseDelay seconds destroys the idle pooled enemies and releases the assets.
  */
 UCLASS()
 class ACombatActivationVolume : public AActor
@@ -26,6 +30,20 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Activation Volume")
 	TArray<AActor*> ActorsToActivate;
 
+	/** If true, the encounter assets of the spawners in ActorsToActivate are loaded on enter and released after leaving */
+	UPROPERTY(EditAnywhere, Category="Encounter Streaming")
+	bool bStreamEncounter = false;
+
+	/** Time the player must stay outside the volume before the encounter is released */
+	UPROPERTY(EditAnywhere, Category="Encounter Streaming", meta = (ClampMin = 0, ClampMax = 600, Units = "s", EditCondition = "bStreamEncounter"))
+	float ReleaseDelay = 20.0f;
+
+	/** Keeps the encounter assets loaded */
+	TSharedPtr<FStreamableHandle> EncounterHandle;
+
+	/** Timer to release the encounter after the player leaves */
+	FTimerHandle ReleaseTimer;
+
 public:	
 	
 	/** Constructor */
@@ -37,4 +55,20 @@ protected:
 	UFUNCTION()
 	void OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
+	/** Handles the player leaving the box volume */
+	UFUNCTION()
+	void OnEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	/** Starts loading the encounter assets (no-op if already loading or loaded) */
+	void StreamInEncounter();
+
+	/** Called when the encounter assets have finished loading */
+	void OnEncounterLoaded();
+
+	/** Releases the encounter assets and idle pooled enemies */
+	void ReleaseEncounter();
+
+	/** EndPlay cleanup */
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 };
@@ -41,6 +41,9 @@ void ACombatCheckpointVolume::OnOverlap(UPrimitiveComponent* OverlappedComponent
 
 			// update the player's respawn checkpoint
 			PC->SetRespawnTransform(PlayerCharacter->GetActorTransform());
+
+			// capture the encounter so it can be restored in place on respawn
+			PC->CaptureEncounterSnapshot();
 		}
 
 	}
@@ -2,6 +2,7 @@
 
 
 #include "CombatDamageableBox.h"
+#include "CombatDebrisSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "TimerManager.h"
 #include "Engine/World.h"
@@ -19,10 +20,24 @@ ACombatDamageableBox::ACombatDamageableBox()
 	// enable physics
 	Mesh->SetSimulatePhysics(true);
 
+	// start with the physics body asleep and skip overlap bookkeeping until something hits us
+	Mesh->BodyInstance.bStartAwake = false;
+	Mesh->SetGenerateOverlapEvents(false);
+
 	// disable navigation relevance so boxes don't affect NavMesh generation
 	Mesh->bNavigationRelevant = false;
 }
 
+void ACombatDamageableBox::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// remember the starting state for pooled reuse
+	StartingHP = CurrentHP;
+	StartingObjectType = Mesh->GetCollisionObjectType();
+	StartingScale = GetActorScale3D();
+}
+
 void ACombatDamageableBox::RemoveFromLevel()
 {
 	// destroy this actor
@@ -33,8 +48,22 @@ void ACombatDamageableBox::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the death timer
+	// clear the death and dormancy timers
 	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+	GetWorld()->GetTimerManager().ClearTimer(DormancyTimer);
+}
+
+void ACombatDamageableBox::GoDormant()
+{
+	// still moving? check again in a bit
+	if (Mesh->GetPhysicsLinearVelocity().SizeSquared() > FMath::Square(DormantSpeedThreshold))
+	{
+		GetWorld()->GetTimerManager().SetTimer(DormancyTimer, this, &ACombatDamageableBox::GoDormant, ActiveWindowTime * 0.5f, false);
+		return;
+	}
+
+	// settle back to sleep
+	Mesh->PutAllRigidBodiesToSleep();
 }
 
 void ACombatDamageableBox::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
@@ -52,8 +81,15 @@ void ACombatDamageableBox::ApplyDamage(float Damage, AActor* DamageCauser, const
 		}
 
 		// apply a physics impulse to the box, ignoring its mass
+		Mesh->WakeAllRigidBodies();
 		Mesh->AddImpulseAtLocation(DamageImpulse * Mesh->GetMass(), DamageLocation);
 
+		// stay active for a while, unless we're about to be removed anyway
+		if (CurrentHP > 0.0f)
+		{
+			GetWorld()->GetTimerManager().SetTimer(DormancyTimer, this, &ACombatDamageableBox::GoDormant, ActiveWindowTime, false);
+		}
+
 		// call the BP handler to play effects, etc.
 		OnBoxDamaged(DamageLocation, DamageImpulse);
 	}
@@ -64,11 +100,21 @@ void ACombatDamageableBox::HandleDeath()
 	// change the collision object type to Visibility so we ignore most interactions but still retain physics collisions
 	Mesh->SetCollisionObjectType(ECC_Visibility);
 
+	// stop any pending dormancy check, the debris budget takes over from here
+	GetWorld()->GetTimerManager().ClearTimer(DormancyTimer);
+
 	// call the BP handler to play effects, etc.
 	OnBoxDestroyed();
 
-	// set up the death cleanup timer
-	GetWorld()->GetTimerManager().SetTimer(DeathTimer, this, &ACombatDamageableBox::RemoveFromLevel, DeathDelayTime);
+	// hand the box to the debris budget, or set up the death cleanup timer if there is none
+	if (UCombatDebrisSubsystem* DebrisSubsystem = GetWorld()->GetSubsystem<UCombatDebrisSubsystem>())
+	{
+		DebrisSubsystem->AddDebris(this);
+	}
+	else
+	{
+		GetWorld()->GetTimerManager().SetTimer(DeathTimer, this, &ACombatDamageableBox::RemoveFromLevel, DeathDelayTime);
+	}
 }
 
 void ACombatDamageableBox::ApplyHealing(float Healing, AActor* Healer)
@@ -76,3 +122,69 @@ void ACombatDamageableBox::ApplyHealing(float Healing, AActor* Healer)
 	// stub
 }
 
+bool ACombatDamageableBox::IsDebrisAwake() const
+{
+	return Mesh->IsSimulatingPhysics() && Mesh->RigidBodyIsAwake();
+}
+
+float ACombatDamageableBox::GetDebrisSpeed() const
+{
+	return Mesh->GetPhysicsLinearVelocity().Size();
+}
+
+void ACombatDamageableBox::SleepDebris()
+{
+	Mesh->PutAllRigidBodiesToSleep();
+}
+
+void ACombatDamageableBox::FreezeDebris()
+{
+	Mesh->SetSimulatePhysics(false);
+}
+
+void ACombatDamageableBox::StartDebrisFade(float FadeTime)
+{
+	// fading debris no longer needs physics or collision
+	Mesh->SetSimulatePhysics(false);
+	Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// call the BP handler to play effects, etc.
+	OnBoxFadeOut(FadeTime);
+}
+
+void ACombatDamageableBox::SetDebrisFade(float Alpha)
+{
+	SetActorScale3D(StartingScale * FMath::Max(1.0f - Alpha, UE_KINDA_SMALL_NUMBER));
+}
+
+void ACombatDamageableBox::DeactivateForPool()
+{
+	// stop any pending timers
+	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+	GetWorld()->GetTimerManager().ClearTimer(DormancyTimer);
+
+	// hide and disable everything
+	Mesh->SetSimulatePhysics(false);
+	Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+}
+
+void ACombatDamageableBox::ActivateFromPool(const FTransform& SpawnTransform)
+{
+	// move to the spawn point, undoing the fade
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	StartingScale = SpawnTransform.GetScale3D();
+
+	// reset HP and collision
+	CurrentHP = StartingHP;
+	Mesh->SetCollisionObjectType(StartingObjectType);
+	Mesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+	// show and re-enable everything, with the physics body asleep until something hits us
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	Mesh->SetSimulatePhysics(true);
+	Mesh->PutAllRigidBodiesToSleep();
+}
+
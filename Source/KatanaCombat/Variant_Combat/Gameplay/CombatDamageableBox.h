@@ -37,6 +37,20 @@ protected:
 	/** Timer to defer destruction of this box after its HP are depleted */
 	FTimerHandle DeathTimer;
 
+	/** How long the box stays physically active after a hit before it may go dormant again */
+	UPROPERTY(EditAnywhere, Category="Dormancy", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
+	float ActiveWindowTime = 2.0f;
+
+	/** The box only goes dormant once it has settled below this speed */
+	UPROPERTY(EditAnywhere, Category="Dormancy", meta = (ClampMin = 0, ClampMax = 100, Units = "cm/s"))
+	float DormantSpeedThreshold = 5.0f;
+
+	/** Timer that returns the box to dormant after its active window */
+	FTimerHandle DormancyTimer;
+
+	/** Puts the box's physics back to sleep once it has settled */
+	void GoDormant();
+
 	/** Blueprint damage handler for effect playback */
 	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
 	void OnBoxDamaged(const FVector& DamageLocation, const FVector& DamageImpulse);
@@ -45,14 +59,53 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
 	void OnBoxDestroyed();
 
+	/** Blueprint handler for debris fading out before it's pooled (e.g. to fade a material) */
+	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
+	void OnBoxFadeOut(float FadeTime);
+
 	/** Timer callback to remove the box from the level after it dies */
 	void RemoveFromLevel();
 
+	/** HP, collision object type and scale the box started with, restored when a pooled box is reused */
+	float StartingHP = 0.0f;
+	TEnumAsByte<ECollisionChannel> StartingObjectType = ECC_WorldDynamic;
+	FVector StartingScale = FVector::OneVector;
+
 public:
 
+	/** BeginPlay initialization */
+	virtual void BeginPlay() override;
+
 	/** EndPlay cleanup */
 	void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
+	/** Returns the time a destroyed box stays in the level as debris */
+	float GetDeathDelayTime() const { return DeathDelayTime; }
+
+	/** Returns true while the debris is simulating and awake */
+	bool IsDebrisAwake() const;
+
+	/** Returns the debris speed in cm/s */
+	float GetDebrisSpeed() const;
+
+	/** Puts the debris physics to sleep */
+	void SleepDebris();
+
+	/** Stops simulating the debris where it lies */
+	void FreezeDebris();
+
+	/** Starts fading the debris out over the given time */
+	void StartDebrisFade(float FadeTime);
+
+	/** Shrinks the debris by its fade progress (0 = untouched, 1 = gone) */
+	void SetDebrisFade(float Alpha);
+
+	/** Hides and deactivates this box so it can be parked in a pool */
+	void DeactivateForPool();
+
+	/** Reactivates a pooled box at the given transform with full HP */
+	void ActivateFromPool(const FTransform& SpawnTransform);
+
 	// ~Begin CombatDamageable interface
 
 	/** Handles damage and knockback events */
@@ -0,0 +1,219 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatDebrisSubsystem.h"
+#include "CombatDamageableBox.h"
+#include "Engine/World.h"
+
+void UCombatDebrisSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UCombatJobSchedulerSubsystem* Scheduler = Collection.InitializeDependency<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->RegisterJob<&UCombatDebrisSubsystem::UpdateDebrisJob>(UpdateJob, this, UpdateInterval, ECombatJobPriority::Low, TEXT("Debris.Update"));
+	}
+}
+
+void UCombatDebrisSubsystem::Deinitialize()
+{
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->UnregisterJob(UpdateJob);
+		Scheduler->UnregisterJob(FadeJob);
+	}
+
+	Debris.Empty();
+	Pool.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatDebrisSubsystem::AddDebris(ACombatDamageableBox* Box)
+{
+	if (!Box || Debris.ContainsByPredicate([Box](const FDebris& Piece) { return Piece.Box.Get() == Box; }))
+	{
+		return;
+	}
+
+	FDebris& Piece = Debris.AddDefaulted_GetRef();
+	Piece.Box = Box;
+	Piece.StartTime = GetWorld()->GetTimeSeconds();
+
+	// enforce the caps on the next scheduler update instead of waiting out the interval
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->MarkJobDue(UpdateJob);
+	}
+}
+
+ACombatDamageableBox* UCombatDebrisSubsystem::SpawnBox(TSubclassOf<ACombatDamageableBox> BoxClass, const FTransform& Transform)
+{
+	if (!BoxClass)
+	{
+		return nullptr;
+	}
+
+	// reuse a pooled box of the same class
+	for (int32 Index = Pool.Num() - 1; Index >= 0; --Index)
+	{
+		ACombatDamageableBox* PooledBox = Pool[Index].Get();
+		if (!PooledBox)
+		{
+			Pool.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (PooledBox->GetClass() == BoxClass)
+		{
+			Pool.RemoveAtSwap(Index);
+			PooledBox->ActivateFromPool(Transform);
+			return PooledBox;
+		}
+	}
+
+	return GetWorld()->SpawnActor<ACombatDamageableBox>(BoxClass, Transform);
+}
+
+int32 UCombatDebrisSubsystem::GetNumAwakeDebris() const
+{
+	int32 NumAwake = 0;
+	for (const FDebris& Piece : Debris)
+	{
+		const ACombatDamageableBox* Box = Piece.Box.Get();
+		NumAwake += Box && !Piece.bFrozen && Box->IsDebrisAwake() ? 1 : 0;
+	}
+
+	return NumAwake;
+}
+
+void UCombatDebrisSubsystem::UpdateDebrisJob(float DeltaTime)
+{
+	UpdateDebris();
+}
+
+void UCombatDebrisSubsystem::UpdateDebris()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// boxes destroyed outright
+	Debris.RemoveAll([](const FDebris& Piece) { return !Piece.Box.IsValid(); });
+
+	// pieces over the total cap fade first, oldest first
+	int32 NumOverCap = Debris.Num() - MaxDebris;
+	for (FDebris& Piece : Debris)
+	{
+		if (Piece.FadeStartTime >= 0.0)
+		{
+			--NumOverCap;
+		}
+	}
+
+	// walk newest first so the newest pieces keep their awake budget
+	int32 NumAwake = 0;
+	for (int32 Index = Debris.Num() - 1; Index >= 0; --Index)
+	{
+		FDebris& Piece = Debris[Index];
+		ACombatDamageableBox* Box = Piece.Box.Get();
+
+		if (!Piece.bFrozen && Box->IsDebrisAwake())
+		{
+			if (Box->GetDebrisSpeed() <= SleepSpeed)
+			{
+				// slowed down - sleep right away instead of waiting for the physics engine to decide
+				Box->SleepDebris();
+			}
+			else if (++NumAwake > MaxAwakeDebris)
+			{
+				// over the awake budget - stop simulating
+				Box->FreezeDebris();
+				Piece.bFrozen = true;
+			}
+		}
+	}
+
+	// fade the oldest pieces past their lifetime or over the total cap
+	for (FDebris& Piece : Debris)
+	{
+		if (Piece.FadeStartTime >= 0.0)
+		{
+			continue;
+		}
+
+		const bool bExpired = Now - Piece.StartTime >= Piece.Box->GetDeathDelayTime();
+		if (bExpired || NumOverCap > 0)
+		{
+			NumOverCap -= bExpired ? 0 : 1;
+			StartFade(Piece, Now);
+		}
+	}
+}
+
+void UCombatDebrisSubsystem::StartFade(FDebris& Piece, double Now)
+{
+	Piece.FadeStartTime = Now;
+	Piece.Box->StartDebrisFade(FadeTime);
+
+	// fades need smooth per-frame updates, but only while something is fading
+	UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>();
+	if (Scheduler && !Scheduler->IsJobRegistered(FadeJob))
+	{
+		Scheduler->RegisterJob<&UCombatDebrisSubsystem::UpdateFadesJob>(FadeJob, this, 0.0f, ECombatJobPriority::Low, TEXT("Debris.Fade"));
+	}
+}
+
+void UCombatDebrisSubsystem::UpdateFadesJob(float DeltaTime)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	bool bAnyFading = false;
+
+	for (int32 Index = 0; Index < Debris.Num(); ++Index)
+	{
+		FDebris& Piece = Debris[Index];
+		ACombatDamageableBox* Box = Piece.Box.Get();
+		if (!Box)
+		{
+			Debris.RemoveAt(Index--);
+			continue;
+		}
+
+		if (Piece.FadeStartTime < 0.0)
+		{
+			continue;
+		}
+
+		const float Alpha = FadeTime > 0.0f ? float(Now - Piece.FadeStartTime) / FadeTime : 1.0f;
+		if (Alpha < 1.0f)
+		{
+			Box->SetDebrisFade(Alpha);
+			bAnyFading = true;
+			continue;
+		}
+
+		// faded out - hand the box to the pool, keeping the rest in age order
+		Debris.RemoveAt(Index--);
+		ReleaseBox(Box);
+	}
+
+	if (!bAnyFading)
+	{
+		if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+		{
+			Scheduler->UnregisterJob(FadeJob);
+		}
+	}
+}
+
+void UCombatDebrisSubsystem::ReleaseBox(ACombatDamageableBox* Box)
+{
+	Pool.RemoveAll([](const TWeakObjectPtr<ACombatDamageableBox>& PooledBox) { return !PooledBox.IsValid(); });
+
+	if (Pool.Num() >= MaxPooledBoxes)
+	{
+		Box->Destroy();
+		return;
+	}
+
+	Box->DeactivateForPool();
+	Pool.Add(Box);
+}
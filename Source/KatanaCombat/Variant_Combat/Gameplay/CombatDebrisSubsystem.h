@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "CombatDebrisSubsystem.generated.h"
+
+class ACombatDamageableBox;
+
+/**
+ *  Debris budget for destroyed damageable boxes
+ *  Destroyed boxes become debris, tracked oldest first. A scheduled job puts debris to sleep as soon as it
+ *  slows down, and freezes the oldest awake pieces whenever more than MaxAwakeDebris are still simulating
+ *  Debris fades out once it outlives its box's DeathDelayTime, or early (oldest first) while there are more
+ *  than MaxDebris pieces, and is then parked in a pool that SpawnBox reuses instead of spawning new actors
+ */
+UCLASS()
+class UCombatDebrisSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Starts tracking a destroyed box as debris */
+	void AddDebris(ACombatDamageableBox* Box);
+
+	/** Spawns a box of the given class, reusing a pooled one if there is any */
+	ACombatDamageableBox* SpawnBox(TSubclassOf<ACombatDamageableBox> BoxClass, const FTransform& Transform);
+
+	/** Returns the number of debris pieces (awake, asleep or fading) */
+	int32 GetNumDebris() const { return Debris.Num(); }
+
+	/** Returns the number of debris pieces still simulating awake */
+	int32 GetNumAwakeDebris() const;
+
+	/** Returns the number of boxes waiting in the pool */
+	int32 GetNumPooled() const { return Pool.Num(); }
+
+	/** Checks every piece of debris now (normally done by the scheduled job) */
+	void UpdateDebris();
+
+	/** Most debris pieces simulating awake at once; the oldest are frozen beyond this */
+	int32 MaxAwakeDebris = 12;
+
+	/** Most debris pieces at once; the oldest start fading beyond this */
+	int32 MaxDebris = 24;
+
+	/** Most boxes kept in the pool; released boxes beyond this are destroyed */
+	int32 MaxPooledBoxes = 32;
+
+	/** Debris slower than this is put to sleep (cm/s) */
+	float SleepSpeed = 20.0f;
+
+	/** Time debris takes to fade out before it's pooled */
+	float FadeTime = 0.5f;
+
+	/** Time between debris checks */
+	float UpdateInterval = 0.1f;
+
+	// ~begin UWorldSubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// ~end UWorldSubsystem interface
+
+protected:
+
+	/** A destroyed box */
+	struct FDebris
+	{
+		TWeakObjectPtr<ACombatDamageableBox> Box;
+
+		/** World time the box was destroyed */
+		double StartTime = 0.0;
+
+		/** World time the box started fading, or a negative value if it hasn't */
+		double FadeStartTime = -1.0;
+
+		/** True once the box no longer simulates */
+		bool bFrozen = false;
+	};
+
+	/** Scheduled job: sleep, freeze and fade decisions */
+	void UpdateDebrisJob(float DeltaTime);
+
+	/** Per-frame job while anything is fading: fade progress and pooling */
+	void UpdateFadesJob(float DeltaTime);
+
+	/** Starts fading the piece of debris and makes sure the fade job runs */
+	void StartFade(FDebris& Piece, double Now);
+
+	/** Parks the box in the pool, or destroys it if the pool is full */
+	void ReleaseBox(ACombatDamageableBox* Box);
+
+	/** Debris check job on the combat job scheduler */
+	FCombatJobHandle UpdateJob;
+
+	/** Fade job on the combat job scheduler (registered only while something is fading) */
+	FCombatJobHandle FadeJob;
+
+	/** Debris, oldest first */
+	TArray<FDebris> Debris;
+
+	/** Released boxes ready for reuse */
+	TArray<TWeakObjectPtr<ACombatDamageableBox>> Pool;
+};
@@ -5,10 +5,13 @@
 #include "Components/SceneComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
 
 ACombatDummy::ACombatDummy()
 {
- 	PrimaryActorTick.bCanEverTick = true;
+ 	// the dummy sits dormant until it's hit, so it never needs to tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	// create the root
 	Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
@@ -24,6 +27,11 @@ ACombatDummy::ACombatDummy()
 
 	Dummy->SetSimulatePhysics(true);
 
+	// start with the physics body asleep and skip overlap bookkeeping. Weapon traces still hit it
+	Dummy->BodyInstance.bStartAwake = false;
+	Dummy->SetGenerateOverlapEvents(false);
+	BasePlate->SetGenerateOverlapEvents(false);
+
 	// create the physics constraint
 	PhysicsConstraint = CreateDefaultSubobject<UPhysicsConstraintComponent>(TEXT("Physics Constraint"));
 	PhysicsConstraint->SetupAttachment(RootComponent);
@@ -33,6 +41,9 @@ ACombatDummy::ACombatDummy()
 
 void ACombatDummy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
 {
+	// leave dormancy for a while
+	WakeUp();
+
 	// apply impulse to the dummy
 	Dummy->AddImpulseAtLocation(DamageImpulse, DamageLocation);
 
@@ -48,4 +59,33 @@ void ACombatDummy::HandleDeath()
 void ACombatDummy::ApplyHealing(float Healing, AActor* Healer)
 {
 	// unused
-}
\ No newline at end of file
+}
+
+void ACombatDummy::WakeUp()
+{
+	Dummy->WakeAllRigidBodies();
+
+	// restart the active window
+	GetWorld()->GetTimerManager().SetTimer(DormancyTimer, this, &ACombatDummy::GoDormant, ActiveWindowTime, false);
+}
+
+void ACombatDummy::GoDormant()
+{
+	// still swinging? check again in a bit
+	if (Dummy->GetPhysicsLinearVelocity().SizeSquared() > FMath::Square(DormantSpeedThreshold))
+	{
+		GetWorld()->GetTimerManager().SetTimer(DormancyTimer, this, &ACombatDummy::GoDormant, ActiveWindowTime * 0.5f, false);
+		return;
+	}
+
+	// settle back to sleep
+	Dummy->PutAllRigidBodiesToSleep();
+}
+
+void ACombatDummy::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// clear the dormancy timer
+	GetWorld()->GetTimerManager().ClearTimer(DormancyTimer);
+}
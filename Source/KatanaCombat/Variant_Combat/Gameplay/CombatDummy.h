@@ -54,6 +54,26 @@ public:
 
 protected:
 
+	/** How long the dummy stays physically active after a hit before it may go dormant again */
+	UPROPERTY(EditAnywhere, Category="Dormancy", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
+	float ActiveWindowTime = 2.0f;
+
+	/** The dummy only goes dormant once it has settled below this speed */
+	UPROPERTY(EditAnywhere, Category="Dormancy", meta = (ClampMin = 0, ClampMax = 100, Units = "cm/s"))
+	float DormantSpeedThreshold = 5.0f;
+
+	/** Timer that returns the dummy to dormant after its active window */
+	FTimerHandle DormancyTimer;
+
+	/** Wakes the dummy's physics and (re)starts the active window */
+	void WakeUp();
+
+	/** Puts the dummy's physics back to sleep once it has settled */
+	void GoDormant();
+
+	/** EndPlay cleanup */
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 	/** Blueprint handle to apply damage effects */
 	UFUNCTION(BlueprintImplementableEvent, Category="Combat", meta = (DisplayName = "On Dummy Damaged"))
 	void BP_OnDummyDamaged(const FVector& Location, const FVector& Direction);
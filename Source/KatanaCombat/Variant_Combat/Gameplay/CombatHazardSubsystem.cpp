@@ -0,0 +1,138 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatHazardSubsystem.h"
+#include "CombatDamageable.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+void UCombatHazardSubsystem::Deinitialize()
+{
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->UnregisterJob(DamageJob);
+	}
+
+	Occupants.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UCombatHazardSubsystem::TouchHazard(AActor* Hazard, AActor* Actor, float Damage, const FVector& ContactLocation)
+{
+	ICombatDamageable* Damageable = Cast<ICombatDamageable>(Actor);
+	if (!Hazard || !Damageable)
+	{
+		return false;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// already in: just note the contact
+	for (FOccupant& Occupant : Occupants)
+	{
+		if (Occupant.Hazard.Get() == Hazard && Occupant.Actor.Get() == Actor)
+		{
+			Occupant.Damage = Damage;
+			Occupant.ContactLocation = ContactLocation;
+			Occupant.LastContactTime = Now;
+			return false;
+		}
+	}
+
+	FOccupant& Occupant = Occupants.AddDefaulted_GetRef();
+	Occupant.Hazard = Hazard;
+	Occupant.Actor = Actor;
+	Occupant.Damage = Damage;
+	Occupant.ContactLocation = ContactLocation;
+	Occupant.LastContactTime = Now;
+
+	// first occupant: start the damage ticks
+	UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>();
+	if (Scheduler && !Scheduler->IsJobRegistered(DamageJob))
+	{
+		Scheduler->RegisterJob<&UCombatHazardSubsystem::ApplyHazardDamageJob>(DamageJob, this, DamageInterval, ECombatJobPriority::Low, TEXT("Hazards.ApplyDamage"));
+	}
+
+	// contact damage (may kill the actor and end its stay right here)
+	Damageable->ApplyDamage(Damage, Hazard, ContactLocation, FVector::ZeroVector);
+
+	return true;
+}
+
+void UCombatHazardSubsystem::LeaveHazard(const AActor* Hazard, const AActor* Actor)
+{
+	Occupants.RemoveAllSwap([Hazard, Actor](const FOccupant& Occupant) { return Occupant.Hazard.Get() == Hazard && Occupant.Actor.Get() == Actor; });
+}
+
+void UCombatHazardSubsystem::RemoveHazard(const AActor* Hazard)
+{
+	Occupants.RemoveAllSwap([Hazard](const FOccupant& Occupant) { return Occupant.Hazard.Get() == Hazard; });
+}
+
+bool UCombatHazardSubsystem::IsInHazard(const AActor* Actor, const AActor* Hazard) const
+{
+	return Actor && Occupants.ContainsByPredicate([Actor, Hazard](const FOccupant& Occupant)
+	{
+		return Occupant.Actor.Get() == Actor && (!Hazard || Occupant.Hazard.Get() == Hazard);
+	});
+}
+
+void UCombatHazardSubsystem::ApplyHazardDamageJob(float DeltaTime)
+{
+	ApplyHazardDamage();
+
+	// nobody left in a hazard: stop running until someone enters one
+	if (Occupants.Num() == 0)
+	{
+		if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+		{
+			Scheduler->UnregisterJob(DamageJob);
+		}
+	}
+}
+
+void UCombatHazardSubsystem::ApplyHazardDamage()
+{
+	++NumDamageTicks;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// drop everyone who left, and collect the damage first: damage can kill, destroy or move actors
+	struct FHazardDamage
+	{
+		TWeakObjectPtr<AActor> Hazard;
+		TWeakObjectPtr<AActor> Actor;
+		float Damage;
+		FVector ContactLocation;
+	};
+	TArray<FHazardDamage, TInlineAllocator<8>> Damages;
+
+	for (int32 Index = Occupants.Num() - 1; Index >= 0; --Index)
+	{
+		FOccupant& Occupant = Occupants[Index];
+		if (!Occupant.Hazard.IsValid() || !Occupant.Actor.IsValid() || Now - Occupant.LastContactTime > ContactTimeout)
+		{
+			Occupants.RemoveAtSwap(Index, EAllowShrinking::No);
+			continue;
+		}
+
+		// took its contact damage since the last tick
+		if (Occupant.bJustEntered)
+		{
+			Occupant.bJustEntered = false;
+			continue;
+		}
+
+		Damages.Add({ Occupant.Hazard, Occupant.Actor, Occupant.Damage, Occupant.ContactLocation });
+	}
+
+	for (const FHazardDamage& Damage : Damages)
+	{
+		ICombatDamageable* Damageable = Cast<ICombatDamageable>(Damage.Actor.Get());
+		if (Damageable && Damage.Hazard.IsValid())
+		{
+			Damageable->ApplyDamage(Damage.Damage, Damage.Hazard.Get(), Damage.ContactLocation, FVector::ZeroVector);
+		}
+	}
+}
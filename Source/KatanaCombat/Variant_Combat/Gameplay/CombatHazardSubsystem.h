@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "CombatHazardSubsystem.generated.h"
+
+/**
+ *  Damage-over-time manager for hazards (lava floors and the like)
+ *  Hazards report contact with TouchHazard from their hit or overlap events; the actor takes the hazard's
+ *  damage once on entry and then once every DamageInterval from a single scheduled job across all hazards,
+ *  however many contact events it generates in between
+ *  Actors leave when the hazard says so (LeaveHazard) or once they go ContactTimeout without touching it,
+ *  which covers blocking hazards that only report hits
+ */
+UCLASS()
+class UCombatHazardSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Keeps the actor in the hazard, damaging it right away if it just entered. Returns true if it just entered */
+	bool TouchHazard(AActor* Hazard, AActor* Actor, float Damage, const FVector& ContactLocation);
+
+	/** Takes the actor out of the hazard */
+	void LeaveHazard(const AActor* Hazard, const AActor* Actor);
+
+	/** Takes every actor out of the hazard */
+	void RemoveHazard(const AActor* Hazard);
+
+	/** Returns true if the actor is in the hazard, or in any hazard if none is given */
+	bool IsInHazard(const AActor* Actor, const AActor* Hazard = nullptr) const;
+
+	/** Returns the number of actors in hazards (an actor in two hazards counts twice) */
+	int32 GetNumOccupants() const { return Occupants.Num(); }
+
+	/** Returns the number of hazard damage ticks run so far */
+	int32 GetNumDamageTicks() const { return NumDamageTicks; }
+
+	/** Damages everyone in a hazard now (normally done by the scheduled job) */
+	void ApplyHazardDamage();
+
+	/** Time between hazard damage ticks */
+	float DamageInterval = 0.5f;
+
+	/** Actors that haven't touched their hazard for this long have left it */
+	float ContactTimeout = 0.5f;
+
+	// ~begin UWorldSubsystem interface
+	virtual void Deinitialize() override;
+	// ~end UWorldSubsystem interface
+
+protected:
+
+	/** An actor in a hazard */
+	struct FOccupant
+	{
+		TWeakObjectPtr<AActor> Hazard;
+		TWeakObjectPtr<AActor> Actor;
+
+		/** Damage dealt every tick */
+		float Damage = 0.0f;
+
+		/** Where the actor last touched the hazard */
+		FVector ContactLocation = FVector::ZeroVector;
+
+		/** World time the actor last touched the hazard */
+		double LastContactTime = 0.0;
+
+		/** Entered since the last tick (and already damaged on entry) */
+		bool bJustEntered = true;
+	};
+
+	/** Scheduled job: one damage tick across all hazards */
+	void ApplyHazardDamageJob(float DeltaTime);
+
+	/** Damage job on the combat job scheduler (registered only while anyone is in a hazard) */
+	FCombatJobHandle DamageJob;
+
+	/** Everyone in a hazard */
+	TArray<FOccupant> Occupants;
+
+	/** Damage ticks run so far */
+	int32 NumDamageTicks = 0;
+};
@@ -2,8 +2,9 @@
 
 
 #include "CombatLavaFloor.h"
-#include "CombatDamageable.h"
+#include "CombatHazardSubsystem.h"
 #include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
 
 ACombatLavaFloor::ACombatLavaFloor()
 {
@@ -18,10 +19,19 @@ ACombatLavaFloor::ACombatLavaFloor()
 
 void ACombatLavaFloor::OnFloorHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
-	// check if the hit actor is damageable by casting to the interface
-	if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(OtherActor))
+	// the hazard subsystem deals the damage (and ignores actors that aren't damageable)
+	if (UCombatHazardSubsystem* Hazards = GetWorld()->GetSubsystem<UCombatHazardSubsystem>())
 	{
-		// damage the actor
-		Damageable->ApplyDamage(Damage, this, Hit.ImpactPoint, FVector::ZeroVector);
+		Hazards->TouchHazard(this, OtherActor, Damage, Hit.ImpactPoint);
 	}
 }
+
+void ACombatLavaFloor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCombatHazardSubsystem* Hazards = GetWorld()->GetSubsystem<UCombatHazardSubsystem>())
+	{
+		Hazards->RemoveHazard(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -11,6 +11,8 @@ class UPrimitiveComponent;
 
 /**
  *  A basic actor that applies damage on contact through the ICombatDamageable interface. 
+ *  Contact only reports to UCombatHazardSubsystem, which deals the damage on entry and then at a fixed cadence
+ *  while the actor keeps touching the floor
  */
 UCLASS(abstract)
 class ACombatLavaFloor : public AActor
@@ -23,7 +25,7 @@ class ACombatLavaFloor : public AActor
 
 protected:
 
-	/** Amount of damage to deal on contact */
+	/** Amount of damage to deal on contact, and again every hazard tick while in contact */
 	UPROPERTY(EditAnywhere, Category="Damage")
 	float Damage = 10000.0f;
 
@@ -37,4 +39,7 @@ protected:
 	/** Blocking hit handler */
 	UFUNCTION()
 	void OnFloorHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
+	/** Lets go of everyone still standing on the floor */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
@@ -0,0 +1,258 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatLifeBarSubsystem.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Components/SceneComponent.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/SLeafWidget.h"
+
+/**
+ *  Viewport layer that draws every batched life bar in one paint pass
+ */
+class SCombatLifeBarLayer : public SLeafWidget
+{
+public:
+
+	SLATE_BEGIN_ARGS(SCombatLifeBarLayer) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UCombatLifeBarSubsystem* InSubsystem)
+	{
+		Subsystem = InSubsystem;
+		SetVisibility(EVisibility::HitTestInvisible);
+	}
+
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override
+	{
+		const UCombatLifeBarSubsystem* LifeBars = Subsystem.Get();
+		if (!LifeBars)
+		{
+			return LayerId;
+		}
+
+		const FSlateBrush* Brush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+		const FVector2f Size(LifeBars->BarSize);
+		const FLinearColor BackgroundColor(0.0f, 0.0f, 0.0f, 0.6f);
+
+		for (const FCombatLifeBarDrawItem& Item : LifeBars->GetDrawItems())
+		{
+			const FVector2f TopLeft = FVector2f(Item.ScreenPosition) - Size * 0.5f;
+
+			// background, then fill on top
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId,
+				AllottedGeometry.ToPaintGeometry(Size, FSlateLayoutTransform(TopLeft)),
+				Brush, ESlateDrawEffect::None, BackgroundColor);
+
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 1,
+				AllottedGeometry.ToPaintGeometry(FVector2f(Size.X * Item.Percent, Size.Y), FSlateLayoutTransform(TopLeft)),
+				Brush, ESlateDrawEffect::None, Item.Color);
+		}
+
+		return LayerId + 1;
+	}
+
+private:
+
+	TWeakObjectPtr<const UCombatLifeBarSubsystem> Subsystem;
+};
+
+int32 UCombatLifeBarSubsystem::RegisterBar(USceneComponent* Anchor, const FLinearColor& Color)
+{
+	EnsureLayer();
+
+	FBar Bar;
+	Bar.Anchor = Anchor;
+	Bar.Color = Color;
+
+	// cull the newcomer on the next frame instead of waiting for the next pass
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->MarkJobDue(CullJob);
+	}
+
+	return Bars.Add(Bar);
+}
+
+void UCombatLifeBarSubsystem::UnregisterBar(int32 BarId)
+{
+	if (Bars.IsValidIndex(BarId))
+	{
+		Bars.RemoveAt(BarId);
+	}
+}
+
+void UCombatLifeBarSubsystem::SetBarPercentage(int32 BarId, float Percent)
+{
+	if (Bars.IsValidIndex(BarId))
+	{
+		Bars[BarId].Percent = FMath::Clamp(Percent, 0.0f, 1.0f);
+	}
+}
+
+void UCombatLifeBarSubsystem::SetBarColor(int32 BarId, const FLinearColor& Color)
+{
+	if (Bars.IsValidIndex(BarId))
+	{
+		Bars[BarId].Color = Color;
+	}
+}
+
+void UCombatLifeBarSubsystem::SetBarVisible(int32 BarId, bool bVisible)
+{
+	if (Bars.IsValidIndex(BarId))
+	{
+		Bars[BarId].bVisible = bVisible;
+	}
+}
+
+void UCombatLifeBarSubsystem::EnsureLayer()
+{
+	if (Layer.IsValid())
+	{
+		return;
+	}
+
+	UGameViewportClient* GameViewport = GetWorld()->GetGameViewport();
+	if (!GameViewport)
+	{
+		return;
+	}
+
+	// draw under the regular HUD widgets
+	Layer = SNew(SCombatLifeBarLayer, this);
+	GameViewport->AddViewportWidgetContent(Layer.ToSharedRef(), -10);
+}
+
+void UCombatLifeBarSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UCombatJobSchedulerSubsystem* Scheduler = Collection.InitializeDependency<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->RegisterJob<&UCombatLifeBarSubsystem::CullBars>(CullJob, this, CullInterval, ECombatJobPriority::Normal, TEXT("LifeBars.Cull"));
+	}
+}
+
+void UCombatLifeBarSubsystem::Deinitialize()
+{
+	if (UCombatJobSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UCombatJobSchedulerSubsystem>())
+	{
+		Scheduler->UnregisterJob(CullJob);
+	}
+
+	if (Layer.IsValid())
+	{
+		if (UGameViewportClient* GameViewport = GetWorld()->GetGameViewport())
+		{
+			GameViewport->RemoveViewportWidgetContent(Layer.ToSharedRef());
+		}
+		Layer.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void UCombatLifeBarSubsystem::CullBars(float DeltaTime)
+{
+	CulledBarIds.Reset();
+
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!PlayerController || !PlayerController->PlayerCameraManager)
+	{
+		return;
+	}
+
+	const FVector CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	const float MaxDistanceSquared = FMath::Square(MaxDrawDistance);
+
+	for (auto It = Bars.CreateConstIterator(); It; ++It)
+	{
+		const FBar& Bar = *It;
+		const USceneComponent* Anchor = Bar.Anchor.Get();
+		if (!Bar.bVisible || !Anchor)
+		{
+			continue;
+		}
+
+		// distance culling
+		if (FVector::DistSquared(Anchor->GetComponentLocation(), CameraLocation) > MaxDistanceSquared)
+		{
+			continue;
+		}
+
+		// occlusion culling: reuse the renderer's visibility result instead of tracing
+		// (tolerance covers the time until the next pass)
+		const AActor* Owner = Anchor->GetOwner();
+		if (!Owner || Owner->IsHidden() || !Owner->WasRecentlyRendered(OcclusionTolerance + CullInterval))
+		{
+			continue;
+		}
+
+		CulledBarIds.Add(It.GetIndex());
+	}
+}
+
+void UCombatLifeBarSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DrawItems.Reset();
+
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!PlayerController)
+	{
+		return;
+	}
+
+	// only the bars that passed the last culling pass follow their anchors this frame
+	for (const int32 BarId : CulledBarIds)
+	{
+		if (!Bars.IsValidIndex(BarId))
+		{
+			continue;
+		}
+
+		const FBar& Bar = Bars[BarId];
+		const USceneComponent* Anchor = Bar.Anchor.Get();
+		if (!Bar.bVisible || !Anchor)
+		{
+			continue;
+		}
+
+		const FVector WorldLocation = Anchor->GetComponentLocation();
+
+		FVector2D ScreenPosition;
+		if (!UWidgetLayoutLibrary::ProjectWorldLocationToWidgetPosition(PlayerController, WorldLocation, ScreenPosition, false))
+		{
+			continue;
+		}
+
+		FCombatLifeBarDrawItem& Item = DrawItems.AddDefaulted_GetRef();
+		Item.ScreenPosition = ScreenPosition;
+		Item.Percent = Bar.Percent;
+		Item.Color = Bar.Color;
+	}
+}
+
+bool UCombatLifeBarSubsystem::IsTickable() const
+{
+	return Bars.Num() > 0 || DrawItems.Num() > 0;
+}
+
+TStatId UCombatLifeBarSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatLifeBarSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "CombatLifeBarSubsystem.generated.h"
+
+class SCombatLifeBarLayer;
+
+/**
+ *  One bar ready to draw: where it goes on screen and what it shows
+ */
+struct FCombatLifeBarDrawItem
+{
+	/** Bar center, in viewport widget space */
+	FVector2D ScreenPosition = FVector2D::ZeroVector;
+
+	/** Fill amount (0-1) */
+	float Percent = 1.0f;
+
+	/** Fill color */
+	FLinearColor Color = FLinearColor::Red;
+};
+
+/**
+ *  Batched world-space life bars
+ *  Replaces one UWidgetComponent (and its render target) per character with a single viewport layer.
+ *  Distance and occlusion culling runs as a job on the combat job scheduler (every CullInterval);
+ *  each frame only the bars that survived it are projected to the screen and packed into one array
+ *  that the layer draws in a single paint pass.
+ *  Fill and color are only written when they change.
+ */
+UCLASS()
+class UCombatLifeBarSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 *  Adds a life bar that follows a scene component
+	 *  @param Anchor	component the bar is drawn over (e.g. the hidden life bar widget component)
+	 *  @param Color	fill color
+	 *  @return bar id for the other calls
+	 */
+	int32 RegisterBar(USceneComponent* Anchor, const FLinearColor& Color);
+
+	/** Removes a life bar */
+	void UnregisterBar(int32 BarId);
+
+	/** Sets a bar's 0-1 fill (no-op if unchanged) */
+	void SetBarPercentage(int32 BarId, float Percent);
+
+	/** Sets a bar's fill color (no-op if unchanged) */
+	void SetBarColor(int32 BarId, const FLinearColor& Color);
+
+	/** Shows or hides a bar (e.g. on death or while pooled) */
+	void SetBarVisible(int32 BarId, bool bVisible);
+
+	/** Bars visible after culling this frame */
+	TConstArrayView<FCombatLifeBarDrawItem> GetDrawItems() const { return DrawItems; }
+
+	/** Bars farther than this from the camera are not drawn */
+	float MaxDrawDistance = 2500.0f;
+
+	/** Bars whose owner was not rendered within this many seconds are treated as occluded */
+	float OcclusionTolerance = 0.1f;
+
+	/** Time between culling passes */
+	float CullInterval = 0.1f;
+
+	/** Drawn bar size, in viewport widget space */
+	FVector2D BarSize = FVector2D(80.0f, 8.0f);
+
+	// ~begin UTickableWorldSubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	// ~end UTickableWorldSubsystem interface
+
+protected:
+
+	/** Registered bar */
+	struct FBar
+	{
+		TWeakObjectPtr<USceneComponent> Anchor;
+		float Percent = 1.0f;
+		FLinearColor Color = FLinearColor::Red;
+		bool bVisible = true;
+	};
+
+	/** Adds the draw layer to the game viewport the first time a bar registers */
+	void EnsureLayer();
+
+	/** Scheduled job: rebuilds CulledBarIds from distance and occlusion */
+	void CullBars(float DeltaTime);
+
+	/** Registered bars (bar id = index) */
+	TSparseArray<FBar> Bars;
+
+	/** Bars that passed the last culling pass */
+	TArray<int32> CulledBarIds;
+
+	/** Packed bars drawn this frame */
+	TArray<FCombatLifeBarDrawItem> DrawItems;
+
+	/** Culling job on the combat job scheduler */
+	FCombatJobHandle CullJob;
+
+	/** Viewport layer drawing DrawItems */
+	TSharedPtr<SCombatLifeBarLayer> Layer;
+};
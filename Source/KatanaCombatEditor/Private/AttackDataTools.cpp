@@ -1,15 +1,26 @@
 ﻿// Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "AttackDataTools.h"
+#include "AttackSectionIndexSubsystem.h"
 #include "Data/AttackData.h"
+#include "Data/ComboGraphValidationCache.h"
 #include "Animation/AnimMontage.h"
 #include "Animation/AnimNotifyState_AttackPhase.h"
 #include "Animation/AnimNotifyState_ComboWindow.h"
 #include "Animation/AnimNotifyState_HoldWindow.h"
 #include "Animation/AnimNotify_ToggleHitDetection.h"
+#include "Animation/AnimNotify_AttackPhaseTransition.h"
+#include "Core/WeaponComponent.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/SkeletalMeshSocket.h"
 #include "CombatTypes.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
 #include "Misc/MessageDialog.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ScopedTransaction.h"
 
 #define LOCTEXT_NAMESPACE "FAttackDataTools"
 
@@ -25,33 +36,45 @@ bool UAttackDataTools::AutoCalculateTiming(UAttackData* AttackData)
         return false;
     }
 
-    const float SectionLength = AttackData->GetSectionLength();
-    if (SectionLength <= 0.0f)
+    if (!CalculateDefaultTiming(AttackData, AttackData->ManualTiming))
     {
         LogToolMessage(TEXT("AutoCalculateTiming: Invalid section length"), true);
         return false;
     }
 
+    // Manual timing is folded into the cooked block
+    AttackData->RefreshTimingCache();
+    AttackData->MarkPackageDirty();
+    LogToolMessage(FString::Printf(TEXT("AutoCalculateTiming: Success for %s"), *AttackData->GetName()));
+    
+    return true;
+}
+
+bool UAttackDataTools::CalculateDefaultTiming(const UAttackData* AttackData, FAttackPhaseTimingOverride& OutTiming)
+{
+    const float SectionLength = AttackData ? AttackData->GetSectionLength() : 0.0f;
+    if (SectionLength <= 0.0f)
+    {
+        return false;
+    }
+
     // Get default percentages based on attack type
     float WindupPercent, ActivePercent, RecoveryPercent;
     GetDefaultTimingPercentages(AttackData->AttackType, WindupPercent, ActivePercent, RecoveryPercent);
 
     // Calculate durations
-    FAttackPhaseTimingOverride& Timing = AttackData->ManualTiming;
-    Timing.WindupDuration = SectionLength * WindupPercent;
-    Timing.ActiveDuration = SectionLength * ActivePercent;
-    Timing.RecoveryDuration = SectionLength * RecoveryPercent;
+    OutTiming = AttackData->ManualTiming;
+    OutTiming.WindupDuration = SectionLength * WindupPercent;
+    OutTiming.ActiveDuration = SectionLength * ActivePercent;
+    OutTiming.RecoveryDuration = SectionLength * RecoveryPercent;
 
     // Configure hold window for light attacks
     if (AttackData->AttackType == EAttackType::Light && AttackData->bCanHold)
     {
-        Timing.HoldWindowStart = Timing.WindupDuration + Timing.ActiveDuration;
-        Timing.HoldWindowDuration = SectionLength * 0.1f; // 10% for hold
+        OutTiming.HoldWindowStart = OutTiming.WindupDuration + OutTiming.ActiveDuration;
+        OutTiming.HoldWindowDuration = SectionLength * 0.1f; // 10% for hold
     }
 
-    AttackData->MarkPackageDirty();
-    LogToolMessage(FString::Printf(TEXT("AutoCalculateTiming: Success for %s"), *AttackData->GetName()));
-    
     return true;
 }
 
@@ -154,6 +177,23 @@ bool UAttackDataTools::GenerateAttackPhaseNotifies(UAttackData* AttackData)
         return false;
     }
 
+    // Remove existing phase notifies
+    UAnimMontage* Montage = AttackData->AttackMontage;
+    RemoveNotifiesOfType(Montage, AttackData->MontageSection, UAnimNotifyState_AttackPhase::StaticClass());
+
+    if (!AppendAttackPhaseNotifies(AttackData))
+    {
+        return false;
+    }
+
+    MarkMontageModified(Montage);
+    LogToolMessage(FString::Printf(TEXT("GenerateAttackPhaseNotifies: Success for %s"), *AttackData->GetName()));
+    
+    return true;
+}
+
+bool UAttackDataTools::AppendAttackPhaseNotifies(UAttackData* AttackData)
+{
     // Ensure timing is calculated
     if (AttackData->ManualTiming.WindupDuration <= 0.0f)
     {
@@ -168,9 +208,6 @@ bool UAttackDataTools::GenerateAttackPhaseNotifies(UAttackData* AttackData)
     float SectionStart, SectionEnd;
     AttackData->GetSectionTimeRange(SectionStart, SectionEnd);
 
-    // Remove existing phase notifies
-    RemoveNotifiesOfType(Montage, AttackData->MontageSection, UAnimNotifyState_AttackPhase::StaticClass());
-
     // Add Windup
     UAnimNotifyState_AttackPhase* WindupNotify = NewObject<UAnimNotifyState_AttackPhase>(Montage);
     WindupNotify->Phase = EAttackPhase::Windup;
@@ -202,9 +239,6 @@ bool UAttackDataTools::GenerateAttackPhaseNotifies(UAttackData* AttackData)
         AddNotifyStateToMontage(Montage, SectionStart + Timing.HoldWindowStart, Timing.HoldWindowDuration, HoldNotify, AttackData->MontageSection);
     }
 
-    MarkMontageModified(Montage);
-    LogToolMessage(FString::Printf(TEXT("GenerateAttackPhaseNotifies: Success for %s"), *AttackData->GetName()));
-    
     return true;
 }
 
@@ -215,14 +249,28 @@ bool UAttackDataTools::GenerateHitDetectionNotifies(UAttackData* AttackData)
         return false;
     }
 
+    // Remove existing hit detection notifies
+    UAnimMontage* Montage = AttackData->AttackMontage;
+    RemoveNotifiesOfType(Montage, AttackData->MontageSection, UAnimNotify_ToggleHitDetection::StaticClass());
+
+    if (!AppendHitDetectionNotifies(AttackData))
+    {
+        return false;
+    }
+
+    MarkMontageModified(Montage);
+    LogToolMessage(FString::Printf(TEXT("GenerateHitDetectionNotifies: Success for %s"), *AttackData->GetName()));
+    
+    return true;
+}
+
+bool UAttackDataTools::AppendHitDetectionNotifies(UAttackData* AttackData)
+{
     UAnimMontage* Montage = AttackData->AttackMontage;
     const FAttackPhaseTimingOverride& Timing = AttackData->ManualTiming;
     float SectionStart, SectionEnd;
     AttackData->GetSectionTimeRange(SectionStart, SectionEnd);
 
-    // Remove existing hit detection notifies
-    RemoveNotifiesOfType(Montage, AttackData->MontageSection, UAnimNotify_ToggleHitDetection::StaticClass());
-
     // Add Enable notify at start of Active phase
     UAnimNotify_ToggleHitDetection* EnableNotify = NewObject<UAnimNotify_ToggleHitDetection>(Montage);
     EnableNotify->bEnable = true;
@@ -241,9 +289,6 @@ bool UAttackDataTools::GenerateHitDetectionNotifies(UAttackData* AttackData)
         return false;
     }
 
-    MarkMontageModified(Montage);
-    LogToolMessage(FString::Printf(TEXT("GenerateHitDetectionNotifies: Success for %s"), *AttackData->GetName()));
-    
     return true;
 }
 
@@ -254,14 +299,28 @@ bool UAttackDataTools::GenerateComboWindowNotify(UAttackData* AttackData)
         return false;
     }
 
+    // Remove existing combo window notifies
+    UAnimMontage* Montage = AttackData->AttackMontage;
+    RemoveNotifiesOfType(Montage, AttackData->MontageSection, UAnimNotifyState_ComboWindow::StaticClass());
+
+    if (!AppendComboWindowNotify(AttackData))
+    {
+        return false;
+    }
+
+    MarkMontageModified(Montage);
+    LogToolMessage(FString::Printf(TEXT("GenerateComboWindowNotify: Success for %s"), *AttackData->GetName()));
+    
+    return true;
+}
+
+bool UAttackDataTools::AppendComboWindowNotify(UAttackData* AttackData)
+{
     UAnimMontage* Montage = AttackData->AttackMontage;
     const FAttackPhaseTimingOverride& Timing = AttackData->ManualTiming;
     float SectionStart, SectionEnd;
     AttackData->GetSectionTimeRange(SectionStart, SectionEnd);
 
-    // Remove existing combo window notifies
-    RemoveNotifiesOfType(Montage, AttackData->MontageSection, UAnimNotifyState_ComboWindow::StaticClass());
-
     // Add combo window during recovery phase
     UAnimNotifyState_ComboWindow* ComboWindowNotify = NewObject<UAnimNotifyState_ComboWindow>(Montage);
     const float RecoveryStart = SectionStart + Timing.WindupDuration + Timing.ActiveDuration;
@@ -272,25 +331,84 @@ bool UAttackDataTools::GenerateComboWindowNotify(UAttackData* AttackData)
         return false;
     }
 
-    MarkMontageModified(Montage);
-    LogToolMessage(FString::Printf(TEXT("GenerateComboWindowNotify: Success for %s"), *AttackData->GetName()));
-    
     return true;
 }
 
 bool UAttackDataTools::GenerateAllNotifies(UAttackData* AttackData)
 {
-    if (!AttackData)
+    if (!AttackData || !AttackData->AttackMontage)
     {
+        LogToolMessage(TEXT("GenerateAllNotifies: Invalid AttackData or Montage"), true);
         return false;
     }
 
-    bool bSuccess = true;
-    bSuccess &= GenerateAttackPhaseNotifies(AttackData);
-    bSuccess &= GenerateHitDetectionNotifies(AttackData);
-    bSuccess &= GenerateComboWindowNotify(AttackData);
+    UAttackData* const Attacks[] = { AttackData };
+    return GenerateNotifiesForMontage(AttackData->AttackMontage, Attacks) == 1;
+}
+
+int32 UAttackDataTools::GenerateNotifiesForMontage(UAnimMontage* Montage, TConstArrayView<UAttackData*> Attacks)
+{
+    if (!Montage || Attacks.Num() == 0)
+    {
+        return 0;
+    }
+
+    Montage->Modify();
+
+    // Clear every generated notify in every section first, in one pass over the montage
+    TArray<FName, TInlineAllocator<8>> SectionNames;
+    for (const UAttackData* AttackData : Attacks)
+    {
+        SectionNames.AddUnique(AttackData->MontageSection);
+    }
+
+    UClass* const GeneratedClasses[] = {
+        UAnimNotifyState_AttackPhase::StaticClass(),
+        UAnimNotify_ToggleHitDetection::StaticClass(),
+        UAnimNotifyState_ComboWindow::StaticClass()
+    };
+    RemoveNotifiesOfTypes(Montage, SectionNames, GeneratedClasses);
+
+    // Then append each attack's notifies (attacks sharing a section: the last one wins, as when generated one by one)
+    int32 NumGenerated = 0;
+    TArray<bool, TInlineAllocator<8>> Generated;
+    Generated.SetNumZeroed(Attacks.Num());
+    for (int32 Index = 0; Index < Attacks.Num(); ++Index)
+    {
+        UAttackData* AttackData = Attacks[Index];
+        const bool bLaterUserOfSection = Attacks.RightChop(Index + 1).ContainsByPredicate([AttackData](const UAttackData* Other)
+        {
+            return Other->MontageSection == AttackData->MontageSection;
+        });
+        if (bLaterUserOfSection)
+        {
+            Generated[Index] = true;
+            continue;
+        }
+
+        bool bSuccess = true;
+        bSuccess &= AppendAttackPhaseNotifies(AttackData);
+        bSuccess &= AppendHitDetectionNotifies(AttackData);
+        bSuccess &= AppendComboWindowNotify(AttackData);
+        Generated[Index] = bSuccess;
+    }
+
+    // One sort/refresh for the montage, then the cooked blocks read the final notifies
+    MarkMontageModified(Montage);
+
+    for (int32 Index = 0; Index < Attacks.Num(); ++Index)
+    {
+        // Notifies moved - keep the cooked block in step
+        RefreshTimingCache(Attacks[Index]);
+
+        if (Generated[Index])
+        {
+            ++NumGenerated;
+            LogToolMessage(FString::Printf(TEXT("GenerateAllNotifies: Success for %s"), *Attacks[Index]->GetName()));
+        }
+    }
 
-    return bSuccess;
+    return NumGenerated;
 }
 
 // ============================================================================
@@ -346,23 +464,32 @@ TArray<UAttackData*> UAttackDataTools::FindSectionConflicts(UAttackData* AttackD
         return Conflicts;
     }
 
-    const TArray<UAttackData*> AllAttacks = FindAllAttackDataAssets();
-    
-    for (UAttackData* OtherAttack : AllAttacks)
+    // Reverse index answers without touching the registry
+    if (const UAttackSectionIndexSubsystem* SectionIndex = UAttackSectionIndexSubsystem::Get())
     {
-        if (OtherAttack == AttackData || !OtherAttack)
-        {
-            continue;
-        }
-
-        if (OtherAttack->AttackMontage == AttackData->AttackMontage &&
-            OtherAttack->MontageSection == AttackData->MontageSection)
+        if (SectionIndex->IsIndexBuilt())
         {
-            Conflicts.Add(OtherAttack);
+            return SectionIndex->FindOtherUsersOfSection(AttackData);
         }
     }
 
-    return Conflicts;
+    const FSoftObjectPath SelfPath(AttackData);
+    const FString MontagePath = FSoftObjectPath(AttackData->AttackMontage.Get()).ToString();
+    const FName SectionName = AttackData->MontageSection;
+
+    return FindAttackDataByRegistryTags(
+        [&](const FAssetData& AssetData)
+        {
+            return AssetData.GetSoftObjectPath() != SelfPath
+                && AssetData.GetTagValueRef<FString>(UAttackData::AttackMontageTagName) == MontagePath
+                && AssetData.GetTagValueRef<FName>(UAttackData::MontageSectionTagName) == SectionName;
+        },
+        [AttackData](const UAttackData* OtherAttack)
+        {
+            return OtherAttack != AttackData
+                && OtherAttack->AttackMontage == AttackData->AttackMontage
+                && OtherAttack->MontageSection == AttackData->MontageSection;
+        });
 }
 
 bool UAttackDataTools::HasValidNotifyTiming(UAttackData* AttackData)
@@ -387,12 +514,7 @@ bool UAttackDataTools::ValidateAttackData(UAttackData* AttackData, TArray<FText>
         return false;
     }
 
-    // Check montage section
-    FText SectionError;
-    if (!ValidateMontageSection(AttackData, SectionError))
-    {
-        OutErrors.Add(SectionError);
-    }
+    AnalyzeAttackData(AttackData, OutWarnings, OutErrors);
 
     // Check for conflicts
     const TArray<UAttackData*> Conflicts = FindSectionConflicts(AttackData);
@@ -404,19 +526,80 @@ bool UAttackDataTools::ValidateAttackData(UAttackData* AttackData, TArray<FText>
         ));
     }
 
+    return OutErrors.Num() == 0;
+}
+
+void UAttackDataTools::AnalyzeAttackData(UAttackData* AttackData, TArray<FText>& OutWarnings, TArray<FText>& OutErrors)
+{
+    if (!AttackData)
+    {
+        OutErrors.Add(LOCTEXT("ValidateNullData", "AttackData is null"));
+        return;
+    }
+
+    // Check montage section
+    FText SectionError;
+    if (!ValidateMontageSection(AttackData, SectionError))
+    {
+        OutErrors.Add(SectionError);
+    }
+
     // Check timing
     if (AttackData->bUseAnimNotifyTiming && !HasValidNotifyTiming(AttackData))
     {
         OutWarnings.Add(LOCTEXT("ValidateNoNotifies", "No AnimNotifyState timing found in section"));
     }
 
+    // Check cooked timing (stale blocks are regenerated on save)
+    if (!IsTimingCacheCurrent(AttackData))
+    {
+        OutWarnings.Add(LOCTEXT("ValidateStaleTimingCache", "Cooked timing block is out of date with the montage (resave the asset)"));
+    }
+
+    // Check baked swing volume (not regenerated on save - sampling needs a mesh)
+    if (AttackData->SwingVolume.GetNumSamples() > 0 && !AttackData->GetSwingVolume())
+    {
+        OutWarnings.Add(LOCTEXT("ValidateStaleSwingVolume", "Baked swing volume is out of date with the montage (rebake it)"));
+    }
+
     // Check combos
     if (AttackData->NextComboAttack && !AttackData->NextComboAttack->AttackMontage)
     {
         OutErrors.Add(LOCTEXT("ValidateInvalidCombo", "NextComboAttack has no montage assigned"));
     }
 
-    return OutErrors.Num() == 0;
+    // Check combo graph (hard links only - no loads; memoized across assets)
+    FComboGraphValidationCache::Get().GetCycleErrors(AttackData, OutErrors);
+
+    // Check capability tags against the links
+    AttackData->ValidateDirectionalFollowUps(OutErrors);
+    AttackData->ValidateTerminalTag(OutErrors);
+}
+
+bool UAttackDataTools::IsTimingCacheCurrent(UAttackData* AttackData)
+{
+    if (!AttackData)
+    {
+        return false;
+    }
+
+    FAttackTimingCache Fresh;
+    AttackData->BuildTimingCache(Fresh);
+    return AttackData->TimingCache.Matches(Fresh);
+}
+
+bool UAttackDataTools::RefreshTimingCache(UAttackData* AttackData)
+{
+    if (!AttackData || IsTimingCacheCurrent(AttackData))
+    {
+        return false;
+    }
+
+    AttackData->Modify();
+    AttackData->RefreshTimingCache();
+    LogToolMessage(FString::Printf(TEXT("RefreshTimingCache: Regenerated cooked timing for %s"), *AttackData->GetName()));
+
+    return true;
 }
 
 // ============================================================================
@@ -588,55 +771,355 @@ TArray<UAttackData*> UAttackDataTools::FindAllAttackDataAssets()
     return FoundAssets;
 }
 
+void UAttackDataTools::GetAllAttackDataAssetData(TArray<FAssetData>& OutAssetData)
+{
+    OutAssetData.Reset();
+
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    AssetRegistryModule.Get().GetAssetsByClass(UAttackData::StaticClass()->GetClassPathName(), OutAssetData, true);
+}
+
+TArray<UAttackData*> UAttackDataTools::FindAttackDataLinkingTo(UAttackData* AttackData)
+{
+    if (!AttackData)
+    {
+        return TArray<UAttackData*>();
+    }
+
+    const FString TargetPath = FSoftObjectPath(AttackData).ToString();
+
+    return FindAttackDataByRegistryTags(
+        [&TargetPath](const FAssetData& AssetData)
+        {
+            TArray<FString> Links;
+            AssetData.GetTagValueRef<FString>(UAttackData::ComboLinksTagName).ParseIntoArray(Links, TEXT(";"));
+            return Links.Contains(TargetPath);
+        },
+        [AttackData](const UAttackData* OtherAttack)
+        {
+            bool bLinks = false;
+            OtherAttack->ForEachComboLink([AttackData, &bLinks](const FSoftObjectPath& SoftPath, UAttackData* Attack)
+            {
+                bLinks |= (Attack == AttackData) || (SoftPath == FSoftObjectPath(AttackData));
+            });
+            return bLinks;
+        });
+}
+
 TArray<UAttackData*> UAttackDataTools::FindAttackDataUsingMontage(UAnimMontage* Montage)
 {
-    TArray<UAttackData*> FoundAssets;
-    
     if (!Montage)
     {
-        return FoundAssets;
+        return TArray<UAttackData*>();
     }
 
-    const TArray<UAttackData*> AllAttacks = FindAllAttackDataAssets();
-    for (UAttackData* AttackData : AllAttacks)
+    const FString MontagePath = FSoftObjectPath(Montage).ToString();
+
+    return FindAttackDataByRegistryTags(
+        [&MontagePath](const FAssetData& AssetData)
+        {
+            return AssetData.GetTagValueRef<FString>(UAttackData::AttackMontageTagName) == MontagePath;
+        },
+        [Montage](const UAttackData* AttackData)
+        {
+            return AttackData->AttackMontage == Montage;
+        });
+}
+
+TArray<UAttackData*> UAttackDataTools::FindAttackDataByType(EAttackType AttackType)
+{
+    const FString TypeName = StaticEnum<EAttackType>()->GetNameStringByValue(static_cast<int64>(AttackType));
+
+    return FindAttackDataByRegistryTags(
+        [&TypeName](const FAssetData& AssetData)
+        {
+            return AssetData.GetTagValueRef<FString>(UAttackData::AttackTypeTagName) == TypeName;
+        },
+        [AttackType](const UAttackData* AttackData)
+        {
+            return AttackData->AttackType == AttackType;
+        });
+}
+
+// ============================================================================
+// BATCH OPERATIONS
+// ============================================================================
+
+bool UAttackDataTools::BatchGenerateNotifies(const TArray<UAttackData*>& AttackDataArray, int32& OutSuccessCount, int32& OutFailureCount)
+{
+    OutSuccessCount = 0;
+    OutFailureCount = 0;
+
+    const int32 NumAssets = AttackDataArray.Num();
+    FScopedSlowTask SlowTask(static_cast<float>(NumAssets * 2), LOCTEXT("BatchGenerateNotifies", "Generating attack notifies..."));
+    SlowTask.MakeDialogDelayed(0.5f);
+
+    // Workers: section validation and timing planning (nothing is written)
+    TArray<FAttackPhaseTimingOverride> PlannedTiming;
+    PlannedTiming.SetNum(NumAssets);
+    TArray<uint8> PlanResults; // 0 = skip, 1 = use ManualTiming, 2 = apply PlannedTiming
+    PlanResults.SetNumZeroed(NumAssets);
+
+    ParallelFor(NumAssets, [&AttackDataArray, &PlannedTiming, &PlanResults](int32 Index)
     {
-        if (AttackData && AttackData->AttackMontage == Montage)
+        UAttackData* AttackData = AttackDataArray[Index];
+        FText SectionError;
+        if (!ValidateMontageSection(AttackData, SectionError))
         {
-            FoundAssets.Add(AttackData);
+            return;
+        }
+
+        if (AttackData->ManualTiming.WindupDuration > 0.0f)
+        {
+            PlanResults[Index] = 1;
+        }
+        else if (CalculateDefaultTiming(AttackData, PlannedTiming[Index]))
+        {
+            PlanResults[Index] = 2;
         }
+    });
+    SlowTask.EnterProgressFrame(static_cast<float>(NumAssets));
+
+    // Game thread: every asset/montage edit lands in a single undo step
+    const FScopedTransaction Transaction(LOCTEXT("BatchGenerateNotifiesTransaction", "Batch Generate Attack Notifies"));
+
+    // Attacks sharing a montage (section-based) are generated together: one Modify, removal pass and refresh per montage
+    TMap<UAnimMontage*, TArray<UAttackData*, TInlineAllocator<8>>> MontageAttacks;
+    for (int32 Index = 0; Index < NumAssets; ++Index)
+    {
+        UAttackData* AttackData = AttackDataArray[Index];
+        if (PlanResults[Index] == 0)
+        {
+            OutFailureCount++;
+            continue;
+        }
+
+        if (PlanResults[Index] == 2)
+        {
+            AttackData->Modify();
+            AttackData->ManualTiming = PlannedTiming[Index];
+        }
+
+        MontageAttacks.FindOrAdd(AttackData->AttackMontage).Add(AttackData);
     }
+    SlowTask.EnterProgressFrame(static_cast<float>(OutFailureCount));
 
-    return FoundAssets;
+    for (const TPair<UAnimMontage*, TArray<UAttackData*, TInlineAllocator<8>>>& Pair : MontageAttacks)
+    {
+        SlowTask.EnterProgressFrame(static_cast<float>(Pair.Value.Num()));
+
+        const int32 NumGenerated = GenerateNotifiesForMontage(Pair.Key, Pair.Value);
+        OutSuccessCount += NumGenerated;
+        OutFailureCount += Pair.Value.Num() - NumGenerated;
+    }
+
+    return OutSuccessCount > 0;
 }
 
-TArray<UAttackData*> UAttackDataTools::FindAttackDataByType(EAttackType AttackType)
+void UAttackDataTools::BatchValidate(const TArray<UAttackData*>& AttackDataArray, TArray<UAttackData*>& OutValidAssets, TArray<UAttackData*>& OutInvalidAssets)
 {
-    TArray<UAttackData*> FoundAssets;
+    OutValidAssets.Empty();
+    OutInvalidAssets.Empty();
+
+    const int32 NumAssets = AttackDataArray.Num();
+    FScopedSlowTask SlowTask(static_cast<float>(NumAssets), LOCTEXT("BatchValidate", "Validating attack data..."));
+    SlowTask.MakeDialogDelayed(0.5f);
 
-    const TArray<UAttackData*> AllAttacks = FindAllAttackDataAssets();
-    for (UAttackData* AttackData : AllAttacks)
+    // Workers: read-only checks; validity only depends on errors
+    TArray<FAttackDataValidationResult> Results;
+    BatchAnalyze(AttackDataArray, Results);
+    SlowTask.EnterProgressFrame(static_cast<float>(NumAssets));
+
+    for (const FAttackDataValidationResult& Result : Results)
     {
-        if (AttackData && AttackData->AttackType == AttackType)
-        {
-            FoundAssets.Add(AttackData);
-        }
+        (Result.IsValid() ? OutValidAssets : OutInvalidAssets).Add(Result.AttackData);
+    }
+}
+
+void UAttackDataTools::BatchAnalyze(const TArray<UAttackData*>& AttackDataArray, TArray<FAttackDataValidationResult>& OutResults)
+{
+    OutResults.Reset();
+    OutResults.SetNum(AttackDataArray.Num());
+
+    // Walk the combo graph once up front so workers only read cached results
+    for (const UAttackData* AttackData : AttackDataArray)
+    {
+        FComboGraphValidationCache::Get().ReachesCycle(AttackData);
     }
 
-    return FoundAssets;
+    ParallelFor(AttackDataArray.Num(), [&AttackDataArray, &OutResults](int32 Index)
+    {
+        FAttackDataValidationResult& Result = OutResults[Index];
+        Result.AttackData = AttackDataArray[Index];
+        AnalyzeAttackData(Result.AttackData, Result.Warnings, Result.Errors);
+    });
 }
 
 // ============================================================================
-// BATCH OPERATIONS
+// SWING VOLUMES
 // ============================================================================
 
-bool UAttackDataTools::BatchGenerateNotifies(const TArray<UAttackData*>& AttackDataArray, int32& OutSuccessCount, int32& OutFailureCount)
+namespace
+{
+    /**
+     * Component-space transform of a mesh bone in the montage pose at MontageTime
+     * Walks the parent chain over the playing animation's bone tracks (reference pose for bones it doesn't animate)
+     */
+    FTransform EvaluateMontageBone(const UAnimMontage* Montage, const USkeletalMesh* Mesh, int32 MeshBoneIndex, float MontageTime)
+    {
+        const FReferenceSkeleton& RefSkeleton = Mesh->GetRefSkeleton();
+        const TArray<FTransform>& RefPose = RefSkeleton.GetRefBonePose();
+        const USkeleton* Skeleton = Mesh->GetSkeleton();
+
+        // Montage time -> the segment playing on the first slot, in that animation's own time
+        const UAnimSequence* Sequence = nullptr;
+        float AnimTime = 0.0f;
+        if (Montage->SlotAnimTracks.Num() > 0)
+        {
+            if (const FAnimSegment* Segment = Montage->SlotAnimTracks[0].AnimTrack.GetSegmentAtTime(MontageTime))
+            {
+                Sequence = Cast<UAnimSequence>(Segment->GetAnimReference());
+                AnimTime = Segment->ConvertTrackPosToAnimPos(MontageTime);
+            }
+        }
+
+        // Root motion goes to the actor at runtime - the mesh root stays at its reference pose
+        const bool bLockRoot = Montage->HasRootMotion();
+        const FAnimExtractContext ExtractContext(static_cast<double>(AnimTime));
+
+        FTransform ComponentTransform = FTransform::Identity;
+        for (int32 BoneIndex = MeshBoneIndex; BoneIndex != INDEX_NONE; BoneIndex = RefSkeleton.GetParentIndex(BoneIndex))
+        {
+            FTransform LocalTransform = RefPose[BoneIndex];
+
+            const int32 SkeletonBoneIndex = Skeleton ? Skeleton->GetSkeletonBoneIndexFromMeshBoneIndex(Mesh, FMeshPoseBoneIndex(BoneIndex)) : INDEX_NONE;
+            const bool bAnimated = Sequence && SkeletonBoneIndex != INDEX_NONE && !(bLockRoot && BoneIndex == 0)
+                && Sequence->GetDataModelInterface()->IsValidBoneTrackName(RefSkeleton.GetBoneName(BoneIndex));
+            if (bAnimated)
+            {
+                Sequence->GetBoneTransform(LocalTransform, FSkeletonPoseBoneIndex(SkeletonBoneIndex), ExtractContext, false);
+            }
+
+            ComponentTransform = ComponentTransform * LocalTransform;
+        }
+
+        return ComponentTransform;
+    }
+
+    /** Component-space location of a mesh socket (or a bone of that name) in the montage pose */
+    bool EvaluateMontageSocket(const UAnimMontage* Montage, const USkeletalMesh* Mesh, FName SocketName, float MontageTime, FVector& OutLocation)
+    {
+        FTransform SocketTransform = FTransform::Identity;
+        FName BoneName = SocketName;
+        if (const USkeletalMeshSocket* Socket = Mesh->FindSocket(SocketName))
+        {
+            SocketTransform = Socket->GetSocketLocalTransform();
+            BoneName = Socket->BoneName;
+        }
+
+        const int32 BoneIndex = Mesh->GetRefSkeleton().FindBoneIndex(BoneName);
+        if (BoneIndex == INDEX_NONE)
+        {
+            return false;
+        }
+
+        OutLocation = (SocketTransform * EvaluateMontageBone(Montage, Mesh, BoneIndex, MontageTime)).GetLocation();
+        return true;
+    }
+}
+
+bool UAttackDataTools::BakeSwingVolume(UAttackData* AttackData, USkeletalMesh* Mesh, FName StartSocket, FName EndSocket, float SampleRate)
+{
+    if (!AttackData || !AttackData->AttackMontage)
+    {
+        LogToolMessage(TEXT("BakeSwingVolume: Invalid AttackData or Montage"), true);
+        return false;
+    }
+
+    UAnimMontage* Montage = AttackData->AttackMontage;
+    if (!Mesh)
+    {
+        Mesh = Montage->GetPreviewMesh();
+        if (!Mesh && Montage->GetSkeleton())
+        {
+            Mesh = Montage->GetSkeleton()->GetPreviewMesh();
+        }
+    }
+
+    if (!Mesh)
+    {
+        LogToolMessage(FString::Printf(TEXT("BakeSwingVolume: %s has no mesh to sample (set a preview mesh on the montage or skeleton)"), *AttackData->GetName()), true);
+        return false;
+    }
+
+    float ActiveStart, ActiveEnd;
+    if (!GetActiveTimeRange(AttackData, ActiveStart, ActiveEnd))
+    {
+        LogToolMessage(FString::Printf(TEXT("BakeSwingVolume: %s has no Active phase in its section"), *AttackData->GetName()), true);
+        return false;
+    }
+
+    // Sockets and radius the weapon traces with unless told otherwise
+    const UWeaponComponent* WeaponDefaults = GetDefault<UWeaponComponent>();
+    StartSocket = StartSocket.IsNone() ? WeaponDefaults->WeaponStartSocket : StartSocket;
+    EndSocket = EndSocket.IsNone() ? WeaponDefaults->WeaponEndSocket : EndSocket;
+
+    // One interval either side: sweeps start from the pose of the frame before the window opens
+    const float Interval = 1.0f / FMath::Max(SampleRate, 1.0f);
+    const float SectionLength = AttackData->GetSectionLength();
+    const float FirstTime = FMath::Max(ActiveStart - Interval, 0.0f);
+    const float LastTime = FMath::Min(ActiveEnd + Interval, Montage->CalculateSequenceLength());
+    const int32 NumSamples = FMath::Max(FMath::CeilToInt((LastTime - FirstTime) / Interval), 1) + 1;
+
+    TArray<FVector> Starts;
+    TArray<FVector> Tips;
+    Starts.SetNum(NumSamples);
+    Tips.SetNum(NumSamples);
+
+    for (int32 Index = 0; Index < NumSamples; ++Index)
+    {
+        const float Time = FMath::Lerp(FirstTime, LastTime, static_cast<float>(Index) / static_cast<float>(NumSamples - 1));
+        if (!EvaluateMontageSocket(Montage, Mesh, StartSocket, Time, Starts[Index]) || !EvaluateMontageSocket(Montage, Mesh, EndSocket, Time, Tips[Index]))
+        {
+            LogToolMessage(FString::Printf(TEXT("BakeSwingVolume: %s lacks socket '%s' or '%s'"), *Mesh->GetName(), *StartSocket.ToString(), *EndSocket.ToString()), true);
+            return false;
+        }
+    }
+
+    AttackData->Modify();
+    FAttackSwingVolume& SwingVolume = AttackData->SwingVolume;
+    SwingVolume.Build(Starts, Tips, WeaponDefaults->TraceRadius);
+    SwingVolume.SourceMontage = Montage;
+    SwingVolume.SourceSection = AttackData->MontageSection;
+    SwingVolume.StartSocket = StartSocket;
+    SwingVolume.EndSocket = EndSocket;
+    SwingVolume.SampleInterval = (LastTime - FirstTime) / static_cast<float>(NumSamples - 1);
+    SwingVolume.StartTime = FirstTime;
+    SwingVolume.WindowStartTime = ActiveStart;
+    AttackData->MarkPackageDirty();
+
+    const FVector Size = SwingVolume.Bounds.GetSize();
+    LogToolMessage(FString::Printf(TEXT("BakeSwingVolume: %s - %d samples over %.2fs of %.2fs, bounds %.0f x %.0f x %.0f cm"),
+        *AttackData->GetName(), NumSamples, LastTime - FirstTime, SectionLength, Size.X, Size.Y, Size.Z));
+
+    return true;
+}
+
+bool UAttackDataTools::BatchBakeSwingVolumes(const TArray<UAttackData*>& AttackDataArray, int32& OutSuccessCount, int32& OutFailureCount)
 {
     OutSuccessCount = 0;
     OutFailureCount = 0;
 
+    FScopedSlowTask SlowTask(static_cast<float>(AttackDataArray.Num()), LOCTEXT("BatchBakeSwingVolumes", "Baking swing volumes..."));
+    SlowTask.MakeDialogDelayed(0.5f);
+
+    const FScopedTransaction Transaction(LOCTEXT("BatchBakeSwingVolumesTransaction", "Batch Bake Swing Volumes"));
+
     for (UAttackData* AttackData : AttackDataArray)
     {
-        if (GenerateAllNotifies(AttackData))
+        SlowTask.EnterProgressFrame(1.0f);
+
+        if (BakeSwingVolume(AttackData))
         {
             OutSuccessCount++;
         }
@@ -646,32 +1129,219 @@ bool UAttackDataTools::BatchGenerateNotifies(const TArray<UAttackData*>& AttackD
         }
     }
 
+    LogToolMessage(FString::Printf(TEXT("BatchBakeSwingVolumes: %d succeeded, %d failed"), OutSuccessCount, OutFailureCount));
     return OutSuccessCount > 0;
 }
 
-void UAttackDataTools::BatchValidate(const TArray<UAttackData*>& AttackDataArray, TArray<UAttackData*>& OutValidAssets, TArray<UAttackData*>& OutInvalidAssets)
+// ============================================================================
+// COST REPORTS
+// ============================================================================
+
+void UAttackDataTools::BuildMontageNotifyReports(const TArray<UAttackData*>& AttackDataArray, float ReferenceFrameRate, TArray<FMontageNotifyCostReport>& OutReports)
 {
-    OutValidAssets.Empty();
-    OutInvalidAssets.Empty();
+    OutReports.Reset();
 
+    TMap<UAnimMontage*, int32> ReportIndices;
     for (UAttackData* AttackData : AttackDataArray)
     {
-        TArray<FText> Warnings, Errors;
-        if (ValidateAttackData(AttackData, Warnings, Errors))
+        if (!AttackData || !AttackData->AttackMontage)
         {
-            OutValidAssets.Add(AttackData);
+            continue;
+        }
+
+        const int32* ExistingIndex = ReportIndices.Find(AttackData->AttackMontage);
+        const int32 ReportIndex = ExistingIndex ? *ExistingIndex : ReportIndices.Add(AttackData->AttackMontage, OutReports.AddDefaulted());
+        OutReports[ReportIndex].Montage = AttackData->AttackMontage;
+        OutReports[ReportIndex].Attacks.Add(AttackData);
+    }
+
+    const int32 MaxSweepSubsteps = GetDefault<UWeaponComponent>()->MaxSweepSubsteps;
+    ParallelFor(OutReports.Num(), [&OutReports, ReferenceFrameRate, MaxSweepSubsteps](int32 Index)
+    {
+        AnalyzeMontageNotifies(OutReports[Index], ReferenceFrameRate, MaxSweepSubsteps);
+    });
+
+    OutReports.Sort([](const FMontageNotifyCostReport& A, const FMontageNotifyCostReport& B)
+    {
+        return A.EstimatedTracesPerSwing > B.EstimatedTracesPerSwing;
+    });
+}
+
+FString UAttackDataTools::GetMontageNotifyReport(float ReferenceFrameRate)
+{
+    TArray<FMontageNotifyCostReport> Reports;
+    BuildMontageNotifyReports(FindAllAttackDataAssets(), ReferenceFrameRate, Reports);
+
+    FString Report = FString::Printf(TEXT("Montage notify cost report (%d montages, %.0f fps)\n"), Reports.Num(), ReferenceFrameRate);
+    for (const FMontageNotifyCostReport& Entry : Reports)
+    {
+        Report += FString::Printf(
+            TEXT("%s: %d attacks, %d notifies, %d states, peak %d/frame at %.2fs, %d swings, %.2fs traced%s, ~%.0f traces/swing (worst %.0f)\n"),
+            *Entry.Montage->GetName(), Entry.Attacks.Num(), Entry.NumNotifies, Entry.NumNotifyStates,
+            Entry.PeakNotifiesPerFrame, Entry.PeakFrameTime, Entry.NumSwings, Entry.HitDetectionTime,
+            Entry.bHitDetectionFromPhases ? TEXT(" (from Active phase)") : TEXT(""),
+            Entry.EstimatedTracesPerSwing, Entry.WorstCaseTracesPerSwing);
+    }
+
+    LogToolMessage(Report);
+    return Report;
+}
+
+void UAttackDataTools::AnalyzeMontageNotifies(FMontageNotifyCostReport& Report, float ReferenceFrameRate, int32 MaxSweepSubsteps)
+{
+    const UAnimMontage* Montage = Report.Montage;
+    if (!Montage)
+    {
+        return;
+    }
+
+    const float MontageLength = Montage->GetPlayLength();
+    const double SamplingRate = FMath::Max(Montage->GetSamplingFrameRate().AsDecimal(), 1.0);
+    const int32 NumFrames = FMath::Max(FMath::CeilToInt32(MontageLength * SamplingRate), 1);
+
+    // Per-frame overlap via a difference array over frame indices
+    TArray<int32> FrameDeltas;
+    FrameDeltas.SetNumZeroed(NumFrames + 1);
+
+    TArray<TPair<float, bool>> Toggles;
+    TArray<TPair<float, float>> ActivePhases;
+    TArray<TPair<float, EAttackPhase>> PhaseTransitions;
+
+    for (const FAnimNotifyEvent& NotifyEvent : Montage->Notifies)
+    {
+        const float StartTime = NotifyEvent.GetTriggerTime();
+        float EndTime = StartTime;
+
+        if (NotifyEvent.NotifyStateClass)
+        {
+            Report.NumNotifyStates++;
+            EndTime = NotifyEvent.GetEndTriggerTime();
+
+            if (const UAnimNotifyState_AttackPhase* PhaseNotify = Cast<UAnimNotifyState_AttackPhase>(NotifyEvent.NotifyStateClass))
+            {
+                if (PhaseNotify->Phase == EAttackPhase::Active)
+                {
+                    ActivePhases.Emplace(StartTime, EndTime);
+                }
+            }
+        }
+        else if (NotifyEvent.Notify)
+        {
+            Report.NumNotifies++;
+
+            if (const UAnimNotify_ToggleHitDetection* Toggle = Cast<UAnimNotify_ToggleHitDetection>(NotifyEvent.Notify))
+            {
+                Toggles.Emplace(StartTime, Toggle->bEnable);
+            }
+            else if (const UAnimNotify_AttackPhaseTransition* Transition = Cast<UAnimNotify_AttackPhaseTransition>(NotifyEvent.Notify))
+            {
+                PhaseTransitions.Emplace(StartTime, Transition->TransitionToPhase);
+            }
         }
         else
         {
-            OutInvalidAssets.Add(AttackData);
+            continue;
+        }
+
+        const int32 StartFrame = FMath::Clamp(FMath::FloorToInt32(StartTime * SamplingRate), 0, NumFrames - 1);
+        const int32 EndFrame = FMath::Clamp(FMath::FloorToInt32(EndTime * SamplingRate), StartFrame, NumFrames - 1);
+        FrameDeltas[StartFrame]++;
+        FrameDeltas[EndFrame + 1]--;
+    }
+
+    int32 Running = 0;
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        Running += FrameDeltas[Frame];
+        if (Running > Report.PeakNotifiesPerFrame)
+        {
+            Report.PeakNotifiesPerFrame = Running;
+            Report.PeakFrameTime = static_cast<float>(Frame / SamplingRate);
+        }
+    }
+
+    // Hit detection windows: explicit toggles win; otherwise the Active phase drives tracing
+    TArray<TPair<float, float>> Windows;
+
+    Toggles.Sort([](const TPair<float, bool>& A, const TPair<float, bool>& B) { return A.Key < B.Key; });
+    float EnabledAt = -1.0f;
+    for (const TPair<float, bool>& Toggle : Toggles)
+    {
+        if (Toggle.Value && EnabledAt < 0.0f)
+        {
+            EnabledAt = Toggle.Key;
+        }
+        else if (!Toggle.Value && EnabledAt >= 0.0f)
+        {
+            Windows.Emplace(EnabledAt, Toggle.Key);
+            EnabledAt = -1.0f;
+        }
+    }
+    if (EnabledAt >= 0.0f)
+    {
+        Windows.Emplace(EnabledAt, MontageLength);
+    }
+
+    if (Windows.Num() == 0)
+    {
+        Report.bHitDetectionFromPhases = true;
+        Windows = ActivePhases;
+
+        PhaseTransitions.Sort([](const TPair<float, EAttackPhase>& A, const TPair<float, EAttackPhase>& B) { return A.Key < B.Key; });
+        for (int32 Index = 0; Index < PhaseTransitions.Num(); ++Index)
+        {
+            if (PhaseTransitions[Index].Value == EAttackPhase::Active)
+            {
+                const float EndTime = PhaseTransitions.IsValidIndex(Index + 1) ? PhaseTransitions[Index + 1].Key : MontageLength;
+                Windows.Emplace(PhaseTransitions[Index].Key, EndTime);
+            }
         }
     }
+
+    Report.NumSwings = Windows.Num();
+    for (const TPair<float, float>& Window : Windows)
+    {
+        Report.HitDetectionTime += FMath::Max(Window.Value - Window.Key, 0.0f);
+    }
+
+    if (Report.NumSwings > 0)
+    {
+        const float TimePerSwing = Report.HitDetectionTime / Report.NumSwings;
+        Report.EstimatedTracesPerSwing = FMath::CeilToFloat(TimePerSwing * ReferenceFrameRate);
+        Report.WorstCaseTracesPerSwing = Report.EstimatedTracesPerSwing * FMath::Max(MaxSweepSubsteps, 1);
+    }
 }
 
 // ============================================================================
 // INTERNAL HELPERS
 // ============================================================================
 
+TArray<UAttackData*> UAttackDataTools::FindAttackDataByRegistryTags(TFunctionRef<bool(const FAssetData&)> TagFilter, TFunctionRef<bool(const UAttackData*)> LoadedFilter)
+{
+    TArray<UAttackData*> FoundAssets;
+
+    TArray<FAssetData> AssetDataList;
+    GetAllAttackDataAssetData(AssetDataList);
+
+    for (const FAssetData& AssetData : AssetDataList)
+    {
+        // Every tag is written together - no AttackType tag means the asset predates them
+        const bool bTagged = AssetData.FindTag(UAttackData::AttackTypeTagName);
+        if (bTagged && !TagFilter(AssetData))
+        {
+            continue;
+        }
+
+        UAttackData* AttackData = Cast<UAttackData>(AssetData.GetAsset());
+        if (AttackData && (bTagged || LoadedFilter(AttackData)))
+        {
+            FoundAssets.Add(AttackData);
+        }
+    }
+
+    return FoundAssets;
+}
+
 bool UAttackDataTools::AddNotifyStateToMontage(UAnimMontage* Montage, float StartTime, float Duration, UAnimNotifyState* NotifyState, FName SectionName)
 {
     if (!Montage || !NotifyState || Duration <= 0.0f)
@@ -709,44 +1379,57 @@ bool UAttackDataTools::AddNotifyToMontage(UAnimMontage* Montage, float Time, UAn
 
 void UAttackDataTools::RemoveNotifiesOfType(UAnimMontage* Montage, FName SectionName, UClass* NotifyClass)
 {
-    if (!Montage || !NotifyClass)
+    if (!NotifyClass)
     {
         return;
     }
 
-    float SectionStart = 0.0f;
-    float SectionEnd = Montage->CalculateSequenceLength();
+    RemoveNotifiesOfTypes(Montage, MakeArrayView(&SectionName, 1), MakeArrayView(&NotifyClass, 1));
+}
 
-    if (SectionName != NAME_None)
+void UAttackDataTools::RemoveNotifiesOfTypes(UAnimMontage* Montage, TConstArrayView<FName> SectionNames, TConstArrayView<UClass*> NotifyClasses)
+{
+    if (!Montage || SectionNames.Num() == 0 || NotifyClasses.Num() == 0)
     {
-        SectionStart = GetSectionStartTime(Montage, SectionName);
-        SectionEnd = SectionStart + GetSectionLength(Montage, SectionName);
+        return;
     }
 
-    for (int32 i = Montage->Notifies.Num() - 1; i >= 0; --i)
+    // Montage time range of each section (None = whole montage)
+    TArray<TPair<float, float>, TInlineAllocator<8>> SectionRanges;
+    for (const FName SectionName : SectionNames)
     {
-        const FAnimNotifyEvent& NotifyEvent = Montage->Notifies[i];
-        const float NotifyTime = NotifyEvent.GetTriggerTime();
+        float SectionStart = 0.0f;
+        float SectionEnd = Montage->CalculateSequenceLength();
 
-        if (NotifyTime >= SectionStart && NotifyTime < SectionEnd)
+        if (SectionName != NAME_None)
         {
-            bool bShouldRemove = false;
+            SectionStart = GetSectionStartTime(Montage, SectionName);
+            SectionEnd = SectionStart + GetSectionLength(Montage, SectionName);
+        }
 
-            if (NotifyEvent.NotifyStateClass && NotifyEvent.NotifyStateClass->IsA(NotifyClass))
-            {
-                bShouldRemove = true;
-            }
-            else if (NotifyEvent.Notify && NotifyEvent.Notify->IsA(NotifyClass))
-            {
-                bShouldRemove = true;
-            }
+        SectionRanges.Emplace(SectionStart, SectionEnd);
+    }
 
-            if (bShouldRemove)
-            {
-                Montage->Notifies.RemoveAt(i);
-            }
+    // Single compacting pass, order of the kept notifies unchanged
+    Montage->Notifies.RemoveAll([&SectionRanges, NotifyClasses](const FAnimNotifyEvent& NotifyEvent)
+    {
+        const UObject* NotifyObject = NotifyEvent.Notify;
+        if (NotifyEvent.NotifyStateClass)
+        {
+            NotifyObject = NotifyEvent.NotifyStateClass;
         }
-    }
+
+        if (!NotifyObject || !NotifyClasses.ContainsByPredicate([NotifyObject](const UClass* NotifyClass) { return NotifyObject->IsA(NotifyClass); }))
+        {
+            return false;
+        }
+
+        const float NotifyTime = NotifyEvent.GetTriggerTime();
+        return SectionRanges.ContainsByPredicate([NotifyTime](const TPair<float, float>& Range)
+        {
+            return NotifyTime >= Range.Key && NotifyTime < Range.Value;
+        });
+    });
 }
 
 float UAttackDataTools::SectionTimeToMontageTime(UAnimMontage* Montage, FName SectionName, float SectionRelativeTime)
@@ -759,6 +1442,36 @@ float UAttackDataTools::SectionTimeToMontageTime(UAnimMontage* Montage, FName Se
     return GetSectionStartTime(Montage, SectionName) + SectionRelativeTime;
 }
 
+bool UAttackDataTools::GetActiveTimeRange(const UAttackData* AttackData, float& OutStart, float& OutEnd)
+{
+    FAttackTimingCache Scratch;
+    const FAttackTimingCache& Timing = AttackData->GetTimingCache(Scratch);
+    if (Timing.SectionEnd <= Timing.SectionStart)
+    {
+        return false;
+    }
+
+    // Transition notifies, else the cooked durations from the section start
+    const FAttackPhaseTimingOverride& Durations = Timing.PhaseDurations;
+    OutStart = Timing.ActiveTransitionTime >= 0.0f ? Timing.ActiveTransitionTime : Timing.SectionStart + Durations.WindupDuration;
+    OutEnd = Timing.RecoveryTransitionTime >= 0.0f ? Timing.RecoveryTransitionTime : OutStart + Durations.ActiveDuration;
+
+    // Explicit hit detection toggles in the section can open the window outside the Active phase
+    for (const FAnimNotifyEvent& NotifyEvent : AttackData->AttackMontage->Notifies)
+    {
+        const float NotifyTime = NotifyEvent.GetTriggerTime();
+        if (Cast<UAnimNotify_ToggleHitDetection>(NotifyEvent.Notify) && NotifyTime >= Timing.SectionStart && NotifyTime < Timing.SectionEnd)
+        {
+            OutStart = FMath::Min(OutStart, NotifyTime);
+            OutEnd = FMath::Max(OutEnd, NotifyTime);
+        }
+    }
+
+    OutStart = FMath::Clamp(OutStart, Timing.SectionStart, Timing.SectionEnd);
+    OutEnd = FMath::Clamp(OutEnd, OutStart, Timing.SectionEnd);
+    return OutEnd > OutStart;
+}
+
 void UAttackDataTools::GetDefaultTimingPercentages(EAttackType AttackType, float& OutWindupPercent, float& OutActivePercent, float& OutRecoveryPercent)
 {
     switch (AttackType)
@@ -793,6 +1506,8 @@ void UAttackDataTools::MarkMontageModified(UAnimMontage* Montage)
 {
     if (Montage)
     {
+        // Sorts the notifies and rebuilds the notify tracks
+        Montage->RefreshCacheData();
         Montage->MarkPackageDirty();
     }
 }
@@ -0,0 +1,302 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AttackSectionIndexSubsystem.h"
+#include "AttackDataTools.h"
+#include "Data/AttackData.h"
+#include "Animation/AnimMontage.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Editor.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+void UAttackSectionIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddUObject(this, &UAttackSectionIndexSubsystem::OnAssetAdded);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddUObject(this, &UAttackSectionIndexSubsystem::OnAssetRemoved);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddUObject(this, &UAttackSectionIndexSubsystem::OnAssetRenamed);
+
+    PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddUObject(this, &UAttackSectionIndexSubsystem::OnPackageSaved);
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &UAttackSectionIndexSubsystem::OnObjectPropertyChanged);
+
+    // Registry tags are only complete once the initial scan finishes
+    if (AssetRegistry.IsLoadingAssets())
+    {
+        FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddUObject(this, &UAttackSectionIndexSubsystem::OnFilesLoaded);
+    }
+    else
+    {
+        BuildIndex();
+    }
+}
+
+void UAttackSectionIndexSubsystem::Deinitialize()
+{
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+    {
+        IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+        AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+    }
+
+    UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+
+    SectionUsers.Empty();
+    AttackKeys.Empty();
+    bIndexBuilt = false;
+
+    Super::Deinitialize();
+}
+
+UAttackSectionIndexSubsystem* UAttackSectionIndexSubsystem::Get()
+{
+    return GEditor ? GEditor->GetEditorSubsystem<UAttackSectionIndexSubsystem>() : nullptr;
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+TArray<UAttackData*> UAttackSectionIndexSubsystem::FindOtherUsersOfSection(const UAttackData* AttackData) const
+{
+    TArray<UAttackData*> Users;
+
+    if (!AttackData)
+    {
+        return Users;
+    }
+
+    const FSectionKey Key = GetKeyFromObject(AttackData);
+    if (Key.Key.IsNull() || Key.Value == NAME_None)
+    {
+        return Users;
+    }
+
+    const TArray<FSoftObjectPath>* Paths = SectionUsers.Find(Key);
+    if (!Paths)
+    {
+        return Users;
+    }
+
+    const FSoftObjectPath SelfPath(AttackData);
+    for (const FSoftObjectPath& Path : *Paths)
+    {
+        if (Path == SelfPath)
+        {
+            continue;
+        }
+
+        if (UAttackData* Other = Cast<UAttackData>(Path.TryLoad()))
+        {
+            Users.Add(Other);
+        }
+    }
+
+    return Users;
+}
+
+void UAttackSectionIndexSubsystem::GetSectionUsers(const FSoftObjectPath& MontagePath, FName SectionName, TArray<FSoftObjectPath>& OutAttackPaths) const
+{
+    OutAttackPaths.Reset();
+
+    if (const TArray<FSoftObjectPath>* Paths = SectionUsers.Find(FSectionKey(MontagePath, SectionName)))
+    {
+        OutAttackPaths = *Paths;
+    }
+}
+
+// ============================================================================
+// INDEX MAINTENANCE
+// ============================================================================
+
+void UAttackSectionIndexSubsystem::BuildIndex()
+{
+    SectionUsers.Reset();
+    AttackKeys.Reset();
+
+    TArray<FAssetData> AssetDataList;
+    UAttackDataTools::GetAllAttackDataAssetData(AssetDataList);
+
+    for (const FAssetData& AssetData : AssetDataList)
+    {
+        FSectionKey Key;
+        if (GetKeyFromTags(AssetData, Key))
+        {
+            SetAttackKey(AssetData.GetSoftObjectPath(), Key);
+        }
+        else if (const UAttackData* AttackData = Cast<UAttackData>(AssetData.GetAsset()))
+        {
+            // Saved before the registry tags existed - one load, then tagged on next save
+            SetAttackKey(AssetData.GetSoftObjectPath(), GetKeyFromObject(AttackData));
+        }
+    }
+
+    bIndexBuilt = true;
+}
+
+void UAttackSectionIndexSubsystem::UpdateAttack(const UAttackData* AttackData)
+{
+    if (AttackData && bIndexBuilt && AttackData->IsAsset())
+    {
+        SetAttackKey(FSoftObjectPath(AttackData), GetKeyFromObject(AttackData));
+    }
+}
+
+void UAttackSectionIndexSubsystem::SetAttackKey(const FSoftObjectPath& AttackPath, const FSectionKey& Key)
+{
+    if (const FSectionKey* OldKey = AttackKeys.Find(AttackPath))
+    {
+        if (*OldKey == Key)
+        {
+            return;
+        }
+        RemoveAttack(AttackPath);
+    }
+
+    AttackKeys.Add(AttackPath, Key);
+    SectionUsers.FindOrAdd(Key).AddUnique(AttackPath);
+}
+
+void UAttackSectionIndexSubsystem::RemoveAttack(const FSoftObjectPath& AttackPath)
+{
+    FSectionKey OldKey;
+    if (!AttackKeys.RemoveAndCopyValue(AttackPath, OldKey))
+    {
+        return;
+    }
+
+    if (TArray<FSoftObjectPath>* Paths = SectionUsers.Find(OldKey))
+    {
+        Paths->RemoveSingleSwap(AttackPath);
+        if (Paths->Num() == 0)
+        {
+            SectionUsers.Remove(OldKey);
+        }
+    }
+}
+
+bool UAttackSectionIndexSubsystem::GetKeyFromTags(const FAssetData& AssetData, FSectionKey& OutKey)
+{
+    FString MontagePath;
+    FName SectionName;
+    if (!AssetData.GetTagValue(UAttackData::AttackMontageTagName, MontagePath)
+        || !AssetData.GetTagValue(UAttackData::MontageSectionTagName, SectionName))
+    {
+        return false;
+    }
+
+    OutKey = FSectionKey(FSoftObjectPath(MontagePath), SectionName);
+    return true;
+}
+
+UAttackSectionIndexSubsystem::FSectionKey UAttackSectionIndexSubsystem::GetKeyFromObject(const UAttackData* AttackData)
+{
+    return FSectionKey(FSoftObjectPath(AttackData->AttackMontage.Get()), AttackData->MontageSection);
+}
+
+// ============================================================================
+// EVENTS
+// ============================================================================
+
+void UAttackSectionIndexSubsystem::OnFilesLoaded()
+{
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+    {
+        AssetRegistryModule->Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+    }
+    FilesLoadedHandle.Reset();
+
+    BuildIndex();
+}
+
+void UAttackSectionIndexSubsystem::OnAssetAdded(const FAssetData& AssetData)
+{
+    // The initial scan reports every asset - BuildIndex covers those in one pass
+    if (!bIndexBuilt || !AssetData.IsInstanceOf(UAttackData::StaticClass()))
+    {
+        return;
+    }
+
+    FSectionKey Key;
+    if (GetKeyFromTags(AssetData, Key))
+    {
+        SetAttackKey(AssetData.GetSoftObjectPath(), Key);
+    }
+    else if (const UAttackData* AttackData = Cast<UAttackData>(AssetData.FastGetAsset(false)))
+    {
+        // New in-memory asset (not saved yet, so no tags)
+        SetAttackKey(AssetData.GetSoftObjectPath(), GetKeyFromObject(AttackData));
+    }
+}
+
+void UAttackSectionIndexSubsystem::OnAssetRemoved(const FAssetData& AssetData)
+{
+    if (bIndexBuilt && AssetData.IsInstanceOf(UAttackData::StaticClass()))
+    {
+        RemoveAttack(AssetData.GetSoftObjectPath());
+    }
+}
+
+void UAttackSectionIndexSubsystem::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    if (!bIndexBuilt || !AssetData.IsInstanceOf(UAttackData::StaticClass()))
+    {
+        return;
+    }
+
+    FSectionKey Key;
+    const FSoftObjectPath OldPath(OldObjectPath);
+    if (AttackKeys.RemoveAndCopyValue(OldPath, Key))
+    {
+        if (TArray<FSoftObjectPath>* Paths = SectionUsers.Find(Key))
+        {
+            Paths->RemoveSingleSwap(OldPath);
+        }
+        SetAttackKey(AssetData.GetSoftObjectPath(), Key);
+    }
+    else
+    {
+        OnAssetAdded(AssetData);
+    }
+}
+
+void UAttackSectionIndexSubsystem::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+    if (!bIndexBuilt || !Package || SaveContext.IsProceduralSave())
+    {
+        return;
+    }
+
+    ForEachObjectWithPackage(Package, [this](UObject* Object)
+    {
+        if (const UAttackData* AttackData = Cast<UAttackData>(Object))
+        {
+            UpdateAttack(AttackData);
+        }
+        return true;
+    }, false);
+}
+
+void UAttackSectionIndexSubsystem::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+    const UAttackData* AttackData = Cast<UAttackData>(Object);
+    if (!AttackData)
+    {
+        return;
+    }
+
+    // Only the key fields matter (None = bulk change, e.g. undo)
+    const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+    if (PropertyName == NAME_None
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UAttackData, AttackMontage)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(UAttackData, MontageSection))
+    {
+        UpdateAttack(AttackData);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,327 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ComboGraph/SComboGraphView.h"
+#include "Data/AttackConfiguration.h"
+#include "Data/AttackData.h"
+#include "Animation/AnimMontage.h"
+#include "PropertyCustomizationHelpers.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/AppStyle.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+
+#define LOCTEXT_NAMESPACE "SComboGraphView"
+
+const FName SComboGraphView::TabId(TEXT("KatanaComboGraph"));
+
+// ============================================================================
+// LAYOUT
+// ============================================================================
+
+void FComboGraphLayout::Build(const FCompiledComboGraph& Graph)
+{
+    *this = FComboGraphLayout();
+
+    const int32 NumNodes = Graph.GetNumNodes();
+    if (NumNodes == 0)
+    {
+        return;
+    }
+
+    // Reachability over what resolution can actually pick (context variants swap in at runtime)
+    TArray<bool> bReachable;
+    bReachable.SetNumZeroed(NumNodes);
+    bReachable[FCompiledComboGraph::RootNode] = true;
+
+    TArray<int32> Frontier = { FCompiledComboGraph::RootNode };
+    TArray<int32> Successors;
+    while (Frontier.Num() > 0)
+    {
+        const int32 Node = Frontier.Pop(EAllowShrinking::No);
+
+        Graph.GetResolvableSuccessors(Node, Successors);
+        if (const UAttackData* Attack = Graph.GetNodeAttack(Node))
+        {
+            for (const TObjectPtr<UAttackData>& Variant : Attack->ContextVariants)
+            {
+                const int32 VariantNode = Graph.FindNode(Variant);
+                if (VariantNode != INDEX_NONE && Variant)
+                {
+                    Successors.AddUnique(VariantNode);
+                }
+            }
+        }
+
+        for (int32 Next : Successors)
+        {
+            if (!bReachable[Next])
+            {
+                bReachable[Next] = true;
+                Frontier.Add(Next);
+            }
+        }
+    }
+
+    // Columns from authored link depth (breadth-first, so every node sits at its shortest depth)
+    TArray<int32> Depth;
+    Depth.Init(INDEX_NONE, NumNodes);
+    Depth[FCompiledComboGraph::RootNode] = 0;
+
+    TArray<int32> Order = { FCompiledComboGraph::RootNode };
+    TArray<int32> Linked;
+    for (int32 OrderIdx = 0; OrderIdx < Order.Num(); ++OrderIdx)
+    {
+        const int32 Node = Order[OrderIdx];
+        Graph.GetLinkedNodes(Node, Linked);
+        Graph.GetResolvableSuccessors(Node, Successors);
+
+        for (int32 Next : Linked)
+        {
+            Edges.Add({ Node, Next, Successors.Contains(Next) || Node == FCompiledComboGraph::RootNode, false });
+            if (Depth[Next] == INDEX_NONE)
+            {
+                Depth[Next] = Depth[Node] + 1;
+                Order.Add(Next);
+            }
+        }
+    }
+
+    for (const TPair<int32, int32>& CycleEdge : Graph.GetCycleEdges())
+    {
+        for (FEdge& Edge : Edges)
+        {
+            if (Edge.From == CycleEdge.Key && Edge.To == CycleEdge.Value)
+            {
+                Edge.bCycle = true;
+            }
+        }
+    }
+    NumCycleEdges = Graph.GetCycleEdges().Num();
+
+    // Place nodes
+    Nodes.SetNum(NumNodes);
+    TArray<int32> RowsPerColumn;
+    TSet<const UAnimMontage*> Montages;
+
+    for (int32 Node : Order)
+    {
+        const int32 Column = Depth[Node];
+        if (RowsPerColumn.Num() <= Column)
+        {
+            RowsPerColumn.SetNumZeroed(Column + 1);
+        }
+        const int32 Row = RowsPerColumn[Column]++;
+
+        FNode& LayoutNode = Nodes[Node];
+        LayoutNode.Position = FVector2D(Column * ColumnSpacing, Row * RowSpacing);
+        LayoutNode.bUnreachable = !bReachable[Node];
+        NumUnreachable += LayoutNode.bUnreachable ? 1 : 0;
+
+        if (const UAttackData* Attack = Graph.GetNodeAttack(Node))
+        {
+            LayoutNode.Label = Attack->GetName();
+            LayoutNode.MontageName = Attack->AttackMontage ? Attack->AttackMontage->GetName() : TEXT("(no montage)");
+            if (bReachable[Node] && Attack->AttackMontage)
+            {
+                Montages.Add(Attack->AttackMontage);
+            }
+        }
+        else
+        {
+            LayoutNode.Label = TEXT("Idle");
+        }
+
+        Size.X = FMath::Max(Size.X, LayoutNode.Position.X + NodeWidth);
+        Size.Y = FMath::Max(Size.Y, LayoutNode.Position.Y + NodeHeight);
+    }
+
+    for (const FEdge& Edge : Edges)
+    {
+        if (Edge.bCycle)
+        {
+            Nodes[Edge.From].bInCycle = true;
+            Nodes[Edge.To].bInCycle = true;
+        }
+    }
+
+    NumMontages = Montages.Num();
+}
+
+// ============================================================================
+// CANVAS
+// ============================================================================
+
+void SComboGraphCanvas::Construct(const FArguments& InArgs, const FComboGraphLayout* InLayout)
+{
+    Layout = InLayout;
+}
+
+FVector2D SComboGraphCanvas::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+    return Layout ? Layout->Size + FVector2D(16.0f) : FVector2D::ZeroVector;
+}
+
+int32 SComboGraphCanvas::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    if (!Layout)
+    {
+        return LayerId;
+    }
+
+    const FVector2D Margin(8.0f);
+    const FSlateBrush* Brush = FAppStyle::GetBrush("WhiteBrush");
+    const FSlateFontInfo LabelFont = FCoreStyle::GetDefaultFontStyle("Bold", 9);
+    const FSlateFontInfo MontageFont = FCoreStyle::GetDefaultFontStyle("Regular", 8);
+
+    // Links first (under the nodes), right edge of source -> left edge of target
+    for (const FComboGraphLayout::FEdge& Edge : Layout->Edges)
+    {
+        const FVector2D From = Margin + Layout->Nodes[Edge.From].Position + FVector2D(FComboGraphLayout::NodeWidth, FComboGraphLayout::NodeHeight * 0.5f);
+        const FVector2D To = Margin + Layout->Nodes[Edge.To].Position + FVector2D(0.0f, FComboGraphLayout::NodeHeight * 0.5f);
+        const FLinearColor Color = Edge.bCycle ? FLinearColor(0.9f, 0.15f, 0.1f)
+            : Edge.bResolvable ? FLinearColor(0.8f, 0.8f, 0.8f)
+            : FLinearColor(0.4f, 0.4f, 0.4f, 0.6f);
+
+        FSlateDrawElement::MakeLines(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(),
+            TArray<FVector2D>{ From, To }, ESlateDrawEffect::None, Color, true, Edge.bCycle ? 2.0f : 1.0f);
+    }
+
+    const int32 NodeLayer = LayerId + 1;
+    for (const FComboGraphLayout::FNode& Node : Layout->Nodes)
+    {
+        const FVector2D Position = Margin + Node.Position;
+        const FLinearColor Border = Node.bInCycle ? FLinearColor(0.9f, 0.15f, 0.1f)
+            : Node.bUnreachable ? FLinearColor(0.95f, 0.55f, 0.1f)
+            : FLinearColor(0.3f, 0.5f, 0.8f);
+
+        FSlateDrawElement::MakeBox(OutDrawElements, NodeLayer,
+            AllottedGeometry.ToPaintGeometry(FVector2f(FComboGraphLayout::NodeWidth, FComboGraphLayout::NodeHeight), FSlateLayoutTransform(FVector2f(Position))),
+            Brush, ESlateDrawEffect::None, Border);
+        FSlateDrawElement::MakeBox(OutDrawElements, NodeLayer,
+            AllottedGeometry.ToPaintGeometry(FVector2f(FComboGraphLayout::NodeWidth - 4.0f, FComboGraphLayout::NodeHeight - 4.0f), FSlateLayoutTransform(FVector2f(Position + FVector2D(2.0f)))),
+            Brush, ESlateDrawEffect::None, FLinearColor(0.05f, 0.05f, 0.05f));
+
+        FSlateDrawElement::MakeText(OutDrawElements, NodeLayer + 1,
+            AllottedGeometry.ToPaintGeometry(FVector2f(FComboGraphLayout::NodeWidth - 12.0f, 16.0f), FSlateLayoutTransform(FVector2f(Position + FVector2D(6.0f, 5.0f)))),
+            Node.Label, LabelFont, ESlateDrawEffect::None, FLinearColor::White);
+        FSlateDrawElement::MakeText(OutDrawElements, NodeLayer + 1,
+            AllottedGeometry.ToPaintGeometry(FVector2f(FComboGraphLayout::NodeWidth - 12.0f, 14.0f), FSlateLayoutTransform(FVector2f(Position + FVector2D(6.0f, 24.0f)))),
+            Node.MontageName, MontageFont, ESlateDrawEffect::None, FLinearColor(0.6f, 0.6f, 0.6f));
+    }
+
+    return NodeLayer + 1;
+}
+
+// ============================================================================
+// VIEW
+// ============================================================================
+
+void SComboGraphView::Construct(const FArguments& InArgs)
+{
+    ChildSlot
+    [
+        SNew(SVerticalBox)
+
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4.0f)
+        [
+            SNew(SHorizontalBox)
+
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            [
+                SNew(SObjectPropertyEntryBox)
+                .AllowedClass(UAttackConfiguration::StaticClass())
+                .ObjectPath(this, &SComboGraphView::GetConfigurationPath)
+                .OnObjectChanged(this, &SComboGraphView::OnConfigurationChanged)
+                .AllowClear(true)
+            ]
+
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .Padding(4.0f, 0.0f)
+            [
+                SNew(SButton)
+                .Text(LOCTEXT("Rebuild", "Rebuild"))
+                .ToolTipText(LOCTEXT("RebuildTooltip", "Recompile the combo graph after editing attacks"))
+                .OnClicked_Lambda([this]() -> FReply
+                {
+                    Rebuild();
+                    return FReply::Handled();
+                })
+            ]
+        ]
+
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4.0f, 0.0f, 4.0f, 4.0f)
+        [
+            SNew(STextBlock)
+            .Text(this, &SComboGraphView::GetSummaryText)
+        ]
+
+        + SVerticalBox::Slot()
+        .FillHeight(1.0f)
+        [
+            SNew(SScrollBox)
+            .Orientation(Orient_Vertical)
+
+            + SScrollBox::Slot()
+            [
+                SNew(SScrollBox)
+                .Orientation(Orient_Horizontal)
+
+                + SScrollBox::Slot()
+                [
+                    SNew(SComboGraphCanvas, &Layout)
+                ]
+            ]
+        ]
+    ];
+}
+
+void SComboGraphView::OnConfigurationChanged(const FAssetData& AssetData)
+{
+    Configuration = Cast<UAttackConfiguration>(AssetData.GetAsset());
+    Rebuild();
+}
+
+FString SComboGraphView::GetConfigurationPath() const
+{
+    return Configuration.IsValid() ? Configuration->GetPathName() : FString();
+}
+
+FText SComboGraphView::GetSummaryText() const
+{
+    if (!Configuration.IsValid())
+    {
+        return LOCTEXT("NoConfiguration", "Pick an AttackConfiguration to view its combo graph.");
+    }
+
+    return FText::Format(
+        LOCTEXT("Summary", "{0} attacks, {1} montages to preload, {2} unreachable (orange), {3} cycle links (red)"),
+        FText::AsNumber(FMath::Max(Graph.GetNumNodes() - 1, 0)),
+        FText::AsNumber(Layout.NumMontages),
+        FText::AsNumber(Layout.NumUnreachable),
+        FText::AsNumber(Layout.NumCycleEdges));
+}
+
+void SComboGraphView::Rebuild()
+{
+    Graph.Reset();
+
+    if (UAttackConfiguration* Config = Configuration.Get())
+    {
+        Graph.Build(Config->DefaultLightAttack, Config->DefaultHeavyAttack);
+    }
+
+    Layout.Build(Graph);
+    Invalidate(EInvalidateWidgetReason::Layout | EInvalidateWidgetReason::Paint);
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,211 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/KatanaCombatDuelSimCommandlet.h"
+#include "Core/CombatDuelSimulator.h"
+#include "Data/CombatSettings.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogKatanaCombatDuelSim, Log, All);
+
+namespace KatanaCombatDuelSim
+{
+    /** Config field a -Sweep parameter name drives (nullptr if not sweepable) */
+    float* FindSweepParameter(FCombatSimConfig& Config, const FString& Name)
+    {
+        if (Name == TEXT("MaxPosture")) { return &Config.MaxPosture; }
+        if (Name == TEXT("PostureRegenRate_Attacking")) { return &Config.PostureRegenRate_Attacking; }
+        if (Name == TEXT("PostureRegenRate_Idle")) { return &Config.PostureRegenRate_Idle; }
+        if (Name == TEXT("GuardBreakStunDuration")) { return &Config.GuardBreakStunDuration; }
+        if (Name == TEXT("GuardBreakRecoveryPercent")) { return &Config.GuardBreakRecoveryPercent; }
+        if (Name == TEXT("ComboResetDelay")) { return &Config.ComboResetDelay; }
+        return nullptr;
+    }
+
+    float GetFloat(const TMap<FString, FString>& ParamValues, const TCHAR* Key, float Default)
+    {
+        const FString* Value = ParamValues.Find(Key);
+        return Value ? FCString::Atof(**Value) : Default;
+    }
+
+    /** Policy from the shared switches, with Suffix-ed overrides (opponent) */
+    FCombatDuelPolicy ParsePolicy(const TMap<FString, FString>& ParamValues, const TCHAR* Suffix, bool bRandomize)
+    {
+        auto Get = [&ParamValues, Suffix](const TCHAR* Key, float Default)
+        {
+            const float Shared = GetFloat(ParamValues, Key, Default);
+            return GetFloat(ParamValues, *(FString(Key) + Suffix), Shared);
+        };
+
+        FCombatDuelPolicy Policy;
+        Policy.Aggression = Get(TEXT("Aggression"), Policy.Aggression);
+        Policy.BlockChance = Get(TEXT("BlockChance"), Policy.BlockChance);
+        Policy.HeavyChance = Get(TEXT("HeavyChance"), Policy.HeavyChance);
+        Policy.ComboChance = Get(TEXT("ComboChance"), Policy.ComboChance);
+        Policy.BlockDuration = Get(TEXT("BlockDuration"), Policy.BlockDuration);
+        Policy.DecisionInterval = FMath::Max(Get(TEXT("DecisionInterval"), Policy.DecisionInterval), KINDA_SMALL_NUMBER);
+        Policy.bRandomize = bRandomize;
+        return Policy;
+    }
+
+    const UCombatSettings* LoadSettings(const FString& Path)
+    {
+        const UCombatSettings* Settings = LoadObject<UCombatSettings>(nullptr, *Path);
+        if (!Settings)
+        {
+            UE_LOG(LogKatanaCombatDuelSim, Error, TEXT("Could not load CombatSettings %s"), *Path);
+        }
+        return Settings;
+    }
+}
+
+UKatanaCombatDuelSimCommandlet::UKatanaCombatDuelSimCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UKatanaCombatDuelSimCommandlet::Main(const FString& Params)
+{
+    using namespace KatanaCombatDuelSim;
+
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamValues;
+    ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+    // ------------------------------------------------------------------------
+    // Fighters: settings and cooked movesets (game thread - loads assets)
+    // ------------------------------------------------------------------------
+
+    const FString* SettingsPath = ParamValues.Find(TEXT("Settings"));
+    if (!SettingsPath)
+    {
+        UE_LOG(LogKatanaCombatDuelSim, Error, TEXT("Missing -Settings=<CombatSettings asset path>"));
+        return 1;
+    }
+
+    const UCombatSettings* Settings = LoadSettings(*SettingsPath);
+    const FString* OpponentPath = ParamValues.Find(TEXT("OpponentSettings"));
+    const UCombatSettings* OpponentSettings = OpponentPath ? LoadSettings(*OpponentPath) : Settings;
+    if (!Settings || !OpponentSettings)
+    {
+        return 1;
+    }
+
+    const FCombatDuelMoveset Moveset = FCombatDuelMoveset::Cook(Settings->AttackConfiguration);
+    const FCombatDuelMoveset OpponentMoveset = FCombatDuelMoveset::Cook(OpponentSettings->AttackConfiguration);
+    if (Moveset.IsEmpty() || OpponentMoveset.IsEmpty())
+    {
+        UE_LOG(LogKatanaCombatDuelSim, Error, TEXT("Both fighters need an AttackConfiguration with default attacks"));
+        return 1;
+    }
+
+    const bool bRandomPolicies = Switches.Contains(TEXT("RandomPolicies"));
+    const int32 NumDuels = FMath::Max(1, FCString::Atoi(ParamValues.Contains(TEXT("Duels")) ? *ParamValues[TEXT("Duels")] : TEXT("2000")));
+    const int32 Seed = ParamValues.Contains(TEXT("Seed")) ? FCString::Atoi(*ParamValues[TEXT("Seed")]) : 1;
+
+    // Settings' posture and guard break tunables; the sweep point overrides one of them
+    FCombatDuelParams BaseParams;
+    BaseParams.Config = FCombatSimCore::CookConfig(Settings);
+    BaseParams.MaxDuration = GetFloat(ParamValues, TEXT("MaxDuration"), BaseParams.MaxDuration);
+    BaseParams.PostureSampleInterval = FMath::Max(GetFloat(ParamValues, TEXT("SampleInterval"), BaseParams.PostureSampleInterval), BaseParams.Config.FixedTimeStep);
+
+    const float Health = GetFloat(ParamValues, TEXT("Health"), 100.0f);
+    BaseParams.Fighters[0].Moveset = &Moveset;
+    BaseParams.Fighters[0].Policy = ParsePolicy(ParamValues, TEXT(""), bRandomPolicies);
+    BaseParams.Fighters[0].MaxHealth = Health;
+    BaseParams.Fighters[1].Moveset = &OpponentMoveset;
+    BaseParams.Fighters[1].Policy = ParsePolicy(ParamValues, TEXT("B"), bRandomPolicies);
+    BaseParams.Fighters[1].MaxHealth = GetFloat(ParamValues, TEXT("HealthB"), Health);
+
+    // ------------------------------------------------------------------------
+    // Sweep: Parameter:Min:Max:Points (one point at the settings' value without -Sweep)
+    // ------------------------------------------------------------------------
+
+    FString SweepName;
+    TArray<float> SweepValues;
+    if (const FString* SweepParam = ParamValues.Find(TEXT("Sweep")))
+    {
+        TArray<FString> Parts;
+        SweepParam->ParseIntoArray(Parts, TEXT(":"));
+
+        FCombatSimConfig Probe;
+        if (Parts.Num() != 4 || !FindSweepParameter(Probe, Parts[0]))
+        {
+            UE_LOG(LogKatanaCombatDuelSim, Error, TEXT("Bad -Sweep=%s (expected <Parameter>:<Min>:<Max>:<Points>)"), **SweepParam);
+            return 1;
+        }
+
+        SweepName = Parts[0];
+        const float Min = FCString::Atof(*Parts[1]);
+        const float Max = FCString::Atof(*Parts[2]);
+        const int32 NumPoints = FMath::Max(1, FCString::Atoi(*Parts[3]));
+        for (int32 Point = 0; Point < NumPoints; ++Point)
+        {
+            SweepValues.Add(NumPoints > 1 ? FMath::Lerp(Min, Max, static_cast<float>(Point) / (NumPoints - 1)) : Min);
+        }
+    }
+    else
+    {
+        SweepName = TEXT("MaxPosture");
+        SweepValues.Add(BaseParams.Config.MaxPosture);
+    }
+
+    // ------------------------------------------------------------------------
+    // Run
+    // ------------------------------------------------------------------------
+
+    FString SummaryCsv = FString::Printf(TEXT("%s,Duels,WinRateA,WinRateB,DrawRate,TimeoutRate,MeanDuration,DPSA,DPSB,GuardBreaksA,GuardBreaksB,BlockRateA,BlockRateB\n"), *SweepName);
+    FString PostureCsv = FString::Printf(TEXT("%s,Time,PostureA,PostureB\n"), *SweepName);
+
+    TArray<FCombatDuelResult> Results;
+    for (const float SweepValue : SweepValues)
+    {
+        FCombatDuelParams PointParams = BaseParams;
+        *FindSweepParameter(PointParams.Config, SweepName) = SweepValue;
+
+        const double StartTime = FPlatformTime::Seconds();
+        FCombatDuelSimulator::RunDuels(PointParams, NumDuels, Seed, Results);
+        const FCombatDuelSummary Summary = FCombatDuelSimulator::Summarize(Results);
+
+        UE_LOG(LogKatanaCombatDuelSim, Display, TEXT("%s=%.3f: %d duels in %.2fs, A %.1f%% / B %.1f%% / draw %.1f%%, DPS %.2f / %.2f"),
+            *SweepName, SweepValue, Summary.NumDuels, FPlatformTime::Seconds() - StartTime,
+            Summary.GetWinRate(0) * 100.0f, Summary.GetWinRate(1) * 100.0f, 100.0f * Summary.Draws / Summary.NumDuels,
+            Summary.DPS[0], Summary.DPS[1]);
+
+        SummaryCsv += FString::Printf(TEXT("%g,%d,%g,%g,%g,%g,%g,%g,%g,%g,%g,%g,%g\n"),
+            SweepValue, Summary.NumDuels, Summary.GetWinRate(0), Summary.GetWinRate(1),
+            static_cast<float>(Summary.Draws) / Summary.NumDuels, static_cast<float>(Summary.Timeouts) / Summary.NumDuels,
+            Summary.MeanDuration, Summary.DPS[0], Summary.DPS[1],
+            Summary.MeanGuardBreaksCaused[0], Summary.MeanGuardBreaksCaused[1], Summary.BlockRate[0], Summary.BlockRate[1]);
+
+        const int32 NumSamples = FMath::Min(Summary.MeanPosture[0].Num(), Summary.MeanPosture[1].Num());
+        for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+        {
+            PostureCsv += FString::Printf(TEXT("%g,%g,%g,%g\n"), SweepValue, SampleIndex * PointParams.PostureSampleInterval,
+                Summary.MeanPosture[0][SampleIndex], Summary.MeanPosture[1][SampleIndex]);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Report
+    // ------------------------------------------------------------------------
+
+    const FString* OutputParam = ParamValues.Find(TEXT("Output"));
+    const FString OutputDir = OutputParam ? *OutputParam : FPaths::ProjectSavedDir() / TEXT("KatanaCombat/DuelSim");
+    const FString SummaryPath = OutputDir / TEXT("Summary.csv");
+    const FString PosturePath = OutputDir / TEXT("PostureCurves.csv");
+
+    if (!FFileHelper::SaveStringToFile(SummaryCsv, *SummaryPath) || !FFileHelper::SaveStringToFile(PostureCsv, *PosturePath))
+    {
+        UE_LOG(LogKatanaCombatDuelSim, Error, TEXT("Failed to write results to %s"), *OutputDir);
+        return 1;
+    }
+
+    UE_LOG(LogKatanaCombatDuelSim, Display, TEXT("%d sweep points x %d duels. Results: %s"), SweepValues.Num(), NumDuels, *OutputDir);
+    return 0;
+}
\ No newline at end of file
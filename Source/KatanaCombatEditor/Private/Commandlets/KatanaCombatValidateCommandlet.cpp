@@ -0,0 +1,215 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/KatanaCombatValidateCommandlet.h"
+#include "AttackDataTools.h"
+#include "Data/AttackData.h"
+#include "Data/AttackConfiguration.h"
+#include "Data/CompiledComboGraph.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogKatanaCombatValidate, Log, All);
+
+namespace KatanaCombatValidate
+{
+    TArray<TSharedPtr<FJsonValue>> ToJsonArray(const TArray<FText>& Messages)
+    {
+        TArray<TSharedPtr<FJsonValue>> Values;
+        Values.Reserve(Messages.Num());
+        for (const FText& Message : Messages)
+        {
+            Values.Add(MakeShared<FJsonValueString>(Message.ToString()));
+        }
+        return Values;
+    }
+
+    bool SavePackage(UPackage* Package)
+    {
+        const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+        FSavePackageArgs SaveArgs;
+        SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+        SaveArgs.Error = GWarn;
+        return UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs);
+    }
+}
+
+UKatanaCombatValidateCommandlet::UKatanaCombatValidateCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UKatanaCombatValidateCommandlet::Main(const FString& Params)
+{
+    using namespace KatanaCombatValidate;
+
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamValues;
+    ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+    const bool bBake = Switches.Contains(TEXT("Bake"));
+    const bool bWarningsAsErrors = Switches.Contains(TEXT("WarningsAsErrors"));
+    const FString* ReportParam = ParamValues.Find(TEXT("Report"));
+    const FString ReportPath = ReportParam ? *ReportParam : FPaths::ProjectSavedDir() / TEXT("KatanaCombat/ValidationReport.json");
+
+    // Headless: the registry has not finished its scan yet
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    // ------------------------------------------------------------------------
+    // Attack data: load, then validate in parallel
+    // ------------------------------------------------------------------------
+
+    const TArray<UAttackData*> Attacks = UAttackDataTools::FindAllAttackDataAssets();
+    UE_LOG(LogKatanaCombatValidate, Display, TEXT("Validating %d AttackData assets"), Attacks.Num());
+
+    TArray<FAttackDataValidationResult> Results;
+    UAttackDataTools::BatchAnalyze(Attacks, Results);
+
+    // ------------------------------------------------------------------------
+    // Bake: stale cooked timing blocks (game thread - mutates and saves)
+    // ------------------------------------------------------------------------
+
+    TSet<UAttackData*> Baked;
+    if (bBake)
+    {
+        for (UAttackData* AttackData : Attacks)
+        {
+            if (UAttackDataTools::RefreshTimingCache(AttackData))
+            {
+                if (SavePackage(AttackData->GetPackage()))
+                {
+                    Baked.Add(AttackData);
+                }
+                else
+                {
+                    UE_LOG(LogKatanaCombatValidate, Error, TEXT("Failed to save %s"), *AttackData->GetPathName());
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Report
+    // ------------------------------------------------------------------------
+
+    int32 NumErrors = 0;
+    int32 NumWarnings = 0;
+    int32 NumInvalidAssets = 0;
+
+    TArray<TSharedPtr<FJsonValue>> AssetValues;
+    for (const FAttackDataValidationResult& Result : Results)
+    {
+        const FString AssetPath = Result.AttackData ? Result.AttackData->GetPathName() : FString();
+
+        for (const FText& Error : Result.Errors)
+        {
+            UE_LOG(LogKatanaCombatValidate, Error, TEXT("%s: %s"), *AssetPath, *Error.ToString());
+        }
+        for (const FText& Warning : Result.Warnings)
+        {
+            UE_LOG(LogKatanaCombatValidate, Warning, TEXT("%s: %s"), *AssetPath, *Warning.ToString());
+        }
+
+        NumErrors += Result.Errors.Num();
+        NumWarnings += Result.Warnings.Num();
+        NumInvalidAssets += Result.IsValid() ? 0 : 1;
+
+        TSharedRef<FJsonObject> AssetObject = MakeShared<FJsonObject>();
+        AssetObject->SetStringField(TEXT("path"), AssetPath);
+        AssetObject->SetBoolField(TEXT("valid"), Result.IsValid());
+        AssetObject->SetBoolField(TEXT("baked"), Baked.Contains(Result.AttackData));
+        AssetObject->SetArrayField(TEXT("errors"), ToJsonArray(Result.Errors));
+        AssetObject->SetArrayField(TEXT("warnings"), ToJsonArray(Result.Warnings));
+        AssetValues.Add(MakeShared<FJsonValueObject>(AssetObject));
+    }
+
+    // Combo graphs, compiled exactly as UCombatComponentV2 does at BeginPlay
+    TArray<FAssetData> ConfigurationAssets;
+    AssetRegistry.GetAssetsByClass(UAttackConfiguration::StaticClass()->GetClassPathName(), ConfigurationAssets, true);
+
+    TArray<TSharedPtr<FJsonValue>> GraphValues;
+    for (const FAssetData& AssetData : ConfigurationAssets)
+    {
+        const UAttackConfiguration* Configuration = Cast<UAttackConfiguration>(AssetData.GetAsset());
+        if (!Configuration)
+        {
+            continue;
+        }
+
+        FCompiledComboGraph Graph;
+        Graph.Build(Configuration->DefaultLightAttack, Configuration->DefaultHeavyAttack);
+
+        if (Graph.HasCycles())
+        {
+            UE_LOG(LogKatanaCombatValidate, Warning, TEXT("%s: Combo graph has circular references"), *Configuration->GetPathName());
+            NumWarnings++;
+        }
+
+        TSharedRef<FJsonObject> GraphObject = MakeShared<FJsonObject>();
+        GraphObject->SetStringField(TEXT("path"), Configuration->GetPathName());
+        GraphObject->SetNumberField(TEXT("nodes"), Graph.GetNumNodes());
+        GraphObject->SetBoolField(TEXT("hasCycles"), Graph.HasCycles());
+        GraphValues.Add(MakeShared<FJsonValueObject>(GraphObject));
+    }
+
+    // Notify density and weapon trace cost per montage (informational, never fails the run)
+    TArray<FMontageNotifyCostReport> MontageReports;
+    UAttackDataTools::BuildMontageNotifyReports(Attacks, 60.0f, MontageReports);
+
+    TArray<TSharedPtr<FJsonValue>> MontageValues;
+    for (const FMontageNotifyCostReport& MontageReport : MontageReports)
+    {
+        TSharedRef<FJsonObject> MontageObject = MakeShared<FJsonObject>();
+        MontageObject->SetStringField(TEXT("path"), MontageReport.Montage->GetPathName());
+        MontageObject->SetNumberField(TEXT("attacks"), MontageReport.Attacks.Num());
+        MontageObject->SetNumberField(TEXT("notifies"), MontageReport.NumNotifies);
+        MontageObject->SetNumberField(TEXT("notifyStates"), MontageReport.NumNotifyStates);
+        MontageObject->SetNumberField(TEXT("peakNotifiesPerFrame"), MontageReport.PeakNotifiesPerFrame);
+        MontageObject->SetNumberField(TEXT("swings"), MontageReport.NumSwings);
+        MontageObject->SetNumberField(TEXT("hitDetectionTime"), MontageReport.HitDetectionTime);
+        MontageObject->SetNumberField(TEXT("tracesPerSwing"), MontageReport.EstimatedTracesPerSwing);
+        MontageObject->SetNumberField(TEXT("worstCaseTracesPerSwing"), MontageReport.WorstCaseTracesPerSwing);
+        MontageValues.Add(MakeShared<FJsonValueObject>(MontageObject));
+    }
+
+    TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+    Summary->SetNumberField(TEXT("assets"), Results.Num());
+    Summary->SetNumberField(TEXT("invalidAssets"), NumInvalidAssets);
+    Summary->SetNumberField(TEXT("errors"), NumErrors);
+    Summary->SetNumberField(TEXT("warnings"), NumWarnings);
+    Summary->SetNumberField(TEXT("baked"), Baked.Num());
+
+    TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetObjectField(TEXT("summary"), Summary);
+    Report->SetArrayField(TEXT("attacks"), AssetValues);
+    Report->SetArrayField(TEXT("comboGraphs"), GraphValues);
+    Report->SetArrayField(TEXT("montages"), MontageValues);
+
+    FString ReportText;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportText);
+    FJsonSerializer::Serialize(Report, Writer);
+
+    if (!FFileHelper::SaveStringToFile(ReportText, *ReportPath))
+    {
+        UE_LOG(LogKatanaCombatValidate, Error, TEXT("Failed to write report to %s"), *ReportPath);
+        return 1;
+    }
+
+    UE_LOG(LogKatanaCombatValidate, Display, TEXT("%d assets, %d invalid, %d errors, %d warnings, %d baked. Report: %s"),
+        Results.Num(), NumInvalidAssets, NumErrors, NumWarnings, Baked.Num(), *ReportPath);
+
+    const bool bFailed = NumErrors > 0 || (bWarningsAsErrors && NumWarnings > 0);
+    return bFailed ? 1 : 0;
+}
\ No newline at end of file
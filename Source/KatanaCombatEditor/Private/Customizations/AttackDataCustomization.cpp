@@ -2,6 +2,7 @@
 
 #include "Customizations/AttackDataCustomization.h"
 #include "Data/AttackData.h"
+#include "AttackDataTools.h"
 #include "DetailLayoutBuilder.h"
 #include "DetailCategoryBuilder.h"
 #include "DetailWidgetRow.h"
@@ -19,11 +20,114 @@
 
 #define LOCTEXT_NAMESPACE "AttackDataCustomization"
 
+TMap<FObjectKey, FAttackDataCustomization::FDetailsCacheEntry> FAttackDataCustomization::DetailsCache;
+FDelegateHandle FAttackDataCustomization::PropertyChangedHandle;
+
 TSharedRef<IDetailCustomization> FAttackDataCustomization::MakeInstance()
 {
     return MakeShareable(new FAttackDataCustomization);
 }
 
+// ============================================================================
+// DETAILS CACHE
+// ============================================================================
+
+void FAttackDataCustomization::RegisterCacheInvalidation()
+{
+    if (!PropertyChangedHandle.IsValid())
+    {
+        PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(&FAttackDataCustomization::OnObjectPropertyChanged);
+    }
+}
+
+void FAttackDataCustomization::UnregisterCacheInvalidation()
+{
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+    PropertyChangedHandle.Reset();
+    DetailsCache.Empty();
+}
+
+void FAttackDataCustomization::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+    // Montage edits (sections, notifies) and attack edits; covers undo/redo too
+    if (Object && (Object->IsA<UAttackData>() || Object->IsA<UAnimMontage>()))
+    {
+        InvalidateCache(Object);
+    }
+}
+
+void FAttackDataCustomization::InvalidateCache(const UObject* Object)
+{
+    if (!Object || DetailsCache.Num() == 0)
+    {
+        return;
+    }
+
+    // Attacks sharing a montage see each other as section conflicts - drop them together
+    TArray<FObjectKey, TInlineAllocator<2>> MontageKeys;
+    if (const UAttackData* AttackData = Cast<UAttackData>(Object))
+    {
+        MontageKeys.Add(FObjectKey(AttackData->AttackMontage.Get()));
+        if (const FDetailsCacheEntry* Entry = DetailsCache.Find(FObjectKey(AttackData)))
+        {
+            MontageKeys.AddUnique(Entry->MontageKey);
+        }
+        DetailsCache.Remove(FObjectKey(AttackData));
+    }
+    else
+    {
+        MontageKeys.Add(FObjectKey(Object));
+    }
+
+    for (auto It = DetailsCache.CreateIterator(); It; ++It)
+    {
+        if (MontageKeys.Contains(It.Value().MontageKey))
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+const FAttackDataCustomization::FDetailsCacheEntry& FAttackDataCustomization::GetCacheEntry() const
+{
+    const UAttackData* AttackData = CachedAttackData.Get();
+    const FObjectKey Key(AttackData);
+
+    if (const FDetailsCacheEntry* Existing = DetailsCache.Find(Key))
+    {
+        return *Existing;
+    }
+
+    FDetailsCacheEntry& Entry = DetailsCache.Add(Key);
+    Entry.SectionOptions.Add(MakeShareable(new FName(NAME_None))); // "Entire Montage"
+
+    if (!AttackData)
+    {
+        return Entry;
+    }
+
+    Entry.MontageKey = FObjectKey(AttackData->AttackMontage.Get());
+    if (const UAnimMontage* Montage = AttackData->AttackMontage)
+    {
+        for (const FCompositeSection& Section : Montage->CompositeSections)
+        {
+            Entry.SectionOptions.Add(MakeShareable(new FName(Section.SectionName)));
+        }
+    }
+
+    AttackData->GetSectionTimeRange(Entry.SectionStart, Entry.SectionEnd);
+    Entry.TimingPreview = FText::FromString(AttackData->GetTimingPreviewString());
+    Entry.bSectionValid = AttackData->ValidateMontageSection(Entry.SectionError);
+    Entry.bHasValidNotifyTiming = AttackData->HasValidNotifyTimingInSection();
+
+    for (UAttackData* Conflict : UAttackDataTools::FindSectionConflicts(const_cast<UAttackData*>(AttackData)))
+    {
+        Entry.SectionConflicts.Add(Conflict);
+    }
+
+    return Entry;
+}
+
 void FAttackDataCustomization::CustomizeDetails(IDetailLayoutBuilder& DetailBuilder)
 {
     // Get the AttackData being edited
@@ -159,11 +263,13 @@ void FAttackDataCustomization::AddValidationWarnings(IDetailLayoutBuilder& Detai
         return;
     }
     
+    const FDetailsCacheEntry& Cache = GetCacheEntry();
+
     // Check if using AnimNotify timing but notifies are missing
     if (CachedAttackData->bUseAnimNotifyTiming)
     {
-        FText ErrorMsg;
-        if (!CachedAttackData->ValidateMontageSection(ErrorMsg))
+        const FText& ErrorMsg = Cache.SectionError;
+        if (!Cache.bSectionValid)
         {
             WarningCategory.AddCustomRow(LOCTEXT("InvalidSectionWarning", "Invalid Section"))
             .WholeRowContent()
@@ -179,7 +285,7 @@ void FAttackDataCustomization::AddValidationWarnings(IDetailLayoutBuilder& Detai
                 ]
             ];
         }
-        else if (!CachedAttackData->HasValidNotifyTimingInSection())
+        else if (!Cache.bHasValidNotifyTiming)
         {
             WarningCategory.AddCustomRow(LOCTEXT("MissingNotifiesWarning", "Missing Notifies"))
             .WholeRowContent()
@@ -263,6 +369,7 @@ TSharedRef<SWidget> FAttackDataCustomization::CreateSectionSelector(IDetailLayou
                 {
                     CachedAttackData->MontageSection = *NewSelection;
                     CachedAttackData->MarkPackageDirty();
+                    InvalidateCache(CachedAttackData.Get());
                     RefreshDetails();
                 }
             })
@@ -289,6 +396,7 @@ TSharedRef<SWidget> FAttackDataCustomization::CreateSectionSelector(IDetailLayou
             .ToolTipText(LOCTEXT("RefreshSectionsTooltip", "Refresh section list from montage"))
             .OnClicked_Lambda([this]() -> FReply
             {
+                InvalidateCache(CachedAttackData.Get());
                 RefreshSectionOptions();
                 RefreshDetails();
                 return FReply::Handled();
@@ -343,6 +451,7 @@ TSharedRef<SWidget> FAttackDataCustomization::CreateChargeLoopSelector(IDetailLa
             .ToolTipText(LOCTEXT("RefreshSectionsTooltip", "Refresh section list from montage"))
             .OnClicked_Lambda([this]() -> FReply
             {
+                InvalidateCache(CachedAttackData.Get());
                 RefreshSectionOptions();
                 RefreshDetails();
                 return FReply::Handled();
@@ -397,6 +506,7 @@ TSharedRef<SWidget> FAttackDataCustomization::CreateChargeReleaseSelector(IDetai
             .ToolTipText(LOCTEXT("RefreshSectionsTooltip", "Refresh section list from montage"))
             .OnClicked_Lambda([this]() -> FReply
             {
+                InvalidateCache(CachedAttackData.Get());
                 RefreshSectionOptions();
                 RefreshDetails();
                 return FReply::Handled();
@@ -416,8 +526,9 @@ TSharedRef<SWidget> FAttackDataCustomization::CreateSectionInfoWidget()
                 if (!CachedAttackData.IsValid()) 
                     return LOCTEXT("NoData", "No AttackData");
                 
-                float Start, End;
-                CachedAttackData->GetSectionTimeRange(Start, End);
+                const FDetailsCacheEntry& Cache = GetCacheEntry();
+                const float Start = Cache.SectionStart;
+                const float End = Cache.SectionEnd;
                 
                 return FText::FromString(FString::Printf(
                     TEXT("Section Range: %.2fs - %.2fs (%.2fs duration)"),
@@ -520,6 +631,18 @@ TSharedRef<SWidget> FAttackDataCustomization::CreateActionButtons()
             .IsEnabled_Lambda([this]() { return CachedAttackData.IsValid(); })
         ]
         
+        + SHorizontalBox::Slot()
+        .AutoWidth()
+        .Padding(2.0f)
+        [
+            SNew(SButton)
+            .Text(LOCTEXT("BakeSwingVolume", "Bake Swing Volume"))
+            .ToolTipText(LOCTEXT("BakeSwingVolumeTooltip", 
+                "Sample the weapon sockets across the Active phase so the weapon can skip sweeps while no target is near the swing"))
+            .OnClicked(this, &FAttackDataCustomization::OnBakeSwingVolumeClicked)
+            .IsEnabled_Lambda([this]() { return CachedAttackData.IsValid() && CachedAttackData->AttackMontage != nullptr; })
+        ]
+        
         + SHorizontalBox::Slot()
         .AutoWidth()
         .Padding(2.0f)
@@ -539,6 +662,7 @@ FReply FAttackDataCustomization::OnAutoCalculateClicked()
     
     CachedAttackData->AutoCalculateTimingFromSection();
     CachedAttackData->MarkPackageDirty();
+    InvalidateCache(CachedAttackData.Get());
     
     FMessageDialog::Open(EAppMsgType::Ok,
         LOCTEXT("TimingCalculated", "Timing has been auto-calculated based on montage length and attack type."));
@@ -552,7 +676,10 @@ FReply FAttackDataCustomization::OnGenerateNotifiesClicked()
     if (!CachedAttackData.IsValid()) 
         return FReply::Handled();
     
-    if (CachedAttackData->GenerateNotifiesInSection())
+    const bool bGenerated = CachedAttackData->GenerateNotifiesInSection();
+    InvalidateCache(CachedAttackData.Get());
+
+    if (bGenerated)
     {
         FMessageDialog::Open(EAppMsgType::Ok,
             LOCTEXT("NotifiesGenerated", 
@@ -590,6 +717,28 @@ FReply FAttackDataCustomization::OnValidateSectionClicked()
     return FReply::Handled();
 }
 
+FReply FAttackDataCustomization::OnBakeSwingVolumeClicked()
+{
+    if (!CachedAttackData.IsValid()) 
+        return FReply::Handled();
+    
+    if (UAttackDataTools::BakeSwingVolume(CachedAttackData.Get()))
+    {
+        FMessageDialog::Open(EAppMsgType::Ok,
+            FText::Format(LOCTEXT("SwingVolumeBaked", "Swing volume baked ({0} samples)."),
+                FText::AsNumber(CachedAttackData->SwingVolume.GetNumSamples())));
+    }
+    else
+    {
+        FMessageDialog::Open(EAppMsgType::Ok,
+            LOCTEXT("SwingVolumeBakeFailed", 
+                "Failed to bake the swing volume. Check the output log - the montage needs a preview mesh with the weapon sockets."));
+    }
+    
+    RefreshDetails();
+    return FReply::Handled();
+}
+
 FReply FAttackDataCustomization::OnPreviewTimelineClicked()
 {
     ShowTimelinePreview();
@@ -608,20 +757,8 @@ FReply FAttackDataCustomization::OnOpenMontageClicked()
 
 void FAttackDataCustomization::RefreshSectionOptions()
 {
-    SectionOptions.Empty();
-    
-    // Always add "Entire Montage" option
-    SectionOptions.Add(MakeShareable(new FName(NAME_None)));
-    
-    if (CachedAttackData.IsValid() && CachedAttackData->AttackMontage)
-    {
-        UAnimMontage* Montage = CachedAttackData->AttackMontage;
-        for (int32 i = 0; i < Montage->CompositeSections.Num(); ++i)
-        {
-            FName SectionName = Montage->CompositeSections[i].SectionName;
-            SectionOptions.Add(MakeShareable(new FName(SectionName)));
-        }
-    }
+    // "Entire Montage" + montage sections, from the details cache
+    SectionOptions = GetCacheEntry().SectionOptions;
 }
 
 FText FAttackDataCustomization::GetTimingPreviewText() const
@@ -629,15 +766,23 @@ FText FAttackDataCustomization::GetTimingPreviewText() const
     if (!CachedAttackData.IsValid())
         return LOCTEXT("NoPreview", "No preview available");
     
-    return FText::FromString(CachedAttackData->GetTimingPreviewString());
+    return GetCacheEntry().TimingPreview;
 }
 
 TArray<UAttackData*> FAttackDataCustomization::FindSectionConflicts() const
 {
+    TArray<UAttackData*> Conflicts;
     if (!CachedAttackData.IsValid())
-        return TArray<UAttackData*>();
+        return Conflicts;
     
-    return CachedAttackData->FindOtherUsersOfSection();
+    for (const TWeakObjectPtr<UAttackData>& Conflict : GetCacheEntry().SectionConflicts)
+    {
+        if (UAttackData* ConflictData = Conflict.Get())
+        {
+            Conflicts.Add(ConflictData);
+        }
+    }
+    return Conflicts;
 }
 
 void FAttackDataCustomization::ShowTimelinePreview()
@@ -4,16 +4,33 @@
 #include "PropertyEditorModule.h"
 #include "Customizations/AttackDataCustomization.h"
 #include "Data/AttackData.h"
+#include "ComboGraph/SComboGraphView.h"
+#include "Telemetry/SCombatTelemetryView.h"
+#include "Framework/Docking/TabManager.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Features/IModularFeatures.h"
+#include "RewindDebugger/CombatStateTrace.h"
+#include "RewindDebugger/CombatStateTrack.h"
 
 #define LOCTEXT_NAMESPACE "FKatanaCombatEditorModule"
 
+static FCombatStateTraceModule GCombatStateTraceModule;
+static FCombatStateTrackCreator GCombatStateTrackCreator;
+
 void FKatanaCombatEditorModule::StartupModule()
 {
 	RegisterCustomizations();
+	RegisterTabs();
+	RegisterRewindDebugger();
 }
 
 void FKatanaCombatEditorModule::ShutdownModule()
 {
+	UnregisterRewindDebugger();
+	UnregisterTabs();
 	UnregisterCustomizations();
 }
 
@@ -27,10 +44,14 @@ void FKatanaCombatEditorModule::RegisterCustomizations()
 		UAttackData::StaticClass()->GetFName(),
 		FOnGetDetailCustomizationInstance::CreateStatic(&FAttackDataCustomization::MakeInstance)
 	);
+
+	FAttackDataCustomization::RegisterCacheInvalidation();
 }
 
 void FKatanaCombatEditorModule::UnregisterCustomizations()
 {
+	FAttackDataCustomization::UnregisterCacheInvalidation();
+
 	if (FModuleManager::Get().IsModuleLoaded("PropertyEditor"))
 	{
 		FPropertyEditorModule& PropertyModule = 
@@ -40,6 +61,56 @@ void FKatanaCombatEditorModule::UnregisterCustomizations()
 	}
 }
 
+void FKatanaCombatEditorModule::RegisterTabs()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(SComboGraphView::TabId,
+		FOnSpawnTab::CreateLambda([](const FSpawnTabArgs&)
+		{
+			return SNew(SDockTab)
+				.TabRole(ETabRole::NomadTab)
+				[
+					SNew(SComboGraphView)
+				];
+		}))
+		.SetDisplayName(LOCTEXT("ComboGraphTabTitle", "Katana Combo Graph"))
+		.SetTooltipText(LOCTEXT("ComboGraphTabTooltip", "View a moveset's compiled combo graph, unreachable attacks and cycles"))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(SCombatTelemetryView::TabId,
+		FOnSpawnTab::CreateLambda([](const FSpawnTabArgs&)
+		{
+			return SNew(SDockTab)
+				.TabRole(ETabRole::NomadTab)
+				[
+					SNew(SCombatTelemetryView)
+				];
+		}))
+		.SetDisplayName(LOCTEXT("TelemetryTabTitle", "Katana Combat Telemetry"))
+		.SetTooltipText(LOCTEXT("TelemetryTabTooltip", "Watch window, input and queue timing streamed from a running device"))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+}
+
+void FKatanaCombatEditorModule::UnregisterTabs()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(SComboGraphView::TabId);
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(SCombatTelemetryView::TabId);
+	}
+}
+
+void FKatanaCombatEditorModule::RegisterRewindDebugger()
+{
+	IModularFeatures::Get().RegisterModularFeature(TraceServices::ModuleFeatureName, &GCombatStateTraceModule);
+	IModularFeatures::Get().RegisterModularFeature(RewindDebugger::IRewindDebuggerTrackCreator::ModularFeatureName, &GCombatStateTrackCreator);
+}
+
+void FKatanaCombatEditorModule::UnregisterRewindDebugger()
+{
+	IModularFeatures::Get().UnregisterModularFeature(RewindDebugger::IRewindDebuggerTrackCreator::ModularFeatureName, &GCombatStateTrackCreator);
+	IModularFeatures::Get().UnregisterModularFeature(TraceServices::ModuleFeatureName, &GCombatStateTraceModule);
+}
+
 #undef LOCTEXT_NAMESPACE
 
 IMPLEMENT_MODULE(FKatanaCombatEditorModule, KatanaCombatEditor)
\ No newline at end of file
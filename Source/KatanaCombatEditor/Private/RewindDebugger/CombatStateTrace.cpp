@@ -0,0 +1,101 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RewindDebugger/CombatStateTrace.h"
+#include "Algo/BinarySearch.h"
+
+const FName FCombatStateTraceProvider::ProviderName(TEXT("KatanaCombatStateProvider"));
+
+// ============================================================================
+// PROVIDER
+// ============================================================================
+
+void FCombatStateTraceProvider::AppendFrame(uint64 ObjectId, FCombatStateTraceFrame&& Frame)
+{
+    TArray<FCombatStateTraceFrame>& Frames = FramesByObject.FindOrAdd(ObjectId);
+
+    // Events arrive in order per thread; everything is sent from the game thread
+    if (Frames.Num() > 0 && Frames.Last().Time > Frame.Time)
+    {
+        const int32 Index = Algo::UpperBoundBy(Frames, Frame.Time, &FCombatStateTraceFrame::Time);
+        Frames.Insert(MoveTemp(Frame), Index);
+        return;
+    }
+
+    Frames.Add(MoveTemp(Frame));
+}
+
+const FCombatStateTraceFrame* FCombatStateTraceProvider::FindFrameAtTime(uint64 ObjectId, double Time) const
+{
+    const TArray<FCombatStateTraceFrame>* Frames = FramesByObject.Find(ObjectId);
+    if (!Frames)
+    {
+        return nullptr;
+    }
+
+    const int32 Index = Algo::UpperBoundBy(*Frames, Time, &FCombatStateTraceFrame::Time) - 1;
+    return Frames->IsValidIndex(Index) ? &(*Frames)[Index] : nullptr;
+}
+
+// ============================================================================
+// ANALYZER
+// ============================================================================
+
+FCombatStateTraceAnalyzer::FCombatStateTraceAnalyzer(TraceServices::IAnalysisSession& InSession, FCombatStateTraceProvider& InProvider)
+    : Session(InSession)
+    , Provider(InProvider)
+{
+}
+
+void FCombatStateTraceAnalyzer::OnAnalysisBegin(const FOnAnalysisContext& Context)
+{
+    Context.InterfaceBuilder.RouteEvent(RouteId_CombatState, "Combat", "CombatState");
+}
+
+bool FCombatStateTraceAnalyzer::OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context)
+{
+    if (RouteId != RouteId_CombatState)
+    {
+        return true;
+    }
+
+    const FEventData& EventData = Context.EventData;
+
+    FCombatStateTraceFrame Frame;
+    Frame.Time = Context.EventTime.AsSeconds(EventData.GetValue<uint64>("Cycle"));
+    Frame.RecordingTime = EventData.GetValue<double>("RecordingTime");
+    Frame.Phase = static_cast<EAttackPhase>(EventData.GetValue<uint8>("Phase"));
+    Frame.CombatState = static_cast<ECombatState>(EventData.GetValue<uint8>("CombatState"));
+    Frame.Posture = EventData.GetValue<int16>("Posture");
+    Frame.MaxPosture = EventData.GetValue<int16>("MaxPosture");
+    Frame.ActiveWindows = EventData.GetValue<uint8>("ActiveWindows");
+    Frame.Queue.Append(EventData.GetArrayView<uint8>("Queue"));
+
+    const double Time = Frame.Time;
+
+    TraceServices::FAnalysisSessionEditScope EditScope(Session);
+    Provider.AppendFrame(EventData.GetValue<uint64>("ObjectId"), MoveTemp(Frame));
+    Session.UpdateDurationSeconds(Time);
+    return true;
+}
+
+// ============================================================================
+// MODULE
+// ============================================================================
+
+void FCombatStateTraceModule::GetModuleInfo(TraceServices::FModuleInfo& OutModuleInfo)
+{
+    OutModuleInfo.Name = TEXT("KatanaCombatState");
+    OutModuleInfo.DisplayName = TEXT("Katana Combat State");
+}
+
+void FCombatStateTraceModule::OnAnalysisBegin(TraceServices::IAnalysisSession& Session)
+{
+    TSharedPtr<FCombatStateTraceProvider> Provider = MakeShared<FCombatStateTraceProvider>();
+    Session.AddProvider(FCombatStateTraceProvider::ProviderName, Provider);
+    Session.AddAnalyzer(new FCombatStateTraceAnalyzer(Session, *Provider));
+}
+
+void FCombatStateTraceModule::GetLoggers(TArray<const TCHAR*>& OutLoggers)
+{
+    OutLoggers.Add(TEXT("Combat"));
+}
@@ -0,0 +1,91 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTypes.h"
+#include "Trace/Analyzer.h"
+#include "TraceServices/Model/AnalysisSession.h"
+#include "TraceServices/ModuleService.h"
+
+/**
+ * One Combat.CombatState event (see CombatTrace::FCombatStateSample)
+ * Each frame holds until the next one for the same object
+ */
+struct FCombatStateTraceFrame
+{
+    /** Trace session time (seconds) */
+    double Time = 0.0;
+
+    /** Game world time when it was sent */
+    double RecordingTime = 0.0;
+
+    EAttackPhase Phase = EAttackPhase::None;
+    ECombatState CombatState = ECombatState::Idle;
+    int16 Posture = 0;
+    int16 MaxPosture = 0;
+
+    /** Bit per EActionWindowType */
+    uint8 ActiveWindows = 0;
+
+    /** Packed queue entries: EInputType low nibble, EActionState high nibble */
+    TArray<uint8, TInlineAllocator<8>> Queue;
+};
+
+/**
+ * Analysis-side store of combat state per traced object
+ * Written by FCombatStateTraceAnalyzer under the session edit lock, read under the read lock
+ */
+class FCombatStateTraceProvider : public TraceServices::IProvider
+{
+public:
+    static const FName ProviderName;
+
+    void AppendFrame(uint64 ObjectId, FCombatStateTraceFrame&& Frame);
+
+    bool HasObject(uint64 ObjectId) const { return FramesByObject.Contains(ObjectId); }
+
+    /** Frames for an object in time order (nullptr if it never sent any) */
+    const TArray<FCombatStateTraceFrame>* GetFrames(uint64 ObjectId) const { return FramesByObject.Find(ObjectId); }
+
+    /** Frame in effect at Time (nullptr before the first one) */
+    const FCombatStateTraceFrame* FindFrameAtTime(uint64 ObjectId, double Time) const;
+
+private:
+    TMap<uint64, TArray<FCombatStateTraceFrame>> FramesByObject;
+};
+
+/**
+ * Routes Combat.CombatState trace events into FCombatStateTraceProvider
+ */
+class FCombatStateTraceAnalyzer : public UE::Trace::IAnalyzer
+{
+public:
+    FCombatStateTraceAnalyzer(TraceServices::IAnalysisSession& InSession, FCombatStateTraceProvider& InProvider);
+
+    virtual void OnAnalysisBegin(const FOnAnalysisContext& Context) override;
+    virtual bool OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context) override;
+
+private:
+    enum : uint16
+    {
+        RouteId_CombatState
+    };
+
+    TraceServices::IAnalysisSession& Session;
+    FCombatStateTraceProvider& Provider;
+};
+
+/**
+ * Trace services module: adds the combat provider and analyzer to every analysis session
+ * (registered as a modular feature by FKatanaCombatEditorModule)
+ */
+class FCombatStateTraceModule : public TraceServices::IModule
+{
+public:
+    virtual void GetModuleInfo(TraceServices::FModuleInfo& OutModuleInfo) override;
+    virtual void OnAnalysisBegin(TraceServices::IAnalysisSession& Session) override;
+    virtual void GetLoggers(TArray<const TCHAR*>& OutLoggers) override;
+    virtual void GenerateReports(const TraceServices::IAnalysisSession& Session, const TCHAR* CmdLine, const TCHAR* OutputDirectory) override {}
+    virtual const TCHAR* GetCommandLineArgument() override { return TEXT("combatstate"); }
+};
@@ -0,0 +1,193 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RewindDebugger/CombatStateTrack.h"
+#include "RewindDebugger/CombatStateTrace.h"
+#include "ActionQueueTypes.h"
+#include "IRewindDebugger.h"
+#include "Styling/AppStyle.h"
+#include "TraceServices/Model/AnalysisSession.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "CombatStateTrack"
+
+namespace
+{
+    FLinearColor GetPhaseColor(EAttackPhase Phase)
+    {
+        switch (Phase)
+        {
+            case EAttackPhase::Windup:   return FLinearColor(0.9f, 0.75f, 0.2f);
+            case EAttackPhase::Active:   return FLinearColor(0.9f, 0.25f, 0.2f);
+            case EAttackPhase::Recovery: return FLinearColor(0.3f, 0.55f, 0.9f);
+            default:                     return FLinearColor(0.5f, 0.5f, 0.5f);
+        }
+    }
+}
+
+// ============================================================================
+// TRACK
+// ============================================================================
+
+FCombatStateTrack::FCombatStateTrack(uint64 InObjectId)
+    : ObjectId(InObjectId)
+    , Icon(FAppStyle::GetAppStyleSetName(), "Icons.Event")
+    , EventData(MakeShared<SEventTimelineView::FTimelineEventData>())
+{
+}
+
+FText FCombatStateTrack::GetDisplayNameInternal() const
+{
+    return LOCTEXT("TrackName", "Combat State");
+}
+
+bool FCombatStateTrack::UpdateInternal()
+{
+    const IRewindDebugger* RewindDebugger = IRewindDebugger::Instance();
+    const TraceServices::IAnalysisSession* Session = RewindDebugger ? RewindDebugger->GetAnalysisSession() : nullptr;
+    if (!Session)
+    {
+        return false;
+    }
+
+    TraceServices::FAnalysisSessionReadScope ReadScope(*Session);
+
+    const FCombatStateTraceProvider* Provider = Session->ReadProvider<FCombatStateTraceProvider>(FCombatStateTraceProvider::ProviderName);
+    const TArray<FCombatStateTraceFrame>* Frames = Provider ? Provider->GetFrames(ObjectId) : nullptr;
+    if (!Frames)
+    {
+        return false;
+    }
+
+    // Frames only ever get appended while recording, so the count tells us when to rebuild
+    if (Frames->Num() != NumFramesBuilt)
+    {
+        RebuildEventData(*Frames);
+    }
+
+    const double TraceTime = RewindDebugger->CurrentTraceTime();
+    if (DetailsText.IsValid() && TraceTime != DetailsTime)
+    {
+        DetailsTime = TraceTime;
+        const FCombatStateTraceFrame* Frame = Provider->FindFrameAtTime(ObjectId, TraceTime);
+        DetailsText->SetText(Frame ? DescribeFrame(*Frame) : LOCTEXT("NoState", "No combat state recorded yet"));
+    }
+
+    return false;
+}
+
+void FCombatStateTrack::RebuildEventData(const TArray<FCombatStateTraceFrame>& Frames)
+{
+    EventData->Points.Reset();
+    EventData->Windows.Reset();
+    NumFramesBuilt = Frames.Num();
+
+    int32 PhaseStart = INDEX_NONE;
+    for (int32 Index = 0; Index < Frames.Num(); ++Index)
+    {
+        const FCombatStateTraceFrame& Frame = Frames[Index];
+        const FCombatStateTraceFrame* Previous = Index > 0 ? &Frames[Index - 1] : nullptr;
+
+        if (!Previous || Previous->CombatState != Frame.CombatState)
+        {
+            EventData->Points.Add({ Frame.Time, UEnum::GetDisplayValueAsText(Frame.CombatState), FLinearColor::White });
+        }
+
+        if (Previous && Previous->Phase == Frame.Phase)
+        {
+            continue;
+        }
+
+        // Phase changed: close the open window, open the next (idle frames leave a gap)
+        if (PhaseStart != INDEX_NONE)
+        {
+            const FCombatStateTraceFrame& Start = Frames[PhaseStart];
+            EventData->Windows.Add({ Start.Time, Frame.Time, UEnum::GetDisplayValueAsText(Start.Phase), GetPhaseColor(Start.Phase) });
+        }
+        PhaseStart = Frame.Phase != EAttackPhase::None ? Index : INDEX_NONE;
+    }
+
+    // Still in a phase at the end of the recording: hold it to the last sample
+    if (PhaseStart != INDEX_NONE && Frames.Num() > 0)
+    {
+        const FCombatStateTraceFrame& Start = Frames[PhaseStart];
+        EventData->Windows.Add({ Start.Time, FMath::Max(Frames.Last().Time, Start.Time), UEnum::GetDisplayValueAsText(Start.Phase), GetPhaseColor(Start.Phase) });
+    }
+}
+
+TSharedPtr<SWidget> FCombatStateTrack::GetTimelineViewInternal()
+{
+    return SNew(SEventTimelineView)
+        .ViewRange_Lambda([]() { return IRewindDebugger::Instance()->GetCurrentViewRange(); })
+        .EventData_Raw(this, &FCombatStateTrack::GetEventData);
+}
+
+TSharedPtr<SWidget> FCombatStateTrack::GetDetailsViewInternal()
+{
+    DetailsTime = -1.0;
+    return SAssignNew(DetailsText, STextBlock)
+        .Font(FAppStyle::GetFontStyle("MonoFont"));
+}
+
+FText FCombatStateTrack::DescribeFrame(const FCombatStateTraceFrame& Frame)
+{
+    FString Windows;
+    for (uint8 Type = 0; Type <= static_cast<uint8>(EActionWindowType::Recovery); ++Type)
+    {
+        if (Frame.ActiveWindows & (1u << Type))
+        {
+            Windows += (Windows.IsEmpty() ? TEXT("") : TEXT(", ")) + UEnum::GetDisplayValueAsText(static_cast<EActionWindowType>(Type)).ToString();
+        }
+    }
+
+    FString Queue;
+    for (const uint8 Packed : Frame.Queue)
+    {
+        Queue += FString::Printf(TEXT("%s%s (%s)"), Queue.IsEmpty() ? TEXT("") : TEXT(", "),
+            *UEnum::GetDisplayValueAsText(static_cast<EInputType>(Packed & 0x0F)).ToString(),
+            *UEnum::GetDisplayValueAsText(static_cast<EActionState>(Packed >> 4)).ToString());
+    }
+
+    return FText::FromString(FString::Printf(TEXT("Phase:       %s\nState:       %s\nPosture:     %d / %d\nCheckpoints: %s\nQueue:       %s\nWorld time:  %.3f"),
+        *UEnum::GetDisplayValueAsText(Frame.Phase).ToString(),
+        *UEnum::GetDisplayValueAsText(Frame.CombatState).ToString(),
+        Frame.Posture, Frame.MaxPosture,
+        Windows.IsEmpty() ? TEXT("-") : *Windows,
+        Queue.IsEmpty() ? TEXT("-") : *Queue,
+        Frame.RecordingTime));
+}
+
+// ============================================================================
+// CREATOR
+// ============================================================================
+
+FName FCombatStateTrackCreator::GetTargetTypeNameInternal() const
+{
+    static const FName ActorTypeName(TEXT("Actor"));
+    return ActorTypeName;
+}
+
+void FCombatStateTrackCreator::GetTrackTypesInternal(TArray<RewindDebugger::FRewindDebuggerTrackType>& Types) const
+{
+    Types.Add({ GetNameInternal(), LOCTEXT("TrackTypeName", "Combat State") });
+}
+
+TSharedPtr<RewindDebugger::FRewindDebuggerTrack> FCombatStateTrackCreator::CreateTrackInternal(uint64 ObjectId) const
+{
+    return MakeShared<FCombatStateTrack>(ObjectId);
+}
+
+bool FCombatStateTrackCreator::HasDebugInfoInternal(uint64 ObjectId) const
+{
+    const IRewindDebugger* RewindDebugger = IRewindDebugger::Instance();
+    const TraceServices::IAnalysisSession* Session = RewindDebugger ? RewindDebugger->GetAnalysisSession() : nullptr;
+    if (!Session)
+    {
+        return false;
+    }
+
+    TraceServices::FAnalysisSessionReadScope ReadScope(*Session);
+    const FCombatStateTraceProvider* Provider = Session->ReadProvider<FCombatStateTraceProvider>(FCombatStateTraceProvider::ProviderName);
+    return Provider && Provider->HasObject(ObjectId);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,65 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IRewindDebuggerTrackCreator.h"
+#include "RewindDebuggerTrack.h"
+#include "SEventTimelineView.h"
+
+class STextBlock;
+struct FCombatStateTraceFrame;
+
+/**
+ * Rewind Debugger track for a character's combat state (CombatState trace channel)
+ *
+ * Timeline: one window per attack phase, points where ECombatState changes.
+ * Details: phase, state, posture, the V2 queue and active checkpoints at the scrub time.
+ */
+class FCombatStateTrack : public RewindDebugger::FRewindDebuggerTrack
+{
+public:
+    explicit FCombatStateTrack(uint64 InObjectId);
+
+    /** One line per field, as shown in the details view */
+    static FText DescribeFrame(const FCombatStateTraceFrame& Frame);
+
+private:
+    virtual bool UpdateInternal() override;
+    virtual TSharedPtr<SWidget> GetTimelineViewInternal() override;
+    virtual TSharedPtr<SWidget> GetDetailsViewInternal() override;
+    virtual FSlateIcon GetIconInternal() override { return Icon; }
+    virtual FName GetNameInternal() const override { return "CombatState"; }
+    virtual FText GetDisplayNameInternal() const override;
+    virtual uint64 GetObjectIdInternal() const override { return ObjectId; }
+
+    TSharedPtr<SEventTimelineView::FTimelineEventData> GetEventData() const { return EventData; }
+
+    /** Rebuild the timeline from the provider's frames */
+    void RebuildEventData(const TArray<FCombatStateTraceFrame>& Frames);
+
+    uint64 ObjectId = 0;
+    FSlateIcon Icon;
+
+    TSharedPtr<SEventTimelineView::FTimelineEventData> EventData;
+
+    /** Frames the timeline was built from (rebuild when the provider has more) */
+    int32 NumFramesBuilt = 0;
+
+    TSharedPtr<STextBlock> DetailsText;
+    double DetailsTime = -1.0;
+};
+
+/**
+ * Adds FCombatStateTrack under any actor that sent combat state
+ * (registered as a modular feature by FKatanaCombatEditorModule)
+ */
+class FCombatStateTrackCreator : public RewindDebugger::IRewindDebuggerTrackCreator
+{
+private:
+    virtual FName GetTargetTypeNameInternal() const override;
+    virtual FName GetNameInternal() const override { return "CombatState"; }
+    virtual void GetTrackTypesInternal(TArray<RewindDebugger::FRewindDebuggerTrackType>& Types) const override;
+    virtual TSharedPtr<RewindDebugger::FRewindDebuggerTrack> CreateTrackInternal(uint64 ObjectId) const override;
+    virtual bool HasDebugInfoInternal(uint64 ObjectId) const override;
+};
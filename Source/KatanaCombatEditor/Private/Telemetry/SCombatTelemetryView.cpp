@@ -0,0 +1,254 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Telemetry/SCombatTelemetryView.h"
+#include "Debug/SCombatDebugDopeSheet.h"
+#include "Algo/BinarySearch.h"
+#include "Styling/AppStyle.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/STextComboBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "SCombatTelemetryView"
+
+const FName SCombatTelemetryView::TabId(TEXT("KatanaCombatTelemetry"));
+
+void SCombatTelemetryView::Construct(const FArguments& InArgs)
+{
+    ChildSlot
+    [
+        SNew(SVerticalBox)
+
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4.0f)
+        [
+            SNew(SHorizontalBox)
+
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .VAlign(VAlign_Center)
+            .Padding(0.0f, 0.0f, 4.0f, 0.0f)
+            [
+                SNew(STextBlock).Text(LOCTEXT("Host", "Device"))
+            ]
+
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            .Padding(0.0f, 0.0f, 4.0f, 0.0f)
+            [
+                SAssignNew(HostText, SEditableTextBox)
+                .Text(FText::FromString(TEXT("127.0.0.1")))
+                .ToolTipText(LOCTEXT("HostTooltip", "Address of the device running with -CombatTelemetry or Combat.Telemetry.Start"))
+            ]
+
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .Padding(0.0f, 0.0f, 4.0f, 0.0f)
+            [
+                SNew(SBox)
+                .WidthOverride(70.0f)
+                [
+                    SAssignNew(PortText, SEditableTextBox)
+                    .Text(FText::AsNumber(FCombatTelemetryServer::DefaultPort, &FNumberFormattingOptions::DefaultNoGrouping()))
+                ]
+            ]
+
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SButton)
+                .Text(this, &SCombatTelemetryView::GetConnectButtonText)
+                .OnClicked(this, &SCombatTelemetryView::OnConnectClicked)
+            ]
+        ]
+
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4.0f, 0.0f, 4.0f, 4.0f)
+        [
+            SNew(SHorizontalBox)
+
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .Padding(0.0f, 0.0f, 8.0f, 0.0f)
+            [
+                SNew(SBox)
+                .WidthOverride(240.0f)
+                [
+                    SAssignNew(OwnerCombo, STextComboBox)
+                    .OptionsSource(&OwnerOptions)
+                    .OnSelectionChanged(this, &SCombatTelemetryView::OnOwnerSelected)
+                ]
+            ]
+
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            .VAlign(VAlign_Center)
+            [
+                SNew(STextBlock)
+                .Text(this, &SCombatTelemetryView::GetStatusText)
+            ]
+        ]
+
+        + SVerticalBox::Slot()
+        .FillHeight(1.0f)
+        [
+            SNew(SScrollBox)
+            + SScrollBox::Slot()
+            [
+                SAssignNew(DopeSheet, SCombatDebugDopeSheet, nullptr)
+                .ViewRangeMin(0.0f)
+                .ViewRangeMax(ViewSeconds)
+            ]
+        ]
+    ];
+
+    RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SCombatTelemetryView::Poll));
+}
+
+FReply SCombatTelemetryView::OnConnectClicked()
+{
+    if (Client.IsConnected())
+    {
+        Client.Disconnect();
+        return FReply::Handled();
+    }
+
+    History.Reset();
+    Owners.Reset();
+    OwnerOptions.Reset();
+    OwnerCombo->RefreshOptions();
+    SelectedOwner = 0;
+    OwnerNamesVersion = 0;
+    DopeSheet->ClearRecordedEvents();
+
+    const FString Host = HostText->GetText().ToString().TrimStartAndEnd();
+    const int32 Port = FCString::Atoi(*PortText->GetText().ToString());
+    if (!Client.Connect(Host, Port > 0 ? Port : FCombatTelemetryServer::DefaultPort))
+    {
+        UE_LOG(LogCombat, Warning, TEXT("[CombatTelemetry] Could not connect to %s:%d"), *Host, Port);
+    }
+    return FReply::Handled();
+}
+
+FText SCombatTelemetryView::GetConnectButtonText() const
+{
+    return Client.IsConnected() ? LOCTEXT("Disconnect", "Disconnect") : LOCTEXT("Connect", "Connect");
+}
+
+FText SCombatTelemetryView::GetStatusText() const
+{
+    const FCombatCaptureStreamDecoder& Decoder = Client.GetDecoder();
+    return FText::Format(LOCTEXT("Status", "{0} - {1} events, {2} lost on device, {3} KB received"),
+        Client.IsConnected() ? LOCTEXT("Connected", "Connected") : LOCTEXT("NotConnected", "Not connected"),
+        FText::AsNumber(Decoder.GetNumEvents()),
+        FText::AsNumber(Decoder.GetNumLostEvents()),
+        FText::AsNumber(Client.GetNumBytesReceived() / 1024));
+}
+
+void SCombatTelemetryView::OnOwnerSelected(TSharedPtr<FString> Option, ESelectInfo::Type SelectInfo)
+{
+    const int32 Index = OwnerOptions.IndexOfByKey(Option);
+    const uint32 Owner = Owners.IsValidIndex(Index) ? Owners[Index] : 0;
+    if (Owner != SelectedOwner)
+    {
+        SelectedOwner = Owner;
+        ReplayHistory();
+    }
+}
+
+EActiveTimerReturnType SCombatTelemetryView::Poll(double InCurrentTime, float InDeltaTime)
+{
+    if (!Client.IsConnected())
+    {
+        return EActiveTimerReturnType::Continue;
+    }
+
+    Received.Reset();
+    Client.Poll([this](const FCombatRecordedEvent& Event)
+    {
+        Received.Add(Event);
+    });
+
+    if (Received.Num() == 0)
+    {
+        return EActiveTimerReturnType::Continue;
+    }
+
+    // New owners become options (names arrive in the stream before the first event that uses them)
+    const FCombatCaptureStreamDecoder& Decoder = Client.GetDecoder();
+    bool bOwnersChanged = Decoder.GetNamesVersion() != OwnerNamesVersion;
+    for (const FCombatRecordedEvent& Event : Received)
+    {
+        if (Event.OwnerId != 0 && !Owners.Contains(Event.OwnerId))
+        {
+            Owners.Add(Event.OwnerId);
+            OwnerOptions.Add(MakeShared<FString>());
+            bOwnersChanged = true;
+        }
+    }
+
+    if (bOwnersChanged)
+    {
+        OwnerNamesVersion = Decoder.GetNamesVersion();
+        for (int32 Index = 0; Index < Owners.Num(); ++Index)
+        {
+            *OwnerOptions[Index] = Decoder.GetName(Owners[Index]);
+        }
+        OwnerCombo->RefreshOptions();
+
+        if (SelectedOwner == 0 && OwnerOptions.Num() > 0)
+        {
+            OwnerCombo->SetSelectedItem(OwnerOptions[0]);
+        }
+    }
+
+    History.Append(Received);
+
+    SelectedReceived.Reset();
+    for (const FCombatRecordedEvent& Event : Received)
+    {
+        if (Event.OwnerId == SelectedOwner)
+        {
+            SelectedReceived.Add(Event);
+        }
+    }
+    DopeSheet->AppendRecordedEvents(SelectedReceived);
+
+    // Keep as much history as the sheet shows (events arrive in time order)
+    const uint64 OldestCycle = History.Last().Cycle - FMath::Min<uint64>(History.Last().Cycle,
+        static_cast<uint64>(DopeSheet->RecordedHistorySeconds / FPlatformTime::GetSecondsPerCycle64()));
+    const int32 NumExpired = Algo::LowerBoundBy(History, OldestCycle, &FCombatRecordedEvent::Cycle);
+    if (NumExpired > 0)
+    {
+        History.RemoveAt(0, NumExpired, EAllowShrinking::No);
+    }
+
+    // Follow the newest event
+    const float Latest = static_cast<float>(FPlatformTime::ToSeconds64(History.Last().Cycle));
+    DopeSheet->SetViewRange(FMath::Max(Latest - ViewSeconds, 0.0f), FMath::Max(Latest, ViewSeconds));
+    DopeSheet->SetCurrentTime(Latest);
+
+    return EActiveTimerReturnType::Continue;
+}
+
+void SCombatTelemetryView::ReplayHistory()
+{
+    DopeSheet->ClearRecordedEvents();
+
+    SelectedReceived.Reset();
+    for (const FCombatRecordedEvent& Event : History)
+    {
+        if (Event.OwnerId == SelectedOwner)
+        {
+            SelectedReceived.Add(Event);
+        }
+    }
+    DopeSheet->AppendRecordedEvents(SelectedReceived);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -9,10 +9,62 @@
 
 class UAttackData;
 class UAnimMontage;
+class USkeletalMesh;
 class UAnimNotifyState_AttackPhase;
 class UAnimNotifyState_ComboWindow;
 class UAnimNotify_ToggleHitDetection;
 struct FAnimNotifyEvent;
+struct FAssetData;
+
+/**
+ * Messages from validating one AttackData asset (see UAttackDataTools::BatchAnalyze)
+ */
+struct FAttackDataValidationResult
+{
+    UAttackData* AttackData = nullptr;
+    TArray<FText> Warnings;
+    TArray<FText> Errors;
+
+    bool IsValid() const { return Errors.Num() == 0; }
+};
+
+/**
+ * Notify density and weapon trace cost of one montage (see UAttackDataTools::BuildMontageNotifyReports)
+ */
+struct FMontageNotifyCostReport
+{
+    UAnimMontage* Montage = nullptr;
+
+    /** AttackData assets playing this montage */
+    TArray<UAttackData*> Attacks;
+
+    /** Instant notifies (AnimNotify) */
+    int32 NumNotifies = 0;
+
+    /** Notify states (AnimNotifyState) */
+    int32 NumNotifyStates = 0;
+
+    /** Most notifies and notify states touching a single frame at the montage's sampling rate */
+    int32 PeakNotifiesPerFrame = 0;
+
+    /** Montage time of the first frame reaching PeakNotifiesPerFrame */
+    float PeakFrameTime = 0.0f;
+
+    /** Hit detection windows (ToggleHitDetection pairs, else Active phases) */
+    int32 NumSwings = 0;
+
+    /** Seconds with hit detection enabled across the whole montage (= weapon trace time) */
+    float HitDetectionTime = 0.0f;
+
+    /** True when no ToggleHitDetection pair was found and Active phase notifies were used instead */
+    bool bHitDetectionFromPhases = false;
+
+    /** Sweeps per swing at the reference frame rate, one per frame */
+    float EstimatedTracesPerSwing = 0.0f;
+
+    /** Sweeps per swing if every frame hits the weapon's substep cap (UWeaponComponent::MaxSweepSubsteps) */
+    float WorstCaseTracesPerSwing = 0.0f;
+};
 
 /**
  * Static utility functions for working with AttackData in the editor
@@ -115,7 +167,7 @@ public:
 
     /**
      * Generate all notifies (AttackPhase + HitDetection + ComboWindow)
-     * Convenience function that calls all generation functions
+     * Same single pass as BatchGenerateNotifies uses per montage
      * 
      * @param AttackData - Attack to generate notifies for
      * @return True if all notifies were successfully generated
@@ -141,6 +193,7 @@ public:
     /**
      * Find other AttackData assets using the same montage section
      * Used to detect conflicts where multiple attacks use same section
+     * Answered by UAttackSectionIndexSubsystem once its index is built (registry tag scan before that)
      * 
      * @param AttackData - Attack to check conflicts for
      * @return Array of conflicting AttackData assets
@@ -170,6 +223,24 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Attack Data Tools")
     static bool ValidateAttackData(UAttackData* AttackData, TArray<FText>& OutWarnings, TArray<FText>& OutErrors);
 
+    /**
+     * Check the cooked timing block against a fresh scan of the montage
+     * 
+     * @param AttackData - Attack to check
+     * @return True if the saved block matches the montage's current notifies/sections
+     */
+    UFUNCTION(BlueprintCallable, Category = "Attack Data Tools")
+    static bool IsTimingCacheCurrent(UAttackData* AttackData);
+
+    /**
+     * Regenerate the cooked timing block and mark the asset dirty if it changed
+     * 
+     * @param AttackData - Attack to refresh
+     * @return True if the block changed
+     */
+    UFUNCTION(BlueprintCallable, Category = "Attack Data Tools")
+    static bool RefreshTimingCache(UAttackData* AttackData);
+
     // ============================================================================
     // VISUALIZATION
     // ============================================================================
@@ -251,8 +322,27 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Attack Data Tools")
     static TArray<UAttackData*> FindAllAttackDataAssets();
 
+    /**
+     * Get registry entries for every AttackData asset without loading them
+     * Tags (UAttackData::AttackMontageTagName etc.) can be read from the results
+     * 
+     * @param OutAssetData - Registry entries (replaced)
+     */
+    static void GetAllAttackDataAssetData(TArray<FAssetData>& OutAssetData);
+
+    /**
+     * Find AttackData assets that link to an attack (combo, directional or context variant)
+     * Filtered by registry tags; only matches are loaded
+     * 
+     * @param AttackData - Link target
+     * @return Array of AttackData linking to it
+     */
+    UFUNCTION(BlueprintCallable, Category = "Attack Data Tools")
+    static TArray<UAttackData*> FindAttackDataLinkingTo(UAttackData* AttackData);
+
     /**
      * Find AttackData assets using specific montage
+     * Filtered by registry tags; only matches are loaded
      * 
      * @param Montage - Montage to search for
      * @return Array of AttackData using this montage
@@ -262,6 +352,7 @@ public:
 
     /**
      * Find AttackData assets of specific type
+     * Filtered by registry tags; only matches are loaded
      * 
      * @param AttackType - Type to filter by
      * @return Array of AttackData of this type
@@ -275,6 +366,8 @@ public:
 
     /**
      * Batch generate notifies for multiple AttackData assets
+     * Section validation and timing planning run in parallel (read-only);
+     * montage edits are applied on the game thread as one undoable transaction
      * 
      * @param AttackDataArray - Assets to process
      * @param OutSuccessCount - Number of successful operations
@@ -286,6 +379,7 @@ public:
 
     /**
      * Batch validate multiple AttackData assets
+     * Section, timing and cycle checks run in parallel (section sharing is a warning and is skipped)
      * 
      * @param AttackDataArray - Assets to validate
      * @param OutValidAssets - Assets that passed validation
@@ -294,11 +388,97 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Attack Data Tools")
     static void BatchValidate(const TArray<UAttackData*>& AttackDataArray, TArray<UAttackData*>& OutValidAssets, TArray<UAttackData*>& OutInvalidAssets);
 
+    /**
+     * Run the read-only validation checks over many assets in parallel, keeping every message
+     * Used by BatchValidate and the KatanaCombatValidate commandlet
+     * 
+     * @param AttackDataArray - Assets to analyze (must already be loaded)
+     * @param OutResults - One result per input, same order
+     */
+    static void BatchAnalyze(const TArray<UAttackData*>& AttackDataArray, TArray<FAttackDataValidationResult>& OutResults);
+
+    // ============================================================================
+    // SWING VOLUMES
+    // ============================================================================
+
+    /**
+     * Bake the blade trajectory over the attack's Active phase into AttackData->SwingVolume
+     * Samples the weapon sockets in the montage pose (root locked to the reference pose, as with root
+     * motion) so UWeaponComponent can skip sweeps while no target is inside the swing.
+     * 
+     * @param AttackData - Attack to bake (needs a montage)
+     * @param Mesh - Mesh carrying the weapon sockets (nullptr = montage/skeleton preview mesh)
+     * @param StartSocket - Blade base socket (None = UWeaponComponent default)
+     * @param EndSocket - Blade tip socket (None = UWeaponComponent default)
+     * @param SampleRate - Samples per second of montage time
+     * @return True if the trajectory was baked
+     */
+    UFUNCTION(BlueprintCallable, Category = "Attack Data Tools")
+    static bool BakeSwingVolume(UAttackData* AttackData, USkeletalMesh* Mesh = nullptr, FName StartSocket = NAME_None, FName EndSocket = NAME_None, float SampleRate = 60.0f);
+
+    /**
+     * Bake swing volumes for multiple AttackData assets (one undoable transaction)
+     * 
+     * @param AttackDataArray - Assets to process
+     * @param OutSuccessCount - Number of assets baked
+     * @param OutFailureCount - Number of assets skipped (no montage, no mesh, missing sockets)
+     * @return True if at least one succeeded
+     */
+    UFUNCTION(BlueprintCallable, Category = "Attack Data Tools")
+    static bool BatchBakeSwingVolumes(const TArray<UAttackData*>& AttackDataArray, int32& OutSuccessCount, int32& OutFailureCount);
+
+    // ============================================================================
+    // COST REPORTS
+    // ============================================================================
+
+    /**
+     * Analyze the notify density and weapon trace cost of every montage used by the given attacks
+     * Montages are analyzed in parallel (read-only)
+     * 
+     * @param AttackDataArray - Attacks whose montages to analyze (must already be loaded)
+     * @param ReferenceFrameRate - Game frame rate used to turn trace time into trace counts
+     * @param OutReports - One report per distinct montage, most expensive swing first
+     */
+    static void BuildMontageNotifyReports(const TArray<UAttackData*>& AttackDataArray, float ReferenceFrameRate, TArray<FMontageNotifyCostReport>& OutReports);
+
+    /**
+     * Notify density and trace cost report for every AttackData montage in the project, as text
+     * Also written to the log
+     * 
+     * @param ReferenceFrameRate - Game frame rate used to turn trace time into trace counts
+     * @return One line per montage
+     */
+    UFUNCTION(BlueprintCallable, Category = "Attack Data Tools")
+    static FString GetMontageNotifyReport(float ReferenceFrameRate = 60.0f);
+
 private:
     // ============================================================================
     // INTERNAL HELPERS
     // ============================================================================
 
+    /**
+     * Default timing from section length and attack type, written to OutTiming only
+     * Read-only on AttackData (safe off the game thread)
+     */
+    static bool CalculateDefaultTiming(const UAttackData* AttackData, FAttackPhaseTimingOverride& OutTiming);
+
+    /**
+     * Checks shared by ValidateAttackData and BatchValidate that only read assets (safe off the game thread)
+     * Covers section, notify timing, cooked timing, combo links, cycles, directional follow-ups and
+     * Terminal tags - not section sharing (registry query)
+     */
+    static void AnalyzeAttackData(UAttackData* AttackData, TArray<FText>& OutWarnings, TArray<FText>& OutErrors);
+
+    /** Fill one montage's notify counts, per-frame overlap and hit detection windows (safe off the game thread) */
+    static void AnalyzeMontageNotifies(FMontageNotifyCostReport& Report, float ReferenceFrameRate, int32 MaxSweepSubsteps);
+
+    /**
+     * Load the AttackData assets that pass a registry query
+     * @param TagFilter - Tested against tagged registry entries (no load)
+     * @param LoadedFilter - Tested instead for assets saved before the tags existed (loads them)
+     */
+    static TArray<UAttackData*> FindAttackDataByRegistryTags(TFunctionRef<bool(const FAssetData&)> TagFilter, TFunctionRef<bool(const UAttackData*)> LoadedFilter);
+
     /** Add notify state to montage at specific time */
     static bool AddNotifyStateToMontage(UAnimMontage* Montage, float StartTime, float Duration, UAnimNotifyState* NotifyState, FName SectionName);
 
@@ -308,9 +488,28 @@ private:
     /** Remove all notifies of specific type from section */
     static void RemoveNotifiesOfType(UAnimMontage* Montage, FName SectionName, UClass* NotifyClass);
 
+    /** Remove all notifies of any of the types from any of the sections, in one pass over the montage */
+    static void RemoveNotifiesOfTypes(UAnimMontage* Montage, TConstArrayView<FName> SectionNames, TConstArrayView<UClass*> NotifyClasses);
+
+    /**
+     * Regenerate every notify of the given attacks on their shared montage
+     * One Modify, one removal pass and one refresh for the montage however many sections it has;
+     * timing blocks refresh once the montage is final
+     * @return Number of attacks whose notifies were all generated
+     */
+    static int32 GenerateNotifiesForMontage(UAnimMontage* Montage, TConstArrayView<UAttackData*> Attacks);
+
+    /** Append one attack's notifies to its section, assuming the old ones were removed (no refresh) */
+    static bool AppendAttackPhaseNotifies(UAttackData* AttackData);
+    static bool AppendHitDetectionNotifies(UAttackData* AttackData);
+    static bool AppendComboWindowNotify(UAttackData* AttackData);
+
     /** Convert section-relative time to montage-absolute time */
     static float SectionTimeToMontageTime(UAnimMontage* Montage, FName SectionName, float SectionRelativeTime);
 
+    /** Active phase of the attack in montage time (transition notifies, else the cooked phase durations) */
+    static bool GetActiveTimeRange(const UAttackData* AttackData, float& OutStart, float& OutEnd);
+
     /** Get default timing percentages for attack type */
     static void GetDefaultTimingPercentages(EAttackType AttackType, float& OutWindupPercent, float& OutActivePercent, float& OutRecoveryPercent);
 
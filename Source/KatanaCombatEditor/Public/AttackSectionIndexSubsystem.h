@@ -0,0 +1,85 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "UObject/SoftObjectPath.h"
+#include "AttackSectionIndexSubsystem.generated.h"
+
+class UAttackData;
+class UPackage;
+struct FAssetData;
+class FObjectPostSaveContext;
+
+/**
+ * Reverse index of (montage, section) -> AttackData assets for instant conflict checks
+ *
+ * Built once from asset registry tags (no loads), then kept current incrementally:
+ * - Asset saved, or montage/section edited in the details panel -> re-keyed from the object
+ * - Asset added (imported/duplicated) -> keyed from its registry tags
+ * - Asset renamed -> path swapped in place
+ * - Asset deleted -> removed
+ *
+ * Queried by UAttackDataTools::FindSectionConflicts (details customization and validation).
+ */
+UCLASS()
+class KATANACOMBATEDITOR_API UAttackSectionIndexSubsystem : public UEditorSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Subsystem for the running editor (nullptr outside the editor or before startup) */
+    static UAttackSectionIndexSubsystem* Get();
+
+    /** Has the initial registry scan completed? (queries return nothing before that) */
+    bool IsIndexBuilt() const { return bIndexBuilt; }
+
+    /**
+     * Other AttackData assets keyed to the same montage section (loads only the matches)
+     * Attacks without a montage or section never conflict
+     */
+    TArray<UAttackData*> FindOtherUsersOfSection(const UAttackData* AttackData) const;
+
+    /** Asset paths keyed to a montage section (no loads) */
+    void GetSectionUsers(const FSoftObjectPath& MontagePath, FName SectionName, TArray<FSoftObjectPath>& OutAttackPaths) const;
+
+    /** Re-key one attack from its current (possibly unsaved) montage/section */
+    void UpdateAttack(const UAttackData* AttackData);
+
+private:
+    using FSectionKey = TPair<FSoftObjectPath, FName>;
+
+    void BuildIndex();
+    void SetAttackKey(const FSoftObjectPath& AttackPath, const FSectionKey& Key);
+    void RemoveAttack(const FSoftObjectPath& AttackPath);
+
+    /** Key stored in an asset's registry tags (false if the asset predates the tags) */
+    static bool GetKeyFromTags(const FAssetData& AssetData, FSectionKey& OutKey);
+    static FSectionKey GetKeyFromObject(const UAttackData* AttackData);
+
+    void OnFilesLoaded();
+    void OnAssetAdded(const FAssetData& AssetData);
+    void OnAssetRemoved(const FAssetData& AssetData);
+    void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+    void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext);
+    void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& PropertyChangedEvent);
+
+    /** (montage, section) -> attacks using it */
+    TMap<FSectionKey, TArray<FSoftObjectPath>> SectionUsers;
+
+    /** Attack -> its current key (for removal/re-keying without a scan) */
+    TMap<FSoftObjectPath, FSectionKey> AttackKeys;
+
+    bool bIndexBuilt = false;
+
+    FDelegateHandle FilesLoadedHandle;
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+    FDelegateHandle PackageSavedHandle;
+    FDelegateHandle PropertyChangedHandle;
+};
\ No newline at end of file
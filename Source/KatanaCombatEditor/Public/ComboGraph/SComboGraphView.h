@@ -0,0 +1,110 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/SLeafWidget.h"
+#include "Data/CompiledComboGraph.h"
+
+class UAttackConfiguration;
+struct FAssetData;
+
+/**
+ * Precomputed layout of a compiled combo graph
+ * Built once per Rebuild; painting only reads it
+ */
+struct FComboGraphLayout
+{
+    struct FNode
+    {
+        FVector2D Position = FVector2D::ZeroVector;
+        FString Label;
+        FString MontageName;
+
+        /** No compiled transition (or context variant) from the root ever selects this attack */
+        bool bUnreachable = false;
+
+        /** Endpoint of a back edge found by cycle detection */
+        bool bInCycle = false;
+    };
+
+    struct FEdge
+    {
+        int32 From = INDEX_NONE;
+        int32 To = INDEX_NONE;
+
+        /** Some input resolves along this link (otherwise authored but shadowed) */
+        bool bResolvable = false;
+
+        /** Back edge reported by cycle detection */
+        bool bCycle = false;
+    };
+
+    TArray<FNode> Nodes;
+    TArray<FEdge> Edges;
+    FVector2D Size = FVector2D::ZeroVector;
+    int32 NumUnreachable = 0;
+    int32 NumCycleEdges = 0;
+
+    /** Distinct montages across reachable attacks (what a moveset must preload) */
+    int32 NumMontages = 0;
+
+    static constexpr float NodeWidth = 200.0f;
+    static constexpr float NodeHeight = 44.0f;
+    static constexpr float ColumnSpacing = 260.0f;
+    static constexpr float RowSpacing = 64.0f;
+
+    /** Layered layout: column = link depth from the root, row = discovery order */
+    void Build(const FCompiledComboGraph& Graph);
+};
+
+/**
+ * Paints a FComboGraphLayout (nodes as boxes, links as lines)
+ */
+class SComboGraphCanvas : public SLeafWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SComboGraphCanvas) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const FComboGraphLayout* InLayout);
+
+    virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+    virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+    const FComboGraphLayout* Layout = nullptr;
+};
+
+/**
+ * Moveset-wide combo graph view for one UAttackConfiguration
+ *
+ * Compiles the same FCompiledComboGraph the runtime resolves against, lays it out once,
+ * and highlights unreachable attacks (orange) and cycles (red).
+ * Opened from Window > Katana Combo Graph.
+ */
+class SComboGraphView : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SComboGraphView) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+    /** Tab id registered by the editor module */
+    static const FName TabId;
+
+private:
+    void OnConfigurationChanged(const FAssetData& AssetData);
+    FString GetConfigurationPath() const;
+    FText GetSummaryText() const;
+
+    /** Recompile the graph and recompute the layout */
+    void Rebuild();
+
+    TWeakObjectPtr<UAttackConfiguration> Configuration;
+    FCompiledComboGraph Graph;
+    FComboGraphLayout Layout;
+};
\ No newline at end of file
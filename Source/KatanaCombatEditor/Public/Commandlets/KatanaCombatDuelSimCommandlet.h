@@ -0,0 +1,40 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "KatanaCombatDuelSimCommandlet.generated.h"
+
+/**
+ * Headless duel simulation for balance sweeps on build machines
+ *
+ * Usage:
+ *   UnrealEditor-Cmd.exe <Project> -run=KatanaCombatDuelSim -Settings=<CombatSettings> [-OpponentSettings=<CombatSettings>]
+ *     [-Duels=2000] [-Seed=1] [-MaxDuration=60] [-SampleInterval=0.5] [-Health=100]
+ *     [-Aggression=0.6] [-BlockChance=0.3] [-HeavyChance=0.3] [-ComboChance=0.7] [-RandomPolicies]
+ *     [-Sweep=<Parameter>:<Min>:<Max>:<Points>] [-Output=<Directory>]
+ *
+ * Steps:
+ * 1. Load the fighters' CombatSettings and cook their AttackConfiguration movesets (FCombatDuelMoveset)
+ * 2. For each sweep point, override one simulation tunable on both fighters' shared config
+ * 3. Run the duels across worker threads (FCombatDuelSimulator::RunDuels)
+ * 4. Write Summary.csv (win rates, DPS, guard breaks per sweep point) and PostureCurves.csv
+ *    (mean posture over time) (default: <ProjectSaved>/KatanaCombat/DuelSim/)
+ *
+ * Policy switches apply to both fighters; suffix B (e.g. -AggressionB=0.4) overrides the opponent's.
+ * Sweepable: MaxPosture, PostureRegenRate_Attacking, PostureRegenRate_Idle, GuardBreakStunDuration,
+ * GuardBreakRecoveryPercent, ComboResetDelay.
+ *
+ * Returns 0 on success, 1 on bad arguments, missing movesets or write failures.
+ */
+UCLASS()
+class KATANACOMBATEDITOR_API UKatanaCombatDuelSimCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UKatanaCombatDuelSimCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
\ No newline at end of file
@@ -0,0 +1,35 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "KatanaCombatValidateCommandlet.generated.h"
+
+/**
+ * Headless moveset validation and pre-bake for build machines
+ *
+ * Usage:
+ *   UnrealEditor-Cmd.exe <Project> -run=KatanaCombatValidate [-Bake] [-Report=<Path>] [-WarningsAsErrors]
+ *
+ * Steps:
+ * 1. Load every UAttackData asset
+ * 2. Validate them in parallel (UAttackDataTools::BatchAnalyze: section, notify timing, cooked timing,
+ *    cycles, directional follow-ups, Terminal tags)
+ * 3. Compile the combo graph of every UAttackConfiguration (node count, cycles)
+ * 4. Report notify density and weapon trace cost of every attack montage (at 60 fps)
+ * 5. -Bake: regenerate stale cooked timing blocks and save those packages
+ * 6. Write a JSON report (default: <ProjectSaved>/KatanaCombat/ValidationReport.json)
+ *
+ * Returns 0 when no asset has errors (or warnings, with -WarningsAsErrors), 1 otherwise.
+ */
+UCLASS()
+class KATANACOMBATEDITOR_API UKatanaCombatValidateCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UKatanaCombatValidateCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
\ No newline at end of file
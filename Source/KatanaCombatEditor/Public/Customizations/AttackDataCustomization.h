@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "IDetailCustomization.h"
 #include "Input/Reply.h"
+#include "UObject/ObjectKey.h"
 
 class UAttackData;
 class IDetailLayoutBuilder;
@@ -37,7 +38,43 @@ public:
     /** IDetailCustomization interface */
     virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
 
+    /** Hook/unhook the change notifications that invalidate the details cache (module startup/shutdown) */
+    static void RegisterCacheInvalidation();
+    static void UnregisterCacheInvalidation();
+
 private:
+    // ============================================================================
+    // DETAILS CACHE (shared across panel rebuilds)
+    // ============================================================================
+
+    /** Everything the panel derives from the asset and its montage */
+    struct FDetailsCacheEntry
+    {
+        /** Montage the entry was built from (attack edits invalidate entries sharing it) */
+        FObjectKey MontageKey;
+
+        TArray<TSharedPtr<FName>> SectionOptions;
+        float SectionStart = 0.0f;
+        float SectionEnd = 0.0f;
+        FText TimingPreview;
+
+        bool bSectionValid = true;
+        FText SectionError;
+        bool bHasValidNotifyTiming = false;
+        TArray<TWeakObjectPtr<UAttackData>> SectionConflicts;
+    };
+
+    /** Entry for the current asset, rebuilt on first use after invalidation */
+    const FDetailsCacheEntry& GetCacheEntry() const;
+
+    /** Drop entries built from an attack or montage (and attacks sharing that montage) */
+    static void InvalidateCache(const UObject* Object);
+
+    static void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& PropertyChangedEvent);
+
+    static TMap<FObjectKey, FDetailsCacheEntry> DetailsCache;
+    static FDelegateHandle PropertyChangedHandle;
+
     /** Currently selected AttackData asset */
     TWeakObjectPtr<UAttackData> CachedAttackData;
 
@@ -92,6 +129,9 @@ private:
     /** Called when "Validate Section" button is pressed */
     FReply OnValidateSectionClicked();
 
+    /** Called when "Bake Swing Volume" button is pressed */
+    FReply OnBakeSwingVolumeClicked();
+
     /** Called when "Preview Timeline" button is pressed */
     FReply OnPreviewTimelineClicked();
 
@@ -14,6 +14,9 @@
  * - Timing calculation tools
  * - AnimNotify generation tools
  * - Montage section validation
+ * - Moveset-wide combo graph view
+ * - Live combat telemetry dope sheet for a device (-CombatTelemetry)
+ * - Rewind Debugger combat state track (-trace=default,object,combatstate)
  * 
  * This module is completely optional. The combat system works perfectly
  * without it - this just provides convenience tools for designers.
@@ -31,4 +34,16 @@ private:
 
     /** Unregister custom details customizations */
     void UnregisterCustomizations();
+
+    /** Register editor tabs (combo graph view, telemetry view) */
+    void RegisterTabs();
+
+    /** Unregister editor tabs */
+    void UnregisterTabs();
+
+    /** Register the combat state trace analysis and Rewind Debugger track */
+    void RegisterRewindDebugger();
+
+    /** Unregister the combat state trace analysis and Rewind Debugger track */
+    void UnregisterRewindDebugger();
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Debug/CombatEventRecorder.h"
+#include "Debug/CombatTelemetry.h"
+
+class SCombatDebugDopeSheet;
+class SEditableTextBox;
+class STextComboBox;
+
+/**
+ * Live dope sheet for a game streaming combat telemetry (Combat.Telemetry.Start / -CombatTelemetry)
+ *
+ * Connects an FCombatTelemetryClient to the device, polls it every editor frame and feeds the chosen
+ * character's window, input and queue events to an SCombatDebugDopeSheet that follows the newest
+ * event. Nothing is drawn on the device itself.
+ * Opened from Window > Katana Combat Telemetry.
+ */
+class SCombatTelemetryView : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SCombatTelemetryView) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+    /** Tab id registered by the editor module */
+    static const FName TabId;
+
+private:
+    FReply OnConnectClicked();
+    FText GetConnectButtonText() const;
+    FText GetStatusText() const;
+    void OnOwnerSelected(TSharedPtr<FString> Option, ESelectInfo::Type SelectInfo);
+
+    /** Read the socket, record new owners and feed the selected owner's events to the sheet */
+    EActiveTimerReturnType Poll(double InCurrentTime, float InDeltaTime);
+
+    /** Refill the sheet from History for SelectedOwner */
+    void ReplayHistory();
+
+    /** Seconds of the newest events shown */
+    static constexpr float ViewSeconds = 5.0f;
+
+    FCombatTelemetryClient Client;
+
+    /** Everything received, for switching owner without losing what came before (trimmed to the sheet's history) */
+    TArray<FCombatRecordedEvent> History;
+
+    /** Owner name indices in the order they first sent events, parallel to OwnerOptions */
+    TArray<uint32> Owners;
+    TArray<TSharedPtr<FString>> OwnerOptions;
+    uint32 SelectedOwner = 0;
+    uint32 OwnerNamesVersion = 0;
+
+    TSharedPtr<SEditableTextBox> HostText;
+    TSharedPtr<SEditableTextBox> PortText;
+    TSharedPtr<STextComboBox> OwnerCombo;
+    TSharedPtr<SCombatDebugDopeSheet> DopeSheet;
+
+    /** Scratch for one poll */
+    TArray<FCombatRecordedEvent> Received;
+    TArray<FCombatRecordedEvent> SelectedReceived;
+};
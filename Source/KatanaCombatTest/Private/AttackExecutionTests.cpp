@@ -1,6 +1,22 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CombatTestHelpers.h"
+#include "Data/CompiledComboGraph.h"
+#include "Data/ComboGraphValidationCache.h"
+#include "Data/AttackConfiguration.h"
+#include "Core/ComboPreloadSubsystem.h"
+#include "Core/WeaponComponent.h"
+#include "Core/HurtboxComponent.h"
+#include "Core/BladeNarrowphase.h"
+#include "Core/AsyncBladeTrace.h"
+#include "Core/HitReactionComponent.h"
+#include "Core/CombatProjectileSubsystem.h"
+#include "Data/CombatArchetype.h"
+#include "Utilities/MontageUtilityLibrary.h"
+#include "Animation/AnimNotify_ToggleHitDetection.h"
+#include "Animation/CombatNotifySink.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
 
 /**
  * Test: ExecuteAttack vs ExecuteComboAttack Separation
@@ -104,5 +120,1134 @@ bool FAttackExecutionTest::RunTest(const FString& Parameters)
 	World->DestroyActor(TestCharacter);
 	FCombatTestHelpers::DestroyTestWorld(World);
 
+	return true;
+}
+
+/**
+ * Test: Compiled Combo Graph matches ResolveNextAttack_V2
+ * Verifies every (attack, input, direction, hold, combo window) slot resolves identically
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCompiledComboGraphTest, "KatanaCombat.CombatComponent.CompiledComboGraph", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCompiledComboGraphTest::RunTest(const FString& Parameters)
+{
+	// Light chain with a directional follow-up and a heavy branch
+	UAttackData* Light1 = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Light2 = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Heavy1 = FCombatTestHelpers::CreateTestAttack(EAttackType::Heavy);
+	UAttackData* HeavyBranch = FCombatTestHelpers::CreateTestAttack(EAttackType::Heavy);
+	UAttackData* ForwardFollowUp = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+
+	Light1->NextComboAttack = Light2;
+	Light1->HeavyComboAttack = HeavyBranch;
+	Light1->DirectionalFollowUps.Add(EAttackDirection::Forward, ForwardFollowUp);
+
+	// Test 1: Build assigns root + every reachable attack
+	FCompiledComboGraph Graph;
+	Graph.Build(Light1, Heavy1);
+
+	TestEqual("Graph should contain root + 5 attacks", Graph.GetNumNodes(), 6);
+	TestFalse("Acyclic chain should not report cycles", Graph.HasCycles());
+	TestEqual("nullptr should map to root node", Graph.FindNode(nullptr), FCompiledComboGraph::RootNode);
+	TestEqual("Unknown attack should not be found",
+		Graph.FindNode(FCombatTestHelpers::CreateTestAttack()), static_cast<int32>(INDEX_NONE));
+
+	// Animation prewarm lists each montage once, however many attacks share it
+	UAnimMontage* SharedMontage = NewObject<UAnimMontage>();
+	Light1->AttackMontage = SharedMontage;
+	Light2->AttackMontage = SharedMontage;
+	TArray<UAnimMontage*> Montages;
+	Graph.GetMontages(Montages);
+	TestEqual("Shared montage should be listed once", Montages.Num(), 1);
+
+	// Test 2: Every slot resolves the same as the runtime walker
+	const TArray<UAttackData*> Currents = { nullptr, Light1, Light2, Heavy1, HeavyBranch, ForwardFollowUp };
+	FGameplayTagContainer NoContext;
+	TSet<UAttackData*> Visited;
+
+	for (UAttackData* Current : Currents)
+	{
+		for (EInputType InputType : { EInputType::LightAttack, EInputType::HeavyAttack, EInputType::Block })
+		{
+			for (int32 DirIdx = 0; DirIdx <= static_cast<int32>(EAttackDirection::Right); ++DirIdx)
+			{
+				const EAttackDirection Direction = static_cast<EAttackDirection>(DirIdx);
+				for (bool bHolding : { false, true })
+				{
+					for (bool bCombo : { false, true })
+					{
+						Visited.Reset();
+						const FAttackResolutionResult Expected = UMontageUtilityLibrary::ResolveNextAttack_V2(
+							Current, InputType, Direction, bHolding, bCombo, Light1, Heavy1, NoContext, Visited);
+						const FAttackResolutionResult Compiled = Graph.Resolve(
+							Graph.FindNode(Current), InputType, Direction, bHolding, bCombo);
+
+						TestEqual("Compiled attack should match runtime resolution", Compiled.Attack.Get(), Expected.Attack.Get());
+						if (Expected.Attack)
+						{
+							TestEqual("Compiled path should match runtime resolution", Compiled.Path, Expected.Path);
+							TestEqual("Compiled clear flag should match runtime resolution",
+								Compiled.bShouldClearDirectionalInput, Expected.bShouldClearDirectionalInput);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Test 3: Cycles are reported at build time
+	Light2->NextComboAttack = Light1;
+	AddExpectedError(TEXT("Circular reference in combo chain"), EAutomationExpectedErrorFlags::Contains, 1);
+	Graph.Build(Light1, Heavy1);
+	TestTrue("Looping chain should report a cycle", Graph.HasCycles());
+	TestEqual("Looping chain should still resolve by index",
+		Graph.Resolve(Graph.FindNode(Light2), EInputType::LightAttack, EAttackDirection::None, false, true).Attack.Get(), Light1);
+
+	return true;
+}
+
+/**
+ * Test: AI move selection from the compiled combo graph
+ * Verifies node metadata is precomputed at build, the utility score prefers damage rate and penalizes
+ * windup and parry windows, moves out of reach are skipped and combo follow-ups come with their direction
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FComboGraphMoveSelectionTest, "KatanaCombat.CombatComponent.ComboGraphMoveSelection", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FComboGraphMoveSelectionTest::RunTest(const FString& Parameters)
+{
+	UAttackData* Light1 = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Light2 = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Heavy1 = FCombatTestHelpers::CreateTestAttack(EAttackType::Heavy);
+	UAttackData* ForwardFollowUp = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+
+	Light1->NextComboAttack = Light2;
+	Light1->DirectionalFollowUps.Add(EAttackDirection::Forward, ForwardFollowUp);
+
+	// The heavy opener hits hardest but barely closes distance
+	Heavy1->BaseDamage = 80.0f;
+	Heavy1->MotionWarpingConfig.MaxWarpDistance = 100.0f;
+	ForwardFollowUp->BaseDamage = 60.0f;
+
+	FCompiledComboGraph Graph;
+	Graph.Build(Light1, Heavy1);
+
+	// Metadata
+	const FCompiledComboNodeInfo& HeavyInfo = Graph.GetNodeInfo(Graph.FindNode(Heavy1));
+	TestEqual("Expected damage cooked", HeavyInfo.ExpectedDamage, 80.0f);
+	TestEqual("Reach cooked", HeavyInfo.Reach, Heavy1->GetMaxTargetDistance());
+	TestTrue("Durations cooked", HeavyInfo.GetTotalDuration() > 0.0f);
+	TestEqual("Root has no metadata", Graph.GetNodeInfo(FCompiledComboGraph::RootNode).ExpectedDamage, 0.0f);
+	TestEqual("Invalid node has no metadata", Graph.GetNodeInfo(100).ExpectedDamage, 0.0f);
+
+	// Score: damage rate up, windup and parry windows down
+	FComboMoveUtilityWeights Weights;
+	Weights.Variation = 0.0f;
+	FCompiledComboNodeInfo Info;
+	Info.ExpectedDamage = 20.0f;
+	Info.WindupDuration = 0.2f;
+	Info.ActiveDuration = 0.2f;
+	Info.RecoveryDuration = 0.6f;
+	const float BaseScore = FCompiledComboGraph::ScoreMove(Info, Weights);
+	FCompiledComboNodeInfo Parryable = Info;
+	Parryable.ParryWindow = 0.3f;
+	TestTrue("Parry window lowers the score", FCompiledComboGraph::ScoreMove(Parryable, Weights) < BaseScore);
+	FCompiledComboNodeInfo Slow = Info;
+	Slow.WindupDuration = 0.6f;
+	TestTrue("Slower windup lowers the score", FCompiledComboGraph::ScoreMove(Slow, Weights) < BaseScore);
+
+	// Openers: heavy wins when reach is ignored or the target is close
+	FComboMoveChoice Choice;
+	if (TestTrue("Opener selected", Graph.SelectMove(FCompiledComboGraph::RootNode, false, -1.0f, Weights, Choice)))
+	{
+		TestEqual("Hardest opener wins", Choice.Node, Graph.FindNode(Heavy1));
+		TestEqual("Pressed as heavy", Choice.InputType, EInputType::HeavyAttack);
+	}
+
+	// Out of the heavy's reach: light opener instead
+	if (TestTrue("Opener within reach selected", Graph.SelectMove(FCompiledComboGraph::RootNode, false, 300.0f, Weights, Choice)))
+	{
+		TestEqual("Reachable opener wins", Choice.Node, Graph.FindNode(Light1));
+		TestEqual("Pressed as light", Choice.InputType, EInputType::LightAttack);
+	}
+
+	TestFalse("Nothing reaches a distant target", Graph.SelectMove(FCompiledComboGraph::RootNode, false, 5000.0f, Weights, Choice));
+
+	// Follow-up out of the heavy opener's reach: the directional branch is worth the most
+	if (TestTrue("Follow-up selected", Graph.SelectMove(Graph.FindNode(Light1), true, 200.0f, Weights, Choice)))
+	{
+		TestEqual("Best follow-up wins", Choice.Node, Graph.FindNode(ForwardFollowUp));
+		TestEqual("Follow-up direction", Choice.Direction, EAttackDirection::Forward);
+		TestEqual("Direction round trips to input", CombatHelpers::InputToAttackDirection(CombatHelpers::AttackToInputDirection(Choice.Direction)), Choice.Direction);
+	}
+
+	TestFalse("Invalid node selects nothing", Graph.SelectMove(INDEX_NONE, false, -1.0f, Weights, Choice));
+
+	return true;
+}
+
+#if WITH_EDITOR
+/**
+ * Test: Incremental combo graph validation
+ * Verifies cycle results are memoized and an edit only revalidates the attack and what leads to it
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FComboGraphValidationCacheTest, "KatanaCombat.CombatComponent.ComboGraphValidationCache", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FComboGraphValidationCacheTest::RunTest(const FString& Parameters)
+{
+	FComboGraphValidationCache& Cache = FComboGraphValidationCache::Get();
+	Cache.Reset();
+
+	// Chain of 8: Chain[0] -> Chain[1] -> ... -> Chain[7]
+	TArray<UAttackData*> Chain;
+	for (int32 Index = 0; Index < 8; ++Index)
+	{
+		Chain.Add(FCombatTestHelpers::CreateTestAttack(EAttackType::Light));
+		if (Index > 0)
+		{
+			Chain[Index - 1]->NextComboAttack = Chain[Index];
+		}
+	}
+
+	// Test 1: First query walks the chain once, later queries are lookups
+	TestFalse("Acyclic chain has no cycle", Cache.ReachesCycle(Chain[0]));
+	TestEqual("Every node validated once", Cache.GetNumNodesValidated(), 8);
+	for (UAttackData* Attack : Chain)
+	{
+		TestFalse("Cached result for every node", Cache.ReachesCycle(Attack));
+	}
+	TestEqual("Cached queries validate nothing", Cache.GetNumNodesValidated(), 8);
+
+	// Test 2: Closing a loop at Chain[5] revalidates only Chain[0..5]
+	Chain[5]->HeavyComboAttack = Chain[3];
+	Cache.Invalidate(Chain[5]);
+
+	TArray<FText> Errors;
+	TestTrue("Loop is reachable from the head", Cache.GetCycleErrors(Chain[0], Errors));
+	TestEqual("One error per asset", Errors.Num(), 1);
+	TestEqual("Only the edited attack and its upstream revalidate", Cache.GetNumNodesValidated(), 8 + 6);
+	TestTrue("Attack on the loop reports it", Cache.ReachesCycle(Chain[4]));
+	TestFalse("Downstream of the loop is unaffected", Cache.ReachesCycle(Chain[6]));
+
+	// Test 3: Breaking the loop clears it for the whole upstream
+	Chain[5]->HeavyComboAttack = nullptr;
+	Cache.Invalidate(Chain[5]);
+	TestFalse("Loop removed", Cache.ReachesCycle(Chain[0]));
+	TestFalse("Former loop member is clean", Cache.ReachesCycle(Chain[3]));
+
+	Cache.Reset();
+	return true;
+}
+#endif
+
+/**
+ * Test: Soft combo links and preload window gathering
+ * Verifies soft links resolve once loaded and the preload walk respects depth
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FComboPreloadChainTest, "KatanaCombat.CombatComponent.ComboPreloadChain", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FComboPreloadChainTest::RunTest(const FString& Parameters)
+{
+	// Light1 -soft-> Light2 -soft-> Light3, Light1 -soft(unloaded)-> missing asset
+	UAttackData* Light1 = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Light2 = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Light3 = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Heavy1 = FCombatTestHelpers::CreateTestAttack(EAttackType::Heavy);
+
+	const FSoftObjectPath MissingPath(TEXT("/Game/Tests/DA_MissingFollowUp.DA_MissingFollowUp"));
+	Light1->SoftNextComboAttack = Light2;
+	Light1->SoftDirectionalFollowUps.Add(EAttackDirection::Left, TSoftObjectPtr<UAttackData>(MissingPath));
+	Light2->SoftNextComboAttack = Light3;
+
+	// Test 1: Soft links resolve when loaded, hard links still win
+	TestEqual("Loaded soft link should resolve", Light1->GetNextComboAttack(), Light2);
+	bool bHasEntry = false;
+	TestNull("Unloaded soft link should not resolve", Light1->GetDirectionalFollowUp(EInputType::LightAttack, EAttackDirection::Left, &bHasEntry));
+	TestTrue("Unloaded soft link should still count as mapped", bHasEntry);
+	TestTrue("Soft links count as combo branches", Light1->HasComboBranches());
+
+	Light1->NextComboAttack = Light3;
+	TestEqual("Hard link should take precedence over soft link", Light1->GetNextComboAttack(), Light3);
+	Light1->NextComboAttack = nullptr;
+
+	// Test 2: Preload walk stops at the requested depth
+	const UAttackData* Roots[] = { Light1, Heavy1 };
+	TArray<FSoftObjectPath> Paths;
+	bool bHasUnloaded = false;
+
+	UComboPreloadSubsystem::GatherChainPaths(Roots, 1, Paths, bHasUnloaded);
+	TestEqual("Depth 1 should gather Light1's soft links", Paths.Num(), 2);
+	TestTrue("Depth 1 should include the missing asset", Paths.Contains(MissingPath));
+	TestTrue("Missing asset should be reported as unloaded", bHasUnloaded);
+
+	UComboPreloadSubsystem::GatherChainPaths(Roots, 2, Paths, bHasUnloaded);
+	TestEqual("Depth 2 should also gather Light2's soft link", Paths.Num(), 3);
+	TestTrue("Depth 2 should include Light3", Paths.Contains(FSoftObjectPath(Light3)));
+
+	UComboPreloadSubsystem::GatherChainPaths(Roots, 0, Paths, bHasUnloaded);
+	TestEqual("Depth 0 should gather nothing", Paths.Num(), 0);
+
+	// Test 3: Compiled graph picks up loaded soft nodes
+	FCompiledComboGraph Graph;
+	Graph.Build(Light1, Heavy1);
+	TestTrue("Loaded soft node should be compiled", Graph.FindNode(Light3) != INDEX_NONE);
+	TestEqual("Compiled soft link should resolve",
+		Graph.Resolve(Graph.FindNode(Light1), EInputType::LightAttack, EAttackDirection::None, false, true).Attack.Get(), Light2);
+
+	return true;
+}
+
+/**
+ * Test: Moveset asset bundles
+ * Verifies Core holds the first follow-ups of the defaults and Extended the rest of the moveset
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovesetBundleTest, "KatanaCombat.CombatComponent.MovesetBundles", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FMovesetBundleTest::RunTest(const FString& Parameters)
+{
+	// Light1 -soft-> Light2 -soft-> Light3, Sprint -soft-> SprintFollowUp
+	UAttackData* Light1 = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Light2 = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Light3 = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Heavy1 = FCombatTestHelpers::CreateTestAttack(EAttackType::Heavy);
+	UAttackData* Sprint = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* SprintFollowUp = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	Light1->SoftNextComboAttack = Light2;
+	Light2->SoftNextComboAttack = Light3;
+	Sprint->SoftNextComboAttack = SprintFollowUp;
+
+	UAttackConfiguration* Configuration = NewObject<UAttackConfiguration>();
+	Configuration->DefaultLightAttack = Light1;
+	Configuration->DefaultHeavyAttack = Heavy1;
+	Configuration->SprintAttack = Sprint;
+
+	TArray<FSoftObjectPath> Paths;
+	bool bHasUnloaded = false;
+
+	// Test 1: Core is the first follow-up of each default
+	Configuration->GatherBundlePaths(UAttackConfiguration::CoreBundleName, Paths, bHasUnloaded);
+	TestEqual("Core should hold one follow-up", Paths.Num(), 1);
+	TestTrue("Core should include Light2", Paths.Contains(FSoftObjectPath(Light2)));
+	TestFalse("Core walk should be complete", bHasUnloaded);
+
+	// Test 2: Extended is everything else, without repeating Core
+	Configuration->GatherBundlePaths(UAttackConfiguration::ExtendedBundleName, Paths, bHasUnloaded);
+	TestEqual("Extended should hold the rest of the moveset", Paths.Num(), 3);
+	TestTrue("Extended should include the deeper chain", Paths.Contains(FSoftObjectPath(Light3)));
+	TestTrue("Extended should include the sprint attack", Paths.Contains(FSoftObjectPath(Sprint)));
+	TestTrue("Extended should include the sprint follow-up", Paths.Contains(FSoftObjectPath(SprintFollowUp)));
+	TestFalse("Extended should not repeat Core", Paths.Contains(FSoftObjectPath(Light2)));
+
+	// Test 3: Deeper Core covers more of the chain
+	Configuration->CoreBundleDepth = 2;
+	Configuration->GatherBundlePaths(UAttackConfiguration::CoreBundleName, Paths, bHasUnloaded);
+	TestEqual("Depth 2 Core should hold the whole default chain", Paths.Num(), 2);
+
+	Configuration->GatherBundlePaths(NAME_None, Paths, bHasUnloaded);
+	TestEqual("Unknown bundle should be empty", Paths.Num(), 0);
+
+	return true;
+}
+
+/**
+ * Test: Cooked attack timing block
+ * Verifies runtime queries read the cooked block and fall back to a scan when it is stale
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttackTimingCacheTest, "KatanaCombat.CombatComponent.AttackTimingCache", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAttackTimingCacheTest::RunTest(const FString& Parameters)
+{
+	UAttackData* Attack = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+
+	// Test 1: Freshly generated block matches the montage
+	TestFalse("Uncooked attack should not have a valid block", Attack->TimingCache.IsValidFor(Attack->AttackMontage, Attack->MontageSection));
+	Attack->RefreshTimingCache();
+	TestTrue("Refreshed block should match montage/section", Attack->TimingCache.IsValidFor(Attack->AttackMontage, Attack->MontageSection));
+
+	FAttackTimingCache Fresh;
+	Attack->BuildTimingCache(Fresh);
+	TestTrue("Refreshed block should match a fresh scan", Attack->TimingCache.Matches(Fresh));
+	TestFalse("Mock montage has no phase notifies", Attack->HasValidNotifyTimingInSection());
+
+	// Test 2: Queries read the cooked block
+	Attack->TimingCache.SectionEnd = 1.25f;
+	float Start = -1.0f, End = -1.0f;
+	Attack->GetSectionTimeRange(Start, End);
+	TestEqual("Section end should come from the cooked block", End, 1.25f);
+	TestFalse("Edited block should no longer match a fresh scan", Attack->TimingCache.Matches(Fresh));
+
+	// Test 3: Montage swapped at runtime - block is stale, queries scan instead
+	Attack->AttackMontage = NewObject<UAnimMontage>();
+	TestFalse("Block should be stale after montage swap", Attack->TimingCache.IsValidFor(Attack->AttackMontage, Attack->MontageSection));
+	Attack->GetSectionTimeRange(Start, End);
+	TestEqual("Stale block should be ignored", End, Fresh.SectionEnd);
+
+	// Test 4: Deprecated manual timing is folded into the block (cooked builds only keep this copy)
+	Attack->ManualTiming.WindupDuration = 0.35f;
+	Attack->ManualTiming.ActiveDuration = 0.1f;
+	Attack->ManualTiming.RecoveryDuration = 0.6f;
+	Attack->RefreshTimingCache();
+	TestEqual("Folded windup", Attack->TimingCache.PhaseDurations.WindupDuration, 0.35f);
+
+	float Windup = 0.0f, Active = 0.0f, Recovery = 0.0f;
+	Attack->GetEffectiveTiming(Windup, Active, Recovery);
+	TestEqual("Effective timing reads the folded active", Active, 0.1f);
+	TestEqual("Effective timing reads the folded recovery", Recovery, 0.6f);
+
+	return true;
+}
+
+/**
+ * Test: Baked attack reach
+ * Verifies warp/targeting reach reads the cooked root motion offsets
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttackReachTest, "KatanaCombat.CombatComponent.AttackReach", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAttackReachTest::RunTest(const FString& Parameters)
+{
+	UAttackData* Attack = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	Attack->RefreshTimingCache();
+
+	// Test 1: Mock montage has no root motion
+	TestFalse("Mock montage should not bake root motion", Attack->TimingCache.bHasRootMotion);
+	TestEqual("No root motion means no active reach", Attack->GetActiveReach(), 0.0f);
+
+	// Test 2: Reach comes from the cooked Active end offset (forward only)
+	Attack->TimingCache.ActiveEndOffset = FVector(120.0f, 30.0f, 0.0f);
+	TestEqual("Active reach should be the forward offset at Active end", Attack->GetActiveReach(), 120.0f);
+
+	Attack->TimingCache.ActiveEndOffset = FVector(-50.0f, 0.0f, 0.0f);
+	TestEqual("Backward steps should not produce negative reach", Attack->GetActiveReach(), 0.0f);
+
+	// Test 3: Warp allowance only counts when translation is warped
+	Attack->TimingCache.ActiveEndOffset = FVector(120.0f, 0.0f, 0.0f);
+	Attack->MotionWarpingConfig.bUseMotionWarping = true;
+	Attack->MotionWarpingConfig.bWarpTranslation = true;
+	Attack->MotionWarpingConfig.MaxWarpDistance = 300.0f;
+	TestEqual("Max target distance should add the warp allowance", Attack->GetMaxTargetDistance(), 420.0f);
+
+	Attack->MotionWarpingConfig.bWarpTranslation = false;
+	TestEqual("Rotation-only warp should not extend reach", Attack->GetMaxTargetDistance(), 120.0f);
+
+	return true;
+}
+
+/**
+ * Test: Baked swing volume
+ * Verifies the quantized trajectory round-trips, bounds stay conservative and stale bakes are ignored
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttackSwingVolumeTest, "KatanaCombat.CombatComponent.AttackSwingVolume", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAttackSwingVolumeTest::RunTest(const FString& Parameters)
+{
+	UAttackData* Attack = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	TestNull("Unbaked attack should have no swing volume", Attack->GetSwingVolume());
+
+	// Test 1: Quarter arc of a 100cm blade around the hand
+	TArray<FVector> Starts;
+	TArray<FVector> Tips;
+	for (int32 Index = 0; Index <= 8; ++Index)
+	{
+		const float Angle = FMath::DegreesToRadians(90.0f * Index / 8.0f);
+		Starts.Add(FVector(FMath::Cos(Angle) * 20.0f, FMath::Sin(Angle) * 20.0f, 120.0f));
+		Tips.Add(FVector(FMath::Cos(Angle) * 120.0f, FMath::Sin(Angle) * 120.0f, 120.0f));
+	}
+
+	FAttackSwingVolume& Volume = Attack->SwingVolume;
+	Volume.Build(Starts, Tips, 5.0f);
+	TestEqual("Every pose should be stored", Volume.GetNumSamples(), Starts.Num());
+
+	// Test 2: Decoded poses within a quantization step, bounds inflated by the radius
+	const float Tolerance = Volume.Bounds.GetSize().GetMax() / MAX_uint16 + KINDA_SMALL_NUMBER;
+	bool bRoundTrips = true;
+	bool bInsideShrunkBounds = true;
+	for (int32 Index = 0; Index < Volume.GetNumSamples(); ++Index)
+	{
+		FVector Start, Tip;
+		Volume.GetSample(Index, Start, Tip);
+		bRoundTrips &= Start.Equals(Starts[Index], Tolerance) && Tip.Equals(Tips[Index], Tolerance);
+		bInsideShrunkBounds &= Volume.Bounds.ExpandBy(-4.9f).IsInsideOrOn(Tips[Index]);
+	}
+	TestTrue("Quantized poses should round-trip", bRoundTrips);
+	TestTrue("Bounds should keep the blade radius around every pose", bInsideShrunkBounds);
+
+	// Test 3: Only a bake of the current montage/section counts
+	Volume.SourceMontage = Attack->AttackMontage;
+	Volume.SourceSection = Attack->MontageSection;
+	TestNotNull("Matching bake should be used", Attack->GetSwingVolume());
+
+	Attack->AttackMontage = NewObject<UAnimMontage>();
+	TestNull("Bake should be stale after montage swap", Attack->GetSwingVolume());
+
+	Volume.Reset();
+	TestEqual("Reset should drop the samples", Volume.GetNumSamples(), 0);
+
+	// Test 4: Culling is opt-in (registry only knows pawns)
+	TestFalse("Swing volume culling should default off", GetDefault<UWeaponComponent>()->bUseSwingVolumeCulling);
+
+	return true;
+}
+
+/**
+ * Test: Baked blade pose at montage time
+ * Verifies the server blade reconstruction interpolates samples and clamps outside the baked range
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBakedBladePoseTest, "KatanaCombat.CombatComponent.BakedBladePose", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FBakedBladePoseTest::RunTest(const FString& Parameters)
+{
+	// Blade sliding 100cm along X over three samples, 0.1s apart from montage time 0.5
+	FAttackSwingVolume Volume;
+	const TArray<FVector> Starts = { FVector(0.0f, 0.0f, 0.0f), FVector(50.0f, 0.0f, 0.0f), FVector(100.0f, 0.0f, 0.0f) };
+	const TArray<FVector> Tips = { FVector(0.0f, 0.0f, 80.0f), FVector(50.0f, 0.0f, 80.0f), FVector(100.0f, 0.0f, 80.0f) };
+	Volume.Build(Starts, Tips, 5.0f);
+	Volume.StartTime = 0.5f;
+	Volume.SampleInterval = 0.1f;
+	Volume.WindowStartTime = 0.6f;
+
+	const float Tolerance = 0.1f;
+	FVector Start, Tip;
+
+	// Test 1: Between samples
+	Volume.SampleAtTime(0.575f, Start, Tip);
+	TestTrue("Start should interpolate between samples", Start.Equals(FVector(37.5f, 0.0f, 0.0f), Tolerance));
+	TestTrue("Tip should interpolate between samples", Tip.Equals(FVector(37.5f, 0.0f, 80.0f), Tolerance));
+
+	// Test 2: Last segment and clamping
+	Volume.SampleAtTime(0.7f, Start, Tip);
+	TestTrue("Last sample time should land on the last pose", Start.Equals(Starts[2], Tolerance));
+
+	Volume.SampleAtTime(2.0f, Start, Tip);
+	TestTrue("Times after the bake should clamp to the last pose", Tip.Equals(Tips[2], Tolerance));
+
+	Volume.SampleAtTime(0.0f, Start, Tip);
+	TestTrue("Times before the bake should clamp to the first pose", Start.Equals(Starts[0], Tolerance));
+
+	// Test 3: Only dedicated servers switch to baked blades
+	UWeaponComponent* Weapon = NewObject<UWeaponComponent>();
+	Weapon->bServerUseBakedBlade = true;
+	TestFalse("Baked blades need BeginPlay on a dedicated server", Weapon->IsUsingBakedBlade());
+
+	return true;
+}
+
+/**
+ * Test: Hit target routes in the swing registry
+ * Verifies native damageables are called directly and non-damageables are skipped
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponHitTargetRouteTest, "KatanaCombat.CombatComponent.WeaponHitTargetRoute", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWeaponHitTargetRouteTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+
+	UCombatComponent* Combat = nullptr;
+	ASamuraiCharacter* Samurai = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	AActor* Prop = World->SpawnActor<AActor>();
+
+	// Test 1: Native C++ damageable resolves to a direct call
+	const FWeaponHitTarget SamuraiTarget = FWeaponHitTarget::Resolve(Samurai);
+	TestTrue("Samurai should resolve to a native damageable", SamuraiTarget.NativeDamageable == Samurai);
+	TestFalse("Samurai should not need Blueprint dispatch", SamuraiTarget.bBlueprintDamageable);
+	TestTrue("Samurai should be damageable", SamuraiTarget.IsDamageable());
+
+	// Test 2: Plain actor takes no damage
+	const FWeaponHitTarget PropTarget = FWeaponHitTarget::Resolve(Prop);
+	TestFalse("Plain actor should not be damageable", PropTarget.IsDamageable());
+	TestFalse("Null actor should not be damageable", FWeaponHitTarget::Resolve(nullptr).IsDamageable());
+
+	// Test 3: Single-hit attacks exhaust the target on the first hit
+	FWeaponHitTarget SingleHit = SamuraiTarget;
+	SingleHit.RecordHit(1.0f, 1, 0.0f);
+	TestTrue("Single hit should exhaust the target", SingleHit.IsExhausted());
+	TestFalse("Exhausted target should not be rehit", SingleHit.CanRehit(10.0f));
+
+	// Test 4: Multi-hit cadence - three hits, 0.2s apart
+	FWeaponHitTarget Flurry = SamuraiTarget;
+	Flurry.RecordHit(1.0f, 3, 0.2f);
+	TestFalse("Same frame should not rehit", Flurry.CanRehit(1.0f));
+	TestFalse("Rehit inside the interval should be refused", Flurry.CanRehit(1.1f));
+	TestTrue("Rehit after the interval should count", Flurry.CanRehit(1.2f));
+
+	Flurry.RecordHit(1.2f, 3, 0.2f);
+	Flurry.RecordHit(1.4f, 3, 0.2f);
+	TestEqual("Every hit should be counted", static_cast<int32>(Flurry.NumHits), 3);
+	TestTrue("Max hits should exhaust the target", Flurry.IsExhausted());
+	TestFalse("Exhausted flurry target should not be rehit", Flurry.CanRehit(5.0f));
+
+	// Test 5: Zero interval still counts one hit per frame
+	FWeaponHitTarget Spin = SamuraiTarget;
+	Spin.RecordHit(2.0f, 4, 0.0f);
+	TestFalse("Overlapping segments in one frame should count once", Spin.CanRehit(2.0f));
+
+	// Cleanup
+	World->DestroyActor(Samurai);
+	World->DestroyActor(Prop);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Weapon trace tick placement
+ * Verifies weapon sweeps run after animation (post update work, behind the owner mesh)
+ * and socket queries without a pose fall back to the owner location
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponTraceTickPlacementTest, "KatanaCombat.CombatComponent.WeaponTraceTickPlacement", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWeaponTraceTickPlacementTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+
+	UCombatComponent* Combat = nullptr;
+	ASamuraiCharacter* Samurai = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	UWeaponComponent* Weapon = Samurai ? Samurai->FindComponentByClass<UWeaponComponent>() : nullptr;
+	if (!TestNotNull("WeaponComponent should exist", Weapon))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	TestEqual("Sweeps tick after animation", Weapon->PrimaryComponentTick.TickGroup.GetValue(), TG_PostUpdateWork);
+
+	USkeletalMeshComponent* Mesh = Samurai->GetMesh();
+	const bool bWaitsOnMesh = Weapon->PrimaryComponentTick.GetPrerequisites().ContainsByPredicate([Mesh](const FTickPrerequisite& Prerequisite)
+	{
+		return Prerequisite.PrerequisiteTickFunction == &Mesh->PrimaryComponentTick;
+	});
+	TestTrue("Owner mesh tick is a prerequisite", bWaitsOnMesh);
+
+	// No skeletal mesh asset - the pose path misses and falls back like GetSocketLocation always did
+	TestEqual("Missing socket falls back to owner location", Weapon->GetSocketLocation(Weapon->WeaponEndSocket), Samurai->GetActorLocation());
+
+	// Cleanup
+	World->DestroyActor(Samurai);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Hurtbox collision layer
+ * Verifies hurtboxes sit alone on the hurtbox object channel (query only, no responses)
+ * and hits on them resolve their damage zone
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHurtboxLayerTest, "KatanaCombat.CombatComponent.HurtboxLayer", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FHurtboxLayerTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+
+	UCombatComponent* Combat = nullptr;
+	ASamuraiCharacter* Samurai = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	if (!TestNotNull("Character should be created", Samurai))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	UHurtboxComponent* Head = NewObject<UHurtboxComponent>(Samurai);
+	Head->Zone = EHurtboxZone::Head;
+	Head->DamageMultiplier = 2.0f;
+	Head->SetupAttachment(Samurai->GetMesh());
+	Head->RegisterComponent();
+
+	TestEqual("Hurtbox uses the hurtbox channel", Head->GetCollisionObjectType(), UHurtboxComponent::HurtboxChannel);
+	TestEqual("Hurtbox is query only", Head->GetCollisionEnabled(), ECollisionEnabled::QueryOnly);
+	TestEqual("Hurtbox ignores pawn queries", Head->GetCollisionResponseToChannel(ECC_Pawn), ECR_Ignore);
+	TestEqual("Hurtbox ignores visibility queries", Head->GetCollisionResponseToChannel(ECC_Visibility), ECR_Ignore);
+	TestFalse("Hurtbox generates no overlap events", Head->GetGenerateOverlapEvents());
+
+	FHitResult Hit;
+	TestNull("Non-hurtbox hit has no zone", UHurtboxComponent::FromHit(Hit));
+	Hit.Component = Head;
+	const UHurtboxComponent* HitHurtbox = UHurtboxComponent::FromHit(Hit);
+	TestTrue("Hurtbox hit resolves its zone", HitHurtbox && HitHurtbox->Zone == EHurtboxZone::Head);
+
+	UWeaponComponent* Weapon = Samurai->FindComponentByClass<UWeaponComponent>();
+	TestTrue("Weapons sweep the trace channel by default", Weapon && !Weapon->bUseHurtboxes);
+
+	// Cleanup
+	World->DestroyActor(Samurai);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Blade narrowphase
+ * Verifies the vectorized segment-capsule kernel agrees with scalar closest-point distances,
+ * including sphere capsules, parallel blades and a partial last batch
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBladeNarrowphaseTest, "KatanaCombat.CombatComponent.BladeNarrowphase", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FBladeNarrowphaseTest::RunTest(const FString& Parameters)
+{
+	FBladeNarrowphase Narrowphase;
+
+	// Handcrafted cases: upright capsule hit, miss, sphere, parallel to the blade
+	const FVector P(0.0f, -50.0f, 100.0f);
+	const FVector Q(0.0f, 50.0f, 100.0f);
+	Narrowphase.AddCapsule(FVector(10.0f, 0.0f, 50.0f), FVector(10.0f, 0.0f, 150.0f), 15.0f);
+	Narrowphase.AddCapsule(FVector(100.0f, 0.0f, 50.0f), FVector(100.0f, 0.0f, 150.0f), 15.0f);
+	Narrowphase.AddCapsule(FVector(0.0f, 60.0f, 100.0f), FVector(0.0f, 60.0f, 100.0f), 5.0f);
+	Narrowphase.AddCapsule(FVector(0.0f, -200.0f, 120.0f), FVector(0.0f, 200.0f, 120.0f), 10.0f);
+	Narrowphase.AddCapsule(FVector(0.0f, -200.0f, 140.0f), FVector(0.0f, 200.0f, 140.0f), 10.0f);
+
+	TBitArray<> Hits;
+	const int32 NumHits = Narrowphase.TestSegment(P, Q, 5.0f, Hits);
+	TestEqual("Hit bits sized to the capsule count", Hits.Num(), 5);
+	TestTrue("Capsule within reach is hit", Hits[0]);
+	TestFalse("Distant capsule is missed", Hits[1]);
+	TestTrue("Sphere past the tip is hit", Hits[2]);
+	TestTrue("Parallel capsule within reach is hit", Hits[3]);
+	TestFalse("Parallel capsule out of reach is missed", Hits[4]);
+	TestEqual("New hits counted", NumHits, 3);
+	TestEqual("Already-set bits aren't counted again", Narrowphase.TestSegment(P, Q, 5.0f, Hits), 0);
+
+	// Random capsules against the scalar reference (skip near-boundary cases)
+	FRandomStream Stream(1234);
+	Narrowphase.Reset();
+	TArray<FVector> As;
+	TArray<FVector> Bs;
+	TArray<float> Radii;
+	for (int32 i = 0; i < 203; ++i)
+	{
+		const FVector A = Stream.VRand() * Stream.FRandRange(0.0f, 200.0f);
+		const FVector B = Stream.FRand() < 0.1f ? A : A + Stream.VRand() * Stream.FRandRange(0.0f, 100.0f);
+		const float Radius = Stream.FRandRange(5.0f, 40.0f);
+		Narrowphase.AddCapsule(A, B, Radius);
+		As.Add(A);
+		Bs.Add(B);
+		Radii.Add(Radius);
+	}
+
+	for (int32 Trial = 0; Trial < 20; ++Trial)
+	{
+		const FVector SegmentStart = Stream.VRand() * 150.0f;
+		const FVector SegmentEnd = SegmentStart + Stream.VRand() * 120.0f;
+		TBitArray<> RandomHits;
+		Narrowphase.TestSegment(SegmentStart, SegmentEnd, 5.0f, RandomHits);
+
+		for (int32 i = 0; i < As.Num(); ++i)
+		{
+			const float Dist = FMath::Sqrt(FBladeNarrowphase::SegmentDistSquared(SegmentStart, SegmentEnd, As[i], Bs[i]));
+			const float Reach = Radii[i] + 5.0f;
+			if (FMath::Abs(Dist - Reach) > 0.01f && (Dist <= Reach) != RandomHits[i])
+			{
+				AddError(FString::Printf(TEXT("Trial %d capsule %d: kernel disagrees with reference (dist %.3f, reach %.3f)"), Trial, i, Dist, Reach));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Test: Async blade trace
+ * Verifies fixed steps sample the baked trajectory from the published montage clock, report each capsule
+ * once through the next publish, sweep the published pose when there is no bake, and stop after End
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncBladeTraceTest, "KatanaCombat.CombatComponent.AsyncBladeTrace", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAsyncBladeTraceTest::RunTest(const FString& Parameters)
+{
+	// Bake: a 100cm blade swinging from -Y through +X to +Y over half a second
+	TArray<FVector> Starts;
+	TArray<FVector> Tips;
+	for (int32 Sample = 0; Sample <= 10; ++Sample)
+	{
+		const float Angle = FMath::DegreesToRadians(-90.0f + 18.0f * Sample);
+		Starts.Add(FVector::ZeroVector);
+		Tips.Add(FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * 100.0f);
+	}
+
+	FAttackSwingVolume SwingVolume;
+	SwingVolume.Build(Starts, Tips, 5.0f);
+	SwingVolume.SampleInterval = 0.05f;
+	SwingVolume.StartTime = 0.0f;
+
+	// Target in front of the owner (reached a quarter second in), and one out of reach
+	auto MakeSnapshot = [](float MontageTime)
+	{
+		FAsyncBladeTrace::FSnapshot Snapshot;
+		Snapshot.MeshTransform = FTransform(FVector(1000.0f, 0.0f, 0.0f));
+		Snapshot.MontageTime = MontageTime;
+		Snapshot.Capsules.Add({ FVector(1060.0f, 0.0f, -50.0f), FVector(1060.0f, 0.0f, 50.0f), 10.0f });
+		Snapshot.Capsules.Add({ FVector(1000.0f, 500.0f, -50.0f), FVector(1000.0f, 500.0f, 50.0f), 10.0f });
+		return Snapshot;
+	};
+
+	constexpr float StepTime = 1.0f / 120.0f;
+	auto StepFor = [](FAsyncBladeTrace& Trace, int32 NumSteps)
+	{
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			Trace.Step(StepTime);
+		}
+	};
+
+	FAsyncBladeTrace Trace;
+	TArray<FAsyncBladeTrace::FHit> Hits;
+	Trace.Step(StepTime);
+	TestEqual("Inactive trace doesn't step", Trace.GetNumSteps(), 0);
+
+	Trace.Begin(&SwingVolume, 5.0f, 10.0f, 8);
+	TestTrue("Swing uses its bake", Trace.IsUsingBake());
+	Trace.Step(StepTime);
+	TestEqual("No steps before the first snapshot", Trace.GetNumSteps(), 0);
+
+	// First 0.2s: the blade hasn't reached the target
+	Trace.Publish(MakeSnapshot(0.0f), Hits);
+	StepFor(Trace, 24);
+	Trace.Publish(MakeSnapshot(0.2f), Hits);
+	TestEqual("Steps counted", Trace.GetNumSteps(), 24);
+	TestEqual("Nothing hit before the blade arrives", Hits.Num(), 0);
+
+	// Next 0.2s, published once: the blade sweeps through the target with no frame in between
+	StepFor(Trace, 24);
+	Trace.Publish(MakeSnapshot(0.4f), Hits);
+	if (TestEqual("Target hit once while the blade passes", Hits.Num(), 1))
+	{
+		TestEqual("Hit reports the target capsule", Hits[0].CapsuleIndex, 0);
+		TestTrue("Impact on the target's surface", FMath::IsNearlyEqual(FVector::Dist2D(Hits[0].OnCapsule, FVector(1060.0f, 0.0f, 0.0f)), 10.0f, 0.5f));
+		TestTrue("Swept pose placed by the mesh transform", Hits[0].Start.Equals(FVector(1000.0f, 0.0f, 0.0f), 1.0f));
+	}
+
+	StepFor(Trace, 12);
+	Trace.Publish(MakeSnapshot(0.5f), Hits);
+	TestEqual("Blade past the target hits nothing new", Hits.Num(), 0);
+
+	// Without a bake the published pose is swept: held clear of the target, then moved through it
+	Trace.Begin(nullptr, 5.0f, 10.0f, 8);
+	TestFalse("Pose-only swing", Trace.IsUsingBake());
+
+	FAsyncBladeTrace::FSnapshot Clear = MakeSnapshot(0.0f);
+	Clear.Start = FVector(1000.0f, 0.0f, 0.0f);
+	Clear.Tip = FVector(1000.0f, -100.0f, 0.0f);
+	Trace.Publish(MoveTemp(Clear), Hits);
+	StepFor(Trace, 4);
+
+	FAsyncBladeTrace::FSnapshot Through = MakeSnapshot(0.0f);
+	Through.Start = FVector(1000.0f, 0.0f, 0.0f);
+	Through.Tip = FVector(1100.0f, 0.0f, 0.0f);
+	Trace.Publish(MoveTemp(Through), Hits);
+	TestEqual("Held pose hits nothing", Hits.Num(), 0);
+	StepFor(Trace, 2);
+	Trace.Publish(MakeSnapshot(0.0f), Hits);
+	TestTrue("Moved pose hits the target", Hits.Num() == 1 && Hits[0].CapsuleIndex == 0);
+
+	// Stopped: no more steps
+	const int32 NumStepsAtEnd = Trace.GetNumSteps();
+	Trace.End();
+	StepFor(Trace, 4);
+	TestEqual("Ended trace doesn't step", Trace.GetNumSteps(), NumStepsAtEnd);
+	TestFalse("Ended trace inactive", Trace.IsActive());
+
+	return true;
+}
+
+/**
+ * Test: Context-sensitive attack resolution (PRIORITY 1)
+ * Verifies compiled context masks pick variants like the tag containers would
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FContextAttackResolutionTest, "KatanaCombat.CombatComponent.ContextAttackResolution", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FContextAttackResolutionTest::RunTest(const FString& Parameters)
+{
+	UAttackData* Light1 = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Heavy1 = FCombatTestHelpers::CreateTestAttack(EAttackType::Heavy);
+	UAttackData* Counter = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	UAttackData* Finisher = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+
+	Counter->RequiredContextTags.AddTag(CombatContextTags::ParryCounter);
+	Counter->BlockedContextTags.AddTag(CombatContextTags::LowHealthFinisher);
+	Finisher->RequiredContextTags.AddTag(CombatContextTags::LowHealthFinisher);
+	Light1->ContextVariants = { Counter, Finisher };
+
+	const FCombatContextTagTable& Table = FCombatContextTagTable::Get();
+	TestTrue("Native context tags should have bits", Table.GetBitIndex(CombatContextTags::ParryCounter) != INDEX_NONE);
+
+	auto Resolve = [&](const FGameplayTagContainer& Context, EInputType InputType)
+	{
+		return UMontageUtilityLibrary::ResolveContextAttack(nullptr, InputType, Light1, Heavy1, Table.MakeActiveMask(Context), Context);
+	};
+
+	// Test 1: No context - no variant
+	FGameplayTagContainer Context;
+	TestNull("No context should not resolve a variant", Resolve(Context, EInputType::LightAttack).Attack.Get());
+
+	// Test 2: Parry counter
+	Context.AddTag(CombatContextTags::ParryCounter);
+	FAttackResolutionResult Result = Resolve(Context, EInputType::LightAttack);
+	TestEqual("Parry context should resolve the counter", Result.Attack.Get(), Counter);
+	TestEqual("Counter should report the parry counter path", Result.Path, EResolutionPath::ParryCounter);
+	TestNull("Heavy input should not pick a light variant", Resolve(Context, EInputType::HeavyAttack).Attack.Get());
+
+	// Test 3: Blocked tag wins over required tag
+	Context.AddTag(CombatContextTags::LowHealthFinisher);
+	Result = Resolve(Context, EInputType::LightAttack);
+	TestEqual("Blocked counter should fall through to the finisher", Result.Attack.Get(), Finisher);
+	TestEqual("Finisher should report the finisher path", Result.Path, EResolutionPath::LowHealthFinisher);
+
+	// Test 4: Masks agree with container matching, and V2 resolution runs priority 1 first
+	TestEqual("Mask match should agree with containers",
+		Counter->MatchesContext(Table.MakeActiveMask(Context), Context),
+		Context.HasAll(Counter->RequiredContextTags) && !Context.HasAny(Counter->BlockedContextTags));
+
+	TSet<UAttackData*> Visited;
+	Result = UMontageUtilityLibrary::ResolveNextAttack_V2(nullptr, EInputType::LightAttack, EAttackDirection::None, false, false, Light1, Heavy1, Context, Visited);
+	TestEqual("ResolveNextAttack_V2 should resolve the context variant", Result.Attack.Get(), Finisher);
+
+	return true;
+}
+
+/**
+ * Test: Shared combat archetype
+ * Verifies characters referencing one archetype read its reactions, finishers and targeting filter
+ * from a single baked table while their own components stay empty
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatArchetypeTest, "KatanaCombat.CombatComponent.CombatArchetype", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatArchetypeTest::RunTest(const FString& Parameters)
+{
+	UCombatArchetype* Archetype = NewObject<UCombatArchetype>();
+	UAnimMontage* LightFront = NewObject<UAnimMontage>();
+	UAnimMontage* StunnedBack = NewObject<UAnimMontage>();
+	UAnimMontage* GuardBroken = NewObject<UAnimMontage>();
+	UAnimMontage* FinisherVictim = NewObject<UAnimMontage>();
+	Archetype->LightHitReactions.FrontHit = LightFront;
+	Archetype->StunnedHitReactions.BackHit = StunnedBack;
+	Archetype->GuardBrokenMontage = GuardBroken;
+	Archetype->HeavyHitStunThreshold = 0.5f;
+	Archetype->FinisherVictimAnimations.Add(TEXT("Decapitate"), FinisherVictim);
+	Archetype->TargetableClasses.Add(ASamuraiCharacter::StaticClass());
+
+	// Baked table
+	const FHitReactionTable& Table = Archetype->GetReactionTable();
+	TestTrue("Table bakes on first use", Table.IsBuilt());
+	TestEqual("Light front reaction", Table.GetReaction(false, false, EAttackDirection::Forward), LightFront);
+	TestEqual("Stunned slot falls back to standing", Table.GetReaction(true, false, EAttackDirection::Forward), LightFront);
+	TestEqual("Stunned set used when present", Table.GetReaction(true, true, EAttackDirection::Backward), StunnedBack);
+	TestEqual("Finisher interned", Table.FindFinisherId(TEXT("Decapitate")), 0);
+	TestEqual("Finisher montage kept as a soft reference", Table.FinisherMontages[0].Get(), FinisherVictim);
+
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	ASamuraiCharacter* First = World ? World->SpawnActor<ASamuraiCharacter>() : nullptr;
+	ASamuraiCharacter* Second = World ? World->SpawnActor<ASamuraiCharacter>() : nullptr;
+	if (!TestNotNull("First character should spawn", First) || !TestNotNull("Second character should spawn", Second))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	for (ASamuraiCharacter* Character : { First, Second })
+	{
+		Character->HitReactionComponent->SetArchetype(Archetype);
+		Character->TargetingComponent->SetArchetype(Archetype);
+	}
+
+	// Components read through the archetype and hold no config of their own
+	TestEqual("Finisher resolved through archetype", First->HitReactionComponent->FindFinisherId(TEXT("Decapitate")), Second->HitReactionComponent->FindFinisherId(TEXT("Decapitate")));
+	TestEqual("Guard broken montage from archetype", First->HitReactionComponent->GetGuardBrokenMontage(), GuardBroken);
+	TestEqual("Threshold from archetype", Second->HitReactionComponent->GetHeavyHitStunThreshold(), 0.5f);
+	TestEqual("Component keeps no finisher copies", First->HitReactionComponent->FinisherVictimAnimations.Num(), 0);
+	TestEqual("Targeting filter from archetype", First->TargetingComponent->GetTargetableClasses().Num(), 1);
+
+	// Dropping the archetype falls back to per-instance config
+	First->HitReactionComponent->SetArchetype(nullptr);
+	TestEqual("Per-instance finishers after clearing the archetype", First->HitReactionComponent->FindFinisherId(TEXT("Decapitate")), static_cast<int32>(INDEX_NONE));
+	TestNull("Per-instance guard broken montage", First->HitReactionComponent->GetGuardBrokenMontage());
+
+	// Cleanup
+	World->DestroyActor(First);
+	World->DestroyActor(Second);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Hit Detection Notify Direct Path
+ * Verifies the toggle notify reaches the weapon through the notify sink without the combat interface
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitDetectionNotifyTest, "KatanaCombat.Weapon.HitDetectionNotify", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FHitDetectionNotifyTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* CombatComp = nullptr;
+	ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+
+	if (!TestNotNull("Character should be created", Character) || !TestNotNull("Weapon should exist", Character->WeaponComponent.Get()))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	FCombatNotifySink Sink;
+	Sink.Resolve(Character);
+	TestEqual("Sink resolves the weapon once", Sink.WeaponComponent.Get(), Character->WeaponComponent.Get());
+
+	UAnimNotify_ToggleHitDetection* Notify = NewObject<UAnimNotify_ToggleHitDetection>();
+	const FAnimNotifyEventReference EventReference;
+
+	Notify->bEnable = true;
+	Notify->Notify(Character->GetMesh(), nullptr, EventReference);
+	TestTrue("Enable notify opens the window", Character->WeaponComponent->IsHitDetectionEnabled());
+
+	Notify->bEnable = false;
+	Notify->Notify(Character->GetMesh(), nullptr, EventReference);
+	TestFalse("Disable notify closes the window", Character->WeaponComponent->IsHitDetectionEnabled());
+
+	World->DestroyActor(Character);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Fused Target Query
+ * Verifies the single-pass cone/range query picks the nearest candidate in the cone and serves range queries nearest first
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetQueryTest, "KatanaCombat.Targeting.FusedQuery", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FTargetQueryTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	ASamuraiCharacter* Owner = World ? World->SpawnActor<ASamuraiCharacter>(FVector::ZeroVector, FRotator::ZeroRotator) : nullptr;
+	if (!TestNotNull("Owner should spawn", Owner))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	ASamuraiCharacter* NearFront = World->SpawnActor<ASamuraiCharacter>(FVector(300.0f, 0.0f, 0.0f), FRotator::ZeroRotator);
+	ASamuraiCharacter* FarFront = World->SpawnActor<ASamuraiCharacter>(FVector(600.0f, 50.0f, 0.0f), FRotator::ZeroRotator);
+	ASamuraiCharacter* Behind = World->SpawnActor<ASamuraiCharacter>(FVector(-200.0f, 0.0f, 0.0f), FRotator::ZeroRotator);
+	ASamuraiCharacter* OutOfRange = World->SpawnActor<ASamuraiCharacter>(FVector(5000.0f, 0.0f, 0.0f), FRotator::ZeroRotator);
+
+	UTargetingComponent* Targeting = Owner->TargetingComponent;
+	Targeting->bRequireLineOfSight = false;
+	Targeting->bSkipCulledCandidates = false;
+	Targeting->TargetableClasses = { ASamuraiCharacter::StaticClass() };
+	Targeting->InvalidateTargetScores();
+
+	TestEqual("Nearest candidate in the forward cone", Targeting->FindTarget(EAttackDirection::Forward), static_cast<AActor*>(NearFront));
+	TestEqual("Cone follows the search direction", Targeting->FindTargetInDirection(FVector::BackwardVector), static_cast<AActor*>(Behind));
+
+	TArray<AActor*> InRange;
+	Targeting->GetAllTargetsInRange(InRange);
+	TestEqual("Range query drops the far candidate", InRange.Num(), 3);
+	if (InRange.Num() == 3)
+	{
+		TestEqual("Nearest first", InRange[0], static_cast<AActor*>(Behind));
+		TestEqual("Then the near front", InRange[1], static_cast<AActor*>(NearFront));
+		TestEqual("Then the far front", InRange[2], static_cast<AActor*>(FarFront));
+	}
+
+	for (ASamuraiCharacter* Character : { Owner, NearFront, FarFront, Behind, OutOfRange })
+	{
+		if (Character)
+		{
+			World->DestroyActor(Character);
+		}
+	}
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Pooled projectiles
+ * Verifies projectiles integrate in the pool, report hits through the launching weapon with their attack,
+ * pierce each actor once, stop on the world and hand their slot to the next launch
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatProjectileTest, "KatanaCombat.CombatComponent.Projectiles", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatProjectileTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+
+	UCombatComponent* Combat = nullptr;
+	ASamuraiCharacter* Thrower = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	ASamuraiCharacter* Target = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	UWeaponComponent* Weapon = Thrower ? Thrower->FindComponentByClass<UWeaponComponent>() : nullptr;
+	UCombatProjectileSubsystem* Projectiles = World->GetSubsystem<UCombatProjectileSubsystem>();
+	if (!TestNotNull("WeaponComponent should exist", Weapon) || !TestNotNull("Projectile subsystem should exist", Projectiles) || !TestNotNull("Target should be created", Target))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	int32 NumHits = 0;
+	UAttackData* ReportedAttack = nullptr;
+	const FDelegateHandle HitHandle = Weapon->OnWeaponHitNative.AddLambda([&NumHits, &ReportedAttack](AActor*, const FHitResult&, UAttackData* AttackData)
+	{
+		++NumHits;
+		ReportedAttack = AttackData;
+	});
+
+	FCombatProjectileParams Params;
+	Params.Attack = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	Params.Location = FVector(0.0f, 0.0f, 100.0f);
+	Params.Velocity = FVector(1000.0f, 0.0f, 0.0f);
+	Params.GravityScale = 0.0f;
+	Params.MaxHits = 2;
+
+	TestFalse("Launch needs a weapon", Projectiles->Launch(nullptr, Params).IsValid());
+	const FCombatProjectileHandle Kunai = Projectiles->Launch(Weapon, Params);
+	TestTrue("Projectile launched", Projectiles->IsActive(Kunai));
+
+	FCombatProjectileParams Arc = Params;
+	Arc.GravityScale = 1.0f;
+	const FCombatProjectileHandle Arrow = Projectiles->Launch(Weapon, Arc);
+
+	// Integration
+	Projectiles->Integrate(0.1f);
+	FVector Location, Velocity;
+	TestTrue("Projectile state readable", Projectiles->GetProjectileState(Kunai, Location, Velocity));
+	TestTrue("Projectile moved along its velocity", Location.Equals(FVector(100.0f, 0.0f, 100.0f), 0.01f));
+	TestTrue("Arcing projectile falls", Projectiles->GetProjectileState(Arrow, Location, Velocity) && FMath::IsNearlyEqual(Velocity.Z, World->GetGravityZ() * 0.1f, 0.01f));
+
+	// Hits go out through the weapon with the projectile's attack, once per actor
+	const FHitResult TargetHit(Target, Target->GetCapsuleComponent(), Target->GetActorLocation(), FVector::BackwardVector);
+	const FHitResult OwnerHit(Thrower, Thrower->GetCapsuleComponent(), Thrower->GetActorLocation(), FVector::BackwardVector);
+	Projectiles->HandleTraceHits(Kunai, { OwnerHit, TargetHit, TargetHit });
+	TestEqual("Owner skipped, target hit once", NumHits, 1);
+	TestEqual("Hit reports the projectile's attack", ReportedAttack, Params.Attack.Get());
+	TestTrue("Piercing projectile still flying", Projectiles->IsActive(Kunai));
+	TestEqual("Projectile hits stay out of the swing hit list", Weapon->GetHitActorCount(), 0);
+
+	// World geometry stops it
+	AActor* Wall = World->SpawnActor<AActor>();
+	UBoxComponent* WallBox = NewObject<UBoxComponent>(Wall);
+	WallBox->SetCollisionObjectType(ECC_WorldStatic);
+	Wall->SetRootComponent(WallBox);
+	WallBox->RegisterComponent();
+	Projectiles->HandleTraceHits(Kunai, { FHitResult(Wall, WallBox, FVector(200.0f, 0.0f, 100.0f), FVector::BackwardVector) });
+	TestFalse("World hit stops the projectile", Projectiles->IsActive(Kunai));
+	TestEqual("World hit reports nothing", NumHits, 1);
+
+	// Late sweeps of a stopped projectile are dropped, and its slot goes to the next launch
+	Projectiles->HandleTraceHits(Kunai, { TargetHit });
+	TestEqual("Stale handle reports nothing", NumHits, 1);
+	const int32 PoolSize = Projectiles->GetPoolSize();
+	const FCombatProjectileHandle Reused = Projectiles->Launch(Weapon, Params);
+	TestEqual("Launch reuses the freed slot", Projectiles->GetPoolSize(), PoolSize);
+	TestFalse("Reused slot doesn't revive the old handle", Projectiles->IsActive(Kunai));
+	TestTrue("New projectile in flight", Projectiles->IsActive(Reused));
+
+	// Lifetime
+	Projectiles->Integrate(Params.Lifetime + 0.1f);
+	TestEqual("Expired projectiles return to the pool", Projectiles->GetNumProjectiles(), 0);
+
+	// Cleanup
+	Weapon->OnWeaponHitNative.Remove(HitHandle);
+	World->DestroyActor(Wall);
+	World->DestroyActor(Target);
+	World->DestroyActor(Thrower);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
 	return true;
 }
\ No newline at end of file
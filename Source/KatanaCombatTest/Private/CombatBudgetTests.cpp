@@ -0,0 +1,428 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatBudgetSubsystem.h"
+#include "Core/CombatAnimBudgetSubsystem.h"
+#include "Debug/CombatAttackProfiler.h"
+#include "Debug/CombatFieldTelemetry.h"
+#include "Debug/CombatHitchDetector.h"
+
+/**
+ * Test: Combat budget hysteresis
+ * Verifies a tracker only steps down after staying over budget, holds between the thresholds,
+ * steps back up one level at a time with headroom, and that the subsystem maps levels to detail scales
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatBudgetHysteresisTest, "KatanaCombat.Budget.Hysteresis", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatBudgetHysteresisTest::RunTest(const FString& Parameters)
+{
+	// Tracker without smoothing: every frame is taken at face value
+	FCombatBudgetTracker Tracker;
+	Tracker.SmoothingAlpha = 1.0f;
+	Tracker.DegradeDelay = 0.25f;
+	Tracker.RestoreDelay = 1.0f;
+	Tracker.RestoreRatio = 0.5f;
+
+	TestFalse("One frame over budget is not enough", Tracker.Update(2.0f, 1.0f, 0.1f));
+	Tracker.Update(2.0f, 1.0f, 0.1f);
+	TestTrue("Sustained overrun steps down", Tracker.Update(2.0f, 1.0f, 0.1f));
+	TestEqual("Reduced", Tracker.Level, ECombatQualityLevel::Reduced);
+
+	// Between RestoreRatio and the budget: hold
+	for (int32 Frame = 0; Frame < 50; ++Frame)
+	{
+		Tracker.Update(0.75f, 1.0f, 0.1f);
+	}
+	TestEqual("Holds inside the hysteresis band", Tracker.Level, ECombatQualityLevel::Reduced);
+
+	// Headroom restores after RestoreDelay
+	for (int32 Frame = 0; Frame < 9; ++Frame)
+	{
+		Tracker.Update(0.25f, 1.0f, 0.1f);
+	}
+	TestEqual("Not restored before the delay", Tracker.Level, ECombatQualityLevel::Reduced);
+	Tracker.Update(0.25f, 1.0f, 0.1f);
+	Tracker.Update(0.25f, 1.0f, 0.1f);
+	TestEqual("Restored with headroom", Tracker.Level, ECombatQualityLevel::Full);
+
+	// Unlimited budget never degrades
+	TestFalse("Zero budget ignores cost", Tracker.Update(100.0f, 0.0f, 10.0f));
+	TestEqual("Still full", Tracker.Level, ECombatQualityLevel::Full);
+
+	// Subsystem
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatBudgetSubsystem* Budget = UCombatBudgetSubsystem::Get(World);
+
+	if (!TestNotNull("Budget subsystem exists", Budget))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	Budget->BudgetMs[static_cast<int32>(ECombatBudgetCategory::Traces)] = 1.0f;
+	Budget->BudgetMs[static_cast<int32>(ECombatBudgetCategory::Targeting)] = 1.0f;
+	Budget->TotalBudgetMs = 0.0f;
+
+	// Traces blow their budget, targeting stays cheap
+	float Frame[static_cast<int32>(ECombatBudgetCategory::Count)] = {};
+	Frame[static_cast<int32>(ECombatBudgetCategory::Traces)] = 10.0f;
+	Frame[static_cast<int32>(ECombatBudgetCategory::Targeting)] = 0.1f;
+	for (int32 Index = 0; Index < 30; ++Index)
+	{
+		Budget->EvaluateFrame(Frame, 0.1f);
+	}
+
+	TestEqual("Traces at minimal quality", Budget->GetQualityLevel(ECombatBudgetCategory::Traces), ECombatQualityLevel::Minimal);
+	TestEqual("Trace detail scale", UCombatBudgetSubsystem::GetDetailScaleFor(World, ECombatBudgetCategory::Traces), Budget->MinimalDetailScale);
+	TestEqual("Targeting untouched", Budget->GetDetailScale(ECombatBudgetCategory::Targeting), 1.0f);
+	TestEqual("Unlimited total keeps AI LOD", Budget->GetTotalDetailScale(), 1.0f);
+
+	// Headroom returns: back to full one level at a time
+	Frame[static_cast<int32>(ECombatBudgetCategory::Traces)] = 0.0f;
+	for (int32 Index = 0; Index < 100; ++Index)
+	{
+		Budget->EvaluateFrame(Frame, 0.1f);
+	}
+	TestEqual("Traces restored", Budget->GetQualityLevel(ECombatBudgetCategory::Traces), ECombatQualityLevel::Full);
+	TestEqual("Two steps down, two back up", Budget->GetNumLevelChanges(), 4);
+
+	// Disabling resets every level
+	Frame[static_cast<int32>(ECombatBudgetCategory::Traces)] = 10.0f;
+	for (int32 Index = 0; Index < 10; ++Index)
+	{
+		Budget->EvaluateFrame(Frame, 0.1f);
+	}
+	Budget->SetEnabled(false);
+	TestEqual("Disabled monitor restores full quality", Budget->GetQualityLevel(ECombatBudgetCategory::Traces), ECombatQualityLevel::Full);
+
+	// Budget scopes accumulate
+	const uint64 CyclesBefore = CombatBudget::GetTotalCycles(ECombatBudgetCategory::Queue);
+	{
+		COMBAT_BUDGET_SCOPE(Queue);
+		FPlatformProcess::Sleep(0.001f);
+	}
+	TestTrue("Scope charged its category", CombatBudget::GetTotalCycles(ECombatBudgetCategory::Queue) > CyclesBefore);
+
+	// Cleanup
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
+
+/**
+ * Test: Animation budget combat exemptions
+ * Verifies characters register their budgeted mesh on BeginPlay, owner-flagged meshes are critical
+ * immediately, and clearing the flag lets the next pass return an idle character to its rank
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatAnimBudgetTest, "KatanaCombat.Budget.AnimBudget", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatAnimBudgetTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* Combat = nullptr;
+	ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	UCombatAnimBudgetSubsystem* AnimBudget = World->GetSubsystem<UCombatAnimBudgetSubsystem>();
+	if (!TestNotNull("Anim budget subsystem", AnimBudget) || !TestNotNull("Character", Character))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	TestEqual("Character mesh registered on BeginPlay", AnimBudget->GetNumMeshes(), 1);
+	TestTrue("Unranked mesh starts unthrottled", AnimBudget->IsCombatCritical(Character));
+
+	// Idle, not targeted, no hit detection: throttling allowed
+	AnimBudget->UpdateMeshSignificance();
+	TestFalse("Idle character may be throttled", AnimBudget->IsCombatCritical(Character));
+
+	// Owner flag applies without waiting for a pass
+	AnimBudget->SetCombatCritical(Character, true);
+	TestTrue("Flagged character is critical", AnimBudget->IsCombatCritical(Character));
+	AnimBudget->UpdateMeshSignificance();
+	TestTrue("Flag survives passes", AnimBudget->IsCombatCritical(Character));
+
+	AnimBudget->SetCombatCritical(Character, false);
+	AnimBudget->UpdateMeshSignificance();
+	TestFalse("Cleared flag returns to rank", AnimBudget->IsCombatCritical(Character));
+
+	// Meshes whose owner is gone drop out on the next pass
+	Character->Destroy();
+	AnimBudget->UpdateMeshSignificance();
+	TestEqual("Destroyed character pruned", AnimBudget->GetNumMeshes(), 0);
+
+	// Cleanup
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
+
+/**
+ * Test: Per-attack cost attribution
+ * Verifies scopes charge their exclusive time to the attack they were given (or resolved later),
+ * nested scopes aren't counted twice, scopes without an attack or opened while stopped charge nothing,
+ * and the table sorts by total cost
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatAttackProfilerTest, "KatanaCombat.Budget.AttackProfiler", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatAttackProfilerTest::RunTest(const FString& Parameters)
+{
+	FCombatAttackProfiler& Profiler = FCombatAttackProfiler::Get();
+	const bool bWasEnabled = Profiler.IsEnabled();
+	Profiler.Reset();
+
+	UAttackData* CheapAttack = FCombatTestHelpers::CreateTestAttack();
+	UAttackData* ExpensiveAttack = FCombatTestHelpers::CreateTestAttack(EAttackType::Heavy);
+
+	// Busy work long enough to measure
+	auto Spin = [](double Seconds)
+	{
+		const double EndTime = FPlatformTime::Seconds() + Seconds;
+		while (FPlatformTime::Seconds() < EndTime)
+		{
+		}
+	};
+
+	// Stopped: scopes are free and charge nothing
+	{
+		FCombatAttackProfileScope Scope(ECombatAttackCost::Trace, CheapAttack);
+		TestFalse("Scope inactive while stopped", Scope.IsActive());
+	}
+	Profiler.AddSwing(CheapAttack);
+	TestEqual("Nothing charged while stopped", Profiler.GetNumAttacks(), 0);
+
+	Profiler.SetEnabled(true);
+
+	// Trace resolved mid-scope, with a hit nested inside it
+	{
+		FCombatAttackProfileScope TraceScope(ECombatAttackCost::Trace);
+		Profiler.SetScopeAttack(ExpensiveAttack);
+		Profiler.AddScopeSweeps(3);
+		Spin(0.002);
+		{
+			FCombatAttackProfileScope HitScope(ECombatAttackCost::Hit, ExpensiveAttack);
+			Spin(0.004);
+		}
+	}
+	Profiler.AddSwing(ExpensiveAttack);
+
+	// Notify on the cheap attack, and a scope that never learns its attack
+	{
+		FCombatAttackProfileScope NotifyScope(ECombatAttackCost::Notify);
+		NotifyScope.SetAttack(CheapAttack);
+	}
+	{
+		FCombatAttackProfileScope OrphanScope(ECombatAttackCost::Trace);
+		Spin(0.001);
+	}
+	Profiler.AddSwing(CheapAttack);
+
+	Profiler.SetEnabled(bWasEnabled);
+
+	TestEqual("Two attacks charged", Profiler.GetNumAttacks(), 2);
+
+	const FCombatAttackCostStats* Expensive = Profiler.FindStats(ExpensiveAttack);
+	if (TestNotNull("Expensive attack charged", Expensive))
+	{
+		TestEqual("One swing", Expensive->NumSwings, 1);
+		TestEqual("Sweeps counted on the trace scope", Expensive->NumSweeps, static_cast<int64>(3));
+		TestEqual("One traced frame", Expensive->GetNumCalls(ECombatAttackCost::Trace), static_cast<int64>(1));
+		TestEqual("One hit", Expensive->GetNumCalls(ECombatAttackCost::Hit), static_cast<int64>(1));
+
+		// Trace spun ~2ms itself, the hit ~4ms: exclusive time keeps the hit out of the trace
+		const double TraceMs = FPlatformTime::ToMilliseconds64(Expensive->GetCycles(ECombatAttackCost::Trace));
+		const double HitMs = FPlatformTime::ToMilliseconds64(Expensive->GetCycles(ECombatAttackCost::Hit));
+		TestTrue("Hit time measured", HitMs >= 4.0);
+		TestTrue("Trace time measured", TraceMs >= 2.0);
+		TestTrue("Nested hit not charged to the trace", TraceMs < HitMs);
+		TestEqual("Total is the sum of the costs", Expensive->GetTotalCycles(),
+			Expensive->GetCycles(ECombatAttackCost::Trace) + Expensive->GetCycles(ECombatAttackCost::Notify) + Expensive->GetCycles(ECombatAttackCost::Hit));
+	}
+
+	const FCombatAttackCostStats* Cheap = Profiler.FindStats(CheapAttack);
+	if (TestNotNull("Cheap attack charged", Cheap))
+	{
+		TestEqual("Swing while stopped not counted", Cheap->NumSwings, 1);
+		TestEqual("Notify attributed after the scope opened", Cheap->GetNumCalls(ECombatAttackCost::Notify), static_cast<int64>(1));
+		TestEqual("Scope without an attack charged nothing", Cheap->GetNumCalls(ECombatAttackCost::Trace), static_cast<int64>(0));
+	}
+
+	TArray<FCombatAttackCostStats> Rows;
+	Profiler.GetStats(Rows);
+	if (TestEqual("One row per attack", Rows.Num(), 2))
+	{
+		TestEqual("Most expensive first", Rows[0].AttackName, ExpensiveAttack->GetPathName());
+	}
+
+	Profiler.Reset();
+	return true;
+}
+
+/**
+ * Test: Field telemetry
+ * Verifies the histograms resolve percentiles within a bucket, that a session aggregates latency, queue
+ * depth, queue events and per-frame combat cost, and that flushing hands the uploader one JSON batch
+ * while an empty flush sends nothing
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatFieldTelemetryTest, "KatanaCombat.Budget.FieldTelemetry", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatFieldTelemetryTest::RunTest(const FString& Parameters)
+{
+	// Histogram: 1..10
+	FCombatFieldHistogram Histogram(1.0);
+	TestEqual("Empty percentile", Histogram.GetPercentile(0.5), 0.0);
+	for (int32 Value = 1; Value <= 10; ++Value)
+	{
+		Histogram.Add(Value);
+	}
+	TestEqual("Sample count", Histogram.SampleCount, 10u);
+	TestEqual("Mean", Histogram.GetMean(), 5.5);
+	const double Median = Histogram.GetPercentile(0.5);
+	TestTrue("Median within a quarter octave", Median >= 5.0 && Median <= 5.0 * FMath::Pow(2.0, 0.25));
+	TestEqual("Top percentile capped at the max", Histogram.GetPercentile(1.0), 10.0);
+
+	FCombatFieldTelemetry& Telemetry = FCombatFieldTelemetry::Get();
+	const bool bWasEnabled = Telemetry.IsEnabled();
+
+	// Stopped: nothing is recorded
+	Telemetry.Stop();
+	Telemetry.RecordQueueDepth(3);
+	TestEqual("Nothing recorded while stopped", Telemetry.GetCurrentBatch().QueueDepth.SampleCount, 0u);
+
+	TArray<FString> Uploads;
+	Telemetry.SetUploader([&Uploads](const FString& Json) { Uploads.Add(Json); });
+	Telemetry.Start(FString(), 3600.0);
+	TestTrue("Session running", Telemetry.IsEnabled());
+
+	Telemetry.RecordInputLatency(EActionExecutionMode::Immediate, 0.020, false);
+	Telemetry.RecordInputLatency(EActionExecutionMode::Queued, 0.050, false);
+	Telemetry.RecordInputLatency(EActionExecutionMode::Immediate, 0.030, true);
+	Telemetry.RecordQueueDepth(1);
+	Telemetry.RecordQueueDepth(2);
+	Telemetry.RecordQueueEvent(CombatTrace::EQueueEvent::Queued);
+	Telemetry.RecordQueueEvent(CombatTrace::EQueueEvent::Queued);
+	Telemetry.RecordQueueEvent(CombatTrace::EQueueEvent::Executed);
+	Telemetry.RecordQueueEvent(CombatTrace::EQueueEvent::Cancelled);
+
+	// One frame with combat work, one without
+	Telemetry.SampleFrame();
+	CombatBudget::AddCycles(ECombatBudgetCategory::Traces, FPlatformTime::SecondsToCycles64(0.001));
+	CombatBudget::AddPhysicsQueries(4);
+	Telemetry.SampleFrame();
+	Telemetry.SampleFrame();
+
+	const FCombatFieldTelemetryBatch Batch = Telemetry.TakeBatch();
+	TestEqual("Immediate execute sample", Batch.InputToExecuteMs[0].SampleCount, 1u);
+	TestEqual("Queued execute sample", Batch.InputToExecuteMs[1].SampleCount, 1u);
+	TestEqual("First frame sample", Batch.InputToFirstFrameMs[0].SampleCount, 1u);
+	TestEqual("Queue depth samples", Batch.QueueDepth.SampleCount, 2u);
+	TestEqual("Queued", Batch.ActionsQueued, 2);
+	TestEqual("Executed", Batch.ActionsExecuted, 1);
+	TestEqual("Cancelled", Batch.ActionsCancelled, 1);
+	TestEqual("Only frames with combat work are sampled", Batch.NumCombatFrames, 1);
+	TestEqual("Physics queries of the frame", Batch.TracesPerFrame.Max, 4.0);
+	TestTrue("Combat cost of the frame", Batch.CombatFrameMs.Max >= 0.9);
+	TestEqual("First batch of the session", Batch.Sequence, 0);
+	TestEqual("Next batch follows", Telemetry.GetCurrentBatch().Sequence, 1);
+
+	// Empty flush: nothing sent, the sequence number is kept
+	Telemetry.Flush();
+	TestEqual("Empty batch not uploaded", Uploads.Num(), 0);
+	TestEqual("Sequence number reused", Telemetry.GetCurrentBatch().Sequence, 1);
+
+	Telemetry.RecordQueueEvent(CombatTrace::EQueueEvent::Queued);
+	Telemetry.Flush();
+	if (TestEqual("One upload", Uploads.Num(), 1))
+	{
+		TestTrue("Upload names the session", Uploads[0].Contains(Batch.SessionId));
+		TestTrue("Upload carries the batch number", Uploads[0].Contains(TEXT("\"seq\":1")));
+	}
+
+	Telemetry.Stop();
+	TestFalse("Session stopped", Telemetry.IsEnabled());
+	TestEqual("Stopping with nothing recorded uploads nothing", Uploads.Num(), 1);
+
+	Telemetry.SetUploader(nullptr);
+	if (bWasEnabled)
+	{
+		Telemetry.Start();
+	}
+	return true;
+}
+
+/**
+ * Test: Combat hitch detector
+ * Verifies only frames over the threshold are reported, with the frame's combat timers and the recorder
+ * events that happened during it, and that reports are rate limited
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatHitchDetectorTest, "KatanaCombat.Budget.HitchDetector", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatHitchDetectorTest::RunTest(const FString& Parameters)
+{
+	FCombatEventRecorder& Recorder = FCombatEventRecorder::Get();
+	const bool bWasRecording = Recorder.IsEnabled();
+	Recorder.SetEnabled(true);
+
+	FCombatHitchDetector& Detector = FCombatHitchDetector::Get();
+	const bool bWasEnabled = Detector.IsEnabled();
+	const double PreviousThresholdMs = Detector.GetThresholdMs();
+	const double PreviousInterval = Detector.MinReportInterval;
+
+	TArray<FCombatHitchReport> Reports;
+	Detector.SetReportHandler([&Reports](const FCombatHitchReport& Report) { Reports.Add(Report); });
+	Detector.MinReportInterval = 0.0;
+	Detector.Start(30.0, 16);
+
+	TestFalse("Short frame not reported", Detector.CheckFrame(0.010));
+	TestEqual("No hitch", Detector.GetNumHitches(), 0);
+
+	// A cleave: one owner hits eight targets in the long frame (fake ids, resolve as "#id")
+	const uint32 Owner = 0x7FFFFFC0u;
+	for (uint32 Target = 1; Target <= 8; ++Target)
+	{
+		FCombatRecordedEvent Event;
+		Event.Cycle = FPlatformTime::Cycles64();
+		Event.Type = ECombatRecordedEventType::Hit;
+		Event.OwnerId = Owner;
+		Event.SubjectId = Owner + Target;
+		Recorder.Record(Event);
+	}
+	CombatBudget::AddCycles(ECombatBudgetCategory::Traces, FPlatformTime::SecondsToCycles64(0.004));
+	CombatBudget::AddPhysicsQueries(8);
+
+	TestTrue("Long frame reported", Detector.CheckFrame(0.045));
+	if (TestEqual("One report", Reports.Num(), 1))
+	{
+		const FCombatHitchReport& Report = Reports[0];
+		TestTrue("Frame time", FMath::IsNearlyEqual(Report.FrameMs, 45.0, 0.001));
+		TestTrue("Trace time of the frame", Report.SystemMs[static_cast<int32>(ECombatBudgetCategory::Traces)] >= 3.9);
+		TestEqual("Physics queries of the frame", Report.PhysicsQueries, static_cast<uint64>(8));
+		TestEqual("Events of the frame", Report.NumFrameEvents, static_cast<uint64>(8));
+		TestTrue("Events capped", Report.Events.Num() <= 16);
+		TestEqual("Hits of the frame", Report.CountFrameEvents(ECombatRecordedEventType::Hit), 8);
+		TestEqual("Owner name resolved", Report.ObjectNames.FindRef(Owner), FString::Printf(TEXT("#%u"), Owner));
+
+		const FString Text = Report.ToString();
+		TestTrue("Report lists the hits", Text.Contains(TEXT("Hit 8")));
+		TestTrue("Report lists the trace time", Text.Contains(TEXT("Traces 4.0")));
+	}
+
+	// The next frame starts clean
+	TestFalse("Short frame after the hitch not reported", Detector.CheckFrame(0.010));
+
+	// Rate limit
+	Detector.MinReportInterval = 3600.0;
+	TestFalse("Hitch inside the report interval only counted", Detector.CheckFrame(0.100));
+	TestEqual("Hitches counted", Detector.GetNumHitches(), 2);
+	TestEqual("Reports", Detector.GetNumReports(), 1);
+
+	Detector.Stop();
+	TestFalse("Stopped", Detector.IsEnabled());
+	TestFalse("Nothing checked while stopped", Detector.CheckFrame(1.0));
+
+	Detector.SetReportHandler(nullptr);
+	Detector.MinReportInterval = PreviousInterval;
+	if (bWasEnabled)
+	{
+		Detector.Start(PreviousThresholdMs);
+	}
+	Recorder.SetEnabled(bWasRecording);
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatAbstractResolutionSubsystem.h"
+#include "Core/CombatCrowdSubsystem.h"
+
+/**
+ * Test: Crowd timing bake
+ * Attacks without phase notifies fall back to their manual timing
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatCrowdTimingBakeTest, "KatanaCombat.Crowd.TimingBake", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatCrowdTimingBakeTest::RunTest(const FString& Parameters)
+{
+	UAttackData* Attack = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	Attack->ManualTiming.WindupDuration = 0.25f;
+	Attack->ManualTiming.ActiveDuration = 0.15f;
+	Attack->ManualTiming.RecoveryDuration = 0.4f;
+
+	const FCombatCrowdAttackTiming Timing = UCombatCrowdSubsystem::BakeAttackTiming(Attack);
+
+	TestEqual("Windup from manual timing", Timing.Windup, 0.25f);
+	TestEqual("Active from manual timing", Timing.Active, 0.15f);
+	TestEqual("Recovery from manual timing", Timing.Recovery, 0.4f);
+	TestEqual("Posture damage from attack", Timing.PostureDamage, Attack->PostureDamage);
+
+	const FCombatCrowdAttackTiming Empty = UCombatCrowdSubsystem::BakeAttackTiming(nullptr);
+	TestEqual("Null attack has no windup", Empty.Windup, 0.0f);
+
+	return true;
+}
+
+/**
+ * Test: Crowd duel
+ * Two opposing agents in range swing on the baked timing and break each other's posture
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatCrowdDuelTest, "KatanaCombat.Crowd.Duel", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatCrowdDuelTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatCrowdSubsystem* Crowd = World->GetSubsystem<UCombatCrowdSubsystem>();
+
+	if (!TestNotNull("Crowd subsystem should exist", Crowd))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	UAttackData* Attack = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	Attack->ManualTiming.WindupDuration = 0.3f;
+	Attack->ManualTiming.ActiveDuration = 0.2f;
+	Attack->ManualTiming.RecoveryDuration = 0.5f;
+	Attack->PostureDamage = 60.0f;
+
+	FCombatCrowdArchetype Archetype;
+	Archetype.Attacks.Add(Attack);
+	Archetype.MaxPosture = 100.0f;
+	Archetype.PostureRegenRate = 0.0f;
+	Archetype.AttackRange = 180.0f;
+	Archetype.AttackCooldown = 1.0f;
+
+	const int32 ArchetypeIndex = Crowd->RegisterArchetype(Archetype);
+	const int32 AgentA = Crowd->SpawnAgent(ArchetypeIndex, FTransform(FVector::ZeroVector), 0);
+	const int32 AgentB = Crowd->SpawnAgent(ArchetypeIndex, FTransform(FVector(100.0f, 0.0f, 0.0f)), 1);
+
+	TestEqual("Two agents spawned", Crowd->GetNumAgents(), 2);
+	TestEqual("Invalid archetype is rejected", Crowd->SpawnAgent(ArchetypeIndex + 1, FTransform::Identity, 0), INDEX_NONE);
+
+	const float DeltaTime = 1.0f / 60.0f;
+
+	// Already in range: both start winding up on the first tick
+	Crowd->Tick(DeltaTime);
+	TestEqual("A winds up", Crowd->GetAgentPhase(AgentA), EAttackPhase::Windup);
+	TestEqual("B winds up", Crowd->GetAgentPhase(AgentB), EAttackPhase::Windup);
+
+	// Past the windup: swings land as they go active
+	for (int32 Frame = 0; Frame < 20; ++Frame)
+	{
+		Crowd->Tick(DeltaTime);
+	}
+	TestEqual("A is active", Crowd->GetAgentPhase(AgentA), EAttackPhase::Active);
+	TestEqual("A took one hit", Crowd->GetAgentPosture(AgentA), 40.0f);
+	TestEqual("B took one hit", Crowd->GetAgentPosture(AgentB), 40.0f);
+
+	// Recovery, cooldown and a second windup: the second hits break both
+	for (int32 Frame = 0; Frame < 150; ++Frame)
+	{
+		Crowd->Tick(DeltaTime);
+	}
+	TestFalse("A was broken", Crowd->IsValidAgent(AgentA));
+	TestFalse("B was broken", Crowd->IsValidAgent(AgentB));
+	TestEqual("Crowd is empty", Crowd->GetNumAgents(), 0);
+
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
+
+/**
+ * Test: Abstract resolution of offscreen fights
+ * Cooked output matches the attacks' damage over their timing; blocks turn damage into posture damage
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatAbstractResolutionTest, "KatanaCombat.Crowd.AbstractResolution", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatAbstractResolutionTest::RunTest(const FString& Parameters)
+{
+	UAttackData* Light = FCombatTestHelpers::CreateTestAttack(EAttackType::Light);
+	Light->ManualTiming.WindupDuration = 0.2f;
+	Light->ManualTiming.ActiveDuration = 0.1f;
+	Light->ManualTiming.RecoveryDuration = 0.2f;
+	Light->BaseDamage = 20.0f;
+	Light->PostureDamage = 10.0f;
+	Light->CounterDamageMultiplier = 2.0f;
+
+	UAttackData* Heavy = FCombatTestHelpers::CreateTestAttack(EAttackType::Heavy);
+	Heavy->ManualTiming.WindupDuration = 0.6f;
+	Heavy->ManualTiming.ActiveDuration = 0.2f;
+	Heavy->ManualTiming.RecoveryDuration = 0.7f;
+	Heavy->BaseDamage = 40.0f;
+	Heavy->PostureDamage = 30.0f;
+	Heavy->CounterDamageMultiplier = 1.0f;
+
+	// Light (0.5s) + Heavy (1.5s) + two 0.5s gaps = 60 damage and 40 posture every 3 seconds
+	const FCombatAbstractStats Stats = UCombatAbstractResolutionSubsystem::CookStats(Light, Heavy, 0.5f);
+	TestEqual("Damage per second", Stats.DamagePerSecond, 20.0f, 0.01f);
+	TestEqual("Posture damage per second", Stats.PostureDamagePerSecond, 40.0f / 3.0f, 0.01f);
+	TestEqual("Counter multiplier is the average", Stats.CounterDamageMultiplier, 1.5f, 0.01f);
+
+	const FCombatAbstractStats LightOnly = UCombatAbstractResolutionSubsystem::CookStats(Light, nullptr, 0.5f);
+	TestEqual("Missing attack is skipped", LightOnly.DamagePerSecond, 20.0f, 0.01f);
+
+	const FCombatAbstractStats Empty = UCombatAbstractResolutionSubsystem::CookStats(nullptr, nullptr, 0.5f);
+	TestEqual("No attacks, no damage", Empty.DamagePerSecond, 0.0f);
+
+	float Damage = 0.0f;
+	float PostureDamage = 0.0f;
+
+	// A quarter blocked over two seconds
+	UCombatAbstractResolutionSubsystem::ResolveExchange(Stats, 2.0f, 0.25f, false, Damage, PostureDamage);
+	TestEqual("Unblocked share hits health", Damage, 30.0f, 0.01f);
+	TestEqual("Blocked share hits posture", PostureDamage, 40.0f / 3.0f * 0.5f, 0.01f);
+
+	// Everything blocked
+	UCombatAbstractResolutionSubsystem::ResolveExchange(Stats, 2.0f, 1.0f, false, Damage, PostureDamage);
+	TestEqual("Full block takes no health damage", Damage, 0.0f, 0.01f);
+
+	// A broken guard blocks nothing and takes counter damage
+	UCombatAbstractResolutionSubsystem::ResolveExchange(Stats, 2.0f, 1.0f, true, Damage, PostureDamage);
+	TestEqual("Guard broken takes counter damage", Damage, 60.0f, 0.01f);
+	TestEqual("Guard broken takes no posture damage", PostureDamage, 0.0f);
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatDuelSimulator.h"
+
+namespace CombatDuelSimulatorTest
+{
+	/** Light -> Light chain with a heavy finisher (hand-built, no assets) */
+	FCombatDuelMoveset MakeMoveset()
+	{
+		FCombatDuelMoveset Moveset;
+
+		FCombatDuelMove& Light = Moveset.Moves.AddDefaulted_GetRef();
+		Light.Timing.Windup = 0.25f;
+		Light.Timing.Active = 0.1f;
+		Light.Timing.Recovery = 0.35f;
+		Light.Timing.PostureDamage = 15.0f;
+		Light.Damage = 10.0f;
+		Light.CounterDamageMultiplier = 1.5f;
+		Light.NextLight = 0;
+		Light.NextHeavy = 1;
+
+		FCombatDuelMove& Heavy = Moveset.Moves.AddDefaulted_GetRef();
+		Heavy.Timing.Windup = 0.55f;
+		Heavy.Timing.Active = 0.15f;
+		Heavy.Timing.Recovery = 0.5f;
+		Heavy.Timing.PostureDamage = 35.0f;
+		Heavy.Damage = 25.0f;
+		Heavy.CounterDamageMultiplier = 1.5f;
+
+		Moveset.RootLight = 0;
+		Moveset.RootHeavy = 1;
+		return Moveset;
+	}
+}
+
+/**
+ * Test: Duel simulator reproducibility
+ * Verifies parallel batches match duels run one by one with the same seeds
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatDuelSimulatorDeterminismTest, "KatanaCombat.SimCore.DuelDeterminism", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatDuelSimulatorDeterminismTest::RunTest(const FString& Parameters)
+{
+	const FCombatDuelMoveset Moveset = CombatDuelSimulatorTest::MakeMoveset();
+
+	FCombatDuelParams Params;
+	Params.MaxDuration = 30.0f;
+	Params.Fighters[0].Moveset = &Moveset;
+	Params.Fighters[1].Moveset = &Moveset;
+	Params.Fighters[1].Policy.bRandomize = true;
+
+	constexpr int32 NumDuels = 64;
+	constexpr int32 BaseSeed = 42;
+	TArray<FCombatDuelResult> Results;
+	FCombatDuelSimulator::RunDuels(Params, NumDuels, BaseSeed, Results);
+	TestEqual("One result per duel", Results.Num(), NumDuels);
+
+	for (int32 DuelIndex = 0; DuelIndex < Results.Num(); ++DuelIndex)
+	{
+		const FCombatDuelResult Serial = FCombatDuelSimulator::RunDuel(Params, BaseSeed + DuelIndex);
+		if (Serial.Winner != Results[DuelIndex].Winner || Serial.Duration != Results[DuelIndex].Duration
+			|| Serial.DamageDealt[0] != Results[DuelIndex].DamageDealt[0] || Serial.DamageDealt[1] != Results[DuelIndex].DamageDealt[1])
+		{
+			AddError(FString::Printf(TEXT("Duel %d differs between parallel and serial runs"), DuelIndex));
+			break;
+		}
+	}
+
+	const FCombatDuelSummary Summary = FCombatDuelSimulator::Summarize(Results);
+	TestEqual("Outcomes add up", Summary.Wins[0] + Summary.Wins[1] + Summary.Draws, NumDuels);
+	TestTrue("Posture curve sampled", Summary.MeanPosture[0].Num() > 0);
+	return true;
+}
+
+/**
+ * Test: Duel simulator outcomes
+ * Verifies a passive fighter loses every duel and the attacker's damage shows up as DPS
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatDuelSimulatorOutcomeTest, "KatanaCombat.SimCore.DuelOutcome", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatDuelSimulatorOutcomeTest::RunTest(const FString& Parameters)
+{
+	const FCombatDuelMoveset Moveset = CombatDuelSimulatorTest::MakeMoveset();
+
+	FCombatDuelParams Params;
+	Params.MaxDuration = 30.0f;
+	Params.Fighters[0].Moveset = &Moveset;
+	Params.Fighters[1].Moveset = &Moveset;
+	Params.Fighters[1].Policy.Aggression = 0.0f;
+	Params.Fighters[1].Policy.BlockChance = 0.0f;
+
+	TArray<FCombatDuelResult> Results;
+	FCombatDuelSimulator::RunDuels(Params, 32, 7, Results);
+	const FCombatDuelSummary Summary = FCombatDuelSimulator::Summarize(Results);
+
+	TestEqual("Attacker wins every duel", Summary.Wins[0], 32);
+	TestEqual("No timeouts", Summary.Timeouts, 0);
+	TestTrue("Attacker deals damage", Summary.DPS[0] > 0.0f);
+	TestEqual("Passive fighter deals none", Summary.DPS[1], 0.0f);
+	return true;
+}
\ No newline at end of file
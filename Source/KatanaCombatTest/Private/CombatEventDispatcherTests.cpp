@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatEventDispatcherSubsystem.h"
+
+/**
+ * Test: Combat event dispatcher filtering
+ * Verifies unwanted kinds are never queued, filters compare instigator/target/involving,
+ * a frame's events are delivered in one dispatch and stale subscriptions go inert
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatEventDispatcherTest, "KatanaCombat.EventDispatcher.Filtering", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatEventDispatcherTest::RunTest(const FString& Parameters)
+{
+	// Setup
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatEventDispatcherSubsystem* Dispatcher = UCombatEventDispatcherSubsystem::Get(World);
+
+	if (!TestNotNull("Event dispatcher exists", Dispatcher))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	AActor* A = World->SpawnActor<AActor>();
+	AActor* B = World->SpawnActor<AActor>();
+	AActor* C = World->SpawnActor<AActor>();
+
+	// Filters
+	FCombatEvent Event;
+	Event.Kind = ECombatEventKind::Hit;
+	Event.Instigator = A;
+	Event.Target = B;
+
+	FCombatEventFilter Filter({ ECombatEventKind::Hit, ECombatEventKind::Damage });
+	TestTrue("Kind in mask matches", Filter.Matches(Event));
+	Filter.Target = C;
+	TestFalse("Other target rejected", Filter.Matches(Event));
+	Filter.Target = nullptr;
+	Filter.Involving = B;
+	TestTrue("Involving matches the target", Filter.Matches(Event));
+	Filter.Involving = nullptr;
+	Filter.Instigator = B;
+	TestFalse("Instigator must match", Filter.Matches(Event));
+	TestFalse("Kind outside the mask rejected", FCombatEventFilter({ ECombatEventKind::Phase }).Matches(Event));
+
+	// Nobody listening - nothing is queued
+	TestFalse("No listener yet", Dispatcher->IsListening(ECombatEventKind::Hit));
+	TestNull("Unwanted event not queued", Dispatcher->Publish(ECombatEventKind::Hit, A, B));
+	TestEqual("Queue empty", Dispatcher->GetNumPendingEvents(), 0);
+
+	// Watch A: two of the three hits involve it
+	Dispatcher->WatchActor(A);
+	TestTrue("Watching listens to every kind", Dispatcher->IsListening(ECombatEventKind::Damage));
+
+	if (FCombatEvent* Damage = Dispatcher->Publish(ECombatEventKind::Damage, B, A))
+	{
+		Damage->Magnitude = 25.0f;
+	}
+	Dispatcher->Publish(ECombatEventKind::Hit, A, B);
+	Dispatcher->Publish(ECombatEventKind::Hit, B, C);
+	TestEqual("Events queued until the dispatch", Dispatcher->GetNumPendingEvents(), 3);
+
+	Dispatcher->Tick(0.016f);
+	TestEqual("Whole frame dispatched", Dispatcher->GetNumDispatchedLastFrame(), 3);
+	TestEqual("Only matching events delivered", Dispatcher->GetNumDeliveredLastFrame(), 2);
+	TestEqual("Queue drained", Dispatcher->GetNumPendingEvents(), 0);
+
+	// Stale handles don't alias live subscriptions
+	FCombatEventSubscription Stale;
+	Stale.Index = 0;
+	Stale.Serial = 0;
+	TestFalse("Stale handle not subscribed", Dispatcher->IsSubscribed(Stale));
+	TestFalse("Unsubscribing a stale handle is a no-op", Dispatcher->Unsubscribe(Stale));
+
+	// Stop watching - the kinds go quiet once the lists are rebuilt
+	Dispatcher->WatchActor(nullptr);
+	TestEqual("Watch subscription removed", Dispatcher->GetNumSubscribers(), 0);
+	Dispatcher->Publish(ECombatEventKind::Hit, A, B);
+	Dispatcher->DispatchPendingEvents();
+	TestEqual("Nothing delivered after unsubscribing", Dispatcher->GetNumDeliveredLastFrame(), 0);
+	TestFalse("No listener after the rebuild", Dispatcher->IsListening(ECombatEventKind::Hit));
+
+	// Cleanup
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
\ No newline at end of file
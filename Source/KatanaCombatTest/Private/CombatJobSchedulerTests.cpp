@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatJobSchedulerSubsystem.h"
+#include "Core/LineOfSightSubsystem.h"
+
+/**
+ * Test: Combat job scheduler budgeting
+ * Verifies subsystems register their jobs, an exhausted budget defers all but the first due job,
+ * overdue jobs run regardless of budget, and stale handles go inert
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatJobSchedulerTest, "KatanaCombat.JobScheduler.Budget", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatJobSchedulerTest::RunTest(const FString& Parameters)
+{
+	// Setup
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatJobSchedulerSubsystem* Scheduler = World->GetSubsystem<UCombatJobSchedulerSubsystem>();
+
+	if (!TestNotNull("Job scheduler exists", Scheduler) || !TestNotNull("Line of sight exists", World->GetSubsystem<ULineOfSightSubsystem>()))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	const int32 NumJobs = Scheduler->GetNumJobs();
+	TestTrue("Line of sight eviction registered as a job", NumJobs >= 1);
+
+	const double Now = World->GetTimeSeconds();
+	Scheduler->MaxDeferralTime = 10.0f;
+
+	// No budget: the first due job still runs, the rest wait
+	Scheduler->FrameBudgetMs = 0.0f;
+	Scheduler->RunDueJobs(Now);
+	TestEqual("First due job runs without budget", Scheduler->GetNumRunLastFrame(), 1);
+	TestEqual("Remaining due jobs deferred", Scheduler->GetNumDeferredLastFrame(), NumJobs - 1);
+
+	// Deferred past MaxDeferralTime: starvation protection runs them all over budget
+	Scheduler->RunDueJobs(Now + 50.0);
+	TestEqual("Starved jobs all run", Scheduler->GetNumRunLastFrame(), NumJobs);
+	TestEqual("Starved jobs counted", Scheduler->GetNumStarvedLastFrame(), NumJobs);
+	TestEqual("Nothing deferred once starved", Scheduler->GetNumDeferredLastFrame(), 0);
+
+	// Intervals restart from the run - nothing is due again straight away
+	Scheduler->RunDueJobs(Now + 50.0, true);
+	TestEqual("Jobs wait for their interval after running", Scheduler->GetNumRunLastFrame(), 0);
+
+	// Stale handles don't alias live jobs
+	FCombatJobHandle Stale;
+	Stale.Index = 0;
+	Stale.Serial = 0;
+	TestFalse("Stale handle not registered", Scheduler->IsJobRegistered(Stale));
+	TestFalse("Unregistering a stale handle is a no-op", Scheduler->UnregisterJob(Stale));
+	TestEqual("Live jobs untouched", Scheduler->GetNumJobs(), NumJobs);
+
+	// Cleanup
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
\ No newline at end of file
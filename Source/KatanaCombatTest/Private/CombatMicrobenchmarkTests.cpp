@@ -0,0 +1,386 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "ActionQueueTypes.h"
+#include "Core/CombatComponentV2.h"
+#include "Utilities/MontageUtilityLibrary.h"
+#include "Animation/AnimNotifyState_ComboWindow.h"
+#include "Animation/AnimNotifyState_HoldWindow.h"
+#include "Animation/AnimNotifyState_ParryWindow.h"
+#include "Core/CombatSimCore.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * Combat microbenchmarks
+ *
+ * Times queue and resolution primitives in isolation over synthetic attack graphs of
+ * 10/100/1000 attacks and reports ns/op and allocations/op. Allocations are counted by
+ * temporarily routing GMalloc through a forwarding proxy while the timed loop runs, so
+ * other threads allocating at the same time show up as noise - treat small non-zero
+ * counts on otherwise allocation-free paths accordingly.
+ */
+namespace CombatBench
+{
+	const int32 GraphSizes[] = { 10, 100, 1000 };
+
+	/** Forwards to the real allocator, counting Malloc/Realloc calls */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override { NumAllocs.IncrementExchange(); return Inner->Malloc(Count, Alignment); }
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override { NumAllocs.IncrementExchange(); return Inner->TryMalloc(Count, Alignment); }
+		virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override { NumAllocs.IncrementExchange(); return Inner->Realloc(Ptr, NewSize, Alignment); }
+		virtual void* TryRealloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override { NumAllocs.IncrementExchange(); return Inner->TryRealloc(Ptr, NewSize, Alignment); }
+		virtual void Free(void* Ptr) override { Inner->Free(Ptr); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("CombatBenchCountingMalloc"); }
+
+		FMalloc* Inner;
+		TAtomic<uint64> NumAllocs { 0 };
+	};
+
+	struct FResult
+	{
+		double NsPerOp = 0.0;
+		double AllocsPerOp = 0.0;
+	};
+
+	/**
+	 * Time Func over NumOps operations (Func performs all of them)
+	 * The proxy is never deleted: blocks allocated through it may be freed after GMalloc is restored
+	 */
+	template <typename FuncType>
+	FResult Measure(int32 NumOps, FuncType&& Func)
+	{
+		static FCountingMalloc* Counter = new FCountingMalloc(GMalloc);
+		Counter->Inner = GMalloc;
+		Counter->NumAllocs = 0;
+
+		// Warm caches and lazily-built tables so they don't land in the measurement
+		Func();
+
+		FMalloc* Previous = GMalloc;
+		GMalloc = Counter;
+		const uint64 Start = FPlatformTime::Cycles64();
+		Func();
+		const uint64 Elapsed = FPlatformTime::Cycles64() - Start;
+		GMalloc = Previous;
+
+		FResult Result;
+		Result.NsPerOp = FPlatformTime::ToMilliseconds64(Elapsed) * 1.0e6 / FMath::Max(NumOps, 1);
+		Result.AllocsPerOp = static_cast<double>(Counter->NumAllocs.Load()) / FMath::Max(NumOps, 1);
+		return Result;
+	}
+
+	void Report(FAutomationTestBase& Test, const TCHAR* Name, int32 GraphSize, const FResult& Result)
+	{
+		Test.AddInfo(FString::Printf(TEXT("%-28s N=%-5d %10.1f ns/op %8.2f allocs/op"), Name, GraphSize, Result.NsPerOp, Result.AllocsPerOp));
+	}
+
+	/**
+	 * Synthetic combo graph: light chain through every attack, heavy branch and four
+	 * directional follow-ups per node pointing at pseudo-random nodes (fixed seed)
+	 */
+	TArray<UAttackData*> BuildGraph(int32 NumAttacks)
+	{
+		TArray<UAttackData*> Attacks;
+		Attacks.Reserve(NumAttacks);
+		for (int32 i = 0; i < NumAttacks; ++i)
+		{
+			Attacks.Add(FCombatTestHelpers::CreateTestAttack((i % 3) == 2 ? EAttackType::Heavy : EAttackType::Light));
+		}
+
+		FRandomStream Stream(NumAttacks);
+		const EAttackDirection Directions[] = { EAttackDirection::Forward, EAttackDirection::Backward, EAttackDirection::Left, EAttackDirection::Right };
+
+		for (int32 i = 0; i < NumAttacks; ++i)
+		{
+			UAttackData* Attack = Attacks[i];
+			Attack->NextComboAttack = (i + 1 < NumAttacks) ? Attacks[i + 1] : nullptr;
+			Attack->HeavyComboAttack = Attacks[Stream.RandRange(0, NumAttacks - 1)];
+
+			for (EAttackDirection Direction : Directions)
+			{
+				Attack->DirectionalFollowUps.Add(Direction, Attacks[Stream.RandRange(0, NumAttacks - 1)]);
+			}
+		}
+
+		return Attacks;
+	}
+
+	/** Montage with NumWindows combo/parry/hold notify states spread over 2 seconds */
+	UAnimMontage* BuildWindowMontage(int32 NumWindows)
+	{
+		UAnimMontage* Montage = NewObject<UAnimMontage>();
+		FRandomStream Stream(NumWindows);
+
+		for (int32 i = 0; i < NumWindows; ++i)
+		{
+			FAnimNotifyEvent& Event = Montage->Notifies.AddDefaulted_GetRef();
+			switch (i % 3)
+			{
+				case 0: Event.NotifyStateClass = NewObject<UAnimNotifyState_ComboWindow>(Montage); break;
+				case 1: Event.NotifyStateClass = NewObject<UAnimNotifyState_ParryWindow>(Montage); break;
+				default: Event.NotifyStateClass = NewObject<UAnimNotifyState_HoldWindow>(Montage); break;
+			}
+			Event.SetTime(Stream.FRandRange(0.0f, 2.0f));
+			Event.SetDuration(0.2f);
+		}
+
+		return Montage;
+	}
+}
+
+/**
+ * Bench: UMontageUtilityLibrary::ResolveNextAttack_V2 over every graph node
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatBenchResolveNextAttackTest, "KatanaCombat.Performance.Bench.ResolveNextAttack", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FCombatBenchResolveNextAttackTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatBench;
+
+	for (int32 GraphSize : GraphSizes)
+	{
+		const TArray<UAttackData*> Attacks = BuildGraph(GraphSize);
+		const FGameplayTagContainer EmptyContext;
+		TSet<UAttackData*> Visited;
+		Visited.Reserve(8);
+		int32 NumResolved = 0;
+
+		const int32 NumOps = FMath::Max(GraphSize, 1000);
+		const FResult Result = Measure(NumOps, [&]()
+		{
+			for (int32 Op = 0; Op < NumOps; ++Op)
+			{
+				Visited.Reset();
+				const bool bHeavy = (Op & 1) != 0;
+				const FAttackResolutionResult Resolved = UMontageUtilityLibrary::ResolveNextAttack_V2(
+					Attacks[Op % GraphSize],
+					bHeavy ? EInputType::HeavyAttack : EInputType::LightAttack,
+					static_cast<EAttackDirection>(Op % 5),
+					(Op & 2) != 0,
+					true,
+					Attacks[0],
+					Attacks[0],
+					EmptyContext,
+					Visited);
+				NumResolved += Resolved.Attack ? 1 : 0;
+			}
+		});
+
+		Report(*this, TEXT("ResolveNextAttack_V2"), GraphSize, Result);
+		TestTrue(TEXT("Resolution should find attacks in a connected graph"), NumResolved > 0);
+	}
+
+	return true;
+}
+
+/**
+ * Bench: UMontageUtilityLibrary::DiscoverCheckpoints (uncached scan + sort)
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatBenchDiscoverCheckpointsTest, "KatanaCombat.Performance.Bench.DiscoverCheckpoints", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FCombatBenchDiscoverCheckpointsTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatBench;
+
+	for (int32 NumWindows : GraphSizes)
+	{
+		UAnimMontage* Montage = BuildWindowMontage(NumWindows);
+		TArray<FTimerCheckpoint> Checkpoints;
+		Checkpoints.Reserve(NumWindows);
+
+		constexpr int32 NumOps = 200;
+		const FResult Result = Measure(NumOps, [&]()
+		{
+			for (int32 Op = 0; Op < NumOps; ++Op)
+			{
+				UMontageUtilityLibrary::DiscoverCheckpoints(Montage, Checkpoints);
+			}
+		});
+
+		Report(*this, TEXT("DiscoverCheckpoints"), NumWindows, Result);
+		TestEqual(TEXT("Every window notify should produce a checkpoint"), Checkpoints.Num(), NumWindows);
+	}
+
+	return true;
+}
+
+/**
+ * Bench: UMontageUtilityLibrary::EvaluateEasing across all curves
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatBenchEvaluateEasingTest, "KatanaCombat.Performance.Bench.EvaluateEasing", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FCombatBenchEvaluateEasingTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatBench;
+
+	constexpr int32 NumOps = 100000;
+	constexpr int32 NumEasingTypes = static_cast<int32>(EEasingType::EaseInOutSine) + 1;
+	float Sink = 0.0f;
+
+	const FResult Result = Measure(NumOps, [&]()
+	{
+		for (int32 Op = 0; Op < NumOps; ++Op)
+		{
+			Sink += UMontageUtilityLibrary::EvaluateEasing((Op % 1024) / 1023.0f, static_cast<EEasingType>(Op % NumEasingTypes));
+		}
+	});
+
+	Report(*this, TEXT("EvaluateEasing"), NumEasingTypes, Result);
+	TestTrue(TEXT("Easing output should be finite"), FMath::IsFinite(Sink));
+	return true;
+}
+
+/**
+ * Bench: FActionQueue ordered insert (replaces the old SortQueueByTime pass)
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatBenchActionQueueInsertTest, "KatanaCombat.Performance.Bench.ActionQueueInsert", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FCombatBenchActionQueueInsertTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatBench;
+
+	const TArray<UAttackData*> Attacks = BuildGraph(10);
+	constexpr int32 NumRounds = 10000;
+	constexpr int32 NumOps = NumRounds * FActionQueue::Capacity;
+
+	// Reverse-ordered times are the worst case: every push walks the full list
+	for (const bool bReverseOrder : { false, true })
+	{
+		FActionQueue Queue;
+		const FResult Result = Measure(NumOps, [&]()
+		{
+			for (int32 Round = 0; Round < NumRounds; ++Round)
+			{
+				Queue.Reset();
+				for (int32 i = 0; i < FActionQueue::Capacity; ++i)
+				{
+					FActionQueueEntry Entry(FQueuedInputAction(EInputType::LightAttack, EInputEventType::Press, 0.0f), Attacks[i % Attacks.Num()], EActionExecutionMode::Queued);
+					Entry.ScheduledTime = bReverseOrder ? (FActionQueue::Capacity - i) * 0.1f : i * 0.1f;
+					Queue.Push(Entry);
+				}
+			}
+		});
+
+		Report(*this, bReverseOrder ? TEXT("ActionQueue.Push (reverse)") : TEXT("ActionQueue.Push (in order)"), FActionQueue::Capacity, Result);
+		TestEqual(TEXT("Queue should be full after a round"), Queue.Num(), FActionQueue::Capacity);
+	}
+
+	return true;
+}
+
+/**
+ * Bench: UCombatComponentV2::QueueAction and ProcessQueue with a full queue
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatBenchQueueActionTest, "KatanaCombat.Performance.Bench.QueueAction", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FCombatBenchQueueActionTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatBench;
+
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* CombatComp = nullptr;
+	ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+	if (Character)
+	{
+		Character->CombatSettings->bUseV2System = true;
+		Character->SelectCombatBackend();
+	}
+	UCombatComponentV2* V2 = Character ? Character->CombatComponentV2.Get() : nullptr;
+
+	if (!TestNotNull(TEXT("V2 component should exist"), V2))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	for (int32 GraphSize : GraphSizes)
+	{
+		const TArray<UAttackData*> Attacks = BuildGraph(GraphSize);
+		Character->CombatSettings->AttackConfiguration->DefaultLightAttack = Attacks[0];
+		Character->CombatSettings->AttackConfiguration->DefaultHeavyAttack = Attacks[0];
+
+		constexpr int32 NumRounds = 500;
+		constexpr int32 NumOps = NumRounds * FActionQueue::Capacity;
+
+		const FResult QueueResult = Measure(NumOps, [&]()
+		{
+			for (int32 Round = 0; Round < NumRounds; ++Round)
+			{
+				V2->ClearQueue(false);
+				for (int32 i = 0; i < FActionQueue::Capacity; ++i)
+				{
+					const FQueuedInputAction Input((i & 1) ? EInputType::HeavyAttack : EInputType::LightAttack, EInputEventType::Press, i * 0.05f, true);
+					V2->QueueAction(Input, Attacks[(Round * FActionQueue::Capacity + i) % GraphSize]);
+				}
+			}
+		});
+		Report(*this, TEXT("QueueAction"), GraphSize, QueueResult);
+
+		const FResult ProcessResult = Measure(NumRounds, [&]()
+		{
+			for (int32 Round = 0; Round < NumRounds; ++Round)
+			{
+				V2->ProcessQueue(Round * 0.01f);
+			}
+		});
+		Report(*this, TEXT("ProcessQueue"), GraphSize, ProcessResult);
+	}
+
+	V2->ClearQueue(true);
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
+
+/**
+ * Bench: FCombatSimCore::Step with 10/100/1000 fighters attacking on a loop (no world)
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatBenchSimCoreStepTest, "KatanaCombat.Performance.Bench.SimCoreStep", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FCombatBenchSimCoreStepTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatBench;
+
+	for (const int32 NumFighters : GraphSizes)
+	{
+		FCombatSimCore Sim;
+		FCombatSimAttackTiming Timing;
+		Timing.Windup = 0.2f;
+		Timing.Active = 0.1f;
+		Timing.Recovery = 0.3f;
+		const int32 Attack = Sim.AddAttack(Timing);
+
+		for (int32 i = 0; i < NumFighters; ++i)
+		{
+			Sim.RequestAttack(Sim.AddFighter(), Attack);
+		}
+
+		constexpr int32 NumSteps = 600;
+		const FResult Result = Measure(NumSteps * NumFighters, [&]()
+		{
+			for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+			{
+				// Keep everyone swinging; events are consumed like an adapter would
+				for (int32 i = 0; i < NumFighters; ++i)
+				{
+					if (Sim.GetFighter(i).AttackIndex == INDEX_NONE)
+					{
+						Sim.RequestAttack(i, Attack);
+					}
+				}
+				Sim.ResetEvents();
+				Sim.Step();
+			}
+		});
+
+		Report(*this, TEXT("SimCoreStep (per fighter)"), NumFighters, Result);
+	}
+	return true;
+}
\ No newline at end of file
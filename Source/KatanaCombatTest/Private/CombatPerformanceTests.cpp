@@ -0,0 +1,270 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatComponentV2.h"
+#include "Core/WeaponComponent.h"
+#include "Core/CombatTimerWheelSubsystem.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+/**
+ * Combat performance suite
+ *
+ * Spawns a crowd of ASamuraiCharacters, drives a scripted light-combo / heavy-hold / parry
+ * loop through V1 or V2 and measures per-frame cost of the combat component, weapon traces
+ * and targeting. Results are compared against Baselines/CombatPerfBaseline.txt.
+ * Pass -CombatPerfUpdateBaseline to rewrite the baseline from the current run.
+ */
+namespace CombatPerf
+{
+	constexpr int32 NumCharacters = 16;
+	constexpr int32 NumFrames = 240;
+	constexpr float FrameDelta = 1.0f / 60.0f;
+
+	struct FMetrics
+	{
+		double CombatComponentUs = 0.0;
+		double WeaponTraceUs = 0.0;
+		double TargetingUs = 0.0;
+		double FrameUs = 0.0;
+	};
+
+	FString GetBaselinePath()
+	{
+		return FPaths::ProjectDir() / TEXT("Source/KatanaCombatTest/Baselines/CombatPerfBaseline.txt");
+	}
+
+	/** Key=Value lines, ';' comments */
+	TMap<FString, double> LoadBaseline()
+	{
+		TMap<FString, double> Values;
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *GetBaselinePath());
+
+		for (const FString& Line : Lines)
+		{
+			FString Key, Value;
+			if (!Line.StartsWith(TEXT(";")) && Line.Split(TEXT("="), &Key, &Value))
+			{
+				Values.Add(Key.TrimStartAndEnd(), FCString::Atod(*Value));
+			}
+		}
+		return Values;
+	}
+
+	void UpdateBaseline(const FString& Prefix, const FMetrics& Metrics)
+	{
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *GetBaselinePath());
+
+		const TPair<FString, double> Entries[] = {
+			{ Prefix + TEXT(".CombatComponent"), Metrics.CombatComponentUs },
+			{ Prefix + TEXT(".WeaponTrace"), Metrics.WeaponTraceUs },
+			{ Prefix + TEXT(".Targeting"), Metrics.TargetingUs },
+			{ Prefix + TEXT(".Frame"), Metrics.FrameUs }
+		};
+
+		for (const TPair<FString, double>& Entry : Entries)
+		{
+			const FString NewLine = FString::Printf(TEXT("%s=%.0f"), *Entry.Key, FMath::CeilToDouble(Entry.Value));
+			const int32 Existing = Lines.IndexOfByPredicate([&Entry](const FString& Line) { return Line.StartsWith(Entry.Key + TEXT("=")); });
+			if (Existing != INDEX_NONE)
+			{
+				Lines[Existing] = NewLine;
+			}
+			else
+			{
+				Lines.Add(NewLine);
+			}
+		}
+
+		FFileHelper::SaveStringArrayToFile(Lines, *GetBaselinePath());
+	}
+
+	/** Scripted input for one character on one frame (staggered per character so work is spread) */
+	void DriveInput(ASamuraiCharacter* Character, int32 Frame, int32 CharacterIndex, bool bUseV2)
+	{
+		const int32 LocalFrame = Frame + CharacterIndex * 7;
+		const int32 Cycle = LocalFrame % 120;
+
+		// 0..59: light combo taps, 60..89: heavy hold, 90..119: parry attempts
+		const bool bLightPress = Cycle < 60 && (Cycle % 15) == 0;
+		const bool bLightRelease = Cycle < 60 && (Cycle % 15) == 3;
+		const bool bHeavyPress = Cycle == 60;
+		const bool bHeavyRelease = Cycle == 85;
+		const bool bBlockPress = Cycle == 95 || Cycle == 110;
+		const bool bBlockRelease = Cycle == 100 || Cycle == 115;
+
+		if (bUseV2)
+		{
+			UCombatComponentV2* V2 = Character->CombatComponentV2;
+			if (bLightPress) V2->OnInputEvent(EInputType::LightAttack, EInputEventType::Press, EInputDirection::Forward);
+			if (bLightRelease) V2->OnInputEvent(EInputType::LightAttack, EInputEventType::Release, EInputDirection::Forward);
+			if (bHeavyPress) V2->OnInputEvent(EInputType::HeavyAttack, EInputEventType::Press);
+			if (bHeavyRelease) V2->OnInputEvent(EInputType::HeavyAttack, EInputEventType::Release);
+			if (bBlockPress) V2->OnInputEvent(EInputType::Block, EInputEventType::Press);
+			if (bBlockRelease) V2->OnInputEvent(EInputType::Block, EInputEventType::Release);
+		}
+		else
+		{
+			UCombatComponent* V1 = Character->CombatComponent;
+			if (bLightPress) V1->OnLightAttackPressed();
+			if (bLightRelease) V1->OnLightAttackReleased();
+			if (bHeavyPress) V1->OnHeavyAttackPressed();
+			if (bHeavyRelease) V1->OnHeavyAttackReleased();
+			if (bBlockPress) V1->OnBlockPressed();
+			if (bBlockRelease) V1->OnBlockReleased();
+		}
+	}
+
+	template <typename FuncType>
+	double TimeUs(FuncType&& Func)
+	{
+		const uint64 Start = FPlatformTime::Cycles64();
+		Func();
+		return FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start) * 1000.0;
+	}
+
+	/** Run the scripted loop and return average per-frame cost */
+	FMetrics RunScenario(bool bUseV2)
+	{
+		UWorld* World = FCombatTestHelpers::CreateTestWorld();
+
+		UAttackData* LightChain = FCombatTestHelpers::CreateTestComboChain(4, EAttackType::Light);
+		UAttackData* Heavy = FCombatTestHelpers::CreateTestAttack(EAttackType::Heavy);
+
+		TArray<ASamuraiCharacter*> Characters;
+		for (int32 i = 0; i < NumCharacters; ++i)
+		{
+			UCombatComponent* CombatComp = nullptr;
+			ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+			if (!Character)
+			{
+				continue;
+			}
+
+			Character->SetActorLocation(FVector((i % 4) * 200.0f, (i / 4) * 200.0f, 0.0f));
+			Character->CombatSettings->bUseV2System = bUseV2;
+			Character->SelectCombatBackend();
+			Character->CombatSettings->AttackConfiguration->DefaultLightAttack = LightChain;
+			Character->CombatSettings->AttackConfiguration->DefaultHeavyAttack = Heavy;
+
+			// Worst case: weapon traces every frame
+			Character->WeaponComponent->EnableHitDetection();
+			Characters.Add(Character);
+		}
+
+		FMetrics Totals;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			FMetrics FrameMetrics;
+
+			for (int32 i = 0; i < Characters.Num(); ++i)
+			{
+				ASamuraiCharacter* Character = Characters[i];
+
+				FrameMetrics.CombatComponentUs += TimeUs([&]()
+				{
+					DriveInput(Character, Frame, i, bUseV2);
+					UActorComponent* Combat = bUseV2 ? static_cast<UActorComponent*>(Character->CombatComponentV2) : Character->CombatComponent;
+					Combat->TickComponent(FrameDelta, LEVELTICK_All, &Combat->PrimaryComponentTick);
+				});
+
+				FrameMetrics.WeaponTraceUs += TimeUs([&]()
+				{
+					Character->WeaponComponent->TickComponent(FrameDelta, LEVELTICK_All, &Character->WeaponComponent->PrimaryComponentTick);
+				});
+
+				FrameMetrics.TargetingUs += TimeUs([&]()
+				{
+					Character->TargetingComponent->FindTarget(EAttackDirection::Forward);
+				});
+			}
+
+			// Timers drive V1 windows and V2 hold/easing callbacks
+			World->GetTimerManager().Tick(FrameDelta);
+			if (UCombatTimerWheelSubsystem* TimerWheel = World->GetSubsystem<UCombatTimerWheelSubsystem>())
+			{
+				TimerWheel->Advance(FrameDelta);
+			}
+
+			Totals.CombatComponentUs += FrameMetrics.CombatComponentUs;
+			Totals.WeaponTraceUs += FrameMetrics.WeaponTraceUs;
+			Totals.TargetingUs += FrameMetrics.TargetingUs;
+			Totals.FrameUs += FrameMetrics.CombatComponentUs + FrameMetrics.WeaponTraceUs + FrameMetrics.TargetingUs;
+		}
+
+		FCombatTestHelpers::DestroyTestWorld(World);
+
+		FMetrics Average;
+		Average.CombatComponentUs = Totals.CombatComponentUs / NumFrames;
+		Average.WeaponTraceUs = Totals.WeaponTraceUs / NumFrames;
+		Average.TargetingUs = Totals.TargetingUs / NumFrames;
+		Average.FrameUs = Totals.FrameUs / NumFrames;
+		return Average;
+	}
+
+	/** Compare against the baseline, or rewrite it when -CombatPerfUpdateBaseline is passed */
+	void CheckBaseline(FAutomationTestBase& Test, const FString& Prefix, const FMetrics& Metrics)
+	{
+		Test.AddInfo(FString::Printf(TEXT("%s per frame (%d characters): Combat %.1fus, WeaponTrace %.1fus, Targeting %.1fus, Total %.1fus"),
+			*Prefix, NumCharacters, Metrics.CombatComponentUs, Metrics.WeaponTraceUs, Metrics.TargetingUs, Metrics.FrameUs));
+
+		if (FParse::Param(FCommandLine::Get(), TEXT("CombatPerfUpdateBaseline")))
+		{
+			UpdateBaseline(Prefix, Metrics);
+			Test.AddInfo(FString::Printf(TEXT("Baseline updated: %s"), *GetBaselinePath()));
+			return;
+		}
+
+		const TMap<FString, double> Baseline = LoadBaseline();
+		if (Baseline.Num() == 0)
+		{
+			Test.AddWarning(FString::Printf(TEXT("No perf baseline at %s - results not checked"), *GetBaselinePath()));
+			return;
+		}
+
+		const double Tolerance = Baseline.FindRef(TEXT("Tolerance"));
+		const TPair<const TCHAR*, double> Checks[] = {
+			{ TEXT("CombatComponent"), Metrics.CombatComponentUs },
+			{ TEXT("WeaponTrace"), Metrics.WeaponTraceUs },
+			{ TEXT("Targeting"), Metrics.TargetingUs },
+			{ TEXT("Frame"), Metrics.FrameUs }
+		};
+
+		for (const TPair<const TCHAR*, double>& Check : Checks)
+		{
+			const FString Key = Prefix + TEXT(".") + Check.Key;
+			if (const double* Budget = Baseline.Find(Key))
+			{
+				const double Limit = *Budget * (1.0 + Tolerance);
+				Test.TestTrue(*FString::Printf(TEXT("%s: %.1fus should be within baseline %.1fus (+%.0f%%)"), *Key, Check.Value, *Budget, Tolerance * 100.0),
+					Check.Value <= Limit);
+			}
+		}
+	}
+}
+
+/**
+ * Perf: V1 crowd loop (UCombatComponent)
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatPerfV1Test, "KatanaCombat.Performance.CrowdLoopV1", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FCombatPerfV1Test::RunTest(const FString& Parameters)
+{
+	CombatPerf::CheckBaseline(*this, TEXT("V1"), CombatPerf::RunScenario(false));
+	return true;
+}
+
+/**
+ * Perf: V2 crowd loop (UCombatComponentV2)
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatPerfV2Test, "KatanaCombat.Performance.CrowdLoopV2", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FCombatPerfV2Test::RunTest(const FString& Parameters)
+{
+	CombatPerf::CheckBaseline(*this, TEXT("V2"), CombatPerf::RunScenario(true));
+	return true;
+}
\ No newline at end of file
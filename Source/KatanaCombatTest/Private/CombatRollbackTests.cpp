@@ -0,0 +1,222 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatRollback.h"
+#include "Math/RandomStream.h"
+
+namespace CombatRollbackTest
+{
+	/** Light -> Light chain with a heavy finisher (hand-built, no assets) */
+	FCombatDuelMoveset MakeMoveset()
+	{
+		FCombatDuelMoveset Moveset;
+
+		FCombatDuelMove& Light = Moveset.Moves.AddDefaulted_GetRef();
+		Light.Timing.Windup = 0.25f;
+		Light.Timing.Active = 0.1f;
+		Light.Timing.Recovery = 0.35f;
+		Light.Timing.PostureDamage = 15.0f;
+		Light.Damage = 10.0f;
+		Light.CounterDamageMultiplier = 1.5f;
+		Light.NextLight = 0;
+		Light.NextHeavy = 1;
+
+		FCombatDuelMove& Heavy = Moveset.Moves.AddDefaulted_GetRef();
+		Heavy.Timing.Windup = 0.55f;
+		Heavy.Timing.Active = 0.15f;
+		Heavy.Timing.Recovery = 0.5f;
+		Heavy.Timing.PostureDamage = 35.0f;
+		Heavy.Damage = 25.0f;
+		Heavy.CounterDamageMultiplier = 1.5f;
+
+		Moveset.RootLight = 0;
+		Moveset.RootHeavy = 1;
+		return Moveset;
+	}
+
+	/** Scripted input of a fighter on a frame (same on every peer) */
+	FCombatRollbackInput GetInput(int32 FighterIndex, int32 Frame)
+	{
+		FRandomStream Stream(Frame * 2 + FighterIndex);
+
+		FCombatRollbackInput Input;
+		if ((Frame / 40 + FighterIndex) % 3 == 0)
+		{
+			Input.Buttons |= FCombatRollbackInput::Block;
+		}
+		else if (Stream.FRand() < 0.08f)
+		{
+			Input.Buttons |= Stream.FRand() < 0.3f ? FCombatRollbackInput::Heavy : FCombatRollbackInput::Light;
+		}
+		return Input;
+	}
+
+	struct FMessage
+	{
+		int32 DeliverTick = 0;
+		int32 Frame = 0;
+		FCombatRollbackInput Input;
+	};
+}
+
+/**
+ * Test: Rollback session determinism
+ * Verifies two peers exchanging inputs with more latency than the input delay end on the same
+ * state and confirmed events as a session that had every input on time
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatRollbackDeterminismTest, "KatanaCombat.SimCore.RollbackDeterminism", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatRollbackDeterminismTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatRollbackTest;
+
+	const FCombatDuelMoveset Moveset = MakeMoveset();
+	FCombatRollbackConfig Config;
+	Config.Movesets[0] = &Moveset;
+	Config.Movesets[1] = &Moveset;
+	Config.MaxHealth[0] = Config.MaxHealth[1] = 1000.0f;
+
+	constexpr int32 NumFrames = 600;
+	constexpr int32 Latency = 5;
+
+	// Reference: remote inputs arrive before they're needed
+	FCombatRollbackSession Reference;
+	Reference.Start(Config, 0);
+	while (Reference.GetCurrentFrame() < NumFrames)
+	{
+		const int32 Frame = Reference.GetCurrentFrame() + Config.InputDelay;
+		Reference.AddRemoteInput(Frame, GetInput(1, Frame));
+		Reference.AdvanceFrame(GetInput(0, Frame));
+	}
+	TestEqual("Reference never rolls back", Reference.GetNumRollbacks(), 0);
+
+	// Peers: every input takes Latency ticks to reach the other side
+	FCombatRollbackSession Peers[2];
+	TArray<FMessage> InFlight[2];
+	Peers[0].Start(Config, 0);
+	Peers[1].Start(Config, 1);
+
+	for (int32 Tick = 0; Peers[0].GetConfirmedFrame() < NumFrames || Peers[1].GetConfirmedFrame() < NumFrames; ++Tick)
+	{
+		if (Tick > NumFrames * 4)
+		{
+			AddError(TEXT("Peers never confirmed every frame"));
+			return false;
+		}
+
+		for (int32 PeerIndex = 0; PeerIndex < 2; ++PeerIndex)
+		{
+			FCombatRollbackSession& Peer = Peers[PeerIndex];
+			TArray<FMessage>& Inbox = InFlight[PeerIndex];
+			for (int32 MessageIndex = Inbox.Num() - 1; MessageIndex >= 0; --MessageIndex)
+			{
+				if (Inbox[MessageIndex].DeliverTick <= Tick)
+				{
+					Peer.AddRemoteInput(Inbox[MessageIndex].Frame, Inbox[MessageIndex].Input);
+					Inbox.RemoveAt(MessageIndex);
+				}
+			}
+
+			if (Peer.GetCurrentFrame() >= NumFrames)
+			{
+				Peer.Synchronize();
+				continue;
+			}
+
+			const int32 Frame = Peer.GetCurrentFrame() + Config.InputDelay;
+			if (Peer.AdvanceFrame(GetInput(PeerIndex, Frame)) == Frame)
+			{
+				InFlight[1 - PeerIndex].Add({ Tick + Latency, Frame, GetInput(PeerIndex, Frame) });
+			}
+		}
+	}
+
+	TestTrue("Late inputs caused rollbacks", Peers[0].GetNumRollbacks() > 0 && Peers[1].GetNumRollbacks() > 0);
+	TestEqual("Peer 0 matches the reference", Peers[0].ComputeChecksum(), Reference.ComputeChecksum());
+	TestEqual("Peer 1 matches the reference", Peers[1].ComputeChecksum(), Reference.ComputeChecksum());
+
+	// Presentation saw each confirmed event once, whatever was resimulated
+	int32 NumHits = 0;
+	for (int32 PeerIndex = 0; PeerIndex < 2; ++PeerIndex)
+	{
+		const TArray<FCombatRollbackEvent>& Events = Peers[PeerIndex].GetConfirmedEvents();
+		const TArray<FCombatRollbackEvent>& Expected = Reference.GetConfirmedEvents();
+		if (!TestEqual("Same number of confirmed events", Events.Num(), Expected.Num()))
+		{
+			continue;
+		}
+
+		for (int32 EventIndex = 0; EventIndex < Events.Num(); ++EventIndex)
+		{
+			if (Events[EventIndex].Frame != Expected[EventIndex].Frame || Events[EventIndex].SimEvent.Type != Expected[EventIndex].SimEvent.Type
+				|| Events[EventIndex].bHit != Expected[EventIndex].bHit || Events[EventIndex].Damage != Expected[EventIndex].Damage)
+			{
+				AddError(FString::Printf(TEXT("Peer %d confirmed event %d differs from the reference"), PeerIndex, EventIndex));
+				break;
+			}
+			NumHits += Events[EventIndex].bHit ? 1 : 0;
+		}
+	}
+	TestTrue("Fighters landed hits", NumHits > 0);
+	return true;
+}
+
+/**
+ * Test: Rollback snapshots and stalling
+ * Verifies a snapshot round trip restores the core exactly and a peer that hears nothing stops
+ * MaxRollbackFrames ahead
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatRollbackSnapshotTest, "KatanaCombat.SimCore.RollbackSnapshot", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatRollbackSnapshotTest::RunTest(const FString& Parameters)
+{
+	using namespace CombatRollbackTest;
+
+	const FCombatDuelMoveset Moveset = MakeMoveset();
+
+	FCombatSimCore Sim;
+	for (const FCombatDuelMove& Move : Moveset.Moves)
+	{
+		Sim.AddAttack(Move.Timing);
+	}
+	Sim.AddFighter();
+	Sim.AddFighter();
+	Sim.RequestAttack(0, 0);
+	for (int32 Step = 0; Step < 10; ++Step)
+	{
+		Sim.Step();
+	}
+
+	FCombatSimSnapshot Snapshot;
+	TestTrue("Two fighters fit a snapshot", Sim.SaveSnapshot(Snapshot));
+	const uint32 Saved = Sim.ComputeChecksum();
+
+	Sim.RequestAttack(1, 1);
+	Sim.ApplyPostureDamage(0, 30.0f);
+	for (int32 Step = 0; Step < 30; ++Step)
+	{
+		Sim.Step();
+	}
+	TestNotEqual("State moved on", Sim.ComputeChecksum(), Saved);
+
+	Sim.RestoreSnapshot(Snapshot);
+	TestEqual("Restore brings the state back", Sim.ComputeChecksum(), Saved);
+
+	// No remote inputs at all: predict up to the limit, then wait
+	FCombatRollbackConfig Config;
+	Config.Movesets[0] = &Moveset;
+	Config.Movesets[1] = &Moveset;
+
+	FCombatRollbackSession Session;
+	Session.Start(Config, 0);
+	for (int32 Tick = 0; Tick < 30; ++Tick)
+	{
+		Session.AdvanceFrame(GetInput(0, Tick));
+	}
+	TestEqual("Stalled at the rollback limit", Session.GetCurrentFrame() - Session.GetConfirmedFrame(), Config.MaxRollbackFrames);
+	TestEqual("Advancing while stalled does nothing", Session.AdvanceFrame(FCombatRollbackInput()), INDEX_NONE);
+
+	// Inputs beyond what the ring holds are refused
+	TestFalse("Far future input refused", Session.AddRemoteInput(Session.GetConfirmedFrame() + 1000, FCombatRollbackInput()));
+	return true;
+}
\ No newline at end of file
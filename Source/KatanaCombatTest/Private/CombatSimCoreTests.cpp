@@ -0,0 +1,148 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatSimCore.h"
+
+namespace CombatSimCoreTest
+{
+	/** Two attacks, a few fighters and a scripted input stream (no world needed) */
+	uint32 RunScript(FCombatSimCore& Sim, int32 NumSteps)
+	{
+		FCombatSimAttackTiming Light;
+		Light.Windup = 0.2f;
+		Light.Active = 0.1f;
+		Light.Recovery = 0.3f;
+		Light.PostureDamage = 15.0f;
+		const int32 LightIndex = Sim.AddAttack(Light);
+
+		FCombatSimAttackTiming Heavy = Light;
+		Heavy.Windup = 0.5f;
+		Heavy.PostureDamage = 40.0f;
+		const int32 HeavyIndex = Sim.AddAttack(Heavy);
+
+		constexpr int32 NumFighters = 4;
+		for (int32 i = 0; i < NumFighters; ++i)
+		{
+			Sim.AddFighter();
+		}
+
+		FRandomStream Stream(1234);
+		for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+		{
+			const int32 Fighter = Stream.RandRange(0, NumFighters - 1);
+			switch (Stream.RandRange(0, 4))
+			{
+				case 0: Sim.RequestAttack(Fighter, LightIndex); break;
+				case 1: Sim.RequestAttack(Fighter, HeavyIndex); break;
+				case 2: Sim.SetHoldRequested(Fighter, Stream.FRand() < 0.5f); break;
+				case 3: Sim.SetBlocking(Fighter, Stream.FRand() < 0.5f); break;
+				default: Sim.ApplyPostureDamage(Fighter, Stream.FRandRange(0.0f, 30.0f)); break;
+			}
+
+			for (const FCombatSimEvent& Event : Sim.GetEvents())
+			{
+				// Active swings hit the next fighter over
+				if (Event.Type == ECombatSimEventType::PhaseChanged && Event.Phase == EAttackPhase::Active)
+				{
+					Sim.ApplyPostureDamage((Event.FighterIndex + 1) % NumFighters, Sim.GetAttackTiming(Event.AttackIndex)->PostureDamage);
+				}
+			}
+			Sim.ResetEvents();
+
+			Sim.Step();
+		}
+
+		return Sim.ComputeChecksum();
+	}
+}
+
+/**
+ * Test: Combat simulation core determinism
+ * Verifies identical input scripts produce identical state, and that real-time
+ * accumulation runs the same fixed steps regardless of frame rate
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatSimCoreDeterminismTest, "KatanaCombat.SimCore.Determinism", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatSimCoreDeterminismTest::RunTest(const FString& Parameters)
+{
+	FCombatSimCore SimA;
+	FCombatSimCore SimB;
+	TestEqual("Same script, same state", CombatSimCoreTest::RunScript(SimA, 600), CombatSimCoreTest::RunScript(SimB, 600));
+
+	// Frame rate independence: 30 Hz and 144 Hz frames over one second both run 60 steps
+	FCombatSimCore Slow;
+	FCombatSimCore Fast;
+	int32 SlowSteps = 0;
+	int32 FastSteps = 0;
+	for (int32 Frame = 0; Frame < 30; ++Frame)
+	{
+		SlowSteps += Slow.Advance(1.0f / 30.0f);
+	}
+	for (int32 Frame = 0; Frame < 144; ++Frame)
+	{
+		FastSteps += Fast.Advance(1.0f / 144.0f);
+	}
+	TestTrue("30 Hz runs ~60 steps", FMath::Abs(SlowSteps - 60) <= 1);
+	TestTrue("144 Hz runs ~60 steps", FMath::Abs(FastSteps - 60) <= 1);
+	return true;
+}
+
+/**
+ * Test: Combat simulation core rules
+ * Verifies phase timing, hold freezing the windup, combo chaining and guard break recovery
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatSimCoreRulesTest, "KatanaCombat.SimCore.Rules", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatSimCoreRulesTest::RunTest(const FString& Parameters)
+{
+	FCombatSimCore Sim;
+	Sim.Config.FixedTimeStep = 0.1f;
+
+	FCombatSimAttackTiming Timing;
+	Timing.Windup = 0.15f;
+	Timing.Active = 0.12f;
+	Timing.Recovery = 0.12f;
+	const int32 Attack = Sim.AddAttack(Timing);
+	const int32 Fighter = Sim.AddFighter();
+
+	// Phases
+	TestTrue("Attack starts from idle", Sim.RequestAttack(Fighter, Attack));
+	TestEqual("Starts in windup", Sim.GetFighter(Fighter).Phase, EAttackPhase::Windup);
+	Sim.Step();
+	Sim.Step();
+	TestEqual("Active after windup", Sim.GetFighter(Fighter).Phase, EAttackPhase::Active);
+
+	// Combo buffer chains on recovery
+	TestTrue("Follow-up buffered mid-attack", Sim.RequestAttack(Fighter, Attack));
+	Sim.Step();
+	Sim.Step();
+	TestEqual("Follow-up started", Sim.GetFighter(Fighter).ComboCount, 2);
+	TestEqual("Follow-up in windup", Sim.GetFighter(Fighter).Phase, EAttackPhase::Windup);
+
+	// Hold freezes windup
+	Sim.SetHoldRequested(Fighter, true);
+	for (int32 i = 0; i < 5; ++i)
+	{
+		Sim.Step();
+	}
+	TestEqual("Holding state", Sim.GetFighter(Fighter).State, ECombatState::HoldingLightAttack);
+	TestEqual("Windup frozen while held", Sim.GetFighter(Fighter).Phase, EAttackPhase::Windup);
+	Sim.SetHoldRequested(Fighter, false);
+	Sim.Step();
+	TestEqual("Release resumes attacking", Sim.GetFighter(Fighter).State, ECombatState::Attacking);
+
+	// Guard break and recovery
+	TestTrue("Posture break", Sim.ApplyPostureDamage(Fighter, 1000.0f));
+	TestEqual("Guard broken", Sim.GetFighter(Fighter).State, ECombatState::GuardBroken);
+	TestEqual("Attack interrupted", Sim.GetFighter(Fighter).AttackIndex, static_cast<int32>(INDEX_NONE));
+	int32 StunSteps = 0;
+	while (Sim.GetFighter(Fighter).State == ECombatState::GuardBroken && StunSteps < 100)
+	{
+		Sim.Step();
+		++StunSteps;
+	}
+	TestTrue("Stun lasts the configured duration", FMath::Abs(StunSteps * Sim.Config.FixedTimeStep - Sim.Config.GuardBreakStunDuration) <= Sim.Config.FixedTimeStep);
+	TestEqual("Recovered to idle", Sim.GetFighter(Fighter).State, ECombatState::Idle);
+	TestTrue("Posture partially restored", FMath::IsNearlyEqual(Sim.GetFighter(Fighter).Posture, Sim.Config.MaxPosture * Sim.Config.GuardBreakRecoveryPercent, 1.0f));
+	return true;
+}
\ No newline at end of file
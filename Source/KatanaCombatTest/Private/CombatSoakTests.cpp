@@ -0,0 +1,395 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatComponentV2.h"
+#include "Core/WeaponComponent.h"
+#include "Core/HitReactionComponent.h"
+#include "Core/TargetingComponent.h"
+#include "Core/CombatTimerWheelSubsystem.h"
+#include "Core/ParryWindowSubsystem.h"
+#include "Core/HitStopSubsystem.h"
+#include "Core/TargetRegistrySubsystem.h"
+#include "Core/AIDefenseSubsystem.h"
+#include "Core/CombatTickManagerSubsystem.h"
+#include "Core/CombatImpactSubsystem.h"
+#include "Core/CombatCrowdSubsystem.h"
+#include "Core/LagCompensationSubsystem.h"
+#include "Core/MontageCheckpointCache.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/UObjectArray.h"
+
+/**
+ * Combat soak test
+ *
+ * Runs the scripted light-combo / heavy-hold / parry loop for simulated hours while enemies are
+ * destroyed and respawned, sampling outstanding state once per simulated minute: timer wheel
+ * timers, subsystem registrations, native delegate bindings, weapon HitActors, live UObjects and
+ * combat component memory. After a warm-up, any metric that keeps growing fails the test - these
+ * are the accumulations that show up as slow frame-time drift in long play sessions.
+ *
+ * Defaults to one simulated hour; pass -CombatSoakMinutes=N to change it.
+ */
+namespace CombatSoak
+{
+	constexpr int32 NumCharacters = 8;
+	constexpr float FrameDelta = 1.0f / 30.0f;
+	constexpr int32 FramesPerSample = 30 * 60;
+	constexpr int32 FramesPerRespawn = 30 * 20;
+	constexpr int32 WarmupSamples = 5;
+	constexpr int32 DefaultMinutes = 60;
+
+	struct FSample
+	{
+		int32 ActiveTimers = 0;
+		int32 Registrations = 0;
+		int32 HitActors = 0;
+		int64 DelegateBytes = 0;
+		int64 ComponentBytes = 0;
+		int32 LiveObjects = 0;
+		double FrameUs = 0.0;
+	};
+
+	/** Metric name, accessor and slack allowed over the warm-up peak */
+	struct FMetric
+	{
+		const TCHAR* Name;
+		int64 (*Get)(const FSample&);
+		int64 Slack;
+	};
+
+	const FMetric Metrics[] = {
+		{ TEXT("ActiveTimers"), [](const FSample& S) -> int64 { return S.ActiveTimers; }, NumCharacters },
+		{ TEXT("Registrations"), [](const FSample& S) -> int64 { return S.Registrations; }, 0 },
+		{ TEXT("HitActors"), [](const FSample& S) -> int64 { return S.HitActors; }, NumCharacters },
+		{ TEXT("DelegateBytes"), [](const FSample& S) -> int64 { return S.DelegateBytes; }, 256 },
+		{ TEXT("ComponentBytes"), [](const FSample& S) -> int64 { return S.ComponentBytes; }, 16 * 1024 },
+		{ TEXT("LiveObjects"), [](const FSample& S) -> int64 { return S.LiveObjects; }, 64 }
+	};
+
+	/** Scripted input for one character on one frame (3 s cycle, staggered per character) */
+	void DriveInput(ASamuraiCharacter* Character, int32 Frame, int32 CharacterIndex, bool bUseV2)
+	{
+		const int32 Cycle = (Frame + CharacterIndex * 11) % 90;
+
+		// 0..39: light combo taps, 40..69: heavy hold, 70..89: parry attempts
+		const bool bLightPress = Cycle < 40 && (Cycle % 8) == 0;
+		const bool bLightRelease = Cycle < 40 && (Cycle % 8) == 2;
+		const bool bHeavyPress = Cycle == 40;
+		const bool bHeavyRelease = Cycle == 65;
+		const bool bBlockPress = Cycle == 74;
+		const bool bBlockRelease = Cycle == 84;
+
+		if (bUseV2)
+		{
+			UCombatComponentV2* V2 = Character->CombatComponentV2;
+			if (bLightPress) V2->OnInputEvent(EInputType::LightAttack, EInputEventType::Press, EInputDirection::Forward);
+			if (bLightRelease) V2->OnInputEvent(EInputType::LightAttack, EInputEventType::Release, EInputDirection::Forward);
+			if (bHeavyPress) V2->OnInputEvent(EInputType::HeavyAttack, EInputEventType::Press);
+			if (bHeavyRelease) V2->OnInputEvent(EInputType::HeavyAttack, EInputEventType::Release);
+			if (bBlockPress) V2->OnInputEvent(EInputType::Block, EInputEventType::Press);
+			if (bBlockRelease) V2->OnInputEvent(EInputType::Block, EInputEventType::Release);
+		}
+		else
+		{
+			UCombatComponent* V1 = Character->CombatComponent;
+			if (bLightPress) V1->OnLightAttackPressed();
+			if (bLightRelease) V1->OnLightAttackReleased();
+			if (bHeavyPress) V1->OnHeavyAttackPressed();
+			if (bHeavyRelease) V1->OnHeavyAttackReleased();
+			if (bBlockPress) V1->OnBlockPressed();
+			if (bBlockRelease) V1->OnBlockReleased();
+		}
+
+		// Weapon traces follow the attack part of the cycle so HitActors is reset every swing
+		if (Cycle == 0 || Cycle == 40)
+		{
+			Character->WeaponComponent->EnableHitDetection();
+		}
+		else if (Cycle == 36 || Cycle == 68)
+		{
+			Character->WeaponComponent->DisableHitDetection();
+		}
+	}
+
+	ASamuraiCharacter* SpawnCharacter(UWorld* World, int32 Slot, bool bUseV2, UAttackData* LightChain, UAttackData* Heavy)
+	{
+		UCombatComponent* CombatComp = nullptr;
+		ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+		if (Character)
+		{
+			Character->SetActorLocation(FVector((Slot % 4) * 150.0f, (Slot / 4) * 150.0f, 0.0f));
+			Character->CombatSettings->bUseV2System = bUseV2;
+			Character->SelectCombatBackend();
+			Character->CombatSettings->AttackConfiguration->DefaultLightAttack = LightChain;
+			Character->CombatSettings->AttackConfiguration->DefaultHeavyAttack = Heavy;
+		}
+		return Character;
+	}
+
+	int64 GetComponentBytes(ASamuraiCharacter* Character)
+	{
+		int64 Bytes = 0;
+		const UActorComponent* Components[] = {
+			Character->CombatComponent, Character->CombatComponentV2, Character->WeaponComponent,
+			Character->HitReactionComponent, Character->TargetingComponent
+		};
+		for (const UActorComponent* Component : Components)
+		{
+			if (Component)
+			{
+				FArchiveCountMem CountMem(const_cast<UActorComponent*>(Component));
+				Bytes += CountMem.GetMax() + const_cast<UActorComponent*>(Component)->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+			}
+		}
+		return Bytes;
+	}
+
+	int64 GetDelegateBytes(ASamuraiCharacter* Character)
+	{
+		int64 Bytes = 0;
+		if (const UCombatComponent* V1 = Character->CombatComponent)
+		{
+			Bytes += V1->OnCombatStateChangedNative.GetAllocatedSize() + V1->OnPostureChangedNative.GetAllocatedSize()
+				+ V1->OnGuardBrokenNative.GetAllocatedSize() + V1->OnPerfectParryNative.GetAllocatedSize()
+				+ V1->OnPerfectEvadeNative.GetAllocatedSize() + V1->OnAttackHitNative.GetAllocatedSize();
+		}
+		if (const UCombatComponentV2* V2 = Character->CombatComponentV2)
+		{
+			Bytes += V2->OnPhaseChangedNative.GetAllocatedSize() + V2->OnMontageEventNative.GetAllocatedSize();
+		}
+		if (const UWeaponComponent* Weapon = Character->WeaponComponent)
+		{
+			Bytes += Weapon->OnWeaponHitNative.GetAllocatedSize();
+		}
+		if (const UHitReactionComponent* HitReaction = Character->HitReactionComponent)
+		{
+			Bytes += HitReaction->OnDamageReceivedNative.GetAllocatedSize();
+		}
+		return Bytes;
+	}
+
+	int32 GetRegistrations(UWorld* World)
+	{
+		int32 Count = 0;
+		if (const UParryWindowSubsystem* Parry = World->GetSubsystem<UParryWindowSubsystem>()) Count += Parry->GetOpenWindowCount();
+		if (const UHitStopSubsystem* HitStop = World->GetSubsystem<UHitStopSubsystem>()) Count += HitStop->GetNumActiveHitStops();
+		if (const UTargetRegistrySubsystem* Registry = World->GetSubsystem<UTargetRegistrySubsystem>()) Count += Registry->GetNumRegisteredTargets();
+		if (const UAIDefenseSubsystem* AIDefense = World->GetSubsystem<UAIDefenseSubsystem>()) Count += AIDefense->GetNumDefenders();
+		if (const UCombatTickManagerSubsystem* TickManager = World->GetSubsystem<UCombatTickManagerSubsystem>()) Count += TickManager->GetNumRegistered();
+		if (const UCombatImpactSubsystem* Impacts = World->GetSubsystem<UCombatImpactSubsystem>()) Count += Impacts->GetNumPendingImpacts();
+		if (const UCombatCrowdSubsystem* Crowd = World->GetSubsystem<UCombatCrowdSubsystem>()) Count += Crowd->GetNumAgents();
+		if (const ULagCompensationSubsystem* LagComp = World->GetSubsystem<ULagCompensationSubsystem>()) Count += LagComp->GetNumTrackedActors();
+		if (const UMontageCheckpointCache* Cache = World->GetSubsystem<UMontageCheckpointCache>()) Count += Cache->GetNumCachedMontages();
+		return Count;
+	}
+
+	FSample TakeSample(UWorld* World, const TArray<ASamuraiCharacter*>& Characters, double FrameUs)
+	{
+		// Destroyed enemies must be collected before objects are counted
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		FSample Sample;
+		Sample.FrameUs = FrameUs;
+		Sample.Registrations = GetRegistrations(World);
+		Sample.LiveObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+		if (const UCombatTimerWheelSubsystem* TimerWheel = World->GetSubsystem<UCombatTimerWheelSubsystem>())
+		{
+			Sample.ActiveTimers = TimerWheel->GetNumActiveTimers();
+		}
+
+		for (ASamuraiCharacter* Character : Characters)
+		{
+			Sample.HitActors += Character->WeaponComponent->GetHitActorCount();
+			Sample.DelegateBytes += GetDelegateBytes(Character);
+			Sample.ComponentBytes += GetComponentBytes(Character);
+		}
+		return Sample;
+	}
+
+	/** Run the soak and return one sample per simulated minute */
+	TArray<FSample> RunSoak(bool bUseV2, int32 Minutes)
+	{
+		UWorld* World = FCombatTestHelpers::CreateTestWorld();
+
+		UAttackData* LightChain = FCombatTestHelpers::CreateTestComboChain(4, EAttackType::Light);
+		UAttackData* Heavy = FCombatTestHelpers::CreateTestAttack(EAttackType::Heavy);
+
+		// Spawned characters only reference these through transient settings; keep them across GC
+		TArray<UObject*> RootedAssets = { LightChain, Heavy };
+		for (UAttackData* Attack = LightChain; Attack; Attack = Attack->NextComboAttack)
+		{
+			RootedAssets.AddUnique(Attack);
+		}
+		for (UObject* Asset : RootedAssets)
+		{
+			Asset->AddToRoot();
+		}
+
+		TArray<ASamuraiCharacter*> Characters;
+		for (int32 i = 0; i < NumCharacters; ++i)
+		{
+			if (ASamuraiCharacter* Character = SpawnCharacter(World, i, bUseV2, LightChain, Heavy))
+			{
+				Characters.Add(Character);
+			}
+		}
+
+		UParryWindowSubsystem* ParryWindows = World->GetSubsystem<UParryWindowSubsystem>();
+		UCombatTimerWheelSubsystem* TimerWheel = World->GetSubsystem<UCombatTimerWheelSubsystem>();
+
+		TArray<FSample> Samples;
+		double SampleUs = 0.0;
+		int32 NextRespawnSlot = 1;
+		const int32 NumFrames = Minutes * FramesPerSample;
+
+		for (int32 Frame = 0; Frame < NumFrames && Characters.Num() > 1; ++Frame)
+		{
+			const uint64 FrameStart = FPlatformTime::Cycles64();
+
+			for (int32 i = 0; i < Characters.Num(); ++i)
+			{
+				ASamuraiCharacter* Character = Characters[i];
+				DriveInput(Character, Frame, i, bUseV2);
+
+				UActorComponent* Combat = bUseV2 ? static_cast<UActorComponent*>(Character->CombatComponentV2) : Character->CombatComponent;
+				Combat->TickComponent(FrameDelta, LEVELTICK_All, &Combat->PrimaryComponentTick);
+				Character->WeaponComponent->TickComponent(FrameDelta, LEVELTICK_All, &Character->WeaponComponent->PrimaryComponentTick);
+				Character->TargetingComponent->FindTarget(EAttackDirection::Forward);
+			}
+
+			// Character 0 is the player; the neighbouring enemy opens a parry window over its block presses
+			if (ParryWindows)
+			{
+				const int32 Cycle = Frame % 90;
+				if (Cycle == 72)
+				{
+					ParryWindows->RegisterParryWindow(Characters[1]);
+				}
+				else if (Cycle == 86)
+				{
+					ParryWindows->UnregisterParryWindow(Characters[1]);
+				}
+			}
+
+			World->GetTimerManager().Tick(FrameDelta);
+			if (TimerWheel)
+			{
+				TimerWheel->Advance(FrameDelta);
+			}
+
+			SampleUs += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - FrameStart) * 1000.0;
+
+			// Replace one enemy mid-fight (never the player); its parry window and registrations must go with it
+			if ((Frame + 1) % FramesPerRespawn == 0)
+			{
+				const int32 Slot = NextRespawnSlot;
+				NextRespawnSlot = NextRespawnSlot + 1 < Characters.Num() ? NextRespawnSlot + 1 : 1;
+
+				if (ParryWindows)
+				{
+					ParryWindows->UnregisterParryWindow(Characters[Slot]);
+				}
+				Characters[Slot]->Destroy();
+
+				if (ASamuraiCharacter* Replacement = SpawnCharacter(World, Slot, bUseV2, LightChain, Heavy))
+				{
+					Characters[Slot] = Replacement;
+				}
+				else
+				{
+					Characters.RemoveAt(Slot);
+					NextRespawnSlot = 1;
+				}
+			}
+
+			if ((Frame + 1) % FramesPerSample == 0)
+			{
+				Samples.Add(TakeSample(World, Characters, SampleUs / FramesPerSample));
+				SampleUs = 0.0;
+			}
+		}
+
+		FCombatTestHelpers::DestroyTestWorld(World);
+
+		for (UObject* Asset : RootedAssets)
+		{
+			Asset->RemoveFromRoot();
+		}
+		return Samples;
+	}
+
+	/** Fail any metric whose last-quarter peak exceeds its warm-up peak (plus slack) */
+	void CheckForGrowth(FAutomationTestBase& Test, const TCHAR* Label, const TArray<FSample>& Samples)
+	{
+		if (!Test.TestTrue(FString::Printf(TEXT("%s: enough samples past warm-up"), Label), Samples.Num() > WarmupSamples * 2))
+		{
+			return;
+		}
+
+		const int32 TailStart = FMath::Max(WarmupSamples, Samples.Num() - Samples.Num() / 4);
+
+		for (const FMetric& Metric : Metrics)
+		{
+			int64 WarmupPeak = 0;
+			int64 TailPeak = 0;
+			FString Series;
+			for (int32 i = 0; i < Samples.Num(); ++i)
+			{
+				const int64 Value = Metric.Get(Samples[i]);
+				if (i < WarmupSamples)
+				{
+					WarmupPeak = FMath::Max(WarmupPeak, Value);
+				}
+				else if (i >= TailStart)
+				{
+					TailPeak = FMath::Max(TailPeak, Value);
+				}
+				Series += FString::Printf(TEXT("%s%lld"), i > 0 ? TEXT(",") : TEXT(""), Value);
+			}
+
+			Test.AddInfo(FString::Printf(TEXT("%s %s: %s"), Label, Metric.Name, *Series));
+			Test.TestTrue(FString::Printf(TEXT("%s %s does not grow (warm-up peak %lld, final peak %lld)"), Label, Metric.Name, WarmupPeak, TailPeak),
+				TailPeak <= WarmupPeak + Metric.Slack);
+		}
+
+		// Frame time is noisy on shared machines - report drift but leave the hard gate to the counters above
+		double WarmupUs = 0.0;
+		double TailUs = 0.0;
+		for (int32 i = 1; i < WarmupSamples; ++i)
+		{
+			WarmupUs += Samples[i].FrameUs / (WarmupSamples - 1);
+		}
+		for (int32 i = TailStart; i < Samples.Num(); ++i)
+		{
+			TailUs += Samples[i].FrameUs / (Samples.Num() - TailStart);
+		}
+
+		Test.AddInfo(FString::Printf(TEXT("%s frame: warm-up %.1f us, final %.1f us"), Label, WarmupUs, TailUs));
+		if (WarmupUs > 0.0 && TailUs > WarmupUs * 1.5)
+		{
+			Test.AddWarning(FString::Printf(TEXT("%s frame time drifted %.0f%% over the soak"), Label, (TailUs / WarmupUs - 1.0) * 100.0));
+		}
+	}
+
+	int32 GetSoakMinutes()
+	{
+		int32 Minutes = DefaultMinutes;
+		FParse::Value(FCommandLine::Get(), TEXT("CombatSoakMinutes="), Minutes);
+		return FMath::Max(Minutes, WarmupSamples * 2 + 1);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatSoakTest, "KatanaCombat.Stress.Soak", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+bool FCombatSoakTest::RunTest(const FString& Parameters)
+{
+	const int32 Minutes = CombatSoak::GetSoakMinutes();
+	AddInfo(FString::Printf(TEXT("Soaking %d simulated minutes with %d characters"), Minutes, CombatSoak::NumCharacters));
+
+	CombatSoak::CheckForGrowth(*this, TEXT("V1"), CombatSoak::RunSoak(false, Minutes));
+	CombatSoak::CheckForGrowth(*this, TEXT("V2"), CombatSoak::RunSoak(true, Minutes));
+
+	return true;
+}
\ No newline at end of file
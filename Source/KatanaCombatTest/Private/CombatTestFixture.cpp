@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestFixture.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+namespace CombatTestFixture
+{
+	/** Released characters wait here, spaced out, outside every test's query range */
+	const FVector ParkingOrigin(0.0f, 0.0f, -1000000.0f);
+	constexpr float ParkingSpacing = 1000.0f;
+
+	struct FSharedState
+	{
+		TWeakObjectPtr<UWorld> World;
+		TArray<TWeakObjectPtr<ASamuraiCharacter>> FreeCharacters;
+		int32 NumWorldsCreated = 0;
+		int32 NumCharactersSpawned = 0;
+		bool bInUse = false;
+	};
+
+	FSharedState& GetState()
+	{
+		static FSharedState State;
+		return State;
+	}
+
+	UWorld* GetOrCreateWorld()
+	{
+		FSharedState& State = GetState();
+		if (!State.World.IsValid())
+		{
+			State.FreeCharacters.Reset();
+			State.World = FCombatTestHelpers::CreateTestWorld();
+			++State.NumWorldsCreated;
+		}
+		return State.World.Get();
+	}
+
+	void Park(ASamuraiCharacter* Character, int32 SlotIndex)
+	{
+		Character->SetActorLocation(ParkingOrigin + FVector(ParkingSpacing * SlotIndex, 0.0f, 0.0f), false, nullptr, ETeleportType::ResetPhysics);
+		Character->SetActorEnableCollision(false);
+		Character->SetActorHiddenInGame(true);
+	}
+}
+
+FCombatTestFixture::FCombatTestFixture()
+{
+	CombatTestFixture::FSharedState& State = CombatTestFixture::GetState();
+	checkf(!State.bInUse, TEXT("FCombatTestFixture: one fixture at a time (nested test cases share the world)"));
+	State.bInUse = true;
+
+	CombatTestFixture::GetOrCreateWorld();
+}
+
+FCombatTestFixture::~FCombatTestFixture()
+{
+	CombatTestFixture::FSharedState& State = CombatTestFixture::GetState();
+
+	for (const TWeakObjectPtr<ASamuraiCharacter>& Character : Borrowed)
+	{
+		// Destroyed by the test: the pool spawns a replacement when needed
+		if (ASamuraiCharacter* PooledCharacter = Character.Get(); PooledCharacter && !PooledCharacter->IsActorBeingDestroyed())
+		{
+			ResetCharacter(PooledCharacter, FVector::ZeroVector);
+			CombatTestFixture::Park(PooledCharacter, State.FreeCharacters.Num());
+			State.FreeCharacters.Add(PooledCharacter);
+		}
+	}
+
+	State.bInUse = false;
+}
+
+UWorld* FCombatTestFixture::GetWorld() const
+{
+	return CombatTestFixture::GetOrCreateWorld();
+}
+
+ASamuraiCharacter* FCombatTestFixture::AcquireCharacter(UCombatComponent*& OutCombat, const FVector& Location)
+{
+	CombatTestFixture::FSharedState& State = CombatTestFixture::GetState();
+
+	ASamuraiCharacter* Character = nullptr;
+	while (!Character && State.FreeCharacters.Num() > 0)
+	{
+		Character = State.FreeCharacters.Pop(EAllowShrinking::No).Get();
+	}
+
+	if (!Character)
+	{
+		UCombatComponent* SpawnedCombat = nullptr;
+		Character = FCombatTestHelpers::CreateTestCharacterWithCombat(GetWorld(), SpawnedCombat);
+		++State.NumCharactersSpawned;
+	}
+
+	ResetCharacter(Character, Location);
+	Borrowed.Add(Character);
+
+	OutCombat = Character->CombatComponent;
+	return Character;
+}
+
+void FCombatTestFixture::ResetCharacter(ASamuraiCharacter* Character, const FVector& Location)
+{
+	if (!Character)
+	{
+		return;
+	}
+
+	// Fresh settings: a previous case may have edited its copy
+	Character->CombatSettings = FCombatTestHelpers::CreateTestSettings();
+
+	Character->SetActorEnableCollision(true);
+	Character->SetActorHiddenInGame(false);
+	Character->SetActorLocationAndRotation(Location, FRotator::ZeroRotator, false, nullptr, ETeleportType::ResetPhysics);
+	if (UCharacterMovementComponent* Movement = Character->GetCharacterMovement())
+	{
+		Movement->StopMovementImmediately();
+	}
+
+	if (Character->TargetingComponent)
+	{
+		Character->TargetingComponent->ClearCurrentTarget();
+		Character->TargetingComponent->ClearDuelTarget();
+	}
+
+	if (Character->CombatComponent)
+	{
+		Character->CombatComponent->ResetForTest();
+	}
+}
+
+void FCombatTestFixture::Shutdown()
+{
+	CombatTestFixture::FSharedState& State = CombatTestFixture::GetState();
+	if (UWorld* World = State.World.Get())
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+	}
+
+	State.World.Reset();
+	State.FreeCharacters.Reset();
+}
+
+int32 FCombatTestFixture::GetNumWorldsCreated()
+{
+	return CombatTestFixture::GetState().NumWorldsCreated;
+}
+
+int32 FCombatTestFixture::GetNumCharactersSpawned()
+{
+	return CombatTestFixture::GetState().NumCharactersSpawned;
+}
+
+int32 FCombatTestFixture::GetNumFreeCharacters()
+{
+	return CombatTestFixture::GetState().FreeCharacters.Num();
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatComponent.h"
+#include "Core/CombatTickManagerSubsystem.h"
+
+/**
+ * Test: Batched combat tick
+ * Verifies parallel batch evaluation matches per-character evaluation, and that a registered
+ * component gets its posture regen from the manager instead of its own tick
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatTickManagerTest, "KatanaCombat.CombatComponent.BatchedTick", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatTickManagerTest::RunTest(const FString& Parameters)
+{
+	// Pure evaluation
+	FCombatTickInput Input;
+	Input.Posture = 90.0f;
+	Input.MaxPosture = 100.0f;
+	Input.PostureRegenRate = 20.0f;
+
+	FCombatTickOutput Output;
+	UCombatTickManagerSubsystem::Evaluate(Input, 1.0f, Output);
+	TestEqual("Regen clamps to max posture", Output.Posture, 100.0f, 0.001f);
+	TestTrue("Posture changed", Output.bPostureChanged);
+
+	Input.Posture = 100.0f;
+	UCombatTickManagerSubsystem::Evaluate(Input, 1.0f, Output);
+	TestFalse("Full posture is left alone", Output.bPostureChanged);
+
+	// Parallel batch matches serial evaluation
+	TArray<FCombatTickInput> Inputs;
+	FRandomStream Stream(99);
+	for (int32 i = 0; i < 500; ++i)
+	{
+		FCombatTickInput& Entry = Inputs.AddDefaulted_GetRef();
+		Entry.MaxPosture = 100.0f;
+		Entry.Posture = Stream.FRandRange(0.0f, 100.0f);
+		Entry.PostureRegenRate = Stream.FRand() < 0.5f ? 0.0f : 30.0f;
+	}
+
+	TArray<FCombatTickOutput> Outputs;
+	UCombatTickManagerSubsystem::EvaluateBatch(Inputs, 1.0f / 60.0f, Outputs, 32);
+	TestEqual("One output per input", Outputs.Num(), Inputs.Num());
+	for (int32 i = 0; i < Inputs.Num(); ++i)
+	{
+		FCombatTickOutput Expected;
+		UCombatTickManagerSubsystem::Evaluate(Inputs[i], 1.0f / 60.0f, Expected);
+		if (Expected.Posture != Outputs[i].Posture || Expected.bPostureChanged != Outputs[i].bPostureChanged)
+		{
+			AddError(FString::Printf(TEXT("Batch entry %d differs from serial evaluation"), i));
+			break;
+		}
+	}
+
+	// Registered component
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* CombatComp = nullptr;
+	ASamuraiCharacter* TestCharacter = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+
+	UCombatTickManagerSubsystem* TickManager = World ? World->GetSubsystem<UCombatTickManagerSubsystem>() : nullptr;
+	if (!TestNotNull("CombatComponent should be created", CombatComp) || !TestNotNull("Tick manager should exist", TickManager))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	// Settings are assigned after BeginPlay in tests - wire up batched per-frame mode explicitly
+	CombatComp->CombatSettings = TestCharacter->CombatSettings;
+	CombatComp->bEventDrivenTick = false;
+	CombatComp->bBatchedTick = true;
+	CombatComp->CurrentPosture = 40.0f;
+	CombatComp->CurrentState = ECombatState::Idle;
+	TickManager->RegisterCombatComponent(CombatComp);
+
+	CombatComp->RefreshTickEnabled();
+	TestFalse("Batched component doesn't tick itself", CombatComp->IsComponentTickEnabled());
+
+	// Idle regen: 20/s
+	TickManager->Tick(0.5f);
+	TestEqual("Manager regenerates posture", CombatComp->CurrentPosture, 50.0f, 0.001f);
+
+	TickManager->UnregisterCombatComponent(CombatComp);
+	TestEqual("Unregistered", TickManager->GetNumRegistered(), 0);
+
+	// Cleanup
+	World->DestroyActor(TestCharacter);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Aggregated combat tick
+ * Verifies the character's combat components tick from its aggregated tick function instead of their own,
+ * and that a component with nothing to do is skipped
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatAggregatedTickTest, "KatanaCombat.CombatComponent.AggregatedTick", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatAggregatedTickTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* CombatComp = nullptr;
+	ASamuraiCharacter* TestCharacter = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+	if (!TestNotNull("CombatComponent should be created", CombatComp))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	TestTrue("Aggregated tick registered", TestCharacter->GetCombatAggregateTickFunction().IsTickFunctionRegistered());
+	TestTrue("Combat components aggregated", TestCharacter->GetNumAggregatedCombatTicks() >= 2);
+	TestFalse("CombatComponent tick taken over", CombatComp->PrimaryComponentTick.IsTickFunctionRegistered());
+	TestFalse("TargetingComponent tick taken over", TestCharacter->TargetingComponent->PrimaryComponentTick.IsTickFunctionRegistered());
+
+	// Settings are assigned after BeginPlay in tests - wire up per-frame posture explicitly
+	CombatComp->CombatSettings = TestCharacter->CombatSettings;
+	CombatComp->bEventDrivenTick = false;
+	CombatComp->bBatchedTick = false;
+	CombatComp->CurrentPosture = 40.0f;
+	CombatComp->CurrentState = ECombatState::Idle;
+	CombatComp->SetComponentTickEnabled(true);
+
+	TestCharacter->TickCombatComponents(0.5f, LEVELTICK_All);
+	TestTrue("Aggregated tick regenerates posture", CombatComp->CurrentPosture > 40.0f);
+	TestFalse("Tick function stays unregistered", CombatComp->PrimaryComponentTick.IsTickFunctionRegistered());
+
+	// Event-driven: the component disables its tick and is skipped from then on
+	CombatComp->bEventDrivenTick = true;
+	CombatComp->RefreshTickEnabled();
+	const float Posture = CombatComp->CurrentPosture;
+	TestCharacter->TickCombatComponents(0.5f, LEVELTICK_All);
+	TestEqual("Disabled component skipped", CombatComp->CurrentPosture, Posture);
+
+	// Cleanup
+	World->DestroyActor(TestCharacter);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatTimerWheelSubsystem.h"
+
+/**
+ * Test: Combat timer wheel scheduling
+ * Verifies window timers fire on time through the wheel, clear without firing,
+ * survive cascading down from higher levels, and that stale handles go inert
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatTimerWheelTest, "KatanaCombat.TimerWheel.Scheduling", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatTimerWheelTest::RunTest(const FString& Parameters)
+{
+	// Setup
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* Combat = nullptr;
+	ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	UCombatTimerWheelSubsystem* TimerWheel = World->GetSubsystem<UCombatTimerWheelSubsystem>();
+
+	if (!TestNotNull("Timer wheel exists", TimerWheel) || !TestNotNull("Character created", Character))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	// Short window - level 0
+	Combat->OpenCounterWindow(0.1f);
+	TestEqual("One pending timer", TimerWheel->GetNumActiveTimers(), 1);
+	TimerWheel->Advance(0.05f);
+	TestTrue("Window still open before expiry", Combat->IsInCounterWindow());
+	TimerWheel->Advance(0.06f);
+	TestFalse("Window closed by the wheel", Combat->IsInCounterWindow());
+	TestEqual("Fired timer released", TimerWheel->GetNumActiveTimers(), 0);
+
+	// Reopening replaces the pending timer instead of stacking
+	Combat->OpenCounterWindow(0.2f);
+	Combat->OpenCounterWindow(0.2f);
+	TestEqual("Reopen replaces the timer", TimerWheel->GetNumActiveTimers(), 1);
+
+	// Closing early clears without firing
+	Combat->CloseCounterWindow();
+	TestEqual("Cleared timer released", TimerWheel->GetNumActiveTimers(), 0);
+
+	// Long window - scheduled on a higher level and cascaded down
+	Combat->OpenParryWindow(5.0f);
+	for (int32 Frame = 0; Frame < 290; ++Frame)
+	{
+		TimerWheel->Advance(1.0f / 60.0f);
+	}
+	TestTrue("Long window open before expiry", Combat->IsInParryWindow());
+	for (int32 Frame = 0; Frame < 20; ++Frame)
+	{
+		TimerWheel->Advance(1.0f / 60.0f);
+	}
+	TestFalse("Long window closed after cascading", Combat->IsInParryWindow());
+
+	// Stale handles don't alias reused nodes
+	Combat->OpenCounterWindow(0.1f);
+	FCombatTimerHandle Stale;
+	Stale.Index = 0;
+	Stale.Serial = 0;
+	TestFalse("Stale handle inactive", TimerWheel->IsTimerActive(Stale));
+	TestFalse("Clearing a stale handle is a no-op", TimerWheel->ClearTimer(Stale));
+	TestEqual("Live timer untouched", TimerWheel->GetNumActiveTimers(), 1);
+
+	// Cleanup
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/CombatUIEventSubsystem.h"
+#include "Debug/CombatDebugDrawSubsystem.h"
+
+/**
+ * Test: UI event coalescing
+ * Verifies several health/stun changes in one frame produce a single update per actor,
+ * and that changes smaller than the quantization step are not emitted
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatUIEventCoalescingTest, "KatanaCombat.UI.EventCoalescing", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatUIEventCoalescingTest::RunTest(const FString& Parameters)
+{
+	// Setup
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* Combat = nullptr;
+	ACharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	UCombatUIEventSubsystem* UIEvents = World->GetSubsystem<UCombatUIEventSubsystem>();
+
+	if (!TestNotNull("UI event subsystem exists", UIEvents) || !TestNotNull("Character created", Character))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	UIEvents->QuantizationStep = 0.01f;
+	UIEvents->RegisterCombatComponent(Combat);
+
+	// First flush emits the initial state
+	UIEvents->Flush();
+
+	TArray<FCombatUIUpdate> Received;
+	UIEvents->OnCombatUIUpdateNative.AddWeakLambda(UIEvents, [&Received](const FCombatUIUpdate& Update)
+	{
+		Received.Add(Update);
+	});
+
+	// Nothing changed - nothing emitted
+	UIEvents->Flush();
+	TestEqual("No update without changes", Received.Num(), 0);
+
+	// Three health changes and a stun in one frame
+	UIEvents->NotifyHealthChanged(Character, 0.9f);
+	UIEvents->NotifyHealthChanged(Character, 0.8f);
+	UIEvents->NotifyHealthChanged(Character, 0.7f);
+	UIEvents->NotifyStunChanged(Character, true);
+	UIEvents->Flush();
+
+	if (TestEqual("One merged update", Received.Num(), 1))
+	{
+		TestTrue("Latest health wins", FMath::IsNearlyEqual(Received[0].HealthPercent, 0.7f));
+		TestTrue("Health flagged", Received[0].bHealthChanged);
+		TestTrue("Stun flagged", Received[0].bStunChanged && Received[0].bStunned);
+		TestFalse("Posture untouched", Received[0].bPostureChanged);
+	}
+
+	// Sub-step change is swallowed
+	Received.Reset();
+	UIEvents->NotifyHealthChanged(Character, 0.701f);
+	UIEvents->Flush();
+	TestEqual("Change below 1% not emitted", Received.Num(), 0);
+
+	// Stun released and re-applied in the same frame nets out
+	UIEvents->NotifyStunChanged(Character, false);
+	UIEvents->NotifyStunChanged(Character, true);
+	UIEvents->Flush();
+	TestEqual("Net-zero stun toggle not emitted", Received.Num(), 0);
+
+	// Cleanup
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
+
+/**
+ * Test: Debug draw budget and relevance
+ * Verifies queued primitives flush once per frame within the budget, selection filters owners,
+ * and cached labels only rebuild when their state hash changes
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatDebugDrawBudgetTest, "KatanaCombat.UI.DebugDrawBudget", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatDebugDrawBudgetTest::RunTest(const FString& Parameters)
+{
+	// Labels
+	FCombatDebugText Label;
+	int32 NumBuilds = 0;
+	auto Build = [&NumBuilds]() { ++NumBuilds; return FString::Printf(TEXT("Build %d"), NumBuilds); };
+
+	Label.Get(1, Build);
+	Label.Get(1, Build);
+	TestEqual("Unchanged state reuses the label", NumBuilds, 1);
+	TestEqual("Changed state rebuilds it", Label.Get(2, Build), FString(TEXT("Build 2")));
+
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* CombatA = nullptr;
+	UCombatComponent* CombatB = nullptr;
+	ACharacter* CharacterA = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatA);
+	ACharacter* CharacterB = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatB);
+	UCombatDebugDrawSubsystem* DebugDraw = UCombatDebugDrawSubsystem::Get(World);
+
+	if (!TestNotNull("Debug draw subsystem exists", DebugDraw) || !TestNotNull("Characters created", CharacterB))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	// Relevance (no local camera in the test world, so distance doesn't filter)
+	TestTrue("Everyone draws with nothing selected", DebugDraw->ShouldDraw(CharacterA) && DebugDraw->ShouldDraw(CharacterB));
+	DebugDraw->SetSelectedActor(CharacterA);
+	TestTrue("Selected actor draws", DebugDraw->ShouldDraw(CharacterA));
+	TestFalse("Others are skipped while one is selected", DebugDraw->ShouldDraw(CharacterB));
+	DebugDraw->SetSelectedActor(nullptr);
+
+	// Budget
+	DebugDraw->MaxPrimitivesPerFrame = 4;
+	for (int32 Index = 0; Index < 10; ++Index)
+	{
+		DebugDraw->AddLine(Index % 2 ? CharacterA : CharacterB, FVector::ZeroVector, FVector(0.0f, 0.0f, 100.0f * Index), FColor::White);
+	}
+	DebugDraw->AddString(CharacterA, FVector::ZeroVector, TEXT("Label"), FColor::White);
+	TestEqual("Primitives are queued, not drawn", DebugDraw->GetNumQueuedPrimitives(), 11);
+
+	DebugDraw->Tick(0.016f);
+	TestEqual("Flush draws up to the budget", DebugDraw->GetNumDrawnLastFrame(), 4);
+	TestEqual("The rest is dropped", DebugDraw->GetNumDroppedLastFrame(), 7);
+	TestEqual("Queue is empty after the flush", DebugDraw->GetNumQueuedPrimitives(), 0);
+
+	DebugDraw->Tick(0.016f);
+	TestEqual("Empty frame draws nothing", DebugDraw->GetNumDrawnLastFrame(), 0);
+
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,190 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "Core/HitStopSubsystem.h"
+#include "Core/CombatImpactSubsystem.h"
+#include "Core/CombatDamageAggregatorSubsystem.h"
+#include "Core/HitReactionComponent.h"
+#include "Data/CombatSettings.h"
+
+/**
+ * Test: Hit-stop batching
+ * Verifies overlapping hit-stops on one actor merge into a single dilation write per frame
+ * and that the actor's own dilation is restored afterwards
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitStopBatchingTest, "KatanaCombat.HitStop.Batching", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FHitStopBatchingTest::RunTest(const FString& Parameters)
+{
+	// Setup
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* Combat = nullptr;
+	ACharacter* Victim = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	UHitStopSubsystem* HitStop = World->GetSubsystem<UHitStopSubsystem>();
+
+	if (!TestNotNull("Hit-stop subsystem exists", HitStop) || !TestNotNull("Victim created", Victim))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	Victim->CustomTimeDilation = 0.5f;
+
+	// Five hits of a cleave in one frame
+	for (int32 Hit = 0; Hit < 5; ++Hit)
+	{
+		HitStop->RequestHitStop(Victim, 0.1f, 0.2f);
+	}
+	TestEqual("Requests don't write immediately", Victim->CustomTimeDilation, 0.5f);
+
+	HitStop->Tick(0.016f);
+	TestEqual("One merged stop", HitStop->GetNumActiveHitStops(), 1);
+	TestEqual("One write for five requests", HitStop->GetNumDilationWrites(), 1);
+	TestTrue("Dilation scales the actor's base", FMath::IsNearlyEqual(Victim->CustomTimeDilation, 0.1f));
+
+	// Unchanged next frame - no write
+	HitStop->Tick(0.016f);
+	TestEqual("No redundant write", HitStop->GetNumDilationWrites(), 1);
+
+	// Stronger overlapping request wins
+	HitStop->RequestHitStop(Victim, 0.05f, 0.1f);
+	HitStop->Tick(0.016f);
+	TestTrue("Strongest dilation wins", FMath::IsNearlyEqual(Victim->CustomTimeDilation, 0.05f));
+
+	HitStop->ClearAllHitStops();
+	TestTrue("Base dilation restored", FMath::IsNearlyEqual(Victim->CustomTimeDilation, 0.5f));
+	TestFalse("Actor no longer in hit-stop", HitStop->IsActorInHitStop(Victim));
+
+	// Cleanup
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
+
+/**
+ * Test: Impact effect lookup and batching
+ * Verifies surface / attack type resolution falls back correctly and queued impacts flush once per frame
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatImpactTest, "KatanaCombat.HitStop.ImpactEffects", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatImpactTest::RunTest(const FString& Parameters)
+{
+	UCombatSettings* Settings = NewObject<UCombatSettings>();
+
+	FCombatImpactEffect& Fallback = Settings->ImpactEffects.AddDefaulted_GetRef();
+	Fallback.AttackType = EAttackType::None;
+	FCombatImpactEffect& Heavy = Settings->ImpactEffects.AddDefaulted_GetRef();
+	Heavy.AttackType = EAttackType::Heavy;
+	FCombatImpactEffect& Metal = Settings->ImpactEffects.AddDefaulted_GetRef();
+	Metal.Surface = SurfaceType1;
+
+	TestEqual("Unlisted pair uses the fallback", UCombatImpactSubsystem::FindImpactEffect(Settings, SurfaceType_Default, EAttackType::Light), 0);
+	TestEqual("Attack type match wins on the default surface", UCombatImpactSubsystem::FindImpactEffect(Settings, SurfaceType_Default, EAttackType::Heavy), 1);
+	TestEqual("Surface match outweighs attack type", UCombatImpactSubsystem::FindImpactEffect(Settings, SurfaceType1, EAttackType::Heavy), 2);
+	TestEqual("No settings, no effect", UCombatImpactSubsystem::FindImpactEffect(nullptr, SurfaceType_Default, EAttackType::Light), static_cast<int32>(INDEX_NONE));
+
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatImpactSubsystem* Impacts = World ? World->GetSubsystem<UCombatImpactSubsystem>() : nullptr;
+	if (!TestNotNull("Impact subsystem exists", Impacts))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	// Three hits of a cleave in one frame (no assets assigned - nothing is spawned)
+	FHitResult Hit;
+	Hit.ImpactNormal = FVector::ForwardVector;
+	for (int32 Index = 0; Index < 3; ++Index)
+	{
+		Hit.ImpactPoint = FVector(100.0f * Index, 0.0f, 0.0f);
+		Impacts->QueueImpact(Hit, nullptr, Settings);
+	}
+	Impacts->QueueImpact(Hit, nullptr, nullptr);
+	TestEqual("Hits are queued, not emitted", Impacts->GetNumPendingImpacts(), 3);
+
+	Impacts->Tick(0.016f);
+	TestEqual("Frame flush empties the queue", Impacts->GetNumPendingImpacts(), 0);
+
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Per-frame damage aggregation
+ * Verifies hits in one frame return their damage immediately but broadcast once, summed, with the
+ * most severe hit chosen for the reaction, and that disabling aggregation restores per-hit events
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDamageAggregationTest, "KatanaCombat.HitStop.DamageAggregation", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDamageAggregationTest::RunTest(const FString& Parameters)
+{
+	// Setup
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* Combat = nullptr;
+	ACharacter* Victim = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	UHitReactionComponent* HitReaction = Victim ? Victim->FindComponentByClass<UHitReactionComponent>() : nullptr;
+	UCombatDamageAggregatorSubsystem* Aggregator = World ? World->GetSubsystem<UCombatDamageAggregatorSubsystem>() : nullptr;
+
+	if (!TestNotNull("Aggregator subsystem exists", Aggregator) || !TestNotNull("Hit reaction component exists", HitReaction))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	int32 NumDamageEvents = 0;
+	float BroadcastDamage = 0.0f;
+	HitReaction->OnDamageReceivedNative.AddLambda([&](const FHitReactionInfo& HitInfo)
+	{
+		++NumDamageEvents;
+		BroadcastDamage = HitInfo.Damage;
+	});
+
+	int32 NumAggregates = 0;
+	FCombatHitAggregate LastAggregate;
+	HitReaction->OnHitsAggregatedNative.AddLambda([&](const FCombatHitAggregate& Hits)
+	{
+		++NumAggregates;
+		LastAggregate = Hits;
+	});
+
+	// Three hits of a cleave in one frame, the middle one the most severe
+	const float Stuns[3] = { 0.1f, 0.5f, 0.2f };
+	float TotalReturned = 0.0f;
+	for (int32 Index = 0; Index < 3; ++Index)
+	{
+		FHitReactionInfo HitInfo;
+		HitInfo.Damage = 10.0f * (Index + 1);
+		HitInfo.StunDuration = Stuns[Index];
+		TotalReturned += HitReaction->ApplyDamage(HitInfo);
+	}
+	FHitReactionInfo Blocked;
+	HitReaction->RecordBlockedHit(Blocked, 15.0f);
+
+	TestTrue("Damage is returned per hit", FMath::IsNearlyEqual(TotalReturned, 60.0f));
+	TestEqual("Events wait for the flush", NumDamageEvents, 0);
+	TestEqual("Target queued once", Aggregator->GetNumPendingTargets(), 1);
+	TestEqual("Pending hits counted", HitReaction->GetPendingHits().NumHits, 3);
+
+	Aggregator->Tick(0.016f);
+	TestEqual("One damage event for the frame", NumDamageEvents, 1);
+	TestTrue("Damage event carries the summed damage", FMath::IsNearlyEqual(BroadcastDamage, 60.0f));
+	TestEqual("One aggregate event", NumAggregates, 1);
+	TestTrue("Strongest hit picked by stun", FMath::IsNearlyEqual(LastAggregate.StrongestHit.StunDuration, 0.5f));
+	TestEqual("Blocked hit counted", LastAggregate.NumBlockedHits, 1);
+	TestTrue("Blocked posture summed", FMath::IsNearlyEqual(LastAggregate.TotalPostureDamage, 15.0f));
+	TestTrue("Aggregate cleared", HitReaction->GetPendingHits().IsEmpty());
+	TestEqual("Queue empty", Aggregator->GetNumPendingTargets(), 0);
+
+	// Aggregation off - every hit broadcasts immediately
+	HitReaction->bAggregateHitsPerFrame = false;
+	FHitReactionInfo Immediate;
+	Immediate.Damage = 5.0f;
+	HitReaction->ApplyDamage(Immediate);
+	HitReaction->ApplyDamage(Immediate);
+	TestEqual("Unaggregated hits broadcast immediately", NumDamageEvents, 3);
+	TestEqual("Nothing queued", Aggregator->GetNumPendingTargets(), 0);
+
+	// Cleanup
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
\ No newline at end of file
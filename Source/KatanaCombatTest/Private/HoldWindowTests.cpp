@@ -1,6 +1,9 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CombatTestHelpers.h"
+#include "Utilities/MontageUtilityLibrary.h"
+#include "Core/CombatTimerWheelSubsystem.h"
+#include "Core/PlayRateEasingSubsystem.h"
 
 /**
  * Test: Hold Window Button State Detection
@@ -115,5 +118,209 @@ bool FHoldWindowTest::RunTest(const FString& Parameters)
 	World->DestroyActor(TestCharacter);
 	FCombatTestHelpers::DestroyTestWorld(World);
 
+	return true;
+}
+
+/**
+ * Test: Held input tracker
+ * Verifies press/release stamps drive held state, on-demand hold duration and window-start checks
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHeldInputTrackerTest, "KatanaCombat.CombatComponent.HeldInputs", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FHeldInputTrackerTest::RunTest(const FString& Parameters)
+{
+	FCombatHeldInputs Held;
+	TestFalse("Nothing held initially", Held.IsAnyHeld());
+
+	Held.Press(EInputType::LightAttack, 1.0f);
+	Held.Press(EInputType::HeavyAttack, 1.5f);
+	TestTrue("Light held", Held.IsHeld(EInputType::LightAttack));
+	TestEqual("One bit per input", Held.HeldMask, static_cast<uint8>(FCombatHeldInputs::Bit(EInputType::LightAttack) | FCombatHeldInputs::Bit(EInputType::HeavyAttack)));
+	TestEqual("Duration comes from the press stamp", Held.GetHoldDuration(EInputType::LightAttack, 1.75f), 0.75f, 0.0001f);
+	TestEqual("Unheld input has no duration", Held.GetHoldDuration(EInputType::Block, 1.75f), 0.0f);
+
+	// Window start checks
+	TestTrue("Held across the window start", Held.WasHeldAt(EInputType::LightAttack, 1.2f));
+	TestFalse("Pressed after the window start", Held.WasHeldAt(EInputType::HeavyAttack, 1.2f));
+
+	float PressTime = 0.0f;
+	TestTrue("Release matches the press", Held.Release(EInputType::LightAttack, 2.0f, &PressTime));
+	TestEqual("Release reports the press time", PressTime, 1.0f);
+	TestFalse("Released input is no longer held", Held.IsHeld(EInputType::LightAttack));
+	TestFalse("Second release has no press to match", Held.Release(EInputType::LightAttack, 2.1f));
+
+	bool bReleasedSince = false;
+	TestTrue("Released after the window start still counts", Held.WasHeldAt(EInputType::LightAttack, 1.9f, nullptr, &bReleasedSince));
+	TestTrue("...and reports the release", bReleasedSince);
+	TestFalse("Released before the window start", Held.WasHeldAt(EInputType::LightAttack, 2.05f));
+
+	Held.Reset();
+	TestFalse("Reset clears every bit", Held.IsAnyHeld());
+	TestFalse("Reset forgets the last release", Held.WasHeldAt(EInputType::LightAttack, 1.9f));
+
+	return true;
+}
+
+/**
+ * Test: Easing Lookup Tables
+ * Verifies LUT/batch easing matches the exact easing math and hits exact endpoints
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEasingLookupTableTest, "KatanaCombat.MontageUtility.EasingLookupTable", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FEasingLookupTableTest::RunTest(const FString& Parameters)
+{
+	const UEnum* EasingEnum = StaticEnum<EEasingType>();
+	const int32 NumTypes = EasingEnum->NumEnums() - 1; // Skip _MAX
+
+	TArray<float> Alphas;
+	for (int32 i = 0; i <= 100; ++i)
+	{
+		Alphas.Add(i / 100.0f);
+	}
+	TArray<float> Eased;
+	Eased.SetNumZeroed(Alphas.Num());
+
+	for (int32 Type = 0; Type < NumTypes; ++Type)
+	{
+		const EEasingType EasingType = static_cast<EEasingType>(EasingEnum->GetValueByIndex(Type));
+		const FString Name = EasingEnum->GetNameStringByIndex(Type);
+
+		TestEqual(FString::Printf(TEXT("%s: LUT start is exact"), *Name), UMontageUtilityLibrary::EvaluateEasingLUT(0.0f, EasingType), UMontageUtilityLibrary::EvaluateEasing(0.0f, EasingType));
+		TestEqual(FString::Printf(TEXT("%s: LUT end is exact"), *Name), UMontageUtilityLibrary::EvaluateEasingLUT(1.0f, EasingType), UMontageUtilityLibrary::EvaluateEasing(1.0f, EasingType));
+
+		UMontageUtilityLibrary::EvaluateEasingBatch(Alphas, EasingType, Eased);
+
+		float MaxError = 0.0f;
+		for (int32 i = 0; i < Alphas.Num(); ++i)
+		{
+			const float Exact = UMontageUtilityLibrary::EvaluateEasing(Alphas[i], EasingType);
+			MaxError = FMath::Max(MaxError, FMath::Abs(UMontageUtilityLibrary::EvaluateEasingLUT(Alphas[i], EasingType) - Exact));
+			MaxError = FMath::Max(MaxError, FMath::Abs(Eased[i] - Exact));
+		}
+		TestTrue(FString::Printf(TEXT("%s: LUT within 1e-3 of exact (max error %f)"), *Name, MaxError), MaxError < 1e-3f);
+	}
+
+	// Mixed-type batch (easing scheduler path) and out-of-range clamping
+	const TArray<float> MixedAlphas = { -1.0f, 0.5f, 2.0f };
+	const TArray<EEasingType> MixedTypes = { EEasingType::EaseInQuad, EEasingType::Linear, EEasingType::EaseOutExpo };
+	TArray<float> MixedOut;
+	MixedOut.SetNumZeroed(MixedAlphas.Num());
+	UMontageUtilityLibrary::EvaluateEasingBatch(MixedAlphas, MixedTypes, MixedOut);
+
+	TestEqual("Alpha below 0 clamps to curve start", MixedOut[0], 0.0f);
+	TestEqual("Linear midpoint", MixedOut[1], 0.5f, 1e-4f);
+	TestEqual("Alpha above 1 clamps to curve end", MixedOut[2], 1.0f);
+
+	return true;
+}
+
+/**
+ * Test: Charge Stage Table
+ * Verifies authored stages compile into a sorted table and a hold steps through them on timer wheel events
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChargeStageTableTest, "KatanaCombat.CombatComponent.ChargeStages", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FChargeStageTableTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* CombatComp = nullptr;
+	FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+	UCombatTimerWheelSubsystem* TimerWheel = World ? World->GetSubsystem<UCombatTimerWheelSubsystem>() : nullptr;
+
+	if (!TestNotNull("CombatComponent should be created", CombatComp) || !TestNotNull("Timer wheel should exist", TimerWheel))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	// Authored out of order
+	UAttackData* Attack = FCombatTestHelpers::CreateTestAttack(EAttackType::Heavy);
+	const float HoldTimes[] = { 1.0f, 0.0f, 0.5f };
+	const float Multipliers[] = { 3.0f, 1.0f, 2.0f };
+	for (int32 i = 0; i < 3; ++i)
+	{
+		FChargeStage& Stage = Attack->ChargeStages.AddDefaulted_GetRef();
+		Stage.HoldTime = HoldTimes[i];
+		Stage.DamageMultiplier = Multipliers[i];
+	}
+
+	const FChargeStageTable& Table = Attack->GetChargeStageTable();
+	TestEqual("Table should hold every stage", Table.Num(), 3);
+	TestEqual("Stages should be sorted by hold time", Table.GetStage(1)->HoldTime, 0.5f);
+	TestEqual("Before the first stage", Table.FindStage(-0.1f), INDEX_NONE);
+	TestEqual("On the first boundary", Table.FindStage(0.0f), 0);
+	TestEqual("Between stages", Table.FindStage(0.75f), 1);
+	TestEqual("Past the last stage", Table.FindStage(5.0f), 2);
+	TestTrue("No stage after the last", Table.GetNextStageTime(2) < 0.0f);
+
+	int32 NumStageEvents = 0;
+	CombatComp->OnChargeStageChangedNative.AddLambda([&NumStageEvents](int32, const FGameplayTag&) { ++NumStageEvents; });
+
+	// Hold started 0.6s ago: stages 0 and 1 are entered at once, stage 2 waits on one timer
+	const int32 TimersBefore = TimerWheel->GetNumActiveTimers();
+	CombatComp->BeginChargeStages(Attack, World->GetTimeSeconds() - 0.6f);
+	TestEqual("Passed stages should be entered immediately", CombatComp->GetChargeStage(), 1);
+	TestEqual("Each passed stage should be broadcast", NumStageEvents, 2);
+	TestEqual("Next boundary should be one timer", TimerWheel->GetNumActiveTimers(), TimersBefore + 1);
+	TestEqual("Active stage multiplier", CombatComp->GetChargeDamageMultiplier(), 2.0f);
+
+	// Release keeps the reached stage for the attack that follows
+	CombatComp->EndChargeStages();
+	TestEqual("Release should cancel the boundary timer", TimerWheel->GetNumActiveTimers(), TimersBefore);
+	TestEqual("Released stage", CombatComp->GetReleasedChargeStage(), 1);
+	TestEqual("Released stage multiplier", CombatComp->GetChargeDamageMultiplier(), 2.0f);
+
+	CombatComp->ClearChargeStages();
+	TestEqual("Cleared multiplier", CombatComp->GetChargeDamageMultiplier(), 1.0f);
+
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
+
+/**
+ * Test: Playrate arbitration
+ * Verifies the highest priority request wins, clearing falls back to the next one down (then 1.0),
+ * and the apply pass retires characters with nothing left requested
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlayRateArbiterTest, "KatanaCombat.HoldWindows.PlayRateArbiter", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPlayRateArbiterTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* CombatComp = nullptr;
+	ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+	UPlayRateEasingSubsystem* Arbiter = World->GetSubsystem<UPlayRateEasingSubsystem>();
+	if (!TestNotNull("Arbiter exists", Arbiter) || !TestNotNull("Character exists", Character))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	Arbiter->RequestPlayRate(Character, EPlayRatePriority::Default, 0.5f);
+	Arbiter->RequestPlayRate(Character, EPlayRatePriority::Hold, 0.2f);
+	TestEqual("Hold wins over default", Arbiter->GetPlayRate(Character), 0.2f);
+
+	Arbiter->RequestPlayRate(Character, EPlayRatePriority::HitStop, 0.0f);
+	TestEqual("Hit-stop wins over hold", Arbiter->GetPlayRate(Character), 0.0f);
+
+	// A later request at the same priority replaces the earlier one
+	Arbiter->RequestPlayRate(Character, EPlayRatePriority::Hold, 0.3f);
+	Arbiter->ClearPlayRate(Character, EPlayRatePriority::HitStop);
+	TestEqual("Falls back to the latest hold request", Arbiter->GetPlayRate(Character), 0.3f);
+	TestEqual("One arbiter per character", Arbiter->GetArbiterCount(), 1);
+
+	Arbiter->ClearPlayRates(Character);
+	TestEqual("Nothing requested restores normal speed", Arbiter->GetPlayRate(Character), 1.0f);
+
+	// No montage playing: nothing to write, and the restored character is retired
+	const int32 WritesBefore = Arbiter->GetNumPlayRateWrites();
+	Arbiter->FlushPlayRates();
+	TestEqual("No writes without an active montage", Arbiter->GetNumPlayRateWrites(), WritesBefore);
+	TestEqual("Restored characters are retired", Arbiter->GetArbiterCount(), 0);
+
+	Arbiter->RequestPlayRate(nullptr, EPlayRatePriority::Hold, 0.0f);
+	TestEqual("Requests without a character are ignored", Arbiter->GetArbiterCount(), 0);
+
+	FCombatTestHelpers::DestroyTestWorld(World);
 	return true;
 }
\ No newline at end of file
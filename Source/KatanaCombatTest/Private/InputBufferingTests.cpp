@@ -1,6 +1,21 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CombatTestHelpers.h"
+#include "ActionQueueTypes.h"
+#include "Core/CombatInputTimingSubsystem.h"
+#include "Core/ParryWindowSubsystem.h"
+#include "Utilities/MontageUtilityLibrary.h"
+#include "Debug/CombatEventRecorder.h"
+#include "Debug/CombatReplayComponent.h"
+#include "Debug/CombatCapture.h"
+#include "Debug/CombatTraceExport.h"
+#include "Debug/CombatTrace.h"
+#include "Debug/CombatStateTraceSubsystem.h"
+#include "Core/CombatComponentV2.h"
+#include "Misc/FileHelper.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
 
 /**
  * Test: Input Buffering (Hybrid Responsive + Snappy)
@@ -101,5 +116,899 @@ bool FInputBufferingTest::RunTest(const FString& Parameters)
 	World->DestroyActor(TestCharacter);
 	FCombatTestHelpers::DestroyTestWorld(World);
 
+	return true;
+}
+
+/**
+ * Test: V2 Action Queue Container
+ * Verifies ordered insert, O(1) removal by handle, stale handles and fixed capacity
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionQueueContainerTest, "KatanaCombat.CombatComponentV2.ActionQueue", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FActionQueueContainerTest::RunTest(const FString& Parameters)
+{
+	auto MakeEntry = [](EInputType InputType, float ScheduledTime)
+	{
+		FActionQueueEntry Entry(FQueuedInputAction(InputType, EInputEventType::Press, 0.0f), nullptr, EActionExecutionMode::Queued);
+		Entry.ScheduledTime = ScheduledTime;
+		return Entry;
+	};
+
+	FActionQueue Queue;
+	TestTrue("New queue should be empty", Queue.IsEmpty());
+
+	// Test 1: Entries are ordered by scheduled time on insert (stable for equal times)
+	const FActionQueueHandle Late = Queue.Push(MakeEntry(EInputType::LightAttack, 0.8f));
+	const FActionQueueHandle Early = Queue.Push(MakeEntry(EInputType::HeavyAttack, 0.2f));
+	const FActionQueueHandle LateTie = Queue.Push(MakeEntry(EInputType::Evade, 0.8f));
+
+	TestEqual("Queue should hold 3 entries", Queue.Num(), 3);
+	TestTrue("Earliest entry should be first", Queue.First() == Early);
+	TestTrue("Equal times should keep insertion order", Queue.Next(Late) == LateTie);
+	TestTrue("Latest insert at equal time should be last", Queue.Last() == LateTie);
+
+	TArray<EInputType> Order;
+	for (const FActionQueueEntry& Entry : Queue)
+	{
+		Order.Add(Entry.InputAction.InputType);
+	}
+	TestEqual("Range-for should visit 3 entries", Order.Num(), 3);
+	TestEqual("Range-for order [0]", Order[0], EInputType::HeavyAttack);
+	TestEqual("Range-for order [1]", Order[1], EInputType::LightAttack);
+	TestEqual("Range-for order [2]", Order[2], EInputType::Evade);
+
+	// Test 2: Removal by handle relinks neighbours and invalidates the handle
+	TestTrue("Remove should succeed for live handle", Queue.Remove(Late));
+	TestFalse("Removed handle should be stale", Queue.IsValidHandle(Late));
+	TestFalse("Removing twice should fail", Queue.Remove(Late));
+	TestTrue("Neighbours should be relinked", Queue.Next(Early) == LateTie);
+
+	// Test 3: Reused slot does not alias the stale handle
+	const FActionQueueHandle Reused = Queue.Push(MakeEntry(EInputType::Block, 0.5f));
+	TestTrue("Reused handle should be valid", Queue.IsValidHandle(Reused));
+	TestNull("Stale handle should not resolve", Queue.Find(Late));
+
+	// Test 4: Fixed capacity rejects overflow without allocating
+	Queue.Reset();
+	TestTrue("Reset should empty queue", Queue.IsEmpty());
+	TestFalse("Reset should invalidate handles", Queue.IsValidHandle(Reused));
+
+	for (int32 i = 0; i < FActionQueue::Capacity; ++i)
+	{
+		Queue.Push(MakeEntry(EInputType::LightAttack, static_cast<float>(i)));
+	}
+	TestTrue("Queue should report full", Queue.IsFull());
+	TestFalse("Push into full queue should return invalid handle",
+		Queue.Push(MakeEntry(EInputType::LightAttack, 0.0f)).IsValid());
+
+	return true;
+}
+
+/**
+ * Test: Input Latency Histogram
+ * Verifies percentile buckets and per-mode routing in FQueueStats
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionLatencyHistogramTest, "KatanaCombat.CombatComponentV2.LatencyHistogram", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FActionLatencyHistogramTest::RunTest(const FString& Parameters)
+{
+	FActionLatencyHistogram Histogram;
+	TestEqual("Empty histogram should report 0", Histogram.GetPercentileMs(0.5), 0.0);
+
+	// 90 samples at 10ms, 10 samples at 100ms
+	for (int32 i = 0; i < 90; ++i)
+	{
+		Histogram.Add(0.010);
+	}
+	for (int32 i = 0; i < 10; ++i)
+	{
+		Histogram.Add(0.100);
+	}
+
+	TestEqual("Sample count", static_cast<int32>(Histogram.SampleCount), 100);
+	const double P50 = Histogram.GetPercentileMs(0.50);
+	const double P99 = Histogram.GetPercentileMs(0.99);
+	TestTrue("p50 should land in the 10ms bucket (within one quarter-octave)", P50 >= 10.0 && P50 < 10.0 * 1.19);
+	TestTrue("p99 should land in the 100ms bucket, capped at max", P99 >= 90.0 && P99 <= 100.0);
+	TestEqual("Max should be exact", Histogram.MaxMs, 100.0);
+
+	// Out-of-range samples clamp into the edge buckets
+	Histogram.Add(-1.0);
+	Histogram.Add(60.0);
+	TestEqual("Outliers still counted", static_cast<int32>(Histogram.SampleCount), 102);
+
+	// Stats route by execution mode
+	FQueueStats Stats;
+	Stats.GetLatency(EActionExecutionMode::Immediate).RecordExecute(0.005);
+	Stats.GetLatency(EActionExecutionMode::Queued).RecordFirstFrame(0.050);
+	TestEqual("Immediate execute sample", Stats.ImmediateLatency.InputToExecute.SampleCount, 1);
+	TestEqual("Queued execute untouched", Stats.QueuedLatency.InputToExecute.SampleCount, 0);
+	TestEqual("Queued first-frame sample", Stats.QueuedLatency.InputToFirstFrame.SampleCount, 1);
+
+	Stats.Reset();
+	TestEqual("Reset clears latency", Stats.ImmediateLatency.InputToExecute.SampleCount, 0);
+
+	return true;
+}
+
+/**
+ * Test: Combat Event Recorder
+ * Verifies the ring keeps the newest events in order and filters by owner
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatEventRecorderTest, "KatanaCombat.CombatComponentV2.EventRecorder", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatEventRecorderTest::RunTest(const FString& Parameters)
+{
+	FCombatEventRecorder& Recorder = FCombatEventRecorder::Get();
+	const bool bWasEnabled = Recorder.IsEnabled();
+	Recorder.SetEnabled(true);
+
+	// Fake owner id that no live object uses in this test
+	const uint32 TestOwner = 0x7FFFFFF0u;
+	const int32 NumWritten = FCombatEventRecorder::Capacity + 32;
+	for (int32 i = 0; i < NumWritten; ++i)
+	{
+		FCombatRecordedEvent Event;
+		Event.OwnerId = TestOwner;
+		Event.Type = ECombatRecordedEventType::Queue;
+		Event.Value = static_cast<float>(i);
+		Recorder.Record(Event);
+	}
+
+	TArray<FCombatRecordedEvent> Events;
+	Recorder.Snapshot(Events, 8, TestOwner);
+	TestEqual("Snapshot should honour MaxEvents", Events.Num(), 8);
+	if (Events.Num() == 8)
+	{
+		TestEqual("Newest event should be last", Events.Last().Value, static_cast<float>(NumWritten - 1));
+		TestEqual("Events should be oldest first", Events[0].Value, static_cast<float>(NumWritten - 8));
+	}
+
+	// Full ring: oldest entries were overwritten
+	Recorder.Snapshot(Events, FCombatEventRecorder::Capacity, TestOwner);
+	TestTrue("Ring should never return more than its capacity", Events.Num() <= static_cast<int32>(FCombatEventRecorder::Capacity));
+	TestTrue("Overwritten events should be gone", Events.Num() == 0 || Events[0].Value >= 32.0f);
+
+	Recorder.Snapshot(Events, 8, TestOwner + 1);
+	TestEqual("Owner filter should drop other owners", Events.Num(), 0);
+
+	// Disabled recorder ignores writes
+	const uint64 Before = Recorder.GetNumRecorded();
+	Recorder.SetEnabled(false);
+	Recorder.Record(FCombatRecordedEvent());
+	TestEqual("Disabled recorder should not advance", Recorder.GetNumRecorded(), Before);
+
+	Recorder.SetEnabled(bWasEnabled);
+	return true;
+}
+
+/**
+ * Test: Combat Replay Stream
+ * Verifies captures split into inputs/expected events and comparisons find the first divergence
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatReplayStreamTest, "KatanaCombat.CombatComponentV2.ReplayStream", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatReplayStreamTest::RunTest(const FString& Parameters)
+{
+	const uint32 Owner = 42;
+	auto MakeEvent = [Owner](ECombatRecordedEventType Type, uint8 Arg0, uint8 Arg1, uint64 Cycle, uint32 EventOwner = 42)
+	{
+		FCombatRecordedEvent Event;
+		Event.Type = Type;
+		Event.Arg0 = Arg0;
+		Event.Arg1 = Arg1;
+		Event.Cycle = Cycle;
+		Event.OwnerId = EventOwner;
+		return Event;
+	};
+
+	TArray<FCombatRecordedEvent> Events;
+	Events.Add(MakeEvent(ECombatRecordedEventType::Phase, 0, 1, 50));                    // Before first input - ignored
+	Events.Add(MakeEvent(ECombatRecordedEventType::Input, static_cast<uint8>(EInputType::LightAttack), static_cast<uint8>(EInputEventType::Press), 100));
+	Events.Add(MakeEvent(ECombatRecordedEventType::Queue, 0, static_cast<uint8>(EInputType::LightAttack), 110));
+	Events.Add(MakeEvent(ECombatRecordedEventType::Input, static_cast<uint8>(EInputType::HeavyAttack), 0, 120, 7)); // Other owner
+	Events.Add(MakeEvent(ECombatRecordedEventType::Phase, 0, 1, 130));
+	Events.Add(MakeEvent(ECombatRecordedEventType::Hit, 0, 0, 140));                      // Not compared
+	Events[1].Arg3 = static_cast<uint8>(EInputDirection::Forward);
+
+	const FCombatReplayStream Stream = FCombatReplayStream::FromEvents(Events, Owner);
+	TestEqual("One input for this owner", Stream.Inputs.Num(), 1);
+	TestEqual("Queue + phase expected", Stream.Expected.Num(), 2);
+	if (Stream.Inputs.Num() == 1)
+	{
+		TestEqual("First input starts the stream", Stream.Inputs[0].Time, 0.0f);
+		TestTrue("Direction preserved", Stream.Inputs[0].Direction == EInputDirection::Forward);
+	}
+
+	// Identical output matches
+	FCombatReplayResult Result = FCombatReplayResult::Compare(Stream.Expected, Stream.Expected);
+	TestTrue("Identical streams should match", Result.bMatched);
+
+	// Divergent phase is reported at its index
+	TArray<FCombatReplayExpectedEvent> Actual = Stream.Expected;
+	Actual[1].Arg1 = 3;
+	Result = FCombatReplayResult::Compare(Stream.Expected, Actual);
+	TestFalse("Divergent stream should not match", Result.bMatched);
+	TestEqual("Mismatch index", Result.FirstMismatchIndex, 1);
+
+	// Extra events are a mismatch too
+	Actual = Stream.Expected;
+	Actual.Add(Actual[0]);
+	Result = FCombatReplayResult::Compare(Stream.Expected, Actual);
+	TestFalse("Extra events should not match", Result.bMatched);
+	TestEqual("Mismatch at first extra event", Result.FirstMismatchIndex, 2);
+
+	// File round trip
+	const FString Path = FPaths::ProjectSavedDir() / TEXT("Automation") / TEXT("CombatReplayStreamTest.kcreplay");
+	FCombatReplayStream Loaded;
+	TestTrue("Save replay", Stream.SaveToFile(Path));
+	TestTrue("Load replay", Loaded.LoadFromFile(Path));
+	TestEqual("Round trip inputs", Loaded.Inputs.Num(), Stream.Inputs.Num());
+	TestTrue("Round trip expected", FCombatReplayResult::Compare(Stream.Expected, Loaded.Expected).bMatched);
+	IFileManager::Get().Delete(*Path);
+
+	return true;
+}
+
+/**
+ * Test: V2 Action Queue hot/cold storage
+ * Verifies hot fields mirror pushed entries and stay in sync with the full entry through the setters
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActionQueueHotColdTest, "KatanaCombat.CombatComponentV2.ActionQueueHotCold", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FActionQueueHotColdTest::RunTest(const FString& Parameters)
+{
+	FActionQueue Queue;
+
+	FActionQueueEntry Entry(FQueuedInputAction(EInputType::HeavyAttack, EInputEventType::Press, 0.0f), nullptr, EActionExecutionMode::Queued, 7);
+	Entry.ScheduledTime = 0.4f;
+	Entry.TargetPhase = EAttackPhase::Recovery;
+	const FActionQueueHandle Handle = Queue.Push(Entry);
+	Queue.Push(FActionQueueEntry(FQueuedInputAction(EInputType::LightAttack, EInputEventType::Press, 0.0f), nullptr, EActionExecutionMode::Queued));
+
+	const FActionQueueHotEntry& Hot = Queue.GetHot(Handle);
+	TestEqual("Hot time mirrors entry", Hot.ScheduledTime, 0.4f);
+	TestEqual("Hot priority mirrors entry", static_cast<int32>(Hot.Priority), 7);
+	TestEqual("Hot phase mirrors entry", Hot.TargetPhase, EAttackPhase::Recovery);
+	TestEqual("Both entries pending", Queue.CountInState(EActionState::Pending), 2);
+
+	Queue.SetState(Handle, EActionState::Executing);
+	TestEqual("Hot state updated", Queue.GetHot(Handle).State, EActionState::Executing);
+	TestEqual("Cold state updated", Queue.Get(Handle).State, EActionState::Executing);
+	TestEqual("One entry still pending", Queue.CountInState(EActionState::Pending), 1);
+
+	Queue.SetScheduledTime(Handle, 0.9f);
+	TestEqual("Cold time updated", Queue.Get(Handle).ScheduledTime, 0.9f);
+
+	Queue.Remove(Handle);
+	TestEqual("Removed entry no longer counted", Queue.CountInState(EActionState::Executing), 0);
+
+	return true;
+}
+
+/**
+ * Test: Sub-frame input timing
+ * Verifies platform timestamps map back into the current frame, stale key events are ignored,
+ * and a parry window closed after the press still counts for it
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSubFrameInputTimingTest, "KatanaCombat.CombatComponentV2.SubFrameInputTiming", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSubFrameInputTimingTest::RunTest(const FString& Parameters)
+{
+	// Frame started at platform time 100.0, world time 10.0, 33ms frame
+	TestEqual("Event 10ms before the frame maps 10ms back", UCombatInputTimingSubsystem::MapPlatformTimeToWorldTime(99.99, 100.0, 10.0f, 0.033f, 1.0f), 9.99f, 0.0001f);
+	TestEqual("Old events clamp to one frame back", UCombatInputTimingSubsystem::MapPlatformTimeToWorldTime(99.5, 100.0, 10.0f, 0.033f, 1.0f), 9.967f, 0.0001f);
+	TestEqual("Events after the frame started map to now", UCombatInputTimingSubsystem::MapPlatformTimeToWorldTime(100.01, 100.0, 10.0f, 0.033f, 1.0f), 10.0f, 0.0001f);
+	TestEqual("Time dilation scales the offset", UCombatInputTimingSubsystem::MapPlatformTimeToWorldTime(99.99, 100.0, 10.0f, 0.033f, 0.5f), 9.995f, 0.0001f);
+	TestEqual("Unknown time is now", UCombatInputTimingSubsystem::MapPlatformTimeToWorldTime(0.0, 100.0, 10.0f, 0.033f, 1.0f), 10.0f);
+
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatInputTimingSubsystem* InputTiming = World ? World->GetSubsystem<UCombatInputTimingSubsystem>() : nullptr;
+	UParryWindowSubsystem* ParrySubsystem = World ? World->GetSubsystem<UParryWindowSubsystem>() : nullptr;
+	if (!TestNotNull("Input timing subsystem should exist", InputTiming) || !TestNotNull("Parry subsystem should exist", ParrySubsystem))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	// Latest event among the mapped keys, presses and releases separately
+	const double Now = FPlatformTime::Seconds();
+	InputTiming->RecordKeyEvent(EKeys::LeftMouseButton, true, Now - 0.02);
+	InputTiming->RecordKeyEvent(EKeys::Gamepad_FaceButton_Left, true, Now - 0.01);
+	InputTiming->RecordKeyEvent(EKeys::LeftMouseButton, false, Now - 0.005);
+	InputTiming->RecordKeyEvent(EKeys::Q, true, Now - 10.0);
+
+	const TArray<FKey> AttackKeys = { EKeys::LeftMouseButton, EKeys::Gamepad_FaceButton_Left };
+	TestEqual("Latest press among mapped keys", InputTiming->GetLatestKeyEventTime(AttackKeys, true), Now - 0.01);
+	TestEqual("Releases tracked separately", InputTiming->GetLatestKeyEventTime(AttackKeys, false), Now - 0.005);
+	TestEqual("Stale events are ignored", InputTiming->GetLatestKeyEventTime(TArray<FKey>{ EKeys::Q }, true), 0.0);
+
+	// Parry window that closed after the press (same world time - the press was processed late)
+	ASamuraiCharacter* Attacker = World->SpawnActor<ASamuraiCharacter>();
+	ASamuraiCharacter* Defender = World->SpawnActor<ASamuraiCharacter>();
+	Attacker->SetActorLocation(FVector(100.0f, 0.0f, 0.0f));
+
+	const float PressTime = World->GetTimeSeconds();
+	ParrySubsystem->RegisterParryWindow(Attacker);
+	ParrySubsystem->UnregisterParryWindow(Attacker);
+	TestNull("Closed window isn't found for a press now", ParrySubsystem->FindParryableAttacker(Defender, 500.0f));
+	TestEqual("Closed window is found for a press before the close", ParrySubsystem->FindParryableAttacker(Defender, 500.0f, PressTime), static_cast<AActor*>(Attacker));
+	TestTrue("Window was open at the press", ParrySubsystem->WasParryWindowOpenAt(Attacker, PressTime));
+	TestFalse("Window wasn't open after the close", ParrySubsystem->WasParryWindowOpenAt(Attacker, World->GetTimeSeconds() + 0.01f));
+
+	// Cleanup
+	World->DestroyActor(Attacker);
+	World->DestroyActor(Defender);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Directional input sample
+ * Verifies one sample derives camera-relative direction, 4/8-way buckets and facing-relative direction,
+ * and that the character's sample drops the stick once movement input stops arriving
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDirectionalInputSampleTest, "KatanaCombat.CombatComponent.DirectionalInputSample", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDirectionalInputSampleTest::RunTest(const FString& Parameters)
+{
+	// Inside the deadzone: magnitude only
+	const FCombatDirectionalInput Idle = FCombatDirectionalInput::Build(FVector2D(0.1f, 0.1f), FRotator::ZeroRotator, FVector::ForwardVector, FVector::RightVector);
+	TestFalse("Deadzone input has no direction", Idle.HasDirection());
+	TestTrue("Deadzone input has no world direction", Idle.WorldDirection.IsZero());
+	TestEqual("Deadzone input keeps its magnitude", Idle.Magnitude, FVector2D(0.1f, 0.1f).Size(), 0.0001f);
+
+	// Stick right with the camera facing the character's left: world direction is the character's forward
+	const FCombatDirectionalInput Sample = FCombatDirectionalInput::Build(FVector2D(1.0f, 0.0f), FRotator(0.0f, -90.0f, 0.0f), FVector::ForwardVector, FVector::RightVector);
+	TestTrue("Camera-relative world direction", Sample.WorldDirection.Equals(FVector::ForwardVector, 0.001f));
+	TestEqual("8-way bucket is camera space", Sample.Direction8, EInputDirection::Right);
+	TestEqual("4-way bucket is camera space", Sample.Direction4, EAttackDirection::Right);
+	TestEqual("Facing bucket is relative to the character", Sample.FacingDirection, EAttackDirection::Forward);
+
+	// Bucket helpers agree with the library wrappers
+	TestEqual("Diagonal 8-way", CombatHelpers::VectorToInputDirection(FVector2D(0.7f, 0.7f), FCombatDirectionalInput::DeadZone), EInputDirection::ForwardRight);
+	TestEqual("Library 4-way uses the shared cones", UMontageUtilityLibrary::GetDirectionFromInput(FVector2D(-0.9f, 0.3f), 0.2f), EAttackDirection::Left);
+	TestEqual("Backward yaw", CombatHelpers::YawToAttackDirection(170.0f), EAttackDirection::Backward);
+
+	// Character sample: fresh this frame, stale once input stops
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	ASamuraiCharacter* Character = World ? World->SpawnActor<ASamuraiCharacter>() : nullptr;
+	if (!TestNotNull("Character should spawn", Character))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	Character->RecordMovementInput(FVector2D(0.0f, 1.0f));
+	TestEqual("Recorded input is sampled", Character->GetDirectionalInput().Direction8, EInputDirection::Forward);
+	TestEqual("Sample is stamped with the frame", Character->GetDirectionalInput().FrameNumber, GFrameCounter);
+
+	GFrameCounter += 2;
+	TestFalse("Input not refreshed for a frame is released", Character->GetDirectionalInput().HasDirection());
+
+	// Cleanup
+	World->DestroyActor(Character);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Combat Capture file
+ * Verifies streamed captures round-trip through the memory-mapped reader, stay compact and survive truncation
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatCaptureFileTest, "KatanaCombat.CombatComponentV2.CaptureFile", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatCaptureFileTest::RunTest(const FString& Parameters)
+{
+	FCombatEventRecorder& Recorder = FCombatEventRecorder::Get();
+	const bool bWasEnabled = Recorder.IsEnabled();
+	Recorder.SetEnabled(true);
+
+	const FString Path = FPaths::ProjectSavedDir() / TEXT("Automation") / TEXT("CombatCaptureFileTest.kcap");
+	FCombatCaptureWriter Writer;
+	TestTrue("Start capture", Writer.Start(Path));
+
+	// Fake owner ids that no live object uses in this test (resolve as "#id")
+	const uint32 OwnerA = 0x7FFFFFE0u;
+	const uint32 OwnerB = 0x7FFFFFE1u;
+	const uint64 BaseCycle = FPlatformTime::Cycles64();
+	const int32 NumPerOwner = 500;
+	for (int32 i = 0; i < NumPerOwner * 2; ++i)
+	{
+		FCombatRecordedEvent Event;
+		Event.Cycle = BaseCycle + static_cast<uint64>(i * 0.005 / FPlatformTime::GetSecondsPerCycle64());
+		Event.OwnerId = (i & 1) ? OwnerB : OwnerA;
+		Event.Type = (i % 3 == 0) ? ECombatRecordedEventType::Input : ECombatRecordedEventType::Phase;
+		Event.Arg0 = static_cast<uint8>(i % 7);
+		Event.Arg1 = static_cast<uint8>(i % 5);
+		Event.Value = (i % 4 == 0) ? static_cast<float>(i) * 0.5f : 0.0f;
+		Recorder.Record(Event);
+
+		// Drain every few events like the per-frame ticker would, so the ring never laps
+		if (i % 64 == 0)
+		{
+			Writer.Drain();
+		}
+	}
+	Writer.Stop();
+	TestFalse("Stopped", Writer.IsCapturing());
+
+	FCombatCaptureReader Reader;
+	TestTrue("Open capture", Reader.Open(Path));
+	TestEqual("Header magic", Reader.GetHeader().Magic, CombatCapture::Magic);
+	TestEqual("Nothing lost", Reader.GetNumLostEvents(), static_cast<uint64>(0));
+
+	const uint32 IndexA = Reader.FindName(FString::Printf(TEXT("#%u"), OwnerA));
+	TestTrue("Owner in name table", IndexA != 0);
+
+	TArray<FCombatRecordedEvent> Events;
+	Reader.ReadEvents(Events, IndexA);
+	TestEqual("All owner events read back", Events.Num(), NumPerOwner);
+	if (Events.Num() == NumPerOwner)
+	{
+		bool bOrdered = true;
+		bool bPayload = true;
+		for (int32 i = 0; i < Events.Num(); ++i)
+		{
+			const int32 Source = i * 2;
+			bOrdered &= i == 0 || Events[i].Cycle >= Events[i - 1].Cycle;
+			bPayload &= Events[i].Arg0 == Source % 7 && Events[i].Arg1 == Source % 5
+				&& Events[i].Value == ((Source % 4 == 0) ? Source * 0.5f : 0.0f);
+		}
+		TestTrue("Times stay ordered", bOrdered);
+		TestTrue("Args and values round trip", bPayload);
+
+		const double Seconds = FPlatformTime::ToSeconds64(Events.Last().Cycle - Events[0].Cycle);
+		TestTrue("Relative time preserved (to the microsecond)", FMath::IsNearlyEqual(Seconds, (NumPerOwner * 2 - 2) * 0.005, 0.0001));
+	}
+
+	// Compact: well under the in-memory event size
+	const int64 FileSize = IFileManager::Get().FileSize(*Path);
+	TestTrue("Under 12 bytes per event", FileSize < static_cast<int64>(sizeof(FCombatCaptureHeader)) + Reader.GetNumEvents() * 12);
+
+	// Replay streams build straight from capture events
+	const FCombatReplayStream Stream = FCombatReplayStream::FromEvents(Events, IndexA);
+	TestTrue("Replay stream from capture has inputs", Stream.Inputs.Num() > 0);
+	Reader.Close();
+
+	// A capture cut short mid-chunk still opens and keeps only complete chunks
+	TArray<uint8> Bytes;
+	FFileHelper::LoadFileToArray(Bytes, *Path);
+	const FString TruncatedPath = FPaths::ProjectSavedDir() / TEXT("Automation") / TEXT("CombatCaptureFileTest_Truncated.kcap");
+	Bytes.SetNum(Bytes.Num() - 3);
+	FFileHelper::SaveArrayToFile(Bytes, *TruncatedPath);
+
+	FCombatCaptureReader Truncated;
+	TestTrue("Truncated capture opens", Truncated.Open(TruncatedPath));
+	TestTrue("Truncated capture drops the partial chunk", Truncated.GetNumEvents() < NumPerOwner * 2);
+	Truncated.Close();
+
+	IFileManager::Get().Delete(*Path);
+	IFileManager::Get().Delete(*TruncatedPath);
+	Recorder.SetEnabled(bWasEnabled);
+	return true;
+}
+
+/**
+ * Test: Replay streams from a capture
+ * Verifies a field capture splits into one input stream per owner that pressed anything, in name table order
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatCaptureReplayStreamsTest, "KatanaCombat.CombatComponentV2.CaptureReplayStreams", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatCaptureReplayStreamsTest::RunTest(const FString& Parameters)
+{
+	FCombatEventRecorder& Recorder = FCombatEventRecorder::Get();
+	const bool bWasEnabled = Recorder.IsEnabled();
+	Recorder.SetEnabled(true);
+
+	const FString Path = FPaths::ProjectSavedDir() / TEXT("Automation") / TEXT("CombatCaptureReplayStreamsTest.kcap");
+	FCombatCaptureWriter Writer;
+	TestTrue("Start capture", Writer.Start(Path));
+
+	// Fake owners: two fighters pressing buttons and a third that only changes phase (an NPC, a prop)
+	const uint32 OwnerA = 0x7FFFFFD0u;
+	const uint32 OwnerB = 0x7FFFFFD1u;
+	const uint32 OwnerC = 0x7FFFFFD2u;
+	const uint64 BaseCycle = FPlatformTime::Cycles64();
+	auto RecordEvent = [&Recorder, BaseCycle](uint32 Owner, ECombatRecordedEventType Type, EInputType InputType, EInputEventType EventType, double Seconds)
+	{
+		FCombatRecordedEvent Event;
+		Event.Cycle = BaseCycle + static_cast<uint64>(Seconds / FPlatformTime::GetSecondsPerCycle64());
+		Event.OwnerId = Owner;
+		Event.Type = Type;
+		Event.Arg0 = static_cast<uint8>(InputType);
+		Event.Arg1 = static_cast<uint8>(EventType);
+		Recorder.Record(Event);
+	};
+
+	RecordEvent(OwnerC, ECombatRecordedEventType::Phase, EInputType::None, EInputEventType::Press, 0.0);
+	RecordEvent(OwnerB, ECombatRecordedEventType::Input, EInputType::Block, EInputEventType::Press, 0.1);
+	RecordEvent(OwnerA, ECombatRecordedEventType::Input, EInputType::LightAttack, EInputEventType::Press, 0.2);
+	RecordEvent(OwnerA, ECombatRecordedEventType::Phase, EInputType::None, EInputEventType::Press, 0.25);
+	RecordEvent(OwnerA, ECombatRecordedEventType::Input, EInputType::LightAttack, EInputEventType::Release, 0.3);
+	RecordEvent(OwnerB, ECombatRecordedEventType::Input, EInputType::Block, EInputEventType::Release, 0.6);
+	RecordEvent(OwnerA, ECombatRecordedEventType::Input, EInputType::HeavyAttack, EInputEventType::Press, 0.7);
+	RecordEvent(OwnerC, ECombatRecordedEventType::Phase, EInputType::None, EInputEventType::Press, 0.8);
+	Writer.Stop();
+
+	FCombatCaptureReader Reader;
+	TestTrue("Open capture", Reader.Open(Path));
+
+	TArray<FCombatReplayStream> Streams;
+	TArray<FString> OwnerNames;
+	TestEqual("One stream per owner with inputs", FCombatReplayStream::FromCapture(Reader, Streams, &OwnerNames), 2);
+	TestEqual("Owner names match streams", OwnerNames.Num(), Streams.Num());
+	if (Streams.Num() == 2 && OwnerNames.Num() == 2)
+	{
+		// B pressed first, so it was named first
+		TestEqual("First stream owner", OwnerNames[0], FString::Printf(TEXT("#%u"), OwnerB));
+		TestEqual("Second stream owner", OwnerNames[1], FString::Printf(TEXT("#%u"), OwnerA));
+		TestEqual("First stream inputs", Streams[0].Inputs.Num(), 2);
+		TestEqual("Second stream inputs", Streams[1].Inputs.Num(), 3);
+		TestTrue("Stream time starts at the owner's first input", FMath::IsNearlyEqual(Streams[1].Duration, 0.5f, 0.001f));
+		TestTrue("Input types preserved", Streams[1].Inputs.Last().InputType == EInputType::HeavyAttack);
+	}
+	Reader.Close();
+
+	IFileManager::Get().Delete(*Path);
+	Recorder.SetEnabled(bWasEnabled);
+	return true;
+}
+
+/**
+ * Test: Telemetry stream
+ * Verifies a capture streamed to a sink decodes incrementally, whatever sizes the bytes arrive in
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatTelemetryStreamTest, "KatanaCombat.CombatComponentV2.TelemetryStream", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatTelemetryStreamTest::RunTest(const FString& Parameters)
+{
+	FCombatEventRecorder& Recorder = FCombatEventRecorder::Get();
+	const bool bWasEnabled = Recorder.IsEnabled();
+	Recorder.SetEnabled(true);
+
+	// Sink runs on the writer's background pipe
+	FCriticalSection BytesLock;
+	TArray<uint8> Bytes;
+	int32 NumSinkCalls = 0;
+
+	FCombatCaptureWriter Writer;
+	TestTrue("Start stream", Writer.StartStream([&](const uint8* Data, int32 NumBytes)
+	{
+		FScopeLock Lock(&BytesLock);
+		Bytes.Append(Data, NumBytes);
+		++NumSinkCalls;
+	}, TEXT("test sink"), 0.0));
+
+	const uint32 Owner = 0x7FFFFFE4u;
+	const uint64 BaseCycle = FPlatformTime::Cycles64();
+	const int32 NumEvents = 300;
+	for (int32 i = 0; i < NumEvents; ++i)
+	{
+		FCombatRecordedEvent Event;
+		Event.Cycle = BaseCycle + static_cast<uint64>(i * 0.01 / FPlatformTime::GetSecondsPerCycle64());
+		Event.OwnerId = Owner;
+		Event.Type = ECombatRecordedEventType::Window;
+		Event.Arg0 = static_cast<uint8>(i % 5);
+		Event.Arg1 = static_cast<uint8>(i & 1);
+		Event.Value = i * 0.25f;
+		Recorder.Record(Event);
+
+		// Flushing every batch sends many small chunks, like a live viewer sees
+		if (i % 32 == 0)
+		{
+			Writer.Drain();
+			Writer.Flush();
+		}
+	}
+	Writer.Stop();
+	TestTrue("Header and several batches sent", NumSinkCalls > 2);
+	TestEqual("Nothing left queued", Writer.GetNumBytesQueued(), static_cast<int64>(0));
+
+	// Feed in awkward sizes so chunk headers and payloads split across reads
+	FCombatCaptureStreamDecoder Decoder;
+	TArray<FCombatRecordedEvent> Decoded;
+	for (int32 Offset = 0; Offset < Bytes.Num(); Offset += 7)
+	{
+		TestTrue("Stream decodes", Decoder.Feed(Bytes.GetData() + Offset, FMath::Min(7, Bytes.Num() - Offset), [&Decoded](const FCombatRecordedEvent& Event)
+		{
+			Decoded.Add(Event);
+		}));
+	}
+
+	TestTrue("Header read", Decoder.HasHeader());
+	TestEqual("Every event decoded", Decoded.Num(), NumEvents);
+	if (Decoded.Num() == NumEvents)
+	{
+		TestEqual("Owner resolves through the streamed name table", Decoder.GetName(Decoded[0].OwnerId), FString::Printf(TEXT("#%u"), Owner));
+
+		bool bPayload = true;
+		for (int32 i = 0; i < NumEvents; ++i)
+		{
+			bPayload &= Decoded[i].Type == ECombatRecordedEventType::Window && Decoded[i].Arg0 == i % 5
+				&& Decoded[i].Arg1 == (i & 1) && Decoded[i].Value == i * 0.25f;
+		}
+		TestTrue("Payload round trips", bPayload);
+		TestTrue("Relative time preserved", FMath::IsNearlyEqual(FPlatformTime::ToSeconds64(Decoded.Last().Cycle - Decoded[0].Cycle), (NumEvents - 1) * 0.01, 0.0001));
+	}
+
+	// Anything that isn't a capture is rejected rather than decoded as garbage
+	FCombatCaptureStreamDecoder Garbage;
+	const TArray<uint8> NotACapture = { 'G', 'E', 'T', ' ', '/', ' ', 'H', 'T', 'T', 'P', '/', '1', '.', '1', '\r', '\n', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	TestFalse("Non-capture stream rejected", Garbage.Feed(NotACapture.GetData(), NotACapture.Num(), [](const FCombatRecordedEvent&) {}));
+
+	Recorder.SetEnabled(bWasEnabled);
+	return true;
+}
+
+/**
+ * Test: Chrome trace export
+ * Verifies recorded inputs, queue lifetimes, phases, windows and hits become spans and instants on named per-owner lanes
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatTraceExportTest, "KatanaCombat.CombatComponentV2.TraceExport", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatTraceExportTest::RunTest(const FString& Parameters)
+{
+	const uint32 Owner = 0x7FFFFFE2u;
+	const uint32 Victim = 0x7FFFFFE3u;
+	const uint64 BaseCycle = FPlatformTime::Cycles64();
+	const uint64 Step = static_cast<uint64>(0.01 / FPlatformTime::GetSecondsPerCycle64());
+
+	TArray<FCombatRecordedEvent> Events;
+	auto AddEvent = [&Events, Owner, BaseCycle, Step](int32 Tick, ECombatRecordedEventType Type, uint8 Arg0, uint8 Arg1, uint32 Subject = 0)
+	{
+		FCombatRecordedEvent& Event = Events.AddDefaulted_GetRef();
+		Event.Cycle = BaseCycle + Tick * Step;
+		Event.OwnerId = Owner;
+		Event.SubjectId = Subject;
+		Event.Type = Type;
+		Event.Arg0 = Arg0;
+		Event.Arg1 = Arg1;
+	};
+
+	const uint8 Light = static_cast<uint8>(EInputType::LightAttack);
+	AddEvent(0, ECombatRecordedEventType::Input, Light, static_cast<uint8>(EInputEventType::Press));
+	AddEvent(1, ECombatRecordedEventType::Queue, static_cast<uint8>(CombatTrace::EQueueEvent::Queued), Light);
+	AddEvent(1, ECombatRecordedEventType::Phase, static_cast<uint8>(EAttackPhase::None), static_cast<uint8>(EAttackPhase::Windup));
+	AddEvent(2, ECombatRecordedEventType::Window, static_cast<uint8>(EActionWindowType::Combo), 1);
+	AddEvent(3, ECombatRecordedEventType::Hit, 0, 0, Victim);
+	AddEvent(4, ECombatRecordedEventType::Window, static_cast<uint8>(EActionWindowType::Combo), 0);
+	AddEvent(5, ECombatRecordedEventType::Queue, static_cast<uint8>(CombatTrace::EQueueEvent::Executed), Light);
+	AddEvent(6, ECombatRecordedEventType::Input, Light, static_cast<uint8>(EInputEventType::Release));
+	AddEvent(7, ECombatRecordedEventType::Phase, static_cast<uint8>(EAttackPhase::Windup), static_cast<uint8>(EAttackPhase::Recovery));
+
+	const FString Path = FPaths::ProjectSavedDir() / TEXT("Automation") / TEXT("CombatTraceExportTest.json");
+	FCombatTraceEventWriter Writer;
+	TestTrue("Open trace", Writer.Open(Path, BaseCycle));
+	for (const FCombatRecordedEvent& Event : Events)
+	{
+		Writer.AddEvent(Event);
+	}
+	Writer.Close();
+
+	// 1 process + 5 lane names, 2 async spans (4 records), 2 phases, 1 window, 1 hit
+	TestEqual("Trace event count", Writer.GetNumTraceEvents(), 14);
+
+	FString Json;
+	TestTrue("Trace written", FFileHelper::LoadFileToString(Json, *Path));
+	TestTrue("Trace event array", Json.StartsWith(TEXT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[")));
+	TestTrue("Array closed", Json.TrimEnd().EndsWith(TEXT("]}")));
+	TestFalse("No trailing comma", Json.Contains(TEXT(",\n]")));
+	TestTrue("Owner is a named process", Json.Contains(FString::Printf(TEXT("\"name\":\"process_name\",\"args\":{\"name\":\"#%u\"}"), Owner)));
+	TestTrue("Window lane named", Json.Contains(TEXT("\"args\":{\"name\":\"Combo Window\"}")));
+	TestTrue("Windup phase span in microseconds", Json.Contains(TEXT("\"ts\":10000,\"dur\":60000,\"cat\":\"Phase\",\"name\":\"Windup\"")));
+	TestTrue("Combo window span", Json.Contains(TEXT("\"ts\":20000,\"dur\":20000,\"cat\":\"Window\"")));
+	TestTrue("Queue lifetime ends executed", Json.Contains(TEXT("\"ph\":\"e\",\"pid\":1,\"tid\":2,\"ts\":50000,\"cat\":\"Queue\",\"name\":\"LightAttack (Executed)\"")));
+	TestTrue("Hit instant", Json.Contains(FString::Printf(TEXT("\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":4,\"ts\":30000,\"cat\":\"Hit\",\"name\":\"Hit #%u\""), Victim)));
+
+	IFileManager::Get().Delete(*Path);
+	return true;
+}
+
+/**
+ * Test: Combat state trace sample
+ * Verifies the Rewind Debugger sample packs the V2 queue in scheduled order and only active checkpoints
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatStateTraceSampleTest, "KatanaCombat.CombatComponentV2.StateTraceSample", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatStateTraceSampleTest::RunTest(const FString& Parameters)
+{
+	UCombatComponentV2* CombatV2 = NewObject<UCombatComponentV2>(GetTransientPackage());
+
+	// Pushed out of order: the sample follows scheduled time, not insertion
+	FActionQueueEntry Heavy(FQueuedInputAction(EInputType::HeavyAttack, EInputEventType::Press, 0.0f), nullptr, EActionExecutionMode::Queued);
+	Heavy.ScheduledTime = 0.5f;
+	const FActionQueueHandle HeavyHandle = CombatV2->ActionQueue.Push(Heavy);
+
+	FActionQueueEntry Light(FQueuedInputAction(EInputType::LightAttack, EInputEventType::Press, 0.0f), nullptr, EActionExecutionMode::Immediate);
+	Light.ScheduledTime = 0.1f;
+	CombatV2->ActionQueue.Push(Light);
+	CombatV2->ActionQueue.SetState(HeavyHandle, EActionState::Executing);
+
+	FTimerCheckpoint Combo(EActionWindowType::Combo, 0.2f, 0.3f);
+	Combo.bActive = true;
+	CombatV2->Checkpoints.Add(Combo);
+	CombatV2->Checkpoints.Add(FTimerCheckpoint(EActionWindowType::Recovery, 0.8f, 0.0f));
+
+	CombatTrace::FCombatStateSample Sample;
+	UCombatStateTraceSubsystem::MakeSample(nullptr, CombatV2, Sample);
+
+	TestEqual("Phase comes from the V2 component", Sample.Phase, CombatV2->GetCurrentPhase());
+	TestEqual("Only the active checkpoint is flagged", Sample.ActiveWindows, static_cast<uint8>(1u << static_cast<uint8>(EActionWindowType::Combo)));
+
+	if (TestEqual("Both queued actions are sampled", Sample.Queue.Num(), 2))
+	{
+		TestEqual("Light first, pending", Sample.Queue[0], static_cast<uint8>(static_cast<uint8>(EInputType::LightAttack) | (static_cast<uint8>(EActionState::Pending) << 4)));
+		TestEqual("Heavy second, executing", Sample.Queue[1], static_cast<uint8>(static_cast<uint8>(EInputType::HeavyAttack) | (static_cast<uint8>(EActionState::Executing) << 4)));
+	}
+
+	// Unchanged state compares equal, so the subsystem sends nothing for it
+	CombatTrace::FCombatStateSample Again;
+	UCombatStateTraceSubsystem::MakeSample(nullptr, CombatV2, Again);
+	TestTrue("Resampling unchanged state matches", Again == Sample);
+
+	CombatV2->Checkpoints[1].bActive = true;
+	UCombatStateTraceSubsystem::MakeSample(nullptr, CombatV2, Again);
+	TestTrue("Opening a checkpoint changes the sample", Again != Sample);
+
+	return true;
+}
+
+/**
+ * Test: V2 batched input submission
+ * Verifies a batch is grouped by component with each component's inputs oldest first (ties keep
+ * submission order), and that commands for destroyed or V2-disabled components are dropped
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputBatchTest, "KatanaCombat.CombatComponentV2.InputBatch", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FInputBatchTest::RunTest(const FString& Parameters)
+{
+	UCombatComponentV2* First = NewObject<UCombatComponentV2>(GetTransientPackage());
+	UCombatComponentV2* Second = NewObject<UCombatComponentV2>(GetTransientPackage());
+
+	auto MakeCommand = [](UCombatComponentV2* Component, EInputType InputType, double PlatformTime)
+	{
+		FCombatInputCommand Command;
+		Command.Component = Component;
+		Command.InputType = InputType;
+		Command.PlatformTime = PlatformTime;
+		return Command;
+	};
+
+	TArray<FCombatInputCommand> Commands;
+	Commands.Add(MakeCommand(Second, EInputType::LightAttack, 2.0));
+	Commands.Add(MakeCommand(First, EInputType::HeavyAttack, 3.0));
+	Commands.Add(MakeCommand(Second, EInputType::Evade, 1.0));
+	Commands.Add(MakeCommand(First, EInputType::LightAttack, 3.0));
+	Commands.Add(MakeCommand(First, EInputType::Block, 1.0));
+
+	UCombatComponentV2::SortInputBatch(Commands);
+
+	// Each component's inputs are contiguous and in time order
+	for (int32 Index = 1; Index < Commands.Num(); ++Index)
+	{
+		if (Commands[Index].Component == Commands[Index - 1].Component)
+		{
+			TestTrue("Oldest first within a component", Commands[Index - 1].PlatformTime <= Commands[Index].PlatformTime);
+		}
+	}
+	int32 NumRuns = 1;
+	for (int32 Index = 1; Index < Commands.Num(); ++Index)
+	{
+		NumRuns += Commands[Index].Component != Commands[Index - 1].Component ? 1 : 0;
+	}
+	TestEqual("One run per component", NumRuns, 2);
+
+	// Equal times keep the order they were submitted in
+	const int32 HeavyIndex = Commands.IndexOfByPredicate([](const FCombatInputCommand& Command) { return Command.InputType == EInputType::HeavyAttack; });
+	const int32 LightIndex = Commands.IndexOfByPredicate([First](const FCombatInputCommand& Command) { return Command.Component == First && Command.InputType == EInputType::LightAttack; });
+	TestTrue("Stable on ties", HeavyIndex < LightIndex);
+
+	// No settings, no world: nothing is dispatched
+	TestEqual("Unconfigured components are dropped", UCombatComponentV2::SubmitInputBatch(Commands), 0);
+
+	Commands.Add(MakeCommand(nullptr, EInputType::LightAttack, 0.0));
+	TestEqual("Missing components are dropped", UCombatComponentV2::SubmitInputBatch(Commands), 0);
+
+	return true;
+}
+
+/**
+ * Test: V2 hot state block
+ * Verifies the packed state starts idle, the component accessors read from it, and it stays small
+ * enough that readers pulling the whole block touch a single cache line
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatV2HotStateTest, "KatanaCombat.CombatComponentV2.HotState", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatV2HotStateTest::RunTest(const FString& Parameters)
+{
+	TestTrue("Hot state fits in 16 bytes", sizeof(FCombatV2HotState) <= 16);
+
+	UCombatComponentV2* CombatV2 = NewObject<UCombatComponentV2>(GetTransientPackage());
+	const FCombatV2HotState& HotState = CombatV2->GetHotState();
+
+	TestEqual("Starts with no phase", HotState.CurrentPhase, EAttackPhase::None);
+	TestEqual("Starts with no attack input", HotState.CurrentAttackInputType, EInputType::None);
+	TestEqual("Starts with no direction", HotState.LastDirectionalInput, EInputDirection::None);
+	TestFalse("Combo window closed", static_cast<bool>(HotState.bComboWindowActive));
+	TestFalse("Movement enabled", static_cast<bool>(HotState.bMovementCurrentlyDisabled));
+	TestFalse("Not blending", static_cast<bool>(HotState.bInComboBlend));
+	TestFalse("Not a directional follow-up", static_cast<bool>(HotState.bCurrentAttackIsDirectionalFollowUp));
+
+	// Accessors are views of the same block
+	TestEqual("Phase accessor", CombatV2->GetCurrentPhase(), HotState.CurrentPhase);
+	TestEqual("Combo window accessor", CombatV2->IsInComboWindow(), static_cast<bool>(HotState.bComboWindowActive));
+	TestEqual("Direction accessor", CombatV2->GetLastDirectionalInput(), HotState.LastDirectionalInput);
+
+	return true;
+}
+
+/**
+ * Test: Latched input stage
+ * Verifies local player inputs are held until the stage that runs between the controller and the mesh,
+ * and go straight through once the stage has run this frame or nobody is controlling the character
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLatchedInputStageTest, "KatanaCombat.CombatComponentV2.LatchedInputStage", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FLatchedInputStageTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* Combat = nullptr;
+	ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	if (!TestNotNull("Character should be created", Character))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	Character->CombatSettings->bUseV2System = true;
+	Character->SelectCombatBackend();
+
+	const FCombatInputLatchTickFunction& LatchTick = Character->GetInputLatchTickFunction();
+	const bool bMeshWaitsOnLatch = Character->GetMesh()->PrimaryComponentTick.GetPrerequisites().ContainsByPredicate([&LatchTick](const FTickPrerequisite& Prerequisite)
+	{
+		return Prerequisite.PrerequisiteTickFunction == &LatchTick;
+	});
+	TestTrue("Mesh tick waits on the latched stage", bMeshWaitsOnLatch);
+	TestFalse("Stage idle without a player controller", Character->IsInputLatchActive());
+
+	// Uncontrolled: nothing to wait for
+	Character->LatchCombatInput(EInputType::LightAttack, EInputEventType::Press, EInputDirection::Forward, 0.0);
+	TestEqual("Input goes straight through without the stage", Character->GetNumLatchedInputs(), 0);
+
+	APlayerController* PlayerController = World->SpawnActor<APlayerController>();
+	PlayerController->Possess(Character);
+	TestTrue("Stage runs for a local player", Character->IsInputLatchActive());
+	const bool bLatchWaitsOnController = LatchTick.GetPrerequisites().ContainsByPredicate([PlayerController](const FTickPrerequisite& Prerequisite)
+	{
+		return Prerequisite.PrerequisiteTickFunction == &PlayerController->PrimaryActorTick;
+	});
+	TestTrue("Stage waits on the controller's input processing", bLatchWaitsOnController);
+
+	GFrameCounter += 1;
+	Character->LatchCombatInput(EInputType::LightAttack, EInputEventType::Release, EInputDirection::Forward, 0.0);
+	Character->LatchCombatInput(EInputType::HeavyAttack, EInputEventType::Press, EInputDirection::None, 0.0);
+	TestEqual("Inputs held for the stage", Character->GetNumLatchedInputs(), 2);
+
+	Character->ProcessLatchedInputs();
+	TestEqual("Stage drains the held inputs", Character->GetNumLatchedInputs(), 0);
+
+	Character->LatchCombatInput(EInputType::HeavyAttack, EInputEventType::Release, EInputDirection::None, 0.0);
+	TestEqual("Input after this frame's stage goes straight through", Character->GetNumLatchedInputs(), 0);
+
+	// Held inputs don't outlive the controller
+	GFrameCounter += 1;
+	Character->LatchCombatInput(EInputType::Block, EInputEventType::Press, EInputDirection::None, 0.0);
+	PlayerController->UnPossess();
+	TestFalse("Stage idle once unpossessed", Character->IsInputLatchActive());
+	TestEqual("Unpossessing dispatches the held inputs", Character->GetNumLatchedInputs(), 0);
+
+	// Cleanup
+	World->DestroyActor(PlayerController);
+	World->DestroyActor(Character);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
 	return true;
 }
\ No newline at end of file
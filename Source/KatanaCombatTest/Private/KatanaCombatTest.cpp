@@ -1,4 +1,5 @@
 #include "KatanaCombatTest.h"
+#include "CombatTestFixture.h"
 
 DEFINE_LOG_CATEGORY(KatanaCombatTest);
 
@@ -11,6 +12,7 @@ void FKatanaCombatTest::StartupModule()
 
 void FKatanaCombatTest::ShutdownModule()
 {
+	FCombatTestFixture::Shutdown();
 	UE_LOG(KatanaCombatTest, Warning, TEXT("KatanaCombatTest module has been unloaded"));
 }
 
@@ -1,6 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CombatTestHelpers.h"
+#include "Core/HitReactionComponent.h"
+#include "Core/MontageCheckpointCache.h"
+#include "Core/CombatScratch.h"
+#include "HAL/IConsoleManager.h"
 
 /**
  * Test: Memory Safety - Null CurrentAttackData
@@ -52,14 +56,12 @@ bool FMemorySafetyTest::RunTest(const FString& Parameters)
 	TestFalse("Should not enter hold with null attack",
 		CombatComp->IsHolding());
 
-	// Test 4: UpdateHoldTime with null CurrentAttackData (should not crash)
+	// Test 4: GetCurrentHoldTime with null CurrentAttackData (should not crash)
 	CombatComp->bIsHolding = true;
 	CombatComp->CurrentAttackData = nullptr;
 
 	// Should not crash
-	CombatComp->UpdateHoldTime(0.016f);
-
-	TestTrue("UpdateHoldTime should handle null gracefully", true);
+	TestEqual("GetCurrentHoldTime should handle null gracefully", CombatComp->GetCurrentHoldTime(), 0.0f);
 
 	// Test 5: GetCurrentAttack returns null safely
 	CombatComp->CurrentAttackData = nullptr;
@@ -104,7 +106,7 @@ bool FMemorySafetyTest::RunTest(const FString& Parameters)
 
 	CombatComp->ReleaseHeldLight(false);
 	CombatComp->ReleaseHeldHeavy(false);
-	CombatComp->UpdateHoldTime(0.016f);
+	CombatComp->GetCurrentHoldTime();
 
 	TestTrue("Multiple operations with null should not crash", true);
 
@@ -112,5 +114,84 @@ bool FMemorySafetyTest::RunTest(const FString& Parameters)
 	World->DestroyActor(TestCharacter);
 	FCombatTestHelpers::DestroyTestWorld(World);
 
+	return true;
+}
+
+/**
+ * Test: Combat memory reporting
+ * Verifies native containers are reported through GetResourceSizeEx and the dump command is registered
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatMemoryReportTest, "KatanaCombat.CombatComponent.MemoryReport", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatMemoryReportTest::RunTest(const FString& Parameters)
+{
+	TestNotNull("Combat.DumpMemory is registered", IConsoleManager::Get().FindConsoleObject(TEXT("Combat.DumpMemory")));
+
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	ASamuraiCharacter* Character = World ? World->SpawnActor<ASamuraiCharacter>() : nullptr;
+	if (!TestNotNull("Character should spawn", Character))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	// Local reaction table is native storage - only visible through GetResourceSizeEx
+	Character->HitReactionComponent->RebuildReactionTable();
+	TestTrue("Hit reaction table is reported", Character->HitReactionComponent->GetResourceSizeBytes(EResourceSizeMode::Exclusive) > 0);
+
+	UMontageCheckpointCache* CheckpointCache = World->GetSubsystem<UMontageCheckpointCache>();
+	if (TestNotNull("Checkpoint cache should exist", CheckpointCache))
+	{
+		const SIZE_T EmptySize = CheckpointCache->GetAllocatedSize();
+		CheckpointCache->FindOrBuildTable(NewObject<UAnimMontage>());
+		TestTrue("Cached tables are counted", CheckpointCache->GetAllocatedSize() > EmptySize);
+	}
+
+	// Runs without crashing on a live world
+	IConsoleManager::Get().ProcessUserConsoleInput(TEXT("Combat.DumpMemory"), *GLog, World);
+
+	// Cleanup
+	World->DestroyActor(Character);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Combat query scratch arrays
+ * Verifies nested scopes borrow separate arrays, released arrays come back empty with their
+ * allocation kept, and the next query reuses them instead of allocating
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatScratchArrayTest, "KatanaCombat.CombatComponent.ScratchArrays", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatScratchArrayTest::RunTest(const FString& Parameters)
+{
+	TCombatScratchPool<FVector>& Pool = TCombatScratchPool<FVector>::Get();
+	const int32 OutstandingBefore = Pool.GetNumOutstanding();
+
+	TArray<FVector>* OuterArray = nullptr;
+	{
+		TCombatScratchArray<FVector> Outer;
+		Outer->Add(FVector::OneVector);
+		OuterArray = &Outer.Get();
+		{
+			TCombatScratchArray<FVector> Inner;
+			TestTrue("Nested scopes get separate arrays", &Inner.Get() != OuterArray);
+			TestEqual("Both are lent out", Pool.GetNumOutstanding(), OutstandingBefore + 2);
+		}
+		TestEqual("Inner returned", Pool.GetNumOutstanding(), OutstandingBefore + 1);
+	}
+	TestEqual("Outer returned", Pool.GetNumOutstanding(), OutstandingBefore);
+
+	// Last in, first out: the next query gets the outer array back, emptied but still allocated
+	const int32 NumArrays = Pool.GetNumArrays();
+	{
+		TCombatScratchArray<FVector> Again;
+		TestTrue("Released array is reused", &Again.Get() == OuterArray);
+		TestEqual("Reused array is empty", Again->Num(), 0);
+		TestTrue("Reused array keeps its allocation", Again->Max() > 0);
+	}
+	TestEqual("Reuse creates no arrays", Pool.GetNumArrays(), NumArrays);
+
 	return true;
 }
\ No newline at end of file
@@ -0,0 +1,205 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatTestHelpers.h"
+#include "ActionQueueTypes.h"
+#include "Core/LagCompensationSubsystem.h"
+#include "Core/CombatEventChannelComponent.h"
+#include "Core/CombatNetDormancySubsystem.h"
+#include "Core/CombatRegistrySubsystem.h"
+#include "Core/TargetRegistrySubsystem.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/BitReader.h"
+
+/**
+ * Test: Input packet round trip
+ * Verifies the networked input packet survives serialization and stays 7 bytes on the wire
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatInputPacketTest, "KatanaCombat.Network.InputPacket", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatInputPacketTest::RunTest(const FString& Parameters)
+{
+	FCombatInputPacket Packet;
+	Packet.InputType = EInputType::HeavyAttack;
+	Packet.EventType = EInputEventType::Release;
+	Packet.Direction = EInputDirection::BackwardLeft;
+	Packet.Sequence = 65535;
+	Packet.TimestampMs = 123456789;
+
+	FBitWriter Writer(0, true);
+	bool bSaved = false;
+	Packet.NetSerialize(Writer, nullptr, bSaved);
+
+	TestTrue("Packet serialized", bSaved);
+	TestEqual("Packet is 7 bytes", static_cast<int32>(Writer.GetNumBytes()), 7);
+
+	FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+	FCombatInputPacket Received;
+	bool bLoaded = false;
+	Received.NetSerialize(Reader, nullptr, bLoaded);
+
+	TestTrue("Packet deserialized", bLoaded);
+	TestEqual("Input type survives", Received.InputType, Packet.InputType);
+	TestEqual("Event type survives", Received.EventType, Packet.EventType);
+	TestEqual("Direction survives", Received.Direction, Packet.Direction);
+	TestEqual("Sequence survives", Received.Sequence, Packet.Sequence);
+	TestEqual("Timestamp survives", Received.TimestampMs, Packet.TimestampMs);
+
+	return true;
+}
+
+/**
+ * Test: Lag compensation rewind
+ * Verifies recorded target history interpolates between samples and clamps outside the recorded range
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLagCompensationRewindTest, "KatanaCombat.Network.LagCompensationRewind", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FLagCompensationRewindTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* Combat = nullptr;
+	ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	ULagCompensationSubsystem* LagCompensation = World->GetSubsystem<ULagCompensationSubsystem>();
+	UTargetRegistrySubsystem* Registry = World->GetSubsystem<UTargetRegistrySubsystem>();
+
+	if (!TestNotNull("Lag compensation subsystem exists", LagCompensation) || !TestNotNull("Target registry exists", Registry))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+	Registry->RegisterTarget(Character);
+
+	// Move 100 cm per 0.1 s, recording each step
+	for (int32 Step = 0; Step <= 3; ++Step)
+	{
+		Character->SetActorLocation(FVector(Step * 100.0f, 0.0f, 0.0f));
+		LagCompensation->RecordSnapshot(Step * 0.1f);
+	}
+
+	FLagCompensationSample Sample;
+	TestTrue("Character has history", LagCompensation->GetRewoundSample(Character, 0.15f, Sample));
+	TestTrue("Interpolates between samples", FMath::IsNearlyEqual(Sample.Location.X, 150.0f, 1.0f));
+	TestTrue("Capsule radius recorded", Sample.Radius > 0.0f);
+
+	LagCompensation->GetRewoundSample(Character, -1.0f, Sample);
+	TestTrue("Clamps to oldest sample", FMath::IsNearlyEqual(Sample.Location.X, 0.0f, 1.0f));
+
+	LagCompensation->GetRewoundSample(Character, 10.0f, Sample);
+	TestTrue("Clamps to newest sample", FMath::IsNearlyEqual(Sample.Location.X, 300.0f, 1.0f));
+
+	// Overflow the ring; the oldest surviving sample moves forward
+	for (int32 Step = 4; Step < ULagCompensationSubsystem::HistoryCapacity + 4; ++Step)
+	{
+		Character->SetActorLocation(FVector(Step * 100.0f, 0.0f, 0.0f));
+		LagCompensation->RecordSnapshot(Step * 0.1f);
+	}
+	LagCompensation->GetRewoundSample(Character, 0.0f, Sample);
+	TestTrue("Ring drops oldest samples", FMath::IsNearlyEqual(Sample.Location.X, 400.0f, 1.0f));
+
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
+
+/**
+ * Test: Combat event batch round trip
+ * Verifies quantized hit/posture events survive serialization and a hit stays a handful of bytes
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatNetEventBatchTest, "KatanaCombat.Network.CombatEventBatch", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatNetEventBatchTest::RunTest(const FString& Parameters)
+{
+	const FVector Direction = FVector(0.3f, -0.8f, -0.2f).GetSafeNormal();
+
+	FCombatNetEventBatch Batch;
+	FCombatNetEvent& Hit = Batch.Events.AddDefaulted_GetRef();
+	Hit.Type = ECombatNetEventType::Hit;
+	Hit.AttackIndex = 3;
+	Hit.Magnitude = FCombatNetEvent::QuantizeMagnitude(27.5f);
+	Hit.Direction = FCombatNetEvent::PackDirection(Direction);
+	Hit.ImpactOffset[0] = 120;
+	Hit.ImpactOffset[1] = -45;
+	Hit.ImpactOffset[2] = 90;
+
+	FCombatNetEvent& Posture = Batch.Events.AddDefaulted_GetRef();
+	Posture.Type = ECombatNetEventType::Posture;
+	Posture.Magnitude = FCombatNetEvent::QuantizeMagnitude(64.25f);
+
+	FBitWriter Writer(0, true);
+	bool bSaved = false;
+	Batch.NetSerialize(Writer, nullptr, bSaved);
+	TestTrue("Batch serialized", bSaved);
+
+	// 5 bit count + hit (3 type + 8 attack + 16 damage + 16 direction + 33 impact) + posture (3 + 16), target GUIDs excluded
+	TestTrue("Hit and posture fit in 13 bytes", Writer.GetNumBits() <= 13 * 8);
+
+	FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+	FCombatNetEventBatch Received;
+	bool bLoaded = false;
+	Received.NetSerialize(Reader, nullptr, bLoaded);
+
+	TestTrue("Batch deserialized", bLoaded && !Reader.IsError());
+	if (!TestEqual("Event count survives", Received.Events.Num(), 2))
+	{
+		return false;
+	}
+
+	const FCombatNetEvent& ReceivedHit = Received.Events[0];
+	TestEqual("Hit type survives", ReceivedHit.Type, ECombatNetEventType::Hit);
+	TestEqual("Attack index survives", static_cast<int32>(ReceivedHit.AttackIndex), 3);
+	TestTrue("Damage survives", FMath::IsNearlyEqual(FCombatNetEvent::DequantizeMagnitude(ReceivedHit.Magnitude), 27.5f, 0.1f));
+	TestEqual("Impact offset survives", static_cast<int32>(ReceivedHit.ImpactOffset[1]), -45);
+	TestTrue("Direction within 2 degrees", FVector::DotProduct(FCombatNetEvent::UnpackDirection(ReceivedHit.Direction), Direction) > FMath::Cos(FMath::DegreesToRadians(2.0f)));
+
+	const FCombatNetEvent& ReceivedPosture = Received.Events[1];
+	TestEqual("Posture type survives", ReceivedPosture.Type, ECombatNetEventType::Posture);
+	TestTrue("Posture survives", FMath::IsNearlyEqual(FCombatNetEvent::DequantizeMagnitude(ReceivedPosture.Magnitude), 64.25f, 0.1f));
+
+	return true;
+}
+
+/**
+ * Test: Combat net dormancy
+ * Verifies combatants rank attackers first, idle combatants go dormant and a wake brings them back
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatNetDormancyTest, "KatanaCombat.Network.CombatNetDormancy", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatNetDormancyTest::RunTest(const FString& Parameters)
+{
+	TestEqual("Attackers rank first", UCombatNetDormancySubsystem::ClassifyCombatant(ECombatantFlags::Attacking, ECombatState::Attacking, true, false), ECombatNetTier::Attacking);
+	TestEqual("Blocking is engaged", UCombatNetDormancySubsystem::ClassifyCombatant(ECombatantFlags::Blocking, ECombatState::Blocking, false, false), ECombatNetTier::Engaged);
+	TestEqual("Being targeted is engaged", UCombatNetDormancySubsystem::ClassifyCombatant(ECombatantFlags::None, ECombatState::Idle, false, true), ECombatNetTier::Engaged);
+	TestEqual("Nothing going on is idle", UCombatNetDormancySubsystem::ClassifyCombatant(ECombatantFlags::None, ECombatState::Idle, false, false), ECombatNetTier::Idle);
+
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* Combat = nullptr;
+	ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, Combat);
+	UCombatRegistrySubsystem* Registry = World->GetSubsystem<UCombatRegistrySubsystem>();
+	UCombatNetDormancySubsystem* Dormancy = World->GetSubsystem<UCombatNetDormancySubsystem>();
+
+	if (!TestNotNull("Combat registry exists", Registry) || !TestNotNull("Dormancy subsystem exists", Dormancy))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+	Registry->RegisterCombatant(Combat);
+	Dormancy->DormancyDelay = 0.0f;
+
+	const float DefaultPriority = Character->NetPriority;
+	Combat->ForceSetStateForTest(ECombatState::Blocking);
+	Dormancy->UpdateDormancy();
+	TestEqual("Blocking keeps the character awake", Dormancy->GetTier(Character), ECombatNetTier::Engaged);
+	TestTrue("Engaged priority raised", Character->NetPriority > DefaultPriority);
+
+	Combat->ForceSetStateForTest(ECombatState::Idle);
+	Dormancy->UpdateDormancy();
+	TestEqual("Idle character goes dormant", Dormancy->GetTier(Character), ECombatNetTier::Dormant);
+	TestEqual("Dormant on the net driver", static_cast<int32>(Character->NetDormancy), static_cast<int32>(DORM_DormantAll));
+	TestEqual("Dormant count", Dormancy->GetNumDormant(), 1);
+	TestEqual("Priority restored", Character->NetPriority, DefaultPriority);
+
+	Dormancy->WakeActor(Character);
+	TestEqual("Wake brings it back", static_cast<int32>(Character->NetDormancy), static_cast<int32>(DORM_Awake));
+	TestEqual("Woken character is idle", Dormancy->GetTier(Character), ECombatNetTier::Idle);
+
+	FCombatTestHelpers::DestroyTestWorld(World);
+	return true;
+}
\ No newline at end of file
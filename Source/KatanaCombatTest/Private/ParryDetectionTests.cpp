@@ -1,6 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CombatTestHelpers.h"
+#include "Core/ParryWindowSubsystem.h"
+#include "Core/CombatRegistrySubsystem.h"
+#include "ActionQueueTypes.h"
+#include "Core/AIDefenseComponent.h"
 
 /**
  * Test: Parry Defender-Side Detection
@@ -85,10 +89,257 @@ bool FParryDetectionTest::RunTest(const FString& Parameters)
 	TestFalse("Parry window clears on Idle transition",
 		AttackerCombat->IsInParryWindow());
 
+	// Test 6: Parry window registry tracks open/close (TryParry queries this instead of overlap scans)
+	if (UParryWindowSubsystem* ParrySubsystem = World->GetSubsystem<UParryWindowSubsystem>())
+	{
+		DefenderCombat->CloseParryWindow();
+		AttackerCombat->OpenParryWindow(0.3f);
+
+		TestTrue("Open parry window is registered",
+			ParrySubsystem->IsParryWindowOpen(Attacker));
+		TestTrue("Defender finds attacker in range",
+			ParrySubsystem->FindParryableAttacker(Defender, 500.0f) == Attacker);
+		TestNull("Defender ignores attacker out of range",
+			ParrySubsystem->FindParryableAttacker(Defender, 50.0f));
+
+		AttackerCombat->CloseParryWindow();
+		TestFalse("Closed parry window is unregistered",
+			ParrySubsystem->IsParryWindowOpen(Attacker));
+		TestEqual("Registry is empty after all windows close",
+			ParrySubsystem->GetOpenWindowCount(), 0);
+	}
+
 	// Cleanup
 	World->DestroyActor(Attacker);
 	World->DestroyActor(Defender);
 	FCombatTestHelpers::DestroyTestWorld(World);
 
+	return true;
+}
+
+/**
+ * Test: Duel mode pairing
+ * Verifies BeginDuel pairs both sides, re-pairing releases the old opponent, and death ends the duel
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDuelModeTest, "KatanaCombat.CombatComponent.DuelMode", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDuelModeTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+
+	UCombatComponent* CombatA = nullptr;
+	UCombatComponent* CombatB = nullptr;
+	UCombatComponent* CombatC = nullptr;
+	ASamuraiCharacter* CharacterA = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatA);
+	ASamuraiCharacter* CharacterB = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatB);
+	ASamuraiCharacter* CharacterC = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatC);
+
+	if (!TestNotNull("CombatA should be created", CombatA) ||
+		!TestNotNull("CombatB should be created", CombatB) ||
+		!TestNotNull("CombatC should be created", CombatC))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	// Test 1: Invalid pairings are rejected
+	TestFalse("Cannot duel nobody", CombatA->BeginDuel(nullptr));
+	TestFalse("Cannot duel yourself", CombatA->BeginDuel(CombatA));
+	TestFalse("Not dueling after rejected pairings", CombatA->IsInDuel());
+
+	// Test 2: Pairing is symmetric and caches the opponent character
+	TestTrue("Duel should start", CombatA->BeginDuel(CombatB));
+	TestTrue("A is dueling", CombatA->IsInDuel());
+	TestTrue("B is dueling", CombatB->IsInDuel());
+	TestTrue("A's opponent is B", CombatA->GetDuelOpponentCombat() == CombatB);
+	TestTrue("B's opponent is A", CombatB->GetDuelOpponentCombat() == CombatA);
+	TestTrue("A caches B's character", CombatA->GetDuelOpponent() == CharacterB);
+	TestTrue("A recognizes B as opponent", CombatA->IsDuelOpponent(CharacterB));
+	TestFalse("A does not treat C as opponent", CombatA->IsDuelOpponent(CharacterC));
+
+	// Test 3: Re-pairing releases the previous opponent
+	TestTrue("C can challenge A", CombatC->BeginDuel(CombatA));
+	TestFalse("B is released", CombatB->IsInDuel());
+	TestTrue("A now duels C", CombatA->GetDuelOpponentCombat() == CombatC);
+
+	// Test 4: EndDuel clears both sides
+	CombatA->EndDuel();
+	TestFalse("A no longer dueling", CombatA->IsInDuel());
+	TestFalse("C no longer dueling", CombatC->IsInDuel());
+
+	// Test 5: Death ends the duel
+	CombatA->BeginDuel(CombatB);
+	CombatB->SetCombatState(ECombatState::Dead);
+	TestFalse("Survivor is released when the opponent dies", CombatA->IsInDuel());
+	TestFalse("Dead combatant cannot start a duel", CombatB->BeginDuel(CombatC));
+
+	// Cleanup
+	World->DestroyActor(CharacterA);
+	World->DestroyActor(CharacterB);
+	World->DestroyActor(CharacterC);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Interval parry evaluation
+ * Verifies a press time maps onto the attacker's montage time and is tested against the parry
+ * checkpoints' [start, end], independent of which frame processed it
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParryIntervalTest, "KatanaCombat.CombatComponent.ParryInterval", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FParryIntervalTest::RunTest(const FString& Parameters)
+{
+	// Sorted like a montage checkpoint table: combo window, then parry window [0.40, 0.55]
+	TArray<FTimerCheckpoint> Checkpoints;
+	Checkpoints.Emplace(EActionWindowType::Combo, 0.1f, 0.6f);
+	Checkpoints.Emplace(EActionWindowType::Parry, 0.4f, 0.15f);
+
+	TestFalse("Before the parry window", UParryWindowSubsystem::IsInParryCheckpoint(Checkpoints, 0.39f));
+	TestTrue("Window start is inclusive", UParryWindowSubsystem::IsInParryCheckpoint(Checkpoints, 0.4f));
+	TestTrue("Window end is inclusive", UParryWindowSubsystem::IsInParryCheckpoint(Checkpoints, 0.55f));
+	TestFalse("After the parry window", UParryWindowSubsystem::IsInParryCheckpoint(Checkpoints, 0.56f));
+	TestFalse("Other window types don't count", UParryWindowSubsystem::IsInParryCheckpoint(Checkpoints, 0.2f));
+
+	// Attacker sampled at montage 0.42 at world 5.0, playing at 1.5x
+	TestEqual("Press 20ms earlier maps back along the play rate", UParryWindowSubsystem::ExtrapolateMontageTime(0.42f, 5.0f, 1.5f, 4.98f), 0.39f, 0.0001f);
+	TestEqual("Press after the sample maps forward", UParryWindowSubsystem::ExtrapolateMontageTime(0.42f, 5.0f, 1.5f, 5.02f), 0.45f, 0.0001f);
+
+	// Same press, 30 vs 60 fps frame boundaries: same answer
+	const float PressTime = 4.99f;
+	const bool bAt30 = UParryWindowSubsystem::IsInParryCheckpoint(Checkpoints, UParryWindowSubsystem::ExtrapolateMontageTime(0.42f - 1.5f * 0.033f, 5.0f - 0.033f, 1.5f, PressTime));
+	const bool bAt60 = UParryWindowSubsystem::IsInParryCheckpoint(Checkpoints, UParryWindowSubsystem::ExtrapolateMontageTime(0.42f - 1.5f * 0.016f, 5.0f - 0.016f, 1.5f, PressTime));
+	TestTrue("Open at the press", bAt30);
+	TestEqual("Frame rate doesn't change the result", bAt30, bAt60);
+
+	return true;
+}
+
+/**
+ * Test: Predictive AI defense planning
+ * Verifies reactions are timed from the attack's parry window and degrade when the AI can't
+ * react in time
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAIDefensePlanTest, "KatanaCombat.CombatComponent.AIDefensePlan", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAIDefensePlanTest::RunTest(const FString& Parameters)
+{
+	UAIDefenseComponent* Defense = NewObject<UAIDefenseComponent>();
+	Defense->ReactionTime = 0.2f;
+	Defense->ParryWindowFraction = 0.5f;
+	Defense->BlockLeadTime = 0.1f;
+	Defense->BlockHoldTime = 0.3f;
+
+	// Parry window [0.6, 0.8] in montage time; attack just started, playing at 2x
+	TArray<FTimerCheckpoint> Checkpoints;
+	Checkpoints.Emplace(EActionWindowType::Combo, 0.2f, 1.0f);
+	Checkpoints.Emplace(EActionWindowType::Parry, 0.6f, 0.2f);
+
+	const FAIDefensePlan Parry = Defense->PlanDefense(EAIDefenseAction::Parry, Checkpoints, 0.0f, 2.0f);
+	TestEqual("Parry planned", Parry.Action, EAIDefenseAction::Parry);
+	TestEqual("Parry lands mid-window in world time", Parry.PressDelay, 0.35f, 0.0001f);
+
+	const FAIDefensePlan Block = Defense->PlanDefense(EAIDefenseAction::Block, Checkpoints, 0.0f, 2.0f);
+	TestEqual("Block planned", Block.Action, EAIDefenseAction::Block);
+	TestEqual("Block raised before the window opens", Block.PressDelay, 0.2f, 0.0001f);
+	TestEqual("Block held through the window and strike", Block.PressDelay + Block.HoldTime, 0.7f, 0.0001f);
+
+	const FAIDefensePlan Evade = Defense->PlanDefense(EAIDefenseAction::Evade, Checkpoints, 0.0f, 2.0f);
+	TestEqual("Evade as the window closes", Evade.PressDelay, 0.4f, 0.0001f);
+
+	// Attack already deep into the window: too late to parry, block instead
+	const FAIDefensePlan LateParry = Defense->PlanDefense(EAIDefenseAction::Parry, Checkpoints, 0.7f, 2.0f);
+	TestEqual("Late parry degrades to block", LateParry.Action, EAIDefenseAction::Block);
+	TestEqual("Late block waits for the reaction time", LateParry.PressDelay, 0.2f, 0.0001f);
+
+	const FAIDefensePlan LateEvade = Defense->PlanDefense(EAIDefenseAction::Evade, Checkpoints, 0.7f, 2.0f);
+	TestFalse("Too late to evade", LateEvade.IsValid());
+
+	// No parry window to time against
+	const FAIDefensePlan Untelegraphed = Defense->PlanDefense(EAIDefenseAction::Parry, TArray<FTimerCheckpoint>(), 0.0f, 1.0f);
+	TestEqual("Untelegraphed attack is blocked", Untelegraphed.Action, EAIDefenseAction::Block);
+	TestEqual("Blocked at the reaction time", Untelegraphed.PressDelay, 0.2f, 0.0001f);
+
+	return true;
+}
+
+/**
+ * Test: Combat registry queries
+ * Verifies who-is-attacking-whom, flag scans and indexed lookups follow the combatants' state
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatRegistryTest, "KatanaCombat.CombatComponent.CombatRegistry", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatRegistryTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatRegistrySubsystem* Registry = World->GetSubsystem<UCombatRegistrySubsystem>();
+
+	UCombatComponent* AttackerCombat = nullptr;
+	UTargetingComponent* AttackerTargeting = nullptr;
+	ASamuraiCharacter* Attacker = FCombatTestHelpers::CreateTestCharacterWithCombatAndTargeting(World, AttackerCombat, AttackerTargeting);
+
+	UCombatComponent* DefenderCombat = nullptr;
+	ASamuraiCharacter* Defender = FCombatTestHelpers::CreateTestCharacterWithCombat(World, DefenderCombat);
+
+	if (!TestNotNull("Registry should exist", Registry) ||
+		!TestNotNull("AttackerTargeting should be created", AttackerTargeting) ||
+		!TestNotNull("DefenderCombat should be created", DefenderCombat))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	// No-op if BeginPlay already registered them
+	Registry->RegisterCombatant(AttackerCombat);
+	Registry->RegisterCombatant(DefenderCombat);
+	TestEqual("Both characters are combatants", Registry->GetNumCombatants(), 2);
+
+	Defender->SetActorLocation(Attacker->GetActorLocation() + FVector(200, 0, 0));
+	AttackerTargeting->SetCurrentTarget(Defender);
+	AttackerCombat->SetCombatState(ECombatState::Attacking);
+	AttackerCombat->OpenParryWindow(0.3f);
+	Registry->RefreshCombatants();
+
+	TArray<AActor*> Found;
+	TestEqual("Defender has one attacker", Registry->GetAttackersOf(Defender, Found), 1);
+	TestTrue("Attacker is the one attacking", Found.Num() == 1 && Found[0] == Attacker);
+
+	Found.Reset();
+	TestEqual("Range limits attackers", Registry->GetAttackersOf(Defender, Found, 100.0f), 0);
+	TestEqual("Nobody attacks the attacker", Registry->GetAttackersOf(Attacker, Found), 0);
+
+	TestEqual("One combatant targets the defender", Registry->GetCombatantsTargeting(Defender, Found), 1);
+
+	Found.Reset();
+	TestEqual("One combatant can be parried", Registry->GetCombatantsWithFlags(ECombatantFlags::ParryWindow, Found), 1);
+	TestEqual("Querier is ignored", Registry->GetCombatantsWithFlags(ECombatantFlags::ParryWindow, Found, Attacker), 0);
+
+	TestTrue("Indexed lookup: attacker is attacking the defender", Registry->IsAttacking(Attacker, Defender));
+	TestFalse("Indexed lookup: defender isn't attacking", Registry->IsAttacking(Defender, Attacker));
+
+	const int32 AttackerIndex = Registry->FindCombatant(Attacker);
+	if (TestTrue("Attacker has an index", AttackerIndex != INDEX_NONE))
+	{
+		TestEqual("Indexed state", Registry->GetCombatantState(AttackerIndex), ECombatState::Attacking);
+		TestEqual("Target resolves to the defender's index", Registry->GetCombatantTargetIndex(AttackerIndex), Registry->FindCombatant(Defender));
+	}
+
+	// State changes show up on the next refresh
+	AttackerCombat->SetCombatState(ECombatState::Idle);
+	Registry->RefreshCombatants();
+	Found.Reset();
+	TestEqual("Idle attacker no longer attacks", Registry->GetAttackersOf(Defender, Found), 0);
+	TestEqual("Idle transition closed the parry window", Registry->GetCombatantsWithFlags(ECombatantFlags::ParryWindow, Found), 0);
+
+	// Destroyed combatants are purged
+	World->DestroyActor(Attacker);
+	Registry->RefreshCombatants();
+	TestEqual("Destroyed combatant is purged", Registry->GetNumCombatants(), 1);
+	TestEqual("Remaining index is patched", Registry->FindCombatant(Defender), 0);
+
+	World->DestroyActor(Defender);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
 	return true;
 }
\ No newline at end of file
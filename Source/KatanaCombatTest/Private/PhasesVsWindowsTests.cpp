@@ -1,6 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CombatTestHelpers.h"
+#include "Utilities/MontageUtilityLibrary.h"
+#include "ActionQueueTypes.h"
+#include "Animation/AnimNotifyState_ComboWindow.h"
+#include "Animation/AnimNotifyState_CancelWindow.h"
 
 /**
  * Test: Phases vs Windows Separation
@@ -137,5 +141,139 @@ bool FPhasesVsWindowsTest::RunTest(const FString& Parameters)
 	World->DestroyActor(TestCharacter);
 	FCombatTestHelpers::DestroyTestWorld(World);
 
+	return true;
+}
+
+/**
+ * Test: Cancel Window Discovery
+ * Verifies CancelWindow notifies become Cancel checkpoints alongside other windows
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCancelWindowDiscoveryTest, "KatanaCombat.MontageUtility.CancelWindowDiscovery", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCancelWindowDiscoveryTest::RunTest(const FString& Parameters)
+{
+	UAnimMontage* Montage = NewObject<UAnimMontage>();
+
+	FAnimNotifyEvent& CancelEvent = Montage->Notifies.AddDefaulted_GetRef();
+	CancelEvent.NotifyStateClass = NewObject<UAnimNotifyState_CancelWindow>(Montage);
+	CancelEvent.SetTime(0.8f);
+	CancelEvent.SetDuration(0.3f);
+
+	FAnimNotifyEvent& ComboEvent = Montage->Notifies.AddDefaulted_GetRef();
+	ComboEvent.NotifyStateClass = NewObject<UAnimNotifyState_ComboWindow>(Montage);
+	ComboEvent.SetTime(0.5f);
+	ComboEvent.SetDuration(0.4f);
+
+	TArray<FTimerCheckpoint> Checkpoints;
+	const int32 NumFound = UMontageUtilityLibrary::DiscoverCheckpoints(Montage, Checkpoints);
+
+	if (!TestEqual("Both windows should be discovered", NumFound, 2))
+	{
+		return false;
+	}
+
+	// Sorted by montage time: combo first, cancel second
+	TestEqual("First checkpoint is the combo window", Checkpoints[0].WindowType, EActionWindowType::Combo);
+	TestEqual("Second checkpoint is the cancel window", Checkpoints[1].WindowType, EActionWindowType::Cancel);
+	TestEqual("Cancel window start", Checkpoints[1].MontageTime, 0.8f, KINDA_SMALL_NUMBER);
+	TestEqual("Cancel window duration", Checkpoints[1].Duration, 0.3f, KINDA_SMALL_NUMBER);
+
+	return true;
+}
+
+/**
+ * Test: Montage Clock
+ * Verifies playrate changes are integrated and wall time to a checkpoint is answered without the montage
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMontageClockTest, "KatanaCombat.MontageUtility.MontageClock", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FMontageClockTest::RunTest(const FString& Parameters)
+{
+	FMontageClock Clock;
+	TestTrue("Stopped clock never reaches a checkpoint", Clock.GetTimeUntil(1.0f, 0.0) < 0.0f);
+
+	// Montage at 0.2 on world time 10, normal speed
+	Clock.Rebase(10.0, 0.2f, 1.0f);
+	TestEqual("Montage time advances with world time", Clock.GetMontageTime(10.3), 0.5f, KINDA_SMALL_NUMBER);
+	TestEqual("Wall time to checkpoint at rate 1", Clock.GetTimeUntil(0.8f, 10.0), 0.6f, KINDA_SMALL_NUMBER);
+	TestEqual("Passed checkpoint is due now", Clock.GetTimeUntil(0.1f, 10.0), 0.0f);
+
+	// Hold eases to half speed at 10.2 (montage 0.4)
+	Clock.SetPlayRate(10.2, 0.5f);
+	TestEqual("Time played at the old rate is kept", Clock.GetMontageTime(10.2), 0.4f, KINDA_SMALL_NUMBER);
+	TestEqual("Wall time to checkpoint at half rate", Clock.GetTimeUntil(0.8f, 10.2), 0.8f, KINDA_SMALL_NUMBER);
+
+	// Frozen hold never gets there
+	Clock.SetPlayRate(10.4, 0.0f);
+	TestEqual("Frozen clock holds its time", Clock.GetMontageTime(11.0), 0.5f, KINDA_SMALL_NUMBER);
+	TestTrue("Frozen clock never reaches a later checkpoint", Clock.GetTimeUntil(0.8f, 11.0) < 0.0f);
+	TestEqual("Frozen clock has still reached an earlier one", Clock.GetTimeUntil(0.3f, 11.0), 0.0f);
+
+	Clock.Stop();
+	TestFalse("Stopped", Clock.IsRunning());
+
+	return true;
+}
+
+/**
+ * Test: Montage section table
+ * Verifies the cached table matches the montage's composite sections (names, start/end times), section
+ * queries answer from it, names resolve to indices once, and editing the montage rebuilds the table
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMontageSectionTableTest, "KatanaCombat.MontageUtility.SectionTable", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FMontageSectionTableTest::RunTest(const FString& Parameters)
+{
+	UAnimMontage* Montage = NewObject<UAnimMontage>();
+	const FName SectionNames[] = { TEXT("Attack1"), TEXT("Attack2"), TEXT("Attack3") };
+	const float SectionTimes[] = { 0.0f, 0.6f, 1.4f };
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(SectionNames); ++Index)
+	{
+		FCompositeSection& Section = Montage->CompositeSections.AddDefaulted_GetRef();
+		Section.SectionName = SectionNames[Index];
+		Section.SetTime(SectionTimes[Index]);
+	}
+
+	TestNull("No table without a montage", UMontageUtilityLibrary::GetSectionTable(nullptr));
+
+	const FMontageSectionTable* Table = UMontageUtilityLibrary::GetSectionTable(Montage);
+	if (!TestNotNull("Table built", Table))
+	{
+		return false;
+	}
+
+	TestEqual("One entry per section", Table->Num(), 3);
+	TestEqual("Indices match the montage", Table->FindSection(TEXT("Attack2")), 1);
+	TestEqual("Unknown section", Table->FindSection(TEXT("Missing")), INDEX_NONE);
+	TestEqual("None never matches", Table->FindSection(NAME_None), INDEX_NONE);
+	TestTrue("Same table on the next lookup", UMontageUtilityLibrary::GetSectionTable(Montage) == Table);
+	TestEqual("Section ends where the next starts", Table->EndTimes[0], 0.6f, KINDA_SMALL_NUMBER);
+	TestTrue("Last section never ends before it starts", Table->GetDuration(2) >= 0.0f);
+	TestEqual("Section at a montage time", Table->FindSectionAtTime(0.7f), 1);
+	TestEqual("Section at its own start", Table->FindSectionAtTime(0.0f), 0);
+	TestEqual("Before every section", Table->FindSectionAtTime(-1.0f), INDEX_NONE);
+
+	// Section queries answer from the table
+	TestEqual("Start time", UMontageUtilityLibrary::GetSectionStartTime(Montage, TEXT("Attack2")), 0.6f, KINDA_SMALL_NUMBER);
+	TestEqual("Duration runs to the next section", UMontageUtilityLibrary::GetSectionDuration(Montage, TEXT("Attack2")), 0.8f, KINDA_SMALL_NUMBER);
+	TestEqual("Missing section start", UMontageUtilityLibrary::GetSectionStartTime(Montage, TEXT("Missing")), -1.0f);
+	TestEqual("Section names in order", UMontageUtilityLibrary::GetMontageSections(Montage), TArray<FName>(SectionNames, UE_ARRAY_COUNT(SectionNames)));
+
+	// Names resolve once into indices
+	TArray<int32> Indices;
+	const TArray<FName> ComboNames = { TEXT("Attack3"), TEXT("Missing"), TEXT("Attack1") };
+	TestEqual("Resolved names", UMontageUtilityLibrary::ResolveSectionIndices(Montage, ComboNames, Indices), 2);
+	TestEqual("One index per name", Indices.Num(), 3);
+	TestEqual("Resolved index", Indices[0], 2);
+	TestEqual("Missing name stays unresolved", Indices[1], INDEX_NONE);
+	TestFalse("Jumping needs an anim instance", UMontageUtilityLibrary::JumpToSectionIndex(nullptr, Montage, 0));
+
+#if WITH_EDITOR
+	// Editing the montage drops its table
+	Montage->Modify();
+	Montage->CompositeSections[1].SectionName = TEXT("Renamed");
+	TestEqual("Edited section found after the rebuild", UMontageUtilityLibrary::GetSectionTable(Montage)->FindSection(TEXT("Renamed")), 1);
+#endif
+
 	return true;
 }
\ No newline at end of file
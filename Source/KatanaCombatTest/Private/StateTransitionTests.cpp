@@ -1,6 +1,12 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "CombatTestHelpers.h"
+#include "CombatTestFixture.h"
+#include "Core/CombatStateTransitions.h"
+#include "Core/CombatComponentV2.h"
+#include "Debug/CombatDebugWidget.h"
+#include "Interfaces/CombatInterface.h"
+#include "GameFramework/WorldSettings.h"
 
 /**
  * Test: State Transition Validation
@@ -11,13 +17,12 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStateTransitionTest, "KatanaCombat.CombatCompo
 bool FStateTransitionTest::RunTest(const FString& Parameters)
 {
 	// Setup
-	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	FCombatTestFixture Fixture;
 	UCombatComponent* CombatComp = nullptr;
-	ACharacter* TestCharacter = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+	Fixture.AcquireCharacter(CombatComp);
 
 	if (!TestNotNull("CombatComponent should be created", CombatComp))
 	{
-		FCombatTestHelpers::DestroyTestWorld(World);
 		return false;
 	}
 
@@ -73,9 +78,299 @@ bool FStateTransitionTest::RunTest(const FString& Parameters)
 	TestFalse("Cannot transition to same state (Idle → Idle)",
 		CombatComp->CanTransitionTo(ECombatState::Idle));
 
+	return true;
+}
+
+/**
+ * Test: Analytic Posture Regen
+ * Verifies event-driven posture matches per-state regen rates without ticking
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAnalyticPostureTest, "KatanaCombat.CombatComponent.AnalyticPosture", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAnalyticPostureTest::RunTest(const FString& Parameters)
+{
+	// Setup
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* CombatComp = nullptr;
+	ASamuraiCharacter* TestCharacter = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+
+	if (!TestNotNull("CombatComponent should be created", CombatComp))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	// Settings are assigned after BeginPlay in tests - wire up event-driven mode explicitly
+	CombatComp->CombatSettings = TestCharacter->CombatSettings;
+	CombatComp->bEventDrivenTick = true;
+	CombatComp->CurrentPosture = 40.0f;
+	CombatComp->PostureAnchorTime = 10.0f;
+
+	// Idle regen: 20/s
+	CombatComp->CurrentState = ECombatState::Idle;
+	TestEqual("Idle regen after 1s", CombatComp->EvaluatePosture(11.0f), 60.0f, 0.001f);
+	TestEqual("Regen clamps to max posture", CombatComp->EvaluatePosture(100.0f), 100.0f, 0.001f);
+	TestEqual("No regen before anchor time", CombatComp->EvaluatePosture(5.0f), 40.0f, 0.001f);
+
+	// Attacking regen: 50/s
+	CombatComp->CurrentState = ECombatState::Attacking;
+	TestEqual("Attacking regen after 0.5s", CombatComp->EvaluatePosture(10.5f), 65.0f, 0.001f);
+
+	// No regen while blocking or guard broken
+	CombatComp->CurrentState = ECombatState::Blocking;
+	TestEqual("No regen while blocking", CombatComp->EvaluatePosture(20.0f), 40.0f, 0.001f);
+	CombatComp->CurrentState = ECombatState::GuardBroken;
+	TestEqual("No regen while guard broken", CombatComp->EvaluatePosture(20.0f), 40.0f, 0.001f);
+
+	// Idle with nothing changing should not tick
+	CombatComp->CurrentState = ECombatState::Idle;
+	CombatComp->bIsHolding = false;
+	CombatComp->RefreshTickEnabled();
+	TestFalse("Idle component tick disabled", CombatComp->IsComponentTickEnabled());
+
+	CombatComp->bIsHolding = true;
+	CombatComp->RefreshTickEnabled();
+	TestTrue("Holding component ticks", CombatComp->IsComponentTickEnabled());
+
 	// Cleanup
 	World->DestroyActor(TestCharacter);
 	FCombatTestHelpers::DestroyTestWorld(World);
 
+	return true;
+}
+
+/**
+ * Test: Transition table
+ * Verifies the shared table agrees with the component for every state pair,
+ * keeps Dead terminal except through the respawn guard, and gates V2 input
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStateTransitionTableTest, "KatanaCombat.CombatComponent.TransitionTable", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FStateTransitionTableTest::RunTest(const FString& Parameters)
+{
+	// Setup
+	FCombatTestFixture Fixture;
+	UCombatComponent* CombatComp = nullptr;
+	Fixture.AcquireCharacter(CombatComp);
+
+	if (!TestNotNull("CombatComponent should be created", CombatComp))
+	{
+		return false;
+	}
+
+	for (int32 From = 0; From < CombatStateTransitions::NumStates; ++From)
+	{
+		const ECombatState FromState = static_cast<ECombatState>(From);
+		CombatComp->ForceSetStateForTest(FromState);
+
+		for (int32 To = 0; To < CombatStateTransitions::NumStates; ++To)
+		{
+			const ECombatState ToState = static_cast<ECombatState>(To);
+			TestEqual(FString::Printf(TEXT("Component matches table (%d -> %d)"), From, To),
+				CombatComp->CanTransitionTo(ToState), CombatStateTransitions::CanTransition(FromState, ToState));
+		}
+
+		TestFalse(FString::Printf(TEXT("No same-state transition (%d)"), From), CombatStateTransitions::CanTransition(FromState, FromState));
+		if (FromState != ECombatState::Dead)
+		{
+			TestTrue(FString::Printf(TEXT("Every live state can die (%d)"), From), CombatStateTransitions::CanTransition(FromState, ECombatState::Dead));
+		}
+	}
+
+	// Dead only leaves through the respawn guard
+	TestEqual("Dead row is empty", CombatStateTransitions::GetAllowedMask(ECombatState::Dead), static_cast<uint16>(0));
+	TestTrue("Respawn guard resets Dead", CombatStateTransitions::CanTransitionGuarded(ECombatState::Dead, ECombatState::Idle, ECombatTransitionGuard::Respawn));
+
+	// V2 input gate
+	TestTrue("Evading accepts input", CombatStateTransitions::AcceptsInput(ECombatState::Evading));
+	TestFalse("Hit stun locks input", CombatStateTransitions::AcceptsInput(ECombatState::HitStunned));
+	TestFalse("Guard break locks input", CombatStateTransitions::AcceptsInput(ECombatState::GuardBroken));
+
+	return true;
+}
+
+/**
+ * Test: Native combat event delegates
+ * Verifies C++ listeners on the native delegates see the same state changes the dynamic ones broadcast
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNativeCombatEventTest, "KatanaCombat.CombatComponent.NativeEvents", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FNativeCombatEventTest::RunTest(const FString& Parameters)
+{
+	FCombatTestFixture Fixture;
+	UCombatComponent* CombatComp = nullptr;
+	Fixture.AcquireCharacter(CombatComp);
+
+	if (!TestNotNull("CombatComponent should be created", CombatComp))
+	{
+		return false;
+	}
+
+	TArray<ECombatState> NativeStates;
+	const FDelegateHandle Handle = CombatComp->OnCombatStateChangedNative.AddLambda([&NativeStates](ECombatState NewState)
+	{
+		NativeStates.Add(NewState);
+	});
+
+	CombatComp->SetCombatState(ECombatState::Attacking);
+	CombatComp->SetCombatState(ECombatState::Idle);
+
+	TestEqual("Native listener sees every change", NativeStates.Num(), 2);
+	TestTrue("Native listener sees the new states in order", NativeStates.Num() == 2 && NativeStates[0] == ECombatState::Attacking && NativeStates[1] == ECombatState::Idle);
+
+	CombatComp->OnCombatStateChangedNative.Remove(Handle);
+	CombatComp->SetCombatState(ECombatState::Attacking);
+	TestEqual("Removed listener isn't called", NativeStates.Num(), 2);
+
+	return true;
+}
+
+/**
+ * Test: Spawn-time combat backend
+ * Verifies V1 characters never create the V2 stack and that switching settings builds or drops it
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatBackendSelectionTest, "KatanaCombat.CombatComponent.BackendSelection", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatBackendSelectionTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* CombatComp = nullptr;
+	ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+	if (!TestNotNull("Character should spawn", Character))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	TestNotNull("V1 component always exists", Character->CombatComponent.Get());
+	TestNull("V1 character has no V2 component", Character->CombatComponentV2.Get());
+	TestNull("V1 character has no V2 debug widget", Character->CombatDebugWidget.Get());
+
+	Character->CombatSettings->bUseV2System = true;
+	Character->SelectCombatBackend();
+	UCombatComponentV2* V2 = Character->CombatComponentV2;
+	if (TestNotNull("Selecting V2 creates the component", V2))
+	{
+		TestTrue("V2 component is registered", V2->IsRegistered());
+		TestTrue("V2 component has begun play", V2->HasBegunPlay());
+	}
+	TestNotNull("Debug widget comes with the V2 stack", Character->CombatDebugWidget.Get());
+
+	Character->SelectCombatBackend();
+	TestEqual("Reselecting the same backend keeps the component", Character->CombatComponentV2.Get(), V2);
+
+	Character->CombatSettings->bUseV2System = false;
+	Character->SelectCombatBackend();
+	TestNull("Back to V1 drops the V2 component", Character->CombatComponentV2.Get());
+	TestNull("Back to V1 drops the debug widget", Character->CombatDebugWidget.Get());
+
+	Character->CombatSettings->bUseV2System = true;
+	Character->SelectCombatBackend();
+	TestNotNull("V2 can be recreated after being dropped", Character->CombatComponentV2.Get());
+
+	World->DestroyActor(Character);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Native combat queries
+ * Verifies the native query block answers like the ICombatInterface query events and follows state changes
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNativeCombatQueryTest, "KatanaCombat.CombatComponent.NativeQueries", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FNativeCombatQueryTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FCombatTestHelpers::CreateTestWorld();
+	UCombatComponent* CombatComp = nullptr;
+	ASamuraiCharacter* Character = FCombatTestHelpers::CreateTestCharacterWithCombat(World, CombatComp);
+	if (!TestNotNull("Character should spawn", Character))
+	{
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	const FCombatQuerySnapshot* Snapshot = ICombatInterface::GetQuerySnapshot(Character);
+	if (!TestNotNull("Native implementer provides a query block", Snapshot))
+	{
+		World->DestroyActor(Character);
+		FCombatTestHelpers::DestroyTestWorld(World);
+		return false;
+	}
+
+	TestEqual("Idle state", Snapshot->CombatState, ECombatState::Idle);
+	TestTrue("Can attack from Idle", Snapshot->bCanAttack);
+	TestEqual("Matches the query event", Snapshot->bIsAttacking, ICombatInterface::Execute_IsAttacking(Character));
+
+	CombatComp->SetCombatState(ECombatState::Attacking);
+	Snapshot = ICombatInterface::GetQuerySnapshot(Character);
+	TestEqual("Follows the state change", Snapshot->CombatState, ECombatState::Attacking);
+	TestTrue("Attacking", Snapshot->bIsAttacking);
+	TestFalse("Can't start a fresh attack while attacking", Snapshot->bCanAttack);
+	TestEqual("Matches the query event while attacking", Snapshot->bIsAttacking, ICombatInterface::Execute_IsAttacking(Character));
+
+	FCombatQuerySnapshot Query;
+	TestTrue("Combat actor can be queried", ICombatInterface::QueryCombatState(Character, Query));
+	TestEqual("Query copies the block", Query.CombatState, ECombatState::Attacking);
+
+	TestNull("Actors without the interface have no block", ICombatInterface::GetQuerySnapshot(World->GetWorldSettings()));
+	TestFalse("Actors without the interface can't be queried", ICombatInterface::QueryCombatState(World->GetWorldSettings(), Query));
+	TestNull("Null actor has no block", ICombatInterface::GetQuerySnapshot(nullptr));
+
+	World->DestroyActor(Character);
+	FCombatTestHelpers::DestroyTestWorld(World);
+
+	return true;
+}
+
+/**
+ * Test: Shared fixture world
+ * Verifies pooled characters are reused across fixtures and come back in their just-spawned state
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatTestFixtureTest, "KatanaCombat.CombatComponent.FixtureReuse", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCombatTestFixtureTest::RunTest(const FString& Parameters)
+{
+	UCombatComponent* FirstCombat = nullptr;
+	const UWorld* FirstWorld = nullptr;
+	{
+		FCombatTestFixture Fixture;
+		FirstWorld = Fixture.GetWorld();
+		Fixture.AcquireCharacter(FirstCombat);
+		if (!TestNotNull("CombatComponent should be created", FirstCombat))
+		{
+			return false;
+		}
+
+		// Leave the character mid-fight
+		FirstCombat->SetCombatState(ECombatState::Blocking);
+		FirstCombat->ApplyPostureDamage(30.0f);
+		FirstCombat->OpenComboWindow(1.0f);
+	}
+
+	const int32 NumWorlds = FCombatTestFixture::GetNumWorldsCreated();
+	const int32 NumSpawned = FCombatTestFixture::GetNumCharactersSpawned();
+	TestTrue("Released character is back in the pool", FCombatTestFixture::GetNumFreeCharacters() > 0);
+
+	FCombatTestFixture Fixture;
+	UCombatComponent* CombatComp = nullptr;
+	ASamuraiCharacter* Character = Fixture.AcquireCharacter(CombatComp, FVector(200.0f, 0.0f, 0.0f));
+
+	TestEqual("Same world reused", Fixture.GetWorld(), FirstWorld);
+	TestEqual("No new world", FCombatTestFixture::GetNumWorldsCreated(), NumWorlds);
+	TestEqual("No new character", FCombatTestFixture::GetNumCharactersSpawned(), NumSpawned);
+	TestEqual("Same combat component reused", CombatComp, FirstCombat);
+
+	TestEqual("State reset", CombatComp->GetCombatState(), ECombatState::Idle);
+	TestEqual("Posture reset", CombatComp->GetCurrentPosture(), CombatComp->GetMaxPosture());
+	TestFalse("Combo window reset", CombatComp->CanCombo());
+	TestEqual("Placed where requested", Character->GetActorLocation(), FVector(200.0f, 0.0f, 0.0f));
+
+	// A second character while the first is borrowed comes from a fresh spawn
+	UCombatComponent* OtherCombat = nullptr;
+	Fixture.AcquireCharacter(OtherCombat);
+	TestNotEqual("Borrowed characters are distinct", OtherCombat, CombatComp);
+
 	return true;
 }
\ No newline at end of file
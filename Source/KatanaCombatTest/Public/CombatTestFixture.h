@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatTestHelpers.h"
+
+/**
+ * Shared fixture world for combat tests
+ * One world and a pool of test characters reused across test cases, so a test pays for world
+ * creation and character spawning once per session instead of once per case
+ *
+ * Usage (scope = one test case):
+ *   FCombatTestFixture Fixture;
+ *   UCombatComponent* CombatComp = nullptr;
+ *   ASamuraiCharacter* Character = Fixture.AcquireCharacter(CombatComp);
+ *
+ * Acquired characters come back reset: fresh test settings, origin transform, combat component
+ * back to its just-spawned state (UCombatComponent::ResetForTest). When the fixture goes out of
+ * scope they return to the pool and are parked far away with collision off.
+ *
+ * World subsystems keep their state between cases - tests that assert on world-wide
+ * state (registry counts, scheduler stats) should keep using CreateTestWorld. Delegates a test
+ * binds on a pooled character must be removed before it ends.
+ */
+class KATANACOMBATTEST_API FCombatTestFixture
+{
+public:
+	FCombatTestFixture();
+	~FCombatTestFixture();
+
+	FCombatTestFixture(const FCombatTestFixture&) = delete;
+	FCombatTestFixture& operator=(const FCombatTestFixture&) = delete;
+
+	/** Shared world (created on first use) */
+	UWorld* GetWorld() const;
+
+	/**
+	 * Borrow a pooled test character (spawning one if the pool is empty)
+	 * @param OutCombat - Character's combat component
+	 * @param Location - Where to place it
+	 * @return Reset character, returned to the pool with the fixture
+	 */
+	ASamuraiCharacter* AcquireCharacter(UCombatComponent*& OutCombat, const FVector& Location = FVector::ZeroVector);
+
+	/** Put a character back to its just-spawned state (also done on acquire) */
+	static void ResetCharacter(ASamuraiCharacter* Character, const FVector& Location);
+
+	/** Destroy the shared world and pool (module shutdown) */
+	static void Shutdown();
+
+	/** Worlds created since startup (stays at 1 while fixtures reuse the world) */
+	static int32 GetNumWorldsCreated();
+
+	/** Characters spawned into the pool since startup */
+	static int32 GetNumCharactersSpawned();
+
+	/** Pooled characters not borrowed by a fixture */
+	static int32 GetNumFreeCharacters();
+
+private:
+	/** Characters this fixture borrowed */
+	TArray<TWeakObjectPtr<ASamuraiCharacter>, TInlineAllocator<4>> Borrowed;
+};
\ No newline at end of file
@@ -58,11 +58,25 @@ public:
 	{
 		ASamuraiCharacter* Character = World->SpawnActor<ASamuraiCharacter>();
 
+		// Setup minimal combat settings on the character (owner of CombatSettings)
+		Character->CombatSettings = CreateTestSettings();
+
+		// Get the existing combat component (created by character constructor)
+		OutCombat = Character->CombatComponent;
+
+		return Character;
+	}
+
+	/**
+	 * Create the minimal combat settings test characters use
+	 * @return Settings with an empty attack configuration (default attacks are set by tests as needed)
+	 */
+	static UCombatSettings* CreateTestSettings()
+	{
 		// Setup minimal attack configuration
 		UAttackConfiguration* AttackConfig = NewObject<UAttackConfiguration>();
 		// Default attacks are set by tests as needed
 
-		// Setup minimal combat settings on the character (owner of CombatSettings)
 		UCombatSettings* Settings = NewObject<UCombatSettings>();
 		Settings->MaxPosture = 100.0f;
 		Settings->PostureRegenRate_Idle = 20.0f;
@@ -71,12 +85,8 @@ public:
 		Settings->AttackConfiguration = AttackConfig;
 		Settings->CounterWindowDuration = 1.5f;
 		Settings->CounterDamageMultiplier = 1.5f;
-		Character->CombatSettings = Settings;
 
-		// Get the existing combat component (created by character constructor)
-		OutCombat = Character->CombatComponent;
-
-		return Character;
+		return Settings;
 	}
 
 	/**
@@ -0,0 +1,8 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "KatanaPlatforming.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_GAME_MODULE( FDefaultGameModuleImpl, KatanaPlatforming );
+
+DEFINE_LOG_CATEGORY(LogKatanaPlatforming)
\ No newline at end of file
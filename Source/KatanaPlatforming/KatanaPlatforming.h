@@ -0,0 +1,8 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Log category of the Platforming variant module */
+DECLARE_LOG_CATEGORY_EXTERN(LogKatanaPlatforming, Log, All);
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "EnhancedInputComponent.h"
 #include "TimerManager.h"
 #include "Engine/LocalPlayer.h"
+#include "Utilities/TraversalProbeComponent.h"
 
 APlatformingCharacter::APlatformingCharacter()
 {
@@ -75,6 +76,9 @@ APlatformingCharacter::APlatformingCharacter()
 	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
 	FollowCamera->bUsePawnControlRotation = false;
+
+	// create the wall probe
+	TraversalProbe = CreateDefaultSubobject<UTraversalProbeComponent>(TEXT("TraversalProbe"));
 }
 
 void APlatformingCharacter::Move(const FInputActionValue& Value)
@@ -113,17 +117,10 @@ void APlatformingCharacter::MultiJump()
 		// have we already wall jumped?
 		if (!bHasWallJumped)
 		{
-			// run a sphere sweep to check if we're in front of a wall
+			// run a sphere sweep to check if we're in front of a wall (reuses a recent result on repeated input)
 			FHitResult OutHit;
 
-			const FVector TraceStart = GetActorLocation();
-			const FVector TraceEnd = TraceStart + (GetActorForwardVector() * WallJumpTraceDistance);
-			const FCollisionShape TraceShape = FCollisionShape::MakeSphere(WallJumpTraceRadius);
-
-			FCollisionQueryParams QueryParams;
-			QueryParams.AddIgnoredActor(this);
-
-			if (GetWorld()->SweepSingleByChannel(OutHit, TraceStart, TraceEnd, FQuat(), ECollisionChannel::ECC_Visibility, TraceShape, QueryParams))
+			if (TraversalProbe->FindWall(GetActorForwardVector(), WallJumpTraceDistance, WallJumpTraceRadius, OutHit))
 			{
 				// rotate the character to face away from the wall, so we're correctly oriented for the next wall jump
 				FRotator WallOrientation = OutHit.ImpactNormal.ToOrientationRotator();
@@ -137,6 +134,9 @@ void APlatformingCharacter::MultiJump()
 
 				LaunchCharacter(WallJumpImpulse, true, true);
 
+				// we're moving away from this wall
+				TraversalProbe->InvalidateCache();
+
 				// enable the jump trail
 				SetJumpTrailState(true);
 
@@ -0,0 +1,142 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingPickupField.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "SideScrollingGameMode.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+
+ASideScrollingPickupField::ASideScrollingPickupField()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	// create the instanced mesh as the root
+	Instances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("Instances"));
+	RootComponent = Instances;
+
+	// pickups are collected by distance, the instances never need collision
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetGenerateOverlapEvents(false);
+
+	// removing an instance moves the last one into its place instead of shifting every index after it
+	Instances->bSupportRemoveAtSwap = true;
+}
+
+void ASideScrollingPickupField::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const int32 NumPickups = Instances->GetInstanceCount();
+
+	PickupLocations.Reset(NumPickups);
+	PickupInstances.Reset(NumPickups);
+	InstancePickups.Reset(NumPickups);
+	Grid.Reset();
+
+	// one pickup per placed instance, sorted into the grid
+	for (int32 InstanceIndex = 0; InstanceIndex < NumPickups; ++InstanceIndex)
+	{
+		FTransform InstanceTransform;
+		Instances->GetInstanceTransform(InstanceIndex, InstanceTransform, true);
+
+		const int32 PickupIndex = PickupLocations.Add(InstanceTransform.GetLocation());
+		PickupInstances.Add(InstanceIndex);
+		InstancePickups.Add(PickupIndex);
+		Grid.FindOrAdd(GetCell(PickupLocations[PickupIndex])).Add(PickupIndex);
+	}
+
+	// nothing to collect
+	SetActorTickEnabled(NumPickups > 0);
+}
+
+void ASideScrollingPickupField::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// pickups are counted by the game mode
+	ASideScrollingGameMode* GM = Cast<ASideScrollingGameMode>(GetWorld()->GetAuthGameMode());
+	if (!GM)
+	{
+		return;
+	}
+
+	// check every player character against the field
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PlayerController = It->Get())
+		{
+			if (const ACharacter* PlayerCharacter = PlayerController->GetPawn<ACharacter>())
+			{
+				CollectAround(PlayerCharacter, GM);
+			}
+		}
+	}
+
+	// stop ticking once the field is empty
+	if (InstancePickups.Num() == 0)
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+FIntPoint ASideScrollingPickupField::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / GridCellSize), FMath::FloorToInt32(Location.Z / GridCellSize));
+}
+
+void ASideScrollingPickupField::CollectAround(const ACharacter* Character, ASideScrollingGameMode* GM)
+{
+	const FVector CharacterLocation = Character->GetActorLocation();
+	const float Reach = CollectRadius + Character->GetSimpleCollisionRadius();
+	const float ReachSquared = FMath::Square(Reach);
+
+	// only visit the cells the reach overlaps
+	const FIntPoint MinCell = GetCell(CharacterLocation - FVector(Reach));
+	const FIntPoint MaxCell = GetCell(CharacterLocation + FVector(Reach));
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellZ = MinCell.Y; CellZ <= MaxCell.Y; ++CellZ)
+		{
+			TArray<int32>* Cell = Grid.Find(FIntPoint(CellX, CellZ));
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (int32 Index = Cell->Num() - 1; Index >= 0; --Index)
+			{
+				const int32 PickupIndex = (*Cell)[Index];
+				if (FVector::DistSquared(CharacterLocation, PickupLocations[PickupIndex]) <= ReachSquared)
+				{
+					Cell->RemoveAtSwap(Index, EAllowShrinking::No);
+					Collect(PickupIndex, GM);
+				}
+			}
+		}
+	}
+}
+
+void ASideScrollingPickupField::Collect(int32 PickupIndex, ASideScrollingGameMode* GM)
+{
+	// tell the game mode to process a pickup
+	GM->ProcessPickup();
+
+	// remove the instance; the last instance takes its place, so the pickup it draws moves with it
+	const int32 InstanceIndex = PickupInstances[PickupIndex];
+	const int32 LastInstanceIndex = InstancePickups.Num() - 1;
+
+	Instances->RemoveInstance(InstanceIndex);
+	InstancePickups.RemoveAtSwap(InstanceIndex, EAllowShrinking::No);
+	PickupInstances[PickupIndex] = INDEX_NONE;
+
+	if (InstanceIndex != LastInstanceIndex)
+	{
+		PickupInstances[InstancePickups[InstanceIndex]] = InstanceIndex;
+	}
+
+	// call the BP handler to play effects where the pickup was
+	BP_OnPickedUp(PickupLocations[PickupIndex]);
+}
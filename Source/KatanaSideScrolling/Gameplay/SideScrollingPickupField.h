@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SideScrollingPickupField.generated.h"
+
+class UInstancedStaticMeshComponent;
+class ASideScrollingGameMode;
+
+/**
+ *  A field of side scrolling pickups drawn as instances of one instanced static mesh
+ *  Place the pickups by adding instances to the mesh component. Each one counts like an ASideScrollingPickup,
+ *  but there are no per-pickup actors or overlap events: the field checks the player against a grid
+ *  of its pickups once per frame and removes the instances as they are collected
+ */
+UCLASS(abstract)
+class ASideScrollingPickupField : public AActor
+{
+	GENERATED_BODY()
+
+	/** Pickup instances (no collision, collection is resolved by the field) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
+	UInstancedStaticMeshComponent* Instances;
+
+protected:
+
+	/** Distance from a pickup to the edge of the player's collision at which it is collected */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Pickup", meta = (ClampMin = 0, Units="cm"))
+	float CollectRadius = 100.0f;
+
+	/** Size of the grid cells pickups are sorted into along the side scrolling plane */
+	UPROPERTY(EditAnywhere, Category="Pickup", meta = (ClampMin = 50, Units="cm"))
+	float GridCellSize = 500.0f;
+
+	/** World locations of the pickups, by pickup index */
+	TArray<FVector> PickupLocations;
+
+	/** Instance currently drawing each pickup, or INDEX_NONE once collected */
+	TArray<int32> PickupInstances;
+
+	/** Pickup drawn by each instance */
+	TArray<int32> InstancePickups;
+
+	/** Uncollected pickups in each grid cell (X, Z) */
+	TMap<FIntPoint, TArray<int32>> Grid;
+
+public:
+
+	/** Constructor */
+	ASideScrollingPickupField();
+
+	/** Returns the number of pickups not collected yet */
+	UFUNCTION(BlueprintPure, Category="Pickup")
+	int32 GetNumPickupsLeft() const { return InstancePickups.Num(); }
+
+protected:
+
+	/** Builds the pickups from the placed instances */
+	virtual void BeginPlay() override;
+
+	/** Collects the pickups in reach of the player */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the grid cell a location falls in */
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Collects every pickup within reach of the character */
+	void CollectAround(const ACharacter* Character, ASideScrollingGameMode* GM);
+
+	/** Counts the pickup on the game mode and removes its instance */
+	void Collect(int32 PickupIndex, ASideScrollingGameMode* GM);
+
+	/** Passes control to BP to play effects on pickup */
+	UFUNCTION(BlueprintImplementableEvent, Category="Pickup", meta = (DisplayName = "On Picked Up"))
+	void BP_OnPickedUp(const FVector& Location);
+};
@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class KatanaSideScrolling : ModuleRules
+{
+	public KatanaSideScrolling(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] {
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"InputCore",
+			"EnhancedInput",
+			"AIModule",
+			"StateTreeModule",
+			"GameplayStateTreeModule",
+			"UMG",
+			"KatanaCombat"
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
+
+		PublicIncludePaths.AddRange(new string[] {
+			"KatanaSideScrolling",
+			"KatanaSideScrolling/AI",
+			"KatanaSideScrolling/Gameplay",
+			"KatanaSideScrolling/Interfaces",
+			"KatanaSideScrolling/UI"
+		});
+	}
+}
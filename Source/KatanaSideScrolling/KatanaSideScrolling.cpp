@@ -0,0 +1,8 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "KatanaSideScrolling.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_GAME_MODULE( FDefaultGameModuleImpl, KatanaSideScrolling );
+
+DEFINE_LOG_CATEGORY(LogKatanaSideScrolling)
\ No newline at end of file
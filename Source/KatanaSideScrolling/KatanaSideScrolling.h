@@ -0,0 +1,8 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Log category of the SideScrolling variant module */
+DECLARE_LOG_CATEGORY_EXTERN(LogKatanaSideScrolling, Log, All);
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "SideScrollingCameraManager.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "Engine/HitResult.h"
 #include "CollisionQueryParams.h"
 #include "Engine/World.h"
@@ -57,16 +59,8 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 
 		} else {
 
-			// run a trace below the character to determine if we need to do a height update
-			FHitResult OutHit;
-
-			const FVector End = CurrentActorLocation + FVector(0.0f, 0.0f, -1000.0f);
-
-			FCollisionQueryParams QueryParams;
-			QueryParams.AddIgnoredActor(TargetPawn);
-
 			// only update height if we're not about to hit ground
-			bZUpdate = !GetWorld()->LineTraceSingleByChannel(OutHit, CurrentActorLocation, End, ECC_Visibility, QueryParams);
+			bZUpdate = !HasGroundBelow(TargetPawn, CurrentActorLocation);
 
 		}
 
@@ -102,4 +96,60 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 
 		OutVT.POV.Location = FMath::VInterpTo(CurrentCameraLocation, TargetCameraLocation, DeltaTime, 2.0f);
 	}
+}
+
+bool ASideScrollingCameraManager::HasGroundBelow(const APawn* TargetPawn, const FVector& TargetLocation)
+{
+	// if the character movement is standing on a walkable floor, reuse its floor result instead of tracing
+	const ACharacter* TargetCharacter = Cast<ACharacter>(TargetPawn);
+
+	if (TargetCharacter && TargetCharacter->GetCharacterMovement())
+	{
+		const FFindFloorResult& Floor = TargetCharacter->GetCharacterMovement()->CurrentFloor;
+
+		if (Floor.IsWalkableFloor())
+		{
+			GroundProbeOrigin = TargetLocation;
+			GroundProbeZ = Floor.HitResult.ImpactPoint.Z;
+			bHasGroundProbe = true;
+			bGroundProbeHit = true;
+
+			return true;
+		}
+	}
+
+	// can we reuse the cached probe?
+	if (bHasGroundProbe && FVector::DistSquared2D(GroundProbeOrigin, TargetLocation) <= FMath::Square(GroundProbeTolerance))
+	{
+		if (bGroundProbeHit)
+		{
+			// the cached ground is still below us and within range
+			const float Height = TargetLocation.Z - GroundProbeZ;
+
+			if (Height >= 0.0f && Height <= GroundProbeDistance)
+			{
+				return true;
+			}
+
+		} else if (TargetLocation.Z >= GroundProbeOrigin.Z) {
+
+			// nothing was found below a lower point, and we've only moved up through empty space since
+			return false;
+		}
+	}
+
+	// run a trace below the character and cache the result
+	FHitResult OutHit;
+
+	const FVector End = TargetLocation + FVector(0.0f, 0.0f, -GroundProbeDistance);
+
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(TargetPawn);
+
+	bGroundProbeHit = GetWorld()->LineTraceSingleByChannel(OutHit, TargetLocation, End, ECC_Visibility, QueryParams);
+	bHasGroundProbe = true;
+	GroundProbeOrigin = TargetLocation;
+	GroundProbeZ = bGroundProbeHit ? OutHit.ImpactPoint.Z : 0.0f;
+
+	return bGroundProbeHit;
 }
\ No newline at end of file
@@ -37,8 +37,31 @@ public:
 	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
 	float CameraXMaxBounds = 10000.0f;
 
+	/** How far below the target we look for ground while it moves vertically */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float GroundProbeDistance = 1000.0f;
+
+	/** How far the target can drift horizontally before the cached ground probe is refreshed */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=1000, Units="cm"))
+	float GroundProbeTolerance = 50.0f;
+
 protected:
 
+	/** Returns true if there is ground within GroundProbeDistance below the target, reusing the cached probe when possible */
+	bool HasGroundBelow(const APawn* TargetPawn, const FVector& TargetLocation);
+
+	/** Location the cached ground probe was taken from */
+	FVector GroundProbeOrigin = FVector::ZeroVector;
+
+	/** Height of the ground found by the cached probe */
+	float GroundProbeZ = 0.0f;
+
+	/** True if the cached probe is valid */
+	bool bHasGroundProbe = false;
+
+	/** True if the cached probe found ground */
+	bool bGroundProbeHit = false;
+
 	/** Last cached camera vertical location. The camera only adjusts its height if necessary. */
 	float CurrentZ = 0.0f;
 
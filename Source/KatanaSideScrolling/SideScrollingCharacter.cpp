@@ -13,6 +13,7 @@
 #include "SideScrollingInteractable.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "TimerManager.h"
+#include "Utilities/TraversalProbeComponent.h"
 
 ASideScrollingCharacter::ASideScrollingCharacter()
 {
@@ -24,6 +25,9 @@ ASideScrollingCharacter::ASideScrollingCharacter()
 
 	Camera->SetRelativeLocationAndRotation(FVector(0.0f, 300.0f, 0.0f), FRotator(0.0f, -90.0f, 0.0f));
 
+	// create the wall probe
+	TraversalProbe = CreateDefaultSubobject<UTraversalProbeComponent>(TEXT("TraversalProbe"));
+
 	// configure the collision capsule
 	GetCapsuleComponent()->SetCapsuleSize(35.0f, 90.0f);
 
@@ -237,18 +241,12 @@ void ASideScrollingCharacter::MultiJump()
 	// if we have a horizontal input, try for wall jump first
 	if (!bHasWallJumped && !FMath::IsNearlyZero(ActionValueY))
 	{
-		// trace ahead of the character for walls
+		// trace ahead of the character for walls (reuses a recent result on repeated input)
 		FHitResult OutHit;
 
-		const FVector Start = GetActorLocation();
-		const FVector End = Start + (FVector(ActionValueY > 0.0f ? 1.0f : -1.0f, 0.0f, 0.0f) * WallJumpTraceDistance);
-
-		FCollisionQueryParams QueryParams;
-		QueryParams.AddIgnoredActor(this);
+		const FVector Direction(ActionValueY > 0.0f ? 1.0f : -1.0f, 0.0f, 0.0f);
 
-		GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECC_Visibility, QueryParams);
-
-		if (OutHit.bBlockingHit)
+		if (TraversalProbe->FindWall(Direction, WallJumpTraceDistance, 0.0f, OutHit))
 		{
 			// rotate to the bounce direction
 			const FRotator BounceRot = UKismetMathLibrary::MakeRotFromX(OutHit.ImpactNormal);
@@ -261,6 +259,9 @@ void ASideScrollingCharacter::MultiJump()
 			// launch the character away from the wall
 			LaunchCharacter(WallJumpImpulse, true, true);
 
+			// we're moving away from this wall
+			TraversalProbe->InvalidateCache();
+
 			// enable wall jump lockout for a bit
 			bHasWallJumped = true;
 
@@ -305,7 +306,25 @@ void ASideScrollingCharacter::CheckForSoftCollision()
 	// reset the drop value
 	DropValue = 0.0f;
 
-	// trace down 
+	// if we're standing on something, the movement component already knows what it is
+	const FFindFloorResult& Floor = GetCharacterMovement()->CurrentFloor;
+
+	if (GetCharacterMovement()->IsMovingOnGround() && Floor.bBlockingHit)
+	{
+		// are we standing on a soft floor?
+		const UPrimitiveComponent* FloorComponent = Floor.HitResult.GetComponent();
+
+		if (FloorComponent && FloorComponent->GetCollisionObjectType() == SoftCollisionObjectType)
+		{
+			// drop through the floor
+			SetSoftCollision(true);
+		}
+
+		// a solid floor keeps blocking us regardless of what's below it, so there's nothing to trace for
+		return;
+	}
+
+	// we're in the air, so trace down 
 	FHitResult OutHit;
 
 	const FVector Start = GetActorLocation();
@@ -8,6 +8,7 @@
 
 class UCameraComponent;
 class UInputAction;
+class UTraversalProbeComponent;
 struct FInputActionValue;
 
 /**
@@ -22,6 +23,10 @@ class ASideScrollingCharacter : public ACharacter
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Camera", meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* Camera;
 
+	/** Cached wall probe for wall jumps */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
+	UTraversalProbeComponent* TraversalProbe;
+
 protected:
 
 	/** Move Input Action */
@@ -10,7 +10,7 @@
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
 #include "Blueprint/UserWidget.h"
-#include "KatanaCombat.h"
+#include "KatanaSideScrolling.h"
 #include "Widgets/Input/SVirtualJoystick.h"
 
 void ASideScrollingPlayerController::BeginPlay()
@@ -30,7 +30,7 @@ void ASideScrollingPlayerController::BeginPlay()
 
 		} else {
 
-			UE_LOG(LogKatanaCombat, Error, TEXT("Could not spawn mobile controls widget."));
+			UE_LOG(LogKatanaSideScrolling, Error, TEXT("Could not spawn mobile controls widget."));
 
 		}
 